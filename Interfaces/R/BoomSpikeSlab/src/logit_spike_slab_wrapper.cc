@@ -48,7 +48,9 @@ extern "C" {
     RMemoryProtector protector;
     try {
       BOOM::RInterface::seed_rng_from_R(r_seed);
-      Matrix design_matrix(BOOM::ToBoomMatrix(r_x));
+      // A view of R's memory.  Each observation copies its own row, so
+      // copying the whole design matrix first would double peak memory.
+      BOOM::ConstSubMatrix design_matrix(BOOM::ToBoomMatrixView(r_x));
       std::vector<int> successes(BOOM::ToIntVector(r_y));
       std::vector<int> trials(BOOM::ToIntVector(r_ny));
       Ptr<BOOM::BinomialLogitModel> model(new BOOM::BinomialLogitModel(
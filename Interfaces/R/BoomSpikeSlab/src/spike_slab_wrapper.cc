@@ -49,16 +49,20 @@ namespace {
         new StandardDeviationListElement(model->Sigsq_prm(), "sigma"));
   }
 
+  // The design matrix and response are views of the memory owned by R.  The
+  // sufficient statistics are accumulated a block of rows at a time, so the
+  // design matrix is never copied in full.
   void initialize_regression_model_data(Ptr<RegressionModel> model,
-                                        const Matrix &design_matrix,
-                                        const Vector &response_vector) {
-    NEW(NeRegSuf, suf)(design_matrix, response_vector);
+                                        const ConstSubMatrix &design_matrix,
+                                        const ConstVectorView &response_vector) {
+    NEW(NeRegSuf, suf)(design_matrix.ncol());
+    suf->add_data_view(design_matrix, response_vector);
     model->suf()->combine(suf);
   }
 
   void initialize_student_model_data(Ptr<TRegressionModel> model,
-                                     const Matrix &design_matrix,
-                                     const Vector &response_vector) {
+                                     const ConstSubMatrix &design_matrix,
+                                     const ConstVectorView &response_vector) {
     size_t n = design_matrix.nrow();
      for (size_t i = 0; i < n; ++i) {
        model->add_data(Ptr<RegressionData>(
@@ -86,10 +90,10 @@ namespace {
       SEXP r_spike_slab_prior,
       SEXP r_model_options,
       BOOM::RListIoManager *io_manager) {
-    Matrix design_matrix(ToBoomMatrix(r_design_matrix));
+    ConstSubMatrix design_matrix(ToBoomMatrixView(r_design_matrix));
     Ptr<RegressionModel> model(new RegressionModel(design_matrix.ncol()));
     initialize_regression_model_data(
-        model, design_matrix, ToBoomVector(r_response_vector));
+        model, design_matrix, ToBoomVectorView(r_response_vector));
     initialize_coefficients(model);
 
     if (Rf_inherits(r_model_options, "SsvsOptions")) {
@@ -172,10 +176,10 @@ namespace {
       SEXP r_response_vector,
       SEXP r_spike_slab_prior,
       BOOM::RListIoManager *io_manager) {
-    Matrix design_matrix(ToBoomMatrix(r_design_matrix));
+    ConstSubMatrix design_matrix(ToBoomMatrixView(r_design_matrix));
     NEW(TRegressionModel, model)(design_matrix.ncol());
     initialize_student_model_data(
-        model, design_matrix, ToBoomVector(r_response_vector));
+        model, design_matrix, ToBoomVectorView(r_response_vector));
     initialize_coefficients(model);
     RInterface::StudentRegressionConjugateSpikeSlabPrior prior(
         r_spike_slab_prior, model->Sigsq_prm());
@@ -34,10 +34,7 @@ extern "C" {
       Vector x = ToBoomVector(r_data_vector);
       Vector knots = ToBoomVector(r_sorted_knots_vector);
       Bspline spline(knots);
-      Matrix basis(x.size(), spline.basis_dimension());
-      for (int i = 0; i < x.size(); ++i) {
-        basis.row(i) = spline.basis(x[i]);
-      }
+      Matrix basis = spline.basis_matrix(x);
       return ToRMatrix(basis);
     } catch(std::exception &e) {
       handle_exception(e);
@@ -54,10 +51,7 @@ extern "C" {
       Vector x = ToBoomVector(r_data_vector);
       Vector knots = ToBoomVector(r_sorted_knots_vector);
       Mspline spline(knots);
-      Matrix basis(x.size(), spline.basis_dimension());
-      for (int i = 0; i < x.size(); ++i) {
-        basis.row(i) = spline.basis(x[i]);
-      }
+      Matrix basis = spline.basis_matrix(x);
       return ToRMatrix(basis);
     } catch(std::exception &e) {
       handle_exception(e);
@@ -73,10 +67,7 @@ extern "C" {
       Vector x = ToBoomVector(r_data_vector);
       Vector knots = ToBoomVector(r_sorted_knots_vector);
       Ispline spline(knots);
-      Matrix basis(x.size(), spline.basis_dimension());
-      for (int i = 0; i < x.size(); ++i) {
-        basis.row(i) = spline.basis(x[i]);
-      }
+      Matrix basis = spline.basis_matrix(x);
       return ToRMatrix(basis);
     } catch(std::exception &e) {
       handle_exception(e);
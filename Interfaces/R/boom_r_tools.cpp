@@ -405,10 +405,14 @@ namespace BOOM {
       SEXP r_variable = VECTOR_ELT(r_data_frame, i);
       if (Rf_isFactor(r_variable)) {
         Factor factor(r_variable);
-        CategoricalVariable variable(factor.vector_of_observations());
-        table.append_variable(variable, variable_names[i]);
+        std::vector<std::int32_t> codes(factor.length());
+        for (int j = 0; j < codes.size(); ++j) {
+          codes[j] = factor[j];
+        }
+        table.append_variable(CategoricalColumn(codes, factor.key()),
+                              variable_names[i]);
       } else if (Rf_isString(r_variable)) {
-        table.append_variable(CategoricalVariable(StringVector(r_variable)),
+        table.append_variable(CategoricalColumn(StringVector(r_variable)),
                               variable_names[i]);
       } else if (Rf_isNumeric(r_variable)) {
         table.append_variable(ToBoomVector(r_variable),
@@ -476,18 +480,17 @@ namespace BOOM {
 
   // R's date object is the number of days since Jan 1 1970.
   Date ToBoomDate(SEXP r_Date) {
-    Date ans;
-    ans.set(lround(Rf_asReal(r_Date)));
-    return ans;
+    return Date(lround(Rf_asReal(r_Date)));
   }
 
   std::vector<BOOM::Date> ToBoomDateVector(SEXP r_dates) {
     Vector date_numbers = ToBoomVector(r_dates);
-    std::vector<BOOM::Date> ans(date_numbers.size());
-    for (int i = 0; i < ans.size(); ++i) {
-      ans[i].set(lround(date_numbers[i]));
+    std::vector<int> days(date_numbers.size());
+    for (int i = 0; i < days.size(); ++i) {
+      days[i] = lround(date_numbers[i]);
     }
-    return ans;
+    // Avoids default constructing each Date, which queries the clock.
+    return dates_from_days(days);
   }
 
   SEXP ToRVector(const Vector &v){
@@ -14,14 +14,19 @@
 // License along with this library; if not, write to the Free Software
 // Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <ctime>
 #include <iostream>
+#include <memory>
 
 #include "model_manager.h"
 #include "utils.h"
 #include "create_state_model.h"
 
 #include "r_interface/boom_r_tools.hpp"
+#include "r_interface/determine_nthreads.hpp"
 #include "r_interface/handle_exception.hpp"
 #include "r_interface/list_io.hpp"
 #include "r_interface/print_R_timestamp.hpp"
@@ -30,6 +35,121 @@
 #include "Models/StateSpace/StateSpaceModelBase.hpp"
 #include "cpputil/report_error.hpp"
 #include "cpputil/ThreadTools.hpp"
+#include "stats/mcmc_convergence.hpp"
+
+namespace {
+  using namespace BOOM;
+  using namespace BOOM::bsts;
+
+  //===========================================================================
+  // One of the independent models fit by
+  // analysis_common_r_fit_bsts_models_in_parallel_.  The model, its io
+  // manager, and the R list that receives its draws are all built on the
+  // main thread.  Run() can then be called from a worker thread: it makes no
+  // calls to the R API, and it writes draws only to the raw memory of R
+  // vectors that were allocated (and protected) beforehand.
+  class BatchFit {
+   public:
+    BatchFit(SEXP r_specification, int niter, RMemoryProtector *protector)
+        : niter_(niter),
+          check_every_(1),
+          ngood_(-1),
+          timed_out_(false) {
+      SEXP r_data_list = getListElement(
+          r_specification, "data.list", true);
+      BstsOptions options(getListElement(
+          r_specification, "model.options", true));
+      int xdim = 0;
+      SEXP r_predictors = getListElement(r_data_list, "predictors");
+      if (!Rf_isNull(r_predictors)) {
+        xdim = Rf_ncols(r_predictors);
+      }
+      model_manager_.reset(ScalarModelManager::Create(
+          ToString(getListElement(r_specification, "family", true)), xdim));
+      model_ = model_manager_->CreateModel(
+          r_data_list,
+          getListElement(r_specification, "state.specification", true),
+          getListElement(r_specification, "prior", true),
+          options,
+          &io_manager_);
+      // As in the single model fit, one draw ensures dynamically allocated
+      // objects have the correct size before R memory is allocated.
+      model_->sample_posterior();
+      stopping_rule_ = options.CreateStoppingRule(&io_manager_);
+      check_every_ = options.stopping_rule_check_every();
+      ans_ = protector->protect(io_manager_.prepare_to_write(niter_));
+    }
+
+    // Run the MCMC.  Errors are recorded rather than thrown, so one failed
+    // model does not discard the draws of the others.
+    //
+    // Args:
+    //   timeout_seconds: The wall clock time after which the run ends.  The
+    //     timer starts when Run() is called.
+    //   canceled:  If this becomes true the run ends at the next iteration.
+    void Run(double timeout_seconds, const std::atomic<bool> *canceled) {
+      auto start = std::chrono::steady_clock::now();
+      for (int i = 0; i < niter_; ++i) {
+        if (*canceled) {
+          ngood_ = i;
+          error_message_ = "Canceled by user.";
+          return;
+        }
+        try {
+          model_->sample_posterior();
+          io_manager_.write();
+          if (stopping_rule_ && (i + 1) % check_every_ == 0
+              && stopping_rule_(*io_manager_.convergence_monitor())) {
+            ngood_ = i + 1;
+            return;
+          }
+          std::chrono::duration<double> elapsed =
+              std::chrono::steady_clock::now() - start;
+          if (elapsed.count() > timeout_seconds) {
+            ngood_ = i + 1;
+            timed_out_ = true;
+            return;
+          }
+        } catch (std::exception &e) {
+          std::ostringstream err;
+          err << "Caught an exception with the following "
+              << "error message in MCMC "
+              << "iteration " << i << ".  Aborting." << std::endl
+              << e.what() << std::endl;
+          ngood_ = i;
+          error_message_ = err.str();
+          return;
+        }
+      }
+    }
+
+    // The list of draws, with an "ngood" element if the run ended early.
+    // Must be called on the main thread after Run() completes.
+    SEXP result() const {
+      if (ngood_ < 0) return ans_;
+      return appendListElement(ans_, ToRVector(Vector(1, ngood_)), "ngood");
+    }
+
+    bool timed_out() const { return timed_out_; }
+    const std::string &error_message() const { return error_message_; }
+
+   private:
+    int niter_;
+    std::unique_ptr<ScalarModelManager> model_manager_;
+    Ptr<Model> model_;
+    RListIoManager io_manager_;
+    McmcStoppingRule stopping_rule_;
+    int check_every_;
+    SEXP ans_;
+
+    // The number of completed iterations if the run ended early, or -1 if
+    // all niter_ iterations completed.
+    int ngood_;
+    bool timed_out_;
+    std::string error_message_;
+  };
+
+}  // namespace
 
 extern "C" {
   using namespace BOOM;
@@ -60,11 +180,12 @@ extern "C" {
       }
       std::unique_ptr<ScalarModelManager> model_manager(
           ScalarModelManager::Create(family, xdim));
+      BstsOptions options(r_options);
       Ptr<BOOM::Model> model(model_manager->CreateModel(
           r_data_list,
           r_state_specification,
           r_prior,
-          r_options,
+          options,
           &io_manager));
 
       // Do one posterior sampling step before getting ready to write.  This
@@ -76,6 +197,11 @@ extern "C" {
       int ping = lround(Rf_asReal(r_ping));
       double timeout_threshold_seconds = Rf_asReal(r_timeout_in_seconds);
 
+      // An optional rule for ending the run once the draws have converged.
+      McmcStoppingRule stopping_rule = options.CreateStoppingRule(
+          &io_manager);
+      int check_every = options.stopping_rule_check_every();
+
       SEXP ans = protector.protect(io_manager.prepare_to_write(niter));
       clock_t start_time = clock();
       double time_threshold = CLOCKS_PER_SEC * timeout_threshold_seconds;
@@ -88,6 +214,13 @@ extern "C" {
         try {
           model->sample_posterior();
           io_manager.write();
+          if (stopping_rule && (i + 1) % check_every == 0
+              && stopping_rule(*io_manager.convergence_monitor())) {
+            return BOOM::appendListElement(
+                ans,
+                ToRVector(BOOM::Vector(1, i + 1)),
+                "ngood");
+          }
           clock_t current_time = clock();
           if (current_time - start_time > time_threshold) {
             std::ostringstream warning;
@@ -125,6 +258,102 @@ extern "C" {
     return R_NilValue;
   }
 
+  // Fits a collection of independent bsts models, running the MCMC for
+  // different models on different threads.  This avoids forking the R
+  // session once per model, as with parallel::mclapply.
+  //
+  // All calls to the R API (model construction, allocation of the output
+  // lists, warnings) happen on the main thread.  The worker threads only
+  // run the samplers and write draws into the previously allocated output
+  // buffers.
+  //
+  // Args:
+  //   r_model_specifications: An R list.  Each element is a list with
+  //     elements "data.list", "state.specification", "prior",
+  //     "model.options", and "family", as passed to
+  //     analysis_common_r_fit_bsts_model_.
+  //   r_niter:  The number of MCMC iterations for each model.
+  //   r_timeout_in_seconds: The wall clock time allowed for each model's
+  //     MCMC run.
+  //   r_nthreads: The number of models to fit at once.  If R's NULL then
+  //     the number of available cores is used.
+  //   r_seed: The seed for the random number generator.  Models are built
+  //     in order on the main thread, and each sampler takes its seed from
+  //     the global RNG, so results do not depend on the number of threads.
+  //
+  // Returns:
+  //   A list containing the output from each model, in the format returned
+  //   by analysis_common_r_fit_bsts_model_.
+  SEXP analysis_common_r_fit_bsts_models_in_parallel_(
+      SEXP r_model_specifications,
+      SEXP r_niter,
+      SEXP r_timeout_in_seconds,
+      SEXP r_nthreads,
+      SEXP r_seed) {
+    BOOM::RErrorReporter error_reporter;
+    BOOM::RMemoryProtector protector;
+    try {
+      seed_rng_from_R(r_seed);
+      int nmodels = Rf_length(r_model_specifications);
+      int niter = lround(Rf_asReal(r_niter));
+      double timeout_seconds = Rf_asReal(r_timeout_in_seconds);
+      std::vector<std::unique_ptr<BatchFit>> fits;
+      for (int i = 0; i < nmodels; ++i) {
+        fits.emplace_back(new BatchFit(
+            VECTOR_ELT(r_model_specifications, i), niter, &protector));
+      }
+
+      std::atomic<bool> canceled(false);
+      int nthreads = std::min<int>(nmodels, determine_nthreads(r_nthreads));
+      if (nthreads <= 1) {
+        for (int i = 0; i < nmodels; ++i) {
+          if (RCheckInterrupt()) canceled = true;
+          fits[i]->Run(timeout_seconds, &canceled);
+        }
+      } else {
+        BOOM::ThreadWorkerPool pool;
+        pool.add_threads(nthreads);
+        std::vector<std::future<void>> futures;
+        for (int i = 0; i < nmodels; ++i) {
+          BatchFit *fit = fits[i].get();
+          futures.emplace_back(pool.submit([fit, timeout_seconds, &canceled]() {
+                fit->Run(timeout_seconds, &canceled);
+              }));
+        }
+        // The main thread stays responsive to user interrupts while the
+        // workers run.
+        for (int i = 0; i < futures.size(); ++i) {
+          while (futures[i].wait_for(std::chrono::milliseconds(100))
+                 != std::future_status::ready) {
+            if (!canceled && RCheckInterrupt()) canceled = true;
+          }
+          futures[i].get();
+        }
+      }
+
+      if (canceled) {
+        error_reporter.SetError("Canceled by user.");
+        return R_NilValue;
+      }
+      SEXP ans = protector.protect(Rf_allocVector(VECSXP, nmodels));
+      for (int i = 0; i < nmodels; ++i) {
+        SET_VECTOR_ELT(ans, i, fits[i]->result());
+        if (fits[i]->timed_out()) {
+          Rf_warning("Timeout threshold %g seconds exceeded for model %d.",
+                     timeout_seconds, i + 1);
+        } else if (!fits[i]->error_message().empty()) {
+          Rf_warning("Model %d: %s", i + 1, fits[i]->error_message().c_str());
+        }
+      }
+      return ans;
+    } catch (std::exception &e) {
+      handle_exception(e);
+    } catch (...) {
+      handle_unknown_exception();
+    }
+    return R_NilValue;
+  }
+
   // Returns the posterior predictive distribution of a model forecast
   // over a specified forecast period.
   // Args:
@@ -34,6 +34,13 @@ extern "C" {
       SEXP r_timeout_in_seconds,
       SEXP r_seed);
 
+  SEXP analysis_common_r_fit_bsts_models_in_parallel_(
+      SEXP r_model_specifications,
+      SEXP r_niter,
+      SEXP r_timeout_in_seconds,
+      SEXP r_nthreads,
+      SEXP r_seed);
+
   SEXP analysis_common_r_fit_dirm_(
       SEXP r_data_list,
       SEXP r_state_specification,
@@ -92,9 +99,20 @@ extern "C" {
       SEXP r_prediction_data,
       SEXP r_burn,
       SEXP r_seed);
-  
+
+  SEXP analysis_common_r_bsts_enable_profiling_(
+      SEXP r_enable,
+      SEXP r_reset);
+
+  SEXP analysis_common_r_bsts_profile_report_();
+
+  SEXP analysis_common_r_bsts_estimate_memory_(
+      SEXP r_dimensions,
+      SEXP r_options);
+
   static R_CallMethodDef bsts_arg_description[] = {
     CALLDEF(analysis_common_r_fit_bsts_model_, 9),
+    CALLDEF(analysis_common_r_fit_bsts_models_in_parallel_, 5),
     CALLDEF(analysis_common_r_fit_dirm_, 7),
     CALLDEF(analysis_common_r_predict_bsts_model_, 5),
     CALLDEF(analysis_common_r_bsts_one_step_prediction_errors_, 3),
@@ -103,6 +121,9 @@ extern "C" {
     CALLDEF(analysis_common_r_get_date_ranges_, 2),
     CALLDEF(analysis_common_r_fit_multivariate_bsts_model_, 8),
     CALLDEF(analysis_common_r_predict_multivariate_bsts_model_, 4),
+    CALLDEF(analysis_common_r_bsts_enable_profiling_, 2),
+    CALLDEF(analysis_common_r_bsts_profile_report_, 0),
+    CALLDEF(analysis_common_r_bsts_estimate_memory_, 2),
     {NULL, NULL, 0}  // NOLINT
   };
 
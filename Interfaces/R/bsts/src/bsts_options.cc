@@ -0,0 +1,106 @@
+// Copyright 2024 Steven L. Scott. All Rights Reserved.
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+
+#include "bsts_options.h"
+#include "cpputil/math_utils.hpp"
+
+namespace BOOM {
+  namespace bsts {
+
+    BstsOptions::BstsOptions()
+        : specified_(false),
+          save_state_contributions_(false),
+          save_prediction_errors_(false),
+          save_full_state_(false),
+          enable_threads_(true),
+          timeout_seconds_(infinity()),
+          clt_threshold_(-1),
+          oda_eigenvalue_fudge_factor_(0.001),
+          oda_fallback_probability_(0.0),
+          min_effective_sample_size_(0),
+          max_split_rhat_(infinity()),
+          max_abs_geweke_(infinity()),
+          check_every_(1)
+    {}
+
+    BstsOptions::BstsOptions(SEXP r_options)
+        : BstsOptions()
+    {
+      if (Rf_isNull(r_options)) {
+        return;
+      }
+      specified_ = true;
+      // Missing logical elements are NA, which C++ treats as true.  This
+      // matches the way the options were read before they were parsed here.
+      save_state_contributions_ = Rf_asLogical(getListElement(
+          r_options, "save.state.contributions"));
+      save_prediction_errors_ = Rf_asLogical(getListElement(
+          r_options, "save.prediction.errors"));
+      save_full_state_ = Rf_asLogical(getListElement(
+          r_options, "save.full.state"));
+      enable_threads_ = Rf_asLogical(getListElement(
+          r_options, "enable.threads"));
+
+      SEXP r_timeout = getListElement(r_options, "timeout.seconds");
+      if (!Rf_isNull(r_timeout)) {
+        timeout_seconds_ = Rf_asReal(r_timeout);
+      }
+
+      SEXP r_clt_threshold = getListElement(r_options, "clt.threshold");
+      if (!Rf_isNull(r_clt_threshold)) {
+        clt_threshold_ = Rf_asInteger(r_clt_threshold);
+      }
+
+      SEXP r_bma_method = getListElement(r_options, "bma.method");
+      if (!Rf_isNull(r_bma_method)) {
+        bma_method_ = ToString(r_bma_method);
+      }
+      SEXP r_oda_options = getListElement(r_options, "oda.options");
+      if (!Rf_isNull(r_oda_options)) {
+        oda_eigenvalue_fudge_factor_ = Rf_asReal(
+            getListElement(r_oda_options, "eigenvalue.fudge.factor"));
+        oda_fallback_probability_ = Rf_asReal(
+            getListElement(r_oda_options, "fallback.probability"));
+      }
+
+      SEXP r_stopping_rule = getListElement(r_options, "stopping.rule");
+      if (!Rf_isNull(r_stopping_rule)) {
+        stopping_rule_parameters_ = StringVector(
+            getListElement(r_stopping_rule, "parameters"));
+        min_effective_sample_size_ = Rf_asReal(getListElement(
+            r_stopping_rule, "min.effective.sample.size"));
+        max_split_rhat_ = Rf_asReal(getListElement(
+            r_stopping_rule, "max.split.rhat"));
+        max_abs_geweke_ = Rf_asReal(getListElement(
+            r_stopping_rule, "max.abs.geweke"));
+        check_every_ = std::max<int>(1, Rf_asInteger(getListElement(
+            r_stopping_rule, "check.every")));
+      }
+    }
+
+    McmcStoppingRule BstsOptions::CreateStoppingRule(
+        RListIoManager *io_manager) const {
+      if (!has_stopping_rule()) {
+        return McmcStoppingRule();
+      }
+      io_manager->monitor_convergence(stopping_rule_parameters_);
+      return ConvergenceStoppingRule(min_effective_sample_size_,
+                                     max_split_rhat_,
+                                     max_abs_geweke_);
+    }
+
+  }  // namespace bsts
+}  // namespace BOOM
@@ -0,0 +1,112 @@
+#ifndef BSTS_SRC_BSTS_OPTIONS_H_
+#define BSTS_SRC_BSTS_OPTIONS_H_
+// Copyright 2024 Steven L. Scott. All Rights Reserved.
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+
+#include <string>
+#include <vector>
+
+#include "r_interface/boom_r_tools.hpp"
+#include "r_interface/list_io.hpp"
+#include "stats/mcmc_convergence.hpp"
+
+namespace BOOM {
+  namespace bsts {
+
+    // The contents of the R list produced by BstsOptions, plus the family
+    // specific options the R code adds to it.  The R list is read once, by the
+    // constructor, which must run on R's main thread.  After that the object
+    // is a plain C++ value, so model construction and MCMC can use it from
+    // any thread.  In the same way, the prior specification classes in
+    // r_interface/prior_specification.hpp copy everything they need out of R
+    // when they are constructed.
+    class BstsOptions {
+     public:
+      // Default options, used when a model is rebuilt from a bsts object for
+      // prediction.  specified() is false.
+      BstsOptions();
+
+      // Args:
+      //   r_options: An R list created by BstsOptions, or R_NilValue.  If
+      //     R_NilValue the default options are used.
+      explicit BstsOptions(SEXP r_options);
+
+      // True if the options came from a non-NULL R list.  Models built
+      // without options (e.g. for prediction) do not need an MCMC sampler
+      // for their regression components.
+      bool specified() const {return specified_;}
+
+      bool save_state_contributions() const {
+        return save_state_contributions_;
+      }
+      bool save_prediction_errors() const {return save_prediction_errors_;}
+      bool save_full_state() const {return save_full_state_;}
+      bool enable_threads() const {return enable_threads_;}
+      double timeout_seconds() const {return timeout_seconds_;}
+
+      // The CLT threshold for logit models, or a negative number if the
+      // options do not specify one.
+      int clt_threshold() const {return clt_threshold_;}
+
+      // The model averaging method for regression models: "SSVS", "ODA", or
+      // empty if not specified.
+      const std::string &bma_method() const {return bma_method_;}
+      double oda_eigenvalue_fudge_factor() const {
+        return oda_eigenvalue_fudge_factor_;
+      }
+      double oda_fallback_probability() const {
+        return oda_fallback_probability_;
+      }
+
+      // True if the options contain a ConvergenceStoppingRule.
+      bool has_stopping_rule() const {
+        return !stopping_rule_parameters_.empty();
+      }
+
+      // Set io_manager to monitor the parameters named in the stopping rule,
+      // and return the rule.  Must be called before
+      // io_manager->prepare_to_write().  If has_stopping_rule() is false an
+      // empty rule is returned, and io_manager is unchanged.
+      McmcStoppingRule CreateStoppingRule(RListIoManager *io_manager) const;
+
+      // The number of iterations between checks of the stopping rule.
+      int stopping_rule_check_every() const {return check_every_;}
+
+     private:
+      bool specified_;
+      bool save_state_contributions_;
+      bool save_prediction_errors_;
+      bool save_full_state_;
+      bool enable_threads_;
+      double timeout_seconds_;
+
+      int clt_threshold_;
+
+      std::string bma_method_;
+      double oda_eigenvalue_fudge_factor_;
+      double oda_fallback_probability_;
+
+      std::vector<std::string> stopping_rule_parameters_;
+      double min_effective_sample_size_;
+      double max_split_rhat_;
+      double max_abs_geweke_;
+      int check_every_;
+    };
+
+  }  // namespace bsts
+}  // namespace BOOM
+
+#endif  // BSTS_SRC_BSTS_OPTIONS_H_
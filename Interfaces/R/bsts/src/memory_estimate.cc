@@ -0,0 +1,78 @@
+/*
+  Copyright (C) 2005-2024 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include "r_interface/boom_r_tools.hpp"
+#include "r_interface/handle_exception.hpp"
+#include "Models/StateSpace/StateSpaceMemoryEstimate.hpp"
+
+extern "C" {
+  using namespace BOOM;
+
+  // Estimate the memory needed to fit a bsts model, without fitting it.
+  //
+  // Args:
+  //   r_dimensions: An integer vector containing the time dimension, the
+  //     state dimension, the number of state models, the number of
+  //     regression predictors, and the number of MCMC iterations.
+  //   r_options: A logical vector indicating whether the Kalman filters keep
+  //     the state variance at each time point, and whether state
+  //     contributions, prediction errors, and the full state are saved.
+  //
+  // Returns:
+  //   A named numeric vector giving the number of bytes in each category of
+  //   the estimate.
+  SEXP analysis_common_r_bsts_estimate_memory_(
+      SEXP r_dimensions,
+      SEXP r_options) {
+    RMemoryProtector protector;
+    try {
+      std::vector<int> dims = ToIntVector(r_dimensions);
+      std::vector<bool> flags = ToVectorBool(r_options);
+      if (dims.size() != 5 || flags.size() != 4) {
+        report_error("Wrong number of arguments passed to the bsts memory "
+                     "estimator.");
+      }
+      StateSpaceMemoryOptions options;
+      options.time_dimension = dims[0];
+      options.state_dimension = dims[1];
+      options.number_of_state_models = dims[2];
+      options.xdim = dims[3];
+      options.niter = dims[4];
+      options.keep_state_variances = flags[0];
+      options.save_state_contributions = flags[1];
+      options.save_prediction_errors = flags[2];
+      options.save_full_state = flags[3];
+
+      MemoryFootprint estimate = EstimateStateSpaceMemory(options);
+      Vector bytes;
+      std::vector<std::string> categories;
+      for (const auto &it : estimate.categories()) {
+        categories.push_back(it.first);
+        bytes.push_back(it.second);
+      }
+      SEXP ans = protector.protect(ToRVector(bytes));
+      return setListNames(ans, categories);
+    } catch (std::exception &e) {
+      RInterface::handle_exception(e);
+    } catch (...) {
+      RInterface::handle_unknown_exception();
+    }
+    return R_NilValue;
+  }
+
+}  // extern "C"
@@ -107,51 +107,43 @@ namespace BOOM {
         SEXP r_data_list,
         SEXP r_state_specification,
         SEXP r_prior,
-        SEXP r_options,
+        const BstsOptions &options,
         RListIoManager *io_manager) {
       ScalarStateSpaceModelBase *model = CreateBareModel(
           r_data_list,
           r_prior,
-          r_options,
+          options,
           io_manager);
       StateModelFactory state_model_factory(io_manager);
       state_model_factory.AddState(model, r_state_specification, "");
       state_model_factory.SaveFinalState(model, &final_state());
 
-      // The predict method does not set BstsOptions, so allow NULL here to
-      // signal that options have not been set.
-      if (!Rf_isNull(r_options)) {
-        bool save_state_contribution = Rf_asLogical(getListElement(
-            r_options, "save.state.contributions"));
-        if (save_state_contribution) {
-          io_manager->add_list_element(
-              new NativeMatrixListElement(
-                  new ScalarStateContributionCallback(model),
-                  "state.contributions",
-                  nullptr));
-        }
+      // The predict method does not set BstsOptions, so the options may be
+      // unspecified, in which case nothing extra is saved.
+      if (options.save_state_contributions()) {
+        io_manager->add_list_element(
+            new NativeMatrixListElement(
+                new ScalarStateContributionCallback(model),
+                "state.contributions",
+                nullptr));
+      }
 
-        bool save_prediction_errors = Rf_asLogical(getListElement(
-            r_options, "save.prediction.errors"));
-        if (save_prediction_errors) {
-          // The final nullptr argument is because we will not be streaming
-          // prediction errors in future calculations.  They are for reporting
-          // only.  As usual, the rows of the matrix correspond to MCMC
-          // iterations, so the columns represent time.
-          io_manager->add_list_element(
-              new BOOM::NativeVectorListElement(
-                  new PredictionErrorCallback(model),
-                  "one.step.prediction.errors",
-                  nullptr));
-        }
+      if (options.save_prediction_errors()) {
+        // The final nullptr argument is because we will not be streaming
+        // prediction errors in future calculations.  They are for reporting
+        // only.  As usual, the rows of the matrix correspond to MCMC
+        // iterations, so the columns represent time.
+        io_manager->add_list_element(
+            new BOOM::NativeVectorListElement(
+                new PredictionErrorCallback(model),
+                "one.step.prediction.errors",
+                nullptr));
+      }
 
-        bool save_full_state = Rf_asLogical(getListElement(
-            r_options, "save.full.state"));
-        if (save_full_state) {
-          io_manager->add_list_element(
-              new NativeMatrixListElement(
-                  new FullStateCallback(model), "full.state", nullptr));
-        }
+      if (options.save_full_state()) {
+        io_manager->add_list_element(
+            new NativeMatrixListElement(
+                new FullStateCallback(model), "full.state", nullptr));
       }
       return model;
     }
@@ -22,6 +22,7 @@
 #include "Models/StateSpace/StateSpaceModelBase.hpp"
 #include "Models/StateSpace/Multivariate/MultivariateStateSpaceModelBase.hpp"
 
+#include "bsts_options.h"
 #include "timestamp_info.h"
 
 namespace BOOM {
@@ -191,7 +192,7 @@ namespace BOOM {
       //     error in the observation equation.  For single parameter error
       //     distributions like binomial or Poisson this can be NULL.
       //   r_options: Model or family specific options such as the technique to
-      //     use for model averaging (ODA vs SVSS).
+      //     use for model averaging (ODA vs SVSS).  Parsed into a BstsOptions.
       //   io_manager: The io_manager responsible for writing MCMC output to an
       //     R object, or streaming it from an existing object.
       //
@@ -202,11 +203,22 @@ namespace BOOM {
       // Side Effects:
       //   The returned pointer is also held in a smart pointer owned by
       //   the child class.
-      virtual ScalarStateSpaceModelBase * CreateModel(
+      ScalarStateSpaceModelBase * CreateModel(
           SEXP r_data_list,
           SEXP r_state_specification,
           SEXP r_prior,
           SEXP r_options,
+          RListIoManager *io_manager) {
+        return CreateModel(r_data_list, r_state_specification, r_prior,
+                           BstsOptions(r_options), io_manager);
+      }
+
+      // As above, but with options that have already been parsed.
+      virtual ScalarStateSpaceModelBase * CreateModel(
+          SEXP r_data_list,
+          SEXP r_state_specification,
+          SEXP r_prior,
+          const BstsOptions &options,
           RListIoManager *io_manager);
 
       // Returns a HoldoutErrorSampler that holds a family specific
@@ -293,7 +305,7 @@ namespace BOOM {
       virtual ScalarStateSpaceModelBase * CreateBareModel(
           SEXP r_data_list,
           SEXP r_prior,
-          SEXP r_options,
+          const BstsOptions &options,
           RListIoManager *io_manager) = 0;
 
       // This function must not be called before UnpackForecastData.  It takes
@@ -0,0 +1,65 @@
+/*
+  Copyright (C) 2005-2024 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include "r_interface/boom_r_tools.hpp"
+#include "r_interface/handle_exception.hpp"
+#include "Samplers/McmcProfiler.hpp"
+
+extern "C" {
+  using namespace BOOM;
+
+  // Turn MCMC phase profiling on or off.
+  //
+  // Args:
+  //   r_enable:  Logical scalar.  Should profiling be on?
+  //   r_reset:  Logical scalar.  If TRUE, previously recorded times are
+  //     discarded.
+  //
+  // Returns:
+  //   R_NilValue.
+  SEXP analysis_common_r_bsts_enable_profiling_(
+      SEXP r_enable,
+      SEXP r_reset) {
+    try {
+      if (Rf_asLogical(r_reset)) {
+        McmcProfiler::reset();
+      }
+      McmcProfiler::enable(Rf_asLogical(r_enable));
+    } catch (std::exception &e) {
+      RInterface::handle_exception(e);
+    } catch (...) {
+      RInterface::handle_unknown_exception();
+    }
+    return R_NilValue;
+  }
+
+  // Returns:
+  //   A matrix with one row per MCMC phase, and columns giving the total
+  //   seconds and the number of calls recorded for each phase.
+  SEXP analysis_common_r_bsts_profile_report_() {
+    try {
+      return ToRMatrix(McmcProfiler::report());
+    } catch (std::exception &e) {
+      RInterface::handle_exception(e);
+    } catch (...) {
+      RInterface::handle_unknown_exception();
+    }
+    return R_NilValue;
+  }
+
+}  // extern "C"
@@ -28,13 +28,13 @@ ScalarStateSpaceModelBase * GaussianModelManagerBase::CreateModel(
     SEXP r_data_list,
     SEXP r_state_specification,
     SEXP r_prior,
-    SEXP r_options,
+    const BstsOptions &options,
     RListIoManager *io_manager) {
   ScalarStateSpaceModelBase *model = ScalarModelManager::CreateModel(
       r_data_list,
       r_state_specification,
       r_prior,
-      r_options,
+      options,
       io_manager);
 
   // It is only possible to compute log likelihood for Gaussian models.
@@ -49,7 +49,7 @@ ScalarStateSpaceModelBase * GaussianModelManagerBase::CreateModel(
 StateSpaceModel * StateSpaceModelManager::CreateBareModel(
     SEXP r_data_list,
     SEXP r_prior,
-    SEXP r_options,
+    const BstsOptions &options,
     RListIoManager *io_manager) {
   model_.reset(new StateSpaceModel);
   // If the model is being created from scratch for the purpose of
@@ -85,8 +85,7 @@ StateSpaceModel * StateSpaceModelManager::CreateBareModel(
 
     Ptr<StateSpacePosteriorSampler> sampler(
         new StateSpacePosteriorSampler(model_.get()));
-    if (!Rf_isNull(r_options)
-        && !Rf_asLogical(getListElement(r_options, "enable.threads"))) {
+    if (!options.enable_threads()) {
       sampler->disable_threads();
     }
     model_->set_method(sampler);
@@ -29,11 +29,12 @@ namespace bsts {
 // non-regression flavors of Gaussian models.
 class GaussianModelManagerBase : public ScalarModelManager {
  public:
+  using ScalarModelManager::CreateModel;
   ScalarStateSpaceModelBase * CreateModel(
       SEXP r_data_list,
       SEXP r_state_specification,
       SEXP r_prior,
-      SEXP r_options,
+      const BstsOptions &options,
       RListIoManager *io_manager) override;
 };
 
@@ -72,12 +73,12 @@ class StateSpaceModelManager
   //   r_data_list: Contains a numeric vector named 'response' and a
   //     logical vector 'response.is.observed.'
   //   r_prior:  An R object of class SdPrior.
-  //   r_options:  Not used.
+  //   options:  Only enable_threads() is used.
   //   io_manager:  The io_manager that will record the MCMC draws.
   StateSpaceModel * CreateBareModel(
       SEXP r_data_list,
       SEXP r_prior,
-      SEXP r_options,
+      const BstsOptions &options,
       RListIoManager *io_manager) override;
 
   HoldoutErrorSampler CreateHoldoutSampler(
@@ -32,7 +32,7 @@ StateSpaceLogitModelManager::StateSpaceLogitModelManager()
 StateSpaceLogitModel * StateSpaceLogitModelManager::CreateBareModel(
     SEXP r_data_list,
     SEXP r_prior,
-    SEXP r_options,
+    const BstsOptions &options,
     RListIoManager *io_manager) {
 
   if (!Rf_isNull(r_data_list)) {
@@ -100,11 +100,8 @@ StateSpaceLogitModel * StateSpaceLogitModelManager::CreateBareModel(
   // is documented in the source for the BinomialLogitAuxMixSampler
   // constructor (which is a base class for
   // BinomialLogitSpikeSlabSampler).
-  if (!Rf_isNull(r_options)) {
-    SEXP r_clt_threshold = getListElement(r_options, "clt.threshold");
-    if (!Rf_isNull(r_clt_threshold)) {
-      clt_threshold_ = Rf_asInteger(r_clt_threshold);
-    }
+  if (options.clt_threshold() >= 0) {
+    clt_threshold_ = options.clt_threshold();
   }
 
   Ptr<BinomialLogitSpikeSlabSampler> observation_model_sampler;
@@ -147,8 +144,7 @@ StateSpaceLogitModel * StateSpaceLogitModelManager::CreateBareModel(
       new StateSpaceLogitPosteriorSampler(
           model_.get(),
           observation_model_sampler));
-  if (!Rf_isNull(r_options)
-      && !Rf_asLogical(getListElement(r_options, "enable.threads"))) {
+  if (!options.enable_threads()) {
     sampler->disable_threads();
   }
   model_->set_method(sampler);
@@ -38,14 +38,14 @@ class StateSpaceLogitModelManager
   //   r_prior: Can be R_NilValue if the model has no regression
   //     component (or the model is not being created for MCMC).
   //     Otherwise this should be SpikeSlabGlmPrior.
-  //   r_options: A list containing "clt.threshold" for use with the
-  //     MCMC sampler.  Can be NULL.
+  //   options: Supplies clt_threshold() and enable_threads() for use with
+  //     the MCMC sampler.  Can be unspecified.
   //   io_manager: The io_manager that will link the MCMC draws to the
   //     R list receiving them.
   StateSpaceLogitModel * CreateBareModel(
       SEXP r_data_list,
       SEXP r_prior,
-      SEXP r_options,
+      const BstsOptions &options,
       RListIoManager *io_manager) override;
 
   HoldoutErrorSampler CreateHoldoutSampler(SEXP, int, bool, Matrix *) override {
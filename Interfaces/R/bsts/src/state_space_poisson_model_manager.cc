@@ -50,7 +50,7 @@ SSPMM::StateSpacePoissonModelManager()
 StateSpacePoissonModel * SSPMM::CreateBareModel(
       SEXP r_data_list,
       SEXP r_prior,
-      SEXP r_options,
+      const BstsOptions &options,
       RListIoManager *io_manager) {
   if (!Rf_isNull(r_data_list)) {
     // If we were passed data from R then build the model using the
@@ -152,8 +152,7 @@ StateSpacePoissonModel * SSPMM::CreateBareModel(
           model_.get(),
           observation_model_sampler));
 
-  if (!Rf_isNull(r_options)
-      && !Rf_asLogical(getListElement(r_options, "enable.threads"))) {
+  if (!options.enable_threads()) {
     sampler->disable_threads();
   }
 
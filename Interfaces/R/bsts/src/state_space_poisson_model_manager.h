@@ -33,7 +33,7 @@ class StateSpacePoissonModelManager
   StateSpacePoissonModel * CreateBareModel(
       SEXP r_data_list,
       SEXP r_prior,
-      SEXP r_options,
+      const BstsOptions &options,
       RListIoManager *io_manager) override;
 
   HoldoutErrorSampler CreateHoldoutSampler(SEXP, int, bool, Matrix *) override {
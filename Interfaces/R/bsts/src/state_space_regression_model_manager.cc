@@ -40,7 +40,7 @@ namespace BOOM {
     StateSpaceRegressionModel * SSRMF::CreateBareModel(
         SEXP r_data_list,
         SEXP r_prior,
-        SEXP r_options,
+        const BstsOptions &options,
         RListIoManager *io_manager) {
       Matrix predictors;
       Vector response;
@@ -99,11 +99,10 @@ namespace BOOM {
 
       // A NULL r_prior signals that no posterior sampler is needed.
       if (!Rf_isNull(r_prior)) {
-        SetRegressionSampler(r_prior, r_options);
+        SetRegressionSampler(r_prior, options);
         Ptr<StateSpacePosteriorSampler> sampler(
             new StateSpacePosteriorSampler(model_.get()));
-        if (!Rf_isNull(r_options)
-            && !Rf_asLogical(getListElement(r_options, "enable.threads"))) {
+        if (!options.enable_threads()) {
           sampler->disable_threads();
         }
         model_->set_method(sampler);
@@ -155,21 +154,18 @@ namespace BOOM {
     }
 
     void SSRMF::SetRegressionSampler(SEXP r_regression_prior,
-                                     SEXP r_options) {
-      // If either the prior object or the bma method is NULL then take
+                                     const BstsOptions &options) {
+      // If either the prior object or the bma method is missing then take
       // that as a signal the model is not being specified for the
       // purposes of MCMC, and bail out.
-      if (Rf_isNull(r_regression_prior)
-          || Rf_isNull(r_options)
-          || Rf_isNull(getListElement(r_options, "bma.method"))) {
+      if (Rf_isNull(r_regression_prior) || options.bma_method().empty()) {
         return;
       }
-      std::string bma_method = BOOM::ToString(getListElement(
-          r_options, "bma.method"));
+      const std::string &bma_method(options.bma_method());
       if (bma_method == "SSVS") {
         SetSsvsRegressionSampler(r_regression_prior);
       } else if (bma_method == "ODA") {
-        SetOdaRegressionSampler(r_regression_prior, r_options);
+        SetOdaRegressionSampler(r_regression_prior, options);
       } else {
         std::ostringstream err;
         err << "Unrecognized value of bma_method: " << bma_method;
@@ -196,18 +192,11 @@ namespace BOOM {
     }
 
     void SSRMF::SetOdaRegressionSampler(SEXP r_regression_prior,
-                                        SEXP r_options) {
-      SEXP r_oda_options = getListElement(r_options, "oda.options");
+                                        const BstsOptions &options) {
       BOOM::RInterface::IndependentRegressionSpikeSlabPrior prior(
           r_regression_prior, model_->regression_model()->Sigsq_prm());
-      double eigenvalue_fudge_factor = 0.001;
-      double fallback_probability = 0.0;
-      if (!Rf_isNull(r_oda_options)) {
-        eigenvalue_fudge_factor = Rf_asReal(
-            getListElement(r_oda_options, "eigenvalue.fudge.factor"));
-        fallback_probability = Rf_asReal(
-            getListElement(r_oda_options, "fallback.probability"));
-      }
+      double eigenvalue_fudge_factor = options.oda_eigenvalue_fudge_factor();
+      double fallback_probability = options.oda_fallback_probability();
       Ptr<SpikeSlabDaRegressionSampler> sampler(
           new SpikeSlabDaRegressionSampler(
               model_->regression_model().get(),
@@ -67,7 +67,7 @@ class StateSpaceRegressionModelManager
   StateSpaceRegressionModel * CreateBareModel(
       SEXP r_data_list,
       SEXP r_prior,
-      SEXP r_options,
+      const BstsOptions &options,
       RListIoManager *io_manager) override;
 
   HoldoutErrorSampler CreateHoldoutSampler(
@@ -93,21 +93,21 @@ class StateSpaceRegressionModelManager
   //     is not being created for the purposes of learning (e.g. if an
   //     already learned model is being reinstantiated for purposes of
   //     forecasting or diagnostics).
-  //   r_options: A list that must contain the following elements if the
-  //     object is being constructed for learning.
-  //     * bma.method: An R string specifying whether "SSVS"
-  //         (stochastic search variable selection: George and
-  //         McCulloch 1997 statistica sinica) or "ODA" (orthoganal
-  //         data augmentation, Ghosh and Clyde 2012 JASA) should be
-  //         used for Bayesian model averaging.  Can also be
-  //         R_NilValue if the model is not being specified for MCMC.
-  //     * oda.options: If the bma.method == "ODA" then this is a list
-  //         containing "eigenvalue_fudge_factor" and
-  //         "fallback_probability".  See the bsts documentation for
+  //   options: The following options are used if the object is being
+  //     constructed for learning.
+  //     * bma_method: Whether "SSVS" (stochastic search variable
+  //         selection: George and McCulloch 1997 statistica sinica) or
+  //         "ODA" (orthoganal data augmentation, Ghosh and Clyde 2012
+  //         JASA) should be used for Bayesian model averaging.  Empty if
+  //         the model is not being specified for MCMC.
+  //     * oda_eigenvalue_fudge_factor and oda_fallback_probability: Used
+  //         if bma_method is "ODA".  See the bsts documentation for
   //         details.
-  void SetRegressionSampler(SEXP r_regression_prior, SEXP r_options);
+  void SetRegressionSampler(SEXP r_regression_prior,
+                            const BstsOptions &options);
   void SetSsvsRegressionSampler(SEXP r_regression_prior);
-  void SetOdaRegressionSampler(SEXP r_regression_prior, SEXP r_options);
+  void SetOdaRegressionSampler(SEXP r_regression_prior,
+                               const BstsOptions &options);
 
   void AddData(const Vector &response,
                const Matrix &predictors,
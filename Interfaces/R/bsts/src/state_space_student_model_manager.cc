@@ -34,7 +34,7 @@ namespace BOOM {
     StateSpaceStudentRegressionModel * SSSMM::CreateBareModel(
         SEXP r_data_list,
         SEXP r_prior,
-        SEXP r_options,
+        const BstsOptions &options,
         RListIoManager *io_manager) {
       Matrix predictors;
       Vector response;
@@ -132,8 +132,7 @@ namespace BOOM {
             new StateSpaceStudentPosteriorSampler(
                 model_.get(),
                 observation_model_sampler));
-        if (!Rf_isNull(r_options)
-            && !Rf_asLogical(getListElement(r_options, "enable.threads"))) {
+        if (!options.enable_threads()) {
           sampler->disable_threads();
         }
         model_->set_method(sampler);
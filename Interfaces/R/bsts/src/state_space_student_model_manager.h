@@ -87,7 +87,7 @@ namespace BOOM {
       StateSpaceStudentRegressionModel * CreateBareModel(
           SEXP r_data_list,
           SEXP r_prior,
-          SEXP r_options,
+          const BstsOptions &options,
           RListIoManager *io_manager) override;
 
       HoldoutErrorSampler CreateHoldoutSampler(
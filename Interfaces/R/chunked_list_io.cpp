@@ -0,0 +1,378 @@
+// Copyright 2018 Google LLC. All Rights Reserved.
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+
+
+#include "r_interface/chunked_list_io.hpp"
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+#include "r_interface/boom_r_tools.hpp"
+#include "cpputil/report_error.hpp"
+
+namespace BOOM {
+
+  namespace {
+    const char header_magic[] = "BOOMCOL1";
+    const char index_magic[] = "BOOMIDX1";
+    const int magic_size = 8;
+
+    template <class T>
+    void write_binary(std::ofstream &out, const T &value) {
+      out.write(reinterpret_cast<const char *>(&value), sizeof(T));
+    }
+
+    template <class T>
+    T read_binary(std::ifstream &in) {
+      T value;
+      in.read(reinterpret_cast<char *>(&value), sizeof(T));
+      if (!in) {
+        report_error("Unexpected end of MCMC output file.");
+      }
+      return value;
+    }
+
+    void check_magic(std::ifstream &in, const char *magic) {
+      char buffer[magic_size];
+      in.read(buffer, magic_size);
+      if (!in || std::memcmp(buffer, magic, magic_size) != 0) {
+        report_error("File is not in the format written by "
+                     "RListIoFileWriter.");
+      }
+    }
+
+    // The dimensions of a single draw stored in an R buffer whose leading
+    // dimension is MCMC iteration.
+    std::vector<int> draw_dims(SEXP buffer) {
+      std::vector<int> ans;
+      SEXP r_dims = Rf_getAttrib(buffer, R_DimSymbol);
+      if (Rf_isNull(r_dims)) {
+        return ans;
+      }
+      for (int i = 1; i < Rf_length(r_dims); ++i) {
+        ans.push_back(INTEGER(r_dims)[i]);
+      }
+      return ans;
+    }
+  }  // namespace
+
+  //===========================================================================
+  RListIoFileWriter::RListIoFileWriter(int chunk_size)
+      : chunk_size_(chunk_size),
+        chunk_buffers_(R_NilValue),
+        position_in_chunk_(0),
+        number_of_draws_(0) {
+    if (chunk_size_ <= 0) {
+      report_error("chunk_size must be positive.");
+    }
+  }
+
+  RListIoFileWriter::~RListIoFileWriter() {
+    if (output_.is_open()) {
+      close();
+    }
+    release_buffers();
+  }
+
+  void RListIoFileWriter::add_list_element(RListIoElement *element) {
+    elements_.push_back(Ptr<RListIoElement>(element));
+  }
+
+  void RListIoFileWriter::add_list_element(
+      const Ptr<RListIoElement> &element) {
+    elements_.push_back(element);
+  }
+
+  void RListIoFileWriter::open(const std::string &filename) {
+    if (output_.is_open()) {
+      close();
+    }
+    release_buffers();
+    output_.open(filename, std::ios::binary | std::ios::trunc);
+    if (!output_) {
+      report_error("Could not open " + filename + " for writing.");
+    }
+    chunk_offsets_.clear();
+    chunk_lengths_.clear();
+    position_in_chunk_ = 0;
+    number_of_draws_ = 0;
+
+    RMemoryProtector protector;
+    chunk_buffers_ = protector.protect(
+        Rf_allocVector(VECSXP, elements_.size()));
+    R_PreserveObject(chunk_buffers_);
+
+    output_.write(header_magic, magic_size);
+    write_binary<std::int32_t>(output_, elements_.size());
+    write_binary<std::int32_t>(output_, chunk_size_);
+    element_sizes_.clear();
+    for (int i = 0; i < elements_.size(); ++i) {
+      SEXP buffer = elements_[i]->prepare_to_write(chunk_size_);
+      SET_VECTOR_ELT(chunk_buffers_, i, buffer);
+      if (!Rf_isReal(buffer)) {
+        report_error("List element " + elements_[i]->name() +
+                     " does not store numeric draws, so it cannot be "
+                     "written to a file.");
+      }
+      std::vector<int> dims = draw_dims(buffer);
+      element_sizes_.push_back(Rf_length(buffer) / chunk_size_);
+      const std::string &name(elements_[i]->name());
+      write_binary<std::int32_t>(output_, name.size());
+      output_.write(name.data(), name.size());
+      write_binary<std::int32_t>(output_, dims.size());
+      for (int d : dims) {
+        write_binary<std::int32_t>(output_, d);
+      }
+    }
+  }
+
+  void RListIoFileWriter::write() {
+    if (!output_.is_open()) {
+      report_error("RListIoFileWriter::open must be called before write.");
+    }
+    if (position_in_chunk_ == chunk_size_) {
+      flush_chunk();
+    }
+    for (auto &el : elements_) {
+      el->write();
+    }
+    ++position_in_chunk_;
+    ++number_of_draws_;
+  }
+
+  void RListIoFileWriter::close() {
+    if (!output_.is_open()) {
+      return;
+    }
+    flush_chunk();
+    std::int64_t index_offset = output_.tellp();
+    for (int i = 0; i < chunk_offsets_.size(); ++i) {
+      write_binary(output_, chunk_offsets_[i]);
+      write_binary(output_, chunk_lengths_[i]);
+    }
+    write_binary(output_, index_offset);
+    write_binary<std::int32_t>(output_, chunk_offsets_.size());
+    output_.write(index_magic, magic_size);
+    output_.close();
+    release_buffers();
+  }
+
+  void RListIoFileWriter::flush_chunk() {
+    if (position_in_chunk_ == 0) {
+      return;
+    }
+    chunk_offsets_.push_back(output_.tellp());
+    chunk_lengths_.push_back(position_in_chunk_);
+    write_binary<std::int32_t>(output_, position_in_chunk_);
+    for (int i = 0; i < elements_.size(); ++i) {
+      const double *data = REAL(VECTOR_ELT(chunk_buffers_, i));
+      if (position_in_chunk_ == chunk_size_) {
+        output_.write(reinterpret_cast<const char *>(data),
+                      sizeof(double) * chunk_size_ * element_sizes_[i]);
+      } else {
+        // A partial chunk.  Each of the element's values occupies a stretch
+        // of chunk_size_ doubles, of which only the first few are in use.
+        for (int j = 0; j < element_sizes_[i]; ++j) {
+          output_.write(
+              reinterpret_cast<const char *>(data + j * chunk_size_),
+              sizeof(double) * position_in_chunk_);
+        }
+      }
+      // Move the element back to the start of its buffer.
+      elements_[i]->advance(-position_in_chunk_);
+    }
+    if (!output_) {
+      report_error("Error writing MCMC output to file.");
+    }
+    position_in_chunk_ = 0;
+  }
+
+  void RListIoFileWriter::release_buffers() {
+    if (chunk_buffers_ != R_NilValue) {
+      R_ReleaseObject(chunk_buffers_);
+      chunk_buffers_ = R_NilValue;
+    }
+  }
+
+  //===========================================================================
+  RListIoFileReader::RListIoFileReader()
+      : number_of_draws_(0),
+        current_chunk_(-1),
+        chunk_buffers_(R_NilValue),
+        next_draw_(0) {}
+
+  RListIoFileReader::~RListIoFileReader() {
+    if (chunk_buffers_ != R_NilValue) {
+      R_ReleaseObject(chunk_buffers_);
+    }
+  }
+
+  void RListIoFileReader::add_list_element(RListIoElement *element) {
+    elements_.push_back(Ptr<RListIoElement>(element));
+  }
+
+  void RListIoFileReader::add_list_element(
+      const Ptr<RListIoElement> &element) {
+    elements_.push_back(element);
+  }
+
+  void RListIoFileReader::prepare_to_stream(const std::string &filename) {
+    if (input_.is_open()) {
+      input_.close();
+    }
+    input_.open(filename, std::ios::binary);
+    if (!input_) {
+      report_error("Could not open " + filename + " for reading.");
+    }
+    check_magic(input_, header_magic);
+    int number_of_elements = read_binary<std::int32_t>(input_);
+    read_binary<std::int32_t>(input_);  // The chunk size is not needed.
+    file_element_names_.clear();
+    file_element_dims_.clear();
+    file_element_sizes_.clear();
+    for (int i = 0; i < number_of_elements; ++i) {
+      std::string name(read_binary<std::int32_t>(input_), ' ');
+      input_.read(&name[0], name.size());
+      std::vector<int> dims(read_binary<std::int32_t>(input_));
+      int size = 1;
+      for (int &d : dims) {
+        d = read_binary<std::int32_t>(input_);
+        size *= d;
+      }
+      file_element_names_.push_back(name);
+      file_element_dims_.push_back(dims);
+      file_element_sizes_.push_back(size);
+    }
+
+    element_map_.clear();
+    for (const auto &el : elements_) {
+      auto it = std::find(file_element_names_.begin(),
+                          file_element_names_.end(), el->name());
+      if (it == file_element_names_.end()) {
+        report_error("List element " + el->name() + " was not found in " +
+                     filename + ".");
+      }
+      element_map_.push_back(it - file_element_names_.begin());
+    }
+
+    // Read the chunk index from the end of the file.
+    std::int64_t footer_size =
+        sizeof(std::int64_t) + sizeof(std::int32_t) + magic_size;
+    input_.seekg(-footer_size, std::ios::end);
+    std::int64_t index_offset = read_binary<std::int64_t>(input_);
+    int number_of_chunks = read_binary<std::int32_t>(input_);
+    check_magic(input_, index_magic);
+    input_.seekg(index_offset);
+    chunk_offsets_.clear();
+    chunk_lengths_.clear();
+    chunk_starts_.clear();
+    number_of_draws_ = 0;
+    for (int i = 0; i < number_of_chunks; ++i) {
+      chunk_offsets_.push_back(read_binary<std::int64_t>(input_));
+      chunk_lengths_.push_back(read_binary<std::int32_t>(input_));
+      chunk_starts_.push_back(number_of_draws_);
+      number_of_draws_ += chunk_lengths_.back();
+    }
+    current_chunk_ = -1;
+    next_draw_ = 0;
+  }
+
+  void RListIoFileReader::stream() {
+    if (next_draw_ >= number_of_draws_) {
+      std::ostringstream err;
+      err << "Attempt to stream draw " << next_draw_ << " from a file "
+          << "containing " << number_of_draws_ << " draws.";
+      report_error(err.str());
+    }
+    bool in_current_chunk =
+        current_chunk_ >= 0
+        && next_draw_ >= chunk_starts_[current_chunk_]
+        && next_draw_ < chunk_starts_[current_chunk_]
+                        + chunk_lengths_[current_chunk_];
+    if (!in_current_chunk) {
+      int chunk = std::upper_bound(chunk_starts_.begin(), chunk_starts_.end(),
+                                   next_draw_) - chunk_starts_.begin() - 1;
+      load_chunk(chunk);
+      for (auto &el : elements_) {
+        el->advance(next_draw_ - chunk_starts_[chunk]);
+      }
+    }
+    for (auto &el : elements_) {
+      el->stream();
+    }
+    ++next_draw_;
+  }
+
+  void RListIoFileReader::advance(int n) {
+    next_draw_ += n;
+    if (current_chunk_ >= 0) {
+      for (auto &el : elements_) {
+        el->advance(n);
+      }
+    }
+  }
+
+  void RListIoFileReader::load_chunk(int chunk) {
+    input_.seekg(chunk_offsets_[chunk]);
+    int ndraws = read_binary<std::int32_t>(input_);
+    if (ndraws != chunk_lengths_[chunk]) {
+      report_error("MCMC output file is corrupt.");
+    }
+
+    RMemoryProtector protector;
+    SEXP buffers = protector.protect(
+        Rf_allocVector(VECSXP, elements_.size()));
+    SEXP buffer_names = protector.protect(
+        Rf_allocVector(STRSXP, elements_.size()));
+    std::int64_t position = chunk_offsets_[chunk] + sizeof(std::int32_t);
+    for (int file_element = 0; file_element < file_element_sizes_.size();
+         ++file_element) {
+      std::int64_t block_size =
+          sizeof(double) * ndraws * file_element_sizes_[file_element];
+      for (int i = 0; i < elements_.size(); ++i) {
+        if (element_map_[i] != file_element) continue;
+        const std::vector<int> &dims(file_element_dims_[file_element]);
+        SEXP r_dims = protector.protect(
+            Rf_allocVector(INTSXP, dims.size() + 1));
+        INTEGER(r_dims)[0] = ndraws;
+        std::copy(dims.begin(), dims.end(), INTEGER(r_dims) + 1);
+        SEXP buffer = dims.empty()
+            ? Rf_allocVector(REALSXP, ndraws)
+            : Rf_allocArray(REALSXP, r_dims);
+        SET_VECTOR_ELT(buffers, i, buffer);
+        SET_STRING_ELT(buffer_names, i,
+                       Rf_mkChar(elements_[i]->name().c_str()));
+        input_.seekg(position);
+        input_.read(reinterpret_cast<char *>(REAL(buffer)), block_size);
+        if (!input_) {
+          report_error("Unexpected end of MCMC output file.");
+        }
+      }
+      position += block_size;
+    }
+    Rf_namesgets(buffers, buffer_names);
+
+    if (chunk_buffers_ != R_NilValue) {
+      R_ReleaseObject(chunk_buffers_);
+    }
+    chunk_buffers_ = buffers;
+    R_PreserveObject(chunk_buffers_);
+    for (auto &el : elements_) {
+      el->prepare_to_stream(chunk_buffers_);
+    }
+    current_chunk_ = chunk;
+  }
+
+}  // namespace BOOM
@@ -0,0 +1,204 @@
+// Copyright 2018 Google LLC. All Rights Reserved.
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+
+
+#ifndef BOOM_R_CHUNKED_LIST_IO_HPP_
+#define BOOM_R_CHUNKED_LIST_IO_HPP_
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "r_interface/list_io.hpp"
+#include "cpputil/Ptr.hpp"
+
+//===========================================================================
+// File based storage for MCMC output managed by RListIoElement objects.
+//
+// RListIoManager keeps every draw in memory, inside R objects allocated by
+// prepare_to_write(niter).  For long runs with large parameters (e.g. bsts
+// state contributions) that can exhaust memory.  The classes here keep only
+// one chunk of draws in memory, and stream completed chunks to a binary file.
+//
+// File layout (native byte order, doubles in IEEE format):
+//   Header:
+//     char[8]   "BOOMCOL1"
+//     int32     number of elements
+//     int32     chunk size
+//     For each element:
+//       int32   length of the element name, followed by the name.
+//       int32   number of dimensions (excluding MCMC iteration).
+//       int32[] the dimensions.
+//   Chunks, each holding up to 'chunk size' draws:
+//     int32     number of draws in the chunk (n).
+//     For each element, n x (product of dims) doubles, in the same
+//     iteration-major order used by the R object for that element.  Each
+//     element's block is contiguous, so the file is columnar within a chunk.
+//   Chunk index:
+//     For each chunk: int64 file offset, int32 number of draws.
+//     int64     file offset of the chunk index.
+//     int32     number of chunks.
+//     char[8]   "BOOMIDX1"
+//
+// Only elements that store their draws in a single numeric R object are
+// supported.  Elements such as SubordinateModelIoElement, which manage
+// lists, cannot be written to a file.
+// ===========================================================================
+
+namespace BOOM {
+
+  // Writes MCMC output to a file, one chunk at a time.  The idiom mirrors
+  // RListIoManager:
+  //
+  //   RListIoFileWriter writer(500);
+  //   writer.add_list_element(new VectorListElement(...));
+  //   writer.open("draws.boom");
+  //   for (int i = 0; i < niter; ++i) {
+  //     do_an_mcmc_iteration();
+  //     writer.write();
+  //   }
+  //   writer.close();
+  //
+  // Memory use is proportional to the chunk size rather than niter.
+  class RListIoFileWriter {
+   public:
+    // Args:
+    //   chunk_size:  The number of draws held in memory between writes.
+    explicit RListIoFileWriter(int chunk_size = 1000);
+
+    // Closes the file if it is still open.
+    ~RListIoFileWriter();
+
+    RListIoFileWriter(const RListIoFileWriter &rhs) = delete;
+    RListIoFileWriter &operator=(const RListIoFileWriter &rhs) = delete;
+
+    void add_list_element(RListIoElement *element);
+    void add_list_element(const Ptr<RListIoElement> &element);
+
+    // Create (or truncate) the named file, allocate a chunk of storage for
+    // each element, and write the file header.
+    void open(const std::string &filename);
+
+    // Each element writes its current value to the chunk buffer.  A full
+    // buffer is written to the file.
+    void write();
+
+    // Write any buffered draws and the chunk index, and close the file.
+    void close();
+
+    // The number of calls to write() since open().
+    int number_of_draws() const { return number_of_draws_; }
+
+   private:
+    // Write the draws in the chunk buffer to the file, and reset the element
+    // positions to the start of the buffer.
+    void flush_chunk();
+
+    // Release the R objects holding the chunk buffer.
+    void release_buffers();
+
+    std::vector<Ptr<RListIoElement>> elements_;
+    int chunk_size_;
+
+    // An R list holding one chunk of storage for each element.  It is
+    // protected by R_PreserveObject while the file is open.
+    SEXP chunk_buffers_;
+
+    // The number of doubles occupied by a single draw of each element.
+    std::vector<int> element_sizes_;
+
+    std::ofstream output_;
+    std::vector<std::int64_t> chunk_offsets_;
+    std::vector<std::int32_t> chunk_lengths_;
+    int position_in_chunk_;
+    int number_of_draws_;
+  };
+
+  //===========================================================================
+  // Streams MCMC output from a file created by RListIoFileWriter, for use
+  // in prediction code that would otherwise stream from an R list using
+  // RListIoManager::prepare_to_stream().  Only one chunk is held in memory.
+  //
+  //   RListIoFileReader reader;
+  //   reader.add_list_element(new VectorListElement(...));
+  //   reader.prepare_to_stream("draws.boom");
+  //   reader.advance(burn);
+  //   for (int i = burn; i < reader.number_of_draws(); ++i) {
+  //     reader.stream();
+  //     do_something_with_the_current_value();
+  //   }
+  //
+  // The registered elements must have the same names as elements in the
+  // file, but need not include all of them.
+  class RListIoFileReader {
+   public:
+    RListIoFileReader();
+    ~RListIoFileReader();
+
+    RListIoFileReader(const RListIoFileReader &rhs) = delete;
+    RListIoFileReader &operator=(const RListIoFileReader &rhs) = delete;
+
+    void add_list_element(RListIoElement *element);
+    void add_list_element(const Ptr<RListIoElement> &element);
+
+    // Open the named file and read its header and chunk index.  The next
+    // call to stream() reads the first draw.
+    void prepare_to_stream(const std::string &filename);
+
+    // Each element reads its next value.
+    void stream();
+
+    // Skip the next n draws.  Skipped chunks are never read.
+    void advance(int n);
+
+    // The total number of draws stored in the file.
+    int number_of_draws() const { return number_of_draws_; }
+
+   private:
+    // Read the chunk containing the draw 'next_draw_' and point the elements
+    // at it.
+    void load_chunk(int chunk);
+
+    std::vector<Ptr<RListIoElement>> elements_;
+
+    // Information about the elements stored in the file.
+    std::vector<std::string> file_element_names_;
+    std::vector<std::vector<int>> file_element_dims_;
+    std::vector<int> file_element_sizes_;
+
+    // For each registered element, the index of the file element that
+    // supplies its draws.
+    std::vector<int> element_map_;
+
+    std::ifstream input_;
+    std::vector<std::int64_t> chunk_offsets_;
+    std::vector<std::int32_t> chunk_lengths_;
+    std::vector<int> chunk_starts_;
+    int number_of_draws_;
+
+    // The index of the chunk held in memory, or -1.
+    int current_chunk_;
+    // The R list holding the current chunk, protected by R_PreserveObject.
+    SEXP chunk_buffers_;
+
+    // The index of the next draw to be streamed.
+    int next_draw_;
+  };
+
+}  // namespace BOOM
+
+#endif  // BOOM_R_CHUNKED_LIST_IO_HPP_
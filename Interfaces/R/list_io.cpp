@@ -14,12 +14,14 @@
 // License along with this library; if not, write to the Free Software
 // Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
 
+#include <algorithm>
 #include <string>
 #include "r_interface/list_io.hpp"
 #include "r_interface/boom_r_tools.hpp"
 #include "cpputil/math_utils.hpp"
 #include "cpputil/string_utils.hpp"
 #include "cpputil/report_error.hpp"
+#include "Samplers/McmcProfiler.hpp"
 
 namespace BOOM {
 
@@ -32,6 +34,7 @@ namespace BOOM {
   }
 
   SEXP RListIoManager::prepare_to_write(int niter) {
+    monitor_.reset();
     if (elements_.empty()) {
       return R_NilValue;
     }
@@ -46,9 +49,37 @@ namespace BOOM {
                      Rf_mkChar(elements_[i]->name().c_str()));
     }
     Rf_namesgets(ans, param_names);
+
+    if (!monitored_names_.empty()) {
+      monitored_elements_.clear();
+      int dimension = 0;
+      for (const auto &name : monitored_names_) {
+        int index = -1;
+        for (int i = 0; i < elements_.size(); ++i) {
+          if (elements_[i]->name() == name) {
+            index = i;
+            break;
+          }
+        }
+        if (index < 0) {
+          report_error("There is no list element named '" + name +
+                       "' to monitor for convergence.");
+        }
+        monitored_elements_.push_back(index);
+        dimension += elements_[index]->draw_size();
+      }
+      monitor_.reset(new McmcConvergenceMonitor(
+          1, dimension, monitor_max_batches_));
+    }
     return ans;
   }
 
+  void RListIoManager::monitor_convergence(
+      const std::vector<std::string> &element_names, int max_batches) {
+    monitored_names_ = element_names;
+    monitor_max_batches_ = max_batches;
+  }
+
   void RListIoManager::prepare_to_stream(SEXP object) {
     if (elements_.empty()) {
       return;
@@ -60,9 +91,17 @@ namespace BOOM {
   }
 
   void RListIoManager::write() {
+    ScopedPhaseTimer timer(McmcProfiler::kIoWrite);
     for (int i = 0; i < elements_.size(); ++i) {
       elements_[i]->write();
     }
+    if (monitor_) {
+      Vector draw;
+      for (int i : monitored_elements_) {
+        draw.concat(elements_[i]->most_recent_draw());
+      }
+      monitor_->add(0, draw);
+    }
   }
 
   void RListIoManager::stream() {
@@ -85,8 +124,20 @@ namespace BOOM {
     return ans;
   }
 
+  MemoryFootprint RListIoManager::memory_footprint() const {
+    std::size_t bytes = 0;
+    for (const auto &el : elements_) {
+      bytes += el->buffer_bytes();
+    }
+    return MemoryFootprint(MemoryFootprint::kMcmcOutput, bytes);
+  }
+
   //======================================================================
-  RListIoElement::RListIoElement(const std::string &name) : name_(name) {}
+  RListIoElement::RListIoElement(const std::string &name)
+      : name_(name),
+        rbuffer_(R_NilValue),
+        position_(0),
+        data_(nullptr) {}
 
   RListIoElement::~RListIoElement() {}
 
@@ -106,6 +157,34 @@ namespace BOOM {
 
   void RListIoElement::advance(int n) {position_ += n;}
 
+  int RListIoElement::draw_size() const {
+    report_error("List element '" + name_ + "' does not store real-valued "
+                 "draws.");
+    return 0;
+  }
+
+  Vector RListIoElement::most_recent_draw() const {
+    report_error("List element '" + name_ + "' does not store real-valued "
+                 "draws.");
+    return Vector();
+  }
+
+  std::size_t RListIoElement::buffer_bytes() const {
+    if (Rf_isNull(rbuffer_)) {
+      return 0;
+    }
+    std::size_t length = Rf_xlength(rbuffer_);
+    switch (TYPEOF(rbuffer_)) {
+      case REALSXP:
+        return length * sizeof(double);
+      case INTSXP:
+      case LGLSXP:
+        return length * sizeof(int);
+      default:
+        return 0;
+    }
+  }
+
   int RListIoElement::next_position() {
     return position_++;
   }
@@ -188,6 +267,35 @@ namespace BOOM {
     RListIoElement::StoreBuffer(buf);
   }
 
+  namespace {
+    // The number of MCMC iterations held by a buffer whose leading dimension
+    // is the iteration number.
+    int buffer_niter(SEXP buffer) {
+      SEXP dims = Rf_getAttrib(buffer, R_DimSymbol);
+      return Rf_isNull(dims) ? Rf_length(buffer) : INTEGER(dims)[0];
+    }
+  }  // namespace
+
+  int RealValuedRListIoElement::draw_size() const {
+    int niter = buffer_niter(rbuffer());
+    return niter > 0 ? Rf_length(rbuffer()) / niter : 0;
+  }
+
+  Vector RealValuedRListIoElement::most_recent_draw() const {
+    int iteration = position() - 1;
+    if (iteration < 0) {
+      report_error("No draws have been written to list element '" + name()
+                   + "'.");
+    }
+    int niter = buffer_niter(rbuffer());
+    int dim = draw_size();
+    Vector ans(dim);
+    for (int i = 0; i < dim; ++i) {
+      ans[i] = data_[iteration + i * niter];
+    }
+    return ans;
+  }
+
   //======================================================================
   SEXP VectorValuedRListIoElement::prepare_to_write(int niter) {
     RMemoryProtector protector;
@@ -851,4 +959,155 @@ namespace BOOM {
     }
   }
 
+  //======================================================================
+  ThinnedListElement::ThinnedListElement(const Ptr<RListIoElement> &element,
+                                         int thin)
+      : RListIoElement(element->name()),
+        element_(element),
+        thin_(thin),
+        iteration_(0) {
+    if (thin_ < 1) {
+      report_error("thin must be at least 1.");
+    }
+  }
+
+  SEXP ThinnedListElement::prepare_to_write(int niter) {
+    iteration_ = 0;
+    return element_->prepare_to_write(number_stored(niter));
+  }
+
+  void ThinnedListElement::prepare_to_stream(SEXP object) {
+    iteration_ = 0;
+    element_->prepare_to_stream(object);
+  }
+
+  void ThinnedListElement::write() {
+    if (iteration_++ % thin_ == 0) {
+      element_->write();
+    }
+  }
+
+  void ThinnedListElement::stream() {
+    if (iteration_++ % thin_ == 0) {
+      element_->stream();
+    }
+  }
+
+  void ThinnedListElement::advance(int n) {
+    element_->advance(number_stored(iteration_ + n) -
+                      number_stored(iteration_));
+    iteration_ += n;
+  }
+
+  //======================================================================
+  PosteriorSummaryListElement::PosteriorSummaryListElement(
+      const Ptr<RListIoElement> &element, const Vector &probs)
+      : RListIoElement(element->name()),
+        element_(element),
+        probs_(probs),
+        draw_buffer_(R_NilValue),
+        niter_(0),
+        number_of_draws_(0),
+        mean_data_(nullptr),
+        quantile_data_(nullptr) {
+    std::sort(probs_.begin(), probs_.end());
+    if (probs_.empty() || probs_[0] < 0 || probs_.back() > 1) {
+      report_error("Quantile probabilities must be in [0, 1].");
+    }
+  }
+
+  PosteriorSummaryListElement::~PosteriorSummaryListElement() {
+    if (draw_buffer_ != R_NilValue) {
+      R_ReleaseObject(draw_buffer_);
+    }
+  }
+
+  SEXP PosteriorSummaryListElement::prepare_to_write(int niter) {
+    niter_ = niter;
+    number_of_draws_ = 0;
+    if (draw_buffer_ != R_NilValue) {
+      R_ReleaseObject(draw_buffer_);
+    }
+    draw_buffer_ = element_->prepare_to_write(1);
+    R_PreserveObject(draw_buffer_);
+    if (!Rf_isReal(draw_buffer_)) {
+      report_error("Only numeric list elements can be summarized.");
+    }
+
+    // The dimensions of a single draw.  The leading dimension of the draw
+    // buffer is MCMC iteration, which is 1 here.
+    std::vector<int> dims;
+    SEXP r_dims = Rf_getAttrib(draw_buffer_, R_DimSymbol);
+    if (!Rf_isNull(r_dims)) {
+      dims = GetArrayDimensions(draw_buffer_);
+      dims.erase(dims.begin());
+    }
+    int size = Rf_length(draw_buffer_);
+    sum_.assign(size, 0.0);
+    quantile_agents_.assign(size, IQagent(probs_));
+
+    RMemoryProtector protector;
+    SEXP ans = protector.protect(Rf_allocVector(VECSXP, 3));
+    SEXP mean;
+    SEXP quantiles;
+    if (dims.empty()) {
+      mean = protector.protect(Rf_allocVector(REALSXP, size));
+      quantiles = protector.protect(
+          Rf_allocMatrix(REALSXP, probs_.size(), size));
+    } else {
+      SEXP mean_dims = protector.protect(Rf_allocVector(INTSXP, dims.size()));
+      std::copy(dims.begin(), dims.end(), INTEGER(mean_dims));
+      mean = protector.protect(Rf_allocArray(REALSXP, mean_dims));
+      SEXP quantile_dims = protector.protect(
+          Rf_allocVector(INTSXP, dims.size() + 1));
+      INTEGER(quantile_dims)[0] = probs_.size();
+      std::copy(dims.begin(), dims.end(), INTEGER(quantile_dims) + 1);
+      quantiles = protector.protect(Rf_allocArray(REALSXP, quantile_dims));
+    }
+    mean_data_ = REAL(mean);
+    quantile_data_ = REAL(quantiles);
+    std::fill(mean_data_, mean_data_ + size, R_NaReal);
+    std::fill(quantile_data_, quantile_data_ + size * probs_.size(),
+              R_NaReal);
+    SET_VECTOR_ELT(ans, 0, mean);
+    SET_VECTOR_ELT(ans, 1, quantiles);
+    SET_VECTOR_ELT(ans, 2, ToRVector(probs_));
+    Rf_namesgets(ans, CharacterVector(
+        std::vector<std::string>{"mean", "quantiles", "probs"}));
+    StoreBuffer(ans);
+    return ans;
+  }
+
+  void PosteriorSummaryListElement::write() {
+    // The wrapped element writes to the first (and only) position in its
+    // buffer, and is then moved back to it for the next draw.
+    element_->write();
+    element_->advance(-1);
+    const double *draw = REAL(draw_buffer_);
+    for (int i = 0; i < sum_.size(); ++i) {
+      sum_[i] += draw[i];
+      quantile_agents_[i].add(draw[i]);
+    }
+    if (++number_of_draws_ == niter_) {
+      finalize();
+    }
+  }
+
+  void PosteriorSummaryListElement::stream() {
+    report_error("List element " + name() + " holds a posterior summary, "
+                 "which cannot be streamed.");
+  }
+
+  void PosteriorSummaryListElement::finalize() {
+    if (number_of_draws_ == 0) return;
+    int nprobs = probs_.size();
+    for (int i = 0; i < sum_.size(); ++i) {
+      mean_data_[i] = sum_[i] / number_of_draws_;
+      quantile_agents_[i].update_cdf();
+      for (int p = 0; p < nprobs; ++p) {
+        quantile_data_[i * nprobs + p] = quantile_agents_[i].quantile(probs_[p]);
+      }
+    }
+  }
+
 }  // namespace BOOM
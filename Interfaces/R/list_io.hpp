@@ -17,6 +17,7 @@
 #ifndef BOOM_R_LIST_IO_HPP_
 #define BOOM_R_LIST_IO_HPP_
 
+#include <memory>
 #include <string>
 #include "LinAlg/Vector.hpp"
 #include "LinAlg/VectorView.hpp"
@@ -28,6 +29,8 @@
 #include "Models/ParamTypes.hpp"
 #include "Models/SpdParams.hpp"
 #include "Models/Glm/GlmCoefs.hpp"
+#include "stats/IQagent.hpp"
+#include "stats/mcmc_convergence.hpp"
 
 #include "cpputil/RefCounted.hpp"
 #include "cpputil/Ptr.hpp"
@@ -111,8 +114,36 @@ namespace BOOM {
     // The names of the managed list elements.
     std::vector<std::string> element_names() const;
 
+    // Follow the convergence of the named elements as the MCMC run proceeds.
+    // Each call to write() adds the values just written by the named elements
+    // to a single-chain McmcConvergenceMonitor, so that a stopping rule can
+    // end the run early.  The elements must store real-valued draws.  The
+    // monitor is built by prepare_to_write(), so this must be called first.
+    //
+    // Args:
+    //   element_names:  The names of the list elements to monitor.
+    //   max_batches:  Passed to the McmcConvergenceMonitor.
+    void monitor_convergence(const std::vector<std::string> &element_names,
+                             int max_batches = 64);
+
+    // The monitor created by the most recent call to prepare_to_write(), or
+    // nullptr if no elements are being monitored.
+    const McmcConvergenceMonitor *convergence_monitor() const {
+      return monitor_.get();
+    }
+
+    // The R memory allocated for the output buffers of all elements,
+    // reported under MemoryFootprint::kMcmcOutput.
+    MemoryFootprint memory_footprint() const;
+
    private:
     std::vector<Ptr<RListIoElement> > elements_;
+
+    // Convergence monitoring.
+    std::vector<std::string> monitored_names_;
+    std::vector<int> monitored_elements_;
+    int monitor_max_batches_ = 64;
+    std::unique_ptr<McmcConvergenceMonitor> monitor_;
   };
 
   //======================================================================
@@ -149,12 +180,27 @@ namespace BOOM {
 
     // Move position in stream forward by n places.
     virtual void advance(int n);
-    
+
+    // The number of real values in each draw, for elements that store
+    // real-valued draws.  Other elements report an error.
+    virtual int draw_size() const;
+
+    // The values stored by the most recent call to write(), for elements
+    // that store real-valued draws.  Other elements report an error.
+    virtual Vector most_recent_draw() const;
+
+    // The number of bytes in the R vector holding this element's output, or
+    // zero if no buffer has been allocated.
+    virtual std::size_t buffer_bytes() const;
+
    protected:
     // StoreBuffer must be called in derived classes to pass the SEXP that
     // manages the parameter to this base class.
     virtual void StoreBuffer(SEXP buffer);
-    SEXP rbuffer() {return rbuffer_;}
+    SEXP rbuffer() const {return rbuffer_;}
+
+    // The number of calls to write() (or stream()) since the buffer was set.
+    int position() const {return position_;}
 
     // Calling next_position() returns the current position and advances the
     // counter.  If you need it more than once, be sure to store it.
@@ -236,6 +282,11 @@ namespace BOOM {
     SEXP prepare_to_write(int niter) override;
     void prepare_to_stream(SEXP object) override;
 
+    // The buffer's leading dimension is the MCMC iteration, so a draw is the
+    // set of buffer entries sharing the same leading index.
+    int draw_size() const override;
+    Vector most_recent_draw() const override;
+
    protected:
     void StoreBuffer(SEXP buffer) override;
 
@@ -917,7 +968,89 @@ namespace BOOM {
     // Views into the arrays held by the data buffer.
     std::vector<ArrayView> views_;
   };
-  
+
+  //===========================================================================
+  // Storage policies.  The following elements wrap another list element and
+  // change how (or whether) its draws are stored.
+  // ===========================================================================
+
+  //---------------------------------------------------------------------------
+  // Stores every thin'th draw of the wrapped element.  Calls to write() and
+  // stream() are made once per MCMC iteration, as for any other element, so
+  // thinned and unthinned elements can share an RListIoManager.  When
+  // streaming, the wrapped element keeps its most recent stored value for the
+  // iterations that were not stored.
+  class ThinnedListElement : public RListIoElement {
+   public:
+    // Args:
+    //   element:  The element whose draws are to be thinned.
+    //   thin:  Store draws 0, thin, 2 * thin, ...
+    ThinnedListElement(const Ptr<RListIoElement> &element, int thin);
+
+    SEXP prepare_to_write(int niter) override;
+    void prepare_to_stream(SEXP object) override;
+    void write() override;
+    void stream() override;
+    void advance(int n) override;
+
+   private:
+    // The number of stored draws among the first 'iterations' iterations.
+    int number_stored(int iterations) const {
+      return (iterations + thin_ - 1) / thin_;
+    }
+
+    Ptr<RListIoElement> element_;
+    int thin_;
+    int iteration_;
+  };
+
+  //---------------------------------------------------------------------------
+  // Stores a running summary of the wrapped element's draws instead of the
+  // draws themselves: the posterior mean and a set of posterior quantiles
+  // (tracked with one IQagent per element of the draw).  Memory use does not
+  // depend on the number of MCMC iterations.
+  //
+  // The R object is a list with components
+  //   mean: An object with the dimensions of a single draw.
+  //   quantiles: An array with leading dimension length(probs), and
+  //     remaining dimensions matching a single draw.
+  //   probs:  The probabilities of the quantiles.
+  //
+  // The summary is filled in after the last of the 'niter' draws passed to
+  // prepare_to_write(), or when finalize() is called.  Summaries cannot be
+  // streamed.  The wrapped element must store numeric draws.
+  class PosteriorSummaryListElement : public RListIoElement {
+   public:
+    // Args:
+    //   element:  The element whose draws are to be summarized.
+    //   probs:  The probabilities of the quantiles to be reported.
+    explicit PosteriorSummaryListElement(
+        const Ptr<RListIoElement> &element,
+        const Vector &probs = Vector{.05, .5, .95});
+    ~PosteriorSummaryListElement() override;
+
+    SEXP prepare_to_write(int niter) override;
+    void write() override;
+    void stream() override;
+
+    // Write the summary of the draws so far to the R object.
+    void finalize();
+
+   private:
+    Ptr<RListIoElement> element_;
+    Vector probs_;
+
+    // A one-draw buffer owned by element_.  Protected with R_PreserveObject.
+    SEXP draw_buffer_;
+
+    int niter_;
+    int number_of_draws_;
+    Vector sum_;
+    std::vector<IQagent> quantile_agents_;
+    double *mean_data_;
+    double *quantile_data_;
+  };
+
 }  // namespace BOOM
 
 #endif  // BOOM_R_LIST_IO_HPP_
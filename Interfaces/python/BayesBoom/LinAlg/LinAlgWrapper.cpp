@@ -3,13 +3,16 @@
 #include <pybind11/eigen.h>
 #include <pybind11/operators.h>
 #include <pybind11/numpy.h>
+#include <algorithm>
 #include <memory>
+#include <sstream>
 #include <cpputil/report_error.hpp>
 #include "LinAlg/Cholesky.hpp"
 #include "LinAlg/EigenMap.hpp"
 #include "LinAlg/Matrix.hpp"
 #include "LinAlg/Selector.hpp"
 #include "LinAlg/SpdMatrix.hpp"
+#include "LinAlg/SubMatrix.hpp"
 #include "LinAlg/CorrelationMatrix.hpp"
 #include "LinAlg/Vector.hpp"
 #include "LinAlg/VectorView.hpp"
@@ -19,9 +22,44 @@ namespace py = pybind11;
 namespace BayesBoom {
   using namespace BOOM;
 
+  namespace {
+    // Copy a 2-D numpy array into a Matrix, honoring the array's strides, so
+    // that C and Fortran ordered arrays are each copied exactly once.
+    Matrix numpy_to_matrix(
+        const py::array_t<double, py::array::forcecast> &numpy_array) {
+      if (numpy_array.ndim() != 2) {
+        report_error("A Matrix can only be created from a 2-D array.");
+      }
+      auto elements = numpy_array.unchecked<2>();
+      Matrix ans(elements.shape(0), elements.shape(1));
+      for (int j = 0; j < ans.ncol(); ++j) {
+        for (int i = 0; i < ans.nrow(); ++i) {
+          ans(i, j) = elements(i, j);
+        }
+      }
+      return ans;
+    }
+
+    // Throw an exception unless numpy_array holds doubles, which is needed
+    // for BOOM views to refer to its memory.
+    void check_float_array(const py::array &numpy_array, int ndim) {
+      if (!py::isinstance<py::array_t<double>>(numpy_array)) {
+        report_error("Views can only be created from arrays with dtype "
+                     "float64.");
+      }
+      if (numpy_array.ndim() != ndim) {
+        std::ostringstream err;
+        err << "Expected a " << ndim << "-D array, but got "
+            << numpy_array.ndim() << " dimensions.";
+        report_error(err.str());
+      }
+    }
+  }  // namespace
+
   void LinAlg_def(py::module &boom) {
 
-    py::class_<Vector, std::unique_ptr<Vector>>(boom, "Vector")
+    py::class_<Vector, std::unique_ptr<Vector>>(boom, "Vector",
+                                                py::buffer_protocol())
         .def(py::init( [] (Eigen::Ref<Eigen::VectorXd> numpy_array) {
               VectorView view(numpy_array.data(), numpy_array.size(), 1);
               return std::unique_ptr<Vector>(new Vector(view));
@@ -51,7 +89,28 @@ namespace BayesBoom {
                                "The number of elements in the vector.")
         .def_property_readonly("size", &Vector::length,
                                "The number of elements in the vector.")
-        .def("to_numpy", [](const Vector &v) {return Eigen::VectorXd(EigenMap(v));})
+        .def_buffer([](Vector &v) {
+              return py::buffer_info(
+                  v.data(), sizeof(double),
+                  py::format_descriptor<double>::format(), 1,
+                  {v.size()}, {sizeof(double)});
+            })
+        .def("to_numpy",
+             [](py::object self, bool copy) {
+               Vector &v(self.cast<Vector &>());
+               if (copy) {
+                 return py::array_t<double>(v.size(), v.data());
+               }
+               return py::array_t<double>({v.size()}, {sizeof(double)},
+                                          v.data(), self);
+             },
+             py::arg("copy") = true,
+             "Convert the Vector to a numpy array.\n\n"
+             "Args:\n"
+             "  copy: If True the array holds a copy of the data.  If False "
+             "the array refers to the memory owned by this Vector, which is "
+             "kept alive for as long as the array exists.  Changes to the "
+             "Vector's size invalidate the array.\n")
         .def("__getitem__", [](const Vector &v, int i) {return v[i];}, py::is_operator())
         .def("__setitem__", [](Vector &v, int i, double value) {return v[i] = value;},
              py::is_operator())
@@ -124,22 +183,98 @@ namespace BayesBoom {
         ;
 
     // =========================================================================
-    py::class_<Matrix>(boom, "Matrix")
+    // Read-only views of numpy arrays.  The view refers to the array's memory
+    // without copying it, and keeps the array alive.
+    py::class_<ConstVectorView>(boom, "ConstVectorView")
+        .def(py::init(
+            [](const py::array &numpy_array) {
+              check_float_array(numpy_array, 1);
+              if (numpy_array.strides(0) % sizeof(double) != 0) {
+                report_error("Array elements are not aligned.");
+              }
+              return ConstVectorView(
+                  static_cast<const double *>(numpy_array.data()),
+                  numpy_array.shape(0),
+                  numpy_array.strides(0) / sizeof(double));
+            }),
+             py::arg("array"),
+             py::keep_alive<1, 2>(),
+             "A read-only view of a 1-D numpy array with dtype float64.  The "
+             "data are not copied.  The array must not be resized while "
+             "the view exists.")
+        .def("__len__", &ConstVectorView::size)
+        .def_property_readonly("size", &ConstVectorView::size,
+                               "The number of elements in the view.")
+        .def_property_readonly("stride", &ConstVectorView::stride,
+                               "The distance between consecutive elements.")
+        .def("__getitem__", [](const ConstVectorView &v, int i) {return v[i];},
+             py::is_operator())
+        .def("sum", &ConstVectorView::sum, "The sum of the elements.")
+        .def("to_vector",
+             [](const ConstVectorView &v) {return Vector(v);},
+             "A copy of the viewed data, as a boom.Vector.")
+        ;
+
+    py::class_<ConstSubMatrix>(boom, "ConstSubMatrix")
+        .def(py::init(
+            [](const py::array &numpy_array) {
+              check_float_array(numpy_array, 2);
+              // BOOM matrices are column major, so the rows of the array
+              // must be adjacent in memory.
+              if (numpy_array.shape(0) > 1
+                  && numpy_array.strides(0) != sizeof(double)) {
+                report_error("A ConstSubMatrix needs an array in Fortran "
+                             "(column major) order.  Use "
+                             "np.asfortranarray() to convert it.");
+              }
+              int stride = numpy_array.strides(1) / sizeof(double);
+              return ConstSubMatrix(
+                  static_cast<const double *>(numpy_array.data()),
+                  numpy_array.shape(0), numpy_array.shape(1),
+                  std::max<int>(stride, numpy_array.shape(0)));
+            }),
+             py::arg("array"),
+             py::keep_alive<1, 2>(),
+             "A read-only view of a 2-D numpy array with dtype float64, "
+             "stored in Fortran order.  The data are not copied.")
+        .def_property_readonly("nrow", &ConstSubMatrix::nrow,
+                               "The number of rows in the matrix.")
+        .def_property_readonly("ncol", &ConstSubMatrix::ncol,
+                               "The number of columns in the matrix.")
+        .def("__getitem__",
+             [](const ConstSubMatrix &m, py::tuple ij) {
+               int i = ij[0].cast<int>();
+               int j = ij[1].cast<int>();
+               return m(i, j);},
+             "Element access.")
+        .def("to_matrix",
+             [](const ConstSubMatrix &m) {return m.to_matrix();},
+             "A copy of the viewed data, as a boom.Matrix.")
+        ;
+
+    // =========================================================================
+    py::class_<Matrix>(boom, "Matrix", py::buffer_protocol())
         .def(py::init<int, int, double>(),
              py::arg("nrow") = 0,
              py::arg("ncol") = 0,
              py::arg("value") = 0.0,
              "Create a matrix with the specified number of rows and columns, "
              "with all elements set to the the given value")
-        .def(py::init( [] (const Eigen::MatrixXd &numpy_array) {
+        .def(py::init(
+            [] (const py::array_t<double, py::array::forcecast> &numpy_array) {
               return std::unique_ptr<Matrix>(
-                  new Matrix(numpy_array.rows(),
-                             numpy_array.cols(),
-                             numpy_array.data(),
-                             false));   // byrow.  False means column-storage order.
+                  new Matrix(numpy_to_matrix(numpy_array)));
             }),
           "Create a Matrix from a 2-D numpy array."
           )
+        .def_buffer([](Matrix &m) {
+              // Matrix data is stored in column major order.
+              return py::buffer_info(
+                  m.data(), sizeof(double),
+                  py::format_descriptor<double>::format(), 2,
+                  {m.nrow(), m.ncol()},
+                  {sizeof(double), sizeof(double) * m.nrow()});
+            })
         .def("__getitem__",
              [](const Matrix &m, py::tuple ij) {
                int i = ij[0].cast<int>();
@@ -165,10 +300,23 @@ namespace BayesBoom {
              &Matrix::max_abs,
              "The absolute value of the matrix element with the largest absolute value.")
         .def("to_numpy",
-             [](const Matrix &m) {
-               return Eigen::MatrixXd(EigenMap(m));
+             [](py::object self, bool copy) {
+               Matrix &m(self.cast<Matrix &>());
+               std::vector<py::ssize_t> shape = {m.nrow(), m.ncol()};
+               std::vector<py::ssize_t> strides = {
+                 sizeof(double), static_cast<py::ssize_t>(
+                     sizeof(double) * m.nrow())};
+               if (copy) {
+                 return py::array_t<double>(shape, strides, m.data());
+               }
+               return py::array_t<double>(shape, strides, m.data(), self);
              },
-             "Convert the matrix to a numpy array." )
+             py::arg("copy") = true,
+             "Convert the matrix to a numpy array.\n\n"
+             "Args:\n"
+             "  copy: If True the array holds a copy of the data.  If False "
+             "the array refers to the memory owned by this Matrix, which is "
+             "kept alive for as long as the array exists.\n")
         .def(py::pickle(
             [](const Matrix &mat) {
               int nrow = mat.nrow();
@@ -239,12 +387,11 @@ namespace BayesBoom {
              "Create a symmetric positive definite matrix of the given dimension. "
              "The diagonal elements are constant and equal to 'digaonal_value'. "
              )
-        .def(py::init([] (const Eigen::MatrixXd &numpy_spd) {
+        .def(py::init(
+            [] (const py::array_t<double, py::array::forcecast> &numpy_spd) {
               return std::unique_ptr<SpdMatrix>(
-                  new SpdMatrix(numpy_spd.cols(),
-                                numpy_spd.data(),
-                                false));
-                       }),
+                  new SpdMatrix(numpy_to_matrix(numpy_spd)));
+            }),
           "Create a symmetric positive definite matrix by copying data "
           "from a 2-D numpy array.")
         .def(py::init([] (const Matrix &m) {
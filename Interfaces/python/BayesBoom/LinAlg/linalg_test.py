@@ -65,6 +65,47 @@ class LinAlgTest(unittest.TestCase):
         vv /= 2.0
         self.assertEqual(v[1], 1.0)
 
+    def test_buffer_protocol(self):
+        v = boom.Vector(np.array([1.0, 2.0, -3.0]))
+        shared = np.asarray(v)
+        shared[0] = 7.0
+        self.assertEqual(v[0], 7.0)
+        view = v.to_numpy(copy=False)
+        view[1] = 8.0
+        self.assertEqual(v[1], 8.0)
+        copied = v.to_numpy()
+        copied[2] = 9.0
+        self.assertEqual(v[2], -3.0)
+
+        raw_data = np.random.randn(3, 4)
+        m = boom.Matrix(raw_data)
+        self.assertTrue(np.allclose(np.asarray(m), raw_data))
+        self.assertTrue(np.allclose(m.to_numpy(copy=False), raw_data))
+        mview = m.to_numpy(copy=False)
+        mview[2, 1] = 12.0
+        self.assertEqual(m[2, 1], 12.0)
+
+    def test_const_views(self):
+        x = np.array([1.0, 2.0, 3.0, 4.0])
+        v = boom.ConstVectorView(x)
+        self.assertEqual(len(v), 4)
+        x[3] = 10.0
+        self.assertEqual(v[3], 10.0)
+        stride_view = boom.ConstVectorView(x[::2])
+        self.assertEqual(len(stride_view), 2)
+        self.assertEqual(stride_view[1], 3.0)
+
+        raw_data = np.asfortranarray(np.random.randn(3, 4))
+        m = boom.ConstSubMatrix(raw_data)
+        self.assertEqual(m.nrow, 3)
+        self.assertEqual(m.ncol, 4)
+        self.assertEqual(m[2, 1], raw_data[2, 1])
+        self.assertTrue(np.allclose(m.to_matrix().to_numpy(), raw_data))
+        with self.assertRaises(Exception):
+            boom.ConstSubMatrix(np.ascontiguousarray(raw_data))
+        with self.assertRaises(Exception):
+            boom.ConstVectorView(np.array([1, 2, 3]))
+
     def test_labelled_matrix(self):
         raw_data = np.random.randn(3, 4)
         row_names = ["Larry", "Moe", "Curly"]
@@ -330,6 +330,11 @@ namespace BayesBoom {
         .def("sample_posterior",
              &MixedDataImputer::sample_posterior,
              "Take one MCMC draw from the posterior distribution.")
+        .def("setup_worker_pool",
+             &MixedDataImputer::setup_worker_pool,
+             py::arg("nworkers"),
+             "Set up a worker pool to impute the data with 'nworkers' "
+             "threads.")
         .def_property_readonly(
             "coefficients",
             [](MixedDataImputer &imputer) {
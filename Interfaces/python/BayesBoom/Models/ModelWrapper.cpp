@@ -24,6 +24,29 @@ namespace BayesBoom {
             },
             "The collection of boom.Params objects defining "
             "the model parameters.")
+        .def("save_checkpoint",
+             [](const Model &model, const std::string &filename,
+                int64_t iteration) {
+               save_checkpoint(model, filename, iteration);
+             },
+             py::arg("filename"),
+             py::arg("iteration") = 0,
+             "Write the model parameters, posterior sampler state, and "
+             "random number generator state to a binary checkpoint file.\n\n"
+             "Args:\n"
+             "  filename:  The file to (atomically) replace.\n"
+             "  iteration:  The MCMC iteration number, returned by "
+             "restore_checkpoint.\n")
+        .def("restore_checkpoint",
+             [](Model &model, const std::string &filename) {
+               return restore_checkpoint(model, filename);
+             },
+             py::arg("filename"),
+             "Restore the state written by save_checkpoint.  The model must "
+             "have the same data, structure, and posterior samplers as the "
+             "one that was saved.\n\n"
+             "Returns:\n"
+             "  The iteration number stored in the checkpoint.\n")
         ;
 
     py::class_<MixtureComponent, Model, Ptr<MixtureComponent>>(
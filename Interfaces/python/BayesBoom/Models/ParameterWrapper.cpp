@@ -1,9 +1,15 @@
 #include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+#include <pybind11/stl.h>
 
 #include "LinAlg/Vector.hpp"
+#include "Models/ModelTypes.hpp"
+#include "Models/ParamDrawRecorder.hpp"
 #include "Models/ParamTypes.hpp"
 #include "Models/SpdParams.hpp"
 #include "cpputil/Ptr.hpp"
+#include "cpputil/report_error.hpp"
+#include "stats/mcmc_convergence.hpp"
 
 #include <sstream>
 
@@ -94,6 +100,170 @@ namespace BayesBoom {
             "The parameter's value as a precision (inverted).")
         ;
 
+    py::class_<ParamDrawRecorder>(boom, "ParamDrawRecorder")
+        .def(py::init<>(),
+             "Records MCMC draws of a set of parameters into storage that is "
+             "allocated once, and shared with numpy without copying.")
+        .def("add_parameter",
+             &ParamDrawRecorder::add_parameter,
+             py::arg("name"),
+             py::arg("prm"),
+             py::arg("minimal") = false,
+             py::arg("thin") = 1,
+             py::arg("single_precision") = false,
+             "Register a parameter to be recorded.\n\n"
+             "Args:\n"
+             "  name:  The name of the parameter.  Names must be unique.\n"
+             "  prm:  The boom.Params object to record.\n"
+             "  minimal:  Passed to the parameter's vectorize method.\n"
+             "  thin:  Only every thin'th draw is stored.\n"
+             "  single_precision:  If True the draws are stored as float32.\n")
+        .def("prepare_to_write",
+             &ParamDrawRecorder::prepare_to_write,
+             py::arg("niter"),
+             "Allocate space for 'niter' draws of each registered parameter.  "
+             "Arrays previously returned by 'draws' are invalidated.")
+        .def("record",
+             &ParamDrawRecorder::record,
+             "Store the current value of each registered parameter.")
+        .def("sample_and_record",
+             &ParamDrawRecorder::sample_and_record,
+             py::arg("model"),
+             py::arg("niter"),
+             py::call_guard<py::gil_scoped_release>(),
+             "Run 'niter' MCMC iterations on 'model', recording the "
+             "registered parameters after each one.  The MCMC loop runs in "
+             "C++ without holding the GIL.")
+        .def("monitor_convergence",
+             &ParamDrawRecorder::monitor_convergence,
+             py::arg("names") = std::vector<std::string>(),
+             py::arg("max_batches") = 64,
+             "Follow the convergence of the named parameters (all registered "
+             "parameters if 'names' is empty) as draws are recorded.  The "
+             "monitor is rebuilt by each call to prepare_to_write.\n\n"
+             "Args:\n"
+             "  names:  The parameters to monitor.  Their values are "
+             "concatenated in the order the parameters were registered.\n"
+             "  max_batches:  The number of batch means kept by the "
+             "monitor.\n")
+        .def_property_readonly(
+            "convergence_monitor",
+            [](const ParamDrawRecorder &recorder) {
+              return recorder.convergence_monitor();
+            },
+            py::return_value_policy::reference_internal,
+            "The boom.McmcConvergenceMonitor following the current run, or "
+            "None if no parameters are being monitored.")
+        .def_property_readonly("niter", &ParamDrawRecorder::niter,
+                               "The number of draws allocated.")
+        .def_property_readonly("number_recorded",
+                               &ParamDrawRecorder::number_recorded,
+                               "The number of draws recorded so far.")
+        .def_property_readonly("names", &ParamDrawRecorder::names,
+                               "The names of the registered parameters.")
+        .def("draws",
+             [](py::object self, const std::string &name) -> py::array {
+               const ParamDrawRecorder &recorder(
+                   self.cast<const ParamDrawRecorder &>());
+               int index = recorder.parameter_index(name);
+               if (index < 0) {
+                 report_error("No parameter named '" + name +
+                              "' is being recorded.");
+               }
+               // Each draw is contiguous, so the storage is an
+               // (number_of_draws x dim) row-major array.
+               int dim = recorder.dim(index);
+               std::vector<py::ssize_t> shape = {
+                 recorder.number_of_stored_draws(index), dim};
+               if (recorder.single_precision(index)) {
+                 std::vector<py::ssize_t> strides = {
+                   static_cast<py::ssize_t>(sizeof(float) * dim),
+                   sizeof(float)};
+                 return py::array_t<float>(
+                     shape, strides,
+                     recorder.single_precision_draws(index).data(), self);
+               }
+               std::vector<py::ssize_t> strides = {
+                 static_cast<py::ssize_t>(sizeof(double) * dim),
+                 sizeof(double)};
+               return py::array_t<double>(
+                   shape, strides, recorder.draws(index).data(), self);
+             },
+             py::arg("name"),
+             "A (number_of_draws x dim) numpy array of the stored draws of "
+             "the named parameter, one draw per row.  The number of draws "
+             "reflects any thinning, and the dtype is float32 for "
+             "parameters stored in single precision.  The array refers to "
+             "the recorder's memory, which is kept alive for as long as the "
+             "array exists.  Rows that have not been recorded are zero.")
+        ;
+
+    boom.def("run_mcmc",
+             [](Model *model, int niter, int burn, int thin,
+                ParamDrawRecorder *recorder, int callback_every,
+                py::object callback, py::object stopping_rule) {
+               std::function<void(int)> cpp_callback;
+               if (!callback.is_none()) {
+                 cpp_callback = [&callback](int iteration) {
+                   py::gil_scoped_acquire acquire;
+                   // Give Python a chance to raise KeyboardInterrupt.
+                   if (PyErr_CheckSignals() != 0) {
+                     throw py::error_already_set();
+                   }
+                   callback(iteration);
+                 };
+               }
+               McmcStoppingRule cpp_stopping_rule;
+               if (!stopping_rule.is_none()) {
+                 cpp_stopping_rule = [&stopping_rule](
+                     const McmcConvergenceMonitor &monitor) {
+                   py::gil_scoped_acquire acquire;
+                   return stopping_rule(
+                       py::cast(&monitor,
+                                py::return_value_policy::reference))
+                       .cast<bool>();
+                 };
+               }
+               py::gil_scoped_release release;
+               return run_mcmc(model, niter, burn, thin, recorder,
+                               callback_every, cpp_callback,
+                               cpp_stopping_rule);
+             },
+             py::arg("model"),
+             py::arg("niter"),
+             py::arg("burn") = 0,
+             py::arg("thin") = 1,
+             py::arg("recorder") = nullptr,
+             py::arg("callback_every") = 0,
+             py::arg("callback") = py::none(),
+             py::arg("stopping_rule") = py::none(),
+             "Run an MCMC loop in C++, releasing the GIL for the duration of "
+             "the run so that other Python threads (e.g. ones fitting other "
+             "models) can proceed.\n\n"
+             "Args:\n"
+             "  model:  The model to sample.  Its posterior sampler must be "
+             "set.\n"
+             "  niter:  The number of draws to keep.\n"
+             "  burn:  The number of initial iterations to discard.\n"
+             "  thin:  The number of MCMC iterations per kept draw.\n"
+             "  recorder:  An optional ParamDrawRecorder in which to store "
+             "the kept draws.\n"
+             "  callback_every:  If positive, 'callback' is called after "
+             "every callback_every kept draws.\n"
+             "  callback:  A callable taking the number of kept draws so "
+             "far.  The GIL is held while it runs.  Exceptions raised by "
+             "the callback end the run.\n"
+             "  stopping_rule:  An optional callable taking the recorder's "
+             "boom.McmcConvergenceMonitor, e.g. one made by "
+             "boom.convergence_stopping_rule.  The run ends once it returns "
+             "True.  It is checked every callback_every draws (every draw "
+             "if callback_every is 0), and needs a recorder that is "
+             "monitoring convergence.\n\n"
+             "Returns:\n"
+             "  The number of draws kept.\n\n"
+             "Models run concurrently in different threads must not share "
+             "parameters, data, or random number generators.\n");
+
   }  // module
 
 }  // namespace BayesBoom
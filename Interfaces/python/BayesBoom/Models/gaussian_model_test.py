@@ -1,3 +1,4 @@
+import threading
 import unittest
 import BayesBoom.boom as boom
 import numpy as np
@@ -57,6 +58,64 @@ class GaussianModelTest(unittest.TestCase):
         for _ in range(100):
             model.sample_posterior()
 
+    def test_draw_recorder(self):
+        model = boom.GaussianModel()
+        data = np.random.randn(1000) * 7 - 16
+        model.set_data(boom.Vector(data))
+        mean_prior = boom.GaussianModelGivenSigma(
+            model.sigsq_parameter, -16, 1.0)
+        sigsq_prior = boom.ChisqModel(1.0, 7)
+        model.set_method(boom.GaussianConjugateSampler(
+            model, mean_prior, sigsq_prior))
+
+        recorder = boom.ParamDrawRecorder()
+        recorder.add_parameter("mu", model.mean_parameter)
+        recorder.add_parameter("sigsq", model.sigsq_parameter)
+        recorder.sample_and_record(model, 100)
+        self.assertEqual(recorder.number_recorded, 100)
+        mu_draws = recorder.draws("mu")
+        self.assertEqual(mu_draws.shape, (100, 1))
+        self.assertAlmostEqual(mu_draws[-1, 0], model.mean)
+        self.assertAlmostEqual(np.mean(mu_draws), -16, delta=2)
+
+        compact = boom.ParamDrawRecorder()
+        compact.add_parameter("mu", model.mean_parameter, thin=10,
+                              single_precision=True)
+        compact.sample_and_record(model, 100)
+        compact_draws = compact.draws("mu")
+        self.assertEqual(compact_draws.shape, (10, 1))
+        self.assertEqual(compact_draws.dtype, np.float32)
+
+    def test_run_mcmc_in_threads(self):
+        def fit(mu, recorder, progress):
+            model = boom.GaussianModel()
+            model.set_data(boom.Vector(np.random.randn(1000) + mu))
+            mean_prior = boom.GaussianModelGivenSigma(
+                model.sigsq_parameter, 0, 1.0)
+            model.set_method(boom.GaussianConjugateSampler(
+                model, mean_prior, boom.ChisqModel(1.0, 1.0)))
+            recorder.add_parameter("mu", model.mean_parameter)
+            boom.run_mcmc(model, niter=100, burn=10, thin=2,
+                          recorder=recorder, callback_every=25,
+                          callback=progress.append)
+
+        means = [-3.0, 5.0]
+        recorders = [boom.ParamDrawRecorder() for _ in means]
+        progress = [[] for _ in means]
+        threads = [
+            threading.Thread(target=fit, args=(mu, rec, prog))
+            for mu, rec, prog in zip(means, recorders, progress)
+        ]
+        for thread in threads:
+            thread.start()
+        for thread in threads:
+            thread.join()
+        for mu, recorder, prog in zip(means, recorders, progress):
+            self.assertEqual(recorder.number_recorded, 100)
+            self.assertEqual(prog, [25, 50, 75, 100])
+            self.assertAlmostEqual(
+                np.mean(recorder.draws("mu")), mu, delta=.5)
+
 
 class ZeroMeanGaussianModelTest(unittest.TestCase):
 
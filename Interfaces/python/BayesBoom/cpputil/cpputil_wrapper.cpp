@@ -7,6 +7,7 @@
 #include <cpputil/report_error.hpp>
 #include <cpputil/Date.hpp>
 #include <cpputil/find.hpp>
+#include <Samplers/McmcProfiler.hpp>
 
 namespace py = pybind11;
 
@@ -64,7 +65,30 @@ namespace BayesBoom {
              "Returns:  A vector of indices ans of the same length as 'input'"
              "  where ans[i] is the position in 'target' where input[i] is "
              "found.\n");
-             
+
+    boom.def("enable_profiling",
+             [](bool enable, bool reset) {
+               if (reset) {
+                 McmcProfiler::reset();
+               }
+               McmcProfiler::enable(enable);
+             },
+             py::arg("enable") = true,
+             py::arg("reset") = true,
+             "Turn timing of the MCMC phases (latent data imputation, Kalman "
+             "filtering and smoothing, parameter draws, etc.) on or off.\n\n"
+             "Args:\n"
+             "  enable:  If True, subsequent calls to sample_posterior record "
+             "the time spent in each phase.\n"
+             "  reset:  If True, previously recorded times are discarded.\n");
+
+    boom.def("profile_report",
+             []() {return McmcProfiler::report();},
+             "Returns:  A LabelledMatrix with one row per MCMC phase.  Column "
+             "'seconds' is the total time spent in the phase, and 'calls' is "
+             "the number of times the phase was entered.  Phases can nest "
+             "(e.g. impute_latent_data includes kalman_filter), so the rows "
+             "need not sum to the total run time.\n");
 
   }  // ends the cpputil_def function.
 
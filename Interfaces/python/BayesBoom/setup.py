@@ -410,6 +410,9 @@ class BuildExt(build_ext):
         c_opts['unix'] += darwin_opts
         l_opts['unix'] += darwin_opts
     elif sys.platform == 'linux':
+        # Deliberately no -march flags, so wheels stay portable.  The hot
+        # loops pick their SIMD instruction set at run time.  See
+        # cpputil/cpu_dispatch.hpp.
         c_opts['unix'] = ['-Wno-sign-compare']
 
     def build_extensions(self):
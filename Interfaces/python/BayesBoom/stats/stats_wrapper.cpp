@@ -1,4 +1,5 @@
 #include <pybind11/pybind11.h>
+#include <pybind11/functional.h>
 #include <pybind11/stl.h>
 #include <pybind11/eigen.h>
 
@@ -13,7 +14,9 @@
 #include "stats/IQagent.hpp"
 #include "stats/Encoders.hpp"
 #include "stats/hexbin.hpp"
+#include "stats/mcmc_convergence.hpp"
 #include "stats/acf.hpp"
+#include "stats/ArrowImport.hpp"
 
 #include "Models/DataTypes.hpp"
 #include "cpputil/Ptr.hpp"
@@ -24,6 +27,34 @@ PYBIND11_DECLARE_HOLDER_TYPE(T, BOOM::Ptr<T>, true);
 namespace BayesBoom {
   using namespace BOOM;
 
+  namespace {
+    // Import a pyarrow.RecordBatch through the Arrow C data interface.
+    ArrowRecordBatch import_record_batch(const py::object &batch) {
+      ArrowSchema schema;
+      ArrowArray array;
+      schema.release = nullptr;
+      array.release = nullptr;
+      batch.attr("_export_to_c")(reinterpret_cast<std::uintptr_t>(&array),
+                                 reinterpret_cast<std::uintptr_t>(&schema));
+      return ArrowRecordBatch(&schema, &array);
+    }
+
+    // Import a pyarrow.Table (one batch per chunk) or pyarrow.RecordBatch.
+    std::vector<ArrowRecordBatch> import_record_batches(
+        const py::object &data) {
+      std::vector<ArrowRecordBatch> ans;
+      if (py::hasattr(data, "to_batches")) {
+        for (const auto &batch : data.attr("to_batches")()) {
+          ans.push_back(import_record_batch(
+              py::reinterpret_borrow<py::object>(batch)));
+        }
+      } else {
+        ans.push_back(import_record_batch(data));
+      }
+      return ans;
+    }
+  }  // namespace
+
   void stats_def(py::module &boom) {
 
     boom.def("mean", [](const Matrix &m){return mean(m);},
@@ -57,7 +88,11 @@ namespace BayesBoom {
         .def("basis", &SplineBase::basis, py::arg("x: float"),
              py::return_value_policy::copy,
              "Spline basis expansion at x.")
-        .def("basis_matrix", &SplineBase::basis_matrix, py::arg("x: Vector"),
+        .def("basis_matrix",
+             [](const SplineBase &spline, const Vector &x) {
+               return spline.basis_matrix(x);
+             },
+             py::arg("x: Vector"),
              py::return_value_policy::copy,
              "Spline basis matrix expansion of the Vector x.")
         .def_property_readonly("dim", &SplineBase::basis_dimension,
@@ -172,6 +207,41 @@ namespace BayesBoom {
         ;
 
 
+    //===========================================================================
+    boom.def("data_table_from_arrow",
+             [](const py::object &data) {
+               return new DataTable(
+                   arrow_to_data_table(import_record_batches(data)));
+             },
+             py::arg("data"),
+             "Args:\n"
+             "  data: A pyarrow.Table or pyarrow.RecordBatch, e.g. from "
+             "pyarrow.parquet.read_table.  Numeric and boolean columns become "
+             "numeric variables.  String and dictionary columns become "
+             "categorical variables.\n\n"
+             "Returns:\n"
+             "  A boom.DataTable holding a copy of the data.")
+        ;
+
+    boom.def("arrow_to_matrix",
+             [](const py::object &data,
+                const std::vector<std::string> &columns) {
+               Matrix ans;
+               for (const auto &batch : import_record_batches(data)) {
+                 Matrix chunk = arrow_to_matrix(batch, columns);
+                 ans = ans.nrow() == 0 ? chunk : rbind(ans, chunk);
+               }
+               return ans;
+             },
+             py::arg("data"),
+             py::arg("columns"),
+             "Args:\n"
+             "  data: A pyarrow.Table or pyarrow.RecordBatch.\n"
+             "  columns: The names of the numeric columns to extract.\n\n"
+             "Returns:\n"
+             "  A boom.Matrix with one row per record and one column per "
+             "entry in 'columns', suitable as a design or predictor matrix.");
+
     //===========================================================================
     py::class_<DataTable,
                Data,
@@ -196,7 +266,7 @@ namespace BayesBoom {
                 const std::vector<std::string> &labels,
                 const std::string &name) {
                NEW(CatKey, key)(labels);
-               table.append_variable(CategoricalVariable(values, key), name);
+               table.append_variable(CategoricalColumn(values, key), name);
              },
              py::arg("values"),
              py::arg("labels"),
@@ -210,7 +280,7 @@ namespace BayesBoom {
              [](DataTable &table,
                 const std::vector<std::string> &values,
                 const std::string &name) {
-               table.append_variable(CategoricalVariable(values), name);
+               table.append_variable(CategoricalColumn(values), name);
              },
              py::arg("values"),
              py::arg("name"),
@@ -257,13 +327,7 @@ namespace BayesBoom {
 
         .def("get_nominal_values",
              [](DataTable &table, int i) {
-               CategoricalVariable var = table.get_nominal(i);
-               std::vector<int> values;
-               values.reserve(table.nrow());
-               for (int i = 0; i < table.nrow(); ++i) {
-                 values.push_back(var[i]->value());
-               }
-               return values;
+               return table.categorical_column(i).codes();
              },
              py::arg("i"),
              "Return table column 'i'.  \n"
@@ -271,8 +335,7 @@ namespace BayesBoom {
              "variable.")
         .def("get_nominal_levels",
              [](DataTable &table, int i) {
-               CategoricalVariable var = table.get_nominal(i);
-               return var.labels();
+               return table.categorical_column(i).labels();
              },
              py::arg("i"),
              "Return the levels associated with variable 'i'.  \n"
@@ -370,6 +433,81 @@ namespace BayesBoom {
             "(first two columns) and the hexagon counts (frequency, third column).\n")
         ;
 
+    //===========================================================================
+    py::class_<McmcConvergenceMonitor>(boom, "McmcConvergenceMonitor")
+        .def(py::init<int, int, int>(),
+             py::arg("number_of_chains"),
+             py::arg("dimension"),
+             py::arg("max_batches") = 64,
+             "Convergence diagnostics for parallel MCMC chains, updated one "
+             "draw at a time without storing the draws.\n\n"
+             "Args:\n"
+             "  number_of_chains:  The number of chains being monitored.\n"
+             "  dimension:  The dimension of each draw.\n"
+             "  max_batches:  The maximum number of batch means kept per "
+             "chain.  Must be an even number of at least 4.\n")
+        .def("add",
+             [](McmcConvergenceMonitor &monitor, int chain,
+                const Vector &draw) {
+               monitor.add(chain, draw);
+             },
+             py::arg("chain"),
+             py::arg("draw"),
+             "Record a draw from the specified chain.")
+        .def_property_readonly(
+            "number_of_chains", &McmcConvergenceMonitor::number_of_chains)
+        .def_property_readonly(
+            "dimension", &McmcConvergenceMonitor::dimension)
+        .def("sample_size", &McmcConvergenceMonitor::sample_size,
+             py::arg("chain"),
+             "The number of draws recorded for the given chain.")
+        .def_property_readonly(
+            "rhat", &McmcConvergenceMonitor::rhat,
+            "The Gelman-Rubin R-hat statistic for each element of the draws.  "
+            "Infinite unless at least two chains have two or more draws.")
+        .def_property_readonly(
+            "split_rhat", &McmcConvergenceMonitor::split_rhat,
+            "R-hat computed after splitting each chain in half, which "
+            "detects drift even in a single chain.")
+        .def_property_readonly(
+            "effective_sample_size",
+            &McmcConvergenceMonitor::effective_sample_size,
+            "The batch means effective sample size of each element, summed "
+            "across chains.")
+        .def("geweke", &McmcConvergenceMonitor::geweke,
+             py::arg("chain") = 0,
+             "Geweke z-scores comparing the first 10% of the chain to the "
+             "last 50%.  Infinite until the chain has ten complete batches.")
+        .def("clear", &McmcConvergenceMonitor::clear,
+             "Discard all recorded draws.")
+        ;
+
+    boom.def("convergence_stopping_rule",
+             [](double min_effective_sample_size, double max_split_rhat,
+                double max_abs_geweke, const std::vector<int> &elements) {
+               return ConvergenceStoppingRule(
+                   min_effective_sample_size, max_split_rhat,
+                   max_abs_geweke, elements);
+             },
+             py::arg("min_effective_sample_size"),
+             py::arg("max_split_rhat") = 1.05,
+             py::arg("max_abs_geweke") = infinity(),
+             py::arg("elements") = std::vector<int>(),
+             "A stopping rule for boom.run_mcmc.  The rule is a callable "
+             "that takes a boom.McmcConvergenceMonitor and returns True "
+             "once the monitored elements have the desired effective sample "
+             "size, split R-hat, and Geweke z-scores.\n\n"
+             "Args:\n"
+             "  min_effective_sample_size:  The effective sample size each "
+             "element must reach.\n"
+             "  max_split_rhat:  The largest acceptable split R-hat.  Use "
+             "math.inf to skip the check.\n"
+             "  max_abs_geweke:  The largest acceptable absolute Geweke "
+             "z-score.  Use math.inf to skip the check.\n"
+             "  elements:  Positions of the parameters of interest in the "
+             "monitored vector.  If empty, all elements are checked.\n")
+        ;
+
   }  // stats_def
 
 }  // namespace BayesBoom
@@ -0,0 +1,40 @@
+import unittest
+import BayesBoom.boom as boom
+import numpy as np
+
+try:
+    import pyarrow as pa
+except ImportError:
+    pa = None
+
+
+@unittest.skipIf(pa is None, "pyarrow is not installed")
+class ArrowTest(unittest.TestCase):
+
+    def setUp(self):
+        np.random.seed(8675309)
+        self.x = np.random.randn(10)
+        colors = ["red", "blue"] * 5
+        self.table = pa.table({
+            "x": self.x,
+            "n": pa.array(range(10), type=pa.int32()),
+            "color": colors,
+            "shape": pa.array(["circle", "square"] * 5).dictionary_encode(),
+        })
+
+    def test_data_table(self):
+        table = boom.data_table_from_arrow(self.table)
+        self.assertEqual(table.nrow, 10)
+        self.assertEqual(table.ncol, 4)
+        self.assertEqual(table.variable_names, ["x", "n", "color", "shape"])
+        self.assertTrue(np.allclose(table.getvar(0).to_numpy(), self.x))
+
+    def test_matrix(self):
+        X = boom.arrow_to_matrix(self.table, ["n", "x"])
+        self.assertEqual(X.nrow, 10)
+        self.assertEqual(X.ncol, 2)
+        self.assertAlmostEqual(X[3, 0], 3.0)
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -69,20 +69,22 @@ namespace BOOM {
       return (ans);
     }
 
-    // Returns the position in the column-major array
-    inline int array_index(const std::vector<int> &index,
+    // Returns the position in the column-major array of the element whose
+    // 'rank' indices are stored in 'index'.  Taking a raw pointer lets the
+    // operator() overloads pass a stack array, so indexing does not allocate.
+    inline int array_index(const int *index, int rank,
                            const std::vector<int> &dim,
                            const std::vector<int> &strides) {
-      if (index.size() != dim.size()) {
+      if (rank != dim.size()) {
         std::ostringstream err;
         err << "Wrong number of dimensions passed to "
             << "ConstArrayBase::operator[]."
-            << "  Expected " << dim.size() << " got " << index.size() << "."
+            << "  Expected " << dim.size() << " got " << rank << "."
             << endl;
         report_error(err.str());
       }
       int pos = 0;
-      for (int i = 0; i < dim.size(); ++i) {
+      for (int i = 0; i < rank; ++i) {
         int ind = index[i];
         if (ind < 0 || ind >= dim[i]) {
           std::ostringstream err;
@@ -92,11 +94,17 @@ namespace BOOM {
               << "]." << endl;
           report_error(err.str());
         }
-        pos += index[i] * strides[i];
+        pos += ind * strides[i];
       }
       return pos;
     }
 
+    inline int array_index(const std::vector<int> &index,
+                           const std::vector<int> &dim,
+                           const std::vector<int> &strides) {
+      return array_index(index.data(), index.size(), dim, strides);
+    }
+
     template <class V>
     bool vector_compare(const V &v, const ConstArrayBase &array) {
       int n = array.size();
@@ -108,62 +116,95 @@ namespace BOOM {
       return true;
     }
 
-    inline void check_slice_size(const std::vector<int> &index,
+    inline void check_slice_size(const int *index, int rank,
                                  const std::vector<int> &dims) {
-      if (index.size() == dims.size()) return;
+      if (rank == dims.size()) return;
 
       std::ostringstream msg;
       msg << "Array::slice expects an argument of length " << dims.size()
-          << " but was passed an argument of length " << index.size() << " : [";
-      for (int i = 0; i < index.size(); ++i) {
+          << " but was passed an argument of length " << rank << " : [";
+      for (int i = 0; i < rank; ++i) {
         msg << index[i];
-        if (i + 1 < index.size()) msg << ",";
+        if (i + 1 < rank) msg << ",";
       }
       msg << "]" << endl;
       report_error(msg.str());
     }
 
+    // Returns the offset in the host data of the first element of the slice
+    // described by 'index'.  Negative elements of 'index' start at zero.
+    inline int slice_offset(const int *index, int rank,
+                            const std::vector<int> &host_dims,
+                            const std::vector<int> &host_strides) {
+      int pos = 0;
+      for (int i = 0; i < rank; ++i) {
+        if (index[i] >= host_dims[i]) {
+          std::ostringstream err;
+          err << "Index " << i << " out of bounds in Array::slice."
+              << " Value passed = " << index[i] << " legal range: [0, "
+              << host_dims[i] - 1 << "]." << endl;
+          report_error(err.str());
+        }
+        if (index[i] > 0) {
+          pos += index[i] * host_strides[i];
+        }
+      }
+      return pos;
+    }
+
     template <class RETURN_TYPE, class INPUT_TYPE>
     RETURN_TYPE template_slice_array(INPUT_TYPE host_data,
-                                     const std::vector<int> &index,
+                                     const int *index, int rank,
                                      const std::vector<int> &host_dims,
                                      const std::vector<int> &host_strides) {
-      check_slice_size(index, host_dims);
+      check_slice_size(index, rank, host_dims);
       std::vector<int> view_dims;
       std::vector<int> view_strides;
-      std::vector<int> view_initial_position(index.size());
-      for (int i = 0; i < index.size(); ++i) {
+      for (int i = 0; i < rank; ++i) {
         if (index[i] < 0) {
           view_dims.push_back(host_dims[i]);
           view_strides.push_back(host_strides[i]);
-          view_initial_position[i] = 0;
-        } else {
-          view_initial_position[i] = index[i];
         }
       }
       INPUT_TYPE view_data =
-          host_data +
-          array_index(view_initial_position, host_dims, host_strides);
+          host_data + slice_offset(index, rank, host_dims, host_strides);
       return RETURN_TYPE(view_data, view_dims, view_strides);
     }
 
     inline ArrayView slice_array(double *host_data,
-                                 const std::vector<int> &index,
+                                 const int *index, int rank,
                                  const std::vector<int> &host_dims,
                                  const std::vector<int> &host_strides) {
       return template_slice_array<ArrayView, double *>(
-          host_data, index, host_dims, host_strides);
+          host_data, index, rank, host_dims, host_strides);
+    }
+
+    inline ArrayView slice_array(double *host_data,
+                                 const std::vector<int> &index,
+                                 const std::vector<int> &host_dims,
+                                 const std::vector<int> &host_strides) {
+      return slice_array(host_data, index.data(), index.size(),
+                         host_dims, host_strides);
     }
 
     inline ConstArrayView slice_const_array(
-        const double *host_data, const std::vector<int> &index,
+        const double *host_data, const int *index, int rank,
         const std::vector<int> &host_dims,
         const std::vector<int> &host_strides) {
       return template_slice_array<ConstArrayView, const double *>(
-          host_data, index, host_dims, host_strides);
+          host_data, index, rank, host_dims, host_strides);
+    }
+
+    inline ConstArrayView slice_const_array(
+        const double *host_data, const std::vector<int> &index,
+        const std::vector<int> &host_dims,
+        const std::vector<int> &host_strides) {
+      return slice_const_array(host_data, index.data(), index.size(),
+                               host_dims, host_strides);
     }
 
-    // Return a vector-like slice of one dimension of the input array.
+    // Return a vector-like slice of one dimension of the input array.  No
+    // memory is allocated.
     // Template Args:
     //   RETURN_TYPE: either ConstVectorView or VectorView.
     //   INPUT_TYPE: either 'const double *' or 'double *'.
@@ -175,31 +216,30 @@ namespace BOOM {
     //     the slice.  For example: in a 3-way array, if index == {2,
     //     -1, 7} then the return is a view into elements {2, 0, 7},
     //     {2, 1, 7}, {2, 2, 7}, ...
+    //   rank:  The number of elements in 'index'.
     //   host_dims:  The dimensions of the input array.
     //   host_strides:  The strides of the input array.
     template <class RETURN_TYPE, class INPUT_TYPE>
     RETURN_TYPE template_vector_slice_array(
-        INPUT_TYPE host_data, const std::vector<int> &index,
+        INPUT_TYPE host_data, const int *index, int rank,
         const std::vector<int> &host_dims,
         const std::vector<int> &host_strides) {
-      int ndim = host_dims.size();
-      check_slice_size(index, host_dims);
-      std::vector<int> initial_position(ndim);
+      check_slice_size(index, rank, host_dims);
       int which_slice = -1;
-      for (int i = 0; i < ndim; ++i) {
-        if (index[i] >= 0) {
-          initial_position[i] = index[i];
-        } else {
+      for (int i = 0; i < rank; ++i) {
+        if (index[i] < 0) {
           if (which_slice >= 0) {
             report_error(
                 "multiple slicing indices were "
                 "provided in Array::vector_slice.");
           }
           which_slice = i;
-          initial_position[i] = 0;
         }
       }
-      int pos = array_index(initial_position, host_dims, host_strides);
+      if (which_slice < 0) {
+        report_error("No slicing index was provided in Array::vector_slice.");
+      }
+      int pos = slice_offset(index, rank, host_dims, host_strides);
       RETURN_TYPE ans(
           host_data + pos, host_dims[which_slice], host_strides[which_slice]);
       return ans;
@@ -208,21 +248,37 @@ namespace BOOM {
     // Syntactic sugar for getting ConstVectorView slices of const
     // arrays or views.
     inline ConstVectorView vector_slice_const_array(
-        const double *host_data, const std::vector<int> &index,
+        const double *host_data, const int *index, int rank,
         const std::vector<int> &host_dims,
         const std::vector<int> &host_strides) {
       return template_vector_slice_array<ConstVectorView, const double *>(
-          host_data, index, host_dims, host_strides);
+          host_data, index, rank, host_dims, host_strides);
+    }
+
+    inline ConstVectorView vector_slice_const_array(
+        const double *host_data, const std::vector<int> &index,
+        const std::vector<int> &host_dims,
+        const std::vector<int> &host_strides) {
+      return vector_slice_const_array(host_data, index.data(), index.size(),
+                                      host_dims, host_strides);
     }
 
     // Syntactic sugar for getting VectorView slices of non-const
     // arrays or views.
     inline VectorView vector_slice_array(double *host_data,
-                                         const std::vector<int> &index,
+                                         const int *index, int rank,
                                          const std::vector<int> &host_dims,
                                          const std::vector<int> &host_strides) {
       return template_vector_slice_array<VectorView, double *>(
-          host_data, index, host_dims, host_strides);
+          host_data, index, rank, host_dims, host_strides);
+    }
+
+    inline VectorView vector_slice_array(double *host_data,
+                                         const std::vector<int> &index,
+                                         const std::vector<int> &host_dims,
+                                         const std::vector<int> &host_strides) {
+      return vector_slice_array(host_data, index.data(), index.size(),
+                                host_dims, host_strides);
     }
 
   }  // namespace
@@ -310,24 +366,30 @@ namespace BOOM {
   }
 
   double ConstArrayBase::operator()(int x1) const {
-    return (*this)[index1(x1)];
+    const int index[] = {x1};
+    return data()[array_index(index, 1, dim(), strides())];
   }
   double ConstArrayBase::operator()(int x1, int x2) const {
-    return (*this)[index2(x1, x2)];
+    const int index[] = {x1, x2};
+    return data()[array_index(index, 2, dim(), strides())];
   }
   double ConstArrayBase::operator()(int x1, int x2, int x3) const {
-    return (*this)[index3(x1, x2, x3)];
+    const int index[] = {x1, x2, x3};
+    return data()[array_index(index, 3, dim(), strides())];
   }
   double ConstArrayBase::operator()(int x1, int x2, int x3, int x4) const {
-    return (*this)[index4(x1, x2, x3, x4)];
+    const int index[] = {x1, x2, x3, x4};
+    return data()[array_index(index, 4, dim(), strides())];
   }
   double ConstArrayBase::operator()(int x1, int x2, int x3, int x4,
                                     int x5) const {
-    return (*this)[index5(x1, x2, x3, x4, x5)];
+    const int index[] = {x1, x2, x3, x4, x5};
+    return data()[array_index(index, 5, dim(), strides())];
   }
   double ConstArrayBase::operator()(int x1, int x2, int x3, int x4, int x5,
                                     int x6) const {
-    return (*this)[index6(x1, x2, x3, x4, x5, x6)];
+    const int index[] = {x1, x2, x3, x4, x5, x6};
+    return data()[array_index(index, 6, dim(), strides())];
   }
 
   Matrix ConstArrayBase::to_matrix() const {
@@ -402,22 +464,30 @@ namespace BOOM {
     return data()[pos];
   }
 
-  double &ArrayBase::operator()(int x1) { return (*this)[index1(x1)]; }
+  double &ArrayBase::operator()(int x1) {
+    const int index[] = {x1};
+    return data()[array_index(index, 1, dim(), strides())];
+  }
   double &ArrayBase::operator()(int x1, int x2) {
-    return (*this)[index2(x1, x2)];
+    const int index[] = {x1, x2};
+    return data()[array_index(index, 2, dim(), strides())];
   }
   double &ArrayBase::operator()(int x1, int x2, int x3) {
-    return (*this)[index3(x1, x2, x3)];
+    const int index[] = {x1, x2, x3};
+    return data()[array_index(index, 3, dim(), strides())];
   }
   double &ArrayBase::operator()(int x1, int x2, int x3, int x4) {
-    return (*this)[index4(x1, x2, x3, x4)];
+    const int index[] = {x1, x2, x3, x4};
+    return data()[array_index(index, 4, dim(), strides())];
   }
   double &ArrayBase::operator()(int x1, int x2, int x3, int x4, int x5) {
-    return (*this)[index5(x1, x2, x3, x4, x5)];
+    const int index[] = {x1, x2, x3, x4, x5};
+    return data()[array_index(index, 5, dim(), strides())];
   }
   double &ArrayBase::operator()(int x1, int x2, int x3, int x4, int x5,
                                 int x6) {
-    return (*this)[index6(x1, x2, x3, x4, x5, x6)];
+    const int index[] = {x1, x2, x3, x4, x5, x6};
+    return data()[array_index(index, 6, dim(), strides())];
   }
 
   //======================================================================
@@ -449,90 +519,116 @@ namespace BOOM {
   ConstArrayView ArrayView::slice(const std::vector<int> &index) const {
     return slice_const_array(data(), index, dim(), strides());
   }
-  ArrayView ArrayView::slice(int x1) { return this->slice(index1(x1)); }
+  ArrayView ArrayView::slice(int x1) {
+    const int index[] = {x1};
+    return slice_array(data(), index, 1, dim(), strides());
+  }
   ArrayView ArrayView::slice(int x1, int x2) {
-    return this->slice(index2(x1, x2));
+    const int index[] = {x1, x2};
+    return slice_array(data(), index, 2, dim(), strides());
   }
   ArrayView ArrayView::slice(int x1, int x2, int x3) {
-    return this->slice(index3(x1, x2, x3));
+    const int index[] = {x1, x2, x3};
+    return slice_array(data(), index, 3, dim(), strides());
   }
   ArrayView ArrayView::slice(int x1, int x2, int x3, int x4) {
-    return this->slice(index4(x1, x2, x3, x4));
+    const int index[] = {x1, x2, x3, x4};
+    return slice_array(data(), index, 4, dim(), strides());
   }
   ArrayView ArrayView::slice(int x1, int x2, int x3, int x4, int x5) {
-    return this->slice(index5(x1, x2, x3, x4, x5));
+    const int index[] = {x1, x2, x3, x4, x5};
+    return slice_array(data(), index, 5, dim(), strides());
   }
   ArrayView ArrayView::slice(int x1, int x2, int x3, int x4, int x5, int x6) {
-    return this->slice(index6(x1, x2, x3, x4, x5, x6));
+    const int index[] = {x1, x2, x3, x4, x5, x6};
+    return slice_array(data(), index, 6, dim(), strides());
   }
 
   ConstArrayView ArrayView::slice(int x1) const {
-    return this->slice(index1(x1));
+    const int index[] = {x1};
+    return slice_const_array(data(), index, 1, dim(), strides());
   }
   ConstArrayView ArrayView::slice(int x1, int x2) const {
-    return this->slice(index2(x1, x2));
+    const int index[] = {x1, x2};
+    return slice_const_array(data(), index, 2, dim(), strides());
   }
   ConstArrayView ArrayView::slice(int x1, int x2, int x3) const {
-    return this->slice(index3(x1, x2, x3));
+    const int index[] = {x1, x2, x3};
+    return slice_const_array(data(), index, 3, dim(), strides());
   }
   ConstArrayView ArrayView::slice(int x1, int x2, int x3, int x4) const {
-    return this->slice(index4(x1, x2, x3, x4));
+    const int index[] = {x1, x2, x3, x4};
+    return slice_const_array(data(), index, 4, dim(), strides());
   }
   ConstArrayView ArrayView::slice(int x1, int x2, int x3, int x4,
                                   int x5) const {
-    return this->slice(index5(x1, x2, x3, x4, x5));
+    const int index[] = {x1, x2, x3, x4, x5};
+    return slice_const_array(data(), index, 5, dim(), strides());
   }
   ConstArrayView ArrayView::slice(int x1, int x2, int x3, int x4, int x5,
                                   int x6) const {
-    return this->slice(index6(x1, x2, x3, x4, x5, x6));
+    const int index[] = {x1, x2, x3, x4, x5, x6};
+    return slice_const_array(data(), index, 6, dim(), strides());
   }
 
   ConstVectorView ArrayView::vector_slice(const std::vector<int> &index) const {
     return vector_slice_const_array(data(), index, dim(), strides());
   }
   ConstVectorView ArrayView::vector_slice(int x1) const {
-    return this->vector_slice(index1(x1));
+    const int index[] = {x1};
+    return vector_slice_const_array(data(), index, 1, dim(), strides());
   }
   ConstVectorView ArrayView::vector_slice(int x1, int x2) const {
-    return this->vector_slice(index2(x1, x2));
+    const int index[] = {x1, x2};
+    return vector_slice_const_array(data(), index, 2, dim(), strides());
   }
   ConstVectorView ArrayView::vector_slice(int x1, int x2, int x3) const {
-    return this->vector_slice(index3(x1, x2, x3));
+    const int index[] = {x1, x2, x3};
+    return vector_slice_const_array(data(), index, 3, dim(), strides());
   }
   ConstVectorView ArrayView::vector_slice(int x1, int x2, int x3,
                                           int x4) const {
-    return this->vector_slice(index4(x1, x2, x3, x4));
+    const int index[] = {x1, x2, x3, x4};
+    return vector_slice_const_array(data(), index, 4, dim(), strides());
   }
   ConstVectorView ArrayView::vector_slice(int x1, int x2, int x3, int x4,
                                           int x5) const {
-    return this->vector_slice(index5(x1, x2, x3, x4, x5));
+    const int index[] = {x1, x2, x3, x4, x5};
+    return vector_slice_const_array(data(), index, 5, dim(), strides());
   }
   ConstVectorView ArrayView::vector_slice(int x1, int x2, int x3, int x4,
                                           int x5, int x6) const {
-    return this->vector_slice(index6(x1, x2, x3, x4, x5, x6));
+    const int index[] = {x1, x2, x3, x4, x5, x6};
+    return vector_slice_const_array(data(), index, 6, dim(), strides());
   }
 
   VectorView ArrayView::vector_slice(const std::vector<int> &index) {
     return vector_slice_array(data(), index, dim(), strides());
   }
   VectorView ArrayView::vector_slice(int x1) {
-    return this->vector_slice(index1(x1));
+    const int index[] = {x1};
+    return vector_slice_array(data(), index, 1, dim(), strides());
   }
   VectorView ArrayView::vector_slice(int x1, int x2) {
-    return this->vector_slice(index2(x1, x2));
+    const int index[] = {x1, x2};
+    return vector_slice_array(data(), index, 2, dim(), strides());
   }
   VectorView ArrayView::vector_slice(int x1, int x2, int x3) {
-    return this->vector_slice(index3(x1, x2, x3));
+    const int index[] = {x1, x2, x3};
+    return vector_slice_array(data(), index, 3, dim(), strides());
   }
   VectorView ArrayView::vector_slice(int x1, int x2, int x3, int x4) {
-    return this->vector_slice(index4(x1, x2, x3, x4));
+    const int index[] = {x1, x2, x3, x4};
+    return vector_slice_array(data(), index, 4, dim(), strides());
   }
   VectorView ArrayView::vector_slice(int x1, int x2, int x3, int x4, int x5) {
-    return this->vector_slice(index5(x1, x2, x3, x4, x5));
+    const int index[] = {x1, x2, x3, x4, x5};
+    return vector_slice_array(data(), index, 5, dim(), strides());
   }
   VectorView ArrayView::vector_slice(int x1, int x2, int x3, int x4, int x5,
                                      int x6) {
-    return this->vector_slice(index6(x1, x2, x3, x4, x5, x6));
+    const int index[] = {x1, x2, x3, x4, x5, x6};
+    return vector_slice_array(data(), index, 6, dim(), strides());
   }
 
   ArrayIterator ArrayView::begin() { return ArrayIterator(this); }
@@ -644,24 +740,30 @@ namespace BOOM {
   }
 
   ConstArrayView ConstArrayView::slice(int x1) const {
-    return this->slice(index1(x1));
+    const int index[] = {x1};
+    return slice_const_array(data(), index, 1, dim(), strides());
   }
   ConstArrayView ConstArrayView::slice(int x1, int x2) const {
-    return this->slice(index2(x1, x2));
+    const int index[] = {x1, x2};
+    return slice_const_array(data(), index, 2, dim(), strides());
   }
   ConstArrayView ConstArrayView::slice(int x1, int x2, int x3) const {
-    return this->slice(index3(x1, x2, x3));
+    const int index[] = {x1, x2, x3};
+    return slice_const_array(data(), index, 3, dim(), strides());
   }
   ConstArrayView ConstArrayView::slice(int x1, int x2, int x3, int x4) const {
-    return this->slice(index4(x1, x2, x3, x4));
+    const int index[] = {x1, x2, x3, x4};
+    return slice_const_array(data(), index, 4, dim(), strides());
   }
   ConstArrayView ConstArrayView::slice(int x1, int x2, int x3, int x4,
                                        int x5) const {
-    return this->slice(index5(x1, x2, x3, x4, x5));
+    const int index[] = {x1, x2, x3, x4, x5};
+    return slice_const_array(data(), index, 5, dim(), strides());
   }
   ConstArrayView ConstArrayView::slice(int x1, int x2, int x3, int x4, int x5,
                                        int x6) const {
-    return this->slice(index6(x1, x2, x3, x4, x5, x6));
+    const int index[] = {x1, x2, x3, x4, x5, x6};
+    return slice_const_array(data(), index, 6, dim(), strides());
   }
 
   ConstVectorView ConstArrayView::vector_slice(
@@ -669,25 +771,31 @@ namespace BOOM {
     return vector_slice_const_array(data(), index, dim(), strides());
   }
   ConstVectorView ConstArrayView::vector_slice(int x1) const {
-    return this->vector_slice(index1(x1));
+    const int index[] = {x1};
+    return vector_slice_const_array(data(), index, 1, dim(), strides());
   }
   ConstVectorView ConstArrayView::vector_slice(int x1, int x2) const {
-    return this->vector_slice(index2(x1, x2));
+    const int index[] = {x1, x2};
+    return vector_slice_const_array(data(), index, 2, dim(), strides());
   }
   ConstVectorView ConstArrayView::vector_slice(int x1, int x2, int x3) const {
-    return this->vector_slice(index3(x1, x2, x3));
+    const int index[] = {x1, x2, x3};
+    return vector_slice_const_array(data(), index, 3, dim(), strides());
   }
   ConstVectorView ConstArrayView::vector_slice(int x1, int x2, int x3,
                                                int x4) const {
-    return this->vector_slice(index4(x1, x2, x3, x4));
+    const int index[] = {x1, x2, x3, x4};
+    return vector_slice_const_array(data(), index, 4, dim(), strides());
   }
   ConstVectorView ConstArrayView::vector_slice(int x1, int x2, int x3, int x4,
                                                int x5) const {
-    return this->vector_slice(index5(x1, x2, x3, x4, x5));
+    const int index[] = {x1, x2, x3, x4, x5};
+    return vector_slice_const_array(data(), index, 5, dim(), strides());
   }
   ConstVectorView ConstArrayView::vector_slice(int x1, int x2, int x3, int x4,
                                                int x5, int x6) const {
-    return this->vector_slice(index6(x1, x2, x3, x4, x5, x6));
+    const int index[] = {x1, x2, x3, x4, x5, x6};
+    return vector_slice_const_array(data(), index, 6, dim(), strides());
   }
 
   ConstArrayIterator ConstArrayView::begin() const {
@@ -846,37 +954,55 @@ namespace BOOM {
     return slice_const_array(data(), index, dim(), strides());
   }
 
-  ArrayView Array::slice(int x1) { return this->slice(index1(x1)); }
-  ArrayView Array::slice(int x1, int x2) { return this->slice(index2(x1, x2)); }
+  ArrayView Array::slice(int x1) {
+    const int index[] = {x1};
+    return slice_array(data(), index, 1, dim(), strides());
+  }
+  ArrayView Array::slice(int x1, int x2) {
+    const int index[] = {x1, x2};
+    return slice_array(data(), index, 2, dim(), strides());
+  }
   ArrayView Array::slice(int x1, int x2, int x3) {
-    return this->slice(index3(x1, x2, x3));
+    const int index[] = {x1, x2, x3};
+    return slice_array(data(), index, 3, dim(), strides());
   }
   ArrayView Array::slice(int x1, int x2, int x3, int x4) {
-    return this->slice(index4(x1, x2, x3, x4));
+    const int index[] = {x1, x2, x3, x4};
+    return slice_array(data(), index, 4, dim(), strides());
   }
   ArrayView Array::slice(int x1, int x2, int x3, int x4, int x5) {
-    return this->slice(index5(x1, x2, x3, x4, x5));
+    const int index[] = {x1, x2, x3, x4, x5};
+    return slice_array(data(), index, 5, dim(), strides());
   }
   ArrayView Array::slice(int x1, int x2, int x3, int x4, int x5, int x6) {
-    return this->slice(index6(x1, x2, x3, x4, x5, x6));
+    const int index[] = {x1, x2, x3, x4, x5, x6};
+    return slice_array(data(), index, 6, dim(), strides());
   }
 
-  ConstArrayView Array::slice(int x1) const { return this->slice(index1(x1)); }
+  ConstArrayView Array::slice(int x1) const {
+    const int index[] = {x1};
+    return slice_const_array(data(), index, 1, dim(), strides());
+  }
   ConstArrayView Array::slice(int x1, int x2) const {
-    return this->slice(index2(x1, x2));
+    const int index[] = {x1, x2};
+    return slice_const_array(data(), index, 2, dim(), strides());
   }
   ConstArrayView Array::slice(int x1, int x2, int x3) const {
-    return this->slice(index3(x1, x2, x3));
+    const int index[] = {x1, x2, x3};
+    return slice_const_array(data(), index, 3, dim(), strides());
   }
   ConstArrayView Array::slice(int x1, int x2, int x3, int x4) const {
-    return this->slice(index4(x1, x2, x3, x4));
+    const int index[] = {x1, x2, x3, x4};
+    return slice_const_array(data(), index, 4, dim(), strides());
   }
   ConstArrayView Array::slice(int x1, int x2, int x3, int x4, int x5) const {
-    return this->slice(index5(x1, x2, x3, x4, x5));
+    const int index[] = {x1, x2, x3, x4, x5};
+    return slice_const_array(data(), index, 5, dim(), strides());
   }
   ConstArrayView Array::slice(int x1, int x2, int x3, int x4, int x5,
                               int x6) const {
-    return this->slice(index6(x1, x2, x3, x4, x5, x6));
+    const int index[] = {x1, x2, x3, x4, x5, x6};
+    return slice_const_array(data(), index, 6, dim(), strides());
   }
 
   ConstVectorView Array::vector_slice(const std::vector<int> &index) const {
@@ -884,47 +1010,59 @@ namespace BOOM {
     return view.vector_slice(index);
   }
   ConstVectorView Array::vector_slice(int x1) const {
-    return this->vector_slice(index1(x1));
+    const int index[] = {x1};
+    return vector_slice_const_array(data(), index, 1, dim(), strides());
   }
   ConstVectorView Array::vector_slice(int x1, int x2) const {
-    return this->vector_slice(index2(x1, x2));
+    const int index[] = {x1, x2};
+    return vector_slice_const_array(data(), index, 2, dim(), strides());
   }
   ConstVectorView Array::vector_slice(int x1, int x2, int x3) const {
-    return this->vector_slice(index3(x1, x2, x3));
+    const int index[] = {x1, x2, x3};
+    return vector_slice_const_array(data(), index, 3, dim(), strides());
   }
   ConstVectorView Array::vector_slice(int x1, int x2, int x3, int x4) const {
-    return this->vector_slice(index4(x1, x2, x3, x4));
+    const int index[] = {x1, x2, x3, x4};
+    return vector_slice_const_array(data(), index, 4, dim(), strides());
   }
   ConstVectorView Array::vector_slice(int x1, int x2, int x3, int x4,
                                       int x5) const {
-    return this->vector_slice(index5(x1, x2, x3, x4, x5));
+    const int index[] = {x1, x2, x3, x4, x5};
+    return vector_slice_const_array(data(), index, 5, dim(), strides());
   }
   ConstVectorView Array::vector_slice(int x1, int x2, int x3, int x4, int x5,
                                       int x6) const {
-    return this->vector_slice(index6(x1, x2, x3, x4, x5, x6));
+    const int index[] = {x1, x2, x3, x4, x5, x6};
+    return vector_slice_const_array(data(), index, 6, dim(), strides());
   }
   VectorView Array::vector_slice(const std::vector<int> &index) {
     ArrayView view(*this);
     return view.vector_slice(index);
   }
   VectorView Array::vector_slice(int x1) {
-    return this->vector_slice(index1(x1));
+    const int index[] = {x1};
+    return vector_slice_array(data(), index, 1, dim(), strides());
   }
   VectorView Array::vector_slice(int x1, int x2) {
-    return this->vector_slice(index2(x1, x2));
+    const int index[] = {x1, x2};
+    return vector_slice_array(data(), index, 2, dim(), strides());
   }
   VectorView Array::vector_slice(int x1, int x2, int x3) {
-    return this->vector_slice(index3(x1, x2, x3));
+    const int index[] = {x1, x2, x3};
+    return vector_slice_array(data(), index, 3, dim(), strides());
   }
   VectorView Array::vector_slice(int x1, int x2, int x3, int x4) {
-    return this->vector_slice(index4(x1, x2, x3, x4));
+    const int index[] = {x1, x2, x3, x4};
+    return vector_slice_array(data(), index, 4, dim(), strides());
   }
   VectorView Array::vector_slice(int x1, int x2, int x3, int x4, int x5) {
-    return this->vector_slice(index5(x1, x2, x3, x4, x5));
+    const int index[] = {x1, x2, x3, x4, x5};
+    return vector_slice_array(data(), index, 5, dim(), strides());
   }
   VectorView Array::vector_slice(int x1, int x2, int x3, int x4, int x5,
                                  int x6) {
-    return this->vector_slice(index6(x1, x2, x3, x4, x5, x6));
+    const int index[] = {x1, x2, x3, x4, x5, x6};
+    return vector_slice_array(data(), index, 6, dim(), strides());
   }
 
   bool Array::operator==(const Array &rhs) const {
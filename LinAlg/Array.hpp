@@ -26,6 +26,7 @@
 #include "LinAlg/Vector.hpp"
 #include "LinAlg/VectorView.hpp"
 
+#include <sstream>
 #include <vector>
 #include "cpputil/report_error.hpp"
 
@@ -77,7 +78,9 @@ namespace BOOM {
 
     // operator() is supported for up to six arguments.  An
     // exception will be thrown if the number of arguments supplied
-    // does not match the dimension of dims_ and strides_.
+    // does not match the dimension of dims_ and strides_.  The
+    // arguments are bounds checked, but no memory is allocated.  See
+    // FixedRankArrayView for unchecked access in inner loops.
     double operator()(int x1) const;
     double operator()(int x1, int x2) const;
     double operator()(int x1, int x2, int x3) const;
@@ -164,6 +167,97 @@ namespace BOOM {
   inline bool operator==(const Matrix &lhs, const ConstArrayBase &rhs) {
     return rhs == lhs;
   }
+  //======================================================================
+  // Views of an array whose number of dimensions is known at compile time.
+  // The dimensions and strides are copied into fixed-size arrays when the
+  // view is created, so element access is a handful of multiply-adds on a
+  // raw pointer, with no bounds checks and no memory allocation.  This is
+  // the tool for inner loops.  Use the host's operator() where checked
+  // access is wanted.
+  //
+  // The view does not own its data.  It is invalidated if the host array
+  // is resized or destroyed.
+  //
+  // Idiom:
+  //   ConstFixedRankArrayView<3> probs(transition_probabilities);
+  //   for (int k = 0; k < probs.dim(2); ++k) {
+  //     total += probs(i, j, k);
+  //   }
+  template <int RANK>
+  class FixedRankArrayShape {
+   public:
+    static_assert(RANK > 0, "Arrays must have at least one dimension.");
+
+    explicit FixedRankArrayShape(const ConstArrayBase &array) {
+      if (array.ndim() != RANK) {
+        std::ostringstream err;
+        err << "A fixed rank view of rank " << RANK
+            << " cannot be created from an array with " << array.ndim()
+            << " dimensions.";
+        report_error(err.str());
+      }
+      for (int i = 0; i < RANK; ++i) {
+        dims_[i] = array.dim(i);
+        strides_[i] = array.stride(i);
+      }
+    }
+
+    int dim(int i) const { return dims_[i]; }
+    int stride(int i) const { return strides_[i]; }
+
+    // The position in the host's data of the element with the given
+    // indices.
+    template <class... INDICES>
+    int offset(INDICES... index) const {
+      static_assert(sizeof...(INDICES) == RANK,
+                    "The number of indices must match the rank of the view.");
+      const int position[] = {static_cast<int>(index)...};
+      int ans = 0;
+      for (int i = 0; i < RANK; ++i) {
+        ans += position[i] * strides_[i];
+      }
+      return ans;
+    }
+
+   private:
+    int dims_[RANK];
+    int strides_[RANK];
+  };
+
+  template <int RANK>
+  class ConstFixedRankArrayView : public FixedRankArrayShape<RANK> {
+   public:
+    explicit ConstFixedRankArrayView(const ConstArrayBase &array)
+        : FixedRankArrayShape<RANK>(array), data_(array.data()) {}
+
+    const double *data() const { return data_; }
+
+    template <class... INDICES>
+    double operator()(INDICES... index) const {
+      return data_[this->offset(index...)];
+    }
+
+   private:
+    const double *data_;
+  };
+
+  template <int RANK>
+  class FixedRankArrayView : public FixedRankArrayShape<RANK> {
+   public:
+    explicit FixedRankArrayView(ArrayBase &array)
+        : FixedRankArrayShape<RANK>(array), data_(array.data()) {}
+
+    double *data() const { return data_; }
+
+    template <class... INDICES>
+    double &operator()(INDICES... index) const {
+      return data_[this->offset(index...)];
+    }
+
+   private:
+    double *data_;
+  };
+
   //======================================================================
   class Array;
   class ConstArrayView : public ConstArrayBase {
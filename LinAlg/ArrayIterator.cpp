@@ -24,7 +24,23 @@
 namespace BOOM {
 
   ArrayPositionManager::ArrayPositionManager(const std::vector<int> &dims)
-      : dims_(dims), position_(dims.size(), 0), at_end_(false) {
+      : dims_(dims),
+        strides_(nullptr),
+        position_(dims.size(), 0),
+        offset_(0),
+        at_end_(false) {
+    if (dims_.empty()) {
+      at_end_ = true;
+    }
+  }
+
+  ArrayPositionManager::ArrayPositionManager(const std::vector<int> &dims,
+                                             const std::vector<int> &strides)
+      : dims_(dims),
+        strides_(&strides),
+        position_(dims.size(), 0),
+        offset_(0),
+        at_end_(false) {
     if (dims_.empty()) {
       at_end_ = true;
     }
@@ -39,6 +55,9 @@ namespace BOOM {
     // you can advance.
     for (int which_index = 0; which_index < dims_.size(); ++which_index) {
       ++position_[which_index];
+      if (strides_) {
+        offset_ += (*strides_)[which_index];
+      }
       if (position_[which_index] < dims_[which_index]) {
         // This is the normal case.  Increment the iterator in its
         // current position.
@@ -49,6 +68,9 @@ namespace BOOM {
         // will increment the next position in the next part of the
         // loop.
         position_[which_index] = 0;
+        if (strides_) {
+          offset_ -= dims_[which_index] * (*strides_)[which_index];
+        }
       }
     }
     // At this point we've made it all the way through the for loop,
@@ -60,6 +82,7 @@ namespace BOOM {
 
   void ArrayPositionManager::reset() {
     position_.assign(dims_.size(), 0);
+    offset_ = 0;
     at_end_ = false;
     if (dims_.empty()) {
       at_end_ = true;
@@ -106,6 +129,12 @@ namespace BOOM {
       }
     }
     position_ = position;
+    offset_ = 0;
+    if (strides_) {
+      for (int i = 0; i < dims_.size(); ++i) {
+        offset_ += position_[i] * (*strides_)[i];
+      }
+    }
     at_end_ = false;
   }
 
@@ -113,36 +142,36 @@ namespace BOOM {
 
   ArrayIterator::ArrayIterator(ArrayBase *host,
                                const std::vector<int> &starting_position)
-      : host_(host), position_(host->dim()) {
+      : host_(host), position_(host->dim(), host->strides()) {
     position_.set_position(starting_position);
   }
 
   ArrayIterator::ArrayIterator(ArrayBase *host)
-      : host_(host), position_(host->dim()) {}
+      : host_(host), position_(host->dim(), host->strides()) {}
 
   double &ArrayIterator::operator*() {
     if (position_.at_end()) {
       report_error("ArrayIterator dereference past end of data.");
     }
-    return (*host_)[position_.position()];
+    return host_->data()[position_.offset()];
   }
 
   //======================================================================
 
   ConstArrayIterator::ConstArrayIterator(
       const ConstArrayBase *host, const std::vector<int> &starting_position)
-      : host_(host), position_(host->dim()) {
+      : host_(host), position_(host->dim(), host->strides()) {
     position_.set_position(starting_position);
   }
 
   ConstArrayIterator::ConstArrayIterator(const ConstArrayBase *host)
-      : host_(host), position_(host->dim()) {}
+      : host_(host), position_(host->dim(), host->strides()) {}
 
   double ConstArrayIterator::operator*() const {
     if (position_.at_end()) {
       report_error("ConstArrayIterator dereference past end of data.");
     }
-    return (*host_)[position()];
+    return host_->data()[position_.offset()];
   }
 
 }  // namespace BOOM
@@ -30,6 +30,13 @@ namespace BOOM {
   class ArrayPositionManager {
    public:
     explicit ArrayPositionManager(const std::vector<int> &dims);
+
+    // If the strides of the host array are supplied then the manager also
+    // tracks offset(), the position of the current element in the host's
+    // data.  The offset is updated incrementally as the position advances,
+    // so dereferencing an iterator does not recompute the full index.
+    ArrayPositionManager(const std::vector<int> &dims,
+                         const std::vector<int> &strides);
     void operator++();
 
     // Move the position back to the beginning.
@@ -47,9 +54,15 @@ namespace BOOM {
     const std::vector<int> &position() const { return position_; }
     void set_position(const std::vector<int> &position);
 
+    // The location of the current position in the host's data.  Only
+    // meaningful if strides were supplied to the constructor.
+    int offset() const { return offset_; }
+
    private:
     const std::vector<int> &dims_;
+    const std::vector<int> *strides_;
     std::vector<int> position_;
+    int offset_;
     bool at_end_;
   };
 
@@ -28,6 +28,31 @@
 namespace BOOM {
   namespace {
     using Eigen::MatrixXd;
+
+    // Replace the lower triangular block of L starting at (start, start),
+    // which is the factor of some matrix B, with the factor of B + sign * w *
+    // w^T, where sign is +1 or -1.  w is the same size as the block, and is
+    // destroyed.  Returns false if a downdate fails to be positive definite,
+    // in which case L has been partially modified.
+    bool rank_one_modify(Matrix &L, int start, Vector &w, double sign) {
+      int n = L.nrow();
+      for (int k = start; k < n; ++k) {
+        double Lkk = L(k, k);
+        double wk = w[k - start];
+        double r2 = Lkk * Lkk + sign * wk * wk;
+        if (!(r2 > 0)) return false;
+        double r = std::sqrt(r2);
+        double c = r / Lkk;
+        double s = wk / Lkk;
+        L(k, k) = r;
+        for (int i = k + 1; i < n; ++i) {
+          double Lik = (L(i, k) + sign * s * w[i - start]) / c;
+          L(i, k) = Lik;
+          w[i - start] = c * w[i - start] - s * Lik;
+        }
+      }
+      return true;
+    }
   }  // namespace
 
   void Cholesky::decompose(const Matrix &A) {
@@ -35,12 +60,16 @@ namespace BOOM {
       pos_def_ = false;
       lower_cholesky_triangle_ = Matrix();
     } else {
-      lower_cholesky_triangle_.resize(A.nrow(), A.ncol());
-      Eigen::LLT<MatrixXd> eigen_cholesky(EigenMap(A));
+      // Factor in place, so that decomposing a sequence of matrices of the
+      // same size (e.g. once per MCMC iteration) reuses the same storage.
+      lower_cholesky_triangle_ = A;
+      auto factor = EigenMap(lower_cholesky_triangle_);
+      Eigen::LLT<Eigen::Ref<MatrixXd>> eigen_cholesky(factor);
       pos_def_ = eigen_cholesky.info() == Eigen::Success;
       if (pos_def_) {
-        // If the fast version of the cholesky decomposition works, we're done!
-        EigenMap(lower_cholesky_triangle_) = eigen_cholesky.matrixL();
+        // If the fast version of the cholesky decomposition works, we're
+        // done, once the upper triangle left over from A is cleared.
+        factor.triangularView<Eigen::StrictlyUpper>().setZero();
       } else if (A.is_sym()) {
         // If the fast Cholesky decomposition failed, try a more robust version.
         Eigen::LDLT<MatrixXd> eigen_cholesky_safe(EigenMap(A));
@@ -112,7 +141,33 @@ namespace BOOM {
     return ans;
   }
 
+  void Cholesky::solve_inplace(VectorView b) const {
+    check();
+    if (b.size() != dim()) {
+      report_error("Wrong size argument to Cholesky::solve_inplace.");
+    }
+    auto L = EigenMap(lower_cholesky_triangle_);
+    auto eigen_b = EigenMap(b);
+    L.triangularView<Eigen::Lower>().solveInPlace(eigen_b);
+    L.transpose().triangularView<Eigen::Upper>().solveInPlace(eigen_b);
+  }
+
+  void Cholesky::upper_solve_inplace(VectorView b) const {
+    check();
+    if (b.size() != dim()) {
+      report_error("Wrong size argument to Cholesky::upper_solve_inplace.");
+    }
+    auto eigen_b = EigenMap(b);
+    EigenMap(lower_cholesky_triangle_).transpose()
+        .triangularView<Eigen::Upper>().solveInPlace(eigen_b);
+  }
+
   // returns the log of the determinant of A
+  Vector Cholesky::lower_solve(const Vector &b) const {
+    check();
+    return Lsolve(lower_cholesky_triangle_, b);
+  }
+
   double Cholesky::logdet() const {
     check();
     ConstVectorView d(diag(lower_cholesky_triangle_));
@@ -130,6 +185,114 @@ namespace BOOM {
     return ans * ans;
   }
 
+  void Cholesky::rank_one_update(const ConstVectorView &v) {
+    check();
+    if (v.size() != dim()) {
+      report_error("Wrong size vector passed to Cholesky::rank_one_update.");
+    }
+    Vector w(v);
+    rank_one_modify(lower_cholesky_triangle_, 0, w, 1.0);
+  }
+
+  bool Cholesky::rank_one_downdate(const ConstVectorView &v) {
+    check();
+    if (v.size() != dim()) {
+      report_error("Wrong size vector passed to Cholesky::rank_one_downdate.");
+    }
+    Matrix L = lower_cholesky_triangle_;
+    Vector w(v);
+    if (!rank_one_modify(L, 0, w, -1.0)) {
+      return false;
+    }
+    lower_cholesky_triangle_ = std::move(L);
+    return true;
+  }
+
+  // Partition A and its new row and column as
+  //   [A11 a12 A13]     [L11           ]
+  //   [a21 a22 a23]  =  [l21  l22      ] * (transpose)
+  //   [A31 a32 A33]     [L31  l32  L33n]
+  // Then l21 solves L11 * l21 = a12, l22 = sqrt(a22 - l21'l21), l32 = (a32 -
+  // L31 * l21) / l22, and L33n is the factor of L33 * L33' - l32 * l32'.
+  bool Cholesky::add_row_col(int position, const ConstVectorView &column) {
+    check();
+    int n = dim();
+    if (position < 0 || position > n) {
+      report_error("Illegal position in Cholesky::add_row_col.");
+    }
+    if (column.size() != n + 1) {
+      report_error("Wrong size column passed to Cholesky::add_row_col.");
+    }
+    const Matrix &L(lower_cholesky_triangle_);
+    int p = position;
+
+    Vector l21(p);
+    for (int i = 0; i < p; ++i) {
+      double value = column[i];
+      for (int j = 0; j < i; ++j) {
+        value -= L(i, j) * l21[j];
+      }
+      l21[i] = value / L(i, i);
+    }
+    double l22_squared = column[p] - l21.normsq();
+    if (!(l22_squared > 0)) {
+      return false;
+    }
+    double l22 = std::sqrt(l22_squared);
+
+    Matrix ans(n + 1, n + 1, 0.0);
+    for (int j = 0; j < p; ++j) {
+      for (int i = j; i < p; ++i) ans(i, j) = L(i, j);
+      ans(p, j) = l21[j];
+      for (int i = p; i < n; ++i) ans(i + 1, j) = L(i, j);
+    }
+    ans(p, p) = l22;
+    Vector l32(n - p);
+    for (int i = p; i < n; ++i) {
+      double value = column[i + 1];
+      for (int j = 0; j < p; ++j) {
+        value -= L(i, j) * l21[j];
+      }
+      l32[i - p] = value / l22;
+      ans(i + 1, p) = l32[i - p];
+    }
+    for (int j = p; j < n; ++j) {
+      for (int i = j; i < n; ++i) ans(i + 1, j + 1) = L(i, j);
+    }
+    if (!rank_one_modify(ans, p + 1, l32, -1.0)) {
+      return false;
+    }
+    lower_cholesky_triangle_ = std::move(ans);
+    return true;
+  }
+
+  // Removing row and column 'position' from A leaves L11 and L31 (in the
+  // notation of add_row_col) unchanged, and replaces L33 with the factor of
+  // L33 * L33' + l32 * l32'.
+  void Cholesky::drop_row_col(int position) {
+    check();
+    int n = dim();
+    if (position < 0 || position >= n) {
+      report_error("Illegal position in Cholesky::drop_row_col.");
+    }
+    const Matrix &L(lower_cholesky_triangle_);
+    int p = position;
+    Matrix ans(n - 1, n - 1, 0.0);
+    for (int j = 0; j < p; ++j) {
+      for (int i = j; i < p; ++i) ans(i, j) = L(i, j);
+      for (int i = p + 1; i < n; ++i) ans(i - 1, j) = L(i, j);
+    }
+    Vector l32(n - p - 1);
+    for (int i = p + 1; i < n; ++i) {
+      l32[i - p - 1] = L(i, p);
+    }
+    for (int j = p + 1; j < n; ++j) {
+      for (int i = j; i < n; ++i) ans(i - 1, j - 1) = L(i, j);
+    }
+    rank_one_modify(ans, p, l32, 1.0);
+    lower_cholesky_triangle_ = std::move(ans);
+  }
+
   void Cholesky::check() const {
     if (!pos_def_) {
       std::ostringstream err;
@@ -36,7 +36,8 @@ namespace BOOM {
     explicit Cholesky(const Matrix &A) { decompose(A); }
 
     // Compute and store the Cholesky factor of the matrix 'A'.  Any previous
-    // decomposition is discarded.
+    // decomposition is discarded, but its storage is reused if A has the same
+    // dimension.
     void decompose(const Matrix &A);
 
     // All three of these return the number of rows in the represented matrix
@@ -64,6 +65,18 @@ namespace BOOM {
     // The (inverse of A) times b.
     Vector solve(const Vector &b) const;
 
+    // b = A^{-1} * b, without allocating.
+    void solve_inplace(VectorView b) const;
+
+    // b = (L^T)^{-1} * b, where L is the lower Cholesky triangle.  If A is a
+    // precision matrix and b holds standard normal deviates, the result is
+    // a draw from N(0, A^{-1}).
+    void upper_solve_inplace(VectorView b) const;
+
+    // L^{-1} * b, where L is the lower Cholesky triangle.  The squared norm
+    // of the result is the quadratic form b^T A^{-1} b.
+    Vector lower_solve(const Vector &b) const;
+
     // The inverse of A.
     SpdMatrix inv() const;  // inverse of A
 
@@ -82,6 +95,39 @@ namespace BOOM {
     // trusted, and may result in errors or exceptions.
     bool is_pos_def() const { return pos_def_; }
 
+    //--------------------------------------------------------------------------
+    // The following functions modify the represented matrix A and update the
+    // Cholesky factor to match, in O(dim^2) operations instead of the O(dim^3)
+    // needed to decompose the modified matrix from scratch.  They are intended
+    // for algorithms (e.g. stochastic search variable selection) that make a
+    // long series of small changes to a matrix.  Each requires is_pos_def().
+
+    // A += v * v^T.
+    void rank_one_update(const ConstVectorView &v);
+
+    // A -= v * v^T.  Returns true on success.  If the downdated matrix is not
+    // positive definite then false is returned, and the decomposition is left
+    // unchanged.
+    bool rank_one_downdate(const ConstVectorView &v);
+
+    // Insert a new row and column into A.  The dimension of A grows by one.
+    //
+    // Args:
+    //   position: The index of the new row and column in the enlarged A.
+    //     Must be in 0..dim().
+    //   column: The new column of A, of size dim() + 1.  Element 'position'
+    //     is the new diagonal element.
+    //
+    // Returns:
+    //   true on success.  If the enlarged matrix would not be positive
+    //   definite then false is returned and the decomposition is left
+    //   unchanged.
+    bool add_row_col(int position, const ConstVectorView &column);
+
+    // Remove row and column 'position' from A.  The dimension of A shrinks by
+    // one.  The result is always positive definite.
+    void drop_row_col(int position);
+
    private:
     Matrix lower_cholesky_triangle_;
     bool pos_def_;
@@ -21,6 +21,7 @@
 
 #include "Eigen/Core"
 #include "LinAlg/Matrix.hpp"
+#include "LinAlg/SubMatrix.hpp"
 #include "LinAlg/Vector.hpp"
 
 namespace BOOM {
@@ -36,6 +37,38 @@ namespace BOOM {
     return ::Eigen::Map<const ::Eigen::MatrixXd>(m.data(), m.nrow(), m.ncol());
   }
 
+  // Maps for SubMatrix and ConstSubMatrix.  Columns are contiguous, but
+  // adjacent columns are outer_stride() apart.
+  inline ::Eigen::Map<::Eigen::MatrixXd, ::Eigen::Unaligned,
+                      ::Eigen::OuterStride<::Eigen::Dynamic>>
+  EigenMap(SubMatrix &m) {
+    return ::Eigen::Map<::Eigen::MatrixXd,
+                        ::Eigen::Unaligned,
+                        ::Eigen::OuterStride<::Eigen::Dynamic>>(
+        m.data(), m.nrow(), m.ncol(),
+        ::Eigen::OuterStride<::Eigen::Dynamic>(m.outer_stride()));
+  }
+
+  inline ::Eigen::Map<const ::Eigen::MatrixXd, ::Eigen::Unaligned,
+                      ::Eigen::OuterStride<::Eigen::Dynamic>>
+  EigenMap(const SubMatrix &m) {
+    return ::Eigen::Map<const ::Eigen::MatrixXd,
+                        ::Eigen::Unaligned,
+                        ::Eigen::OuterStride<::Eigen::Dynamic>>(
+        m.data(), m.nrow(), m.ncol(),
+        ::Eigen::OuterStride<::Eigen::Dynamic>(m.outer_stride()));
+  }
+
+  inline ::Eigen::Map<const ::Eigen::MatrixXd, ::Eigen::Unaligned,
+                      ::Eigen::OuterStride<::Eigen::Dynamic>>
+  EigenMap(const ConstSubMatrix &m) {
+    return ::Eigen::Map<const ::Eigen::MatrixXd,
+                        ::Eigen::Unaligned,
+                        ::Eigen::OuterStride<::Eigen::Dynamic>>(
+        m.data(), m.nrow(), m.ncol(),
+        ::Eigen::OuterStride<::Eigen::Dynamic>(m.outer_stride()));
+  }
+
   // Maps for Vectors
   inline ::Eigen::Map<::Eigen::VectorXd> EigenMap(Vector &v) {
     return ::Eigen::Map<::Eigen::VectorXd>(v.data(), v.size());
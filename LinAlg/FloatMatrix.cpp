@@ -0,0 +1,189 @@
+/*
+  Copyright (C) 2005-2024 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include "LinAlg/FloatMatrix.hpp"
+#include <algorithm>
+#include <sstream>
+#include "LinAlg/EigenMap.hpp"
+#include "cpputil/cpu_dispatch.hpp"
+#include "cpputil/report_error.hpp"
+
+namespace BOOM {
+
+  namespace {
+    // The number of rows converted to double at a time.  Large enough to
+    // amortize the per-block overhead, small enough for the block to stay
+    // in cache for moderate numbers of columns.
+    const int kRowBlockSize = 256;
+
+    void check_size(int actual, int expected, const char *what,
+                    const char *caller) {
+      if (actual != expected) {
+        std::ostringstream err;
+        err << "Size mismatch in " << caller << ": " << what << " has size "
+            << actual << " but " << expected << " was expected.";
+        report_error(err.str());
+      }
+    }
+
+    // out[i] = x[i], i = 0, ..., n-1.
+    BOOM_TARGET_CLONES
+    void widen(const float *x, int n, double *out) {
+      for (int i = 0; i < n; ++i) {
+        out[i] = x[i];
+      }
+    }
+
+    // ans[i] += scale * x[i], i = 0, ..., n-1.
+    BOOM_TARGET_CLONES
+    void add_scaled_floats(const float *x, int n, double scale, double *ans) {
+      for (int i = 0; i < n; ++i) {
+        ans[i] += scale * x[i];
+      }
+    }
+  }  // namespace
+
+  ConstFloatSubMatrix ConstFloatSubMatrix::rows(int begin, int end) const {
+    if (begin < 0 || end > nrow_ || begin > end) {
+      report_error("Invalid row range in ConstFloatSubMatrix::rows.");
+    }
+    return ConstFloatSubMatrix(data_ + begin, end - begin, ncol_, stride_);
+  }
+
+  ConstFloatSubMatrix ConstFloatSubMatrix::columns(int begin, int end) const {
+    if (begin < 0 || end > ncol_ || begin > end) {
+      report_error("Invalid column range in ConstFloatSubMatrix::columns.");
+    }
+    return ConstFloatSubMatrix(data_ + begin * stride_, nrow_, end - begin,
+                               stride_);
+  }
+
+  Vector ConstFloatSubMatrix::row(int i) const {
+    Vector ans(ncol_);
+    for (int j = 0; j < ncol_; ++j) {
+      ans[j] = (*this)(i, j);
+    }
+    return ans;
+  }
+
+  Vector ConstFloatSubMatrix::col(int j) const {
+    return Vector(col_begin(j), col_end(j));
+  }
+
+  void ConstFloatSubMatrix::copy_rows(int begin, int end,
+                                      Matrix &block) const {
+    const int nrow = end - begin;
+    block.resize(nrow, ncol_);
+    for (int j = 0; j < ncol_; ++j) {
+      widen(col_begin(j) + begin, nrow,
+            block.data() + static_cast<int64_t>(j) * nrow);
+    }
+  }
+
+  Matrix ConstFloatSubMatrix::to_matrix() const {
+    Matrix ans;
+    copy_rows(0, nrow_, ans);
+    return ans;
+  }
+
+  //===========================================================================
+  FloatMatrix::FloatMatrix(int nrow, int ncol, float value)
+      : nrow_(nrow),
+        ncol_(ncol),
+        data_(static_cast<int64_t>(nrow) * ncol, value) {}
+
+  FloatMatrix::FloatMatrix(const ConstSubMatrix &m)
+      : nrow_(m.nrow()),
+        ncol_(m.ncol()),
+        data_(static_cast<int64_t>(m.nrow()) * m.ncol()) {
+    for (int j = 0; j < ncol_; ++j) {
+      std::copy(m.col_begin(j), m.col_end(j),
+                data_.begin() + static_cast<int64_t>(j) * nrow_);
+    }
+  }
+
+  void FloatMatrix::set_row(int i, const ConstVectorView &values) {
+    check_size(values.size(), ncol_, "values", "FloatMatrix::set_row");
+    for (int j = 0; j < ncol_; ++j) {
+      (*this)(i, j) = values[j];
+    }
+  }
+
+  void FloatMatrix::set_col(int j, const ConstVectorView &values) {
+    check_size(values.size(), nrow_, "values", "FloatMatrix::set_col");
+    std::copy(values.begin(), values.end(),
+              data_.begin() + static_cast<int64_t>(j) * nrow_);
+  }
+
+  //===========================================================================
+  Vector float_matrix_vector_product(const ConstFloatSubMatrix &X,
+                                     const ConstVectorView &v) {
+    check_size(v.size(), X.ncol(), "v", "float_matrix_vector_product");
+    // X * v is accumulated a column at a time, reading X directly rather
+    // than through a converted block.  Working on one block of rows at a
+    // time keeps that part of the answer in cache.
+    Vector ans(X.nrow(), 0.0);
+    for (int begin = 0; begin < X.nrow(); begin += kRowBlockSize) {
+      int end = std::min(begin + kRowBlockSize, X.nrow());
+      for (int j = 0; j < X.ncol(); ++j) {
+        add_scaled_floats(X.col_begin(j) + begin, end - begin, v[j],
+                          ans.data() + begin);
+      }
+    }
+    return ans;
+  }
+
+  Vector float_transpose_matrix_vector_product(const ConstFloatSubMatrix &X,
+                                               const ConstVectorView &v) {
+    check_size(v.size(), X.nrow(), "v",
+               "float_transpose_matrix_vector_product");
+    Vector ans(X.ncol(), 0.0);
+    Matrix block;
+    for (int begin = 0; begin < X.nrow(); begin += kRowBlockSize) {
+      int end = std::min(begin + kRowBlockSize, X.nrow());
+      X.copy_rows(begin, end, block);
+      EigenMap(ans).noalias() += EigenMap(block).transpose() *
+          EigenMap(ConstVectorView(v, begin, end - begin));
+    }
+    return ans;
+  }
+
+  Matrix float_matrix_product(const ConstFloatSubMatrix &X, const Matrix &B) {
+    check_size(B.nrow(), X.ncol(), "B", "float_matrix_product");
+    Matrix ans(X.nrow(), B.ncol());
+    Matrix block;
+    for (int begin = 0; begin < X.nrow(); begin += kRowBlockSize) {
+      int end = std::min(begin + kRowBlockSize, X.nrow());
+      X.copy_rows(begin, end, block);
+      EigenMap(ans).middleRows(begin, end - begin).noalias() =
+          EigenMap(block) * EigenMap(B);
+    }
+    return ans;
+  }
+
+  void add_float_inner_product(SpdMatrix &xtx, const ConstFloatSubMatrix &X) {
+    check_size(xtx.nrow(), X.ncol(), "xtx", "add_float_inner_product");
+    Matrix block;
+    for (int begin = 0; begin < X.nrow(); begin += kRowBlockSize) {
+      int end = std::min(begin + kRowBlockSize, X.nrow());
+      X.copy_rows(begin, end, block);
+      xtx.add_inner(block);
+    }
+  }
+
+}  // namespace BOOM
@@ -0,0 +1,151 @@
+#ifndef BOOM_LINALG_FLOAT_MATRIX_HPP_
+#define BOOM_LINALG_FLOAT_MATRIX_HPP_
+
+/*
+  Copyright (C) 2005-2024 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include <cstdint>
+#include <vector>
+#include "LinAlg/Matrix.hpp"
+#include "LinAlg/SpdMatrix.hpp"
+#include "LinAlg/SubMatrix.hpp"
+#include "LinAlg/Vector.hpp"
+#include "LinAlg/VectorView.hpp"
+
+// Single precision storage for large data matrices.
+//
+// The rest of LinAlg works in double precision.  Design matrices and stored
+// simulation output rarely need more than float precision, and the big-N
+// computations that read them (X'X, X'y, X * beta) are limited by memory
+// bandwidth, so storing them as float halves both the memory footprint and
+// the time spent reading them.  Only storage is single precision: the
+// kernels below convert blocks of rows to double and accumulate in double.
+namespace BOOM {
+
+  // A read-only view of a column major float matrix, analogous to
+  // ConstSubMatrix.  The view does not own its data.
+  class ConstFloatSubMatrix {
+   public:
+    // Args:
+    //   data: The matrix elements in column major order.
+    //   nrow:  The number of rows in the matrix.
+    //   ncol:  The number of columns in the matrix.
+    //   stride: The distance between the starts of adjacent columns.  A
+    //     negative value means stride = nrow.
+    ConstFloatSubMatrix(const float *data, int nrow, int ncol,
+                        int64_t stride = -1)
+        : data_(data), nrow_(nrow), ncol_(ncol),
+          stride_(stride < 0 ? nrow : stride) {}
+
+    int nrow() const { return nrow_; }
+    int ncol() const { return ncol_; }
+    int64_t stride() const { return stride_; }
+
+    double operator()(int i, int j) const { return data_[i + j * stride_]; }
+    const float *col_begin(int j) const { return data_ + j * stride_; }
+    const float *col_end(int j) const { return col_begin(j) + nrow_; }
+
+    // Rows [begin, end).
+    ConstFloatSubMatrix rows(int begin, int end) const;
+
+    // Columns [begin, end).
+    ConstFloatSubMatrix columns(int begin, int end) const;
+
+    // Copies of a row or column, in double precision.
+    Vector row(int i) const;
+    Vector col(int j) const;
+
+    // Copy rows [begin, end) into 'block', in double precision.  'block' is
+    // resized to (end - begin) x ncol().
+    void copy_rows(int begin, int end, Matrix &block) const;
+
+    // The whole matrix in double precision.
+    Matrix to_matrix() const;
+
+   private:
+    const float *data_;
+    int nrow_;
+    int ncol_;
+    int64_t stride_;
+  };
+
+  //===========================================================================
+  // A column major matrix stored in single precision.
+  class FloatMatrix {
+   public:
+    FloatMatrix() : nrow_(0), ncol_(0) {}
+    FloatMatrix(int nrow, int ncol, float value = 0.0f);
+
+    // Round the elements of a double precision matrix to float.
+    explicit FloatMatrix(const ConstSubMatrix &m);
+    explicit FloatMatrix(const Matrix &m)
+        : FloatMatrix(ConstSubMatrix(m)) {}
+
+    int nrow() const { return nrow_; }
+    int ncol() const { return ncol_; }
+
+    float *data() { return data_.data(); }
+    const float *data() const { return data_.data(); }
+
+    float &operator()(int i, int j) {
+      return data_[i + static_cast<int64_t>(j) * nrow_];
+    }
+    double operator()(int i, int j) const {
+      return data_[i + static_cast<int64_t>(j) * nrow_];
+    }
+
+    // Round 'values' to float and store them in row i or column j.
+    void set_row(int i, const ConstVectorView &values);
+    void set_col(int j, const ConstVectorView &values);
+
+    ConstFloatSubMatrix view() const {
+      return ConstFloatSubMatrix(data_.data(), nrow_, ncol_);
+    }
+    operator ConstFloatSubMatrix() const { return view(); }
+
+    Matrix to_matrix() const { return view().to_matrix(); }
+
+   private:
+    int nrow_;
+    int ncol_;
+    std::vector<float> data_;
+  };
+
+  //===========================================================================
+  // Kernels reading single precision data, with double precision
+  // accumulation.  Each works through X in blocks of rows, converting one
+  // block at a time, so the extra memory is one block regardless of the
+  // size of X.
+
+  // Returns X * v.
+  Vector float_matrix_vector_product(const ConstFloatSubMatrix &X,
+                                     const ConstVectorView &v);
+
+  // Returns X' * v.
+  Vector float_transpose_matrix_vector_product(const ConstFloatSubMatrix &X,
+                                               const ConstVectorView &v);
+
+  // Returns X * B.
+  Matrix float_matrix_product(const ConstFloatSubMatrix &X, const Matrix &B);
+
+  // xtx += X' * X.
+  void add_float_inner_product(SpdMatrix &xtx, const ConstFloatSubMatrix &X);
+
+}  // namespace BOOM
+
+#endif  // BOOM_LINALG_FLOAT_MATRIX_HPP_
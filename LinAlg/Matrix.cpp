@@ -208,17 +208,12 @@ namespace BOOM {
   }
 
   Matrix &Matrix::randomize(RNG &rng) {
-    uint n = nr_ * nc_;
-    for (uint i = 0; i < n; ++i) {
-      data_[i] = runif_mt(rng, 0, 1);
-    }
+    runif_mt(rng, VectorView(data_.data(), nr_ * nc_, 1), 0, 1);
     return *this;
   }
 
   Matrix & Matrix::randomize_gaussian(double mean, double sd, RNG &rng) {
-    for (auto &el : data_) {
-      el = rnorm_mt(rng, mean, sd);
-    }
+    rnorm_mt(rng, VectorView(data_.data(), nr_ * nc_, 1), mean, sd);
     return *this;
   }
 
@@ -620,21 +615,39 @@ namespace BOOM {
     return nrow() == ans.nrow() && B.nrow() == ans.ncol() && ncol() == B.ncol();
   }
 
+  // In the multiplication functions below, Eigen's default assignment
+  // evaluates the product into a temporary in case the output aliases one of
+  // the arguments.  When the output is distinct from both arguments the
+  // product is written into it directly.
   Matrix &Matrix::mult(const Matrix &B, Matrix &ans, double scal) const {
     assert(can_mult(B, ans));
-    EigenMap(ans) = EigenMap(*this) * EigenMap(B) * scal;
+    if (&ans == this || &ans == &B) {
+      EigenMap(ans) = EigenMap(*this) * EigenMap(B) * scal;
+    } else {
+      EigenMap(ans).noalias() = scal * EigenMap(*this) * EigenMap(B);
+    }
     return ans;
   }
 
   Matrix &Matrix::Tmult(const Matrix &B, Matrix &ans, double scal) const {
     assert(can_Tmult(B, ans));
-    EigenMap(ans) = EigenMap(*this).transpose() * EigenMap(B) * scal;
+    if (&ans == this || &ans == &B) {
+      EigenMap(ans) = EigenMap(*this).transpose() * EigenMap(B) * scal;
+    } else {
+      EigenMap(ans).noalias() =
+          scal * EigenMap(*this).transpose() * EigenMap(B);
+    }
     return ans;
   }
 
   Matrix &Matrix::multT(const Matrix &B, Matrix &ans, double scal) const {
     assert(can_multT(B, ans));
-    EigenMap(ans) = EigenMap(*this) * EigenMap(B).transpose() * scal;
+    if (&ans == this || &ans == &B) {
+      EigenMap(ans) = EigenMap(*this) * EigenMap(B).transpose() * scal;
+    } else {
+      EigenMap(ans).noalias() =
+          scal * EigenMap(*this) * EigenMap(B).transpose();
+    }
     return ans;
   }
 
@@ -703,13 +716,22 @@ namespace BOOM {
   //--------- Vector support
   Vector &Matrix::mult(const Vector &v, Vector &ans, double scal) const {
     assert(ncol() == v.size() && nrow() == ans.size());
-    EigenMap(ans) = EigenMap(*this) * EigenMap(v) * scal;
+    if (&ans == &v) {
+      EigenMap(ans) = EigenMap(*this) * EigenMap(v) * scal;
+    } else {
+      EigenMap(ans).noalias() = scal * EigenMap(*this) * EigenMap(v);
+    }
     return ans;
   }
 
   Vector &Matrix::Tmult(const Vector &v, Vector &ans, double scal) const {
     assert(nrow() == v.size() && ncol() == ans.size());
-    EigenMap(ans) = EigenMap(*this).transpose() * EigenMap(v) * scal;
+    if (&ans == &v) {
+      EigenMap(ans) = EigenMap(*this).transpose() * EigenMap(v) * scal;
+    } else {
+      EigenMap(ans).noalias() =
+          scal * EigenMap(*this).transpose() * EigenMap(v);
+    }
     return ans;
   }
 
@@ -769,7 +791,7 @@ namespace BOOM {
 
   SpdMatrix Matrix::inner() const {
     SpdMatrix ans(nc_, 0.0);
-    EigenMap(ans) = EigenMap(*this).transpose() * EigenMap(*this);
+    EigenMap(ans).noalias() = EigenMap(*this).transpose() * EigenMap(*this);
     return ans;
   }
 
@@ -1323,14 +1345,14 @@ namespace BOOM {
   Vector operator*(const VectorView &v, const Matrix &m) {
     Vector ans(m.ncol());
     assert(v.size() == m.nrow());
-    EigenMap(ans) = EigenMap(m).transpose() * EigenMap(v);
+    EigenMap(ans).noalias() = EigenMap(m).transpose() * EigenMap(v);
     return ans;
   }
 
   Vector operator*(const Matrix &m, const VectorView &v) {
     Vector ans(m.nrow());
     assert(v.size() == m.ncol());
-    EigenMap(ans) = EigenMap(m) * EigenMap(v);
+    EigenMap(ans).noalias() = EigenMap(m) * EigenMap(v);
     return ans;
   }
 
@@ -1338,14 +1360,14 @@ namespace BOOM {
   Vector operator*(const ConstVectorView &v, const Matrix &m) {
     assert(v.size() == m.nrow());
     Vector ans(m.ncol());
-    EigenMap(ans) = EigenMap(m).transpose() * EigenMap(v);
+    EigenMap(ans).noalias() = EigenMap(m).transpose() * EigenMap(v);
     return ans;
   }
 
   Vector operator*(const Matrix &m, const ConstVectorView &v) {
     assert(v.size() == m.ncol());
     Vector ans(m.nrow());
-    EigenMap(ans) = EigenMap(m) * EigenMap(v);
+    EigenMap(ans).noalias() = EigenMap(m) * EigenMap(v);
     return ans;
   }
 
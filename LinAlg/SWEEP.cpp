@@ -101,6 +101,19 @@ namespace BOOM {
            swept_.complement().select(unconditional_mean);
   }
   //------------------------------------------------------------
+  Matrix SVM::conditional_mean(const Matrix &known_subset,
+                               const Matrix &unconditional_mean) const {
+    if (known_subset.nrow() != unconditional_mean.nrow()) {
+      report_error("The known values and the means must have the same "
+                   "number of rows.");
+    }
+    Selector unswept = swept_.complement();
+    Matrix residual =
+        known_subset - swept_.select_cols(unconditional_mean);
+    return unswept.select_cols(unconditional_mean)
+        + residual.multT(Beta());
+  }
+  //------------------------------------------------------------
   SpdMatrix SVM::residual_variance() const {
     return swept_.complement().select(S_);
   }
@@ -109,4 +122,74 @@ namespace BOOM {
     return -1 * swept_.select(S_);
   }
 
+  //===========================================================================
+  SweptVarianceCache::Pattern::Pattern(const SpdMatrix &variance,
+                                       const Selector &known)
+      : swept_(variance),
+        known_(known),
+        unknown_(known.complement()) {
+    swept_.SWP(known);
+    beta_ = swept_.Beta();
+    if (unknown_.nvars() > 0) {
+      residual_drawer_.set_variance(swept_.residual_variance());
+    }
+  }
+
+  Vector SweptVarianceCache::Pattern::conditional_mean(
+      const Vector &known_subset, const Vector &unconditional_mean) const {
+    return beta_ * (known_subset - known_.select(unconditional_mean))
+        + unknown_.select(unconditional_mean);
+  }
+
+  Matrix SweptVarianceCache::Pattern::conditional_mean(
+      const Matrix &known_subset, const Matrix &unconditional_mean) const {
+    if (known_subset.nrow() != unconditional_mean.nrow()) {
+      report_error("The known values and the means must have the same "
+                   "number of rows.");
+    }
+    Matrix residual =
+        known_subset - known_.select_cols(unconditional_mean);
+    return unknown_.select_cols(unconditional_mean) + residual.multT(beta_);
+  }
+
+  SweptVarianceCache::SweptVarianceCache(const SpdMatrix &variance,
+                                         int capacity)
+      : variance_(variance),
+        version_(0),
+        capacity_(capacity > 0 ? capacity : 1) {}
+
+  void SweptVarianceCache::set_variance(const SpdMatrix &variance) {
+    variance_ = variance;
+    ++version_;
+  }
+
+  const SweptVarianceCache::Pattern &SweptVarianceCache::pattern(
+      const Selector &known) {
+    if (known.nvars_possible() != variance_.nrow()) {
+      report_error("Selector dimension does not match the variance matrix "
+                   "in SweptVarianceCache.");
+    }
+    auto it = entries_.find(known);
+    if (it != entries_.end()) {
+      Entry &entry(it->second);
+      recency_.splice(recency_.begin(), recency_, entry.recency);
+      if (entry.version != version_) {
+        entry.pattern.reset(new Pattern(variance_, known));
+        entry.version = version_;
+      }
+      return *entry.pattern;
+    }
+
+    if (entries_.size() >= capacity_) {
+      entries_.erase(recency_.back());
+      recency_.pop_back();
+    }
+    recency_.push_front(known);
+    Entry &entry(entries_[known]);
+    entry.pattern.reset(new Pattern(variance_, known));
+    entry.version = version_;
+    entry.recency = recency_.begin();
+    return *entry.pattern;
+  }
+
 }  // namespace BOOM
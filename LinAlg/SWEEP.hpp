@@ -20,6 +20,9 @@
 #ifndef BOOM_SWEEP_HPP
 #define BOOM_SWEEP_HPP
 
+#include <list>
+#include <map>
+#include <memory>
 #include <vector>
 #include "uint.hpp"
 
@@ -27,6 +30,7 @@
 #include "LinAlg/Selector.hpp"
 #include "LinAlg/SpdMatrix.hpp"
 #include "LinAlg/Vector.hpp"
+#include "distributions/MvnDrawer.hpp"
 
 namespace BOOM {
 
@@ -84,6 +88,21 @@ namespace BOOM {
     Vector conditional_mean(const Vector &known_subset,
                             const Vector &unconditional_mean) const;
 
+    // Batch version of conditional_mean, for many observations that share the
+    // same set of known variables.  The regression coefficients are formed
+    // once and applied to all the observations with a single matrix product.
+    // Args:
+    //   known_subset: Each row is a vector of known values, of dimension
+    //     xdim().
+    //   unconditional_mean: Each row is the overall mean of the corresponding
+    //     row of known_subset, of dimension xdim() + ydim().
+    // Returns:
+    //   A matrix with the same number of rows as the inputs, and ydim()
+    //   columns.  Row i is the conditional mean of the unknowns given row i
+    //   of known_subset.
+    Matrix conditional_mean(const Matrix &known_subset,
+                            const Matrix &unconditional_mean) const;
+
     // Conditional variance of the unknowns (of dimension ydim()).
     SpdMatrix residual_variance() const;
 
@@ -105,6 +124,95 @@ namespace BOOM {
     Selector swept_;
 
   };
+
+  //===========================================================================
+  // The conditional distributions implied by a variance matrix, for the
+  // missingness patterns seen most recently.  Imputing missing data one row at
+  // a time with a single SweptVarianceMatrix sweeps and unsweeps as the
+  // missingness pattern changes from row to row, and recomputes the
+  // regression coefficients and the factor of the residual variance for each
+  // row.  The cache does that work once per pattern.
+  //
+  // Entries are keyed by the pattern and the version of the variance matrix
+  // they were computed from.  Changing the variance advances the version, and
+  // stale entries are recomputed the next time they are requested.  The
+  // least recently used entry is discarded when the cache is full.
+  class SweptVarianceCache {
+   public:
+    // The conditional distribution of the unknown variables given the known
+    // variables in one missingness pattern.
+    class Pattern {
+     public:
+      Pattern(const SpdMatrix &variance, const Selector &known);
+
+      const SweptVarianceMatrix &swept() const { return swept_; }
+
+      // The matrix of regression coefficients for E(unknown | known),
+      // computed once.  See SweptVarianceMatrix::Beta.
+      const Matrix &regression_coefficients() const { return beta_; }
+
+      // The conditional mean of the unknowns given the knowns.  See
+      // SweptVarianceMatrix::conditional_mean.
+      Vector conditional_mean(const Vector &known_subset,
+                              const Vector &unconditional_mean) const;
+      Matrix conditional_mean(const Matrix &known_subset,
+                              const Matrix &unconditional_mean) const;
+
+      // Draws from the conditional distribution of the unknowns about their
+      // conditional mean.  The residual variance is factored once.
+      const MvnDrawer &residual_drawer() const { return residual_drawer_; }
+
+     private:
+      SweptVarianceMatrix swept_;
+      Selector known_;
+      Selector unknown_;
+      Matrix beta_;
+      MvnDrawer residual_drawer_;
+    };
+
+    // Args:
+    //   variance:  The variance matrix of the full set of variables.
+    //   capacity:  The maximum number of patterns to keep.
+    explicit SweptVarianceCache(const SpdMatrix &variance = SpdMatrix(0),
+                                int capacity = 64);
+
+    // Replace the variance matrix.  All cached patterns become stale.
+    void set_variance(const SpdMatrix &variance);
+    const SpdMatrix &variance() const { return variance_; }
+
+    // The number of times the variance has been set.
+    int version() const { return version_; }
+
+    // The conditional distribution for rows in which the variables in 'known'
+    // are observed.  The returned reference remains valid until the next call
+    // to pattern() or swept().
+    const Pattern &pattern(const Selector &known);
+
+    // The variance matrix swept on the variables in 'known'.
+    const SweptVarianceMatrix &swept(const Selector &known) {
+      return pattern(known).swept();
+    }
+
+    // The number of patterns held in the cache, including stale ones.
+    int number_of_patterns() const { return entries_.size(); }
+    int capacity() const { return capacity_; }
+
+   private:
+    struct Entry {
+      std::unique_ptr<Pattern> pattern;
+      int version;
+      std::list<std::vector<bool>>::iterator recency;
+    };
+
+    SpdMatrix variance_;
+    int version_;
+    int capacity_;
+    std::map<std::vector<bool>, Entry> entries_;
+
+    // Patterns in order of use, most recent first.
+    std::list<std::vector<bool>> recency_;
+  };
+
 }  // namespace BOOM
 
 #endif  // BOOM_SWEEP_HPP
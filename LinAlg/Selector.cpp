@@ -422,6 +422,26 @@ namespace BOOM {
     return ans;
   }
 
+  void Selector::select_into(const ConstVectorView &x, Vector &ans) const {
+    check_size_eq(x.size(), "select_into");
+    uint n = nvars();
+    ans.resize(n);
+    for (uint i = 0; i < n; ++i) ans[i] = x[indx(i)];
+  }
+
+  void Selector::select_into(const SpdMatrix &S, SpdMatrix &ans) const {
+    check_size_eq(S.ncol(), "select_into");
+    uint n = nvars();
+    ans.resize(n);
+    for (uint i = 0; i < n; ++i) {
+      const double *s(S.col(indx(i)).data());
+      double *a(ans.col(i).data());
+      for (uint j = 0; j < n; ++j) {
+        a[j] = s[indx(j)];
+      }
+    }
+  }
+
   Matrix Selector::select_cols(const Matrix &m) const {
     if (include_all_) return m;
     Matrix ans(m.nrow(), nvars());
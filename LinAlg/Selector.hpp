@@ -163,6 +163,13 @@ namespace BOOM {
     Vector select_if_needed(const ConstVectorView &x) const;
 
     SpdMatrix select(const SpdMatrix &) const;
+
+    // The same as select(), but the result is written into 'ans', which is
+    // resized if needed.  Reusing 'ans' from one call to the next avoids
+    // allocating.  'ans' must not be the same object as the argument.
+    void select_into(const ConstVectorView &x, Vector &ans) const;
+    void select_into(const SpdMatrix &S, SpdMatrix &ans) const;
+
     Matrix select_cols(const Matrix &M) const;
     Matrix select_square(const Matrix &M) const;  // selects rows and columns
     Matrix select_rows(const Matrix &M) const;
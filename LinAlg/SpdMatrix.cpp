@@ -460,8 +460,20 @@ namespace BOOM {
     assert(X.nrow() == w.size());
     assert(X.ncol() == this->ncol());
     uint n = w.size();
-    for (uint i = 0; i < n; ++i) {
-      this->add_outer(X.row(i), w[i], false);
+    if (n == 0 || nrow() == 0) return *this;
+    if (w.min() >= 0) {
+      // X^T W X = (W^{1/2} X)^T (W^{1/2} X), which is a single rank-k
+      // update.
+      Matrix scaled_X(X);
+      for (uint i = 0; i < n; ++i) {
+        scaled_X.row(i) *= std::sqrt(w[i]);
+      }
+      EigenMap(*this).selfadjointView<Eigen::Upper>().rankUpdate(
+          EigenMap(scaled_X).transpose(), 1.0);
+    } else {
+      for (uint i = 0; i < n; ++i) {
+        this->add_outer(X.row(i), w[i], false);
+      }
     }
     if (force_sym) reflect();
     return *this;
@@ -693,8 +705,9 @@ namespace BOOM {
       return SpdMatrix(0);
     }
     SpdMatrix ans(A.nrow());
-    EigenMap(ans) = EigenMap(A) * EigenMap(V).selfadjointView<Eigen::Upper>() *
-                    EigenMap(A).transpose();
+    EigenMap(ans).noalias() = EigenMap(A) *
+                              EigenMap(V).selfadjointView<Eigen::Upper>() *
+                              EigenMap(A).transpose();
     return ans;
   }
 
@@ -50,6 +50,12 @@ namespace BOOM {
     uint nrow() const;
     uint ncol() const;
 
+    // The address of the (0, 0) element, and the distance in memory between
+    // the starts of adjacent columns.  For handing the view to Eigen or BLAS.
+    double *data() { return start_; }
+    const double *data() const { return start_; }
+    int outer_stride() const { return stride; }
+
     double &operator()(uint i, uint j);
     const double &operator()(uint i, uint j) const;
 
@@ -138,6 +144,10 @@ namespace BOOM {
     uint nrow() const;
     uint ncol() const;
 
+    // See SubMatrix::data() and SubMatrix::outer_stride().
+    const double *data() const { return start_; }
+    int outer_stride() const { return stride; }
+
     const double &operator()(uint i, uint j) const;
     const_col_iterator col_begin(uint j) const;
     const_col_iterator col_end(uint j) const;
@@ -30,6 +30,7 @@
 #include <sstream>
 #include <numeric>
 
+#include "cpputil/lse.hpp"
 #include "cpputil/math_utils.hpp"
 #include "cpputil/report_error.hpp"
 #include "cpputil/shift_element.hpp"
@@ -160,18 +161,12 @@ namespace BOOM {
   Vector Vector::one() const { return Vector(size(), 1.0); }
 
   Vector &Vector::randomize(RNG &rng) {
-    uint n = size();
-    double *d(data());
-    for (uint i = 0; i < n; ++i) d[i] = runif_mt(rng, 0, 1);
+    runif_mt(rng, *this, 0, 1);
     return *this;
   }
 
   Vector &Vector::randomize_gaussian(double mean, double sd, RNG &rng) {
-    size_t n = size();
-    double *d(data());
-    for (size_t i = 0; i < n; ++i) {
-      d[i] = rnorm_mt(rng, mean, sd);
-    }
+    rnorm_mt(rng, *this, mean, sd);
     return *this;
   }
 
@@ -321,7 +316,11 @@ namespace BOOM {
     // v^A == (A^Tv)^T
     assert(ans.size() == A.ncol());
     assert(size() == A.nrow());
-    EigenMap(ans) = EigenMap(A).transpose() * EigenMap(*this);
+    if (&ans == this) {
+      EigenMap(ans) = EigenMap(A).transpose() * EigenMap(*this);
+    } else {
+      EigenMap(ans).noalias() = EigenMap(A).transpose() * EigenMap(*this);
+    }
     return ans;
   }
   Vector Vector::mult(const Matrix &A) const {
@@ -388,7 +387,6 @@ namespace BOOM {
   }
 
   Vector &Vector::normalize_logprob() {
-    double normalizing_constant = 0;
     Vector &x = *this;
     size_t n = size();
     if (n == 0) {
@@ -396,12 +394,7 @@ namespace BOOM {
     } else if (n == 1) {
       x[0] = 1.0;
     } else {
-      double max_value = max();
-      for (size_t i = 0; i < n; ++i) {
-        x[i] = std::exp(x[i] - max_value);
-        normalizing_constant += x[i];
-      }
-      x /= normalizing_constant;
+      normalize_logprob_inplace(VectorView(x));
     }
     return *this;
   }
@@ -134,11 +134,7 @@ namespace BOOM {
     return *this;
   }
 
-  void VV::randomize() {
-    uint n = size();
-    double *d = data();
-    for (uint i = 0; i < n; ++i) d[i] = runif(0, 1);
-  }
+  void VV::randomize() { runif_mt(GlobalRng::rng, *this, 0, 1); }
 
   VV &VV::operator+=(const double &x) {
     VV &A(*this);
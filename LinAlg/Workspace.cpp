@@ -0,0 +1,98 @@
+/*
+  Copyright (C) 2005-2024 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include "LinAlg/Workspace.hpp"
+#include "cpputil/report_error.hpp"
+
+namespace BOOM {
+
+  namespace {
+    // Hand out the next object in 'pool', creating it if needed.  Returns
+    // true if the request required a heap allocation.
+    template <class T>
+    T &next_object(std::vector<std::unique_ptr<T>> &pool, size_t &in_use,
+                   bool &allocated) {
+      if (in_use == pool.size()) {
+        pool.emplace_back(new T);
+        allocated = true;
+      }
+      return *pool[in_use++];
+    }
+  }  // namespace
+
+  WorkspaceArena::WorkspaceArena()
+      : in_use_{0, 0, 0},
+        heap_allocations_(0),
+        requests_(0)
+  {}
+
+  Vector &WorkspaceArena::vector(int size) {
+    ++requests_;
+    bool allocated = false;
+    Vector &ans(next_object(vectors_, in_use_.vectors, allocated));
+    if (ans.capacity() < size) allocated = true;
+    ans.resize(size);
+    heap_allocations_ += allocated;
+    return ans;
+  }
+
+  Matrix &WorkspaceArena::matrix(int nrow, int ncol) {
+    ++requests_;
+    bool allocated = false;
+    Matrix &ans(next_object(matrices_, in_use_.matrices, allocated));
+    if (ans.size() < nrow * ncol) allocated = true;
+    ans.resize(nrow, ncol);
+    heap_allocations_ += allocated;
+    return ans;
+  }
+
+  SpdMatrix &WorkspaceArena::spd(int dim) {
+    ++requests_;
+    bool allocated = false;
+    SpdMatrix &ans(next_object(spd_matrices_, in_use_.spd_matrices, allocated));
+    if (ans.size() < dim * dim) allocated = true;
+    ans.resize(dim);
+    heap_allocations_ += allocated;
+    return ans;
+  }
+
+  WorkspaceArena::Mark WorkspaceArena::mark() const { return in_use_; }
+
+  void WorkspaceArena::release(const Mark &mark) {
+    if (mark.vectors > in_use_.vectors ||
+        mark.matrices > in_use_.matrices ||
+        mark.spd_matrices > in_use_.spd_matrices) {
+      report_error("WorkspaceArena::release called with a mark that is "
+                   "newer than the current state.");
+    }
+    in_use_ = mark;
+  }
+
+  void WorkspaceArena::reset() { in_use_ = Mark{0, 0, 0}; }
+
+  void WorkspaceArena::clear_statistics() {
+    heap_allocations_ = 0;
+    requests_ = 0;
+  }
+
+  WorkspaceArena &thread_workspace() {
+    thread_local WorkspaceArena workspace;
+    return workspace;
+  }
+
+}  // namespace BOOM
@@ -0,0 +1,150 @@
+#ifndef BOOM_LINALG_WORKSPACE_HPP_
+#define BOOM_LINALG_WORKSPACE_HPP_
+
+/*
+  Copyright (C) 2005-2024 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "LinAlg/Matrix.hpp"
+#include "LinAlg/SpdMatrix.hpp"
+#include "LinAlg/Vector.hpp"
+
+namespace BOOM {
+
+  // A pool of scratch Vector and Matrix objects that can be reused from one
+  // MCMC iteration to the next.
+  //
+  // Code in an inner loop (e.g. a Kalman filter recursion) asks the arena for
+  // a temporary with vector(), matrix(), or spd().  The returned object keeps
+  // its storage after it is released, so once the pool has "warmed up" a
+  // request for an object no larger than one handed out previously does not
+  // touch the heap.  Objects are released in LIFO order, either all at once
+  // with reset(), or back to a previously recorded mark().  WorkspaceScope
+  // (below) does the latter automatically, which makes nested use safe.
+  //
+  // References returned by the arena remain valid until the object is
+  // released.  The contents of a newly requested object are unspecified.
+  //
+  // An arena is not thread safe.  Each thread should use its own, which is
+  // what thread_workspace() provides.
+  class WorkspaceArena {
+   public:
+    // The number of objects of each type in use at a point in time.
+    struct Mark {
+      size_t vectors;
+      size_t matrices;
+      size_t spd_matrices;
+    };
+
+    WorkspaceArena();
+    WorkspaceArena(const WorkspaceArena &rhs) = delete;
+    WorkspaceArena &operator=(const WorkspaceArena &rhs) = delete;
+
+    // Return a scratch object of the requested dimension.
+    Vector &vector(int size);
+    Matrix &matrix(int nrow, int ncol);
+    SpdMatrix &spd(int dim);
+
+    // The objects currently in use.
+    Mark mark() const;
+
+    // Release all objects acquired since 'mark' was recorded.  It is an error
+    // to release to a mark with more objects in use than the current state.
+    void release(const Mark &mark);
+
+    // Release all objects.  Storage is retained for future requests.
+    void reset();
+
+    // The number of requests that needed to allocate memory, either because
+    // a new object was created or because an existing object needed more
+    // capacity.
+    std::int64_t heap_allocations() const { return heap_allocations_; }
+
+    // The total number of requests for scratch objects.
+    std::int64_t requests() const { return requests_; }
+
+    void clear_statistics();
+
+   private:
+    std::vector<std::unique_ptr<Vector>> vectors_;
+    std::vector<std::unique_ptr<Matrix>> matrices_;
+    std::vector<std::unique_ptr<SpdMatrix>> spd_matrices_;
+    Mark in_use_;
+    std::int64_t heap_allocations_;
+    std::int64_t requests_;
+  };
+
+  // The workspace for the calling thread.
+  WorkspaceArena &thread_workspace();
+
+  //===========================================================================
+  // Records the state of a WorkspaceArena on construction, and releases any
+  // objects acquired during its lifetime on destruction.
+  //
+  // Usage:
+  //   WorkspaceScope scope;
+  //   Vector &tmp(scope.workspace().vector(n));
+  class WorkspaceScope {
+   public:
+    explicit WorkspaceScope(WorkspaceArena &workspace = thread_workspace())
+        : workspace_(workspace), mark_(workspace.mark()) {}
+    ~WorkspaceScope() { workspace_.release(mark_); }
+    WorkspaceScope(const WorkspaceScope &rhs) = delete;
+    WorkspaceScope &operator=(const WorkspaceScope &rhs) = delete;
+
+    WorkspaceArena &workspace() { return workspace_; }
+
+   private:
+    WorkspaceArena &workspace_;
+    WorkspaceArena::Mark mark_;
+  };
+
+  //===========================================================================
+  // A WorkspaceArena that can be a data member of a copyable class.
+  //
+  // An object that needs the same temporaries on every call (e.g. a posterior
+  // sampler, whose draw() is called once per MCMC iteration) can hold one of
+  // these instead of using thread_workspace().  Its scratch objects then keep
+  // their sizes from one call to the next, even if other code on the same
+  // thread requests objects of different sizes in between.
+  //
+  // The arena is created on first use.  A copy starts with an empty arena of
+  // its own, because scratch space is never shared between objects.
+  class PersistentWorkspace {
+   public:
+    PersistentWorkspace() {}
+    PersistentWorkspace(const PersistentWorkspace &rhs) {}
+    PersistentWorkspace &operator=(const PersistentWorkspace &rhs) {
+      return *this;
+    }
+
+    WorkspaceArena &arena() const {
+      if (!arena_) arena_.reset(new WorkspaceArena);
+      return *arena_;
+    }
+
+   private:
+    mutable std::unique_ptr<WorkspaceArena> arena_;
+  };
+
+}  // namespace BOOM
+
+#endif  // BOOM_LINALG_WORKSPACE_HPP_
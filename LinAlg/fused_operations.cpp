@@ -0,0 +1,207 @@
+/*
+  Copyright (C) 2005-2024 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include "LinAlg/fused_operations.hpp"
+#include <sstream>
+#include "LinAlg/EigenMap.hpp"
+#include "cpputil/report_error.hpp"
+
+namespace BOOM {
+
+  namespace {
+    void check_size(int actual, int expected, const char *what,
+                    const char *caller) {
+      if (actual != expected) {
+        std::ostringstream err;
+        err << "Size mismatch in " << caller << ": " << what << " has size "
+            << actual << " but " << expected << " was expected.";
+        report_error(err.str());
+      }
+    }
+  }  // namespace
+
+  void matrix_vector_product(VectorView ans, const Matrix &A,
+                             const ConstVectorView &x, double alpha,
+                             double beta) {
+    check_size(x.size(), A.ncol(), "x", "matrix_vector_product");
+    check_size(ans.size(), A.nrow(), "ans", "matrix_vector_product");
+    auto out = EigenMap(ans);
+    if (beta == 0.0) {
+      out.noalias() = alpha * EigenMap(A) * EigenMap(x);
+    } else {
+      if (beta != 1.0) out *= beta;
+      out.noalias() += alpha * EigenMap(A) * EigenMap(x);
+    }
+  }
+
+  void matrix_vector_product(Vector &ans, const Matrix &A,
+                             const ConstVectorView &x, double alpha,
+                             double beta) {
+    if (beta == 0.0) ans.resize(A.nrow());
+    matrix_vector_product(VectorView(ans), A, x, alpha, beta);
+  }
+
+  void transpose_matrix_vector_product(VectorView ans, const Matrix &A,
+                                       const ConstVectorView &x,
+                                       double alpha, double beta) {
+    check_size(x.size(), A.nrow(), "x", "transpose_matrix_vector_product");
+    check_size(ans.size(), A.ncol(), "ans", "transpose_matrix_vector_product");
+    auto out = EigenMap(ans);
+    if (beta == 0.0) {
+      out.noalias() = alpha * EigenMap(A).transpose() * EigenMap(x);
+    } else {
+      if (beta != 1.0) out *= beta;
+      out.noalias() += alpha * EigenMap(A).transpose() * EigenMap(x);
+    }
+  }
+
+  void transpose_matrix_vector_product(Vector &ans, const Matrix &A,
+                                       const ConstVectorView &x,
+                                       double alpha, double beta) {
+    if (beta == 0.0) ans.resize(A.ncol());
+    transpose_matrix_vector_product(VectorView(ans), A, x, alpha, beta);
+  }
+
+  void residual(VectorView ans, const ConstVectorView &y, const Matrix &X,
+                const ConstVectorView &beta) {
+    check_size(y.size(), X.nrow(), "y", "residual");
+    check_size(ans.size(), X.nrow(), "ans", "residual");
+    check_size(beta.size(), X.ncol(), "beta", "residual");
+    if (ans.data() != y.data()) {
+      ans = y;
+    }
+    EigenMap(ans).noalias() -= EigenMap(X) * EigenMap(beta);
+  }
+
+  void residual(Vector &ans, const ConstVectorView &y, const Matrix &X,
+                const ConstVectorView &beta) {
+    if (ans.data() != y.data()) ans.resize(y.size());
+    residual(VectorView(ans), y, X, beta);
+  }
+
+  void linear_combination(VectorView ans, double a, const ConstVectorView &x,
+                          double b, const ConstVectorView &y) {
+    check_size(x.size(), ans.size(), "x", "linear_combination");
+    check_size(y.size(), ans.size(), "y", "linear_combination");
+    // Element-wise, so the output can safely alias either input.
+    EigenMap(ans) = a * EigenMap(x) + b * EigenMap(y);
+  }
+
+  void linear_combination(Vector &ans, double a, const ConstVectorView &x,
+                          double b, const ConstVectorView &y) {
+    if (ans.data() != x.data() && ans.data() != y.data()) {
+      ans.resize(x.size());
+    }
+    linear_combination(VectorView(ans), a, x, b, y);
+  }
+
+  void matrix_product(Matrix &ans, const Matrix &A, const Matrix &B,
+                      double alpha, double beta) {
+    check_size(A.ncol(), B.nrow(), "B", "matrix_product");
+    if (beta == 0.0) {
+      ans.resize(A.nrow(), B.ncol());
+      EigenMap(ans).noalias() = alpha * EigenMap(A) * EigenMap(B);
+    } else {
+      check_size(ans.nrow(), A.nrow(), "ans", "matrix_product");
+      check_size(ans.ncol(), B.ncol(), "ans", "matrix_product");
+      if (beta != 1.0) ans *= beta;
+      EigenMap(ans).noalias() += alpha * EigenMap(A) * EigenMap(B);
+    }
+  }
+
+  void matrix_vector_product(VectorView ans, const ConstSubMatrix &A,
+                             const ConstVectorView &x, double alpha,
+                             double beta) {
+    check_size(x.size(), A.ncol(), "x", "matrix_vector_product");
+    check_size(ans.size(), A.nrow(), "ans", "matrix_vector_product");
+    auto out = EigenMap(ans);
+    if (beta == 0.0) {
+      out.noalias() = alpha * EigenMap(A) * EigenMap(x);
+    } else {
+      if (beta != 1.0) out *= beta;
+      out.noalias() += alpha * EigenMap(A) * EigenMap(x);
+    }
+  }
+
+  void transpose_matrix_vector_product(VectorView ans, const ConstSubMatrix &A,
+                                       const ConstVectorView &x,
+                                       double alpha, double beta) {
+    check_size(x.size(), A.nrow(), "x", "transpose_matrix_vector_product");
+    check_size(ans.size(), A.ncol(), "ans", "transpose_matrix_vector_product");
+    auto out = EigenMap(ans);
+    if (beta == 0.0) {
+      out.noalias() = alpha * EigenMap(A).transpose() * EigenMap(x);
+    } else {
+      if (beta != 1.0) out *= beta;
+      out.noalias() += alpha * EigenMap(A).transpose() * EigenMap(x);
+    }
+  }
+
+  void matrix_product(SubMatrix ans, const ConstSubMatrix &A,
+                      const ConstSubMatrix &B, double alpha, double beta) {
+    check_size(B.nrow(), A.ncol(), "B", "matrix_product");
+    check_size(ans.nrow(), A.nrow(), "ans", "matrix_product");
+    check_size(ans.ncol(), B.ncol(), "ans", "matrix_product");
+    auto out = EigenMap(ans);
+    if (beta == 0.0) {
+      out.noalias() = alpha * EigenMap(A) * EigenMap(B);
+    } else {
+      if (beta != 1.0) out *= beta;
+      out.noalias() += alpha * EigenMap(A) * EigenMap(B);
+    }
+  }
+
+  void transpose_matrix_product(SubMatrix ans, const ConstSubMatrix &A,
+                                const ConstSubMatrix &B, double alpha,
+                                double beta) {
+    check_size(B.nrow(), A.nrow(), "B", "transpose_matrix_product");
+    check_size(ans.nrow(), A.ncol(), "ans", "transpose_matrix_product");
+    check_size(ans.ncol(), B.ncol(), "ans", "transpose_matrix_product");
+    auto out = EigenMap(ans);
+    if (beta == 0.0) {
+      out.noalias() = alpha * EigenMap(A).transpose() * EigenMap(B);
+    } else {
+      if (beta != 1.0) out *= beta;
+      out.noalias() += alpha * EigenMap(A).transpose() * EigenMap(B);
+    }
+  }
+
+  void matrix_product_transpose(SubMatrix ans, const ConstSubMatrix &A,
+                                const ConstSubMatrix &B, double alpha,
+                                double beta) {
+    check_size(B.ncol(), A.ncol(), "B", "matrix_product_transpose");
+    check_size(ans.nrow(), A.nrow(), "ans", "matrix_product_transpose");
+    check_size(ans.ncol(), B.nrow(), "ans", "matrix_product_transpose");
+    auto out = EigenMap(ans);
+    if (beta == 0.0) {
+      out.noalias() = alpha * EigenMap(A) * EigenMap(B).transpose();
+    } else {
+      if (beta != 1.0) out *= beta;
+      out.noalias() += alpha * EigenMap(A) * EigenMap(B).transpose();
+    }
+  }
+
+  void add_inner_product(SpdMatrix &ans, const ConstSubMatrix &X, double w,
+                         bool reflect) {
+    check_size(ans.nrow(), X.ncol(), "ans", "add_inner_product");
+    EigenMap(ans).selfadjointView<Eigen::Upper>().rankUpdate(
+        EigenMap(X).transpose(), w);
+    if (reflect) ans.reflect();
+  }
+
+}  // namespace BOOM
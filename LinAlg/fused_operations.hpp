@@ -0,0 +1,121 @@
+#ifndef BOOM_LINALG_FUSED_OPERATIONS_HPP_
+#define BOOM_LINALG_FUSED_OPERATIONS_HPP_
+
+/*
+  Copyright (C) 2005-2024 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include "LinAlg/Matrix.hpp"
+#include "LinAlg/SpdMatrix.hpp"
+#include "LinAlg/SubMatrix.hpp"
+#include "LinAlg/Vector.hpp"
+#include "LinAlg/VectorView.hpp"
+
+// Allocation free versions of common linear algebra expressions.
+//
+// Arithmetic operators on Vector and Matrix return new objects, so an
+// expression like y - X * beta allocates a temporary for X * beta and
+// another for the difference.  That is fine for most code, but inside an
+// MCMC inner loop the allocations can dominate the run time.  The functions
+// below evaluate such expressions in a single pass (through Eigen, via
+// EigenMap), writing directly into caller-owned storage.  The output may be
+// a Vector or any VectorView, including a row or column of a Matrix.
+//
+// Unless otherwise noted the output must not overlap any of the inputs.
+// The overloads taking a Vector output resize it as needed, and otherwise
+// behave like the VectorView versions.
+
+namespace BOOM {
+
+  // ans = alpha * A * x + beta * ans.  If beta == 0 the initial contents of
+  // ans are ignored (they may be uninitialized or NaN).
+  void matrix_vector_product(VectorView ans, const Matrix &A,
+                             const ConstVectorView &x, double alpha = 1.0,
+                             double beta = 0.0);
+  void matrix_vector_product(Vector &ans, const Matrix &A,
+                             const ConstVectorView &x, double alpha = 1.0,
+                             double beta = 0.0);
+
+  // ans = alpha * A^T * x + beta * ans.
+  void transpose_matrix_vector_product(VectorView ans, const Matrix &A,
+                                       const ConstVectorView &x,
+                                       double alpha = 1.0, double beta = 0.0);
+  void transpose_matrix_vector_product(Vector &ans, const Matrix &A,
+                                       const ConstVectorView &x,
+                                       double alpha = 1.0, double beta = 0.0);
+
+  // ans = y - X * beta.  The residuals of a regression, computed without
+  // temporaries.  ans may be the same vector as y.
+  void residual(VectorView ans, const ConstVectorView &y, const Matrix &X,
+                const ConstVectorView &beta);
+  void residual(Vector &ans, const ConstVectorView &y, const Matrix &X,
+                const ConstVectorView &beta);
+
+  // ans = a * x + b * y.  ans may be the same vector as x or y.
+  void linear_combination(VectorView ans, double a, const ConstVectorView &x,
+                          double b, const ConstVectorView &y);
+  void linear_combination(Vector &ans, double a, const ConstVectorView &x,
+                          double b, const ConstVectorView &y);
+
+  // ans = alpha * A * B + beta * ans.
+  void matrix_product(Matrix &ans, const Matrix &A, const Matrix &B,
+                      double alpha = 1.0, double beta = 0.0);
+
+  //---------------------------------------------------------------------------
+  // Versions taking views.  The output is a SubMatrix or VectorView into
+  // caller-owned storage (e.g. a block of a larger matrix), so it is never
+  // resized and must already have the right dimensions.  The inputs may be
+  // blocks of other matrices, such as a range of rows of a data matrix, and
+  // are read in place without being copied.  ConstSubMatrix(const Matrix &)
+  // is explicit, so a whole Matrix argument needs to be wrapped.
+
+  // ans = alpha * A * x + beta * ans.
+  void matrix_vector_product(VectorView ans, const ConstSubMatrix &A,
+                             const ConstVectorView &x, double alpha = 1.0,
+                             double beta = 0.0);
+
+  // ans = alpha * A^T * x + beta * ans.
+  void transpose_matrix_vector_product(VectorView ans, const ConstSubMatrix &A,
+                                       const ConstVectorView &x,
+                                       double alpha = 1.0, double beta = 0.0);
+
+  // ans = alpha * A * B + beta * ans.
+  void matrix_product(SubMatrix ans, const ConstSubMatrix &A,
+                      const ConstSubMatrix &B, double alpha = 1.0,
+                      double beta = 0.0);
+
+  // ans = alpha * A^T * B + beta * ans.
+  void transpose_matrix_product(SubMatrix ans, const ConstSubMatrix &A,
+                                const ConstSubMatrix &B, double alpha = 1.0,
+                                double beta = 0.0);
+
+  // ans = alpha * A * B^T + beta * ans.
+  void matrix_product_transpose(SubMatrix ans, const ConstSubMatrix &A,
+                                const ConstSubMatrix &B, double alpha = 1.0,
+                                double beta = 0.0);
+
+  // ans += w * X^T * X, as a symmetric rank-k update that computes only the
+  // upper triangle.  If 'reflect' is false the lower triangle of ans is left
+  // stale, and the caller is responsible for calling ans.reflect() before
+  // using it.  This lets a sequence of updates (e.g. over blocks of rows)
+  // pay for a single reflection.
+  void add_inner_product(SpdMatrix &ans, const ConstSubMatrix &X,
+                         double w = 1.0, bool reflect = true);
+
+}  // namespace BOOM
+
+#endif  // BOOM_LINALG_FUSED_OPERATIONS_HPP_
@@ -1,6 +1,7 @@
 #include "gtest/gtest.h"
 #include "distributions.hpp"
 #include "LinAlg/Cholesky.hpp"
+#include "LinAlg/Selector.hpp"
 #include "LinAlg/SpdMatrix.hpp"
 #include "test_utils/test_utils.hpp"
 #include <fstream>
@@ -132,4 +133,104 @@ namespace {
   }
 
 
+  TEST_F(CholeskyTest, RankOneUpdateAndDowndate) {
+    SpdMatrix spd(5);
+    spd.randomize();
+    Vector v(5);
+    v.randomize();
+
+    Cholesky cholesky(spd);
+    cholesky.rank_one_update(v);
+    SpdMatrix updated = spd;
+    updated.add_outer(v);
+    EXPECT_TRUE(MatrixEquals(updated, cholesky.original_matrix()));
+    EXPECT_TRUE(MatrixEquals(Cholesky(updated).getL(), cholesky.getL()));
+
+    EXPECT_TRUE(cholesky.rank_one_downdate(v));
+    EXPECT_TRUE(MatrixEquals(spd, cholesky.original_matrix()));
+
+    // A downdate that destroys positive definiteness fails and leaves the
+    // decomposition alone.
+    Matrix L = cholesky.getL();
+    Vector big = v * 1000.0;
+    EXPECT_FALSE(cholesky.rank_one_downdate(big));
+    EXPECT_TRUE(MatrixEquals(L, cholesky.getL()));
+  }
+
+  TEST_F(CholeskyTest, AddAndDropRowCol) {
+    SpdMatrix big(6);
+    big.randomize();
+    Selector all(6, true);
+    for (int position = 0; position < 6; ++position) {
+      Selector included = all;
+      included.drop(position);
+      Cholesky cholesky(included.select(big));
+
+      // Add variable 'position' back in.
+      EXPECT_TRUE(cholesky.add_row_col(position, big.col(position)));
+      EXPECT_EQ(6, cholesky.dim());
+      EXPECT_TRUE(MatrixEquals(big, cholesky.original_matrix()))
+          << "position = " << position << endl
+          << big << endl
+          << cholesky.original_matrix();
+      EXPECT_TRUE(MatrixEquals(Cholesky(big).getL(), cholesky.getL()));
+
+      // And take it back out.
+      cholesky.drop_row_col(position);
+      EXPECT_EQ(5, cholesky.dim());
+      EXPECT_TRUE(MatrixEquals(included.select(big),
+                               cholesky.original_matrix()));
+    }
+
+    // Grow a factor from nothing.
+    Cholesky grown(SpdMatrix(0));
+    for (int i = 0; i < 6; ++i) {
+      Selector first(6, false);
+      for (int j = 0; j <= i; ++j) first.add(j);
+      EXPECT_TRUE(grown.add_row_col(i, first.select(big.col(i))));
+    }
+    EXPECT_TRUE(MatrixEquals(big, grown.original_matrix()));
+
+    // A column that would make the matrix indefinite is rejected.  The new
+    // variable duplicates variable 2, but has a smaller variance.
+    Cholesky cholesky(big);
+    Vector column(7);
+    VectorView(column, 0, 6) = big.col(2);
+    column[6] = .5 * big(2, 2);
+    EXPECT_FALSE(cholesky.add_row_col(6, column));
+    EXPECT_EQ(6, cholesky.dim());
+  }
+
+  TEST_F(CholeskyTest, InPlaceOperations) {
+    Cholesky cholesky(spd_);
+    Vector b(4);
+    b.randomize();
+
+    Vector x = b;
+    cholesky.solve_inplace(VectorView(x));
+    EXPECT_TRUE(VectorEquals(x, spd_.solve(b)));
+
+    Vector u = b;
+    cholesky.upper_solve_inplace(VectorView(u));
+    EXPECT_TRUE(VectorEquals(u, Usolve(cholesky.getLT(), b)));
+
+    // Decomposing another matrix of the same size reuses the storage, and
+    // the upper triangle of the factor is zero.
+    SpdMatrix other(4);
+    other.randomize();
+    cholesky.decompose(other);
+    EXPECT_TRUE(cholesky.is_pos_def());
+    EXPECT_TRUE(MatrixEquals(other, cholesky.original_matrix()));
+    Matrix L = cholesky.getL();
+    for (int i = 0; i < 4; ++i) {
+      for (int j = i + 1; j < 4; ++j) {
+        EXPECT_DOUBLE_EQ(0.0, L(i, j));
+      }
+    }
+
+    Vector wrong_size(3);
+    EXPECT_THROW(cholesky.solve_inplace(VectorView(wrong_size)),
+                 std::exception);
+  }
+
 }  // namespace
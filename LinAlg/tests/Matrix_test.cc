@@ -6,6 +6,7 @@
 #include "LinAlg/SubMatrix.hpp"
 #include "LinAlg/DiagonalMatrix.hpp"
 #include "distributions.hpp"
+#include "cpputil/lse.hpp"
 #include "cpputil/math_utils.hpp"
 
 #include "test_utils/test_utils.hpp"
@@ -547,4 +548,35 @@ namespace {
 
   }
 
+  // The row-wise log probability kernels should agree with the Vector
+  // versions applied to each row.
+  TEST_F(MatrixTest, RowwiseLogProbabilities) {
+    Matrix log_prob(25, 4);
+    log_prob.randomize();
+    log_prob *= 30;
+    log_prob(3, 1) = negative_infinity();
+    log_prob(5, 0) = log_prob(5, 1) = log_prob(5, 2) = log_prob(5, 3) =
+        negative_infinity();
+
+    Vector row_lse = lse_rows(log_prob);
+    Vector approximate_row_lse = lse_rows(log_prob, true);
+    EXPECT_EQ(negative_infinity(), row_lse[5]);
+    for (int i = 0; i < log_prob.nrow(); ++i) {
+      if (i == 5) continue;
+      EXPECT_NEAR(lse(log_prob.row(i)), row_lse[i], 1e-12);
+      EXPECT_NEAR(row_lse[i], approximate_row_lse[i], 1e-5);
+    }
+
+    Matrix probs = log_prob;
+    Vector normalizing_constants = normalize_logprob_rows(probs);
+    for (int i = 0; i < log_prob.nrow(); ++i) {
+      if (i == 5) continue;
+      Vector expected = log_prob.row(i);
+      expected.normalize_logprob();
+      EXPECT_TRUE(VectorEquals(expected, probs.row(i), 1e-14));
+      EXPECT_NEAR(row_lse[i], normalizing_constants[i], 1e-12);
+    }
+    EXPECT_DOUBLE_EQ(0.0, probs(3, 1));
+  }
+
 }  // namespace
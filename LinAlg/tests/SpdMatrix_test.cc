@@ -240,6 +240,14 @@ namespace {
         Sigma.add_inner(X, weights),
         original_sigma + X.transpose() * W * X));
 
+    // Negative weights can't use the square root trick.
+    weights[0] = -2.0;
+    W.diag() = weights;
+    Sigma = original_sigma;
+    EXPECT_TRUE(MatrixEquals(
+        Sigma.add_inner(X, weights),
+        original_sigma + X.transpose() * W * X));
+
     Matrix Y(3, 4);
     Y.randomize();
     Sigma = original_sigma;
@@ -3,6 +3,7 @@
 #include "LinAlg/VectorView.hpp"
 #include "LinAlg/Matrix.hpp"
 #include "distributions.hpp"
+#include "cpputil/lse.hpp"
 #include "cpputil/math_utils.hpp"
 #include "test_utils/test_utils.hpp"
 #include <fstream>
@@ -397,4 +398,53 @@ namespace {
 
   }
   
+  // The vectorized lse and normalize_logprob should match the scalar
+  // formulas, in both exact and approximate modes.
+  TEST_F(VectorTest, LogProbabilities) {
+    Vector x(37);
+    x.randomize();
+    x *= 50;
+    x[3] = negative_infinity();
+    x[7] = -800;
+
+    double max_value = x.max();
+    double total = 0;
+    Vector expected(x.size());
+    for (int i = 0; i < x.size(); ++i) {
+      expected[i] = std::exp(x[i] - max_value);
+      total += expected[i];
+    }
+    double expected_lse = max_value + std::log(total);
+    expected /= total;
+
+    EXPECT_NEAR(expected_lse, lse(x), 1e-12);
+    EXPECT_NEAR(expected_lse, lse_approximate(x), 1e-5);
+
+    Vector probs = x;
+    probs.normalize_logprob();
+    EXPECT_TRUE(VectorEquals(expected, probs, 1e-14));
+    EXPECT_DOUBLE_EQ(0.0, probs[3]);
+    EXPECT_DOUBLE_EQ(0.0, probs[7]);
+
+    probs = x;
+    EXPECT_NEAR(expected_lse,
+                normalize_logprob_inplace(VectorView(probs), true), 1e-5);
+    for (int i = 0; i < x.size(); ++i) {
+      EXPECT_NEAR(expected[i], probs[i], 1e-5 * expected[i] + 1e-300);
+    }
+    EXPECT_NEAR(1.0, probs.sum(), 1e-12);
+
+    // Views with a stride other than 1.
+    Matrix m(4, 3);
+    m.randomize();
+    Vector original_row = m.row(2);
+    Vector row = original_row;
+    row.normalize_logprob();
+    double row_lse = normalize_logprob_inplace(m.row(2));
+    EXPECT_TRUE(VectorEquals(row, m.row(2)));
+    EXPECT_NEAR(lse(original_row), row_lse, 1e-12);
+
+    EXPECT_EQ(negative_infinity(), lse(Vector(3, negative_infinity())));
+  }
+
 }  // namespace
@@ -119,4 +119,60 @@ namespace {
     }
   }
 
+  TEST_F(ArrayTest, FixedRankViews) {
+    Array array(std::vector<int>{3, 4, 5});
+    array.randomize();
+
+    ConstFixedRankArrayView<3> view(array);
+    EXPECT_EQ(view.dim(0), 3);
+    EXPECT_EQ(view.dim(1), 4);
+    EXPECT_EQ(view.dim(2), 5);
+    for (int i = 0; i < 3; ++i) {
+      for (int j = 0; j < 4; ++j) {
+        for (int k = 0; k < 5; ++k) {
+          EXPECT_DOUBLE_EQ(view(i, j, k), array(i, j, k));
+        }
+      }
+    }
+
+    // Writes through a view of a strided slice land in the host.
+    ArrayView slice = array.slice(-1, 2, -1);
+    FixedRankArrayView<2> matrix_view(slice);
+    matrix_view(1, 3) = -7.0;
+    EXPECT_DOUBLE_EQ(array(1, 2, 3), -7.0);
+
+    EXPECT_THROW(ConstFixedRankArrayView<2> wrong_rank(array),
+                 std::exception);
+  }
+
+  TEST_F(ArrayTest, StridedIteration) {
+    Array array(std::vector<int>{3, 4, 5});
+    array.randomize();
+
+    // Iterate over a non-contiguous slice and check that each element
+    // matches the one obtained by explicit indexing.
+    ConstArrayView slice = array.slice(1, -1, -1);
+    int count = 0;
+    for (ConstArrayIterator it = slice.begin(); it != slice.end(); ++it) {
+      const std::vector<int> &position(it.position());
+      EXPECT_DOUBLE_EQ(*it, array(1, position[0], position[1]));
+      ++count;
+    }
+    EXPECT_EQ(count, 4 * 5);
+
+    auto it = array.abegin();
+    it.set_position(std::vector<int>{2, 3, 1});
+    EXPECT_DOUBLE_EQ(*it, array(2, 3, 1));
+    ++it;
+    EXPECT_DOUBLE_EQ(*it, array(0, 0, 2));
+
+    ConstVectorView fiber = array.vector_slice(2, -1, 4);
+    EXPECT_EQ(fiber.size(), 4);
+    for (int j = 0; j < 4; ++j) {
+      EXPECT_DOUBLE_EQ(fiber[j], array(2, j, 4));
+    }
+    EXPECT_THROW(array.vector_slice(2, 1, 4), std::exception);
+    EXPECT_THROW(array(3, 0, 0), std::exception);
+  }
+
 }  // namespace
@@ -0,0 +1,87 @@
+#include "gtest/gtest.h"
+#include "LinAlg/FloatMatrix.hpp"
+#include "LinAlg/Matrix.hpp"
+#include "LinAlg/SpdMatrix.hpp"
+#include "distributions.hpp"
+#include "test_utils/test_utils.hpp"
+
+namespace {
+  using namespace BOOM;
+  using std::endl;
+  using std::cout;
+
+  class FloatMatrixTest : public ::testing::Test {
+   protected:
+    FloatMatrixTest() {
+      GlobalRng::rng.seed(8675309);
+    }
+  };
+
+  TEST_F(FloatMatrixTest, Storage) {
+    Matrix X(5, 3);
+    X.randomize();
+    FloatMatrix fX(X);
+    EXPECT_EQ(5, fX.nrow());
+    EXPECT_EQ(3, fX.ncol());
+    for (int i = 0; i < 5; ++i) {
+      for (int j = 0; j < 3; ++j) {
+        EXPECT_EQ(static_cast<float>(X(i, j)), fX(i, j));
+      }
+    }
+    EXPECT_TRUE(MatrixEquals(X, fX.to_matrix(), 1e-6));
+
+    ConstFloatSubMatrix view = fX.view();
+    EXPECT_TRUE(VectorEquals(view.row(3), fX.to_matrix().row(3), 1e-12));
+    EXPECT_TRUE(VectorEquals(view.col(1), fX.to_matrix().col(1), 1e-12));
+    ConstFloatSubMatrix block = view.rows(1, 4).columns(1, 3);
+    EXPECT_EQ(3, block.nrow());
+    EXPECT_EQ(2, block.ncol());
+    EXPECT_DOUBLE_EQ(fX(2, 2), block(1, 1));
+
+    fX.set_row(0, Vector{1.0, 2.0, 3.0});
+    fX.set_col(2, Vector{4, 5, 6, 7, 8});
+    EXPECT_EQ(2.0f, fX(0, 1));
+    EXPECT_EQ(4.0f, fX(0, 2));
+    EXPECT_EQ(8.0f, fX(4, 2));
+  }
+
+  // The kernels agree with double precision arithmetic on the rounded
+  // matrix, including matrices with more rows than one conversion block.
+  TEST_F(FloatMatrixTest, Kernels) {
+    int n = 1000;
+    int p = 6;
+    Matrix X(n, p);
+    X.randomize();
+    FloatMatrix fX(X);
+    Matrix rounded = fX.to_matrix();
+
+    Vector beta(p);
+    beta.randomize();
+    EXPECT_TRUE(VectorEquals(float_matrix_vector_product(fX, beta),
+                             rounded * beta, 1e-10));
+
+    Vector y(n);
+    y.randomize();
+    EXPECT_TRUE(VectorEquals(float_transpose_matrix_vector_product(fX, y),
+                             rounded.Tmult(y), 1e-8));
+
+    Matrix B(p, 3);
+    B.randomize();
+    EXPECT_TRUE(MatrixEquals(float_matrix_product(fX, B), rounded * B,
+                             1e-10));
+
+    SpdMatrix xtx(p, 0.0);
+    add_float_inner_product(xtx, fX);
+    SpdMatrix expected(p, 0.0);
+    expected.add_inner(rounded);
+    EXPECT_TRUE(MatrixEquals(xtx, expected, 1e-8));
+
+    // A view of a row subset.
+    ConstFloatSubMatrix rows = fX.view().rows(300, 700);
+    EXPECT_TRUE(VectorEquals(
+        float_matrix_vector_product(rows, beta),
+        ConstSubMatrix(rounded, 300, 699, 0, p - 1).to_matrix() * beta,
+        1e-10));
+  }
+
+}  // namespace
@@ -0,0 +1,188 @@
+#include "gtest/gtest.h"
+#include "LinAlg/Matrix.hpp"
+#include "LinAlg/SpdMatrix.hpp"
+#include "LinAlg/SubMatrix.hpp"
+#include "LinAlg/Vector.hpp"
+#include "LinAlg/VectorView.hpp"
+#include "LinAlg/fused_operations.hpp"
+#include "distributions.hpp"
+#include "test_utils/test_utils.hpp"
+
+namespace {
+  using namespace BOOM;
+  using std::endl;
+  using std::cout;
+
+  class FusedOperationsTest : public ::testing::Test {
+   protected:
+    FusedOperationsTest() {
+      GlobalRng::rng.seed(8675309);
+    }
+  };
+
+  TEST_F(FusedOperationsTest, MatrixVectorProduct) {
+    Matrix A(4, 3);
+    A.randomize();
+    Vector x(3);
+    x.randomize();
+
+    Vector ans;
+    matrix_vector_product(ans, A, x);
+    EXPECT_TRUE(VectorEquals(ans, A * x));
+
+    Vector y(4);
+    y.randomize();
+    Vector original_y = y;
+    matrix_vector_product(y, A, x, 2.0, -1.0);
+    EXPECT_TRUE(VectorEquals(y, 2.0 * (A * x) - original_y));
+
+    // Write into a column of a matrix, which is a strided view.
+    Matrix output(4, 2, 0.0);
+    matrix_vector_product(output.col(1), A, x);
+    EXPECT_TRUE(VectorEquals(output.col(1), A * x));
+    EXPECT_DOUBLE_EQ(0.0, output.col(0).abs_norm());
+
+    Vector z(4);
+    z.randomize();
+    Vector tans;
+    transpose_matrix_vector_product(tans, A, z, .5);
+    EXPECT_TRUE(VectorEquals(tans, .5 * A.Tmult(z)));
+  }
+
+  TEST_F(FusedOperationsTest, Residual) {
+    Matrix X(10, 3);
+    X.randomize();
+    Vector beta(3);
+    beta.randomize();
+    Vector y(10);
+    y.randomize();
+
+    Vector resid;
+    residual(resid, y, X, beta);
+    EXPECT_TRUE(VectorEquals(resid, y - X * beta));
+
+    // The output can be the same vector as y.
+    Vector y_copy = y;
+    residual(y_copy, y_copy, X, beta);
+    EXPECT_TRUE(VectorEquals(y_copy, y - X * beta));
+
+    // Rows of a matrix are strided views.
+    Matrix XT = X.transpose();
+    Matrix output(2, 10);
+    residual(output.row(0), y, XT.transpose(), beta);
+    EXPECT_TRUE(VectorEquals(output.row(0), y - X * beta));
+  }
+
+  TEST_F(FusedOperationsTest, LinearCombination) {
+    Vector x(5), y(5);
+    x.randomize();
+    y.randomize();
+    Vector ans;
+    linear_combination(ans, 2.0, x, -3.0, y);
+    EXPECT_TRUE(VectorEquals(ans, 2.0 * x - 3.0 * y));
+
+    Vector x_copy = x;
+    linear_combination(x_copy, 2.0, x_copy, -3.0, y);
+    EXPECT_TRUE(VectorEquals(x_copy, 2.0 * x - 3.0 * y));
+  }
+
+  TEST_F(FusedOperationsTest, MatrixProduct) {
+    Matrix A(3, 4), B(4, 2);
+    A.randomize();
+    B.randomize();
+    Matrix ans;
+    matrix_product(ans, A, B);
+    EXPECT_TRUE(MatrixEquals(ans, A * B));
+
+    Matrix C(3, 2);
+    C.randomize();
+    Matrix original_C = C;
+    matrix_product(C, A, B, 1.5, 2.0);
+    EXPECT_TRUE(MatrixEquals(C, 1.5 * (A * B) + 2.0 * original_C));
+  }
+
+  // The view overloads read blocks of larger matrices in place, and write
+  // into blocks of caller-owned matrices without touching anything else.
+  TEST_F(FusedOperationsTest, SubMatrixProducts) {
+    Matrix big_A(6, 7), big_B(8, 5);
+    big_A.randomize();
+    big_B.randomize();
+    ConstSubMatrix A(big_A, 1, 3, 2, 5);   // 3 x 4
+    ConstSubMatrix B(big_B, 2, 5, 1, 2);   // 4 x 2
+    Matrix dense_A = A.to_matrix();
+    Matrix dense_B = B.to_matrix();
+
+    Matrix output(5, 6, 0.0);
+    SubMatrix block(output, 1, 3, 2, 3);
+    matrix_product(block, A, B);
+    EXPECT_TRUE(MatrixEquals(block.to_matrix(), dense_A * dense_B));
+    EXPECT_DOUBLE_EQ(output.sum(), block.sum());
+
+    Matrix original_block = block.to_matrix();
+    matrix_product(block, A, B, 2.0, -1.0);
+    EXPECT_TRUE(MatrixEquals(block.to_matrix(),
+                             2.0 * (dense_A * dense_B) - original_block));
+
+    // A' * C, with C a 3 x 2 block.
+    ConstSubMatrix C(big_B, 0, 2, 3, 4);
+    Matrix tprod(4, 2);
+    transpose_matrix_product(SubMatrix(tprod), A, C, .5);
+    EXPECT_TRUE(MatrixEquals(tprod, .5 * dense_A.Tmult(C.to_matrix())));
+
+    // A * D', with D a 2 x 4 block.
+    ConstSubMatrix D(big_A, 4, 5, 0, 3);
+    Matrix prodt(3, 2);
+    matrix_product_transpose(SubMatrix(prodt), A, D);
+    EXPECT_TRUE(MatrixEquals(prodt, dense_A.multT(D.to_matrix())));
+
+    Vector x(4);
+    x.randomize();
+    Vector Ax(3);
+    matrix_vector_product(VectorView(Ax), A, x);
+    EXPECT_TRUE(VectorEquals(Ax, dense_A * x));
+    Vector z(3);
+    z.randomize();
+    Vector Atz(4);
+    transpose_matrix_vector_product(VectorView(Atz), A, z);
+    EXPECT_TRUE(VectorEquals(Atz, dense_A.Tmult(z)));
+
+    EXPECT_THROW(matrix_product(SubMatrix(prodt), A, A), std::exception);
+  }
+
+  TEST_F(FusedOperationsTest, AddInnerProduct) {
+    Matrix big_X(20, 6);
+    big_X.randomize();
+    ConstSubMatrix X(big_X, 3, 17, 1, 4);
+    Matrix dense_X = X.to_matrix();
+
+    SpdMatrix xtx(4, 0.0);
+    add_inner_product(xtx, X);
+    EXPECT_TRUE(MatrixEquals(xtx, dense_X.Tmult(dense_X)));
+
+    SpdMatrix deferred(4, 0.0);
+    add_inner_product(deferred, X, 2.0, false);
+    add_inner_product(deferred, X, 1.0, false);
+    deferred.reflect();
+    EXPECT_TRUE(MatrixEquals(deferred, 3.0 * dense_X.Tmult(dense_X)));
+  }
+
+  // The member multiplication functions skip Eigen's temporary when the
+  // output is distinct from the inputs.  Make sure they still work when it
+  // is not.
+  TEST_F(FusedOperationsTest, AliasedMemberMultiplication) {
+    Matrix A(3, 3);
+    A.randomize();
+    Vector v(3);
+    v.randomize();
+    Vector expected = A * v;
+    A.mult(v, v);
+    EXPECT_TRUE(VectorEquals(v, expected));
+
+    Matrix B(3, 3);
+    B.randomize();
+    Matrix expected_product = A * B;
+    A.mult(B, B);
+    EXPECT_TRUE(MatrixEquals(B, expected_product));
+  }
+
+}  // namespace
@@ -306,4 +306,25 @@ namespace {
     EXPECT_TRUE(VectorEquals(x, y));
   }
 
+  TEST_F(SelectorTest, SelectInto) {
+    Vector x(5);
+    x.randomize();
+    SpdMatrix S(5);
+    S.randomize();
+    Selector three("11010");
+
+    Vector selected_x;
+    three.select_into(x, selected_x);
+    EXPECT_TRUE(VectorEquals(three.select(x), selected_x));
+    SpdMatrix selected_S(1);
+    three.select_into(S, selected_S);
+    EXPECT_TRUE(MatrixEquals(three.select(S), selected_S));
+
+    Selector all(5, true);
+    all.select_into(x, selected_x);
+    EXPECT_TRUE(VectorEquals(x, selected_x));
+    all.select_into(S, selected_S);
+    EXPECT_TRUE(MatrixEquals(S, selected_S));
+  }
+
 }  // namespace
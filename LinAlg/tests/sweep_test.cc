@@ -98,4 +98,76 @@ namespace {
 
   }
 
+  TEST_F(SweepTest, BatchConditionalMean) {
+    SweptVarianceMatrix swp(spd_);
+    Selector known("0110");
+    swp.SWP(known);
+
+    Matrix y(3, 4);
+    y.randomize();
+    Matrix mean(3, 4);
+    mean.randomize();
+    Matrix known_values(3, 2);
+    for (int i = 0; i < 3; ++i) {
+      known_values.row(i) = known.select(Vector(y.row(i)));
+    }
+
+    Matrix batch = swp.conditional_mean(known_values, mean);
+    EXPECT_EQ(3, batch.nrow());
+    EXPECT_EQ(2, batch.ncol());
+    for (int i = 0; i < 3; ++i) {
+      Vector single = swp.conditional_mean(Vector(known_values.row(i)),
+                                           Vector(mean.row(i)));
+      EXPECT_TRUE(VectorEquals(single, batch.row(i)));
+    }
+  }
+
+  TEST_F(SweepTest, SweptVarianceCache) {
+    SweptVarianceCache cache(spd_, 2);
+    Selector pattern1("1010");
+    Selector pattern2("0111");
+    Selector pattern3("1100");
+
+    // Sweeping a fresh copy for each pattern matches sweeping a single matrix
+    // back and forth.
+    SweptVarianceMatrix swp(spd_);
+    swp.SWP(pattern1);
+    EXPECT_TRUE(MatrixEquals(cache.swept(pattern1).swept_matrix(),
+                             swp.swept_matrix()));
+    swp.SWP(pattern2);
+    EXPECT_TRUE(MatrixEquals(cache.swept(pattern2).swept_matrix(),
+                             swp.swept_matrix()));
+    EXPECT_EQ(2, cache.number_of_patterns());
+
+    // The cached regression coefficients and conditional means match the
+    // swept matrix.
+    const SweptVarianceCache::Pattern &pattern(cache.pattern(pattern2));
+    EXPECT_TRUE(MatrixEquals(pattern.regression_coefficients(), swp.Beta()));
+    Vector known = {1.0, -2.0, 0.5};
+    Vector mean = {0.3, 0.1, -0.4, 2.0};
+    EXPECT_TRUE(VectorEquals(pattern.conditional_mean(known, mean),
+                             swp.conditional_mean(known, mean)));
+    EXPECT_EQ(1, pattern.residual_drawer().dim());
+
+    // Patterns are reused.
+    const SweptVarianceMatrix *first = &cache.swept(pattern1);
+    EXPECT_EQ(first, &cache.swept(pattern1));
+    EXPECT_EQ(2, cache.number_of_patterns());
+
+    // A third pattern evicts the least recently used one (pattern2).
+    cache.swept(pattern3);
+    EXPECT_EQ(2, cache.number_of_patterns());
+    EXPECT_EQ(first, &cache.swept(pattern1));
+
+    // Changing the variance makes the cached patterns stale.
+    SpdMatrix other(4);
+    other.randomize();
+    cache.set_variance(other);
+    EXPECT_EQ(1, cache.version());
+    SweptVarianceMatrix other_swp(other);
+    other_swp.SWP(pattern1);
+    EXPECT_TRUE(MatrixEquals(cache.swept(pattern1).swept_matrix(),
+                             other_swp.swept_matrix()));
+  }
+
 }  // namespace
@@ -0,0 +1,114 @@
+#include "gtest/gtest.h"
+#include "LinAlg/Workspace.hpp"
+#include "distributions.hpp"
+#include "test_utils/test_utils.hpp"
+
+namespace {
+  using namespace BOOM;
+  using std::endl;
+  using std::cout;
+
+  class WorkspaceTest : public ::testing::Test {
+   protected:
+    WorkspaceTest() {
+      GlobalRng::rng.seed(8675309);
+    }
+  };
+
+  TEST_F(WorkspaceTest, ObjectsAreReusedAfterReset) {
+    WorkspaceArena arena;
+    Vector &v(arena.vector(5));
+    Matrix &m(arena.matrix(3, 4));
+    SpdMatrix &s(arena.spd(3));
+    EXPECT_EQ(5, v.size());
+    EXPECT_EQ(3, m.nrow());
+    EXPECT_EQ(4, m.ncol());
+    EXPECT_EQ(3, s.nrow());
+    EXPECT_EQ(3, arena.requests());
+    EXPECT_EQ(3, arena.heap_allocations());
+
+    const double *vdata = v.data();
+    arena.reset();
+    Vector &v2(arena.vector(4));
+    EXPECT_EQ(&v, &v2);
+    EXPECT_EQ(vdata, v2.data());
+    arena.matrix(2, 6);
+    arena.spd(2);
+    EXPECT_EQ(6, arena.requests());
+    EXPECT_EQ(3, arena.heap_allocations());
+
+    // Asking for more than the pool provides requires an allocation.
+    arena.vector(3);
+    EXPECT_EQ(4, arena.heap_allocations());
+    arena.reset();
+    arena.vector(100);
+    EXPECT_EQ(5, arena.heap_allocations());
+
+    arena.clear_statistics();
+    EXPECT_EQ(0, arena.requests());
+    EXPECT_EQ(0, arena.heap_allocations());
+  }
+
+  TEST_F(WorkspaceTest, ScopesNest) {
+    WorkspaceArena arena;
+    Vector &outer(arena.vector(3));
+    outer = 1.0;
+    {
+      WorkspaceScope scope(arena);
+      Vector &inner(scope.workspace().vector(3));
+      EXPECT_NE(&outer, &inner);
+      inner = 2.0;
+      {
+        WorkspaceScope inner_scope(arena);
+        inner_scope.workspace().matrix(2, 2);
+        EXPECT_EQ(2, arena.mark().vectors);
+        EXPECT_EQ(1, arena.mark().matrices);
+      }
+      EXPECT_EQ(0, arena.mark().matrices);
+      EXPECT_DOUBLE_EQ(2.0, inner[0]);
+    }
+    EXPECT_EQ(1, arena.mark().vectors);
+    EXPECT_DOUBLE_EQ(1.0, outer[2]);
+
+    // An object released by a scope is handed out again.
+    Vector &again(arena.vector(3));
+    EXPECT_EQ(3, arena.heap_allocations());
+    EXPECT_EQ(2, arena.mark().vectors);
+    EXPECT_NE(&outer, &again);
+  }
+
+  TEST_F(WorkspaceTest, ThreadWorkspaceIsPersistent) {
+    WorkspaceArena &workspace(thread_workspace());
+    EXPECT_EQ(&workspace, &thread_workspace());
+    WorkspaceArena::Mark start = workspace.mark();
+    {
+      WorkspaceScope scope;
+      scope.workspace().vector(10);
+      EXPECT_EQ(start.vectors + 1, workspace.mark().vectors);
+    }
+    EXPECT_EQ(start.vectors, workspace.mark().vectors);
+  }
+
+  TEST_F(WorkspaceTest, PersistentWorkspaceCopiesAreIndependent) {
+    PersistentWorkspace workspace;
+    WorkspaceArena &arena(workspace.arena());
+    EXPECT_EQ(&arena, &workspace.arena());
+    {
+      WorkspaceScope scope(arena);
+      scope.workspace().spd(4);
+    }
+    {
+      WorkspaceScope scope(arena);
+      scope.workspace().spd(4);
+    }
+    EXPECT_EQ(2, arena.requests());
+    EXPECT_EQ(1, arena.heap_allocations());
+
+    PersistentWorkspace copy(workspace);
+    EXPECT_NE(&arena, &copy.arena());
+    EXPECT_EQ(0, copy.arena().requests());
+    copy = workspace;
+    EXPECT_NE(&arena, &copy.arena());
+  }
+
+}  // namespace
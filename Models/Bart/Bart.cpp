@@ -21,9 +21,12 @@
 #include <cmath>
 #include <cstdlib>
 #include <iterator>
+#include <memory>
+#include <utility>
 
 #include "Models/Bart/Bart.hpp"
 #include "Models/Bart/ResidualRegressionData.hpp"
+#include "cpputil/ThreadTools.hpp"
 #include "cpputil/math_utils.hpp"
 #include "cpputil/report_error.hpp"
 #include "distributions.hpp"
@@ -32,6 +35,30 @@
 namespace BOOM {
   namespace Bart {
     namespace {
+      // Nodes with fewer observations than this are processed serially,
+      // because the cost of dispatching work to the thread pool would
+      // exceed the savings.
+      const int minimum_shard_size = 10000;
+
+      // The number of shards to use for a node with 'sample_size'
+      // observations.  A return value of 1 means "don't shard."
+      int shard_count(int sample_size, const SharedThreadPool *pool) {
+        if (!pool || pool->no_threads() ||
+            sample_size < 2 * minimum_shard_size) {
+          return 1;
+        }
+        int max_shards = 4 * std::max<int>(pool->number_of_threads(), 1);
+        return std::min<int>(max_shards, sample_size / minimum_shard_size);
+      }
+
+      // Observations [first, second) belong to shard 'shard'.
+      std::pair<int, int> shard_range(int shard, int number_of_shards,
+                                      int sample_size) {
+        int64_t begin = int64_t(sample_size) * shard / number_of_shards;
+        int64_t end = int64_t(sample_size) * (shard + 1) / number_of_shards;
+        return std::make_pair(int(begin), int(end));
+      }
+
       inline void remove_node_and_descendants_from_set(
           TreeNode *node, std::set<TreeNode *> &set_of_nodes) {
         if (!node) {
@@ -46,6 +73,33 @@ namespace BOOM {
         }
       }
 
+      // Args:
+      //   sorted_values: A sorted vector of observed values.
+      //   number_of_cutpoints: The number of equally spaced quantiles
+      //     desired.
+      //
+      // Returns:
+      //   The requested quantiles of sorted_values, followed by the
+      //   largest observed value.  DiscreteVariableSummary drops the
+      //   largest value it is given, leaving at most
+      //   number_of_cutpoints distinct cutpoints.
+      Vector empirical_quantiles(const Vector &sorted_values,
+                                 int number_of_cutpoints) {
+        Vector ans;
+        int n = sorted_values.size();
+        if (n == 0) {
+          return ans;
+        }
+        number_of_cutpoints = std::max(number_of_cutpoints, 1);
+        ans.reserve(number_of_cutpoints + 1);
+        for (int j = 1; j <= number_of_cutpoints; ++j) {
+          int64_t index = int64_t(j) * n / (number_of_cutpoints + 1);
+          ans.push_back(sorted_values[std::min<int64_t>(index, n - 1)]);
+        }
+        ans.push_back(sorted_values.back());
+        return ans;
+      }
+
       // Args:
       //   rng: The random number generator used to generate the U[0, 1)
       //     randomness.
@@ -90,8 +144,16 @@ namespace BOOM {
 
     //----------------------------------------------------------------------
     void VariableSummary::finalize(int discrete_distribution_cutoff,
-                                   ContinuousCutpointStrategy strategy) {
+                                   ContinuousCutpointStrategy strategy,
+                                   int max_number_of_cutpoints) {
       observed_values_.sort();
+      // The quantiles must be computed before duplicates are removed,
+      // because they depend on how often each value occurs.
+      Vector quantiles;
+      if (strategy == DISCRETE_QUANTILES) {
+        quantiles =
+            empirical_quantiles(observed_values_, max_number_of_cutpoints);
+      }
       Vector::iterator end =
           std::unique(observed_values_.begin(), observed_values_.end());
 
@@ -115,6 +177,10 @@ namespace BOOM {
             impl_.reset(new DiscreteVariableSummary(variable_number_,
                                                     observed_values_));
             break;
+          case DISCRETE_QUANTILES:
+            impl_.reset(
+                new DiscreteVariableSummary(variable_number_, quantiles));
+            break;
           default:
             report_error(
                 "Unknown enum value passed to "
@@ -716,16 +782,31 @@ namespace BOOM {
       }
     }
 
+    //----------------------------------------------------------------------
+    void TreeNode::populate_data(
+        const std::vector<ResidualRegressionData *> &data) {
+      data_.insert(data_.end(), data.begin(), data.end());
+      refresh_subtree_data();
+    }
+
     //----------------------------------------------------------------------
     void TreeNode::refresh_subtree_data() {
       if (is_leaf()) {
         return;
       }
-      left_child_->clear_data_and_suf(true);
-      right_child_->clear_data_and_suf(true);
-      for (int i = 0; i < data_.size(); ++i) {
-        drop_data_to_subtree(data_[i]);
+      left_child_->clear_data_and_suf(false);
+      right_child_->clear_data_and_suf(false);
+      std::vector<ResidualRegressionData *> &left_data(left_child_->data_);
+      std::vector<ResidualRegressionData *> &right_data(right_child_->data_);
+      for (ResidualRegressionData *dp : data_) {
+        if (dp->x()[which_variable_] <= cutpoint_) {
+          left_data.push_back(dp);
+        } else {
+          right_data.push_back(dp);
+        }
       }
+      left_child_->refresh_subtree_data();
+      right_child_->refresh_subtree_data();
     }
 
     //----------------------------------------------------------------------
@@ -735,14 +816,32 @@ namespace BOOM {
     }
 
     //----------------------------------------------------------------------
-    const SufficientStatisticsBase &TreeNode::compute_suf() {
+    const SufficientStatisticsBase &TreeNode::compute_suf(
+        SharedThreadPool *pool) {
       if (!!suf_) {
         suf_->clear();
       } else {
         report_error("Sufficient statistics object was never allocated.");
       }
-      for (int i = 0; i < data_.size(); ++i) {
-        suf_->update(*(data_[i]));
+      int number_of_shards = shard_count(data_.size(), pool);
+      if (number_of_shards <= 1) {
+        for (int i = 0; i < data_.size(); ++i) {
+          suf_->update(*(data_[i]));
+        }
+        return *suf_;
+      }
+      std::vector<std::unique_ptr<SufficientStatisticsBase>> shards(
+          number_of_shards);
+      pool->parallel_for(0, number_of_shards, 1, [&](int shard) {
+        std::pair<int, int> range =
+            shard_range(shard, number_of_shards, data_.size());
+        shards[shard].reset(suf_->create());
+        for (int i = range.first; i < range.second; ++i) {
+          shards[shard]->update(*(data_[i]));
+        }
+      });
+      for (int shard = 0; shard < number_of_shards; ++shard) {
+        suf_->combine(*shards[shard]);
       }
       return *suf_;
     }
@@ -753,17 +852,39 @@ namespace BOOM {
     }
 
     //----------------------------------------------------------------------
-    void TreeNode::remove_mean_effect() {
-      for (int i = 0; i < data_.size(); ++i) {
-        data_[i]->add_to_residual(mean_);
+    void TreeNode::remove_mean_effect(SharedThreadPool *pool) {
+      int number_of_shards = shard_count(data_.size(), pool);
+      if (number_of_shards <= 1) {
+        for (int i = 0; i < data_.size(); ++i) {
+          data_[i]->add_to_residual(mean_);
+        }
+        return;
       }
+      pool->parallel_for(0, number_of_shards, 1, [&](int shard) {
+        std::pair<int, int> range =
+            shard_range(shard, number_of_shards, data_.size());
+        for (int i = range.first; i < range.second; ++i) {
+          data_[i]->add_to_residual(mean_);
+        }
+      });
     }
 
     //----------------------------------------------------------------------
-    void TreeNode::replace_mean_effect() {
-      for (int i = 0; i < data_.size(); ++i) {
-        data_[i]->subtract_from_residual(mean_);
+    void TreeNode::replace_mean_effect(SharedThreadPool *pool) {
+      int number_of_shards = shard_count(data_.size(), pool);
+      if (number_of_shards <= 1) {
+        for (int i = 0; i < data_.size(); ++i) {
+          data_[i]->subtract_from_residual(mean_);
+        }
+        return;
       }
+      pool->parallel_for(0, number_of_shards, 1, [&](int shard) {
+        std::pair<int, int> range =
+            shard_range(shard, number_of_shards, data_.size());
+        for (int i = range.first; i < range.second; ++i) {
+          data_[i]->subtract_from_residual(mean_);
+        }
+      });
     }
 
     //----------------------------------------------------------------------
@@ -1033,22 +1154,28 @@ namespace BOOM {
       root_->populate_data(data, true);
     }
 
+    //----------------------------------------------------------------------
+    void Tree::populate_data(
+        const std::vector<ResidualRegressionData *> &data) {
+      root_->populate_data(data);
+    }
+
     //----------------------------------------------------------------------
     void Tree::clear_data_and_delete_suf() {
       root_->clear_data_and_delete_suf(true);
     }
 
     //----------------------------------------------------------------------
-    void Tree::remove_mean_effect() {
+    void Tree::remove_mean_effect(SharedThreadPool *pool) {
       for (NodeSetIterator it = leaves_.begin(); it != leaves_.end(); ++it) {
-        (*it)->remove_mean_effect();
+        (*it)->remove_mean_effect(pool);
       }
     }
 
     //----------------------------------------------------------------------
-    void Tree::replace_mean_effect() {
+    void Tree::replace_mean_effect(SharedThreadPool *pool) {
       for (NodeSetIterator it = leaves_.begin(); it != leaves_.end(); ++it) {
-        (*it)->replace_mean_effect();
+        (*it)->replace_mean_effect(pool);
       }
     }
 
@@ -1181,11 +1308,42 @@ namespace BOOM {
     trees_[i]->from_matrix(matrix);
   }
 
+  //----------------------------------------------------------------------
+  void BartModelBase::write_checkpoint(CheckpointWriter &out) const {
+    Model::write_checkpoint(out);
+    out.begin_section("BartTrees");
+    out.write(number_of_trees());
+    for (int i = 0; i < number_of_trees(); ++i) {
+      Matrix tree_matrix = trees_[i]->to_matrix();
+      out.write(static_cast<int>(tree_matrix.nrow()));
+      out.write(static_cast<int>(tree_matrix.ncol()));
+      out.write(std::vector<double>(tree_matrix.begin(), tree_matrix.end()));
+    }
+  }
+
+  void BartModelBase::read_checkpoint(CheckpointReader &in) {
+    Model::read_checkpoint(in);
+    in.expect_section("BartTrees");
+    set_number_of_trees(in.read_int());
+    for (int i = 0; i < number_of_trees(); ++i) {
+      int nrow = in.read_int();
+      int ncol = in.read_int();
+      std::vector<double> data = in.read_double_vector();
+      if (data.size() != static_cast<size_t>(nrow) * ncol) {
+        report_error("Malformed tree in BART checkpoint.");
+      }
+      Matrix tree_matrix(nrow, ncol, data.data());
+      rebuild_tree(i, ConstSubMatrix(tree_matrix));
+    }
+  }
+
   //----------------------------------------------------------------------
   void BartModelBase::finalize_data(int discrete_distribution_cutoff,
-                                    Bart::ContinuousCutpointStrategy strategy) {
+                                    Bart::ContinuousCutpointStrategy strategy,
+                                    int max_number_of_cutpoints) {
     for (int i = 0; i < number_of_variables(); ++i) {
-      variable_summaries_[i].finalize(discrete_distribution_cutoff, strategy);
+      variable_summaries_[i].finalize(discrete_distribution_cutoff, strategy,
+                                      max_number_of_cutpoints);
     }
   }
 
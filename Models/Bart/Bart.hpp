@@ -32,6 +32,7 @@
 #include "distributions/rng.hpp"
 
 namespace BOOM {
+  class SharedThreadPool;
 
   namespace Bart {
     class TreeNode;
@@ -67,6 +68,13 @@ namespace BOOM {
       // Add relevant functions of data to the sufficient statistics
       // being modeled.
       virtual void update(const ResidualRegressionData &data) = 0;
+
+      // Add the data summarized by 'rhs' to *this.  It is an error if
+      // rhs is not the same concrete type as *this.  Nodes with a lot
+      // of data build their sufficient statistics in shards, which are
+      // then combined.
+      virtual void combine(const SufficientStatisticsBase &rhs) = 0;
+
       virtual SufficientStatisticsBase *create() const {
         SufficientStatisticsBase *ans = clone();
         ans->clear();
@@ -86,7 +94,13 @@ namespace BOOM {
 
       // Choose cutpoints at random according to a discretization of
       // the empirical CDF.  This will put more cutpoints into regions
-      // where there is more data.
+      // where there is more data.  The variable is treated as
+      // discrete, with at most max_number_of_cutpoints values (see
+      // VariableSummary::finalize), so each variable has at most
+      // max_number_of_cutpoints + 1 bins.  This is an approximation
+      // for very large data sets.  It lets the posterior sampler
+      // summarize a node's data with a histogram over the bins (see
+      // BartPosteriorSamplerBase::set_use_histograms).
       DISCRETE_QUANTILES
     };
 
@@ -154,8 +168,13 @@ namespace BOOM {
       // Args:
       //   discrete_distribution_cutoff: The number of unique values a
       //     numeric variable must have before it is considered continuous.
+      //   strategy:  How cutpoints are chosen for continuous variables.
+      //   max_number_of_cutpoints: The largest number of cutpoints
+      //     used by the DISCRETE_QUANTILES strategy.  Ignored by other
+      //     strategies.
       void finalize(int discrete_distribution_cutoff = 20,
-                    ContinuousCutpointStrategy = UNIFORM_CONTINUOUS);
+                    ContinuousCutpointStrategy strategy = UNIFORM_CONTINUOUS,
+                    int max_number_of_cutpoints = 255);
 
       // Serialize the value of this variable summary for long term
       // storage.
@@ -381,8 +400,17 @@ namespace BOOM {
       //     left or the right.
       void populate_data(ResidualRegressionData *dp, bool recursive = true);
 
+      // Associate a set of observations with this node, and partition
+      // them among this node's descendants.  This is equivalent to
+      // calling populate_data(dp, true) for each element of 'data',
+      // but each node's data is split with a single pass.
+      void populate_data(const std::vector<ResidualRegressionData *> &data);
+
       // Clear the data below this node, and drop this node's data
       // down through the subtree formed by this node's descendants.
+      // Each interior node partitions its data between its children
+      // in one pass, preserving the order of the observations, and
+      // the children repeat the process.
       void refresh_subtree_data();
 
       // Take this data point, and recursively distribute it to either
@@ -402,23 +430,30 @@ namespace BOOM {
       // Re-compute sufficient statistics based on the current values
       // of the residuals assigned to this node.
       //
+      // Args:
+      //   pool: If non-NULL and the node has enough data, the data
+      //     are split into contiguous shards that are summarized in
+      //     parallel, and the shards are then combined in order.
+      //
       // TODO: Check whether this is a bottleneck, and if
       // so whether it can be made more efficient using an
       // "is_current" observer.
-      const SufficientStatisticsBase &compute_suf();
+      const SufficientStatisticsBase &compute_suf(
+          SharedThreadPool *pool = nullptr);
 
       // The vector of data associated with this node.
       const std::vector<ResidualRegressionData *> &data() const;
 
       // Remove the effect of this node on the predicted values of the
       // data associated with it.  (I.e. adjust the predictions as if
-      // the mean of this node was zero).
-      void remove_mean_effect();
+      // the mean of this node was zero).  If 'pool' is non-NULL then
+      // large data sets are adjusted in parallel shards.
+      void remove_mean_effect(SharedThreadPool *pool = nullptr);
 
       // Replace the effect of this node in the predicted values of
       // the data associated it.  This is the inverse operation to
       // remove_mean_effect().
-      void replace_mean_effect();
+      void replace_mean_effect(SharedThreadPool *pool = nullptr);
 
       std::ostream &print(std::ostream &out) const;
 
@@ -579,6 +614,10 @@ namespace BOOM {
       // falls through keeps a copy of the pointer.
       void populate_data(ResidualRegressionData *data);
 
+      // Drops a set of data pointers through the tree.  Equivalent to
+      // calling populate_data() for each element, but faster.
+      void populate_data(const std::vector<ResidualRegressionData *> &data);
+
       // Removes the data from the nodes in the tree, and deletes the
       // sufficient statistics objects summarizing the data.
       void clear_data_and_delete_suf();
@@ -586,11 +625,11 @@ namespace BOOM {
       // Remove any contribution that this tree has made towards the
       // residuals by having each leaf add its mean back into the
       // residuals.
-      void remove_mean_effect();
+      void remove_mean_effect(SharedThreadPool *pool = nullptr);
 
       // Replace this tree's effect on the residuals by subtracting
       // each leaf's mean effect from the residuals for that leaf.
-      void replace_mean_effect();
+      void replace_mean_effect(SharedThreadPool *pool = nullptr);
 
       std::ostream &print(std::ostream &out) const;
 
@@ -675,6 +714,11 @@ namespace BOOM {
 
     // Rebuild an individual tree from its matrix representation.
     void rebuild_tree(int which_tree, const ConstSubMatrix &tree_matrix);
+
+    // The checkpoint includes each tree, in addition to the parameters and
+    // samplers handled by Model.
+    void write_checkpoint(CheckpointWriter &out) const override;
+    void read_checkpoint(CheckpointReader &in) override;
     // Rebuild the variable summaries from their serialized values.
     void set_variable_summaries(
         const std::vector<Bart::SerializedVariableSummary> &serialized);
@@ -684,7 +728,8 @@ namespace BOOM {
     // data has been observed.
     void finalize_data(
         int discrete_distribution_cutoff = 20,
-        Bart::ContinuousCutpointStrategy strategy = Bart::UNIFORM_CONTINUOUS);
+        Bart::ContinuousCutpointStrategy strategy = Bart::UNIFORM_CONTINUOUS,
+        int max_number_of_cutpoints = 255);
 
     // Returns the VariableSummary associated with the variable at the
     // given index.
@@ -0,0 +1,311 @@
+/*
+  Copyright (C) 2005-2024 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include "Models/Bart/BartEnsembleFile.hpp"
+#include <cstring>
+#include <sstream>
+#include "cpputil/report_error.hpp"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace BOOM {
+
+  namespace {
+    const char magic[8] = {'B', 'O', 'O', 'M', 'B', 'A', 'R', 'T'};
+
+    std::vector<Bart::SerializedVariableSummary> serialize_variable_summaries(
+        const BartModelBase &model) {
+      std::vector<Bart::SerializedVariableSummary> ans;
+      for (int i = 0; i < model.number_of_variables(); ++i) {
+        ans.push_back(model.variable_summary(i).serialize());
+      }
+      return ans;
+    }
+
+    // Reads consecutive fields from a memory mapped file, reporting an
+    // error rather than reading past the end of the mapping.
+    class Cursor {
+     public:
+      Cursor(const char *data, size_t size, size_t position,
+             const std::string &filename)
+          : data_(data), size_(size), position_(position),
+            filename_(filename) {}
+
+      // Return a pointer to the next 'count' objects of type T, and advance
+      // past them.
+      template <class T>
+      const T *next(int64_t count) {
+        if (count < 0 || (size_ - position_) / sizeof(T) < size_t(count)) {
+          report_error(filename_ + " is truncated or corrupt.");
+        }
+        const T *ans = reinterpret_cast<const T *>(data_ + position_);
+        position_ += sizeof(T) * count;
+        return ans;
+      }
+
+      void seek(int64_t position) {
+        if (position < 0 || size_t(position) > size_ || position % 8 != 0) {
+          report_error(filename_ + " is truncated or corrupt.");
+        }
+        position_ = position;
+      }
+
+     private:
+      const char *data_;
+      size_t size_;
+      size_t position_;
+      std::string filename_;
+    };
+  }  // namespace
+
+  //===========================================================================
+  BartEnsembleWriter::BartEnsembleWriter(const std::string &filename,
+                                         const BartModelBase &model)
+      : BartEnsembleWriter(filename, serialize_variable_summaries(model)) {}
+
+  BartEnsembleWriter::BartEnsembleWriter(
+      const std::string &filename,
+      const std::vector<Bart::SerializedVariableSummary> &variable_summaries)
+      : filename_(filename),
+        out_(filename, std::ios::binary | std::ios::trunc),
+        number_of_variables_(variable_summaries.size()),
+        index_offset_(0)
+  {
+    if (!out_) {
+      report_error("Could not open " + filename + " for writing.");
+    }
+    write_header();
+    for (const auto &summary : variable_summaries) {
+      int32_t fields[4] = {summary.variable_number, summary.finalized,
+                           summary.is_continuous, summary.strategy};
+      int64_t size = summary.data.size();
+      write(fields, sizeof(fields));
+      write(&size, sizeof(size));
+      write(summary.data.data(), sizeof(double) * size);
+    }
+  }
+
+  BartEnsembleWriter::~BartEnsembleWriter() {
+    if (out_.is_open()) {
+      try {
+        close();
+      } catch (...) {
+      }
+    }
+  }
+
+  void BartEnsembleWriter::write_header() {
+    char header[BartEnsembleFormat::header_size];
+    std::memset(header, 0, sizeof(header));
+    std::memcpy(header, magic, sizeof(magic));
+    uint32_t byte_order = BartEnsembleFormat::byte_order_mark;
+    uint32_t version = BartEnsembleFormat::version;
+    int64_t number_of_draws = draw_offsets_.size();
+    std::memcpy(header + 8, &byte_order, sizeof(byte_order));
+    std::memcpy(header + 12, &version, sizeof(version));
+    std::memcpy(header + 16, &number_of_variables_,
+                sizeof(number_of_variables_));
+    std::memcpy(header + 24, &number_of_draws, sizeof(number_of_draws));
+    std::memcpy(header + 32, &index_offset_, sizeof(index_offset_));
+    out_.seekp(0);
+    write(header, sizeof(header));
+  }
+
+  void BartEnsembleWriter::write(const void *data, size_t bytes) {
+    out_.write(static_cast<const char *>(data), bytes);
+    if (!out_) {
+      report_error("Error writing to " + filename_ + ".");
+    }
+  }
+
+  void BartEnsembleWriter::add_draw(const BartModelBase &model) {
+    add_draw(Bart::CompiledForest(model));
+  }
+
+  void BartEnsembleWriter::add_draw(const Bart::CompiledForest &forest) {
+    if (!out_.is_open()) {
+      report_error("add_draw called on a closed BartEnsembleWriter.");
+    }
+    Bart::CompiledForestView view = forest.view();
+    draw_offsets_.push_back(out_.tellp());
+    int64_t sizes[2] = {view.number_of_trees, view.number_of_nodes};
+    write(sizes, sizeof(sizes));
+    write(view.cutpoint, sizeof(double) * view.number_of_nodes);
+    write(view.leaf_value, sizeof(double) * view.number_of_nodes);
+    write(view.variable, sizeof(int32_t) * view.number_of_nodes);
+    write(view.left_child, sizeof(int32_t) * view.number_of_nodes);
+    write(view.tree_start, sizeof(int32_t) * view.number_of_trees);
+    write(view.tree_depth, sizeof(int32_t) * view.number_of_trees);
+  }
+
+  void BartEnsembleWriter::close() {
+    if (!out_.is_open()) return;
+    index_offset_ = out_.tellp();
+    write(draw_offsets_.data(), sizeof(int64_t) * draw_offsets_.size());
+    write_header();
+    out_.close();
+    if (!out_) {
+      report_error("Error closing " + filename_ + ".");
+    }
+  }
+
+  //===========================================================================
+  MappedBartEnsemble::MappedBartEnsemble(const std::string &filename)
+      : mapping_(nullptr),
+        mapping_size_(0)
+  {
+#ifdef _WIN32
+    report_error("MappedBartEnsemble is not supported on this platform.");
+#else
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+      report_error("Could not open " + filename + ".");
+    }
+    struct stat file_status;
+    if (::fstat(fd, &file_status) != 0) {
+      ::close(fd);
+      report_error("Could not determine the size of " + filename + ".");
+    }
+    size_t size = file_status.st_size;
+    void *mapping = size > 0
+        ? ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0)
+        : MAP_FAILED;
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+      report_error("Could not memory map " + filename + ".");
+    }
+    mapping_ = mapping;
+    mapping_size_ = size;
+    try {
+      parse(filename);
+    } catch (...) {
+      unmap();
+      throw;
+    }
+#endif
+  }
+
+  MappedBartEnsemble::~MappedBartEnsemble() { unmap(); }
+
+  void MappedBartEnsemble::unmap() {
+#ifndef _WIN32
+    if (mapping_) {
+      ::munmap(mapping_, mapping_size_);
+    }
+#endif
+    mapping_ = nullptr;
+    mapping_size_ = 0;
+    draws_.clear();
+  }
+
+  void MappedBartEnsemble::parse(const std::string &filename) {
+    const char *data = static_cast<const char *>(mapping_);
+    if (mapping_size_ < BartEnsembleFormat::header_size ||
+        std::memcmp(data, magic, sizeof(magic)) != 0) {
+      report_error(filename + " is not a BART ensemble file.");
+    }
+    uint32_t byte_order, version;
+    int64_t number_of_variables, number_of_draws, index_offset;
+    std::memcpy(&byte_order, data + 8, sizeof(byte_order));
+    std::memcpy(&version, data + 12, sizeof(version));
+    std::memcpy(&number_of_variables, data + 16, sizeof(number_of_variables));
+    std::memcpy(&number_of_draws, data + 24, sizeof(number_of_draws));
+    std::memcpy(&index_offset, data + 32, sizeof(index_offset));
+    if (byte_order != BartEnsembleFormat::byte_order_mark) {
+      report_error(filename + " was written on a machine with a different "
+                   "byte order.");
+    }
+    if (version != BartEnsembleFormat::version) {
+      std::ostringstream err;
+      err << filename << " has format version " << version
+          << ".  Only version " << BartEnsembleFormat::version
+          << " is supported.";
+      report_error(err.str());
+    }
+    if (index_offset == 0) {
+      report_error(filename + " was not closed by its writer.");
+    }
+
+    Cursor cursor(data, mapping_size_, BartEnsembleFormat::header_size,
+                  filename);
+    for (int64_t i = 0; i < number_of_variables; ++i) {
+      const int32_t *fields = cursor.next<int32_t>(4);
+      int64_t size = *cursor.next<int64_t>(1);
+      const double *values = cursor.next<double>(size);
+      Bart::SerializedVariableSummary summary;
+      summary.variable_number = fields[0];
+      summary.finalized = fields[1];
+      summary.is_continuous = fields[2];
+      summary.strategy = static_cast<Bart::ContinuousCutpointStrategy>(
+          fields[3]);
+      summary.data = Vector(values, values + size);
+      variable_summaries_.push_back(summary);
+    }
+
+    cursor.seek(index_offset);
+    const int64_t *offsets = cursor.next<int64_t>(number_of_draws);
+    draws_.reserve(number_of_draws);
+    for (int64_t i = 0; i < number_of_draws; ++i) {
+      cursor.seek(offsets[i]);
+      const int64_t *sizes = cursor.next<int64_t>(2);
+      Bart::CompiledForestView draw;
+      draw.number_of_trees = sizes[0];
+      draw.number_of_nodes = sizes[1];
+      draw.cutpoint = cursor.next<double>(draw.number_of_nodes);
+      draw.leaf_value = cursor.next<double>(draw.number_of_nodes);
+      draw.variable = cursor.next<int32_t>(draw.number_of_nodes);
+      draw.left_child = cursor.next<int32_t>(draw.number_of_nodes);
+      draw.tree_start = cursor.next<int32_t>(draw.number_of_trees);
+      draw.tree_depth = cursor.next<int32_t>(draw.number_of_trees);
+      draws_.push_back(draw);
+    }
+  }
+
+  const Bart::CompiledForestView &MappedBartEnsemble::draw(
+      int which_draw) const {
+    if (which_draw < 0 || which_draw >= number_of_draws()) {
+      std::ostringstream err;
+      err << "Draw " << which_draw << " was requested, but the ensemble has "
+          << number_of_draws() << " draws.";
+      report_error(err.str());
+    }
+    return draws_[which_draw];
+  }
+
+  Vector MappedBartEnsemble::predict(const ConstVectorView &x) const {
+    Vector ans(number_of_draws());
+    for (int i = 0; i < number_of_draws(); ++i) {
+      ans[i] = draws_[i].predict(x);
+    }
+    return ans;
+  }
+
+  Matrix MappedBartEnsemble::predict(const ConstSubMatrix &X) const {
+    Matrix ans(number_of_draws(), X.nrow());
+    for (int i = 0; i < number_of_draws(); ++i) {
+      ans.row(i) = draws_[i].predict(X);
+    }
+    return ans;
+  }
+
+}  // namespace BOOM
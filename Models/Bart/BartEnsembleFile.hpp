@@ -0,0 +1,186 @@
+#ifndef BOOM_BART_ENSEMBLE_FILE_HPP_
+#define BOOM_BART_ENSEMBLE_FILE_HPP_
+/*
+  Copyright (C) 2005-2024 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "LinAlg/Matrix.hpp"
+#include "LinAlg/SubMatrix.hpp"
+#include "LinAlg/Vector.hpp"
+#include "LinAlg/VectorView.hpp"
+#include "Models/Bart/Bart.hpp"
+#include "Models/Bart/CompiledForest.hpp"
+
+// A compact binary file holding a posterior sample of BART ensembles.  Each
+// MCMC draw is stored as a CompiledForest, so a scoring process can map the
+// file and predict straight from it, without building any TreeNode objects
+// or parsing the per-tree matrices produced by Tree::to_matrix().
+//
+// Layout (integers in native byte order; the byte_order field detects a
+// mismatch):
+//   Header, 64 bytes:
+//     bytes  0 -  7: magic string "BOOMBART".
+//     bytes  8 - 11: uint32 byte_order = 0x01020304.
+//     bytes 12 - 15: uint32 format version, currently 1.
+//     bytes 16 - 23: int64 number of variables.
+//     bytes 24 - 31: int64 number of draws.
+//     bytes 32 - 39: int64 offset of the draw index.
+//     bytes 40 - 63: reserved, zero.
+//   One record per variable, holding a SerializedVariableSummary:
+//     int32 variable_number, int32 finalized, int32 is_continuous,
+//     int32 strategy, int64 size of data, double data[size].
+//   One block per draw, holding a CompiledForest with T trees and N nodes:
+//     int64 T, int64 N, double cutpoint[N], double leaf_value[N],
+//     int32 variable[N], int32 left_child[N], int32 tree_start[T],
+//     int32 tree_depth[T].
+//   The draw index: int64 offset of each draw block.
+//
+// Every record is a multiple of 8 bytes long, so the arrays are aligned and
+// can be used in place.
+namespace BOOM {
+  namespace BartEnsembleFormat {
+    constexpr int header_size = 64;
+    constexpr uint32_t byte_order_mark = 0x01020304;
+    constexpr uint32_t version = 1;
+  }  // namespace BartEnsembleFormat
+
+  //===========================================================================
+  // Writes a posterior sample of BART ensembles one MCMC draw at a time.
+  //
+  // Usage:
+  //   BartEnsembleWriter writer("bart.bin", *model);
+  //   for (int i = 0; i < niter; ++i) {
+  //     model->sample_posterior();
+  //     writer.add_draw(*model);
+  //   }
+  //   writer.close();
+  class BartEnsembleWriter {
+   public:
+    // Args:
+    //   filename:  The name of the file to be (over)written.
+    //   model: The model whose draws will be written.  Its variable
+    //     summaries are recorded in the file.
+    BartEnsembleWriter(const std::string &filename,
+                       const BartModelBase &model);
+
+    // Args:
+    //   filename:  The name of the file to be (over)written.
+    //   variable_summaries: The variable summaries to record in the file,
+    //     one per predictor variable.
+    BartEnsembleWriter(
+        const std::string &filename,
+        const std::vector<Bart::SerializedVariableSummary> &variable_summaries);
+
+    BartEnsembleWriter(const BartEnsembleWriter &rhs) = delete;
+    BartEnsembleWriter &operator=(const BartEnsembleWriter &rhs) = delete;
+
+    // Closes the file if close() has not already been called.
+    ~BartEnsembleWriter();
+
+    // Append the current trees in 'model' as the next draw.
+    void add_draw(const BartModelBase &model);
+
+    // Append 'forest' as the next draw.
+    void add_draw(const Bart::CompiledForest &forest);
+
+    int64_t number_of_draws() const { return draw_offsets_.size(); }
+
+    // Write the draw index, record the number of draws in the header, and
+    // close the file.  Any further calls to add_draw are an error.
+    void close();
+
+   private:
+    void write_header();
+    void write(const void *data, size_t bytes);
+
+    std::string filename_;
+    std::ofstream out_;
+    int64_t number_of_variables_;
+    int64_t index_offset_;
+    std::vector<int64_t> draw_offsets_;
+  };
+
+  //===========================================================================
+  // A read-only, memory mapped view of a BART ensemble file.  The operating
+  // system pages the trees in as they are used, and opening the file costs
+  // time proportional to the number of variables and draws, not the number
+  // of nodes.  Views returned by this object are valid for the lifetime of
+  // the object.
+  //
+  // Only the sizes of the blocks are checked when the file is opened.  The
+  // node arrays are trusted, so the file should come from a
+  // BartEnsembleWriter.
+  class MappedBartEnsemble {
+   public:
+    // Map the named file.  An error is reported if the file does not exist,
+    // is not a BART ensemble file, or if memory mapping is not supported on
+    // the current platform.
+    explicit MappedBartEnsemble(const std::string &filename);
+    MappedBartEnsemble(const MappedBartEnsemble &rhs) = delete;
+    MappedBartEnsemble &operator=(const MappedBartEnsemble &rhs) = delete;
+    ~MappedBartEnsemble();
+
+    int number_of_draws() const { return draws_.size(); }
+    int number_of_variables() const { return variable_summaries_.size(); }
+
+    // The variable summaries recorded by the writer.  These can be passed
+    // to BartModelBase::set_variable_summaries.
+    const std::vector<Bart::SerializedVariableSummary> &variable_summaries()
+        const {
+      return variable_summaries_;
+    }
+
+    // The forest from the MCMC draw with the given index.
+    const Bart::CompiledForestView &draw(int which_draw) const;
+
+    // The sum of trees prediction for 'x' under each MCMC draw.
+    Vector predict(const ConstVectorView &x) const;
+    Vector predict(const Vector &x) const {
+      return predict(ConstVectorView(x));
+    }
+    Vector predict(const VectorView &x) const {
+      return predict(ConstVectorView(x));
+    }
+
+    // Sum of trees predictions for the rows of X.
+    //
+    // Returns:
+    //   A matrix with one row per MCMC draw and one column per row of X.
+    Matrix predict(const ConstSubMatrix &X) const;
+    Matrix predict(const Matrix &X) const {
+      return predict(ConstSubMatrix(X));
+    }
+
+   private:
+    void unmap();
+
+    // Parse the contents of the mapping.
+    void parse(const std::string &filename);
+
+    void *mapping_;
+    size_t mapping_size_;
+    std::vector<Bart::SerializedVariableSummary> variable_summaries_;
+    std::vector<Bart::CompiledForestView> draws_;
+  };
+
+}  // namespace BOOM
+
+#endif  // BOOM_BART_ENSEMBLE_FILE_HPP_
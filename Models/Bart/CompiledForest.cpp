@@ -0,0 +1,154 @@
+/*
+  Copyright (C) 2005-2024 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include "Models/Bart/CompiledForest.hpp"
+#include <algorithm>
+#include <utility>
+#include "Models/Bart/Bart.hpp"
+#include "cpputil/report_error.hpp"
+
+namespace BOOM {
+  namespace Bart {
+
+    namespace {
+      // The number of rows that descend a tree together in
+      // CompiledForest::predict(const ConstSubMatrix &).
+      const int row_block_size = 64;
+    }  // namespace
+
+    CompiledForest::CompiledForest() {}
+
+    CompiledForest::CompiledForest(const BartModelBase &model) {
+      for (int i = 0; i < model.number_of_trees(); ++i) {
+        add_tree(*model.tree(i));
+      }
+    }
+
+    void CompiledForest::add_tree(const Tree &tree) {
+      compile(tree.root());
+    }
+
+    //----------------------------------------------------------------------
+    void CompiledForest::compile(const TreeNode *root) {
+      int start = variable_.size();
+      tree_start_.push_back(start);
+
+      // A breadth-first traversal, with each node paired with its depth.
+      // Nodes are appended to the arrays in the order they are visited, so
+      // the position of a node is 'start' plus its place in the queue.
+      std::vector<std::pair<const TreeNode *, int>> queue;
+      queue.push_back(std::make_pair(root, 0));
+      int max_depth = 0;
+      for (size_t i = 0; i < queue.size(); ++i) {
+        const TreeNode *node = queue[i].first;
+        int depth = queue[i].second;
+        max_depth = std::max(max_depth, depth);
+        int position = start + i;
+        if (node->is_leaf()) {
+          variable_.push_back(0);
+          cutpoint_.push_back(0.0);
+          left_child_.push_back(position);
+          leaf_value_.push_back(node->mean());
+        } else {
+          variable_.push_back(node->variable_index());
+          cutpoint_.push_back(node->cutpoint());
+          left_child_.push_back(start + queue.size());
+          leaf_value_.push_back(0.0);
+          queue.push_back(std::make_pair(node->left_child(), depth + 1));
+          queue.push_back(std::make_pair(node->right_child(), depth + 1));
+        }
+      }
+      tree_depth_.push_back(max_depth);
+    }
+
+    //----------------------------------------------------------------------
+    CompiledForestView CompiledForest::view() const {
+      CompiledForestView ans;
+      ans.number_of_trees = tree_start_.size();
+      ans.number_of_nodes = variable_.size();
+      ans.variable = variable_.data();
+      ans.cutpoint = cutpoint_.data();
+      ans.left_child = left_child_.data();
+      ans.leaf_value = leaf_value_.data();
+      ans.tree_start = tree_start_.data();
+      ans.tree_depth = tree_depth_.data();
+      return ans;
+    }
+
+    //----------------------------------------------------------------------
+    double CompiledForestView::predict(const ConstVectorView &x) const {
+      double ans = 0;
+      for (int tree = 0; tree < number_of_trees; ++tree) {
+        int node = tree_start[tree];
+        while (left_child[node] != node) {
+          node = left_child[node] + !(x[variable[node]] <= cutpoint[node]);
+        }
+        ans += leaf_value[node];
+      }
+      return ans;
+    }
+
+    //----------------------------------------------------------------------
+    Vector CompiledForestView::predict(const ConstSubMatrix &X) const {
+      int nrow = X.nrow();
+      Vector ans(nrow, 0.0);
+      if (nrow == 0 || number_of_trees == 0) {
+        return ans;
+      }
+      int max_variable = *std::max_element(variable, variable + number_of_nodes);
+      if (max_variable >= X.ncol()) {
+        report_error("The predictor matrix has too few columns for the "
+                     "variables used by the trees.");
+      }
+
+      // Pointers to the start of each column of X, so the inner loop needs
+      // only the row offset.
+      std::vector<const double *> columns(X.ncol());
+      for (int j = 0; j < X.ncol(); ++j) {
+        columns[j] = X.col(j).data();
+      }
+
+      int node[row_block_size];
+      for (int block_start = 0; block_start < nrow;
+           block_start += row_block_size) {
+        int block_size = std::min(row_block_size, nrow - block_start);
+        double *result = ans.data() + block_start;
+        for (int tree = 0; tree < number_of_trees; ++tree) {
+          std::fill(node, node + block_size, tree_start[tree]);
+          // Every row reaches its leaf after tree_depth steps.  Rows that
+          // arrive early stay put, because a leaf is its own left child and
+          // the right step is masked off.
+          for (int step = 0; step < tree_depth[tree]; ++step) {
+            for (int i = 0; i < block_size; ++i) {
+              int current = node[i];
+              int child = left_child[current];
+              double x = columns[variable[current]][block_start + i];
+              int go_right = !(x <= cutpoint[current]);
+              node[i] = child + ((child != current) & go_right);
+            }
+          }
+          for (int i = 0; i < block_size; ++i) {
+            result[i] += leaf_value[node[i]];
+          }
+        }
+      }
+      return ans;
+    }
+
+  }  // namespace Bart
+}  // namespace BOOM
@@ -0,0 +1,142 @@
+#ifndef BOOM_BART_COMPILED_FOREST_HPP_
+#define BOOM_BART_COMPILED_FOREST_HPP_
+/*
+  Copyright (C) 2005-2024 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include <vector>
+#include "LinAlg/Matrix.hpp"
+#include "LinAlg/SubMatrix.hpp"
+#include "LinAlg/Vector.hpp"
+#include "LinAlg/VectorView.hpp"
+
+namespace BOOM {
+  class BartModelBase;
+
+  namespace Bart {
+    class Tree;
+    class TreeNode;
+
+    // Non-owning pointers to the flat arrays that describe a compiled
+    // forest.  A view can point into a CompiledForest (see
+    // CompiledForest::view) or into a memory mapped file (see
+    // MappedBartEnsemble), so the same prediction code serves both.  The
+    // meanings of the arrays are documented in CompiledForest.
+    struct CompiledForestView {
+      int number_of_trees;
+      int number_of_nodes;
+      const int *variable;
+      const double *cutpoint;
+      const int *left_child;
+      const double *leaf_value;
+      const int *tree_start;
+      const int *tree_depth;
+
+      // See CompiledForest::predict.
+      double predict(const ConstVectorView &x) const;
+      Vector predict(const ConstSubMatrix &X) const;
+    };
+
+    // A read-only snapshot of a sum of trees, laid out for fast prediction.
+    // A Tree is a set of individually allocated TreeNodes that carry data
+    // pointers and sufficient statistics, which is what the MCMC moves need,
+    // but walking one means chasing a pointer at every level.  A
+    // CompiledForest stores every node of every tree in a few flat arrays.
+    // Each tree occupies a contiguous block in breadth-first order, and the
+    // two children of an interior node are adjacent, so a node needs only
+    // the position of its left child.
+    //
+    // A CompiledForest does not track later changes to the trees it was
+    // built from.  Build a new one after each MCMC draw you want to score.
+    class CompiledForest {
+     public:
+      // An empty forest, which predicts zero.
+      CompiledForest();
+
+      // Compile all the trees in 'model'.
+      explicit CompiledForest(const BartModelBase &model);
+
+      // Append 'tree' to the forest.
+      void add_tree(const Tree &tree);
+
+      int number_of_trees() const { return tree_start_.size(); }
+      int number_of_nodes() const { return variable_.size(); }
+
+      // A view of the forest's arrays, valid until the next call to
+      // add_tree.
+      CompiledForestView view() const;
+
+      // The sum of the tree predictions for a single predictor vector.  This
+      // matches BartModelBase::predict.
+      double predict(const ConstVectorView &x) const {
+        return view().predict(x);
+      }
+      double predict(const Vector &x) const {
+        return predict(ConstVectorView(x));
+      }
+      double predict(const VectorView &x) const {
+        return predict(ConstVectorView(x));
+      }
+
+      // Predictions for each row of a design matrix.  The trees are applied
+      // one at a time to blocks of rows, so the nodes of the current tree
+      // stay in cache while the rows stream past.  Within a block all rows
+      // descend the tree in lock step with no data-dependent branches, which
+      // lets the compiler vectorize across rows.
+      //
+      // Args:
+      //   X:  A matrix with one row per observation.
+      //
+      // Returns:
+      //   A vector with element i containing the prediction for row i of X.
+      Vector predict(const ConstSubMatrix &X) const {
+        return view().predict(X);
+      }
+      Vector predict(const Matrix &X) const {
+        return predict(ConstSubMatrix(X));
+      }
+
+     private:
+      // Add the nodes of the tree rooted at 'root' in breadth-first order.
+      void compile(const TreeNode *root);
+
+      // The index of the variable used to split each node.  Zero for leaves,
+      // so that lock step traversal can read a valid element of x.
+      std::vector<int> variable_;
+
+      // The cutpoint for interior nodes.  Observations with
+      // x[variable] <= cutpoint go to the left child.
+      std::vector<double> cutpoint_;
+
+      // The position of the left child of each node.  The right child is
+      // next to it.  A leaf is its own left child, which lets a traversal
+      // take a fixed number of steps.
+      std::vector<int> left_child_;
+
+      // The mean parameter at each leaf, and zero at interior nodes.
+      std::vector<double> leaf_value_;
+
+      // For each tree, the position of its root and the depth of its deepest
+      // leaf.
+      std::vector<int> tree_start_;
+      std::vector<int> tree_depth_;
+    };
+
+  }  // namespace Bart
+}  // namespace BOOM
+
+#endif  // BOOM_BART_COMPILED_FOREST_HPP_
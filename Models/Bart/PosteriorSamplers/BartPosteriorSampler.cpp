@@ -18,6 +18,8 @@
 */
 
 #include "Models/Bart/PosteriorSamplers/BartPosteriorSampler.hpp"
+#include <algorithm>
+#include <memory>
 #include "LinAlg/Selector.hpp"
 #include "Models/Bart/ResidualRegressionData.hpp"
 #include "Samplers/ScalarSliceSampler.hpp"
@@ -240,6 +242,7 @@ namespace BOOM {
   using Bart::Tree;
   using Bart::TreeNode;
   using Bart::VariableSummary;
+  using Bart::SufficientStatisticsBase;
 
   //----------------------------------------------------------------------
   BartPosteriorSamplerBase::BartPosteriorSamplerBase(
@@ -253,7 +256,8 @@ namespace BOOM {
         prior_tree_depth_alpha_(prior_tree_depth_alpha),
         prior_tree_depth_beta_(prior_tree_depth_beta),
         total_prediction_variance_(square(total_prediction_sd)),
-        log_prior_number_of_trees_(log_prior_number_of_trees) {
+        log_prior_number_of_trees_(log_prior_number_of_trees),
+        use_histograms_(false) {
     if (prior_tree_depth_alpha <= 0 || prior_tree_depth_alpha >= 1) {
       report_error(
           "The prior_tree_depth_alpha parameter "
@@ -320,28 +324,72 @@ namespace BOOM {
     tree_birth_move();
   }
 
+  //----------------------------------------------------------------------
+  void BartPosteriorSamplerBase::write_checkpoint(
+      CheckpointWriter &out) const {
+    out.begin_section("BartPosteriorSampler");
+    PosteriorSampler::write_checkpoint(out);
+    MH_accounting_.write_checkpoint(out);
+  }
+
+  void BartPosteriorSamplerBase::read_checkpoint(CheckpointReader &in) {
+    in.expect_section("BartPosteriorSampler");
+    PosteriorSampler::read_checkpoint(in);
+    MH_accounting_.read_checkpoint(in);
+    // The trees are about to be replaced, so force check_residuals() to
+    // rebuild the residuals from scratch.
+    clear_data_from_trees();
+    clear_residuals();
+  }
+
   //----------------------------------------------------------------------
   double BartPosteriorSamplerBase::subtree_log_integrated_likelihood(
       Bart::TreeNode *node) const {
     if (node->is_leaf()) {
-      return log_integrated_likelihood(node->compute_suf());
+      return log_integrated_likelihood(compute_suf(node));
     } else {
       return subtree_log_integrated_likelihood(node->left_child()) +
              subtree_log_integrated_likelihood(node->right_child());
     }
   }
 
+  //----------------------------------------------------------------------
+  void BartPosteriorSamplerBase::impute_in_shards(
+      int sample_size,
+      const std::function<void(int, int, RNG &)> &impute_shard) {
+    // Latent data imputation costs a few random draws per observation,
+    // so shards need to be large to repay the cost of dispatching them.
+    const int shard_size = 10000;
+    int number_of_shards = (sample_size + shard_size - 1) / shard_size;
+    RNG::RngIntType seed = seed_rng(rng());
+    auto run_shard = [&](int shard) {
+      RNG shard_rng(seed, shard);
+      int begin = shard * shard_size;
+      int end = std::min<int>(begin + shard_size, sample_size);
+      impute_shard(begin, end, shard_rng);
+    };
+    if (pool_.no_threads()) {
+      for (int shard = 0; shard < number_of_shards; ++shard) {
+        run_shard(shard);
+      }
+    } else {
+      pool_.parallel_for(0, number_of_shards, 1, run_shard);
+    }
+  }
+
   //----------------------------------------------------------------------
   // It should only be necessary to call check_residuals once.
   void BartPosteriorSamplerBase::check_residuals() {
     if (residual_size() != model_->sample_size()) {
       clear_residuals();
       clear_data_from_trees();
+      std::vector<Bart::ResidualRegressionData *> data;
+      data.reserve(model_->sample_size());
       for (int i = 0; i < model_->sample_size(); ++i) {
-        Bart::ResidualRegressionData *data = create_and_store_residual(i);
-        for (int j = 0; j < model_->number_of_trees(); ++j) {
-          model_->tree(j)->populate_data(data);
-        }
+        data.push_back(create_and_store_residual(i));
+      }
+      for (int j = 0; j < model_->number_of_trees(); ++j) {
+        model_->tree(j)->populate_data(data);
       }
       for (int i = 0; i < model_->number_of_trees(); ++i) {
         model_->tree(i)->populate_sufficient_statistics(create_suf());
@@ -351,14 +399,17 @@ namespace BOOM {
 
   //----------------------------------------------------------------------
   void BartPosteriorSamplerBase::fill_tree_with_residual_data(Tree *tree) {
+    std::vector<Bart::ResidualRegressionData *> data;
+    data.reserve(residual_size());
     for (int i = 0; i < residual_size(); ++i) {
-      tree->populate_data(residual(i));
+      data.push_back(residual(i));
     }
+    tree->populate_data(data);
   }
 
   //----------------------------------------------------------------------
   void BartPosteriorSamplerBase::modify_tree(Tree *tree) {
-    tree->remove_mean_effect();
+    tree->remove_mean_effect(&pool_);
     modify_tree_structure(tree);
     draw_terminal_means_and_adjust_residuals(tree);
   }
@@ -473,7 +524,7 @@ namespace BOOM {
 
     double log_likelihood_ratio =
         subtree_log_integrated_likelihood(branch_root) -
-        log_integrated_likelihood(branch_root->compute_suf());
+        log_integrated_likelihood(compute_suf(branch_root));
 
     int depth = branch_root->depth();
     double log_prior_ratio = -log_probability_of_no_split(depth);
@@ -639,9 +690,9 @@ namespace BOOM {
     int depth = leaf->depth();
 
     double log_likelihood_ratio =
-        log_integrated_likelihood(leaf->left_child()->compute_suf()) +
-        log_integrated_likelihood(leaf->right_child()->compute_suf()) -
-        log_integrated_likelihood(leaf->compute_suf());
+        log_integrated_likelihood(compute_suf(leaf->left_child())) +
+        log_integrated_likelihood(compute_suf(leaf->right_child())) -
+        log_integrated_likelihood(compute_suf(leaf));
 
     // The prior_ratio omits a factor of p(variable, cutpoint) that
     // cancels with the transition distribution.
@@ -814,6 +865,11 @@ namespace BOOM {
       // There is only one choice.  We need to stay where we are.
       return;
     }
+    if (use_histograms_ && node->has_no_grandchildren() &&
+        slice_sample_discrete_cutpoint_from_histogram(
+            node, potential_cutpoint_values)) {
+      return;
+    }
 
     double logf_slice =
         subtree_log_integrated_likelihood(node) - rexp_mt(rng(), 1.0);
@@ -840,6 +896,105 @@ namespace BOOM {
     }
   }
 
+  namespace {
+    // Sufficient statistics for the data at a node, binned by the value
+    // of one variable relative to a sorted vector of cutpoints.  Bin k
+    // holds the observations with cutpoints[k-1] < x <= cutpoints[k],
+    // and the last bin holds those above the largest cutpoint.  The
+    // statistics for either side of a split at cutpoints[k] are cumulative
+    // sums of the bins, formed once when the histogram is built.  The
+    // right side is a sum of the later bins, rather than the total minus
+    // the left side, so no precision is lost to cancellation.
+    class CutpointHistogram {
+     public:
+      CutpointHistogram(const std::vector<ResidualRegressionData *> &data,
+                        int variable, const Vector &cutpoints,
+                        const SufficientStatisticsBase &prototype) {
+        int number_of_cutpoints = cutpoints.size();
+        std::vector<std::unique_ptr<SufficientStatisticsBase>> bins;
+        for (int k = 0; k <= number_of_cutpoints; ++k) {
+          bins.emplace_back(prototype.create());
+        }
+        for (ResidualRegressionData *dp : data) {
+          double x = dp->x()[variable];
+          int bin = std::lower_bound(cutpoints.begin(), cutpoints.end(), x) -
+                    cutpoints.begin();
+          bins[bin]->update(*dp);
+        }
+
+        left_.resize(number_of_cutpoints);
+        right_.resize(number_of_cutpoints);
+        left_[0].reset(bins[0]->clone());
+        for (int k = 1; k < number_of_cutpoints; ++k) {
+          left_[k].reset(left_[k - 1]->clone());
+          left_[k]->combine(*bins[k]);
+        }
+        right_.back().reset(bins.back()->clone());
+        for (int k = number_of_cutpoints - 2; k >= 0; --k) {
+          right_[k].reset(right_[k + 1]->clone());
+          right_[k]->combine(*bins[k + 1]);
+        }
+      }
+
+      // Sufficient statistics for the data with x <= cutpoints[k].
+      const SufficientStatisticsBase &left(int k) const { return *left_[k]; }
+
+      // Sufficient statistics for the data with x > cutpoints[k].
+      const SufficientStatisticsBase &right(int k) const {
+        return *right_[k];
+      }
+
+     private:
+      std::vector<std::unique_ptr<SufficientStatisticsBase>> left_;
+      std::vector<std::unique_ptr<SufficientStatisticsBase>> right_;
+    };
+  }  // namespace
+
+  bool BartPosteriorSamplerBase::slice_sample_discrete_cutpoint_from_histogram(
+      TreeNode *node, const Vector &potential_cutpoint_values) {
+    Vector::const_iterator it =
+        std::lower_bound(potential_cutpoint_values.begin(),
+                         potential_cutpoint_values.end(), node->cutpoint());
+    if (it == potential_cutpoint_values.end() || *it != node->cutpoint()) {
+      return false;
+    }
+    int current_position = it - potential_cutpoint_values.begin();
+    int variable = node->variable_index();
+    std::unique_ptr<SufficientStatisticsBase> prototype(create_suf());
+    CutpointHistogram histogram(node->data(), variable,
+                                potential_cutpoint_values, *prototype);
+    auto log_likelihood = [this, &histogram](int k) {
+      return log_integrated_likelihood(histogram.left(k)) +
+             log_integrated_likelihood(histogram.right(k));
+    };
+
+    // The remainder mirrors slice_sample_discrete_cutpoint.
+    double logf_slice =
+        log_likelihood(current_position) - rexp_mt(rng(), 1.0);
+    Selector possible_cutpoint_positions(potential_cutpoint_values.size(),
+                                         true);
+    double logp = logf_slice - 1;
+    int pos = current_position;
+    while (logp < logf_slice && possible_cutpoint_positions.nvars() > 0) {
+      pos = possible_cutpoint_positions.random_included_position(rng());
+      if (pos < 0) {
+        report_error(
+            "Something went wrong when sampling cutpoints in "
+            "'slice_sample_discrete_cutpoint_from_histogram'");
+      }
+      logp = log_likelihood(pos);
+      possible_cutpoint_positions.drop(pos);
+    }
+    if (logp < logf_slice && possible_cutpoint_positions.nvars() == 0) {
+      report_error(
+          "Ran out of choices for cutpoints when slice sampling "
+          "a discrete variable.");
+    }
+    node->set_variable_and_cutpoint(variable, potential_cutpoint_values[pos]);
+    node->refresh_subtree_data();
+    return true;
+  }
+
   //----------------------------------------------------------------------
   void BartPosteriorSamplerBase::draw_terminal_means_and_adjust_residuals(
       Bart::Tree *tree) {
@@ -848,7 +1003,7 @@ namespace BOOM {
       Bart::TreeNode *leaf = *it;
       double mean = draw_mean(leaf);
       leaf->set_mean(mean);
-      leaf->replace_mean_effect();
+      leaf->replace_mean_effect(&pool_);
     }
   }
 
@@ -1001,13 +1156,13 @@ namespace BOOM {
     double proposal_loglike = 0;
     for (Bart::Tree::ConstNodeSetIterator it = proposal->leaf_begin();
          it != proposal->leaf_end(); ++it) {
-      proposal_loglike += log_integrated_likelihood((*it)->compute_suf());
+      proposal_loglike += log_integrated_likelihood(compute_suf(*it));
     }
 
     // Any root will do here, since they all start with the same set
     // of data.
     double current_loglike =
-        complete_data_log_likelihood(proposal->root()->compute_suf());
+        complete_data_log_likelihood(compute_suf(proposal->root()));
 
     double log_numerator = proposal_loglike + proposal_log_prior -
                            log_proposal_transition_probability;
@@ -1134,11 +1289,11 @@ namespace BOOM {
     // current model.
 
     double current_loglike =
-        complete_data_log_likelihood(stump->root()->compute_suf());
+        complete_data_log_likelihood(compute_suf(stump->root()));
 
-    stump->remove_mean_effect();
+    stump->remove_mean_effect(&pool_);
     double proposal_loglike =
-        complete_data_log_likelihood(stump->root()->compute_suf());
+        complete_data_log_likelihood(compute_suf(stump->root()));
 
     double log_numerator = proposal_loglike + proposal_log_prior -
                            log_proposal_transition_probability;
@@ -1150,7 +1305,7 @@ namespace BOOM {
     if (log(runif_mt(rng())) < log_acceptance_probability) {
       model_->remove_tree(stump);
     } else {
-      stump->replace_mean_effect();
+      stump->replace_mean_effect(&pool_);
     }
   }
 
@@ -24,6 +24,7 @@
 #include "Models/GaussianModel.hpp"
 #include "Models/PosteriorSamplers/PosteriorSampler.hpp"
 #include "Samplers/MoveAccounting.hpp"
+#include "cpputil/ThreadTools.hpp"
 #include "cpputil/math_utils.hpp"
 
 namespace BOOM {
@@ -127,6 +128,30 @@ namespace BOOM {
     // enum.
     void set_move_probabilities(const Vector &move_probs);
 
+    // Trees are visited one at a time, but the work each tree does
+    // with its data (computing node sufficient statistics and
+    // adjusting residuals) is split into shards that run on this
+    // many threads from the global thread pool.  Only nodes with
+    // many observations are sharded.  Imputation of latent data in
+    // the logit, probit, and Poisson samplers is sharded the same
+    // way (see impute_in_shards).  The default is 0, which does all
+    // the work in the calling thread.
+    void set_number_of_threads(int number_of_threads) {
+      pool_.set_number_of_threads(number_of_threads);
+    }
+
+    // If true, then slice sampling the cutpoint of a discrete variable
+    // at a node whose children are both leaves summarizes the node's
+    // data with one pass into a histogram over the candidate
+    // cutpoints.  The children's sufficient statistics for each
+    // candidate are then sums of histogram bins, so each candidate
+    // costs O(number of cutpoints) instead of O(number of
+    // observations).  This is most useful with variables binned by
+    // the DISCRETE_QUANTILES strategy.  The default is false.
+    void set_use_histograms(bool use_histograms) {
+      use_histograms_ = use_histograms;
+    }
+
     // I implemented a skeleton version of logpri() to get this class
     // to compile.  It does not return anything useful, and will throw
     // an exception if called.
@@ -137,6 +162,15 @@ namespace BOOM {
     // calls to modify tree.
     void draw() override;
 
+    // In addition to the RNG, the checkpoint holds the move accounting.
+    // The residuals are rebuilt from the restored trees on the next call
+    // to draw(), so the continuation after a restore is a valid draw from
+    // the same chain, but may differ from the original run in the last few
+    // bits of the residuals (and in any latent data that families such as
+    // the probit and logit re-impute).
+    void write_checkpoint(CheckpointWriter &out) const override;
+    void read_checkpoint(CheckpointReader &in) override;
+
     // Returns a draw of the mean parameter for the given leaf,
     // conditional on the tree structure and the data assigned to
     // leaf.  This differs slightly across the exponential family
@@ -234,6 +268,18 @@ namespace BOOM {
     void slice_sample_continuous_cutpoint(Bart::TreeNode *node);
     void slice_sample_discrete_cutpoint(Bart::TreeNode *node);
 
+    // The histogram version of slice_sample_discrete_cutpoint.  Returns
+    // false, without changing anything, if the node's current cutpoint
+    // is not among potential_cutpoint_values.
+    //
+    // Args:
+    //   node: A node with no grandchildren that splits on a discrete
+    //     variable.
+    //   potential_cutpoint_values: The sorted set of legal cutpoints
+    //     for the node.
+    bool slice_sample_discrete_cutpoint_from_histogram(
+        Bart::TreeNode *node, const Vector &potential_cutpoint_values);
+
     // Conditional on the tree structure and sigma, sample the mean
     // parameters at the leaves.
     void draw_terminal_means_and_adjust_residuals(Bart::Tree *tree);
@@ -288,6 +334,24 @@ namespace BOOM {
     // model_.
     void clear_data_from_trees();
 
+    // Calls impute_shard(begin, end, rng) for consecutive ranges of
+    // observations [begin, end) covering [0, sample_size), running the
+    // shards on the thread pool.  Each shard is given its own RNG
+    // stream, seeded from rng().  The shards depend only on
+    // sample_size, so the draws do not depend on the number of
+    // threads.  impute_shard must only modify the observations in its
+    // range.
+    void impute_in_shards(
+        int sample_size,
+        const std::function<void(int begin, int end, RNG &rng)> &impute_shard);
+
+    // Recompute and return the sufficient statistics for 'node',
+    // using the thread pool if the node has enough data.
+    const Bart::SufficientStatisticsBase &compute_suf(
+        Bart::TreeNode *node) const {
+      return node->compute_suf(&pool_);
+    }
+
     //----------------------------------------------------------------------
     // Compute the log of the Metropolis-Hastings ratio for the split
     // move.  The log ratio for the prune_split move is -1 times this
@@ -334,6 +398,12 @@ namespace BOOM {
     // The vector of move_probabilities_ must be the same length as
     // the number of elements in the MoveType enum.
     Vector move_probabilities_;
+
+    // Shards the per-node data work.  See set_number_of_threads.
+    mutable SharedThreadPool pool_;
+
+    // See set_use_histograms.
+    bool use_histograms_;
   };
 
 }  // namespace BOOM
@@ -19,6 +19,7 @@
 
 #include "Models/Bart/PosteriorSamplers/GaussianBartPosteriorSampler.hpp"
 #include "cpputil/math_utils.hpp"
+#include "cpputil/report_error.hpp"
 #include "distributions.hpp"
 
 namespace BOOM {
@@ -35,6 +36,17 @@ namespace BOOM {
       suf.update(*this);
     }
 
+    void GaussianBartSufficientStatistics::combine(
+        const SufficientStatisticsBase &rhs) {
+      const GaussianBartSufficientStatistics *other =
+          dynamic_cast<const GaussianBartSufficientStatistics *>(&rhs);
+      if (!other) {
+        report_error("GaussianBartSufficientStatistics can only be combined "
+                     "with another object of the same type.");
+      }
+      suf_.combine(other->suf_);
+    }
+
   }  // namespace Bart
 
   const double GaussianBartPosteriorSampler::log_2_pi(1.83787706640935);
@@ -61,7 +73,7 @@ namespace BOOM {
     double sigsq = model_->sigsq();
     const Bart::GaussianBartSufficientStatistics &suf(
         dynamic_cast<const Bart::GaussianBartSufficientStatistics &>(
-            leaf->compute_suf()));
+            compute_suf(leaf)));
     double ivar = suf.n() / sigsq + 1.0 / mean_prior_variance();
     double mean = (suf.sum() / sigsq) / ivar;
     double sd = sqrt(1.0 / ivar);
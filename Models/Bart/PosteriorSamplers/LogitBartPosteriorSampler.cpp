@@ -74,6 +74,19 @@ namespace BOOM {
       data.add_to_logit_suf(*this);
     }
 
+    void LogitSufficientStatistics::combine(const SufficientStatisticsBase &rhs) {
+      const LogitSufficientStatistics *other = dynamic_cast<const LogitSufficientStatistics *>(&rhs);
+      if (!other) {
+        report_error("LogitSufficientStatistics can only be combined with another object of the "
+                     "same type.");
+      }
+      sum_of_information_ += other->sum_of_information_;
+      information_weighted_sum_ += other->information_weighted_sum_;
+      information_weighted_prediction_ += other->information_weighted_prediction_;
+      information_weighted_sum_of_observation_times_prediction_ += other->information_weighted_sum_of_observation_times_prediction_;
+      information_weighted_sum_of_squared_predictions_ += other->information_weighted_sum_of_squared_predictions_;
+    }
+
     void LogitSufficientStatistics::update(const LogitResidualData &data) {
       double info = data.sum_of_information();
       double pred = data.prediction();
@@ -147,7 +160,7 @@ namespace BOOM {
   double LogitBartPosteriorSampler::draw_mean(Bart::TreeNode *leaf) {
     const Bart::LogitSufficientStatistics &suf(
         dynamic_cast<const Bart::LogitSufficientStatistics &>(
-            leaf->compute_suf()));
+            compute_suf(leaf)));
     double prior_variance = mean_prior_variance();
     double ivar = (1.0 / prior_variance) + suf.sum_of_information();
     double posterior_mean = suf.information_weighted_residual_sum() / ivar;
@@ -329,13 +342,16 @@ namespace BOOM {
 
   //----------------------------------------------------------------------
   void LogitBartPosteriorSampler::impute_latent_data() {
-    for (int i = 0; i < residuals_.size(); ++i) {
-      impute_latent_data_point(residuals_[i].get());
-    }
+    impute_in_shards(residuals_.size(), [this](int begin, int end, RNG &rng) {
+      for (int i = begin; i < end; ++i) {
+        impute_latent_data_point(residuals_[i].get(), rng);
+      }
+    });
   }
 
   //----------------------------------------------------------------------
-  void LogitBartPosteriorSampler::impute_latent_data_point(DataType *data) {
+  void LogitBartPosteriorSampler::impute_latent_data_point(DataType *data,
+                                                           RNG &rng) {
     double eta = data->prediction();
 
 #ifndef NDEBUG
@@ -346,7 +362,7 @@ namespace BOOM {
 #endif
 
     std::pair<double, double> latent_data =
-        data_imputer_->impute(rng(), data->n(), data->y(), eta);
+        data_imputer_->impute(rng, data->n(), data->y(), eta);
     double information_weighted_sum_of_latent_logits = latent_data.first;
     double information = latent_data.second;
     data->set_latent_data(information_weighted_sum_of_latent_logits,
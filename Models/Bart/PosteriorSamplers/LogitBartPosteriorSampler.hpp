@@ -99,6 +99,7 @@ namespace BOOM {
       void clear() override;
       void update(const ResidualRegressionData &abstract_data) override;
       virtual void update(const LogitResidualData &data);
+      void combine(const SufficientStatisticsBase &rhs) override;
 
       double sum_of_information() const;
       double information_weighted_sum() const;
@@ -153,8 +154,10 @@ namespace BOOM {
     Bart::LogitResidualData *residual(int i) override;
     Bart::LogitSufficientStatistics *create_suf() const override;
 
+    // Impute the latent logits for each observation, in shards on the
+    // thread pool.  See impute_in_shards.
     void impute_latent_data();
-    void impute_latent_data_point(DataType *data);
+    void impute_latent_data_point(DataType *data, RNG &rng);
 
    private:
     LogitBartModel *model_;
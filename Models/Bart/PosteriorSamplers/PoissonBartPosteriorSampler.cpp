@@ -20,6 +20,7 @@
 #include "Models/Bart/PosteriorSamplers/PoissonBartPosteriorSampler.hpp"
 #include "Models/Glm/PosteriorSamplers/poisson_mixture_approximation_table.hpp"
 #include "cpputil/math_utils.hpp"
+#include "cpputil/report_error.hpp"
 #include "distributions.hpp"
 
 namespace BOOM {
@@ -105,6 +106,18 @@ namespace BOOM {
       data.add_to_poisson_suf(*this);
     }
 
+    //----------------------------------------------------------------------
+    void PoissonSufficientStatistics::combine(const SufficientStatisticsBase &rhs) {
+      const PoissonSufficientStatistics *other = dynamic_cast<const PoissonSufficientStatistics *>(&rhs);
+      if (!other) {
+        report_error("PoissonSufficientStatistics can only be combined with another object of the "
+                     "same type.");
+      }
+      sum_of_weights_ += other->sum_of_weights_;
+      weighted_sum_of_residuals_ += other->weighted_sum_of_residuals_;
+      weighted_sum_of_squared_residuals_ += other->weighted_sum_of_squared_residuals_;
+    }
+
     //----------------------------------------------------------------------
     void PoissonSufficientStatistics::update(
         const PoissonResidualRegressionData &data) {
@@ -134,7 +147,8 @@ namespace BOOM {
                                  prior_tree_depth_alpha, prior_tree_depth_beta,
                                  log_prior_on_number_of_trees, seeding_rng),
         model_(model),
-        data_imputer_(new PoissonDataImputer) {}
+        data_imputer_(new PoissonDataImputer),
+        mixture_table_is_prepared_(false) {}
 
   //----------------------------------------------------------------------
   void PoissonBartPosteriorSampler::draw() {
@@ -146,7 +160,7 @@ namespace BOOM {
   double PoissonBartPosteriorSampler::draw_mean(Bart::TreeNode *leaf) {
     const Bart::PoissonSufficientStatistics &suf(
         dynamic_cast<const Bart::PoissonSufficientStatistics &>(
-            leaf->compute_suf()));
+            compute_suf(leaf)));
     double ivar = suf.sum_of_weights() + 1.0 / mean_prior_variance();
     double posterior_mean = suf.weighted_sum_of_residuals() / ivar;
     double posterior_sd = sqrt(1.0 / ivar);
@@ -200,7 +214,10 @@ namespace BOOM {
   }
 
   //----------------------------------------------------------------------
-  void PoissonBartPosteriorSampler::clear_residuals() { residuals_.clear(); }
+  void PoissonBartPosteriorSampler::clear_residuals() {
+    residuals_.clear();
+    mixture_table_is_prepared_ = false;
+  }
 
   //----------------------------------------------------------------------
   int PoissonBartPosteriorSampler::residual_size() const {
@@ -233,13 +250,29 @@ namespace BOOM {
   //----------------------------------------------------------------------
   void PoissonBartPosteriorSampler::impute_latent_data() {
     check_residuals();
-    for (int i = 0; i < residuals_.size(); ++i) {
-      impute_latent_data_point(residuals_[i].get());
+    prepare_mixture_table();
+    impute_in_shards(residuals_.size(), [this](int begin, int end, RNG &rng) {
+      for (int i = begin; i < end; ++i) {
+        impute_latent_data_point(residuals_[i].get(), rng);
+      }
+    });
+  }
+
+  //----------------------------------------------------------------------
+  void PoissonBartPosteriorSampler::prepare_mixture_table() {
+    if (mixture_table_is_prepared_) return;
+    std::vector<int> responses;
+    responses.reserve(residuals_.size());
+    for (const auto &data : residuals_) {
+      responses.push_back(data->y());
     }
+    PoissonDataImputer::prepare_mixture_table(responses);
+    mixture_table_is_prepared_ = true;
   }
 
   //----------------------------------------------------------------------
-  void PoissonBartPosteriorSampler::impute_latent_data_point(DataType *data) {
+  void PoissonBartPosteriorSampler::impute_latent_data_point(DataType *data,
+                                                             RNG &rng) {
     double eta = data->predicted_log_lambda();
     double neglog_final_event_time = 0;
     double internal_mu = 0;
@@ -247,7 +280,7 @@ namespace BOOM {
     double neglog_final_interarrival_time;
     double external_mu;
     double external_weight;
-    data_imputer_->impute(rng(), data->y(), data->exposure(), eta,
+    data_imputer_->impute(rng, data->y(), data->exposure(), eta,
                           &neglog_final_event_time, &internal_mu,
                           &internal_weight, &neglog_final_interarrival_time,
                           &external_mu, &external_weight);
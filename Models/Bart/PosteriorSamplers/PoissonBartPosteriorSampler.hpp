@@ -178,6 +178,7 @@ namespace BOOM {
       // contributions to the sufficient statistics.
       void update(const ResidualRegressionData &data) override;
       virtual void update(const PoissonResidualRegressionData &data);
+      void combine(const SufficientStatisticsBase &rhs) override;
 
       double sum_of_weights() const { return sum_of_weights_; }
       double weighted_sum_of_residuals() const {
@@ -277,10 +278,18 @@ namespace BOOM {
     DataType *residual(int i) override;
     SufType *create_suf() const override;
 
+    // Impute the latent data for each observation, in shards on the
+    // thread pool.  See impute_in_shards.
     void impute_latent_data();
-    void impute_latent_data_point(DataType *data);
+    void impute_latent_data_point(DataType *data, RNG &rng);
 
    private:
+    // The PoissonDataImputer's mixture table is filled in lazily, which is
+    // not thread safe.  Before the first sharded imputation the table is
+    // filled with the entries needed for the observed responses.
+    void prepare_mixture_table();
+    bool mixture_table_is_prepared_;
+
     PoissonBartModel *model_;
     std::vector<std::shared_ptr<DataType> > residuals_;
     std::shared_ptr<PoissonDataImputer> data_imputer_;
@@ -71,6 +71,16 @@ namespace BOOM {
       data.add_to_probit_suf(*this);
     }
 
+    void ProbitSufficientStatistics::combine(const SufficientStatisticsBase &rhs) {
+      const ProbitSufficientStatistics *other = dynamic_cast<const ProbitSufficientStatistics *>(&rhs);
+      if (!other) {
+        report_error("ProbitSufficientStatistics can only be combined with another object of the "
+                     "same type.");
+      }
+      n_ += other->n_;
+      sum_ += other->sum_;
+    }
+
     void ProbitSufficientStatistics::update(const ProbitResidualData &data) {
       n_ += data.n();
       sum_ += data.sum_of_residuals();
@@ -104,7 +114,7 @@ namespace BOOM {
   double ProbitBartPosteriorSampler::draw_mean(Bart::TreeNode *leaf) {
     const Bart::ProbitSufficientStatistics &suf(
         dynamic_cast<const Bart::ProbitSufficientStatistics &>(
-            leaf->compute_suf()));
+            compute_suf(leaf)));
     double prior_variance = mean_prior_variance();
     double ivar = suf.sample_size() + (1.0 / prior_variance);
     double posterior_mean = suf.sum() / ivar;
@@ -186,13 +196,40 @@ namespace BOOM {
 
   //----------------------------------------------------------------------
   void ProbitBartPosteriorSampler::impute_latent_data() {
-    for (int i = 0; i < residuals_.size(); ++i) {
-      impute_latent_data_point(residuals_[i].get());
+    impute_in_shards(residuals_.size(), [this](int begin, int end, RNG &rng) {
+      impute_latent_data(begin, end, rng);
+    });
+  }
+
+  //----------------------------------------------------------------------
+  void ProbitBartPosteriorSampler::impute_latent_data(int begin, int end,
+                                                      RNG &rng) {
+    std::vector<DataType *> single_trials;
+    Vector eta;
+    std::vector<bool> positive;
+    single_trials.reserve(end - begin);
+    eta.reserve(end - begin);
+    positive.reserve(end - begin);
+    for (int i = begin; i < end; ++i) {
+      DataType *data = residuals_[i].get();
+      if (data->n() == 1) {
+        single_trials.push_back(data);
+        eta.push_back(data->prediction());
+        positive.push_back(data->y() > 0);
+      } else {
+        impute_latent_data_point(data, rng);
+      }
+    }
+    Vector probits(eta.size());
+    rtrun_norm_mt(rng, probits, eta, 1.0, Vector(eta.size(), 0.0), positive);
+    for (int i = 0; i < single_trials.size(); ++i) {
+      single_trials[i]->set_sum_of_residuals(probits[i] - eta[i]);
     }
   }
 
   //----------------------------------------------------------------------
-  void ProbitBartPosteriorSampler::impute_latent_data_point(DataType *data) {
+  void ProbitBartPosteriorSampler::impute_latent_data_point(DataType *data,
+                                                            RNG &rng) {
     double eta = data->prediction();
     int n = data->n();
     int number_positive = data->y();
@@ -203,11 +240,11 @@ namespace BOOM {
       double mean = 0;
       double variance = 1;
       trun_norm_moments(eta, 1, 0, true, &mean, &variance);
-      sum_of_probits += rnorm_mt(rng(), number_positive * mean,
+      sum_of_probits += rnorm_mt(rng, number_positive * mean,
                                  sqrt(number_positive * variance));
     } else {
       for (int i = 0; i < number_positive; ++i) {
-        sum_of_probits += rtrun_norm_mt(rng(), eta, 1, 0, true);
+        sum_of_probits += rtrun_norm_mt(rng, eta, 1, 0, true);
       }
     }
 
@@ -215,11 +252,11 @@ namespace BOOM {
       double mean = 0;
       double variance = 1;
       trun_norm_moments(eta, 1, 0, false, &mean, &variance);
-      sum_of_probits += rnorm_mt(rng(), number_negative * mean,
+      sum_of_probits += rnorm_mt(rng, number_negative * mean,
                                  sqrt(number_negative * variance));
     } else {
       for (int i = 0; i < number_negative; ++i) {
-        sum_of_probits += rtrun_norm_mt(rng(), eta, 1, 0, false);
+        sum_of_probits += rtrun_norm_mt(rng, eta, 1, 0, false);
       }
     }
     data->set_sum_of_residuals(sum_of_probits - (n * eta));
@@ -73,6 +73,7 @@ namespace BOOM {
       void clear() override;
       void update(const ResidualRegressionData &abstract_data) override;
       virtual void update(const ProbitResidualData &data);
+      void combine(const SufficientStatisticsBase &rhs) override;
       int sample_size() const;
       double sum() const;
 
@@ -115,10 +116,17 @@ namespace BOOM {
     Bart::ProbitResidualData *residual(int i) override;
     Bart::ProbitSufficientStatistics *create_suf() const override;
 
+    // Impute the latent probits for each observation, in shards on the
+    // thread pool.  See impute_in_shards.
     void impute_latent_data();
-    void impute_latent_data_point(DataType *data);
+    void impute_latent_data_point(DataType *data, RNG &rng);
 
    private:
+    // Impute the latent data for observations [begin, end).  Observations
+    // with a single trial, which are the usual case, are imputed with one
+    // call to the bulk truncated normal generator.
+    void impute_latent_data(int begin, int end, RNG &rng);
+
     ProbitBartModel *model_;
     std::vector<std::shared_ptr<DataType> > residuals_;
   };
@@ -28,6 +28,7 @@
 #include "Models/SufstatAbstractCombineImpl.hpp"
 #include "cpputil/math_utils.hpp"
 #include "distributions.hpp"
+#include "distributions/vectorized_densities.hpp"
 
 namespace BOOM {
 
@@ -269,6 +270,22 @@ namespace BOOM {
     return pdf(data_point->trials(), data_point->successes(), logscale);
   }
 
+  void BM::pdf_batch(const std::vector<Ptr<Data>> &data, VectorView ans,
+                     bool logscale) const {
+    Vector successes(data.size());
+    Vector trials(data.size());
+    for (size_t i = 0; i < data.size(); ++i) {
+      const BinomialData *data_point =
+          dynamic_cast<const BinomialData *>(data[i].get());
+      successes[i] = data_point->successes();
+      trials[i] = data_point->trials();
+    }
+    dbinom_vector(successes, trials, prob(), ans, logscale);
+    for (size_t i = 0; i < data.size(); ++i) {
+      if (data[i]->missing()) ans[i] = logscale ? 0.0 : 1.0;
+    }
+  }
+
   unsigned int BM::sim(int n, RNG &rng) const {
     return rbinom_mt(rng, n, prob());
   }
@@ -118,6 +118,8 @@ namespace BOOM {
     void set_prob(double p);
 
     double pdf(const Data *dp, bool logscale) const override;
+    void pdf_batch(const std::vector<Ptr<Data>> &data, VectorView ans,
+                   bool logscale) const override;
     double pdf(double trials, double successes, bool logscale) const;
 
     Ptr<UnivParams> Prob_prm();
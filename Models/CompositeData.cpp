@@ -20,6 +20,7 @@
 #include "Models/CompositeData.hpp"
 
 #include <utility>
+#include "cpputil/report_error.hpp"
 
 namespace BOOM {
 
@@ -46,4 +47,28 @@ namespace BOOM {
   Ptr<Data> CompositeData::get_ptr(uint i) { return dat_[i]; }
 
   const Data *CompositeData::get(uint i) const { return dat_[i].get(); }
+
+  //===========================================================================
+  CompositeDataTable::CompositeDataTable(const std::vector<Ptr<Data>> &data) {
+    missing_.reserve(data.size());
+    for (size_t i = 0; i < data.size(); ++i) {
+      CompositeData *observation = dynamic_cast<CompositeData *>(data[i].get());
+      if (!observation) {
+        report_error("CompositeDataTable requires CompositeData.");
+      }
+      if (i == 0) {
+        columns_.resize(observation->dim());
+        for (auto &column : columns_) {
+          column.reserve(data.size());
+        }
+      } else if (observation->dim() != columns_.size()) {
+        report_error("All elements of a CompositeDataTable must have the "
+                     "same number of fields.");
+      }
+      for (size_t j = 0; j < columns_.size(); ++j) {
+        columns_[j].push_back(observation->get_ptr(j));
+      }
+      missing_.push_back(data[i]->missing() == Data::completely_missing);
+    }
+  }
 }  // namespace BOOM
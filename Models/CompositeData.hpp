@@ -53,6 +53,37 @@ namespace BOOM {
     std::vector<Ptr<Data>> dat_;
   };
 
+  //===========================================================================
+  // A collection of CompositeData stored by field rather than by
+  // observation.  Column j holds field j of each observation, which is the
+  // layout needed by MixtureComponent::pdf_batch.  Build one table and use it
+  // for each component of a mixture, rather than re-splitting the data once
+  // per component.
+  class CompositeDataTable {
+   public:
+    // Args:
+    //   data: Each element must be a CompositeData, and all must have the
+    //     same dim().  Missing observations are allowed.
+    explicit CompositeDataTable(const std::vector<Ptr<Data>> &data);
+
+    // The number of observations.
+    int nrow() const { return missing_.size(); }
+
+    // The number of fields in each observation.
+    int ncol() const { return columns_.size(); }
+
+    // Field j of each observation.
+    const std::vector<Ptr<Data>> &column(int j) const { return columns_[j]; }
+
+    // True if observation i is missing as a whole.  Missing fields within
+    // an observation are handled by the field's model.
+    bool missing(int i) const { return missing_[i]; }
+
+   private:
+    std::vector<std::vector<Ptr<Data>>> columns_;
+    std::vector<bool> missing_;
+  };
+
 }  // namespace BOOM
 
 #endif  // BOOM_COMPOSITE_DATA_HPP
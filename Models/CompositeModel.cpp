@@ -18,6 +18,7 @@
 */
 
 #include "Models/CompositeModel.hpp"
+#include "cpputil/report_error.hpp"
 
 namespace BOOM {
 
@@ -85,6 +86,38 @@ namespace BOOM {
     return logscale ? ans : exp(ans);
   }
 
+  void CM::pdf_batch(const std::vector<Ptr<Data>> &data, VectorView ans,
+                     bool logscale) const {
+    if (ans.size() != data.size()) {
+      report_error("Output vector has the wrong size in pdf_batch.");
+    }
+    logp_batch(CompositeDataTable(data), ans);
+    if (!logscale) {
+      for (int i = 0; i < ans.size(); ++i) {
+        ans[i] = exp(ans[i]);
+      }
+    }
+  }
+
+  void CM::logp_batch(const CompositeDataTable &table, VectorView ans) const {
+    if (ans.size() != table.nrow()) {
+      report_error("Output vector has the wrong size in logp_batch.");
+    }
+    if (table.nrow() > 0 && table.ncol() != m_.size()) {
+      report_error("The number of fields in the data does not match the "
+                   "number of models in the CompositeModel.");
+    }
+    ans = 0.0;
+    Vector field_log_density(table.nrow());
+    for (int j = 0; j < table.ncol(); ++j) {
+      m_[j]->pdf_batch(table.column(j), VectorView(field_log_density), true);
+      ans += field_log_density;
+    }
+    for (int i = 0; i < table.nrow(); ++i) {
+      if (table.missing(i)) ans[i] = 0.0;
+    }
+  }
+
   std::vector<Ptr<MixtureComponent> > &CM::components() { return m_; }
   const std::vector<Ptr<MixtureComponent> > &CM::components() const {
     return m_;
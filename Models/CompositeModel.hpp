@@ -63,6 +63,18 @@ namespace BOOM {
     double pdf(const CompositeData &, bool logscale) const;
     double pdf(const Ptr<Data> &dp, bool logscale) const;
     double pdf(const Data *, bool logscale) const override;
+
+    // Splits 'data' into a CompositeDataTable and calls logp_batch.
+    void pdf_batch(const std::vector<Ptr<Data>> &data, VectorView ans,
+                   bool logscale) const override;
+
+    // Set ans[i] to the log density of observation i in 'table'.  Each
+    // field is evaluated with a single call to its model's pdf_batch, so
+    // the cost is one virtual call per field rather than one per field per
+    // observation, and fields with vectorized densities are evaluated in a
+    // vectorized pass.  Completely missing observations have log density 0.
+    void logp_batch(const CompositeDataTable &table, VectorView ans) const;
+
     int number_of_observations() const override { return dat().size(); }
 
     std::vector<Ptr<MixtureComponent> > &components();
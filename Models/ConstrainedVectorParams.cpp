@@ -158,6 +158,24 @@ namespace BOOM {
     return e;
   }
 
+  void ConstrainedVectorParams::vectorize_into(VectorView out,
+                                               bool minimal) const {
+    if (minimal) {
+      Params::vectorize_into(out, minimal);
+    } else {
+      VectorParams::vectorize_into(out, minimal);
+    }
+  }
+
+  void ConstrainedVectorParams::unvectorize_from(
+      const ConstVectorView &values, bool minimal) {
+    if (minimal) {
+      Params::unvectorize_from(values, minimal);
+    } else {
+      VectorParams::unvectorize_from(values, minimal);
+    }
+  }
+
   void ConstrainedVectorParams::set(const Vector &value, bool signal_change) {
     int n = value.size();
     if (n == size(true)) {
@@ -135,6 +135,9 @@ namespace BOOM {
     Vector::const_iterator unvectorize(Vector::const_iterator &v,
                                        bool minimal = true) override;
     using Params::unvectorize;
+    void vectorize_into(VectorView out, bool minimal = true) const override;
+    void unvectorize_from(const ConstVectorView &values,
+                          bool minimal = true) override;
 
     bool check_constraint() const;
 
@@ -18,6 +18,7 @@
 */
 
 #include "Models/DataTypes.hpp"
+#include <algorithm>
 #include <sstream>
 #include <stdexcept>
 #include <vector>
@@ -48,6 +49,53 @@ namespace BOOM {
   Data::missing_status Data::missing() const { return missing_flag; }
   void Data::set_missing_status(missing_status m) { missing_flag = m; }
 
+  std::size_t Data::memory_footprint() const {
+    return sizeof(Data) + observer_bytes();
+  }
+
+  void Data::remove_observer(void *owner) {
+    signals_.erase(std::remove_if(signals_.begin(), signals_.end(),
+                                  [owner](const auto &observer) {
+                                    return observer.first == owner;
+                                  }),
+                   signals_.end());
+  }
+
+  //------------------------------------------------------------
+  thread_local int DataSignalBatch::depth_ = 0;
+  thread_local std::vector<Data *> DataSignalBatch::pending_;
+
+  void DataSignalBatch::defer(Data *data) {
+    if (!data->signal_pending_) {
+      data->signal_pending_ = true;
+      pending_.push_back(data);
+    }
+  }
+
+  // Called when a Data object with a pending signal is destroyed.  The entry
+  // is cleared rather than erased, because it may be removed while flush()
+  // is walking the list.
+  void DataSignalBatch::forget(Data *data) {
+    for (auto &pending : pending_) {
+      if (pending == data) pending = nullptr;
+    }
+  }
+
+  void DataSignalBatch::flush() {
+    // Observers run with the batch closed, so anything they set signals
+    // immediately.  If an observer opens and closes a batch of its own, the
+    // nested flush handles the rest of the list, and the pending flag keeps
+    // any object from being notified twice.
+    for (size_t i = 0; i < pending_.size(); ++i) {
+      Data *data = pending_[i];
+      if (data && data->signal_pending_) {
+        data->signal_pending_ = false;
+        data->notify_observers();
+      }
+    }
+    pending_.clear();
+  }
+
   //------------------------------------------------------------
   VectorData::VectorData(uint n, double X) : data_(n, X) {}
   VectorData::VectorData(const Vector &y) : data_(y) {}
@@ -55,6 +103,10 @@ namespace BOOM {
       : Data(rhs), Traits(rhs), data_(rhs.data_) {}
   VectorData *VectorData::clone() const { return new VectorData(*this); }
 
+  std::size_t VectorData::memory_footprint() const {
+    return sizeof(*this) + observer_bytes() + heap_bytes(data_);
+  }
+
   std::ostream &VectorData::display(std::ostream &out) const {
     out << data_;
     return out;
@@ -126,6 +178,10 @@ namespace BOOM {
       : Data(rhs), Traits(rhs), x(rhs.x) {}
 
   MatrixData *MatrixData::clone() const { return new MatrixData(*this); }
+
+  std::size_t MatrixData::memory_footprint() const {
+    return sizeof(*this) + observer_bytes() + x.size() * sizeof(double);
+  }
   std::ostream &MatrixData::display(std::ostream &out) const {
     out << x << std::endl;
     return out;
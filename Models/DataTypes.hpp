@@ -36,11 +36,46 @@
 #include "LinAlg/Selector.hpp"
 
 #include <functional>
+#include "cpputil/MemoryFootprint.hpp"
 #include "cpputil/Ptr.hpp"
 #include "cpputil/RefCounted.hpp"
 
 namespace BOOM {
 
+  class Data;
+
+  // Defers the observer notifications sent by Data::signal() on the calling
+  // thread while an object of this class is in scope.  When the outermost
+  // scope closes, each Data object that signalled during the batch notifies
+  // its observers once.  Use a batch around loops that set many values whose
+  // observers only need to know that something changed, such as the latent
+  // indicators in a mixture model.
+  //
+  // Observers are run from the destructor, so they must not throw.  Data
+  // objects that signal during a batch must not be destroyed by another
+  // thread before the batch closes.
+  class DataSignalBatch {
+   public:
+    DataSignalBatch() { ++depth_; }
+    ~DataSignalBatch() {
+      if (--depth_ == 0) flush();
+    }
+    DataSignalBatch(const DataSignalBatch &rhs) = delete;
+    DataSignalBatch &operator=(const DataSignalBatch &rhs) = delete;
+
+    // True if a batch is open on the calling thread.
+    static bool active() { return depth_ > 0; }
+
+   private:
+    friend class Data;
+    static void defer(Data *data);
+    static void forget(Data *data);
+    static void flush();
+
+    static thread_local int depth_;
+    static thread_local std::vector<Data *> pending_;
+  };
+
   class Data {  // abstract base class
     RefCounted rc_;
    public:
@@ -50,19 +85,31 @@ namespace BOOM {
 
     enum missing_status { observed = 0, completely_missing, partly_missing };
 
-    Data() : missing_flag(observed) {}
+    Data() : missing_flag(observed), signal_pending_(false), version_(0) {}
     // When copying Data, the observers should not be copied.
     Data(const Data &rhs)
         : missing_flag(rhs.missing_flag),
+          signal_pending_(false),
+          version_(0),
           signals_() {}
     virtual Data *clone() const = 0;
-    virtual ~Data() {signals_.clear();}
+    virtual ~Data() {
+      if (signal_pending_) DataSignalBatch::forget(this);
+    }
     virtual std::ostream &display(std::ostream &) const = 0;
     missing_status missing() const;
     void set_missing_status(missing_status m);
+
+    // Notify the observers that the value of this object has changed.  If a
+    // DataSignalBatch is open the notification is deferred until the batch
+    // closes.
     void signal() {
-      for (auto &it : signals_) {
-        it.second();
+      ++version_;
+      if (signals_.empty()) return;
+      if (DataSignalBatch::active()) {
+        DataSignalBatch::defer(this);
+      } else {
+        notify_observers();
       }
     }
     // TODO: This implementation of the observer pattern is broken by
@@ -74,21 +121,53 @@ namespace BOOM {
     // from the set of signals.  This fix will require making changes to all the
     // classes that use the current observer scheme.
     void add_observer(void *owner, const std::function<void(void)> &f) {
-      signals_.insert(std::make_pair(owner, f));
+      signals_.emplace_back(owner, f);
     }
 
-    void remove_observer(void *owner) {
-      signals_.erase(owner);
-    }
+    void remove_observer(void *owner);
+
+    // A counter that is incremented each time signal() is called, whether or
+    // not the object has observers.  Code that caches a function of this
+    // object (e.g. a log likelihood computed from a set of Params) can
+    // record the version and compare it later, instead of registering an
+    // observer.  Changes made without signalling (e.g. set(value, false))
+    // do not change the version.  Copies start at version 0.
+    unsigned int version() const { return version_; }
 
     // Remove all observers.
     void clear_observers() { signals_.clear(); }
     friend void intrusive_ptr_add_ref(Data *d);
     friend void intrusive_ptr_release(Data *d);
 
+    // An estimate of the number of bytes used by this object, including any
+    // heap storage that it owns.  The default only counts the Data base
+    // class, so classes owning significant storage should override it.
+    virtual std::size_t memory_footprint() const;
+
+   protected:
+    // The heap storage used to hold the observers.
+    std::size_t observer_bytes() const { return heap_bytes(signals_); }
+
    private:
+    friend class DataSignalBatch;
+    void notify_observers() {
+      for (size_t i = 0; i < signals_.size(); ++i) {
+        signals_[i].second();
+      }
+    }
+
     missing_status missing_flag;
-    std::multimap<void *, std::function<void(void)>>  signals_;
+
+    // True if this object has signalled during an open DataSignalBatch, and
+    // its observers have not yet been notified.
+    bool signal_pending_;
+
+    // The number of calls to signal().  See version().
+    unsigned int version_;
+
+    // Most Data have no observers, and most of the rest have one, so the
+    // observers are kept in a flat list rather than a map.
+    std::vector<std::pair<void *, std::function<void(void)>>> signals_;
   };
   //======================================================================
   std::ostream &operator<<(std::ostream &out, const Data &d);
@@ -122,6 +201,9 @@ namespace BOOM {
     UnivData<T> *clone() const { return new UnivData<T>(*this); }
 
     const T &value() const { return value_; }
+    std::size_t memory_footprint() const override {
+      return sizeof(*this) + this->observer_bytes();
+    }
     virtual void set(const T &rhs, bool Signal = true) {
       value_ = rhs;
       if (Signal) {
@@ -155,6 +237,7 @@ namespace BOOM {
     const Vector &value() const override { return data_; }
     void set(const Vector &rhs, bool signal_change = true) override;
     virtual void set_element(double value, int position, bool sig = true);
+    std::size_t memory_footprint() const override;
 
     // Set the contiguous subset of elements from start to start + subset.size()
     // - 1 with the elements of subset.
@@ -203,6 +286,7 @@ namespace BOOM {
     const Matrix &value() const override { return x; }
     void set(const Matrix &rhs, bool sig = true) override;
     virtual void set_element(double value, int row, int col, bool sig = true);
+    std::size_t memory_footprint() const override;
 
    private:
     Matrix x;
@@ -76,7 +76,9 @@ namespace BOOM {
       : num_classes_(num_classes)
   {}
 
-  MultinomialFactorModel::MultinomialFactorModel(const MultinomialFactorModel &rhs) {
+  MultinomialFactorModel::MultinomialFactorModel(const MultinomialFactorModel &rhs)
+      : num_classes_(rhs.num_classes_)
+  {
     operator=(rhs);
   }
 
@@ -84,6 +86,7 @@ namespace BOOM {
       const MultinomialFactorModel &rhs) {
     if (&rhs != this) {
       clear_data();
+      num_classes_ = rhs.num_classes_;
       for (const auto &visitor_it : rhs.visitors_) {
         const Ptr<Visitor> &visitor(visitor_it.second);
         for (const auto &it : visitor->sites_visited()) {
@@ -151,6 +154,7 @@ namespace BOOM {
       visitor_it.second->clear();
     }
     visitors_.clear();
+    visit_index_current_ = false;
   }
 
   void MultinomialFactorModel::record_visit(
@@ -178,6 +182,7 @@ namespace BOOM {
     }
     visitor->visit(site, nvisits);
     site->observe_visitor(visitor, nvisits);
+    visit_index_current_ = false;
   }
 
   Int MultinomialFactorModel::get_site_index(const std::string &id) const {
@@ -216,4 +221,13 @@ namespace BOOM {
     }
   }
 
+  const FactorModels::VisitIndex<Visitor, Site> &
+  MultinomialFactorModel::visit_index() const {
+    if (!visit_index_current_) {
+      visit_index_.build(visitors_, sites_);
+      visit_index_current_ = true;
+    }
+    return visit_index_;
+  }
+
 }  // namespace BOOM
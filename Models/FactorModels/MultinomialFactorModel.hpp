@@ -23,6 +23,7 @@
 #include "Models/FactorModels/VisitorBase.hpp"
 #include "Models/FactorModels/SiteBase.hpp"
 #include "Models/FactorModels/PoissonFactorModel.hpp"
+#include "Models/FactorModels/VisitIndex.hpp"
 
 namespace BOOM {
 
@@ -202,12 +203,21 @@ namespace BOOM {
     // Otherwise return nullptr.
     Ptr<Visitor> visitor(const std::string &id) const;
 
+    // A compressed, integer-indexed copy of the visitor/site graph.  Visitors
+    // and sites are numbered in the order of their ID's, matching
+    // get_site_index().  The index is rebuilt on the first call after the data
+    // have changed.
+    const FactorModels::VisitIndex<Visitor, Site> &visit_index() const;
+
    private:
     int num_classes_;
 
     // Sites and visitors stored in order of their ID's.
     std::map<std::string, Ptr<Visitor>> visitors_;
     std::map<std::string, Ptr<Site>> sites_;
+
+    mutable FactorModels::VisitIndex<Visitor, Site> visit_index_;
+    mutable bool visit_index_current_ = false;
   };
 }  // namespace BOOM
 
@@ -98,13 +98,18 @@ namespace BOOM {
         sum_of_lambdas_current_(false)
   {}
 
-  PoissonFactorModel::PoissonFactorModel(const PoissonFactorModel &rhs) {
+  PoissonFactorModel::PoissonFactorModel(const PoissonFactorModel &rhs)
+      : num_classes_(rhs.num_classes_),
+        sum_of_lambdas_(rhs.num_classes_, 0.0),
+        sum_of_lambdas_current_(false)
+  {
     *this = rhs;
   }
 
   PoissonFactorModel & PoissonFactorModel::operator=(const PoissonFactorModel &rhs) {
     if (&rhs != this) {
       clear_data();
+      num_classes_ = rhs.num_classes_;
       for (const auto &visitor_it : rhs.visitors_) {
         const Ptr<Visitor> &visitor(visitor_it.second);
         for (const auto &it : visitor->sites_visited()) {
@@ -135,7 +140,8 @@ namespace BOOM {
   }
 
   PoissonFactorModel::PoissonFactorModel(PoissonFactorModel &&rhs)
-      : visitors_(std::move(rhs.visitors_)),
+      : num_classes_(rhs.num_classes_),
+        visitors_(std::move(rhs.visitors_)),
         sites_(std::move(rhs.sites_)),
         sum_of_lambdas_current_(false)
   {}
@@ -160,6 +166,7 @@ namespace BOOM {
       visitor_it.second->clear();
     }
     visitors_.clear();
+    visit_index_current_ = false;
   }
 
   void PoissonFactorModel::combine_data(
@@ -192,6 +199,7 @@ namespace BOOM {
     }
     visitor->visit(site, nvisits);
     site->observe_visitor(visitor, nvisits);
+    visit_index_current_ = false;
   }
 
   Ptr<Site> PoissonFactorModel::site(const std::string &id) const {
@@ -226,4 +234,13 @@ namespace BOOM {
     return sum_of_lambdas_;
   }
 
+  const FactorModels::VisitIndex<Visitor, Site> &
+  PoissonFactorModel::visit_index() const {
+    if (!visit_index_current_) {
+      visit_index_.build(visitors_, sites_);
+      visit_index_current_ = true;
+    }
+    return visit_index_;
+  }
+
 }  // namespace BOOM
@@ -21,6 +21,7 @@
 
 #include "Models/FactorModels/SiteBase.hpp"
 #include "Models/FactorModels/VisitorBase.hpp"
+#include "Models/FactorModels/VisitIndex.hpp"
 #include "Models/Policies/ManyParamPolicy.hpp"
 #include "Models/Policies/PriorPolicy.hpp"
 
@@ -246,6 +247,11 @@ namespace BOOM {
     // across all sites managed by the model.  This is
     const Vector &sum_of_lambdas() const;
 
+    // A compressed, integer-indexed copy of the visitor/site graph.  Visitors
+    // and sites are numbered in the order of their ID's.  The index is rebuilt
+    // on the first call after the data have changed.
+    const FactorModels::VisitIndex<Visitor, Site> &visit_index() const;
+
    private:
     // Both visitors_ and sites_ are stored in the order of their ID's.
     int num_classes_;
@@ -254,6 +260,9 @@ namespace BOOM {
 
     mutable Vector sum_of_lambdas_;
     mutable bool sum_of_lambdas_current_;
+
+    mutable FactorModels::VisitIndex<Visitor, Site> visit_index_;
+    mutable bool visit_index_current_ = false;
   };
 
 
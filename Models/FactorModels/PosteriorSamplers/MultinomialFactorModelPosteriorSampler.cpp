@@ -20,6 +20,7 @@
 #include "distributions.hpp"
 #include "cpputil/report_error.hpp"
 #include "cpputil/math_utils.hpp"
+#include <algorithm>
 #include <sstream>
 
 namespace BOOM {
@@ -46,10 +47,68 @@ namespace BOOM {
   }
 
 
+  void Sampler::set_number_of_threads(int number_of_threads) {
+    pool_.set_number_of_threads(number_of_threads);
+    worker_rngs_.clear();
+    RNG::RngIntType seed = seed_rng(rng());
+    for (int i = 0; i < pool_.number_of_threads(); ++i) {
+      worker_rngs_.emplace_back(seed, i);
+    }
+  }
+
+  int Sampler::number_of_shards(Int size) const {
+    if (pool_.no_threads()) return 1;
+    return std::max<Int>(1, std::min<Int>(worker_rngs_.size(), size));
+  }
+
   void Sampler::impute_visitors() {
-    for (auto &visitor_it : model_->visitors()) {
-      Ptr<Visitor> &visitor(visitor_it.second);
-      impute_visitor(*visitor);
+    const auto &index(model_->visit_index());
+    int number_of_classes = model_->number_of_classes();
+
+    // Gather the site log probabilities into a single column-major array, so
+    // each visitor's sweep reads contiguous memory indexed by site position
+    // rather than chasing a pointer to each site.
+    Matrix site_logprob(number_of_classes, index.number_of_sites());
+    for (Int j = 0; j < index.number_of_sites(); ++j) {
+      site_logprob.col(j) = index.site(j)->logprob();
+    }
+
+    Int number_of_visitors = index.number_of_visitors();
+    int nshards = number_of_shards(number_of_visitors);
+    pool_.parallel_for(0, nshards, 1, [&](int shard) {
+      Int begin = shard * number_of_visitors / nshards;
+      Int end = (shard + 1) * number_of_visitors / nshards;
+      impute_visitor_range(nshards == 1 ? rng() : worker_rngs_[shard],
+                           begin, end, site_logprob);
+    });
+  }
+
+  void Sampler::impute_visitor_range(RNG &rng, Int begin, Int end,
+                                     const Matrix &site_logprob) {
+    const auto &index(model_->visit_index());
+    int number_of_classes = site_logprob.nrow();
+    const std::vector<Int> &sites_visited(index.visitor_sites());
+    Vector logprob(number_of_classes);
+    for (Int i = begin; i < end; ++i) {
+      Visitor &visitor(*index.visitor(i));
+      const Vector &prob(prior_class_probabilities(visitor.id()));
+      if (prob.max() > .999) {
+        visitor.set_class_probabilities(prob);
+        visitor.set_class_member_indicator(prob.imax());
+      } else {
+        logprob = log(prob);
+        for (Int e = index.visitor_begin(i); e < index.visitor_end(i); ++e) {
+          const double *site_column =
+              site_logprob.data() + sites_visited[e] * number_of_classes;
+          for (int k = 0; k < number_of_classes; ++k) {
+            logprob[k] += site_column[k];
+          }
+          check_logprob(logprob);
+        }
+        Vector post = logprob.normalize_logprob();
+        visitor.set_class_probabilities(post);
+        visitor.set_class_member_indicator(rmulti_mt(rng, post));
+      }
     }
   }
 
@@ -71,53 +130,62 @@ namespace BOOM {
     }
   }
 
+  // Each class's visit probabilities across sites are a Dirichlet draw, made
+  // by normalizing independent gamma draws, one per site.  The counts and
+  // the gamma draws are computed one shard of sites at a time, reading each
+  // site's visitors from the visit index, so no two shards write to the same
+  // memory.  With a single shard the gamma draws are made in the same order
+  // as rdirichlet.
   void Sampler::draw_site_parameters() {
-
-    // Assemble the site map and reverse site map.  It would be faster to make
-    // these member variables, because they won't change across iterations.
-    std::map<std::string, Int> site_map;
-    std::vector<std::string> reverse_site_map;
+    const auto &index(model_->visit_index());
     int number_of_classes = model_->number_of_classes();
-    Int number_of_sites = model_->number_of_sites();
-    Int counter = 0;
-    for (const auto &site_it : model_->sites()) {
-      const std::string &site_id(site_it.first);
-      site_map[site_id] = counter++;
-      reverse_site_map.push_back(site_id);
-    }
-
-    // Assemble the vectors of counts.  One Vector for each category.  Start by
-    // creating the data structures and putting in the priors.
-    std::vector<Vector> counts;
-    for (int k = 0; k < number_of_classes; ++k) {
-      counts.push_back(Vector(number_of_sites, 0.1));
-    }
-
-    // Now add the observed data from the visitors.
-    for (const auto &visitor_it : model_->visitors()) {
-      const Ptr<Visitor> &visitor(visitor_it.second);
-      int category = visitor->imputed_class_membership();
-      for (const auto &site_it : visitor->sites_visited()) {
-        const Ptr<Site> &site(site_it.first);
-        Int site_index = site_map[site->id()];
-        ++counts[category][site_index];
+    Int number_of_sites = index.number_of_sites();
+
+    // Element [k][j] starts as the count of visitors in class k who visited
+    // site j (plus a prior count), and is replaced by a gamma draw.
+    std::vector<Vector> probs(number_of_classes, Vector(number_of_sites));
+    const std::vector<Int> &site_visitors(index.site_visitors());
+    int nshards = number_of_shards(number_of_sites);
+    pool_.parallel_for(0, nshards, 1, [&](int shard) {
+      RNG &shard_rng(nshards == 1 ? rng() : worker_rngs_[shard]);
+      Int begin = shard * number_of_sites / nshards;
+      Int end = (shard + 1) * number_of_sites / nshards;
+      for (Int j = begin; j < end; ++j) {
+        for (int k = 0; k < number_of_classes; ++k) {
+          probs[k][j] = 0.1;
+        }
+        for (Int e = index.site_begin(j); e < index.site_end(j); ++e) {
+          ++probs[index.visitor(site_visitors[e])->imputed_class_membership()]
+              [j];
+        }
       }
-    }
+      for (int k = 0; k < number_of_classes; ++k) {
+        for (Int j = begin; j < end; ++j) {
+          probs[k][j] = rgamma_mt(shard_rng, probs[k][j], 1);
+        }
+      }
+    });
 
-    // Ready to draw the model parameters.  These are structured the same way as
-    // the counts.
-    std::vector<Vector> probs;
     for (int k = 0; k < number_of_classes; ++k) {
-      probs.push_back(rdirichlet_mt(rng(), counts[k]));
+      double total = 0;
+      for (Int j = 0; j < number_of_sites; ++j) {
+        total += probs[k][j];
+      }
+      if (!std::isnormal(total)) {
+        std::ostringstream err;
+        err << "Invalid sum of gamma draws for class " << k
+            << " in MultinomialFactorModelPosteriorSampler: " << total;
+        report_error(err.str());
+      }
+      probs[k] /= total;
     }
 
-    for (Int i = 0; i < number_of_sites; ++i) {
-      Ptr<Site> site = model_->site(reverse_site_map[i]);
-      Vector site_probs(number_of_classes);
+    Vector site_probs(number_of_classes);
+    for (Int j = 0; j < number_of_sites; ++j) {
       for (int k = 0; k < number_of_classes; ++k) {
-        site_probs[k] = probs[k][i];
+        site_probs[k] = probs[k][j];
       }
-      site->set_probs(site_probs);
+      index.site(j)->set_probs(site_probs);
     }
   }
 
@@ -22,6 +22,7 @@
 #include "Models/PosteriorSamplers/PosteriorSampler.hpp"
 #include "Models/FactorModels/MultinomialFactorModel.hpp"
 #include "Models/FactorModels/PosteriorSamplers/VisitorPriorManager.hpp"
+#include "cpputil/ThreadTools.hpp"
 
 namespace BOOM {
 
@@ -45,7 +46,15 @@ namespace BOOM {
     void impute_visitor(Visitor &visitor);
 
     void draw_site_parameters();
-    
+
+    // Use threads from the global thread pool in impute_visitors() and
+    // draw_site_parameters().  Visitors are conditionally independent given
+    // the site parameters, and sites given the visitors' classes, so each
+    // phase is split into one shard per thread, and each shard draws from its
+    // own random number stream.  The default of zero threads does all the
+    // work in the calling thread using this sampler's RNG.
+    void set_number_of_threads(int number_of_threads);
+
     void set_prior_class_probabilities(
         const std::string &visitor_id,
         const Vector &probs) {
@@ -61,6 +70,18 @@ namespace BOOM {
     MultinomialFactorModel *model_;
     VisitorPriorManager visitor_prior_;
 
+    SharedThreadPool pool_;
+    std::vector<RNG> worker_rngs_;
+
+    // The number of shards into which 'size' units of work should be split.
+    int number_of_shards(Int size) const;
+
+    // Impute the class membership of visitors [begin, end) in the model's
+    // visit_index().  Column j of site_logprob is the logprob() vector for
+    // site j.
+    void impute_visitor_range(RNG &rng, Int begin, Int end,
+                              const Matrix &site_logprob);
+
     // Raise an exception if any elements of logprob are non-finite.
     void check_logprob(const Vector &logprob) const;
   };
@@ -74,26 +74,55 @@ namespace BOOM {
 
   void PoissonFactorHierarchicalSampler::draw_site_parameters() {
     SumMultinomialLogitTransform transform;
-    profile_hyperprior_->clear_data();
+    const auto &index(model()->visit_index());
+    Int number_of_sites = index.number_of_sites();
+    int number_of_classes = model()->number_of_classes();
+
+    // The shards share the hyperprior, whose precision matrix is computed
+    // lazily.  Compute it here so the shards only read it.
+    profile_hyperprior_->siginv();
+    profile_hyperprior_->ldsi();
+
+    // Row k of visit_counts is the number of imputed visits in category k.
+    // Column j corresponds to site j.
+    Matrix visit_counts(number_of_classes, number_of_sites, 0.0);
+    Matrix lambdas(number_of_classes, number_of_sites);
+    int nshards = number_of_shards(number_of_sites);
+    shard_sampling_counts_.assign(nshards, SamplingCounts());
+    for_each_shard(
+        number_of_sites, nshards,
+        [&](int shard, RNG &rng, Int begin, Int end) {
+          compute_site_visit_counts(begin, end, visit_counts);
+          for (Int j = begin; j < end; ++j) {
+            const Ptr<Site> &site(index.site(j));
+            Vector site_visit_counts = visit_counts.col(j);
+            if (site_visit_counts.min() >= MH_threshold_) {
+              lambdas.col(j) = draw_lambda_MH(
+                  rng, site, site->lambda(), site_visit_counts,
+                  shard_sampling_counts_[shard]);
+            } else {
+              lambdas.col(j) = draw_lambda_slice(
+                  rng, site, site_visit_counts, shard_sampling_counts_[shard]);
+            }
+          }
+        });
+    for (const auto &counts : shard_sampling_counts_) {
+      record_sampling_counts(counts);
+    }
 
-     for (auto &site_it : model()->sites()) {
-       Ptr<Site> &site(site_it.second);
-       Matrix visitor_counts = site->visitor_counts();
-       
-       // column 0 of visitor_counts is the number of imputed visits in each category.
-       // column 1 is the number of imputed visitors in each category.
-       if (visitor_counts.col(0).min() >= MH_threshold_) {
-         draw_site_parameters_MH(site);
-       } else {
-         draw_site_parameters_slice(site);
-       }
-       Vector eta = transform.to_sum_logits(site->lambda());
-       // The first element of eta is the sum of the lambdas.  The remaining
-       // elements are the multinomial logit transform of the lambda profile
-       // (i.e. of lambda divided by its sum).  Only the logits are described
-       // by the profile_hyperprior.
-       profile_hyperprior_->suf()->update_raw(ConstVectorView(eta, 1));
-     }
+    // Updating a site notifies the model, so the sites are updated here
+    // rather than in the shards.
+    profile_hyperprior_->clear_data();
+    for (Int j = 0; j < number_of_sites; ++j) {
+      const Ptr<Site> &site(index.site(j));
+      site->set_lambda(lambdas.col(j));
+      Vector eta = transform.to_sum_logits(site->lambda());
+      // The first element of eta is the sum of the lambdas.  The remaining
+      // elements are the multinomial logit transform of the lambda profile
+      // (i.e. of lambda divided by its sum).  Only the logits are described
+      // by the profile_hyperprior.
+      profile_hyperprior_->suf()->update_raw(ConstVectorView(eta, 1));
+    }
   }
 
   // A functor for evaluating the conditional log posterior of a site's
@@ -113,6 +142,8 @@ namespace BOOM {
 
     // Args:
     //   site:  The site whose parameters are to be evaluated.
+    //   visit_counts: The number of visits to the site from visitors in each
+    //     latent category.
     //   mlogit_profile_prior: A multivariate normal prior on the multinomial
     //     logit transformation of the profile of a site's intensity parameters.
     //     The 'profile' is the set of intensity parameters divided by their
@@ -124,16 +155,16 @@ namespace BOOM {
     //     sum and logits.
     SiteParameterLogPosterior(
         const Ptr<Site> &site,
+        const Vector &visit_counts,
         const Ptr<MvnModel> &mlogit_profile_prior,
         const Vector &exposures,
         Scale scale = RAW)
         : site_(site),
           mlogit_profile_prior_(mlogit_profile_prior),
+          visit_counts_(visit_counts),
           exposures_(exposures),
           scale_(scale)
-    {
-      visit_counts_ = site_->visitor_counts().col(0);
-    }
+    {}
 
     // The argument to operator() can be either lambda, or sum_and_logits,
     // depending on how scale_ was set during construction.
@@ -195,12 +226,30 @@ namespace BOOM {
   //   full conditional distribution.
   void PoissonFactorHierarchicalSampler::draw_site_parameters_MH(
       Ptr<Site> &site) {
-    Vector lambda = site->lambda();
-    Matrix counts = site->visitor_counts();
-    const ConstVectorView visit_counts(counts.col(0));
+    SamplingCounts counts;
+    site->set_lambda(draw_lambda_MH(
+        rng(), site, site->lambda(), compute_visit_counts(*site), counts));
+    record_sampling_counts(counts);
+  }
+
+  void PoissonFactorHierarchicalSampler::draw_site_parameters_slice(
+      Ptr<Site> &site) {
+    SamplingCounts counts;
+    site->set_lambda(
+        draw_lambda_slice(rng(), site, compute_visit_counts(*site), counts));
+    record_sampling_counts(counts);
+  }
 
+  Vector PoissonFactorHierarchicalSampler::draw_lambda_MH(
+      RNG &rng,
+      const Ptr<Site> &site,
+      const Vector &original_lambda,
+      const Vector &visit_counts,
+      SamplingCounts &counts) const {
+    Vector lambda = original_lambda;
     SiteParameterLogPosterior logpost(
         site,
+        visit_counts,
         profile_hyperprior_,
         exposure_counts(),
         SiteParameterLogPosterior::Scale::RAW);
@@ -212,37 +261,40 @@ namespace BOOM {
       double log_denominator =
           logpost(lambda) - dgamma(lambda[i], alpha, beta, true);
 
-      double original_lambda = lambda[i];
-      lambda[i] = rgamma_mt(rng(), alpha, beta);
+      double original_value = lambda[i];
+      lambda[i] = rgamma_mt(rng, alpha, beta);
       double log_numerator =
           logpost(lambda) - dgamma(lambda[i], alpha, beta, true);
 
       double logu = negative_infinity();
       while (!std::isfinite(logu)) {
-        logu = log(runif_mt(rng()));
+        logu = log(runif_mt(rng));
       }
       if (logu < log_numerator - log_denominator) {
         // Accept the draw by doing nothing.
-        ++MH_acceptance_;
+        ++counts.MH_acceptance;
       } else {
         // Reject the draw by reverting to the original lambda value.
-        lambda[i] = original_lambda;
-        ++MH_failure_;
+        lambda[i] = original_value;
+        ++counts.MH_failure;
       }
     }
-    site->set_lambda(lambda);
+    return lambda;
   }
 
-  void PoissonFactorHierarchicalSampler::draw_site_parameters_slice(
-      Ptr<Site> &site) {
-    ++slice_sample_draws_;
+  Vector PoissonFactorHierarchicalSampler::draw_lambda_slice(
+      RNG &rng,
+      const Ptr<Site> &site,
+      const Vector &visit_counts,
+      SamplingCounts &counts) const {
+    ++counts.slice_sample_draws;
     SumMultinomialLogitTransform transformation;
     Vector eta = transformation.to_sum_logits(site->lambda());
     SiteParameterLogPosterior logpost(
-        site, profile_hyperprior_, exposure_counts(),
+        site, visit_counts, profile_hyperprior_, exposure_counts(),
         SiteParameterLogPosterior::Scale::TRANSFORMED);
 
-    UnivariateSliceSampler sampler(logpost);
+    UnivariateSliceSampler sampler(logpost, 1.0, false, &rng);
     Vector lower_limit(eta.size(), negative_infinity());
     Vector upper_limit(eta.size(), infinity());
     lower_limit[0] = 0.0;
@@ -257,10 +309,16 @@ namespace BOOM {
           << "Falling back to Metropolis-Hastings algorithm.\n\n"
           << ex.what();
       report_warning(err.str());
-      draw_site_parameters_MH(site);
-      return;
+      return draw_lambda_MH(rng, site, site->lambda(), visit_counts, counts);
     }
-    site->set_lambda(transformation.from_sum_logits(eta));
+    return transformation.from_sum_logits(eta);
+  }
+
+  void PoissonFactorHierarchicalSampler::record_sampling_counts(
+      const SamplingCounts &counts) {
+    MH_acceptance_ += counts.MH_acceptance;
+    MH_failure_ += counts.MH_failure;
+    slice_sample_draws_ += counts.slice_sample_draws;
   }
 
   void PoissonFactorHierarchicalSampler::set_MH_threshold(int threshold) {
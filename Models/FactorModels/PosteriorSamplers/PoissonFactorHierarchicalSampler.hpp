@@ -91,6 +91,9 @@ namespace BOOM {
 
     // The lambda site parameters are decomponsed into lambda = alpha * pi,
     // where alpha is a scalar and pi is a discrete probability distribution.
+    // Sites are conditionally independent given the visitors' classes and the
+    // hyperparameters, so they are drawn in parallel shards if threads have
+    // been allotted (see set_number_of_threads).
     void draw_site_parameters();
     void draw_hyperparameters();
 
@@ -114,6 +117,31 @@ namespace BOOM {
    private:
     void check_dimension(const Ptr<MvnModel> &profile_hyperprior) const;
 
+    // Tallies of the types of site draws, kept separately for each shard so
+    // the shards can be drawn in parallel.
+    struct SamplingCounts {
+      Int MH_acceptance = 0;
+      Int MH_failure = 0;
+      Int slice_sample_draws = 0;
+    };
+
+    // Return a draw of a site's lambda parameters, given the current value of
+    // lambda and the site's visit counts in each latent category.  These do
+    // not modify the site or the sampler, so different sites can be drawn in
+    // parallel.
+    Vector draw_lambda_MH(RNG &rng,
+                          const Ptr<FactorModels::PoissonSite> &site,
+                          const Vector &lambda,
+                          const Vector &visit_counts,
+                          SamplingCounts &counts) const;
+    Vector draw_lambda_slice(RNG &rng,
+                             const Ptr<FactorModels::PoissonSite> &site,
+                             const Vector &visit_counts,
+                             SamplingCounts &counts) const;
+
+    // Add the tallies in 'counts' to the sampler's totals.
+    void record_sampling_counts(const SamplingCounts &counts);
+
     PoissonFactorModel *model_;
 
     // Prior distribution for mulinomial logits of intensity parameters, with
@@ -135,6 +163,8 @@ namespace BOOM {
     // The min number of observations in each category needed to use MH sampling
     // instead of slice sampling.
     int MH_threshold_;
+
+    std::vector<SamplingCounts> shard_sampling_counts_;
   };
 
 }  // namespace BOOM
@@ -47,42 +47,59 @@ namespace BOOM {
     ++iteration_;
   }
 
+  // Sites are conditionally independent given the visitors' classes, so they
+  // are drawn in parallel shards.  The draws are stored and the sites are
+  // updated afterwards, because updating a site notifies the model.
   void Sampler::draw_site_parameters() {
-    for (auto &site_it : model()->sites()) {
-      Ptr<Site> &site(site_it.second);
-      const std::vector<Ptr<GammaModelBase>> &site_prior(
-          intensity_prior(site->id()));
-      Vector visit_counts = compute_visit_counts(*site);
-      for (int i = 0; i < site_prior.size(); ++i) {
-        visit_counts[i] += site_prior[i]->a();
+    const auto &index(model()->visit_index());
+    Int number_of_sites = index.number_of_sites();
+    int number_of_classes = model()->number_of_classes();
+    Matrix lambdas(number_of_classes, number_of_sites, 0.0);
+    for_each_shard(
+        number_of_sites, number_of_shards(number_of_sites),
+        [&](int, RNG &rng, Int begin, Int end) {
+          compute_site_visit_counts(begin, end, lambdas);
+          for (Int j = begin; j < end; ++j) {
+            draw_site_lambda(rng, *index.site(j), lambdas.col(j));
+          }
+        });
+    for (Int j = 0; j < number_of_sites; ++j) {
+      index.site(j)->set_lambda(lambdas.col(j));
+    }
+  }
+
+  void Sampler::draw_site_lambda(RNG &rng, const Site &site,
+                                 VectorView lambda) const {
+    const std::vector<Ptr<GammaModelBase>> &site_prior(
+        intensity_prior(site.id()));
+    Vector visit_counts = lambda;
+    for (int i = 0; i < site_prior.size(); ++i) {
+      visit_counts[i] += site_prior[i]->a();
+    }
+    for (int k = 0; k < visit_counts.size(); ++k) {
+      double b = exposure_counts()[k] + site_prior[k]->b();
+      if (!std::isfinite(visit_counts[k]) || !std::isfinite(b)) {
+        std::ostringstream err;
+        err << "site " << site.id()
+            << " had an infinite value in position " << k
+            << " in either visit_counts "
+            << visit_counts[k] << "\n"
+            << " exposure_counts " << exposure_counts()[k]
+            << " or prior: ("
+            << site_prior[k]->a()
+            << ", " << site_prior[k]->b()
+            << ".\n";
+        report_error(err.str());
       }
-      Vector lambdas(visit_counts.size());
-      for (int k = 0; k < visit_counts.size(); ++k) {
-        double b = exposure_counts()[k] + site_prior[k]->b();
-        if (!std::isfinite(visit_counts[k]) || !std::isfinite(b)) {
-          std::ostringstream err;
-          err << "site " << site->id()
-              << " had an infinite value in position " << k
-              << " in either visit_counts "
-              << visit_counts[k] << "\n"
-              << " exposure_counts " << exposure_counts()[k]
-              << " or prior: ("
-              << site_prior[k]->a()
-              << ", " << site_prior[k]->b()
-              << ".\n";
-          report_error(err.str());
-        }
-        lambdas[k] = rgamma_mt(rng(), visit_counts[k], b);
-        if (lambdas[k] <= 0.0) {
-          std::ostringstream err;
-          err << "site " << site->id()
-              << " generated a zero value for lambda.\n"
-              << "visit_counts[" << k << "] = " << visit_counts[k]
-              << ", b = " << b << "\n";
-          report_error(err.str());
-        }
+      lambda[k] = rgamma_mt(rng, visit_counts[k], b);
+      if (lambda[k] <= 0.0) {
+        std::ostringstream err;
+        err << "site " << site.id()
+            << " generated a zero value for lambda.\n"
+            << "visit_counts[" << k << "] = " << visit_counts[k]
+            << ", b = " << b << "\n";
+        report_error(err.str());
       }
-      site->set_lambda(lambdas);
     }
   }
 
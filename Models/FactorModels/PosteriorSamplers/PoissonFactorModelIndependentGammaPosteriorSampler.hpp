@@ -65,6 +65,12 @@ namespace BOOM {
         const std::string &site_id) const;
 
    private:
+    // Draw the intensity parameters for a site.  On input 'lambda' holds the
+    // site's visit counts in each latent category.  On output it holds the
+    // draw.
+    void draw_site_lambda(RNG &rng, const FactorModels::PoissonSite &site,
+                          VectorView lambda) const;
+
     std::vector<Ptr<GammaModelBase>> default_intensity_prior_;
     std::map<std::string, std::vector<Ptr<GammaModelBase>>>
     intensity_parameter_priors_;
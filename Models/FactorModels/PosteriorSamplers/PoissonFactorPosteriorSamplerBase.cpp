@@ -17,6 +17,7 @@
 */
 
 #include "Models/FactorModels/PosteriorSamplers/PoissonFactorPosteriorSamplerBase.hpp"
+#include <algorithm>
 #include <sstream>
 #include "cpputil/report_error.hpp"
 #include "distributions.hpp"
@@ -41,28 +42,84 @@ namespace BOOM {
     //     check_probabilities(default_prior_class_probabilities);
   }
 
+  void Sampler::set_number_of_threads(int number_of_threads) {
+    pool_.set_number_of_threads(number_of_threads);
+    worker_rngs_.clear();
+    RNG::RngIntType seed = seed_rng(rng());
+    for (int i = 0; i < pool_.number_of_threads(); ++i) {
+      worker_rngs_.emplace_back(seed, i);
+    }
+  }
+
+  int Sampler::number_of_shards(Int size) const {
+    if (pool_.no_threads()) return 1;
+    return std::max<Int>(1, std::min<Int>(worker_rngs_.size(), size));
+  }
+
   void Sampler::impute_visitors() {
-    exposure_counts_ *= 0.0;
-    for (auto &visitor_it : model_->visitors()) {
-      Ptr<Visitor> &visitor(visitor_it.second);
-      Vector prob = prior_class_probabilities(visitor->id());
+    const auto &index(model_->visit_index());
+    int number_of_classes = model_->number_of_classes();
+
+    // Gather the log intensities into a single column-major array so each
+    // visitor's sweep reads them by site position.
+    Matrix log_lambda(number_of_classes, index.number_of_sites());
+    for (Int j = 0; j < index.number_of_sites(); ++j) {
+      log_lambda.col(j) = index.site(j)->log_lambda();
+    }
+    // sum_of_lambdas() is computed lazily, so make sure it is current before
+    // the shards read it.
+    model_->sum_of_lambdas();
+
+    int nshards = number_of_shards(index.number_of_visitors());
+    shard_exposure_counts_.resize(nshards);
+    for (auto &counts : shard_exposure_counts_) {
+      counts.resize(number_of_classes);
+      counts = 0.0;
+    }
+    for_each_shard(
+        index.number_of_visitors(), nshards,
+        [&](int shard, RNG &rng, Int begin, Int end) {
+          impute_visitor_range(rng, begin, end, log_lambda,
+                               shard_exposure_counts_[shard]);
+        });
+
+    exposure_counts_ = 0.0;
+    for (const auto &counts : shard_exposure_counts_) {
+      exposure_counts_ += counts;
+    }
+  }
+
+  void Sampler::impute_visitor_range(RNG &rng, Int begin, Int end,
+                                     const Matrix &log_lambda,
+                                     Vector &exposure_counts) {
+    const auto &index(model_->visit_index());
+    int number_of_classes = log_lambda.nrow();
+    const std::vector<Int> &sites_visited(index.visitor_sites());
+    const std::vector<int> &visit_counts(index.visitor_visit_counts());
+    const Vector &sum_of_lambdas(model_->sum_of_lambdas());
+    Vector logprob(number_of_classes);
+    for (Int i = begin; i < end; ++i) {
+      Visitor &visitor(*index.visitor(i));
+      Vector prob = prior_class_probabilities(visitor.id());
       if (prob.max() > .9999) {
-        visitor->set_class_probabilities(prob);
-        visitor->set_class_member_indicator(prob.imax());
+        visitor.set_class_probabilities(prob);
+        visitor.set_class_member_indicator(prob.imax());
       } else {
-        Vector logprob = log(prob);
-        logprob -= model_->sum_of_lambdas();
-        for (const auto &it : visitor->sites_visited()) {
-          int visit_counts = it.second;
-          const Ptr<Site> &site(it.first);
-          logprob += visit_counts * site->log_lambda();
-          check_logprob(logprob, visit_counts, site);
+        logprob = log(prob);
+        logprob -= sum_of_lambdas;
+        for (Int e = index.visitor_begin(i); e < index.visitor_end(i); ++e) {
+          const double *site_column =
+              log_lambda.data() + sites_visited[e] * number_of_classes;
+          for (int k = 0; k < number_of_classes; ++k) {
+            logprob[k] += visit_counts[e] * site_column[k];
+          }
+          check_logprob(logprob, visit_counts[e], index.site(sites_visited[e]));
         }
         prob = logprob.normalize_logprob();
-        visitor->set_class_probabilities(prob);
-        visitor->set_class_member_indicator(rmulti_mt(rng(), prob));
+        visitor.set_class_probabilities(prob);
+        visitor.set_class_member_indicator(rmulti_mt(rng, prob));
       }
-      ++exposure_counts_[visitor->imputed_class_membership()];
+      ++exposure_counts[visitor.imputed_class_membership()];
     }
   }
 
@@ -77,6 +134,27 @@ namespace BOOM {
     return counts;
   }
 
+  Matrix Sampler::compute_site_visit_counts() const {
+    const auto &index(model_->visit_index());
+    Matrix counts(model_->number_of_classes(), index.number_of_sites(), 0.0);
+    compute_site_visit_counts(0, index.number_of_sites(), counts);
+    return counts;
+  }
+
+  void Sampler::compute_site_visit_counts(Int begin, Int end,
+                                          Matrix &counts) const {
+    const auto &index(model_->visit_index());
+    const std::vector<Int> &site_visitors(index.site_visitors());
+    const std::vector<int> &visit_counts(index.site_visit_counts());
+    for (Int j = begin; j < end; ++j) {
+      for (Int e = index.site_begin(j); e < index.site_end(j); ++e) {
+        int class_id =
+            index.visitor(site_visitors[e])->imputed_class_membership();
+        counts(class_id, j) += visit_counts[e];
+      }
+    }
+  }
+
   void Sampler::check_logprob(const Vector &logprob,
                               int visit_counts,
                               const Ptr<Site> &site) const {
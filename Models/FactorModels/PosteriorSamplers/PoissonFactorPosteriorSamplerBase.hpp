@@ -23,6 +23,7 @@
 #include "Models/PosteriorSamplers/PosteriorSampler.hpp"
 #include "Models/FactorModels/PosteriorSamplers/VisitorPriorManager.hpp"
 #include "distributions/rng.hpp"
+#include "cpputil/ThreadTools.hpp"
 
 namespace BOOM {
 
@@ -36,8 +37,18 @@ namespace BOOM {
 
     int number_of_classes() const {return model_->number_of_classes();}
     
+    // Impute the class membership of each visitor given the site parameters.
+    // Visitors are conditionally independent, so they are imputed in
+    // parallel shards if threads have been allotted.
     void impute_visitors();
 
+    // Use threads from the global thread pool for visitor imputation and the
+    // site level draws.  Work is split into one shard per thread, and each
+    // shard draws from its own random number stream.  The default of zero
+    // threads does all the work in the calling thread using this sampler's
+    // RNG.
+    void set_number_of_threads(int number_of_threads);
+
     void set_prior_class_probabilities(const std::string &visitor_id,
                                        const Vector &probs) {
       visitor_prior_.set_prior_class_probabilities(visitor_id, probs);
@@ -54,10 +65,39 @@ namespace BOOM {
     // latent category.
     Vector compute_visit_counts(const FactorModels::PoissonSite &site) const;
 
+    // Return a matrix with one row per latent category and one column per
+    // site, in the order of the model's visit_index().  Column j is
+    // compute_visit_counts() for site j, but the whole matrix is computed in a
+    // single pass over the visit index.
+    Matrix compute_site_visit_counts() const;
+
    protected:
     PoissonFactorModel *model() {return model_;}
     const PoissonFactorModel *model() const {return model_;}
 
+    // The number of shards into which 'size' units of work should be split.
+    int number_of_shards(Int size) const;
+
+    // Add the visits to sites [begin, end) to the corresponding columns of
+    // 'counts', which has the layout described in compute_site_visit_counts.
+    // Each site's visitors are read from the site-major half of the visit
+    // index, so shards covering different sites write to disjoint columns.
+    void compute_site_visit_counts(Int begin, Int end, Matrix &counts) const;
+
+    // Call body(shard, rng, begin, end) for each of 'nshards' contiguous
+    // shards of [0, size), in parallel if threads have been allotted.  The
+    // RNG is rng() if there is a single shard, and the shard's own stream
+    // otherwise.
+    template <class Body>
+    void for_each_shard(Int size, int nshards, Body body) {
+      pool_.parallel_for(0, nshards, 1, [&](int shard) {
+        body(shard,
+             nshards == 1 ? rng() : worker_rngs_[shard],
+             shard * size / nshards,
+             (shard + 1) * size / nshards);
+      });
+    }
+
    private:
 
     // Raise an exception if logprob contains non-finite values.
@@ -76,6 +116,19 @@ namespace BOOM {
 
     // The total number of users of each class.
     Vector exposure_counts_;
+
+    // Per-shard contributions to exposure_counts_, combined in shard order.
+    std::vector<Vector> shard_exposure_counts_;
+
+    SharedThreadPool pool_;
+    std::vector<RNG> worker_rngs_;
+
+    // Impute visitors [begin, end) in the model's visit_index(), adding them
+    // to 'exposure_counts'.  Column j of log_lambda is the log_lambda()
+    // vector for site j.
+    void impute_visitor_range(RNG &rng, Int begin, Int end,
+                              const Matrix &log_lambda,
+                              Vector &exposure_counts);
   };
 
 
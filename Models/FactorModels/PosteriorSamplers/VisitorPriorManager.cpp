@@ -31,6 +31,11 @@ namespace BOOM {
 
   const Vector &VisitorPriorManager::prior_class_probabilities(
       const std::string &visitor_id) const {
+    // Most models use only the default prior, in which case the string
+    // comparisons in the map lookup can be skipped.
+    if (prior_class_probabilities_.empty()) {
+      return default_prior_class_probabilities_;
+    }
     auto it = prior_class_probabilities_.find(visitor_id);
     if (it == prior_class_probabilities_.end()) {
       return default_prior_class_probabilities_;
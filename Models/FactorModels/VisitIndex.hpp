@@ -0,0 +1,151 @@
+#ifndef BOOM_FACTOR_MODELS_VISIT_INDEX_HPP_
+#define BOOM_FACTOR_MODELS_VISIT_INDEX_HPP_
+/*
+  Copyright (C) 2005-2024 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "uint.hpp"
+#include "cpputil/Ptr.hpp"
+
+namespace BOOM {
+  namespace FactorModels {
+
+    // A compressed representation of the bipartite visitor/site graph held by
+    // a factor model.  Visitors and sites are numbered 0, 1, ... in the order
+    // of their ID's (i.e. the order of the model's visitor and site
+    // directories).  The visits are stored twice: in compressed sparse row
+    // form, grouped by visitor, and in compressed sparse column form, grouped
+    // by site.  Posterior samplers can then impute visitors, or accumulate
+    // site statistics, with a linear scan over integer arrays instead of
+    // walking the maps held by each Visitor and Site.
+    //
+    // The visits by visitor i are entries visitor_begin(i), ...,
+    // visitor_end(i) - 1 of visitor_sites() and visitor_visit_counts().  The
+    // visits to site j are entries site_begin(j), ..., site_end(j) - 1 of
+    // site_visitors() and site_visit_counts().  A visitor's entries follow
+    // the order of its sites_visited() map, so sums over a visitor's sites
+    // accumulate in the same order as a loop over the map.  A site's entries
+    // are in increasing order of visitor index.
+    //
+    // VISITOR must provide sites_visited(), a map from Ptr<SITE> to the
+    // number of visits.
+    template <class VISITOR, class SITE>
+    class VisitIndex {
+     public:
+      VisitIndex() : visitor_offsets_(1, 0), site_offsets_(1, 0) {}
+
+      // Rebuild the index from a model's visitor and site directories.
+      void build(const std::map<std::string, Ptr<VISITOR>> &visitors,
+                 const std::map<std::string, Ptr<SITE>> &sites);
+
+      Int number_of_visitors() const { return visitors_.size(); }
+      Int number_of_sites() const { return sites_.size(); }
+
+      // The number of distinct (visitor, site) pairs.
+      Int number_of_edges() const { return visitor_sites_.size(); }
+
+      const Ptr<VISITOR> &visitor(Int i) const { return visitors_[i]; }
+      const Ptr<SITE> &site(Int j) const { return sites_[j]; }
+
+      Int visitor_begin(Int i) const { return visitor_offsets_[i]; }
+      Int visitor_end(Int i) const { return visitor_offsets_[i + 1]; }
+      const std::vector<Int> &visitor_sites() const { return visitor_sites_; }
+      const std::vector<int> &visitor_visit_counts() const {
+        return visitor_visit_counts_;
+      }
+
+      Int site_begin(Int j) const { return site_offsets_[j]; }
+      Int site_end(Int j) const { return site_offsets_[j + 1]; }
+      const std::vector<Int> &site_visitors() const { return site_visitors_; }
+      const std::vector<int> &site_visit_counts() const {
+        return site_visit_counts_;
+      }
+
+     private:
+      std::vector<Ptr<VISITOR>> visitors_;
+      std::vector<Ptr<SITE>> sites_;
+
+      // Compressed sparse row storage, grouped by visitor.
+      std::vector<Int> visitor_offsets_;
+      std::vector<Int> visitor_sites_;
+      std::vector<int> visitor_visit_counts_;
+
+      // Compressed sparse column storage, grouped by site.
+      std::vector<Int> site_offsets_;
+      std::vector<Int> site_visitors_;
+      std::vector<int> site_visit_counts_;
+    };
+
+    //===========================================================================
+    template <class VISITOR, class SITE>
+    void VisitIndex<VISITOR, SITE>::build(
+        const std::map<std::string, Ptr<VISITOR>> &visitors,
+        const std::map<std::string, Ptr<SITE>> &sites) {
+      sites_.clear();
+      sites_.reserve(sites.size());
+      std::unordered_map<const SITE *, Int> site_index;
+      site_index.reserve(sites.size());
+      for (const auto &it : sites) {
+        site_index[it.second.get()] = sites_.size();
+        sites_.push_back(it.second);
+      }
+
+      visitors_.clear();
+      visitors_.reserve(visitors.size());
+      visitor_offsets_.assign(1, 0);
+      visitor_offsets_.reserve(visitors.size() + 1);
+      visitor_sites_.clear();
+      visitor_visit_counts_.clear();
+      for (const auto &it : visitors) {
+        visitors_.push_back(it.second);
+        for (const auto &visit : it.second->sites_visited()) {
+          visitor_sites_.push_back(site_index.at(visit.first.get()));
+          visitor_visit_counts_.push_back(visit.second);
+        }
+        visitor_offsets_.push_back(visitor_sites_.size());
+      }
+
+      // Transpose the row storage into column storage with a counting sort.
+      // Visitors are processed in order, so each site's visitors are sorted.
+      site_offsets_.assign(sites_.size() + 1, 0);
+      for (Int site : visitor_sites_) {
+        ++site_offsets_[site + 1];
+      }
+      for (Int j = 0; j < sites_.size(); ++j) {
+        site_offsets_[j + 1] += site_offsets_[j];
+      }
+      site_visitors_.resize(visitor_sites_.size());
+      site_visit_counts_.resize(visitor_sites_.size());
+      std::vector<Int> position(site_offsets_.begin(), site_offsets_.end() - 1);
+      for (Int i = 0; i < visitors_.size(); ++i) {
+        for (Int e = visitor_begin(i); e < visitor_end(i); ++e) {
+          Int destination = position[visitor_sites_[e]]++;
+          site_visitors_[destination] = i;
+          site_visit_counts_[destination] = visitor_visit_counts_[e];
+        }
+      }
+    }
+
+  }  // namespace FactorModels
+}  // namespace BOOM
+
+#endif  // BOOM_FACTOR_MODELS_VISIT_INDEX_HPP_
@@ -151,4 +151,53 @@ namespace {
     visitor_out << visitor_draws;
   }
 
+  //===========================================================================
+  // A threaded sampler draws each shard from its own stream, so two threaded
+  // samplers seeded the same way produce the same draws.
+  TEST_F(MultinomialFactorModelTest, ThreadedSamplerIsReproducible) {
+    int num_classes = 3;
+    int num_sites = 30;
+    Matrix site_probs(num_sites, num_classes);
+    for (int j = 0; j < num_classes; ++j){
+      site_probs.col(j) = rdirichlet(Vector(num_sites, 1.0));
+    }
+    std::vector<int> class_indicators = rmulti_vector_mt(
+        GlobalRng::rng, 500, Vector{.2, .3, .5});
+    std::vector<Ptr<MultinomialFactorData>> data = simulate_data(
+        site_probs, class_indicators);
+
+    std::vector<Ptr<MultinomialFactorModel>> models;
+    for (int m = 0; m < 2; ++m) {
+      NEW(MultinomialFactorModel, model)(num_classes);
+      for (const auto &data_point : data) {
+        model->add_data(data_point);
+      }
+      RNG seeding_rng(12345);
+      NEW(MultinomialFactorModelPosteriorSampler, sampler)(
+          model.get(), Vector(num_classes, 1.0 / num_classes), seeding_rng);
+      sampler->set_number_of_threads(3);
+      model->set_method(sampler);
+      models.push_back(model);
+    }
+
+    for (int i = 0; i < 10; ++i) {
+      models[0]->sample_posterior();
+      models[1]->sample_posterior();
+    }
+
+    for (const auto &it : models[0]->visitors()) {
+      EXPECT_EQ(it.second->imputed_class_membership(),
+                models[1]->visitor(it.first)->imputed_class_membership());
+    }
+    for (int k = 0; k < num_classes; ++k) {
+      double total = 0;
+      for (const auto &it : models[0]->sites()) {
+        EXPECT_EQ(it.second->visit_probs(),
+                  models[1]->site(it.first)->visit_probs());
+        total += it.second->visit_probs()[k];
+      }
+      EXPECT_NEAR(1.0, total, 1e-8);
+    }
+  }
+
 }  // namespace
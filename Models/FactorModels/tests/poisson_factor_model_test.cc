@@ -268,6 +268,49 @@ namespace {
     //     << Sigma_draws;
   }
 
+  // A threaded sampler draws each shard from its own stream, so two threaded
+  // samplers seeded the same way produce the same draws.
+  TEST_F(PoissonFactorModelTest, ThreadedHierarchicalSamplerIsReproducible) {
+    int num_sites = 40;
+    Matrix site_lambdas(num_sites, 3);
+    for (int i = 0; i < num_sites; ++i) {
+      for (int j = 0; j < 3; ++j){
+        site_lambdas(i, j) = rgamma(0.8, 2.0);
+      }
+    }
+    std::vector<int> class_indicators = rmulti_vector_mt(
+        GlobalRng::rng, 300, Vector{.2, .3, .5});
+    std::vector<Ptr<PoissonFactorData>> data = simulate_data(
+        site_lambdas, class_indicators);
 
+    std::vector<Ptr<PoissonFactorModel>> models;
+    std::vector<Ptr<PoissonFactorHierarchicalSampler>> samplers;
+    for (int m = 0; m < 2; ++m) {
+      NEW(PoissonFactorModel, model)(3);
+      for (const auto &data_point : data) {
+        model->add_data(data_point);
+      }
+      RNG seeding_rng(12345);
+      NEW(PoissonFactorHierarchicalSampler, sampler)(
+          model.get(), Vector(3, 1.0 / 3), Vector(2, 0.0), 1.0,
+          SpdMatrix(2, 1.0), 3.0, 10, seeding_rng);
+      sampler->set_number_of_threads(4);
+      model->set_method(sampler);
+      models.push_back(model);
+      samplers.push_back(sampler);
+    }
+
+    for (int i = 0; i < 10; ++i) {
+      models[0]->sample_posterior();
+      models[1]->sample_posterior();
+    }
+
+    EXPECT_EQ(samplers[0]->exposure_counts(), samplers[1]->exposure_counts());
+    EXPECT_DOUBLE_EQ(300.0, sum(samplers[0]->exposure_counts()));
+    for (const auto &it : models[0]->sites()) {
+      EXPECT_EQ(it.second->lambda(), models[1]->site(it.first)->lambda());
+    }
+    EXPECT_EQ(samplers[0]->sampling_report(), samplers[1]->sampling_report());
+  }
 
 }  // namespace
@@ -0,0 +1,166 @@
+#include "gtest/gtest.h"
+#include "Models/FactorModels/MultinomialFactorModel.hpp"
+#include "Models/FactorModels/PoissonFactorModel.hpp"
+#include "Models/FactorModels/PosteriorSamplers/MultinomialFactorModelPosteriorSampler.hpp"
+#include "Models/FactorModels/PosteriorSamplers/PoissonFactorModelIndependentGammaPosteriorSampler.hpp"
+#include "Models/GammaModel.hpp"
+#include "distributions.hpp"
+
+#include "test_utils/test_utils.hpp"
+#include <string>
+
+namespace {
+  using namespace BOOM;
+  using std::endl;
+  using std::cout;
+
+  class VisitIndexTest : public ::testing::Test {
+   protected:
+    VisitIndexTest() {
+      GlobalRng::rng.seed(8675309);
+    }
+
+    // Record a random set of visits in the model.  Visit counts vary across
+    // visitor/site pairs, and many pairs have no visits at all.
+    template <class MODEL>
+    void simulate_visits(MODEL &model, int num_visitors, int num_sites) {
+      for (int i = 0; i < num_visitors; ++i) {
+        for (int j = 0; j < num_sites; ++j) {
+          int nvisits = rpois(.3 * (1 + (i + j) % 3));
+          if (nvisits > 0) {
+            model.record_visit("visitor" + std::to_string(i),
+                               "site" + std::to_string(j),
+                               nvisits);
+          }
+        }
+      }
+    }
+  };
+
+  // The row and column storage agree with the maps held by the visitors and
+  // sites.
+  TEST_F(VisitIndexTest, MatchesVisitorAndSiteMaps) {
+    PoissonFactorModel model(3);
+    simulate_visits(model, 50, 12);
+    const auto &index(model.visit_index());
+    ASSERT_EQ(model.number_of_visitors(), index.number_of_visitors());
+    ASSERT_EQ(model.number_of_sites(), index.number_of_sites());
+
+    Int i = 0;
+    Int total_visits = 0;
+    for (const auto &visitor_it : model.visitors()) {
+      const Ptr<PoissonFactorModel::Visitor> &visitor(visitor_it.second);
+      EXPECT_EQ(visitor.get(), index.visitor(i).get());
+      ASSERT_EQ(visitor->sites_visited().size(),
+                index.visitor_end(i) - index.visitor_begin(i));
+      Int e = index.visitor_begin(i);
+      for (const auto &it : visitor->sites_visited()) {
+        EXPECT_EQ(it.first.get(), index.site(index.visitor_sites()[e]).get());
+        EXPECT_EQ(it.second, index.visitor_visit_counts()[e]);
+        total_visits += it.second;
+        ++e;
+      }
+      ++i;
+    }
+    EXPECT_EQ(index.number_of_edges(), index.visitor_sites().size());
+
+    Int j = 0;
+    for (const auto &site_it : model.sites()) {
+      const Ptr<PoissonFactorModel::Site> &site(site_it.second);
+      EXPECT_EQ(site.get(), index.site(j).get());
+      ASSERT_EQ(site->observed_visitors().size(),
+                index.site_end(j) - index.site_begin(j));
+      for (Int e = index.site_begin(j); e < index.site_end(j); ++e) {
+        const auto &visitor(index.visitor(index.site_visitors()[e]));
+        auto it = site->observed_visitors().find(visitor);
+        ASSERT_TRUE(it != site->observed_visitors().end());
+        EXPECT_EQ(it->second, index.site_visit_counts()[e]);
+        total_visits -= it->second;
+        if (e > index.site_begin(j)) {
+          EXPECT_LT(index.site_visitors()[e - 1], index.site_visitors()[e]);
+        }
+      }
+      ++j;
+    }
+    EXPECT_EQ(0, total_visits);
+  }
+
+  // Recording a new visit invalidates the index.
+  TEST_F(VisitIndexTest, RebuildsAfterNewData) {
+    MultinomialFactorModel model(2);
+    model.record_visit("a", "x", 2);
+    EXPECT_EQ(1, model.visit_index().number_of_edges());
+    model.record_visit("b", "x", 1);
+    model.record_visit("a", "y", 1);
+    const auto &index(model.visit_index());
+    EXPECT_EQ(2, index.number_of_visitors());
+    EXPECT_EQ(2, index.number_of_sites());
+    EXPECT_EQ(3, index.number_of_edges());
+    // Site "x" is site 0, visited by "a" twice and "b" once.
+    EXPECT_EQ(0, index.site_begin(0));
+    EXPECT_EQ(2, index.site_end(0));
+    EXPECT_EQ(2, index.site_visit_counts()[0]);
+    EXPECT_EQ(1, index.site_visit_counts()[1]);
+
+    model.clear_data();
+    EXPECT_EQ(0, model.visit_index().number_of_visitors());
+    EXPECT_EQ(0, model.visit_index().number_of_edges());
+  }
+
+  // The per-site visit counts computed from the index match the counts
+  // computed one site at a time.
+  TEST_F(VisitIndexTest, SiteVisitCounts) {
+    PoissonFactorModel model(3);
+    simulate_visits(model, 80, 10);
+    std::vector<Ptr<GammaModelBase>> intensity_prior;
+    for (int k = 0; k < 3; ++k) {
+      intensity_prior.push_back(new GammaModel(1.0, 1.0));
+    }
+    NEW(PoissonFactorModelIndependentGammaPosteriorSampler, sampler)(
+        &model, Vector(3, 1.0 / 3), intensity_prior);
+    model.set_method(sampler);
+    model.sample_posterior();
+
+    Matrix counts = sampler->compute_site_visit_counts();
+    const auto &index(model.visit_index());
+    for (Int j = 0; j < index.number_of_sites(); ++j) {
+      EXPECT_EQ(Vector(counts.col(j)),
+                sampler->compute_visit_counts(*index.site(j)));
+    }
+  }
+
+  // The sweep over the index gives the same visitor imputations as imputing
+  // each visitor from its own map.
+  TEST_F(VisitIndexTest, MultinomialImputationMatchesMapWalk) {
+    MultinomialFactorModel model(3);
+    simulate_visits(model, 60, 8);
+    for (auto &site_it : model.sites()) {
+      Vector probs(3);
+      for (double &p : probs) p = runif(.01, .2);
+      site_it.second->set_probs(probs);
+    }
+    RNG indexed_seed(12345);
+    RNG map_seed(12345);
+    NEW(MultinomialFactorModelPosteriorSampler, indexed_sampler)(
+        &model, Vector(3, 1.0 / 3), indexed_seed);
+    NEW(MultinomialFactorModelPosteriorSampler, map_sampler)(
+        &model, Vector(3, 1.0 / 3), map_seed);
+
+    indexed_sampler->impute_visitors();
+    std::vector<Vector> indexed_probs;
+    std::vector<int> indexed_classes;
+    for (const auto &it : model.visitors()) {
+      indexed_probs.push_back(it.second->class_probabilities());
+      indexed_classes.push_back(it.second->imputed_class_membership());
+    }
+
+    int i = 0;
+    for (const auto &it : model.visitors()) {
+      map_sampler->impute_visitor(*it.second);
+      EXPECT_EQ(indexed_probs[i], it.second->class_probabilities());
+      EXPECT_EQ(indexed_classes[i], it.second->imputed_class_membership());
+      ++i;
+    }
+  }
+
+}  // namespace
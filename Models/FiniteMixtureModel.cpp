@@ -18,6 +18,7 @@
 */
 
 #include "Models/FiniteMixtureModel.hpp"
+#include "Samplers/McmcProfiler.hpp"
 #include "cpputil/lse.hpp"
 #include "distributions.hpp"
 
@@ -76,49 +77,130 @@ namespace BOOM {
     }
   }
 
-  void FMM::impute_latent_data(RNG &rng) {
-    const std::vector<Ptr<Data> > &d(dat());
-    std::vector<Ptr<CategoricalData> > hvec(latent_data());
+  namespace {
+    // The number of observations in each shard of a parallel imputation.
+    // This is fixed, rather than derived from the number of threads, so that
+    // the random numbers used for each observation do not depend on how many
+    // threads there are.
+    const int imputation_shard_size = 2000;
+  }  // namespace
 
-    uint n = d.size();
+  void FMM::impute_latent_data(RNG &rng) {
+    ScopedPhaseTimer timer(McmcProfiler::kImputeLatentData);
+    uint n = dat().size();
     uint S = number_of_mixture_components();
     class_membership_probabilities_.resize(n, S);
 
-    wsp_.resize(S);
     set_logpi();
-    last_loglike_ = 0;
-    const std::vector<Ptr<MixtureComponent> > &mod(mixture_components_);
-    Ptr<MultinomialModel> mix(mixing_dist_);
     clear_component_data();
-    for (uint i = 0; i < n; ++i) {
-      Ptr<Data> dp = d[i];
-      Ptr<CategoricalData> cd = hvec[i];
+    // The log densities are computed in bulk, and stored in the table of
+    // membership probabilities, which is overwritten row by row below.
+    compute_log_densities(class_membership_probabilities_);
+
+    int nshards = number_of_shards(n);
+    if (nshards <= 1) {
+      Vector counts(S, 0.0);
+      last_loglike_ = impute_shard(0, n, rng, mixture_components_, counts);
+      mixing_dist_->suf()->add_mixture_data(counts);
+      return;
+    }
+
+    prepare_shards(nshards);
+    RNG::RngIntType seed = seed_rng(rng);
+    pool_.parallel_for(0, nshards, 1, [&](int shard) {
+      RNG shard_rng(seed, shard);
+      ImputationShard &storage(shards_[shard]);
+      storage.loglike = impute_shard(
+          shard_begin(shard, n), shard_begin(shard + 1, n), shard_rng,
+          storage.components, storage.counts);
+    });
+    last_loglike_ = combine_shards();
+  }
+
+  double FMM::impute_shard(
+      int begin, int end, RNG &rng,
+      const std::vector<Ptr<MixtureComponent>> &components, Vector &counts) {
+    const std::vector<Ptr<Data>> &d(dat());
+    const std::vector<Ptr<CategoricalData>> &hvec(latent_data());
+    Vector wsp(number_of_mixture_components());
+    double loglike = 0;
+    // Observers of the latent indicators hear about the changes once, when
+    // the shard is finished.
+    DataSignalBatch signal_batch;
+    for (int i = begin; i < end; ++i) {
+      const Ptr<Data> &dp(d[i]);
+      const Ptr<CategoricalData> &cd(hvec[i]);
       if (dp->missing() != 0u) {
-        wsp_ = logpi_;
+        wsp = logpi_;
       } else if (which_mixture_component(i) > 0) {
         int source = which_mixture_component(i);
-        last_loglike_ += mod[source]->pdf(dp.get(), true);
+        loglike += class_membership_probabilities_(i, source);
         class_membership_probabilities_.row(i) = 0;
         class_membership_probabilities_(i, source) = 1.0;
         cd->set(source);
-        mix->add_data(cd);
-        mod[source]->add_data(dp);
+        ++counts[source];
+        components[source]->add_data(dp);
         continue;
       } else {
-        for (uint s = 0; s < S; ++s) {
-          wsp_[s] = logpi_[s] + mod[s]->pdf(dp.get(), true);
-        }
+        wsp = logpi_;
+        wsp += class_membership_probabilities_.row(i);
       }
-      last_loglike_ += lse(wsp_);
-      wsp_.normalize_logprob();
-      class_membership_probabilities_.row(i) = wsp_;
-      uint h = rmulti_mt(rng, wsp_);
+      loglike += lse(wsp);
+      wsp.normalize_logprob();
+      class_membership_probabilities_.row(i) = wsp;
+      uint h = rmulti_mt(rng, wsp);
       cd->set(h);
-      mod[h]->add_data(dp);
-      mix->add_data(cd);
+      components[h]->add_data(dp);
+      ++counts[h];
+    }
+    return loglike;
+  }
+
+  void FMM::set_number_of_threads(int n) { pool_.set_number_of_threads(n); }
+
+  int FMM::number_of_shards(int sample_size) {
+    return (sample_size + imputation_shard_size - 1) / imputation_shard_size;
+  }
+
+  int FMM::shard_begin(int shard, int sample_size) {
+    return std::min<int64_t>(
+        static_cast<int64_t>(shard) * imputation_shard_size, sample_size);
+  }
+
+  void FMM::prepare_shards(int nshards) {
+    int S = number_of_mixture_components();
+    if (shards_.size() != nshards) {
+      shards_.resize(nshards);
+    }
+    for (auto &shard : shards_) {
+      if (shard.components.size() != S) {
+        shard.components.clear();
+        for (int s = 0; s < S; ++s) {
+          shard.components.push_back(mixture_components_[s]->clone());
+        }
+      }
+      for (int s = 0; s < S; ++s) {
+        shard.components[s]->clear_data();
+      }
+      shard.counts.resize(S);
+      shard.counts = 0.0;
+      shard.loglike = 0;
     }
   }
 
+  double FMM::combine_shards() {
+    int S = number_of_mixture_components();
+    double loglike = 0;
+    for (const auto &shard : shards_) {
+      for (int s = 0; s < S; ++s) {
+        mixture_components_[s]->combine_data(*shard.components[s], true);
+      }
+      mixing_dist_->suf()->add_mixture_data(shard.counts);
+      loglike += shard.loglike;
+    }
+    return loglike;
+  }
+
   int FMM::impute_observation(const Ptr<Data> &data, RNG &rng,
                               bool update_complete_data_suf) {
     int component = impute_observation(data, rng);
@@ -151,6 +233,15 @@ namespace BOOM {
     ans.normalize_logprob();
   }
 
+  void FMM::compute_log_densities(Matrix &log_densities) const {
+    const std::vector<Ptr<Data>> &data(dat());
+    int S = number_of_mixture_components();
+    log_densities.resize(data.size(), S);
+    for (int s = 0; s < S; ++s) {
+      mixture_components_[s]->pdf_batch(data, log_densities.col(s), true);
+    }
+  }
+
   double FMM::last_loglike() const { return last_loglike_; }
 
   void FMM::set_observers() {
@@ -270,11 +361,12 @@ namespace BOOM {
     const Vector &log_pi(logpi());
     Vector wsp(S);
     double ans = 0;
+    Matrix log_densities;
+    compute_log_densities(log_densities);
 
     for (uint i = 0; i < n; ++i) {
-      for (uint s = 0; s < S; ++s) {
-        wsp[s] = log_pi[s] + mixture_component(s)->pdf(d[i].get(), true);
-      }
+      wsp = log_pi;
+      wsp += log_densities.row(i);
       ans += lse(wsp);
     }
     return ans;
@@ -294,28 +386,62 @@ namespace BOOM {
 
   double EmFiniteMixtureModel::EStep() {
     clear_component_data();
-    Vector &wsp(wsp_);
-    wsp.resize(number_of_mixture_components());
-    const std::vector<Ptr<Data> > &data(dat());
-    double ans = 0;
-    const Vector &log_pi(logpi());
-    for (int i = 0; i < data.size(); ++i) {
-      for (int s = 0; s < number_of_mixture_components(); ++s) {
-        wsp[s] = log_pi[s] + mixture_component(s)->pdf(data[i].get(), true);
+    int n = dat().size();
+    int S = number_of_mixture_components();
+    set_logpi();
+    Matrix log_densities;
+    compute_log_densities(log_densities);
+
+    int nshards = number_of_shards(n);
+    if (nshards <= 1) {
+      std::vector<EmMixtureComponent *> components;
+      for (const auto &component : em_mixture_components_) {
+        components.push_back(component.get());
+      }
+      Vector counts(S, 0.0);
+      double ans = estep_shard(0, n, log_densities, components, counts);
+      mixing_distribution()->suf()->add_mixture_data(counts);
+      return ans;
+    }
+
+    prepare_shards(nshards);
+    pool_.parallel_for(0, nshards, 1, [&](int shard) {
+      ImputationShard &storage(shards_[shard]);
+      std::vector<EmMixtureComponent *> components;
+      for (const auto &component : storage.components) {
+        components.push_back(
+            dynamic_cast<EmMixtureComponent *>(component.get()));
       }
+      storage.loglike = estep_shard(
+          shard_begin(shard, n), shard_begin(shard + 1, n), log_densities,
+          components, storage.counts);
+    });
+    return combine_shards();
+  }
+
+  double EmFiniteMixtureModel::estep_shard(
+      int begin, int end, const Matrix &log_densities,
+      const std::vector<EmMixtureComponent *> &components, Vector &counts) {
+    const std::vector<Ptr<Data>> &data(dat());
+    const Vector &log_pi(logpi());
+    int S = number_of_mixture_components();
+    Vector wsp(S);
+    double ans = 0;
+    for (int i = begin; i < end; ++i) {
+      wsp = log_pi;
+      wsp += log_densities.row(i);
       double total = lse(wsp);
       ans += total;
       double normalizing_constant = 0;
-      for (int s = 0; s < number_of_mixture_components(); ++s) {
+      for (int s = 0; s < S; ++s) {
         wsp[s] = exp(wsp[s] - total);
         normalizing_constant += wsp[s];
       }
-      for (int s = 0; s < number_of_mixture_components(); ++s) {
-        em_mixture_components_[s]->add_mixture_data(
-            data[i], wsp[s] / normalizing_constant);
+      wsp /= normalizing_constant;
+      for (int s = 0; s < S; ++s) {
+        components[s]->add_mixture_data(data[i], wsp[s]);
       }
-      mixing_distribution()->suf()->add_mixture_data(wsp /
-                                                     normalizing_constant);
+      counts += wsp;
     }
     return ans;
   }
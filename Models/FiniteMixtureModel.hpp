@@ -26,6 +26,7 @@
 #include "Models/ParamTypes.hpp"
 #include "Models/Policies/CompositeParamPolicy.hpp"
 #include "Models/Policies/MixtureDataPolicy.hpp"
+#include "cpputil/ThreadTools.hpp"
 
 namespace BOOM {
 
@@ -81,13 +82,58 @@ namespace BOOM {
     // impute_latent_data().
     Vector class_assignment() const;
 
+    // Set the number of threads used by impute_latent_data() and, for
+    // EmFiniteMixtureModel, the EStep.  The data are divided into shards of
+    // a fixed size, regardless of the number of threads.  Each shard draws
+    // from its own random number stream and the shards are combined in
+    // order, so for a given seed the results do not depend on the number of
+    // threads.
+    void set_number_of_threads(int n);
+
    protected:
     void set_logpi() const;
     mutable Vector wsp_;
 
+    // The working storage for one shard of the data.
+    struct ImputationShard {
+      // Empty copies of the mixture components, used only to accumulate the
+      // complete data assigned to each component.
+      std::vector<Ptr<MixtureComponent>> components;
+
+      // The (possibly fractional) number of observations assigned to each
+      // component.
+      Vector counts;
+
+      // The contribution of the shard to the observed data log likelihood.
+      double loglike;
+    };
+
+    // The number of shards needed for a data set of size 'sample_size'.
+    static int number_of_shards(int sample_size);
+
+    // The first observation in the given shard.  The shard ends where the
+    // next one begins.
+    static int shard_begin(int shard, int sample_size);
+
+    // Resize shards_ to hold 'nshards' shards and clear their accumulators.
+    void prepare_shards(int nshards);
+
+    // Add the complete data accumulated in shards_ to the mixture components
+    // and the mixing distribution, in shard order.  Returns the sum of the
+    // shard log likelihoods.
+    double combine_shards();
+
+    std::vector<ImputationShard> shards_;
+    SharedThreadPool pool_;
+
     // Save the class membership probabilities for user i.
     void update_class_membership_probabilities(int i, const Vector &probs);
 
+    // Fill 'log_densities' with the log density of each data point (rows)
+    // under each mixture component (columns).  Each column is computed with a
+    // single call to MixtureComponent::pdf_batch.
+    void compute_log_densities(Matrix &log_densities) const;
+
    private:
     std::vector<Ptr<MixtureComponent>> mixture_components_;
     Ptr<MultinomialModel> mixing_dist_;
@@ -95,6 +141,15 @@ namespace BOOM {
     mutable bool logpi_current_;
     void observe_pi() const;
     void set_observers();
+
+    // Impute the latent data for observations [begin, end), adding the
+    // complete data to 'components' and the class counts to 'counts'.  The
+    // log densities must already be stored in
+    // class_membership_probabilities_.  Returns the log likelihood
+    // contribution of the imputed observations.
+    double impute_shard(int begin, int end, RNG &rng,
+                        const std::vector<Ptr<MixtureComponent>> &components,
+                        Vector &counts);
     virtual std::vector<Ptr<MixtureComponent>> models();
     virtual const std::vector<Ptr<MixtureComponent>> models() const;
     double last_loglike_;
@@ -162,6 +217,12 @@ namespace BOOM {
    private:
     std::vector<Ptr<EmMixtureComponent>> em_mixture_components_;
     void populate_em_mixture_components();
+
+    // Accumulate the expected complete data for observations [begin, end)
+    // in 'components' and 'counts', returning their log likelihood.
+    double estep_shard(int begin, int end, const Matrix &log_densities,
+                       const std::vector<EmMixtureComponent *> &components,
+                       Vector &counts);
   };
 
 }  // namespace BOOM
@@ -17,17 +17,60 @@
 */
 
 #include "Models/GP/GaussianProcessRegressionModel.hpp"
+#include "cpputil/Constants.hpp"
 #include "cpputil/report_error.hpp"
 #include "distributions.hpp"
+#include "LinAlg/SubMatrix.hpp"
+#include <algorithm>
 
 namespace BOOM {
 
+  namespace {
+    // The number of observations whose features are summed into the
+    // Woodbury matrix at once by refresh_approximation.
+    const int approximation_block_size = 256;
+
+    // The number of prediction points whose kernel values are computed
+    // together, as one task for the thread pool.
+    const int prediction_block_size = 64;
+
+    // Fill an nrow x ncol matrix in blocks of columns, in parallel if the
+    // pool has threads.  block(begin, end) must return the nrow x
+    // (end - begin) matrix holding columns begin..end-1.
+    template <class BlockFunction>
+    Matrix fill_column_blocks(int nrow, int ncol, SharedThreadPool &pool,
+                              BlockFunction block) {
+      Matrix ans(nrow, ncol);
+      if (nrow == 0 || ncol == 0) {
+        return ans;
+      }
+      int number_of_blocks =
+          (ncol + prediction_block_size - 1) / prediction_block_size;
+      pool.parallel_for(0, number_of_blocks, 1, [&](int b) {
+        int begin = b * prediction_block_size;
+        int end = std::min(ncol, begin + prediction_block_size);
+        SubMatrix(ans, 0, nrow - 1, begin, end - 1) = block(begin, end);
+      });
+      return ans;
+    }
+
+    Matrix row_block(const Matrix &X, int begin, int end) {
+      return Matrix(ConstSubMatrix(X, begin, end - 1, 0, X.ncol() - 1));
+    }
+  }  // namespace
+
   GaussianProcessRegressionModel::GaussianProcessRegressionModel(
       const Ptr<FunctionParams> &mean_function,
       const Ptr<KernelParams> &kernel,
       const Ptr<UnivParams> &sigsq)
       : ParamPolicy(mean_function, kernel, sigsq),
-        kernel_matrix_current_(false)
+        kernel_matrix_current_(false),
+        factored_sample_size_(0),
+        inverse_kernel_residuals_current_(false),
+        Kinv_current_(false),
+        approximate_log_likelihood_(negative_infinity()),
+        training_predictors_current_(false),
+        distance_cache_current_(false)
   {
     add_observers();
   }
@@ -35,11 +78,22 @@ namespace BOOM {
   GaussianProcessRegressionModel::GaussianProcessRegressionModel(
       const GaussianProcessRegressionModel &rhs)
       : Model(rhs),
-        ParamPolicy(Ptr<FunctionParams>(mean_param()->clone()),
-                    Ptr<KernelParams>(kernel_param()->clone()),
-                    Ptr<UnivParams>(sigsq_param()->clone())),
+        ParamPolicy(Ptr<FunctionParams>(rhs.mean_param()->clone()),
+                    Ptr<KernelParams>(rhs.kernel_param()->clone()),
+                    Ptr<UnivParams>(rhs.sigsq_param()->clone())),
         DataPolicy(rhs),
-        PriorPolicy(rhs)
+        PriorPolicy(rhs),
+        kernel_matrix_current_(false),
+        factored_sample_size_(0),
+        inverse_kernel_residuals_current_(false),
+        Kinv_current_(false),
+        approximation_(rhs.approximation_
+                       ? rhs.approximation_->clone()
+                       : nullptr),
+        approximate_log_likelihood_(negative_infinity()),
+        pool_(rhs.pool_),
+        training_predictors_current_(false),
+        distance_cache_current_(false)
   {
     add_observers();
   }
@@ -49,8 +103,98 @@ namespace BOOM {
     return new GaussianProcessRegressionModel(*this);
   }
 
+  const SpdMatrix &GaussianProcessRegressionModel::inverse_kernel_matrix()
+      const {
+    if (approximation_) {
+      report_error("The inverse kernel matrix is not available when a kernel "
+                   "approximation is in use.");
+    }
+    refresh_kernel_matrix();
+    if (!Kinv_current_) {
+      Kinv_ = dat().empty() ? SpdMatrix() : kernel_chol_.inv();
+      Kinv_current_ = true;
+    }
+    return Kinv_;
+  }
+
+  const Vector &GaussianProcessRegressionModel::inverse_kernel_residuals()
+      const {
+    refresh_kernel_matrix();
+    if (!inverse_kernel_residuals_current_) {
+      inverse_kernel_residuals_ = residuals_;
+      if (!residuals_.empty()) {
+        kernel_chol_.solve_inplace(VectorView(inverse_kernel_residuals_));
+      }
+      inverse_kernel_residuals_current_ = true;
+    }
+    return inverse_kernel_residuals_;
+  }
+
+  const Matrix &GaussianProcessRegressionModel::training_predictors() const {
+    const std::vector<Ptr<RegressionData>> &data(dat());
+    int nobs = data.size();
+    if (training_predictors_current_ && training_predictors_.nrow() == nobs) {
+      return training_predictors_;
+    }
+    training_predictors_.resize(nobs, xdim());
+    for (int i = 0; i < nobs; ++i) {
+      training_predictors_.row(i) = data[i]->x();
+    }
+    training_predictors_current_ = true;
+    distance_cache_current_ = false;
+    return training_predictors_;
+  }
+
+  Matrix GaussianProcessRegressionModel::training_cross_kernel(
+      const Matrix &X) const {
+    const KernelParams &kernel(*kernel_param());
+    const Matrix &predictors(training_predictors());
+    if (!kernel.depends_only_on_squared_distance()) {
+      return blocked_cross_kernel(predictors, X);
+    }
+
+    int nobs = predictors.nrow();
+    if (!distance_cache_current_ || !(distance_cache_points_ == X)) {
+      distance_cache_ = fill_column_blocks(
+          nobs, X.nrow(), pool_, [&](int begin, int end) {
+            return squared_distances(predictors, row_block(X, begin, end));
+          });
+      distance_cache_points_ = X;
+      distance_cache_current_ = true;
+    }
+    return fill_column_blocks(
+        nobs, X.nrow(), pool_, [&](int begin, int end) {
+          return kernel.kernel_from_squared_distances(Matrix(ConstSubMatrix(
+              distance_cache_, 0, nobs - 1, begin, end - 1)));
+        });
+  }
+
+  Matrix GaussianProcessRegressionModel::blocked_cross_kernel(
+      const Matrix &X1, const Matrix &X2) const {
+    const KernelParams &kernel(*kernel_param());
+    return fill_column_blocks(
+        X1.nrow(), X2.nrow(), pool_, [&](int begin, int end) {
+          return kernel.cross_kernel(X1, row_block(X2, begin, end));
+        });
+  }
+
+  void GaussianProcessRegressionModel::set_kernel_approximation(
+      const Ptr<GP::KernelApproximation> &approximation) {
+    approximation_ = approximation;
+    kernel_matrix_current_ = false;
+    // Release the memory held by the exact calculations.
+    kernel_chol_ = Cholesky();
+    Kinv_ = SpdMatrix();
+    Kinv_current_ = false;
+  }
+
   double GaussianProcessRegressionModel::predict(const Vector &x) const {
     refresh_kernel_matrix();
+    if (approximation_) {
+      return mean_function(x) +
+             approximation_->features(*kernel_param(), x).dot(
+                 woodbury_coefficients_);
+    }
 
     // The vector of kernel values of the new x against the training data.
     const std::vector<Ptr<RegressionData>> & data(dat());
@@ -60,42 +204,100 @@ namespace BOOM {
       Kstrip(i) = kernel(x, data[i]->x());
     }
 
-    return mean_function(x) + Kstrip.dot(Kinv_ * residuals_);
+    return mean_function(x) + Kstrip.dot(inverse_kernel_residuals());
+  }
+
+  Vector GaussianProcessRegressionModel::predict(const Matrix &X) const {
+    refresh_kernel_matrix();
+    int nx = X.nrow();
+    Vector ans(nx);
+    if (approximation_) {
+      const KernelParams &kernel(*kernel_param());
+      for (int i = 0; i < nx; ++i) {
+        ans[i] = approximation_->features(kernel, X.row(i)).dot(
+            woodbury_coefficients_);
+      }
+    } else if (sample_size() > 0) {
+      ans = training_cross_kernel(X).Tmult(inverse_kernel_residuals());
+    }
+    for (int i = 0; i < nx; ++i) {
+      ans[i] += mean_function(X.row(i));
+    }
+    return ans;
   }
 
   Ptr<MvnBase> GaussianProcessRegressionModel::predict_distribution(
       const Matrix &X, bool predict_data) const {
     refresh_kernel_matrix();
+    if (approximation_) {
+      return approximate_predict_distribution(X, predict_data);
+    }
 
-    const std::vector<Ptr<RegressionData>> & data(dat());
-    int nobs = data.size();
+    int nobs = sample_size();
     int nx = X.nrow();
 
-    Matrix Kstrip(nobs, nx);
     Vector yhat(nx);
-
-    SpdMatrix base_variance(nx);
     for (int i = 0; i < nx; ++i) {
       yhat[i] = mean_function(X.row(i));
-      for (int j = 0; j <= i; ++j) {
-        base_variance(i, j) = kernel(X.row(i), X.row(j));
-        if (j < i) {
-          base_variance(j, i) = base_variance(i, j);
-        } else if(i == j && predict_data) {
-          base_variance(i, i) += residual_variance();
-        }
-      }
     }
 
-    for (int j = 0; j < nx; ++j) {
-      for (int i = 0; i < nobs; ++i) {
-        Kstrip(i, j) = kernel(data[i]->x(), X.row(j));
-      }
+    SpdMatrix base_variance(blocked_cross_kernel(X, X), false);
+    base_variance.fix_near_symmetry();
+    if (predict_data) {
+      base_variance.diag() += residual_variance();
     }
 
-    Vector mean = yhat + Kstrip.Tmult(Kinv_ * residuals_);
-    SpdMatrix variance = base_variance + Kstrip.Tmult(
-        inverse_kernel_matrix() * Kstrip);
+    Matrix Kstrip = training_cross_kernel(X);
+
+    // The posterior variance is K(X, X) - K(X, x)' Kinv K(X, x).  With
+    // Kinv = (LL')^{-1}, the second term is V'V for V = L^{-1} K(X, x).
+    Vector mean = yhat + Kstrip.Tmult(inverse_kernel_residuals());
+    SpdMatrix variance = base_variance;
+    if (nobs > 0) {
+      variance -= Lsolve(kernel_chol_.getL(false), Kstrip).inner();
+    }
+
+    if (predict_data) {
+      return new MvnModel(mean, variance);
+    } else {
+      return new LowRankMvnModel(mean, variance);
+    }
+  }
+
+  // Under the approximation, the covariance of the function values at X given
+  // the training data is U + Phi A^{-1} Phi', where U is the unexplained
+  // covariance and Phi holds the features of the rows of X.
+  Ptr<MvnBase> GaussianProcessRegressionModel::approximate_predict_distribution(
+      const Matrix &X, bool predict_data) const {
+    const KernelParams &kernel(*kernel_param());
+    int nx = X.nrow();
+    std::vector<Vector> features;
+    features.reserve(nx);
+    Matrix Phi(nx, approximation_->dim());
+    Vector mean(nx);
+    for (int i = 0; i < nx; ++i) {
+      features.push_back(approximation_->features(kernel, X.row(i)));
+      Phi.row(i) = features.back();
+      mean[i] = mean_function(X.row(i)) +
+                features.back().dot(woodbury_coefficients_);
+    }
+
+    SpdMatrix variance(Phi * woodbury_chol_.solve(Phi.transpose()));
+    for (int i = 0; i < nx; ++i) {
+      for (int j = 0; j <= i; ++j) {
+        double unexplained = approximation_->unexplained_covariance(
+            kernel, X.row(i), X.row(j), features[i], features[j]);
+        if (i == j) {
+          variance(i, i) += std::max(unexplained, 0.0);
+          if (predict_data) {
+            variance(i, i) += residual_variance();
+          }
+        } else {
+          variance(i, j) += unexplained;
+          variance(j, i) = variance(i, j);
+        }
+      }
+    }
 
     if (predict_data) {
       return new MvnModel(mean, variance);
@@ -111,14 +313,30 @@ namespace BOOM {
     sigsq_param()->add_observer(this, obs);
   }
 
+  // The posterior mean at the training data is mu + K(X) Kinv r, where r is
+  // the vector of residuals from the mean function.  Because
+  // K(X) = (K(X) + sigsq) - sigsq, the posterior residuals are
+  // sigsq * Kinv r, so no kernel evaluations are needed.
   Vector GaussianProcessRegressionModel::posterior_residuals() const {
+    Vector ans;
+    fill_posterior_residuals(ans);
+    return ans;
+  }
+
+  void GaussianProcessRegressionModel::fill_posterior_residuals(
+      Vector &ans) const {
+    refresh_kernel_matrix();
+    if (!approximation_) {
+      ans = inverse_kernel_residuals();
+      ans *= residual_variance();
+      return;
+    }
     const std::vector<Ptr<RegressionData>> &data(dat());
     size_t sample_size = data.size();
-    Vector ans(sample_size);
+    ans.resize(sample_size);
     for (size_t i = 0; i < sample_size; ++i) {
       ans[i] = data[i]->y() - predict(data[i]->x());
     }
-    return ans;
   }
 
   double GaussianProcessRegressionModel::loglike(const Vector &theta) const {
@@ -139,40 +357,137 @@ namespace BOOM {
     size_t sample_size = data.size();
 
     refresh_kernel_matrix();
-    Vector mu(sample_size);
-    Vector y(sample_size);
-    for (size_t i = 0; i < sample_size; ++i) {
-      mu[i] = mean_function(data[i]->x());
-      y[i] = data[i]->y();
+    if (approximation_) {
+      return approximate_log_likelihood_;
     }
-    return dmvn(y, mu, Kinv_, true);
+    return -0.5 * (sample_size * Constants::log_2pi
+                   + kernel_chol_.logdet()
+                   + residuals_.dot(inverse_kernel_residuals()));
   }
 
   void GaussianProcessRegressionModel::refresh_kernel_matrix() const {
-    if (kernel_matrix_current_) {
+    const std::vector<Ptr<RegressionData>> & data(dat());
+    int nobs = data.size();
+    if (kernel_matrix_current_ && factored_sample_size_ == nobs) {
       return;
     }
 
+    if (approximation_) {
+      refresh_approximation();
+    } else if (kernel_matrix_current_ && factored_sample_size_ > 0
+               && factored_sample_size_ < nobs) {
+      extend_kernel_matrix();
+    } else {
+      residuals_.resize(nobs);
+      SpdMatrix K(nobs);
+
+      for (size_t i = 0; i < nobs; ++i) {
+        residuals_[i] = data[i]->y() - mean_function(data[i]->x());
+        for (size_t j = 0; j <= i; ++j) {
+          K(i, j) = kernel(data[i]->x(), data[j]->x());
+          if (j < i) {
+            K(j, i) = K(i, j);
+          }
+        }
+      }
+
+      K.diag() += residual_variance();
+      if (nobs > 0) {
+        // Decomposing into the existing factor reuses its storage, which
+        // matters because the kernel sampler refactors K at every step.
+        kernel_chol_.decompose(K);
+        if (!kernel_chol_.is_pos_def()) {
+          report_error("The kernel matrix is not positive definite.");
+        }
+      } else {
+        kernel_chol_ = Cholesky();
+      }
+    }
+    kernel_matrix_current_ = true;
+    factored_sample_size_ = nobs;
+    inverse_kernel_residuals_current_ = false;
+    Kinv_current_ = false;
+  }
+
+  void GaussianProcessRegressionModel::extend_kernel_matrix() const {
     const std::vector<Ptr<RegressionData>> & data(dat());
     int nobs = data.size();
+    double sigsq = residual_variance();
+    for (int i = factored_sample_size_; i < nobs; ++i) {
+      const Vector &x(data[i]->x());
+      Vector column(i + 1);
+      for (int j = 0; j < i; ++j) {
+        column[j] = kernel(data[j]->x(), x);
+      }
+      column[i] = kernel(x, x) + sigsq;
+      if (!kernel_chol_.add_row_col(i, column)) {
+        report_error("The kernel matrix is not positive definite.");
+      }
+      residuals_.push_back(data[i]->y() - mean_function(x));
+    }
+  }
 
-    residuals_.resize(nobs);
-    SpdMatrix K(nobs);
+  // With residuals r and the notation from the class comments, the log
+  // likelihood is
+  //
+  //   -.5 * (n log(2 pi) + log|A| + sum(log D) + r'D^{-1}r - b'A^{-1}b + t),
+  //
+  // where b = Phi' D^{-1} r, and t is the VFE trace penalty: the total
+  // unexplained variance at the training points divided by the residual
+  // variance.  Only sums over the data are needed, so the features of each
+  // observation are used once and then discarded.
+  void GaussianProcessRegressionModel::refresh_approximation() const {
+    const std::vector<Ptr<RegressionData>> &data(dat());
+    int nobs = data.size();
+    const KernelParams &kernel(*kernel_param());
+    approximation_->refresh(kernel);
+    int dim = approximation_->dim();
+    bool fitc = approximation_->adds_unexplained_variance_to_residuals();
+    double sigsq = residual_variance();
 
-    for (size_t i = 0; i < nobs; ++i) {
-      residuals_[i] = data[i]->y() - mean_function(data[i]->x());
-      for (size_t j = 0; j <= i; ++j) {
-        K(i, j) = kernel(data[i]->x(), data[j]->x());
-        if (j < i) {
-          K(j, i) = K(i, j);
+    SpdMatrix woodbury_matrix(dim, 0.0);
+    Vector b(dim, 0.0);
+    double sum_log_variance = 0;
+    double weighted_sum_of_squares = 0;
+    double trace_penalty = 0;
+    for (int start = 0; start < nobs; start += approximation_block_size) {
+      int block_size = std::min(approximation_block_size, nobs - start);
+      Matrix features(block_size, dim);
+      Vector weights(block_size);
+      for (int i = 0; i < block_size; ++i) {
+        const Vector &x(data[start + i]->x());
+        Vector phi = approximation_->features(kernel, x);
+        double unexplained = std::max(
+            0.0, approximation_->unexplained_covariance(kernel, x, x, phi, phi));
+        double variance = sigsq;
+        if (fitc) {
+          variance += unexplained;
+        } else {
+          trace_penalty += unexplained / sigsq;
         }
+        double residual = data[start + i]->y() - mean_function(x);
+        features.row(i) = phi;
+        weights[i] = 1.0 / variance;
+        b.axpy(phi, residual / variance);
+        sum_log_variance += log(variance);
+        weighted_sum_of_squares += square(residual) / variance;
       }
+      woodbury_matrix.add_inner(features, weights);
     }
-
-    Kfunc_ = K;
-    K.diag() += residual_variance();
-    Kinv_ = K.inv();
-    kernel_matrix_current_ = true;
+    woodbury_matrix.diag() += 1.0;
+    woodbury_chol_.decompose(woodbury_matrix);
+    if (!woodbury_chol_.is_pos_def()) {
+      report_error("The Woodbury matrix in the kernel approximation is not "
+                   "positive definite.");
+    }
+    woodbury_coefficients_ = woodbury_chol_.solve(b);
+    approximate_log_likelihood_ = -0.5 * (
+        nobs * Constants::log_2pi
+        + woodbury_chol_.logdet()
+        + sum_log_variance
+        + weighted_sum_of_squares
+        - b.dot(woodbury_coefficients_)
+        + trace_penalty);
   }
 
 }  // namespace BOOM
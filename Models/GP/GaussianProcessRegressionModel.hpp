@@ -19,6 +19,7 @@
 */
 
 #include "Models/GP/GpMeanFunction.hpp"
+#include "Models/GP/KernelApproximation.hpp"
 #include "Models/GP/kernels.hpp"
 #include "Models/Policies/ParamPolicy_3.hpp"
 #include "Models/Policies/IID_DataPolicy.hpp"
@@ -27,6 +28,8 @@
 #include "LinAlg/Vector.hpp"
 #include "LinAlg/Matrix.hpp"
 #include "LinAlg/SpdMatrix.hpp"
+#include "LinAlg/Cholesky.hpp"
+#include "cpputil/ThreadTools.hpp"
 
 #include "Models/Glm/Glm.hpp"
 #include "Models/MvnModel.hpp"
@@ -46,6 +49,10 @@ namespace BOOM {
   // Both the mean function and the kernel function may depend on model
   // parameters.  Any such dependence is encapsulated by wrapping these
   // functions in FunctionParams and KernelParams objects.
+  //
+  // Exact computations with n data points take O(n^3) time and O(n^2)
+  // memory.  For large data sets the kernel can be replaced by a low rank
+  // GP::KernelApproximation using set_kernel_approximation.
   class GaussianProcessRegressionModel :
       public ParamPolicy_3<FunctionParams, KernelParams, UnivParams>,
       public IID_DataPolicy<RegressionData>,
@@ -118,19 +125,40 @@ namespace BOOM {
     }
 
     // The inverse of the kernel matrix (K(X) + sigsq) evaluated at the training
-    // data.
-    const SpdMatrix &inverse_kernel_matrix() const {
-      refresh_kernel_matrix();
-      return Kinv_;
+    // data.  This is only available if no kernel approximation is in use.
+    const SpdMatrix &inverse_kernel_matrix() const;
+
+    // Base likelihood and prediction calculations on a low rank
+    // approximation to the kernel.  With m features, refreshing the model
+    // after a parameter change costs O(n * m^2) time and O(m^2) memory.
+    //
+    // Args:
+    //   approximation: The approximation to use.  A nullptr restores the
+    //     exact calculations.
+    void set_kernel_approximation(
+        const Ptr<GP::KernelApproximation> &approximation);
+
+    const Ptr<GP::KernelApproximation> &kernel_approximation() const {
+      return approximation_;
     }
 
     //----------- Data access
 
+    // Data points added after the kernel matrix was last refreshed are
+    // appended to its Cholesky decomposition in O(n^2) operations each, so
+    // adding points one at a time does not force an O(n^3) refresh.
     using DataPolicy::add_data;
 
-    void add_data(const Ptr<RegressionData> &data_point) override {
+    void clear_data() override {
+      kernel_matrix_current_ = false;
+      training_predictors_current_ = false;
+      DataPolicy::clear_data();
+    }
+
+    void remove_data(const Ptr<Data> &data_point) override {
       kernel_matrix_current_ = false;
-      DataPolicy::add_data(data_point);
+      training_predictors_current_ = false;
+      DataPolicy::remove_data(data_point);
     }
 
     size_t sample_size() const {return dat().size();}
@@ -141,6 +169,18 @@ namespace BOOM {
     //----------- Prediction
     double predict(const Vector &x) const;
 
+    // The posterior mean of the function at each row of X.  Kernel values
+    // between X and the training data are computed in blocks of rows of X,
+    // which is much faster than calling predict() one row at a time.
+    Vector predict(const Matrix &X) const;
+
+    // Compute kernel values between the training data and new points using
+    // threads from the global thread pool.  The default of zero threads
+    // does all the work in the calling thread.
+    void set_number_of_threads(int number_of_threads) {
+      pool_.set_number_of_threads(number_of_threads);
+    }
+
     // Compute the predictive distribution of the data at specific X points.
     // This distribution incorporates the residual error around specific data
     // points.
@@ -161,6 +201,11 @@ namespace BOOM {
 
     Vector posterior_residuals() const;
 
+    // The same values as posterior_residuals(), written into 'ans', which is
+    // resized if needed.  Lets a posterior sampler reuse its storage from
+    // one MCMC iteration to the next.
+    void fill_posterior_residuals(Vector &ans) const;
+
     double loglike(const Vector &theta) const override;
     double log_likelihood() const override {
       return evaluate_log_likelihood();
@@ -169,30 +214,99 @@ namespace BOOM {
    private:
     double evaluate_log_likelihood() const;
 
+    // True if the quantities below describe the first factored_sample_size_
+    // data points under the current parameters.
     mutable bool kernel_matrix_current_;
+    mutable int factored_sample_size_;
 
-    // The inverse of the kernel matrix based on the training data.  This matrix
-    // includes contributions from the residual variance, so it describes
-    // individual data points.  This one is for "prediction intervals" not
-    // "confidence intervals."
-    mutable SpdMatrix Kinv_;
-
-    // The kernel matrix based on the training data.  This matrix omits
-    // contributions from the residual variance, so it describes covariance of
-    // the posterior mean function.  As such, its values may be highly
-    // correlated.  It should not be inverted directly.
-    mutable SpdMatrix Kfunc_;
+    // The Cholesky decomposition of the kernel matrix K(X) + sigsq * I based
+    // on the training data.  This matrix includes contributions from the
+    // residual variance, so it describes individual data points.  This one
+    // is for "prediction intervals" not "confidence intervals."
+    mutable Cholesky kernel_chol_;
 
     // The residuals from the prior mean function.
     mutable Vector residuals_;
 
+    // (K(X) + sigsq)^{-1} * residuals_, computed on demand.
+    mutable Vector inverse_kernel_residuals_;
+    mutable bool inverse_kernel_residuals_current_;
+
+    // The inverse of the kernel matrix, computed on demand for
+    // inverse_kernel_matrix().
+    mutable SpdMatrix Kinv_;
+    mutable bool Kinv_current_;
+
+    // If set, the kernel is approximated by phi(x1)' phi(x2).  The
+    // covariance of the training data is then Phi * Phi' + D, where Phi has
+    // one row of features per observation, and D is a diagonal matrix
+    // holding the residual variance, plus any unexplained variance added by
+    // the approximation.
+    Ptr<GP::KernelApproximation> approximation_;
+
+    // The Cholesky decomposition of the m x m matrix
+    // A = I + Phi' D^{-1} Phi.  By the Woodbury identity, the inverse of the
+    // training covariance is D^{-1} - D^{-1} Phi A^{-1} Phi' D^{-1}.
+    mutable Cholesky woodbury_chol_;
+
+    // A^{-1} Phi' D^{-1} * residuals_.  The posterior mean at x is
+    // mean_function(x) + phi(x)' * woodbury_coefficients_.
+    mutable Vector woodbury_coefficients_;
+
+    // The log likelihood under the approximation, computed along with the
+    // Woodbury terms.
+    mutable double approximate_log_likelihood_;
+
+    // Threads used to compute kernel values in blocks of new points.
+    mutable SharedThreadPool pool_;
+
+    // The predictors from the training data, stacked as rows of a matrix.
+    mutable Matrix training_predictors_;
+    mutable bool training_predictors_current_;
+
+    // Squared distances between the training predictors and the rows of
+    // distance_cache_points_.  If the kernel depends only on squared
+    // distance (e.g. a RadialBasisFunction with a common scale) these are
+    // reused across MCMC draws of the kernel parameters, as long as the
+    // training data and the prediction points do not change.
+    mutable Matrix distance_cache_points_;
+    mutable Matrix distance_cache_;
+    mutable bool distance_cache_current_;
+
     // Put observers on the kernel and mean function parameters so if the
     // parameters change our kernel matrix will be invalidated.
     void add_observers();
 
-    // Refresh the mutable parameters.  Fill a matrix K with K(X) + sigsq, where
-    // X is the matrix of predictors in the training data.
+    // Refresh the mutable parameters.  Decompose the matrix K(X) + sigsq,
+    // where X is the matrix of predictors in the training data.  If the only
+    // change since the last refresh is new data, the decomposition is
+    // extended instead of recomputed.
     void refresh_kernel_matrix() const;
+
+    // Append the data points after the first factored_sample_size_ to the
+    // Cholesky decomposition of the kernel matrix.
+    void extend_kernel_matrix() const;
+
+    // (K(X) + sigsq)^{-1} * residuals_.
+    const Vector &inverse_kernel_residuals() const;
+
+    const Matrix &training_predictors() const;
+
+    // The matrix of kernel values between the training predictors (rows)
+    // and the rows of X (columns).
+    Matrix training_cross_kernel(const Matrix &X) const;
+
+    // The matrix of kernel values between the rows of X1 and the rows of
+    // X2, computed in blocks of rows of X2 using pool_.
+    Matrix blocked_cross_kernel(const Matrix &X1, const Matrix &X2) const;
+
+    // The version of refresh_kernel_matrix used when approximation_ is set.
+    // It makes one pass through the data, in blocks of observations.
+    void refresh_approximation() const;
+
+    // The predictive distribution under the kernel approximation.
+    Ptr<MvnBase> approximate_predict_distribution(
+        const Matrix &X, bool predict_data) const;
   };
 
 
@@ -0,0 +1,111 @@
+/*
+  Copyright (C) 2005-2024 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include "Models/GP/KernelApproximation.hpp"
+#include <cmath>
+#include "LinAlg/SpdMatrix.hpp"
+#include "cpputil/Constants.hpp"
+#include "cpputil/report_error.hpp"
+#include "distributions.hpp"
+
+namespace BOOM {
+  namespace GP {
+
+    InducingPointApproximation::InducingPointApproximation(
+        const Matrix &inducing_points, Method method, double jitter)
+        : inducing_points_(inducing_points),
+          method_(method),
+          jitter_(jitter)
+    {
+      if (inducing_points_.nrow() == 0) {
+        report_error("At least one inducing point is needed.");
+      }
+      if (jitter_ < 0) {
+        report_error("jitter must be non-negative.");
+      }
+    }
+
+    InducingPointApproximation *InducingPointApproximation::clone() const {
+      return new InducingPointApproximation(*this);
+    }
+
+    void InducingPointApproximation::refresh(const KernelParams &kernel) {
+      SpdMatrix K = kernel(inducing_points_);
+      K.diag() += jitter_ * K.diag().max();
+      bool ok = true;
+      chol_ = K.chol(ok);
+      if (!ok) {
+        report_error("The kernel matrix of the inducing points is not "
+                     "positive definite.  Try removing duplicated inducing "
+                     "points, or increasing the jitter.");
+      }
+    }
+
+    Vector InducingPointApproximation::features(
+        const KernelParams &kernel, const ConstVectorView &x) const {
+      Vector ans(dim());
+      for (int i = 0; i < ans.size(); ++i) {
+        ans[i] = kernel(inducing_points_.row(i), x);
+      }
+      return Lsolve_inplace(chol_, ans);
+    }
+
+    double InducingPointApproximation::unexplained_covariance(
+        const KernelParams &kernel, const ConstVectorView &x1,
+        const ConstVectorView &x2, const Vector &phi1,
+        const Vector &phi2) const {
+      return kernel(x1, x2) - phi1.dot(phi2);
+    }
+
+    //=========================================================================
+    RandomFourierFeatures::RandomFourierFeatures(
+        int number_of_features, int xdim, RNG &rng)
+        : standard_normals_(number_of_features, xdim),
+          phases_(number_of_features)
+    {
+      if (number_of_features <= 0) {
+        report_error("The number of features must be positive.");
+      }
+      for (int i = 0; i < number_of_features; ++i) {
+        for (int j = 0; j < xdim; ++j) {
+          standard_normals_(i, j) = rnorm_mt(rng);
+        }
+        phases_[i] = runif_mt(rng, 0, 2 * Constants::pi);
+      }
+    }
+
+    RandomFourierFeatures *RandomFourierFeatures::clone() const {
+      return new RandomFourierFeatures(*this);
+    }
+
+    void RandomFourierFeatures::refresh(const KernelParams &kernel) {
+      frequencies_ = kernel.spectral_frequencies(standard_normals_);
+    }
+
+    Vector RandomFourierFeatures::features(
+        const KernelParams &, const ConstVectorView &x) const {
+      double scale = sqrt(2.0 / dim());
+      Vector ans = frequencies_ * x;
+      for (int i = 0; i < ans.size(); ++i) {
+        ans[i] = scale * cos(ans[i] + phases_[i]);
+      }
+      return ans;
+    }
+
+  }  // namespace GP
+}  // namespace BOOM
@@ -0,0 +1,174 @@
+#ifndef BOOM_MODELS_GP_KERNEL_APPROXIMATION_HPP_
+#define BOOM_MODELS_GP_KERNEL_APPROXIMATION_HPP_
+/*
+  Copyright (C) 2005-2024 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include "Models/GP/kernels.hpp"
+#include "LinAlg/Matrix.hpp"
+#include "LinAlg/Vector.hpp"
+#include "LinAlg/VectorView.hpp"
+#include "cpputil/RefCounted.hpp"
+#include "distributions/rng.hpp"
+
+namespace BOOM {
+  namespace GP {
+
+    // A low rank approximation to a kernel, k(x1, x2) ~= phi(x1)' phi(x2),
+    // where phi is a vector of 'dim' features.  A Gaussian process
+    // regression using an approximate kernel costs O(n * dim^2) time and
+    // O(dim^2) memory, instead of the O(n^3) time and O(n^2) memory of the
+    // exact model.  See
+    // GaussianProcessRegressionModel::set_kernel_approximation.
+    class KernelApproximation : private RefCounted {
+     public:
+      virtual ~KernelApproximation() {}
+      virtual KernelApproximation *clone() const = 0;
+
+      // The number of features.
+      virtual int dim() const = 0;
+
+      // Prepare the approximation for the current value of the kernel
+      // parameters.  This must be called before 'features', and again
+      // after the kernel parameters change.
+      virtual void refresh(const KernelParams &kernel) = 0;
+
+      // The feature vector phi(x).  The kernel must be the one passed to the
+      // most recent call to refresh.
+      virtual Vector features(const KernelParams &kernel,
+                              const ConstVectorView &x) const = 0;
+
+      // The part of the kernel not captured by the features:
+      // k(x1, x2) - phi(x1)' phi(x2).  Approximations that replace the
+      // kernel entirely, like random features, return zero.
+      virtual double unexplained_covariance(const KernelParams &kernel,
+                                            const ConstVectorView &x1,
+                                            const ConstVectorView &x2,
+                                            const Vector &phi1,
+                                            const Vector &phi2) const {
+        return 0.0;
+      }
+
+      // If true, the unexplained variance at each training point is added
+      // to that point's residual variance (the FITC approximation).  If
+      // false it enters the log likelihood as a trace penalty (the VFE
+      // approximation), which vanishes when the unexplained variance is
+      // zero.
+      virtual bool adds_unexplained_variance_to_residuals() const {
+        return false;
+      }
+
+      friend void intrusive_ptr_add_ref(KernelApproximation *approx) {
+        approx->up_count();
+      }
+      friend void intrusive_ptr_release(KernelApproximation *approx) {
+        approx->down_count();
+        if (approx->ref_count() == 0) {
+          delete approx;
+        }
+      }
+    };
+
+    //=========================================================================
+    // Approximates the kernel through its values at a set of m "inducing
+    // points" Z.  The features are phi(x) = L^{-1} k(Z, x), where
+    // LL' = K(Z, Z), so that phi(x1)' phi(x2) = k(x1, Z) K(Z, Z)^{-1} k(Z, x2)
+    // is the Nystrom approximation.
+    //
+    // The FITC method (Snelson and Ghahramani, 2006) uses the exact prior
+    // variance at each training point.  The VFE method (Titsias, 2009)
+    // maximizes a variational lower bound on the exact log likelihood.
+    class InducingPointApproximation : public KernelApproximation {
+     public:
+      enum Method { FITC, VFE };
+
+      // Args:
+      //   inducing_points: A matrix with one row per inducing point, and
+      //     the same number of columns as the predictors.  A random subset
+      //     of the training predictors is a reasonable default.
+      //   method: The way the unexplained variance at the training points
+      //     is handled.
+      //   jitter: A small multiple of the largest diagonal element of
+      //     K(Z, Z), added to its diagonal to keep the Cholesky
+      //     decomposition stable when inducing points are close together.
+      explicit InducingPointApproximation(const Matrix &inducing_points,
+                                          Method method = VFE,
+                                          double jitter = 1e-8);
+      InducingPointApproximation *clone() const override;
+
+      int dim() const override { return inducing_points_.nrow(); }
+      void refresh(const KernelParams &kernel) override;
+      Vector features(const KernelParams &kernel,
+                      const ConstVectorView &x) const override;
+      double unexplained_covariance(const KernelParams &kernel,
+                                    const ConstVectorView &x1,
+                                    const ConstVectorView &x2,
+                                    const Vector &phi1,
+                                    const Vector &phi2) const override;
+      bool adds_unexplained_variance_to_residuals() const override {
+        return method_ == FITC;
+      }
+
+      const Matrix &inducing_points() const { return inducing_points_; }
+
+     private:
+      Matrix inducing_points_;
+      Method method_;
+      double jitter_;
+
+      // The Cholesky factor of K(Z, Z).
+      Matrix chol_;
+    };
+
+    //=========================================================================
+    // Random Fourier features (Rahimi and Recht, 2007) for kernels that
+    // implement KernelParams::spectral_frequencies.  The features are
+    // sqrt(2 / m) * cos(w_j' x + b_j), for frequencies w_j drawn from the
+    // kernel's spectral distribution and phases b_j ~ U(0, 2 * pi).
+    //
+    // The standard normal draws behind the frequencies are made once, when
+    // the object is built, so the features change smoothly with the kernel
+    // parameters.
+    class RandomFourierFeatures : public KernelApproximation {
+     public:
+      // Args:
+      //   number_of_features:  The number of features, m.
+      //   xdim:  The dimension of the predictors.
+      //   rng:  The random number generator used to draw the features.
+      RandomFourierFeatures(int number_of_features, int xdim,
+                            RNG &rng = GlobalRng::rng);
+      RandomFourierFeatures *clone() const override;
+
+      int dim() const override { return phases_.size(); }
+      void refresh(const KernelParams &kernel) override;
+      Vector features(const KernelParams &kernel,
+                      const ConstVectorView &x) const override;
+
+     private:
+      // One row per feature.
+      Matrix standard_normals_;
+      Vector phases_;
+
+      // The frequencies for the kernel passed to the last call to refresh.
+      // One row per feature.
+      Matrix frequencies_;
+    };
+
+  }  // namespace GP
+}  // namespace BOOM
+
+#endif  // BOOM_MODELS_GP_KERNEL_APPROXIMATION_HPP_
@@ -57,7 +57,9 @@ namespace BOOM {
     double data_sum_of_squares = 0;
     size_t sample_size = model_->dat().size();
 
-    Vector posterior_residuals = model_->posterior_residuals();
+    WorkspaceScope scope(workspace());
+    Vector &posterior_residuals(scope.workspace().vector(sample_size));
+    model_->fill_posterior_residuals(posterior_residuals);
     for (double resid : posterior_residuals) {
       data_sum_of_squares += square(resid);
     }
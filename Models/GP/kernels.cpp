@@ -17,10 +17,33 @@
 */
 
 #include "Models/GP/kernels.hpp"
+#include "cpputil/math_utils.hpp"
 #include "cpputil/report_error.hpp"
+#include <algorithm>
 
 namespace BOOM {
 
+  Matrix squared_distances(const Matrix &X1, const Matrix &X2) {
+    if (X1.ncol() != X2.ncol()) {
+      report_error("Arguments to squared_distances must have the same "
+                   "number of columns.");
+    }
+    Matrix ans = X1.multT(X2);
+    ans *= -2.0;
+    Vector norms1(X1.nrow());
+    for (int i = 0; i < X1.nrow(); ++i) norms1[i] = X1.row(i).normsq();
+    Vector norms2(X2.nrow());
+    for (int j = 0; j < X2.nrow(); ++j) norms2[j] = X2.row(j).normsq();
+    for (int j = 0; j < ans.ncol(); ++j) {
+      for (int i = 0; i < ans.nrow(); ++i) {
+        // Rounding error can make the distance between nearby points
+        // slightly negative.
+        ans(i, j) = std::max(0.0, ans(i, j) + norms1[i] + norms2[j]);
+      }
+    }
+    return ans;
+  }
+
   SpdMatrix KernelParams::operator()(const Matrix &X) const {
     size_t sample_size = X.nrow();
     SpdMatrix ans(sample_size);
@@ -35,6 +58,26 @@ namespace BOOM {
     return ans;
   }
 
+  Matrix KernelParams::cross_kernel(const Matrix &X1, const Matrix &X2) const {
+    Matrix ans(X1.nrow(), X2.nrow());
+    for (int j = 0; j < X2.nrow(); ++j) {
+      for (int i = 0; i < X1.nrow(); ++i) {
+        ans(i, j) = (*this)(X1.row(i), X2.row(j));
+      }
+    }
+    return ans;
+  }
+
+  Matrix KernelParams::kernel_from_squared_distances(const Matrix &) const {
+    report_error("This kernel does not depend only on squared distance.");
+    return Matrix();
+  }
+
+  Matrix KernelParams::spectral_frequencies(const Matrix &) const {
+    report_error("This kernel does not support random Fourier features.");
+    return Matrix();
+  }
+
   //===========================================================================
 
   RadialBasisFunction::RadialBasisFunction(double scale)
@@ -75,6 +118,64 @@ namespace BOOM {
     return exp( -2 * distance);
   }
 
+  Matrix RadialBasisFunction::cross_kernel(
+      const Matrix &X1, const Matrix &X2) const {
+    if (depends_only_on_squared_distance()) {
+      return kernel_from_squared_distances(squared_distances(X1, X2));
+    }
+    int dim = X1.ncol();
+    if (scale_.size() != dim) {
+      report_error("Predictor dimension does not match the scale of the "
+                   "RadialBasisFunction.");
+    }
+    Matrix Z1 = X1;
+    Matrix Z2 = X2;
+    for (int j = 0; j < dim; ++j) {
+      Z1.col(j) /= scale_[j];
+      Z2.col(j) /= scale_[j];
+    }
+    Matrix ans = squared_distances(Z1, Z2);
+    ans *= -2.0;
+    return exp(ans);
+  }
+
+  bool RadialBasisFunction::depends_only_on_squared_distance() const {
+    for (int i = 1; i < scale_.size(); ++i) {
+      if (scale_[i] != scale_[0]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  Matrix RadialBasisFunction::kernel_from_squared_distances(
+      const Matrix &squared_distances) const {
+    if (!depends_only_on_squared_distance()) {
+      report_error("A RadialBasisFunction with a different scale in each "
+                   "dimension does not depend only on squared distance.");
+    }
+    Matrix ans = squared_distances;
+    ans *= -2.0 / square(scale_[0]);
+    return exp(ans);
+  }
+
+  // exp(-2 * ||delta / scale||^2) is the characteristic function of a
+  // normal distribution with standard deviation 2 / scale in each
+  // coordinate.
+  Matrix RadialBasisFunction::spectral_frequencies(
+      const Matrix &standard_normals) const {
+    int dim = standard_normals.ncol();
+    if (scale_.size() != 1 && scale_.size() != dim) {
+      report_error("Frequency dimension does not match the scale of the "
+                   "RadialBasisFunction.");
+    }
+    Matrix ans = standard_normals;
+    for (int j = 0; j < dim; ++j) {
+      ans.col(j) *= 2.0 / scale_[scale_.size() == 1 ? 0 : j];
+    }
+    return ans;
+  }
+
   std::ostream &RadialBasisFunction::display(std::ostream &out) const {
     out << "Radial Basis Function with scale " << scale_;
     return out;
@@ -147,6 +248,25 @@ namespace BOOM {
     return exp(-.5 * scaled_shrunk_xtx_inv_.Mdist(x1, x2));
   }
 
+  Matrix MahalanobisKernel::cross_kernel(
+      const Matrix &X1, const Matrix &X2) const {
+    Matrix L = scaled_shrunk_xtx_inv_.chol();
+    Matrix ans = squared_distances(X1 * L, X2 * L);
+    ans *= -.5;
+    return exp(ans);
+  }
+
+  // exp(-.5 * delta' M delta) is the characteristic function of N(0, M).
+  // If M = LL' then the rows of Z * L' have this distribution.
+  Matrix MahalanobisKernel::spectral_frequencies(
+      const Matrix &standard_normals) const {
+    if (standard_normals.ncol() != scaled_shrunk_xtx_inv_.nrow()) {
+      report_error("Frequency dimension does not match the dimension of the "
+                   "MahalanobisKernel.");
+    }
+    return standard_normals.multT(scaled_shrunk_xtx_inv_.chol());
+  }
+
   std::ostream & MahalanobisKernel::display(std::ostream &out) const {
     out << "MahalanobisKernel with respect to the matrix: \n"
         << scaled_shrunk_xtx_inv_;
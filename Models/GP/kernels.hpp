@@ -21,10 +21,16 @@
 #include "Models/ParamTypes.hpp"
 #include <ostream>
 #include "LinAlg/Vector.hpp"
+#include "LinAlg/Matrix.hpp"
 
 
 namespace BOOM {
 
+  // The matrix of squared Euclidean distances between the rows of X1 and the
+  // rows of X2.  The distances are computed as ||x1||^2 + ||x2||^2 - 2 x1'x2,
+  // so the bulk of the work is the single matrix product X1 * X2'.
+  Matrix squared_distances(const Matrix &X1, const Matrix &X2);
+
   // A "kernel" is the parameter to a Gaussian process.  A kernel is a function
   // of two vector arguments: k(x1, x2), subject to the condition that a matrix
   // K with elements K_{ij} = k(xi, xj) must be positive defininte for arbitrary
@@ -39,6 +45,40 @@ namespace BOOM {
                               const ConstVectorView &x2) const = 0;
 
     virtual SpdMatrix operator()(const Matrix &predictors) const;
+
+    // The matrix with elements k(X1.row(i), X2.row(j)).  The default
+    // implementation evaluates the kernel one pair at a time.  Kernels that
+    // can be written in terms of distances should override it with a
+    // version based on squared_distances().
+    //
+    // Implementations must be safe to call from several threads at once.
+    virtual Matrix cross_kernel(const Matrix &X1, const Matrix &X2) const;
+
+    // Returns true if the kernel depends on x1 and x2 only through the
+    // squared Euclidean distance ||x1 - x2||^2.  The distances can then be
+    // computed once and reused as the kernel parameters change.
+    virtual bool depends_only_on_squared_distance() const {return false;}
+
+    // If depends_only_on_squared_distance() then return the matrix of kernel
+    // values corresponding to a matrix of squared distances.  The default
+    // implementation reports an error.
+    virtual Matrix kernel_from_squared_distances(
+        const Matrix &squared_distances) const;
+
+    // A stationary kernel with k(x, x) = 1 is the characteristic function
+    // of a probability distribution over frequencies (Bochner's theorem).
+    // Kernels of this type can be approximated by random Fourier features
+    // (see GP::RandomFourierFeatures) if they override this function.  The
+    // default implementation reports an error.
+    //
+    // Args:
+    //   standard_normals: A matrix of independent N(0, 1) draws, with one
+    //     row per feature and one column per dimension of x.
+    //
+    // Returns:
+    //   A matrix of the same shape as the argument, with rows that are
+    //   draws from the kernel's spectral distribution.
+    virtual Matrix spectral_frequencies(const Matrix &standard_normals) const;
   };
 
   //===========================================================================
@@ -63,6 +103,15 @@ namespace BOOM {
                       const ConstVectorView &x2) const override;
     using KernelParams::operator();
 
+    Matrix cross_kernel(const Matrix &X1, const Matrix &X2) const override;
+
+    // True if the scale is the same in every dimension.
+    bool depends_only_on_squared_distance() const override;
+    Matrix kernel_from_squared_distances(
+        const Matrix &squared_distances) const override;
+
+    Matrix spectral_frequencies(const Matrix &standard_normals) const override;
+
     std::ostream &display(std::ostream &out) const override;
     Vector vectorize(bool minimal=true) const override;
     Vector::const_iterator unvectorize(Vector::const_iterator &v,
@@ -104,6 +153,12 @@ namespace BOOM {
                       const ConstVectorView &x2) const override;
     using KernelParams::operator();
 
+    // With M = LL' the Mahalanobis distance between x1 and x2 is the
+    // Euclidean distance between x1'L and x2'L.
+    Matrix cross_kernel(const Matrix &X1, const Matrix &X2) const override;
+
+    Matrix spectral_frequencies(const Matrix &standard_normals) const override;
+
     std::ostream &display(std::ostream &out) const override;
     Vector vectorize(bool minimal=true) const override;
     Vector::const_iterator unvectorize(Vector::const_iterator &v,
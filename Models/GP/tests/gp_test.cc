@@ -101,6 +101,150 @@ namespace {
 
   }
 
+  // Adding data one point at a time extends the Cholesky decomposition of
+  // the kernel matrix.  The results should match a model that factors all
+  // the data at once.
+  TEST_F(GpTest, IncrementalDataMatchesBatch) {
+    int sample_size = 12;
+    Matrix X(sample_size, 2);
+    X.randomize();
+    Vector y = 3 * X.col(0) + rnorm_vector(sample_size, 0, 1);
+
+    NEW(RadialBasisFunction, kernel_param)(.57);
+    NEW(UnivParams, residual_variance_param)(square(1.2));
+    GaussianProcessRegressionModel incremental(
+        new ZeroFunction, kernel_param, residual_variance_param);
+    GaussianProcessRegressionModel batch(
+        new ZeroFunction, kernel_param, residual_variance_param);
+
+    Vector xnew = {.3, .6};
+    for (int i = 0; i < sample_size; ++i) {
+      NEW(RegressionData, data_point)(y[i], X.row(i));
+      incremental.add_data(data_point);
+      // Force a refresh after each new point.
+      incremental.predict(xnew);
+      batch.add_data(data_point);
+    }
+
+    EXPECT_NEAR(batch.log_likelihood(), incremental.log_likelihood(), 1e-8);
+    EXPECT_NEAR(batch.predict(xnew), incremental.predict(xnew), 1e-8);
+    EXPECT_TRUE(MatrixEquals(batch.inverse_kernel_matrix(),
+                             incremental.inverse_kernel_matrix()));
+
+    Matrix Xnew(3, 2);
+    Xnew.randomize();
+    Ptr<MvnBase> batch_prediction = batch.predict_distribution(Xnew, false);
+    Ptr<MvnBase> incremental_prediction =
+        incremental.predict_distribution(Xnew, false);
+    EXPECT_TRUE(VectorEquals(batch_prediction->mu(),
+                             incremental_prediction->mu()));
+    EXPECT_TRUE(MatrixEquals(batch_prediction->Sigma(),
+                             incremental_prediction->Sigma()));
+
+    // A parameter change forces a full refresh.
+    residual_variance_param->set(2.0);
+    SpdMatrix V = (*kernel_param)(X);
+    V.diag() += 2.0;
+    EXPECT_NEAR(dmvn(y, Vector(sample_size, 0.0), V.inv(), true),
+                incremental.log_likelihood(), 1e-8);
+  }
+
+  // Batched prediction should match prediction one point at a time, including
+  // when the cached squared distances are reused after a change in the
+  // kernel scale.
+  TEST_F(GpTest, BatchPredictionTest) {
+    int sample_size = 30;
+    Matrix X(sample_size, 2);
+    X.randomize();
+    Vector y = 3 * X.col(0) + rnorm_vector(sample_size, 0, .5);
+
+    NEW(RadialBasisFunction, kernel_param)(.8);
+    GaussianProcessRegressionModel model(
+        new ZeroFunction, kernel_param, new UnivParams(square(.5)));
+    for (int i = 0; i < sample_size; ++i) {
+      NEW(RegressionData, data_point)(y[i], X.row(i));
+      model.add_data(data_point);
+    }
+
+    Matrix Xnew(100, 2);
+    Xnew.randomize();
+    for (double scale : {.8, 1.4}) {
+      kernel_param->set_scale(Vector(1, scale));
+      Vector predictions = model.predict(Xnew);
+      for (int i = 0; i < Xnew.nrow(); ++i) {
+        EXPECT_NEAR(predictions[i], model.predict(Vector(Xnew.row(i))), 1e-8);
+      }
+    }
+
+    // The posterior residuals are computed without evaluating the kernel.
+    Vector residuals = model.posterior_residuals();
+    Vector fitted = model.predict(X);
+    for (int i = 0; i < sample_size; ++i) {
+      EXPECT_NEAR(residuals[i], y[i] - fitted[i], 1e-8);
+    }
+  }
+
+  // When the inducing points are the training points the Nystrom
+  // approximation is exact, so both inducing point methods should reproduce
+  // the exact log likelihood and predictions.
+  TEST_F(GpTest, InducingPointsMatchExactModel) {
+    int sample_size = 8;
+    Matrix X(sample_size, 2);
+    X.randomize();
+    Vector y = 3 * X.col(0) + rnorm_vector(sample_size, 0, 1);
+
+    NEW(RadialBasisFunction, kernel_param)(.57);
+    GaussianProcessRegressionModel model(
+        new ZeroFunction, kernel_param, new UnivParams(square(1.2)));
+    for (int i = 0; i < sample_size; ++i) {
+      NEW(RegressionData, data_point)(y[i], X.row(i));
+      model.add_data(data_point);
+    }
+    Vector xnew = {.3, .6};
+    double exact_log_likelihood = model.log_likelihood();
+    double exact_prediction = model.predict(xnew);
+
+    for (auto method : {GP::InducingPointApproximation::VFE,
+                        GP::InducingPointApproximation::FITC}) {
+      model.set_kernel_approximation(
+          new GP::InducingPointApproximation(X, method, 1e-12));
+      EXPECT_NEAR(exact_log_likelihood, model.log_likelihood(), 1e-5);
+      EXPECT_NEAR(exact_prediction, model.predict(xnew), 1e-5);
+    }
+
+    model.set_kernel_approximation(nullptr);
+    EXPECT_NEAR(exact_log_likelihood, model.log_likelihood(), 1e-8);
+  }
+
+  // With many random features the approximate model should be close to the
+  // exact one.
+  TEST_F(GpTest, RandomFourierFeaturesApproximateExactModel) {
+    int sample_size = 30;
+    Matrix X(sample_size, 2);
+    X.randomize();
+    Vector y = 3 * X.col(0) + rnorm_vector(sample_size, 0, .5);
+
+    NEW(RadialBasisFunction, kernel_param)(1.3);
+    GaussianProcessRegressionModel model(
+        new ZeroFunction, kernel_param, new UnivParams(square(.5)));
+    for (int i = 0; i < sample_size; ++i) {
+      NEW(RegressionData, data_point)(y[i], X.row(i));
+      model.add_data(data_point);
+    }
+    Matrix Xnew(3, 2);
+    Xnew.randomize();
+    Ptr<MvnBase> exact = model.predict_distribution(Xnew, true);
+
+    model.set_kernel_approximation(
+        new GP::RandomFourierFeatures(1000, 2));
+    Ptr<MvnBase> approximate = model.predict_distribution(Xnew, true);
+    for (int i = 0; i < Xnew.nrow(); ++i) {
+      EXPECT_NEAR(exact->mu()[i], approximate->mu()[i], .05);
+      EXPECT_NEAR(model.predict(Xnew.row(i)), approximate->mu()[i], 1e-8);
+      EXPECT_GT(approximate->Sigma()(i, i), model.residual_variance());
+    }
+  }
+
   // Check that MCMC for model parameters is
   TEST_F(GpTest, McmcTest_MahalanobisKernel) {
     int sample_size = 50;
@@ -28,6 +28,63 @@ namespace {
 
   }
 
+  // Inner products of random Fourier features should approximate the kernel.
+  TEST_F(KernelTest, RandomFourierFeaturesTest) {
+    int dim = 3;
+    Matrix X(10, dim);
+    X.randomize();
+    RadialBasisFunction rbf(1.7);
+    MahalanobisKernel mahalanobis(X, 1.3);
+
+    Vector x1(dim);
+    Vector x2(dim);
+    x1.randomize();
+    x2.randomize();
+    for (const KernelParams *kernel :
+             std::vector<const KernelParams *>{&rbf, &mahalanobis}) {
+      GP::RandomFourierFeatures features(20000, dim);
+      features.refresh(*kernel);
+      Vector phi1 = features.features(*kernel, x1);
+      Vector phi2 = features.features(*kernel, x2);
+      EXPECT_NEAR(phi1.dot(phi2), (*kernel)(x1, x2), .03);
+      EXPECT_NEAR(phi1.dot(phi1), 1.0, .03);
+    }
+  }
+
+  // The distance based cross_kernel methods should match the kernels
+  // evaluated one pair at a time.
+  TEST_F(KernelTest, CrossKernelTest) {
+    int dim = 3;
+    Matrix X1(7, dim);
+    X1.randomize();
+    Matrix X2(5, dim);
+    X2.randomize();
+    RadialBasisFunction rbf(1.7);
+    RadialBasisFunction rbf_by_dimension(Vector{.8, 1.7, 2.2});
+    MahalanobisKernel mahalanobis(X1, 1.3);
+
+    EXPECT_TRUE(rbf.depends_only_on_squared_distance());
+    EXPECT_FALSE(rbf_by_dimension.depends_only_on_squared_distance());
+    EXPECT_FALSE(mahalanobis.depends_only_on_squared_distance());
+
+    for (const KernelParams *kernel : std::vector<const KernelParams *>{
+             &rbf, &rbf_by_dimension, &mahalanobis}) {
+      Matrix K = kernel->cross_kernel(X1, X2);
+      ASSERT_EQ(K.nrow(), X1.nrow());
+      ASSERT_EQ(K.ncol(), X2.nrow());
+      for (int i = 0; i < X1.nrow(); ++i) {
+        for (int j = 0; j < X2.nrow(); ++j) {
+          EXPECT_NEAR(K(i, j), (*kernel)(X1.row(i), X2.row(j)), 1e-8);
+        }
+      }
+    }
+
+    Matrix D = squared_distances(X1, X2);
+    EXPECT_NEAR(D(2, 3), (X1.row(2) - X2.row(3)).normsq(), 1e-10);
+    EXPECT_TRUE(MatrixEquals(rbf.kernel_from_squared_distances(D),
+                             rbf.cross_kernel(X1, X2)));
+  }
+
   TEST_F(KernelTest, MahalanobisKernelTest) {
     int dim = 3;
     int sample_size = 10;
@@ -23,6 +23,7 @@
 #include "Models/SufstatAbstractCombineImpl.hpp"
 #include "cpputil/math_utils.hpp"
 #include "distributions.hpp"
+#include "distributions/vectorized_densities.hpp"
 
 namespace BOOM {
 
@@ -158,6 +159,18 @@ namespace BOOM {
     return logscale ? ans : exp(ans);
   }
 
+  void GammaModelBase::pdf_batch(const std::vector<Ptr<Data>> &data,
+                                 VectorView ans, bool logscale) const {
+    Vector values(data.size());
+    for (size_t i = 0; i < data.size(); ++i) {
+      values[i] = DAT(data[i])->value();
+    }
+    dgamma_vector(values, alpha(), beta(), ans, logscale);
+    for (size_t i = 0; i < data.size(); ++i) {
+      if (data[i]->missing()) ans[i] = logscale ? 0.0 : 1.0;
+    }
+  }
+
   double GammaModelBase::Logp(double x, double &g, double &h, uint nd) const {
     double a = alpha();
     double b = beta();
@@ -93,6 +93,8 @@ namespace BOOM {
     void add_mixture_data(const Ptr<Data> &, double prob) override;
     double pdf(const Ptr<Data> &dp, bool logscale) const override;
     double pdf(const Data *dp, bool logscale) const override;
+    void pdf_batch(const std::vector<Ptr<Data>> &data, VectorView ans,
+                   bool logscale) const override;
     int number_of_observations() const override { return dat().size(); }
 
     double Logp(double x, double &g, double &h, uint nd) const override;
@@ -19,6 +19,7 @@
 #include "Models/GaussianModelBase.hpp"
 #include "Models/SufstatAbstractCombineImpl.hpp"
 #include "distributions.hpp"
+#include "distributions/vectorized_densities.hpp"
 #include "cpputil/Constants.hpp"
 
 namespace BOOM {
@@ -27,15 +28,38 @@ namespace BOOM {
     using GS = BOOM::GaussianSuf;
   }
 
+  namespace {
+    // Sum the elements of y with Neumaier's compensated summation, which
+    // keeps the rounding error independent of the number of elements.
+    template <class FUN>
+    double compensated_sum(const ConstVectorView &y, FUN f) {
+      double sum = 0;
+      double compensation = 0;
+      for (double yi : y) {
+        double term = f(yi);
+        double total = sum + term;
+        if (std::fabs(sum) >= std::fabs(term)) {
+          compensation += (sum - total) + term;
+        } else {
+          compensation += (term - total) + sum;
+        }
+        sum = total;
+      }
+      return sum + compensation;
+    }
+  }  // namespace
+
   GS::GaussianSuf(double Sum, double Sumsq, double N)
-      : sum_(Sum), sumsq_(Sumsq), n_(N) {}
+      : n_(N),
+        mean_(N > 0 ? Sum / N : 0.0),
+        centered_sumsq_(Sumsq - mean_ * Sum) {}
 
   GS::GaussianSuf(const GS &rhs)
       : Sufstat(rhs),
         SufstatDetails<DataType>(rhs),
-        sum_(rhs.sum_),
-        sumsq_(rhs.sumsq_),
-        n_(rhs.n_) {}
+        n_(rhs.n_),
+        mean_(rhs.mean_),
+        centered_sumsq_(rhs.centered_sumsq_) {}
 
   GS *GS::clone() const { return new GS(*this); }
 
@@ -46,41 +70,59 @@ namespace BOOM {
 
   void GS::update_raw(double y) {
     n_ += 1;
-    sum_ += y;
-    sumsq_ += y * y;
+    double delta = y - mean_;
+    mean_ += delta / n_;
+    centered_sumsq_ += delta * (y - mean_);
+  }
+
+  void GS::add_data(const ConstVectorView &y) {
+    if (y.empty()) return;
+    double block_n = y.size();
+    double block_mean = compensated_sum(y, [](double yi) {return yi;})
+        / block_n;
+    double block_centered_sumsq = compensated_sum(
+        y, [block_mean](double yi) {return square(yi - block_mean);});
+    merge(block_n, block_mean, block_centered_sumsq);
   }
 
   void GS::update_expected_value(double expected_sample_size,
                                  double expected_sum,
                                  double expected_sum_of_squares) {
-    n_ += expected_sample_size;
-    sum_ += expected_sum;
-    sumsq_ += expected_sum_of_squares;
+    if (expected_sample_size <= 0) return;
+    double mean = expected_sum / expected_sample_size;
+    merge(expected_sample_size, mean,
+          expected_sum_of_squares - mean * expected_sum);
   }
 
   void GS::remove(double y) {
-    n_ -= 1;
-    sum_ -= y;
-    sumsq_ -= y * y;
+    double n = n_ - 1;
+    if (n <= 0) {
+      clear();
+      return;
+    }
+    double old_mean = mean_;
+    mean_ = (n_ * mean_ - y) / n;
+    centered_sumsq_ -= (y - mean_) * (y - old_mean);
+    n_ = n;
   }
 
   void GS::add_mixture_data(double y, double prob) {
+    if (prob <= 0) return;
     n_ += prob;
-    prob *= y;
-    sum_ += prob;
-    prob *= y;
-    sumsq_ += prob;
+    double delta = y - mean_;
+    mean_ += delta * prob / n_;
+    centered_sumsq_ += prob * delta * (y - mean_);
   }
 
-  double GS::sum() const { return sum_; }
-  double GS::sumsq() const { return sumsq_; }
+  double GS::sum() const { return n_ * mean_; }
+  double GS::sumsq() const { return centered_sumsq_ + n_ * mean_ * mean_; }
   double GS::centered_sumsq(double mu) const {
-    return sumsq_ - (2.0 * sum_ * mu) + n_ * mu * mu;
+    return centered_sumsq_ + n_ * square(mean_ - mu);
   }
   double GS::n() const { return n_; }
   double GS::ybar() const {
     if (n_ > 0) {
-      return sum() / n();
+      return mean_;
     }
     return 0.0;
   }
@@ -89,43 +131,52 @@ namespace BOOM {
     if (n_ <= 1) {
       return 0;
     }
-    double ss = sumsq() - n() * pow(ybar(), 2);
-    return ss / (n_ - 1);
+    return centered_sumsq_ / (n_ - 1);
   }
 
-  void GS::clear() { sum_ = sumsq_ = n_ = 0; }
+  void GS::clear() { n_ = mean_ = centered_sumsq_ = 0; }
+
+  // Chan et al.'s pairwise update for merging two sets of statistics.
+  void GS::merge(double n, double mean, double centered_sumsq) {
+    double total = n_ + n;
+    if (total <= 0) return;
+    double delta = mean - mean_;
+    mean_ += delta * n / total;
+    centered_sumsq_ += centered_sumsq + delta * delta * n_ * n / total;
+    n_ = total;
+  }
 
   void GS::combine(const Ptr<GS> &s) {
-    n_ += s->n_;
-    sum_ += s->sum_;
-    sumsq_ += s->sumsq_;
+    combine(*s);
   }
 
   void GS::combine(const GS &rhs) {
-    n_ += rhs.n_;
-    sum_ += rhs.sum_;
-    sumsq_ += rhs.sumsq_;
+    merge(rhs.n_, rhs.mean_, rhs.centered_sumsq_);
   }
 
   GaussianSuf *GS::abstract_combine(Sufstat *s) {
     return abstract_combine_impl(this, s);
   }
 
+  // The serialized form is (n, sum, sumsq), as in earlier versions.
   Vector GS::vectorize(bool) const {
     Vector ans(3);
     ans[0] = n_;
-    ans[1] = sum_;
-    ans[2] = sumsq_;
+    ans[1] = sum();
+    ans[2] = sumsq();
     return ans;
   }
 
   Vector::const_iterator GS::unvectorize(Vector::const_iterator &v, bool) {
-    n_ = *v;
+    double n = *v;
     ++v;
-    sum_ = *v;
+    double sum = *v;
     ++v;
-    sumsq_ = *v;
+    double sumsq = *v;
     ++v;
+    n_ = n;
+    mean_ = n > 0 ? sum / n : 0.0;
+    centered_sumsq_ = sumsq - mean_ * sum;
     return v;
   }
 
@@ -135,7 +186,7 @@ namespace BOOM {
   }
 
   std::ostream &GS::print(std::ostream &out) const {
-    return out << n_ << " " << sum_ << " " << sumsq_;
+    return out << n_ << " " << sum() << " " << sumsq();
   }
 
   //======================================================================
@@ -158,6 +209,18 @@ namespace BOOM {
     return logscale ? ans : exp(ans);
   }
 
+  void GaussianModelBase::pdf_batch(const std::vector<Ptr<Data>> &data,
+                                    VectorView ans, bool logscale) const {
+    Vector values(data.size());
+    for (size_t i = 0; i < data.size(); ++i) {
+      values[i] = DAT(data[i])->value();
+    }
+    dnorm_vector(values, mu(), sigma(), ans, logscale);
+    for (size_t i = 0; i < data.size(); ++i) {
+      if (data[i]->missing()) ans[i] = logscale ? 0.0 : 1.0;
+    }
+  }
+
   double GaussianModelBase::Logp(double x, double &g, double &h,
                                  uint nd) const {
     double m = mu();
@@ -46,10 +46,17 @@ namespace BOOM {
     // Remove the effect of observation y from the sufficient
     // statistics, as if it were dropped from the data set.
     void remove(double y);
+    bool supports_remove() const override { return true; }
+    void Remove(const DoubleData &y) override { remove(y.value()); }
 
     // Increment n by prob, sum by prob * y, and sumsq by prob * y^2.
     void add_mixture_data(double y, double prob);
 
+    // Add a block of observations, equivalent to calling update_raw on each
+    // element.  A raw buffer of doubles can be wrapped in a ConstVectorView
+    // to avoid copying it.
+    void add_data(const ConstVectorView &y);
+
     double sum() const;
 
     // sumsq returns the uncentered (raw) sum of squared y's: sum(y^2)
@@ -58,6 +65,9 @@ namespace BOOM {
     // centered_sumsq returns sum((y - mu)^2).
     double centered_sumsq(double mu) const;
 
+    // The sum of squared deviations about ybar().
+    double centered_sumsq() const { return centered_sumsq_; }
+
     double n() const;
 
     // The sample mean. If there is no data then ybar == 0.
@@ -76,7 +86,17 @@ namespace BOOM {
     std::ostream &print(std::ostream &out) const override;
 
    private:
-    double sum_, sumsq_, n_;
+    // The statistics are stored as the sample size, mean, and centered sum
+    // of squares, which are updated with Welford's algorithm.  This avoids
+    // the cancellation in sumsq - n * ybar^2 when the variance is small
+    // relative to the mean, and lets statistics accumulated on different
+    // shards be merged accurately.
+    double n_;
+    double mean_;
+    double centered_sumsq_;
+
+    // Add the statistics of another sample to *this.
+    void merge(double n, double mean, double centered_sumsq);
   };
   //======================================================================
   class GaussianModelBase
@@ -107,6 +127,8 @@ namespace BOOM {
 
     double pdf(const Ptr<Data> &dp, bool logscale) const override;
     double pdf(const Data *dp, bool logscale) const override;
+    void pdf_batch(const std::vector<Ptr<Data>> &data, VectorView ans,
+                   bool logscale) const override;
     double Logp(double x, double &g, double &h, uint nd) const override;
     double Logp(const Vector &x, Vector &g, Matrix &h, uint nd) const;
 
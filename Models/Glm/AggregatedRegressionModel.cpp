@@ -22,6 +22,7 @@
 #include <iomanip>
 #include <map>
 
+#include "LinAlg/Eigen.hpp"
 #include "LinAlg/SpdMatrix.hpp"
 #include "Samplers/ScalarSliceSampler.hpp"
 #include "cpputil/math_utils.hpp"
@@ -31,10 +32,16 @@
 namespace BOOM {
   namespace Agreg {
     Group::Group(const std::string &name, double value, const Transformation &F)
-        : name_(name), total_value_(value), f(F) {}
+        : name_(name),
+          total_value_(value),
+          f(F),
+          have_collapsed_statistics_(false) {}
     //----------------------------------------------------------------------
     Group::Group(const Group &rhs)
-        : name_(rhs.name_), total_value_(rhs.total_value_), f(rhs.f) {}
+        : name_(rhs.name_),
+          total_value_(rhs.total_value_),
+          f(rhs.f),
+          have_collapsed_statistics_(false) {}
     //----------------------------------------------------------------------
     Group *Group::clone() const { return new Group(*this); }
     //----------------------------------------------------------------------
@@ -73,6 +80,7 @@ namespace BOOM {
     //----------------------------------------------------------------------
     void Group::add_unit(const Ptr<RegressionData> &dp) {
       unit_data_.push_back(dp);
+      have_collapsed_statistics_ = false;
     }
     //----------------------------------------------------------------------
     void Group::distribute_total(const Vector &beta, double sigma) {
@@ -197,6 +205,70 @@ namespace BOOM {
       }
     }
 
+    //----------------------------------------------------------------------
+    void Group::compute_collapsed_statistics() {
+      int n = unit_data_.size();
+      int p = unit_data_[0]->xdim();
+      xtx_.resize(p);
+      xtx_ = 0.0;
+      x_column_sums_.resize(p);
+      x_column_sums_ = 0.0;
+      for (const auto &unit : unit_data_) {
+        xtx_.add_outer(unit->x(), 1.0, false);
+        x_column_sums_ += unit->x();
+      }
+      xtx_.reflect();
+
+      SpdMatrix centered_xtx = xtx_;
+      centered_xtx.add_outer(x_column_sums_, -1.0 / n);
+      SymmetricEigen eigen(centered_xtx);
+      const Vector &values(eigen.eigenvalues());
+      double threshold = 1e-8 * std::max<double>(values.max(), 1.0);
+      std::vector<int> columns;
+      for (int i = 0; i < values.size(); ++i) {
+        if (values[i] > threshold) columns.push_back(i);
+      }
+      centered_root_.resize(p, columns.size());
+      for (int k = 0; k < columns.size(); ++k) {
+        centered_root_.col(k) =
+            eigen.eigenvectors().col(columns[k]) * sqrt(values[columns[k]]);
+      }
+      have_collapsed_statistics_ = true;
+    }
+
+    //----------------------------------------------------------------------
+    // Write the unit values as y = m + sigma * P * e, where m is the
+    // conditional mean, P = I - 11'/n, and e ~ N(0, I).  Because P * 1 = 0,
+    // X'y = X'm + sigma * v and y'y = m'm + 2 * sigma * beta'v + sigma^2 *
+    // e'Pe, where v = X'Pe.  Split Pe into its projection onto the column
+    // space of PX, which has dimension r, and the remainder.  Then v has the
+    // distribution of centered_root_ * u with u ~ N(0, I_r), and e'Pe = u'u
+    // + w, where w ~ chisq(n - 1 - r) is independent of u.
+    void Group::add_collapsed_sufficient_statistics(const Vector &beta,
+                                                    double sigma, RNG &rng,
+                                                    Vector &xty,
+                                                    double &yty) {
+      if (!have_collapsed_statistics_) {
+        compute_collapsed_statistics();
+      }
+      double n = unit_data_.size();
+      double sum_of_means = x_column_sums_.dot(beta);
+      double shift = (total_value_ - sum_of_means) / n;
+      Vector xtx_beta = xtx_ * beta;
+
+      Vector u(centered_root_.ncol());
+      rnorm_mt(rng, u);
+      Vector v = centered_root_ * u;
+      double residual_df = n - 1 - u.size();
+      double chisq = residual_df > 0 ? rchisq_mt(rng, residual_df) : 0.0;
+
+      xty += xtx_beta;
+      xty.axpy(x_column_sums_, shift);
+      xty.axpy(v, sigma);
+      yty += beta.dot(xtx_beta) + 2 * shift * sum_of_means + n * square(shift)
+          + 2 * sigma * beta.dot(v) + square(sigma) * (u.normsq() + chisq);
+    }
+
   }  // namespace Agreg
 
   //======================================================================
@@ -284,6 +356,31 @@ namespace BOOM {
     refresh_suf();
   }
   //----------------------------------------------------------------------
+  void AggregatedRegressionModel::draw_collapsed_sufficient_statistics(
+      RNG &rng) {
+    if (!f.name().empty()) {
+      report_error("Collapsed sufficient statistics are only available "
+                   "with the identity transformation.");
+    }
+    // X'X, n, and the column sums of X do not depend on the unit values.
+    Ptr<RegSuf> suf = model_->suf();
+    SpdMatrix xtx = suf->xtx();
+    double n = suf->n();
+    Vector xbar = suf->xbar();
+
+    Vector xty(xtx.nrow(), 0.0);
+    double yty = 0;
+    double sumy = 0;
+    for (int i = 0; i < dat().size(); ++i) {
+      dat()[i]->add_collapsed_sufficient_statistics(
+          model_->Beta(), model_->sigma(), rng, xty, yty);
+      sumy += dat()[i]->total_value();
+    }
+    NEW(NeRegSuf, collapsed_suf)(xtx, xty, yty, n, sumy / n, xbar);
+    suf->clear();
+    suf->combine(collapsed_suf);
+  }
+  //----------------------------------------------------------------------
   // Communicate changes in raw data to sufficient statistics.
   void AggregatedRegressionModel::refresh_suf() {
     const std::vector<Ptr<RegressionData> > &data(model_->dat());
@@ -126,7 +126,33 @@ namespace BOOM {
       // unit to the average unit value.
       void initialize_unit_values();
 
+      // With the identity transformation the unit values given the group
+      // total are multivariate normal, with mean mu + (total - sum(mu)) / n
+      // and variance sigma^2 * (I - 11' / n), where mu = X * beta.  The
+      // regression model only needs X'y and y'y from the unit values, and
+      // these can be drawn directly from their joint conditional
+      // distribution at a cost that does not grow with the number of units
+      // in the group.  The individual unit values are not changed.  Note
+      // that the truncation of unit values to (0, total) imposed by
+      // distribute_total() is not applied here.
+      //
+      // Args:
+      //   beta:  The regression coefficients.
+      //   sigma:  The residual standard deviation.
+      //   rng:  The random number generator to use for the draw.
+      //   xty: The draw of X'y for this group is added to this vector.
+      //   yty: The draw of y'y for this group is added to this value.
+      void add_collapsed_sufficient_statistics(const Vector &beta,
+                                               double sigma, RNG &rng,
+                                               Vector &xty, double &yty);
+
+      double total_value() const { return total_value_; }
+
      private:
+      // Compute the statistics used by add_collapsed_sufficient_statistics.
+      // They depend only on the predictors, so they are computed once.
+      void compute_collapsed_statistics();
+
       // Reapportion the values of units [i] and [j] so that the total
       // value of the group is maintained.  This method is used to
       // implement distribute_total.
@@ -153,6 +179,14 @@ namespace BOOM {
 
       // Transformation to normality.
       const Transformation &f;
+
+      // Statistics used by add_collapsed_sufficient_statistics.
+      // centered_root_ is a p x r matrix of full column rank with
+      // centered_root_ * centered_root_' = X' (I - 11'/n) X.
+      bool have_collapsed_statistics_;
+      SpdMatrix xtx_;
+      Vector x_column_sums_;
+      Matrix centered_root_;
     };
   }  // namespace Agreg
 
@@ -183,6 +217,15 @@ namespace BOOM {
     // the model parameters.
     void distribute_group_totals();
 
+    // A collapsed alternative to distribute_group_totals(), available only
+    // with the identity transformation.  Draws the sufficient statistics of
+    // the regression model from their conditional distribution given the
+    // group totals, without imputing the individual unit values.  See
+    // Group::add_collapsed_sufficient_statistics.  The cost is
+    // O(number_of_groups * p^2), where p is the number of predictors,
+    // after a one-time cost of O(number_of_units * p^2).
+    void draw_collapsed_sufficient_statistics(RNG &rng);
+
     RegressionModel *regression_model() const { return model_.get(); }
 
    private:
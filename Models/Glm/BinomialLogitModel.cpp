@@ -17,6 +17,7 @@
   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
 */
 #include "Models/Glm/BinomialLogitModel.hpp"
+#include "Models/Glm/ShardedLogLikelihood.hpp"
 #include "cpputil/math_utils.hpp"
 #include "cpputil/report_error.hpp"
 #include "distributions.hpp"
@@ -26,6 +27,10 @@ namespace BOOM {
   namespace {
     typedef BinomialLogitModel BLM;
     typedef BinomialRegressionData BRD;
+
+    // The number of observations in each block of the log likelihood
+    // evaluation.  Blocks are the unit of work assigned to threads.
+    const int logit_block_size = 256;
   }  // namespace
 
   BLM::BinomialLogitModel(uint beta_dim, bool all)
@@ -56,7 +61,8 @@ namespace BOOM {
         ParamPolicy(rhs),
         DataPolicy(rhs),
         PriorPolicy(rhs),
-        log_alpha_(rhs.log_alpha_) {}
+        log_alpha_(rhs.log_alpha_),
+        pool_(rhs.pool_) {}
 
   BLM *BinomialLogitModel::clone() const {
     return new BinomialLogitModel(*this);
@@ -143,7 +149,6 @@ namespace BOOM {
 
   double BLM::log_likelihood(const Vector &beta, Vector *g, Matrix *h,
                              bool initialize_derivs) const {
-    const BLM::DatasetType &data(dat());
     if (initialize_derivs) {
       if (g) {
         g->resize(beta.size());
@@ -154,16 +159,27 @@ namespace BOOM {
         }
       }
     }
+    return sharded_log_likelihood(
+        pool_, dat().size(), logit_block_size, g, h,
+        [this, &beta](int begin, int end, Vector *gradient, Matrix *hessian) {
+          return accumulate_log_likelihood(begin, end, beta, gradient,
+                                           hessian);
+        });
+  }
+
+  double BLM::accumulate_log_likelihood(int begin, int end, const Vector &beta,
+                                        Vector *g, Matrix *h) const {
+    const BLM::DatasetType &data(dat());
     double ans = 0;
     bool all_coefficients_included = (xdim() == beta.size());
     const Selector &inc(coef().inc());
-    for (int i = 0; i < data.size(); ++i) {
+    Vector reduced_x;
+    for (int i = begin; i < end; ++i) {
       // y and n had been defined as uint's but y-n*p was computing
       // -n, which overflowed
       double y = data[i]->y();
       double n = data[i]->n();
       const Vector &x(data[i]->x());
-      Vector reduced_x;
       if (!all_coefficients_included) {
         reduced_x = inc.select(x);
       }
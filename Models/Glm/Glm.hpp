@@ -62,6 +62,11 @@ namespace BOOM {
       x_ = x;
     }
 
+    // Includes the predictors.
+    std::size_t memory_footprint() const override {
+      return sizeof(*this) + observer_bytes() + x_->memory_footprint();
+    }
+
    private:
     Ptr<VectorData> x_;
   };
@@ -101,6 +106,12 @@ namespace BOOM {
       y_ = y;
     }
 
+    // Includes the response and the predictors.
+    std::size_t memory_footprint() const override {
+      return GlmBaseData::memory_footprint() - sizeof(GlmBaseData)
+          + sizeof(*this) + y_->memory_footprint();
+    }
+
    private:
     // If an intercept is desired, it must be explicitly included.
     Ptr<DAT> y_;
@@ -135,6 +146,11 @@ namespace BOOM {
     void set_weight(double W) { weight_->set(W); }
     Ptr<DoubleData> WeightPtr() { return weight_; }
 
+    std::size_t memory_footprint() const override {
+      return Base::memory_footprint() - sizeof(Base) + sizeof(*this)
+          + weight_->memory_footprint();
+    }
+
    private:
     Ptr<DoubleData> weight_;
   };
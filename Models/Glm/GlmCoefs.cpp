@@ -18,7 +18,9 @@
 */
 
 #include "Models/Glm/GlmCoefs.hpp"
+#include <sstream>
 #include <stdexcept>
+#include "Models/StateSpace/Filters/SparseVector.hpp"
 #include "cpputil/report_error.hpp"
 
 namespace BOOM {
@@ -162,6 +164,18 @@ namespace BOOM {
     return do_prediction(this, x);
   }
 
+  double GlmCoefs::predict(const SparseVector &x) const {
+    if (x.size() != nvars_possible()) {
+      std::ostringstream err;
+      err << "A sparse predictor vector of dimension " << x.size()
+          << " is incompatible with a coefficient vector of dimension "
+          << nvars_possible() << ".";
+      report_error(err.str());
+    }
+    // Beta() is zero in the excluded positions, so no selection is needed.
+    return x.dot(Beta());
+  }
+
   Vector GlmCoefs::predict(const Matrix &design_matrix) const {
     Vector ans(design_matrix.nrow());
     predict(design_matrix, VectorView(ans));
@@ -264,6 +278,26 @@ namespace BOOM {
     return VectorParams::unvectorize(v);
   }
 
+  // The minimal representation holds only the included coefficients, so it
+  // goes through vectorize() and unvectorize().
+  void GlmCoefs::vectorize_into(VectorView out, bool minimal) const {
+    if (minimal) {
+      Params::vectorize_into(out, minimal);
+    } else {
+      VectorParams::vectorize_into(out, minimal);
+    }
+  }
+
+  void GlmCoefs::unvectorize_from(const ConstVectorView &values,
+                                  bool minimal) {
+    if (minimal) {
+      Params::unvectorize_from(values, minimal);
+    } else {
+      included_coefficients_current_ = false;
+      VectorParams::unvectorize_from(values, minimal);
+    }
+  }
+
   namespace {
     template <class VECTOR>
     void add_to_impl(VECTOR &vec, const Vector &included_coefficients, const Selector &inc) {
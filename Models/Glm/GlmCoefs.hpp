@@ -23,6 +23,8 @@
 #include "Models/ParamTypes.hpp"
 
 namespace BOOM {
+  class SparseVector;
+
   class GlmCoefs : public VectorParams {
    public:
     explicit GlmCoefs(uint p, bool all = true);  // beta is 0..p
@@ -60,6 +62,11 @@ namespace BOOM {
     double predict(const VectorView &x) const;
     double predict(const ConstVectorView &x) const;
 
+    // Prediction for a sparse predictor vector (e.g. a row of one-hot
+    // encoded categorical variables).  The cost is linear in the number of
+    // nonzero elements of x.  The dimension of x must be nvars_possible().
+    double predict(const SparseVector &x) const;
+
     //
     Vector predict(const Matrix &design_matrix) const;
     void predict(const Matrix &design_matrix, Vector &result) const;
@@ -105,6 +112,9 @@ namespace BOOM {
     Vector::const_iterator unvectorize(Vector::const_iterator &v,
                                        bool minimal = true) override;
     using Params::unvectorize;
+    void vectorize_into(VectorView out, bool minimal = true) const override;
+    void unvectorize_from(const ConstVectorView &values,
+                          bool minimal = true) override;
 
     // Add *this to vec.
     void add_to(VectorView vec) const;
@@ -18,6 +18,7 @@
 */
 
 #include "Models/Glm/LogisticRegressionModel.hpp"
+#include "Models/Glm/ShardedLogLikelihood.hpp"
 #include "Models/Glm/PosteriorSamplers/LogitSampler.hpp"
 #include "Models/MvnBase.hpp"
 #include "Models/PosteriorSamplers/PosteriorSampler.hpp"
@@ -28,6 +29,12 @@
 
 namespace BOOM {
 
+  namespace {
+    // The number of observations in each block of the log likelihood
+    // evaluation.  Blocks are the unit of work assigned to threads.
+    const int logit_block_size = 256;
+  }  // namespace
+
   LogisticRegressionModel::LogisticRegressionModel(uint beta_dim, bool all)
       : ParamPolicy(new GlmCoefs(beta_dim, all)), log_alpha_(0) {}
 
@@ -53,7 +60,8 @@ namespace BOOM {
         ParamPolicy(rhs),
         DataPolicy(rhs),
         PriorPolicy(rhs),
-        log_alpha_(rhs.log_alpha_) {}
+        log_alpha_(rhs.log_alpha_),
+        pool_(rhs.pool_) {}
 
   LogisticRegressionModel *LogisticRegressionModel::clone() const {
     return new LogisticRegressionModel(*this);
@@ -89,7 +97,6 @@ namespace BOOM {
 
   double LRM::log_likelihood(const Vector &beta, Vector *g, Matrix *h,
                              bool initialize_derivs) const {
-    const LRM::DatasetType &data(dat());
     if (initialize_derivs) {
       if (g) {
         g->resize(beta.size());
@@ -100,31 +107,37 @@ namespace BOOM {
         }
       }
     }
+    return sharded_log_likelihood(
+        pool_, dat().size(), logit_block_size, g, h,
+        [this, &beta](int begin, int end, Vector *gradient, Matrix *hessian) {
+          return accumulate_log_likelihood(begin, end, beta, gradient,
+                                           hessian);
+        });
+  }
 
+  double LRM::accumulate_log_likelihood(int begin, int end, const Vector &beta,
+                                        Vector *g, Matrix *h) const {
+    const LRM::DatasetType &data(dat());
     double ans = 0;
-    int n = data.size();
     bool all_coefficients_included = coef().nvars() == xdim();
     const Selector &inc(coef().inc());
-    for (int i = 0; i < n; ++i) {
+    Vector reduced_x;
+    for (int i = begin; i < end; ++i) {
       bool y = data[i]->y();
-      const Vector &x(data[i]->x());
-      double eta = predict(x) + log_alpha_;
+      const Vector &full_x(data[i]->x());
+      if (!all_coefficients_included) {
+        reduced_x = inc.select(full_x);
+      }
+      const Vector &x(all_coefficients_included ? full_x : reduced_x);
+      double eta = beta.dot(x) + log_alpha_;
       double loglike = plogis(eta, 0, 1, y, true);
       ans += loglike;
       if (g) {
         double logp = y ? loglike : plogis(eta, 0, 1, true, true);
         double p = exp(logp);
-        if (all_coefficients_included) {
-          *g += (y - p) * x;
-          if (h) {
-            h->add_outer(x, x, -p * (1 - p));
-          }
-        } else {
-          Vector reduced_x = inc.select(x);
-          *g += (y - p) * reduced_x;
-          if (h) {
-            h->add_outer(reduced_x, reduced_x, -p * (1 - p));
-          }
+        g->axpy(x, y - p);
+        if (h) {
+          h->add_outer(x, x, -p * (1 - p));
         }
       }
     }
@@ -27,6 +27,7 @@
 #include "Models/Policies/ParamPolicy_1.hpp"
 #include "Models/Policies/PriorPolicy.hpp"
 #include "TargetFun/TargetFun.hpp"
+#include "cpputil/ThreadTools.hpp"
 #include "numopt.hpp"
 
 namespace BOOM {
@@ -71,11 +72,21 @@ namespace BOOM {
     void set_nonevent_sampling_prob(double alpha);
     double log_alpha() const;
 
+    // Evaluate the log likelihood and its derivatives using up to n
+    // threads.  The result does not depend on the number of threads.
+    void set_number_of_threads(int n) { pool_.set_number_of_threads(n); }
+
    private:
+    // Add the derivative contributions of observations [begin, end) to g
+    // and h (if non-NULL), and return their log likelihood.
+    double accumulate_log_likelihood(int begin, int end, const Vector &beta,
+                                     Vector *g, Matrix *h) const;
+
     double log_alpha_;  // alpha is the probability that a 'zero'
                         // (non-event) is retained in the data.  It is
                         // assumed that the data retains all the
                         // events and 100 alpha% of the non-events
+    mutable SharedThreadPool pool_;
   };
 
 }  // namespace BOOM
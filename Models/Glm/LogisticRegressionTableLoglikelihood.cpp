@@ -0,0 +1,104 @@
+// Copyright 2018 Google LLC. All Rights Reserved.
+/*
+  Copyright (C) 2005-2018 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#include "Models/Glm/LogisticRegressionTableLoglikelihood.hpp"
+#include <algorithm>
+#include <cmath>
+#include "cpputil/report_error.hpp"
+#include "distributions.hpp"
+#include "stats/logit.hpp"
+
+namespace BOOM {
+
+  namespace {
+    typedef LogisticRegressionTableLoglikelihood LRTL;
+
+    // Observations are processed in blocks of this size when the full data
+    // set is traversed, so each block can be handled with matrix operations.
+    const int table_block_size = 256;
+
+    // The log likelihood contribution of a single 0/1 observation with
+    // linear predictor eta.  The derivative with respect to eta is y -
+    // plogis(eta).
+    inline double logit_loglike(double y, double eta) {
+      return y * eta - lope(eta);
+    }
+  }  // namespace
+
+  LRTL::LogisticRegressionTableLoglikelihood(
+      const Ptr<RegressionDataTable> &data)
+      : data_(data) {
+    if (!data_) {
+      report_error("LogisticRegressionTableLoglikelihood needs a data table.");
+    }
+  }
+
+  double LRTL::operator()(const Vector &beta) const {
+    return full_data_value(beta, nullptr);
+  }
+
+  double LRTL::operator()(const Vector &beta, Vector &gradient) const {
+    return full_data_value(beta, &gradient);
+  }
+
+  double LRTL::subsample_value(const Vector &beta, Vector &gradient,
+                               const std::vector<int> &subsample) const {
+    gradient.resize(beta.size());
+    gradient = 0.0;
+    double ans = 0;
+    for (int i : subsample) {
+      ConstVectorView x(data_->predictors(i));
+      double y = data_->response(i);
+      double eta = x.dot(beta);
+      ans += logit_loglike(y, eta);
+      gradient.axpy(x, y - plogis(eta));
+    }
+    return ans;
+  }
+
+  double LRTL::full_data_value(const Vector &beta, Vector *gradient) const {
+    if (beta.size() != data_->xdim()) {
+      report_error("Coefficient vector does not match the data table.");
+    }
+    if (gradient) {
+      gradient->resize(beta.size());
+      *gradient = 0.0;
+    }
+    double ans = 0;
+    Matrix X;
+    Vector residual;
+    int n = data_->sample_size();
+    for (int begin = 0; begin < n; begin += table_block_size) {
+      int end = std::min(n, begin + table_block_size);
+      data_->fill_design_matrix(begin, end, X);
+      Vector eta = X * beta;
+      ConstVectorView y(data_->responses(begin, end));
+      residual.resize(eta.size());
+      for (int i = 0; i < eta.size(); ++i) {
+        ans += logit_loglike(y[i], eta[i]);
+        residual[i] = y[i] - plogis(eta[i]);
+      }
+      if (gradient) {
+        *gradient += residual * X;
+      }
+    }
+    return ans;
+  }
+
+}  // namespace BOOM
@@ -0,0 +1,59 @@
+// Copyright 2018 Google LLC. All Rights Reserved.
+/*
+  Copyright (C) 2005-2018 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#ifndef BOOM_GLM_LOGISTIC_REGRESSION_TABLE_LOGLIKELIHOOD_HPP_
+#define BOOM_GLM_LOGISTIC_REGRESSION_TABLE_LOGLIKELIHOOD_HPP_
+
+#include <vector>
+#include "LinAlg/Matrix.hpp"
+#include "LinAlg/Vector.hpp"
+#include "Models/Glm/RegressionDataTable.hpp"
+#include "TargetFun/TargetFun.hpp"
+
+namespace BOOM {
+
+  // The log likelihood of a logistic regression model whose data are stored
+  // in a RegressionDataTable.  The responses in the table must be 0 or 1.
+  // The function argument is the full vector of regression coefficients.
+  //
+  // Each observation is a term in the sum, so the log likelihood and its
+  // gradient can be evaluated on a minibatch of observations without
+  // touching the rest of the table.
+  class LogisticRegressionTableLoglikelihood : public dSubsampleTargetFun {
+   public:
+    explicit LogisticRegressionTableLoglikelihood(
+        const Ptr<RegressionDataTable> &data);
+
+    double operator()(const Vector &beta) const override;
+    double operator()(const Vector &beta, Vector &gradient) const override;
+    int number_of_terms() const override { return data_->sample_size(); }
+    double subsample_value(const Vector &beta, Vector &gradient,
+                           const std::vector<int> &subsample) const override;
+
+   private:
+    // The full data log likelihood, evaluated in blocks of observations.
+    // The gradient is only computed if 'gradient' is non-NULL.
+    double full_data_value(const Vector &beta, Vector *gradient) const;
+
+    Ptr<RegressionDataTable> data_;
+  };
+
+}  // namespace BOOM
+
+#endif  // BOOM_GLM_LOGISTIC_REGRESSION_TABLE_LOGLIKELIHOOD_HPP_
@@ -19,6 +19,7 @@
 #include <vector>
 #include <algorithm>
 #include <cstdint>
+#include <limits>
 #include "cpputil/ToString.hpp"
 #include "Models/Glm/LoglinearModel.hpp"
 #include "Models/SufstatAbstractCombineImpl.hpp"
@@ -256,6 +257,8 @@ namespace BOOM {
       std::copy(v, v + el.second.size(), el.second.begin());
       v += el.second.size();
     }
+    observed_cells_.clear();
+    cells_current_ = false;
     return v;
   }
 
@@ -269,6 +272,10 @@ namespace BOOM {
     for (auto &el : cross_tabulations_) {
       cross_tabulations_[el.first] = 0.0;
     }
+    nlevels_.clear();
+    radix_.clear();
+    observed_cells_.clear();
+    cells_current_ = true;
     sample_size_ = 0;
     valid_ = true;
   }
@@ -281,8 +288,22 @@ namespace BOOM {
   void LoglinearModelSuf::refresh(const std::vector<Ptr<MCD>> &data) {
     clear();
     for (const auto &el : data) {
-      Update(*el);
+      if (nlevels_.empty()) {
+        set_cell_structure(*el);
+      }
+      observed_cells_[cell_code(*el)] += el->frequency();
+      sample_size_ += el->frequency();
+    }
+
+    // Each margin is projected from the observed cells into its own table,
+    // so the margins can be filled in parallel.
+    std::vector<std::pair<const std::vector<int> *, Array *>> margins;
+    for (auto &el : cross_tabulations_) {
+      margins.emplace_back(&el.first, &el.second);
     }
+    pool_.parallel_for(0, margins.size(), 1, [this, &margins](int i) {
+      project_cells(*margins[i].first, *margins[i].second);
+    });
   }
 
   void LoglinearModelSuf::Update(const MCD &data) {
@@ -292,27 +313,106 @@ namespace BOOM {
     if (!valid_) {
       report_error("LoglinearModelSuf::Update called from an invalid state.");
     }
+    if (nlevels_.empty()) {
+      set_cell_structure(data);
+    }
+    observed_cells_[cell_code(data)] += data.frequency();
     sample_size_ += data.frequency();
     for (auto &el : cross_tabulations_) {
-      std::vector<int> index = el.first;
-      // index starts off containing the indices of the variables involved in an
-      // effect.  Replace each element of 'index' with the value of the variable
-      // at that index.
-      for (int j = 0; j < index.size(); ++j) {
-        const CategoricalData &variable(data[index[j]]);
-        index[j] = variable.value();
+      // el.first contains the indices of the variables involved in an effect.
+      // The values of those variables index the cross tabulation.  The
+      // position is accumulated directly from the strides to avoid building
+      // an index vector for each effect.
+      const std::vector<int> &variables(el.first);
+      Array &table(el.second);
+      int position = 0;
+      for (int j = 0; j < variables.size(); ++j) {
+        const CategoricalData &variable(data[variables[j]]);
+        position += variable.value() * table.stride(j);
+      }
+      table.data()[position] += data.frequency();
+    }
+  }
+
+  void LoglinearModelSuf::set_cell_structure(const MCD &data) {
+    int nvars = data.nvars();
+    nlevels_.resize(nvars);
+    radix_.resize(nvars);
+    std::uint64_t radix = 1;
+    for (int i = 0; i < nvars; ++i) {
+      nlevels_[i] = data[i].nlevels();
+      radix_[i] = radix;
+      if (nlevels_[i] > 0
+          && radix > std::numeric_limits<std::uint64_t>::max() / nlevels_[i]) {
+        report_error("The full contingency table has too many cells to be "
+                     "indexed by a 64 bit cell code.");
       }
-      el.second[index] += data.frequency();
+      radix *= nlevels_[i];
+    }
+  }
+
+  std::uint64_t LoglinearModelSuf::cell_code(const MCD &data) const {
+    if (data.nvars() != nlevels_.size()) {
+      report_error("Data point has the wrong number of variables.");
+    }
+    std::uint64_t code = 0;
+    for (int i = 0; i < nlevels_.size(); ++i) {
+      code += data[i].value() * radix_[i];
+    }
+    return code;
+  }
+
+  void LoglinearModelSuf::decode_cell(std::uint64_t code,
+                                      std::vector<int> &levels) const {
+    levels.resize(nlevels_.size());
+    for (int i = 0; i < nlevels_.size(); ++i) {
+      levels[i] = code % nlevels_[i];
+      code /= nlevels_[i];
     }
   }
 
+  void LoglinearModelSuf::project_cells(
+      const std::vector<int> &which_variables, Array &table) const {
+    for (const auto &cell : observed_cells_) {
+      int position = 0;
+      for (int j = 0; j < which_variables.size(); ++j) {
+        int var = which_variables[j];
+        int level = (cell.first / radix_[var]) % nlevels_[var];
+        position += level * table.stride(j);
+      }
+      table.data()[position] += cell.second;
+    }
+  }
+
+  Array LoglinearModelSuf::project(
+      const std::vector<int> &which_variables) const {
+    if (!cells_current_) {
+      report_error("The observed cells are not available after unvectorize.");
+    }
+    std::vector<int> dims;
+    for (int j = 0; j < which_variables.size(); ++j) {
+      int var = which_variables[j];
+      if (var < 0 || var >= nlevels_.size()
+          || (j > 0 && var <= which_variables[j - 1])) {
+        report_error("Variables to project must be valid, increasing "
+                     "indices.");
+      }
+      dims.push_back(nlevels_[var]);
+    }
+    Array ans(dims, 0.0);
+    project_cells(which_variables, ans);
+    return ans;
+  }
+
   void LoglinearModelSuf::add_effect(
       const Ptr<CategoricalDataEncoder> &effect) {
     effects_.push_back(effect);
-    cross_tabulations_[effect->which_variables()] = Array(
-        effect->nlevels(), 0.0);
-    if (sample_size_ > 0) {
+    Array &table = cross_tabulations_[effect->which_variables()];
+    table = Array(effect->nlevels(), 0.0);
+    if (!cells_current_) {
       valid_ = false;
+    } else if (!observed_cells_.empty()) {
+      project_cells(effect->which_variables(), table);
     }
   }
 
@@ -320,6 +420,15 @@ namespace BOOM {
     for (const auto &el : rhs.cross_tabulations_) {
       cross_tabulations_[el.first] += el.second;
     }
+    if (nlevels_.empty()) {
+      nlevels_ = rhs.nlevels_;
+      radix_ = rhs.radix_;
+    }
+    for (const auto &cell : rhs.observed_cells_) {
+      observed_cells_[cell.first] += cell.second;
+    }
+    cells_current_ = cells_current_ && rhs.cells_current_;
+    sample_size_ += rhs.sample_size_;
   }
 
   void LoglinearModelSuf::combine(const Ptr<LoglinearModelSuf> &rhs) {
@@ -364,8 +473,7 @@ namespace BOOM {
     for (size_t i = 0; i < table.nrow(); ++i) {
       NEW(MultivariateCategoricalData, data_point)();
       for (size_t j = 0; j < categorical_variables.size(); ++j) {
-        data_point->push_back(table.get_nominal(
-            categorical_variables[j])[i]);
+        data_point->push_back(table.get_nominal(i, categorical_variables[j]));
       }
       add_data(data_point);
     }
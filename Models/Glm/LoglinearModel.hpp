@@ -20,6 +20,7 @@
 
 #include <map>
 #include <cstdint>
+#include <unordered_map>
 
 #include "Models/CategoricalData.hpp"
 #include "Models/Sufstat.hpp"
@@ -33,6 +34,7 @@
 #include "distributions/rng.hpp"
 #include "stats/DataTable.hpp"
 #include "stats/Encoders.hpp"
+#include "cpputil/ThreadTools.hpp"
 
 namespace BOOM {
 
@@ -225,9 +227,17 @@ namespace BOOM {
   //===========================================================================
   // The sufficient statistics for a log linear model are the marginal cross
   // tabulations for each effect in the model.
+  //
+  // The object also keeps a sparse record of the full contingency table: the
+  // frequency of each distinct cell that has been observed.  With many
+  // variables the full table is far too large to store, but the number of
+  // observed cells is at most the number of data points.  Margins for new
+  // effects, or for arbitrary sets of variables, are computed by projecting
+  // the observed cells.
   class LoglinearModelSuf : public SufstatDetails<MultivariateCategoricalData> {
    public:
-    LoglinearModelSuf() : sample_size_(0), valid_(true) {}
+    LoglinearModelSuf()
+        : cells_current_(true), sample_size_(0), valid_(true) {}
     LoglinearModelSuf *clone() const override {
       return new LoglinearModelSuf(*this);
     }
@@ -242,14 +252,14 @@ namespace BOOM {
     Vector::const_iterator unvectorize(
         const Vector &v, bool minimal=true) override;
 
-    // Add a main effect or interaction to the model structure.
+    // Add a main effect or interaction to the model structure.  If data has
+    // already been added, the margin for the new effect is computed by
+    // projecting the observed cells, so no refresh is needed.
     //
-    // If data has already been allocated to the object, adding an effect
-    // invalidates the object.  To put it back in a valid state call "refresh"
-    // and pass the original data.
-    //
-    // If all elements of model structure are added prior to calling
-    // Update. Then no refreshing is needed.
+    // The exception is an object whose data was set by 'unvectorize', which
+    // restores the margins but not the observed cells.  Adding an effect to
+    // such an object invalidates it.  To put it back in a valid state call
+    // "refresh" and pass the original data.
     void add_effect(const Ptr<CategoricalDataEncoder> &effect);
 
     // Clear the data but keep the information about model structure.  Set the
@@ -259,9 +269,17 @@ namespace BOOM {
     // Clear everything.
     void clear_data_and_structure();
 
-    // Clear the data and recompute the sufficient statistics.
+    // Clear the data and recompute the sufficient statistics.  The data are
+    // first tabulated into observed cells, and the margins for each effect
+    // are then projected from the cells, in parallel if threads have been
+    // assigned.
     void refresh(const std::vector<Ptr<MultivariateCategoricalData>> &data);
 
+    // The number of threads to use when computing margins in 'refresh'.
+    void set_number_of_threads(int number_of_threads) {
+      pool_.set_number_of_threads(number_of_threads);
+    }
+
     // It is an error to update the sufficient statistics with new data when the
     // object is in an invalid state.  The easiest way to prevent this from
     // happening is to add all elements of model structure before calling
@@ -288,9 +306,45 @@ namespace BOOM {
     //   number of times X0 == i, X1 == j, and X2 == k.
     const Array &margin(const std::vector<int> &index) const;
 
+    // Cross tabulate an arbitrary set of variables by projecting the observed
+    // cells.  The cost is proportional to the number of observed cells, not
+    // the size of the full table.
+    //
+    // Args:
+    //   which_variables: The indices of the variables to tabulate, in
+    //     increasing order.
+    //
+    // Returns:
+    //   An array laid out in the same way as the return value of margin().
+    Array project(const std::vector<int> &which_variables) const;
+
+    // The observed cells of the full contingency table.  Each key is a cell
+    // code, which can be decoded using decode_cell.  Each value is the total
+    // frequency of the data falling in that cell.
+    const std::unordered_map<std::uint64_t, double> &observed_cells() const {
+      return observed_cells_;
+    }
+
+    // The code identifying the cell containing 'data'.  The code is the
+    // position of the cell in the full table, with the first variable
+    // changing fastest.
+    std::uint64_t cell_code(const MultivariateCategoricalData &data) const;
+
+    // Fill 'levels' with the level of each variable in the cell identified by
+    // 'code'.
+    void decode_cell(std::uint64_t code, std::vector<int> &levels) const;
+
     std::int64_t sample_size() const {return sample_size_;}
 
    private:
+    // Record the number of levels of each variable from the first data
+    // point, and set up the radices used to compute cell codes.
+    void set_cell_structure(const MultivariateCategoricalData &data);
+
+    // Add the observed cells to the margin 'table' of 'which_variables'.
+    void project_cells(const std::vector<int> &which_variables,
+                       Array &table) const;
+
     std::vector<Ptr<CategoricalDataEncoder>> effects_;
 
     // Cross tabulations are indexed by a vector containing the indices of the
@@ -298,11 +352,26 @@ namespace BOOM {
     // variables 0, 2, and 5.  The indices must be in order.
     std::map<std::vector<int>, Array> cross_tabulations_;
 
+    // The number of levels in each variable, and the amount by which a cell
+    // code changes when the level of each variable increases by one.  Both
+    // are empty until the first data point is seen.
+    std::vector<int> nlevels_;
+    std::vector<std::uint64_t> radix_;
+
+    std::unordered_map<std::uint64_t, double> observed_cells_;
+
+    // False if the margins were set by unvectorize, in which case
+    // observed_cells_ does not describe them.
+    bool cells_current_;
+
     std::int64_t sample_size_;
 
-    // The state of the object.  The state becomes invalid each time an effect
-    // is added.  The state can be made valid by calling clear() or refresh().
+    // The state of the object.  The state becomes invalid if an effect is
+    // added when the margins are known but the observed cells are not.  The
+    // state can be made valid by calling clear() or refresh().
     bool valid_;
+
+    SharedThreadPool pool_;
   };
 
   //===========================================================================
@@ -318,9 +387,8 @@ namespace BOOM {
     LoglinearModel();
 
     // Build a LoglinearModel from the categorical variables in a DataTable.
-    //
-    // A model built with this constructor must call refresh_suf() after all
-    // model structure is added.
+    // Margins for interactions added later are projected from the observed
+    // cells in the sufficient statistics, so refresh_suf() need not be called.
     explicit LoglinearModel(const DataTable &table);
 
     LoglinearModel *clone() const override;
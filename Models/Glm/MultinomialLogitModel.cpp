@@ -17,10 +17,12 @@
 */
 #include "Models/Glm/MultinomialLogitModel.hpp"
 
+#include <algorithm>
 #include <cmath>
 #include <functional>
 
 #include "LinAlg/VectorView.hpp"
+#include "Models/Glm/ShardedLogLikelihood.hpp"
 #include "Models/Glm/PosteriorSamplers/MLVS.hpp"
 #include "Models/MvnBase.hpp"
 #include "TargetFun/LogPost.hpp"
@@ -35,6 +37,12 @@ namespace BOOM {
 
   typedef MultinomialLogitModel MLM;
 
+  namespace {
+    // The number of observations handled by each matrix multiplication when
+    // evaluating the log likelihood over the full data set.
+    const int mlogit_block_size = 256;
+  }  // namespace
+
   inline Vector make_vector(const Matrix &beta_subject,
                             const Vector &beta_choice) {
     Vector b(beta_subject.begin(), beta_subject.end());
@@ -125,7 +133,8 @@ namespace BOOM {
         nch_(rhs.nch_),
         psub_(rhs.psub_),
         pch_(rhs.pch_),
-        log_sampling_probs_(rhs.log_sampling_probs_) {
+        log_sampling_probs_(rhs.log_sampling_probs_),
+        pool_(rhs.pool_) {
     setup_observers();
   }
   //------------------------------------------------------------
@@ -183,47 +192,141 @@ namespace BOOM {
   //------------------------------------------------------------
   double MLM::log_likelihood(const Vector &beta, Vector &g, Matrix &h,
                              int nd) const {
-    const std::vector<Ptr<ChoiceData> > &d(dat());
-    double ans = 0;
-    uint nobs = d.size();
-    Vector xbar;
-    Vector probs;
-    Vector tmpx;
-    Matrix X;
-    bool downsampling = log_sampling_probs().size() == Nchoices();
-    Selector inc(this->inc());
-    int beta_dim = inc.nvars();
+    const Selector &inc(this->inc());
+    Matrix subject_coefficients;
+    Vector choice_coefficients;
+    unpack_coefficients(beta, subject_coefficients, choice_coefficients);
+
+    int full_dim = beta_size(false);
+    Vector gradient;
+    Matrix hessian;
+    if (nd > 0) {
+      gradient.resize(full_dim);
+      gradient = 0;
+      if (nd > 1) {
+        hessian.resize(full_dim, full_dim);
+        hessian = 0;
+      }
+    }
+
+    double ans = sharded_log_likelihood(
+        pool_, dat().size(), mlogit_block_size, nd > 0 ? &gradient : nullptr,
+        nd > 1 ? &hessian : nullptr,
+        [&](int begin, int end, Vector *block_gradient,
+            Matrix *block_hessian) {
+          // Unused derivatives are never touched when nd is small.
+          Vector unused_gradient;
+          Matrix unused_hessian;
+          return accumulate_log_likelihood(
+              begin, end, subject_coefficients, choice_coefficients,
+              block_gradient ? *block_gradient : unused_gradient,
+              block_hessian ? *block_hessian : unused_hessian, nd);
+        });
+
     if (nd > 0) {
-      g.resize(beta_dim);
-      g = 0;
+      bool all_included = inc.nvars_excluded() == 0;
+      g = all_included ? gradient : inc.select(gradient);
       if (nd > 1) {
-        h.resize(beta_dim, beta_dim);
-        h = 0;
+        h = all_included ? hessian : inc.select_square(hessian);
       }
     }
+    return ans;
+  }
+
+  //------------------------------------------------------------
+  double MLM::accumulate_log_likelihood(int begin, int end,
+                                        const Matrix &subject_coefficients,
+                                        const Vector &choice_coefficients,
+                                        Vector &gradient, Matrix &hessian,
+                                        int nd) const {
+    const std::vector<Ptr<ChoiceData>> &data(dat());
+    int nobs = end - begin;
+    int M = Nchoices();
+    int psub = subject_nvars();
+    int pch = choice_nvars();
+    int subject_dim = (M - 1) * psub;
+
+    Matrix X, probs;
+    fill_eta(begin, end, subject_coefficients, choice_coefficients, X, probs);
+    double ans = 0;
+    for (int i = 0; i < nobs; ++i) {
+      ans += probs(i, data[begin + i]->value());
+    }
+    ans -= normalize_logprob_rows(probs).sum();
+    if (nd <= 0) return ans;
 
-    for (uint i = 0; i < nobs; ++i) {
-      Ptr<ChoiceData> dp = d[i];
-      uint y = dp->value();
-      fill_eta(*dp, wsp_, beta);
-      if (downsampling) {
-        wsp_ += log_sampling_probs();
+    // The residuals y - probs, where y is the 0/1 indicator of the response.
+    Matrix residual = probs * -1.0;
+    for (int i = 0; i < nobs; ++i) {
+      residual(i, data[begin + i]->value()) += 1.0;
+    }
+    if (psub > 0) {
+      Matrix subject_gradient = X.Tmult(residual);
+      for (int m = 1; m < M; ++m) {
+        VectorView(gradient, (m - 1) * psub, psub) += subject_gradient.col(m);
+      }
+    }
+    VectorView choice_gradient(gradient, subject_dim, pch);
+    for (int i = 0; i < nobs && pch > 0; ++i) {
+      for (int m = 0; m < M; ++m) {
+        choice_gradient.axpy(data[begin + i]->Xchoice(m), residual(i, m));
       }
-      double lognc = lse(wsp_);
-      ans += wsp_[y] - lognc;
-      if (nd > 0) {
-        uint M = dp->nchoices();
-        X = inc.select_cols(dp->X(false));
-        probs = exp(wsp_ - lognc);
-        xbar = probs * X;
-        g += X.row(y) - xbar;
-
-        if (nd > 1) {
-          for (uint m = 0; m < M; ++m) {
-            tmpx = X.row(m);
-            h.add_outer(tmpx, tmpx, -probs[m]);
+    }
+    if (nd <= 1) return ans;
+
+    // The Hessian is minus the variance of the gradient of eta under the
+    // choice probabilities.  The subject block for choices (m, m') is
+    //   -sum_i x_i x_i' p_im (delta_mm' - p_im').
+    // With W = [diag(p_1) X, ..., diag(p_{M-1}) X] the off-diagonal part is
+    // W'W, computed in a single matrix multiplication.
+    if (psub > 0 && M > 1) {
+      Matrix W(nobs, subject_dim);
+      for (int m = 1; m < M; ++m) {
+        for (int j = 0; j < psub; ++j) {
+          int k = (m - 1) * psub + j;
+          for (int i = 0; i < nobs; ++i) {
+            W(i, k) = X(i, j) * probs(i, m);
           }
-          h.add_outer(xbar, xbar);
+        }
+      }
+      SubMatrix subject_hessian(hessian, 0, subject_dim - 1, 0,
+                                subject_dim - 1);
+      subject_hessian += W.Tmult(W);
+      Matrix diagonal_blocks = X.Tmult(W);
+      for (int m = 1; m < M; ++m) {
+        int lo = (m - 1) * psub;
+        SubMatrix(hessian, lo, lo + psub - 1, lo, lo + psub - 1) -=
+            SubMatrix(diagonal_blocks, 0, psub - 1, lo, lo + psub - 1);
+      }
+    }
+
+    if (pch > 0) {
+      Vector xbar(pch);
+      for (int i = 0; i < nobs; ++i) {
+        const ChoiceData &dp(*data[begin + i]);
+        xbar = 0;
+        for (int m = 0; m < M; ++m) {
+          xbar.axpy(dp.Xchoice(m), probs(i, m));
+        }
+        SubMatrix choice_hessian(hessian, subject_dim, subject_dim + pch - 1,
+                                 subject_dim, subject_dim + pch - 1);
+        Matrix choice_outer(pch, pch, 0.0);
+        for (int m = 0; m < M; ++m) {
+          choice_outer.add_outer(dp.Xchoice(m), dp.Xchoice(m), probs(i, m));
+        }
+        choice_outer.add_outer(xbar, xbar, -1.0);
+        choice_hessian -= choice_outer;
+
+        // Cross terms: -p_im x_i (x_im - xbar)' for the subject block of
+        // choice m.
+        for (int m = 1; m < M && psub > 0; ++m) {
+          Matrix cross(psub, pch, 0.0);
+          cross.add_outer(dp.Xsubject(), dp.Xchoice(m) - xbar, -probs(i, m));
+          int lo = (m - 1) * psub;
+          SubMatrix(hessian, lo, lo + psub - 1, subject_dim,
+                    subject_dim + pch - 1) += cross;
+          SubMatrix(hessian, subject_dim, subject_dim + pch - 1, lo,
+                    lo + psub - 1) += cross.transpose();
         }
       }
     }
@@ -292,6 +395,81 @@ namespace BOOM {
     return fill_eta(dp, ans, beta());
   }
 
+  Matrix &MLM::fill_eta(int begin, int end, const Vector &beta,
+                        Matrix &eta) const {
+    Matrix subject_coefficients;
+    Vector choice_coefficients;
+    unpack_coefficients(beta, subject_coefficients, choice_coefficients);
+    Matrix X;
+    return fill_eta(begin, end, subject_coefficients, choice_coefficients, X,
+                    eta);
+  }
+
+  Matrix &MLM::fill_eta(int begin, int end,
+                        const Matrix &subject_coefficients,
+                        const Vector &choice_coefficients, Matrix &X,
+                        Matrix &eta) const {
+    if (begin < 0 || end > dat().size() || begin > end) {
+      report_error("Invalid range of observations in fill_eta.");
+    }
+    int nobs = end - begin;
+    int M = Nchoices();
+    fill_subject_predictors(begin, end, X);
+    eta.resize(nobs, M);
+    if (subject_nvars() > 0) {
+      X.mult(subject_coefficients, eta);
+    } else {
+      eta = 0;
+    }
+    const std::vector<Ptr<ChoiceData>> &data(dat());
+    if (choice_nvars() > 0) {
+      for (int i = 0; i < nobs; ++i) {
+        const ChoiceData &dp(*data[begin + i]);
+        for (int m = 0; m < M; ++m) {
+          eta(i, m) += choice_coefficients.dot(dp.Xchoice(m));
+        }
+      }
+    }
+    if (log_sampling_probs().size() == M) {
+      for (int i = 0; i < nobs; ++i) {
+        eta.row(i) += log_sampling_probs();
+      }
+    }
+    return eta;
+  }
+
+  void MLM::fill_subject_predictors(int begin, int end, Matrix &X) const {
+    int psub = subject_nvars();
+    X.resize(end - begin, psub);
+    const std::vector<Ptr<ChoiceData>> &data(dat());
+    for (int i = begin; i < end; ++i) {
+      const Vector &x(data[i]->Xsubject());
+      for (int j = 0; j < psub; ++j) {
+        X(i - begin, j) = x[j];
+      }
+    }
+  }
+
+  void MLM::unpack_coefficients(const Vector &beta,
+                                Matrix &subject_coefficients,
+                                Vector &choice_coefficients) const {
+    const Selector &included(inc());
+    const Vector &full_beta =
+        beta.size() == beta_size(false) ? beta : included.expand(beta);
+    if (full_beta.size() != beta_size(false)) {
+      report_error("Wrong size coefficient vector in MultinomialLogitModel.");
+    }
+    int M = Nchoices();
+    int psub = subject_nvars();
+    subject_coefficients.resize(psub, M);
+    subject_coefficients.col(0) = 0.0;
+    for (int m = 1; m < M; ++m) {
+      subject_coefficients.col(m) =
+          ConstVectorView(full_beta, (m - 1) * psub, psub);
+    }
+    choice_coefficients = ConstVectorView(full_beta, (M - 1) * psub);
+  }
+
   //------------------------------------------------------------
   double MLM::pdf(const Ptr<Data> &dp, bool logscale) const {
     double ans = logp(*DAT(dp));
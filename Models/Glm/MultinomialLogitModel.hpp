@@ -26,6 +26,7 @@
 #include "Models/Policies/IID_DataPolicy.hpp"
 #include "Models/Policies/ParamPolicy_1.hpp"
 #include "Models/Policies/PriorPolicy.hpp"
+#include "cpputil/ThreadTools.hpp"
 
 namespace BOOM {
 
@@ -170,6 +171,20 @@ namespace BOOM {
                      const Vector &full_beta) const;
     Vector &fill_eta(const ChoiceData &, Vector &ans) const;
 
+    // Fill the linear predictors for a block of the model's data, with one
+    // row per observation and one column per choice.  The subject level
+    // contributions for the whole block are computed with a single matrix
+    // multiplication, rather than building each observation's design
+    // matrix.
+    //
+    // Args:
+    //   begin, end:  The block of observations is dat()[begin, ..., end-1].
+    //   beta: The vector of coefficients, with structural zeros omitted.
+    //     Either the full vector (as in beta()) or just its included
+    //     elements.
+    //   eta:  Resized to (end - begin) x Nchoices() and filled on output.
+    Matrix &fill_eta(int begin, int end, const Vector &beta, Matrix &eta) const;
+
     //----------------------------------------------------------------------
     virtual double pdf(const Ptr<Data> &dp, bool logscale) const;
     double pdf(const Data *dp, bool logscale) const override;
@@ -211,7 +226,35 @@ namespace BOOM {
     void set_sampling_probs(const Vector &probs);
     const Vector &log_sampling_probs() const;
 
+    // Evaluate the log likelihood and its derivatives using up to n
+    // threads.  The result does not depend on the number of threads.
+    void set_number_of_threads(int n) { pool_.set_number_of_threads(n); }
+
    private:
+    // Expand 'beta' (either full or just the included elements) into the
+    // subject coefficients, with one column per choice (column 0 is zero),
+    // and the choice level coefficients.
+    void unpack_coefficients(const Vector &beta, Matrix &subject_coefficients,
+                             Vector &choice_coefficients) const;
+
+    // Fill the (end - begin) x subject_nvars() matrix of subject level
+    // predictors for a block of data.
+    void fill_subject_predictors(int begin, int end, Matrix &X) const;
+
+    Matrix &fill_eta(int begin, int end, const Matrix &subject_coefficients,
+                     const Vector &choice_coefficients, Matrix &X,
+                     Matrix &eta) const;
+
+    // Add the log likelihood contribution of a block of data to the return
+    // value, and (depending on nd) its derivatives to the gradient and
+    // Hessian with respect to beta(), with structural zeros omitted and no
+    // variables excluded.
+    double accumulate_log_likelihood(int begin, int end,
+                                     const Matrix &subject_coefficients,
+                                     const Vector &choice_coefficients,
+                                     Vector &gradient, Matrix &hessian,
+                                     int nd) const;
+
     mutable Vector beta_with_zeros_;
     mutable bool beta_with_zeros_current_;
 
@@ -226,6 +269,7 @@ namespace BOOM {
     uint psub_;  // number of subject X variables
     uint pch_;   // number of choice X variables
     Vector log_sampling_probs_;
+    mutable SharedThreadPool pool_;
   };
 }  // namespace BOOM
 #endif  // BOOM_MULTINOMIAL_LOGIT_MODEL_HPP
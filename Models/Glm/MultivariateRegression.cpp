@@ -27,11 +27,15 @@ namespace BOOM {
   //======================================================================
 
   MvRegSuf::MvRegSuf(uint xdim, uint ydim)
-      : yty_(ydim), xtx_(xdim), xty_(xdim, ydim), n_(0) {}
+      : yty_(ydim), xtx_(xdim), xty_(xdim, ydim), sumw_(0), n_(0) {}
 
 
   MvRegSuf::MvRegSuf(const Matrix &X, const Matrix &Y)
-      : yty_(Y.ncol()), xtx_(X.ncol()), xty_(X.ncol(), Y.ncol()), n_(0) {
+      : yty_(Y.ncol()),
+        xtx_(X.ncol()),
+        xty_(X.ncol(), Y.ncol()),
+        sumw_(0),
+        n_(0) {
     QR qr(X);
     Matrix R = qr.getR();
     xtx_.add_inner(R);
@@ -49,6 +53,7 @@ namespace BOOM {
         yty_(rhs.yty_),
         xtx_(rhs.xtx_),
         xty_(rhs.xty_),
+        sumw_(rhs.sumw_),
         n_(rhs.n_) {}
 
   MvRegSuf *MvRegSuf::clone() const { return new MvRegSuf(*this); }
@@ -68,6 +73,24 @@ namespace BOOM {
     yty_.add_outer(y, w);
   }
 
+  void MvRegSuf::add_data(const Matrix &X, const Matrix &Y, const Vector &w) {
+    int n = X.nrow();
+    if (Y.nrow() != n || w.size() != n || X.ncol() != xdim()
+        || Y.ncol() != ydim()) {
+      report_error("Wrong size arguments passed to MvRegSuf::add_data.");
+    }
+    if (n == 0) return;
+    n_ += n;
+    sumw_ += w.sum();
+    xtx_.add_inner(X, w);
+    yty_.add_inner(Y, w);
+    Matrix weighted_y = Y;
+    for (int i = 0; i < n; ++i) {
+      weighted_y.row(i) *= w[i];
+    }
+    xty_ += X.Tmult(weighted_y);
+  }
+
   void MvRegSuf::clear_y_keep_x() {
     sumw_ = 0;
     xty_ = 0;
@@ -107,6 +130,7 @@ namespace BOOM {
     yty_ = 0;
     xtx_ = 0;
     xty_ = 0;
+    sumw_ = 0;
     n_ = 0;
   }
 
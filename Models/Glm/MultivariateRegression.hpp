@@ -66,6 +66,15 @@ namespace BOOM {
     virtual void update_raw_data(const Vector &Y, const Vector &X,
                                  double w = 1.0);
 
+    // Add each row of X and Y as an observation, with the corresponding
+    // element of w as its weight.  The cross product matrices are updated
+    // with rank-k updates rather than one outer product per row.
+    // Args:
+    //   X:  The predictors, one observation per row.
+    //   Y:  The responses, one observation per row.
+    //   w:  The weight for each observation.
+    void add_data(const Matrix &X, const Matrix &Y, const Vector &w);
+
     // Clear the sufficient statistics that depend on y, but not the ones that
     // depend on X.  This is a useful optimization in some latent variable
     // models.
@@ -122,6 +131,7 @@ namespace BOOM {
     xtx_ = SpdMatrix(xdim, 0.0);
     yty_ = SpdMatrix(ydim, 0.0);
     xty_ = Matrix(xdim, ydim, 0.0);
+    sumw_ = 0;
     n_ = 0;
     sumw_ = 0;
 
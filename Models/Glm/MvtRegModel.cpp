@@ -39,7 +39,7 @@ namespace BOOM {
                     new UnivParams(default_df)) {
     Matrix XX(add_intercept ? cbind(1.0, X) : X);
     QR qr(XX);
-    Matrix Beta(qr.solve(qr.QtY(Y)));
+    Matrix Beta(qr.Rsolve(qr.QtY(Y)));
     Matrix resid = Y - XX * Beta;
     uint n = XX.nrow();
     SpdMatrix Sig = resid.transpose() * resid / n;
@@ -18,7 +18,10 @@
 */
 
 #include "Models/Glm/PoissonRegressionModel.hpp"
+#include <algorithm>
 #include <functional>
+#include "LinAlg/EigenMap.hpp"
+#include "Models/Glm/ShardedLogLikelihood.hpp"
 #include "TargetFun/TargetFun.hpp"
 #include "cpputil/report_error.hpp"
 #include "distributions.hpp"
@@ -27,6 +30,12 @@
 
 namespace BOOM {
 
+  namespace {
+    // The number of observations handled by each matrix-vector product when
+    // evaluating the log likelihood over the full data set.
+    const int poisson_block_size = 256;
+  }  // namespace
+
   PoissonRegressionModel::PoissonRegressionModel(int xdim)
       : ParamPolicy(new GlmCoefs(xdim)) {}
 
@@ -60,9 +69,7 @@ namespace BOOM {
     //   ell = y * (log(E) + log(lambda)) - E*exp(x * beta)
     //       = yXbeta - E*exp(Xbeta)
     // dell  = (y - E*lambda) * x
-    // ddell = -lambda * x * x'
-    double ans = 0;
-    const std::vector<Ptr<PoissonRegressionData> > &data(dat());
+    // ddell = -E * lambda * x * x'
     const Selector &included(inc());
     int nvars = included.nvars();
     if (beta.size() != nvars) {
@@ -74,22 +81,65 @@ namespace BOOM {
     }
     initialize_derivatives(g, h, nvars, reset_derivatives);
 
-    for (int i = 0; i < data.size(); ++i) {
-      const Vector x = included.select(data[i]->x());
-      int64_t y = data[i]->y();
-      double lambda = 1.0;
-      if (nvars > 0) {
-        double eta = beta.dot(x);
-        lambda = exp(eta);
-      }
-      double exposure = data[i]->exposure();
-      ans += dpois(y, exposure * lambda, true);
-      if (g) {
-        g->axpy(x, (y - exposure * lambda));
-        if (h) {
-          h->add_outer(x, x, -lambda);
+    return sharded_log_likelihood(
+        pool_, dat().size(), poisson_block_size, g, h,
+        [this, &beta](int begin, int end, Vector *gradient, Matrix *hessian) {
+          return accumulate_log_likelihood(begin, end, beta, gradient,
+                                           hessian);
+        });
+  }
+
+  double PoissonRegressionModel::accumulate_log_likelihood(
+      int begin, int end, const Vector &beta, Vector *g, Matrix *h) const {
+    const std::vector<Ptr<PoissonRegressionData>> &data(dat());
+    const Selector &included(inc());
+    int nvars = included.nvars();
+    int nobs = end - begin;
+    bool all_included = included.nvars_excluded() == 0;
+
+    // Stack the included predictors for the block, so the linear predictor
+    // is a single matrix-vector product.
+    Matrix X(nobs, nvars);
+    Vector y(nobs);
+    Vector exposure(nobs);
+    for (int i = 0; i < nobs; ++i) {
+      const PoissonRegressionData &data_point(*data[begin + i]);
+      const Vector &x(data_point.x());
+      if (all_included) {
+        X.row(i) = x;
+      } else {
+        for (int j = 0; j < nvars; ++j) {
+          X(i, j) = x[included.indx(j)];
         }
       }
+      y[i] = data_point.y();
+      exposure[i] = data_point.exposure();
+    }
+
+    Vector eta(nobs, 0.0);
+    if (nvars > 0) {
+      eta = X * beta;
+    }
+    // The expected counts E * exp(eta), with the exponentials evaluated in a
+    // single vectorized pass.
+    Vector mean(nobs);
+    EigenMap(mean) = EigenMap(exposure).array() * EigenMap(eta).array().exp();
+
+    double ans = 0;
+    for (int i = 0; i < nobs; ++i) {
+      ans -= mean[i];
+      if (y[i] > 0) {
+        ans += y[i] * log(mean[i]) - lgamma(y[i] + 1);
+      }
+    }
+
+    if (g && nvars > 0) {
+      *g += X.Tmult(y - mean);
+      if (h) {
+        SpdMatrix information(nvars, 0.0);
+        information.add_inner(X, mean);
+        *h -= information;
+      }
     }
     return ans;
   }
@@ -109,13 +159,19 @@ namespace BOOM {
         [this](const Vector &x, Vector *gradient, Matrix *hessian, bool reset) {
           return this->log_likelihood(x, gradient, hessian, reset);
         });
-    Vector gradient;
-    Matrix hessian;
     double function_value;
     std::string error_message;
-    bool ok =
-        max_nd2_careful(beta, gradient, hessian, function_value, Target(target),
-                        dTarget(target), d2Target(target), 1e-5, error_message);
+    bool ok;
+    if (beta.size() > kLimitedMemoryDimension) {
+      ok = max_nd1_careful(beta, function_value, Target(target),
+                           dTarget(target), error_message, 1e-5, 500, LBFGS);
+    } else {
+      Vector gradient;
+      Matrix hessian;
+      ok = max_nd2_careful(beta, gradient, hessian, function_value,
+                           Target(target), dTarget(target), d2Target(target),
+                           1e-5, error_message);
+    }
     if (!ok) {
       beta = 0;
     }
@@ -27,6 +27,7 @@
 #include "Models/Policies/IID_DataPolicy.hpp"
 #include "Models/Policies/ParamPolicy_1.hpp"
 #include "Models/Policies/PriorPolicy.hpp"
+#include "cpputil/ThreadTools.hpp"
 
 namespace BOOM {
 
@@ -91,6 +92,21 @@ namespace BOOM {
     double pdf(const Data *, bool logscale) const override;
     double logp(const PoissonRegressionData &data) const;
     int number_of_observations() const override { return dat().size(); }
+
+    // Evaluate the log likelihood and its derivatives using up to n
+    // threads.  The result does not depend on the number of threads.
+    void set_number_of_threads(int n) { pool_.set_number_of_threads(n); }
+
+   private:
+    // Add the derivatives of the log likelihood for observations [begin,
+    // end) to g and h (if they are non-NULL), and return the log likelihood
+    // of those observations.  The observations are evaluated as a block: one
+    // matrix-vector product for the linear predictors, and one rank-k update
+    // for the Hessian.
+    double accumulate_log_likelihood(int begin, int end, const Vector &beta,
+                                     Vector *g, Matrix *h) const;
+
+    mutable SharedThreadPool pool_;
   };
 
 }  // namespace BOOM
@@ -0,0 +1,109 @@
+/*
+  Copyright (C) 2005-2024 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#include "Models/Glm/PosteriorPredictiveEnsemble.hpp"
+
+#include <cmath>
+#include <vector>
+
+#include "cpputil/report_error.hpp"
+#include "stats/TDigest.hpp"
+#include "stats/logit.hpp"
+
+namespace BOOM {
+
+  PosteriorPredictiveEnsemble::PosteriorPredictiveEnsemble(
+      const Matrix &coefficient_draws, Link link)
+      : link_(link) {
+    const int ndraws = coefficient_draws.nrow();
+    const int xdim = coefficient_draws.ncol();
+    if (ndraws == 0) {
+      report_error("PosteriorPredictiveEnsemble needs at least one draw.");
+    }
+    std::vector<bool> nonzero(xdim, false);
+    for (int j = 0; j < xdim; ++j) {
+      const double *column = coefficient_draws.data() + j * ndraws;
+      for (int d = 0; d < ndraws; ++d) {
+        if (column[d] != 0.0) {
+          nonzero[j] = true;
+          break;
+        }
+      }
+    }
+    included_ = Selector(nonzero);
+    draws_ = included_.select_cols(coefficient_draws);
+  }
+
+  void PosteriorPredictiveEnsemble::linear_predictors(
+      const Matrix &predictors, Matrix &ans) const {
+    if (predictors.ncol() != xdim()) {
+      report_error("Wrong number of columns in the predictor matrix passed "
+                   "to PosteriorPredictiveEnsemble.");
+    }
+    ans.resize(predictors.nrow(), number_of_draws());
+    if (included_.nvars() == 0) {
+      ans = 0.0;
+    } else if (included_.nvars() == xdim()) {
+      predictors.multT(draws_, ans);
+    } else {
+      included_.select_cols(predictors).multT(draws_, ans);
+    }
+  }
+
+  void PosteriorPredictiveEnsemble::predict(const Matrix &predictors,
+                                            Matrix &means) const {
+    linear_predictors(predictors, means);
+    double *data = means.data();
+    const long size = static_cast<long>(means.nrow()) * means.ncol();
+    switch (link_) {
+      case Link::IDENTITY:
+        break;
+      case Link::LOGIT:
+        for (long i = 0; i < size; ++i) data[i] = logit_inv(data[i]);
+        break;
+      case Link::LOG:
+        for (long i = 0; i < size; ++i) data[i] = std::exp(data[i]);
+        break;
+    }
+  }
+
+  Matrix PosteriorPredictiveEnsemble::summarize(const Matrix &predictors,
+                                                const Vector &probs,
+                                                double compression) const {
+    Matrix means;
+    predict(predictors, means);
+    const int nrequests = means.nrow();
+    const int ndraws = means.ncol();
+    Matrix ans(nrequests, 1 + probs.size());
+    for (int i = 0; i < nrequests; ++i) {
+      TDigest digest(compression);
+      double total = 0;
+      for (int d = 0; d < ndraws; ++d) {
+        double value = means(i, d);
+        total += value;
+        digest.add(value);
+      }
+      ans(i, 0) = total / ndraws;
+      for (int j = 0; j < probs.size(); ++j) {
+        ans(i, j + 1) = digest.quantile(probs[j]);
+      }
+    }
+    return ans;
+  }
+
+}  // namespace BOOM
@@ -0,0 +1,104 @@
+#ifndef BOOM_GLM_POSTERIOR_PREDICTIVE_ENSEMBLE_HPP_
+#define BOOM_GLM_POSTERIOR_PREDICTIVE_ENSEMBLE_HPP_
+/*
+  Copyright (C) 2005-2024 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#include "LinAlg/Matrix.hpp"
+#include "LinAlg/Selector.hpp"
+#include "LinAlg/Vector.hpp"
+
+namespace BOOM {
+
+  // A set of saved MCMC draws of the coefficients of a regression model
+  // (RegressionModel, LogisticRegressionModel, PoissonRegressionModel),
+  // packed for scoring many requests at once.
+  //
+  // The draws are stored as a contiguous (draws x included variables)
+  // matrix.  A variable is included if it is nonzero in at least one draw,
+  // so variables that spike-and-slab priors dropped from every draw cost
+  // nothing at scoring time.  The linear predictors for a batch of requests
+  // are computed with a single matrix-matrix product, rather than one call
+  // to predict() per draw per request.
+  //
+  // Objects of this class are immutable after construction, so one
+  // ensemble can serve requests from many threads concurrently.
+  class PosteriorPredictiveEnsemble {
+   public:
+    // The inverse link function mapping a linear predictor to the mean of
+    // the response.
+    enum class Link {
+      IDENTITY,  // RegressionModel: the mean is x * beta.
+      LOGIT,     // LogisticRegressionModel: the mean is plogis(x * beta).
+      LOG        // PoissonRegressionModel: the mean is exp(x * beta).
+    };
+
+    // Args:
+    //   coefficient_draws: Each row is an MCMC draw of the full
+    //     (nvars_possible) coefficient vector, with zeros for excluded
+    //     variables.
+    //   link: The link function of the model that produced the draws.
+    PosteriorPredictiveEnsemble(const Matrix &coefficient_draws, Link link);
+
+    int number_of_draws() const { return draws_.nrow(); }
+    int xdim() const { return included_.nvars_possible(); }
+    Link link() const { return link_; }
+
+    // The variables included in at least one draw.
+    const Selector &included() const { return included_; }
+
+    // Args:
+    //   predictors: A matrix with one row per request.  The number of
+    //     columns must be xdim().
+    //   linear_predictors: On output, element (i, d) is the linear
+    //     predictor for row i of 'predictors' under draw d.  Resized if
+    //     needed.
+    void linear_predictors(const Matrix &predictors,
+                           Matrix &linear_predictors) const;
+
+    // As linear_predictors(), but the inverse link has been applied to each
+    // element, so element (i, d) is the mean of the response for request i
+    // under draw d.  For Poisson models the mean is per unit exposure.
+    void predict(const Matrix &predictors, Matrix &means) const;
+
+    // Summarize the posterior distribution of the mean response for each
+    // request.
+    //
+    // Args:
+    //   predictors: A matrix with one row per request.
+    //   probs: The probabilities of the desired quantiles.
+    //   compression: The compression parameter for the TDigest used to
+    //     approximate the quantiles.
+    //
+    // Returns:
+    //   A matrix with one row per request.  Column 0 is the posterior mean.
+    //   Column j + 1 is the approximate quantile of the posterior
+    //   distribution corresponding to probs[j].
+    Matrix summarize(const Matrix &predictors, const Vector &probs,
+                     double compression = 100) const;
+
+   private:
+    Link link_;
+    Selector included_;
+
+    // Rows are draws.  Columns are the included variables.
+    Matrix draws_;
+  };
+
+}  // namespace BOOM
+
+#endif  // BOOM_GLM_POSTERIOR_PREDICTIVE_ENSEMBLE_HPP_
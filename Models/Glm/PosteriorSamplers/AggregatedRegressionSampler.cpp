@@ -40,7 +40,8 @@ namespace BOOM {
         sam_(new BregVsSampler(model_->regression_model(), prior_sigma_nobs,
                                prior_sigma_guess, prior_beta_nobs,
                                prior_diagonal_shrinkage,
-                               prior_variable_inclusion_probability)) {
+                               prior_variable_inclusion_probability)),
+        collapsed_(false) {
     check_positive(prior_sigma_guess, "prior_sigma_guess");
     check_positive(prior_sigma_nobs, "prior_sigma_nobs");
     check_positive(prior_beta_nobs, "prior_beta_nobs");
@@ -51,7 +52,11 @@ namespace BOOM {
   }
 
   void AggregatedRegressionSampler::draw() {
-    model_->distribute_group_totals();
+    if (collapsed_) {
+      model_->draw_collapsed_sufficient_statistics(rng());
+    } else {
+      model_->distribute_group_totals();
+    }
     sam_->draw();
   }
 
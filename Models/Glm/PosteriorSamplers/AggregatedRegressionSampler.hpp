@@ -39,9 +39,17 @@ namespace BOOM {
     void draw() override;
     double logpri() const override;
 
+    // In collapsed mode each draw() replaces the imputation of individual
+    // unit values with a direct draw of the regression sufficient statistics
+    // given the group totals.  See
+    // AggregatedRegressionModel::draw_collapsed_sufficient_statistics.
+    // Collapsed mode requires the identity transformation.
+    void set_collapsed(bool collapsed = true) { collapsed_ = collapsed; }
+
    private:
     AggregatedRegressionModel *model_;
     Ptr<BregVsSampler> sam_;
+    bool collapsed_;
   };
 
 }  // namespace BOOM
@@ -16,10 +16,14 @@
   Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
 */
 
+#include <algorithm>
+#include <atomic>
 #include <thread>
 #include "Models/Glm/PosteriorSamplers/BigAssSpikeSlabSampler.hpp"
 #include "distributions.hpp"
 #include "cpputil/ThreadTools.hpp"
+#include "cpputil/seq.hpp"
+#include "cpputil/timer.hpp"
 
 namespace BOOM {
 
@@ -33,7 +37,8 @@ namespace BOOM {
         model_(model),
         spike_(spike),
         slab_prototype_(slab_prototype),
-        residual_precision_prior_(residual_precision_prior)
+        residual_precision_prior_(residual_precision_prior),
+        max_initial_screen_concurrency_(0)
   {}
 
   void BigAssSpikeSlabSampler::draw() {
@@ -151,25 +156,45 @@ namespace BOOM {
 
     int num_models = model_->number_of_subordinate_models();
     std::vector<std::vector<Selector>> draws(num_models);
+    initial_screen_wall_time_.resize(num_models);
+    initial_screen_wall_time_ = 0.0;
+
+    // The cost of an MCMC iteration grows with the dimension of the model,
+    // so schedule the largest models first.
+    std::vector<int> schedule = seq<int>(0, num_models - 1);
+    std::stable_sort(schedule.begin(), schedule.end(), [this](int a, int b) {
+      return model_->subordinate_model(a)->xdim() >
+             model_->subordinate_model(b)->xdim();
+    });
+
+    auto run_chain = [this, niter, &draws](int m) {
+      Timer timer;
+      RegressionModel *worker_model = model_->subordinate_model(m);
+      std::vector<Selector> &worker_model_draws(draws[m]);
+      worker_model_draws.reserve(niter);
+      for (int iter = 0; iter < niter; ++iter) {
+        worker_model->sample_posterior();
+        worker_model_draws.push_back(worker_model->inc());
+      }
+      timer.stop();
+      initial_screen_wall_time_[m] = timer.time_in_seconds();
+    };
 
     if (use_threads) {
-      int num_threads = std::min<int>(std::thread::hardware_concurrency(),
-                                      num_models);
-      ThreadWorkerPool pool(num_threads);
+      int concurrency = max_initial_screen_concurrency_ > 0
+          ? max_initial_screen_concurrency_
+          : global_thread_pool_size();
+      concurrency = std::max<int>(1, std::min<int>(concurrency, num_models));
+      SharedThreadPool pool(concurrency);
+      std::atomic<int> next_model(0);
       std::vector<std::future<void>> futures;
-
-
-      for (int i = 0; i < num_models; ++i) {
-        std::vector<Selector> &worker_model_draws(draws[i]);
-        RegressionModel *worker_model = model_->subordinate_model(i);
-        futures.emplace_back(
-            pool.submit(
-                [worker_model, niter, &worker_model_draws]() {
-                  for (int iter = 0; iter < niter; ++iter) {
-                    worker_model->sample_posterior();
-                    worker_model_draws.push_back(worker_model->inc());
-                  }
-                }));
+      for (int t = 0; t < concurrency; ++t) {
+        futures.emplace_back(pool.submit(
+            [&schedule, &next_model, &run_chain, num_models]() {
+              for (int i = next_model++; i < num_models; i = next_model++) {
+                run_chain(schedule[i]);
+              }
+            }));
       }
       for (auto & future : futures) {
         future.get();
@@ -178,15 +203,7 @@ namespace BOOM {
       // The non-thread code path should match the code in the thread code path
       // as closely as possible.
       for (int i = 0; i < num_models; ++i) {
-        std::vector<Selector> &worker_model_draws(draws[i]);
-        RegressionModel *worker_model = model_->subordinate_model(i);
-        auto callback = [worker_model, niter, &worker_model_draws]() {
-                          for (int iter = 0; iter < niter; ++iter) {
-                            worker_model->sample_posterior();
-                            worker_model_draws.push_back(worker_model->inc());
-                          }
-                        };
-        callback();
+        run_chain(schedule[i]);
       }
     }
 
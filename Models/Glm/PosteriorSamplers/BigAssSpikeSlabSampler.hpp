@@ -71,9 +71,10 @@ namespace BOOM {
     //   niter:  The number of MCMC iterations to use.
     //   threshold: The variables whose 'marginal inclusion probabilities'
     //     exceed 'threshold' become candidates in the next round.
-    //   use_threads: If 'true' then C++11 threads will be used to run the MCMC
-    //     algorithms for the subordinate models.  If 'false' then the code path
-    //     for doing the MCMC will not use threads.
+    //   use_threads: If 'true' then the MCMC algorithms for the subordinate
+    //     models are run as tasks on the global thread pool, at most
+    //     max_initial_screen_concurrency() at a time.  If 'false' then the
+    //     code path for doing the MCMC will not use threads.
     //
     // Preconditions:
     //   It is expected that the model being screened has passed the data
@@ -89,6 +90,25 @@ namespace BOOM {
     //     columns in the global predictor matrix.
     ConstVectorView select_chunk(const Vector &v, int chunk) const;
 
+    // Limit the number of subordinate models whose MCMC runs at the same
+    // time during initial_screen.  If max_concurrency <= 0 (the default)
+    // the limit is the size of the global thread pool.
+    void set_max_initial_screen_concurrency(int max_concurrency) {
+      max_initial_screen_concurrency_ = max_concurrency;
+    }
+    int max_initial_screen_concurrency() const {
+      return max_initial_screen_concurrency_;
+    }
+
+    // The wall time, in seconds, taken by the MCMC for each subordinate
+    // model in the most recent call to initial_screen.  Element i
+    // corresponds to model_->subordinate_model(i).  Useful for tuning the
+    // subordinate_model_max_dim argument to the BigRegressionModel
+    // constructor.
+    const Vector &initial_screen_wall_time() const {
+      return initial_screen_wall_time_;
+    }
+
    private:
     // The basic objects provided to the constructor.
     BigRegressionModel *model_;
@@ -104,6 +124,9 @@ namespace BOOM {
     Ptr<RegressionSlabPrior> candidate_slab_;
     Ptr<BregVsSampler> candidate_sampler_;
 
+    int max_initial_screen_concurrency_;
+    Vector initial_screen_wall_time_;
+
     // Assigns posterior samplers to the subordinate models contained in model_.
     void assign_subordinate_samplers();
 
@@ -118,6 +141,10 @@ namespace BOOM {
     //     that does not invoke threading tools.  This will be slow, but it
     //     makes gdb easy.
     //
+    // The subordinate models are handed out largest first, to a fixed
+    // number of tasks that each take the next model as soon as they finish
+    // one, so a small final chunk does not leave cores idle at the end.
+    //
     // Effects:
     //   The inclusion flags for each worker model are set according to whether
     //   each variables's marginal inclusion probability exceeds the specified
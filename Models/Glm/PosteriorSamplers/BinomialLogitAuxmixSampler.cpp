@@ -27,8 +27,19 @@ namespace BOOM {
   }  // namespace
 
   namespace BinomialLogit {
+    namespace {
+      // The number of rows buffered between rank-k updates of xtx.
+      const int update_block_size = 64;
+    }  // namespace
+
     SufficientStatistics::SufficientStatistics(int dim)
-        : xtx_(dim), xty_(dim), sym_(false), sample_size_(0) {}
+        : xtx_(dim),
+          xty_(dim),
+          sym_(false),
+          sample_size_(0),
+          pending_x_(update_block_size, dim),
+          pending_weights_(update_block_size),
+          number_pending_(0) {}
 
     SufficientStatistics *SufficientStatistics::clone() const {
       return new SufficientStatistics(*this);
@@ -39,9 +50,12 @@ namespace BOOM {
       xty_ = 0;
       sym_ = false;
       sample_size_ = 0;
+      number_pending_ = 0;
     }
 
     void SufficientStatistics::combine(const SufficientStatistics &rhs) {
+      flush();
+      rhs.flush();
       xtx_ += rhs.xtx_;
       xty_ += rhs.xty_;
       sym_ = sym_ && rhs.sym_;
@@ -49,6 +63,7 @@ namespace BOOM {
     }
 
     const SpdMatrix &SufficientStatistics::xtx() const {
+      flush();
       if (!sym_) {
         xtx_.reflect();
         sym_ = true;
@@ -61,11 +76,28 @@ namespace BOOM {
     void SufficientStatistics::update(const Vector &x, double weighted_value,
                                       double weight) {
       sym_ = false;
-      xtx_.add_outer(x, weight, false);
+      pending_x_.row(number_pending_) = x;
+      pending_weights_[number_pending_] = weight;
+      if (++number_pending_ == pending_weights_.size()) {
+        flush();
+      }
       xty_.axpy(x, weighted_value);
       ++sample_size_;
     }
 
+    void SufficientStatistics::flush() const {
+      if (number_pending_ == 0) return;
+      if (number_pending_ == pending_weights_.size()) {
+        xtx_.add_inner(pending_x_, pending_weights_, false);
+      } else {
+        Matrix rows(SubMatrix(pending_x_, 0, number_pending_ - 1,
+                              0, pending_x_.ncol() - 1));
+        Vector weights(ConstVectorView(pending_weights_, 0, number_pending_));
+        xtx_.add_inner(rows, weights, false);
+      }
+      number_pending_ = 0;
+    }
+
     ImputeWorker::ImputeWorker(SufficientStatistics &global_suf,
                                std::mutex &global_suf_mutex, int clt_threshold,
                                const GlmCoefs *coef, RNG *rng, RNG &seeding_rng)
@@ -138,7 +170,7 @@ namespace BOOM {
   }
 
   void BLAMS::assign_data_to_workers() {
-    BOOM::assign_data_to_workers(model_->dat(), workers());
+    distribute_data(model_->dat());
   }
 
 }  // namespace BOOM
@@ -47,16 +47,28 @@ namespace BOOM {
       void clear();
       void combine(const SufficientStatistics &rhs);
 
+      // Rows passed to update() are buffered, and added to xtx in blocks
+      // with a single rank-k update, which is considerably faster than one
+      // rank-one update per observation.
       void update(const Vector &x, double weighted_value, double weight);
       const SpdMatrix &xtx() const;
       const Vector &xty() const;
       int sample_size() const { return sample_size_; }
 
      private:
+      // Add any buffered rows to xtx_.
+      void flush() const;
+
       mutable SpdMatrix xtx_;
       Vector xty_;
       mutable bool sym_;
       int sample_size_;
+
+      // Rows (and their weights) that have been passed to update() but not
+      // yet added to xtx_.
+      mutable Matrix pending_x_;
+      mutable Vector pending_weights_;
+      mutable int number_pending_;
       friend void intrusive_ptr_add_ref(SufficientStatistics *w) {
         w->up_count();
       }
@@ -18,6 +18,8 @@
 */
 
 #include "Models/Glm/PosteriorSamplers/BinomialLogitDataImputer.hpp"
+#include <algorithm>
+#include <cmath>
 #include "cpputil/math_utils.hpp"
 #include "cpputil/Constants.hpp"
 #include "cpputil/report_error.hpp"
@@ -26,7 +28,118 @@
 
 namespace BOOM {
   const LogitMixtureApproximation BinomialLogitDataImputer::mixture_approximation;
-  
+
+  namespace {
+    // Quantities derived from the logit mixture approximation that the
+    // imputers need for every observation.  They are computed once, so the
+    // per-observation work is a handful of exp() and pnorm() calls with no
+    // heap allocation.
+    struct LogitMixtureTable {
+      // The mixture has 9 components.  The extra space leaves room for a
+      // refined approximation without changing the table layout.
+      static const int max_components = 16;
+
+      explicit LogitMixtureTable(const NormalMixtureApproximation &mixture)
+          : dim(mixture.dim()) {
+        if (dim > max_components) {
+          report_error("Too many components in the logit mixture "
+                       "approximation.");
+        }
+        for (int m = 0; m < dim; ++m) {
+          double sd = mixture.sigma()[m];
+          sigma[m] = sd;
+          variance[m] = sd * sd;
+          precision[m] = 1.0 / variance[m];
+          squared_precision[m] = square(precision[m]);
+          weight[m] = mixture.weights()[m];
+          // The log mixing weight plus the log normal density, without the
+          // constant log(2 pi) / 2 which cancels on normalization.
+          log_weight_over_sigma[m] = mixture.log_weights()[m] - log(sd);
+        }
+      }
+
+      int dim;
+      double sigma[max_components];
+      double variance[max_components];
+      double precision[max_components];
+      double squared_precision[max_components];
+      double weight[max_components];
+      double log_weight_over_sigma[max_components];
+    };
+
+    const LogitMixtureTable &logit_mixture_table() {
+      static const LogitMixtureTable table(
+          BinomialLogitDataImputer::mixture_approximation);
+      return table;
+    }
+
+    // Draw the mixture component for a centered latent logit 'residual', and
+    // return its precision.  This is NormalMixtureApproximation::unmix, which
+    // the mixture's zero means reduce to a scale-mixture computation.
+    double unmix_logit_precision(RNG &rng, double residual,
+                                 const LogitMixtureTable &table) {
+      double log_prob[LogitMixtureTable::max_components];
+      double max_log_prob = negative_infinity();
+      double half_residual_squared = 0.5 * residual * residual;
+      for (int m = 0; m < table.dim; ++m) {
+        log_prob[m] = table.log_weight_over_sigma[m] -
+                      half_residual_squared * table.precision[m];
+        max_log_prob = std::max(max_log_prob, log_prob[m]);
+      }
+      double total = 0;
+      for (int m = 0; m < table.dim; ++m) {
+        log_prob[m] = exp(log_prob[m] - max_log_prob);
+        total += log_prob[m];
+      }
+      double u = runif_mt(rng, 0, total);
+      double cumulative = 0;
+      for (int m = 0; m < table.dim - 1; ++m) {
+        cumulative += log_prob[m];
+        if (u <= cumulative) return table.precision[m];
+      }
+      return table.precision[table.dim - 1];
+    }
+
+    // Impute each Bernoulli trial separately.  Returns the pair
+    // (information_weighted_sum, information).
+    std::pair<double, double> impute_trials_exactly(
+        RNG &rng, double number_of_trials, double number_of_successes,
+        double linear_predictor) {
+      const LogitMixtureTable &table(logit_mixture_table());
+      double information_weighted_sum = 0;
+      double information = 0;
+      for (int i = 0; i < number_of_trials; ++i) {
+        bool success = i < number_of_successes;
+        double latent_logit = rtrun_logit_mt(rng, linear_predictor, 0, success);
+        double current_weight = unmix_logit_precision(
+            rng, latent_logit - linear_predictor, table);
+        information += current_weight;
+        information_weighted_sum += latent_logit * current_weight;
+      }
+      return std::make_pair(information_weighted_sum, information);
+    }
+
+    // Draw 'counts' from the multinomial distribution with n trials and
+    // probabilities proportional to prob[0], ..., prob[dim - 1], using the
+    // sequence of conditional binomial draws used by rmultinom.
+    void rmultinom_unnormalized(RNG &rng, int n, const double *prob,
+                                int dim, int *counts) {
+      double total = 0;
+      for (int m = 0; m < dim; ++m) {
+        total += prob[m];
+        counts[m] = 0;
+      }
+      for (int m = 0; m < dim - 1 && n > 0; ++m) {
+        if (total <= 0) break;
+        double p = std::min(1.0, prob[m] / total);
+        counts[m] = rbinom_mt(rng, n, p);
+        n -= counts[m];
+        total -= prob[m];
+      }
+      counts[dim - 1] += n;
+    }
+  }  // namespace
+
   void BinomialLogitDataImputer::debug_status_message(
       std::ostream &out, double number_of_trials, double number_of_successes,
       double linear_predictor) const {
@@ -60,53 +173,40 @@ namespace BOOM {
                            linear_predictor);
       report_error(err.str());
     }
-    double information_weighted_sum = 0;
-    double information = 0;
     if (number_of_trials < clt_threshold_) {
-      for (int i = 0; i < number_of_trials; ++i) {
-        bool success = i < number_of_successes;
-        double latent_logit = rtrun_logit_mt(rng, linear_predictor, 0, success);
-        // mu is unused because the mixture is a scale-mixture only,
-        // but we need it for the API.
-        double mu, sigsq;
-        mixture_approximation.unmix(rng, latent_logit - linear_predictor, &mu,
-                                    &sigsq);
-        double current_weight = 1.0 / sigsq;
-        information += current_weight;
-        information_weighted_sum += latent_logit * current_weight;
-      }
-    } else {
-      // Large sample case.  There are number_of_successes draws from
-      // the positive side, and number_of_trials - number_of_successes
-      // draws from the negative side.
-      double mean_of_logit_sum = 0;
-      double variance_of_logit_sum = 0;
-      if (number_of_successes > 0) {
-        mean_of_logit_sum +=
-            number_of_successes * trun_logit_mean(linear_predictor, 0, true);
-        variance_of_logit_sum += number_of_successes *
-                                 trun_logit_variance(linear_predictor, 0, true);
-      }
-      double number_of_failures = number_of_trials - number_of_successes;
-      if (number_of_failures > 0) {
-        mean_of_logit_sum +=
-            number_of_failures * trun_logit_mean(linear_predictor, 0, false);
-        variance_of_logit_sum +=
-            number_of_failures *
-            trun_logit_variance(linear_predictor, 0, false);
-      }
-      // The information_weighted_sum is the sum of the latent logits
-      // (approximated by a normal), divided by the weight that each
-      // term in the sum recieves (the variance of the logistic
-      // distribution, pi^2/3).
-      information_weighted_sum =
-          rnorm_mt(rng, mean_of_logit_sum, sqrt(variance_of_logit_sum));
-      information_weighted_sum /= Constants::pi_squared_over_3;
-
-      // Each latent logit carries the same amount of information:
-      // 1/pi_squared_over_3.
-      information = number_of_trials / Constants::pi_squared_over_3;
+      return impute_trials_exactly(rng, number_of_trials, number_of_successes,
+                                   linear_predictor);
     }
+    // Large sample case.  There are number_of_successes draws from
+    // the positive side, and number_of_trials - number_of_successes
+    // draws from the negative side.
+    double mean_of_logit_sum = 0;
+    double variance_of_logit_sum = 0;
+    if (number_of_successes > 0) {
+      mean_of_logit_sum +=
+          number_of_successes * trun_logit_mean(linear_predictor, 0, true);
+      variance_of_logit_sum += number_of_successes *
+                               trun_logit_variance(linear_predictor, 0, true);
+    }
+    double number_of_failures = number_of_trials - number_of_successes;
+    if (number_of_failures > 0) {
+      mean_of_logit_sum +=
+          number_of_failures * trun_logit_mean(linear_predictor, 0, false);
+      variance_of_logit_sum +=
+          number_of_failures *
+          trun_logit_variance(linear_predictor, 0, false);
+    }
+    // The information_weighted_sum is the sum of the latent logits
+    // (approximated by a normal), divided by the weight that each
+    // term in the sum recieves (the variance of the logistic
+    // distribution, pi^2/3).
+    double information_weighted_sum =
+        rnorm_mt(rng, mean_of_logit_sum, sqrt(variance_of_logit_sum));
+    information_weighted_sum /= Constants::pi_squared_over_3;
+
+    // Each latent logit carries the same amount of information:
+    // 1/pi_squared_over_3.
+    double information = number_of_trials / Constants::pi_squared_over_3;
     return std::make_pair(information_weighted_sum, information);
   }
 
@@ -134,74 +234,62 @@ namespace BOOM {
   std::pair<double, double> BinomialLogitCltDataImputer::impute_small_sample(
       RNG &rng, double number_of_trials, double number_of_successes,
       double linear_predictor) const {
-    double information_weighted_sum = 0;
-    double information = 0;
-    for (int i = 0; i < number_of_trials; ++i) {
-      bool success = i < number_of_successes;
-      double latent_logit = rtrun_logit_mt(rng, linear_predictor, 0, success);
-      // mu is unused because the mixture is a scale-mixture only,
-      // but we need it for the API.
-      double mu, sigsq;
-      mixture_approximation.unmix(rng, latent_logit - linear_predictor, &mu,
-                                  &sigsq);
-      double current_weight = 1.0 / sigsq;
-      information += current_weight;
-      information_weighted_sum += latent_logit * current_weight;
-    }
-    return std::make_pair(information_weighted_sum, information);
+    return impute_trials_exactly(rng, number_of_trials, number_of_successes,
+                                 linear_predictor);
   }
 
   //----------------------------------------------------------------------
   std::pair<double, double> BinomialLogitCltDataImputer::impute_large_sample(
       RNG &rng, double number_of_trials, double number_of_successes,
       double linear_predictor) const {
-    double information = 0.0;
-    const Vector &mixing_weights(mixture_approximation.weights());
-    const Vector &sigma(mixture_approximation.sigma());
-    double negative_logit_support = plogis(0, linear_predictor, 1, true);
-    double positive_logit_support = plogis(0, linear_predictor, 1, false);
-    Vector p0 = mixing_weights / negative_logit_support;
-    Vector p1 = mixing_weights / positive_logit_support;
-    for (int m = 0; m < mixture_approximation.dim(); ++m) {
-      p0[m] *= pnorm(0, linear_predictor, sigma[m], true);
-      p1[m] *= pnorm(0, linear_predictor, sigma[m], false);
-    }
+    const LogitMixtureTable &table(logit_mixture_table());
+    const int dim = table.dim;
 
-    // p0 is the probability distribution over the mixture component
-    // indicators for the failures.  N0 is the count of the number of
-    // failures belonging to each mixture component.
-    std::vector<int> N0 =
-        rmultinom_mt(rng, number_of_trials - number_of_successes, p0 / sum(p0));
+    // p0[m] and p1[m] are proportional to the probability distributions over
+    // the mixture component indicators for the failures and the successes.
+    // The normalizing constants (the logistic probabilities of each side of
+    // zero) are not needed by the multinomial draws below.
+    double p0[LogitMixtureTable::max_components];
+    double p1[LogitMixtureTable::max_components];
+    for (int m = 0; m < dim; ++m) {
+      p0[m] = table.weight[m] * pnorm(0, linear_predictor, table.sigma[m], true);
+      p1[m] = table.weight[m] *
+              pnorm(0, linear_predictor, table.sigma[m], false);
+    }
 
-    // p1 is the probability distribution over the mixture component
-    // indicators for the successes.  N1 is the count of the number
-    // of successes in each mixture component.
-    std::vector<int> N1 = rmultinom_mt(rng, number_of_successes, p1 / sum(p1));
+    // N0 and N1 count the failures and successes belonging to each mixture
+    // component.
+    int N0[LogitMixtureTable::max_components];
+    int N1[LogitMixtureTable::max_components];
+    rmultinom_unnormalized(rng, lround(number_of_trials - number_of_successes),
+                           p0, dim, N0);
+    rmultinom_unnormalized(rng, lround(number_of_successes), p1, dim, N1);
 
+    double information = 0.0;
     double simulation_mean = 0;
     double simulation_variance = 0;
-    for (int m = 0; m < N0.size(); ++m) {
+    for (int m = 0; m < dim; ++m) {
       int total_obs = N0[m] + N1[m];
       if (total_obs == 0) {
         continue;
       }
-      double sigsq = square(sigma[m]);
-      double sig4 = square(sigsq);
-      information += total_obs / sigsq;
+      information += total_obs * table.precision[m];
       double truncated_normal_mean;
       double truncated_normal_variance;
       double cutpoint = 0;
       if (N0[m] > 0) {
-        trun_norm_moments(linear_predictor, sigma[m], cutpoint, false,
+        trun_norm_moments(linear_predictor, table.sigma[m], cutpoint, false,
                           &truncated_normal_mean, &truncated_normal_variance);
-        simulation_mean += N0[m] * truncated_normal_mean / sigsq;
-        simulation_variance += N0[m] * truncated_normal_variance / sig4;
+        simulation_mean += N0[m] * truncated_normal_mean * table.precision[m];
+        simulation_variance +=
+            N0[m] * truncated_normal_variance * table.squared_precision[m];
       }
       if (N1[m] > 0) {
-        trun_norm_moments(linear_predictor, sigma[m], cutpoint, true,
+        trun_norm_moments(linear_predictor, table.sigma[m], cutpoint, true,
                           &truncated_normal_mean, &truncated_normal_variance);
-        simulation_mean += N1[m] * truncated_normal_mean / sigsq;
-        simulation_variance += N1[m] * truncated_normal_variance / sig4;
+        simulation_mean += N1[m] * truncated_normal_mean * table.precision[m];
+        simulation_variance +=
+            N1[m] * truncated_normal_variance * table.squared_precision[m];
       }
     }
     double information_weighted_sum =
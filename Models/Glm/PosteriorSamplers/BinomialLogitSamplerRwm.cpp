@@ -45,22 +45,31 @@ namespace BOOM {
         m_(model),
         pri_(prior),
         proposal_(new MvtRwmProposal(SpdMatrix(model->xdim(), 1.0), nu)),
-        sam_(BinomialLogitLogPosterior(m_, pri_), proposal_) {}
+        sam_(BinomialLogitLogPosterior(m_, pri_), proposal_),
+        information_is_cached_(false) {}
 
   void BinomialLogitSamplerRwm::draw() {
-    const std::vector<Ptr<BinomialRegressionData> > &data(m_->dat());
-    SpdMatrix ivar(pri_->siginv());
     Vector beta(m_->Beta());
-    for (int i = 0; i < data.size(); ++i) {
-      Ptr<BinomialRegressionData> dp = data[i];
-      double eta = beta.dot(dp->x());
-      double prob = plogis(eta);
-      ivar.add_outer(dp->x(), dp->n() * prob * (1 - prob));
+    if (!information_is_cached_) {
+      const std::vector<Ptr<BinomialRegressionData> > &data(m_->dat());
+      SpdMatrix ivar(pri_->siginv());
+      for (int i = 0; i < data.size(); ++i) {
+        Ptr<BinomialRegressionData> dp = data[i];
+        double eta = beta.dot(dp->x());
+        double prob = plogis(eta);
+        ivar.add_outer(dp->x(), dp->n() * prob * (1 - prob));
+      }
+      proposal_->set_ivar(ivar);
+      information_is_cached_ = proposal_->adapting();
     }
-
-    proposal_->set_ivar(ivar);
     beta = sam_.draw(beta);
     m_->set_Beta(beta);
+    proposal_->observe(beta);
+  }
+
+  void BinomialLogitSamplerRwm::enable_adaptive_proposal(int warmup) {
+    proposal_->enable_adaptation(warmup);
+    information_is_cached_ = false;
   }
 
   double BinomialLogitSamplerRwm::logpri() const {
@@ -47,11 +47,20 @@ namespace BOOM {
 
     void set_chunk_size(int n);
 
+    // Adapt the proposal variance to the posterior as the chain runs (see
+    // MvtRwmProposal).  The fixed component of the proposal is the posterior
+    // information at the first draw after this call.  It is not recomputed
+    // on later draws, which saves a pass through the data on each iteration.
+    void enable_adaptive_proposal(int warmup = 100);
+
    private:
     BinomialLogitModel *m_;
     Ptr<MvnBase> pri_;
     Ptr<MvtRwmProposal> proposal_;
     MetropolisHastings sam_;
+
+    // True if the adaptive proposal's fixed component has been set.
+    bool information_is_cached_;
   };
 
 }  // namespace BOOM
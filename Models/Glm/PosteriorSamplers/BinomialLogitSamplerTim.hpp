@@ -69,6 +69,16 @@ namespace BOOM {
     double d2logp(const Vector &beta, Vector &g, Matrix &H) const;
     double Logp(const Vector &beta, Vector &g, Matrix &h, int nd) const;
 
+    // If the mode is not stable, reuse the most recent mode as the
+    // proposal until the acceptance rate drops below acceptance_threshold.
+    // See TIM::cache_mode.
+    void cache_mode(double acceptance_threshold, int window = 20) {
+      sam_.cache_mode(acceptance_threshold, window);
+    }
+    int number_of_mode_searches() const {
+      return sam_.number_of_mode_searches();
+    }
+
    private:
     BinomialLogitModel *m_;
     Ptr<MvnBase> pri_;
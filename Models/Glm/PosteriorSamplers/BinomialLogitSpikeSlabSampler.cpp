@@ -204,12 +204,76 @@ namespace BOOM {
 
     uint n = g.nvars_possible();
     if (max_flips_ > 0) n = std::min<int>(n, max_flips_);
-    for (uint i = 0; i < n; ++i) {
-      logp = mcmc_one_flip(g, indx[i], logp);
+
+    // Each flip adds or removes one variable, so the Cholesky factors needed
+    // by log_model_prob can be updated rather than recomputed.
+    SpdMatrix posterior_precision = suf().xtx() + slab_->siginv();
+    Cholesky prior_factor(g.select(slab_->siginv()));
+    Cholesky posterior_factor(g.select(posterior_precision));
+    if (!prior_factor.is_pos_def() || !posterior_factor.is_pos_def()) {
+      for (uint i = 0; i < n; ++i) {
+        logp = mcmc_one_flip(g, indx[i], logp);
+      }
+    } else {
+      for (uint i = 0; i < n; ++i) {
+        logp = mcmc_one_flip(g, indx[i], logp, posterior_precision,
+                             prior_factor, posterior_factor);
+      }
     }
     model_->coef().set_inc(g);
   }
 
+  double BLSSS::log_model_prob(const Selector &g,
+                               const Cholesky &prior_factor,
+                               const Cholesky &posterior_factor) const {
+    double num = spike_->logp(g);
+    if (num == BOOM::negative_infinity() || g.nvars() == 0) {
+      return num;
+    }
+    num += .5 * prior_factor.logdet();
+    Vector mu = g.select(slab_->mu());
+    Vector ivar_mu = g.select(slab_->siginv()) * mu;
+    num -= .5 * mu.dot(ivar_mu);
+
+    double denom = .5 * posterior_factor.logdet();
+    Vector S = g.select(suf().xty()) + ivar_mu;
+    Lsolve_inplace(posterior_factor.getL(false), S);
+    denom -= .5 * S.normsq();
+    return num - denom;
+  }
+
+  double BLSSS::mcmc_one_flip(Selector &mod, uint which_var, double logp_old,
+                              const SpdMatrix &posterior_precision,
+                              Cholesky &prior_factor,
+                              Cholesky &posterior_factor) {
+    Cholesky original_prior_factor = prior_factor;
+    Cholesky original_posterior_factor = posterior_factor;
+    bool ok = true;
+    if (mod.inc(which_var)) {
+      int position = mod.INDX(which_var);
+      mod.flip(which_var);
+      prior_factor.drop_row_col(position);
+      posterior_factor.drop_row_col(position);
+    } else {
+      mod.flip(which_var);
+      int position = mod.INDX(which_var);
+      ok = prior_factor.add_row_col(
+               position, mod.select(slab_->siginv().col(which_var))) &&
+           posterior_factor.add_row_col(
+               position, mod.select(posterior_precision.col(which_var)));
+    }
+    double logp_new = ok ? log_model_prob(mod, prior_factor, posterior_factor)
+                         : negative_infinity();
+    double u = runif_mt(rng(), 0, 1);
+    if (log(u) > logp_new - logp_old) {
+      mod.flip(which_var);  // reject draw
+      prior_factor = original_prior_factor;
+      posterior_factor = original_posterior_factor;
+      return logp_old;
+    }
+    return logp_new;
+  }
+
   double BLSSS::mcmc_one_flip(Selector &mod, uint which_var, double logp_old) {
     mod.flip(which_var);
     double logp_new = log_model_prob(mod);
@@ -19,6 +19,7 @@
 #ifndef BOOM_BINOMIAL_LOGIT_SPIKE_SLAB_SAMPLER_HPP_
 #define BOOM_BINOMIAL_LOGIT_SPIKE_SLAB_SAMPLER_HPP_
 
+#include "LinAlg/Cholesky.hpp"
 #include "LinAlg/Selector.hpp"
 #include "Models/Glm/PosteriorSamplers/BinomialLogitAuxmixSampler.hpp"
 #include "Models/Glm/VariableSelectionPrior.hpp"
@@ -76,6 +77,25 @@ namespace BOOM {
 
    private:
     double mcmc_one_flip(Selector &mod, uint which_var, double logp_old);
+
+    // The versions of log_model_prob and mcmc_one_flip used during a sweep
+    // through the inclusion indicators.  They keep live Cholesky factors of
+    // the included subsets of the prior and posterior precision matrices,
+    // which are updated in O(p^2) when a variable is added or dropped,
+    // instead of being refactored in O(p^3) for each candidate model.
+    //
+    // Args:
+    //   posterior_precision:  The full (unselected) posterior precision,
+    //     siginv + xtx.
+    //   prior_factor:  The Cholesky factor of the included subset of the
+    //     prior precision.
+    //   posterior_factor:  The Cholesky factor of the included subset of
+    //     posterior_precision.
+    double log_model_prob(const Selector &g, const Cholesky &prior_factor,
+                          const Cholesky &posterior_factor) const;
+    double mcmc_one_flip(Selector &mod, uint which_var, double logp_old,
+                         const SpdMatrix &posterior_precision,
+                         Cholesky &prior_factor, Cholesky &posterior_factor);
     BinomialLogitModel *model_;
     Ptr<MvnBase> slab_;
     Ptr<VariableSelectionPrior> spike_;
@@ -19,6 +19,7 @@
 
 #include "Models/Glm/PosteriorSamplers/BinomialProbitDataImputer.hpp"
 #include <cstdint>
+#include "LinAlg/Vector.hpp"
 #include "cpputil/report_error.hpp"
 #include "distributions.hpp"
 
@@ -51,22 +52,25 @@ namespace BOOM {
       // them up we'll have a normal with mean (y * mean) and variance
       // (y * variance).
       ans += rnorm_mt(rng, y * mean, sqrt(y * variance));
-    } else {
-      for (int i = 0; i < y; ++i) {
-        // TODO: If y is large-ish but not quite
-        // clt_threshold_ then we might waste some time here
-        // constantly rebuilding the same TnSampler object.
-        ans += rtrun_norm_mt(rng, eta, 1, 0, true);
-      }
+    } else if (y == 1) {
+      ans += rtrun_norm_mt(rng, eta, 1, 0, true);
+    } else if (y > 1) {
+      // The batch sampler shares its setup across the y draws, rather than
+      // building a new TnSampler for each one.
+      Vector draws(y);
+      rtrun_norm_mt(rng, draws, eta, 1, 0, true);
+      ans += draws.sum();
     }
 
     if (n - y > clt_threshold_) {
       trun_norm_moments(eta, 1, 0, false, &mean, &variance);
       ans += rnorm_mt(rng, (n - y) * mean, sqrt((n - y) * variance));
-    } else {
-      for (int i = 0; i < n - y; ++i) {
-        ans += rtrun_norm_mt(rng, eta, 1, 0, false);
-      }
+    } else if (n - y == 1) {
+      ans += rtrun_norm_mt(rng, eta, 1, 0, false);
+    } else if (n - y > 1) {
+      Vector draws(n - y);
+      rtrun_norm_mt(rng, draws, eta, 1, 0, false);
+      ans += draws.sum();
     }
     return ans;
   }
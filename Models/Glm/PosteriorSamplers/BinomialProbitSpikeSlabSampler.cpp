@@ -34,7 +34,10 @@ namespace BOOM {
         slab_prior_(slab_prior),
         spike_prior_(spike_prior),
         spike_slab_(model_, slab_prior_, spike_prior_),
-        imputer_(clt_threshold) {}
+        clt_threshold_(clt_threshold),
+        xtz_(model_->xdim()) {
+    set_number_of_workers(1);
+  }
 
   void BPSSS::draw() {
     impute_latent_data();
@@ -57,16 +60,38 @@ namespace BOOM {
     if (nrow(xtx_) != model_->xdim()) {
       refresh_xtx();
     }
+    if (number_of_observations_managed() != model_->dat().size()) {
+      // The model has gained or lost data since it was assigned to the
+      // workers.
+      assign_data_to_workers();
+    }
+    LatentDataSampler<Probit::ImputeWorker<BinomialRegressionData>>::
+        impute_latent_data();
+  }
 
-    xtz_.resize(model_->xdim());
-    xtz_ = 0.0;
-    const std::vector<Ptr<BinomialRegressionData>> &data(model_->dat());
-    for (int i = 0; i < data.size(); ++i) {
-      const Vector &x(data[i]->x());
-      double sum_of_z = imputer_.impute(rng(), data[i]->n(), data[i]->y(),
-                                        model_->predict(x));
-      xtz_.axpy(x, sum_of_z);
+  Ptr<Probit::ImputeWorker<BinomialRegressionData>> BPSSS::create_worker(
+      std::mutex &m) {
+    return new Probit::ImputeWorker<BinomialRegressionData>(
+        xtz_, m, clt_threshold_, model_->coef_prm().get(), nullptr, rng());
+  }
+
+  int BPSSS::number_of_observations_managed() {
+    int ans = 0;
+    for (const auto &worker : workers()) {
+      ans += worker->number_of_observations_managed();
+    }
+    return ans;
+  }
+
+  void BPSSS::assign_data_to_workers() {
+    distribute_data(model_->dat());
+  }
+
+  void BPSSS::clear_latent_data() {
+    if (xtz_.xtz().size() != model_->xdim()) {
+      xtz_.resize(model_->xdim());
     }
+    xtz_.clear();
   }
 
   void BPSSS::refresh_xtx() {
@@ -80,7 +105,7 @@ namespace BOOM {
   WeightedRegSuf BPSSS::complete_data_sufficient_statistics() const {
     WeightedRegSuf suf(model_->xdim());
     suf.set_xtwx(xtx_);
-    suf.set_xtwy(xtz_);
+    suf.set_xtwy(xtz_.xtz());
     return suf;
   }
 
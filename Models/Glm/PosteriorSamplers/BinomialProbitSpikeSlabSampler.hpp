@@ -21,17 +21,23 @@
 #define BOOM_BINOMIAL_PROBIT_SPIKE_SLAB_SAMPLER_HPP_
 
 #include "Models/Glm/BinomialProbitModel.hpp"
-#include "Models/Glm/PosteriorSamplers/BinomialProbitDataImputer.hpp"
+#include "Models/Glm/PosteriorSamplers/ProbitImputeWorker.hpp"
 #include "Models/Glm/PosteriorSamplers/SpikeSlabSampler.hpp"
 #include "Models/Glm/VariableSelectionPrior.hpp"
 #include "Models/Glm/WeightedRegressionModel.hpp"
 #include "Models/MvnBase.hpp"
+#include "Models/PosteriorSamplers/Imputer.hpp"
 #include "Models/PosteriorSamplers/PosteriorSampler.hpp"
 #include "distributions/rng.hpp"
 
 namespace BOOM {
 
-  class BinomialProbitSpikeSlabSampler : public PosteriorSampler {
+  // The latent data can be imputed in parallel by calling
+  // set_number_of_workers().
+  class BinomialProbitSpikeSlabSampler
+      : public PosteriorSampler,
+        public LatentDataSampler<
+            Probit::ImputeWorker<BinomialRegressionData>> {
    public:
     BinomialProbitSpikeSlabSampler(
         BinomialProbitModel *model, const Ptr<MvnBase> &slab_prior,
@@ -51,20 +57,29 @@ namespace BOOM {
     // inclusion indicators will be sampled.
     void limit_model_selection(int max_flips);
 
-    void impute_latent_data();
+    void impute_latent_data() override;
+    Ptr<Probit::ImputeWorker<BinomialRegressionData>> create_worker(
+        std::mutex &m) override;
+    void assign_data_to_workers() override;
+    void clear_latent_data() override;
 
     void refresh_xtx();
     WeightedRegSuf complete_data_sufficient_statistics() const;
 
    private:
+    // The number of observations assigned to the workers.
+    int number_of_observations_managed();
+
     BinomialProbitModel *model_;
     Ptr<MvnBase> slab_prior_;
     Ptr<VariableSelectionPrior> spike_prior_;
     SpikeSlabSampler spike_slab_;
-    BinomialProbitDataImputer imputer_;
+    int clt_threshold_;
 
+    // Complete data sufficient statistics.  Only xtz_ depends on the latent
+    // data.
     SpdMatrix xtx_;
-    Vector xtz_;
+    Probit::LatentDataSufficientStatistics xtz_;
   };
 
 }  // namespace BOOM
@@ -63,7 +63,9 @@ namespace BOOM {
         model_(model),
         coefficient_prior_(coefficient_prior),
         shape_parameter_prior_(shape_parameter_prior),
-        epsilon_(1e-5) {}
+        epsilon_(1e-5),
+        adaptive_(false),
+        adaptation_warmup_(100) {}
 
   void GRPS::reset_shape_parameter_prior(
       const Ptr<DiffDoubleModel> &shape_parameter_prior) {
@@ -78,12 +80,21 @@ namespace BOOM {
     Vector log_alpha_beta = model_->vectorize_params();
     log_alpha_beta[0] = log(log_alpha_beta[0]);
     log_alpha_beta = mh_sampler_->draw(log_alpha_beta);
+    if (adaptive_proposal_) {
+      adaptive_proposal_->observe(log_alpha_beta);
+    }
     if (mh_sampler_->last_draw_was_accepted()) {
       log_alpha_beta[0] = exp(log_alpha_beta[0]);
       model_->unvectorize_params(log_alpha_beta);
     }
   }
 
+  void GRPS::enable_adaptive_proposal(int warmup) {
+    adaptive_ = true;
+    adaptation_warmup_ = warmup;
+    mh_sampler_ = nullptr;
+  }
+
   double GRPS::logpri() const {
     double ans = shape_parameter_prior_->logp(model_->shape_parameter());
     ans += coefficient_prior_->logp(model_->Beta());
@@ -108,8 +119,15 @@ namespace BOOM {
           << error_message;
       report_error(err.str());
     }
-    mh_sampler_.reset(new MetropolisHastings(
-        target, new MvtIndepProposal(log_alpha_beta, -Hessian, 3)));
+    if (adaptive_) {
+      adaptive_proposal_.reset(new MvtRwmProposal(-Hessian, 3));
+      adaptive_proposal_->enable_adaptation(adaptation_warmup_);
+      mh_sampler_.reset(new MetropolisHastings(target, adaptive_proposal_));
+    } else {
+      adaptive_proposal_.reset();
+      mh_sampler_.reset(new MetropolisHastings(
+          target, new MvtIndepProposal(log_alpha_beta, -Hessian, 3)));
+    }
     log_alpha_beta[0] = exp(log_alpha_beta[0]);
     model_->unvectorize_params(log_alpha_beta);
   }
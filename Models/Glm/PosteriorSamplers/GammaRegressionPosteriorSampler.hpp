@@ -24,6 +24,7 @@
 #include "Models/Glm/GammaRegressionModel.hpp"
 #include "Models/MvnBase.hpp"
 #include "Models/PosteriorSamplers/PosteriorSampler.hpp"
+#include "Samplers/MH_Proposals.hpp"
 #include "Samplers/MetropolisHastings.hpp"
 
 namespace BOOM {
@@ -61,6 +62,15 @@ namespace BOOM {
     // mh_sampler_ will be defined. Otherwise it will be nullptr.
     bool posterior_mode_found() const { return !!mh_sampler_; }
 
+    // Replace the TIM proposal with an adaptive random walk (see
+    // MvtRwmProposal), whose fixed component is the inverse Hessian at the
+    // posterior mode.  The random walk is more robust than the TIM when
+    // the posterior is far from normal, and adapting its variance to the
+    // chain's history keeps the acceptance rate reasonable without
+    // recomputing derivatives.  Calling this function resets the MH
+    // sampler, as with reset_shape_parameter_prior.
+    void enable_adaptive_proposal(int warmup = 100);
+
     // Returns the log posterior and its derivatives with respect to
     // (log alpha, beta).
     double log_posterior(const Vector &log_alpha_beta, Vector &gradient,
@@ -76,6 +86,12 @@ namespace BOOM {
 
     // Value is nullptr until set by find_posterior_mode.
     Ptr<MetropolisHastings> mh_sampler_;
+
+    bool adaptive_;
+    int adaptation_warmup_;
+    // The proposal used by mh_sampler_ if adaptive_ is true.  Otherwise
+    // nullptr.
+    Ptr<MvtRwmProposal> adaptive_proposal_;
   };
 
 }  // namespace BOOM
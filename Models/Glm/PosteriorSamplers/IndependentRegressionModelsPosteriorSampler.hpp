@@ -21,11 +21,13 @@
 
 #include "Models/Glm/IndependentRegressionModels.hpp"
 #include "Models/PosteriorSamplers/PosteriorSampler.hpp"
+#include "cpputil/ThreadTools.hpp"
 
 namespace BOOM {
 
   // All work is deferred to the posterior samplers assigned to the subordinate
-  // models.
+  // models.  Each subordinate model is drawn by its own sampler, with its own
+  // RNG, so the draws can be made in parallel without changing their values.
   template <class GLM>
   class IndependentGlmsPosteriorSampler
       : public PosteriorSampler {
@@ -43,11 +45,19 @@ namespace BOOM {
     {}
 
     void draw() override {
-      for (int i = 0; i < model_->ydim(); ++i) {
+      pool_.parallel_for(0, model_->ydim(), 1, [this](int i) {
         model_->model(i)->sample_posterior();
-      }
+      });
     }
 
+    // Set the number of threads used to draw the subordinate models.  The
+    // default is zero, which draws them sequentially in the calling thread.
+    // When threads are used, any observers that a host model places on the
+    // subordinate parameters may be called concurrently, so they must be
+    // thread safe.
+    void set_number_of_threads(int n) { pool_.set_number_of_threads(n); }
+    int number_of_threads() const { return pool_.number_of_threads(); }
+
     double logpri() const override {
       double ans = 0;
       for (int i = 0; i < model_->ydim(); ++i) {
@@ -73,6 +83,7 @@ namespace BOOM {
 
    private:
     IndependentGlms<GLM> *model_;
+    SharedThreadPool pool_;
   };
 
   // The special case of GLM == RegressionModel is needed for legacy reasons.
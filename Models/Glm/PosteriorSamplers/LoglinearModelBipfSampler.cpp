@@ -36,8 +36,13 @@ namespace BOOM {
   {}
 
   void BIPF::draw() {
-    for (int i = 0; i < model_->number_of_effects(); ++i) {
-      draw_effect_parameters(i);
+    int number_of_effects = model_->number_of_effects();
+    std::vector<Vector> counts(number_of_effects);
+    pool_.parallel_for(0, number_of_effects, 1, [this, &counts](int i) {
+      counts[i] = adjusted_counts(i);
+    });
+    for (int i = 0; i < number_of_effects; ++i) {
+      draw_effect_parameters(i, counts[i]);
     }
     draw_intercept();
   }
@@ -52,33 +57,43 @@ namespace BOOM {
     model_->prm()->set_element(log(b0), 0);
   }
 
-  void BIPF::draw_effect_parameters(int effect_index) {
-
-    //
-    // TODO: This needs to be redone with the GIG distribution.
-    //
-    report_error("The loglinear model posterior sampler needs to be"
-                 " redone with draws from the GIG distribution.");
-
+  Vector BIPF::adjusted_counts(int effect_index) const {
     const CategoricalDataEncoder &encoder(model_->encoder(effect_index));
     const std::vector<int> &which_variables(encoder.which_variables());
 
-    Vector adjusted_counts(encoder.dim(), 0.0);
+    Vector ans(encoder.dim(), 0.0);
     const Array& counts(model_->suf()->margin(which_variables));
-    double sample_size = model_->suf()->sample_size();
     std::vector<int> indices(model_->nvars(), 0);
 
     for (auto it = counts.abegin(); it != counts.aend(); ++it) {
+      if (*it == 0.0) continue;
       for (int i = 0; i < which_variables.size(); ++i) {
         indices[which_variables[i]] = it.position()[i];
       }
-      adjusted_counts += *it * encoder.encode(indices);
+      ans.axpy(encoder.encode(indices), *it);
     }
 
-    // adjusted_counts now contains the count associated with each parameter.
-    // The count starts off with the number of times the base level for that
-    // parameter was observed.  It then subtracts off the counts for the
-    // reference level of the next margin up, etc.
+    // ans now contains the count associated with each parameter.  The count
+    // starts off with the number of times the base level for that parameter
+    // was observed.  It then subtracts off the counts for the reference level
+    // of the next margin up, etc.
+    return ans;
+  }
+
+  void BIPF::draw_effect_parameters(int effect_index) {
+    draw_effect_parameters(effect_index, adjusted_counts(effect_index));
+  }
+
+  void BIPF::draw_effect_parameters(int effect_index,
+                                    const Vector &adjusted_counts) {
+
+    //
+    // TODO: This needs to be redone with the GIG distribution.
+    //
+    report_error("The loglinear model posterior sampler needs to be"
+                 " redone with draws from the GIG distribution.");
+
+    double sample_size = model_->suf()->sample_size();
 
     // The count in adjusted_counts might be negative.
     Vector coefficients(adjusted_counts.size());
@@ -21,6 +21,7 @@
 
 #include "Models/Glm/LoglinearModel.hpp"
 #include "Models/PosteriorSamplers/PosteriorSampler.hpp"
+#include "cpputil/ThreadTools.hpp"
 #include "distributions.hpp"
 
 namespace BOOM {
@@ -43,10 +44,26 @@ namespace BOOM {
     void draw_effect_parameters(int effect_index);
     void draw_intercept();
 
+    // The count associated with each parameter of the given effect, computed
+    // from the effect's margin in the model's sufficient statistics.  The
+    // work is proportional to the size of the margin, not the full table.
+    Vector adjusted_counts(int effect_index) const;
+
+    // The adjusted counts for different effects only read the sufficient
+    // statistics, so draw() computes them in parallel across effects using
+    // this many threads.
+    void set_number_of_threads(int number_of_threads) {
+      pool_.set_number_of_threads(number_of_threads);
+    }
+
    private:
+    void draw_effect_parameters(int effect_index,
+                                const Vector &adjusted_counts);
+
     LoglinearModel *model_;
     double prior_count_;
     double min_scale_;
+    SharedThreadPool pool_;
   };
 
 }  // namespace BOOM
@@ -30,7 +30,7 @@ namespace BOOM {
                        RNG &seeding_rng)
       : PosteriorSampler(seeding_rng), mod_(Mod), pri(Pri) {
     Ptr<VariableSelectionPrior> vp(0);
-    sam = new MLVS(mod_, pri, vp, nthreads, false);
+    sam = new MLVS(mod_, pri, vp, nthreads, false, rng());
     sam->suppress_model_selection();
   }
   void AUX::draw() { sam->draw(); }
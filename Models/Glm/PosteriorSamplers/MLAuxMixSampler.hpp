@@ -45,6 +45,11 @@ namespace BOOM {
     void draw() override;
     double logpri() const override;
 
+    // Impute the latent data using up to n threads.  The data are split
+    // among n workers, each accumulating its own complete data sufficient
+    // statistics, which are then combined.
+    void set_number_of_workers(int n) { sam->set_number_of_workers(n); }
+
    private:
     MultinomialLogitModel *mod_;
     Ptr<MvnBase> pri;
@@ -74,6 +74,17 @@ namespace BOOM {
     draw_beta();
   }
 
+  void MLVS::impute_latent_data() {
+    int managed = 0;
+    for (const auto &worker : workers()) {
+      managed += worker->number_of_observations_managed();
+    }
+    if (managed != mod_->dat().size()) {
+      assign_data_to_workers();
+    }
+    LatentDataSampler<MlvsDataImputer>::impute_latent_data();
+  }
+
   void MLVS::clear_latent_data() { suf_.clear(); }
 
   Ptr<MlvsDataImputer> MLVS::create_worker(std::mutex &m) {
@@ -81,7 +92,7 @@ namespace BOOM {
   }
 
   void MLVS::assign_data_to_workers() {
-    BOOM::assign_data_to_workers(mod_->dat(), workers());
+    distribute_data(mod_->dat());
   }
 
   double MLVS::logpri() const {
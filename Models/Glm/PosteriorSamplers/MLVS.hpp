@@ -69,6 +69,11 @@ namespace BOOM {
     void draw() override;
     double logpri() const override;
 
+    // Impute the latent utilities and mixture indicators, in parallel if
+    // set_number_of_workers() was given more than one worker.  The data are
+    // reassigned to the workers if the model has gained or lost
+    // observations.
+    void impute_latent_data() override;
     void clear_latent_data() override;
     Ptr<MlvsDataImputer> create_worker(std::mutex &m) override;
     void assign_data_to_workers() override;
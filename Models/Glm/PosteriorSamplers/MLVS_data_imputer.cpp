@@ -51,9 +51,13 @@ namespace BOOM {
   void MlvsDataImputer::impute_latent_data_point(const ChoiceData &dp,
                                                  SufficientStatistics *suf,
                                                  RNG &rng) {
-    model_->fill_eta(dp, eta);  // eta+= downsampling_logprob
-    if (downsampling_) eta += log_sampling_probs_;  //
     uint M = model_->Nchoices();
+    // Each choice's utility only involves its own block of coefficients, so
+    // avoid multiplying by the full (block sparse) design matrix.
+    for (uint m = 0; m < M; ++m) {
+      eta[m] = model_->predict_subject(dp, m) + model_->predict_choice(dp, m);
+    }
+    if (downsampling_) eta += log_sampling_probs_;
     uint y = dp.value();
     assert(y < M);
     double loglam = lse(eta);
@@ -27,15 +27,25 @@ namespace BOOM {
   typedef MlogitRwm MLR;
 
   MLR::MlogitRwm(MLM *mlm, const Ptr<MvnBase> &pri, RNG &seeding_rng)
-      : PosteriorSampler(seeding_rng), mlm_(mlm), pri_(pri) {}
+      : PosteriorSampler(seeding_rng),
+        mlm_(mlm),
+        pri_(pri),
+        adaptive_(false),
+        adaptation_warmup_(100) {}
 
   MLR::MlogitRwm(MLM *mlm, const Vector &mu, const SpdMatrix &Ominv,
                  RNG &seeding_rng)
       : PosteriorSampler(seeding_rng),
         mlm_(mlm),
-        pri_(new MvnModel(mu, Ominv, true)) {}
+        pri_(new MvnModel(mu, Ominv, true)),
+        adaptive_(false),
+        adaptation_warmup_(100) {}
 
   void MLR::draw() {
+    if (adaptive_) {
+      draw_adaptive();
+      return;
+    }
     // random walk metropolis centered on current beta, with inverse
     // variance matrix given by current hessian of log posterior
 
@@ -65,6 +75,47 @@ namespace BOOM {
     }
   }
 
+  void MLR::enable_adaptive_proposal(int warmup) {
+    adaptive_ = true;
+    adaptation_warmup_ = warmup;
+    adaptive_proposal_.reset();
+  }
+
+  void MLR::draw_adaptive() {
+    const Selector &inc(mlm_->coef().inc());
+    Vector nonzero_beta = mlm_->coef().included_coefficients();
+    mu = inc.select(pri_->mu());
+    ivar = inc.select(pri_->siginv());
+    double logp_old;
+    if (!adaptive_proposal_ || proposal_inc_ != inc) {
+      uint p = inc.nvars();
+      H.resize(p);
+      g.resize(p);
+      logp_old = mlm_->Loglike(nonzero_beta, g, H, 2) +
+                 dmvn(nonzero_beta, mu, ivar, 0, true);
+      H *= -1;
+      H += ivar;
+      adaptive_proposal_.reset(new MvtRwmProposal(H, 3));
+      adaptive_proposal_->enable_adaptation(adaptation_warmup_);
+      proposal_inc_ = inc;
+    } else {
+      logp_old = mlm_->loglike(nonzero_beta) +
+                 dmvn(nonzero_beta, mu, ivar, 0, true);
+    }
+
+    // The proposal is symmetric, so it drops out of the MH ratio.
+    bstar = adaptive_proposal_->draw(nonzero_beta, &rng());
+    double logp_new = mlm_->loglike(bstar) + dmvn(bstar, mu, ivar, 0, true);
+    double logu = log(runif_mt(rng(), 0, 1));
+    while (!std::isfinite(logu)) logu = log(runif_mt(rng(), 0, 1));
+    if (logu <= logp_new - logp_old) {
+      mlm_->coef().set_included_coefficients(bstar);
+      adaptive_proposal_->observe(bstar);
+    } else {
+      adaptive_proposal_->observe(nonzero_beta);
+    }
+  }
+
   double MLR::logpri() const {
     const Selector &inc(mlm_->coef().inc());
     Vector b = mlm_->coef().included_coefficients();
@@ -23,6 +23,7 @@
 #include "Models/Glm/MultinomialLogitModel.hpp"
 #include "Models/MvnBase.hpp"
 #include "Models/PosteriorSamplers/PosteriorSampler.hpp"
+#include "Samplers/MH_Proposals.hpp"
 
 namespace BOOM {
   class MlogitRwm : public PosteriorSampler {
@@ -34,11 +35,26 @@ namespace BOOM {
     void draw() override;
     double logpri() const override;
 
+    // Adapt the proposal variance to the posterior as the chain runs (see
+    // MvtRwmProposal).  The fixed component of the proposal is the posterior
+    // information at the first draw after this call, so the Hessian is not
+    // recomputed on each iteration.  Adaptation restarts whenever the set of
+    // included coefficients changes.
+    void enable_adaptive_proposal(int warmup = 100);
+
    private:
+    void draw_adaptive();
+
     MultinomialLogitModel *mlm_;
     Ptr<MvnBase> pri_;
     Vector mu, g, b, bstar;
     SpdMatrix H, ivar;
+
+    bool adaptive_;
+    int adaptation_warmup_;
+    Ptr<MvtRwmProposal> adaptive_proposal_;
+    // The inclusion indicators in effect when adaptive_proposal_ was built.
+    Selector proposal_inc_;
   };
 
 }  // namespace BOOM
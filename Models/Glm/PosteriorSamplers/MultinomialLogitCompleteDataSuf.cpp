@@ -19,6 +19,7 @@
 
 #include "Models/Glm/PosteriorSamplers/MultinomialLogitCompleteDataSuf.hpp"
 #include "cpputil/math_utils.hpp"
+#include "cpputil/report_error.hpp"
 
 namespace BOOM {
   namespace MultinomialLogit {
@@ -40,13 +41,47 @@ namespace BOOM {
 
     void MLVSS::update(const ChoiceData &dp, const Vector &wgts,
                        const Vector &u) {
-      const Matrix &X(dp.X(false));     // 'false' means omit columns
-      xtwx_.add_inner(X, wgts, false);  // corresponding to subject X's at
-      xtwu_ += X.Tmult(wgts * u);       // choice level 0.
-      sym_ = false;
-      for (int i = 0; i < wgts.size(); ++i) {
-        weighted_sum_of_squares_ += wgts[i] * square(u[i]);
+      // The design matrix dp.X(false) is block sparse: row m > 0 holds the
+      // subject predictors in block m - 1 and the choice predictors for
+      // choice m in the final block.  Only the nonzero blocks of X'WX and
+      // X'Wu are touched, which saves a factor of roughly Nchoices^2 over
+      // the dense computation.  Only the upper triangle of xtwx_ is filled.
+      const Vector &xsub(dp.Xsubject());
+      int psub = dp.subject_nvars();
+      int pch = dp.choice_nvars();
+      int M = wgts.size();
+      int choice_start = (M - 1) * psub;
+      if (choice_start + pch != xtwu_.size()) {
+        report_error("ChoiceData does not match the dimension of the "
+                     "complete data sufficient statistics.");
+      }
+      for (int m = 0; m < M; ++m) {
+        double w = wgts[m];
+        double wu = w * u[m];
+        const Vector &xch(dp.Xchoice(m));
+        if (m > 0) {
+          int lo = (m - 1) * psub;
+          for (int j = 0; j < psub; ++j) {
+            double wxj = w * xsub[j];
+            for (int i = 0; i <= j; ++i) {
+              xtwx_(lo + i, lo + j) += wxj * xsub[i];
+            }
+            for (int k = 0; k < pch; ++k) {
+              xtwx_(lo + j, choice_start + k) += wxj * xch[k];
+            }
+            xtwu_[lo + j] += wu * xsub[j];
+          }
+        }
+        for (int k = 0; k < pch; ++k) {
+          double wxk = w * xch[k];
+          for (int i = 0; i <= k; ++i) {
+            xtwx_(choice_start + i, choice_start + k) += wxk * xch[i];
+          }
+          xtwu_[choice_start + k] += wu * xch[k];
+        }
+        weighted_sum_of_squares_ += w * square(u[m]);
       }
+      sym_ = false;
     }
 
     void MLVSS::combine(const MLVSS &rhs) {
@@ -60,7 +60,7 @@ namespace BOOM {
     SpdMatrix ivar = Ominv_ + s->xtx();
     Matrix Mu = s->xty() + Ominv_ * beta_prior_mean_;
     Mu = ivar.solve(Mu);
-    Matrix ans = rmatrix_normal_ivar(Mu, ivar, model_->Siginv());
+    Matrix ans = rmatrix_normal_ivar_mt(rng(), Mu, ivar, model_->Siginv());
     model_->set_Beta(ans);
   }
 
@@ -68,7 +68,7 @@ namespace BOOM {
     Ptr<MvRegSuf> s(model_->suf());
     SpdMatrix sumsq = SS_ + s->SSE(model_->Beta());
     double df = prior_df_ + s->n();
-    SpdMatrix ans = rWish(df, sumsq.inv());
+    SpdMatrix ans = rWish_mt(rng(), df, sumsq.inv());
     model_->set_Siginv(ans);
   }
 }  // namespace BOOM
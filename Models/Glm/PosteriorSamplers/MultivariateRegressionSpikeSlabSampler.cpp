@@ -19,6 +19,7 @@
 #include "Models/Glm/PosteriorSamplers/MultivariateRegressionSpikeSlabSampler.hpp"
 #include "Models/PosteriorSamplers/MvnVarSampler.hpp"
 #include "cpputil/lse.hpp"
+#include "cpputil/math_utils.hpp"
 #include "distributions.hpp"
 #include "cpputil/report_error.hpp"
 
@@ -26,7 +27,121 @@ namespace BOOM {
 
   namespace {
     using MRSSS = MultivariateRegressionSpikeSlabSampler;
-  }  // namespace 
+
+    // The scalar regression problem solved for a single column of Beta by
+    // MultivariateRegressionSpikeSlabSampler::draw_columns().  The response
+    // has been adjusted for the residuals of the other columns, so that
+    //   y_j ~ N(X * beta_j, 1 / siginv),  beta_j ~ N(prior_mean, (siginv *
+    //   row_precision)^{-1}),
+    // with the prior restricted to the included coefficients.
+    class ColumnSelectionProblem {
+     public:
+      ColumnSelectionProblem(const ConstVectorView &prior_inclusion_probs,
+                             double siginv,
+                             const SpdMatrix &row_precision,
+                             const SpdMatrix &posterior_row_precision,
+                             const Vector &prior_mean,
+                             const Vector &xty)
+          : log_prob_in_(prior_inclusion_probs.size()),
+            log_prob_out_(prior_inclusion_probs.size()),
+            siginv_(siginv),
+            row_precision_(row_precision),
+            posterior_row_precision_(posterior_row_precision),
+            prior_mean_(prior_mean),
+            xty_(xty) {
+        for (int i = 0; i < prior_inclusion_probs.size(); ++i) {
+          double prob = prior_inclusion_probs[i];
+          log_prob_in_[i] = prob > 0 ? log(prob) : negative_infinity();
+          log_prob_out_[i] = prob < 1 ? log(1 - prob) : negative_infinity();
+        }
+      }
+
+      // The log of the un-normalized probability of 'included', given the
+      // Cholesky factors of the included prior and posterior row precisions.
+      // Terms that do not depend on 'included' are omitted.
+      double log_model_probability(const Selector &included,
+                                   const Cholesky &prior_factor,
+                                   const Cholesky &posterior_factor) const {
+        double ans = 0;
+        for (int i = 0; i < included.nvars_possible(); ++i) {
+          ans += included[i] ? log_prob_in_[i] : log_prob_out_[i];
+        }
+        if (ans == negative_infinity() || included.nvars() == 0) {
+          return ans;
+        }
+        Vector mu = included.select(prior_mean_);
+        Vector ivar_mu = included.select(row_precision_) * mu;
+        Vector S = included.select(xty_) + ivar_mu;
+        Lsolve_inplace(posterior_factor.getL(false), S);
+        // The factors of siginv in the determinants cancel.
+        ans += .5 * (prior_factor.logdet() - posterior_factor.logdet());
+        ans -= .5 * siginv_ * (mu.dot(ivar_mu) - S.normsq());
+        return ans;
+      }
+
+      // Propose flipping included[which_variable], and accept or reject the
+      // proposal with a Metropolis-Hastings step.  The Cholesky factors are
+      // kept consistent with 'included'.
+      double mcmc_one_flip(RNG &rng, Selector &included, int which_variable,
+                           double logp_old, Cholesky &prior_factor,
+                           Cholesky &posterior_factor) const {
+        Cholesky original_prior_factor = prior_factor;
+        Cholesky original_posterior_factor = posterior_factor;
+        bool ok = true;
+        if (included[which_variable]) {
+          int position = included.INDX(which_variable);
+          included.flip(which_variable);
+          prior_factor.drop_row_col(position);
+          posterior_factor.drop_row_col(position);
+        } else {
+          included.flip(which_variable);
+          int position = included.INDX(which_variable);
+          ok = prior_factor.add_row_col(
+                   position, included.select(row_precision_.col(
+                       which_variable))) &&
+               posterior_factor.add_row_col(
+                   position, included.select(posterior_row_precision_.col(
+                       which_variable)));
+        }
+        double logp_new = ok
+            ? log_model_probability(included, prior_factor, posterior_factor)
+            : negative_infinity();
+        double u = runif_mt(rng, 0, 1);
+        if (log(u) > logp_new - logp_old) {
+          included.flip(which_variable);
+          prior_factor = original_prior_factor;
+          posterior_factor = original_posterior_factor;
+          return logp_old;
+        }
+        return logp_new;
+      }
+
+      // Draw the included coefficients given 'included'.
+      Vector draw_coefficients(RNG &rng, const Selector &included,
+                               const Cholesky &posterior_factor) const {
+        if (included.nvars() == 0) {
+          return Vector(0);
+        }
+        Vector mu = included.select(prior_mean_);
+        Vector S = included.select(xty_) + included.select(row_precision_) * mu;
+        Vector ans = posterior_factor.solve(S);
+        Vector z(ans.size());
+        rnorm_mt(rng, VectorView(z), 0, 1.0 / sqrt(siginv_));
+        LTsolve_inplace(posterior_factor.getL(false), z);
+        ans += z;
+        return ans;
+      }
+
+     private:
+      Vector log_prob_in_;
+      Vector log_prob_out_;
+      double siginv_;
+      const SpdMatrix &row_precision_;
+      const SpdMatrix &posterior_row_precision_;
+      const Vector &prior_mean_;
+      const Vector &xty_;
+    };
+  }  // namespace
 
   void CompositeCholesky::decompose(const Matrix &row_cholesky,
                                     const Matrix &siginv_cholesky,
@@ -195,7 +310,8 @@ namespace BOOM {
         spike_(spike),
         slab_(slab),
         residual_precision_prior_(residual_precision_prior),
-        total_row_precision_cholesky_(0, 0)
+        total_row_precision_cholesky_(0, 0),
+        per_response_updates_(false)
   {}
 
   double MRSSS::logpri() const {
@@ -212,14 +328,18 @@ namespace BOOM {
     } else {
       Selector included = model_->included_coefficients().vectorize();
       Vector beta = included.select(vec(model_->Beta()));
-      Vector mean = included.select(slab_->mvn_mean());
-      SpdMatrix precision = included.select(slab_->mvn_precision());
-      ans += dmvn(beta, mean, precision, true);
+      ans += slab_->logp_given_inclusion(beta, nullptr, nullptr, included,
+                                         false);
     }
     return ans;
   }
   
   void MRSSS::draw() {
+    if (per_response_updates_) {
+      draw_columns();
+      draw_residual_variance();
+      return;
+    }
     set_total_row_precision_cholesky();
     draw_inclusion_indicators();
     draw_residual_variance();
@@ -253,6 +373,93 @@ namespace BOOM {
     }
   }
 
+  void MRSSS::draw_columns() {
+    const MvRegSuf &suf(*model_->suf());
+    const SelectorMatrix &included(model_->included_coefficients());
+    const Matrix &Beta(model_->Beta());
+    int xdim = Beta.nrow();
+    int ydim = Beta.ncol();
+
+    // Quantities shared by all columns.  Siginv is computed lazily, so it is
+    // evaluated here rather than in the worker threads.
+    const SpdMatrix &Siginv(model_->Siginv());
+    SpdMatrix posterior_row_precision = suf.xtx() + slab_->row_precision();
+    Matrix xtr = suf.xty() - suf.xtx() * Beta;
+    Matrix deviation = Beta - slab_->mean();
+    for (int j = 0; j < ydim; ++j) {
+      for (int i = 0; i < xdim; ++i) {
+        if (!included(i, j)) deviation(i, j) = 0.0;
+      }
+    }
+
+    std::vector<Selector> columns;
+    for (int j = 0; j < ydim; ++j) {
+      columns.push_back(included.col(j));
+    }
+    Matrix new_beta(xdim, ydim, 0.0);
+    RNG::RngIntType seed = seed_rng(rng());
+    auto draw_one_column = [&](int j) {
+      RNG column_rng(seed, j);
+      draw_column(column_rng, j, Siginv, xtr, deviation,
+                  posterior_row_precision, columns[j], new_beta.col(j));
+    };
+    if (pool_.no_threads()) {
+      for (int j = 0; j < ydim; ++j) {
+        draw_one_column(j);
+      }
+    } else {
+      pool_.parallel_for(0, ydim, 1, draw_one_column);
+    }
+
+    SelectorMatrix new_included(included);
+    for (int j = 0; j < ydim; ++j) {
+      for (int i = 0; i < xdim; ++i) {
+        if (columns[j][i]) {
+          new_included.add(i, j);
+        } else {
+          new_included.drop(i, j);
+        }
+      }
+    }
+    model_->Beta_prm()->set_inclusion_pattern(new_included);
+    model_->set_Beta(new_beta);
+  }
+
+  void MRSSS::draw_column(RNG &rng, int j, const SpdMatrix &Siginv,
+                          const Matrix &xtr, const Matrix &deviation,
+                          const SpdMatrix &posterior_row_precision,
+                          Selector &included, VectorView beta) const {
+    double siginv = Siginv(j, j);
+
+    // The residual of y_j given the residuals of the other responses has
+    // regression coefficients -Siginv(j, k) / Siginv(j, j).
+    Vector weights = Siginv.col(j) / siginv;
+    weights[j] = 0.0;
+    Vector xty = model_->suf()->xty().col(j) + xtr * weights;
+    Vector prior_mean = slab_->mean().col(j) - deviation * weights;
+
+    ColumnSelectionProblem problem(
+        spike_->prior_inclusion_probabilities().col(j),
+        siginv,
+        slab_->row_precision(),
+        posterior_row_precision,
+        prior_mean,
+        xty);
+    Cholesky prior_factor(included.select(slab_->row_precision()));
+    Cholesky posterior_factor(included.select(posterior_row_precision));
+    if (!prior_factor.is_pos_def() || !posterior_factor.is_pos_def()) {
+      report_error("The included row precision is not positive definite.");
+    }
+    double logp = problem.log_model_probability(
+        included, prior_factor, posterior_factor);
+    for (int i = 0; i < included.nvars_possible(); ++i) {
+      logp = problem.mcmc_one_flip(rng, included, i, logp, prior_factor,
+                                   posterior_factor);
+    }
+    beta = included.expand(problem.draw_coefficients(
+        rng, included, posterior_factor));
+  }
+
   double MRSSS::log_model_probability(const SelectorMatrix &included) const {
     // Computing the prior mean involves the Cholesky of the posterior
     // precision.
@@ -24,6 +24,8 @@
 #include "Models/MatrixNormalModel.hpp"
 #include "Models/WishartModel.hpp"
 #include "Models/PosteriorSamplers/PosteriorSampler.hpp"
+#include "LinAlg/Cholesky.hpp"
+#include "cpputil/ThreadTools.hpp"
 
 namespace BOOM {
 
@@ -136,7 +138,41 @@ namespace BOOM {
     // should be called before any of the draw_X functions are called.  It only
     // needs to be called once, and is a no-op if called again.
     void set_total_row_precision_cholesky();
-    
+
+    // By default draw() updates the inclusion indicators using the full
+    // residual precision, which couples every column of Beta.  Each flip costs
+    // a QR decomposition of dimension (xdim * ydim), which is prohibitive
+    // when ydim is large.
+    //
+    // If per-response updates are turned on, draw() instead calls
+    // draw_columns() followed by draw_residual_variance().
+    void set_per_response_updates(bool per_response) {
+      per_response_updates_ = per_response;
+    }
+
+    // The columns updated by draw_columns() are independent of one another,
+    // so they can be run concurrently.  Draws do not depend on the number of
+    // threads.
+    void set_number_of_threads(int n) { pool_.set_number_of_threads(n); }
+
+    // Draw the inclusion indicators and coefficients for each column of Beta,
+    // one response at a time, holding Sigma fixed.  Column j is drawn from
+    // p(gamma_j, beta_j | B_{-j}, Sigma, Y), where y_j is regressed on X
+    // after adjusting for the residuals of the other responses, which gives
+    // a scalar regression with residual variance 1 / Siginv(j, j) and prior
+    // precision Siginv(j, j) * row_precision.  Columns share X'X through the
+    // sufficient statistics, and each column keeps its own Cholesky factors
+    // up to date with Cholesky::add_row_col and drop_row_col as indicators
+    // flip.
+    //
+    // All columns condition on the value of B at the start of the call, so
+    // they can be drawn concurrently on the thread pool.  When Sigma is
+    // diagonal the columns are conditionally independent and this is an
+    // exact Gibbs step.  Otherwise it is an approximation that ignores the
+    // dependence of the slab's normalizing constant on the other columns'
+    // indicators, and uses B_{-j} from the start of the sweep.
+    void draw_columns();
+
    private:
     // Args:
     //   rng:  The random number generator.
@@ -152,6 +188,25 @@ namespace BOOM {
     void attempt_flip(RNG &rng, SelectorMatrix &included, int i, int j,
                       double &current_logprob) const;
 
+    // Draw column j of the inclusion indicators and coefficients, as part of
+    // draw_columns().
+    //
+    // Args:
+    //   rng:  The random number generator to use for this column.
+    //   j:  The index of the column to draw.
+    //   Siginv:  The residual precision matrix.
+    //   xtr:  X' times the residuals of all responses at the current Beta.
+    //   deviation:  Beta minus the prior mean, with zeros for the excluded
+    //     coefficients.
+    //   posterior_row_precision: X'X + slab_->row_precision().
+    //   included:  On input, the current inclusion indicators for column j.
+    //     On output, the drawn indicators.
+    //   beta:  On output, the drawn coefficients for column j.
+    void draw_column(RNG &rng, int j, const SpdMatrix &Siginv,
+                     const Matrix &xtr, const Matrix &deviation,
+                     const SpdMatrix &posterior_row_precision,
+                     Selector &included, VectorView beta) const;
+
     
     MultivariateRegressionModel *model_;
 
@@ -174,6 +229,9 @@ namespace BOOM {
     // TODO(stevescott): Set an observer on the prior precision if it is
     // expected to change, then update as needed.
     Matrix total_row_precision_cholesky_;
+
+    bool per_response_updates_;
+    SharedThreadPool pool_;
   };
   
 }  // namespace BOOM
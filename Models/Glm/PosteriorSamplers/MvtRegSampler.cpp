@@ -28,6 +28,16 @@ namespace BOOM {
 
   typedef MvtRegSampler MVTRS;
 
+  namespace {
+    // The number of observations in each block of the latent data
+    // imputation.
+    const int mvt_block_size = 256;
+
+    // The maximum number of shards used for imputation.  Each shard has its
+    // own complete data sufficient statistics.
+    const int max_number_of_shards = 32;
+  }  // namespace
+
   struct Logp_nu {
     Logp_nu(const Ptr<ScaledChisqModel> &Numod, const Ptr<DoubleModel> &Pri)
         : loglike(Numod.get()), pri(Pri) {}
@@ -74,27 +84,82 @@ namespace BOOM {
   }
 
   void MVTRS::impute_w() {
+    int sample_size = mod->dat().size();
+    if (sample_size == 0) return;
+    int number_of_blocks = (sample_size + mvt_block_size - 1) / mvt_block_size;
+    int blocks_per_shard = (number_of_blocks + max_number_of_shards - 1)
+        / max_number_of_shards;
+    int shard_size = blocks_per_shard * mvt_block_size;
+    int number_of_shards = (sample_size + shard_size - 1) / shard_size;
+    if (shard_reg_suf_.size() != number_of_shards) {
+      shard_reg_suf_.assign(number_of_shards,
+                            MvRegSuf(mod->xdim(), mod->ydim()));
+      shard_weight_suf_.assign(number_of_shards, GammaSuf());
+    }
+
+    // Siginv is computed lazily, so it is evaluated here rather than in the
+    // worker threads.
+    const SpdMatrix &Siginv(mod->Siginv());
+    RNG::RngIntType seed = seed_rng(rng());
+    auto impute_shard = [&](int shard) {
+      RNG shard_rng(seed, shard);
+      int begin = shard * shard_size;
+      int end = std::min<int>(begin + shard_size, sample_size);
+      shard_reg_suf_[shard].clear();
+      shard_weight_suf_[shard].clear();
+      impute_w(begin, end, Siginv, shard_reg_suf_[shard],
+               shard_weight_suf_[shard], shard_rng);
+    };
+    if (pool_.no_threads()) {
+      for (int shard = 0; shard < number_of_shards; ++shard) {
+        impute_shard(shard);
+      }
+    } else {
+      pool_.parallel_for(0, number_of_shards, 1, impute_shard);
+    }
+
     Ptr<MvRegSuf> rs = reg_model->suf();
     Ptr<GammaSuf> gs = nu_model->suf();
-
-    const std::vector<Ptr<MvRegData> > &dat(mod->dat());
-    uint n = dat.size();
-    for (uint i = 0; i < n; ++i) {
-      Ptr<MvRegData> dp = dat[i];
-      double w = impute_w(dp);
-      rs->update_raw_data(dp->y(), dp->x(), w);
-      gs->update_raw(w);
+    for (int shard = 0; shard < number_of_shards; ++shard) {
+      rs->combine(shard_reg_suf_[shard]);
+      gs->combine(shard_weight_suf_[shard]);
     }
   }
 
-  double MVTRS::impute_w(const Ptr<MvRegData> &dp) {
-    const Vector &y(dp->y());
-    const Vector &x(dp->x());
-    yhat = mod->predict(x);
+  // Given y, the weight w has a Ga((nu + ydim) / 2, (nu + ss) / 2)
+  // distribution, where ss is the Mahalanobis distance from y to yhat.
+  void MVTRS::impute_w(int begin, int end, const SpdMatrix &Siginv,
+                       MvRegSuf &reg_suf, GammaSuf &weight_suf,
+                       RNG &rng) const {
+    const std::vector<Ptr<MvRegData>> &data(mod->dat());
+    const Matrix &Beta(mod->Beta());
     double nu = mod->nu();
-    double ss = mod->Siginv().Mdist(y, yhat);
-    double w = rgamma((nu + y.size()) / 2, (nu + ss) / 2);
-    return w;
+    int xdim = Beta.nrow();
+    int ydim = Beta.ncol();
+    Matrix predictors;
+    Matrix response;
+    Vector weights;
+    while (begin < end) {
+      int nobs = std::min<int>(end - begin, mvt_block_size);
+      predictors.resize(nobs, xdim);
+      response.resize(nobs, ydim);
+      for (int i = 0; i < nobs; ++i) {
+        predictors.row(i) = data[begin + i]->x();
+        response.row(i) = data[begin + i]->y();
+      }
+      Matrix residual = response - predictors * Beta;
+      Matrix scaled_residual = residual * Siginv;
+      weights.resize(nobs);
+      // Ga(a, b) is Ga(a, 1) / b, so the shared shape can be drawn in bulk.
+      rgamma_mt(rng, weights, 0.5 * (nu + ydim), 1.0);
+      for (int i = 0; i < nobs; ++i) {
+        double ss = residual.row(i).dot(scaled_residual.row(i));
+        weights[i] /= 0.5 * (nu + ss);
+        weight_suf.update_raw(weights[i]);
+      }
+      reg_suf.add_data(predictors, response, weights);
+      begin += nobs;
+    }
   }
 
   void MVTRS::draw_Sigma() { reg_sampler->draw_Sigma(); }
@@ -19,12 +19,14 @@
 #ifndef BOOM_MVT_REG_SAMPLER_HPP
 #define BOOM_MVT_REG_SAMPLER_HPP
 
+#include "Models/GammaModel.hpp"
 #include "Models/Glm/MultivariateRegression.hpp"
 #include "Models/Glm/MvtRegModel.hpp"
 #include "Models/Glm/PosteriorSamplers/MultivariateRegressionSampler.hpp"
 #include "Models/PosteriorSamplers/PosteriorSampler.hpp"
 #include "Models/ScaledChisqModel.hpp"
 #include "Samplers/SliceSampler.hpp"
+#include "cpputil/ThreadTools.hpp"
 
 namespace BOOM {
   class GammaModel;
@@ -43,6 +45,11 @@ namespace BOOM {
     void draw() override;
     double logpri() const override;
 
+    // The latent weights are imputed in shards, each of which accumulates
+    // its own sufficient statistics.  The shards can be run concurrently.
+    // Draws do not depend on the number of threads.
+    void set_number_of_threads(int n) { pool_.set_number_of_threads(n); }
+
    private:
     MvtRegModel *mod;
 
@@ -55,9 +62,19 @@ namespace BOOM {
     Ptr<DoubleModel> nu_prior;
     Ptr<SliceSampler> nu_sampler;
 
-    Vector yhat;
+    std::vector<MvRegSuf> shard_reg_suf_;
+    std::vector<GammaSuf> shard_weight_suf_;
+    SharedThreadPool pool_;
+
     void impute_w();
-    double impute_w(const Ptr<MvRegData> &dp);
+
+    // Impute the weights for observations [begin, end) given the residual
+    // precision Siginv, and add the weighted observations to 'reg_suf' and
+    // the weights to 'weight_suf'.  Observations are processed in blocks, so each block's residuals come
+    // from a single matrix product, and its sufficient statistics from
+    // rank-k updates.
+    void impute_w(int begin, int end, const SpdMatrix &Siginv,
+                  MvRegSuf &reg_suf, GammaSuf &weight_suf, RNG &rng) const;
     void draw_Sigma();
     void draw_Beta();
     void draw_nu();
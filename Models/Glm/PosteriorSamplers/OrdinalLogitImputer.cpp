@@ -18,6 +18,7 @@
 
 #include "Models/Glm/PosteriorSamplers/OrdinalLogitImputer.hpp"
 #include "distributions.hpp"
+#include "distributions/trun_logit.hpp"
 
 namespace BOOM {
 
@@ -26,6 +27,12 @@ namespace BOOM {
     return eta + qlogis(runif_mt(
         rng, plogis(lower_cutpoint - eta), plogis(upper_cutpoint - eta)));
   }
+
+  void OrdinalLogitImputer::impute(
+      RNG &rng, const ConstVectorView &eta, double lower_cutpoint,
+      double upper_cutpoint, VectorView ans) {
+    rtrun_logit_2_mt(rng, ans, eta, lower_cutpoint, upper_cutpoint);
+  }
   
 }
 
@@ -18,6 +18,7 @@
   Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
 */
 
+#include "LinAlg/VectorView.hpp"
 #include "distributions/rng.hpp"
 
 namespace BOOM {
@@ -28,6 +29,13 @@ namespace BOOM {
     // between lower_cutpoint and upper_cutpoint.
     static double impute(RNG &rng, double eta, double lower_cutpoint,
                          double upper_cutpoint);
+
+    // Impute a vector of latent variables, where Z[i] ~ logistic(eta[i])
+    // conditional on Z[i] between lower_cutpoint and upper_cutpoint.  The
+    // draws are written to 'ans', which must be the same size as 'eta'.
+    static void impute(RNG &rng, const ConstVectorView &eta,
+                       double lower_cutpoint, double upper_cutpoint,
+                       VectorView ans);
   };
   
 }  // namespace BOOM
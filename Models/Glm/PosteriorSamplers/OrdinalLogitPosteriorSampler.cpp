@@ -19,10 +19,37 @@
 #include "Models/Glm/PosteriorSamplers/OrdinalLogitPosteriorSampler.hpp"
 #include "distributions.hpp"
 
+#include <algorithm>
 #include <cmath>
 
 namespace BOOM {
 
+  namespace {
+    typedef OrdinalLogitPosteriorSampler OLPS;
+
+    // The maximum number of observations in a CategoryBlock.
+    const int ordinal_block_size = 256;
+
+    // The maximum number of shards used for imputation.  Each shard has its
+    // own complete data sufficient statistics.
+    const int max_number_of_shards = 32;
+
+    // The truncation bounds on the latent variable for an observation with
+    // response y, given the free cutpoints.  The first cutpoint is fixed at
+    // zero.
+    double lower_bound(int y, const Vector &cutpoints) {
+      if (y <= 0) return negative_infinity();
+      if (y == 1) return 0;
+      return cutpoints[y - 2];
+    }
+
+    double upper_bound(int y, const Vector &cutpoints) {
+      if (y == 0) return 0;
+      if (y <= cutpoints.size()) return cutpoints[y - 1];
+      return infinity();
+    }
+  }  // namespace
+
   OrdinalLogitPosteriorSampler::OrdinalLogitPosteriorSampler(
       OrdinalLogitModel *model,
       const Ptr<MvnBase> &coefficient_prior,
@@ -33,57 +60,164 @@ namespace BOOM {
         coefficient_prior_(coefficient_prior),
         cutpoint_prior_(cutpoint_prior),
         complete_data_suf_(coefficient_prior_->dim()),
-        coefficient_sampler_(model_, coefficient_prior_, nullptr)
+        coefficient_sampler_(model_, coefficient_prior_, nullptr),
+        number_of_observations_blocked_(-1)
   {
     for (int i = 0; i < model_->cutpoint_vector().size(); ++i) {
-      auto cutpoint_i_logpost = [model, cutpoint_prior, i](double x) {
-        Vector cutpoints = model->cutpoint_vector();
-        cutpoints[i] = x;
-        double log_prior = cutpoint_prior->logp(cutpoints);
-        if (!std::isfinite(log_prior)) {
-          return log_prior;
-        }
-        Vector bg, dg;
-        Matrix bH, dH, cH;
-        return log_prior + model->full_loglike(
-            model->Beta(), cutpoints, bg, dg, bH, dH, cH, 0, false, false);
+      auto cutpoint_i_logpost = [this, i](double x) {
+        return this->cutpoint_log_posterior(i, x);
       };
       cutpoint_samplers_.push_back(ScalarSliceSampler(
           cutpoint_i_logpost, false, 1.0, &rng()));
     }
   }
 
-  double OrdinalLogitPosteriorSampler::logpri() const {
+  double OLPS::logpri() const {
     return coefficient_prior_->logp(model_->Beta())
         + cutpoint_prior_->logp(model_->cutpoint_vector());
   }
 
-  void OrdinalLogitPosteriorSampler::draw() {
+  void OLPS::draw() {
     impute_latent_data();
     draw_beta();
     draw_cutpoints();
   }
 
-  void OrdinalLogitPosteriorSampler::impute_latent_data() {
+  void OLPS::ensure_category_blocks() {
+    const std::vector<Ptr<OrdinalRegressionData>> &data(model_->dat());
+    if (number_of_observations_blocked_ == data.size()) return;
+    int nlevels = model_->nlevels();
+    std::vector<std::vector<int>> members(nlevels);
+    for (int i = 0; i < data.size(); ++i) {
+      members[data[i]->y()].push_back(i);
+    }
+    blocks_.clear();
+    first_block_.assign(nlevels + 1, 0);
+    for (int k = 0; k < nlevels; ++k) {
+      first_block_[k] = blocks_.size();
+      for (int start = 0; start < members[k].size();
+           start += ordinal_block_size) {
+        int nobs = std::min<int>(ordinal_block_size,
+                                 members[k].size() - start);
+        CategoryBlock block;
+        block.category = k;
+        block.predictors.resize(nobs, model_->xdim());
+        for (int j = 0; j < nobs; ++j) {
+          block.predictors.row(j) = data[members[k][start + j]]->x();
+        }
+        blocks_.push_back(std::move(block));
+      }
+    }
+    first_block_[nlevels] = blocks_.size();
+    number_of_observations_blocked_ = data.size();
+    linear_predictor_coefficients_.clear();
+  }
+
+  void OLPS::ensure_linear_predictors() {
+    const Vector &beta(model_->Beta());
+    if (linear_predictor_coefficients_ == beta) return;
+    auto compute_linear_predictors = [this, &beta](int b) {
+      blocks_[b].linear_predictors = blocks_[b].predictors * beta;
+    };
+    if (pool_.no_threads()) {
+      for (int b = 0; b < blocks_.size(); ++b) {
+        compute_linear_predictors(b);
+      }
+    } else {
+      pool_.parallel_for(0, blocks_.size(), 1, compute_linear_predictors);
+    }
+    linear_predictor_coefficients_ = beta;
+  }
+
+  void OLPS::impute_latent_data() {
+    ensure_category_blocks();
+    ensure_linear_predictors();
     complete_data_suf_.clear();
-    for (int i = 0; i < model_->dat().size(); ++i) {
-      const OrdinalRegressionData &data_point(*model_->dat()[i]);
-      double eta = model_->predict(data_point.x());
-      int y = data_point.y();
-      double upper_cutpoint = model_->upper_cutpoint(y);
-      double lower_cutpoint = model_->lower_cutpoint(y);
-      double z = imputer_.impute(rng(), eta, lower_cutpoint, upper_cutpoint);
-      double mu, sigsq;
-      logit_mixture_.unmix(rng(), z, &mu, &sigsq);
-      complete_data_suf_.add_data(data_point.x(), z, 1.0 / sigsq);
+    int number_of_blocks = blocks_.size();
+    if (number_of_blocks == 0) return;
+    int blocks_per_shard = (number_of_blocks + max_number_of_shards - 1)
+        / max_number_of_shards;
+    int number_of_shards = (number_of_blocks + blocks_per_shard - 1)
+        / blocks_per_shard;
+    if (shard_suf_.size() != number_of_shards) {
+      shard_suf_.assign(number_of_shards,
+                        WeightedRegSuf(coefficient_prior_->dim()));
+    }
+
+    RNG::RngIntType seed = seed_rng(rng());
+    auto impute_shard = [&](int shard) {
+      RNG shard_rng(seed, shard);
+      int first_block = shard * blocks_per_shard;
+      int end_block = std::min<int>(first_block + blocks_per_shard,
+                                    number_of_blocks);
+      shard_suf_[shard].clear();
+      impute_latent_data(first_block, end_block, shard_suf_[shard],
+                         shard_rng);
+    };
+    if (pool_.no_threads()) {
+      for (int shard = 0; shard < number_of_shards; ++shard) {
+        impute_shard(shard);
+      }
+    } else {
+      pool_.parallel_for(0, number_of_shards, 1, impute_shard);
+    }
+    for (const auto &suf : shard_suf_) {
+      complete_data_suf_.combine(suf);
+    }
+  }
+
+  void OLPS::impute_latent_data(int first_block, int end_block,
+                                WeightedRegSuf &suf, RNG &rng) {
+    Vector latent;
+    Vector weights;
+    for (int b = first_block; b < end_block; ++b) {
+      const CategoryBlock &block(blocks_[b]);
+      const Vector &eta(block.linear_predictors);
+      latent.resize(eta.size());
+      weights.resize(eta.size());
+      imputer_.impute(rng, eta, model_->lower_cutpoint(block.category),
+                      model_->upper_cutpoint(block.category),
+                      VectorView(latent));
+      for (int i = 0; i < eta.size(); ++i) {
+        // The mixture component is drawn given the logistic error term.
+        double mu, sigsq;
+        logit_mixture_.unmix(rng, latent[i] - eta[i], &mu, &sigsq);
+        latent[i] -= mu;
+        weights[i] = 1.0 / sigsq;
+      }
+      suf.add_data(block.predictors, latent, weights);
     }
   }
 
-  void OrdinalLogitPosteriorSampler::draw_beta() {
+  void OLPS::draw_beta() {
     coefficient_sampler_.draw_beta(rng(), complete_data_suf_);
   }
 
-  void OrdinalLogitPosteriorSampler::draw_cutpoints() {
+  double OLPS::cutpoint_log_posterior(int index, double value) const {
+    Vector cutpoints = model_->cutpoint_vector();
+    cutpoints[index] = value;
+    double ans = cutpoint_prior_->logp(cutpoints);
+    if (!std::isfinite(ans)) {
+      return ans;
+    }
+    // Cutpoint 'index' is the upper bound for category index + 1, and the
+    // lower bound for category index + 2.  The likelihood contributions
+    // from other categories do not depend on it.
+    for (int k = index + 1; k <= index + 2; ++k) {
+      double lower = lower_bound(k, cutpoints);
+      double upper = upper_bound(k, cutpoints);
+      for (int b = first_block_[k]; b < first_block_[k + 1]; ++b) {
+        for (double eta : blocks_[b].linear_predictors) {
+          ans += log(plogis(upper - eta) - plogis(lower - eta));
+        }
+      }
+    }
+    return ans;
+  }
+
+  void OLPS::draw_cutpoints() {
+    ensure_category_blocks();
+    ensure_linear_predictors();
     for (int i = 0; i < model_->cutpoint_vector().size(); ++i) {
       if (i > 0) {
         cutpoint_samplers_[i].set_lower_limit(model_->cutpoint_vector()[i - 1]);
@@ -105,4 +239,3 @@ namespace BOOM {
   }
   
 } // namespace BOOM
-
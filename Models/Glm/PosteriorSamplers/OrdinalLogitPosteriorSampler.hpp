@@ -32,6 +32,7 @@
 
 #include "Samplers/UnivariateSliceSampler.hpp"
 
+#include "cpputil/ThreadTools.hpp"
 #include "distributions/rng.hpp"
 
 namespace BOOM {
@@ -54,11 +55,44 @@ namespace BOOM {
     void draw() override;
     double logpri() const override;
 
+    // Use 'n' threads to impute the latent data.  The draws do not depend on
+    // the number of threads.
+    void set_number_of_threads(int n) { pool_.set_number_of_threads(n); }
+
    private:
+    // The data are held in blocks of observations sharing the same value of
+    // y, sorted by y, so that the latent data in a block share truncation
+    // bounds, and the log likelihood for a cutpoint only visits the blocks
+    // for the two categories it bounds.
+    struct CategoryBlock {
+      int category;
+      // One row per observation.
+      Matrix predictors;
+      // The linear predictors for the rows of 'predictors' under the
+      // coefficients in linear_predictor_coefficients_.
+      Vector linear_predictors;
+    };
+
+    // Rebuild blocks_ if the model's data have changed size.
+    void ensure_category_blocks();
+
+    // Recompute the linear predictors in blocks_ if the model coefficients
+    // have changed since they were last computed.
+    void ensure_linear_predictors();
+
     void impute_latent_data();
+
+    // Impute the latent data for blocks_[first_block, end_block), adding
+    // the complete data to 'suf'.
+    void impute_latent_data(int first_block, int end_block,
+                            WeightedRegSuf &suf, RNG &rng);
     void draw_beta();
     void draw_cutpoints();
 
+    // The log posterior of the cutpoints, as a function of cutpoint
+    // 'index' with the other cutpoints held fixed, up to a constant.
+    double cutpoint_log_posterior(int index, double value) const;
+
     OrdinalLogitModel *model_;
     Ptr<MvnBase> coefficient_prior_;
     Ptr<VectorModel> cutpoint_prior_;
@@ -72,6 +106,18 @@ namespace BOOM {
     // Separate cutpoint samplers are maintained so that the upper and lower
     // limits for each can be manipulated.
     std::vector<ScalarSliceSampler> cutpoint_samplers_;
+
+    std::vector<CategoryBlock> blocks_;
+    // The blocks for category k are blocks_[first_block_[k]] through
+    // blocks_[first_block_[k + 1] - 1].
+    std::vector<int> first_block_;
+    int number_of_observations_blocked_;
+    Vector linear_predictor_coefficients_;
+
+    // Each shard of blocks accumulates its complete data in its own
+    // sufficient statistics, which are combined in shard order.
+    std::vector<WeightedRegSuf> shard_suf_;
+    SharedThreadPool pool_;
   };
   
 }  // namespace BOOM
@@ -97,6 +97,17 @@ namespace BOOM {
     }
   }
 
+  void PoissonDataImputer::prepare_mixture_table(
+      const std::vector<int> &responses) {
+    // The final interarrival time is always unmixed with a single event.
+    mixture_table_.approximate(1);
+    for (int response : responses) {
+      if (response > 0 && response < mixture_table_.largest_index()) {
+        mixture_table_.approximate(response);
+      }
+    }
+  }
+
   void PoissonDataImputer::saturate_mixture_table() {
     // Force the table to fill itself with interpolated values, so that it does
     // not change later, while being accessed from separate threads.
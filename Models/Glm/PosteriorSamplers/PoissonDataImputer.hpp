@@ -20,6 +20,7 @@
 #ifndef BOOM_POISSON_DATA_IMPUTER_HPP_
 #define BOOM_POISSON_DATA_IMPUTER_HPP_
 
+#include <vector>
 #include "Models/Glm/PosteriorSamplers/NormalMixtureApproximation.hpp"
 #include "distributions/rng.hpp"
 
@@ -77,6 +78,13 @@ namespace BOOM {
     // take a long time, however.
     static void saturate_mixture_table();
 
+    // Add table entries for each of the given event counts, so that
+    // imputing latent data for observations with these responses does not
+    // modify the table.  Once the table has been prepared for every response
+    // in a data set, imputation for that data set is thread-safe.  This is
+    // much cheaper than saturate_mixture_table().
+    static void prepare_mixture_table(const std::vector<int> &responses);
+
     // Save the values in the mixture table to a Vector that can be
     // used to restore the table later.
     static Vector serialize_mixture_table() {
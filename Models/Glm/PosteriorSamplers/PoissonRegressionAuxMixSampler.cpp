@@ -18,6 +18,7 @@
 */
 
 #include "Models/Glm/PosteriorSamplers/PoissonRegressionAuxMixSampler.hpp"
+#include <algorithm>
 #include "Models/Glm/PosteriorSamplers/poisson_mixture_approximation_table.hpp"
 #include "distributions.hpp"
 
@@ -26,6 +27,9 @@ namespace BOOM {
   namespace {
     typedef PoissonRegressionAuxMixSampler PRAMS;
     typedef LatentDataSampler<PoissonRegressionDataImputer> Parent;
+
+    // The number of observations whose latent data are imputed together.
+    const int imputation_block_size = 256;
   }  // namespace
 
   PoissonRegressionDataImputer::PoissonRegressionDataImputer(
@@ -80,6 +84,59 @@ namespace BOOM {
                                 external_weight);
   }
 
+  void PoissonRegressionDataImputer::impute_latent_data_range(
+      Iterator begin, Iterator end, WeightedRegSuf *complete_data_suf,
+      RNG &rng) {
+    int xdim = coefficients_->nvars_possible();
+    while (begin != end) {
+      int nobs = std::min<int>(imputation_block_size, end - begin);
+      Matrix X(nobs, xdim);
+      int number_of_latent_observations = nobs;
+      for (int i = 0; i < nobs; ++i) {
+        X.row(i) = begin[i]->x();
+        if (begin[i]->y() > 0) {
+          ++number_of_latent_observations;
+        }
+      }
+      Vector eta(nobs);
+      coefficients_->predict(X, eta);
+
+      // Each observation contributes a latent observation for its final
+      // interarrival time, and one for its final internal event time if
+      // y > 0.  Both share the observation's predictors.
+      Matrix latent_X(number_of_latent_observations, xdim);
+      Vector latent_y(number_of_latent_observations);
+      Vector latent_weight(number_of_latent_observations);
+      int row = 0;
+      for (int i = 0; i < nobs; ++i) {
+        const PoissonRegressionData &dp(*begin[i]);
+        int y = dp.y();
+        double internal_neglog_final_event_time;
+        double internal_mu;
+        double internal_weight;
+        double neglog_final_interarrival_time;
+        double external_mu;
+        double external_weight;
+        imputer_->impute(rng, y, dp.exposure(), eta[i],
+                         &internal_neglog_final_event_time, &internal_mu,
+                         &internal_weight, &neglog_final_interarrival_time,
+                         &external_mu, &external_weight);
+        if (y > 0) {
+          latent_X.row(row) = X.row(i);
+          latent_y[row] = internal_neglog_final_event_time - internal_mu;
+          latent_weight[row] = internal_weight;
+          ++row;
+        }
+        latent_X.row(row) = X.row(i);
+        latent_y[row] = neglog_final_interarrival_time - external_mu;
+        latent_weight[row] = external_weight;
+        ++row;
+      }
+      complete_data_suf->add_data(latent_X, latent_y, latent_weight);
+      begin += nobs;
+    }
+  }
+
   //======================================================================
 
   PRAMS::PoissonRegressionAuxMixSampler(PoissonRegressionModel *model,
@@ -111,13 +168,20 @@ namespace BOOM {
   }
 
   void PRAMS::impute_latent_data() {
-    Parent::impute_latent_data();
     if (first_pass_through_data_) {
+      const std::vector<Ptr<PoissonRegressionData>> &data(model_->dat());
+      std::vector<int> responses;
+      responses.reserve(data.size());
+      for (const auto &data_point : data) {
+        responses.push_back(data_point->y());
+      }
+      PoissonDataImputer::prepare_mixture_table(responses);
       first_pass_through_data_ = false;
       if (desired_number_of_workers_ > 1) {
         set_number_of_workers(desired_number_of_workers_);
       }
     }
+    Parent::impute_latent_data();
   }
 
   void PRAMS::draw_beta_given_complete_data() {
@@ -158,7 +222,7 @@ namespace BOOM {
   }
 
   void PRAMS::assign_data_to_workers() {
-    BOOM::assign_data_to_workers(model_->dat(), workers());
+    distribute_data(model_->dat());
   }
 
 }  // namespace BOOM
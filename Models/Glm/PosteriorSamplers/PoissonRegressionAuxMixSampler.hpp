@@ -52,6 +52,15 @@ namespace BOOM {
                                   WeightedRegSuf *complete_data_suf,
                                   RNG &rng) override;
 
+    // Impute the latent data in blocks.  The linear predictors for each
+    // block come from a single matrix-vector product, and the latent
+    // observations for the block are added to the complete data sufficient
+    // statistics with a single rank-k update.  The random draws are the
+    // same as those made by impute_latent_data_point().
+    void impute_latent_data_range(Iterator begin, Iterator end,
+                                  WeightedRegSuf *complete_data_suf,
+                                  RNG &rng) override;
+
    private:
     const GlmCoefs *coefficients_;
     std::unique_ptr<PoissonDataImputer> imputer_;
@@ -76,12 +85,12 @@ namespace BOOM {
     Ptr<PoissonRegressionDataImputer> create_worker(std::mutex &m) override;
     void assign_data_to_workers() override;
 
-    // The first trip through the data is single threaded, so that the
-    // PoissonDataImputer object can be filled with required values
-    // without causing a race condition.  Subsequent trips can use
-    // multiple threads.  The overrides to set_number_of_workers() and
-    // impute_latent_data_point() ensure that multi-threading is
-    // delayed until after the first iteration.
+    // Before the first trip through the data the PoissonDataImputer's
+    // mixture table is filled (in a single thread) with the entries needed
+    // for the observed responses, so the table is not modified by the
+    // workers.  The overrides to set_number_of_workers() and
+    // impute_latent_data() ensure that multi-threading is delayed until
+    // the table has been prepared.
     void set_number_of_workers(int n) override;
     void impute_latent_data() override;
 
@@ -112,10 +121,9 @@ namespace BOOM {
     Ptr<MvnBase> prior_;
     WeightedRegSuf complete_data_suf_;
 
-    // The Poisson data imputer needs single threaded access during
-    // the first MCMC iteration.  After that it is safe to access in a
-    // multi-threaded environment.  This flag keeps track of whether
-    // impute_data() has previously been called.
+    // The Poisson data imputer's mixture table must be prepared before it
+    // can be accessed in a multi-threaded environment.  This flag keeps
+    // track of whether impute_latent_data() has previously been called.
     bool first_pass_through_data_;
 
     // Once the first pass through the data is complete then the
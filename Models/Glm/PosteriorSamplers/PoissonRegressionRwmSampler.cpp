@@ -27,7 +27,11 @@ namespace BOOM {
   PoissonRegressionRwmSampler::PoissonRegressionRwmSampler(
       PoissonRegressionModel *model, const Ptr<MvnBase> &prior,
       RNG &seeding_rng)
-      : PosteriorSampler(seeding_rng), model_(model), prior_(prior) {
+      : PosteriorSampler(seeding_rng),
+        model_(model),
+        prior_(prior),
+        adaptive_(false),
+        adaptation_warmup_(100) {
     if (model_->xdim() != prior_->dim()) {
       report_error(
           "Prior and model are incompatible in "
@@ -36,20 +40,18 @@ namespace BOOM {
   }
 
   void PoissonRegressionRwmSampler::draw() {
-    const std::vector<Ptr<PoissonRegressionData> > &data(model_->dat());
-    int nobs = data.size();
-    SpdMatrix proposal_information = prior_->siginv();
-
-    for (int i = 0; i < nobs; ++i) {
-      const PoissonRegressionData &d(*data[i]);
-      double eta = model_->predict(d.x());
-      proposal_information.add_outer(d.x(), d.exposure() * exp(eta), false);
-    }
-
-    proposal_information.reflect();
     const Vector &beta = model_->Beta();
-
-    Vector candidate = rmvt_ivar_mt(rng(), beta, proposal_information, 2);
+    Vector candidate;
+    if (adaptive_) {
+      if (!adaptive_proposal_) {
+        adaptive_proposal_.reset(
+            new MvtRwmProposal(proposal_information(), 2));
+        adaptive_proposal_->enable_adaptation(adaptation_warmup_);
+      }
+      candidate = adaptive_proposal_->draw(beta, &rng());
+    } else {
+      candidate = rmvt_ivar_mt(rng(), beta, proposal_information(), 2);
+    }
     double logp_cand =
         prior_->logp(candidate) + model_->log_likelihood(candidate);
     double logp_original = prior_->logp(beta) + model_->log_likelihood(beta);
@@ -57,6 +59,28 @@ namespace BOOM {
     if (log(runif_mt(rng())) < logp_cand - logp_original) {
       model_->set_Beta(candidate);
     }
+    if (adaptive_) {
+      adaptive_proposal_->observe(model_->Beta());
+    }
+  }
+
+  void PoissonRegressionRwmSampler::enable_adaptive_proposal(int warmup) {
+    adaptive_ = true;
+    adaptation_warmup_ = warmup;
+    adaptive_proposal_.reset();
+  }
+
+  SpdMatrix PoissonRegressionRwmSampler::proposal_information() const {
+    const std::vector<Ptr<PoissonRegressionData> > &data(model_->dat());
+    int nobs = data.size();
+    SpdMatrix ans = prior_->siginv();
+    for (int i = 0; i < nobs; ++i) {
+      const PoissonRegressionData &d(*data[i]);
+      double eta = model_->predict(d.x());
+      ans.add_outer(d.x(), d.exposure() * exp(eta), false);
+    }
+    ans.reflect();
+    return ans;
   }
 
   double PoissonRegressionRwmSampler::logpri() const {
@@ -23,6 +23,7 @@
 #include "Models/Glm/PoissonRegressionModel.hpp"
 #include "Models/MvnBase.hpp"
 #include "Models/PosteriorSamplers/PosteriorSampler.hpp"
+#include "Samplers/MH_Proposals.hpp"
 
 namespace BOOM {
 
@@ -36,9 +37,23 @@ namespace BOOM {
     void draw() override;
     double logpri() const override;
 
+    // Adapt the proposal variance to the posterior as the chain runs (see
+    // MvtRwmProposal).  The fixed component of the proposal is the posterior
+    // information at the first draw after this call.  It is not recomputed
+    // on later draws, which saves a pass through the data on each iteration.
+    void enable_adaptive_proposal(int warmup = 100);
+
    private:
+    // The prior information plus the Fisher information at the current
+    // coefficients.
+    SpdMatrix proposal_information() const;
+
     PoissonRegressionModel *model_;
     Ptr<MvnBase> prior_;
+
+    bool adaptive_;
+    int adaptation_warmup_;
+    Ptr<MvtRwmProposal> adaptive_proposal_;
   };
 
 }  // namespace BOOM
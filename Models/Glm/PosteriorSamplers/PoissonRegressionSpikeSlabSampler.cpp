@@ -90,12 +90,18 @@ namespace BOOM {
       // this case would just be the likelihood portion.
     }
 
-    Vector gradient(dim);
-    SpdMatrix hessian(dim);
     std::string error_message;
-    bool ok = max_nd2_careful(beta, gradient, hessian, log_posterior_at_mode_,
-                              Target(logpost), dTarget(logpost),
-                              d2Target(logpost), 1e-5, error_message);
+    bool ok;
+    if (dim > kLimitedMemoryDimension) {
+      ok = max_nd1_careful(beta, log_posterior_at_mode_, Target(logpost),
+                           dTarget(logpost), error_message, 1e-5, 500, LBFGS);
+    } else {
+      Vector gradient(dim);
+      SpdMatrix hessian(dim);
+      ok = max_nd2_careful(beta, gradient, hessian, log_posterior_at_mode_,
+                           Target(logpost), dTarget(logpost),
+                           d2Target(logpost), 1e-5, error_message);
+    }
     if (ok) {
       model_->set_included_coefficients(beta);
       return;
@@ -0,0 +1,199 @@
+#ifndef BOOM_GLM_PROBIT_IMPUTE_WORKER_HPP_
+#define BOOM_GLM_PROBIT_IMPUTE_WORKER_HPP_
+/*
+  Copyright (C) 2005-2024 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include <algorithm>
+#include <vector>
+
+#include "LinAlg/Matrix.hpp"
+#include "LinAlg/Vector.hpp"
+#include "Models/Glm/BinomialRegressionData.hpp"
+#include "Models/Glm/Glm.hpp"
+#include "Models/Glm/GlmCoefs.hpp"
+#include "Models/Glm/PosteriorSamplers/BinomialProbitDataImputer.hpp"
+#include "Models/PosteriorSamplers/Imputer.hpp"
+#include "cpputil/RefCounted.hpp"
+#include "distributions.hpp"
+
+namespace BOOM {
+  namespace Probit {
+
+    // The part of the complete data sufficient statistics for probit data
+    // augmentation that depends on the latent data: X'z, where z[i] is the
+    // sum of the latent Gaussian variables for observation i.  The other
+    // part, X'X, does not change between iterations, so samplers keep it
+    // separately.
+    //
+    // This class was designed to work with the SufstatImputeWorker class
+    // defined in Imputer.hpp.
+    class LatentDataSufficientStatistics : private RefCounted {
+     public:
+      explicit LatentDataSufficientStatistics(int dim) : xtz_(dim, 0.0) {}
+
+      LatentDataSufficientStatistics *clone() const {
+        return new LatentDataSufficientStatistics(*this);
+      }
+      void clear() { xtz_ = 0.0; }
+      void combine(const LatentDataSufficientStatistics &rhs) {
+        xtz_ += rhs.xtz_;
+      }
+      void update(const Vector &x, double sum_of_z) { xtz_.axpy(x, sum_of_z); }
+
+      // Add X'z for a block of observations, where the rows of X are the
+      // predictors and z contains the sums of their latent variables.
+      void update(const Matrix &X, const Vector &sum_of_z) {
+        xtz_ += X.Tmult(sum_of_z);
+      }
+
+      const Vector &xtz() const { return xtz_; }
+
+      // Resize, and clear.
+      void resize(int dim) { xtz_.assign(dim, 0.0); }
+
+     private:
+      Vector xtz_;
+
+      friend void intrusive_ptr_add_ref(LatentDataSufficientStatistics *s) {
+        s->up_count();
+      }
+      friend void intrusive_ptr_release(LatentDataSufficientStatistics *s) {
+        s->down_count();
+        if (s->ref_count() == 0) delete s;
+      }
+    };
+
+    // The number of trials and successes in an observation.
+    inline double number_of_trials(const BinomialRegressionData &data) {
+      return data.n();
+    }
+    inline double number_of_trials(const BinaryRegressionData &) {
+      return 1.0;
+    }
+    inline double number_of_successes(const BinomialRegressionData &data) {
+      return data.y();
+    }
+    inline double number_of_successes(const BinaryRegressionData &data) {
+      return data.y();
+    }
+
+    // A worker that imputes the latent Gaussian variables for a chunk of the
+    // data in a probit model.
+    //
+    // Template Types:
+    //   DATA: Either BinaryRegressionData (for ProbitRegressionModel) or
+    //     BinomialRegressionData (for BinomialProbitModel).
+    template <class DATA>
+    class ImputeWorker
+        : public SufstatImputeWorker<DATA, LatentDataSufficientStatistics> {
+     public:
+      // Args:
+      //   global_suf: The sufficient statistics held by the primary sampler.
+      //   global_suf_mutex:  A reference to a mutex protecting global_suf.
+      //   clt_threshold: Observations with at least this many trials have
+      //     the sum of their latent variables drawn from a normal
+      //     approximation.  See BinomialProbitDataImputer.
+      //   coef: The coefficients of the model being sampled.
+      //   rng:  A random number generator or nullptr.
+      //   seeding_rng: A RNG used to initialize a new RNG in the case that
+      //     rng==nullptr.
+      ImputeWorker(LatentDataSufficientStatistics &global_suf,
+                   std::mutex &global_suf_mutex, int clt_threshold,
+                   const GlmCoefs *coef, RNG *rng = nullptr,
+                   RNG &seeding_rng = GlobalRng::rng)
+          : SufstatImputeWorker<DATA, LatentDataSufficientStatistics>(
+                global_suf, global_suf_mutex, rng, seeding_rng),
+            imputer_(clt_threshold),
+            coefficients_(coef) {}
+
+      void impute_latent_data_point(const DATA &data,
+                                    LatentDataSufficientStatistics *suf,
+                                    RNG &rng) override {
+        const Vector &x(data.x());
+        double sum_of_z = imputer_.impute(rng, number_of_trials(data),
+                                          number_of_successes(data),
+                                          coefficients_->predict(x));
+        suf->update(x, sum_of_z);
+      }
+
+      typedef typename SufstatImputeWorker<
+        DATA, LatentDataSufficientStatistics>::Iterator Iterator;
+
+      // Impute the latent data in blocks.  The linear predictors for each
+      // block come from a single matrix-vector product, the latent variables
+      // for all the single-trial observations in the block are drawn with one
+      // call to the batch truncated normal sampler, and X'z for the block is
+      // accumulated with a single transposed matrix-vector product.
+      // Observations with more than one trial are handled by the
+      // BinomialProbitDataImputer, as in impute_latent_data_point().
+      void impute_latent_data_range(Iterator begin, Iterator end,
+                                    LatentDataSufficientStatistics *suf,
+                                    RNG &rng) override {
+        const int block_size = 256;
+        int xdim = coefficients_->nvars_possible();
+        while (begin != end) {
+          int nobs = std::min<int>(block_size, end - begin);
+          Matrix X(nobs, xdim);
+          for (int i = 0; i < nobs; ++i) {
+            X.row(i) = begin[i]->x();
+          }
+          Vector eta(nobs);
+          coefficients_->predict(X, eta);
+
+          Vector sum_of_z(nobs);
+          std::vector<int> single_trial;
+          for (int i = 0; i < nobs; ++i) {
+            const DATA &data_point(*begin[i]);
+            if (number_of_trials(data_point) == 1.0) {
+              single_trial.push_back(i);
+            } else {
+              sum_of_z[i] = imputer_.impute(rng, number_of_trials(data_point),
+                                            number_of_successes(data_point),
+                                            eta[i]);
+            }
+          }
+
+          int nsingle = single_trial.size();
+          if (nsingle > 0) {
+            Vector mean(nsingle);
+            std::vector<bool> success(nsingle);
+            for (int j = 0; j < nsingle; ++j) {
+              int i = single_trial[j];
+              mean[j] = eta[i];
+              success[j] = number_of_successes(*begin[i]) > 0;
+            }
+            Vector z(nsingle);
+            rtrun_norm_mt(rng, z, mean, 1.0, Vector(nsingle, 0.0), success);
+            for (int j = 0; j < nsingle; ++j) {
+              sum_of_z[single_trial[j]] = z[j];
+            }
+          }
+          suf->update(X, sum_of_z);
+          begin += nobs;
+        }
+      }
+
+     private:
+      BinomialProbitDataImputer imputer_;
+      const GlmCoefs *coefficients_;
+    };
+
+  }  // namespace Probit
+}  // namespace BOOM
+
+#endif  // BOOM_GLM_PROBIT_IMPUTE_WORKER_HPP_
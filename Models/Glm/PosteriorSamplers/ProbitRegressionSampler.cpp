@@ -33,6 +33,7 @@ namespace BOOM {
         xtx_(model_->xdim()),
         xtz_(model_->xdim()) {
     refresh_xtx();
+    set_number_of_workers(1);
   }
 
   double PRS::logpri() const { return prior_->logp(model_->Beta()); }
@@ -44,22 +45,45 @@ namespace BOOM {
 
   void PRS::draw_beta() {
     model_->set_Beta(rmvn_suf_mt(rng(), xtx_ + prior_->siginv(),
-                                 xtz_ + prior_->siginv() * prior_->mu()));
+                                 xtz() + prior_->siginv() * prior_->mu()));
   }
 
   void PRS::impute_latent_data() {
-    const ProbitRegressionModel::DatasetType &data(model_->dat());
-    int n = data.size();
-    const Vector &beta(model_->Beta());
-    xtz_ = 0;
-    for (int i = 0; i < n; ++i) {
-      const Vector &x(data[i]->x());
-      double z = imputer_.impute(rng(), 1, data[i]->y(), x.dot(beta));
-      xtz_.axpy(x, z);
+    if (number_of_observations_managed() != model_->dat().size()) {
+      // The model has gained or lost data since it was assigned to the
+      // workers.
+      assign_data_to_workers();
+    }
+    LatentDataSampler<Probit::ImputeWorker<BinaryRegressionData>>::
+        impute_latent_data();
+  }
+
+  Ptr<Probit::ImputeWorker<BinaryRegressionData>> PRS::create_worker(
+      std::mutex &m) {
+    return new Probit::ImputeWorker<BinaryRegressionData>(
+        xtz_, m, 10, model_->coef_prm().get(), nullptr, rng());
+  }
+
+  int PRS::number_of_observations_managed() {
+    int ans = 0;
+    for (const auto &worker : workers()) {
+      ans += worker->number_of_observations_managed();
+    }
+    return ans;
+  }
+
+  void PRS::assign_data_to_workers() {
+    distribute_data(model_->dat());
+  }
+
+  void PRS::clear_latent_data() {
+    if (xtz_.xtz().size() != model_->xdim()) {
+      xtz_.resize(model_->xdim());
     }
+    xtz_.clear();
   }
 
-  const Vector &PRS::xtz() const { return xtz_; }
+  const Vector &PRS::xtz() const { return xtz_.xtz(); }
   const SpdMatrix &PRS::xtx() const { return xtx_; }
 
   void PRS::refresh_xtx() {
@@ -20,13 +20,18 @@
 #ifndef BOOM_PROBIT_REGRESSION_SAMPLER_HPP_
 #define BOOM_PROBIT_REGRESSION_SAMPLER_HPP_
 
-#include "Models/Glm/PosteriorSamplers/BinomialProbitDataImputer.hpp"
+#include "Models/Glm/PosteriorSamplers/ProbitImputeWorker.hpp"
 #include "Models/Glm/ProbitRegression.hpp"
 #include "Models/MvnBase.hpp"
+#include "Models/PosteriorSamplers/Imputer.hpp"
 #include "Models/PosteriorSamplers/PosteriorSampler.hpp"
 
 namespace BOOM {
-  class ProbitRegressionSampler : public PosteriorSampler {
+  // The latent data can be imputed in parallel by calling
+  // set_number_of_workers().
+  class ProbitRegressionSampler
+      : public PosteriorSampler,
+        public LatentDataSampler<Probit::ImputeWorker<BinaryRegressionData>> {
    public:
     ProbitRegressionSampler(ProbitRegressionModel *model,
                             const Ptr<MvnBase> &prior,
@@ -38,7 +43,12 @@ namespace BOOM {
     // Otherwise, it is assumed that xtx_ is fixed between iterations
     void refresh_xtx();
 
-    void impute_latent_data();
+    void impute_latent_data() override;
+    Ptr<Probit::ImputeWorker<BinaryRegressionData>> create_worker(
+        std::mutex &m) override;
+    void assign_data_to_workers() override;
+    void clear_latent_data() override;
+
     const Vector &xtz() const;
     const SpdMatrix &xtx() const;
 
@@ -46,14 +56,16 @@ namespace BOOM {
     virtual void draw_beta();
 
    private:
+    // The number of observations assigned to the workers.
+    int number_of_observations_managed();
+
     ProbitRegressionModel *model_;
     Ptr<MvnBase> prior_;
 
-    BinomialProbitDataImputer imputer_;
-
-    // Complete data sufficient statistics.
+    // Complete data sufficient statistics.  Only xtz_ depends on the latent
+    // data.
     SpdMatrix xtx_;
-    Vector xtz_;
+    Probit::LatentDataSufficientStatistics xtz_;
   };
 }  // namespace BOOM
 
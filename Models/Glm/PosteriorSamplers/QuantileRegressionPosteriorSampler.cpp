@@ -18,6 +18,7 @@
 */
 
 #include "Models/Glm/PosteriorSamplers/QuantileRegressionPosteriorSampler.hpp"
+#include "LinAlg/SubMatrix.hpp"
 #include "distributions/inverse_gaussian.hpp"
 
 namespace BOOM {
@@ -25,6 +26,10 @@ namespace BOOM {
     typedef QuantileRegressionPosteriorSampler QRPS;
     typedef QuantileRegressionImputeWorker QRIW;
     typedef QuantileRegressionSpikeSlabSampler QRSSS;
+
+    // The number of observations in each block of the latent data
+    // imputation.
+    const int quantile_block_size = 256;
   }  // namespace
 
   void QRIW::impute_latent_data_point(const RegressionData &observed,
@@ -38,6 +43,58 @@ namespace BOOM {
     }
   }
 
+  void QRIW::impute_latent_data_range(Iterator begin, Iterator end,
+                                      WeightedRegSuf *suf, RNG &rng) {
+    const Vector &beta(coefficients_->Beta());
+    int xdim = beta.size();
+    Matrix predictors;
+    Vector response;
+    Vector inverse_scale_mean;
+    Vector inverse_scale;
+    while (begin != end) {
+      int nobs = std::min<std::ptrdiff_t>(end - begin, quantile_block_size);
+      predictors.resize(nobs, xdim);
+      response.resize(nobs);
+      for (int i = 0; i < nobs; ++i) {
+        predictors.row(i) = begin[i]->x();
+        response[i] = begin[i]->y();
+      }
+      Vector residual = response - predictors * beta;
+
+      // Observations with a zero residual carry no information about the
+      // latent scale, and are skipped.  They are moved out of the block so
+      // the remaining rows stay contiguous.
+      int nonzero = 0;
+      inverse_scale_mean.resize(nobs);
+      for (int i = 0; i < nobs; ++i) {
+        double abs_residual = fabs(residual[i]);
+        if (abs_residual > 0) {
+          if (nonzero < i) {
+            predictors.row(nonzero) = predictors.row(i);
+            response[nonzero] = response[i];
+          }
+          inverse_scale_mean[nonzero++] = 1.0 / abs_residual;
+        }
+      }
+      if (nonzero > 0) {
+        if (nonzero < nobs) {
+          predictors = SubMatrix(predictors, 0, nonzero - 1, 0, xdim - 1)
+                           .to_matrix();
+          response.resize(nonzero);
+          inverse_scale_mean.resize(nonzero);
+        }
+        inverse_scale.resize(nonzero);
+        rig_mt(rng, inverse_scale, inverse_scale_mean, 1.0);
+        for (int i = 0; i < nonzero; ++i) {
+          response[i] = adjusted_observation(response[i],
+                                             1.0 / inverse_scale[i]);
+        }
+        suf->add_data(predictors, response, inverse_scale);
+      }
+      begin += nobs;
+    }
+  }
+
   //======================================================================
   QRPS::QuantileRegressionPosteriorSampler(QuantileRegressionModel *model,
                                            const Ptr<MvnBase> &prior, RNG &rng)
@@ -70,7 +127,7 @@ namespace BOOM {
   void QRPS::clear_latent_data() { suf_.clear(); }
 
   void QRPS::assign_data_to_workers() {
-    BOOM::assign_data_to_workers(model_->dat(), workers());
+    distribute_data(model_->dat());
   }
 
   //======================================================================
@@ -79,6 +79,13 @@ namespace BOOM {
     void impute_latent_data_point(const RegressionData &data_point,
                                   WeightedRegSuf *suf, RNG &rng) override;
 
+    // Impute the latent scales for blocks of observations at once.  The
+    // residuals for a block come from a single matrix-vector product, the
+    // inverse scales are drawn with the bulk inverse Gaussian generator, and
+    // the block is added to 'suf' with a single rank-k update.
+    void impute_latent_data_range(Iterator begin, Iterator end,
+                                  WeightedRegSuf *suf, RNG &rng) override;
+
    private:
     const GlmCoefs *coefficients_;
     double quantile_complement_;
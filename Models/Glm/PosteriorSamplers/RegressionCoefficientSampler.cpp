@@ -33,11 +33,16 @@ namespace BOOM {
 
   void RegressionCoefficientSampler::sample_regression_coefficients(
       RNG &rng, RegressionModel *model, const MvnBase &prior) {
-    SpdMatrix prior_precision = prior.siginv();
+    sample_regression_coefficients(rng, model, prior.mu(), prior.siginv());
+  }
+
+  void RegressionCoefficientSampler::sample_regression_coefficients(
+      RNG &rng, RegressionModel *model, const Vector &prior_mean,
+      const SpdMatrix &prior_precision) {
     SpdMatrix posterior_precision =
         model->suf()->xtx() / model->sigsq() + prior_precision;
     Vector scaled_posterior_mean = model->suf()->xty() / model->sigsq();
-    scaled_posterior_mean += prior_precision * prior.mu();
+    scaled_posterior_mean += prior_precision * prior_mean;
 
     Cholesky cholesky(posterior_precision);
     Vector posterior_mean = cholesky.solve(scaled_posterior_mean);
@@ -45,6 +45,13 @@ namespace BOOM {
     static void sample_regression_coefficients(RNG &rng, RegressionModel *model,
                                                const MvnBase &prior);
 
+    // As above, but with the prior given by its mean and precision.  MvnBase
+    // may compute siginv() lazily, so callers drawing several models in
+    // parallel can extract the prior moments once and use this version.
+    static void sample_regression_coefficients(
+        RNG &rng, RegressionModel *model, const Vector &prior_mean,
+        const SpdMatrix &prior_precision);
+
     // Simulate the vector of regression coefficients from their posterior
     // distribution given the directly supplied sufficient statistics, the
     // residual variance, and the specified prior distribution.
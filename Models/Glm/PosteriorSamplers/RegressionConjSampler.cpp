@@ -18,6 +18,8 @@
 */
 
 #include "Models/Glm/PosteriorSamplers/RegressionConjSampler.hpp"
+#include "LinAlg/fused_operations.hpp"
+#include "cpputil/report_error.hpp"
 #include "distributions.hpp"
 
 namespace BOOM {
@@ -31,32 +33,52 @@ namespace BOOM {
         residual_precision_prior_(residual_precision_prior),
         sigsq_sampler_(residual_precision_prior_) {}
 
+  // With prior mean m and unscaled prior precision P, the posterior
+  // precision is L = P + X'X, the posterior mean is b = L^{-1}(X'y + P m),
+  // and the posterior sum of squares is y'y + m'Pm - b'Lb.  Everything is
+  // evaluated into storage that persists between calls.
   void RCS::set_posterior_suf() {
+    WorkspaceScope scope(workspace());
+    const RegSuf &suf(*model_->suf());
     const Vector &prior_mean(coefficient_prior_->mu());
-    SpdMatrix unscaled_prior_precision = coefficient_prior_->unscaled_precision();
-    posterior_precision_ = unscaled_prior_precision + model_->suf()->xtx();
-    posterior_mean_ = model_->suf()->xty() + unscaled_prior_precision * prior_mean;
-    posterior_mean_ = posterior_precision_.solve(posterior_mean_);
-    SS_ = model_->suf()->relative_sse(posterior_mean_)
-        + unscaled_prior_precision.Mdist(posterior_mean_, prior_mean);
-    DF_ = model_->suf()->n();
+    const SpdMatrix &unscaled_prior_precision(
+        coefficient_prior_->unscaled_precision());
+    suf.fill_xtx(posterior_precision_);
+    posterior_precision_ += unscaled_prior_precision;
+
+    Vector &prior_information(scope.workspace().vector(prior_mean.size()));
+    matrix_vector_product(prior_information, unscaled_prior_precision,
+                          prior_mean);
+    Vector &posterior_information(
+        scope.workspace().vector(prior_mean.size()));
+    suf.fill_xty(posterior_information);
+    posterior_information += prior_information;
+
+    posterior_cholesky_.decompose(posterior_precision_);
+    if (!posterior_cholesky_.is_pos_def()) {
+      report_error("Posterior precision matrix is not positive definite "
+                   "in RegressionConjSampler.");
+    }
+    posterior_mean_ = posterior_information;
+    posterior_cholesky_.solve_inplace(VectorView(posterior_mean_));
+    SS_ = suf.yty() + prior_mean.dot(prior_information)
+        - posterior_mean_.dot(posterior_information);
+    DF_ = suf.n();
   }
 
+  // Given sigsq, beta ~ N(b, sigsq * L^{-1}), so a draw is b + sigsq^{1/2}
+  // U^{-1} z, where U is the upper Cholesky triangle of L.  This reuses the
+  // factorization from set_posterior_suf instead of factoring L / sigsq.
   void RCS::draw() {
     set_posterior_suf();
     double sigsq = sigsq_sampler_.draw(rng(), DF_, SS_);
     model_->set_sigsq(sigsq);
-    posterior_precision_ /= sigsq;
-    Vector beta = rmvn_ivar_mt(
-        rng(), posterior_mean_, posterior_precision_);
-    // if (beta[0] < -10 || beta[0] > 10) {
-    //   std::cout << "Unusual draw of beta[0] in RegressionConjSampler...\n"
-    //             << "xtx = " << model_->suf()->xtx()
-    //             << "xty = " << model_->suf()->xty() << "\n"
-    //             << "posterior_mean = " << posterior_mean_ << "\n"
-    //             << "posterior_precision_ = " << posterior_precision_
-    //             << "sigsq = " << sigsq << "\n" ;
-    // }
+    WorkspaceScope scope(workspace());
+    Vector &beta(scope.workspace().vector(posterior_mean_.size()));
+    rnorm_mt(rng(), beta, 0, 1);
+    posterior_cholesky_.upper_solve_inplace(VectorView(beta));
+    beta *= sqrt(sigsq);
+    beta += posterior_mean_;
     model_->set_Beta(beta);
   }
 
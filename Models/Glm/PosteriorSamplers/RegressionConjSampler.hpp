@@ -20,6 +20,7 @@
 #ifndef BOOM_REGRESSION_CONJUGATE_SAMPLER_HPP
 #define BOOM_REGRESSION_CONJUGATE_SAMPLER_HPP
 
+#include "LinAlg/Cholesky.hpp"
 #include "Models/GammaModel.hpp"
 #include "Models/MvnGivenScalarSigma.hpp"
 #include "Models/Glm/RegressionModel.hpp"
@@ -57,6 +58,7 @@ namespace BOOM {
     Ptr<GammaModelBase> residual_precision_prior_;
     Vector posterior_mean_;
     SpdMatrix posterior_precision_;
+    Cholesky posterior_cholesky_;
     double SS_, DF_;
     GenericGaussianVarianceSampler sigsq_sampler_;
     void set_posterior_suf();
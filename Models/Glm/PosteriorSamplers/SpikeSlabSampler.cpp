@@ -18,6 +18,7 @@
 */
 
 #include "Models/Glm/PosteriorSamplers/SpikeSlabSampler.hpp"
+#include "LinAlg/fused_operations.hpp"
 #include "cpputil/math_utils.hpp"
 #include "cpputil/seq.hpp"
 #include "distributions.hpp"
@@ -75,9 +76,24 @@ namespace BOOM {
 
     uint n = inclusion_indicators.nvars_possible();
     if (max_flips_ > 0) n = std::min<int>(n, max_flips_);
+
+    // Each flip adds or removes one variable, so the Cholesky factors needed
+    // by log_model_prob can be updated rather than recomputed.
+    SpdMatrix posterior_precision = suf.xtx() / sigsq;
+    posterior_precision += slab_prior_->siginv();
+    Cholesky prior_factor(inclusion_indicators.select(slab_prior_->siginv()));
+    Cholesky posterior_factor(inclusion_indicators.select(posterior_precision));
+    if (!prior_factor.is_pos_def() || !posterior_factor.is_pos_def()) {
+      for (int i = 0; i < n; ++i) {
+        logp = mcmc_one_flip(
+            rng, inclusion_indicators, indx[i], logp, suf, sigsq);
+      }
+      return;
+    }
     for (int i = 0; i < n; ++i) {
-      logp = mcmc_one_flip(
-          rng, inclusion_indicators, indx[i], logp, suf, sigsq);
+      logp = mcmc_one_flip(rng, inclusion_indicators, indx[i], logp, suf,
+                           sigsq, posterior_precision, prior_factor,
+                           posterior_factor);
     }
   }
 
@@ -98,12 +114,13 @@ namespace BOOM {
     if (!model_) {
       report_error("No model was set.");
     }
-    Selector inclusion_indicators = model_->coef().inc();
+    const Selector &inclusion_indicators(model_->coef().inc());
     if (inclusion_indicators.nvars() == 0) {
       model_->drop_all();
       return;
     }
-    Vector coefficients = model_->included_coefficients();
+    WorkspaceScope scope(workspace_.arena());
+    Vector &coefficients(scope.workspace().vector(inclusion_indicators.nvars()));
     draw_coefficients_given_inclusion(rng, coefficients, inclusion_indicators,
                                       suf, sigsq, false);
     // If model selection is turned off and some elements of beta
@@ -123,15 +140,43 @@ namespace BOOM {
       }
       return;
     }
-    SpdMatrix precision = inclusion_indicators.select(slab_prior_->siginv());
-    Vector precision_mu =
-        precision * inclusion_indicators.select(slab_prior_->mu());
-    precision += inclusion_indicators.select(suf.xtx()) / sigsq;
-    precision_mu += inclusion_indicators.select(suf.xty()) / sigsq;
-    Vector mean = precision.solve(precision_mu);
-    Vector draw = rmvn_ivar_mt(rng, mean, precision);
+    // Every temporary comes from workspace_, so once the workspace has seen
+    // a model of this size the draw does not allocate.
+    WorkspaceScope scope(workspace_.arena());
+    WorkspaceArena &workspace(scope.workspace());
+    int dim = inclusion_indicators.nvars();
+    SpdMatrix &precision(workspace.spd(dim));
+    inclusion_indicators.select_into(slab_prior_->siginv(), precision);
+    Vector &prior_mean(workspace.vector(dim));
+    inclusion_indicators.select_into(slab_prior_->mu(), prior_mean);
+    Vector &precision_mu(workspace.vector(dim));
+    matrix_vector_product(precision_mu, precision, prior_mean);
+
+    SpdMatrix &xtx(workspace.spd(dim));
+    suf.fill_xtx(inclusion_indicators, xtx);
+    xtx /= sigsq;
+    precision += xtx;
+    Vector &xty(workspace.vector(dim));
+    suf.fill_xty(inclusion_indicators, xty);
+    precision_mu.axpy(xty, 1.0 / sigsq);
+
+    posterior_cholesky_.decompose(precision);
+    if (!posterior_cholesky_.is_pos_def()) {
+      report_error("Posterior precision matrix is not positive definite in "
+                   "SpikeSlabSampler.");
+    }
+    Vector &mean(workspace.vector(dim));
+    mean = precision_mu;
+    posterior_cholesky_.solve_inplace(VectorView(mean));
+    Vector &draw(workspace.vector(dim));
+    rmvn_precision_cholesky_mt(rng, mean, posterior_cholesky_,
+                               VectorView(draw));
     if (full_set) {
-      coefficients = inclusion_indicators.expand(draw);
+      coefficients.resize(inclusion_indicators.nvars_possible());
+      coefficients = 0.0;
+      for (int i = 0; i < dim; ++i) {
+        coefficients[inclusion_indicators.indx(i)] = draw[i];
+      }
     } else {
       coefficients = draw;
     }
@@ -202,6 +247,62 @@ namespace BOOM {
     return numerator - denominator;
   }
 
+  double SSS::log_model_prob(const Selector &inclusion_indicators,
+                             const Cholesky &prior_factor,
+                             const Cholesky &posterior_factor,
+                             const WeightedRegSuf &suf, double sigsq) const {
+    double numerator = spike_prior_->logp(inclusion_indicators);
+    if (numerator == BOOM::negative_infinity() ||
+        inclusion_indicators.nvars() == 0) {
+      return numerator;
+    }
+    numerator += .5 * prior_factor.logdet();
+    Vector mu = inclusion_indicators.select(slab_prior_->mu());
+    Vector precision_mu =
+        inclusion_indicators.select(slab_prior_->siginv()) * mu;
+    numerator -= .5 * mu.dot(precision_mu);
+
+    double denominator = .5 * posterior_factor.logdet();
+    Vector S = inclusion_indicators.select(suf.xty()) / sigsq + precision_mu;
+    Lsolve_inplace(posterior_factor.getL(false), S);
+    denominator -= .5 * S.normsq();
+    return numerator - denominator;
+  }
+
+  double SSS::mcmc_one_flip(RNG &rng, Selector &mod, int which_var,
+                            double logp_old, const WeightedRegSuf &suf,
+                            double sigsq, const SpdMatrix &posterior_precision,
+                            Cholesky &prior_factor,
+                            Cholesky &posterior_factor) const {
+    Cholesky original_prior_factor = prior_factor;
+    Cholesky original_posterior_factor = posterior_factor;
+    bool ok = true;
+    if (mod.inc(which_var)) {
+      int position = mod.INDX(which_var);
+      mod.flip(which_var);
+      prior_factor.drop_row_col(position);
+      posterior_factor.drop_row_col(position);
+    } else {
+      mod.flip(which_var);
+      int position = mod.INDX(which_var);
+      ok = prior_factor.add_row_col(
+               position, mod.select(slab_prior_->siginv().col(which_var))) &&
+           posterior_factor.add_row_col(
+               position, mod.select(posterior_precision.col(which_var)));
+    }
+    double logp_new =
+        ok ? log_model_prob(mod, prior_factor, posterior_factor, suf, sigsq)
+           : negative_infinity();
+    double u = runif_mt(rng, 0, 1);
+    if (log(u) > logp_new - logp_old) {
+      mod.flip(which_var);  // reject draw
+      prior_factor = original_prior_factor;
+      posterior_factor = original_posterior_factor;
+      return logp_old;
+    }
+    return logp_new;
+  }
+
   double SSS::mcmc_one_flip(RNG &rng, Selector &mod, int which_var,
                             double logp_old, const WeightedRegSuf &suf,
                             double sigsq) const {
@@ -20,6 +20,8 @@
 #ifndef BOOM_GLM_SPIKE_SLAB_SAMPLER_HPP_
 #define BOOM_GLM_SPIKE_SLAB_SAMPLER_HPP_
 
+#include "LinAlg/Cholesky.hpp"
+#include "LinAlg/Workspace.hpp"
 #include "Models/Glm/Glm.hpp"
 #include "Models/Glm/VariableSelectionPrior.hpp"
 #include "Models/Glm/WeightedRegressionModel.hpp"
@@ -161,11 +163,40 @@ namespace BOOM {
                          double logp_old, const WeightedRegSuf &suf,
                          double sigsq = 1.0) const;
 
+    // The versions of log_model_prob and mcmc_one_flip used during a sweep
+    // through the inclusion indicators.  Rather than refactoring the prior
+    // and posterior precision matrices for each candidate model, they keep
+    // live Cholesky factors of both (restricted to the variables included in
+    // g) that are updated in O(p^2) each time a variable is added or
+    // dropped.
+    //
+    // Args:
+    //   posterior_precision:  The full (unselected) posterior precision,
+    //     siginv + xtx / sigsq.
+    //   prior_factor:  The Cholesky factor of the included subset of the
+    //     prior precision.
+    //   posterior_factor:  The Cholesky factor of the included subset of
+    //     posterior_precision.
+    double log_model_prob(const Selector &g, const Cholesky &prior_factor,
+                          const Cholesky &posterior_factor,
+                          const WeightedRegSuf &suf, double sigsq) const;
+    double mcmc_one_flip(RNG &rng, Selector &g, int which_variable,
+                         double logp_old, const WeightedRegSuf &suf,
+                         double sigsq, const SpdMatrix &posterior_precision,
+                         Cholesky &prior_factor,
+                         Cholesky &posterior_factor) const;
+
     GlmModel *model_;
     Ptr<MvnBase> slab_prior_;
     Ptr<VariableSelectionPrior> spike_prior_;
     int max_flips_;
     bool allow_model_selection_;
+
+    // Scratch space for draw_beta, kept between draws so that steady state
+    // MCMC iterations do not allocate.  This class is not a PosteriorSampler,
+    // so it holds its own workspace rather than sharing the owning sampler's.
+    PersistentWorkspace workspace_;
+    mutable Cholesky posterior_cholesky_;
   };
 
 }  // namespace BOOM
@@ -0,0 +1,170 @@
+// Copyright 2018 Google LLC. All Rights Reserved.
+/*
+  Copyright (C) 2005-2018 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#include "Models/Glm/PosteriorSamplers/StochasticGradientGlmSampler.hpp"
+#include <cmath>
+#include "cpputil/report_error.hpp"
+#include "distributions.hpp"
+
+namespace BOOM {
+
+  namespace {
+    typedef StochasticGradientGlmSampler SGGS;
+  }  // namespace
+
+  SGGS::StochasticGradientGlmSampler(GlmModel *model,
+                                     const Ptr<dSubsampleTargetFun> &loglike,
+                                     const Ptr<MvnBase> &prior,
+                                     int minibatch_size, double step_size,
+                                     RNG &seeding_rng)
+      : PosteriorSampler(seeding_rng),
+        model_(model),
+        loglike_(loglike),
+        prior_(prior),
+        minibatch_size_(0),
+        step_size_(0),
+        use_control_variate_(false),
+        friction_(0.0) {
+    if (prior_->dim() != model_->xdim()) {
+      report_error("Prior dimension does not match the model.");
+    }
+    set_minibatch_size(minibatch_size);
+    set_step_size(step_size);
+  }
+
+  void SGGS::draw() {
+    if (model_->inc().nvars() != model_->xdim()) {
+      report_error(
+          "StochasticGradientGlmSampler requires all coefficients to be "
+          "included.");
+    }
+    Vector beta = model_->Beta();
+    Vector gradient = estimate_gradient(beta);
+    if (friction_ <= 0) {
+      beta += preconditioned_step(gradient, step_size_ / 2,
+                                  sqrt(step_size_));
+    } else {
+      if (momentum_.size() != beta.size()) {
+        momentum_.resize(beta.size());
+        momentum_ = 0.0;
+      }
+      momentum_ *= 1 - friction_;
+      momentum_ += preconditioned_step(gradient, step_size_,
+                                       sqrt(2 * friction_ * step_size_));
+      beta += momentum_;
+    }
+    model_->set_Beta(beta);
+  }
+
+  double SGGS::logpri() const { return prior_->logp(model_->Beta()); }
+
+  void SGGS::set_control_variate(const Vector &beta_hat) {
+    control_variate_center_ = beta_hat;
+    (*loglike_)(beta_hat, control_variate_gradient_);
+    use_control_variate_ = true;
+  }
+
+  void SGGS::clear_control_variate() {
+    use_control_variate_ = false;
+    control_variate_center_.clear();
+    control_variate_gradient_.clear();
+  }
+
+  void SGGS::set_preconditioner(const SpdMatrix &variance) {
+    if (variance.nrow() != model_->xdim()) {
+      report_error("Preconditioner dimension does not match the model.");
+    }
+    bool ok = true;
+    preconditioner_cholesky_ = variance.chol(ok);
+    if (!ok) {
+      report_error("Preconditioner must be positive definite.");
+    }
+    preconditioner_ = variance;
+  }
+
+  void SGGS::use_hamiltonian_dynamics(double friction) {
+    if (friction <= 0 || friction > 1) {
+      report_error("SGHMC friction must be in (0, 1].");
+    }
+    friction_ = friction;
+    momentum_.clear();
+  }
+
+  void SGGS::use_langevin_dynamics() {
+    friction_ = 0.0;
+    momentum_.clear();
+  }
+
+  void SGGS::set_step_size(double step_size) {
+    if (step_size <= 0) {
+      report_error("Step size must be positive.");
+    }
+    step_size_ = step_size;
+  }
+
+  void SGGS::set_minibatch_size(int minibatch_size) {
+    if (minibatch_size <= 0) {
+      report_error("Minibatch size must be positive.");
+    }
+    minibatch_size_ = minibatch_size;
+  }
+
+  Vector SGGS::estimate_gradient(const Vector &beta) {
+    int sample_size = loglike_->number_of_terms();
+    if (sample_size <= 0) {
+      report_error("StochasticGradientGlmSampler needs data.");
+    }
+    draw_minibatch();
+    double scale = static_cast<double>(sample_size) / minibatch_size_;
+    loglike_->subsample_value(beta, minibatch_gradient_, minibatch_);
+    Vector ans = minibatch_gradient_ * scale;
+    if (use_control_variate_) {
+      loglike_->subsample_value(control_variate_center_, center_gradient_,
+                                minibatch_);
+      ans.axpy(center_gradient_, -scale);
+      ans += control_variate_gradient_;
+    }
+    ans += prior_->siginv() * (prior_->mu() - beta);
+    return ans;
+  }
+
+  void SGGS::draw_minibatch() {
+    int sample_size = loglike_->number_of_terms();
+    minibatch_.resize(minibatch_size_);
+    for (int i = 0; i < minibatch_size_; ++i) {
+      minibatch_[i] = random_int_mt(rng(), 0, sample_size - 1);
+    }
+  }
+
+  Vector SGGS::preconditioned_step(const Vector &gradient,
+                                   double gradient_scale, double noise_scale) {
+    Vector noise(gradient.size());
+    for (int i = 0; i < noise.size(); ++i) {
+      noise[i] = rnorm_mt(rng(), 0, noise_scale);
+    }
+    if (preconditioner_.nrow() == 0) {
+      return gradient * gradient_scale + noise;
+    }
+    Vector ans = preconditioner_ * gradient;
+    ans *= gradient_scale;
+    ans += preconditioner_cholesky_ * noise;
+    return ans;
+  }
+
+}  // namespace BOOM
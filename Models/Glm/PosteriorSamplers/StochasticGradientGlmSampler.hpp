@@ -0,0 +1,151 @@
+// Copyright 2018 Google LLC. All Rights Reserved.
+/*
+  Copyright (C) 2005-2018 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#ifndef BOOM_GLM_STOCHASTIC_GRADIENT_GLM_SAMPLER_HPP_
+#define BOOM_GLM_STOCHASTIC_GRADIENT_GLM_SAMPLER_HPP_
+
+#include <vector>
+#include "LinAlg/Matrix.hpp"
+#include "LinAlg/SpdMatrix.hpp"
+#include "LinAlg/Vector.hpp"
+#include "Models/Glm/Glm.hpp"
+#include "Models/MvnBase.hpp"
+#include "Models/PosteriorSamplers/PosteriorSampler.hpp"
+#include "TargetFun/TargetFun.hpp"
+
+namespace BOOM {
+
+  // A stochastic gradient MCMC sampler for the coefficients of a GLM with a
+  // very large number of observations.  Each draw evaluates the log
+  // likelihood gradient on a minibatch of observations, sampled with
+  // replacement, so the cost of a draw depends on the minibatch size but
+  // not on the sample size.  There is no Metropolis correction, so the
+  // draws are from an approximation to the posterior whose quality
+  // improves as the step size shrinks.
+  //
+  // Two forms of dynamics are available.  Stochastic gradient Langevin
+  // dynamics (SGLD, the default) moves
+  //
+  //   beta += (epsilon / 2) * V * g + sqrt(epsilon) * V^{1/2} * z,
+  //
+  // where g is the estimated gradient of the log posterior, V is the
+  // preconditioner, and z is standard normal.  Stochastic gradient
+  // Hamiltonian Monte Carlo (SGHMC) keeps a momentum vector v with friction
+  // alpha, and moves
+  //
+  //   v = (1 - alpha) * v + epsilon * V * g
+  //       + sqrt(2 * alpha * epsilon) * V^{1/2} * z,
+  //   beta += v.
+  //
+  // The gradient estimate can use a control variate centered on a point
+  // beta_hat near the posterior mode.  The full data gradient at beta_hat
+  // is computed once, and each draw estimates only the difference between
+  // the gradient at beta and the gradient at beta_hat:
+  //
+  //   g = grad(beta_hat)
+  //       + (N / m) * sum_{i in batch} [g_i(beta) - g_i(beta_hat)].
+  //
+  // Near the mode the two minibatch terms nearly cancel, so the variance of
+  // the estimate is much smaller than the plain (N / m) * sum_i g_i(beta).
+  //
+  // This sampler assumes all the coefficients are included in the model.
+  // It does not work with spike and slab priors.
+  class StochasticGradientGlmSampler : public PosteriorSampler {
+   public:
+    // Args:
+    //   model:  The model whose coefficients are to be sampled.
+    //   loglike: The log likelihood of the data, as a function of the full
+    //     coefficient vector, with one term per observation.
+    //   prior:  The prior distribution on the full coefficient vector.
+    //   minibatch_size:  The number of observations used in each draw.
+    //   step_size: The step size epsilon.  Smaller steps give a better
+    //     approximation to the posterior, and slower mixing.
+    //   seeding_rng: The random number generator used to seed the RNG for
+    //     this sampler.
+    StochasticGradientGlmSampler(GlmModel *model,
+                                 const Ptr<dSubsampleTargetFun> &loglike,
+                                 const Ptr<MvnBase> &prior, int minibatch_size,
+                                 double step_size,
+                                 RNG &seeding_rng = GlobalRng::rng);
+
+    void draw() override;
+    double logpri() const override;
+
+    // Center the gradient estimates on beta_hat, which should be near the
+    // posterior mode, e.g. the MLE from a subsample of the data.  This
+    // evaluates the full data gradient at beta_hat, which is the only
+    // computation in this class whose cost grows with the sample size.
+    void set_control_variate(const Vector &beta_hat);
+    void clear_control_variate();
+
+    // Set the preconditioner V.  A good choice is an estimate of the
+    // posterior variance, e.g. the inverse of the negative Hessian of the
+    // log posterior at the mode.  The default is the identity.
+    void set_preconditioner(const SpdMatrix &variance);
+
+    // Switch to SGHMC dynamics with the given friction, which must be in
+    // (0, 1].  The momentum is reset to zero.
+    void use_hamiltonian_dynamics(double friction);
+
+    // Switch back to SGLD dynamics.
+    void use_langevin_dynamics();
+
+    void set_step_size(double step_size);
+    void set_minibatch_size(int minibatch_size);
+
+    // An unbiased estimate of the gradient of the log posterior at beta,
+    // computed from a fresh minibatch.
+    Vector estimate_gradient(const Vector &beta);
+
+   private:
+    // Fill minibatch_ with observation indices, drawn with replacement.
+    void draw_minibatch();
+
+    // Return V * g, and add V^{1/2} * z * noise_scale to the output, where z
+    // is standard normal.
+    Vector preconditioned_step(const Vector &gradient, double gradient_scale,
+                               double noise_scale);
+
+    GlmModel *model_;
+    Ptr<dSubsampleTargetFun> loglike_;
+    Ptr<MvnBase> prior_;
+    int minibatch_size_;
+    double step_size_;
+
+    bool use_control_variate_;
+    Vector control_variate_center_;
+    Vector control_variate_gradient_;
+
+    // The preconditioner and its lower Cholesky triangle.  Both are empty
+    // if the preconditioner is the identity.
+    SpdMatrix preconditioner_;
+    Matrix preconditioner_cholesky_;
+
+    // Friction for SGHMC.  Zero means SGLD.
+    double friction_;
+    Vector momentum_;
+
+    std::vector<int> minibatch_;
+    Vector minibatch_gradient_;
+    Vector center_gradient_;
+  };
+
+}  // namespace BOOM
+
+#endif  // BOOM_GLM_STOCHASTIC_GRADIENT_GLM_SAMPLER_HPP_
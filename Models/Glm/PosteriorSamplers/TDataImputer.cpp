@@ -19,6 +19,7 @@
 
 #include "Models/Glm/PosteriorSamplers/TDataImputer.hpp"
 #include "cpputil/math_utils.hpp"
+#include "cpputil/report_error.hpp"
 #include "distributions.hpp"
 
 namespace BOOM {
@@ -29,4 +30,18 @@ namespace BOOM {
     return rgamma_mt(rng, 0.5 * (nu + 1), 0.5 * (nu + square(delta)));
   }
 
+  void TDataImputer::impute(RNG &rng, const ConstVectorView &residuals,
+                            double sd, double nu, VectorView weights) const {
+    if (weights.size() != residuals.size()) {
+      report_error("residuals and weights must be the same size.");
+    }
+    // Ga(a, b) is Ga(a, 1) / b, so the shape, which is shared by every
+    // observation, can be drawn in bulk.
+    rgamma_mt(rng, weights, 0.5 * (nu + 1), 1.0);
+    for (int i = 0; i < weights.size(); ++i) {
+      double delta = residuals[i] / sd;
+      weights[i] /= 0.5 * (nu + square(delta));
+    }
+  }
+
 }  // namespace BOOM
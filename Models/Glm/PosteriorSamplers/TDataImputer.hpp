@@ -20,6 +20,7 @@
 #ifndef BOOM_T_DATA_IMPUTER_HPP_
 #define BOOM_T_DATA_IMPUTER_HPP_
 
+#include "LinAlg/VectorView.hpp"
 #include "distributions/rng.hpp"
 
 namespace BOOM {
@@ -52,6 +53,19 @@ namespace BOOM {
     // Returns:
     //   A random draw of w from its posterior distribution.
     double impute(RNG &rng, double residual, double sd, double df) const;
+
+    // Impute the weights for a block of observations.  The draws differ from
+    // repeated calls to the scalar impute(), but have the same distribution.
+    //
+    // Args:
+    //   rng:  A random number generator.
+    //   residuals:  The values of y-mu for each observation.
+    //   sd:  s in the comment above.
+    //   nu:  The "degrees of freedom" parameter.
+    //   weights:  On output, the imputed weights.  Must be the same size as
+    //     residuals.
+    void impute(RNG &rng, const ConstVectorView &residuals, double sd,
+                double nu, VectorView weights) const;
   };
 
 }  // namespace BOOM
@@ -28,6 +28,14 @@
 namespace BOOM {
 
   namespace {
+    // The number of observations in each block of the latent data
+    // imputation.
+    const int t_block_size = 256;
+
+    // The maximum number of shards used for imputation.  Each shard has its
+    // own complete data sufficient statistics.
+    const int max_number_of_shards = 32;
+
     class TRegressionLogPosterior {
      public:
       TRegressionLogPosterior(TRegressionModel *model,
@@ -122,19 +130,71 @@ namespace BOOM {
   }
 
   void TRegressionSampler::impute_latent_data() {
-    if (!latent_data_is_fixed_) {
-      complete_data_sufficient_statistics_.clear();
-      weight_model_->suf()->clear();
-      const std::vector<Ptr<RegressionData> > &data(model_->dat());
-      for (int i = 0; i < data.size(); ++i) {
-        double mu = model_->predict(data[i]->x());
-        double residual = data[i]->y() - mu;
-        double weight = data_imputer_.impute(rng(), residual, model_->sigma(),
-                                             model_->nu());
-        weight_model_->suf()->update_raw(weight);
-        complete_data_sufficient_statistics_.add_data(data[i]->x(),
-                                                      data[i]->y(), weight);
+    if (latent_data_is_fixed_) return;
+    complete_data_sufficient_statistics_.clear();
+    weight_model_->suf()->clear();
+    int sample_size = model_->dat().size();
+    if (sample_size == 0) return;
+    int number_of_blocks = (sample_size + t_block_size - 1) / t_block_size;
+    int blocks_per_shard = (number_of_blocks + max_number_of_shards - 1)
+        / max_number_of_shards;
+    int shard_size = blocks_per_shard * t_block_size;
+    int number_of_shards = (sample_size + shard_size - 1) / shard_size;
+    if (shard_suf_.size() != number_of_shards) {
+      shard_suf_.assign(number_of_shards, WeightedRegSuf(model_->xdim()));
+      shard_weight_suf_.assign(number_of_shards, GammaSuf());
+    }
+
+    RNG::RngIntType seed = seed_rng(rng());
+    auto impute_shard = [&](int shard) {
+      RNG shard_rng(seed, shard);
+      int begin = shard * shard_size;
+      int end = std::min<int>(begin + shard_size, sample_size);
+      shard_suf_[shard].clear();
+      shard_weight_suf_[shard].clear();
+      impute_latent_data(begin, end, shard_suf_[shard],
+                         shard_weight_suf_[shard], shard_rng);
+    };
+    if (pool_.no_threads()) {
+      for (int shard = 0; shard < number_of_shards; ++shard) {
+        impute_shard(shard);
+      }
+    } else {
+      pool_.parallel_for(0, number_of_shards, 1, impute_shard);
+    }
+    for (int shard = 0; shard < number_of_shards; ++shard) {
+      complete_data_sufficient_statistics_.combine(shard_suf_[shard]);
+      weight_model_->suf()->combine(shard_weight_suf_[shard]);
+    }
+  }
+
+  void TRegressionSampler::impute_latent_data(int begin, int end,
+                                              WeightedRegSuf &suf,
+                                              GammaSuf &weight_suf,
+                                              RNG &rng) const {
+    const std::vector<Ptr<RegressionData>> &data(model_->dat());
+    const Vector &beta(model_->Beta());
+    double sigma = model_->sigma();
+    double nu = model_->nu();
+    Matrix predictors;
+    Vector response;
+    Vector weights;
+    while (begin < end) {
+      int nobs = std::min<int>(end - begin, t_block_size);
+      predictors.resize(nobs, beta.size());
+      response.resize(nobs);
+      for (int i = 0; i < nobs; ++i) {
+        predictors.row(i) = data[begin + i]->x();
+        response[i] = data[begin + i]->y();
+      }
+      Vector residual = response - predictors * beta;
+      weights.resize(nobs);
+      data_imputer_.impute(rng, residual, sigma, nu, VectorView(weights));
+      for (int i = 0; i < nobs; ++i) {
+        weight_suf.update_raw(weights[i]);
       }
+      suf.add_data(predictors, response, weights);
+      begin += nobs;
     }
   }
 
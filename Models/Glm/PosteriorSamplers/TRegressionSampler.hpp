@@ -27,6 +27,7 @@
 #include "Models/PosteriorSamplers/GenericGaussianVarianceSampler.hpp"
 #include "Models/ScaledChisqModel.hpp"
 #include "Samplers/ScalarSliceSampler.hpp"
+#include "cpputil/ThreadTools.hpp"
 
 namespace BOOM {
   // A posterior sampler for T regression models.  Uses data
@@ -89,7 +90,21 @@ namespace BOOM {
     void update_complete_data_sufficient_statistics(double y, const Vector &x,
                                                     double weight);
 
+    // impute_latent_data() divides the data into shards, each of which
+    // imputes its weights and accumulates its own sufficient statistics.
+    // The shards can be run concurrently.  Draws do not depend on the number
+    // of threads.
+    void set_number_of_threads(int n) { pool_.set_number_of_threads(n); }
+
    private:
+    // Impute the weights for observations [begin, end), and add the weighted
+    // observations to 'suf' and the weights to 'weight_suf'.  Observations
+    // are processed in blocks, so each block's residuals come from a single
+    // matrix-vector product, and its sufficient statistics from a single
+    // rank-k update.
+    void impute_latent_data(int begin, int end, WeightedRegSuf &suf,
+                            GammaSuf &weight_suf, RNG &rng) const;
+
     TRegressionModel *model_;
     Ptr<MvnBase> coefficient_prior_;
     Ptr<GammaModelBase> siginv_prior_;
@@ -113,6 +128,11 @@ namespace BOOM {
     ScalarSliceSampler nu_complete_data_sampler_;
 
     bool latent_data_is_fixed_;
+
+    // Workspace for impute_latent_data().
+    std::vector<WeightedRegSuf> shard_suf_;
+    std::vector<GammaSuf> shard_weight_suf_;
+    SharedThreadPool pool_;
   };
 
 
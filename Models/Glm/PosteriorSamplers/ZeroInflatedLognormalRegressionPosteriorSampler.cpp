@@ -77,6 +77,11 @@ namespace BOOM {
     nonzero_->sample_posterior();
   }
 
+  void ZILRP::set_number_of_threads(int n) {
+    model_->set_number_of_threads(n);
+    logit_sampler_->set_number_of_workers(n);
+  }
+
   double ZILRP::logpri() const {
     return regression_sampler_->logpri() + logit_sampler_->logpri();
   }
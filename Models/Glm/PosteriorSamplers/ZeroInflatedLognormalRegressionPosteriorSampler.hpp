@@ -55,6 +55,10 @@ namespace BOOM {
     void draw() override;
     double logpri() const override;
 
+    // Use 'n' threads in the data augmentation for the logistic regression
+    // component, and to evaluate the model's log likelihood.
+    void set_number_of_threads(int n);
+
     // An observer method to be called when the data in *model
     // changes.
     void invalidate_latent_data() { data_is_current_ = false; }
@@ -24,6 +24,13 @@
 
 namespace BOOM {
 
+  namespace {
+    // The number of observations in each block of the forced zero
+    // imputation.  Blocks are the unit of work assigned to threads, and each
+    // has its own RNG stream.
+    const int forced_zero_block_size = 256;
+  }  // namespace
+
   typedef ZeroInflatedPoissonRegressionSampler ZIPRS;
 
   ZIPRS::ZeroInflatedPoissonRegressionSampler(
@@ -126,66 +133,109 @@ namespace BOOM {
   }
 
   void ZIPRS::impute_forced_zeros(bool stochastic) {
+    ensure_latent_data();
+    int number_of_observations = model_->dat().size();
+    int number_of_blocks =
+        (number_of_observations + forced_zero_block_size - 1) /
+        forced_zero_block_size;
+    RNG::RngIntType seed = stochastic ? seed_rng(rng()) : 0;
+    auto impute_block = [&](int block) {
+      RNG block_rng(seed, block);
+      int begin = block * forced_zero_block_size;
+      int end = std::min<int>(begin + forced_zero_block_size,
+                              number_of_observations);
+      impute_forced_zeros(begin, end, stochastic, block_rng);
+    };
+    if (pool_.no_threads()) {
+      for (int block = 0; block < number_of_blocks; ++block) {
+        impute_block(block);
+      }
+    } else {
+      pool_.parallel_for(0, number_of_blocks, 1, impute_block);
+    }
+  }
+
+  void ZIPRS::impute_forced_zeros(int begin, int end, bool stochastic,
+                                  RNG &rng) {
     const std::vector<Ptr<ZeroInflatedPoissonRegressionData>> &data(
         model_->dat());
-    ensure_latent_data();
     const std::vector<Ptr<PoissonRegressionData>> &poisson_data(
         poisson_->dat());
     const std::vector<Ptr<BinomialRegressionData>> &logit_data(logit_->dat());
-    for (int i = 0; i < data.size(); ++i) {
-      int64_t total_number_of_zeros = lround(data[i]->number_of_zero_trials());
-      if (total_number_of_zeros > 0) {
-        // pbinomial will eventually be the probability that this zero
-        // is a forced zero.
-        //                         p(0 | forced) * pforced
-        // pforced | 0 =  --------------------------------------------
-        //                 p(0 | forced) * pforced + p(0 | free) * pfree
+
+    // Only observations with zero trials need imputation.
+    std::vector<int> zeros;
+    for (int i = begin; i < end; ++i) {
+      if (data[i]->number_of_zero_trials() > 0) {
+        zeros.push_back(i);
+      }
+    }
+    if (zeros.empty()) return;
+    Matrix predictors(zeros.size(),
+                      model_->poisson_coefficients().nvars_possible());
+    for (int j = 0; j < zeros.size(); ++j) {
+      predictors.row(j) = data[zeros[j]]->x();
+    }
+    Vector logit_eta = predictors * model_->logit_coefficients().Beta();
+    Vector poisson_eta = predictors * model_->poisson_coefficients().Beta();
+
+    for (int j = 0; j < zeros.size(); ++j) {
+      int i = zeros[j];
+      int64_t total_number_of_zeros = data[i]->number_of_zero_trials();
+      // The probability that a zero is a forced zero is
+      //                         p(0 | forced) * pforced
+      // pforced | 0 =  --------------------------------------------
+      //                 p(0 | forced) * pforced + p(0 | free) * pfree
+      //
+      // where p(0|forced) = 1.0 and p(0 | free) = exp(-lambda).  On the
+      // logit scale this is log(pforced / pfree) + lambda, and
+      // log(pforced / pfree) is the negative of the logit linear predictor.
+      double pforced_given_0 = plogis(exp(poisson_eta[j]) - logit_eta[j]);
+      if (stochastic) {
+        int64_t number_of_binomial_zeros =
+            rbinom_mt(rng, total_number_of_zeros, pforced_given_0);
+
+        // The number of trials for the logit data is the total number
+        // of zeros.  This should be set in ensure_latent_data, as it
+        // does not vary with the data augmentation.  Note that this
+        // might be zero.
         //
-        // where p(0|forced) = 1.0
-        double pforced = model_->probability_forced_to_zero(data[i]->x());
-        double pfree = 1.0 - pforced;
-        double lambda = model_->poisson_mean(data[i]->x());
-        double pforced_given_0 = pforced / (pforced + pfree * dpois(0, lambda));
-        if (stochastic) {
-          int64_t number_of_binomial_zeros =
-              rbinom_mt(rng(), total_number_of_zeros, pforced_given_0);
-
-          // The number of trials for the logit data is the total number
-          // of zeros.  This should be set in ensure_latent_data, as it
-          // does not vary with the data augmentation.  Note that this
-          // might be zero.
-          //
-          // The notion of 'success' for the binomial model is an
-          // observation that is not forced to zero.  Note that the
-          // nonzero trials contribute to the binomial nonzeros too.
-          int64_t number_of_poisson_observations =
-              data[i]->total_number_of_trials() - number_of_binomial_zeros;
-          logit_data[i]->set_y(number_of_poisson_observations);
-
-          // The exposure for the poisson data is the total number of
-          // trials minus the number of trials that are forced to be
-          // zero.  The 'y' for the Poisson data is the sum of the event
-          // values, which does not change across the data augmentation,
-          // and so should be set in ensure_latent_data.
-          poisson_data[i]->set_exposure(number_of_poisson_observations);
-        } else {
-          // If we're not imputing stochastically, then we're not
-          // going to impute an integer number of draws.  Otherwise
-          // this branch is the same as the preceding branch, with
-          // draws replaced by expectations.
-          double expected_number_of_binomial_zeros =
-              total_number_of_zeros * pforced_given_0;
-          double expected_number_of_poisson_observations =
-              data[i]->total_number_of_trials() -
-              expected_number_of_binomial_zeros;
-          logit_data[i]->set_y(expected_number_of_poisson_observations);
-          poisson_data[i]->set_exposure(
-              expected_number_of_poisson_observations);
-        }
+        // The notion of 'success' for the binomial model is an
+        // observation that is not forced to zero.  Note that the
+        // nonzero trials contribute to the binomial nonzeros too.
+        int64_t number_of_poisson_observations =
+            data[i]->total_number_of_trials() - number_of_binomial_zeros;
+        logit_data[i]->set_y(number_of_poisson_observations);
+
+        // The exposure for the poisson data is the total number of
+        // trials minus the number of trials that are forced to be
+        // zero.  The 'y' for the Poisson data is the sum of the event
+        // values, which does not change across the data augmentation,
+        // and so should be set in ensure_latent_data.
+        poisson_data[i]->set_exposure(number_of_poisson_observations);
+      } else {
+        // If we're not imputing stochastically, then we're not
+        // going to impute an integer number of draws.  Otherwise
+        // this branch is the same as the preceding branch, with
+        // draws replaced by expectations.
+        double expected_number_of_binomial_zeros =
+            total_number_of_zeros * pforced_given_0;
+        double expected_number_of_poisson_observations =
+            data[i]->total_number_of_trials() -
+            expected_number_of_binomial_zeros;
+        logit_data[i]->set_y(expected_number_of_poisson_observations);
+        poisson_data[i]->set_exposure(
+            expected_number_of_poisson_observations);
       }
     }
   }
 
+  void ZIPRS::set_number_of_threads(int n) {
+    pool_.set_number_of_threads(n);
+    poisson_sampler_->set_number_of_workers(n);
+    logit_sampler_->set_number_of_workers(n);
+  }
+
   void ZIPRS::allow_model_selection(bool tf) {
     poisson_sampler_->allow_model_selection(tf);
     logit_sampler_->allow_model_selection(tf);
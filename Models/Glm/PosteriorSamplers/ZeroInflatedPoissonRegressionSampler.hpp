@@ -24,6 +24,7 @@
 #include "Models/Glm/PosteriorSamplers/BinomialLogitCompositeSpikeSlabSampler.hpp"
 #include "Models/Glm/PosteriorSamplers/PoissonRegressionSpikeSlabSampler.hpp"
 #include "Models/Glm/ZeroInflatedPoissonRegression.hpp"
+#include "cpputil/ThreadTools.hpp"
 
 namespace BOOM {
 
@@ -47,8 +48,17 @@ namespace BOOM {
     //     parameters.  If 'false' then replace each indicator with
     //     its posterior mean, which is the E step in an EM algorithm
     //     for finding the posterior mode.
+    //
+    // The observations are processed in fixed blocks, each with its own RNG
+    // stream, so the draws do not depend on the number of threads.
     void impute_forced_zeros(bool stochastic);
 
+    // Use 'n' threads to impute the forced zeros, and the same number of
+    // workers in the data augmentation steps of the Poisson and logit
+    // samplers.  Each of those workers accumulates its own complete data
+    // sufficient statistics.
+    void set_number_of_threads(int n);
+
     // Model selection is on by default.  allow_model_selection(false)
     // turns it off.  allow_model_selection(true) turns it back on
     // again.
@@ -69,6 +79,11 @@ namespace BOOM {
     // data and provide a fresh set.
     void ensure_latent_data();
 
+    // Impute the forced zeros for observations [begin, end).  The linear
+    // predictors of both components are computed as a block for the
+    // observations with at least one zero trial.
+    void impute_forced_zeros(int begin, int end, bool stochastic, RNG &rng);
+
     // Clear the data from poisson_ and logit_, create new data and
     // use it to populate the models.
     void refresh_latent_data();
@@ -87,6 +102,7 @@ namespace BOOM {
     Ptr<BinomialLogitCompositeSpikeSlabSampler> logit_sampler_;
 
     bool posterior_mode_found_;
+    SharedThreadPool pool_;
   };
 
 }  // namespace BOOM
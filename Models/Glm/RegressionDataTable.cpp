@@ -0,0 +1,77 @@
+/*
+  Copyright (C) 2005-2024 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include "Models/Glm/RegressionDataTable.hpp"
+#include <sstream>
+#include "cpputil/report_error.hpp"
+
+namespace BOOM {
+
+  RegressionDataTable::RegressionDataTable(int xdim, int expected_sample_size)
+      : xdim_(xdim) {
+    if (xdim_ < 0) {
+      report_error("Predictor dimension must be non-negative.");
+    }
+    if (expected_sample_size > 0) {
+      predictors_.reserve(size_t(expected_sample_size) * xdim_);
+      response_.reserve(expected_sample_size);
+    }
+  }
+
+  RegressionDataTable::RegressionDataTable(const Matrix &X, const Vector &y)
+      : RegressionDataTable(X.ncol(), X.nrow()) {
+    if (X.nrow() != y.size()) {
+      std::ostringstream err;
+      err << "The design matrix has " << X.nrow() << " rows, but the "
+          << "response vector has " << y.size() << " elements.";
+      report_error(err.str());
+    }
+    for (int i = 0; i < X.nrow(); ++i) {
+      add_observation(y[i], X.row(i));
+    }
+  }
+
+  void RegressionDataTable::add_observation(double y,
+                                            const ConstVectorView &x) {
+    if (x.size() != xdim_) {
+      std::ostringstream err;
+      err << "Predictor vector has dimension " << x.size()
+          << ", but the table expects " << xdim_ << ".";
+      report_error(err.str());
+    }
+    predictors_.insert(predictors_.end(), x.begin(), x.end());
+    response_.push_back(y);
+  }
+
+  void RegressionDataTable::fill_design_matrix(int begin, int end,
+                                               Matrix &X) const {
+    if (begin < 0 || end > sample_size() || begin > end) {
+      report_error("Invalid range of observations in fill_design_matrix.");
+    }
+    X.resize(end - begin, xdim_);
+    for (int i = begin; i < end; ++i) {
+      X.row(i - begin) = predictors(i);
+    }
+  }
+
+  void RegressionDataTable::clear() {
+    predictors_.clear();
+    response_.clear();
+  }
+
+}  // namespace BOOM
@@ -0,0 +1,111 @@
+#ifndef BOOM_GLM_REGRESSION_DATA_TABLE_HPP_
+#define BOOM_GLM_REGRESSION_DATA_TABLE_HPP_
+/*
+  Copyright (C) 2005-2024 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include <vector>
+#include "LinAlg/Matrix.hpp"
+#include "LinAlg/Vector.hpp"
+#include "LinAlg/VectorView.hpp"
+#include "cpputil/RefCounted.hpp"
+
+namespace BOOM {
+
+  // A compact store for regression data: a response y[i] and a predictor
+  // vector x[i] for each observation.  A vector<Ptr<RegressionData>> holds
+  // each observation in its own heap allocated object, with a reference
+  // count, missing data status, observers, and a separately allocated
+  // predictor vector.  This class stores all the predictors in a single
+  // contiguous block, one observation after another, and the responses in
+  // another, so large data sets cost little more than the raw numbers and
+  // can be traversed in cache-friendly order.
+  //
+  // Models with sufficient statistics can absorb a table without creating
+  // RegressionData objects.  See RegSuf::add_data_table and
+  // RegressionModel::add_data_table.
+  class RegressionDataTable : private RefCounted {
+   public:
+    // An empty table.
+    //
+    // Args:
+    //   xdim:  The dimension of the predictor vector for each observation.
+    //   expected_sample_size: If positive, space for this many observations
+    //     is reserved in advance.
+    explicit RegressionDataTable(int xdim, int expected_sample_size = 0);
+
+    // A table holding a copy of the given data.
+    //
+    // Args:
+    //   X: The design matrix.  Row i is the predictor vector for observation
+    //     i.
+    //   y: The vector of responses.  The length of y must match the number
+    //     of rows in X.
+    RegressionDataTable(const Matrix &X, const Vector &y);
+
+    void add_observation(double y, const ConstVectorView &x);
+    void add_observation(double y, const Vector &x) {
+      add_observation(y, ConstVectorView(x));
+    }
+    void add_observation(double y, const VectorView &x) {
+      add_observation(y, ConstVectorView(x));
+    }
+
+    int sample_size() const { return response_.size(); }
+    int xdim() const { return xdim_; }
+
+    double response(int i) const { return response_[i]; }
+
+    // The predictor vector for observation i.  The view is invalidated if
+    // more observations are added.
+    ConstVectorView predictors(int i) const {
+      return ConstVectorView(predictors_.data() + i * xdim_, xdim_, 1);
+    }
+
+    // Copy observations [begin, end) into a design matrix with one row per
+    // observation, for use with the matrix operations in LinAlg.
+    //
+    // Args:
+    //   begin, end:  The range of observations to copy.
+    //   X: On output X is resized to (end - begin) x xdim() and filled with
+    //     the predictors.
+    void fill_design_matrix(int begin, int end, Matrix &X) const;
+
+    // Responses for observations [begin, end).
+    ConstVectorView responses(int begin, int end) const {
+      return ConstVectorView(response_.data() + begin, end - begin, 1);
+    }
+
+    void clear();
+
+   private:
+    int xdim_;
+    std::vector<double> predictors_;
+    std::vector<double> response_;
+
+    friend void intrusive_ptr_add_ref(RegressionDataTable *t) {
+      t->up_count();
+    }
+    friend void intrusive_ptr_release(RegressionDataTable *t) {
+      t->down_count();
+      if (t->ref_count() == 0) delete t;
+    }
+  };
+
+}  // namespace BOOM
+
+#endif  // BOOM_GLM_REGRESSION_DATA_TABLE_HPP_
@@ -21,7 +21,10 @@
 
 #include <cmath>
 #include <sstream>
+#include "LinAlg/fused_operations.hpp"
+#include "Models/StateSpace/Filters/SparseVector.hpp"
 #include "Models/SufstatAbstractCombineImpl.hpp"
+#include "cpputil/ThreadTools.hpp"
 #include "distributions.hpp"
 
 namespace BOOM {
@@ -75,6 +78,47 @@ namespace BOOM {
     return xtx().Mdist(beta) - 2 * beta.dot(xty()) + yty();
   }
 
+  namespace {
+    void check_data_block(const Matrix &X, const Vector &y,
+                          const Vector &weights, int xdim) {
+      std::ostringstream err;
+      if (X.ncol() != xdim) {
+        err << "A design matrix with " << X.ncol() << " columns cannot be "
+            << "added to sufficient statistics of dimension " << xdim << ".";
+        report_error(err.str());
+      }
+      if (X.nrow() != y.size()) {
+        err << "Number of rows of X: " << X.nrow()
+            << " must match the length of y: " << y.size() << ".";
+        report_error(err.str());
+      }
+      if (!weights.empty() && weights.size() != y.size()) {
+        err << "There are " << weights.size() << " weights for "
+            << y.size() << " observations.";
+        report_error(err.str());
+      }
+    }
+  }  // namespace
+
+  void RegSuf::add_data(const Matrix &X, const Vector &y,
+                        const Vector &weights) {
+    check_data_block(X, y, weights, size());
+    for (int i = 0; i < X.nrow(); ++i) {
+      add_mixture_data(y[i], X.row(i), weights.empty() ? 1.0 : weights[i]);
+    }
+  }
+
+  void RegSuf::add_data_table(const RegressionDataTable &table) {
+    for (int i = 0; i < table.sample_size(); ++i) {
+      add_mixture_data(table.response(i), table.predictors(i), 1.0);
+    }
+  }
+
+  void RegSuf::add_mixture_data(double y, const SparseVector &x,
+                                double prob) {
+    add_mixture_data(y, x.dense(), prob);
+  }
+
   double RegSuf::sample_variance() const {
     return n() <= 1.0 ? 0.0 : SST() / (n() - 1);
   }
@@ -369,6 +413,25 @@ namespace BOOM {
     x_column_sums_.axpy(x, prob);
   }
 
+  void NeRegSuf::add_mixture_data(double y, const SparseVector &x,
+                                  double prob) {
+    if (x.size() != xty_.size()) {
+      report_error("Wrong size predictor passed to "
+                   "NeRegSuf::add_mixture_data().");
+    }
+    if (!xtx_is_fixed_) {
+      x.add_outer_product(xtx_, prob);
+    }
+    if (!std::isfinite(y)) {
+      report_error("Non-finite response variable in add_mixture_data.");
+    }
+    x.add_this_to(xty_, y * prob);
+    sumsqy_ += y * y * prob;
+    n_ += prob;
+    sumy_ += y * prob;
+    x.add_this_to(x_column_sums_, prob);
+  }
+
   void NeRegSuf::clear() {
     if (!xtx_is_fixed_) xtx_ = 0.0;
     xty_ = 0.0;
@@ -417,6 +480,13 @@ namespace BOOM {
     return inc.select(xtx_);
   }
   Vector NeRegSuf::xty(const Selector &inc) const { return inc.select(xty_); }
+
+  void NeRegSuf::fill_xtx(SpdMatrix &ans) const {
+    reflect();
+    ans = xtx_;
+  }
+
+  void NeRegSuf::fill_xty(Vector &ans) const { ans = xty_; }
   double NeRegSuf::yty() const { return sumsqy_; }
 
   Vector NeRegSuf::beta_hat() const {
@@ -443,6 +513,9 @@ namespace BOOM {
     xty_ += other.xty();
     sumsqy_ += other.yty();
     sumy_ += other.n() * other.ybar();
+    if (other.n() > 0) {
+      x_column_sums_.axpy(other.xbar(), other.n());
+    }
     n_ += other.n();
   }
 
@@ -450,6 +523,116 @@ namespace BOOM {
     return abstract_combine_impl(this, s);
   }
 
+  void NeRegSuf::add_data(const Matrix &X, const Vector &y,
+                          const Vector &weights) {
+    check_data_block(X, y, weights, xty_.size());
+    if (!allow_non_finite_responses_) {
+      for (int i = 0; i < y.size(); ++i) {
+        if (!std::isfinite(y[i])) {
+          report_error("Non-finite response variable in add_data.");
+        }
+      }
+    }
+    if (weights.empty()) {
+      if (!xtx_is_fixed_) {
+        xtx_.add_inner(X);
+      }
+      xty_ += y * X;
+      sumsqy_ += y.normsq();
+      sumy_ += y.sum();
+      n_ += X.nrow();
+      x_column_sums_ += ColSums(X);
+    } else {
+      if (!xtx_is_fixed_) {
+        xtx_.add_inner(X, weights, false);
+        needs_to_reflect_ = true;
+      }
+      Vector wy(y.size());
+      for (int i = 0; i < y.size(); ++i) {
+        wy[i] = weights[i] * y[i];
+      }
+      xty_ += wy * X;
+      sumsqy_ += wy.dot(y);
+      sumy_ += wy.sum();
+      n_ += weights.sum();
+      x_column_sums_ += weights * X;
+    }
+  }
+
+  void NeRegSuf::add_data_table(const RegressionDataTable &table) {
+    if (table.xdim() != xty_.size()) {
+      std::ostringstream err;
+      err << "A table with predictor dimension " << table.xdim()
+          << " cannot be added to sufficient statistics of dimension "
+          << xty_.size() << ".";
+      report_error(err.str());
+    }
+    const int block_size = 256;
+    Matrix X;
+    for (int begin = 0; begin < table.sample_size(); begin += block_size) {
+      int end = std::min<int>(begin + block_size, table.sample_size());
+      table.fill_design_matrix(begin, end, X);
+      add_data(X, Vector(table.responses(begin, end)));
+    }
+  }
+
+  namespace {
+    void check_data_view(int nrow, int ncol, int ysize, int xdim) {
+      if (nrow != ysize) {
+        std::ostringstream err;
+        err << "Number of rows of X: " << nrow
+            << " must match the length of y: " << ysize
+            << ".";
+        report_error(err.str());
+      }
+      if (ncol != xdim) {
+        std::ostringstream err;
+        err << "A design matrix with " << ncol << " columns cannot be "
+            << "added to sufficient statistics of dimension "
+            << xdim << ".";
+        report_error(err.str());
+      }
+    }
+  }  // namespace
+
+  void NeRegSuf::add_data_view(const ConstSubMatrix &X,
+                               const ConstVectorView &y) {
+    check_data_view(X.nrow(), X.ncol(), y.size(), xty_.size());
+    if (!allow_non_finite_responses_) {
+      for (int i = 0; i < y.size(); ++i) {
+        if (!std::isfinite(y[i])) {
+          report_error("Non-finite response variable in add_data_view.");
+        }
+      }
+    }
+    // X is read in place (e.g. from R's column major storage), so no part of
+    // it is copied.  The rank-k update fills only the upper triangle of xtx_.
+    if (!xtx_is_fixed_) {
+      add_inner_product(xtx_, X, 1.0, false);
+      needs_to_reflect_ = true;
+    }
+    transpose_matrix_vector_product(VectorView(xty_), X, y, 1.0, 1.0);
+    sumsqy_ += y.normsq();
+    sumy_ += y.sum();
+    n_ += X.nrow();
+    for (int j = 0; j < X.ncol(); ++j) {
+      x_column_sums_[j] += X.col(j).sum();
+    }
+  }
+
+  void NeRegSuf::add_data_view(const ConstFloatSubMatrix &X,
+                               const ConstVectorView &y) {
+    check_data_view(X.nrow(), X.ncol(), y.size(), xty_.size());
+    const int block_size = 256;
+    const int sample_size = X.nrow();
+    Matrix block;
+    for (int begin = 0; begin < sample_size; begin += block_size) {
+      int end = std::min<int>(begin + block_size, sample_size);
+      X.copy_rows(begin, end, block);
+      add_data(block, Vector(ConstVectorView(y, begin, end - begin)));
+    }
+  }
+
   Vector NeRegSuf::vectorize(bool minimal) const {
     reflect();
     Vector ans = xtx_.vectorize(minimal);
@@ -457,6 +640,7 @@ namespace BOOM {
     ans.push_back(sumsqy_);
     ans.push_back(n_);
     ans.push_back(sumy_);
+    ans.concat(x_column_sums_);
     return ans;
   }
 
@@ -470,10 +654,14 @@ namespace BOOM {
     v += dim;
     sumsqy_ = *v;
     ++v;
-    n_ = lround(*v);
+    // The sample size is not rounded, because data added through
+    // add_mixture_data can carry fractional weight.
+    n_ = *v;
     ++v;
     sumy_ = *v;
     ++v;
+    x_column_sums_.assign(v, v + dim);
+    v += dim;
     return v;
   }
 
@@ -748,6 +936,16 @@ namespace BOOM {
     suf()->add_mixture_data(d->y(), d->x(), prob);
   }
 
+  void RM::add_data_table(const RegressionDataTable &table) {
+    only_keep_sufstats(true);
+    suf()->add_data_table(table);
+  }
+
+  void RM::add_data(const Matrix &X, const Vector &y) {
+    only_keep_sufstats(true);
+    suf()->add_data(X, y);
+  }
+
   /*
      SSE = (y-Xb)^T (y-Xb)
      = (y - QQTy)^T (y - Q Q^Ty)
@@ -780,8 +978,54 @@ namespace BOOM {
 
   void BigRegressionModel::stream_data_for_initial_screen(
       const RegressionData &data_point) {
-    double y = data_point.y();
-    const Vector &x(data_point.x());
+    stream_observation_for_initial_screen(data_point.y(),
+                                          ConstVectorView(data_point.x()));
+  }
+
+  namespace {
+    // The number of observations passed to each rank-k update when a
+    // RegressionDataTable is streamed into a BigRegressionModel.
+    const int stream_block_size = 256;
+  }  // namespace
+
+  void BigRegressionModel::stream_data_table_for_initial_screen(
+      const RegressionDataTable &table) {
+    Matrix X;
+    for (int begin = 0; begin < table.sample_size();
+         begin += stream_block_size) {
+      int end = std::min<int>(begin + stream_block_size, table.sample_size());
+      table.fill_design_matrix(begin, end, X);
+      stream_data_for_initial_screen(X, Vector(table.responses(begin, end)));
+    }
+  }
+
+  void BigRegressionModel::stream_data_for_initial_screen(
+      const Matrix &X, const Vector &y) {
+    if (X.ncol() != xdim()) {
+      std::ostringstream err;
+      err << "A design matrix with " << X.ncol() << " columns was streamed "
+          << "to a BigRegressionModel with " << xdim() << " predictors.";
+      report_error(err.str());
+    }
+    long cursor = 0;
+    Matrix chunk;
+    for (uint m = 0; m < subordinate_models_.size(); ++m) {
+      auto &model(*subordinate_models_[m]);
+      long chunk_size = model.xdim();
+      chunk.resize(X.nrow(), chunk_size);
+      bool add_intercept = force_intercept_ && m > 0;
+      if (add_intercept) {
+        chunk.col(0) = 1.0;
+      }
+      for (int i = add_intercept; i < chunk_size; ++i) {
+        chunk.col(i) = X.col(cursor++);
+      }
+      model.suf()->add_data(chunk, y);
+    }
+  }
+
+  void BigRegressionModel::stream_observation_for_initial_screen(
+      double y, const ConstVectorView &x) {
     long cursor = 0;
     for (uint m = 0; m < subordinate_models_.size(); ++m) {
       auto &model(*subordinate_models_[m]);
@@ -816,6 +1060,27 @@ namespace BOOM {
         1.0);
   }
 
+  void BigRegressionModel::stream_data_table_for_restricted_model(
+      const RegressionDataTable &table) {
+    Matrix X;
+    for (int begin = 0; begin < table.sample_size();
+         begin += stream_block_size) {
+      int end = std::min<int>(begin + stream_block_size, table.sample_size());
+      table.fill_design_matrix(begin, end, X);
+      stream_data_for_restricted_model(X, Vector(table.responses(begin, end)));
+    }
+  }
+
+  void BigRegressionModel::stream_data_for_restricted_model(
+      const Matrix &X, const Vector &y) {
+    if (!restricted_model_) {
+      report_error("You must call 'set_candidates' before streaming data "
+                   "to the restricted model.");
+    }
+    restricted_model_->suf()->add_data(predictor_candidates_.select_cols(X),
+                                       y);
+  }
+
   void BigRegressionModel::create_subordinate_models(
       uint xdim,
       int subordinate_model_max_dim,
@@ -839,6 +1104,104 @@ namespace BOOM {
     }
   }
 
+  namespace {
+    // Deserialize each shard into a copy of 'prototypes' and sum them.  The
+    // shards must already be known to have the right size.
+    // Element m of the return value is the sum over shards of the sufficient
+    // statistics corresponding to prototypes[m].  Shards are merged
+    // pairwise: at each level of the tree shard i absorbs shard i + stride
+    // for every suitable i, and the stride doubles.
+    std::vector<Ptr<RegSuf>> tree_reduce_regression_sufs(
+        const std::vector<Ptr<RegSuf>> &prototypes,
+        const std::vector<Vector> &shards) {
+      int nshards = shards.size();
+      int nsuf = prototypes.size();
+      if (nshards == 0 || nsuf == 0) {
+        return std::vector<Ptr<RegSuf>>();
+      }
+      std::vector<std::vector<Ptr<RegSuf>>> shard_sufs(nshards);
+      global_thread_pool().parallel_for(
+          0, nshards, 1, [&](int shard) {
+            Vector::const_iterator it = shards[shard].begin();
+            for (int m = 0; m < nsuf; ++m) {
+              Ptr<RegSuf> suf(prototypes[m]->clone());
+              suf->clear();
+              suf->unvectorize(it, true);
+              shard_sufs[shard].push_back(suf);
+            }
+          });
+
+      for (int stride = 1; stride < nshards; stride *= 2) {
+        int npairs = (nshards - stride + 2 * stride - 1) / (2 * stride);
+        global_thread_pool().parallel_for(
+            0, npairs * nsuf, 1, [&](int task) {
+              int shard = 2 * stride * (task / nsuf);
+              int m = task % nsuf;
+              shard_sufs[shard][m]->combine(shard_sufs[shard + stride][m]);
+            });
+      }
+      return shard_sufs[0];
+    }
+
+    void check_shard_sizes(const std::vector<Vector> &shards,
+                           int expected_size) {
+      for (int i = 0; i < shards.size(); ++i) {
+        if (shards[i].size() != expected_size) {
+          std::ostringstream err;
+          err << "Shard " << i << " has " << shards[i].size()
+              << " elements, but a model of this size needs "
+              << expected_size << ".  Was the shard built with the same "
+              << "model dimensions?";
+          report_error(err.str());
+        }
+      }
+    }
+  }  // namespace
+
+  Vector BigRegressionModel::serialize_initial_screen_suf() const {
+    Vector ans;
+    for (const auto &model : subordinate_models_) {
+      ans.concat(model->suf()->vectorize(true));
+    }
+    return ans;
+  }
+
+  Vector BigRegressionModel::serialize_restricted_model_suf() const {
+    if (!restricted_model_) {
+      report_error("You must call 'set_candidates' before serializing the "
+                   "restricted model.");
+    }
+    return restricted_model_->suf()->vectorize(true);
+  }
+
+  void BigRegressionModel::combine_initial_screen_shards(
+      const std::vector<Vector> &shards) {
+    std::vector<Ptr<RegSuf>> prototypes;
+    for (const auto &model : subordinate_models_) {
+      prototypes.push_back(model->suf());
+    }
+    check_shard_sizes(shards, serialize_initial_screen_suf().size());
+    std::vector<Ptr<RegSuf>> total = tree_reduce_regression_sufs(
+        prototypes, shards);
+    for (int m = 0; m < total.size(); ++m) {
+      subordinate_models_[m]->suf()->combine(total[m]);
+    }
+  }
+
+  void BigRegressionModel::combine_restricted_model_shards(
+      const std::vector<Vector> &shards) {
+    if (!restricted_model_) {
+      report_error("You must call 'set_candidates' before combining data "
+                   "for the restricted model.");
+    }
+    check_shard_sizes(shards, serialize_restricted_model_suf().size());
+    std::vector<Ptr<RegSuf>> total = tree_reduce_regression_sufs(
+        std::vector<Ptr<RegSuf>>(1, restricted_model_->suf()), shards);
+    if (!total.empty()) {
+      restricted_model_->suf()->combine(total[0]);
+    }
+  }
+
   void BigRegressionModel::expand_restricted_model_parameters() {
     const GlmCoefs &restricted_coefs(restricted_model_->coef());
     const Selector &restricted_inc(restricted_coefs.inc());
@@ -23,9 +23,11 @@
 #include "uint.hpp"
 #include <cstdint>
 
+#include "LinAlg/FloatMatrix.hpp"
 #include "LinAlg/QR.hpp"
 #include "Models/EmMixtureComponent.hpp"
 #include "Models/Glm/Glm.hpp"
+#include "Models/Glm/RegressionDataTable.hpp"
 #include "Models/ParamTypes.hpp"
 #include "Models/Policies/IID_DataPolicy.hpp"
 #include "Models/Policies/ParamPolicy_2.hpp"
@@ -70,6 +72,13 @@ namespace BOOM {
     virtual Vector xty(const Selector &) const = 0;
     virtual SpdMatrix xtx(const Selector &) const = 0;
 
+    // Write xtx() or xty() into caller-owned storage, which is resized if
+    // needed.  Code that needs the statistics every MCMC iteration can use
+    // these to avoid allocating.  The default implementations copy the
+    // return value of xtx() or xty().
+    virtual void fill_xtx(SpdMatrix &ans) const { ans = xtx(); }
+    virtual void fill_xty(Vector &ans) const { ans = xty(); }
+
     // (X - Xbar)^T * (X - Xbar)
     //  = xtx - n * xbar xbar^T
     SpdMatrix centered_xtx() const;
@@ -95,8 +104,32 @@ namespace BOOM {
     virtual void add_mixture_data(double y, const Vector &x, double prob) = 0;
     virtual void add_mixture_data(double y, const ConstVectorView &x,
                                   double prob) = 0;
+
+    // Add an observation with a sparse predictor vector, such as a row of
+    // one-hot encoded categorical variables.  The default implementation
+    // converts x to a dense vector.  Child classes that can take advantage
+    // of sparsity should override.
+    virtual void add_mixture_data(double y, const SparseVector &x,
+                                  double prob);
     virtual void combine(const Ptr<RegSuf> &) = 0;
 
+    // Add a block of observations to the sufficient statistics.
+    //
+    // Args:
+    //   X:  The design matrix.  Row i is the predictor vector for
+    //     observation i.
+    //   y:  The vector of responses.  Its length must match nrow(X).
+    //   weights: Observation weights (as in add_mixture_data).  If empty,
+    //     all weights are 1.
+    //
+    // The default implementation calls add_mixture_data once per row.
+    virtual void add_data(const Matrix &X, const Vector &y,
+                          const Vector &weights = Vector());
+
+    // Add every observation in 'table' to the sufficient statistics, with
+    // unit weight.
+    virtual void add_data_table(const RegressionDataTable &table);
+
     std::ostream &print(std::ostream &out) const override;
   };
 
@@ -115,6 +148,7 @@ namespace BOOM {
     void add_mixture_data(double y, const Vector &x, double prob) override;
     void add_mixture_data(double y, const ConstVectorView &x,
                           double prob) override;
+    using RegSuf::add_mixture_data;
     void fix_xtx(bool fixed = true) override;
     uint size() const override;  // dimension of beta
     double yty() const override;
@@ -186,6 +220,12 @@ namespace BOOM {
     void add_mixture_data(double y, const Vector &x, double prob) override;
     void add_mixture_data(double y, const ConstVectorView &x,
                           double prob) override;
+
+    // Only the nonzero elements of x are visited, so the cost of the update
+    // is quadratic in the number of nonzeros rather than in the dimension
+    // of x.
+    void add_mixture_data(double y, const SparseVector &x,
+                          double prob) override;
     void Update(const RegressionData &rdp) override;
     uint size() const override;  // dimension of beta
     double yty() const override;
@@ -193,6 +233,8 @@ namespace BOOM {
     SpdMatrix xtx() const override;
     Vector xty(const Selector &) const override;
     SpdMatrix xtx(const Selector &) const override;
+    void fill_xtx(SpdMatrix &ans) const override;
+    void fill_xty(Vector &ans) const override;
     Vector beta_hat() const override;
     double SSE() const override;
     double SST() const override;
@@ -203,6 +245,28 @@ namespace BOOM {
     void combine(const RegSuf &);
     NeRegSuf *abstract_combine(Sufstat *s) override;
 
+    // Blocks of observations are added to xtx with a rank-k update
+    // (BLAS SYRK), which is much faster than one outer product per
+    // observation.
+    void add_data(const Matrix &X, const Vector &y,
+                  const Vector &weights = Vector()) override;
+    void add_data_table(const RegressionDataTable &table) override;
+
+    // Add the rows of a design matrix owned by someone else, such as a
+    // matrix held by R and accessed through ToBoomMatrixView.  Rows are
+    // copied into the same 256-row blocks used by add_data_table, so the
+    // memory overhead is a single block no matter how large X is.
+    //
+    // Args:
+    //   X:  The design matrix, with one row per observation.
+    //   y:  The response vector.  Its length must match the rows of X.
+    void add_data_view(const ConstSubMatrix &X, const ConstVectorView &y);
+
+    // Add the rows of a design matrix stored in single precision.  Blocks
+    // of rows are converted to double before they are added, so the
+    // sufficient statistics are accumulated in double precision.
+    void add_data_view(const ConstFloatSubMatrix &X, const ConstVectorView &y);
+
     Vector vectorize(bool minimal = true) const override;
     Vector::const_iterator unvectorize(Vector::const_iterator &v,
                                        bool minimal = true) override;
@@ -434,6 +498,24 @@ namespace BOOM {
 
     void add_mixture_data(const Ptr<Data> &, double prob) override;
 
+    // Add the observations in 'table' to the model's sufficient statistics,
+    // without creating a RegressionData object for each observation.  The
+    // model switches to keeping only sufficient statistics (see
+    // only_keep_sufstats()), so any individual data points it held are
+    // dropped, though their contribution to the sufficient statistics is
+    // kept.
+    void add_data_table(const RegressionDataTable &table);
+
+    // Add a chunk of observations directly to the sufficient statistics.
+    // As with add_data_table, the model switches to keeping only
+    // sufficient statistics.
+    //
+    // Args:
+    //   X:  The design matrix for the chunk, with one row per observation.
+    //   y:  The responses for the chunk.
+    void add_data(const Matrix &X, const Vector &y);
+    using DataPolicy::add_data;
+
     //--- diagnostics ---
     AnovaTable anova() const { return suf()->anova(); }
   };
@@ -482,6 +564,19 @@ namespace BOOM {
     // Pass data to the primary model.  The set of candidate values are
     void stream_data_for_restricted_model(const RegressionData &data_point);
 
+    // Stream each observation in 'table', without creating a RegressionData
+    // object for each observation.
+    void stream_data_table_for_initial_screen(
+        const RegressionDataTable &table);
+    void stream_data_table_for_restricted_model(
+        const RegressionDataTable &table);
+
+    // Stream a chunk of observations.  Each row of X is the full predictor
+    // vector for one observation.  The chunk is added to the sufficient
+    // statistics with a single rank-k update per model.
+    void stream_data_for_initial_screen(const Matrix &X, const Vector &y);
+    void stream_data_for_restricted_model(const Matrix &X, const Vector &y);
+
     // Set the subset of variables to use in the final spike-and-slab run.
     void set_candidates(const Selector &candidates);
 
@@ -520,6 +615,43 @@ namespace BOOM {
 
     bool force_intercept() const {return force_intercept_;}
 
+    //---------------------------------------------------------------------
+    // Support for data that is spread across many machines.  Each machine
+    // holding a shard of the data builds a BigRegressionModel with the same
+    // xdim, subordinate_model_max_dim, and force_intercept, streams its
+    // shard, and ships the serialized sufficient statistics to a
+    // coordinator.  The coordinator merges the shards with
+    // combine_initial_screen_shards (or combine_restricted_model_shards)
+    // before calling BigAssSpikeSlabSampler::initial_screen (or
+    // sample_posterior).  The candidate set chosen by the initial screen
+    // must be sent back to each machine (through set_candidates) before the
+    // data are streamed for the restricted model.
+    //
+    // The sufficient statistics are sums, so shards can also be merged
+    // pairwise at intermediate machines by deserializing into a model,
+    // combining, and serializing again.
+
+    // The sufficient statistics of all the subordinate models, concatenated
+    // into a single vector.
+    Vector serialize_initial_screen_suf() const;
+
+    // The sufficient statistics of the restricted model.  It is an error to
+    // call this before set_candidates().
+    Vector serialize_restricted_model_suf() const;
+
+    // Add the serialized sufficient statistics from one or more shards to
+    // the statistics held by this model.  The shards are merged by a
+    // pairwise tree reduction, with the merges at each level of the tree
+    // spread across the global thread pool.  The reduction order depends
+    // only on the number of shards.
+    //
+    // Args:
+    //   shards: Each element is the output of serialize_initial_screen_suf()
+    //     (or of serialize_restricted_model_suf()) from a model with the
+    //     same structure as this one.
+    void combine_initial_screen_shards(const std::vector<Vector> &shards);
+    void combine_restricted_model_shards(const std::vector<Vector> &shards);
+
    private:
     // Indicates whether an intercept term is added to each of the subordinate
     // models.
@@ -537,6 +669,9 @@ namespace BOOM {
     Ptr<RegressionModel> restricted_model_;
 
     void create_subordinate_models(uint xdim, int max_worker_dim, bool force_intercept);
+
+    void stream_observation_for_initial_screen(double y,
+                                               const ConstVectorView &x);
   };
 
 
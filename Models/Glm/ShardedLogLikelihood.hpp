@@ -0,0 +1,136 @@
+// Copyright 2018 Google LLC. All Rights Reserved.
+/*
+  Copyright (C) 2005-2018 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#ifndef BOOM_GLM_SHARDED_LOG_LIKELIHOOD_HPP_
+#define BOOM_GLM_SHARDED_LOG_LIKELIHOOD_HPP_
+
+#include <algorithm>
+#include <vector>
+#include "LinAlg/Matrix.hpp"
+#include "LinAlg/Vector.hpp"
+#include "cpputil/ThreadTools.hpp"
+
+namespace BOOM {
+
+  // Evaluate a log likelihood, and optionally its gradient and Hessian, as a
+  // sum of contributions from contiguous blocks of observations.
+  //
+  // The observations are split into at most 'number_of_shards' shards of
+  // whole blocks.  The blocks in each shard are accumulated in order into
+  // the shard's own partial sums, and the partial sums are added to the
+  // totals in shard order.  The partition depends only on the number of
+  // observations, so the result is bit-for-bit the same for any number of
+  // threads in 'pool'.
+  //
+  // Args:
+  //   pool:  Supplies the threads used to evaluate the shards.
+  //   number_of_observations:  The number of observations in the data set.
+  //   block_size:  The number of observations passed to each call to
+  //     'accumulate'.
+  //   gradient: If non-NULL, the gradient contributions are added to
+  //     *gradient, which must already have the right size.
+  //   hessian: If non-NULL (and gradient is non-NULL), the Hessian
+  //     contributions are added to *hessian, which must already have the
+  //     right size.
+  //   accumulate: A callable with signature
+  //       double accumulate(int begin, int end, Vector *g, Matrix *h)
+  //     that adds the derivative contributions of observations [begin, end)
+  //     to g and h (when they are non-NULL) and returns their log
+  //     likelihood.  It is called concurrently from several threads, so it
+  //     must not modify shared state.
+  //   number_of_shards:  The maximum number of partial sums.
+  //
+  // Returns:
+  //   The sum of the log likelihood contributions.
+  template <class ACCUMULATOR>
+  double sharded_log_likelihood(SharedThreadPool &pool,
+                                int number_of_observations, int block_size,
+                                Vector *gradient, Matrix *hessian,
+                                ACCUMULATOR accumulate,
+                                int number_of_shards = 32) {
+    if (!gradient) hessian = nullptr;
+    int number_of_blocks =
+        (number_of_observations + block_size - 1) / block_size;
+    if (number_of_blocks == 0) return 0;
+    int blocks_per_shard =
+        (number_of_blocks + number_of_shards - 1) / number_of_shards;
+    int shard_size = blocks_per_shard * block_size;
+    number_of_shards =
+        (number_of_observations + shard_size - 1) / shard_size;
+
+    // Evaluate shard 'shard' into the partial sums g and h, which are
+    // sized and zeroed here.
+    auto evaluate_shard = [&](int shard, Vector *g, Matrix *h) {
+      if (g) {
+        g->resize(gradient->size());
+        *g = 0.0;
+        if (h) {
+          h->resize(hessian->nrow(), hessian->ncol());
+          *h = 0.0;
+        }
+      }
+      double ans = 0;
+      int shard_end = std::min<int>((shard + 1) * shard_size,
+                                    number_of_observations);
+      for (int begin = shard * shard_size; begin < shard_end;
+           begin += block_size) {
+        int end = std::min<int>(begin + block_size, shard_end);
+        ans += accumulate(begin, end, g, h);
+      }
+      return ans;
+    };
+
+    double ans = 0;
+    if (pool.no_threads()) {
+      // Shards are evaluated one at a time into a single workspace, and
+      // added to the totals in the same order as the threaded branch.
+      Vector g;
+      Matrix h;
+      for (int shard = 0; shard < number_of_shards; ++shard) {
+        ans += evaluate_shard(shard, gradient ? &g : nullptr,
+                              hessian ? &h : nullptr);
+        if (gradient) {
+          *gradient += g;
+          if (hessian) *hessian += h;
+        }
+      }
+      return ans;
+    }
+
+    std::vector<double> shard_log_likelihood(number_of_shards, 0.0);
+    std::vector<Vector> shard_gradient(gradient ? number_of_shards : 0);
+    std::vector<Matrix> shard_hessian(hessian ? number_of_shards : 0);
+    pool.parallel_for(0, number_of_shards, 1, [&](int shard) {
+      shard_log_likelihood[shard] = evaluate_shard(
+          shard, gradient ? &shard_gradient[shard] : nullptr,
+          hessian ? &shard_hessian[shard] : nullptr);
+    });
+    for (int shard = 0; shard < number_of_shards; ++shard) {
+      ans += shard_log_likelihood[shard];
+      if (gradient) {
+        *gradient += shard_gradient[shard];
+        if (hessian) *hessian += shard_hessian[shard];
+      }
+    }
+    return ans;
+  }
+
+}  // namespace BOOM
+
+#endif  // BOOM_GLM_SHARDED_LOG_LIKELIHOOD_HPP_
@@ -22,8 +22,10 @@
 
 #include <cmath>
 #include "Models/PosteriorSamplers/PosteriorSampler.hpp"
+#include "Models/StateSpace/Filters/SparseVector.hpp"
 #include "Models/SufstatAbstractCombineImpl.hpp"
 #include "cpputil/math_utils.hpp"
+#include "cpputil/report_error.hpp"
 
 namespace BOOM {
   typedef WeightedRegressionData WRD;
@@ -91,6 +93,7 @@ namespace BOOM {
   }
 
   Vector WRS::vectorize(bool minimal) const {
+    if (!sym_) make_symmetric();
     Vector ans = xtwx_.vectorize(minimal);
     ans.concat(xtwy_);
     ans.push_back(n_);
@@ -100,8 +103,10 @@ namespace BOOM {
     return ans;
   }
 
-  Vector::const_iterator WRS::unvectorize(Vector::const_iterator &v, bool) {
-    xtwx_.unvectorize(v);
+  Vector::const_iterator WRS::unvectorize(Vector::const_iterator &v,
+                                          bool minimal) {
+    xtwx_.unvectorize(v, minimal);
+    sym_ = true;
     uint dim = xtwy_.size();
     xtwy_.assign(v, v + dim);
     v += dim;
@@ -132,7 +137,7 @@ namespace BOOM {
     uint n = w.size();
     assert(y.size() == n && X.nrow() == n);
     clear();
-    for (uint i = 0; i < n; ++i) add_data(X.row(i), y[i], w[i]);
+    add_data(X, y, w);
   }
 
   void WRS::recompute(const std::vector<Ptr<WeightedRegressionData>> &data) {
@@ -168,6 +173,38 @@ namespace BOOM {
     sym_ = false;
   }
 
+  void WRS::add_data(const SparseVector &x, double y, double w) {
+    if (x.size() != xtwy_.size()) {
+      report_error("Wrong size predictor passed to WeightedRegSuf::add_data.");
+    }
+    ++n_;
+    yt_w_y_ += w * y * y;
+    sumw_ += w;
+    sumlogw_ += log(w);
+    // Both triangles are updated, so the symmetry status of xtwx_ is
+    // unchanged.
+    x.add_outer_product(xtwx_, w);
+    x.add_this_to(xtwy_, w * y);
+  }
+
+  void WRS::add_data(const Matrix &X, const Vector &y, const Vector &w) {
+    int n = X.nrow();
+    if (y.size() != n || w.size() != n || X.ncol() != xtwy_.size()) {
+      report_error("Wrong size arguments passed to WeightedRegSuf::add_data.");
+    }
+    if (n == 0) return;
+    Vector wy = w * y;
+    n_ += n;
+    yt_w_y_ += wy.dot(y);
+    sumw_ += w.sum();
+    for (int i = 0; i < n; ++i) {
+      sumlogw_ += log(w[i]);
+    }
+    xtwx_.add_inner(X, w, false);
+    xtwy_ += X.Tmult(wy);
+    sym_ = false;
+  }
+
   void WRS::remove_data(const Vector &x, double y, double w) {
     // All the sums can be deprecated by calling add_data with -w for a weight,
     // but this adds 1 to n_.  We need to remove that 1, and 1 more for the data
@@ -201,6 +238,15 @@ namespace BOOM {
   Vector WRS::xty(const Selector &inc) const { return inc.select(xtwy_); }
   SpdMatrix WRS::xtx(const Selector &inc) const { return inc.select(xtx()); }
 
+  void WRS::fill_xtx(const Selector &inc, SpdMatrix &ans) const {
+    if (!sym_) make_symmetric();
+    inc.select_into(xtwx_, ans);
+  }
+
+  void WRS::fill_xty(const Selector &inc, Vector &ans) const {
+    inc.select_into(xtwy_, ans);
+  }
+
   Vector WRS::beta_hat() const { return xtx().solve(xtwy_); }
 
   double WRS::weighted_sum_of_squared_errors(const Vector &beta) const {
@@ -74,6 +74,16 @@ namespace BOOM {
 
     void Update(const WeightedRegressionData &) override;
     void add_data(const Vector &x, double y, double w);
+
+    // Add an observation with a sparse predictor vector.  The cost is
+    // quadratic in the number of nonzero elements of x.
+    void add_data(const SparseVector &x, double y, double w);
+
+    // Add each row of X as an observation, with the corresponding elements
+    // of y and w as its response and weight.  The cross product matrix is
+    // updated with a single rank-k update rather than one outer product per
+    // row.
+    void add_data(const Matrix &X, const Vector &y, const Vector &w);
     void remove_data(const Vector &x, double y, double w);
 
     void clear() override;
@@ -83,6 +93,13 @@ namespace BOOM {
     virtual SpdMatrix xtx() const;                  // X^T W X
     virtual Vector xty(const Selector &) const;     // X^T W Y
     virtual SpdMatrix xtx(const Selector &) const;  // X^T W X
+
+    // xtx(inc) and xty(inc), written into caller-owned storage that is
+    // resized if needed.  Samplers that need the statistics every MCMC
+    // iteration can use these to avoid allocating.
+    void fill_xtx(const Selector &inc, SpdMatrix &ans) const;
+    void fill_xty(const Selector &inc, Vector &ans) const;
+
     virtual Vector beta_hat() const;                // WLS estimate
     double weighted_sum_of_squared_errors(const Vector &beta) const;
     virtual double SSE() const;   //
@@ -17,14 +17,20 @@
   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
 */
 #include "Models/Glm/ZeroInflatedLognormalRegression.hpp"
+#include "Models/Glm/ShardedLogLikelihood.hpp"
 #include "cpputil/math_utils.hpp"
 #include "cpputil/report_error.hpp"
 #include "distributions.hpp"
+#include "stats/logit.hpp"
 
 namespace BOOM {
 
   namespace {
     typedef ZeroInflatedLognormalRegressionModel ZILRM;
+
+    // The number of observations in each block of the logistic regression
+    // log likelihood.  Blocks are the unit of work assigned to threads.
+    const int logit_block_size = 256;
   }  // namespace
 
   ZILRM::ZeroInflatedLognormalRegressionModel(int dimension,
@@ -109,19 +115,28 @@ namespace BOOM {
                                double sigsq) const {
     double loglike =
         RegressionModel::log_likelihood(regression_coefficients, sigsq, *suf());
+    return loglike + sharded_log_likelihood(
+        pool_, dat().size(), logit_block_size, nullptr, nullptr,
+        [this, &logit_coefficients](int begin, int end, Vector *, Matrix *) {
+          return logit_log_likelihood(begin, end, logit_coefficients);
+        });
+  }
+
+  double ZILRM::logit_log_likelihood(int begin, int end,
+                                     const Vector &logit_coefficients) const {
     const std::vector<Ptr<RegressionData>> &data(dat());
-    for (int i = 0; i < data.size(); ++i) {
-      bool success = data[i]->y() > zero_threshold_;
-      double log_odds = logit_coefficients.dot(data[i]->x());
-      // log [(p/q)^y * q] = y * eta + log(q)
-      loglike += success * log_odds +
-                 plogis(log_odds,
-                        0,      // location
-                        1,      // scale
-                        false,  // lower tail, because we want log q not log p.
-                        true);  // logscale
+    Matrix predictors(end - begin, logit_coefficients.size());
+    for (int i = begin; i < end; ++i) {
+      predictors.row(i - begin) = data[i]->x();
+    }
+    Vector log_odds = predictors * logit_coefficients;
+    double ans = 0;
+    for (int i = begin; i < end; ++i) {
+      double eta = log_odds[i - begin];
+      // log [(p/q)^y * q] = y * eta + log(q), and log(q) = -log(1 + e^eta).
+      ans += (data[i]->y() > zero_threshold_) * eta - lope(eta);
     }
-    return loglike;
+    return ans;
   }
 
   double ZILRM::sim(const Vector &x, RNG &rng) const {
@@ -27,6 +27,7 @@
 #include "Models/Policies/IID_DataPolicy.hpp"
 #include "Models/Policies/ParamPolicy_3.hpp"
 #include "Models/Policies/PriorPolicy.hpp"
+#include "cpputil/ThreadTools.hpp"
 
 namespace BOOM {
 
@@ -82,16 +83,27 @@ namespace BOOM {
     // Observations smaller than this number will be treated as zero.
     double zero_threshold() const { return zero_threshold_; }
 
+    // The logistic regression portion of the log likelihood is evaluated in
+    // blocks of observations, which are split among the threads set by
+    // set_number_of_threads().  The result does not depend on the number of
+    // threads.
     double log_likelihood(const Vector &logit_coefficients,
                           const Vector &regression_coefficients,
                           double sigsq) const;
+    void set_number_of_threads(int n) { pool_.set_number_of_threads(n); }
+
     double sim(const Vector &x, RNG &rng = BOOM::GlobalRng::rng) const;
 
     HierarchicalZeroInflatedGammaData simulate_sufficient_statistics(
         const Vector &x, int64_t n, RNG &rng = BOOM::GlobalRng::rng) const;
 
    private:
+    // The logistic regression log likelihood of observations [begin, end).
+    double logit_log_likelihood(int begin, int end,
+                                const Vector &logit_coefficients) const;
+
     double zero_threshold_;
+    mutable SharedThreadPool pool_;
   };
 
 }  // namespace BOOM
@@ -0,0 +1,111 @@
+#include "gtest/gtest.h"
+#include "Models/Glm/AggregatedRegressionModel.hpp"
+#include "distributions.hpp"
+#include "stats/moments.hpp"
+#include "test_utils/test_utils.hpp"
+
+namespace {
+  using namespace BOOM;
+
+  double correlation(const Vector &x, const Vector &y) {
+    return (x - mean(x)).dot(y - mean(y)) / ((x.size() - 1) * sd(x) * sd(y));
+  }
+
+  class AggregatedRegressionTest : public ::testing::Test {
+   protected:
+    AggregatedRegressionTest()
+        : xdim_(3),
+          sigma_(1.3),
+          beta_{1.0, 2.0, -.5}
+    {
+      GlobalRng::rng.seed(8675309);
+      group_sizes_ = {40, 7, 1};
+      group_totals_ = {120.0, 15.0, 4.0};
+      int nobs = 0;
+      for (int size : group_sizes_) nobs += size;
+      predictors_.resize(nobs, xdim_);
+      predictors_.randomize();
+      predictors_.col(0) = 1.0;
+      for (int g = 0; g < group_sizes_.size(); ++g) {
+        for (int i = 0; i < group_sizes_[g]; ++i) {
+          group_names_.push_back(std::to_string(g));
+          group_values_.push_back(group_totals_[g]);
+        }
+      }
+    }
+
+    // Draw the unit values in each group directly from their conditional
+    // distribution given the group total, and return y'y.  Element i of
+    // 'xty' is set to X'y.
+    double brute_force_draw(Vector &xty) {
+      Vector y(predictors_.nrow());
+      int start = 0;
+      for (int g = 0; g < group_sizes_.size(); ++g) {
+        int n = group_sizes_[g];
+        Vector errors(n);
+        rnorm_mt(GlobalRng::rng, errors);
+        errors -= errors.sum() / n;
+        double sum_of_means = 0;
+        for (int i = 0; i < n; ++i) {
+          y[start + i] = predictors_.row(start + i).dot(beta_);
+          sum_of_means += y[start + i];
+        }
+        for (int i = 0; i < n; ++i) {
+          y[start + i] += (group_totals_[g] - sum_of_means) / n
+              + sigma_ * errors[i];
+        }
+        start += n;
+      }
+      xty = predictors_.Tmult(y);
+      return y.normsq();
+    }
+
+    int xdim_;
+    double sigma_;
+    Vector beta_;
+    std::vector<int> group_sizes_;
+    Vector group_totals_;
+    Matrix predictors_;
+    std::vector<std::string> group_names_;
+    Vector group_values_;
+  };
+
+  // The collapsed draws of X'y and y'y should have the same distribution as
+  // the statistics computed from an explicit draw of the unit values.
+  TEST_F(AggregatedRegressionTest, CollapsedSufficientStatistics) {
+    NEW(AggregatedRegressionModel, model)(
+        predictors_, group_names_, group_values_, "");
+    model->set_beta(beta_);
+    model->set_sigma(sigma_);
+    Ptr<RegSuf> suf = model->regression_model()->suf();
+    SpdMatrix original_xtx = suf->xtx();
+
+    int niter = 10000;
+    Vector collapsed_yty(niter);
+    Vector brute_force_yty(niter);
+    Vector collapsed_xty(niter);
+    Vector brute_force_xty(niter);
+    Vector xty;
+    RNG rng(12345);
+    for (int i = 0; i < niter; ++i) {
+      model->draw_collapsed_sufficient_statistics(rng);
+      collapsed_yty[i] = suf->yty();
+      collapsed_xty[i] = suf->xty()[1];
+      brute_force_yty[i] = brute_force_draw(xty);
+      brute_force_xty[i] = xty[1];
+    }
+    EXPECT_TRUE(MatrixEquals(suf->xtx(), original_xtx));
+    EXPECT_DOUBLE_EQ(suf->n(), predictors_.nrow());
+    EXPECT_NEAR(suf->ybar() * suf->n(), group_totals_.sum(), 1e-8);
+
+    double yty_se = sd(brute_force_yty) / sqrt(niter);
+    EXPECT_NEAR(mean(collapsed_yty), mean(brute_force_yty), 4 * yty_se);
+    EXPECT_NEAR(sd(collapsed_yty) / sd(brute_force_yty), 1.0, .05);
+    double xty_se = sd(brute_force_xty) / sqrt(niter);
+    EXPECT_NEAR(mean(collapsed_xty), mean(brute_force_xty), 4 * xty_se);
+    EXPECT_NEAR(sd(collapsed_xty) / sd(brute_force_xty), 1.0, .05);
+    EXPECT_NEAR(correlation(collapsed_xty, collapsed_yty),
+                correlation(brute_force_xty, brute_force_yty), .05);
+  }
+
+}  // namespace
@@ -132,6 +132,180 @@ namespace {
     EXPECT_TRUE(VectorEquals(m1->suf()->xty(), x1 * y));
   }
 
+  TEST_F(BigRegressionTest, StreamDataTable) {
+    int total_predictor_dim = 10;
+    int max_model_dim = 4;
+    int sample_size = 50;
+    SimulatePredictors(sample_size, total_predictor_dim);
+    SimulateCoefficients(3);
+    SimulateResponse();
+    FillRegressionData();
+    RegressionDataTable table(predictors_, response_);
+
+    NEW(BigRegressionModel, model)(total_predictor_dim, max_model_dim);
+    NEW(BigRegressionModel, table_model)(total_predictor_dim, max_model_dim);
+    for (int i = 0; i < sample_size; ++i) {
+      model->stream_data_for_initial_screen(*regression_data_[i]);
+    }
+    table_model->stream_data_table_for_initial_screen(table);
+    for (int m = 0; m < model->number_of_subordinate_models(); ++m) {
+      EXPECT_TRUE(MatrixEquals(model->subordinate_model(m)->suf()->xtx(),
+                               table_model->subordinate_model(m)->suf()->xtx()));
+      EXPECT_TRUE(VectorEquals(model->subordinate_model(m)->suf()->xty(),
+                               table_model->subordinate_model(m)->suf()->xty()));
+    }
+
+    Selector candidates({1, 5, 6}, total_predictor_dim);
+    model->set_candidates(candidates);
+    table_model->set_candidates(candidates);
+    for (int i = 0; i < sample_size; ++i) {
+      model->stream_data_for_restricted_model(*regression_data_[i]);
+    }
+    table_model->stream_data_table_for_restricted_model(table);
+    EXPECT_TRUE(MatrixEquals(model->restricted_model()->suf()->xtx(),
+                             table_model->restricted_model()->suf()->xtx()));
+    EXPECT_TRUE(VectorEquals(model->restricted_model()->suf()->xty(),
+                             table_model->restricted_model()->suf()->xty()));
+
+    // Stream the same data as two chunks of a design matrix.
+    NEW(BigRegressionModel, chunk_model)(total_predictor_dim, max_model_dim);
+    int split = 20;
+    int ncol = predictors_.ncol();
+    Matrix X1 = SubMatrix(predictors_, 0, split - 1, 0, ncol - 1).to_matrix();
+    Matrix X2 = SubMatrix(predictors_, split, sample_size - 1, 0, ncol - 1)
+        .to_matrix();
+    Vector y1(ConstVectorView(response_, 0, split));
+    Vector y2(ConstVectorView(response_, split, sample_size - split));
+    chunk_model->stream_data_for_initial_screen(X1, y1);
+    chunk_model->stream_data_for_initial_screen(X2, y2);
+    for (int m = 0; m < model->number_of_subordinate_models(); ++m) {
+      EXPECT_TRUE(MatrixEquals(model->subordinate_model(m)->suf()->xtx(),
+                               chunk_model->subordinate_model(m)->suf()->xtx()));
+      EXPECT_TRUE(VectorEquals(model->subordinate_model(m)->suf()->xty(),
+                               chunk_model->subordinate_model(m)->suf()->xty()));
+    }
+    chunk_model->set_candidates(candidates);
+    chunk_model->stream_data_for_restricted_model(X1, y1);
+    chunk_model->stream_data_for_restricted_model(X2, y2);
+    EXPECT_TRUE(MatrixEquals(model->restricted_model()->suf()->xtx(),
+                             chunk_model->restricted_model()->suf()->xtx()));
+    EXPECT_THROW(chunk_model->stream_data_for_initial_screen(
+        Matrix(3, total_predictor_dim + 1), Vector(3)), std::exception);
+  }
+
+  // Data streamed into several shards and merged should give the same
+  // sufficient statistics as streaming all the data into one model.
+  TEST_F(BigRegressionTest, CombineShards) {
+    int total_predictor_dim = 10;
+    int max_model_dim = 4;
+    int sample_size = 200;
+    int nshards = 5;
+    SimulatePredictors(sample_size, total_predictor_dim);
+    SimulateCoefficients(3);
+    SimulateResponse();
+    FillRegressionData();
+
+    NEW(BigRegressionModel, full_model)(total_predictor_dim, max_model_dim);
+    std::vector<Ptr<BigRegressionModel>> shard_models;
+    for (int s = 0; s < nshards; ++s) {
+      shard_models.push_back(new BigRegressionModel(
+          total_predictor_dim, max_model_dim));
+    }
+    for (int i = 0; i < sample_size; ++i) {
+      full_model->stream_data_for_initial_screen(*regression_data_[i]);
+      shard_models[i % nshards]->stream_data_for_initial_screen(
+          *regression_data_[i]);
+    }
+    std::vector<Vector> shards;
+    for (int s = 0; s < nshards; ++s) {
+      shards.push_back(shard_models[s]->serialize_initial_screen_suf());
+    }
+
+    NEW(BigRegressionModel, coordinator)(total_predictor_dim, max_model_dim);
+    coordinator->combine_initial_screen_shards(shards);
+    EXPECT_EQ(full_model->number_of_subordinate_models(),
+              coordinator->number_of_subordinate_models());
+    for (int m = 0; m < full_model->number_of_subordinate_models(); ++m) {
+      Ptr<RegSuf> expected = full_model->subordinate_model(m)->suf();
+      Ptr<RegSuf> merged = coordinator->subordinate_model(m)->suf();
+      EXPECT_TRUE(MatrixEquals(expected->xtx(), merged->xtx()));
+      EXPECT_TRUE(VectorEquals(expected->xty(), merged->xty()));
+      EXPECT_TRUE(VectorEquals(expected->xbar(), merged->xbar()));
+      EXPECT_NEAR(expected->yty(), merged->yty(), 1e-8);
+      EXPECT_DOUBLE_EQ(expected->n(), merged->n());
+    }
+
+    Selector candidates({0, 2, 7}, total_predictor_dim);
+    full_model->set_candidates(candidates);
+    coordinator->set_candidates(candidates);
+    shards.clear();
+    for (int s = 0; s < nshards; ++s) {
+      shard_models[s]->set_candidates(candidates);
+    }
+    for (int i = 0; i < sample_size; ++i) {
+      full_model->stream_data_for_restricted_model(*regression_data_[i]);
+      shard_models[i % nshards]->stream_data_for_restricted_model(
+          *regression_data_[i]);
+    }
+    for (int s = 0; s < nshards; ++s) {
+      shards.push_back(shard_models[s]->serialize_restricted_model_suf());
+    }
+    coordinator->combine_restricted_model_shards(shards);
+    EXPECT_TRUE(MatrixEquals(full_model->restricted_model()->suf()->xtx(),
+                             coordinator->restricted_model()->suf()->xtx()));
+    EXPECT_TRUE(VectorEquals(full_model->restricted_model()->suf()->xty(),
+                             coordinator->restricted_model()->suf()->xty()));
+
+    shards.back().pop_back();
+    EXPECT_THROW(coordinator->combine_restricted_model_shards(shards),
+                 std::exception);
+  }
+
+  // Threaded and unthreaded initial screens with the same seed give the same
+  // answer, regardless of the number of models run at once.
+  TEST_F(BigRegressionTest, InitialScreenScheduling) {
+    int max_model_dim = 7;
+    int total_predictor_dim = 30;
+    int sample_size = 200;
+    SimulatePredictors(sample_size, total_predictor_dim);
+    SimulateCoefficients(4);
+    SimulateResponse();
+    FillRegressionData();
+
+    std::vector<Ptr<BigRegressionModel>> models;
+    std::vector<Ptr<BigAssSpikeSlabSampler>> samplers;
+    for (int i = 0; i < 2; ++i) {
+      NEW(BigRegressionModel, model)(total_predictor_dim, max_model_dim);
+      for (int j = 0; j < sample_size; ++j) {
+        model->stream_data_for_initial_screen(*regression_data_[j]);
+      }
+      NEW(ChisqModel, residual_precision_prior)(1.0, 1.0);
+      NEW(VariableSelectionPrior, spike)(total_predictor_dim, .2);
+      NEW(RegressionSlabPrior, slab)(SpdMatrix(1), model->Sigsq_prm(),
+                                     1.0, 1.0, 5.0, 0.1);
+      GlobalRng::rng.seed(31337);
+      NEW(BigAssSpikeSlabSampler, sampler)(
+          model.get(), spike, slab, residual_precision_prior);
+      model->set_method(sampler);
+      models.push_back(model);
+      samplers.push_back(sampler);
+    }
+    EXPECT_EQ(0, samplers[0]->max_initial_screen_concurrency());
+    samplers[0]->set_max_initial_screen_concurrency(2);
+    samplers[0]->initial_screen(20, .2, true);
+    samplers[1]->initial_screen(20, .2, false);
+
+    int nmodels = models[0]->number_of_subordinate_models();
+    EXPECT_GT(nmodels, 2);
+    ASSERT_EQ(nmodels, samplers[0]->initial_screen_wall_time().size());
+    for (int m = 0; m < nmodels; ++m) {
+      EXPECT_EQ(models[0]->subordinate_model(m)->inc(),
+                models[1]->subordinate_model(m)->inc());
+      EXPECT_GT(samplers[0]->initial_screen_wall_time()[m], 0.0);
+      EXPECT_GT(samplers[1]->initial_screen_wall_time()[m], 0.0);
+    }
+  }
+
   // A setting where there are some obvious variables for the sampler to find,
   // with some obviously important variables located in different shards.
   TEST_F(BigRegressionTest, FindsRightVariables) {
@@ -5,7 +5,13 @@
 #include "Models/Glm/VariableSelectionPrior.hpp"
 #include "distributions.hpp"
 #include "Models/Glm/BinomialLogitModel.hpp"
+#include "Models/Glm/LogisticRegressionModel.hpp"
+#include "Models/Glm/PosteriorSamplers/BinomialLogitAuxmixSampler.hpp"
 #include "Models/Glm/PosteriorSamplers/BinomialLogitDataImputer.hpp"
+#include "Models/Glm/PosteriorSamplers/BinomialLogitSamplerTim.hpp"
+#include "Models/Glm/PosteriorSamplers/BinomialLogitSpikeSlabSampler.hpp"
+#include "Models/MvnModel.hpp"
+#include "stats/moments.hpp"
 
 #include "test_utils/test_utils.hpp"
 #include <fstream>
@@ -29,5 +35,248 @@ namespace {
     BinomialLogitCltDataImputer clt_imputer;
     BinomialLogitPartialAugmentationDataImputer pa_imputer;
   }
-  
+
+  // A logistic regression is a binomial logit model with one trial per
+  // observation.  The two models' log likelihoods agree at an arbitrary
+  // coefficient vector, with or without threads.
+  TEST_F(BinomialLogitTest, ThreadedLogLikelihood) {
+    Vector beta = {-.5, 1.0, .3};
+    NEW(LogisticRegressionModel, logistic)(beta.size());
+    NEW(BinomialLogitModel, binomial)(beta.size());
+    for (int i = 0; i < 5000; ++i) {
+      Vector x(beta.size());
+      x.randomize();
+      x[0] = 1.0;
+      bool y = runif() < plogis(beta.dot(x));
+      logistic->add_data(new BinaryRegressionData(y, x));
+      binomial->add_data(new BinomialRegressionData(y, 1, x));
+    }
+
+    Vector coefficients = {-.3, .8, .2};
+    Vector logistic_gradient, binomial_gradient, threaded_gradient;
+    Matrix logistic_hessian, binomial_hessian, threaded_hessian;
+    double loglike = logistic->log_likelihood(coefficients, &logistic_gradient,
+                                              &logistic_hessian);
+    EXPECT_NEAR(loglike,
+                binomial->log_likelihood(coefficients, &binomial_gradient,
+                                         &binomial_hessian),
+                1e-8);
+    EXPECT_TRUE(VectorEquals(logistic_gradient, binomial_gradient));
+    EXPECT_TRUE(MatrixEquals(logistic_hessian, binomial_hessian));
+
+    logistic->set_number_of_threads(3);
+    EXPECT_EQ(loglike, logistic->log_likelihood(
+                           coefficients, &threaded_gradient, &threaded_hessian));
+    EXPECT_EQ(0.0, (logistic_gradient - threaded_gradient).max_abs());
+    EXPECT_EQ(0.0, (logistic_hessian - threaded_hessian).max_abs());
+
+    double binomial_loglike = binomial->log_likelihood(
+        coefficients, &binomial_gradient, &binomial_hessian);
+    binomial->set_number_of_threads(3);
+    EXPECT_EQ(binomial_loglike,
+              binomial->log_likelihood(coefficients, &threaded_gradient,
+                                       &threaded_hessian));
+    EXPECT_EQ(0.0, (binomial_gradient - threaded_gradient).max_abs());
+    EXPECT_EQ(0.0, (binomial_hessian - threaded_hessian).max_abs());
+  }
+
+  // Above the CLT threshold the imputer draws the mixture component counts
+  // and then the sum of the latent logits.  Below it each trial is imputed
+  // separately.  Both describe the same distribution, so their moments
+  // should agree.
+  TEST_F(BinomialLogitTest, CltImputerMatchesExactImputation) {
+    BinomialLogitCltDataImputer clt_imputer(10);
+    BinomialLogitCltDataImputer exact_imputer(1000);
+    int niter = 20000;
+    double trials = 15;
+    double successes = 4;
+    double eta = -0.7;
+    Vector clt_sum(niter), clt_information(niter);
+    Vector exact_sum(niter), exact_information(niter);
+    for (int i = 0; i < niter; ++i) {
+      std::pair<double, double> clt = clt_imputer.impute(
+          GlobalRng::rng, trials, successes, eta);
+      clt_sum[i] = clt.first;
+      clt_information[i] = clt.second;
+      std::pair<double, double> exact = exact_imputer.impute(
+          GlobalRng::rng, trials, successes, eta);
+      exact_sum[i] = exact.first;
+      exact_information[i] = exact.second;
+    }
+    double information_se = sqrt(
+        (var(clt_information) + var(exact_information)) / niter);
+    EXPECT_NEAR(mean(clt_information), mean(exact_information),
+                4 * information_se);
+    double sum_se = sqrt((var(clt_sum) + var(exact_sum)) / niter);
+    EXPECT_NEAR(mean(clt_sum), mean(exact_sum), 4 * sum_se);
+    EXPECT_NEAR(sd(clt_sum), sd(exact_sum), .05 * sd(exact_sum));
+
+    // An observation with no trials carries no information.
+    std::pair<double, double> empty = exact_imputer.impute(
+        GlobalRng::rng, 0, 0, eta);
+    EXPECT_DOUBLE_EQ(0.0, empty.second);
+  }
+
+  // The complete data sufficient statistics buffer rows between block
+  // updates of xtx.  Check them against a direct computation, when the
+  // sample size is not a multiple of the block size.
+  TEST_F(BinomialLogitTest, BufferedSufficientStatistics) {
+    int n = 150;
+    int p = 4;
+    Matrix X(n, p);
+    X.randomize();
+    Vector z(n);
+    z.randomize();
+    Vector w(n);
+    w.randomize();
+
+    SpdMatrix xtwx(p, 0.0);
+    Vector xtwz(p, 0.0);
+    BinomialLogit::SufficientStatistics suf(p);
+    BinomialLogit::SufficientStatistics first_half(p);
+    BinomialLogit::SufficientStatistics second_half(p);
+    for (int i = 0; i < n; ++i) {
+      Vector x = X.row(i);
+      xtwx.add_outer(x, w[i]);
+      xtwz.axpy(x, w[i] * z[i]);
+      suf.update(x, w[i] * z[i], w[i]);
+      if (i < 70) {
+        first_half.update(x, w[i] * z[i], w[i]);
+      } else {
+        second_half.update(x, w[i] * z[i], w[i]);
+      }
+    }
+    EXPECT_EQ(n, suf.sample_size());
+    EXPECT_TRUE(MatrixEquals(xtwx, suf.xtx()));
+    EXPECT_TRUE(VectorEquals(xtwz, suf.xty()));
+
+    first_half.combine(second_half);
+    EXPECT_EQ(n, first_half.sample_size());
+    EXPECT_TRUE(MatrixEquals(xtwx, first_half.xtx()));
+
+    Ptr<BinomialLogit::SufficientStatistics> copy(suf.clone());
+    copy->update(X.row(0), 1.0, 2.0);
+    xtwx.add_outer(X.row(0), 2.0);
+    EXPECT_TRUE(MatrixEquals(xtwx, copy->xtx()));
+
+    suf.clear();
+    EXPECT_TRUE(MatrixEquals(SpdMatrix(p, 0.0), suf.xtx()));
+  }
+
+  // The model indicator sweep updates Cholesky factors as variables enter
+  // and leave the model.  Check that the sampler still finds the right
+  // variables.
+  TEST_F(BinomialLogitTest, SpikeSlabFindsSignal) {
+    int n = 500;
+    int p = 8;
+    Vector beta(p, 0.0);
+    beta[0] = -.5;
+    beta[2] = 1.5;
+    beta[5] = -2.0;
+    NEW(BinomialLogitModel, model)(p);
+    for (int i = 0; i < n; ++i) {
+      Vector x(p);
+      x.randomize();
+      x[0] = 1.0;
+      double trials = 10;
+      double prob = plogis(x.dot(beta));
+      model->add_data(new BinomialRegressionData(
+          rbinom(trials, prob), trials, x));
+    }
+
+    NEW(MvnModel, slab)(Vector(p, 0.0), SpdMatrix(p, 1.0));
+    NEW(VariableSelectionPrior, spike)(p, .5);
+    NEW(BinomialLogitSpikeSlabSampler, sampler)(model.get(), slab, spike, 5);
+    model->set_method(sampler);
+    model->coef().drop_all();
+    model->coef().add(0);
+
+    int niter = 100;
+    Vector inclusion_frequency(p, 0.0);
+    for (int i = 0; i < niter; ++i) {
+      model->sample_posterior();
+      if (i >= niter / 2) {
+        for (int j = 0; j < p; ++j) {
+          inclusion_frequency[j] += model->coef().inc(j);
+        }
+      }
+    }
+    inclusion_frequency /= niter / 2;
+    EXPECT_GT(inclusion_frequency[2], .9);
+    EXPECT_GT(inclusion_frequency[5], .9);
+    EXPECT_LT(inclusion_frequency[1], .5);
+    EXPECT_LT(inclusion_frequency[3], .5);
+  }
+
+  // With mode caching, a TIM sampler whose mode is not stable reuses its
+  // modal approximation while the proposal keeps being accepted, instead
+  // of locating the mode on every draw.
+  TEST_F(BinomialLogitTest, TimModeCaching) {
+    int n = 500;
+    Vector beta = {-.5, 1.0, .3};
+    NEW(BinomialLogitModel, model)(beta.size());
+    for (int i = 0; i < n; ++i) {
+      Vector x(beta.size());
+      x.randomize();
+      x[0] = 1.0;
+      model->add_data(new BinomialRegressionData(
+          rbinom(5, plogis(x.dot(beta))), 5, x));
+    }
+    NEW(MvnModel, prior)(Vector(beta.size(), 0.0),
+                         SpdMatrix(beta.size(), 10.0));
+
+    NEW(BinomialLogitSamplerTim, uncached)(model.get(), prior, false);
+    NEW(BinomialLogitSamplerTim, cached)(model.get(), prior, false);
+    cached->cache_mode(.5);
+    int niter = 200;
+    Matrix draws(niter, beta.size());
+    for (int i = 0; i < niter; ++i) {
+      uncached->draw();
+      cached->draw();
+      draws.row(i) = model->Beta();
+    }
+    EXPECT_EQ(niter, uncached->number_of_mode_searches());
+    EXPECT_LT(cached->number_of_mode_searches(), niter / 10);
+    EXPECT_TRUE(VectorEquals(beta, mean(draws), .2)) << mean(draws);
+  }
+
+  // With a fixed imputation block size the auxiliary mixture sampler
+  // produces the same draws for any number of threads.
+  TEST_F(BinomialLogitTest, BlockImputationIsThreadCountInvariant) {
+    int n = 1000;
+    Vector beta = {-.5, 1.0, .3};
+    std::vector<Ptr<BinomialRegressionData>> data;
+    for (int i = 0; i < n; ++i) {
+      Vector x(beta.size());
+      x.randomize();
+      x[0] = 1.0;
+      data.push_back(new BinomialRegressionData(
+          rbinom(3, plogis(x.dot(beta))), 3, x));
+    }
+
+    std::vector<Matrix> draws;
+    for (int nthreads : {1, 3, 8}) {
+      NEW(BinomialLogitModel, model)(beta.size());
+      for (const auto &dp : data) {
+        model->add_data(dp);
+      }
+      NEW(MvnModel, prior)(Vector(beta.size(), 0.0),
+                           SpdMatrix(beta.size(), 10.0));
+      RNG seeding_rng(12345);
+      NEW(BinomialLogitAuxmixSampler, sampler)(
+          model.get(), prior, 10, seeding_rng);
+      sampler->set_imputation_block_size(64);
+      sampler->set_number_of_workers(nthreads);
+      int niter = 10;
+      Matrix beta_draws(niter, beta.size());
+      for (int i = 0; i < niter; ++i) {
+        sampler->draw();
+        beta_draws.row(i) = model->Beta();
+      }
+      draws.push_back(beta_draws);
+    }
+    EXPECT_EQ(draws[0], draws[1]);
+    EXPECT_EQ(draws[0], draws[2]);
+  }
+
 }  // namespace
@@ -6,7 +6,11 @@
 #include "Models/Glm/BinomialProbitModel.hpp"
 #include "Models/Glm/PosteriorSamplers/BinomialProbitDataImputer.hpp"
 #include "Models/Glm/PosteriorSamplers/BinomialProbitCompositeSpikeSlabSampler.hpp"
+#include "Models/Glm/PosteriorSamplers/BinomialProbitSpikeSlabSampler.hpp"
+#include "Models/Glm/PosteriorSamplers/ProbitRegressionSampler.hpp"
+#include "Models/Glm/ProbitRegression.hpp"
 
+#include "stats/moments.hpp"
 #include "test_utils/test_utils.hpp"
 #include <fstream>
 
@@ -118,5 +122,70 @@ namespace {
       model->sample_posterior();
     }
   }
-  
+
+  // Latent data imputation spread across several workers should cover all
+  // the data, including data added after the workers were created.
+  TEST_F(BinomialProbitTest, ParallelImputation) {
+    int nobs = 2000;
+    int xdim = 3;
+    Matrix predictors(nobs, xdim);
+    predictors.randomize();
+    predictors.col(0) = 1.0;
+    Vector beta = {-.5, 1.0, -1.0};
+    Vector eta = predictors * beta;
+
+    NEW(BinomialProbitModel, binomial_model)(xdim);
+    NEW(ProbitRegressionModel, binary_model)(Vector(xdim, 0.0));
+    for (int i = 0; i < nobs; ++i) {
+      double prob = pnorm(eta[i]);
+      int n = 1 + rpois(4.0);
+      binomial_model->add_data(new BinomialRegressionData(
+          rbinom(n, prob), n, predictors.row(i)));
+      binary_model->add_data(new BinaryRegressionData(
+          runif(0, 1) < prob, predictors.row(i)));
+    }
+
+    NEW(MvnModel, slab)(Vector(xdim, 0.0), SpdMatrix(xdim, 100.0));
+    NEW(VariableSelectionPrior, spike)(xdim, .99);
+    NEW(BinomialProbitSpikeSlabSampler, binomial_sampler)(
+        binomial_model.get(), slab, spike);
+    binomial_sampler->allow_model_selection(false);
+    binomial_sampler->set_number_of_workers(4);
+    binomial_model->set_method(binomial_sampler);
+
+    NEW(ProbitRegressionSampler, binary_sampler)(binary_model.get(), slab);
+    binary_sampler->set_number_of_workers(3);
+    binary_model->set_method(binary_sampler);
+
+    // Data added after the workers were created must also be imputed.
+    for (int i = 0; i < 100; ++i) {
+      Vector x(xdim);
+      x.randomize();
+      x[0] = 1.0;
+      binary_model->add_data(new BinaryRegressionData(
+          runif(0, 1) < pnorm(beta.dot(x)), x));
+    }
+    binary_sampler->refresh_xtx();
+
+    int niter = 200;
+    int burn = 50;
+    Matrix binomial_draws(niter - burn, xdim);
+    Matrix binary_draws(niter - burn, xdim);
+    for (int i = 0; i < niter; ++i) {
+      binomial_model->sample_posterior();
+      binary_model->sample_posterior();
+      if (i >= burn) {
+        binomial_draws.row(i - burn) = binomial_model->Beta();
+        binary_draws.row(i - burn) = binary_model->Beta();
+      }
+    }
+    EXPECT_EQ(xdim, binary_sampler->xtz().size());
+    for (int j = 0; j < xdim; ++j) {
+      EXPECT_NEAR(beta[j], mean(binomial_draws.col(j)), .15)
+          << "binomial coefficient " << j;
+      EXPECT_NEAR(beta[j], mean(binary_draws.col(j)), .25)
+          << "binary coefficient " << j;
+    }
+  }
+
 }  // namespace
@@ -1,6 +1,7 @@
 #include "gtest/gtest.h"
 
 #include "Models/Glm/GlmCoefs.hpp"
+#include "Models/StateSpace/Filters/SparseVector.hpp"
 #include "distributions.hpp"
 
 #include "test_utils/test_utils.hpp"
@@ -128,6 +129,17 @@ namespace {
         << "predict() = " << c1.predict(X) << "\n";
   }
 
+  TEST_F(GlmCoefsTest, SparsePredictTest) {
+    GlmCoefs c1(Vector{2.3, 1.8, 0, 0, -6.4}, true);
+    SparseVector x(5);
+    x[0] = 1.0;
+    x[3] = 7.0;
+    x[4] = -2.0;
+    EXPECT_DOUBLE_EQ(c1.predict(x.dense()), c1.predict(x));
+    EXPECT_DOUBLE_EQ(2.3 + 12.8, c1.predict(x));
+    EXPECT_THROW(c1.predict(SparseVector(3)), std::exception);
+  }
+
   TEST_F(GlmCoefsTest, GetSetTest) {
     GlmCoefs c1(Vector{2.3, 1.8, 0, 0, -6.4}, true);
     EXPECT_TRUE(VectorEquals(
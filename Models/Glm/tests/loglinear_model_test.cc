@@ -1,4 +1,5 @@
 #include "gtest/gtest.h"
+#include <numeric>
 
 #include "stats/Encoders.hpp"
 #include "Models/Glm/LoglinearModel.hpp"
@@ -242,6 +243,55 @@ namespace {
     EXPECT_EQ(0, arr(2));
   }
 
+  TEST_F(LoglinearModelTest, SparseCells) {
+    LoglinearModelSuf suf;
+    suf.add_effect(hs_);
+    suf.add_effect(phs_);
+    suf.add_effect(fol_);
+    suf.add_effect(sex_);
+    double total = 0;
+    for (const auto &data_point : data_) {
+      suf.update(data_point);
+      total += data_point->frequency();
+    }
+    EXPECT_DOUBLE_EQ(suf.sample_size(), total);
+
+    // Each data point in minn38 is a distinct cell.
+    EXPECT_EQ(suf.observed_cells().size(), data_.size());
+    std::vector<int> levels;
+    suf.decode_cell(suf.cell_code(*data_[7]), levels);
+    EXPECT_EQ(levels, data_[7]->to_vector());
+
+    // Projections of the observed cells match the margins accumulated by
+    // Update.
+    for (int i = 0; i < 4; ++i) {
+      std::vector<int> index(1, i);
+      EXPECT_TRUE(suf.project(index) == suf.margin(index));
+    }
+
+    // An interaction added after the data is projected from the cells, and
+    // matches one that was present from the start.
+    NEW(CategoricalInteraction, hs_by_fol)(hs_, fol_);
+    suf.add_effect(hs_by_fol);
+    LoglinearModelSuf reference;
+    reference.add_effect(hs_by_fol);
+    for (const auto &data_point : data_) {
+      reference.update(data_point);
+    }
+    EXPECT_TRUE(suf.margin({0, 2}) == reference.margin({0, 2}));
+    Array full_table = suf.project({0, 1, 2, 3});
+    EXPECT_DOUBLE_EQ(std::accumulate(full_table.begin(), full_table.end(), 0.0),
+                     total);
+
+    // Refreshing in parallel reproduces the margins.
+    LoglinearModelSuf threaded(suf);
+    threaded.set_number_of_threads(3);
+    threaded.refresh(data_);
+    EXPECT_DOUBLE_EQ(threaded.sample_size(), total);
+    EXPECT_TRUE(threaded.margin({0, 2}) == suf.margin({0, 2}));
+    EXPECT_TRUE(threaded.margin({1}) == suf.margin({1}));
+  }
+
   TEST_F(LoglinearModelTest, TestSingleVar) {
     NEW(LoglinearModel, model)();
     data_ = get_minn38_data();
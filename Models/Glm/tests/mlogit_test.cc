@@ -1,11 +1,13 @@
 #include "gtest/gtest.h"
 
 #include "stats/DataTable.hpp"
+#include "cpputil/lse.hpp"
 #include "distributions.hpp"
 
 #include "Models/MvnModel.hpp"
 #include "Models/Glm/VariableSelectionPrior.hpp"
 #include "Models/Glm/MultinomialLogitModel.hpp"
+#include "Models/Glm/PosteriorSamplers/MLAuxMixSampler.hpp"
 #include "Models/Glm/PosteriorSamplers/MultinomialLogitCompositeSpikeSlabSampler.hpp"
 
 #include "test_utils/test_utils.hpp"
@@ -35,6 +37,147 @@ namespace {
     DataTable autopref_;
   };
 
+  // Log likelihood and derivatives for a single observation, computed from
+  // its full design matrix.
+  double observation_log_likelihood(const ChoiceData &dp, const Vector &beta,
+                                    Vector &g, Matrix &h) {
+    Matrix X = dp.X(false);
+    Vector eta = X * beta;
+    double lognc = lse(eta);
+    Vector probs = exp(eta - lognc);
+    Vector xbar = probs * X;
+    g += X.row(dp.value()) - xbar;
+    for (int m = 0; m < X.nrow(); ++m) {
+      Vector x = X.row(m);
+      h.add_outer(x, x, -probs[m]);
+    }
+    h.add_outer(xbar, xbar);
+    return eta[dp.value()] - lognc;
+  }
+
+  // The blocked log likelihood matches the sum of per-observation
+  // contributions, across several blocks and with choice level predictors.
+  TEST_F(MultinomialLogitTest, BlockedLogLikelihood) {
+    int nchoices = 4;
+    int subject_xdim = 3;
+    int choice_xdim = 2;
+    int sample_size = 700;
+    NEW(MultinomialLogitModel, model)(nchoices, subject_xdim, choice_xdim);
+    Vector beta(model->beta_size());
+    beta.randomize();
+    model->set_beta(beta);
+    for (int i = 0; i < sample_size; ++i) {
+      NEW(VectorData, subject_predictors)(
+          Vector{1.0, rnorm(), rnorm()});
+      std::vector<Ptr<VectorData>> choice_predictors;
+      for (int m = 0; m < nchoices; ++m) {
+        choice_predictors.push_back(new VectorData(Vector{rnorm(), rnorm()}));
+      }
+      NEW(CategoricalData, y)(random_int(0, nchoices - 1), nchoices);
+      model->add_data(new ChoiceData(*y, subject_predictors,
+                                     choice_predictors));
+    }
+
+    Vector expected_gradient(beta.size(), 0.0);
+    Matrix expected_hessian(beta.size(), beta.size(), 0.0);
+    double expected = 0;
+    for (const auto &dp : model->dat()) {
+      expected += observation_log_likelihood(
+          *dp, beta, expected_gradient, expected_hessian);
+    }
+
+    Vector gradient;
+    Matrix hessian;
+    EXPECT_NEAR(expected, model->log_likelihood(beta, gradient, hessian, 2),
+                1e-8);
+    EXPECT_TRUE(VectorEquals(expected_gradient, gradient));
+    EXPECT_TRUE(MatrixEquals(expected_hessian, hessian));
+    EXPECT_NEAR(expected, model->log_likelihood(), 1e-8);
+
+    // Threads share the blocks without changing the result.
+    double serial_loglike = model->log_likelihood(beta, gradient, hessian, 2);
+    model->set_number_of_threads(3);
+    Vector threaded_gradient;
+    Matrix threaded_hessian;
+    EXPECT_EQ(serial_loglike, model->log_likelihood(beta, threaded_gradient,
+                                                    threaded_hessian, 2));
+    EXPECT_EQ(0.0, (gradient - threaded_gradient).max_abs());
+    EXPECT_EQ(0.0, (hessian - threaded_hessian).max_abs());
+
+    Matrix eta;
+    model->fill_eta(300, 310, beta, eta);
+    EXPECT_EQ(10, eta.nrow());
+    Vector observation_eta;
+    model->fill_eta(*model->dat()[305], observation_eta);
+    EXPECT_TRUE(VectorEquals(observation_eta, eta.row(5)));
+
+    // With some coefficients excluded, beta, the gradient and the Hessian
+    // refer to the included coefficients only.
+    model->drop_all_slopes(true);
+    const Selector &inc(model->inc());
+    Vector included_beta = inc.select(beta);
+    Vector full_beta = inc.expand(included_beta);
+    expected_gradient = 0;
+    expected_hessian = 0;
+    expected = 0;
+    for (const auto &dp : model->dat()) {
+      expected += observation_log_likelihood(
+          *dp, full_beta, expected_gradient, expected_hessian);
+    }
+    EXPECT_NEAR(expected,
+                model->log_likelihood(included_beta, gradient, hessian, 2),
+                1e-8);
+    EXPECT_TRUE(VectorEquals(inc.select(expected_gradient), gradient));
+    EXPECT_TRUE(MatrixEquals(inc.select_square(expected_hessian), hessian));
+  }
+
+  // The block sparse update of the complete data sufficient statistics
+  // matches the dense computation from the full design matrix, and workers
+  // can share the imputation.
+  TEST_F(MultinomialLogitTest, CompleteDataSufficientStatistics) {
+    int nchoices = 4;
+    int subject_xdim = 3;
+    int choice_xdim = 2;
+    NEW(MultinomialLogitModel, model)(nchoices, subject_xdim, choice_xdim);
+    for (int i = 0; i < 200; ++i) {
+      NEW(VectorData, subject_predictors)(Vector{1.0, rnorm(), rnorm()});
+      std::vector<Ptr<VectorData>> choice_predictors;
+      for (int m = 0; m < nchoices; ++m) {
+        choice_predictors.push_back(new VectorData(Vector{rnorm(), rnorm()}));
+      }
+      NEW(CategoricalData, y)(random_int(0, nchoices - 1), nchoices);
+      model->add_data(new ChoiceData(*y, subject_predictors,
+                                     choice_predictors));
+    }
+
+    int dim = model->beta_size();
+    MultinomialLogit::CompleteDataSufficientStatistics suf(dim);
+    SpdMatrix xtwx(dim, 0.0);
+    Vector xtwu(dim, 0.0);
+    for (int i = 0; i < 10; ++i) {
+      const ChoiceData &dp(*model->dat()[i]);
+      Vector weights(nchoices), utilities(nchoices);
+      weights.randomize();
+      utilities.randomize();
+      suf.update(dp, weights, utilities);
+      const Matrix &X(dp.X(false));
+      xtwx.add_inner(X, weights);
+      xtwu += X.Tmult(weights * utilities);
+    }
+    EXPECT_TRUE(MatrixEquals(xtwx, suf.xtwx()));
+    EXPECT_TRUE(VectorEquals(xtwu, suf.xtwu()));
+
+    NEW(MvnModel, prior)(dim);
+    NEW(MLAuxMixSampler, sampler)(model.get(), prior, 3);
+    model->set_method(sampler);
+    for (int i = 0; i < 10; ++i) {
+      model->sample_posterior();
+    }
+    sampler->set_number_of_workers(2);
+    model->sample_posterior();
+    EXPECT_TRUE(std::isfinite(model->log_likelihood()));
+  }
+
   TEST_F(MultinomialLogitTest, FindMle) {
     Vector age = autopref_.getvar(1);
     CategoricalVariable sex = autopref_.get_nominal(2);
@@ -85,6 +228,7 @@ namespace {
         model.get(),
         coefficient_prior,
         inclusion_prior);
+    sampler->set_number_of_workers(2);
     model->set_method(sampler);
 
     int niter = 100;
@@ -136,6 +136,23 @@ namespace {
     EXPECT_TRUE(MatrixEquals(xty, suf->xty()));
     EXPECT_TRUE(MatrixEquals(yty, suf->yty()));
     EXPECT_DOUBLE_EQ(predictors_.nrow(), suf->n());
+
+    // Adding the data in a block with weights matches adding it one row at a
+    // time.
+    Vector weights(sample_size);
+    weights.randomize();
+    MvRegSuf row_suf(model.xdim(), model.ydim());
+    for (int i = 0; i < sample_size; ++i) {
+      row_suf.update_raw_data(response_.row(i), predictors_.row(i),
+                              weights[i]);
+    }
+    MvRegSuf block_suf(model.xdim(), model.ydim());
+    block_suf.add_data(predictors_, response_, weights);
+    EXPECT_TRUE(MatrixEquals(row_suf.xtx(), block_suf.xtx()));
+    EXPECT_TRUE(MatrixEquals(row_suf.xty(), block_suf.xty()));
+    EXPECT_TRUE(MatrixEquals(row_suf.yty(), block_suf.yty()));
+    EXPECT_DOUBLE_EQ(row_suf.n(), block_suf.n());
+    EXPECT_DOUBLE_EQ(row_suf.sumw(), block_suf.sumw());
   }
 
   //===========================================================================
@@ -439,4 +456,74 @@ namespace {
     EXPECT_TRUE(status.ok) << status.error_message();
   }
 
+  //===========================================================================
+  TEST_F(MultivariateRegressionTest, PerResponseSpikeSlabTest) {
+    int xdim = 12;
+    int ydim = 3;
+    MultivariateRegressionModel model(xdim, ydim);
+    int sample_size = 1000;
+    PopulateModel(model, .25, sample_size);
+    Ptr<MultivariateRegressionSpikeSlabSampler> sampler =
+        SetupSpikeSlab(model);
+    sampler->set_per_response_updates(true);
+    sampler->set_number_of_threads(2);
+
+    int niter = 1000;
+    Matrix beta_draws(niter, xdim * ydim);
+    Matrix inclusion_draws(niter, xdim * ydim);
+    for (int i = 0; i < niter; ++i) {
+      model.sample_posterior();
+      beta_draws.row(i) = vec(model.Beta());
+      inclusion_draws.row(i) =
+          model.included_coefficients().vectorize().to_Vector();
+    }
+    auto status = CheckMcmcMatrix(beta_draws, vec(coefficients_), .95,
+                                  true, "beta.draws");
+    EXPECT_TRUE(status.ok) << status.error_message();
+
+    Vector inclusion_probs = mean(inclusion_draws);
+    Vector true_coefficients = vec(coefficients_);
+    double success_count = 0.0;
+    for (int i = 0; i < inclusion_probs.size(); ++i) {
+      if (fabs(true_coefficients[i]) > 1e-6) {
+        success_count += inclusion_probs[i] > .5;
+      } else {
+        success_count += inclusion_probs[i] < .5;
+      }
+    }
+    EXPECT_GT(success_count / inclusion_probs.size(), .9)
+        << cbind(true_coefficients, inclusion_probs);
+  }
+
+  //===========================================================================
+  // Per-response draws should not depend on the number of threads.
+  TEST_F(MultivariateRegressionTest, PerResponseThreadsAreReproducible) {
+    int xdim = 6;
+    int ydim = 5;
+    int sample_size = 200;
+    MultivariateRegressionModel serial_model(xdim, ydim);
+    GlobalRng::rng.seed(12345);
+    PopulateModel(serial_model, .5, sample_size);
+    Ptr<MultivariateRegressionSpikeSlabSampler> serial_sampler =
+        SetupSpikeSlab(serial_model);
+    serial_sampler->set_per_response_updates(true);
+
+    MultivariateRegressionModel threaded_model(xdim, ydim);
+    GlobalRng::rng.seed(12345);
+    PopulateModel(threaded_model, .5, sample_size);
+    Ptr<MultivariateRegressionSpikeSlabSampler> threaded_sampler =
+        SetupSpikeSlab(threaded_model);
+    threaded_sampler->set_per_response_updates(true);
+    threaded_sampler->set_number_of_threads(3);
+
+    serial_sampler->set_seed(8675309);
+    threaded_sampler->set_seed(8675309);
+    for (int i = 0; i < 20; ++i) {
+      serial_model.sample_posterior();
+      threaded_model.sample_posterior();
+      EXPECT_TRUE(MatrixEquals(serial_model.Beta(), threaded_model.Beta()));
+      EXPECT_TRUE(MatrixEquals(serial_model.Sigma(), threaded_model.Sigma()));
+    }
+  }
+
 }  // namespace
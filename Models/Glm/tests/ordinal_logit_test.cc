@@ -112,6 +112,37 @@ namespace {
     TestDataImputer(-7.4, 1.2, infinity(), 1000);
   }
 
+  // The batch imputer matches the same truncated distribution, including
+  // intervals far into the tails.
+  TEST_F(OrdinalLogitTest, BatchDataImputer) {
+    OrdinalLogitImputer imputer;
+    int n = 2000;
+    std::vector<std::pair<double, double>> intervals = {
+      {negative_infinity(), 0}, {0, 1.2}, {1.2, infinity()}, {20, 21}};
+    for (const auto &interval : intervals) {
+      double lower = interval.first;
+      double upper = interval.second;
+      for (double eta : {-7.4, 0.3}) {
+        Vector draws(n);
+        imputer.impute(GlobalRng::rng, Vector(n, eta), lower, upper,
+                       VectorView(draws));
+        EXPECT_GE(draws.min(), lower);
+        EXPECT_LE(draws.max(), upper);
+        // The CDF is computed on the reflected scale for the upper tail.
+        bool ok = DistributionsMatch(draws, [=](double x) {
+            if (lower - eta > 0) {
+              double mass = plogis(eta - lower) - plogis(eta - upper);
+              return (plogis(eta - lower) - plogis(eta - x)) / mass;
+            }
+            double mass = plogis(upper - eta) - plogis(lower - eta);
+            return (plogis(x - eta) - plogis(lower - eta)) / mass;
+          });
+        EXPECT_TRUE(ok) << "eta = " << eta << " lower = " << lower
+                        << " upper = " << upper;
+      }
+    }
+  }
+
   TEST_F(OrdinalLogitTest, Init) {
     int xdim = 3;
     int nlevels = 4;
@@ -233,5 +264,35 @@ namespace {
         "cutpoint_draws.txt");
     EXPECT_TRUE(cutpoint_status.ok) << cutpoint_status;
   }
+
+  // Sharded imputation gives the same draws for any number of threads.
+  TEST_F(OrdinalLogitTest, ThreadedMcmcIsReproducible) {
+    Vector cutpoints{0.23, .78};
+    int nlevels = cutpoints.size() + 2;
+    int xdim = 3;
+    SimulateData(3000, xdim, cutpoints);
+    std::vector<Ptr<OrdinalLogitModel>> models;
+    for (int threads : {0, 4}) {
+      NEW(OrdinalLogitModel, model)(xdim, nlevels);
+      for (const auto &data_point : data_) {
+        model->add_data(data_point);
+      }
+      NEW(MvnModel, beta_prior)(xdim);
+      NEW(ExponentialIncrementModel, cutpoint_prior)(
+          Vector(cutpoints.size(), .10));
+      RNG seeding_rng(17);
+      NEW(OrdinalLogitPosteriorSampler, sampler)(
+          model.get(), beta_prior, cutpoint_prior, seeding_rng);
+      sampler->set_number_of_threads(threads);
+      model->set_method(sampler);
+      for (int i = 0; i < 20; ++i) {
+        model->sample_posterior();
+      }
+      models.push_back(model);
+    }
+    EXPECT_TRUE(VectorEquals(models[0]->Beta(), models[1]->Beta()));
+    EXPECT_TRUE(VectorEquals(models[0]->cutpoint_vector(),
+                             models[1]->cutpoint_vector()));
+  }
   
 }  // namespace
@@ -0,0 +1,169 @@
+#include "gtest/gtest.h"
+#include "Models/Glm/PoissonRegressionModel.hpp"
+#include "Models/Glm/PosteriorSamplers/PoissonRegressionAuxMixSampler.hpp"
+#include "Models/MvnModel.hpp"
+#include "distributions.hpp"
+#include "test_utils/test_utils.hpp"
+
+namespace {
+  using namespace BOOM;
+  using std::endl;
+  using std::cout;
+
+  class PoissonRegressionTest : public ::testing::Test {
+   protected:
+    PoissonRegressionTest() {
+      GlobalRng::rng.seed(8675309);
+    }
+
+    // Simulate 'nobs' observations, with varying exposures, from a Poisson
+    // regression with coefficients beta and an intercept.
+    Ptr<PoissonRegressionModel> simulate(const Vector &beta, int nobs) {
+      NEW(PoissonRegressionModel, model)(beta);
+      for (int i = 0; i < nobs; ++i) {
+        Vector x(beta.size());
+        x.randomize();
+        x[0] = 1.0;
+        double exposure = runif(.5, 3.0);
+        int64_t y = rpois(exposure * exp(beta.dot(x)));
+        model->add_data(new PoissonRegressionData(y, x, exposure));
+      }
+      return model;
+    }
+  };
+
+  // The blocked log likelihood and its derivatives agree with the
+  // observation-by-observation formulas, with and without excluded
+  // coefficients.
+  TEST_F(PoissonRegressionTest, LogLikelihoodAndDerivatives) {
+    Vector beta = {.5, -.3, .8, 0.0};
+    Ptr<PoissonRegressionModel> model = simulate(beta, 700);
+    Vector coefficients = {.4, -.2, .7, .1};
+
+    for (bool drop_one : {false, true}) {
+      if (drop_one) {
+        model->coef().drop(3);
+      }
+      const Selector &inc(model->coef().inc());
+      Vector included_coefficients = inc.select(coefficients);
+      int nvars = inc.nvars();
+      double expected = 0;
+      Vector expected_gradient(nvars, 0.0);
+      Matrix expected_hessian(nvars, nvars, 0.0);
+      for (const auto &dp : model->dat()) {
+        Vector x = inc.select(dp->x());
+        double mean = dp->exposure() * exp(included_coefficients.dot(x));
+        expected += dpois(dp->y(), mean, true);
+        expected_gradient.axpy(x, dp->y() - mean);
+        expected_hessian.add_outer(x, x, -mean);
+      }
+
+      Vector gradient;
+      Matrix hessian;
+      EXPECT_NEAR(expected,
+                  model->log_likelihood(included_coefficients, &gradient,
+                                        &hessian),
+                  1e-8);
+      EXPECT_TRUE(VectorEquals(expected_gradient, gradient));
+      EXPECT_TRUE(MatrixEquals(expected_hessian, hessian));
+    }
+  }
+
+  // Sharing the likelihood evaluation among threads gives the same answer
+  // as a serial evaluation, so the maximum likelihood estimate is
+  // unchanged.
+  TEST_F(PoissonRegressionTest, ThreadedLogLikelihood) {
+    Vector beta = {.5, -.3, .8};
+    Ptr<PoissonRegressionModel> model = simulate(beta, 20000);
+    Vector serial_gradient, threaded_gradient;
+    Matrix serial_hessian, threaded_hessian;
+    double serial =
+        model->log_likelihood(beta, &serial_gradient, &serial_hessian);
+    model->set_number_of_threads(4);
+    EXPECT_EQ(serial,
+              model->log_likelihood(beta, &threaded_gradient,
+                                    &threaded_hessian));
+    EXPECT_EQ(0.0, (serial_gradient - threaded_gradient).max_abs());
+    EXPECT_EQ(0.0, (serial_hessian - threaded_hessian).max_abs());
+
+    model->mle();
+    EXPECT_TRUE(VectorEquals(beta, model->Beta(), .05)) << model->Beta();
+  }
+
+  // Adding a block of weighted observations matches adding them one at a
+  // time.
+  TEST_F(PoissonRegressionTest, WeightedRegSufBlockUpdate) {
+    Matrix X(40, 3);
+    X.randomize();
+    Vector y(40), w(40);
+    y.randomize();
+    w.randomize();
+    WeightedRegSuf one_at_a_time(3);
+    for (int i = 0; i < X.nrow(); ++i) {
+      one_at_a_time.add_data(X.row(i), y[i], w[i]);
+    }
+    WeightedRegSuf block(3);
+    block.add_data(X, y, w);
+    EXPECT_TRUE(MatrixEquals(one_at_a_time.xtx(), block.xtx()));
+    EXPECT_TRUE(VectorEquals(one_at_a_time.xty(), block.xty()));
+    EXPECT_NEAR(one_at_a_time.yty(), block.yty(), 1e-10);
+    EXPECT_DOUBLE_EQ(one_at_a_time.n(), block.n());
+    EXPECT_NEAR(one_at_a_time.sumw(), block.sumw(), 1e-10);
+    EXPECT_NEAR(one_at_a_time.sumlogw(), block.sumlogw(), 1e-10);
+  }
+
+  // The blocked imputation makes the same draws as the observation by
+  // observation imputation.
+  TEST_F(PoissonRegressionTest, BlockedImputationMatchesPointwise) {
+    Vector beta = {.5, -.3, .8};
+    Ptr<PoissonRegressionModel> model = simulate(beta, 600);
+    std::vector<int> responses;
+    for (const auto &dp : model->dat()) {
+      responses.push_back(dp->y());
+    }
+    PoissonDataImputer::prepare_mixture_table(responses);
+
+    std::mutex mutex;
+    WeightedRegSuf pointwise_suf(3);
+    RNG pointwise_rng(12345);
+    PoissonRegressionDataImputer pointwise_imputer(
+        pointwise_suf, mutex, &model->coef(), &pointwise_rng);
+    for (const auto &dp : model->dat()) {
+      pointwise_imputer.impute_latent_data_point(*dp, &pointwise_suf,
+                                                 pointwise_rng);
+    }
+
+    WeightedRegSuf blocked_suf(3);
+    RNG blocked_rng(12345);
+    PoissonRegressionDataImputer blocked_imputer(blocked_suf, mutex,
+                                                 &model->coef(), &blocked_rng);
+    blocked_imputer.impute_latent_data_range(
+        model->dat().begin(), model->dat().end(), &blocked_suf, blocked_rng);
+
+    EXPECT_DOUBLE_EQ(pointwise_suf.n(), blocked_suf.n());
+    EXPECT_TRUE(MatrixEquals(pointwise_suf.xtx(), blocked_suf.xtx()));
+    EXPECT_TRUE(VectorEquals(pointwise_suf.xty(), blocked_suf.xty()));
+  }
+
+  // The auxiliary mixture sampler recovers the coefficients when the data
+  // augmentation is multi-threaded from the first iteration.
+  TEST_F(PoissonRegressionTest, AuxMixSamplerRecoversCoefficients) {
+    Vector beta = {.5, -.3, .8};
+    Ptr<PoissonRegressionModel> model = simulate(beta, 2000);
+    NEW(MvnModel, prior)(Vector(3, 0.0), SpdMatrix(3, 100.0));
+    NEW(PoissonRegressionAuxMixSampler, sampler)(model.get(), prior, 3);
+    model->set_method(sampler);
+    int niter = 400;
+    int burn = 100;
+    Vector mean_draws(3, 0.0);
+    for (int i = 0; i < niter; ++i) {
+      model->sample_posterior();
+      if (i >= burn) {
+        mean_draws += model->Beta();
+      }
+    }
+    mean_draws /= niter - burn;
+    EXPECT_TRUE(VectorEquals(beta, mean_draws, .1)) << mean_draws;
+  }
+
+}  // namespace
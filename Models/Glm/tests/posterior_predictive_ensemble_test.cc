@@ -0,0 +1,93 @@
+#include "gtest/gtest.h"
+#include "Models/Glm/GlmCoefs.hpp"
+#include "Models/Glm/PosteriorPredictiveEnsemble.hpp"
+#include "distributions.hpp"
+#include "stats/logit.hpp"
+#include "test_utils/test_utils.hpp"
+
+namespace {
+  using namespace BOOM;
+  using std::endl;
+  using std::cout;
+
+  class PosteriorPredictiveEnsembleTest : public ::testing::Test {
+   protected:
+    PosteriorPredictiveEnsembleTest() {
+      GlobalRng::rng.seed(8675309);
+    }
+  };
+
+  // Predictions from the packed draws match per-draw calls to predict(),
+  // and variables excluded from every draw are dropped.
+  TEST_F(PosteriorPredictiveEnsembleTest, MatchesPerDrawPredictions) {
+    int ndraws = 200;
+    int xdim = 6;
+    Matrix draws(ndraws, xdim);
+    draws.randomize();
+    for (int d = 0; d < ndraws; ++d) {
+      draws(d, 2) = 0.0;
+      draws(d, 5) = 0.0;
+      if (d % 3 == 0) draws(d, 4) = 0.0;
+    }
+    Matrix predictors(25, xdim);
+    predictors.randomize();
+
+    PosteriorPredictiveEnsemble ensemble(
+        draws, PosteriorPredictiveEnsemble::Link::LOGIT);
+    EXPECT_EQ(ndraws, ensemble.number_of_draws());
+    EXPECT_EQ(xdim, ensemble.xdim());
+    EXPECT_EQ(4, ensemble.included().nvars());
+    EXPECT_FALSE(ensemble.included()[2]);
+    EXPECT_TRUE(ensemble.included()[4]);
+
+    Matrix probs;
+    ensemble.predict(predictors, probs);
+    ASSERT_EQ(predictors.nrow(), probs.nrow());
+    ASSERT_EQ(ndraws, probs.ncol());
+    for (int d = 0; d < ndraws; ++d) {
+      GlmCoefs coefs(draws.row(d), true);
+      for (int i = 0; i < predictors.nrow(); ++i) {
+        EXPECT_NEAR(logit_inv(coefs.predict(predictors.row(i))),
+                    probs(i, d), 1e-10);
+      }
+    }
+
+    PosteriorPredictiveEnsemble poisson(
+        draws, PosteriorPredictiveEnsemble::Link::LOG);
+    Matrix rates;
+    poisson.predict(predictors, rates);
+    GlmCoefs coefs(draws.row(7), true);
+    EXPECT_NEAR(exp(coefs.predict(predictors.row(3))), rates(3, 7), 1e-10);
+  }
+
+  // The summary reports the posterior mean and quantiles of the draws.
+  TEST_F(PosteriorPredictiveEnsembleTest, Summaries) {
+    int ndraws = 1000;
+    Matrix draws(ndraws, 2);
+    for (int d = 0; d < ndraws; ++d) {
+      draws(d, 0) = rnorm(1.0, 0.5);
+      draws(d, 1) = rnorm(-2.0, 0.25);
+    }
+    Matrix predictors(3, 2);
+    predictors.randomize();
+    PosteriorPredictiveEnsemble ensemble(
+        draws, PosteriorPredictiveEnsemble::Link::IDENTITY);
+    Vector probs = {.025, .5, .975};
+    Matrix summary = ensemble.summarize(predictors, probs);
+    ASSERT_EQ(3, summary.nrow());
+    ASSERT_EQ(4, summary.ncol());
+
+    Matrix linear_predictors;
+    ensemble.linear_predictors(predictors, linear_predictors);
+    for (int i = 0; i < predictors.nrow(); ++i) {
+      Vector values = linear_predictors.row(i);
+      EXPECT_NEAR(values.sum() / ndraws, summary(i, 0), 1e-10);
+      EXPECT_LT(summary(i, 1), summary(i, 2));
+      EXPECT_LT(summary(i, 2), summary(i, 3));
+      values.sort();
+      EXPECT_NEAR(values[500], summary(i, 2), 0.02);
+      EXPECT_NEAR(values[24], summary(i, 1), 0.05);
+    }
+  }
+
+}  // namespace
@@ -0,0 +1,68 @@
+#include "gtest/gtest.h"
+#include "Models/Glm/PosteriorSamplers/QuantileRegressionPosteriorSampler.hpp"
+#include "Models/Glm/QuantileRegressionModel.hpp"
+#include "Models/MvnModel.hpp"
+#include "distributions.hpp"
+#include "stats/moments.hpp"
+#include "test_utils/test_utils.hpp"
+
+namespace {
+  using namespace BOOM;
+  using std::endl;
+  using std::cout;
+
+  class QuantileRegressionTest : public ::testing::Test {
+   protected:
+    QuantileRegressionTest() {
+      GlobalRng::rng.seed(8675309);
+    }
+  };
+
+  // The blocked data augmentation, split among several workers, recovers
+  // the coefficients of the conditional quantile.
+  TEST_F(QuantileRegressionTest, McmcRecoversQuantile) {
+    int dim = 3;
+    double quantile = .8;
+    Vector beta = {1.0, -2.0, .5};
+    NEW(QuantileRegressionModel, model)(dim, quantile);
+    // The errors are normal, so the conditional quantile of y is beta.dot(x)
+    // plus the 80th percentile of the error distribution.
+    double error_sd = .5;
+    Vector quantile_beta = beta;
+    quantile_beta[0] += qnorm(quantile, 0, error_sd);
+    for (int i = 0; i < 5000; ++i) {
+      Vector x(dim);
+      x.randomize();
+      x[0] = 1.0;
+      // A few observations fall exactly on the true quantile, to exercise
+      // the zero residual case when the sampler starts there.
+      double y = i % 1000 == 0 ? quantile_beta.dot(x)
+                              : rnorm(beta.dot(x), error_sd);
+      NEW(RegressionData, data_point)(y, x);
+      model->add_data(data_point);
+    }
+    model->set_Beta(quantile_beta);
+
+    NEW(MvnModel, prior)(Vector(dim, 0.0), SpdMatrix(dim, 100.0));
+    NEW(QuantileRegressionPosteriorSampler, sampler)(model.get(), prior);
+    sampler->set_number_of_workers(3);
+    model->set_method(sampler);
+
+    int niter = 600;
+    int burn = 100;
+    Matrix draws(niter - burn, dim);
+    for (int i = 0; i < niter; ++i) {
+      model->sample_posterior();
+      if (i >= burn) {
+        draws.row(i - burn) = model->Beta();
+      }
+    }
+    // Each worker saw every one of its observations.
+    EXPECT_EQ(5000, lround(sampler->suf().n()));
+    for (int j = 0; j < dim; ++j) {
+      EXPECT_NEAR(mean(draws.col(j)), quantile_beta[j], .1)
+          << "coefficient " << j;
+    }
+  }
+
+}  // namespace
@@ -5,6 +5,8 @@
 #include "Models/Glm/VariableSelectionPrior.hpp"
 #include "distributions.hpp"
 #include "Models/Glm/RegressionModel.hpp"
+#include "Models/Glm/WeightedRegressionModel.hpp"
+#include "Models/StateSpace/Filters/SparseVector.hpp"
 #include "Models/Glm/PosteriorSamplers/RegressionConjSampler.hpp"
 
 #include "stats/moments.hpp"
@@ -49,6 +51,228 @@ namespace {
     EXPECT_NEAR(suf.sample_sd(), sd(y), tiny);
   }
 
+  // Serializing and combining sufficient statistics should give the same
+  // statistics as computing them from all the data at once.
+  TEST_F(RegressionModelTest, RegSufSerializeAndCombine) {
+    int n = 100;
+    int p = 3;
+    Matrix X(n, p);
+    X.randomize();
+    X.col(0) = 1.0;
+    Vector y(n);
+    y.randomize();
+    NeRegSuf full(X, y);
+
+    NeRegSuf first(p);
+    NeRegSuf second(p);
+    for (int i = 0; i < n; ++i) {
+      (i < 40 ? first : second).add_mixture_data(y[i], Vector(X.row(i)), 1.0);
+    }
+    NeRegSuf restored(p);
+    restored.unvectorize(second.vectorize());
+    EXPECT_TRUE(VectorEquals(second.xbar(), restored.xbar()));
+    first.combine(restored);
+
+    EXPECT_TRUE(MatrixEquals(full.xtx(), first.xtx()));
+    EXPECT_TRUE(VectorEquals(full.xty(), first.xty()));
+    EXPECT_TRUE(VectorEquals(full.xbar(), first.xbar()));
+    EXPECT_NEAR(full.yty(), first.yty(), 1e-8);
+    EXPECT_NEAR(full.ybar(), first.ybar(), 1e-8);
+    EXPECT_DOUBLE_EQ(full.n(), first.n());
+
+    // Fractional weights must survive serialization.
+    NeRegSuf weighted(p);
+    weighted.add_mixture_data(y[0], Vector(X.row(0)), .25);
+    NeRegSuf weighted_copy(p);
+    weighted_copy.unvectorize(weighted.vectorize(false), false);
+    EXPECT_DOUBLE_EQ(.25, weighted_copy.n());
+  }
+
+  TEST_F(RegressionModelTest, DataTable) {
+    int n = 600;
+    int p = 4;
+    Matrix X(n, p);
+    X.randomize();
+    X.col(0) = 1.0;
+    Vector y(n);
+    y.randomize();
+
+    RegressionDataTable table(X, y);
+    EXPECT_EQ(n, table.sample_size());
+    EXPECT_EQ(p, table.xdim());
+    EXPECT_TRUE(VectorEquals(table.predictors(17), X.row(17)));
+    EXPECT_DOUBLE_EQ(y[17], table.response(17));
+
+    NeRegSuf expected(X, y);
+    NeRegSuf suf(p);
+    suf.add_data_table(table);
+    EXPECT_TRUE(MatrixEquals(expected.xtx(), suf.xtx()));
+    EXPECT_TRUE(VectorEquals(expected.xty(), suf.xty()));
+    EXPECT_TRUE(VectorEquals(expected.xbar(), suf.xbar()));
+    EXPECT_NEAR(expected.yty(), suf.yty(), 1e-8);
+    EXPECT_NEAR(expected.ybar(), suf.ybar(), 1e-8);
+    EXPECT_DOUBLE_EQ(expected.n(), suf.n());
+
+    NEW(RegressionModel, model)(p);
+    model->add_data_table(table);
+    EXPECT_TRUE(model->dat().empty());
+    EXPECT_TRUE(MatrixEquals(expected.xtx(), model->suf()->xtx()));
+    Ptr<RegressionModel> copy(model->clone());
+    EXPECT_TRUE(VectorEquals(expected.xty(), copy->suf()->xty()));
+
+    EXPECT_THROW(table.add_observation(1.0, Vector(p + 1)), std::exception);
+  }
+
+  TEST_F(RegressionModelTest, AddDataView) {
+    int n = 600;
+    int p = 4;
+    Matrix X(n, p);
+    X.randomize();
+    X.col(0) = 1.0;
+    Vector y(n);
+    y.randomize();
+
+    NeRegSuf expected(X, y);
+    NeRegSuf suf(p);
+    // A view of externally owned, column major memory, as with a matrix
+    // passed from R.
+    suf.add_data_view(ConstSubMatrix(X.data(), n, p), ConstVectorView(y));
+    EXPECT_TRUE(MatrixEquals(expected.xtx(), suf.xtx()));
+    EXPECT_TRUE(VectorEquals(expected.xty(), suf.xty()));
+    EXPECT_TRUE(VectorEquals(expected.xbar(), suf.xbar()));
+    EXPECT_NEAR(expected.yty(), suf.yty(), 1e-8);
+    EXPECT_NEAR(expected.ybar(), suf.ybar(), 1e-8);
+    EXPECT_DOUBLE_EQ(expected.n(), suf.n());
+
+    // A subset of rows taken from a strided view.
+    NeRegSuf partial(p);
+    partial.add_data_view(ConstSubMatrix(X, 100, 399, 0, p - 1),
+                          ConstVectorView(y, 100, 300));
+    NeRegSuf partial_expected(
+        ConstSubMatrix(X, 100, 399, 0, p - 1).to_matrix(),
+        Vector(ConstVectorView(y, 100, 300)));
+    EXPECT_TRUE(MatrixEquals(partial_expected.xtx(), partial.xtx()));
+    EXPECT_TRUE(VectorEquals(partial_expected.xty(), partial.xty()));
+
+    EXPECT_THROW(suf.add_data_view(ConstSubMatrix(X), ConstVectorView(y, 1)),
+                 std::exception);
+
+    // A single precision design matrix gives the sufficient statistics of
+    // the rounded data.
+    FloatMatrix float_X(X);
+    NeRegSuf float_suf(p);
+    float_suf.add_data_view(float_X.view(), ConstVectorView(y));
+    NeRegSuf rounded_expected(float_X.to_matrix(), y);
+    EXPECT_TRUE(MatrixEquals(rounded_expected.xtx(), float_suf.xtx()));
+    EXPECT_TRUE(VectorEquals(rounded_expected.xty(), float_suf.xty()));
+    EXPECT_TRUE(MatrixEquals(expected.xtx(), float_suf.xtx(), 1e-3));
+  }
+
+  TEST_F(RegressionModelTest, BatchAddData) {
+    int n = 300;
+    int p = 5;
+    Matrix X(n, p);
+    X.randomize();
+    X.col(0) = 1.0;
+    Vector y(n);
+    y.randomize();
+    Vector w(n);
+    w.randomize();
+
+    NeRegSuf one_at_a_time(p);
+    NeRegSuf weighted_one_at_a_time(p);
+    for (int i = 0; i < n; ++i) {
+      one_at_a_time.add_mixture_data(y[i], Vector(X.row(i)), 1.0);
+      weighted_one_at_a_time.add_mixture_data(y[i], Vector(X.row(i)), w[i]);
+    }
+
+    NeRegSuf batch(p);
+    batch.add_data(X, y);
+    EXPECT_TRUE(MatrixEquals(one_at_a_time.xtx(), batch.xtx()));
+    EXPECT_TRUE(VectorEquals(one_at_a_time.xty(), batch.xty()));
+    EXPECT_TRUE(VectorEquals(one_at_a_time.xbar(), batch.xbar()));
+    EXPECT_NEAR(one_at_a_time.yty(), batch.yty(), 1e-8);
+    EXPECT_DOUBLE_EQ(one_at_a_time.n(), batch.n());
+
+    NeRegSuf weighted_batch(p);
+    weighted_batch.add_data(X, y, w);
+    EXPECT_TRUE(MatrixEquals(weighted_one_at_a_time.xtx(),
+                             weighted_batch.xtx()));
+    EXPECT_TRUE(VectorEquals(weighted_one_at_a_time.xty(),
+                             weighted_batch.xty()));
+    EXPECT_TRUE(VectorEquals(weighted_one_at_a_time.xbar(),
+                             weighted_batch.xbar()));
+    EXPECT_NEAR(weighted_one_at_a_time.yty(), weighted_batch.yty(), 1e-8);
+    EXPECT_NEAR(weighted_one_at_a_time.n(), weighted_batch.n(), 1e-8);
+
+    NEW(RegressionModel, model)(p);
+    model->add_data(SubMatrix(X, 0, 99, 0, p - 1).to_matrix(),
+                    Vector(ConstVectorView(y, 0, 100)));
+    model->add_data(SubMatrix(X, 100, n - 1, 0, p - 1).to_matrix(),
+                    Vector(ConstVectorView(y, 100, n - 100)));
+    EXPECT_TRUE(model->dat().empty());
+    EXPECT_TRUE(MatrixEquals(one_at_a_time.xtx(), model->suf()->xtx()));
+    EXPECT_TRUE(VectorEquals(one_at_a_time.xty(), model->suf()->xty()));
+
+    EXPECT_THROW(batch.add_data(X, Vector(n - 1)), std::exception);
+    EXPECT_THROW(batch.add_data(X, y, Vector(3)), std::exception);
+  }
+
+  TEST_F(RegressionModelTest, SparsePredictors) {
+    int n = 200;
+    int p = 12;
+    Matrix X(n, p, 0.0);
+    Vector y(n);
+    Vector w(n);
+    std::vector<SparseVector> rows;
+    for (int i = 0; i < n; ++i) {
+      SparseVector x(p);
+      x[0] = 1.0;
+      x[1 + random_int(0, p - 2)] = rnorm();
+      x[1 + random_int(0, p - 2)] = rnorm();
+      X.row(i) = x.dense();
+      rows.push_back(x);
+      y[i] = rnorm();
+      w[i] = runif(.5, 2.0);
+    }
+
+    NeRegSuf dense(X, y);
+    NeRegSuf sparse(p);
+    for (int i = 0; i < n; ++i) {
+      sparse.add_mixture_data(y[i], rows[i], 1.0);
+    }
+    EXPECT_TRUE(MatrixEquals(dense.xtx(), sparse.xtx()));
+    EXPECT_TRUE(VectorEquals(dense.xty(), sparse.xty()));
+    EXPECT_TRUE(VectorEquals(dense.xbar(), sparse.xbar()));
+    EXPECT_NEAR(dense.yty(), sparse.yty(), 1e-8);
+    EXPECT_DOUBLE_EQ(dense.n(), sparse.n());
+
+    // Mixing sparse and dense updates must leave xtx symmetric.
+    NeRegSuf mixed(p);
+    for (int i = 0; i < n; ++i) {
+      if (i % 2 == 0) {
+        mixed.add_mixture_data(y[i], rows[i], 1.0);
+      } else {
+        mixed.add_mixture_data(y[i], Vector(X.row(i)), 1.0);
+      }
+    }
+    EXPECT_TRUE(MatrixEquals(dense.xtx(), mixed.xtx()));
+
+    WeightedRegSuf weighted_dense(p);
+    WeightedRegSuf weighted_sparse(p);
+    for (int i = 0; i < n; ++i) {
+      weighted_dense.add_data(Vector(X.row(i)), y[i], w[i]);
+      weighted_sparse.add_data(rows[i], y[i], w[i]);
+    }
+    EXPECT_TRUE(MatrixEquals(weighted_dense.xtx(), weighted_sparse.xtx()));
+    EXPECT_TRUE(VectorEquals(weighted_dense.xty(), weighted_sparse.xty()));
+    EXPECT_NEAR(weighted_dense.yty(), weighted_sparse.yty(), 1e-8);
+    EXPECT_NEAR(weighted_dense.sumlogw(), weighted_sparse.sumlogw(), 1e-8);
+
+    EXPECT_THROW(sparse.add_mixture_data(1.0, SparseVector(p + 1), 1.0),
+                 std::exception);
+  }
+
   TEST_F(RegressionModelTest, DataConstructor) {
     int nobs = 1000;
     int nvars = 10;
@@ -0,0 +1,108 @@
+#include "gtest/gtest.h"
+
+#include "Models/Glm/LogisticRegressionModel.hpp"
+#include "Models/Glm/LogisticRegressionTableLoglikelihood.hpp"
+#include "Models/Glm/PosteriorSamplers/StochasticGradientGlmSampler.hpp"
+#include "Models/Glm/RegressionDataTable.hpp"
+#include "Models/MvnModel.hpp"
+#include "distributions.hpp"
+#include "stats/moments.hpp"
+
+#include "test_utils/test_utils.hpp"
+
+namespace {
+  using namespace BOOM;
+  using std::endl;
+  using std::cout;
+
+  class StochasticGradientTest : public ::testing::Test {
+   protected:
+    StochasticGradientTest()
+        : beta_{-.5, 1.0, .3},
+          table_(new RegressionDataTable(beta_.size())),
+          model_(new LogisticRegressionModel(beta_.size())) {
+      GlobalRng::rng.seed(8675309);
+      for (int i = 0; i < 20000; ++i) {
+        Vector x(beta_.size());
+        x.randomize();
+        x[0] = 1.0;
+        bool y = runif() < plogis(beta_.dot(x));
+        table_->add_observation(y, x);
+        model_->add_data(new BinaryRegressionData(y, x));
+      }
+    }
+
+    Vector beta_;
+    Ptr<RegressionDataTable> table_;
+    Ptr<LogisticRegressionModel> model_;
+  };
+
+  // The table log likelihood matches the model's, and a subsample holding
+  // every observation reproduces the full data gradient.
+  TEST_F(StochasticGradientTest, TableLoglikelihood) {
+    NEW(LogisticRegressionTableLoglikelihood, loglike)(table_);
+    EXPECT_EQ(20000, loglike->number_of_terms());
+    Vector coefficients = {-.3, .8, .2};
+    Vector gradient, model_gradient, subsample_gradient;
+    double value = (*loglike)(coefficients, gradient);
+    EXPECT_NEAR(value, (*loglike)(coefficients), 1e-8);
+    EXPECT_NEAR(value, model_->log_likelihood(coefficients, &model_gradient,
+                                              nullptr),
+                1e-6);
+    EXPECT_TRUE(VectorEquals(gradient, model_gradient, 1e-6));
+
+    std::vector<int> everything(loglike->number_of_terms());
+    for (int i = 0; i < everything.size(); ++i) everything[i] = i;
+    EXPECT_NEAR(value,
+                loglike->subsample_value(coefficients, subsample_gradient,
+                                         everything),
+                1e-6);
+    EXPECT_TRUE(VectorEquals(gradient, subsample_gradient, 1e-6));
+  }
+
+  // With a control variate at the MLE and the inverse Fisher information as
+  // the preconditioner, both SGLD and SGHMC draws center on the MLE with
+  // roughly the right spread.
+  TEST_F(StochasticGradientTest, DrawsCenterOnMle) {
+    model_->mle();
+    Vector mle = model_->Beta();
+    Vector gradient;
+    Matrix hessian;
+    model_->log_likelihood(mle, &gradient, &hessian);
+    SpdMatrix variance = SpdMatrix(hessian * -1.0).inv();
+
+    NEW(MvnModel, prior)(Vector(beta_.size(), 0.0),
+                         SpdMatrix(beta_.size(), 100.0));
+    NEW(LogisticRegressionTableLoglikelihood, loglike)(table_);
+    NEW(StochasticGradientGlmSampler, sampler)(model_.get(), loglike, prior,
+                                               100, .2);
+    sampler->set_control_variate(mle);
+    sampler->set_preconditioner(variance);
+    model_->set_method(sampler);
+
+    for (bool hamiltonian : {false, true}) {
+      if (hamiltonian) {
+        sampler->use_hamiltonian_dynamics(.3);
+      } else {
+        sampler->use_langevin_dynamics();
+      }
+      model_->set_Beta(mle);
+      int niter = 4000;
+      Matrix draws(niter, beta_.size());
+      for (int i = 0; i < niter; ++i) {
+        model_->sample_posterior();
+        draws.row(i) = model_->Beta();
+      }
+      Vector draw_mean = mean(draws);
+      for (int j = 0; j < beta_.size(); ++j) {
+        double posterior_sd = sqrt(variance(j, j));
+        EXPECT_NEAR(mle[j], draw_mean[j], .25 * posterior_sd)
+            << "hamiltonian = " << hamiltonian << endl;
+        double draw_sd = sd(draws.col(j));
+        EXPECT_GT(draw_sd, .6 * posterior_sd) << "hamiltonian = " << hamiltonian;
+        EXPECT_LT(draw_sd, 1.6 * posterior_sd) << "hamiltonian = " << hamiltonian;
+      }
+    }
+  }
+
+}  // namespace
@@ -0,0 +1,198 @@
+#include "gtest/gtest.h"
+#include "Models/ChisqModel.hpp"
+#include "Models/Glm/MvtRegModel.hpp"
+#include "Models/Glm/PosteriorSamplers/MvtRegSampler.hpp"
+#include "Models/Glm/PosteriorSamplers/TRegressionSampler.hpp"
+#include "Models/Glm/TRegression.hpp"
+#include "Models/MvnModel.hpp"
+#include "Models/UniformModel.hpp"
+#include "distributions.hpp"
+#include "test_utils/test_utils.hpp"
+
+namespace {
+  using namespace BOOM;
+  using std::endl;
+
+  class StudentRegressionTest : public ::testing::Test {
+   protected:
+    StudentRegressionTest()
+        : nobs_(2000),
+          xdim_(4),
+          residual_sd_(0.5),
+          tail_thickness_(4) {
+      GlobalRng::rng.seed(8675309);
+      predictors_.resize(nobs_, xdim_);
+      predictors_.randomize();
+      predictors_.col(0) = 1.0;
+      coefficients_.resize(xdim_);
+      coefficients_.randomize();
+      response_ = predictors_ * coefficients_;
+      for (int i = 0; i < nobs_; ++i) {
+        response_[i] += rstudent_mt(GlobalRng::rng, 0, residual_sd_,
+                                    tail_thickness_);
+      }
+    }
+
+    Ptr<TRegressionSampler> SetSampler(TRegressionModel *model) {
+      NEW(MvnModel, coefficient_prior)(Vector(xdim_, 0.0),
+                                       SpdMatrix(xdim_, 100.0));
+      NEW(ChisqModel, siginv_prior)(1.0, 1.0);
+      NEW(UniformModel, nu_prior)(.1, 100);
+      NEW(TRegressionSampler, sampler)(model, coefficient_prior,
+                                       siginv_prior, nu_prior);
+      model->set_method(sampler);
+      return sampler;
+    }
+
+    int nobs_;
+    int xdim_;
+    double residual_sd_;
+    double tail_thickness_;
+    Matrix predictors_;
+    Vector coefficients_;
+    Vector response_;
+  };
+
+  TEST_F(StudentRegressionTest, BlockImputation) {
+    NEW(TRegressionModel, model)(predictors_, response_);
+    model->set_Beta(coefficients_);
+    model->set_sigsq(square(residual_sd_));
+    model->set_nu(tail_thickness_);
+    Ptr<TRegressionSampler> sampler = SetSampler(model.get());
+    sampler->impute_latent_data();
+
+    // Every observation contributes to the complete data, and the weights
+    // have mean 1.
+    const WeightedRegSuf &suf(sampler->complete_data_sufficient_statistics());
+    EXPECT_DOUBLE_EQ(suf.n(), nobs_);
+    EXPECT_NEAR(suf.sumw() / nobs_, 1.0, .05);
+
+    // The residuals of outliers are downweighted.
+    EXPECT_LT(suf.weighted_sum_of_squared_errors(coefficients_) / suf.n(),
+              1.2 * square(residual_sd_));
+  }
+
+  TEST_F(StudentRegressionTest, McmcRecoversParameters) {
+    NEW(TRegressionModel, model)(predictors_, response_);
+    Ptr<TRegressionSampler> sampler = SetSampler(model.get());
+    sampler->set_number_of_threads(4);
+    int niter = 1000;
+    int burn = 100;
+    Matrix beta_draws(niter, xdim_);
+    Vector sigma_draws(niter);
+    for (int i = 0; i < burn; ++i) {
+      model->sample_posterior();
+    }
+    for (int i = 0; i < niter; ++i) {
+      model->sample_posterior();
+      beta_draws.row(i) = model->Beta();
+      sigma_draws[i] = model->sigma();
+    }
+    auto status = CheckMcmcMatrix(beta_draws, coefficients_);
+    EXPECT_TRUE(status.ok) << status;
+    EXPECT_TRUE(CheckMcmcVector(sigma_draws, residual_sd_))
+        << "Residual SD failed to cover.";
+  }
+
+  // Sharded imputation gives the same draws for any number of threads.
+  TEST_F(StudentRegressionTest, ThreadedMcmcIsReproducible) {
+    Matrix draws[2];
+    int threads[2] = {0, 4};
+    for (int run = 0; run < 2; ++run) {
+      NEW(TRegressionModel, model)(predictors_, response_);
+      Ptr<TRegressionSampler> sampler = SetSampler(model.get());
+      sampler->set_number_of_threads(threads[run]);
+      sampler->set_seed(12345);
+      draws[run].resize(20, xdim_);
+      for (int i = 0; i < 20; ++i) {
+        model->sample_posterior();
+        draws[run].row(i) = model->Beta();
+      }
+    }
+    EXPECT_TRUE(MatrixEquals(draws[0], draws[1]));
+  }
+
+  //===========================================================================
+  class MvtRegressionTest : public ::testing::Test {
+   protected:
+    MvtRegressionTest()
+        : nobs_(2000),
+          xdim_(3),
+          ydim_(2),
+          tail_thickness_(5) {
+      GlobalRng::rng.seed(8675309);
+      coefficients_.resize(xdim_, ydim_);
+      coefficients_.randomize();
+      Sigma_.resize(ydim_);
+      Sigma_(0, 0) = 1.0;
+      Sigma_(1, 1) = 2.0;
+      Sigma_(0, 1) = Sigma_(1, 0) = .6;
+      predictors_.resize(nobs_, xdim_);
+      predictors_.randomize();
+      predictors_.col(0) = 1.0;
+      response_.resize(nobs_, ydim_);
+      for (int i = 0; i < nobs_; ++i) {
+        Vector yhat = predictors_.row(i) * coefficients_;
+        response_.row(i) = rmvt_mt(GlobalRng::rng, yhat, Sigma_,
+                                   tail_thickness_);
+      }
+    }
+
+    Ptr<MvtRegSampler> SetSampler(MvtRegModel *model) {
+      NEW(UniformModel, nu_prior)(.1, 100);
+      NEW(MvtRegSampler, sampler)(model, Matrix(xdim_, ydim_, 0.0), 1.0,
+                                  1.0, SpdMatrix(ydim_, 1.0), nu_prior);
+      model->set_method(sampler);
+      return sampler;
+    }
+
+    int nobs_;
+    int xdim_;
+    int ydim_;
+    double tail_thickness_;
+    Matrix coefficients_;
+    SpdMatrix Sigma_;
+    Matrix predictors_;
+    Matrix response_;
+  };
+
+  TEST_F(MvtRegressionTest, McmcRecoversParameters) {
+    NEW(MvtRegModel, model)(predictors_, response_);
+    Ptr<MvtRegSampler> sampler = SetSampler(model.get());
+    sampler->set_number_of_threads(4);
+    int niter = 500;
+    int burn = 100;
+    Matrix beta_draws(niter, xdim_ * ydim_);
+    for (int i = 0; i < burn; ++i) {
+      model->sample_posterior();
+    }
+    for (int i = 0; i < niter; ++i) {
+      model->sample_posterior();
+      beta_draws.row(i) = vec(model->Beta());
+    }
+    auto status = CheckMcmcMatrix(beta_draws, vec(coefficients_));
+    EXPECT_TRUE(status.ok) << status;
+  }
+
+  // Sharded imputation gives the same draws for any number of threads.
+  TEST_F(MvtRegressionTest, ThreadedMcmcIsReproducible) {
+    Matrix draws[2];
+    int threads[2] = {0, 4};
+    for (int run = 0; run < 2; ++run) {
+      // The nu and regression samplers inside MvtRegSampler draw from
+      // GlobalRng, or from RNGs that it seeds.
+      GlobalRng::rng.seed(12345);
+      NEW(MvtRegModel, model)(predictors_, response_);
+      Ptr<MvtRegSampler> sampler = SetSampler(model.get());
+      sampler->set_number_of_threads(threads[run]);
+      sampler->set_seed(12345);
+      draws[run].resize(20, xdim_ * ydim_);
+      for (int i = 0; i < 20; ++i) {
+        model->sample_posterior();
+        draws[run].row(i) = vec(model->Beta());
+      }
+    }
+    EXPECT_TRUE(MatrixEquals(draws[0], draws[1]));
+  }
+
+}  // namespace
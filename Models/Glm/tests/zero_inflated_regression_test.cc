@@ -0,0 +1,114 @@
+#include "gtest/gtest.h"
+#include "Models/Glm/PosteriorSamplers/ZeroInflatedPoissonRegressionSampler.hpp"
+#include "Models/Glm/ZeroInflatedLognormalRegression.hpp"
+#include "Models/MvnModel.hpp"
+#include "distributions.hpp"
+#include "stats/moments.hpp"
+#include "test_utils/test_utils.hpp"
+
+namespace {
+  using namespace BOOM;
+  using std::endl;
+  using std::cout;
+
+  class ZeroInflatedRegressionTest : public ::testing::Test {
+   protected:
+    ZeroInflatedRegressionTest() {
+      GlobalRng::rng.seed(8675309);
+    }
+
+    // A vector of predictors with an intercept.
+    Vector random_predictors(int dim) {
+      Vector x(dim);
+      x.randomize();
+      x[0] = 1.0;
+      return x;
+    }
+  };
+
+  // The blocked logistic regression log likelihood agrees with the
+  // observation-by-observation formula, for any number of threads.
+  TEST_F(ZeroInflatedRegressionTest, LognormalLogLikelihood) {
+    int dim = 3;
+    NEW(ZeroInflatedLognormalRegressionModel, model)(dim);
+    Vector logit_coefficients = {.3, -1.0, .5};
+    Vector regression_coefficients = {1.0, .2, -.4};
+    model->logit_coefficient_ptr()->set_Beta(logit_coefficients);
+    model->regression_coefficient_ptr()->set_Beta(regression_coefficients);
+    for (int i = 0; i < 1000; ++i) {
+      Vector x = random_predictors(dim);
+      NEW(RegressionData, data_point)(model->sim(x), x);
+      model->add_data(data_point);
+    }
+
+    Vector alpha = {.1, -.8, .6};
+    Vector beta = {.9, .3, -.3};
+    double sigsq = 1.3;
+    double expected = RegressionModel::log_likelihood(beta, sigsq,
+                                                      *model->suf());
+    for (const auto &dp : model->dat()) {
+      double p = plogis(alpha.dot(dp->x()));
+      expected += dp->y() > model->zero_threshold() ? log(p) : log(1 - p);
+    }
+
+    EXPECT_NEAR(expected, model->log_likelihood(alpha, beta, sigsq), 1e-8);
+    model->set_number_of_threads(4);
+    double threaded = model->log_likelihood(alpha, beta, sigsq);
+    EXPECT_NEAR(expected, threaded, 1e-8);
+    model->set_number_of_threads(0);
+    EXPECT_DOUBLE_EQ(threaded, model->log_likelihood(alpha, beta, sigsq));
+  }
+
+  // The threaded sampler recovers the coefficients used to simulate the data.
+  TEST_F(ZeroInflatedRegressionTest, PoissonMcmc) {
+    int dim = 2;
+    Vector poisson_coefficients = {1.0, .5};
+    Vector logit_coefficients = {.5, -1.0};
+    NEW(ZeroInflatedPoissonRegressionModel, model)(dim);
+    model->poisson_coefficient_ptr()->set_Beta(poisson_coefficients);
+    model->logit_coefficient_ptr()->set_Beta(logit_coefficients);
+    for (int i = 0; i < 1000; ++i) {
+      Vector x = random_predictors(dim);
+      int64_t trials = 10;
+      int64_t events = 0;
+      int64_t zeros = 0;
+      for (int trial = 0; trial < trials; ++trial) {
+        int64_t y = lround(model->sim(x));
+        events += y;
+        zeros += y == 0;
+      }
+      model->add_data(
+          new ZeroInflatedPoissonRegressionData(events, x, trials, zeros));
+    }
+    model->poisson_coefficient_ptr()->set_Beta(Vector(dim, 0.0));
+    model->logit_coefficient_ptr()->set_Beta(Vector(dim, 0.0));
+
+    NEW(VariableSelectionPrior, poisson_spike)(dim, 1.0);
+    NEW(MvnModel, poisson_slab)(Vector(dim, 0.0), SpdMatrix(dim, 1.0));
+    NEW(VariableSelectionPrior, logit_spike)(dim, 1.0);
+    NEW(MvnModel, logit_slab)(Vector(dim, 0.0), SpdMatrix(dim, 1.0));
+    NEW(ZeroInflatedPoissonRegressionSampler, sampler)(
+        model.get(), poisson_spike, poisson_slab, logit_spike, logit_slab);
+    sampler->set_number_of_threads(4);
+    model->set_method(sampler);
+
+    int niter = 500;
+    int burn = 100;
+    Matrix poisson_draws(niter - burn, dim);
+    Matrix logit_draws(niter - burn, dim);
+    for (int i = 0; i < niter; ++i) {
+      model->sample_posterior();
+      if (i >= burn) {
+        poisson_draws.row(i - burn) = model->poisson_coefficients().Beta();
+        logit_draws.row(i - burn) = model->logit_coefficients().Beta();
+      }
+    }
+    for (int j = 0; j < dim; ++j) {
+      EXPECT_NEAR(mean(poisson_draws.col(j)), poisson_coefficients[j], .15)
+          << "poisson coefficient " << j;
+      EXPECT_NEAR(mean(logit_draws.col(j)), logit_coefficients[j], .25)
+          << "logit coefficient " << j;
+    }
+  }
+
+}  // namespace
@@ -405,6 +405,70 @@ namespace BOOM {
     return oldloglike;
   }
 
+  //----------------------------------------------------------------------
+  double NestedHmm::streaming_fwd_bkwd(Clickstream::StreamSource &source,
+                                       bool bayes, bool find_mode) {
+    clear_client_data();
+    fill_big_Q();
+    pass_params_to_workers();
+    source.rewind();
+    std::vector<Ptr<Stream>> chunk;
+    double loglike = 0;
+    while (source.next_chunk(chunk) > 0) {
+      loglike += chunk_fwd_bkwd(chunk);
+    }
+
+    if (!workers_.empty()) {
+      // Give the workers back their share of the model's own data.
+      for (int i = 0; i < workers_.size(); ++i) workers_[i]->clear_data();
+      allocate_data_to_workers();
+    }
+
+    loglike_->set(loglike);
+    if (bayes) {
+      loglike += logpri();
+      logpost_->set(loglike);
+    }
+    if (find_mode) complete_data_mode(bayes);
+    return loglike;
+  }
+
+  //----------------------------------------------------------------------
+  // Add the expected complete data sufficient statistics for the streams in
+  // 'chunk' to suf_vec(), and return their log likelihood.  Assumes
+  // fill_big_Q() and pass_params_to_workers() have already been called.
+  double NestedHmm::chunk_fwd_bkwd(const std::vector<Ptr<Stream>> &chunk) {
+    if (workers_.empty()) {
+      double loglike = 0;
+      for (int i = 0; i < chunk.size(); ++i) {
+        loglike += fwd(chunk[i]);
+        bkwd_smoothing(chunk[i]);
+      }
+      return loglike;
+    }
+    int nworkers = workers_.size();
+    for (int i = 0; i < nworkers; ++i) workers_[i]->clear_data();
+    for (int i = 0; i < chunk.size(); ++i) {
+      workers_[i % nworkers]->add_data(chunk[i]);
+    }
+    start_thread_em();
+    return collect_threads();
+  }
+
+  //----------------------------------------------------------------------
+  double NestedHmm::streaming_EM(Clickstream::StreamSource &source, double eps,
+                                 bool bayes) {
+    double crit = 1 + eps;
+    randomize_starting_values();
+    double oldloglike = streaming_fwd_bkwd(source, bayes);
+    while (crit > eps) {
+      double loglike = streaming_fwd_bkwd(source, bayes);
+      crit = loglike - oldloglike;
+      oldloglike = loglike;
+    }
+    return oldloglike;
+  }
+
   //----------------------------------------------------------------------
 
   std::ostream &NestedHmm::write_suf(std::ostream &out) const {
@@ -590,7 +654,7 @@ namespace BOOM {
   }
   //----------------------------------------------------------------------
   void NestedHmm::start_thread_imputation() {
-    ThreadWorkerPool pool;
+    SharedThreadPool pool;
     pool.add_threads(workers_.size());
     std::vector<std::future<void>> futures;
     for (int i = 0; i < workers_.size(); ++i){
@@ -615,7 +679,7 @@ namespace BOOM {
   }
   //----------------------------------------------------------------------
   void NestedHmm::start_thread_em() {
-    ThreadWorkerPool pool;
+    SharedThreadPool pool;
     pool.add_threads(workers_.size());
     std::vector<std::future<void>> futures;
     for (int i = 0; i < workers_.size(); ++i) {
@@ -31,6 +31,7 @@
 #include "distributions/rng.hpp"
 
 #include "Models/HMM/Clickstream/Stream.hpp"
+#include "Models/HMM/Clickstream/StreamSource.hpp"
 
 namespace BOOM {
 
@@ -90,6 +91,17 @@ namespace BOOM {
     // Fit the model (find the MLE) using an EM algorithm.
     double EM(double epsilon, bool bayes = true);
 
+    // Streaming versions of fwd_bkwd() and EM(), for data sets too large to
+    // hold in memory.  Streams are read from 'source' one chunk at a time.
+    // If set_threads() has been called, each chunk is divided among the
+    // workers.  Only the sufficient statistics in suf_vec() are accumulated
+    // across chunks, so memory use is bounded by the chunk size.  Any data
+    // owned by the model itself are ignored.
+    double streaming_fwd_bkwd(Clickstream::StreamSource &source,
+                              bool bayes = false, bool find_mode = true);
+    double streaming_EM(Clickstream::StreamSource &source, double epsilon,
+                        bool bayes = true);
+
     std::ostream &write_suf(std::ostream &) const;
 
     // Sets the number of threads to use for data imputation.
@@ -198,6 +210,7 @@ namespace BOOM {
     ConstSubMatrix get_block(const Matrix &P, int H1, int H2) const;
     Matrix get_Htrans(const Matrix &P) const;
     double fwd_bkwd_with_threads(bool bayes = false, bool find_mode = true);
+    double chunk_fwd_bkwd(const std::vector<Ptr<Stream>> &chunk);
     double impute_latent_data_with_threads();
 
     double collect_threads();
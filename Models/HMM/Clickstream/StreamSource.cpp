@@ -0,0 +1,43 @@
+// Copyright 2018 Google LLC. All Rights Reserved.
+/*
+  Copyright (C) 2005-2018 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#include "Models/HMM/Clickstream/StreamSource.hpp"
+#include <algorithm>
+#include "cpputil/report_error.hpp"
+
+namespace BOOM {
+  namespace Clickstream {
+
+    VectorStreamSource::VectorStreamSource(
+        const std::vector<Ptr<Stream>> &streams, int chunk_size)
+        : streams_(streams), chunk_size_(chunk_size), position_(0) {
+      if (chunk_size_ <= 0) {
+        report_error("chunk_size must be positive.");
+      }
+    }
+
+    int VectorStreamSource::next_chunk(std::vector<Ptr<Stream>> &chunk) {
+      int end = std::min<int>(position_ + chunk_size_, streams_.size());
+      chunk.assign(streams_.begin() + position_, streams_.begin() + end);
+      position_ = end;
+      return chunk.size();
+    }
+
+  }  // namespace Clickstream
+}  // namespace BOOM
@@ -0,0 +1,74 @@
+// Copyright 2018 Google LLC. All Rights Reserved.
+/*
+  Copyright (C) 2005-2018 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#ifndef BOOM_CLICKSTREAM_STREAM_SOURCE_HPP_
+#define BOOM_CLICKSTREAM_STREAM_SOURCE_HPP_
+
+#include <vector>
+#include "Models/HMM/Clickstream/Stream.hpp"
+#include "cpputil/Ptr.hpp"
+
+namespace BOOM {
+  namespace Clickstream {
+
+    // A StreamSource delivers user streams a chunk at a time, so that a
+    // NestedHmm can be fit to more data than will fit in memory.  Concrete
+    // sources might read from files, a database, or a network connection.
+    // An EM algorithm makes several passes through the data, so a source
+    // must be able to start over from the beginning.
+    class StreamSource {
+     public:
+      virtual ~StreamSource() {}
+
+      // Fill 'chunk' with the next group of streams.  Any existing contents
+      // of 'chunk' are discarded.
+      //
+      // Returns:
+      //   The number of streams placed in chunk.  A return value of 0 means
+      //   the source is exhausted.
+      virtual int next_chunk(std::vector<Ptr<Stream>> &chunk) = 0;
+
+      // Return to the beginning of the data, so the next call to next_chunk
+      // returns the first chunk again.
+      virtual void rewind() = 0;
+    };
+
+    // A StreamSource serving streams that are already in memory.  Mainly
+    // useful for testing, and for adapting existing data to code written
+    // against the StreamSource interface.
+    class VectorStreamSource : public StreamSource {
+     public:
+      // Args:
+      //   streams:  The data to be served.
+      //   chunk_size:  The maximum number of streams in each chunk.
+      VectorStreamSource(const std::vector<Ptr<Stream>> &streams,
+                         int chunk_size);
+      int next_chunk(std::vector<Ptr<Stream>> &chunk) override;
+      void rewind() override { position_ = 0; }
+
+     private:
+      std::vector<Ptr<Stream>> streams_;
+      int chunk_size_;
+      int position_;
+    };
+
+  }  // namespace Clickstream
+}  // namespace BOOM
+
+#endif  // BOOM_CLICKSTREAM_STREAM_SOURCE_HPP_
@@ -20,9 +20,11 @@
 #include "Models/HMM/HMM2.hpp"
 #include "Models/HMM/HmmDataImputer.hpp"
 #include "Models/HMM/HmmFilter.hpp"
+#include "Models/HMM/hmm_tools.hpp"
 
 #include "Models/EmMixtureComponent.hpp"
 #include "Models/MarkovModel.hpp"
+#include "Samplers/McmcProfiler.hpp"
 
 #include "cpputil/math_utils.hpp"
 #include "cpputil/report_error.hpp"
@@ -32,6 +34,7 @@
 
 #include <cmath>
 #include <future>
+#include <mutex>
 #include <stdexcept>
 
 namespace BOOM {
@@ -48,7 +51,8 @@ namespace BOOM {
         mix_(Mix),
         filter_(new HmmFilter(mix_, mark_)),
         loglike_(new UnivParams(0.0)),
-        logpost_(new UnivParams(0.0)) {
+        logpost_(new UnivParams(0.0)),
+        beam_width_(0) {
     ParamPolicy::set_models(mix_.begin(), mix_.end());
     ParamPolicy::add_model(mark_);
   }
@@ -61,7 +65,9 @@ namespace BOOM {
         mark_(rhs.mark_->clone()),
         mix_(rhs.state_space_size()),
         loglike_(new UnivParams(0.0)),
-        logpost_(new UnivParams(0.0)) {
+        logpost_(new UnivParams(0.0)),
+        sparse_pattern_(rhs.sparse_pattern_),
+        beam_width_(rhs.beam_width_) {
     for (uint i = 0; i < state_space_size(); ++i) {
       mix_[i] = rhs.mix_[i]->clone();
     }
@@ -100,7 +106,89 @@ namespace BOOM {
 
   void HMM::set_pi0(const Vector &pi0) { mark_->set_pi0(pi0); }
   void HMM::set_Q(const Matrix &Q) { mark_->set_Q(Q); }
-  void HMM::set_filter(const Ptr<HmmFilter> &f) { filter_ = f; }
+  void HMM::set_filter(const Ptr<HmmFilter> &f) {
+    filter_ = f;
+    filter_->set_sparse_transitions(sparse_pattern_, beam_width_);
+  }
+
+  void HMM::set_sparse_transitions(const Matrix &allowed, int beam_width) {
+    if (allowed.nrow() != state_space_size()) {
+      report_error("The matrix of allowed transitions has the wrong size.");
+    }
+    sparse_pattern_ = std::make_shared<SparseTransitionPattern>(allowed);
+    beam_width_ = beam_width;
+    filter_->set_sparse_transitions(sparse_pattern_, beam_width_);
+    if (!workers_.empty()) {
+      // The workers pick up the pattern when they are created.
+      set_nthreads(workers_.size());
+    }
+  }
+
+  //----------------------------------------------------------------------
+  void HMM::series_log_densities(const DataSeriesType &ts,
+                                 Matrix &log_densities) const {
+    uint S = state_space_size();
+    Matrix by_time(ts.size(), S);
+    for (uint s = 0; s < S; ++s) {
+      mix_[s]->pdf_batch(ts, by_time.col(s), true);
+    }
+    log_densities = by_time.transpose();
+  }
+
+  double HMM::viterbi_path_impl(int series, int *path) const {
+    Matrix log_densities;
+    series_log_densities(dat(series), log_densities);
+    return BOOM::viterbi_path(mark_->pi0(), mark_->Q(), log_densities, path);
+  }
+
+  void HMM::state_marginals_impl(int series, Matrix &state_probs,
+                                 bool smoothed) const {
+    Matrix log_densities;
+    series_log_densities(dat(series), log_densities);
+    if (sparse_pattern_) {
+      Vector values;
+      sparse_pattern_->gather(mark_->Q(), values);
+      sparse_fwd_marginals(mark_->pi0(), *sparse_pattern_, values,
+                           log_densities, state_probs, beam_width_);
+    } else {
+      fwd_marginals(mark_->pi0(), mark_->Q(), log_densities, state_probs);
+    }
+    if (smoothed) {
+      smooth_marginals(mark_->Q(), state_probs);
+    }
+  }
+
+  double HMM::viterbi_path(int series, int *path) {
+    prepare_shared_parameters();
+    return viterbi_path_impl(series, path);
+  }
+
+  void HMM::state_marginals(int series, Matrix &state_probs, bool smoothed) {
+    prepare_shared_parameters();
+    state_marginals_impl(series, state_probs, smoothed);
+  }
+
+  void HMM::decode_viterbi(const ViterbiCallback &callback) {
+    prepare_shared_parameters();
+    std::mutex callback_mutex;
+    thread_pool_.parallel_for(0, nseries(), 1, [&](int series) {
+      std::vector<int> path(dat(series).size());
+      double log_probability = viterbi_path_impl(series, path.data());
+      std::lock_guard<std::mutex> lock(callback_mutex);
+      callback(series, path, log_probability);
+    });
+  }
+
+  void HMM::decode_marginals(const MarginalCallback &callback, bool smoothed) {
+    prepare_shared_parameters();
+    std::mutex callback_mutex;
+    thread_pool_.parallel_for(0, nseries(), 1, [&](int series) {
+      Matrix state_probs;
+      state_marginals_impl(series, state_probs, smoothed);
+      std::lock_guard<std::mutex> lock(callback_mutex);
+      callback(series, state_probs);
+    });
+  }
 
   void HMM::fix_pi0(const Vector &Pi0) { mark_->fix_pi0(Pi0); }
   void HMM::fix_pi0_stationary() { mark_->fix_pi0_stationary(); }
@@ -124,9 +212,9 @@ namespace BOOM {
   }
 
   void HMM::clear_prob_hist() {
-    for (std::map<Ptr<Data>, Vector>::iterator it = prob_hist_.begin();
-         it != prob_hist_.end(); ++it) {
-      it->second = 0.0;
+    Ptr<HmmSavePiFilter> filter(filter_.dcast<HmmSavePiFilter>());
+    if (!!filter) {
+      filter->clear_state_probs();
     }
   }
 
@@ -148,24 +236,18 @@ namespace BOOM {
   }
 
   void HMM::save_state_probs() {
-    NEW(HmmSavePiFilter, filter)(mix_, mark_, prob_hist_);
+    NEW(HmmSavePiFilter, filter)(mix_, mark_);
     set_filter(filter);
   }
 
   Matrix HMM::report_state_probs(const DataSeriesType &ts) const {
-    int n = ts.size();
-    int S = state_space_size();
-    Matrix ans(n, S);
     Ptr<HmmSavePiFilter> filter(filter_.dcast<HmmSavePiFilter>());
     if (!filter) {
       report_error(
           "filter could not be cast to SavePiFilter in "
           "HMM::report_state_probs");
     }
-    for (int i = 0; i < n; ++i) {
-      ans.row(i) = filter->state_probs(ts[i]);
-    }
-    return ans;
+    return filter->state_probs(ts);
   }
 
   //======================================================================
@@ -227,6 +309,7 @@ namespace BOOM {
   }
 
   double HMM::impute_latent_data() {
+    ScopedPhaseTimer timer(McmcProfiler::kImputeLatentData);
     if (nthreads() > 0) {
       return impute_latent_data_with_threads();
     }
@@ -236,8 +319,8 @@ namespace BOOM {
     uint ns = nseries();
     for (uint series = 0; series < ns; ++series) {
       const DataSeriesType &ts(dat(series));
-      ans += filter_->fwd(ts);
-      filter_->bkwd_sampling(ts);
+      ans += filter_->fwd_marginal(ts);
+      filter_->bkwd_sampling_marginal(ts);
     }
     set_loglike(ans);
     set_logpost(ans + logpri());
@@ -287,6 +370,23 @@ namespace BOOM {
 
   uint HMM::nthreads() const { return workers_.size(); }
 
+  // The workers evaluate densities using the HMM's own mixture components.
+  // Some models compute derived quantities (e.g. matrix decompositions)
+  // lazily on the first call to pdf, so evaluate each component once here to
+  // make those calls read-only by the time the workers start.
+  void HMM::prepare_shared_parameters() {
+    for (uint series = 0; series < nseries(); ++series) {
+      for (const Ptr<Data> &dp : dat(series)) {
+        if (!dp->missing()) {
+          for (uint s = 0; s < state_space_size(); ++s) {
+            mix_[s]->pdf(dp.get(), true);
+          }
+          return;
+        }
+      }
+    }
+  }
+
   namespace {
     class HmmWorkWrapper {
      public:
@@ -302,6 +402,7 @@ namespace BOOM {
   double HMM::impute_latent_data_with_threads() {
     try {
       clear_client_data();
+      prepare_shared_parameters();
 
       std::vector<std::future<void>> futures;
       for (int i = 0; i < nthreads(); ++i) {
@@ -314,7 +415,7 @@ namespace BOOM {
       for (uint i = 0; i < nthreads(); ++i) {
         futures[i].get();
         loglike += workers_[i]->loglike();
-        mark_->combine_data(*workers_[i]->mark(), true);
+        mark_->suf()->combine(workers_[i]->transition_suf());
         for (uint s = 0; s < S; ++s) {
           mix_[s]->combine_data(*workers_[i]->models(s), true);
         }
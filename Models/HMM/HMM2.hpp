@@ -20,6 +20,8 @@
 #ifndef BOOM_HMM_HPP
 #define BOOM_HMM_HPP
 
+#include <functional>
+#include <memory>
 #include <vector>
 #include "uint.hpp"
 #include "Models/DataTypes.hpp"
@@ -35,6 +37,7 @@ namespace BOOM {
   class HmmFilter;
   class HmmEmFilter;
   class HmmDataImputer;
+  class SparseTransitionPattern;
 
   // A HiddenMarkovModel models one or more time series using a hidden Markov
   // mixture of an arbitrary set of mixture components.  If multiple time series
@@ -70,6 +73,29 @@ namespace BOOM {
     virtual void initialize_params();
     void set_nthreads(uint);
 
+    // Restrict the hidden Markov chain to the transitions marked by the
+    // nonzero elements of 'allowed', and filter using a sparse transition
+    // matrix.  The Markov model's prior should put zero probability on the
+    // other transitions, e.g. a MarkovConjSampler whose prior counts are
+    // zero outside the allowed pattern.  Only the MCMC path
+    // (impute_latent_data) uses the sparse filter.
+    //
+    // Args:
+    //   allowed:  An S x S matrix whose nonzero elements are the allowed
+    //     transitions.
+    //   beam_width: If positive, the forward filter keeps only this many of
+    //     the most probable states at each time point.  This is an
+    //     approximation, intended for online decoding.
+    void set_sparse_transitions(const Matrix &allowed, int beam_width = 0);
+
+    // The allowed transitions set by set_sparse_transitions, or nullptr if
+    // the dense filter is in use.
+    const std::shared_ptr<const SparseTransitionPattern> &
+    sparse_transition_pattern() const {
+      return sparse_pattern_;
+    }
+    int beam_width() const { return beam_width_; }
+
     double pdf(const Ptr<Data> &dp, bool logscale) const;
     void clear_client_data();
 
@@ -85,6 +111,50 @@ namespace BOOM {
     double saved_loglike() const;
     void randomly_assign_data();
 
+    //----------------------------------------------------------------------
+    // Streaming decoders, for scoring data with the current parameters.
+    // Each series is decoded by its own task on the model's thread pool (see
+    // set_nthreads), and the result is passed to the callback as soon as the
+    // series is done.  Nothing about a series is kept once its callback
+    // returns, so memory use is bounded by the size of the largest series
+    // times the number of threads.  Calls to the callback are serialized,
+    // but the series may arrive in any order.  None of these methods touch
+    // the saved state probabilities or the imputed states held by the
+    // filter.
+
+    // Args:
+    //   series:  The index of the series in dat().
+    //   path: The most likely sequence of hidden states for the series.
+    //   log_probability:  log p(path, y) for the series.
+    using ViterbiCallback = std::function<void(
+        int series, const std::vector<int> &path, double log_probability)>;
+
+    // Args:
+    //   series:  The index of the series in dat().
+    //   state_probs: An S x n matrix.  Column t is the distribution of the
+    //     hidden state at time t.
+    using MarginalCallback =
+        std::function<void(int series, const Matrix &state_probs)>;
+
+    // Compute the Viterbi path of every series.
+    void decode_viterbi(const ViterbiCallback &callback);
+
+    // Compute the marginal distribution of the hidden state at each time
+    // point of every series.  If 'smoothed' is false the distributions
+    // condition on the data up to time t (as in online decoding).  If true
+    // they condition on the whole series.
+    void decode_marginals(const MarginalCallback &callback,
+                          bool smoothed = false);
+
+    // Single series versions, which decode in the calling thread and write
+    // to a caller-supplied buffer.
+    //   viterbi_path:  'path' must have room for dat(series).size()
+    //     elements.  Returns log p(path, y).
+    //   state_marginals: 'state_probs' is resized to S x n.
+    double viterbi_path(int series, int *path);
+    void state_marginals(int series, Matrix &state_probs,
+                         bool smoothed = false);
+
     // For managing the distribution of hidden states.
     void save_state_probs();
     void clear_prob_hist();
@@ -111,14 +181,28 @@ namespace BOOM {
     Ptr<MarkovModel> mark_;
     std::vector<Ptr<MixtureComponent>> mix_;
     Ptr<HmmFilter> filter_;
-    std::map<Ptr<Data>, Vector> prob_hist_;
     Ptr<UnivParams> loglike_;
     Ptr<UnivParams> logpost_;
     std::vector<Ptr<HmmDataImputer>> workers_;
+    std::shared_ptr<const SparseTransitionPattern> sparse_pattern_;
+    int beam_width_;
 
-    ThreadWorkerPool thread_pool_;
+    SharedThreadPool thread_pool_;
 
     double impute_latent_data_with_threads();
+    void prepare_shared_parameters();
+
+    // Fill log_densities with the S x n matrix of log p(y[t] | h[t] = s) for
+    // series ts.  Safe to call from several threads once
+    // prepare_shared_parameters() has run.
+    void series_log_densities(const DataSeriesType &ts,
+                              Matrix &log_densities) const;
+
+    // The implementations of viterbi_path and state_marginals, minus the
+    // call to prepare_shared_parameters.
+    double viterbi_path_impl(int series, int *path) const;
+    void state_marginals_impl(int series, Matrix &state_probs,
+                              bool smoothed) const;
   };
   //----------------------------------------------------------------------
   class HMM_EM : public HiddenMarkovModel {
@@ -37,15 +37,15 @@ namespace BOOM {
     loglike_ = 0;
     for (uint i = 0; i < ns; ++i) {
       const std::vector<Ptr<Data> > &ts(*dat_[i]);
-      loglike_ += filter_->fwd(ts);
-      filter_->bkwd_sampling_mt(ts, eng);
+      loglike_ += filter_->fwd_marginal(ts);
+      filter_->bkwd_sampling_marginal(ts, eng);
     }
   }
 
   HmmDataImputer::HmmDataImputer(HiddenMarkovModel *hmm, uint id, uint nworkers)
       : id_(id),
         nworkers_(nworkers),
-        mark_(new MarkovModel(hmm->state_space_size())),
+        transition_suf_(new MarkovSuf(hmm->state_space_size())),
         eng(getseed()) {
     eng.seed();
     uint S = hmm->state_space_size();
@@ -53,18 +53,21 @@ namespace BOOM {
       Ptr<MixtureComponent> m(hmm->mixture_component(s)->clone());
       mix_.push_back(m);
     }
-    filter_ = new HmmFilter(mix_, mark_);
+    filter_ = new HmmFilter(hmm->mixture_components(), hmm->mark());
+    filter_->set_imputation_targets(mix_, transition_suf_);
+    filter_->set_sparse_transitions(hmm->sparse_transition_pattern(),
+                                    hmm->beam_width());
   }
 
   //----------------------------------------------------------------------
   double HmmDataImputer::loglike() const { return loglike_; }
   //----------------------------------------------------------------------
-  Ptr<MarkovModel> HmmDataImputer::mark() { return mark_; }
+  Ptr<MarkovSuf> HmmDataImputer::transition_suf() { return transition_suf_; }
   //----------------------------------------------------------------------
   Ptr<MixtureComponent> HmmDataImputer::models(uint s) { return mix_[s]; }
   //----------------------------------------------------------------------
   void HmmDataImputer::clear_client_data() {
-    mark_->clear_data();
+    transition_suf_->clear();
     uint S = mix_.size();
     for (uint s = 0; s < S; ++s) mix_[s]->clear_data();
   }
@@ -78,14 +81,5 @@ namespace BOOM {
       TimeSeries<Data> *ts = &(hmm->dat(i));
       dat_.push_back(ts);
     }
-
-    Vector theta = hmm->mark()->vectorize_params();
-    mark_->unvectorize_params(theta);
-
-    uint S = hmm->state_space_size();
-    for (uint s = 0; s < S; ++s) {
-      theta = hmm->mixture_component(s)->vectorize_params();
-      mix_[s]->unvectorize_params(theta);
-    }
   }
 }  // namespace BOOM
@@ -29,10 +29,17 @@
 
 namespace BOOM {
 
+  // Imputes the hidden states for a subset of the time series managed by a
+  // HiddenMarkovModel.  The worker filters using the parameters of the
+  // HMM's own mixture components and Markov model, which must not change
+  // while impute_data() is running.  The imputed data are accumulated in
+  // worker-owned copies of the mixture components (used only to hold data or
+  // sufficient statistics) and a worker-owned MarkovSuf, which the HMM
+  // combines once all workers have finished.
   class HmmDataImputer : private RefCounted {
    public:
     HmmDataImputer(HiddenMarkovModel *hmm, uint id, uint nworkers);
-    Ptr<MarkovModel> mark();
+    Ptr<MarkovSuf> transition_suf();
     Ptr<MixtureComponent> models(uint s);
     double loglike() const;
 
@@ -49,7 +56,9 @@ namespace BOOM {
    private:
     uint id_;
     uint nworkers_;
-    Ptr<MarkovModel> mark_;
+
+    // Accumulators for the imputed data.  Their parameters are never used.
+    Ptr<MarkovSuf> transition_suf_;
     std::vector<Ptr<MixtureComponent>> mix_;
     Ptr<HmmFilter> filter_;
     double loglike_;
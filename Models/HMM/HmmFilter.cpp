@@ -56,7 +56,9 @@ namespace BOOM {
         logpi(mix.size()),
         one(mix.size(), 1.0),
         logQ(mix.size(), mix.size()),
-        markov_(mark) {}
+        markov_(mark),
+        beam_width_(0),
+        current_slot_(-1) {}
 
   uint HmmFilter::state_space_size() const { return models_.size(); }
 
@@ -76,6 +78,14 @@ namespace BOOM {
     return loglike;
   }
 
+  void HmmFilter::compute_log_densities(const std::vector<Ptr<Data>> &dv) {
+    uint S = state_space_size();
+    log_densities_.resize(dv.size(), S);
+    for (uint s = 0; s < S; ++s) {
+      models_[s]->pdf_batch(dv, log_densities_.col(s), true);
+    }
+  }
+
   double HmmFilter::fwd(const std::vector<Ptr<Data>> &dv) {
     logQ = log(markov_->Q());
     uint n = dv.size();
@@ -83,12 +93,9 @@ namespace BOOM {
     if (logp.size() != S) logp.resize(S);
     if (P.size() < n) P.resize(n);
     double loglike = initialize(dv[0].get());
+    compute_log_densities(dv);
     for (uint i = 1; i < n; ++i) {
-      if (dv[i]->missing())
-        logp = 0;
-      else
-        for (uint s = 0; s < S; ++s)
-          logp[s] = models_[s]->pdf(dv[i].get(), true);
+      logp = log_densities_.row(i);
       loglike += fwd_1(pi, P[i], logQ, logp, one);
     }
     return loglike;
@@ -96,46 +103,83 @@ namespace BOOM {
   //------------------------------------------------------------
 
   double HmmFilter::loglike(const std::vector<Ptr<Data>> &dv) {
-    logQ = log(markov_->Q());
-    pi = markov_->pi0();
-    uint S = pi.size();
-    uint n = dv.size();
-    Matrix P(logQ);
-    double ans = initialize(dv[0].get());
-    for (uint i = 1; i < n; ++i) {
-      if (dv[i]->missing())
-        logp = 0;
-      else
-        for (uint s = 0; s < S; ++s)
-          logp[s] = models_[s]->pdf(dv[i].get(), true);
-      ans += fwd_1(pi, P, logQ, logp, one);
-    }
-    return ans;
+    return fwd_marginal(dv);
   }
   //------------------------------------------------------------
 
   void HmmFilter::bkwd_sampling_mt(const std::vector<Ptr<Data>> &data, RNG &rng) {
     uint sample_size = data.size();
-    std::vector<int> imputed_state(sample_size);
+    begin_series(data);
     // pi was already set by fwd.
     // So the following line would  break things when sample_size=1.
     //      pi = one * P.back();
     uint s = rmulti_mt(rng, pi);
-    models_[s]->add_data(data.back());
-    imputed_state.back() = s;
+    allocation_target(s)->add_data(data.back());
+    record_imputed_state(sample_size - 1, s);
     for (int64_t i = sample_size - 1; i >= 0; --i) {
       pi = P[i].col(s);
       pi.normalize_prob();
       uint r = rmulti_mt(rng, pi);
       if (i > 0) {
-        imputed_state[i - 1] = r;
+        record_imputed_state(i - 1, r);
       }
-      models_[r]->add_data(data[i - 1]);
-      markov_->suf()->add_transition(r, s);
+      allocation_target(r)->add_data(data[i - 1]);
+      transition_suf()->add_transition(r, s);
       s = r;
     }
-    markov_->suf()->add_initial_value(s);
-    imputed_state_map_[data] = imputed_state;
+    transition_suf()->add_initial_value(s);
+  }
+
+  //------------------------------------------------------------
+  double HmmFilter::fwd_marginal(const std::vector<Ptr<Data>> &dv) {
+    compute_log_densities(dv);
+    if (sparse_pattern_) {
+      sparse_pattern_->gather(markov_->Q(), sparse_values_);
+      return sparse_fwd_marginals(markov_->pi0(), *sparse_pattern_,
+                                  sparse_values_, log_densities_.transpose(),
+                                  filtered_, beam_width_);
+    }
+    return fwd_marginals(markov_->pi0(), markov_->Q(),
+                         log_densities_.transpose(), filtered_);
+  }
+
+  //------------------------------------------------------------
+  // allocate() is called with pi set to the distribution the state was
+  // drawn from, so that HmmSavePiFilter records it.
+  void HmmFilter::bkwd_sampling_marginal(const std::vector<Ptr<Data>> &dv,
+                                         RNG &rng) {
+    int n = dv.size();
+    int S = state_space_size();
+    const Matrix &Q(markov_->Q());
+    begin_series(dv);
+    pi = filtered_.col(n - 1);
+    uint s = rmulti_mt(rng, pi);
+    allocate(dv.back(), s);
+    record_imputed_state(n - 1, s);
+    for (int t = n - 1; t > 0; --t) {
+      const ConstVectorView previous(filtered_.col(t - 1));
+      if (sparse_pattern_) {
+        // Only the states that can transition to s are candidates.
+        pi = 0.0;
+        const std::vector<int> &rows(sparse_pattern_->row());
+        const std::vector<int> &position(sparse_pattern_->csr_position());
+        const std::vector<int> &column_start(sparse_pattern_->column_start());
+        for (int k = column_start[s]; k < column_start[s + 1]; ++k) {
+          pi[rows[k]] = previous[rows[k]] * sparse_values_[position[k]];
+        }
+      } else {
+        for (int r = 0; r < S; ++r) {
+          pi[r] = previous[r] * Q(r, s);
+        }
+      }
+      pi.normalize_prob();
+      uint r = rmulti_mt(rng, pi);
+      allocate(dv[t - 1], r);
+      record_imputed_state(t - 1, r);
+      transition_suf()->add_transition(r, s);
+      s = r;
+    }
+    transition_suf()->add_initial_value(s);
   }
 
   //------------------------------------------------------------
@@ -144,66 +188,144 @@ namespace BOOM {
     // pi was already set by fwd, so the following line would breaks
     // things when n=1.
     //      pi = one * P.back();
+    begin_series(dv);
     uint s = rmulti(pi);     // last obs in state s
     allocate(dv.back(), s);  // last data point allocated
+    record_imputed_state(n - 1, s);
 
     for (uint i = n - 1; i != 0; --i) {  // start with s=h[i]
       pi = P[i].col(s);                  // compute r = h[i-1]
       uint r = rmulti(pi);
       allocate(dv[i - 1], r);
-      markov_->suf()->add_transition(r, s);
+      record_imputed_state(i - 1, r);
+      transition_suf()->add_transition(r, s);
       s = r;
     }
-    markov_->suf()->add_initial_value(s);
+    transition_suf()->add_initial_value(s);
     // in last step of loop i = 1, so s=h[0]
   }
   //----------------------------------------------------------------------
   void HmmFilter::allocate(const Ptr<Data> &dp, uint h) {
-    models_[h]->add_data(dp);
+    allocation_target(h)->add_data(dp);
   }
-  Vector HmmFilter::state_probs(const Ptr<Data> &) const {
-    Vector ans;
+
+  void HmmFilter::set_imputation_targets(
+      const std::vector<Ptr<MixtureComponent>> &models,
+      const Ptr<MarkovSuf> &transitions) {
+    if (models.size() != models_.size()) {
+      report_error("One imputation target is needed for each state.");
+    }
+    if (!transitions) {
+      report_error("A MarkovSuf is needed to hold the imputed transitions.");
+    }
+    target_models_ = models;
+    target_suf_ = transitions;
+  }
+  Matrix HmmFilter::state_probs(const std::vector<Ptr<Data>> &) const {
     report_error(
         "state_probs() cannot be called with this filter.  "
         "Use an HmmSavePiFilter instead.");
-    return ans;
+    return Matrix();
   }
   //----------------------------------------------------------------------
   std::vector<int> HmmFilter::imputed_state(
       const std::vector<Ptr<Data>> &data) const {
-    const auto it = imputed_state_map_.find(data);
-    if (it == imputed_state_map_.end()) {
+    int slot = find_series_slot(data);
+    if (slot < 0 || imputed_states_[slot].size() != data.size()) {
       return std::vector<int>(0);
     } else {
-      return it->second;
+      return imputed_states_[slot];
     }
   }
-  
+
+  void HmmFilter::set_sparse_transitions(
+      const std::shared_ptr<const SparseTransitionPattern> &pattern,
+      int beam_width) {
+    if (pattern && pattern->state_space_size() != state_space_size()) {
+      report_error("The sparse transition pattern has the wrong dimension.");
+    }
+    sparse_pattern_ = pattern;
+    beam_width_ = beam_width;
+  }
+
+  void HmmFilter::clear_series_storage() {
+    series_slots_.clear();
+    imputed_states_.clear();
+    current_slot_ = -1;
+  }
+
+  int HmmFilter::find_series_slot(const std::vector<Ptr<Data>> &dv) const {
+    auto it = series_slots_.find(&dv);
+    return it == series_slots_.end() ? -1 : it->second;
+  }
+
+  // A single lookup per series, after which each time point is addressed
+  // directly by its index.
+  void HmmFilter::begin_series(const std::vector<Ptr<Data>> &dv) {
+    auto it = series_slots_.find(&dv);
+    if (it == series_slots_.end()) {
+      current_slot_ = imputed_states_.size();
+      series_slots_[&dv] = current_slot_;
+      imputed_states_.emplace_back();
+    } else {
+      current_slot_ = it->second;
+    }
+    imputed_states_[current_slot_].resize(dv.size());
+  }
+
+  void HmmFilter::record_imputed_state(int t, uint h) {
+    imputed_states_[current_slot_][t] = h;
+  }
+
   //======================================================================
   HmmSavePiFilter::HmmSavePiFilter(const std::vector<Ptr<MixtureComponent>> &mv,
-                                   const Ptr<MarkovModel> &mark,
-                                   std::map<Ptr<Data>, Vector> &pi_hist)
-      : HmmFilter(mv, mark), pi_hist_(pi_hist) {}
+                                   const Ptr<MarkovModel> &mark)
+      : HmmFilter(mv, mark) {}
   //----------------------------------------------------------------------
-  void HmmSavePiFilter::allocate(const Ptr<Data> &dp, uint h) {
-    models_[h]->add_data(dp);
-    Vector &v(pi_hist_[dp]);
-    if (v.empty()) v.resize(pi.size());
-    v += pi;
-  }
-
-  Vector HmmSavePiFilter::state_probs(const Ptr<Data> &dp) const {
-    std::map<Ptr<Data>, Vector>::const_iterator it = pi_hist_.find(dp);
-    if (it == pi_hist_.end()) {
-      ostringstream err;
-      err << "could not compute state probability distribution "
-          << "for data point " << *dp << endl;
-      report_error(err.str());
-    }
-    Vector ans(it->second);
-    ans.normalize_prob();
+  void HmmSavePiFilter::begin_series(const std::vector<Ptr<Data>> &dv) {
+    HmmFilter::begin_series(dv);
+    if (current_slot_ >= state_prob_sums_.size()) {
+      state_prob_sums_.resize(current_slot_ + 1);
+    }
+    Matrix &sums(state_prob_sums_[current_slot_]);
+    if (sums.nrow() != dv.size() || sums.ncol() != state_space_size()) {
+      sums.resize(dv.size(), state_space_size());
+      sums = 0.0;
+    }
+  }
+
+  void HmmSavePiFilter::record_imputed_state(int t, uint h) {
+    HmmFilter::record_imputed_state(t, h);
+    state_prob_sums_[current_slot_].row(t) += pi;
+  }
+
+  const Matrix &HmmSavePiFilter::state_prob_sums(
+      const std::vector<Ptr<Data>> &dv) const {
+    int slot = find_series_slot(dv);
+    if (slot < 0 || slot >= state_prob_sums_.size()) {
+      report_error("No state probabilities have been saved for this series.");
+    }
+    return state_prob_sums_[slot];
+  }
+
+  Matrix HmmSavePiFilter::state_probs(const std::vector<Ptr<Data>> &dv) const {
+    Matrix ans = state_prob_sums(dv);
+    for (int t = 0; t < ans.nrow(); ++t) {
+      ans.row(t).normalize_prob();
+    }
     return ans;
   }
+
+  void HmmSavePiFilter::clear_state_probs() {
+    for (Matrix &sums : state_prob_sums_) {
+      sums = 0.0;
+    }
+  }
+
+  void HmmSavePiFilter::clear_series_storage() {
+    HmmFilter::clear_series_storage();
+    state_prob_sums_.clear();
+  }
   //======================================================================
 
   // Note the conversion from EmMixtureComponent to MixtureComponent in the
@@ -20,7 +20,9 @@
 #ifndef BOOM_HMM_FILTER_HPP
 #define BOOM_HMM_FILTER_HPP
 
+#include <memory>
 #include "LinAlg/Matrix.hpp"
+#include "Models/HMM/hmm_tools.hpp"
 #include "Models/MarkovModel.hpp"
 #include "cpputil/Ptr.hpp"
 #include "cpputil/RefCounted.hpp"
@@ -50,32 +52,147 @@ namespace BOOM {
     double fwd(const std::vector<Ptr<Data>> &);
     void bkwd_sampling(const std::vector<Ptr<Data>> &);
     void bkwd_sampling_mt(const std::vector<Ptr<Data>> &, RNG &rng);
+
+    // A lower memory alternative to fwd() and bkwd_sampling().
+    // fwd_marginal() stores only the filtered distribution of each hidden
+    // state, which takes O(n * S) memory instead of O(n * S^2).  It returns
+    // the log likelihood of the data.
+    //
+    // bkwd_sampling_marginal() must follow a call to fwd_marginal() on the
+    // same data.  It draws the hidden states one at a time from the end of
+    // the series, using p(h[t-1] = r | h[t] = s, Y) proportional to
+    // filtered(r, t-1) * Q(r, s).  Each draw is passed to allocate(), and
+    // the transitions are added to the Markov model's sufficient statistics.
+    double fwd_marginal(const std::vector<Ptr<Data>> &);
+    void bkwd_sampling_marginal(const std::vector<Ptr<Data>> &,
+                                RNG &rng = GlobalRng::rng);
     virtual void allocate(const Ptr<Data> &, uint);
-    virtual Vector state_probs(const Ptr<Data> &) const;
 
-    // Return the state vector that was imputed for data during the call to
-    // bkwd_sampling or bkwd_sampling_mt.
+    // The posterior distribution of the hidden state at each time point in
+    // a data series, as an n x S matrix with rows summing to 1.  Only
+    // filters that save state probabilities (HmmSavePiFilter) support this.
+    virtual Matrix state_probs(const std::vector<Ptr<Data>> &) const;
+
+    // By default the imputed data are allocated to the mixture components
+    // and Markov model that define the filter.  Setting imputation targets
+    // sends them elsewhere, so that several filters can share one set of
+    // parameters (read only) while each accumulates its own sufficient
+    // statistics.
+    //
+    // Args:
+    //   models: One model per state, to which allocate() adds data.
+    //   transitions: Receives the imputed transitions and initial states.
+    void set_imputation_targets(const std::vector<Ptr<MixtureComponent>> &models,
+                                const Ptr<MarkovSuf> &transitions);
+
+    // Return the state vector that was imputed for data during the most
+    // recent call to bkwd_sampling_marginal or bkwd_sampling_mt.  The result
+    // is empty if no states have been imputed for data.
+    //
+    // Imputed states are stored densely, one array per data series, with the
+    // series identified by its address.  The data series must therefore be
+    // the same object (not a copy) that was passed to the sampler.
     std::vector<int> imputed_state(const std::vector<Ptr<Data>> &data) const;
-    
+
+    // Discard the storage associated with any previously seen data series.
+    virtual void clear_series_storage();
+
+    // Use a sparse representation of the transition probability matrix in
+    // fwd_marginal() and bkwd_sampling_marginal().  Transitions outside the
+    // pattern are treated as having probability zero, whatever their value
+    // in the Markov model's Q.  This reduces the cost of filtering from
+    // O(n * S^2) to O(n * (S + nnz)).  The dense fwd() and bkwd_sampling()
+    // methods are not affected.
+    //
+    // Args:
+    //   pattern:  The allowed transitions.  May be shared with other filters.
+    //     If nullptr the dense filter is restored.
+    //   beam_width: If positive, fwd_marginal() carries only this many of
+    //     the most probable states forward at each time point.  See
+    //     sparse_fwd_marginals() in hmm_tools.hpp.
+    void set_sparse_transitions(
+        const std::shared_ptr<const SparseTransitionPattern> &pattern,
+        int beam_width = 0);
+
    protected:
+    // Fill log_densities_ with the log density of each observation in dv
+    // (rows) under each state (columns).  Each column is filled by a single
+    // call to MixtureComponent::pdf_batch.  Missing data have density 1.
+    void compute_log_densities(const std::vector<Ptr<Data>> &dv);
+
+    // The model receiving data allocated to state h.
+    MixtureComponent *allocation_target(uint h) {
+      return target_models_.empty() ? models_[h].get() : target_models_[h].get();
+    }
+
+    // The sufficient statistics receiving imputed transitions.
+    MarkovSuf *transition_suf() {
+      return target_suf_ ? target_suf_.get() : markov_->suf().get();
+    }
+
+    // The storage slot for the data series dv, or -1 if dv has not been seen.
+    int find_series_slot(const std::vector<Ptr<Data>> &dv) const;
+
+    // Called by the backward samplers before drawing the states of dv.  Sets
+    // current_slot_ and sizes the per-series storage.  Child classes that
+    // store additional per-series information should call the parent
+    // version.
+    virtual void begin_series(const std::vector<Ptr<Data>> &dv);
+
+    // Called by the backward samplers each time the hidden state at time t
+    // of the current series is drawn to be h.  The distribution from which h
+    // was drawn is stored in pi.
+    virtual void record_imputed_state(int t, uint h);
+
     std::vector<Ptr<MixtureComponent>> models_;
     std::vector<Matrix> P;
     Vector pi, logp, logpi, one;
     Matrix logQ;
+    Matrix log_densities_;
+
+    // Filtered state distributions computed by fwd_marginal.  Column t is
+    // p(h[t] | y[0..t]).
+    Matrix filtered_;
     Ptr<MarkovModel> markov_;
-    std::map<std::vector<Ptr<Data>>, std::vector<int>> imputed_state_map_;
+
+    // Set by set_sparse_transitions.  sparse_values_ holds the elements of
+    // Q at the allowed positions, refreshed by each call to fwd_marginal.
+    std::shared_ptr<const SparseTransitionPattern> sparse_pattern_;
+    Vector sparse_values_;
+    int beam_width_;
+
+    // The storage slot of the series being imputed.
+    int current_slot_;
+
+   private:
+    std::map<const std::vector<Ptr<Data>> *, int> series_slots_;
+    std::vector<std::vector<int>> imputed_states_;
+
+    std::vector<Ptr<MixtureComponent>> target_models_;
+    Ptr<MarkovSuf> target_suf_;
   };
   //----------------------------------------------------------------------
   class HmmSavePiFilter : public HmmFilter {
    public:
     HmmSavePiFilter(const std::vector<Ptr<MixtureComponent>> &mix,
-                    const Ptr<MarkovModel> &mark,
-                    std::map<Ptr<Data>, Vector> &pi_hist);
-    void allocate(const Ptr<Data> &dp, uint h) override;
-    Vector state_probs(const Ptr<Data> &) const override;
+                    const Ptr<MarkovModel> &mark);
+    Matrix state_probs(const std::vector<Ptr<Data>> &) const override;
+
+    // The running sum of the distributions from which the hidden states of
+    // dv were drawn.  Row t corresponds to time t.  Rows are not normalized.
+    const Matrix &state_prob_sums(const std::vector<Ptr<Data>> &dv) const;
+
+    // Reset the saved state probabilities to zero, keeping the storage.
+    void clear_state_probs();
+    void clear_series_storage() override;
+
+   protected:
+    void begin_series(const std::vector<Ptr<Data>> &dv) override;
+    void record_imputed_state(int t, uint h) override;
 
    private:
-    std::map<Ptr<Data>, Vector> &pi_hist_;
+    // One n x S matrix per data series, indexed by storage slot.
+    std::vector<Matrix> state_prob_sums_;
   };
 
   //----------------------------------------------------------------------
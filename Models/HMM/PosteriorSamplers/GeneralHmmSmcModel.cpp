@@ -0,0 +1,54 @@
+// Copyright 2018 Google LLC. All Rights Reserved.
+/*
+  Copyright (C) 2005-2018 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#include "Models/HMM/PosteriorSamplers/GeneralHmmSmcModel.hpp"
+#include "cpputil/report_error.hpp"
+
+namespace BOOM {
+
+  GeneralHmmSmcModel::GeneralHmmSmcModel(
+      const Ptr<GeneralContinuousStateHmm> &hmm, const Vector &parameters)
+      : hmm_(hmm), parameters_(parameters) {
+    if (!hmm_) {
+      report_error("GeneralHmmSmcModel needs a non-null model.");
+    }
+  }
+
+  void GeneralHmmSmcModel::simulate_transition(
+      RNG &rng, const ConstVectorView &previous_state, VectorView next_state,
+      int t) const {
+    next_state = hmm_->simulate_transition(rng, Vector(previous_state), t - 1,
+                                           parameters_);
+  }
+
+  double GeneralHmmSmcModel::log_observation_density(
+      const ConstVectorView &state, int t) const {
+    if (t < 0 || t >= observations_.size()) {
+      report_error("Add the observation for each time point before "
+                   "filtering it.");
+    }
+    const Data &observation(*observations_[t]);
+    if (observation.missing() == Data::completely_missing) {
+      return 0.0;
+    }
+    return hmm_->log_observation_density(observation, Vector(state), t,
+                                         parameters_);
+  }
+
+}  // namespace BOOM
@@ -0,0 +1,69 @@
+// Copyright 2018 Google LLC. All Rights Reserved.
+/*
+  Copyright (C) 2005-2018 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#ifndef BOOM_HMM_GENERAL_HMM_SMC_MODEL_HPP_
+#define BOOM_HMM_GENERAL_HMM_SMC_MODEL_HPP_
+
+#include <vector>
+#include "Models/HMM/GeneralHmm.hpp"
+#include "Samplers/SequentialMonteCarlo.hpp"
+
+namespace BOOM {
+
+  // Exposes a GeneralContinuousStateHmm with fixed parameters to a
+  // SequentialMonteCarloFilter.  Unlike LiuWestParticleFilter, the
+  // parameters are not learned by the filter, which is appropriate when they
+  // have been estimated offline and the state distribution is to be updated
+  // as data arrive.
+  //
+  // The model has no initial state distribution, so the filter must be
+  // started with SequentialMonteCarloFilter::set_particles().
+  class GeneralHmmSmcModel : public SmcModel {
+   public:
+    // Args:
+    //   hmm:  The model supplying the transition and observation densities.
+    //   parameters:  A vectorized set of model parameters, suitable for
+    //     passing to hmm->unvectorize_params().
+    GeneralHmmSmcModel(const Ptr<GeneralContinuousStateHmm> &hmm,
+                       const Vector &parameters);
+
+    // Append an observation.  Observations are numbered from 0 in the order
+    // they are added.
+    void add_observation(const Ptr<Data> &observation) {
+      observations_.push_back(observation);
+    }
+    int number_of_observations() const { return observations_.size(); }
+
+    int state_dimension() const override { return hmm_->state_dimension(); }
+    void simulate_transition(RNG &rng, const ConstVectorView &previous_state,
+                             VectorView next_state, int t) const override;
+
+    // Observations with missing() == Data::completely_missing contribute 0.
+    double log_observation_density(const ConstVectorView &state,
+                                   int t) const override;
+
+   private:
+    Ptr<GeneralContinuousStateHmm> hmm_;
+    Vector parameters_;
+    std::vector<Ptr<Data>> observations_;
+  };
+
+}  // namespace BOOM
+
+#endif  // BOOM_HMM_GENERAL_HMM_SMC_MODEL_HPP_
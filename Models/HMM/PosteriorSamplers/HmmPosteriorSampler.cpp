@@ -20,6 +20,7 @@
 #include "Models/HMM/PosteriorSamplers/HmmPosteriorSampler.hpp"
 #include <future>
 #include "Models/HMM/HmmFilter.hpp"
+#include "Samplers/McmcProfiler.hpp"
 
 namespace BOOM {
 
@@ -37,8 +38,11 @@ namespace BOOM {
       hmm_->impute_latent_data();
       first_time_ = false;
     }
-    hmm_->mark()->sample_posterior();
-    draw_mixture_components();
+    {
+      ScopedPhaseTimer timer(McmcProfiler::kParameterDraws);
+      hmm_->mark()->sample_posterior();
+      draw_mixture_components();
+    }
     // by drawing latent data at the end, the log likelihood stored
     // int the model matches the current set of parameters.
     hmm_->impute_latent_data();
@@ -86,6 +90,7 @@ namespace BOOM {
       for (uint s = 0; s < S; ++s) {
         workers_.emplace_back(mix[s].get());
       }
+      thread_pool_.set_number_of_threads(S);
     }
   }
 
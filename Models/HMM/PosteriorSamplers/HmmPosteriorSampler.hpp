@@ -50,7 +50,7 @@ namespace BOOM {
     HiddenMarkovModel *hmm_;
     std::vector<MixtureComponentSampler> workers_;
     bool use_threads_;
-    ThreadWorkerPool thread_pool_;
+    SharedThreadPool thread_pool_;
     // 
     bool first_time_;
   };
@@ -18,6 +18,7 @@
 
 #include "Models/HMM/PosteriorSamplers/LiuWestParticleFilter.hpp"
 #include "distributions.hpp"
+#include "distributions/CategoricalSampler.hpp"
 #include "Models/MvnBase.hpp"
 #include "stats/Resampler.hpp"
 
@@ -140,8 +141,10 @@ namespace BOOM {
     // done with replacement.
     std::vector<Vector> new_state_particles(number_of_particles());
     Vector new_log_weights(number_of_particles());
+    // Every particle draws its parent from the same kernel weights.
+    CategoricalSampler kernel_sampler(kernel_weights, number_of_particles());
     for (int i = 0; i < number_of_particles(); ++i) {
-      int particle = rmulti_mt(rng, kernel_weights);
+      int particle = kernel_sampler.draw(rng);
       Vector parameter_proposal =
           rmvn_L_mt(rng, predicted_parameter_mean[particle], variance_cholesky);
       try {
@@ -21,10 +21,93 @@
 #include "LinAlg/Matrix.hpp"
 #include "LinAlg/Vector.hpp"
 #include "uint.hpp"
+#include "cpputil/report_error.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <sstream>
+#include <vector>
 
 namespace BOOM {
   using BOOM::uint;
 
+  namespace {
+    // The implementation of fwd_marginals.  If FIXED_S is positive it is the
+    // dimension of the state space, and dynamic_S is ignored.  Otherwise the
+    // dimension is dynamic_S.  Q, log_densities, and filtered are in
+    // column-major order, as in Matrix::data().
+    template <int FIXED_S>
+    double fwd_marginals_impl(int dynamic_S, const double *initial_distribution,
+                              const double *Q, const double *log_densities,
+                              int time_dimension, double *filtered) {
+      const int S = FIXED_S > 0 ? FIXED_S : dynamic_S;
+      double loglike = 0;
+      for (int t = 0; t < time_dimension; ++t) {
+        const double *logd = log_densities + t * S;
+        double *pi = filtered + t * S;
+        double max_logd = logd[0];
+        for (int s = 1; s < S; ++s) {
+          max_logd = std::max(max_logd, logd[s]);
+        }
+        if (!std::isfinite(max_logd)) {
+          report_error("Observation has zero or infinite density under every "
+                       "state in fwd_marginals.");
+        }
+        if (t == 0) {
+          for (int s = 0; s < S; ++s) {
+            pi[s] = initial_distribution[s] * std::exp(logd[s] - max_logd);
+          }
+        } else {
+          // pi[s] = sum_r previous[r] * Q(r, s).  Column s of Q is
+          // contiguous.
+          const double *previous = pi - S;
+          for (int s = 0; s < S; ++s) {
+            const double *Qs = Q + s * S;
+            double predicted = 0;
+            for (int r = 0; r < S; ++r) {
+              predicted += previous[r] * Qs[r];
+            }
+            pi[s] = predicted * std::exp(logd[s] - max_logd);
+          }
+        }
+        double total = 0;
+        for (int s = 0; s < S; ++s) {
+          total += pi[s];
+        }
+        if (!(total > 0)) {
+          std::ostringstream err;
+          err << "Zero normalizing constant in fwd_marginals at time " << t
+              << ".";
+          report_error(err.str());
+        }
+        double scale = 1.0 / total;
+        for (int s = 0; s < S; ++s) {
+          pi[s] *= scale;
+        }
+        loglike += max_logd + std::log(total);
+      }
+      return loglike;
+    }
+
+    using FwdMarginalsImpl = double (*)(int, const double *, const double *,
+                                        const double *, int, double *);
+
+    // fixed_fwd_marginals[S] handles state spaces of size S.
+    const FwdMarginalsImpl fixed_fwd_marginals[] = {
+      &fwd_marginals_impl<0>,
+      &fwd_marginals_impl<1>, &fwd_marginals_impl<2>,
+      &fwd_marginals_impl<3>, &fwd_marginals_impl<4>,
+      &fwd_marginals_impl<5>, &fwd_marginals_impl<6>,
+      &fwd_marginals_impl<7>, &fwd_marginals_impl<8>,
+      &fwd_marginals_impl<9>, &fwd_marginals_impl<10>,
+      &fwd_marginals_impl<11>, &fwd_marginals_impl<12>,
+      &fwd_marginals_impl<13>, &fwd_marginals_impl<14>,
+      &fwd_marginals_impl<15>, &fwd_marginals_impl<16>
+    };
+    const int max_fixed_state_dimension = 16;
+  }  // namespace
+
   double fwd_1(Vector &pi, Matrix &P, const Matrix &logQ, const Vector &logd,
                const Vector &one) {
     /*----------------------------------------------------------------------
@@ -69,4 +152,233 @@ namespace BOOM {
     pi = P * one;
   }
 
+  double fwd_marginals(const Vector &initial_distribution, const Matrix &Q,
+                       const Matrix &log_densities, Matrix &filtered) {
+    int S = initial_distribution.size();
+    int time_dimension = log_densities.ncol();
+    if (Q.nrow() != S || Q.ncol() != S || log_densities.nrow() != S) {
+      report_error("Dimensions do not match in fwd_marginals.");
+    }
+    filtered.resize(S, time_dimension);
+    FwdMarginalsImpl impl = S <= max_fixed_state_dimension
+        ? fixed_fwd_marginals[S]
+        : &fwd_marginals_impl<0>;
+    return impl(S, initial_distribution.data(), Q.data(),
+                log_densities.data(), time_dimension, filtered.data());
+  }
+
+  void smooth_marginals(const Matrix &Q, Matrix &filtered) {
+    const int S = filtered.nrow();
+    const int time_dimension = filtered.ncol();
+    if (Q.nrow() != S || Q.ncol() != S) {
+      report_error("Dimensions do not match in smooth_marginals.");
+    }
+    std::vector<double> ratio(S);
+    for (int t = time_dimension - 2; t >= 0; --t) {
+      double *current = filtered.data() + t * S;
+      const double *next = current + S;
+      // ratio[s] = p(h[t+1] = s | y[0..n-1]) / p(h[t+1] = s | y[0..t]).
+      for (int s = 0; s < S; ++s) {
+        const double *Qs = Q.data() + s * S;
+        double predicted = 0;
+        for (int r = 0; r < S; ++r) {
+          predicted += current[r] * Qs[r];
+        }
+        ratio[s] = predicted > 0 ? next[s] / predicted : 0.0;
+      }
+      double total = 0;
+      for (int r = 0; r < S; ++r) {
+        double backward = 0;
+        for (int s = 0; s < S; ++s) {
+          backward += Q(r, s) * ratio[s];
+        }
+        current[r] *= backward;
+        total += current[r];
+      }
+      if (total > 0) {
+        for (int r = 0; r < S; ++r) current[r] /= total;
+      }
+    }
+  }
+
+  double viterbi_path(const Vector &initial_distribution, const Matrix &Q,
+                      const Matrix &log_densities, int *path) {
+    const int S = initial_distribution.size();
+    const int time_dimension = log_densities.ncol();
+    if (Q.nrow() != S || Q.ncol() != S || log_densities.nrow() != S) {
+      report_error("Dimensions do not match in viterbi_path.");
+    }
+    if (time_dimension == 0) return 0;
+    const Matrix logQ = log(Q);
+    // backpointer[t * S + s] is the best predecessor of state s at time t.
+    std::vector<int> backpointer(static_cast<std::size_t>(time_dimension) * S);
+    std::vector<double> score(S);
+    std::vector<double> next_score(S);
+    for (int s = 0; s < S; ++s) {
+      score[s] = std::log(initial_distribution[s]) + log_densities(s, 0);
+    }
+    for (int t = 1; t < time_dimension; ++t) {
+      const double *logd = log_densities.data() + t * S;
+      int *best = backpointer.data() + static_cast<std::size_t>(t) * S;
+      for (int s = 0; s < S; ++s) {
+        const double *logQs = logQ.data() + s * S;
+        int argmax = 0;
+        double max_score = score[0] + logQs[0];
+        for (int r = 1; r < S; ++r) {
+          double candidate = score[r] + logQs[r];
+          if (candidate > max_score) {
+            max_score = candidate;
+            argmax = r;
+          }
+        }
+        next_score[s] = max_score + logd[s];
+        best[s] = argmax;
+      }
+      score.swap(next_score);
+    }
+    int state = std::max_element(score.begin(), score.end()) - score.begin();
+    const double ans = score[state];
+    if (!(ans > -std::numeric_limits<double>::infinity())) {
+      std::fill(path, path + time_dimension, 0);
+      return ans;
+    }
+    path[time_dimension - 1] = state;
+    for (int t = time_dimension - 1; t > 0; --t) {
+      state = backpointer[static_cast<std::size_t>(t) * S + state];
+      path[t - 1] = state;
+    }
+    return ans;
+  }
+
+  //===========================================================================
+  SparseTransitionPattern::SparseTransitionPattern(const Matrix &allowed) {
+    int S = allowed.nrow();
+    if (allowed.ncol() != S) {
+      report_error("The matrix of allowed transitions must be square.");
+    }
+    row_start_.reserve(S + 1);
+    row_start_.push_back(0);
+    std::vector<int> column_count(S, 0);
+    for (int r = 0; r < S; ++r) {
+      for (int s = 0; s < S; ++s) {
+        if (allowed(r, s) != 0) {
+          column_.push_back(s);
+          ++column_count[s];
+        }
+      }
+      if (column_.size() == row_start_.back()) {
+        std::ostringstream err;
+        err << "State " << r << " has no allowed transitions.";
+        report_error(err.str());
+      }
+      row_start_.push_back(column_.size());
+    }
+
+    column_start_.assign(S + 1, 0);
+    for (int s = 0; s < S; ++s) {
+      column_start_[s + 1] = column_start_[s] + column_count[s];
+    }
+    row_.resize(column_.size());
+    csr_position_.resize(column_.size());
+    std::vector<int> next(column_start_.begin(), column_start_.end() - 1);
+    for (int r = 0; r < S; ++r) {
+      for (int k = row_start_[r]; k < row_start_[r + 1]; ++k) {
+        int position = next[column_[k]]++;
+        row_[position] = r;
+        csr_position_[position] = k;
+      }
+    }
+  }
+
+  void SparseTransitionPattern::gather(const Matrix &Q, Vector &values) const {
+    int S = state_space_size();
+    if (Q.nrow() != S || Q.ncol() != S) {
+      report_error("Q does not match the sparse transition pattern.");
+    }
+    values.resize(column_.size());
+    for (int r = 0; r < S; ++r) {
+      for (int k = row_start_[r]; k < row_start_[r + 1]; ++k) {
+        values[k] = Q(r, column_[k]);
+      }
+    }
+  }
+
+  double sparse_fwd_marginals(const Vector &initial_distribution,
+                              const SparseTransitionPattern &pattern,
+                              const Vector &transition_values,
+                              const Matrix &log_densities, Matrix &filtered,
+                              int beam_width) {
+    const int S = initial_distribution.size();
+    const int time_dimension = log_densities.ncol();
+    if (pattern.state_space_size() != S || log_densities.nrow() != S ||
+        transition_values.size() != pattern.number_of_nonzeros()) {
+      report_error("Dimensions do not match in sparse_fwd_marginals.");
+    }
+    filtered.resize(S, time_dimension);
+    const int *row_start = pattern.row_start().data();
+    const int *column = pattern.column().data();
+    const double *values = transition_values.data();
+
+    // The states with positive probability in the previous time period.
+    // Only these rows of the transition matrix are visited.
+    std::vector<int> active;
+    active.reserve(S);
+    double loglike = 0;
+    for (int t = 0; t < time_dimension; ++t) {
+      const double *logd = log_densities.data() + t * S;
+      double *current = filtered.data() + t * S;
+      if (t == 0) {
+        for (int s = 0; s < S; ++s) current[s] = initial_distribution[s];
+      } else {
+        const double *previous = current - S;
+        std::fill(current, current + S, 0.0);
+        for (int r : active) {
+          const double weight = previous[r];
+          for (int k = row_start[r]; k < row_start[r + 1]; ++k) {
+            current[column[k]] += weight * values[k];
+          }
+        }
+      }
+
+      double max_logd = -std::numeric_limits<double>::infinity();
+      for (int s = 0; s < S; ++s) {
+        if (current[s] > 0 && logd[s] > max_logd) max_logd = logd[s];
+      }
+      if (!std::isfinite(max_logd)) {
+        return -std::numeric_limits<double>::infinity();
+      }
+      double total = 0;
+      for (int s = 0; s < S; ++s) {
+        if (current[s] > 0) {
+          current[s] *= std::exp(logd[s] - max_logd);
+          total += current[s];
+        }
+      }
+      if (!(total > 0)) {
+        return -std::numeric_limits<double>::infinity();
+      }
+      loglike += max_logd + std::log(total);
+
+      active.clear();
+      for (int s = 0; s < S; ++s) {
+        if (current[s] > 0) active.push_back(s);
+      }
+      if (beam_width > 0 && active.size() > beam_width) {
+        std::nth_element(active.begin(), active.begin() + beam_width,
+                         active.end(), [current](int a, int b) {
+                           return current[a] > current[b];
+                         });
+        for (int i = beam_width; i < active.size(); ++i) {
+          current[active[i]] = 0;
+        }
+        active.resize(beam_width);
+        total = 0;
+        for (int s : active) total += current[s];
+      }
+      const double scale = 1.0 / total;
+      for (int s = 0; s < S; ++s) current[s] *= scale;
+    }
+    return loglike;
+  }
+
 }  // namespace BOOM
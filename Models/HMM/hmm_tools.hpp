@@ -19,6 +19,7 @@
 #ifndef BOOM_HMM_TOOLS_HPP
 #define BOOM_HMM_TOOLS_HPP
 
+#include <vector>
 #include "LinAlg/Matrix.hpp"
 #include "LinAlg/Vector.hpp"
 
@@ -28,5 +29,122 @@ namespace BOOM {
                const Vector &one);
   void bkwd_1(Vector &pi, Matrix &P, Vector &wsp, const Vector &one);
 
+  // A forward filter for a hidden Markov model that stores only the filtered
+  // marginal distributions, rather than the S x S joint distributions
+  // produced by fwd_1.  The recursion is done on the probability scale: the
+  // predictive distribution is a matrix-vector product with Q, and each step
+  // is rescaled by the largest density to avoid underflow.  For S <= 16 the
+  // state dimension is a compile time constant, so the inner loops can be
+  // unrolled and vectorized.
+  //
+  // Args:
+  //   initial_distribution: The distribution of h[0].
+  //   Q: The S x S transition probability matrix.  Rows sum to 1.
+  //   log_densities: The S x n matrix with element (s, t) equal to
+  //     log p(y[t] | h[t] = s).  Storing time in columns keeps the values for
+  //     each time point contiguous.
+  //   filtered: On output, the S x n matrix with column t equal to
+  //     p(h[t] | y[0], ..., y[t]).
+  //
+  // Returns:
+  //   The log likelihood log p(y[0], ..., y[n-1]).
+  double fwd_marginals(const Vector &initial_distribution, const Matrix &Q,
+                       const Matrix &log_densities, Matrix &filtered);
+
+  // Convert the output of fwd_marginals (or sparse_fwd_marginals) to the
+  // smoothed marginal distributions p(h[t] | y[0], ..., y[n-1]), in place.
+  // The backward recursion costs O(n * S^2) and needs no storage beyond the
+  // filtered distributions themselves.
+  //
+  // Args:
+  //   Q: The S x S transition probability matrix used by the filter.
+  //   filtered: On input, the S x n filtered distributions.  On output, the
+  //     smoothed distributions.
+  void smooth_marginals(const Matrix &Q, Matrix &filtered);
+
+  // The most likely sequence of hidden states given the data, computed by
+  // the Viterbi algorithm in log space.
+  //
+  // Args:
+  //   initial_distribution: The distribution of h[0].
+  //   Q: The S x S transition probability matrix.
+  //   log_densities: The S x n matrix of log p(y[t] | h[t] = s).
+  //   path: A caller-supplied buffer with room for n states.  On output
+  //     path[t] is the most likely value of h[t].
+  //
+  // Returns:
+  //   log p(path, y), or negative infinity if every path has probability
+  //   zero (in which case path is filled with zeros).
+  double viterbi_path(const Vector &initial_distribution, const Matrix &Q,
+                      const Matrix &log_densities, int *path);
+
+  //===========================================================================
+  // The pattern of allowed transitions in a sparse transition probability
+  // matrix.  The allowed transitions are stored in compressed sparse row
+  // (CSR) form, for the forward filter, and in compressed sparse column form,
+  // for backward sampling.  The pattern holds no probabilities.  Those are
+  // gathered from a dense Q by gather(), so a single pattern can be shared
+  // (read only) by several filters.
+  class SparseTransitionPattern {
+   public:
+    // Args:
+    //   allowed: An S x S matrix.  Transitions r -> s are allowed where
+    //     allowed(r, s) is nonzero.  A natural choice is the prior count
+    //     matrix Nu of a MarkovConjSampler, where zeros mark the transitions
+    //     that are not allowed.  Each row must allow at least one transition.
+    explicit SparseTransitionPattern(const Matrix &allowed);
+
+    int state_space_size() const { return row_start_.size() - 1; }
+    int number_of_nonzeros() const { return column_.size(); }
+
+    // Row r occupies positions [row_start()[r], row_start()[r + 1]) of
+    // column() and of the value vector filled by gather().
+    const std::vector<int> &row_start() const { return row_start_; }
+    const std::vector<int> &column() const { return column_; }
+
+    // Column s occupies positions [column_start()[s], column_start()[s+1])
+    // of row() and csr_position().  csr_position() gives the position of the
+    // element in CSR order.
+    const std::vector<int> &column_start() const { return column_start_; }
+    const std::vector<int> &row() const { return row_; }
+    const std::vector<int> &csr_position() const { return csr_position_; }
+
+    // Fill values with the elements of Q at the allowed positions, in CSR
+    // order.  Elements of Q outside the pattern are ignored.
+    void gather(const Matrix &Q, Vector &values) const;
+
+   private:
+    std::vector<int> row_start_;
+    std::vector<int> column_;
+    std::vector<int> column_start_;
+    std::vector<int> row_;
+    std::vector<int> csr_position_;
+  };
+
+  // The analog of fwd_marginals for a sparse transition matrix.  Each step
+  // of the recursion costs O(S + nnz) instead of O(S^2).
+  //
+  // Args:
+  //   initial_distribution: The distribution of h[0].
+  //   pattern:  The allowed transitions.
+  //   transition_values: The transition probabilities at the allowed
+  //     positions, in the CSR order produced by pattern.gather().
+  //   log_densities: The S x n matrix of log p(y[t] | h[t] = s).
+  //   filtered: On output, column t is p(h[t] | y[0], ..., y[t]).
+  //   beam_width: If positive, at each time point only the beam_width most
+  //     probable states are carried forward.  The rest of the filtered
+  //     distribution is set to zero, and the remainder renormalized.  This
+  //     is an approximation, intended for online decoding with large state
+  //     spaces.  The returned log likelihood is then approximate as well.
+  //
+  // Returns:
+  //   The log likelihood log p(y[0], ..., y[n-1]), or negative infinity if
+  //   the data are impossible under the model.
+  double sparse_fwd_marginals(const Vector &initial_distribution,
+                              const SparseTransitionPattern &pattern,
+                              const Vector &transition_values,
+                              const Matrix &log_densities, Matrix &filtered,
+                              int beam_width = 0);
+
 }  // namespace BOOM
 #endif  // BOOM_HMM_TOOLS_HPP
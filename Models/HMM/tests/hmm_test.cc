@@ -1,5 +1,7 @@
 #include "gtest/gtest.h"
 #include "Models/HMM/HMM2.hpp"
+#include "Models/HMM/HmmFilter.hpp"
+#include "Models/HMM/hmm_tools.hpp"
 #include "Models/PoissonModel.hpp"
 #include "Models/MarkovModel.hpp"
 #include "Models/ProductDirichletModel.hpp"
@@ -8,6 +10,7 @@
 #include "Models/PosteriorSamplers/MarkovConjSampler.hpp"
 #include "Models/HMM/PosteriorSamplers/HmmPosteriorSampler.hpp"
 
+#include "distributions.hpp"
 #include "test_utils/test_utils.hpp"
 #include <fstream>
 
@@ -52,6 +55,292 @@ namespace {
   TEST_F(HmmTest, Basics) {
   }
 
+  // The marginal forward filter should give the same log likelihood as the
+  // filter storing joint distributions, both for small state spaces (which
+  // use the fixed dimension code) and large ones.
+  TEST_F(HmmTest, MarginalFilterMatchesJointFilter) {
+    std::vector<Ptr<Data>> data;
+    for (int i = 0; i < lamb_data.size(); ++i) {
+      data.push_back(new IntData(lamb_data[i]));
+    }
+
+    for (int S : {1, 3, 20}) {
+      std::vector<Ptr<MixtureComponent>> mixture_components;
+      for (int s = 0; s < S; ++s) {
+        mixture_components.push_back(new PoissonModel(.1 + s * .4));
+      }
+      Matrix Q(S, S);
+      for (int r = 0; r < S; ++r) {
+        Vector row(S);
+        row.randomize();
+        row[r] += S;
+        row.normalize_prob();
+        Q.row(r) = row;
+      }
+      NEW(MarkovModel, mark)(Q);
+
+      NEW(HmmFilter, filter)(mixture_components, mark);
+      double joint_loglike = filter->fwd(data);
+      EXPECT_NEAR(joint_loglike, filter->fwd_marginal(data), 1e-7)
+          << "S = " << S;
+      EXPECT_NEAR(joint_loglike, filter->loglike(data), 1e-7);
+
+      filter->bkwd_sampling_marginal(data);
+      std::vector<int> states = filter->imputed_state(data);
+      EXPECT_EQ(data.size(), states.size());
+      double total = 0;
+      for (int s = 0; s < S; ++s) {
+        total += mixture_components[s]->number_of_observations();
+      }
+      EXPECT_DOUBLE_EQ(data.size(), total);
+    }
+  }
+
+  // With a banded transition matrix the sparse filter should reproduce the
+  // dense one, and backward sampling should only produce allowed
+  // transitions.  A beam as wide as the state space changes nothing.
+  TEST_F(HmmTest, SparseFilterMatchesDenseFilter) {
+    std::vector<Ptr<Data>> data;
+    for (int i = 0; i < lamb_data.size(); ++i) {
+      data.push_back(new IntData(lamb_data[i]));
+    }
+
+    int S = 25;
+    std::vector<Ptr<MixtureComponent>> mixture_components;
+    for (int s = 0; s < S; ++s) {
+      mixture_components.push_back(new PoissonModel(.1 + s * .3));
+    }
+    Matrix allowed(S, S, 0.0);
+    Matrix Q(S, S, 0.0);
+    for (int r = 0; r < S; ++r) {
+      for (int s = std::max(0, r - 2); s <= std::min(S - 1, r + 2); ++s) {
+        allowed(r, s) = 1.0;
+        Q(r, s) = runif(.1, 1);
+      }
+      Q.row(r).normalize_prob();
+    }
+    NEW(MarkovModel, mark)(Q);
+
+    NEW(HmmFilter, dense_filter)(mixture_components, mark);
+    double dense_loglike = dense_filter->fwd_marginal(data);
+
+    std::shared_ptr<const SparseTransitionPattern> pattern(
+        new SparseTransitionPattern(allowed));
+    EXPECT_EQ(S * 5 - 6, pattern->number_of_nonzeros());
+    NEW(HmmFilter, sparse_filter)(mixture_components, mark);
+    sparse_filter->set_sparse_transitions(pattern);
+    EXPECT_NEAR(dense_loglike, sparse_filter->fwd_marginal(data), 1e-8);
+
+    sparse_filter->bkwd_sampling_marginal(data);
+    std::vector<int> states = sparse_filter->imputed_state(data);
+    ASSERT_EQ(data.size(), states.size());
+    for (int t = 1; t < states.size(); ++t) {
+      EXPECT_GT(allowed(states[t - 1], states[t]), 0.0);
+    }
+
+    sparse_filter->set_sparse_transitions(pattern, S);
+    EXPECT_NEAR(dense_loglike, sparse_filter->fwd_marginal(data), 1e-8);
+
+    // A narrow beam is only an approximation, but it should stay finite.
+    sparse_filter->set_sparse_transitions(pattern, 3);
+    EXPECT_TRUE(std::isfinite(sparse_filter->fwd_marginal(data)));
+  }
+
+  // A MarkovConjSampler with zeros in its prior counts should keep the
+  // corresponding transition probabilities at zero.
+  TEST_F(HmmTest, SparseMarkovPrior) {
+    Matrix Nu(3, 3, 1.0);
+    Nu(0, 2) = 0.0;
+    Nu(2, 0) = 0.0;
+    NEW(MarkovModel, mark)(3);
+    mark->suf()->add_transition(0, 1);
+    mark->suf()->add_transition(1, 2);
+    mark->suf()->add_transition(2, 2);
+    NEW(MarkovConjSampler, sampler)(mark.get(), Nu);
+    mark->set_method(sampler);
+    for (int i = 0; i < 20; ++i) {
+      mark->sample_posterior();
+      EXPECT_DOUBLE_EQ(0.0, mark->Q()(0, 2));
+      EXPECT_DOUBLE_EQ(0.0, mark->Q()(2, 0));
+      EXPECT_NEAR(1.0, sum(mark->Q().row(0)), 1e-10);
+      EXPECT_TRUE(std::isfinite(sampler->logpri()));
+    }
+  }
+
+  // Workers imputing with the model's own parameters should allocate every
+  // observation, and every transition, exactly once.
+  TEST_F(HmmTest, ThreadedImputation) {
+    int S = 3;
+    std::vector<Ptr<PoissonModel>> mixture_components;
+    std::vector<Ptr<MixtureComponent>> components;
+    for (int s = 0; s < S; ++s) {
+      mixture_components.push_back(new PoissonModel(.1 + s));
+      components.push_back(mixture_components.back());
+    }
+    NEW(MarkovModel, mark)(S);
+    NEW(HiddenMarkovModel, model)(components, mark);
+
+    int nseries = 5;
+    int series_length = 48;
+    for (int i = 0; i < nseries; ++i) {
+      NEW(TimeSeries<Data>, series)();
+      for (int t = 0; t < series_length; ++t) {
+        series->add_data_point(
+            new IntData(lamb_data[i * series_length + t]));
+      }
+      model->add_data_series(series);
+    }
+
+    model->set_nthreads(2);
+    double loglike = model->impute_latent_data();
+    EXPECT_TRUE(std::isfinite(loglike));
+
+    double total = 0;
+    for (int s = 0; s < S; ++s) {
+      total += mixture_components[s]->suf()->n();
+    }
+    EXPECT_DOUBLE_EQ(nseries * series_length, total);
+    EXPECT_DOUBLE_EQ(nseries * (series_length - 1), sum(mark->suf()->trans()));
+    EXPECT_DOUBLE_EQ(nseries, sum(mark->suf()->init()));
+
+    // Imputing a second time starts from empty sufficient statistics.
+    model->impute_latent_data();
+    EXPECT_DOUBLE_EQ(nseries, sum(mark->suf()->init()));
+
+    // The threaded and single threaded log likelihoods agree.
+    model->set_nthreads(0);
+    EXPECT_NEAR(loglike, model->impute_latent_data(), 1e-8);
+  }
+
+  // The streaming decoders should visit every series once.  The Viterbi path
+  // should beat every other path (checked by brute force on short series),
+  // the filtered marginals should end where the marginal filter does, and
+  // the smoothed marginals should sum to one.
+  TEST_F(HmmTest, StreamingDecoders) {
+    int S = 2;
+    std::vector<Ptr<MixtureComponent>> components;
+    for (int s = 0; s < S; ++s) {
+      components.push_back(new PoissonModel(.2 + 2 * s));
+    }
+    Matrix Q(S, S);
+    Q(0, 0) = .9;
+    Q(0, 1) = .1;
+    Q(1, 0) = .3;
+    Q(1, 1) = .7;
+    NEW(MarkovModel, mark)(Q);
+    NEW(HiddenMarkovModel, model)(components, mark);
+
+    int nseries = 6;
+    int series_length = 8;
+    for (int i = 0; i < nseries; ++i) {
+      NEW(TimeSeries<Data>, series)();
+      for (int t = 0; t < series_length; ++t) {
+        series->add_data_point(
+            new IntData(lamb_data[80 + i * series_length + t]));
+      }
+      model->add_data_series(series);
+    }
+    model->set_nthreads(2);
+
+    std::vector<int> visits(nseries, 0);
+    model->decode_viterbi([&](int series, const std::vector<int> &path,
+                              double log_probability) {
+      ++visits[series];
+      ASSERT_EQ(series_length, path.size());
+      const TimeSeries<Data> &data(model->dat(series));
+      auto log_joint = [&](const std::vector<int> &states) {
+        double ans = log(model->pi0()[states[0]]) +
+            components[states[0]]->pdf(data[0].get(), true);
+        for (int t = 1; t < states.size(); ++t) {
+          ans += log(Q(states[t - 1], states[t])) +
+              components[states[t]]->pdf(data[t].get(), true);
+        }
+        return ans;
+      };
+      EXPECT_NEAR(log_probability, log_joint(path), 1e-8);
+      std::vector<int> states(series_length);
+      for (int code = 0; code < (1 << series_length); ++code) {
+        for (int t = 0; t < series_length; ++t) {
+          states[t] = (code >> t) & 1;
+        }
+        EXPECT_LE(log_joint(states), log_probability + 1e-8);
+      }
+    });
+    for (int i = 0; i < nseries; ++i) {
+      EXPECT_EQ(1, visits[i]);
+    }
+
+    std::vector<Matrix> streamed(nseries);
+    model->decode_marginals([&](int series, const Matrix &probs) {
+      streamed[series] = probs;
+    });
+    for (int i = 0; i < nseries; ++i) {
+      Matrix probs;
+      model->state_marginals(i, probs, false);
+      EXPECT_EQ(S, probs.nrow());
+      EXPECT_EQ(series_length, probs.ncol());
+      EXPECT_TRUE(MatrixEquals(probs, streamed[i]));
+    }
+
+    Matrix filtered;
+    model->state_marginals(3, filtered, false);
+    Matrix smoothed;
+    model->state_marginals(3, smoothed, true);
+    EXPECT_TRUE(VectorEquals(filtered.col(series_length - 1),
+                             smoothed.col(series_length - 1)));
+    for (int t = 0; t < series_length; ++t) {
+      EXPECT_NEAR(1.0, sum(smoothed.col(t)), 1e-10);
+      EXPECT_NEAR(1.0, sum(filtered.col(t)), 1e-10);
+    }
+
+    std::vector<int> path(series_length);
+    double log_probability = model->viterbi_path(3, path.data());
+    EXPECT_TRUE(std::isfinite(log_probability));
+  }
+
+  // The saved state probabilities are stored one row per time point, and
+  // accumulate across imputations until they are cleared.
+  TEST_F(HmmTest, SavedStateProbabilities) {
+    std::vector<Ptr<Data>> data;
+    for (int i = 0; i < lamb_data.size(); ++i) {
+      data.push_back(new IntData(lamb_data[i]));
+    }
+    int S = 3;
+    std::vector<Ptr<MixtureComponent>> mixture_components;
+    for (int s = 0; s < S; ++s) {
+      mixture_components.push_back(new PoissonModel(.1 + s));
+    }
+    NEW(MarkovModel, mark)(S);
+    NEW(HmmSavePiFilter, filter)(mixture_components, mark);
+
+    int niter = 3;
+    for (int i = 0; i < niter; ++i) {
+      filter->fwd_marginal(data);
+      filter->bkwd_sampling_marginal(data);
+    }
+    const Matrix &sums(filter->state_prob_sums(data));
+    EXPECT_EQ(data.size(), sums.nrow());
+    EXPECT_EQ(S, sums.ncol());
+    EXPECT_NEAR(niter * data.size(), sum(sums), 1e-8);
+
+    Matrix probs = filter->state_probs(data);
+    for (int t = 0; t < probs.nrow(); ++t) {
+      EXPECT_NEAR(1.0, probs.row(t).sum(), 1e-8);
+    }
+
+    std::vector<int> states = filter->imputed_state(data);
+    ASSERT_EQ(data.size(), states.size());
+    for (int t = 0; t < states.size(); ++t) {
+      EXPECT_GT(sums(t, states[t]), 0.0);
+    }
+
+    filter->clear_state_probs();
+    EXPECT_DOUBLE_EQ(0.0, sum(filter->state_prob_sums(data)));
+
+    std::vector<Ptr<Data>> other_data(data.begin(), data.begin() + 10);
+    EXPECT_TRUE(filter->imputed_state(other_data).empty());
+  }
+
   TEST_F(HmmTest, Poisson) {
     std::vector<Ptr<PoissonModel>> mixture_components;
     mixture_components.push_back(new PoissonModel(1.0));
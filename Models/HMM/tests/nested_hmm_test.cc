@@ -0,0 +1,71 @@
+#include "gtest/gtest.h"
+#include "Models/CategoricalData.hpp"
+#include "Models/HMM/Clickstream/NestedHmm.hpp"
+#include "Models/HMM/Clickstream/StreamSource.hpp"
+#include "distributions.hpp"
+
+#include "test_utils/test_utils.hpp"
+
+namespace {
+  using namespace BOOM;
+  using std::endl;
+  using std::cout;
+
+  class NestedHmmTest : public ::testing::Test {
+   protected:
+    NestedHmmTest() {
+      GlobalRng::rng.seed(8675309);
+    }
+
+    // Simulate 'nstreams' streams of random page views, with levels 0..2
+    // plus an end of session marker.
+    std::vector<Ptr<Clickstream::Stream>> simulate_streams(int nstreams) {
+      NEW(CatKey, key)(std::vector<std::string>{"a", "b", "c", "eos"});
+      std::vector<Ptr<Clickstream::Stream>> streams;
+      for (int m = 0; m < nstreams; ++m) {
+        std::vector<Ptr<Clickstream::Session>> sessions;
+        int nsessions = 1 + random_int(0, 3);
+        for (int s = 0; s < nsessions; ++s) {
+          std::vector<Ptr<Clickstream::Event>> events;
+          int nevents = 1 + random_int(0, 5);
+          events.push_back(new Clickstream::Event(
+              random_int(0, 2), Ptr<CatKeyBase>(key)));
+          for (int i = 1; i < nevents; ++i) {
+            events.push_back(
+                new Clickstream::Event(random_int(0, 2), events.back()));
+          }
+          sessions.push_back(new Clickstream::Session(events, true));
+        }
+        streams.push_back(new Clickstream::Stream(sessions));
+      }
+      return streams;
+    }
+  };
+
+  // A streaming E-step should accumulate the same sufficient statistics and
+  // log likelihood as one holding all the data in memory, with or without
+  // threads.
+  TEST_F(NestedHmmTest, StreamingMatchesInMemory) {
+    std::vector<Ptr<Clickstream::Stream>> streams = simulate_streams(25);
+    NEW(NestedHmm, model)(streams, 2, 2);
+    model->randomize_starting_values();
+    double loglike = model->fwd_bkwd(false, false);
+    Vector suf = vectorize(model->suf_vec());
+
+    NEW(NestedHmm, streaming_model)(2, 2, model->S0());
+    streaming_model->unvectorize_params(model->vectorize_params());
+    Clickstream::VectorStreamSource source(streams, 7);
+    EXPECT_NEAR(loglike,
+                streaming_model->streaming_fwd_bkwd(source, false, false),
+                1e-8);
+    EXPECT_TRUE(VectorEquals(suf, vectorize(streaming_model->suf_vec())));
+
+    // A second pass starts from cleared sufficient statistics.
+    streaming_model->set_threads(3);
+    EXPECT_NEAR(loglike,
+                streaming_model->streaming_fwd_bkwd(source, false, false),
+                1e-8);
+    EXPECT_TRUE(VectorEquals(suf, vectorize(streaming_model->suf_vec())));
+  }
+
+}  // namespace
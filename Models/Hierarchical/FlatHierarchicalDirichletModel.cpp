@@ -0,0 +1,103 @@
+// Copyright 2018 Google LLC. All Rights Reserved.
+/*
+  Copyright (C) 2005-2018 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#include "Models/Hierarchical/FlatHierarchicalDirichletModel.hpp"
+#include "cpputil/report_error.hpp"
+
+namespace BOOM {
+
+  namespace {
+    typedef FlatHierarchicalDirichletModel FHDM;
+  }  // namespace
+
+  FHDM::FlatHierarchicalDirichletModel(const Ptr<DirichletModel> &prior)
+      : prior_(prior), number_of_groups_(0) {
+    initialize_param_policy();
+  }
+
+  FHDM::FlatHierarchicalDirichletModel(const FHDM &rhs)
+      : Model(rhs),
+        ParamPolicy(rhs),
+        PriorPolicy(rhs),
+        prior_(rhs.prior_->clone()),
+        number_of_groups_(rhs.number_of_groups_),
+        counts_(rhs.counts_),
+        probabilities_(rhs.probabilities_) {
+    initialize_param_policy();
+  }
+
+  FHDM *FHDM::clone() const { return new FHDM(*this); }
+
+  void FHDM::add_group(const ConstVectorView &counts) {
+    if (counts.size() != dim()) {
+      report_error(
+          "Wrong sized counts passed to "
+          "FlatHierarchicalDirichletModel::add_group.");
+    }
+    Vector prior_mean = prior_->pi();
+    for (int k = 0; k < dim(); ++k) {
+      if (counts[k] < 0) {
+        report_error("Counts must be non-negative.");
+      }
+      counts_.push_back(counts[k]);
+      probabilities_.push_back(prior_mean[k]);
+    }
+    ++number_of_groups_;
+  }
+
+  void FHDM::reserve(int number_of_groups) {
+    counts_.reserve(number_of_groups * dim());
+    probabilities_.reserve(number_of_groups * dim());
+  }
+
+  void FHDM::add_data(const Ptr<Data> &dp) {
+    Ptr<HierarchicalDirichletData> data_point =
+        dp.dcast<HierarchicalDirichletData>();
+    if (!data_point) {
+      report_error("Wrong data type in FlatHierarchicalDirichletModel.");
+    }
+    add_group(data_point->suf().n());
+  }
+
+  void FHDM::clear_data() {
+    number_of_groups_ = 0;
+    counts_.clear();
+    probabilities_.clear();
+    prior_->clear_data();
+  }
+
+  void FHDM::combine_data(const Model &other_model, bool) {
+    const FHDM *other = dynamic_cast<const FHDM *>(&other_model);
+    if (!other) {
+      report_error(
+          "Could not convert the argument of 'combine_data' to "
+          "FlatHierarchicalDirichletModel.");
+    }
+    reserve(number_of_groups() + other->number_of_groups());
+    for (int i = 0; i < other->number_of_groups(); ++i) {
+      add_group(other->counts(i));
+    }
+  }
+
+  void FHDM::initialize_param_policy() {
+    ParamPolicy::clear();
+    ParamPolicy::add_model(prior_);
+  }
+
+}  // namespace BOOM
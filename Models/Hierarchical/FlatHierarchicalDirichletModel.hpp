@@ -0,0 +1,88 @@
+// Copyright 2018 Google LLC. All Rights Reserved.
+/*
+  Copyright (C) 2005-2018 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#ifndef BOOM_FLAT_HIERARCHICAL_DIRICHLET_MODEL_HPP_
+#define BOOM_FLAT_HIERARCHICAL_DIRICHLET_MODEL_HPP_
+
+#include "LinAlg/Vector.hpp"
+#include "LinAlg/VectorView.hpp"
+#include "Models/DirichletModel.hpp"
+#include "Models/Hierarchical/HierarchicalDirichletModel.hpp"
+#include "Models/Policies/CompositeParamPolicy.hpp"
+#include "Models/Policies/PriorPolicy.hpp"
+
+namespace BOOM {
+
+  // The Dirichlet-multinomial hierarchy of HierarchicalDirichletModel for
+  // problems with very many small groups.  Instead of a MultinomialModel
+  // per group, the category counts and the multinomial probabilities for
+  // all groups are stored in two contiguous arrays, with the dim() values
+  // for each group adjacent to one another.
+  //
+  // The group level probability vectors are treated like latent variables:
+  // they are managed by the posterior sampler, but they are not part of the
+  // parameter_vector(), which holds only the parameters of the prior.
+  class FlatHierarchicalDirichletModel : public CompositeParamPolicy,
+                                         public PriorPolicy {
+   public:
+    explicit FlatHierarchicalDirichletModel(const Ptr<DirichletModel> &prior);
+    FlatHierarchicalDirichletModel(const FlatHierarchicalDirichletModel &rhs);
+    FlatHierarchicalDirichletModel *clone() const override;
+
+    // Add a group with the given category counts.  The group's
+    // probabilities are initialized to the prior mean.
+    void add_group(const ConstVectorView &counts);
+
+    // Reserve space for the given total number of groups.
+    void reserve(int number_of_groups);
+
+    // Adds a group.  The data must be of type HierarchicalDirichletData.
+    void add_data(const Ptr<Data> &dp) override;
+    void clear_data() override;
+    void combine_data(const Model &other_model, bool just_suf = true) override;
+
+    // The number of categories.
+    int dim() const { return prior_->dim(); }
+    int number_of_groups() const { return number_of_groups_; }
+
+    ConstVectorView counts(int group) const {
+      return ConstVectorView(counts_.data() + group * dim(), dim(), 1);
+    }
+    ConstVectorView probabilities(int group) const {
+      return ConstVectorView(probabilities_.data() + group * dim(), dim(), 1);
+    }
+    VectorView mutable_probabilities(int group) {
+      return VectorView(probabilities_.data() + group * dim(), dim(), 1);
+    }
+
+    DirichletModel *prior_model() { return prior_.get(); }
+    const DirichletModel *prior_model() const { return prior_.get(); }
+
+   private:
+    void initialize_param_policy();
+
+    Ptr<DirichletModel> prior_;
+    int number_of_groups_;
+    Vector counts_;
+    Vector probabilities_;
+  };
+
+}  // namespace BOOM
+
+#endif  // BOOM_FLAT_HIERARCHICAL_DIRICHLET_MODEL_HPP_
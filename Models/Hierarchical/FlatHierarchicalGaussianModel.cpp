@@ -0,0 +1,112 @@
+// Copyright 2018 Google LLC. All Rights Reserved.
+/*
+  Copyright (C) 2005-2018 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#include "Models/Hierarchical/FlatHierarchicalGaussianModel.hpp"
+#include "cpputil/report_error.hpp"
+
+namespace BOOM {
+
+  namespace {
+    typedef FlatHierarchicalGaussianModel FHGM;
+  }  // namespace
+
+  FHGM::FlatHierarchicalGaussianModel(const Ptr<GaussianModel> &prior,
+                                      const Ptr<UnivParams> &residual_variance)
+      : prior_(prior), residual_variance_(residual_variance) {
+    initialize_param_policy();
+  }
+
+  FHGM::FlatHierarchicalGaussianModel(const FHGM &rhs)
+      : Model(rhs),
+        ParamPolicy(rhs),
+        PriorPolicy(rhs),
+        prior_(rhs.prior_->clone()),
+        residual_variance_(rhs.residual_variance_->clone()),
+        sample_sizes_(rhs.sample_sizes_),
+        sums_(rhs.sums_),
+        sums_of_squares_(rhs.sums_of_squares_),
+        group_means_(rhs.group_means_) {
+    initialize_param_policy();
+  }
+
+  FHGM *FHGM::clone() const { return new FHGM(*this); }
+
+  void FHGM::add_group(double sample_size, double sum, double sumsq) {
+    if (sample_size < 0 || sumsq < 0) {
+      report_error(
+          "Sample sizes and sums of squares must be non-negative.");
+    }
+    sample_sizes_.push_back(sample_size);
+    sums_.push_back(sum);
+    sums_of_squares_.push_back(sumsq);
+    group_means_.push_back(sample_size > 0 ? sum / sample_size
+                                           : prior_->mu());
+  }
+
+  void FHGM::reserve(int number_of_groups) {
+    sample_sizes_.reserve(number_of_groups);
+    sums_.reserve(number_of_groups);
+    sums_of_squares_.reserve(number_of_groups);
+    group_means_.reserve(number_of_groups);
+  }
+
+  void FHGM::add_data(const Ptr<Data> &dp) {
+    Ptr<GaussianSuf> suf = dp.dcast<GaussianSuf>();
+    if (!suf) {
+      report_error("Wrong data type in FlatHierarchicalGaussianModel.");
+    }
+    add_group(*suf);
+  }
+
+  void FHGM::clear_data() {
+    sample_sizes_.clear();
+    sums_.clear();
+    sums_of_squares_.clear();
+    group_means_.clear();
+    prior_->clear_data();
+  }
+
+  void FHGM::combine_data(const Model &other_model, bool) {
+    const FHGM *other = dynamic_cast<const FHGM *>(&other_model);
+    if (!other) {
+      report_error(
+          "Could not convert the argument of 'combine_data' to "
+          "FlatHierarchicalGaussianModel.");
+    }
+    reserve(number_of_groups() + other->number_of_groups());
+    for (int i = 0; i < other->number_of_groups(); ++i) {
+      add_group(other->sample_sizes_[i], other->sums_[i],
+                other->sums_of_squares_[i]);
+    }
+  }
+
+  void FHGM::set_group_means(const Vector &means) {
+    if (means.size() != group_means_.size()) {
+      report_error("Wrong size argument passed to set_group_means.");
+    }
+    group_means_ = means;
+  }
+
+  void FHGM::initialize_param_policy() {
+    ParamPolicy::clear();
+    ParamPolicy::add_model(prior_);
+    ParamPolicy::add_params(residual_variance_);
+  }
+
+}  // namespace BOOM
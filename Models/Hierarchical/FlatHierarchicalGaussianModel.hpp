@@ -0,0 +1,105 @@
+// Copyright 2018 Google LLC. All Rights Reserved.
+/*
+  Copyright (C) 2005-2018 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#ifndef BOOM_FLAT_HIERARCHICAL_GAUSSIAN_MODEL_HPP_
+#define BOOM_FLAT_HIERARCHICAL_GAUSSIAN_MODEL_HPP_
+
+#include "LinAlg/Vector.hpp"
+#include "Models/GaussianModel.hpp"
+#include "Models/ParamTypes.hpp"
+#include "Models/Policies/CompositeParamPolicy.hpp"
+#include "Models/Policies/PriorPolicy.hpp"
+
+namespace BOOM {
+
+  // A model for groups of Gaussian data with group specific means and a
+  // common residual variance,
+  //
+  //      y[i, j] | mu[i] ~ N(mu[i], sigma^2)
+  //          mu[i]       ~ N(mu0, tau^2),
+  //
+  // for problems with very many small groups.  The sufficient statistics
+  // (sample size, sum and sum of squares) and the mean of each group are
+  // stored in contiguous vectors rather than in a GaussianModel per group.
+  //
+  // The group means are treated like latent variables: they are managed by
+  // the posterior sampler, but they are not part of the parameter_vector(),
+  // which holds the parameters of the prior and the residual variance.
+  class FlatHierarchicalGaussianModel : public CompositeParamPolicy,
+                                        public PriorPolicy {
+   public:
+    // Args:
+    //   prior: The distribution of the group means.  Its posterior sampler
+    //     should be set before sampling this model.
+    //   residual_variance:  The common variance of the observations about
+    //     their group means.
+    explicit FlatHierarchicalGaussianModel(
+        const Ptr<GaussianModel> &prior,
+        const Ptr<UnivParams> &residual_variance = new UnivParams(1.0));
+    FlatHierarchicalGaussianModel(const FlatHierarchicalGaussianModel &rhs);
+    FlatHierarchicalGaussianModel *clone() const override;
+
+    // Add a group with the given sufficient statistics.  The group mean is
+    // initialized to the sample mean, or the prior mean if sample_size is
+    // zero.
+    void add_group(double sample_size, double sum, double sumsq);
+    void add_group(const GaussianSuf &suf) {
+      add_group(suf.n(), suf.sum(), suf.sumsq());
+    }
+
+    // Reserve space for the given total number of groups.
+    void reserve(int number_of_groups);
+
+    // Adds a group.  The data must be of type GaussianSuf.
+    void add_data(const Ptr<Data> &dp) override;
+    void clear_data() override;
+    void combine_data(const Model &other_model, bool just_suf = true) override;
+
+    int number_of_groups() const { return sample_sizes_.size(); }
+    const Vector &sample_sizes() const { return sample_sizes_; }
+    const Vector &sums() const { return sums_; }
+    const Vector &sums_of_squares() const { return sums_of_squares_; }
+
+    const Vector &group_means() const { return group_means_; }
+    double group_mean(int group) const { return group_means_[group]; }
+    void set_group_means(const Vector &means);
+    void set_group_mean(int group, double mean) { group_means_[group] = mean; }
+
+    GaussianModel *prior() { return prior_.get(); }
+    const GaussianModel *prior() const { return prior_.get(); }
+
+    double residual_variance() const { return residual_variance_->value(); }
+    double residual_sd() const { return sqrt(residual_variance()); }
+    void set_residual_variance(double sigsq) { residual_variance_->set(sigsq); }
+
+   private:
+    void initialize_param_policy();
+
+    Ptr<GaussianModel> prior_;
+    Ptr<UnivParams> residual_variance_;
+
+    Vector sample_sizes_;
+    Vector sums_;
+    Vector sums_of_squares_;
+    Vector group_means_;
+  };
+
+}  // namespace BOOM
+
+#endif  //  BOOM_FLAT_HIERARCHICAL_GAUSSIAN_MODEL_HPP_
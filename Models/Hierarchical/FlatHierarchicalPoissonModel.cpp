@@ -0,0 +1,118 @@
+// Copyright 2018 Google LLC. All Rights Reserved.
+/*
+  Copyright (C) 2005-2018 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#include "Models/Hierarchical/FlatHierarchicalPoissonModel.hpp"
+#include "cpputil/report_error.hpp"
+
+namespace BOOM {
+
+  namespace {
+    typedef FlatHierarchicalPoissonModel FHPM;
+  }  // namespace
+
+  FHPM::FlatHierarchicalPoissonModel(double lambda_prior_guess,
+                                     double lambda_prior_sample_size)
+      : prior_(new GammaModel(lambda_prior_sample_size, lambda_prior_guess,
+                              0)) {
+    initialize_param_policy();
+  }
+
+  FHPM::FlatHierarchicalPoissonModel(const Ptr<GammaModel> &prior)
+      : prior_(prior) {
+    initialize_param_policy();
+  }
+
+  FHPM::FlatHierarchicalPoissonModel(const FHPM &rhs)
+      : Model(rhs),
+        ParamPolicy(rhs),
+        PriorPolicy(rhs),
+        prior_(rhs.prior_->clone()),
+        event_counts_(rhs.event_counts_),
+        exposures_(rhs.exposures_),
+        lambda_(rhs.lambda_) {
+    initialize_param_policy();
+  }
+
+  FHPM *FHPM::clone() const { return new FHPM(*this); }
+
+  void FHPM::add_group(double event_count, double exposure) {
+    if (event_count < 0 || exposure < 0) {
+      report_error("Event counts and exposures must be non-negative.");
+    }
+    double lambda_hat = 1.0;
+    if (exposure > 0) {
+      lambda_hat = event_count > 0 ? event_count / exposure : 1.0 / exposure;
+    }
+    event_counts_.push_back(event_count);
+    exposures_.push_back(exposure);
+    lambda_.push_back(lambda_hat);
+  }
+
+  void FHPM::reserve(int number_of_groups) {
+    event_counts_.reserve(number_of_groups);
+    exposures_.reserve(number_of_groups);
+    lambda_.reserve(number_of_groups);
+  }
+
+  void FHPM::add_data(const Ptr<Data> &dp) {
+    Ptr<HierarchicalPoissonData> data_point =
+        dp.dcast<HierarchicalPoissonData>();
+    if (!data_point) {
+      report_error("Wrong data type in FlatHierarchicalPoissonModel.");
+    }
+    add_group(data_point->event_count(), data_point->exposure());
+  }
+
+  void FHPM::clear_data() {
+    event_counts_.clear();
+    exposures_.clear();
+    lambda_.clear();
+    prior_->clear_data();
+  }
+
+  void FHPM::combine_data(const Model &other_model, bool) {
+    const FHPM *other = dynamic_cast<const FHPM *>(&other_model);
+    if (!other) {
+      report_error(
+          "Could not convert the argument of 'combine_data' to "
+          "FlatHierarchicalPoissonModel.");
+    }
+    reserve(number_of_groups() + other->number_of_groups());
+    for (int i = 0; i < other->number_of_groups(); ++i) {
+      add_group(other->event_counts_[i], other->exposures_[i]);
+    }
+  }
+
+  void FHPM::set_lambda(const Vector &lambda) {
+    if (lambda.size() != lambda_.size()) {
+      report_error("Wrong size argument passed to set_lambda.");
+    }
+    lambda_ = lambda;
+  }
+
+  double FHPM::prior_mean() const { return prior_->mean(); }
+
+  double FHPM::prior_sample_size() const { return prior_->alpha(); }
+
+  void FHPM::initialize_param_policy() {
+    ParamPolicy::clear();
+    ParamPolicy::add_model(prior_);
+  }
+
+}  // namespace BOOM
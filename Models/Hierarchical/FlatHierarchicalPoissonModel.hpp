@@ -0,0 +1,94 @@
+// Copyright 2018 Google LLC. All Rights Reserved.
+/*
+  Copyright (C) 2005-2018 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#ifndef BOOM_FLAT_HIERARCHICAL_POISSON_MODEL_HPP_
+#define BOOM_FLAT_HIERARCHICAL_POISSON_MODEL_HPP_
+
+#include "LinAlg/Vector.hpp"
+#include "Models/GammaModel.hpp"
+#include "Models/Hierarchical/HierarchicalPoissonModel.hpp"
+#include "Models/Policies/CompositeParamPolicy.hpp"
+#include "Models/Policies/PriorPolicy.hpp"
+
+namespace BOOM {
+
+  // The Poisson/gamma hierarchical model of HierarchicalPoissonModel,
+  //
+  //      y[i] | lambda[i] ~ Poisson(lambda[i] * exposure[i])
+  //   lambda[i] | (a, b)  ~ Gamma(a, b),
+  //
+  // for problems with very many small groups.  HierarchicalPoissonModel
+  // holds a PoissonModel for each group, with its own parameter, data
+  // policy, observers and sampler.  Here the event counts, exposures and
+  // Poisson rates for all groups are stored in contiguous vectors, so a
+  // group costs three doubles.
+  //
+  // The group level rates are treated like latent variables: they are
+  // managed by the posterior sampler, but they are not part of the
+  // parameter_vector(), which holds only the parameters of the prior.
+  class FlatHierarchicalPoissonModel : public CompositeParamPolicy,
+                                       public PriorPolicy {
+   public:
+    FlatHierarchicalPoissonModel(double lambda_prior_guess,
+                                 double lambda_prior_sample_size);
+    explicit FlatHierarchicalPoissonModel(const Ptr<GammaModel> &prior);
+    FlatHierarchicalPoissonModel(const FlatHierarchicalPoissonModel &rhs);
+    FlatHierarchicalPoissonModel *clone() const override;
+
+    // Add a group with the given data.  The rate for the new group is
+    // initialized to its observed rate (or 1/exposure if there were no
+    // events).
+    void add_group(double event_count, double exposure);
+
+    // Reserve space for the given total number of groups, to avoid
+    // reallocation when groups are added one at a time.
+    void reserve(int number_of_groups);
+
+    // Adds a group.  The data must be of type HierarchicalPoissonData.
+    void add_data(const Ptr<Data> &dp) override;
+    void clear_data() override;
+    void combine_data(const Model &other_model, bool just_suf = true) override;
+
+    int number_of_groups() const { return event_counts_.size(); }
+    const Vector &event_counts() const { return event_counts_; }
+    const Vector &exposures() const { return exposures_; }
+
+    // The Poisson rates for each group.
+    const Vector &lambda() const { return lambda_; }
+    double lambda(int group) const { return lambda_[group]; }
+    void set_lambda(const Vector &lambda);
+    void set_lambda(int group, double lambda) { lambda_[group] = lambda; }
+
+    GammaModel *prior_model() { return prior_.get(); }
+    const GammaModel *prior_model() const { return prior_.get(); }
+    double prior_mean() const;
+    double prior_sample_size() const;
+
+   private:
+    void initialize_param_policy();
+
+    Ptr<GammaModel> prior_;
+    Vector event_counts_;
+    Vector exposures_;
+    Vector lambda_;
+  };
+
+}  // namespace BOOM
+
+#endif  //  BOOM_FLAT_HIERARCHICAL_POISSON_MODEL_HPP_
@@ -0,0 +1,85 @@
+// Copyright 2018 Google LLC. All Rights Reserved.
+/*
+  Copyright (C) 2005-2018 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#include "Models/Hierarchical/PosteriorSamplers/FlatHierarchicalDirichletSampler.hpp"
+#include <algorithm>
+#include "distributions.hpp"
+
+namespace BOOM {
+
+  namespace {
+    typedef FlatHierarchicalDirichletSampler FHDS;
+
+    // The number of groups in each shard of the group level draws.
+    const int group_shard_size = 256;
+  }  // namespace
+
+  FHDS::FlatHierarchicalDirichletSampler(
+      FlatHierarchicalDirichletModel *model,
+      const Ptr<DiffVectorModel> &dirichlet_mean_prior,
+      const Ptr<DiffDoubleModel> &dirichlet_sample_size_prior, RNG &seeding_rng)
+      : PosteriorSampler(seeding_rng),
+        model_(model),
+        dirichlet_mean_prior_(dirichlet_mean_prior),
+        dirichlet_sample_size_prior_(dirichlet_sample_size_prior),
+        sampler_(new DirichletPosteriorSampler(
+            model_->prior_model(), dirichlet_mean_prior_,
+            dirichlet_sample_size_prior_, rng())) {
+    model_->prior_model()->set_method(sampler_);
+  }
+
+  double FHDS::logpri() const {
+    const DirichletModel *prior = model_->prior_model();
+    double ans = dirichlet_mean_prior_->logp(prior->pi());
+    ans += dirichlet_sample_size_prior_->logp(sum(prior->nu()));
+    return ans;
+  }
+
+  void FHDS::draw() {
+    DirichletModel *prior = model_->prior_model();
+    const Vector &nu(prior->nu());
+    int ngroups = model_->number_of_groups();
+    int nshards = (ngroups + group_shard_size - 1) / group_shard_size;
+    while (shard_suf_.size() < nshards) {
+      shard_suf_.push_back(new DirichletSuf(prior->dim()));
+    }
+    RNG::RngIntType seed = seed_rng(rng());
+    pool_.parallel_for(0, nshards, 1, [&](int shard) {
+      RNG shard_rng(seed, shard);
+      DirichletSuf &suf(*shard_suf_[shard]);
+      suf.clear();
+      Vector posterior_counts(nu.size());
+      int end = std::min<int>((shard + 1) * group_shard_size, ngroups);
+      for (int i = shard * group_shard_size; i < end; ++i) {
+        posterior_counts = nu;
+        posterior_counts += model_->counts(i);
+        Vector probs = rdirichlet_mt(shard_rng, posterior_counts);
+        model_->mutable_probabilities(i) = probs;
+        suf.add_mixture_data(probs, 1.0);
+      }
+    });
+
+    prior->clear_data();
+    for (int shard = 0; shard < nshards; ++shard) {
+      prior->suf()->combine(*shard_suf_[shard]);
+    }
+    prior->sample_posterior();
+  }
+
+}  // namespace BOOM
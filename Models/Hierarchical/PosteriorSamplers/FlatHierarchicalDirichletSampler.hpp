@@ -0,0 +1,66 @@
+// Copyright 2018 Google LLC. All Rights Reserved.
+/*
+  Copyright (C) 2005-2018 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#ifndef BOOM_FLAT_HIERARCHICAL_DIRICHLET_SAMPLER_HPP_
+#define BOOM_FLAT_HIERARCHICAL_DIRICHLET_SAMPLER_HPP_
+
+#include "Models/DirichletModel.hpp"
+#include "Models/Hierarchical/FlatHierarchicalDirichletModel.hpp"
+#include "Models/PosteriorSamplers/DirichletPosteriorSampler.hpp"
+#include "Models/PosteriorSamplers/PosteriorSampler.hpp"
+#include "cpputil/ThreadTools.hpp"
+
+namespace BOOM {
+
+  // Posterior sampler for the FlatHierarchicalDirichletModel.  The priors
+  // have the same meaning as in the HierarchicalDirichletPosteriorSampler.
+  class FlatHierarchicalDirichletSampler : public PosteriorSampler {
+   public:
+    FlatHierarchicalDirichletSampler(
+        FlatHierarchicalDirichletModel *model,
+        const Ptr<DiffVectorModel> &mean_prior,
+        const Ptr<DiffDoubleModel> &content_prior,
+        RNG &seeding_rng = GlobalRng::rng);
+
+    double logpri() const override;
+
+    // Draw the group level probability vectors from their conjugate
+    // Dirichlet posteriors, then the prior parameters given the
+    // probabilities.  The groups are drawn in fixed-size shards, each with
+    // its own random number stream seeded from rng(), so the draws do not
+    // depend on the number of threads.
+    void draw() override;
+
+    // Set the number of threads to use for the group level draws.
+    void set_number_of_threads(int n) { pool_.set_number_of_threads(n); }
+
+   private:
+    FlatHierarchicalDirichletModel *model_;
+    Ptr<DiffVectorModel> dirichlet_mean_prior_;
+    Ptr<DiffDoubleModel> dirichlet_sample_size_prior_;
+    Ptr<DirichletPosteriorSampler> sampler_;
+
+    // Per-shard sufficient statistics for the prior, combined in shard order.
+    std::vector<Ptr<DirichletSuf>> shard_suf_;
+    SharedThreadPool pool_;
+  };
+
+}  // namespace BOOM
+
+#endif  // BOOM_FLAT_HIERARCHICAL_DIRICHLET_SAMPLER_HPP_
@@ -0,0 +1,105 @@
+// Copyright 2018 Google LLC. All Rights Reserved.
+/*
+  Copyright (C) 2005-2018 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#include "Models/Hierarchical/PosteriorSamplers/FlatHierarchicalGaussianSampler.hpp"
+#include <algorithm>
+#include "distributions.hpp"
+
+namespace BOOM {
+
+  namespace {
+    typedef FlatHierarchicalGaussianSampler FHGS;
+
+    // The number of groups in each shard of the group level draws.
+    const int group_shard_size = 1024;
+  }  // namespace
+
+  FHGS::FlatHierarchicalGaussianSampler(
+      FlatHierarchicalGaussianModel *model,
+      const Ptr<GammaModelBase> &residual_precision_prior, RNG &seeding_rng)
+      : PosteriorSampler(seeding_rng),
+        model_(model),
+        residual_precision_prior_(residual_precision_prior),
+        residual_variance_sampler_(residual_precision_prior_) {}
+
+  void FHGS::draw() {
+    GaussianModel *prior = model_->prior();
+    const double prior_mean = prior->mu();
+    const double prior_precision = 1.0 / prior->sigsq();
+    const double residual_precision = 1.0 / model_->residual_variance();
+    const Vector &sample_sizes(model_->sample_sizes());
+    const Vector &sums(model_->sums());
+    const Vector &sums_of_squares(model_->sums_of_squares());
+
+    int ngroups = model_->number_of_groups();
+    int nshards = (ngroups + group_shard_size - 1) / group_shard_size;
+    while (shard_suf_.size() < nshards) {
+      shard_suf_.push_back(new GaussianSuf);
+    }
+    shard_sample_size_.resize(nshards);
+    shard_residual_sum_of_squares_.resize(nshards);
+
+    RNG::RngIntType seed = seed_rng(rng());
+    pool_.parallel_for(0, nshards, 1, [&](int shard) {
+      RNG shard_rng(seed, shard);
+      GaussianSuf &suf(*shard_suf_[shard]);
+      suf.clear();
+      double sample_size = 0;
+      double residual_sum_of_squares = 0;
+      int end = std::min<int>((shard + 1) * group_shard_size, ngroups);
+      for (int i = shard * group_shard_size; i < end; ++i) {
+        double n = sample_sizes[i];
+        double posterior_precision = prior_precision + n * residual_precision;
+        double posterior_mean =
+            (prior_precision * prior_mean + residual_precision * sums[i]) /
+            posterior_precision;
+        double mu = rnorm_mt(shard_rng, posterior_mean,
+                             1.0 / sqrt(posterior_precision));
+        model_->set_group_mean(i, mu);
+        suf.update_raw(mu);
+        sample_size += n;
+        residual_sum_of_squares +=
+            sums_of_squares[i] - 2 * mu * sums[i] + n * mu * mu;
+      }
+      shard_sample_size_[shard] = sample_size;
+      shard_residual_sum_of_squares_[shard] = residual_sum_of_squares;
+    });
+
+    prior->clear_data();
+    for (int shard = 0; shard < nshards; ++shard) {
+      prior->suf()->combine(*shard_suf_[shard]);
+    }
+    model_->set_residual_variance(residual_variance_sampler_.draw(
+        rng(), sum(shard_sample_size_),
+        std::max<double>(sum(shard_residual_sum_of_squares_), 0.0)));
+    prior->sample_posterior();
+  }
+
+  double FHGS::logpri() const {
+    const GaussianModel *prior = model_->prior();
+    double ans =
+        residual_variance_sampler_.log_prior(model_->residual_variance());
+    for (int i = 0; i < model_->number_of_groups(); ++i) {
+      ans += prior->logp(model_->group_mean(i));
+    }
+    ans += prior->logpri();
+    return ans;
+  }
+
+}  // namespace BOOM
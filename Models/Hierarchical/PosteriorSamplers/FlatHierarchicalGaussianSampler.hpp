@@ -0,0 +1,72 @@
+// Copyright 2018 Google LLC. All Rights Reserved.
+/*
+  Copyright (C) 2005-2018 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#ifndef BOOM_FLAT_HIERARCHICAL_GAUSSIAN_SAMPLER_HPP_
+#define BOOM_FLAT_HIERARCHICAL_GAUSSIAN_SAMPLER_HPP_
+
+#include "Models/GammaModel.hpp"
+#include "Models/Hierarchical/FlatHierarchicalGaussianModel.hpp"
+#include "Models/PosteriorSamplers/GenericGaussianVarianceSampler.hpp"
+#include "Models/PosteriorSamplers/PosteriorSampler.hpp"
+#include "cpputil/ThreadTools.hpp"
+
+namespace BOOM {
+
+  // Posterior sampler for the FlatHierarchicalGaussianModel.  The sampler
+  // for the prior distribution of the group means must be set separately,
+  // by calling model->prior()->set_method().
+  class FlatHierarchicalGaussianSampler : public PosteriorSampler {
+   public:
+    // Args:
+    //   model:  The model to be sampled.
+    //   residual_precision_prior: Prior distribution on 1 / sigma^2, where
+    //     sigma^2 is the variance of the observations about their group
+    //     means.
+    FlatHierarchicalGaussianSampler(
+        FlatHierarchicalGaussianModel *model,
+        const Ptr<GammaModelBase> &residual_precision_prior,
+        RNG &seeding_rng = GlobalRng::rng);
+
+    // Draw the group means given the prior and residual variance, then the
+    // residual variance, then the prior parameters.  The group means are
+    // drawn in fixed-size shards, each with its own random number stream
+    // seeded from rng(), so the draws do not depend on the number of
+    // threads.
+    void draw() override;
+    double logpri() const override;
+
+    // Set the number of threads to use for the group level draws.
+    void set_number_of_threads(int n) { pool_.set_number_of_threads(n); }
+
+   private:
+    FlatHierarchicalGaussianModel *model_;
+    Ptr<GammaModelBase> residual_precision_prior_;
+    GenericGaussianVarianceSampler residual_variance_sampler_;
+
+    // Per-shard sufficient statistics for the prior, and for the residual
+    // variance, combined in shard order.
+    std::vector<Ptr<GaussianSuf>> shard_suf_;
+    Vector shard_sample_size_;
+    Vector shard_residual_sum_of_squares_;
+    SharedThreadPool pool_;
+  };
+
+}  // namespace BOOM
+
+#endif  //  BOOM_FLAT_HIERARCHICAL_GAUSSIAN_SAMPLER_HPP_
@@ -0,0 +1,102 @@
+// Copyright 2018 Google LLC. All Rights Reserved.
+/*
+  Copyright (C) 2005-2018 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#include "Models/Hierarchical/PosteriorSamplers/FlatHierarchicalPoissonSampler.hpp"
+#include <algorithm>
+#include "Models/PosteriorSamplers/GammaPosteriorSampler.hpp"
+#include "cpputil/report_error.hpp"
+#include "distributions.hpp"
+
+namespace BOOM {
+
+  namespace {
+    typedef FlatHierarchicalPoissonSampler FHPS;
+
+    // The number of groups in each shard of the group level draws.  The
+    // per-group work is a single gamma draw, so shards are large.
+    const int group_shard_size = 1024;
+  }  // namespace
+
+  FHPS::FlatHierarchicalPoissonSampler(
+      FlatHierarchicalPoissonModel *model,
+      const Ptr<DoubleModel> &gamma_mean_prior,
+      const Ptr<DoubleModel> &gamma_sample_size_prior, RNG &seeding_rng)
+      : PosteriorSampler(seeding_rng),
+        model_(model),
+        gamma_mean_prior_(gamma_mean_prior),
+        gamma_sample_size_prior_(gamma_sample_size_prior) {
+    GammaModel *prior = model_->prior_model();
+    prior->clear_methods();
+    NEW(GammaPosteriorSampler, prior_sampler)
+    (prior, gamma_mean_prior_, gamma_sample_size_prior_, rng());
+    prior->set_method(prior_sampler);
+  }
+
+  double FHPS::logpri() const {
+    const GammaModel *prior = model_->prior_model();
+    return gamma_mean_prior_->logp(prior->mean()) +
+           gamma_sample_size_prior_->logp(prior->alpha());
+  }
+
+  void FHPS::draw() {
+    GammaModel *prior = model_->prior_model();
+    const double alpha = prior->alpha();
+    const double beta = prior->beta();
+    const Vector &counts(model_->event_counts());
+    const Vector &exposures(model_->exposures());
+
+    int ngroups = model_->number_of_groups();
+    int nshards = (ngroups + group_shard_size - 1) / group_shard_size;
+    while (shard_suf_.size() < nshards) {
+      shard_suf_.push_back(new GammaSuf);
+    }
+    RNG::RngIntType seed = seed_rng(rng());
+    pool_.parallel_for(0, nshards, 1, [&](int shard) {
+      RNG shard_rng(seed, shard);
+      GammaSuf &suf(*shard_suf_[shard]);
+      suf.clear();
+      int end = std::min<int>((shard + 1) * group_shard_size, ngroups);
+      for (int i = shard * group_shard_size; i < end; ++i) {
+        double a = alpha + counts[i];
+        double b = beta + exposures[i];
+        double lambda = 0;
+        int number_attempts = 0;
+        // Tiny shape parameters can underflow to zero, which the gamma
+        // prior cannot absorb.
+        while (lambda <= 0) {
+          if (++number_attempts > 1000) {
+            report_error(
+                "Too many attempts to draw a positive mean in "
+                "FlatHierarchicalPoissonSampler::draw");
+          }
+          lambda = rgamma_mt(shard_rng, a, b);
+        }
+        model_->set_lambda(i, lambda);
+        suf.update_raw(lambda);
+      }
+    });
+
+    prior->clear_data();
+    for (int shard = 0; shard < nshards; ++shard) {
+      prior->suf()->combine(*shard_suf_[shard]);
+    }
+    prior->sample_posterior();
+  }
+
+}  // namespace BOOM
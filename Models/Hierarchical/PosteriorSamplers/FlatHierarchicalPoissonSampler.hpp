@@ -0,0 +1,72 @@
+// Copyright 2018 Google LLC. All Rights Reserved.
+/*
+  Copyright (C) 2005-2018 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#ifndef BOOM_FLAT_HIERARCHICAL_POISSON_SAMPLER_HPP_
+#define BOOM_FLAT_HIERARCHICAL_POISSON_SAMPLER_HPP_
+
+#include "Models/DoubleModel.hpp"
+#include "Models/GammaModel.hpp"
+#include "Models/Hierarchical/FlatHierarchicalPoissonModel.hpp"
+#include "Models/PosteriorSamplers/PosteriorSampler.hpp"
+#include "cpputil/ThreadTools.hpp"
+
+namespace BOOM {
+
+  // Posterior sampler for the FlatHierarchicalPoissonModel.  The priors on
+  // the gamma distribution of the group level rates have the same meaning
+  // as in the HierarchicalPoissonSampler.
+  class FlatHierarchicalPoissonSampler : public PosteriorSampler {
+   public:
+    // Args:
+    //   model: The model whose parameters are to be to be sampled
+    //     from their posterior distribution.
+    //   gamma_mean_prior: Prior distribution on the mean of the gamma
+    //     distribution: a/b.
+    //   gamma_sample_size_prior: Prior distribution on the shape
+    //     parameter of the gamma distribution: a.
+    FlatHierarchicalPoissonSampler(
+        FlatHierarchicalPoissonModel *model,
+        const Ptr<DoubleModel> &gamma_mean_prior,
+        const Ptr<DoubleModel> &gamma_sample_size_prior,
+        RNG &seeding_rng = GlobalRng::rng);
+    double logpri() const override;
+
+    // Draw the group level rates from their conjugate gamma posteriors,
+    // then the prior parameters given the rates.  The groups are drawn in
+    // fixed-size shards, each with its own random number stream seeded from
+    // rng(), so the draws do not depend on the number of threads.
+    void draw() override;
+
+    // Set the number of threads to use for the group level draws.
+    void set_number_of_threads(int n) { pool_.set_number_of_threads(n); }
+
+   private:
+    FlatHierarchicalPoissonModel *model_;
+    Ptr<DoubleModel> gamma_mean_prior_;
+    Ptr<DoubleModel> gamma_sample_size_prior_;
+
+    // Per-shard sufficient statistics for the prior, combined in shard
+    // order.
+    std::vector<Ptr<GammaSuf>> shard_suf_;
+    SharedThreadPool pool_;
+  };
+
+}  // namespace BOOM
+
+#endif  //  BOOM_FLAT_HIERARCHICAL_POISSON_SAMPLER_HPP_
@@ -18,6 +18,7 @@
 */
 
 #include "Models/Hierarchical/PosteriorSamplers/HierGaussianRegressionAsisSampler.hpp"
+#include <algorithm>
 #include "Models/Glm/PosteriorSamplers/RegressionCoefficientSampler.hpp"
 #include "Models/PosteriorSamplers/MvnMeanSampler.hpp"
 #include "Models/PosteriorSamplers/MvnVarSampler.hpp"
@@ -25,6 +26,9 @@
 namespace BOOM {
   namespace {
     typedef HierGaussianRegressionAsisSampler HGRAS;
+
+    // The number of groups in each shard of the group level draws.
+    const int group_shard_size = 64;
   }
   HGRAS::HierGaussianRegressionAsisSampler(
       HierarchicalGaussianRegressionModel *model,
@@ -47,13 +51,36 @@ namespace BOOM {
 
   void HGRAS::draw() {
     MvnModel *prior = model_->prior();
+    // The prior precision is computed lazily, so it is extracted here
+    // rather than in the worker threads.
+    const Vector &prior_mean(prior->mu());
+    const SpdMatrix &prior_precision(prior->siginv());
+    int ngroups = model_->number_of_groups();
+    int nshards = (ngroups + group_shard_size - 1) / group_shard_size;
+    while (shard_suf_.size() < nshards) {
+      shard_suf_.push_back(new MvnSuf(prior->dim()));
+    }
+    RNG::RngIntType seed = seed_rng(rng());
+    pool_.parallel_for(0, nshards, 1, [&](int shard) {
+      RNG shard_rng(seed, shard);
+      MvnSuf &suf(*shard_suf_[shard]);
+      suf.clear();
+      int end = std::min<int>((shard + 1) * group_shard_size, ngroups);
+      for (int i = shard * group_shard_size; i < end; ++i) {
+        RegressionModel *reg = model_->data_model(i);
+        // Sample coefficients for model i.
+        RegressionCoefficientSampler::sample_regression_coefficients(
+            shard_rng, reg, prior_mean, prior_precision);
+        suf.update_raw(reg->Beta());
+      }
+    });
     prior->clear_data();
-    for (int i = 0; i < model_->number_of_groups(); ++i) {
-      RegressionModel *reg = model_->data_model(i);
-      // Sample coefficients for model i.
-      RegressionCoefficientSampler::sample_regression_coefficients(
-          rng(), reg, *prior);
-      prior->suf()->update_raw(reg->Beta());
+    for (int shard = 0; shard < nshards; ++shard) {
+      // MvnSuf::combine divides by the combined sample size, so empty
+      // statistics must be skipped.
+      if (shard_suf_[shard]->n() > 0) {
+        prior->suf()->combine(*shard_suf_[shard]);
+      }
     }
     prior->sample_posterior();
 
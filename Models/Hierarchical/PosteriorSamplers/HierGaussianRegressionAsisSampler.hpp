@@ -27,6 +27,7 @@
 #include "Models/PosteriorSamplers/MvnVarSampler.hpp"
 #include "Models/PosteriorSamplers/PosteriorSampler.hpp"
 #include "Models/WishartModel.hpp"
+#include "cpputil/ThreadTools.hpp"
 
 namespace BOOM {
 
@@ -57,9 +58,17 @@ namespace BOOM {
         const Ptr<WishartModel> &coefficient_precision_hyperprior,
         const Ptr<GammaModelBase> &residual_precision_prior,
         RNG &seeding_rng = GlobalRng::rng);
+
+    // The group level coefficients are drawn in fixed-size shards of
+    // conditionally independent groups, in parallel if threads have been
+    // allotted.  Each shard has its own random number stream seeded from
+    // rng(), so the draws do not depend on the number of threads.
     void draw() override;
     double logpri() const override;
 
+    // Set the number of threads to use for the group level draws.
+    void set_number_of_threads(int n) { pool_.set_number_of_threads(n); }
+
     // Reset the hyperprior models used in the sampler.  These have the same
     // meaning as in the constructor.  The residual_precision_prior can be
     // nullptr if the residual variance is to be either held fixed or managed by
@@ -83,6 +92,10 @@ namespace BOOM {
     void refresh_working_suf();
     SpdMatrix xtx_;
     Vector xty_;
+
+    // Per-shard sufficient statistics for the prior, combined in shard order.
+    std::vector<Ptr<MvnSuf>> shard_suf_;
+    SharedThreadPool pool_;
   };
 
 }  // namespace BOOM
@@ -18,6 +18,7 @@
 */
 
 #include "Models/Hierarchical/PosteriorSamplers/HierarchicalDirichletPosteriorSampler.hpp"
+#include <algorithm>
 #include "Models/Hierarchical/HierarchicalDirichletModel.hpp"
 #include "Models/PosteriorSamplers/PosteriorSampler.hpp"
 
@@ -25,6 +26,9 @@ namespace BOOM {
 
   namespace {
     typedef HierarchicalDirichletPosteriorSampler HDPS;
+
+    // The number of groups in each shard of the group level draws.
+    const int group_shard_size = 256;
   }
 
   HDPS::HierarchicalDirichletPosteriorSampler(
@@ -50,8 +54,8 @@ namespace BOOM {
 
   void HDPS::draw() {
     DirichletModel *prior = model_->prior_model();
-    prior->clear_data();
-    for (int i = 0; i < model_->number_of_groups(); ++i) {
+    int ngroups = model_->number_of_groups();
+    for (int i = 0; i < ngroups; ++i) {
       MultinomialModel *data_model = model_->data_model(i);
       if (data_model->number_of_sampling_methods() != 1) {
         data_model->clear_methods();
@@ -59,8 +63,26 @@ namespace BOOM {
         (data_model, Ptr<DirichletModel>(prior), rng());
         data_model->set_method(data_model_sampler);
       }
-      data_model->sample_posterior();
-      prior->suf()->update(*(data_model->Pi_prm()));
+    }
+
+    int nshards = (ngroups + group_shard_size - 1) / group_shard_size;
+    while (shard_suf_.size() < nshards) {
+      shard_suf_.push_back(new DirichletSuf(prior->dim()));
+    }
+    pool_.parallel_for(0, nshards, 1, [&](int shard) {
+      DirichletSuf &suf(*shard_suf_[shard]);
+      suf.clear();
+      int end = std::min<int>((shard + 1) * group_shard_size, ngroups);
+      for (int i = shard * group_shard_size; i < end; ++i) {
+        MultinomialModel *data_model = model_->data_model(i);
+        data_model->sample_posterior();
+        suf.update(*(data_model->Pi_prm()));
+      }
+    });
+
+    prior->clear_data();
+    for (int shard = 0; shard < nshards; ++shard) {
+      prior->suf()->combine(*shard_suf_[shard]);
     }
     prior->sample_posterior();
   }
@@ -24,6 +24,8 @@
 #include "Models/PosteriorSamplers/DirichletPosteriorSampler.hpp"
 #include "Models/PosteriorSamplers/PosteriorSampler.hpp"
 #include "Models/Hierarchical/HierarchicalDirichletModel.hpp"
+#include "cpputil/ThreadTools.hpp"
+
 namespace BOOM {
 
   class HierarchicalDirichletPosteriorSampler : public PosteriorSampler {
@@ -35,13 +37,25 @@ namespace BOOM {
         RNG &seeding_rng = GlobalRng::rng);
 
     double logpri() const override;
+
+    // The group level probability vectors are drawn in fixed-size shards of
+    // conditionally independent groups, in parallel if threads have been
+    // allotted.  Each group has its own sampler and random number stream, so
+    // the draws do not depend on the number of threads.
     void draw() override;
 
+    // Set the number of threads to use for the group level draws.
+    void set_number_of_threads(int n) { pool_.set_number_of_threads(n); }
+
    private:
     HierarchicalDirichletModel *model_;
     Ptr<DiffVectorModel> dirichlet_mean_prior_;
     Ptr<DiffDoubleModel> dirichlet_sample_size_prior_;
     Ptr<DirichletPosteriorSampler> sampler_;
+
+    // Per-shard sufficient statistics for the prior, combined in shard order.
+    std::vector<Ptr<DirichletSuf>> shard_suf_;
+    SharedThreadPool pool_;
   };
 
 }  // namespace BOOM
@@ -18,9 +18,15 @@
 */
 
 #include "Models/Hierarchical/PosteriorSamplers/HierarchicalGammaSampler.hpp"
+#include <algorithm>
 
 namespace BOOM {
 
+  namespace {
+    // The number of groups in each shard of the group level draws.
+    const int group_shard_size = 128;
+  }  // namespace
+
   HierarchicalGammaSampler::HierarchicalGammaSampler(
       HierarchicalGammaModel *model,
       const Ptr<DoubleModel> &gamma_mean_mean_prior,
@@ -49,17 +55,31 @@ namespace BOOM {
 
   // The draw() method will draw values of the gamma_mean and gamma_shape
   void HierarchicalGammaSampler::draw() {
+    int ngroups = model_->number_of_groups();
+    for (int i = 0; i < ngroups; ++i) {
+      ensure_posterior_sampling_method(model_->data_model(i));
+    }
+    int nshards = (ngroups + group_shard_size - 1) / group_shard_size;
+    while (shard_mean_suf_.size() < nshards) {
+      shard_mean_suf_.push_back(new GammaSuf);
+      shard_shape_suf_.push_back(new GammaSuf);
+    }
+    pool_.parallel_for(0, nshards, 1, [&](int shard) {
+      int begin = shard * group_shard_size;
+      int end = std::min<int>(begin + group_shard_size, ngroups);
+      shard_mean_suf_[shard]->clear();
+      shard_shape_suf_[shard]->clear();
+      draw_groups(begin, end, *shard_mean_suf_[shard],
+                  *shard_shape_suf_[shard]);
+    });
+
     model_->prior_for_mean_parameters()->clear_data();
     model_->prior_for_shape_parameters()->clear_data();
-
-    for (int i = 0; i < model_->number_of_groups(); ++i) {
-      GammaModel *data_model = model_->data_model(i);
-      ensure_posterior_sampling_method(data_model);
-      data_model->sample_posterior();
-      model_->prior_for_mean_parameters()->suf()->update_raw(
-          data_model->mean());
-      model_->prior_for_shape_parameters()->suf()->update_raw(
-          data_model->alpha());
+    for (int shard = 0; shard < nshards; ++shard) {
+      model_->prior_for_mean_parameters()->suf()->combine(
+          *shard_mean_suf_[shard]);
+      model_->prior_for_shape_parameters()->suf()->combine(
+          *shard_shape_suf_[shard]);
     }
 
     model_->prior_for_mean_parameters()->sample_posterior();
@@ -71,9 +91,20 @@ namespace BOOM {
     if (data_model->number_of_sampling_methods() == 0) {
       NEW(GammaPosteriorSampler, sampler)
       (data_model, model_->prior_for_mean_parameters(),
-       model_->prior_for_shape_parameters());
+       model_->prior_for_shape_parameters(), rng());
       data_model->set_method(sampler);
     }
   }
 
+  void HierarchicalGammaSampler::draw_groups(int begin, int end,
+                                             GammaSuf &mean_suf,
+                                             GammaSuf &shape_suf) {
+    for (int i = begin; i < end; ++i) {
+      GammaModel *data_model = model_->data_model(i);
+      data_model->sample_posterior();
+      mean_suf.update_raw(data_model->mean());
+      shape_suf.update_raw(data_model->alpha());
+    }
+  }
+
 }  // namespace BOOM
@@ -24,6 +24,7 @@
 #include "Models/Hierarchical/HierarchicalGammaModel.hpp"
 #include "Models/PosteriorSamplers/GammaPosteriorSampler.hpp"
 #include "Models/PosteriorSamplers/PosteriorSampler.hpp"
+#include "cpputil/ThreadTools.hpp"
 
 namespace BOOM {
 
@@ -60,13 +61,26 @@ namespace BOOM {
                              const Ptr<DoubleModel> &gamma_shape_shape_prior,
                              RNG &seeding_rng = GlobalRng::rng);
     double logpri() const override;
+
+    // The group level parameters are drawn in fixed-size shards of
+    // conditionally independent groups, in parallel if threads have been
+    // allotted.  Each group has its own sampler and random number stream, so
+    // the draws do not depend on the number of threads.
     void draw() override;
 
+    // Set the number of threads to use for the group level draws.
+    void set_number_of_threads(int n) { pool_.set_number_of_threads(n); }
+
    private:
     // Check that a posterior sampler has been assigned to
     // *data_model.  If not, assign one.
     void ensure_posterior_sampling_method(GammaModel *data_model);
 
+    // Draw the parameters for groups [begin, end), accumulating the group
+    // means and shapes in the given sufficient statistics.
+    void draw_groups(int begin, int end, GammaSuf &mean_suf,
+                     GammaSuf &shape_suf);
+
     HierarchicalGammaModel *model_;
     Ptr<DoubleModel> gamma_mean_mean_prior_;
     Ptr<DoubleModel> gamma_mean_shape_prior_;
@@ -78,6 +92,12 @@ namespace BOOM {
 
     // Responsible for drawing a_mean and a_shape.
     Ptr<GammaPosteriorSampler> gamma_shape_sampler_;
+
+    // Per-shard sufficient statistics for the two priors, combined in shard
+    // order.
+    std::vector<Ptr<GammaSuf>> shard_mean_suf_;
+    std::vector<Ptr<GammaSuf>> shard_shape_suf_;
+    SharedThreadPool pool_;
   };
 
 }  // namespace BOOM
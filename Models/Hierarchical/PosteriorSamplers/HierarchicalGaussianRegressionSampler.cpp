@@ -18,12 +18,16 @@
 */
 
 #include "Models/Hierarchical/PosteriorSamplers/HierarchicalGaussianRegressionSampler.hpp"
+#include <algorithm>
 #include "Models/Glm/PosteriorSamplers/RegressionCoefficientSampler.hpp"
 
 namespace BOOM {
   namespace {
     typedef HierarchicalGaussianRegressionSampler HGRS;
     typedef HierarchicalGaussianRegressionModel HGRM;
+
+    // The number of groups in each shard of the group level draws.
+    const int group_shard_size = 64;
   }  // namespace
 
   HGRS::HierarchicalGaussianRegressionSampler(
@@ -34,22 +38,51 @@ namespace BOOM {
         residual_variance_prior_(residual_precision_prior),
         residual_variance_sampler_(residual_variance_prior_) {}
 
-  // TODO:  Consider threads here.
   void HGRS::draw() {
-    double sample_size = 0;
-    double residual_sum_of_squares = 0;
     MvnModel *prior = model_->prior();
+    // The prior precision is computed lazily, so it is extracted here
+    // rather than in the worker threads.
+    const Vector &prior_mean(prior->mu());
+    const SpdMatrix &prior_precision(prior->siginv());
+
+    int ngroups = model_->number_of_groups();
+    int nshards = (ngroups + group_shard_size - 1) / group_shard_size;
+    while (shard_suf_.size() < nshards) {
+      shard_suf_.push_back(new MvnSuf(prior->dim()));
+    }
+    shard_sample_size_.resize(nshards);
+    shard_residual_sum_of_squares_.resize(nshards);
+
+    RNG::RngIntType seed = seed_rng(rng());
+    pool_.parallel_for(0, nshards, 1, [&](int shard) {
+      RNG shard_rng(seed, shard);
+      MvnSuf &suf(*shard_suf_[shard]);
+      suf.clear();
+      double sample_size = 0;
+      double residual_sum_of_squares = 0;
+      int end = std::min<int>((shard + 1) * group_shard_size, ngroups);
+      for (int i = shard * group_shard_size; i < end; ++i) {
+        RegressionModel *reg = model_->data_model(i);
+        RegressionCoefficientSampler::sample_regression_coefficients(
+            shard_rng, reg, prior_mean, prior_precision);
+        suf.update_raw(reg->Beta());
+        sample_size += reg->suf()->n();
+        residual_sum_of_squares += reg->suf()->relative_sse(reg->coef());
+      }
+      shard_sample_size_[shard] = sample_size;
+      shard_residual_sum_of_squares_[shard] = residual_sum_of_squares;
+    });
+
     prior->clear_data();
-    for (int i = 0; i < model_->number_of_groups(); ++i) {
-      RegressionModel *reg = model_->data_model(i);
-      RegressionCoefficientSampler::sample_regression_coefficients(rng(), reg,
-                                                                   *prior);
-      prior->suf()->update_raw(reg->Beta());
-      sample_size += reg->suf()->n();
-      residual_sum_of_squares += reg->suf()->relative_sse(reg->coef());
+    for (int shard = 0; shard < nshards; ++shard) {
+      // MvnSuf::combine divides by the combined sample size, so empty
+      // statistics must be skipped.
+      if (shard_suf_[shard]->n() > 0) {
+        prior->suf()->combine(*shard_suf_[shard]);
+      }
     }
     model_->set_residual_variance(residual_variance_sampler_.draw(
-        rng(), sample_size, residual_sum_of_squares));
+        rng(), sum(shard_sample_size_), sum(shard_residual_sum_of_squares_)));
     prior->sample_posterior();
   }
 
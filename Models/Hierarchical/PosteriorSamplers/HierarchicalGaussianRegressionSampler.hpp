@@ -24,6 +24,7 @@
 #include "Models/Hierarchical/HierarchicalGaussianRegressionModel.hpp"
 #include "Models/PosteriorSamplers/GenericGaussianVarianceSampler.hpp"
 #include "Models/PosteriorSamplers/PosteriorSampler.hpp"
+#include "cpputil/ThreadTools.hpp"
 
 namespace BOOM {
 
@@ -33,13 +34,27 @@ namespace BOOM {
         HierarchicalGaussianRegressionModel *model,
         const Ptr<GammaModelBase> &residual_precision_prior,
         RNG &seeding_rng = GlobalRng::rng);
+    // The group level coefficients are drawn in fixed-size shards of
+    // conditionally independent groups, in parallel if threads have been
+    // allotted.  Each shard has its own random number stream seeded from
+    // rng(), so the draws do not depend on the number of threads.
     void draw() override;
     double logpri() const override;
 
+    // Set the number of threads to use for the group level draws.
+    void set_number_of_threads(int n) { pool_.set_number_of_threads(n); }
+
    private:
     HierarchicalGaussianRegressionModel *model_;
     Ptr<GammaModelBase> residual_variance_prior_;
     GenericGaussianVarianceSampler residual_variance_sampler_;
+
+    // Per-shard sufficient statistics for the prior, and for the residual
+    // variance, combined in shard order.
+    std::vector<Ptr<MvnSuf>> shard_suf_;
+    Vector shard_sample_size_;
+    Vector shard_residual_sum_of_squares_;
+    SharedThreadPool pool_;
   };
 
 }  // namespace BOOM
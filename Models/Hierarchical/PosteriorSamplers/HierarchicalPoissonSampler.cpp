@@ -18,11 +18,17 @@
 */
 
 #include "Models/Hierarchical/PosteriorSamplers/HierarchicalPoissonSampler.hpp"
+#include <algorithm>
 #include "Models/PosteriorSamplers/GammaPosteriorSampler.hpp"
 #include "Models/PosteriorSamplers/PoissonGammaSampler.hpp"
 
 namespace BOOM {
 
+  namespace {
+    // The number of groups in each shard of the group level draws.
+    const int group_shard_size = 256;
+  }  // namespace
+
   HierarchicalPoissonSampler::HierarchicalPoissonSampler(
       HierarchicalPoissonModel *model, const Ptr<DoubleModel> &gamma_mean_prior,
       const Ptr<DoubleModel> &gamma_sample_size_prior, RNG &seeding_rng)
@@ -45,15 +51,42 @@ namespace BOOM {
 
   void HierarchicalPoissonSampler::draw() {
     GammaModel *prior = model_->prior_model();
+    ensure_data_model_samplers();
+    int ngroups = model_->number_of_groups();
+    int nshards = (ngroups + group_shard_size - 1) / group_shard_size;
+    while (shard_suf_.size() < nshards) {
+      shard_suf_.push_back(new GammaSuf);
+    }
+    pool_.parallel_for(0, nshards, 1, [&](int shard) {
+      int begin = shard * group_shard_size;
+      int end = std::min<int>(begin + group_shard_size, ngroups);
+      shard_suf_[shard]->clear();
+      draw_groups(begin, end, *shard_suf_[shard]);
+    });
+
     prior->clear_data();
+    for (int shard = 0; shard < nshards; ++shard) {
+      prior->suf()->combine(*shard_suf_[shard]);
+    }
+    prior->sample_posterior();
+  }
+
+  void HierarchicalPoissonSampler::ensure_data_model_samplers() {
+    Ptr<GammaModel> prior(model_->prior_model());
     for (int i = 0; i < model_->number_of_groups(); ++i) {
       PoissonModel *data_model = model_->data_model(i);
       if (data_model->number_of_sampling_methods() != 1) {
         data_model->clear_methods();
-        NEW(PoissonGammaSampler, data_model_sampler)
-        (data_model, Ptr<GammaModel>(prior), rng());
+        NEW(PoissonGammaSampler, data_model_sampler)(data_model, prior, rng());
         data_model->set_method(data_model_sampler);
       }
+    }
+  }
+
+  void HierarchicalPoissonSampler::draw_groups(int begin, int end,
+                                               GammaSuf &suf) {
+    for (int i = begin; i < end; ++i) {
+      PoissonModel *data_model = model_->data_model(i);
       int number_attempts = 0;
       do {
         data_model->sample_posterior();
@@ -63,9 +96,8 @@ namespace BOOM {
               "HierarchicalPoissonSampler::draw");
         }
       } while (data_model->lam() == 0);
-      prior->suf()->update_raw(data_model->lam());
+      suf.update_raw(data_model->lam());
     }
-    prior->sample_posterior();
   }
 
 }  // namespace BOOM
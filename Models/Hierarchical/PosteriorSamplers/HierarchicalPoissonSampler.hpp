@@ -22,6 +22,7 @@
 
 #include "Models/DoubleModel.hpp"
 #include "Models/Hierarchical/HierarchicalPoissonModel.hpp"
+#include "cpputil/ThreadTools.hpp"
 
 namespace BOOM {
 
@@ -51,12 +52,33 @@ namespace BOOM {
                                const Ptr<DoubleModel> &gamma_sample_size_prior,
                                RNG &seeding_rng = GlobalRng::rng);
     double logpri() const override;
+
+    // Draw the group level rates given the prior, then the prior parameters
+    // given the rates.  The groups are conditionally independent, so they
+    // are processed in fixed-size shards, in parallel if threads have been
+    // allotted.  Each group has its own sampler and random number stream, so
+    // the draws do not depend on the number of threads.
     void draw() override;
 
+    // Set the number of threads to use for the group level draws.
+    void set_number_of_threads(int n) { pool_.set_number_of_threads(n); }
+
    private:
+    // Assign a PoissonGammaSampler to any data model that lacks one.  This
+    // uses rng(), so it is done serially before the parallel draws.
+    void ensure_data_model_samplers();
+
+    // Draw the rates for groups [begin, end), accumulating them in suf.
+    void draw_groups(int begin, int end, GammaSuf &suf);
+
     HierarchicalPoissonModel *model_;
     Ptr<DoubleModel> gamma_mean_prior_;
     Ptr<DoubleModel> gamma_sample_size_prior_;
+
+    // Per-shard sufficient statistics for the prior, combined in shard
+    // order.
+    std::vector<Ptr<GammaSuf>> shard_suf_;
+    SharedThreadPool pool_;
   };
 
 }  // namespace BOOM
@@ -18,9 +18,15 @@
 */
 
 #include "Models/Hierarchical/PosteriorSamplers/HierarchicalZeroInflatedGammaSampler.hpp"
+#include <algorithm>
 
 namespace BOOM {
 
+  namespace {
+    // The number of groups in each shard of the group level draws.
+    const int group_shard_size = 128;
+  }  // namespace
+
   HierarchicalZeroInflatedGammaSampler::HierarchicalZeroInflatedGammaSampler(
       HierarchicalZeroInflatedGammaModel *model,
       const Ptr<DoubleModel> &gamma_mean_mean_prior,
@@ -62,20 +68,32 @@ namespace BOOM {
 
   // The draw() method will draw values of the gamma_mean and gamma_shape
   void HierarchicalZeroInflatedGammaSampler::draw() {
+    int ngroups = model_->number_of_groups();
+    for (int i = 0; i < ngroups; ++i) {
+      ensure_posterior_sampling_method(model_->data_model(i));
+    }
+    int nshards = (ngroups + group_shard_size - 1) / group_shard_size;
+    while (shard_mean_suf_.size() < nshards) {
+      shard_positive_probability_suf_.push_back(new BetaSuf);
+      shard_mean_suf_.push_back(new GammaSuf);
+      shard_shape_suf_.push_back(new GammaSuf);
+    }
+    pool_.parallel_for(0, nshards, 1, [&](int shard) {
+      int begin = shard * group_shard_size;
+      int end = std::min<int>(begin + group_shard_size, ngroups);
+      draw_groups(begin, end, shard);
+    });
+
     model_->prior_for_positive_probability()->clear_data();
     model_->prior_for_mean_parameters()->clear_data();
     model_->prior_for_shape_parameters()->clear_data();
-
-    for (int i = 0; i < model_->number_of_groups(); ++i) {
-      ZeroInflatedGammaModel *data_model = model_->data_model(i);
-      ensure_posterior_sampling_method(data_model);
-      data_model->sample_posterior();
-      model_->prior_for_positive_probability()->suf()->update_raw(
-          data_model->positive_probability());
-      model_->prior_for_mean_parameters()->suf()->update_raw(
-          data_model->mean_parameter());
-      model_->prior_for_shape_parameters()->suf()->update_raw(
-          data_model->shape_parameter());
+    for (int shard = 0; shard < nshards; ++shard) {
+      model_->prior_for_positive_probability()->suf()->combine(
+          *shard_positive_probability_suf_[shard]);
+      model_->prior_for_mean_parameters()->suf()->combine(
+          *shard_mean_suf_[shard]);
+      model_->prior_for_shape_parameters()->suf()->combine(
+          *shard_shape_suf_[shard]);
     }
 
     model_->prior_for_positive_probability()->sample_posterior();
@@ -83,6 +101,23 @@ namespace BOOM {
     model_->prior_for_shape_parameters()->sample_posterior();
   }
 
+  void HierarchicalZeroInflatedGammaSampler::draw_groups(int begin, int end,
+                                                         int shard) {
+    BetaSuf &positive_probability_suf(*shard_positive_probability_suf_[shard]);
+    GammaSuf &mean_suf(*shard_mean_suf_[shard]);
+    GammaSuf &shape_suf(*shard_shape_suf_[shard]);
+    positive_probability_suf.clear();
+    mean_suf.clear();
+    shape_suf.clear();
+    for (int i = begin; i < end; ++i) {
+      ZeroInflatedGammaModel *data_model = model_->data_model(i);
+      data_model->sample_posterior();
+      positive_probability_suf.update_raw(data_model->positive_probability());
+      mean_suf.update_raw(data_model->mean_parameter());
+      shape_suf.update_raw(data_model->shape_parameter());
+    }
+  }
+
   void HierarchicalZeroInflatedGammaSampler::ensure_posterior_sampling_method(
       ZeroInflatedGammaModel *data_model) {
     if (data_model->number_of_sampling_methods() == 0) {
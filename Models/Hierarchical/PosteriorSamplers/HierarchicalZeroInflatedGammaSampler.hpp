@@ -26,6 +26,7 @@
 #include "Models/PosteriorSamplers/GammaPosteriorSampler.hpp"
 #include "Models/PosteriorSamplers/PosteriorSampler.hpp"
 #include "Models/PosteriorSamplers/ZeroInflatedGammaPosteriorSampler.hpp"
+#include "cpputil/ThreadTools.hpp"
 
 namespace BOOM {
 
@@ -72,13 +73,25 @@ namespace BOOM {
         const Ptr<DoubleModel> &positive_probability_sample_size_prior,
         RNG &seeding_rng = GlobalRng::rng);
     double logpri() const override;
+
+    // The group level parameters are drawn in fixed-size shards of
+    // conditionally independent groups, in parallel if threads have been
+    // allotted.  Each group has its own sampler and random number stream, so
+    // the draws do not depend on the number of threads.
     void draw() override;
 
+    // Set the number of threads to use for the group level draws.
+    void set_number_of_threads(int n) { pool_.set_number_of_threads(n); }
+
    private:
     // Check that a posterior sampler has been assigned to
     // *data_model.  If not, assign one.
     void ensure_posterior_sampling_method(ZeroInflatedGammaModel *data_model);
 
+    // Draw the parameters for groups [begin, end), accumulating them in the
+    // sufficient statistics for shard 'shard'.
+    void draw_groups(int begin, int end, int shard);
+
     HierarchicalZeroInflatedGammaModel *model_;
     Ptr<DoubleModel> gamma_mean_mean_prior_;
     Ptr<DoubleModel> gamma_mean_shape_prior_;
@@ -96,6 +109,13 @@ namespace BOOM {
     // Responsible for drawing positive_probability_mean and
     // positive_probability_sample_size.
     Ptr<BetaPosteriorSampler> positive_probability_prior_sampler_;
+
+    // Per-shard sufficient statistics for the three priors, combined in
+    // shard order.
+    std::vector<Ptr<BetaSuf>> shard_positive_probability_suf_;
+    std::vector<Ptr<GammaSuf>> shard_mean_suf_;
+    std::vector<Ptr<GammaSuf>> shard_shape_suf_;
+    SharedThreadPool pool_;
   };
 
 }  // namespace BOOM
@@ -18,10 +18,16 @@
 */
 
 #include "Models/Hierarchical/PosteriorSamplers/HierarchicalZeroInflatedPoissonSampler.hpp"
+#include <algorithm>
 #include "cpputil/math_utils.hpp"
 
 namespace BOOM {
 
+  namespace {
+    // The number of groups in each shard of the group level draws.
+    const int group_shard_size = 256;
+  }  // namespace
+
   typedef HierarchicalZeroInflatedPoissonSampler HZIPS;
 
   HZIPS::HierarchicalZeroInflatedPoissonSampler(
@@ -47,12 +53,40 @@ namespace BOOM {
 
   //----------------------------------------------------------------------
   void HierarchicalZeroInflatedPoissonSampler::draw() {
+    ensure_data_model_samplers();
+    int ngroups = model_->number_of_groups();
+    int nshards = (ngroups + group_shard_size - 1) / group_shard_size;
+    while (shard_lambda_suf_.size() < nshards) {
+      shard_lambda_suf_.push_back(new GammaSuf);
+      shard_zero_probability_suf_.push_back(new BetaSuf);
+    }
+    pool_.parallel_for(0, nshards, 1, [&](int shard) {
+      int begin = shard * group_shard_size;
+      int end = std::min<int>(begin + group_shard_size, ngroups);
+      shard_lambda_suf_[shard]->clear();
+      shard_zero_probability_suf_[shard]->clear();
+      draw_groups(begin, end, *shard_lambda_suf_[shard],
+                  *shard_zero_probability_suf_[shard]);
+    });
+
     GammaModel *lambda_prior = model_->prior_for_poisson_mean();
     lambda_prior->clear_data();
-
     BetaModel *zero_probability_prior = model_->prior_for_zero_probability();
     zero_probability_prior->clear_data();
+    for (int shard = 0; shard < nshards; ++shard) {
+      lambda_prior->suf()->combine(*shard_lambda_suf_[shard]);
+      zero_probability_prior->suf()->combine(
+          *shard_zero_probability_suf_[shard]);
+    }
 
+    lambda_prior_sampler_.draw();
+    zero_probability_prior_sampler_.draw();
+  }
+
+  //----------------------------------------------------------------------
+  void HZIPS::ensure_data_model_samplers() {
+    GammaModel *lambda_prior = model_->prior_for_poisson_mean();
+    BetaModel *zero_probability_prior = model_->prior_for_zero_probability();
     for (int i = 0; i < model_->number_of_groups(); ++i) {
       ZeroInflatedPoissonModel *data_level_model = model_->data_model(i);
       if (data_level_model->number_of_sampling_methods() == 0) {
@@ -60,12 +94,20 @@ namespace BOOM {
         (data_level_model, lambda_prior, zero_probability_prior, rng());
         data_level_model->set_method(sampler);
       }
+    }
+  }
+
+  //----------------------------------------------------------------------
+  void HZIPS::draw_groups(int begin, int end, GammaSuf &lambda_suf,
+                          BetaSuf &zero_probability_suf) {
+    for (int i = begin; i < end; ++i) {
+      ZeroInflatedPoissonModel *data_level_model = model_->data_model(i);
       data_level_model->sample_posterior();
       double lambda = data_level_model->lambda();
       if (lambda <= 0.0) {
         report_error("Data level model had zero value for lambda.");
       }
-      lambda_prior->suf()->update_raw(lambda);
+      lambda_suf.update_raw(lambda);
 
       double zero_probability = data_level_model->zero_probability();
       if (zero_probability <= 0.0) {
@@ -73,12 +115,8 @@ namespace BOOM {
       } else if (zero_probability >= 1.0) {
         report_error("data_level_model had a zero_probability of 1.0");
       }
-      zero_probability_prior->suf()->update_raw(
-          data_level_model->zero_probability());
+      zero_probability_suf.update_raw(zero_probability);
     }
-
-    lambda_prior_sampler_.draw();
-    zero_probability_prior_sampler_.draw();
   }
 
   //----------------------------------------------------------------------
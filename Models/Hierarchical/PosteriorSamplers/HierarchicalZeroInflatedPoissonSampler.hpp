@@ -27,6 +27,7 @@
 #include "Models/PosteriorSamplers/PosteriorSampler.hpp"
 #include "Models/PosteriorSamplers/ZeroInflatedPoissonSampler.hpp"
 #include "Samplers/ScalarSliceSampler.hpp"
+#include "cpputil/ThreadTools.hpp"
 
 namespace BOOM {
 
@@ -40,10 +41,25 @@ namespace BOOM {
         const Ptr<DoubleModel> &zero_probability_sample_size_prior,
         RNG &seeding_rng = GlobalRng::rng);
 
+    // The group level parameters are drawn in fixed-size shards of
+    // conditionally independent groups, in parallel if threads have been
+    // allotted.  Each group has its own sampler and random number stream, so
+    // the draws do not depend on the number of threads.
     void draw() override;
     double logpri() const override;
 
+    // Set the number of threads to use for the group level draws.
+    void set_number_of_threads(int n) { pool_.set_number_of_threads(n); }
+
    private:
+    // Assign a ZeroInflatedPoissonSampler to any data model that lacks one.
+    void ensure_data_model_samplers();
+
+    // Draw the parameters for groups [begin, end), accumulating the draws
+    // in the given sufficient statistics.
+    void draw_groups(int begin, int end, GammaSuf &lambda_suf,
+                     BetaSuf &zero_probability_suf);
+
     HierarchicalZeroInflatedPoissonModel *model_;
     Ptr<DoubleModel> lambda_mean_prior_;
     Ptr<DoubleModel> lambda_sample_size_prior_;
@@ -52,6 +68,12 @@ namespace BOOM {
 
     GammaPosteriorSamplerBeta lambda_prior_sampler_;
     BetaPosteriorSampler zero_probability_prior_sampler_;
+
+    // Per-shard sufficient statistics for the two priors, combined in shard
+    // order.
+    std::vector<Ptr<GammaSuf>> shard_lambda_suf_;
+    std::vector<Ptr<BetaSuf>> shard_zero_probability_suf_;
+    SharedThreadPool pool_;
   };
 
 }  // namespace BOOM
@@ -0,0 +1,178 @@
+#include "gtest/gtest.h"
+#include "Models/ChisqModel.hpp"
+#include "Models/GammaModel.hpp"
+#include "Models/GaussianModel.hpp"
+#include "Models/Hierarchical/FlatHierarchicalDirichletModel.hpp"
+#include "Models/Hierarchical/FlatHierarchicalGaussianModel.hpp"
+#include "Models/Hierarchical/FlatHierarchicalPoissonModel.hpp"
+#include "Models/Hierarchical/HierarchicalPoissonModel.hpp"
+#include "Models/Hierarchical/PosteriorSamplers/FlatHierarchicalDirichletSampler.hpp"
+#include "Models/Hierarchical/PosteriorSamplers/FlatHierarchicalGaussianSampler.hpp"
+#include "Models/Hierarchical/PosteriorSamplers/FlatHierarchicalPoissonSampler.hpp"
+#include "Models/Hierarchical/PosteriorSamplers/HierarchicalPoissonSampler.hpp"
+#include "Models/PosteriorSamplers/GaussianMeanSampler.hpp"
+#include "Models/PosteriorSamplers/GaussianVarSampler.hpp"
+#include "distributions.hpp"
+#include "test_utils/test_utils.hpp"
+
+namespace {
+  using namespace BOOM;
+  using std::endl;
+  using std::cout;
+
+  class FlatHierarchicalTest : public ::testing::Test {
+   protected:
+    FlatHierarchicalTest() {
+      GlobalRng::rng.seed(8675309);
+    }
+  };
+
+  Ptr<FlatHierarchicalPoissonModel> flat_poisson_model(
+      const std::vector<Ptr<HierarchicalPoissonData>> &data, int nthreads,
+      RNG &seeding_rng) {
+    NEW(FlatHierarchicalPoissonModel, model)(1.0, 1.0);
+    model->reserve(data.size());
+    for (const auto &dp : data) {
+      model->add_data(dp);
+    }
+    NEW(FlatHierarchicalPoissonSampler, sampler)(
+        model.get(), new GammaModel(1.0, 1.0), new GammaModel(1.0, 1.0),
+        seeding_rng);
+    sampler->set_number_of_threads(nthreads);
+    model->set_method(sampler);
+    return model;
+  }
+
+  // The flat model is reproducible across thread counts, and its posterior
+  // agrees with the one from the HierarchicalPoissonModel.
+  TEST_F(FlatHierarchicalTest, PoissonMatchesHierarchicalModel) {
+    int ngroups = 3000;
+    double prior_mean = 3.0;
+    std::vector<Ptr<HierarchicalPoissonData>> data;
+    for (int i = 0; i < ngroups; ++i) {
+      double lambda = rgamma(10.0, 10.0 / prior_mean);
+      double exposure = 1 + random_int(0, 5);
+      data.push_back(
+          new HierarchicalPoissonData(rpois(lambda * exposure), exposure));
+    }
+
+    RNG serial_seed(12345);
+    RNG threaded_seed(12345);
+    Ptr<FlatHierarchicalPoissonModel> serial =
+        flat_poisson_model(data, 0, serial_seed);
+    Ptr<FlatHierarchicalPoissonModel> threaded =
+        flat_poisson_model(data, 3, threaded_seed);
+    EXPECT_EQ(ngroups, serial->number_of_groups());
+
+    NEW(HierarchicalPoissonModel, full)(1.0, 1.0);
+    for (const auto &dp : data) {
+      full->add_data(dp);
+    }
+    NEW(HierarchicalPoissonSampler, full_sampler)(
+        full.get(), new GammaModel(1.0, 1.0), new GammaModel(1.0, 1.0));
+    full->set_method(full_sampler);
+
+    int niter = 400;
+    int burn = 100;
+    double flat_mean = 0, full_mean = 0;
+    double flat_sample_size = 0, full_sample_size = 0;
+    for (int iteration = 0; iteration < niter; ++iteration) {
+      serial->sample_posterior();
+      threaded->sample_posterior();
+      full->sample_posterior();
+      if (iteration >= burn) {
+        flat_mean += serial->prior_mean();
+        full_mean += full->prior_mean();
+        flat_sample_size += serial->prior_sample_size();
+        full_sample_size += full->prior_sample_size();
+      }
+    }
+    EXPECT_TRUE(VectorEquals(serial->lambda(), threaded->lambda()));
+    EXPECT_DOUBLE_EQ(serial->prior_mean(), threaded->prior_mean());
+
+    flat_mean /= niter - burn;
+    full_mean /= niter - burn;
+    flat_sample_size /= niter - burn;
+    full_sample_size /= niter - burn;
+    EXPECT_NEAR(prior_mean, flat_mean, .1);
+    EXPECT_NEAR(full_mean, flat_mean, .1);
+    EXPECT_NEAR(full_sample_size, flat_sample_size, .2 * full_sample_size);
+  }
+
+  TEST_F(FlatHierarchicalTest, GaussianRecoversParameters) {
+    int ngroups = 2000;
+    double mu0 = 2.0;
+    double tau = 0.5;
+    double sigma = 1.5;
+    NEW(GaussianModel, prior)(0.0, 1.0);
+    NEW(GaussianMeanSampler, prior_mean_sampler)(prior.get(), 0.0, 10.0);
+    NEW(GaussianVarSampler, prior_variance_sampler)(
+        prior.get(), new ChisqModel(1.0, 1.0));
+    prior->set_method(prior_mean_sampler);
+    prior->set_method(prior_variance_sampler);
+    NEW(FlatHierarchicalGaussianModel, model)(prior);
+    Vector true_means(ngroups);
+    for (int i = 0; i < ngroups; ++i) {
+      true_means[i] = rnorm(mu0, tau);
+      GaussianSuf suf;
+      int n = 1 + random_int(0, 4);
+      for (int j = 0; j < n; ++j) {
+        suf.update_raw(rnorm(true_means[i], sigma));
+      }
+      model->add_group(suf);
+    }
+    NEW(FlatHierarchicalGaussianSampler, sampler)(
+        model.get(), new ChisqModel(1.0, 1.0));
+    sampler->set_number_of_threads(2);
+    model->set_method(sampler);
+
+    double mu_draws = 0, sigma_draws = 0, tau_draws = 0;
+    int niter = 500;
+    int burn = 100;
+    for (int iteration = 0; iteration < niter; ++iteration) {
+      model->sample_posterior();
+      if (iteration >= burn) {
+        mu_draws += model->prior()->mu();
+        tau_draws += model->prior()->sigma();
+        sigma_draws += model->residual_sd();
+      }
+    }
+    EXPECT_NEAR(mu0, mu_draws / (niter - burn), .1);
+    EXPECT_NEAR(tau, tau_draws / (niter - burn), .15);
+    EXPECT_NEAR(sigma, sigma_draws / (niter - burn), .1);
+  }
+
+  TEST_F(FlatHierarchicalTest, DirichletRecoversMean) {
+    int ngroups = 1000;
+    Vector pi = {.5, .3, .2};
+    double sample_size = 20;
+    NEW(FlatHierarchicalDirichletModel, model)(
+        new DirichletModel(Vector(3, 1.0)));
+    for (int i = 0; i < ngroups; ++i) {
+      Vector probs = rdirichlet(pi * sample_size);
+      std::vector<int> counts = rmultinom(10, probs);
+      model->add_group(Vector(counts.begin(), counts.end()));
+    }
+    EXPECT_EQ(ngroups, model->number_of_groups());
+    EXPECT_EQ(3, model->dim());
+
+    NEW(FlatHierarchicalDirichletSampler, sampler)(
+        model.get(), new DirichletModel(Vector(3, 1.0)),
+        new GammaModel(1.0, .05));
+    sampler->set_number_of_threads(3);
+    model->set_method(sampler);
+    Vector mean_draws(3, 0.0);
+    int niter = 300;
+    int burn = 100;
+    for (int iteration = 0; iteration < niter; ++iteration) {
+      model->sample_posterior();
+      EXPECT_NEAR(1.0, sum(model->probabilities(0)), 1e-8);
+      if (iteration >= burn) {
+        mean_draws += model->prior_model()->pi();
+      }
+    }
+    mean_draws /= niter - burn;
+    EXPECT_TRUE(VectorEquals(pi, mean_draws, .03)) << mean_draws;
+  }
+
+}  // namespace
@@ -0,0 +1,131 @@
+#include "gtest/gtest.h"
+#include "Models/ChisqModel.hpp"
+#include "Models/GammaModel.hpp"
+#include "Models/Hierarchical/HierarchicalGaussianRegressionModel.hpp"
+#include "Models/Hierarchical/HierarchicalPoissonModel.hpp"
+#include "Models/Hierarchical/PosteriorSamplers/HierarchicalGaussianRegressionSampler.hpp"
+#include "Models/Hierarchical/PosteriorSamplers/HierarchicalPoissonSampler.hpp"
+#include "Models/PosteriorSamplers/MvnConjSampler.hpp"
+#include "distributions.hpp"
+#include "test_utils/test_utils.hpp"
+
+namespace {
+  using namespace BOOM;
+  using std::endl;
+  using std::cout;
+
+  class HierarchicalSamplerTest : public ::testing::Test {
+   protected:
+    HierarchicalSamplerTest() {
+      GlobalRng::rng.seed(8675309);
+    }
+  };
+
+  Ptr<HierarchicalPoissonModel> poisson_model(
+      const std::vector<Ptr<HierarchicalPoissonData>> &data, int nthreads,
+      RNG &seeding_rng) {
+    NEW(HierarchicalPoissonModel, model)(1.0, 1.0);
+    for (const auto &dp : data) {
+      model->add_data(dp);
+    }
+    NEW(HierarchicalPoissonSampler, sampler)(
+        model.get(), new GammaModel(1.0, 1.0), new GammaModel(1.0, 1.0),
+        seeding_rng);
+    sampler->set_number_of_threads(nthreads);
+    model->set_method(sampler);
+    return model;
+  }
+
+  // The group level draws are sharded, so the threaded sampler reproduces
+  // the serial one exactly.
+  TEST_F(HierarchicalSamplerTest, PoissonThreadsMatchSerial) {
+    int ngroups = 700;
+    double prior_mean = 3.0;
+    std::vector<Ptr<HierarchicalPoissonData>> data;
+    for (int i = 0; i < ngroups; ++i) {
+      double lambda = rgamma(10.0, 10.0 / prior_mean);
+      double exposure = 20;
+      data.push_back(
+          new HierarchicalPoissonData(rpois(lambda * exposure), exposure));
+    }
+
+    RNG serial_seed(12345);
+    RNG threaded_seed(12345);
+    Ptr<HierarchicalPoissonModel> serial = poisson_model(data, 0, serial_seed);
+    Ptr<HierarchicalPoissonModel> threaded =
+        poisson_model(data, 3, threaded_seed);
+    for (int iteration = 0; iteration < 20; ++iteration) {
+      serial->sample_posterior();
+      threaded->sample_posterior();
+    }
+    double total = 0;
+    for (int i = 0; i < ngroups; ++i) {
+      EXPECT_DOUBLE_EQ(serial->data_model(i)->lam(),
+                       threaded->data_model(i)->lam());
+      total += serial->data_model(i)->lam();
+    }
+    EXPECT_DOUBLE_EQ(serial->prior_mean(), threaded->prior_mean());
+    EXPECT_DOUBLE_EQ(serial->prior_sample_size(),
+                     threaded->prior_sample_size());
+    EXPECT_NEAR(prior_mean, total / ngroups, .15);
+  }
+
+  Ptr<HierarchicalGaussianRegressionModel> regression_model(
+      const std::vector<Ptr<RegSuf>> &data, int nthreads, RNG &seeding_rng) {
+    int xdim = data[0]->size();
+    NEW(MvnModel, prior)(xdim);
+    NEW(MvnConjSampler, prior_sampler)(
+        prior.get(), Vector(xdim, 0.0), 1.0, SpdMatrix(xdim, 1.0), xdim + 1,
+        seeding_rng);
+    prior->set_method(prior_sampler);
+    NEW(HierarchicalGaussianRegressionModel, model)(prior);
+    for (const auto &suf : data) {
+      model->add_data(Ptr<RegSuf>(suf->clone()));
+    }
+    NEW(HierarchicalGaussianRegressionSampler, sampler)(
+        model.get(), new ChisqModel(1.0, 1.0), seeding_rng);
+    sampler->set_number_of_threads(nthreads);
+    model->set_method(sampler);
+    return model;
+  }
+
+  TEST_F(HierarchicalSamplerTest, GaussianRegressionThreadsMatchSerial) {
+    int ngroups = 150;
+    int sample_size = 20;
+    Vector prior_mean = {1.0, -2.0};
+    double residual_sd = 0.5;
+    std::vector<Ptr<RegSuf>> data;
+    for (int g = 0; g < ngroups; ++g) {
+      Vector beta = prior_mean;
+      for (auto &b : beta) b += rnorm(0, .3);
+      Matrix X(sample_size, 2);
+      X.randomize();
+      X.col(0) = 1.0;
+      Vector y = X * beta;
+      for (auto &yi : y) yi += rnorm(0, residual_sd);
+      data.push_back(new NeRegSuf(X, y));
+    }
+
+    RNG serial_seed(12345);
+    RNG threaded_seed(12345);
+    Ptr<HierarchicalGaussianRegressionModel> serial =
+        regression_model(data, 0, serial_seed);
+    Ptr<HierarchicalGaussianRegressionModel> threaded =
+        regression_model(data, 4, threaded_seed);
+    for (int iteration = 0; iteration < 20; ++iteration) {
+      serial->sample_posterior();
+      threaded->sample_posterior();
+    }
+    for (int g = 0; g < ngroups; ++g) {
+      EXPECT_TRUE(VectorEquals(serial->data_model(g)->Beta(),
+                               threaded->data_model(g)->Beta()));
+    }
+    EXPECT_TRUE(VectorEquals(serial->prior()->mu(), threaded->prior()->mu()));
+    EXPECT_DOUBLE_EQ(serial->residual_variance(),
+                     threaded->residual_variance());
+    EXPECT_NEAR(residual_sd, sqrt(serial->residual_variance()), .05);
+    EXPECT_TRUE(VectorEquals(prior_mean, serial->prior()->mu(), .15))
+        << serial->prior()->mu();
+  }
+
+}  // namespace
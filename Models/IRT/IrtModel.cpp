@@ -59,7 +59,8 @@ namespace BOOM {
           theta_suppressed(false),
           subject_subset(0),
           subject_search_helper(new Subject("", 1)),
-          item_search_helper(new NullItem) {
+          item_search_helper(new NullItem),
+          response_index_current_(false) {
       set_default_names(subscale_names_);
     }
 
@@ -74,7 +75,8 @@ namespace BOOM {
           theta_suppressed(false),
           subject_subset(0),
           subject_search_helper(new Subject("", 1)),
-          item_search_helper(new NullItem) {
+          item_search_helper(new NullItem),
+          response_index_current_(false) {
       set_default_names(subscale_names_);
     }
 
@@ -88,7 +90,8 @@ namespace BOOM {
           theta_suppressed(false),
           subject_subset(0),
           subject_search_helper(new Subject("", 1)),
-          item_search_helper(new NullItem) {}
+          item_search_helper(new NullItem),
+          response_index_current_(false) {}
 
     IrtModel::IrtModel(const IrtModel &rhs)
         : Model(rhs), ParamPolicy(rhs), DataPolicy(rhs), PriorPolicy(rhs) {
@@ -160,6 +163,7 @@ namespace BOOM {
     //------------------------------------------------------------
     void IrtModel::add_item(const Ptr<Item> &item) {
       items.insert(item);
+      response_index_current_ = false;
       ParamPolicy::add_model(item);
     }
 
@@ -187,6 +191,7 @@ namespace BOOM {
     //------------------------------------------------------------
     void IrtModel::add_subject(const Ptr<Subject> &s) {
       BOOM::IRT::add_subject(subjects_, s);
+      response_index_current_ = false;
       DataPolicy::add_data(s);
       if (!!subject_prior_) subject_prior_->add_data(s);
     }
@@ -213,6 +218,23 @@ namespace BOOM {
       return *it;
     }
 
+    //------------------------------------------------------------
+    const ResponseIndex &IrtModel::response_index() const {
+      if (response_index_current_) {
+        Int number_of_responses = 0;
+        for (const auto &subject : subjects_) {
+          number_of_responses += subject->Nitems();
+        }
+        response_index_current_ =
+            number_of_responses == response_index_.number_of_responses();
+      }
+      if (!response_index_current_) {
+        response_index_.build(subjects_, items);
+        response_index_current_ = true;
+      }
+      return response_index_;
+    }
+
     //------------------------------------------------------------
     void IrtModel::set_subject_prior(const Ptr<MvnModel> &p) {
       subject_prior_ = new MvnSubjectPrior(p);
@@ -20,6 +20,7 @@
 #define IRT_MODEL_HPP
 
 #include "Models/IRT/IRT.hpp"
+#include "Models/IRT/ResponseIndex.hpp"
 #include "Models/ModelTypes.hpp"
 #include "Models/Policies/CompositeParamPolicy.hpp"
 #include "Models/Policies/IID_DataPolicy.hpp"
@@ -71,6 +72,14 @@ namespace BOOM {
       CSI subject_end() const;
       Ptr<Subject> find_subject(const std::string &id, bool nag = true) const;
 
+      // An integer indexed copy of the subject by item response matrix.  The
+      // index is rebuilt on demand if subjects, items, or responses have been
+      // added since it was last built.  Responses are normally added through
+      // Subject::add_item, which the model does not see, so staleness is
+      // detected by counting responses.  Changing the value of an existing
+      // response without adding one is not detected.
+      const ResponseIndex &response_index() const;
+
       void set_subject_prior(const Ptr<MvnModel> &);
       void set_subject_prior(const Ptr<MvRegModel> &);
       void set_subject_prior(const Ptr<SubjectPrior> &);
@@ -95,6 +104,9 @@ namespace BOOM {
       mutable Ptr<Subject> subject_search_helper;
       mutable Ptr<Item> item_search_helper;
 
+      mutable ResponseIndex response_index_;
+      mutable bool response_index_current_;
+
       void allocate_subjects();
       // helper function for set_subject_prior
     };
@@ -20,9 +20,11 @@
 #include "Models/IRT/Subject.hpp"
 #include "Models/PosteriorSamplers/PosteriorSampler.hpp"
 #include "cpputil/lse.hpp"
+#include "cpputil/math_utils.hpp"
 #include "cpputil/report_error.hpp"
 #include "cpputil/seq.hpp"
 
+#include <algorithm>
 #include <functional>
 #include <stdexcept>
 
@@ -332,10 +334,23 @@ namespace BOOM {
       return response_prob(r->value(), Theta, logsc);
     }
 
+    // eta[m] = beta[m] + (m + 1) * theta * beta[M + 1] is computed in place,
+    // rather than through the eta_ and X_ workspaces, so that once beta is
+    // current several threads can evaluate the same item at once.
     double PCR::response_prob(uint r, const Vector &Theta, bool logsc) const {
-      fill_eta(Theta);
-      double lognc = lse(eta_);
-      double ans = eta_[r] - lognc;
+      if (!beta_current) fill_beta();
+      const Vector &beta(beta_->value());
+      uint M = maxscore();
+      double slope = Theta[which_subscale()] * beta[M + 1];
+      double max_eta = negative_infinity();
+      for (uint m = 0; m <= M; ++m) {
+        max_eta = std::max(max_eta, beta[m] + (m + 1) * slope);
+      }
+      double total = 0;
+      for (uint m = 0; m <= M; ++m) {
+        total += exp(beta[m] + (m + 1) * slope - max_eta);
+      }
+      double ans = beta[r] + (r + 1) * slope - max_eta - log(total);
       return logsc ? ans : exp(ans);
     }
 
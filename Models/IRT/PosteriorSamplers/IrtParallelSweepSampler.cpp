@@ -0,0 +1,134 @@
+/*
+  Copyright (C) 2005-2024 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include "Models/IRT/PosteriorSamplers/IrtParallelSweepSampler.hpp"
+#include <algorithm>
+#include "Models/IRT/Item.hpp"
+#include "Models/IRT/Subject.hpp"
+#include "Models/IRT/SubjectPrior.hpp"
+#include "Samplers/ScalarSliceSampler.hpp"
+#include "cpputil/report_error.hpp"
+
+namespace BOOM {
+  namespace IRT {
+
+    namespace {
+      // The number of subjects in each shard of the subject phase.
+      const Int subject_shard_size = 1024;
+    }  // namespace
+
+    IrtParallelSweepSampler::IrtParallelSweepSampler(IrtModel *model,
+                                                     RNG &seeding_rng)
+        : PosteriorSampler(seeding_rng),
+          model_(model) {}
+
+    double IrtParallelSweepSampler::logpri() const {
+      double ans = 0;
+      for (auto it = model_->item_begin(); it != model_->item_end(); ++it) {
+        ans += (*it)->logpri();
+      }
+      Ptr<SubjectPrior> prior = model_->subject_prior();
+      if (!!prior) ans += prior->logpri();
+      return ans;
+    }
+
+    void IrtParallelSweepSampler::draw() {
+      draw_subjects();
+      draw_items();
+      Ptr<SubjectPrior> prior = model_->subject_prior();
+      if (prior->number_of_sampling_methods() > 0) {
+        prior->sample_posterior();
+      }
+    }
+
+    void IrtParallelSweepSampler::draw_subjects() {
+      Ptr<SubjectPrior> prior = model_->subject_prior();
+      if (!prior) {
+        report_error("IrtParallelSweepSampler needs a subject prior.  "
+                     "Call set_subject_prior on the IrtModel.");
+      }
+      const ResponseIndex &index(model_->response_index());
+
+      // Bring each item's parameterization up to date in this thread, so
+      // that the parallel calls to response_prob only read it.
+      for (Int j = 0; j < index.number_of_items(); ++j) {
+        index.item(j)->beta();
+      }
+
+      Int nsubjects = index.number_of_subjects();
+      theta_draws_.resize(nsubjects, model_->nscales());
+      SpdMatrix siginv = prior->siginv();
+      RNG::RngIntType seed = seed_rng(rng());
+      int nshards = (nsubjects + subject_shard_size - 1) / subject_shard_size;
+      pool_.parallel_for(0, nshards, 1, [&](int shard) {
+        RNG shard_rng(seed, shard);
+        Int begin = shard * subject_shard_size;
+        Int end = std::min<Int>(begin + subject_shard_size, nsubjects);
+        draw_subject_range(index, *prior, begin, end, siginv, shard_rng);
+      });
+
+      for (Int i = 0; i < nsubjects; ++i) {
+        index.subject(i)->set_Theta(Vector(theta_draws_.row(i)));
+      }
+    }
+
+    void IrtParallelSweepSampler::draw_subject_range(
+        const ResponseIndex &index, const SubjectPrior &prior, Int begin,
+        Int end, const SpdMatrix &siginv, RNG &rng) {
+      const std::vector<Int> &items(index.subject_items());
+      const std::vector<int> &responses(index.subject_responses());
+      Vector theta;
+      Vector mu;
+      for (Int i = begin; i < end; ++i) {
+        const Ptr<Subject> &subject(index.subject(i));
+        theta = subject->Theta();
+        mu = prior.mean(subject);
+        Int first = index.subject_begin(i);
+        Int last = index.subject_end(i);
+        auto log_posterior = [&]() {
+          double ans = -.5 * siginv.Mdist(theta, mu);
+          for (Int e = first; e < last; ++e) {
+            ans += index.item(items[e])->response_prob(
+                static_cast<uint>(responses[e]), theta, true);
+          }
+          return ans;
+        };
+        for (int k = 0; k < theta.size(); ++k) {
+          ScalarSliceSampler slice(
+              [&](double x) {
+                theta[k] = x;
+                return log_posterior();
+              },
+              false, 1.0, &rng);
+          theta[k] = slice.draw(theta[k]);
+        }
+        theta_draws_.row(i) = theta;
+      }
+    }
+
+    void IrtParallelSweepSampler::draw_items() {
+      std::vector<Ptr<Item>> items(model_->item_begin(), model_->item_end());
+      pool_.parallel_for(0, items.size(), 1, [&](int j) {
+        if (items[j]->number_of_sampling_methods() > 0) {
+          items[j]->sample_posterior();
+        }
+      });
+    }
+
+  }  // namespace IRT
+}  // namespace BOOM
@@ -0,0 +1,85 @@
+/*
+  Copyright (C) 2005-2024 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+#ifndef BOOM_IRT_PARALLEL_SWEEP_SAMPLER_HPP_
+#define BOOM_IRT_PARALLEL_SWEEP_SAMPLER_HPP_
+
+#include "Models/IRT/IrtModel.hpp"
+#include "Models/PosteriorSamplers/PosteriorSampler.hpp"
+#include "cpputil/ThreadTools.hpp"
+#include "LinAlg/Matrix.hpp"
+#include "LinAlg/SpdMatrix.hpp"
+
+namespace BOOM {
+  namespace IRT {
+
+    // A posterior sampler for an IrtModel that alternates between all the
+    // subjects and all the items.  Subjects are conditionally independent
+    // given the items, and items given the subjects, so each half of the
+    // sweep can be done in parallel.
+    //
+    // Subject phase: each subject's Theta is drawn by coordinate-wise slice
+    // sampling from its full conditional.  The prior is Gaussian with the
+    // mean and precision supplied by the model's SubjectPrior, and the
+    // likelihood is read from the model's response_index(), so no maps are
+    // searched.  Subjects are processed in fixed-size shards, each with its
+    // own random number stream, so the draws do not depend on the number of
+    // threads.  The new values are stored, and copied into the subjects after
+    // the parallel phase, so observers of the subjects' parameters are
+    // notified from a single thread.
+    //
+    // Item phase: each item is updated by its own posterior sampler(s) (e.g.
+    // DafePcrItemSampler), in parallel across items.  Items without sampling
+    // methods are left alone.
+    //
+    // Finally the subject prior is updated by its own sampling methods, if it
+    // has any.
+    //
+    // Thread safety requires that Item::response_prob can be called from
+    // several threads at once for a fixed item, as PartialCreditModel's can,
+    // and that each item's sampler touches only its own item.
+    class IrtParallelSweepSampler : public PosteriorSampler {
+     public:
+      explicit IrtParallelSweepSampler(IrtModel *model,
+                                       RNG &seeding_rng = GlobalRng::rng);
+
+      double logpri() const override;
+      void draw() override;
+
+      void draw_subjects();
+      void draw_items();
+
+      // Set the number of threads used by draw_subjects() and draw_items().
+      // The default of zero does all the work in the calling thread.
+      void set_number_of_threads(int n) { pool_.set_number_of_threads(n); }
+
+     private:
+      // Draw Theta for subjects [begin, end) of the response index, storing
+      // the draws in the corresponding rows of theta_draws_.
+      void draw_subject_range(const ResponseIndex &index,
+                              const SubjectPrior &prior, Int begin, Int end,
+                              const SpdMatrix &siginv, RNG &rng);
+
+      IrtModel *model_;
+      Matrix theta_draws_;
+      SharedThreadPool pool_;
+    };
+
+  }  // namespace IRT
+}  // namespace BOOM
+
+#endif  // BOOM_IRT_PARALLEL_SWEEP_SAMPLER_HPP_
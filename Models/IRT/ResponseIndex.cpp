@@ -0,0 +1,86 @@
+/*
+  Copyright (C) 2005-2024 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include "Models/IRT/ResponseIndex.hpp"
+#include <sstream>
+#include <unordered_map>
+#include "Models/IRT/Item.hpp"
+#include "Models/IRT/Subject.hpp"
+#include "cpputil/report_error.hpp"
+
+namespace BOOM {
+  namespace IRT {
+
+    ResponseIndex::ResponseIndex()
+        : subject_offsets_(1, 0), item_offsets_(1, 0) {}
+
+    void ResponseIndex::build(const SubjectSet &subjects,
+                              const ItemSet &items) {
+      items_.assign(items.begin(), items.end());
+      std::unordered_map<const Item *, Int> item_index;
+      item_index.reserve(items_.size());
+      for (Int j = 0; j < items_.size(); ++j) {
+        item_index[items_[j].get()] = j;
+      }
+
+      // Each subject's ItemResponseMap is sorted by item ID, which is the
+      // order of the model's ItemSet, so the item indices within a row come
+      // out sorted.
+      subjects_.assign(subjects.begin(), subjects.end());
+      subject_offsets_.assign(1, 0);
+      subject_offsets_.reserve(subjects_.size() + 1);
+      subject_items_.clear();
+      subject_responses_.clear();
+      for (const auto &subject : subjects_) {
+        for (const auto &it : subject->item_responses()) {
+          auto position = item_index.find(it.first.get());
+          if (position == item_index.end()) {
+            std::ostringstream err;
+            err << "Subject " << subject->id() << " responded to item "
+                << it.first->id() << ", which is not part of the model.";
+            report_error(err.str());
+          }
+          subject_items_.push_back(position->second);
+          subject_responses_.push_back(it.second->value());
+        }
+        subject_offsets_.push_back(subject_items_.size());
+      }
+
+      // Transpose the row storage into column storage with a counting sort.
+      // Subjects are processed in order, so each item's subjects are sorted.
+      item_offsets_.assign(items_.size() + 1, 0);
+      for (Int item : subject_items_) {
+        ++item_offsets_[item + 1];
+      }
+      for (Int j = 0; j < items_.size(); ++j) {
+        item_offsets_[j + 1] += item_offsets_[j];
+      }
+      item_subjects_.resize(subject_items_.size());
+      item_responses_.resize(subject_items_.size());
+      std::vector<Int> position(item_offsets_.begin(), item_offsets_.end() - 1);
+      for (Int i = 0; i < subjects_.size(); ++i) {
+        for (Int e = subject_begin(i); e < subject_end(i); ++e) {
+          Int destination = position[subject_items_[e]]++;
+          item_subjects_[destination] = i;
+          item_responses_[destination] = subject_responses_[e];
+        }
+      }
+    }
+
+  }  // namespace IRT
+}  // namespace BOOM
@@ -0,0 +1,92 @@
+/*
+  Copyright (C) 2005-2024 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+#ifndef BOOM_IRT_RESPONSE_INDEX_HPP_
+#define BOOM_IRT_RESPONSE_INDEX_HPP_
+
+#include <vector>
+#include "Models/IRT/IRT.hpp"
+#include "uint.hpp"
+
+namespace BOOM {
+  namespace IRT {
+
+    // A compressed, integer indexed copy of the subject by item response
+    // matrix held by an IrtModel.  Subjects and items are numbered 0, 1, ...
+    // in the order of the model's subject and item containers (i.e. sorted by
+    // ID).  The responses are stored twice: in compressed sparse row form,
+    // grouped by subject, and in compressed sparse column form, grouped by
+    // item.  Samplers can then update subjects (or items) with a linear scan
+    // over integer arrays instead of searching each subject's
+    // ItemResponseMap.
+    //
+    // The responses of subject i are entries subject_begin(i), ...,
+    // subject_end(i) - 1 of subject_items() and subject_responses().  The
+    // responses to item j are entries item_begin(j), ..., item_end(j) - 1 of
+    // item_subjects() and item_responses().  Within a subject the entries are
+    // in increasing order of item index, and within an item they are in
+    // increasing order of subject index.
+    class ResponseIndex {
+     public:
+      ResponseIndex();
+
+      // Rebuild the index from the subjects and items in a model.  Every
+      // item that a subject responded to must be in 'items'.
+      void build(const SubjectSet &subjects, const ItemSet &items);
+
+      Int number_of_subjects() const { return subjects_.size(); }
+      Int number_of_items() const { return items_.size(); }
+
+      // The number of (subject, item) responses.
+      Int number_of_responses() const { return subject_items_.size(); }
+
+      const Ptr<Subject> &subject(Int i) const { return subjects_[i]; }
+      const Ptr<Item> &item(Int j) const { return items_[j]; }
+
+      Int subject_begin(Int i) const { return subject_offsets_[i]; }
+      Int subject_end(Int i) const { return subject_offsets_[i + 1]; }
+      const std::vector<Int> &subject_items() const { return subject_items_; }
+      const std::vector<int> &subject_responses() const {
+        return subject_responses_;
+      }
+
+      Int item_begin(Int j) const { return item_offsets_[j]; }
+      Int item_end(Int j) const { return item_offsets_[j + 1]; }
+      const std::vector<Int> &item_subjects() const { return item_subjects_; }
+      const std::vector<int> &item_responses() const {
+        return item_responses_;
+      }
+
+     private:
+      std::vector<Ptr<Subject>> subjects_;
+      std::vector<Ptr<Item>> items_;
+
+      // Compressed sparse row storage, grouped by subject.
+      std::vector<Int> subject_offsets_;
+      std::vector<Int> subject_items_;
+      std::vector<int> subject_responses_;
+
+      // Compressed sparse column storage, grouped by item.
+      std::vector<Int> item_offsets_;
+      std::vector<Int> item_subjects_;
+      std::vector<int> item_responses_;
+    };
+
+  }  // namespace IRT
+}  // namespace BOOM
+
+#endif  // BOOM_IRT_RESPONSE_INDEX_HPP_
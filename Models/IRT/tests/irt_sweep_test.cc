@@ -0,0 +1,174 @@
+#include "gtest/gtest.h"
+#include "Models/IRT/IrtModel.hpp"
+#include "Models/IRT/PartialCreditModel.hpp"
+#include "Models/IRT/Subject.hpp"
+#include "Models/IRT/PosteriorSamplers/IrtParallelSweepSampler.hpp"
+#include "Models/MvnModel.hpp"
+#include "distributions.hpp"
+#include "stats/moments.hpp"
+#include "cpputil/lse.hpp"
+
+#include "test_utils/test_utils.hpp"
+#include <string>
+
+namespace {
+  using namespace BOOM;
+  using namespace BOOM::IRT;
+  using std::endl;
+  using std::cout;
+
+  class IrtSweepTest : public ::testing::Test {
+   protected:
+    IrtSweepTest() {
+      GlobalRng::rng.seed(8675309);
+    }
+  };
+
+  // Simulate a model with one subscale, partial credit items with maximum
+  // score 2, and a random subset of the items answered by each subject.
+  // The subjects' true abilities are returned in 'true_theta'.
+  Ptr<IrtModel> simulate_model(int nsubjects, int nitems, Vector &true_theta) {
+    NEW(IrtModel, model)(1);
+    std::vector<Ptr<PartialCreditModel>> items;
+    for (int j = 0; j < nitems; ++j) {
+      NEW(PartialCreditModel, item)("item" + std::to_string(j), 2, 0, 1,
+                                    runif(.8, 2.0), rnorm(0, 1),
+                                    Vector(3, 0.0));
+      items.push_back(item);
+      model->add_item(item);
+    }
+    true_theta.resize(nsubjects);
+    for (int i = 0; i < nsubjects; ++i) {
+      true_theta[i] = rnorm();
+      NEW(Subject, subject)("subject" + std::to_string(i), 1);
+      subject->set_Theta(Vector(1, true_theta[i]));
+      for (const auto &item : items) {
+        if (runif() < .7) {
+          subject->add_item(item, subject->simulate_response(item));
+          item->add_subject(subject);
+        }
+      }
+      subject->set_Theta(Vector(1, 0.0));
+      model->add_subject(subject);
+    }
+    model->set_subject_prior(new MvnModel(Vector(1, 0.0), SpdMatrix(1, 1.0)));
+    return model;
+  }
+
+  // The row and column storage agree with the subjects' response maps.
+  TEST_F(IrtSweepTest, ResponseIndexMatchesMaps) {
+    Vector true_theta;
+    Ptr<IrtModel> model = simulate_model(200, 8, true_theta);
+    const ResponseIndex &index(model->response_index());
+    ASSERT_EQ(200, index.number_of_subjects());
+    ASSERT_EQ(8, index.number_of_items());
+
+    Int total = 0;
+    for (Int i = 0; i < index.number_of_subjects(); ++i) {
+      const Ptr<Subject> &subject(index.subject(i));
+      ASSERT_EQ(subject->Nitems(),
+                index.subject_end(i) - index.subject_begin(i));
+      for (Int e = index.subject_begin(i); e < index.subject_end(i); ++e) {
+        Response r = subject->response(index.item(index.subject_items()[e]));
+        ASSERT_TRUE(!!r);
+        EXPECT_EQ(r->value(), index.subject_responses()[e]);
+      }
+      total += subject->Nitems();
+    }
+    EXPECT_EQ(total, index.number_of_responses());
+
+    for (Int j = 0; j < index.number_of_items(); ++j) {
+      const Ptr<Item> &item(index.item(j));
+      ASSERT_EQ(item->Nsubjects(), index.item_end(j) - index.item_begin(j));
+      for (Int e = index.item_begin(j); e < index.item_end(j); ++e) {
+        const Ptr<Subject> &subject(index.subject(index.item_subjects()[e]));
+        EXPECT_EQ(subject->response(item)->value(),
+                  index.item_responses()[e]);
+        if (e > index.item_begin(j)) {
+          EXPECT_LT(index.item_subjects()[e - 1], index.item_subjects()[e]);
+        }
+      }
+    }
+
+    // Adding a response to an existing subject is detected.
+    Ptr<Subject> subject = index.subject(0);
+    Ptr<Item> unanswered;
+    for (Int j = 0; j < index.number_of_items(); ++j) {
+      if (!subject->response(index.item(j))) {
+        unanswered = index.item(j);
+      }
+    }
+    if (!!unanswered) {
+      subject->add_item(unanswered, 1u);
+      EXPECT_EQ(total + 1, model->response_index().number_of_responses());
+    }
+  }
+
+  // The in-place response probabilities agree with the ones computed from
+  // the X * beta workspace.
+  TEST_F(IrtSweepTest, ResponseProbMatchesEta) {
+    PartialCreditModel item("item", 3, 0, 1, 1.3, .4,
+                            Vector{0.0, .5, -.2, -.3});
+    Vector theta(1, -.7);
+    Vector eta = item.fill_eta(theta);
+    double lognc = lse(eta);
+    for (int r = 0; r <= 3; ++r) {
+      EXPECT_NEAR(eta[r] - lognc,
+                  item.response_prob(static_cast<BOOM::uint>(r), theta, true),
+                  1e-10);
+    }
+  }
+
+  // The subject draws are sharded, so the threaded sweep reproduces the
+  // serial one exactly.
+  TEST_F(IrtSweepTest, ThreadsMatchSerial) {
+    Vector true_theta;
+    GlobalRng::rng.seed(12345);
+    Ptr<IrtModel> serial = simulate_model(2500, 10, true_theta);
+    GlobalRng::rng.seed(12345);
+    Ptr<IrtModel> threaded = simulate_model(2500, 10, true_theta);
+
+    RNG serial_seed(31);
+    RNG threaded_seed(31);
+    NEW(IrtParallelSweepSampler, serial_sampler)(serial.get(), serial_seed);
+    NEW(IrtParallelSweepSampler, threaded_sampler)(
+        threaded.get(), threaded_seed);
+    threaded_sampler->set_number_of_threads(4);
+    for (int iteration = 0; iteration < 3; ++iteration) {
+      serial_sampler->draw();
+      threaded_sampler->draw();
+    }
+    for (auto s = serial->subject_begin(), t = threaded->subject_begin();
+         s != serial->subject_end(); ++s, ++t) {
+      EXPECT_EQ((*s)->Theta(), (*t)->Theta());
+    }
+  }
+
+  // With the items held at their true values, the subject draws track the
+  // true abilities.
+  TEST_F(IrtSweepTest, RecoversAbilities) {
+    Vector true_theta;
+    Ptr<IrtModel> model = simulate_model(1000, 30, true_theta);
+    NEW(IrtParallelSweepSampler, sampler)(model.get());
+    sampler->set_number_of_threads(2);
+    int niter = 20;
+    Vector theta_sum(1000, 0.0);
+    for (int iteration = 0; iteration < niter; ++iteration) {
+      sampler->draw();
+      int i = 0;
+      for (auto it = model->subject_begin(); it != model->subject_end();
+           ++it) {
+        theta_sum[i++] += (*it)->Theta()[0];
+      }
+    }
+    // Subjects are sorted by ID, which is not the simulation order.
+    Vector posterior_mean(1000);
+    int i = 0;
+    for (auto it = model->subject_begin(); it != model->subject_end(); ++it) {
+      int position = std::stoi((*it)->id().substr(7));
+      posterior_mean[position] = theta_sum[i++] / niter;
+    }
+    EXPECT_GT(cor(posterior_mean, true_theta), .85);
+  }
+
+}  // namespace
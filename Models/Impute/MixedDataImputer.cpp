@@ -16,6 +16,8 @@
   Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
 */
 
+#include <future>
+
 #include "Models/Impute/MixedDataImputer.hpp"
 #include "distributions.hpp"
 #include "cpputil/lse.hpp"
@@ -181,6 +183,16 @@ namespace BOOM {
       return atom_model_->logpi()[category_map(observed)];
     }
 
+    void NumericScalarModel::combine_sufficient_statistics(
+        const ScalarModelBase &other) {
+      atom_model_->suf()->combine(
+          dynamic_cast<const NumericScalarModel &>(other).atom_model_->suf());
+    }
+
+    void NumericScalarModel::copy_parameters(const ScalarModelBase &other) {
+      set_atom_probs(dynamic_cast<const NumericScalarModel &>(other).atom_probs());
+    }
+
     void NumericScalarModel::set_conjugate_prior(const Vector &counts) {
       if (counts.size() != atoms_.size() + 1) {
         std::ostringstream err;
@@ -225,6 +237,10 @@ namespace BOOM {
         return atoms_[true_atom];
       } else if (category_map(observed_value) == atoms_.size()) {
         return observed_value;
+      } else if (true_atom == atoms_.size() && std::isnan(observed_value)) {
+        // A missing value from the continuous component.  It is imputed by
+        // the numeric data model.
+        return observed_value;
       } else {
         std::ostringstream msg;
         msg << "Illegal value: true_atom = " << true_atom
@@ -310,6 +326,18 @@ namespace BOOM {
       model_->suf()->update_raw(observed_level);
     }
 
+    void CategoricalScalarModel::combine_sufficient_statistics(
+        const ScalarModelBase &other) {
+      model_->suf()->combine(
+          dynamic_cast<const CategoricalScalarModel &>(other).model_->suf());
+    }
+
+    void CategoricalScalarModel::copy_parameters(
+        const ScalarModelBase &other) {
+      set_level_probs(
+          dynamic_cast<const CategoricalScalarModel &>(other).level_probs());
+    }
+
     void CategoricalScalarModel::set_conjugate_prior(const Vector &counts) {
       if (counts.size() != levels_->max_levels()) {
         std::ostringstream err;
@@ -382,6 +410,20 @@ namespace BOOM {
         model->sample_posterior();
       }
     }
+
+    void RowModelBase::combine_sufficient_statistics(
+        const RowModelBase &other) {
+      for (size_t i = 0; i < scalar_models_.size(); ++i) {
+        scalar_models_[i]->combine_sufficient_statistics(
+            *other.scalar_models_[i]);
+      }
+    }
+
+    void RowModelBase::copy_parameters(const RowModelBase &other) {
+      for (size_t i = 0; i < scalar_models_.size(); ++i) {
+        scalar_models_[i]->copy_parameters(*other.scalar_models_[i]);
+      }
+    }
     //==========================================================================
     RowModel::RowModel() {}
 
@@ -557,6 +599,10 @@ namespace BOOM {
     set_numeric_data_model_observers();
   }
 
+  MixedDataImputerBase::~MixedDataImputerBase() {
+    shut_down_worker_pool();
+  }
+
   MixedDataImputerBase &MixedDataImputerBase::operator=(
       const MixedDataImputerBase &rhs) {
     if (&rhs != this) {
@@ -594,6 +640,11 @@ namespace BOOM {
 
   void MixedDataImputerBase::impute_data_set(
       std::vector<Ptr<MixedImputation::CompleteData>> &rows) {
+    if (!workers_.empty()) {
+      impute_data_set_multithreaded(rows);
+      return;
+    }
+    DataSignalBatch signal_batch;
     for (auto &el : rows) {
       impute_row(el, rng_, false);
     }
@@ -601,6 +652,9 @@ namespace BOOM {
 
   void MixedDataImputerBase::impute_all_rows() {
     clear_client_data();
+    // Each row sets several imputed values.  Their observers are notified
+    // once, after all the rows have been imputed.
+    DataSignalBatch signal_batch;
     for (size_t i = 0; i < complete_data_.size(); ++i) {
       impute_row(complete_data_[i], rng_, true);
     }
@@ -613,7 +667,11 @@ namespace BOOM {
     for (int i = 0; i < empirical_distributions_.size(); ++i) {
       empirical_distribution(i).update_cdf();
     }
-    impute_all_rows();
+    if (!workers_.empty()) {
+      impute_all_rows_multithreaded();
+    } else {
+      impute_all_rows();
+    }
     mixing_distribution_->sample_posterior();
     for (int s = 0; s < number_of_mixture_components(); ++s) {
       row_model(s)->sample_posterior();
@@ -621,6 +679,118 @@ namespace BOOM {
     numeric_data_model()->sample_posterior();
   }
 
+  //---------------------------------------------------------------------------
+  void MixedDataImputerBase::setup_worker_pool(int nworkers) {
+    shut_down_worker_pool();
+    if (nworkers <= 0) {
+      return;
+    }
+    for (int i = 0; i < nworkers; ++i) {
+      // Workers don't sample their own parameters, so there is no need to set
+      // priors on them.  Each clone seeds its own RNG from rng_.
+      workers_.push_back(clone());
+    }
+    thread_pool_.set_number_of_threads(nworkers);
+  }
+
+  void MixedDataImputerBase::shut_down_worker_pool() {
+    thread_pool_.set_number_of_threads(0);
+    workers_.clear();
+  }
+
+  void MixedDataImputerBase::impute_all_rows_multithreaded() {
+    ensure_data_distribution();
+    broadcast_parameters();
+    std::vector<std::future<void>> futures;
+    for (size_t i = 0; i < workers_.size(); ++i) {
+      MixedDataImputerBase *worker = workers_[i].get();
+      futures.emplace_back(thread_pool_.submit(
+          [worker]() {
+            worker->impute_all_rows();
+          }));
+    }
+    for (size_t i = 0; i < futures.size(); ++i) {
+      futures[i].get();
+    }
+    reduce_sufficient_statistics();
+  }
+
+  void MixedDataImputerBase::impute_data_set_multithreaded(
+      std::vector<Ptr<MixedImputation::CompleteData>> &rows) {
+    broadcast_parameters();
+    size_t rows_per_worker = rows.size() / workers_.size();
+    std::vector<std::vector<Ptr<MixedImputation::CompleteData>>> shards(
+        workers_.size());
+    auto b = rows.begin();
+    for (size_t i = 0; i < workers_.size(); ++i) {
+      auto e = (i + 1 == workers_.size()) ? rows.end() : b + rows_per_worker;
+      shards[i].assign(b, e);
+      b = e;
+    }
+
+    std::vector<std::future<void>> futures;
+    for (size_t i = 0; i < workers_.size(); ++i) {
+      MixedDataImputerBase *worker = workers_[i].get();
+      std::vector<Ptr<MixedImputation::CompleteData>> *shard = &shards[i];
+      futures.emplace_back(thread_pool_.submit(
+          [worker, shard]() {
+            worker->impute_data_set(*shard);
+          }));
+    }
+    for (size_t i = 0; i < futures.size(); ++i) {
+      futures[i].get();
+    }
+  }
+
+  void MixedDataImputerBase::ensure_data_distribution() {
+    size_t nobs = 0;
+    for (size_t i = 0; i < workers_.size(); ++i) {
+      nobs += workers_[i]->complete_data_.size();
+    }
+    if (nobs != complete_data_.size()) {
+      distribute_data_to_workers();
+    }
+  }
+
+  void MixedDataImputerBase::distribute_data_to_workers() {
+    size_t data_per_worker = complete_data_.size() / workers_.size();
+    auto b = complete_data_.begin();
+    for (size_t i = 0; i < workers_.size(); ++i) {
+      auto e = (i + 1 == workers_.size()) ? complete_data_.end()
+          : b + data_per_worker;
+      workers_[i]->complete_data_.assign(b, e);
+      b = e;
+    }
+  }
+
+  // The empirical distributions are copied along with the model parameters
+  // because they can change between calls, e.g. on the first MCMC iteration.
+  void MixedDataImputerBase::broadcast_parameters() {
+    for (size_t i = 0; i < workers_.size(); ++i) {
+      MixedDataImputerBase &worker(*workers_[i]);
+      worker.mixing_distribution_->set_pi(mixing_distribution_->pi());
+      worker.numeric_data_model_->set_Beta(numeric_data_model_->Beta());
+      worker.numeric_data_model_->set_Sigma(numeric_data_model_->Sigma());
+      for (int s = 0; s < number_of_mixture_components(); ++s) {
+        worker.row_model(s)->copy_parameters(*row_model(s));
+      }
+      worker.empirical_distributions_ = empirical_distributions_;
+    }
+  }
+
+  void MixedDataImputerBase::reduce_sufficient_statistics() {
+    clear_client_data();
+    for (size_t i = 0; i < workers_.size(); ++i) {
+      const MixedDataImputerBase &worker(*workers_[i]);
+      mixing_distribution_->suf()->combine(worker.mixing_distribution_->suf());
+      numeric_data_model_->suf()->combine(worker.numeric_data_model_->suf());
+      for (int s = 0; s < number_of_mixture_components(); ++s) {
+        row_model(s)->combine_sufficient_statistics(*worker.row_model(s));
+      }
+    }
+  }
+
+  //---------------------------------------------------------------------------
   Vector MixedDataImputerBase::ybar() const {
     Vector ans(data_types_.number_of_numeric_fields());
     int index = 0;
@@ -749,7 +919,7 @@ namespace BOOM {
     if (!complete_data_.empty()) {
       for (int i = 0; i < table.nvars(); ++i) {
         if (table.variable_type(i) == VariableType::categorical) {
-          NEW(EffectsEncoder, encoder)(i, table.get_nominal(i).key());
+          NEW(EffectsEncoder, encoder)(i, table.categorical_column(i).key());
           encoders_.push_back(encoder);
           encoder_->add_encoder(encoder);
         }
@@ -770,7 +940,7 @@ namespace BOOM {
       for (int i = 0; i < data.nvars(); ++i) {
         variable_types.push_back(data.variable_type(i));
         if (variable_types.back() == VariableType::categorical) {
-          levels.push_back(data.get_nominal(i).key());
+          levels.push_back(data.categorical_column(i).key());
         }
       }
       initialize_mixture(num_clusters, atoms, levels, variable_types);
@@ -149,6 +149,16 @@ namespace BOOM {
       // The type of variable the scalar model describes.
       virtual VariableType variable_type() const = 0;
 
+      // Add the complete data sufficient statistics from 'other' to those of
+      // this model.  Used to merge statistics accumulated by worker threads.
+      // 'other' must be the same concrete type as *this.
+      virtual void combine_sufficient_statistics(
+          const ScalarModelBase &other) = 0;
+
+      // Set the parameters of this model equal to those of 'other', which
+      // must be the same concrete type as *this.
+      virtual void copy_parameters(const ScalarModelBase &other) = 0;
+
      private:
       int index_;
     };
@@ -188,9 +198,12 @@ namespace BOOM {
 
       void sample_posterior() override {atom_model_->sample_posterior();}
       double logpri() const override {return atom_model_->logpri();}
+      void clear_data() override {atom_model_->clear_data();}
       VariableType variable_type() const override {
         return VariableType::numeric;
       }
+      void combine_sufficient_statistics(const ScalarModelBase &other) override;
+      void copy_parameters(const ScalarModelBase &other) override;
 
       // Return the atom responsible for the observed value.  If the observed
       // value is missing then impute using the atom_model_.
@@ -249,6 +262,8 @@ namespace BOOM {
       VariableType variable_type() const override {
         return VariableType::categorical;
       }
+      void combine_sufficient_statistics(const ScalarModelBase &other) override;
+      void copy_parameters(const ScalarModelBase &other) override;
 
       void update_complete_data_suf(int observed_level);
 
@@ -302,6 +317,12 @@ namespace BOOM {
       void clear_data() override;
       void sample_posterior() override;
 
+      // Merge the complete data sufficient statistics, or copy the
+      // parameters, of the scalar models in 'other', which must have the same
+      // structure as *this.
+      void combine_sufficient_statistics(const RowModelBase &other);
+      void copy_parameters(const RowModelBase &other);
+
       // For numeric variables, impute the latent variables indicating which
       // atom is responsible for each variable.
       virtual void impute_atoms(
@@ -440,6 +461,7 @@ namespace BOOM {
     MixedDataImputerBase & operator=(const MixedDataImputerBase &rhs);
     MixedDataImputerBase(MixedDataImputerBase &&rhs) = default;
     MixedDataImputerBase & operator=(MixedDataImputerBase &&rhs) = default;
+    ~MixedDataImputerBase() override;
 
     MixedDataImputerBase * clone() const override = 0;
     // Setup functions that require virtual functions.  Clients should call this
@@ -506,6 +528,19 @@ namespace BOOM {
     // on a variable-by-variable basis.
     Vector ybar() const;
 
+    //--------------------------------------------------------------------------
+    // Rows are conditionally independent given the model parameters, so they
+    // can be imputed in parallel.  Each worker is a clone of this object that
+    // owns a contiguous shard of the rows, its own RNG, and its own complete
+    // data sufficient statistics, which are merged into this object after
+    // each imputation sweep.  Results are reproducible for a given seed and
+    // number of workers.
+    //
+    // A non-positive number of workers shuts down the pool, returning to
+    // single threaded imputation.
+    void setup_worker_pool(int nworkers);
+    void shut_down_worker_pool();
+
    protected:
     void ensure_swept_sigma_current() const;
     SweptVarianceMatrix & swept_sigma() {return swept_sigma_;}
@@ -587,6 +622,23 @@ namespace BOOM {
     // numeric_data_model_ object is constructed.
     void set_numeric_data_model_observers();
     mutable Vector wsp_;
+
+    // ----------------------------------------------------------------------
+    // Threading section
+    // ----------------------------------------------------------------------
+
+    // If the object is a worker then the workers_ vector is empty and the
+    // thread pool has no threads.
+    std::vector<Ptr<MixedDataImputerBase>> workers_;
+    SharedThreadPool thread_pool_;
+
+    void impute_all_rows_multithreaded();
+    void impute_data_set_multithreaded(
+        std::vector<Ptr<MixedImputation::CompleteData>> &rows);
+    void distribute_data_to_workers();
+    void ensure_data_distribution();
+    void broadcast_parameters();
+    void reduce_sufficient_statistics();
   };
 
   //===========================================================================
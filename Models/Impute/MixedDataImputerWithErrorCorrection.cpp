@@ -60,6 +60,15 @@ namespace BOOM {
 
     NECM *NECM::clone() const {return new NECM(*this);}
 
+    void NECM::combine_sufficient_statistics(const ScalarModelBase &other) {
+      impl_->combine_sufficient_statistics(
+          *dynamic_cast<const NECM &>(other).impl_);
+    }
+
+    void NECM::copy_parameters(const ScalarModelBase &other) {
+      impl_->copy_parameters(*dynamic_cast<const NECM &>(other).impl_);
+    }
+
     double NECM::logp(const MixedMultivariateData &data) const {
       const DoubleData &scalar(data.numeric(index()));
       double value = std::numeric_limits<double>::quiet_NaN();
@@ -135,6 +144,20 @@ namespace BOOM {
       }
     }
 
+    void CECM::combine_sufficient_statistics(const ScalarModelBase &other) {
+      const CECM &rhs(dynamic_cast<const CECM &>(other));
+      truth_model_->suf()->combine(rhs.truth_model_->suf());
+      for (int i = 0; i < obs_models_.size(); ++i) {
+        obs_models_[i]->suf()->combine(rhs.obs_models_[i]->suf());
+      }
+    }
+
+    void CECM::copy_parameters(const ScalarModelBase &other) {
+      const CECM &rhs(dynamic_cast<const CECM &>(other));
+      set_level_probs(rhs.level_probs());
+      set_level_observation_probs(rhs.level_observation_probs());
+    }
+
     void CECM::update_complete_data_suf(int true_level, int observed_level) {
       truth_model_->suf()->update_raw(true_level);
       obs_models_[true_level]->suf()->update_raw(observed_level);
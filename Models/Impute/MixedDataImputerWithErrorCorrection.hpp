@@ -83,6 +83,8 @@ namespace BOOM {
       void sample_posterior() override { impl_->sample_posterior(); }
       double logpri() const override {return impl_->logpri();}
       void clear_data() override {impl_->clear_data();}
+      void combine_sufficient_statistics(const ScalarModelBase &other) override;
+      void copy_parameters(const ScalarModelBase &other) override;
       int impute_atom(double observed_value, RNG &rng, bool update) {
         return impl_->impute_atom(observed_value, rng, update);
       }
@@ -150,6 +152,8 @@ namespace BOOM {
       VariableType variable_type() const override {
         return VariableType::categorical;
       }
+      void combine_sufficient_statistics(const ScalarModelBase &other) override;
+      void copy_parameters(const ScalarModelBase &other) override;
 
       void update_complete_data_suf(int true_level, int observed_level);
 
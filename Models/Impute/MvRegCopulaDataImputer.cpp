@@ -17,6 +17,7 @@
 */
 
 #include <future>
+#include <map>
 
 #include "Models/Impute/MvRegCopulaDataImputer.hpp"
 #include "Models/PosteriorSamplers/MultinomialDirichletSampler.hpp"
@@ -458,6 +459,33 @@ namespace BOOM {
                                           RNG &rng,
                                           bool update_complete_data_suf) {
     ensure_swept_sigma_current();
+    Vector imputed_numeric;
+    Selector observed = prepare_numeric_values(
+        data, rng, update_complete_data_suf, imputed_numeric);
+
+    // Impute those numeric values that need imputing.
+    bool any_missing = observed.nvars() < observed.nvars_possible();
+    if (any_missing) {
+      Vector mean = complete_data_model_->predict(data->x());
+      if (observed.nvars() == 0) {
+        imputed_numeric = sigma_drawer_.draw(rng, mean);
+      } else {
+        const SweptVarianceCache::Pattern &pattern(
+            swept_sigma_.pattern(observed));
+        Vector imputed_values = pattern.residual_drawer().draw(
+            rng, pattern.conditional_mean(
+                observed.select(imputed_numeric), mean));
+        observed.fill_missing_elements(imputed_numeric, imputed_values);
+      }
+    }
+    store_numeric_values(data, imputed_numeric, any_missing,
+                         update_complete_data_suf);
+  }
+
+  //---------------------------------------------------------------------------
+  Selector MvRegCopulaDataImputer::prepare_numeric_values(
+      Ptr<Imputer::CompleteData> &data, RNG &rng,
+      bool update_complete_data_suf, Vector &imputed_numeric) {
     int component = impute_cluster(data, rng, update_complete_data_suf);
 
     // Fill y_true and y_numeric with values, which might include missing
@@ -467,11 +495,9 @@ namespace BOOM {
     cluster_mixture_components_[component]->impute_atoms(
         *data, rng, update_complete_data_suf);
 
-    // The remainder of this function fills in the missing numeric values.
-
     // Determine which numeric values need to be imputed.  As of this point the
     // numeric values have not been transformed to normality.
-    Vector imputed_numeric = data->y_numeric();
+    imputed_numeric = data->y_numeric();
     Selector observed(imputed_numeric.size(), true);
     for (int i = 0; i < imputed_numeric.size(); ++i) {
       if (std::isnan(imputed_numeric[i])) {
@@ -489,20 +515,14 @@ namespace BOOM {
          imputed_numeric[i] = qnorm(uniform);
       }
     }
+    return observed;
+  }
 
-    // Impute those numeric values that need imputing.
-    if (observed.nvars() < observed.nvars_possible()) {
-      Vector mean = complete_data_model_->predict(data->x());
-      if (observed.nvars() == 0) {
-        imputed_numeric = rmvn_mt(rng, mean, complete_data_model_->Sigma());
-      } else {
-        swept_sigma_.SWP(observed);
-        Vector conditional_mean = swept_sigma_.conditional_mean(
-            observed.select(imputed_numeric), mean);
-        Vector imputed_values = rmvn_mt(rng, conditional_mean, swept_sigma_.residual_variance());
-        observed.fill_missing_elements(imputed_numeric, imputed_values);
-      }
-
+  //---------------------------------------------------------------------------
+  void MvRegCopulaDataImputer::store_numeric_values(
+      Ptr<Imputer::CompleteData> &data, const Vector &imputed_numeric,
+      bool any_missing, bool update_complete_data_suf) {
+    if (any_missing) {
       // Transform imputed data back to observed scale.
       Vector y_true = data->y_true();
       for (int i = 0; i < imputed_numeric.size(); ++i) {
@@ -524,7 +544,38 @@ namespace BOOM {
       complete_data_model_->suf()->update_raw_data(
           data->y_numeric(), data->x(), 1.0);
     }
+  }
 
+  //---------------------------------------------------------------------------
+  void MvRegCopulaDataImputer::impute_numeric_pattern(
+      const Selector &observed, const std::vector<int> &rows,
+      std::vector<Vector> &imputed_numeric, RNG &rng) {
+    int nrows = rows.size();
+    int xdim = complete_data_model_->xdim();
+    Matrix predictors(nrows, xdim);
+    for (int i = 0; i < nrows; ++i) {
+      predictors.row(i) = complete_data_[rows[i]]->x();
+    }
+    Matrix means = predictors * complete_data_model_->Beta();
+
+    Matrix draws;
+    if (observed.nvars() == 0) {
+      draws = sigma_drawer_.draw_many(rng, nrows);
+      draws += means;
+    } else {
+      const SweptVarianceCache::Pattern &pattern(
+          swept_sigma_.pattern(observed));
+      Matrix known(nrows, observed.nvars());
+      for (int i = 0; i < nrows; ++i) {
+        known.row(i) = observed.select(imputed_numeric[rows[i]]);
+      }
+      draws = pattern.residual_drawer().draw_many(rng, nrows);
+      draws += pattern.conditional_mean(known, means);
+    }
+    for (int i = 0; i < nrows; ++i) {
+      observed.fill_missing_elements(imputed_numeric[rows[i]],
+                                     Vector(draws.row(i)));
+    }
   }
 
   //---------------------------------------------------------------------------
@@ -685,15 +736,38 @@ namespace BOOM {
                   std::back_inserter(workers_[i]->complete_data_));
         b += data_per_worker;
       }
-
-      workers_[i]-> empirical_distributions_ = empirical_distributions_;
     }
   }
 
+  // Rows are imputed in three passes.  The first imputes the cluster and atoms
+  // for each row and groups the rows by their pattern of missing numeric
+  // values.  The second imputes the missing numeric values for each pattern
+  // as a batch, sweeping the variance matrix once per pattern.  The third
+  // stores the results and updates the sufficient statistics.
   void MvRegCopulaDataImputer::impute_all_rows() {
     clear_client_data();
-    for (size_t i = 0; i < complete_data_.size(); ++i) {
-      impute_row(complete_data_[i], rng_, true);
+    ensure_swept_sigma_current();
+    size_t nrows = complete_data_.size();
+    std::vector<Vector> imputed_numeric(nrows);
+    std::vector<bool> any_missing(nrows, false);
+    std::map<std::vector<bool>, std::vector<int>> rows_by_pattern;
+    for (size_t i = 0; i < nrows; ++i) {
+      Selector observed = prepare_numeric_values(
+          complete_data_[i], rng_, true, imputed_numeric[i]);
+      if (observed.nvars() < observed.nvars_possible()) {
+        any_missing[i] = true;
+        rows_by_pattern[observed].push_back(i);
+      }
+    }
+
+    for (const auto &pattern : rows_by_pattern) {
+      impute_numeric_pattern(Selector(pattern.first), pattern.second,
+                             imputed_numeric, rng_);
+    }
+
+    for (size_t i = 0; i < nrows; ++i) {
+      store_numeric_values(complete_data_[i], imputed_numeric[i],
+                           any_missing[i], true);
     }
   }
 
@@ -711,8 +785,11 @@ namespace BOOM {
     }
   }
 
+  // The empirical distributions are copied along with the model parameters
+  // because they can change after the data have been distributed.
   void MvRegCopulaDataImputer::broadcast_parameters() {
     for (size_t i = 0; i < workers_.size(); ++i) {
+      workers_[i]->empirical_distributions_ = empirical_distributions_;
       workers_[i]->complete_data_model_->set_Beta(
           complete_data_model_->Beta());
       workers_[i]->complete_data_model_->set_Sigma(
@@ -782,7 +859,8 @@ namespace BOOM {
   //---------------------------------------------------------------------------
   void MvRegCopulaDataImputer::ensure_swept_sigma_current() const {
     if (swept_sigma_current_) return;
-    swept_sigma_ = SweptVarianceMatrix(complete_data_model_->Sigma());
+    swept_sigma_.set_variance(complete_data_model_->Sigma());
+    sigma_drawer_.set_variance(complete_data_model_->Sigma());
     swept_sigma_current_ = true;
   }
 
@@ -32,6 +32,7 @@
 
 #include "stats/IQagent.hpp"
 #include "distributions/rng.hpp"
+#include "distributions/MvnDrawer.hpp"
 
 #include "cpputil/ThreadTools.hpp"
 
@@ -462,7 +463,12 @@ namespace BOOM {
     // ======================================================================
     // Mutable workspace
     // ======================================================================
-    mutable SweptVarianceMatrix swept_sigma_;
+    // The conditional distribution of the missing numeric values given the
+    // observed ones, for recently seen missingness patterns.
+    mutable SweptVarianceCache swept_sigma_;
+    // Draws fully missing rows from N(0, Sigma) without refactoring Sigma for
+    // each row.  Kept current along with swept_sigma_.
+    mutable MvnDrawer sigma_drawer_;
     mutable bool swept_sigma_current_;
     void ensure_swept_sigma_current() const;
 
@@ -479,7 +485,7 @@ namespace BOOM {
     // If the object is a worker then the workers_ vector is empty and the
     // thread pool has no threads.
     std::vector<Ptr<MvRegCopulaDataImputer>> workers_;
-    ThreadWorkerPool thread_pool_;
+    SharedThreadPool thread_pool_;
     int worker_id_;
 
     // These methods are here to implemente multi-threading.
@@ -490,6 +496,32 @@ namespace BOOM {
     void broadcast_parameters();
     void reduce_sufficient_statistics();
     void impute_all_rows();
+
+    // The stages of impute_row, which impute_all_rows runs separately so that
+    // rows sharing a pattern of missing numeric values can be imputed as a
+    // batch.
+    //
+    // Impute the cluster and atoms for 'data', and fill 'imputed_numeric'
+    // with its numeric values transformed to normality.  Returns the pattern
+    // of observed numeric values.  Missing values are left as NaN.
+    Selector prepare_numeric_values(Ptr<Imputer::CompleteData> &data,
+                                    RNG &rng,
+                                    bool update_complete_data_suf,
+                                    Vector &imputed_numeric);
+
+    // Fill the missing elements of imputed_numeric[i] for each i in 'rows',
+    // all of which have the observed pattern 'observed'.
+    void impute_numeric_pattern(const Selector &observed,
+                                const std::vector<int> &rows,
+                                std::vector<Vector> &imputed_numeric,
+                                RNG &rng);
+
+    // Store the imputed numeric values in 'data', transforming any imputed
+    // values back to the observed scale.
+    void store_numeric_values(Ptr<Imputer::CompleteData> &data,
+                              const Vector &imputed_numeric,
+                              bool any_missing,
+                              bool update_complete_data_suf);
   };
 
 }  // namespace BOOM
@@ -277,6 +277,15 @@ namespace {
 
     // Check that all the parameters are moving.
 
+    // Missing values are imputed in batches grouped by missingness pattern.
+    // Every missing value should have been filled in.
+    Matrix imputed = imputer.imputed_data();
+    for (int i = 0; i < imputed.nrow(); ++i) {
+      for (int j = 0; j < imputed.ncol(); ++j) {
+        EXPECT_FALSE(std::isnan(imputed(i, j)));
+      }
+    }
+
     // Check that the imputed values are moving.
 
     // Check that the imputed values cover the true values.
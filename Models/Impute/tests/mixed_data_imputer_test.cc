@@ -2,6 +2,7 @@
 #include "Models/Impute/MixedDataImputer.hpp"
 #include "Models/Glm/PosteriorSamplers/MultivariateRegressionSampler.hpp"
 #include "Models/MvnModel.hpp"
+#include "Models/PosteriorSamplers/MultinomialDirichletSampler.hpp"
 #include "distributions.hpp"
 
 #include "test_utils/test_utils.hpp"
@@ -56,4 +57,103 @@ namespace {
 
   }
 
+  // A data table with one categorical and two numeric variables.  The first
+  // numeric variable has an atom at zero.  Roughly 10% of each variable is
+  // missing.
+  DataTable simulate_table(int nrows, const Ptr<CatKey> &colors) {
+    DataTable table;
+    double nan = std::numeric_limits<double>::quiet_NaN();
+    for (int i = 0; i < nrows; ++i) {
+      int level = rmulti(Vector{.5, .3, .2});
+      double y1 = runif() < .2 ? 0.0 : 3.0 + level + rnorm();
+      double y2 = -1.0 + 2.0 * level + rnorm();
+      NEW(DoubleData, numeric1)(runif() < .1 ? nan : y1);
+      NEW(DoubleData, numeric2)(runif() < .1 ? nan : y2);
+      NEW(LabeledCategoricalData, color)(colors->label(level), colors);
+      if (std::isnan(numeric1->value())) {
+        numeric1->set_missing_status(Data::missing_status::completely_missing);
+      }
+      if (std::isnan(numeric2->value())) {
+        numeric2->set_missing_status(Data::missing_status::completely_missing);
+      }
+      if (runif() < .1) {
+        color->set_missing_status(Data::missing_status::completely_missing);
+      }
+      MixedMultivariateData row;
+      row.add_numeric(numeric1);
+      row.add_categorical(color);
+      row.add_numeric(numeric2);
+      table.append_row(row);
+    }
+    return table;
+  }
+
+  Ptr<MixedDataImputer> build_imputer(const DataTable &table, int nworkers,
+                                      RNG &seeding_rng) {
+    // The conjugate priors on the scalar models seed their RNG's from the
+    // global RNG.
+    GlobalRng::rng.seed(seeding_rng());
+    std::vector<Vector> atoms = {Vector{0.0}, Vector()};
+    NEW(MixedDataImputer, imputer)(2, table, atoms, seeding_rng);
+    NEW(MultinomialDirichletSampler, mixing_sampler)(
+        imputer->mixing_distribution().get(), Vector(2, 1.0), imputer->rng());
+    imputer->mixing_distribution()->set_method(mixing_sampler);
+    int xdim = imputer->xdim();
+    int ydim = imputer->ydim();
+    NEW(MultivariateRegressionSampler, regression_sampler)(
+        imputer->numeric_data_model().get(), Matrix(xdim, ydim, 0.0), 1.0,
+        ydim + 1, SpdMatrix(ydim, 1.0), imputer->rng());
+    imputer->numeric_data_model()->set_method(regression_sampler);
+    for (int s = 0; s < imputer->nclusters(); ++s) {
+      imputer->row_model(s)->numeric_model(0)->set_conjugate_prior(
+          Vector(2, 1.0));
+      imputer->row_model(s)->numeric_model(1)->set_conjugate_prior(
+          Vector(1, 1.0));
+      imputer->row_model(s)->categorical_model(0)->set_conjugate_prior(
+          Vector(3, 1.0));
+    }
+    imputer->setup_worker_pool(nworkers);
+    return imputer;
+  }
+
+  // Sharded imputation merges the workers' sufficient statistics into the
+  // master, and is reproducible for a fixed seed and number of workers.
+  TEST_F(MixedDataImputerTest, ThreadedImputationIsReproducible) {
+    DataTable table = simulate_table(500, colors_);
+    RNG seed1(12345);
+    RNG seed2(12345);
+    Ptr<MixedDataImputer> imputer1 = build_imputer(table, 3, seed1);
+    Ptr<MixedDataImputer> imputer2 = build_imputer(table, 3, seed2);
+    for (int i = 0; i < 10; ++i) {
+      imputer1->sample_posterior();
+      imputer2->sample_posterior();
+    }
+    EXPECT_TRUE(MatrixEquals(imputer1->numeric_data_model()->Beta(),
+                             imputer2->numeric_data_model()->Beta()));
+    EXPECT_TRUE(VectorEquals(imputer1->mixing_distribution()->pi(),
+                             imputer2->mixing_distribution()->pi()));
+
+    // The merged statistics describe every row exactly once.
+    EXPECT_DOUBLE_EQ(500, sum(imputer1->mixing_distribution()->suf()->n()));
+    EXPECT_DOUBLE_EQ(500, imputer1->numeric_data_model()->suf()->n());
+    double atom_count = 0;
+    for (int s = 0; s < imputer1->nclusters(); ++s) {
+      atom_count += imputer1->row_model(s)->numeric_model(0)->atom_probs()[0];
+    }
+    EXPECT_GT(atom_count, 0.0);
+
+    std::vector<Ptr<CompleteData>> rows1, rows2;
+    for (int i = 0; i < 100; ++i) {
+      rows1.push_back(new CompleteData(table.row(i)));
+      rows2.push_back(new CompleteData(table.row(i)));
+    }
+    imputer1->impute_data_set(rows1);
+    imputer2->impute_data_set(rows2);
+    for (int i = 0; i < rows1.size(); ++i) {
+      EXPECT_TRUE(VectorEquals(rows1[i]->y_true(), rows2[i]->y_true()));
+      EXPECT_FALSE(std::isnan(rows1[i]->y_true()[1]));
+      EXPECT_EQ(rows1[i]->true_categories(), rows2[i]->true_categories());
+    }
+  }
+
 }  // namespace
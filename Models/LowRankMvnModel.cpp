@@ -85,9 +85,7 @@ namespace BOOM {
     const Matrix &root(prm2_ref().root());
     int zdim = root.ncol();
     Vector standard(zdim);
-    for (int i = 0; i < zdim; ++i) {
-      standard[i] = rnorm_mt(rng);
-    }
+    rnorm_mt(rng, standard);
     return mu() + root * standard;
   }
 
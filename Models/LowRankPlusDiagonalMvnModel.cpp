@@ -0,0 +1,293 @@
+/*
+  Copyright (C) 2005-2024 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include "Models/LowRankPlusDiagonalMvnModel.hpp"
+#include <cmath>
+#include "LinAlg/Cholesky.hpp"
+#include "cpputil/report_error.hpp"
+#include "distributions.hpp"
+#include "numopt/initialize_derivatives.hpp"
+
+namespace BOOM {
+
+  namespace {
+    const double log2pi = 1.83787706641;
+
+    // The pieces of the Woodbury identity for V = F * F' + D.
+    class WoodburyFactor {
+     public:
+      WoodburyFactor(const Matrix &factor, const Vector &diagonal)
+          : factor_(factor),
+            diagonal_(diagonal),
+            inner_(inner_matrix(factor, diagonal)) {
+        if (!inner_.is_pos_def()) {
+          report_error("I + F' D^{-1} F is not positive definite.");
+        }
+      }
+
+      // V^{-1} * x
+      Vector solve(const Vector &x) const {
+        Vector scaled = x / diagonal_;
+        Vector inner_solution = inner_.solve(factor_.Tmult(scaled));
+        scaled -= (factor_ * inner_solution) / diagonal_;
+        return scaled;
+      }
+
+      // log |V|
+      double logdet() const {
+        return sum(log(diagonal_)) + inner_.logdet();
+      }
+
+      // A k x k matrix R with R * R' = (I + F' D^{-1} F)^{-1}.
+      Matrix inverse_inner_root() const { return inner_.inv().chol(); }
+
+      // The dense V^{-1}.
+      SpdMatrix inverse() const {
+        Matrix scaled_factor = factor_;
+        for (int i = 0; i < scaled_factor.nrow(); ++i) {
+          scaled_factor.row(i) /= diagonal_[i];
+        }
+        SpdMatrix ans(diagonal_.size(), 0.0);
+        ans.diag() = 1.0 / diagonal_;
+        Matrix root = scaled_factor * inverse_inner_root();
+        ans.add_outer(root, -1.0);
+        return ans;
+      }
+
+     private:
+      static SpdMatrix inner_matrix(const Matrix &factor,
+                                    const Vector &diagonal) {
+        SpdMatrix ans(factor.ncol(), 0.0);
+        ans.add_inner(factor, 1.0 / diagonal);
+        ans.diag() += 1.0;
+        return ans;
+      }
+
+      const Matrix &factor_;
+      const Vector &diagonal_;
+      Cholesky inner_;
+    };
+
+    double woodbury_logp(const Vector &residual,
+                         const WoodburyFactor &woodbury,
+                         Vector *gradient) {
+      Vector scaled_residual = woodbury.solve(residual);
+      double ans = -.5 * residual.size() * log2pi - .5 * woodbury.logdet()
+          - .5 * residual.dot(scaled_residual);
+      if (gradient) {
+        *gradient -= scaled_residual;
+      }
+      return ans;
+    }
+  }  // namespace
+
+  LowRankPlusDiagonalMvnModel::LowRankPlusDiagonalMvnModel(
+      const Vector &mean, const Matrix &factor,
+      const Vector &diagonal_variance)
+      : ParamPolicy(new VectorParams(mean),
+                    new MatrixParams(factor),
+                    new VectorParams(diagonal_variance))
+  {
+    check_dimensions();
+  }
+
+  LowRankPlusDiagonalMvnModel *LowRankPlusDiagonalMvnModel::clone() const {
+    return new LowRankPlusDiagonalMvnModel(*this);
+  }
+
+  void LowRankPlusDiagonalMvnModel::set_factor(const Matrix &factor) {
+    prm2_ref().set(factor);
+    check_dimensions();
+  }
+
+  void LowRankPlusDiagonalMvnModel::set_diagonal_variance(
+      const Vector &diagonal_variance) {
+    prm3_ref().set(diagonal_variance);
+    check_dimensions();
+  }
+
+  void LowRankPlusDiagonalMvnModel::check_dimensions() const {
+    if (factor().nrow() != mu().size()
+        || diagonal_variance().size() != mu().size()) {
+      report_error("The mean, factor, and diagonal variance of a "
+                   "LowRankPlusDiagonalMvnModel must have the same number "
+                   "of rows.");
+    }
+    if (!diagonal_variance().empty() && diagonal_variance().min() <= 0) {
+      report_error("The diagonal variance must be positive.");
+    }
+  }
+
+  const SpdMatrix &LowRankPlusDiagonalMvnModel::Sigma() const {
+    variance_workspace_.resize(dim());
+    variance_workspace_ = 0.0;
+    variance_workspace_.add_outer(factor());
+    variance_workspace_.diag() += diagonal_variance();
+    return variance_workspace_;
+  }
+
+  const SpdMatrix &LowRankPlusDiagonalMvnModel::siginv() const {
+    variance_workspace_ =
+        WoodburyFactor(factor(), diagonal_variance()).inverse();
+    return variance_workspace_;
+  }
+
+  double LowRankPlusDiagonalMvnModel::ldsi() const {
+    return -WoodburyFactor(factor(), diagonal_variance()).logdet();
+  }
+
+  double LowRankPlusDiagonalMvnModel::logp(const Vector &x) const {
+    return woodbury_logp(x - mu(),
+                         WoodburyFactor(factor(), diagonal_variance()),
+                         nullptr);
+  }
+
+  double LowRankPlusDiagonalMvnModel::Logp(const Vector &x, Vector &gradient,
+                                           Matrix &Hessian,
+                                           uint nderiv) const {
+    WoodburyFactor woodbury(factor(), diagonal_variance());
+    if (nderiv == 0) {
+      return woodbury_logp(x - mu(), woodbury, nullptr);
+    }
+    gradient.resize(x.size());
+    gradient = 0.0;
+    double ans = woodbury_logp(x - mu(), woodbury, &gradient);
+    if (nderiv > 1) {
+      Hessian = woodbury.inverse() * -1.0;
+    }
+    return ans;
+  }
+
+  double LowRankPlusDiagonalMvnModel::logp_given_inclusion(
+      const Vector &x_subset, Vector *gradient, Matrix *Hessian,
+      const Selector &included, bool reset_derivatives) const {
+    if (included.nvars() == 0) {
+      return 0.0;
+    }
+    initialize_derivatives(gradient, Hessian, included.nvars(),
+                           reset_derivatives);
+    // As in MvnBase, the precision of the included variables is the
+    // corresponding block of siginv(), i.e. the precision of the included
+    // variables given the excluded ones.  Its inverse is D_in + F_in (I +
+    // F_out' D_out^{-1} F_out)^{-1} F_in'.
+    Matrix subset_factor;
+    if (included.nvars() == dim()) {
+      subset_factor = factor();
+    } else {
+      Selector excluded = included.complement();
+      SpdMatrix inner(rank(), 0.0);
+      inner.add_inner(excluded.select_rows(factor()),
+                      1.0 / excluded.select(diagonal_variance()));
+      inner.diag() += 1.0;
+      subset_factor = included.select_rows(factor()) * inner.inv().chol();
+    }
+    Vector subset_diagonal = included.select(diagonal_variance());
+    WoodburyFactor woodbury(subset_factor, subset_diagonal);
+    double ans = woodbury_logp(x_subset - included.select(mu()), woodbury,
+                               gradient);
+    if (gradient && Hessian) {
+      *Hessian -= woodbury.inverse();
+    }
+    return ans;
+  }
+
+  Vector LowRankPlusDiagonalMvnModel::sim(RNG &rng) const {
+    Vector z(rank());
+    rnorm_mt(rng, z);
+    Vector ans = mu() + factor() * z;
+    const Vector &diagonal(diagonal_variance());
+    for (int i = 0; i < ans.size(); ++i) {
+      ans[i] += rnorm_mt(rng, 0, std::sqrt(diagonal[i]));
+    }
+    return ans;
+  }
+
+  Vector LowRankPlusDiagonalMvnModel::precision_times(const Vector &x) const {
+    return WoodburyFactor(factor(), diagonal_variance()).solve(x);
+  }
+
+  // With M = F_o' D_o^{-1} F_o, the conditional variance of the unobserved
+  // variables is D_u + F_u (I + M)^{-1} F_u', and the conditional mean is
+  // mu_u + F_u (I + M)^{-1} F_o' D_o^{-1} (y_o - mu_o).
+  Ptr<LowRankPlusDiagonalMvnModel>
+  LowRankPlusDiagonalMvnModel::conditional_distribution(
+      const Selector &observed, const Vector &observed_values) const {
+    if (observed.nvars_possible() != dim()
+        || observed_values.size() != observed.nvars()) {
+      report_error("Wrong dimensions in conditional_distribution.");
+    }
+    Selector unobserved = observed.complement();
+    Matrix observed_factor = observed.select_rows(factor());
+    Vector observed_diagonal = observed.select(diagonal_variance());
+    Matrix unobserved_factor = unobserved.select_rows(factor());
+
+    SpdMatrix inner(rank(), 0.0);
+    inner.add_inner(observed_factor, 1.0 / observed_diagonal);
+    inner.diag() += 1.0;
+    Cholesky inner_cholesky(inner);
+
+    Vector scaled_residual =
+        (observed_values - observed.select(mu())) / observed_diagonal;
+    Vector mean = unobserved.select(mu()) + unobserved_factor *
+        inner_cholesky.solve(observed_factor.Tmult(scaled_residual));
+    return new LowRankPlusDiagonalMvnModel(
+        mean, unobserved_factor * inner_cholesky.inv().chol(),
+        unobserved.select(diagonal_variance()));
+  }
+
+  // Let W = diag(1 / observation_variance) and E = (D^{-1} + W)^{-1}.  The
+  // posterior precision is E^{-1} - U C U', with U = D^{-1} F and C = (I +
+  // F' D^{-1} F)^{-1}.  Applying the Woodbury identity a second time gives
+  // the posterior variance E + E U K^{-1} U' E, where
+  //
+  //     K = C^{-1} - U' E U = I + F' diag(w / (1 + w * D)) F.
+  //
+  // The posterior factor is E U R, where R R' = K^{-1}.
+  Ptr<LowRankPlusDiagonalMvnModel> LowRankPlusDiagonalMvnModel::posterior(
+      const Vector &y, const Vector &observation_variance) const {
+    if (y.size() != dim() || observation_variance.size() != dim()) {
+      report_error("Wrong dimensions in posterior.");
+    }
+    const Vector &D(diagonal_variance());
+    Vector E(dim());
+    Vector weights(dim());
+    Vector shrinkage(dim());
+    for (int i = 0; i < dim(); ++i) {
+      double w = 1.0 / observation_variance[i];
+      E[i] = 1.0 / (1.0 / D[i] + w);
+      weights[i] = w / (1 + w * D[i]);
+      shrinkage[i] = E[i] / D[i];
+    }
+    SpdMatrix K(rank(), 0.0);
+    K.add_inner(factor(), weights);
+    K.diag() += 1.0;
+    Matrix posterior_factor = factor();
+    for (int i = 0; i < dim(); ++i) {
+      posterior_factor.row(i) *= shrinkage[i];
+    }
+    posterior_factor = posterior_factor * K.inv().chol();
+
+    // The posterior mean is V_post * (V^{-1} mu + W y).
+    Vector precision_weighted_mean =
+        precision_times(mu()) + y / observation_variance;
+    Vector mean = E * precision_weighted_mean + posterior_factor *
+        posterior_factor.Tmult(precision_weighted_mean);
+    return new LowRankPlusDiagonalMvnModel(mean, posterior_factor, E);
+  }
+
+}  // namespace BOOM
@@ -0,0 +1,132 @@
+#ifndef BOOM_MODELS_LOW_RANK_PLUS_DIAGONAL_MVN_MODEL_HPP_
+#define BOOM_MODELS_LOW_RANK_PLUS_DIAGONAL_MVN_MODEL_HPP_
+
+/*
+  Copyright (C) 2005-2024 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include "LinAlg/Selector.hpp"
+#include "Models/MvnBase.hpp"
+#include "Models/ParamTypes.hpp"
+#include "Models/Policies/IID_DataPolicy.hpp"
+#include "Models/Policies/ParamPolicy_3.hpp"
+#include "Models/Policies/PriorPolicy.hpp"
+
+// A multivariate normal model with a factor-structured variance
+//
+//     y ~ N(mu, F * F' + D),
+//
+// where F is a d x k "factor loading" matrix with k << d, and D is diagonal
+// with positive elements.  Unlike LowRankMvnModel, which stores a dense
+// variance matrix of less than full rank, this model is full rank and is
+// stored entirely in terms of (mu, F, D).  All the operations below use the
+// Woodbury identity
+//
+//     (F F' + D)^{-1} = D^{-1} - D^{-1} F (I + F' D^{-1} F)^{-1} F' D^{-1},
+//
+// so their cost is O(d * k^2).  This makes the model usable as a prior on
+// very high dimensional coefficient vectors.
+//
+// The dense d x d matrices returned by Sigma() and siginv() are formed only
+// when those functions are called.
+namespace BOOM {
+
+  class LowRankPlusDiagonalMvnModel
+      : public MvnBase,
+        public ParamPolicy_3<VectorParams, MatrixParams, VectorParams>,
+        public IID_DataPolicy<VectorData>,
+        public PriorPolicy
+  {
+   public:
+    // Args:
+    //   mean: The mean of the distribution, of dimension d.
+    //   factor: The d x k matrix F.
+    //   diagonal_variance: The diagonal elements of D.  All must be
+    //     positive.
+    LowRankPlusDiagonalMvnModel(const Vector &mean, const Matrix &factor,
+                                const Vector &diagonal_variance);
+    LowRankPlusDiagonalMvnModel *clone() const override;
+
+    // The number of columns in the factor.
+    int rank() const { return factor().ncol(); }
+
+    const Vector &mu() const override { return prm1_ref().value(); }
+    const Matrix &factor() const { return prm2_ref().value(); }
+    const Vector &diagonal_variance() const { return prm3_ref().value(); }
+
+    void set_mu(const Vector &mu) { prm1_ref().set(mu); }
+    void set_factor(const Matrix &factor);
+    void set_diagonal_variance(const Vector &diagonal_variance);
+
+    // Dense variance and precision matrices.  These cost O(d^2) memory.
+    const SpdMatrix &Sigma() const override;
+    const SpdMatrix &siginv() const override;
+
+    // The log determinant of the precision matrix.
+    double ldsi() const override;
+
+    double logp(const Vector &x) const override;
+    double Logp(const Vector &x, Vector &gradient, Matrix &Hessian,
+                uint nderiv) const override;
+
+    // As in MvnBase, the included variables have mean mu[inclusion] and
+    // precision siginv()[inclusion].  The corresponding variance keeps the
+    // low rank plus diagonal structure, so the cost is O(d * k^2).
+    double logp_given_inclusion(const Vector &x_subset, Vector *gradient,
+                                Matrix *Hessian, const Selector &inclusion,
+                                bool reset_derivatives) const override;
+
+    // Simulate mu + F * z + D^{1/2} * e for standard normal z and e.
+    Vector sim(RNG &rng = GlobalRng::rng) const override;
+
+    // Returns (F F' + D)^{-1} * x.
+    Vector precision_times(const Vector &x) const;
+
+    // The conditional distribution of the variables not in 'observed', given
+    // the values of the variables that are.
+    //
+    // Args:
+    //   observed:  Identifies the observed variables.
+    //   observed_values: The values of the observed variables.  The
+    //     dimension is observed.nvars().
+    //
+    // Returns:
+    //   The conditional distribution, which has dimension d -
+    //   observed.nvars() and the same rank as this model.
+    Ptr<LowRankPlusDiagonalMvnModel> conditional_distribution(
+        const Selector &observed, const Vector &observed_values) const;
+
+    // The posterior distribution of x, with this model as the prior, after
+    // observing y = x + e, where the elements of e are independent
+    // N(0, observation_variance[i]).
+    //
+    // Returns:
+    //   The posterior distribution, which keeps the low rank plus diagonal
+    //   form with the same rank as this model.
+    Ptr<LowRankPlusDiagonalMvnModel> posterior(
+        const Vector &y, const Vector &observation_variance) const;
+
+   private:
+    void check_dimensions() const;
+
+    // Scratch space for the dense Sigma() and siginv().
+    mutable SpdMatrix variance_workspace_;
+  };
+
+}  // namespace BOOM
+
+#endif  //  BOOM_MODELS_LOW_RANK_PLUS_DIAGONAL_MVN_MODEL_HPP_
@@ -18,7 +18,10 @@
 */
 
 #include "Models/MarkovModel.hpp"
+#include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <sstream>
 #include "LinAlg/Matrix.hpp"
 #include "LinAlg/VectorView.hpp"
 #include "Models/DirichletModel.hpp"
@@ -135,6 +138,31 @@ namespace BOOM {
     return out;
   }
 
+  //======================================================================
+  MarkovSequences::MarkovSequences(int state_space_size)
+      : state_space_size_(state_space_size), series_start_(1, 0) {
+    if (state_space_size <= 0) {
+      report_error("The state space size must be positive.");
+    }
+  }
+
+  void MarkovSequences::add_series(const std::vector<int> &states) {
+    if (states.empty()) {
+      report_error("Empty series cannot be added to MarkovSequences.");
+    }
+    for (int state : states) {
+      if (state < 0 || state >= state_space_size_) {
+        std::ostringstream err;
+        err << "State " << state << " is out of range for a Markov chain with "
+            << state_space_size_ << " states.";
+        report_error(err.str());
+      }
+    }
+    states_.insert(states_.end(), states.begin(), states.end());
+    series_start_.push_back(states_.size());
+  }
+
+  //======================================================================
   MarkovSuf::MarkovSuf(uint S) : trans_(S, S, 0.0), init_(S, 0.0) {}
 
   MarkovSuf::MarkovSuf(const MarkovSuf &rhs)
@@ -161,6 +189,81 @@ namespace BOOM {
 
   void MarkovSuf::add_initial_value(uint h) { ++init_[h]; }
 
+  namespace {
+    // Shards smaller than this are not worth the cost of a task.
+    const std::size_t min_markov_shard_size = 1 << 16;
+  }  // namespace
+
+  void MarkovSuf::add_sequences(const MarkovSequences &data,
+                                SharedThreadPool *pool) {
+    const int S = state_space_size();
+    if (data.state_space_size() != S) {
+      report_error("MarkovSequences has the wrong state space size.");
+    }
+    const std::size_t total = data.total_length();
+    if (total == 0) return;
+
+    int nshards = 1;
+    if (pool && !pool->no_threads()) {
+      std::size_t max_shards = 1 + (total - 1) / min_markov_shard_size;
+      nshards = std::min<std::size_t>(4 * pool->number_of_threads(),
+                                      max_shards);
+    }
+
+    const std::vector<int> &states(data.states());
+    const std::vector<std::size_t> &series_start(data.series_start());
+    const int nseries = data.number_of_series();
+    // Each shard owns S*S transition counts followed by S initial counts.
+    std::vector<std::vector<std::int64_t>> counts(nshards);
+
+    auto count_shard = [&](int shard) {
+      std::vector<std::int64_t> &shard_counts(counts[shard]);
+      shard_counts.assign(S * S + S, 0);
+      std::int64_t *transitions = shard_counts.data();
+      std::int64_t *initial = transitions + S * S;
+      const std::size_t begin = total * shard / nshards;
+      const std::size_t end = total * (shard + 1) / nshards;
+
+      // The series containing position 'begin'.
+      int series = std::upper_bound(series_start.begin(), series_start.end(),
+                                    begin) - series_start.begin() - 1;
+      for (; series < nseries && series_start[series] < end; ++series) {
+        std::size_t lo = std::max(begin, series_start[series]);
+        const std::size_t hi = std::min(end, series_start[series + 1]);
+        if (lo >= hi) continue;
+        if (lo == series_start[series]) {
+          ++initial[states[lo]];
+          ++lo;
+        }
+        // The transition into position t is counted by the shard that owns
+        // t, even if t - 1 belongs to the previous shard.
+        int from = states[lo - 1];
+        for (std::size_t t = lo; t < hi; ++t) {
+          const int to = states[t];
+          ++transitions[from * S + to];
+          from = to;
+        }
+      }
+    };
+
+    if (nshards == 1) {
+      count_shard(0);
+    } else {
+      pool->parallel_for(0, nshards, 1, count_shard);
+    }
+
+    for (int shard = 0; shard < nshards; ++shard) {
+      const std::int64_t *transitions = counts[shard].data();
+      const std::int64_t *initial = transitions + S * S;
+      for (int from = 0; from < S; ++from) {
+        for (int to = 0; to < S; ++to) {
+          trans_(from, to) += transitions[from * S + to];
+        }
+        init_[from] += initial[from];
+      }
+    }
+  }
+
   void MarkovSuf::add_mixture_data(const Ptr<MarkovData> &dp, double prob) {
     uint now = dp->value();
     MarkovData *prev = dp->prev();
@@ -323,7 +426,8 @@ namespace BOOM {
         PriorPolicy(rhs),
         LoglikeModel(rhs),
         EmMixtureComponent(rhs),
-        initial_distribution_status_(rhs.initial_distribution_status_) {}
+        initial_distribution_status_(rhs.initial_distribution_status_),
+        pool_(rhs.pool_) {}
 
   MarkovModel *MarkovModel::clone() const { return new MarkovModel(*this); }
 
@@ -488,4 +592,8 @@ namespace BOOM {
   void MarkovModel::add_mixture_data(const Ptr<Data> &dp, double prob) {
     suf()->add_mixture_data(DAT_1(dp), prob);
   }
+
+  void MarkovModel::add_sequences(const MarkovSequences &data) {
+    suf()->add_sequences(data, &pool_);
+  }
 }  // namespace BOOM
@@ -20,6 +20,7 @@
 #ifndef BOOM_MARKOV_MODEL_HPP
 #define BOOM_MARKOV_MODEL_HPP
 
+#include <cstddef>
 #include <vector>
 #include "uint.hpp"
 
@@ -39,6 +40,8 @@
 #include "LinAlg/Matrix.hpp"
 #include "LinAlg/Vector.hpp"
 
+#include "cpputil/ThreadTools.hpp"
+
 namespace BOOM {
 
   //====================================================================
@@ -130,6 +133,42 @@ namespace BOOM {
     return *this;
   }
 
+  //=====================================================================
+  // A compact representation of one or more Markov chains on the state space
+  // {0, ..., S-1}.  The states from all the series are stored end to end in
+  // a single integer array, along with the position where each series
+  // starts.  This avoids the heap allocated, doubly linked MarkovData node
+  // per observation, which is the dominant cost when there are many millions
+  // of transitions to count.
+  class MarkovSequences {
+   public:
+    explicit MarkovSequences(int state_space_size);
+
+    // Append a series to the collection.  Each element of 'states' must be
+    // in [0, state_space_size()).  Empty series are not allowed.
+    void add_series(const std::vector<int> &states);
+
+    int state_space_size() const { return state_space_size_; }
+    int number_of_series() const { return series_start_.size() - 1; }
+
+    // The total number of observations, summed across all series.
+    std::size_t total_length() const { return states_.size(); }
+
+    // The states from all the series, stored end to end.
+    const std::vector<int> &states() const { return states_; }
+
+    // Series i occupies positions [series_start()[i], series_start()[i+1])
+    // of states().  The final element is total_length().
+    const std::vector<std::size_t> &series_start() const {
+      return series_start_;
+    }
+
+   private:
+    int state_space_size_;
+    std::vector<int> states_;
+    std::vector<std::size_t> series_start_;
+  };
+
   //=====================================================================
   const bool debug_markov_update_suf(false);
   class MarkovSuf
@@ -151,6 +190,20 @@ namespace BOOM {
     void add_initial_distribution(const Vector &pi);
     void add_transition(uint from, uint to);
     void add_initial_value(uint val);
+
+    // Add the initial states and transitions from every series in 'data'.
+    // The state array is split into contiguous shards, each of which is
+    // counted on 'pool' into its own S x S table of integer counts.  The
+    // tables are summed once all the shards are done.  Integer counts make
+    // the result independent of the number of threads.
+    //
+    // Args:
+    //   data:  The sequences to add.  The state space size must match.
+    //   pool: The pool used to count the shards.  If nullptr the work is
+    //     done serially in the calling thread.
+    void add_sequences(const MarkovSequences &data,
+                       SharedThreadPool *pool = nullptr);
+
     const Matrix &trans() const { return trans_; }
     const Vector &init() const { return init_; }
     std::ostream &print(std::ostream &) const override;
@@ -253,6 +306,16 @@ namespace BOOM {
 
     void add_mixture_data(const Ptr<Data> &, double prob) override;
 
+    // Add the transitions in 'data' directly to the sufficient statistics.
+    // The sequences are not stored as MarkovData, so they do not count
+    // towards number_of_observations(), and they are discarded by
+    // clear_data().  Posterior samplers that work from suf(), such as
+    // MarkovConjSampler, use them like any other data.
+    void add_sequences(const MarkovSequences &data);
+
+    // The number of threads used to count transitions in add_sequences.
+    void set_number_of_threads(int n) { pool_.set_number_of_threads(n); }
+
     uint state_space_size() const;
 
     Ptr<MatrixParams> Q_prm();
@@ -309,6 +372,8 @@ namespace BOOM {
     // two in sync.
     mutable bool log_transition_probabilities_current_;
     mutable Matrix log_transition_probabilities_;
+
+    SharedThreadPool pool_;
   };
 
 }  // namespace BOOM
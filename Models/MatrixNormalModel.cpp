@@ -18,6 +18,7 @@
 
 #include "Models/MatrixNormalModel.hpp"
 #include "distributions.hpp"
+#include "numopt/initialize_derivatives.hpp"
 
 namespace BOOM {
   MatrixNormalModel::MatrixNormalModel(int nrow, int ncol)
@@ -61,6 +62,27 @@ namespace BOOM {
     return Kronecker(column_precision(), row_precision());
   }
 
+  SpdMatrix MatrixNormalModel::mvn_precision(const Selector &included) const {
+    // Element k of vec(Y) is Y(k % nrow, k / nrow), and the precision of
+    // vec(Y) is column_precision \otimes row_precision.
+    const SpdMatrix &row_prec(row_precision());
+    const SpdMatrix &col_prec(column_precision());
+    const int nr = nrow();
+    const int n = included.nvars();
+    SpdMatrix ans(n);
+    for (int b = 0; b < n; ++b) {
+      const int kb = included.indx(b);
+      const int row_b = kb % nr;
+      const int col_b = kb / nr;
+      for (int a = 0; a <= b; ++a) {
+        const int ka = included.indx(a);
+        ans(a, b) = col_prec(ka / nr, col_b) * row_prec(ka % nr, row_b);
+      }
+    }
+    ans.reflect();
+    return ans;
+  }
+
   double MatrixNormalModel::logp(const Matrix &y) const {
     return dmatrix_normal_ivar(y, mean(),
                                row_precision(), row_precision_logdet(),
@@ -72,6 +94,56 @@ namespace BOOM {
     return logp(Matrix(nrow(), ncol(), y));
   }
 
+  double MatrixNormalModel::Logp(const Vector &y, Vector &gradient,
+                                 Matrix &Hessian, uint nderiv) const {
+    if (nderiv == 0) {
+      return logp(y);
+    }
+    Matrix residual = Matrix(nrow(), ncol(), y) - mean();
+    // scaled_residual = row_precision * residual * column_precision, so the
+    // quadratic form is tr(residual' * scaled_residual).
+    Matrix scaled_residual = row_precision() * residual * column_precision();
+    double qform = traceAtB(residual, scaled_residual);
+    const double log2pi = 1.83787706641;
+    double ans = -.5 * dim() * log2pi + .5 * ldsi() - .5 * qform;
+    gradient = vec(scaled_residual) * -1.0;
+    if (nderiv > 1) {
+      Hessian = mvn_precision() * -1.0;
+    }
+    return ans;
+  }
+
+  double MatrixNormalModel::logp_given_inclusion(
+      const Vector &x_subset, Vector *gradient, Matrix *Hessian,
+      const Selector &included, bool reset_derivatives) const {
+    if (included.nvars() == 0) {
+      return 0.0;
+    }
+    initialize_derivatives(gradient, Hessian, included.nvars(),
+                           reset_derivatives);
+    if (included.nvars() == dim()) {
+      Vector g;
+      Matrix h;
+      int nderiv = gradient ? (Hessian ? 2 : 1) : 0;
+      double ans = Logp(x_subset, g, h, nderiv);
+      if (gradient) {
+        *gradient += g;
+        if (Hessian) *Hessian += h;
+      }
+      return ans;
+    }
+    Vector mu0 = included.select(mu());
+    SpdMatrix precision = mvn_precision(included);
+    double ans = dmvn(x_subset, mu0, precision, precision.logdet(), true);
+    if (gradient) {
+      *gradient -= precision * (x_subset - mu0);
+      if (Hessian) {
+        *Hessian -= precision;
+      }
+    }
+    return ans;
+  }
+
   Matrix MatrixNormalModel::simulate(RNG &rng) const {
     Matrix Z(nrow(), ncol());
     for (int i = 0; i < nrow(); ++i) {
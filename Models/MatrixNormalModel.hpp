@@ -56,6 +56,11 @@ namespace BOOM {
     // MvnBase interface.
     uint dim() const override {return nrow() * ncol();}
     const Vector &mu() const override;
+
+    // Sigma() and siginv() form the dense (nrow * ncol)^2 Kronecker product.
+    // They exist to satisfy the MvnBase interface, but none of the other
+    // member functions below need them, so a model with large row and column
+    // dimensions never materializes the dense matrix unless asked.
     const SpdMatrix &Sigma() const override;
     const SpdMatrix &siginv() const override;
     double ldsi() const override {
@@ -66,6 +71,19 @@ namespace BOOM {
     double logp(const Vector &vectorized_matrix) const override;
     Vector sim(RNG &rng = GlobalRng::rng) const override;
 
+    // The log density and its gradient are computed from the row and column
+    // factors.  The Hessian is the dense negative precision matrix, so it is
+    // only formed if nderiv > 1.
+    double Logp(const Vector &vectorized_matrix, Vector &gradient,
+                Matrix &Hessian, uint nderiv) const override;
+
+    // If only some elements are included, the precision of the included
+    // elements is assembled directly from the row and column precisions, at
+    // a cost quadratic in the number of included elements.
+    double logp_given_inclusion(const Vector &x_subset, Vector *gradient,
+                                Matrix *Hessian, const Selector &inclusion,
+                                bool reset_derivatives) const override;
+
     // The number of rows and columns in the random variable described by this
     // model.
     int nrow() const {return mean().nrow();}
@@ -112,6 +130,11 @@ namespace BOOM {
     SpdMatrix mvn_variance() const;
     SpdMatrix mvn_precision() const;
 
+    // The rows and columns of mvn_precision() corresponding to the included
+    // elements of the vectorized random variable, computed without forming
+    // mvn_precision().
+    SpdMatrix mvn_precision(const Selector &included) const;
+
     double logp(const Matrix &y) const;
     Matrix simulate(RNG &rng = GlobalRng::rng) const;
 
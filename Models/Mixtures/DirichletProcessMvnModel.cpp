@@ -89,6 +89,27 @@ namespace BOOM {
     }
   }
 
+  void DPMM::set_clusters(const std::vector<Ptr<MvnSuf>> &sufs) {
+    if (sufs.empty()) {
+      report_error("DirichletProcessMvnModel needs at least one cluster.");
+    }
+    std::vector<Ptr<MvnModel>> components;
+    components.reserve(sufs.size());
+    for (int i = 0; i < sufs.size(); ++i) {
+      Ptr<MvnModel> mvn;
+      if (i < mixture_components_.size()) {
+        mvn = mixture_components_[i];
+      } else {
+        mvn = new MvnModel(dim_);
+      }
+      mvn->suf()->clear();
+      mvn->suf()->combine(*sufs[i]);
+      components.push_back(mvn);
+    }
+    mixture_components_.swap(components);
+    register_models();
+  }
+
   void DPMM::update_cluster(const Vector &old_y, const Vector &new_y,
                             int cluster) {
     if (cluster < mixture_components_.size()) {
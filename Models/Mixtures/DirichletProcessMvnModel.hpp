@@ -70,6 +70,13 @@ namespace BOOM {
     // in an empty cluster then the cluster is removed.
     void remove_data_from_cluster(const Vector &y, int cluster);
 
+    // Replace the current set of clusters with one cluster for each element
+    // of 'sufs', holding the corresponding sufficient statistics.  Existing
+    // mixture components are reused where possible, so their parameters
+    // carry over, but callers will normally set the parameters of each
+    // cluster afterwards.  It is an error to pass an empty vector.
+    void set_clusters(const std::vector<Ptr<MvnSuf>> &sufs);
+
     // Change value of data currently used in model.
     void update_cluster(const Vector &old_y, const Vector &new_y, int cluster);
 
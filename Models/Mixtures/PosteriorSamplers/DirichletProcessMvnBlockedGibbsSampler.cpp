@@ -0,0 +1,237 @@
+// Copyright 2018 Google LLC. All Rights Reserved.
+/*
+  Copyright (C) 2005-2018 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#include "Models/Mixtures/PosteriorSamplers/DirichletProcessMvnBlockedGibbsSampler.hpp"
+#include "cpputil/lse.hpp"
+#include "cpputil/math_utils.hpp"
+#include "cpputil/report_error.hpp"
+#include "distributions.hpp"
+
+namespace BOOM {
+  namespace {
+    typedef DirichletProcessMvnBlockedGibbsSampler DPMBGS;
+
+    // The number of observations in each shard when drawing cluster
+    // membership indicators.  This does not depend on the number of threads,
+    // so the random numbers used for each observation do not either.
+    const int indicator_shard_size = 1000;
+  }  // namespace
+
+  DPMBGS::DirichletProcessMvnBlockedGibbsSampler(
+      DirichletProcessMvnModel *model,
+      const Ptr<MvnGivenSigma> &mean_base_measure,
+      const Ptr<WishartModel> &precision_base_measure, int truncation_level,
+      RNG &seeding_rng)
+      : PosteriorSampler(seeding_rng),
+        model_(model),
+        mean_base_measure_(mean_base_measure),
+        precision_base_measure_(precision_base_measure),
+        truncation_level_(truncation_level),
+        posterior_(mean_base_measure_.get(), precision_base_measure_.get()),
+        mu_(truncation_level),
+        siginv_(truncation_level),
+        precision_cholesky_(truncation_level),
+        log_normalizing_constants_(truncation_level),
+        log_weights_(truncation_level, -std::log(truncation_level)) {
+    if (truncation_level_ < 1) {
+      report_error("truncation_level must be positive.");
+    }
+    for (int k = 0; k < truncation_level_; ++k) {
+      suf_.push_back(new MvnSuf(model_->dim()));
+    }
+  }
+
+  double DPMBGS::logpri() const {
+    report_error(
+        "Calling logpri for a Dirichlet process mixture really "
+        "doesn't make a lot of sense");
+    return 0;
+  }
+
+  void DPMBGS::draw() {
+    initialize_labels();
+    draw_parameters();
+    draw_mixing_weights();
+    draw_cluster_membership_indicators();
+    update_model();
+  }
+
+  void DPMBGS::draw_parameters() {
+    const double log2pi = 1.83787706641;
+    int dim = model_->dim();
+    for (int k = 0; k < truncation_level_; ++k) {
+      posterior_.compute_mvn_posterior(*suf_[k]);
+      siginv_[k] = rWish_mt(rng(), posterior_.variance_sample_size(),
+                            posterior_.sum_of_squares().inv());
+      mu_[k] = rmvn_ivar_mt(rng(), posterior_.mean(),
+                            posterior_.mean_sample_size() * siginv_[k]);
+      precision_cholesky_[k] = siginv_[k].chol();
+      double half_logdet = 0;
+      for (int i = 0; i < dim; ++i) {
+        half_logdet += std::log(precision_cholesky_[k](i, i));
+      }
+      log_normalizing_constants_[k] = half_logdet - 0.5 * dim * log2pi;
+    }
+  }
+
+  void DPMBGS::draw_mixing_weights() {
+    double alpha = model_->alpha();
+    // remaining[k] is the number of observations in components after k.
+    Vector remaining(truncation_level_, 0.0);
+    for (int k = truncation_level_ - 2; k >= 0; --k) {
+      remaining[k] = remaining[k + 1] + suf_[k + 1]->n();
+    }
+    double log_leftover = 0;
+    for (int k = 0; k < truncation_level_ - 1; ++k) {
+      double stick = rbeta_mt(rng(), 1 + suf_[k]->n(), alpha + remaining[k]);
+      log_weights_[k] = log_leftover + std::log(stick);
+      log_leftover += std::log1p(-stick);
+    }
+    log_weights_.back() = log_leftover;
+  }
+
+  void DPMBGS::draw_cluster_membership_indicators() {
+    int n = labels_.size();
+    int nshards = (n + indicator_shard_size - 1) / indicator_shard_size;
+    if (shard_suf_.size() != nshards) {
+      shard_suf_.resize(nshards);
+    }
+    for (auto &shard : shard_suf_) {
+      if (shard.size() != truncation_level_) {
+        shard.clear();
+        for (int k = 0; k < truncation_level_; ++k) {
+          shard.push_back(new MvnSuf(model_->dim()));
+        }
+      }
+      for (auto &suf : shard) {
+        suf->clear();
+      }
+    }
+
+    RNG::RngIntType seed = seed_rng(rng());
+    pool_.parallel_for(0, nshards, 1, [&](int shard) {
+      RNG shard_rng(seed, shard);
+      int begin = shard * indicator_shard_size;
+      int end = std::min<int>(begin + indicator_shard_size, n);
+      draw_labels(begin, end, shard_rng, shard_suf_[shard]);
+    });
+
+    for (int k = 0; k < truncation_level_; ++k) {
+      suf_[k]->clear();
+      for (const auto &shard : shard_suf_) {
+        // MvnSuf::combine divides by the combined sample size, so empty
+        // statistics must be skipped.
+        if (shard[k]->n() > 0) {
+          suf_[k]->combine(*shard[k]);
+        }
+      }
+    }
+  }
+
+  void DPMBGS::draw_labels(int begin, int end, RNG &rng,
+                           std::vector<Ptr<MvnSuf>> &suf) {
+    const std::vector<Ptr<VectorData>> &data(model_->dat());
+    int dim = model_->dim();
+    int nobs = end - begin;
+    Matrix y(nobs, dim);
+    for (int i = 0; i < nobs; ++i) {
+      y.row(i) = data[begin + i]->value();
+    }
+
+    // log_prob(i, k) is the unnormalized log probability that observation i
+    // belongs to component k.  The quadratic forms for each component are
+    // computed as a block, using the cached Cholesky factor.
+    Matrix log_prob(nobs, truncation_level_);
+    Matrix residual(nobs, dim);
+    for (int k = 0; k < truncation_level_; ++k) {
+      if (!std::isfinite(log_weights_[k])) {
+        log_prob.col(k) = negative_infinity();
+        continue;
+      }
+      residual = y;
+      for (int i = 0; i < nobs; ++i) {
+        residual.row(i) -= mu_[k];
+      }
+      Matrix scaled_residual = residual * precision_cholesky_[k];
+      double constant = log_weights_[k] + log_normalizing_constants_[k];
+      for (int i = 0; i < nobs; ++i) {
+        log_prob(i, k) = constant - 0.5 * scaled_residual.row(i).normsq();
+      }
+    }
+
+    normalize_logprob_rows(log_prob);
+    Vector prob(truncation_level_);
+    for (int i = 0; i < nobs; ++i) {
+      prob = log_prob.row(i);
+      int label = rmulti_mt(rng, prob);
+      labels_[begin + i] = label;
+      suf[label]->update_raw(data[begin + i]->value());
+    }
+  }
+
+  void DPMBGS::initialize_labels() {
+    const std::vector<Ptr<VectorData>> &data(model_->dat());
+    int n = data.size();
+    if (labels_.size() == n) return;
+    labels_.assign(n, 0);
+    const std::vector<int> &indicators(model_->cluster_indicators());
+    if (indicators.size() == n) {
+      bool valid = true;
+      for (int i = 0; i < n; ++i) {
+        if (indicators[i] < 0 || indicators[i] >= truncation_level_) {
+          valid = false;
+          break;
+        }
+      }
+      if (valid) {
+        labels_ = indicators;
+      }
+    }
+    for (auto &suf : suf_) {
+      suf->clear();
+    }
+    for (int i = 0; i < n; ++i) {
+      suf_[labels_[i]]->update_raw(data[i]->value());
+    }
+  }
+
+  void DPMBGS::update_model() {
+    // cluster_number[k] is the model's cluster number for component k, or -1
+    // if component k is empty.
+    std::vector<int> cluster_number(truncation_level_, -1);
+    std::vector<Ptr<MvnSuf>> occupied;
+    for (int k = 0; k < truncation_level_; ++k) {
+      if (suf_[k]->n() > 0) {
+        cluster_number[k] = occupied.size();
+        occupied.push_back(suf_[k]);
+      }
+    }
+    model_->set_clusters(occupied);
+    for (int k = 0; k < truncation_level_; ++k) {
+      if (cluster_number[k] >= 0) {
+        model_->set_component_params(cluster_number[k], mu_[k], siginv_[k]);
+      }
+    }
+    model_->initialize_cluster_indicators(labels_.size());
+    for (int i = 0; i < labels_.size(); ++i) {
+      model_->set_cluster_indicator(i, cluster_number[labels_[i]]);
+    }
+  }
+
+}  // namespace BOOM
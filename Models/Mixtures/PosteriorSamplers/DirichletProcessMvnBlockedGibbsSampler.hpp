@@ -0,0 +1,146 @@
+// Copyright 2018 Google LLC. All Rights Reserved.
+/*
+  Copyright (C) 2005-2018 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#ifndef BOOM_DIRICHLET_PROCESS_MVN_BLOCKED_GIBBS_SAMPLER_HPP_
+#define BOOM_DIRICHLET_PROCESS_MVN_BLOCKED_GIBBS_SAMPLER_HPP_
+
+#include "Models/Mixtures/DirichletProcessMvnModel.hpp"
+
+#include "Models/MvnGivenSigma.hpp"
+#include "Models/PosteriorSamplers/MvnConjSampler.hpp"
+#include "Models/PosteriorSamplers/PosteriorSampler.hpp"
+#include "Models/WishartModel.hpp"
+#include "cpputil/ThreadTools.hpp"
+
+namespace BOOM {
+
+  // A posterior sampler for a DirichletProcessMvnModel based on the blocked
+  // Gibbs sampler of Ishwaran and James (2001, JASA).  The Dirichlet process
+  // is truncated to a fixed number of mixture components, with stick
+  // breaking weights.  Given the component parameters and mixing weights, the
+  // cluster membership indicators are conditionally independent, so they can
+  // be drawn in parallel.  This makes the sampler a better choice than
+  // DirichletProcessMvnCollapsedGibbsSampler for large data sets, where the
+  // one-observation-at-a-time collapsed sampler is too slow.
+  //
+  // The sampler keeps all 'truncation_level' components, including empty
+  // ones, in its own state.  The model object only sees the occupied
+  // clusters, numbered in order of their component labels.
+  class DirichletProcessMvnBlockedGibbsSampler : public PosteriorSampler {
+   public:
+    // Args:
+    //   model: The model for which posterior samples are desired.
+    //   mean_base_measure: A conditional MVN model describing the prior
+    //     distribution of the normal mean conditional on the normal
+    //     variance.  Only the parameters of this model are used.
+    //   precision_base_measure: A WishartModel describing the marginal
+    //     distribution of Siginv, the precision parameter of each mixture
+    //     component.
+    //   truncation_level: The maximum number of mixture components.  This
+    //     should be comfortably larger than the number of clusters expected
+    //     in the data.
+    //   seeding_rng: The RNG to use to set the seed for this posterior
+    //     sampler.
+    DirichletProcessMvnBlockedGibbsSampler(
+        DirichletProcessMvnModel *model,
+        const Ptr<MvnGivenSigma> &mean_base_measure,
+        const Ptr<WishartModel> &precision_base_measure,
+        int truncation_level = 20,
+        RNG &seeding_rng = GlobalRng::rng);
+
+    // Note that logpri is a required overload, but it doesn't really make
+    // sense here.  Calling it results in an exception.
+    double logpri() const override;
+
+    void draw() override;
+
+    // Draw the parameters of each component given the cluster membership
+    // indicators.  Empty components are drawn from the base measure.
+    void draw_parameters();
+
+    // Draw the stick breaking mixing weights given the cluster membership
+    // indicators.
+    void draw_mixing_weights();
+
+    // Draw the cluster membership indicators given the parameters and
+    // mixing weights.  The data are divided into shards of a fixed size,
+    // each with its own random number stream, so for a given seed the draw
+    // does not depend on the number of threads.
+    void draw_cluster_membership_indicators();
+
+    // Set the number of threads to use when drawing the cluster membership
+    // indicators.
+    void set_number_of_threads(int n) { pool_.set_number_of_threads(n); }
+
+    int truncation_level() const { return truncation_level_; }
+
+    // The log of the current mixing weights, one for each of the
+    // truncation_level() components.
+    const Vector &log_mixing_weights() const { return log_weights_; }
+
+   private:
+    DirichletProcessMvnModel *model_;
+    Ptr<MvnGivenSigma> mean_base_measure_;
+    Ptr<WishartModel> precision_base_measure_;
+    int truncation_level_;
+
+    NormalInverseWishart::NormalInverseWishartParameters posterior_;
+
+    // The component label of each observation, in 0 ..
+    // truncation_level_ - 1.
+    std::vector<int> labels_;
+
+    // The sufficient statistics for the data assigned to each component.
+    std::vector<Ptr<MvnSuf>> suf_;
+
+    // The parameters of each component.  The precision matrices are stored
+    // as their lower Cholesky factors L, with Siginv = L * L^T, so the
+    // quadratic form in each density is the squared norm of L^T (y - mu).
+    // The log normalizing constant of each component is cached alongside.
+    std::vector<Vector> mu_;
+    std::vector<SpdMatrix> siginv_;
+    std::vector<Matrix> precision_cholesky_;
+    Vector log_normalizing_constants_;
+
+    // The log of the stick breaking weights.
+    Vector log_weights_;
+
+    // Per-shard sufficient statistics, accumulated in parallel and combined
+    // in shard order.
+    std::vector<std::vector<Ptr<MvnSuf>>> shard_suf_;
+    SharedThreadPool pool_;
+
+    // Set up labels_ and suf_ the first time draw() is called, or when the
+    // sample size has changed.  Existing cluster indicators in the model
+    // are used if they are valid.  Otherwise all data start in component 0.
+    void initialize_labels();
+
+    // Assign labels for observations [begin, end), adding each observation
+    // to the corresponding element of 'suf'.
+    void draw_labels(int begin, int end, RNG &rng,
+                     std::vector<Ptr<MvnSuf>> &suf);
+
+    // Copy the occupied components, their parameters, and the implied
+    // cluster indicators to the model.
+    void update_model();
+  };
+
+}  // namespace BOOM
+
+#endif  //  BOOM_DIRICHLET_PROCESS_MVN_BLOCKED_GIBBS_SAMPLER_HPP_
@@ -59,6 +59,8 @@ namespace BOOM {
   void DPMCGS::draw_cluster_membership_indicators() {
     const std::vector<Ptr<VectorData> > &data(model_->dat());
     model_->initialize_cluster_membership_probabilities();
+    // The base measure may have changed since the last call.
+    refresh_cluster_posteriors();
     if (model_->cluster_indicators().empty()) {
       // If this is the first time we've been down this code path then
       // cluster_indicators_ will be empty.  Fill it with -1's which
@@ -77,7 +79,7 @@ namespace BOOM {
       model_->set_cluster_indicator(i, -1);
       Vector prob = cluster_membership_probability(y);
       int cluster_number = rmulti_mt(rng(), prob);
-      model_->assign_data_to_cluster(y, cluster_number);
+      assign_data_to_cluster(y, cluster_number);
       model_->set_cluster_indicator(i, cluster_number);
     }
 
@@ -100,6 +102,9 @@ namespace BOOM {
   }
 
   Vector DPMCGS::cluster_membership_probability(const Vector &y) {
+    if (!cluster_posteriors_are_current()) {
+      refresh_cluster_posteriors();
+    }
     Vector ans(model_->number_of_clusters() + 1);
     int n = model_->dat().size();
     // NOTE: there is an optimization opportunity here, because we
@@ -109,10 +114,10 @@ namespace BOOM {
     for (int i = 0; i < model_->number_of_clusters(); ++i) {
       const MvnSuf &suf(*model_->cluster(i).suf());
       ans[i] = log(suf.n()) - log(n - 1 + model_->alpha()) +
-               log_marginal_density(y, suf);
+               log_predictive_density(y, cluster_posteriors_[i]);
     }
     ans.back() = log(model_->alpha()) - log(n - 1 + model_->alpha()) +
-                 log_marginal_density(y, empty_suf_);
+                 log_predictive_density(y, empty_posterior_);
 
     ans.normalize_logprob();
     return ans;
@@ -142,12 +147,30 @@ namespace BOOM {
   }
 
   void DPMCGS::assign_data_to_cluster(const Vector &y, int cluster) {
+    bool in_sync = cluster_posteriors_are_current();
     model_->assign_data_to_cluster(y, cluster);
+    if (!in_sync) {
+      refresh_cluster_posteriors();
+      return;
+    }
+    if (cluster == cluster_posteriors_.size()) {
+      cluster_posteriors_.push_back(empty_posterior_);
+    }
+    add_to_posterior(y, cluster_posteriors_[cluster]);
   }
 
   void DPMCGS::remove_data_from_cluster(const Vector &y, int cluster) {
     bool empty = (model_->cluster(cluster).suf()->n() == 1);
+    bool in_sync = cluster_posteriors_are_current();
     model_->remove_data_from_cluster(y, cluster);
+    if (!in_sync) {
+      refresh_cluster_posteriors();
+    } else if (empty) {
+      cluster_posteriors_.erase(cluster_posteriors_.begin() + cluster);
+    } else if (!remove_from_posterior(y, cluster_posteriors_[cluster])) {
+      compute_cluster_posterior(*model_->cluster(cluster).suf(),
+                                cluster_posteriors_[cluster]);
+    }
     // If this is the last data point in the cluster, then removing it will make
     // the cluster empty.  Decrement cluster indicators for clusters numbered
     // larger than 'cluster' to account for the fact that 'cluster' no longer
@@ -162,4 +185,77 @@ namespace BOOM {
     }
   }
 
+  bool DPMCGS::cluster_posteriors_are_current() const {
+    return empty_posterior_.sum_of_squares.is_pos_def() &&
+           cluster_posteriors_.size() == model_->number_of_clusters();
+  }
+
+  void DPMCGS::refresh_cluster_posteriors() {
+    int nclusters = model_->number_of_clusters();
+    cluster_posteriors_.resize(nclusters);
+    for (int i = 0; i < nclusters; ++i) {
+      compute_cluster_posterior(*model_->cluster(i).suf(),
+                                cluster_posteriors_[i]);
+    }
+    compute_cluster_posterior(empty_suf_, empty_posterior_);
+  }
+
+  void DPMCGS::compute_cluster_posterior(const MvnSuf &suf,
+                                         ClusterPosterior &posterior) const {
+    posterior_.compute_mvn_posterior(suf);
+    posterior.mean_sample_size = posterior_.mean_sample_size();
+    posterior.variance_sample_size = posterior_.variance_sample_size();
+    posterior.mean = posterior_.mean();
+    posterior.sum_of_squares.decompose(posterior_.sum_of_squares());
+  }
+
+  // Adding y to a cluster with posterior parameters (kappa, mu, nu, S) gives
+  //   kappa' = kappa + 1,  nu' = nu + 1,
+  //   mu' = (kappa * mu + y) / (kappa + 1),
+  //   S' = S + kappa / (kappa + 1) * (y - mu) (y - mu)^T.
+  void DPMCGS::add_to_posterior(const Vector &y,
+                                ClusterPosterior &posterior) const {
+    double kappa = posterior.mean_sample_size;
+    Vector residual = y - posterior.mean;
+    posterior.mean.axpy(residual, 1.0 / (kappa + 1));
+    residual *= std::sqrt(kappa / (kappa + 1));
+    posterior.sum_of_squares.rank_one_update(residual);
+    posterior.mean_sample_size += 1;
+    posterior.variance_sample_size += 1;
+  }
+
+  bool DPMCGS::remove_from_posterior(const Vector &y,
+                                     ClusterPosterior &posterior) const {
+    double kappa = posterior.mean_sample_size - 1;
+    Vector mean = posterior.mean * (kappa + 1);
+    mean -= y;
+    mean /= kappa;
+    Vector residual = y - mean;
+    residual *= std::sqrt(kappa / (kappa + 1));
+    if (!posterior.sum_of_squares.rank_one_downdate(residual)) {
+      return false;
+    }
+    posterior.mean = mean;
+    posterior.mean_sample_size = kappa;
+    posterior.variance_sample_size -= 1;
+    return true;
+  }
+
+  // This is log_marginal_density expressed in terms of the cluster posterior.
+  // With r = y - mu and c = kappa / (kappa + 1), the determinant of the
+  // updated sum of squares is |S| * (1 + c * r^T S^{-1} r), so only one
+  // triangular solve is needed.
+  double DPMCGS::log_predictive_density(
+      const Vector &y, const ClusterPosterior &posterior) const {
+    double kappa = posterior.mean_sample_size;
+    double nu = posterior.variance_sample_size;
+    double c = kappa / (kappa + 1);
+    double quadratic_form =
+        posterior.sum_of_squares.lower_solve(y - posterior.mean).normsq();
+    int dim = y.size();
+    return 0.5 * dim * log(c) - 0.5 * posterior.sum_of_squares.logdet() -
+           0.5 * (nu + 1) * log1p(c * quadratic_form) +
+           lmultigamma_ratio(nu / 2.0, 1, dim);
+  }
+
 }  // namespace BOOM
@@ -22,6 +22,7 @@
 
 #include "Models/Mixtures/DirichletProcessMvnModel.hpp"
 
+#include "LinAlg/Cholesky.hpp"
 #include "Models/MvnGivenSigma.hpp"
 #include "Models/PosteriorSamplers/MvnConjSampler.hpp"
 #include "Models/PosteriorSamplers/PosteriorSampler.hpp"
@@ -70,6 +71,9 @@ namespace BOOM {
     // Compute the discrete probability distribution of cluster
     // membership for observation y, which is currently unassigned,
     // conditional on the cluster membership of the other data points.
+    //
+    // This uses the cached posterior for each cluster, so each cluster
+    // costs one triangular solve.
     Vector cluster_membership_probability(const Vector &y);
 
     // Returns the log marginal density of y given a cluster of other
@@ -77,6 +81,9 @@ namespace BOOM {
     // the integral of p(y | theta) * p(theta | suf) with respect to
     // theta.  For the math, see Murphy (Machine Learning: A
     // probabilistic perspective) page 161 (eq: 5.29).
+    //
+    // This function computes the posterior from scratch.  It is much slower
+    // than the cached version used by cluster_membership_probability.
     double log_marginal_density(const Vector &y, const MvnSuf &suf) const;
 
     // Assign the (currently unassigned) observation to the given
@@ -93,12 +100,53 @@ namespace BOOM {
     void remove_data_from_cluster(const Vector &y, int cluster);
 
    private:
+    // The normal inverse Wishart posterior given the data in a cluster, in
+    // the form needed to evaluate the predictive density of a new
+    // observation.  The Cholesky factor of the sum of squares is kept up to
+    // date with rank one updates as data enter and leave the cluster.
+    struct ClusterPosterior {
+      double mean_sample_size;
+      double variance_sample_size;
+      Vector mean;
+      Cholesky sum_of_squares;
+    };
+
+    // Returns true if cluster_posteriors_ has been initialized and has one
+    // element per cluster in the model.
+    bool cluster_posteriors_are_current() const;
+
+    // Rebuild cluster_posteriors_ and empty_posterior_ from the model's
+    // sufficient statistics.
+    void refresh_cluster_posteriors();
+
+    // Set 'posterior' to the posterior distribution given 'suf'.
+    void compute_cluster_posterior(const MvnSuf &suf,
+                                   ClusterPosterior &posterior) const;
+
+    // Add y to, or remove y from, the data summarized by 'posterior'.
+    // Removal returns false if the downdated sum of squares is not
+    // numerically positive definite, in which case 'posterior' should be
+    // recomputed from the cluster's sufficient statistics.
+    void add_to_posterior(const Vector &y, ClusterPosterior &posterior) const;
+    bool remove_from_posterior(const Vector &y,
+                               ClusterPosterior &posterior) const;
+
+    // The log of the posterior predictive density of y, up to the same
+    // constant omitted by log_marginal_density.
+    double log_predictive_density(const Vector &y,
+                                  const ClusterPosterior &posterior) const;
+
     DirichletProcessMvnModel *model_;
     Ptr<MvnGivenSigma> mean_base_measure_;
     Ptr<WishartModel> precision_base_measure_;
 
     MvnSuf empty_suf_;
 
+    // cluster_posteriors_[i] is the posterior given the data in cluster i.
+    // empty_posterior_ is the prior, used for a new cluster.
+    std::vector<ClusterPosterior> cluster_posteriors_;
+    ClusterPosterior empty_posterior_;
+
     mutable NormalInverseWishart::NormalInverseWishartParameters prior_;
     mutable NormalInverseWishart::NormalInverseWishartParameters posterior_;
   };
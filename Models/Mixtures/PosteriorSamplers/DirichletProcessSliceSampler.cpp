@@ -18,6 +18,8 @@
 */
 
 #include "Models/Mixtures/PosteriorSamplers/DirichletProcessSliceSampler.hpp"
+#include <algorithm>
+#include <numeric>
 #include "cpputil/lse.hpp"
 #include "cpputil/math_utils.hpp"
 #include "cpputil/report_error.hpp"
@@ -42,7 +44,8 @@ namespace BOOM {
         max_clusters_(model_->number_of_observations(), initial_clusters),
         global_max_clusters_(initial_clusters),
         first_time_(true),
-        split_merge_strategy_(nullptr) {}
+        split_merge_strategy_(nullptr),
+        split_merge_batch_size_(1) {}
 
   //----------------------------------------------------------------------
   void DPSS::draw() {
@@ -203,6 +206,13 @@ namespace BOOM {
     split_merge_strategy_.reset(strategy);
   }
 
+  void DPSS::set_split_merge_batch_size(int batch_size) {
+    if (batch_size < 1) {
+      report_error("The split-merge batch size must be positive.");
+    }
+    split_merge_batch_size_ = batch_size;
+  }
+
   // TODO: only do split_merge with some probability, because it is
   // expensive.
   void DPSS::split_merge_move() {
@@ -213,6 +223,10 @@ namespace BOOM {
       // done here.
       return;
     }
+    if (split_merge_batch_size_ > 1) {
+      batched_split_merge_move();
+      return;
+    }
     int first_index = random_int_mt(rng(), 0, n - 1);
     int second_index = first_index;
     while (second_index == first_index) {
@@ -230,6 +244,67 @@ namespace BOOM {
     draw_stick_fractions_given_mixture_indicators();
   }
 
+  //----------------------------------------------------------------------
+  void DPSS::batched_split_merge_move() {
+    int attempts = 0;
+    while (attempts < split_merge_batch_size_) {
+      std::vector<SplitMerge::ProposalSeeds> seeds =
+          choose_proposal_seeds(split_merge_batch_size_ - attempts);
+      std::vector<SplitMerge::Proposal> proposals;
+      {
+        MoveTimer timer = move_accounting_.start_time("SplitMergeBatch");
+        proposals = split_merge_strategy_->propose_moves(seeds, rng(), pool_);
+      }
+      for (const auto &proposal : proposals) {
+        ++attempts;
+        const std::string move_type = proposal.is_merge() ? "Merge" : "Split";
+        double log_MH_alpha = log_MH_probability(proposal);
+        double logu = log(runif_mt(rng(), 0, 1));
+        if (logu < log_MH_alpha) {
+          model_->accept_split_merge_proposal(proposal);
+          move_accounting_.record_acceptance(move_type);
+          // The remaining proposals were made from the old state.
+          break;
+        } else {
+          move_accounting_.record_rejection(move_type);
+        }
+      }
+      draw_stick_fractions_given_mixture_indicators();
+    }
+  }
+
+  //----------------------------------------------------------------------
+  std::vector<SplitMerge::ProposalSeeds> DPSS::choose_proposal_seeds(
+      int max_proposals) {
+    std::vector<int> eligible(model_->number_of_observations());
+    std::iota(eligible.begin(), eligible.end(), 0);
+    std::vector<SplitMerge::ProposalSeeds> ans;
+    while (ans.size() < max_proposals && eligible.size() >= 2) {
+      int n = eligible.size();
+      int first = random_int_mt(rng(), 0, n - 1);
+      int second = first;
+      while (second == first) {
+        second = random_int_mt(rng(), 0, n - 1);
+      }
+      SplitMerge::ProposalSeeds seeds;
+      seeds.data_index_1 = eligible[first];
+      seeds.data_index_2 = eligible[second];
+      int cluster_1 = model_->cluster_indicator(seeds.data_index_1);
+      int cluster_2 = model_->cluster_indicator(seeds.data_index_2);
+      seeds.type = cluster_1 == cluster_2 ? SplitMerge::Proposal::Split
+                                          : SplitMerge::Proposal::Merge;
+      ans.push_back(seeds);
+      eligible.erase(
+          std::remove_if(eligible.begin(), eligible.end(),
+                         [&](int i) {
+                           int cluster = model_->cluster_indicator(i);
+                           return cluster == cluster_1 || cluster == cluster_2;
+                         }),
+          eligible.end());
+    }
+    return ans;
+  }
+
   //----------------------------------------------------------------------
   void DPSS::attempt_merge_move(int data_index_1, int data_index_2) {
     // if (print_mcmc_details) {
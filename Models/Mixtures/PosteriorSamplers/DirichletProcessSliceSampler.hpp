@@ -97,6 +97,25 @@ namespace BOOM {
     // can be resolved.
     void set_split_merge_strategy(SplitMerge::ProposalStrategy *strategy);
 
+    // The number of split-merge moves attempted in each draw().  The default
+    // is 1.
+    //
+    // With a batch size of more than 1, seed pairs are chosen so that no
+    // mixture component is involved in more than one proposal, and the
+    // proposals are generated together, with the costly allocation step for
+    // each proposal run in its own thread.  The proposals are then evaluated
+    // one at a time.  A rejection leaves the model unchanged, so the next
+    // proposal is still a valid proposal from the current state.  After an
+    // acceptance the remaining proposals are stale, so they are discarded and
+    // a new batch is generated from the new state.  Each move is therefore an
+    // ordinary Metropolis-Hastings step, and a batch of size k is equivalent
+    // to k sequential moves with seeds restricted to unused components.
+    void set_split_merge_batch_size(int batch_size);
+
+    // Split-merge proposals in a batch are generated concurrently using this
+    // many threads.  Draws do not depend on the number of threads.
+    void set_number_of_threads(int n) { pool_.set_number_of_threads(n); }
+
     void split_merge_move();
 
     // Attempt, using Metropolis-Hastings, to merge the components containing
@@ -152,6 +171,8 @@ namespace BOOM {
 
     // Proposes split and merge moves.
     std::unique_ptr<SplitMerge::ProposalStrategy> split_merge_strategy_;
+    int split_merge_batch_size_;
+    SharedThreadPool pool_;
 
     // Keeps track of how often different MH moves are tried, and their success
     // rates.
@@ -159,6 +180,16 @@ namespace BOOM {
 
     // Allocates data to clusters uniformly at random.  Used for initialization.
     void randomly_allocate_data_to_clusters();
+
+    // The version of split_merge_move() used when split_merge_batch_size_ >
+    // 1.
+    void batched_split_merge_move();
+
+    // Choose up to 'max_proposals' pairs of seed observations, uniformly at
+    // random, such that no mixture component contains observations from more
+    // than one pair.
+    std::vector<SplitMerge::ProposalSeeds> choose_proposal_seeds(
+        int max_proposals);
   };
 
 }  // namespace BOOM
@@ -165,6 +165,26 @@ namespace BOOM {
       return split_mixing_weights_[split2_->mixture_component_index()];
     }
 
+    //--------------------------------------------------------------------------
+    std::vector<Proposal> ProposalStrategy::propose_moves(
+        const std::vector<ProposalSeeds> &seeds, RNG &rng,
+        SharedThreadPool &pool) {
+      std::vector<Proposal> ans;
+      ans.reserve(seeds.size());
+      RNG::RngIntType seed = seed_rng(rng);
+      for (int k = 0; k < seeds.size(); ++k) {
+        RNG proposal_rng(seed, k);
+        if (seeds[k].type == Proposal::Split) {
+          ans.push_back(propose_split(seeds[k].data_index_1,
+                                      seeds[k].data_index_2, proposal_rng));
+        } else {
+          ans.push_back(propose_merge(seeds[k].data_index_1,
+                                      seeds[k].data_index_2, proposal_rng));
+        }
+      }
+      return ans;
+    }
+
     //======================================================================
     SOSS::SingleObservationSplitStrategy(DirichletProcessMixtureModel *model,
                                          double annealing_factor)
@@ -172,14 +192,84 @@ namespace BOOM {
 
     //--------------------------------------------------------------------------
     Proposal SOSS::propose_split(int data_index_1, int data_index_2, RNG &rng) {
+      PartialProposal partial(Proposal::Split, data_index_1, data_index_2);
+      start_split(partial, rng);
+      allocate(partial, rng);
+      finish_split(partial, rng);
+      return partial.proposal;
+    }
+
+    //--------------------------------------------------------------------------
+    Proposal SOSS::propose_merge(int data_index_1, int data_index_2, RNG &rng) {
+      PartialProposal partial(Proposal::Merge, data_index_1, data_index_2);
+      start_merge(partial);
+      allocate(partial, rng);
+      finish_merge(partial, rng);
+      return partial.proposal;
+    }
+
+    //--------------------------------------------------------------------------
+    std::vector<Proposal> SOSS::propose_moves(
+        const std::vector<ProposalSeeds> &seeds, RNG &rng,
+        SharedThreadPool &pool) {
+      std::set<int> components;
+      for (const auto &el : seeds) {
+        int component_1 = model_->cluster_indicator(el.data_index_1);
+        int component_2 = model_->cluster_indicator(el.data_index_2);
+        bool disjoint = components.insert(component_1).second;
+        if (component_2 != component_1) {
+          disjoint = components.insert(component_2).second && disjoint;
+        }
+        if (!disjoint) {
+          report_error("Each mixture component may be involved in at most "
+                       "one proposal.");
+        }
+      }
+
+      RNG::RngIntType seed = seed_rng(rng);
+      std::vector<RNG> rngs;
+      std::vector<PartialProposal> partials;
+      rngs.reserve(seeds.size());
+      partials.reserve(seeds.size());
+      for (int k = 0; k < seeds.size(); ++k) {
+        rngs.emplace_back(seed, k);
+        partials.emplace_back(seeds[k].type, seeds[k].data_index_1,
+                              seeds[k].data_index_2);
+        if (seeds[k].type == Proposal::Split) {
+          start_split(partials.back(), rngs.back());
+        } else {
+          start_merge(partials.back());
+        }
+      }
+
+      pool.parallel_for(0, partials.size(), 1, [&](int k) {
+        allocate(partials[k], rngs[k]);
+      });
+
+      std::vector<Proposal> ans;
+      ans.reserve(partials.size());
+      for (int k = 0; k < partials.size(); ++k) {
+        if (partials[k].proposal.is_merge()) {
+          finish_merge(partials[k], rngs[k]);
+        } else {
+          finish_split(partials[k], rngs[k]);
+        }
+        ans.push_back(partials[k].proposal);
+      }
+      return ans;
+    }
+
+    //--------------------------------------------------------------------------
+    void SOSS::start_split(PartialProposal &partial, RNG &rng) {
+      int data_index_1 = partial.proposal.data_index_1();
+      int data_index_2 = partial.proposal.data_index_2();
       int component_index = model_->cluster_indicator(data_index_1);
       if (component_index != model_->cluster_indicator(data_index_2)) {
         report_error(
             "Both data points must belong to the same cluster "
             "in order to attempt a split move.");
       }
-
-      Proposal proposal(Proposal::Split, data_index_1, data_index_2);
+      partial.component_index = component_index;
 
       // Initialize the two mixture components split1 and split2.  The
       // parameters for split1 are equal to the original component.  The
@@ -187,30 +277,88 @@ namespace BOOM {
       // single data point at data_index_2.  Each component has its seed
       // observation assigned.  The initialize function removes observations 1
       // and 2 from the data set.
-      Ptr<DpMixtureComponent> original_component =
-          model_->component(component_index);
-      std::set<Ptr<Data>> data_set(original_component->abstract_data_set());
-      Ptr<DpMixtureComponent> split1 = initialize_split_proposal(
-          original_component, data_set, data_index_1, false, rng);
-      Ptr<DpMixtureComponent> split2 = initialize_split_proposal(
-          original_component, data_set, data_index_2, true, rng);
-      if (split2->mixture_component_index() <=
-          split1->mixture_component_index()) {
+      partial.merged = model_->component(component_index);
+      partial.data_set = partial.merged->abstract_data_set();
+      partial.split1 = initialize_split_proposal(
+          partial.merged, partial.data_set, data_index_1, false, rng);
+      partial.split2 = initialize_split_proposal(
+          partial.merged, partial.data_set, data_index_2, true, rng);
+      if (partial.split2->mixture_component_index() <=
+          partial.split1->mixture_component_index()) {
         // split2 will be inserted at its mixture_index.  If it comes before
         // split1 then split1 will be shifted one unit to the right.
-        split1->increment_mixture_component_index();
+        partial.split1->increment_mixture_component_index();
       }
-      Ptr<DpMixtureComponent> empty = split2->clone();
-      empty->clear_data();
-      empty->set_mixture_component_index(model_->number_of_components());
-      model_->base_distribution()->draw_model_parameters(*empty);
+      partial.empty = partial.split2->clone();
+      partial.empty->clear_data();
+      partial.empty->set_mixture_component_index(
+          model_->number_of_components());
+      model_->base_distribution()->draw_model_parameters(*partial.empty);
+    }
 
-      // Allocate observations to components using annealed likelihood, with
-      // equal prior mising weights.
-      double log_partition_probability = allocate_data_between_split_components(
-          split1.get(), split2.get(), data_set, rng);
+    //--------------------------------------------------------------------------
+    void SOSS::start_merge(PartialProposal &partial) {
+      int data_index_1 = partial.proposal.data_index_1();
+      int data_index_2 = partial.proposal.data_index_2();
+      int component_index_1 = model_->cluster_indicator(data_index_1);
+      int component_index_2 = model_->cluster_indicator(data_index_2);
+      if (component_index_1 == component_index_2) {
+        report_error(
+            "Merge move cannot be attempted with data points "
+            "in the same cluster");
+      }
 
-      proposal.set_components(original_component, empty, split1, split2);
+      // Initialize the merged and empty components.  The merged component has
+      // the same parameters as split1, and all the data from split1 and
+      // split2.
+      partial.split1 = model_->component(component_index_1);
+      partial.split2 = model_->component(component_index_2);
+      partial.merged = partial.split1->clone();
+      partial.merged->clear_data();
+      partial.merged->combine_data(*partial.split1, false);
+      partial.merged->combine_data(*partial.split2, false);
+      partial.merged->set_mixture_component_index(component_index_1);
+      if (component_index_2 < component_index_1) {
+        // If split2 is to the left of split1 then it will be removed as part of
+        // the merge, so the index for merged will be one less than that of
+        // split1.
+        partial.merged->decrement_mixture_component_index();
+      }
+
+      // Set the parameters for *empty to a draw from p(theta | observation 2).
+      partial.empty = partial.split2->clone();
+      partial.empty->clear_data();
+      partial.empty->add_data(model_->dat()[data_index_2]);
+      sample_parameters(*partial.empty);
+      partial.empty->clear_data();
+      partial.empty->set_mixture_component_index(
+          model_->number_of_components());
+    }
+
+    //--------------------------------------------------------------------------
+    void SOSS::allocate(PartialProposal &partial, RNG &rng) const {
+      if (partial.proposal.is_merge()) {
+        partial.log_partition_probability = compute_log_partition_probability(
+            partial.split1, partial.split2, partial.proposal.data_index_1(),
+            partial.proposal.data_index_2());
+      } else {
+        // Allocate observations to components using annealed likelihood, with
+        // equal prior mising weights.
+        partial.log_partition_probability =
+            allocate_data_between_split_components(
+                partial.split1.get(), partial.split2.get(), partial.data_set,
+                rng);
+        partial.data_set.clear();
+      }
+    }
+
+    //--------------------------------------------------------------------------
+    void SOSS::finish_split(PartialProposal &partial, RNG &rng) {
+      Proposal &proposal(partial.proposal);
+      const Ptr<DpMixtureComponent> &split1(partial.split1);
+      const Ptr<DpMixtureComponent> &split2(partial.split2);
+      int component_index = partial.component_index;
+      proposal.set_components(partial.merged, partial.empty, split1, split2);
 
       // Compute the mixing weights for the two components.  The final element
       // of original_mixing_weights corresponds to unseen components in the
@@ -245,12 +393,11 @@ namespace BOOM {
       proposal.set_mixing_weights(original_mixing_weights,
                                   split_mixing_weights);
 
-      // Set the final element, check that everything has been set, and return
-      // the proposal.
+      // Set the final element, check that everything has been set.
       proposal.set_log_proposal_density_ratio(split_log_proposal_density_ratio(
-          proposal, log_partition_probability, data_index_2));
+          proposal, partial.log_partition_probability,
+          proposal.data_index_2()));
       proposal.check();
-      return proposal;
     }
 
     //----------------------------------------------------------------------
@@ -341,41 +488,14 @@ namespace BOOM {
     }
 
     //----------------------------------------------------------------------
-    Proposal SOSS::propose_merge(int data_index_1, int data_index_2, RNG &rng) {
-      int component_index_1 = model_->cluster_indicator(data_index_1);
-      int component_index_2 = model_->cluster_indicator(data_index_2);
-      if (component_index_1 == component_index_2) {
-        report_error(
-            "Merge move cannot be attempted with data points "
-            "in the same cluster");
-      }
-      Proposal proposal(Proposal::Merge, data_index_1, data_index_2);
-
-      // Initialize the merged and empty components.  The merged component has
-      // the same parameters as split1, and all the data from split1 and
-      // split2.
-      Ptr<DpMixtureComponent> split1 = model_->component(component_index_1);
-      Ptr<DpMixtureComponent> split2 = model_->component(component_index_2);
-      Ptr<DpMixtureComponent> merged = split1->clone();
-      merged->clear_data();
-      merged->combine_data(*split1, false);
-      merged->combine_data(*split2, false);
-      merged->set_mixture_component_index(component_index_1);
-      if (component_index_2 < component_index_1) {
-        // If split2 is to the left of split1 then it will be removed as part of
-        // the merge, so the index for merged will be one less than that of
-        // split1.
-        merged->decrement_mixture_component_index();
-      }
-
-      // Set the parameters for *empty to a draw from p(theta | observation 2).
-      Ptr<DpMixtureComponent> empty = split2->clone();
-      empty->clear_data();
-      empty->add_data(model_->dat()[data_index_2]);
-      sample_parameters(*empty);
-      empty->clear_data();
-      empty->set_mixture_component_index(model_->number_of_components());
-      proposal.set_components(merged, empty, split1, split2);
+    void SOSS::finish_merge(PartialProposal &partial, RNG &rng) {
+      Proposal &proposal(partial.proposal);
+      int component_index_1 =
+          model_->cluster_indicator(proposal.data_index_1());
+      int component_index_2 =
+          model_->cluster_indicator(proposal.data_index_2());
+      proposal.set_components(partial.merged, partial.empty, partial.split1,
+                              partial.split2);
 
       // Remove the 'all other components' mixing weight from the end of
       // split_mixing_weights.
@@ -386,7 +506,7 @@ namespace BOOM {
       double split2_mixing_weight = split_mixing_weights[component_index_2];
       double total_mixing_weight = split1_mixing_weight + split2_mixing_weight;
       double alpha = model_->concentration_parameter();
-      double n0 = merged->number_of_observations();
+      double n0 = partial.merged->number_of_observations();
       double empty_mixing_weight_fraction = rbeta_mt(rng, 1, alpha + n0);
 
       double merged_mixing_weight =
@@ -401,13 +521,10 @@ namespace BOOM {
                     merged_mixing_weights.size() - 1);
 
       proposal.set_mixing_weights(merged_mixing_weights, split_mixing_weights);
-
-      double log_partition_probability = compute_log_partition_probability(
-          split1, split2, data_index_1, data_index_2);
       proposal.set_log_proposal_density_ratio(split_log_proposal_density_ratio(
-          proposal, log_partition_probability, data_index_2));
+          proposal, partial.log_partition_probability,
+          proposal.data_index_2()));
       proposal.check();
-      return proposal;
     }
 
     //----------------------------------------------------------------------
@@ -20,7 +20,10 @@
 #ifndef BOOM_DIRICHLET_PROCESS_SPLIT_MERGE_PROPOSALS_HPP_
 #define BOOM_DIRICHLET_PROCESS_SPLIT_MERGE_PROPOSALS_HPP_
 
+#include <set>
+#include <vector>
 #include "Models/Mixtures/DirichletProcessMixture.hpp"
+#include "cpputil/ThreadTools.hpp"
 #include "distributions/rng.hpp"
 
 namespace BOOM {
@@ -190,6 +193,16 @@ namespace BOOM {
       Vector merged_mixing_weights_;
     };
 
+    //======================================================================
+    // The pair of observations used to seed a split or merge proposal.  In a
+    // split both observations belong to the same mixture component, and in a
+    // merge they belong to different components.
+    struct ProposalSeeds {
+      Proposal::ProposalType type;
+      int data_index_1;
+      int data_index_2;
+    };
+
     //======================================================================
     class ProposalStrategy {
      public:
@@ -205,6 +218,17 @@ namespace BOOM {
       // data_index_2, which must belong to different components.
       virtual Proposal propose_merge(int data_index_1, int data_index_2,
                                      RNG &rng) = 0;
+
+      // Propose one move for each element of 'seeds'.  All the proposals are
+      // made from the current state of the model, so no mixture component
+      // may be involved in more than one of them.
+      //
+      // Proposal k is made with its own RNG stream, seeded from 'rng', so
+      // the proposals do not depend on the number of threads in 'pool'.  The
+      // default implementation makes the proposals one at a time.
+      virtual std::vector<Proposal> propose_moves(
+          const std::vector<ProposalSeeds> &seeds, RNG &rng,
+          SharedThreadPool &pool);
     };
 
     //======================================================================
@@ -239,6 +263,15 @@ namespace BOOM {
       Proposal propose_merge(int data_index_1, int data_index_2,
                              RNG &rng) override;
 
+      // Allocating the data between the split components (or, for a merge,
+      // finding the probability of the current allocation) is most of the
+      // work in a proposal, and is done concurrently for the different
+      // proposals.  The remaining steps use the base distribution, which is
+      // not thread safe, and are done serially.
+      std::vector<Proposal> propose_moves(
+          const std::vector<ProposalSeeds> &seeds, RNG &rng,
+          SharedThreadPool &pool) override;
+
       // Returns the log of the proposal density ratio for the split move.
       // I.e. the log of p(from merged to split) / p(from split to merged). The
       // procedure for proposing splits and merges is described elsewhere.
@@ -343,6 +376,45 @@ namespace BOOM {
           const Ptr<DirichletProcessMixtureComponent> &other_component,
           int data_index) const;
 
+     private:
+      // A proposal under construction.  Proposals are built in three
+      // stages: start_split or start_merge, then allocate, then
+      // finish_split or finish_merge.
+      struct PartialProposal {
+        PartialProposal(Proposal::ProposalType type, int data_index_1,
+                        int data_index_2)
+            : proposal(type, data_index_1, data_index_2),
+              component_index(-1),
+              log_partition_probability(0) {}
+        Proposal proposal;
+        Ptr<DirichletProcessMixtureComponent> merged;
+        Ptr<DirichletProcessMixtureComponent> empty;
+        Ptr<DirichletProcessMixtureComponent> split1;
+        Ptr<DirichletProcessMixtureComponent> split2;
+
+        // For a split, the index of the component being split, and the data
+        // (other than the seeds) to be allocated between split1 and split2.
+        int component_index;
+        std::set<Ptr<Data>> data_set;
+
+        double log_partition_probability;
+      };
+
+      // Create the components involved in the proposal.  These steps use
+      // the base distribution.
+      void start_split(PartialProposal &partial, RNG &rng);
+      void start_merge(PartialProposal &partial);
+
+      // Fill partial.log_partition_probability, allocating the data between
+      // the split components if the proposal is a split.  This step touches
+      // only the components in 'partial', so it can run concurrently with
+      // the same step for proposals involving other components.
+      void allocate(PartialProposal &partial, RNG &rng) const;
+
+      // Draw the mixing weights and compute the proposal density ratio.
+      void finish_split(PartialProposal &partial, RNG &rng);
+      void finish_merge(PartialProposal &partial, RNG &rng);
+
       DirichletProcessMixtureModel *model_;
       const double annealing_factor_;
     };
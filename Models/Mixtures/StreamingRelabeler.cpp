@@ -0,0 +1,204 @@
+/*
+  Copyright (C) 2005-2024 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include "Models/Mixtures/StreamingRelabeler.hpp"
+
+#include <cmath>
+
+#include "cpputil/ThreadTools.hpp"
+#include "cpputil/report_error.hpp"
+#include "cpputil/seq.hpp"
+#include "numopt/LinearAssignment.hpp"
+
+namespace BOOM {
+
+  StreamingRelabeler::StreamingRelabeler(int number_of_clusters)
+      : number_of_clusters_(number_of_clusters),
+        type_(UNSET),
+        number_of_draws_(0),
+        total_cost_(0.0),
+        pool_(nullptr) {
+    if (number_of_clusters <= 0) {
+      report_error("StreamingRelabeler needs at least one cluster.");
+    }
+  }
+
+  std::vector<int> StreamingRelabeler::relabel_probs(const Matrix &probs) {
+    return relabel_batch(std::vector<Matrix>(1, probs), PROBS)[0];
+  }
+
+  std::vector<int> StreamingRelabeler::relabel_features(
+      const Matrix &features) {
+    return relabel_batch(std::vector<Matrix>(1, features), FEATURES)[0];
+  }
+
+  std::vector<std::vector<int>> StreamingRelabeler::relabel_probs_batch(
+      const std::vector<Matrix> &probs) {
+    return relabel_batch(probs, PROBS);
+  }
+
+  std::vector<std::vector<int>> StreamingRelabeler::relabel_features_batch(
+      const std::vector<Matrix> &features) {
+    return relabel_batch(features, FEATURES);
+  }
+
+  std::vector<std::vector<int>> StreamingRelabeler::relabel_batch(
+      const std::vector<Matrix> &draws, PivotType type) {
+    for (const auto &draw : draws) {
+      check_draw(draw, type);
+    }
+    int ndraws = draws.size();
+    std::vector<std::vector<int>> ans(ndraws);
+    int first = 0;
+    if (number_of_draws_ == 0 && ndraws > 0) {
+      // Without a pivot every labeling is equally good, so the first draw
+      // defines the labels.
+      ans[0] = seq<int>(0, number_of_clusters_ - 1);
+      update_pivot(draws[0], ans[0]);
+      first = 1;
+    }
+
+    std::vector<double> costs(ndraws, 0.0);
+    auto solve = [&](int i) {
+      LinearAssignment lap(cost_matrix(draws[i]));
+      costs[i] = lap.solve();
+      ans[i].assign(lap.row_solution().begin(), lap.row_solution().end());
+    };
+    if (pool_) {
+      pool_->parallel_for(first, ndraws, 1, solve);
+    } else {
+      for (int i = first; i < ndraws; ++i) solve(i);
+    }
+
+    for (int i = first; i < ndraws; ++i) {
+      total_cost_ += costs[i];
+      update_pivot(draws[i], ans[i]);
+    }
+    return ans;
+  }
+
+  void StreamingRelabeler::check_draw(const Matrix &draw, PivotType type) {
+    if (type == PROBS) {
+      if (draw.ncol() != number_of_clusters_) {
+        report_error("Membership probabilities must have one column per "
+                     "cluster.");
+      }
+    } else if (draw.nrow() != number_of_clusters_) {
+      report_error("Cluster features must have one row per cluster.");
+    }
+
+    if (type_ == UNSET) {
+      type_ = type;
+      if (type == PROBS) {
+        pivot_mean_.resize(draw.nrow(), number_of_clusters_);
+        pivot_mean_ = 1.0 / number_of_clusters_;
+        pivot_log_mean_ = log(pivot_mean_);
+      } else {
+        pivot_mean_.resize(number_of_clusters_, draw.ncol());
+        pivot_mean_ = 0.0;
+        pivot_sum_of_squares_ = pivot_mean_;
+        feature_variance_.resize(draw.ncol());
+        feature_variance_ = 1.0;
+      }
+    } else if (type != type_) {
+      report_error("A StreamingRelabeler cannot mix membership probabilities "
+                   "and cluster features.");
+    }
+
+    if (draw.nrow() != pivot_mean_.nrow()
+        || draw.ncol() != pivot_mean_.ncol()) {
+      report_error("All draws passed to a StreamingRelabeler must have the "
+                   "same dimensions.");
+    }
+  }
+
+  Matrix StreamingRelabeler::cost_matrix(const Matrix &draw) const {
+    int S = number_of_clusters_;
+    Matrix ans(S, S);
+    if (type_ == PROBS) {
+      // cost(i, j) = sum_n p(n, j) * (log p(n, j) - log pivot(n, i)), the KL
+      // divergence of the pivot's cluster i from the draw's cluster j.
+      Matrix cross = draw.Tmult(pivot_log_mean_);
+      for (int j = 0; j < S; ++j) {
+        double negative_entropy = 0;
+        ConstVectorView p(draw.col(j));
+        for (int n = 0; n < p.size(); ++n) {
+          if (p[n] > 0) negative_entropy += p[n] * std::log(p[n]);
+        }
+        for (int i = 0; i < S; ++i) {
+          ans(i, j) = negative_entropy - cross(j, i);
+        }
+      }
+    } else {
+      int dim = draw.ncol();
+      for (int i = 0; i < S; ++i) {
+        for (int j = 0; j < S; ++j) {
+          double distance = 0;
+          for (int k = 0; k < dim; ++k) {
+            double diff = draw(j, k) - pivot_mean_(i, k);
+            distance += diff * diff / feature_variance_[k];
+          }
+          ans(i, j) = distance;
+        }
+      }
+    }
+    return ans;
+  }
+
+  void StreamingRelabeler::update_pivot(const Matrix &draw,
+                                        const std::vector<int> &permutation) {
+    int S = number_of_clusters_;
+    double n = number_of_draws_;
+    if (type_ == PROBS) {
+      // The pivot is the mean of the relabeled draws and a prior draw of
+      // 1/S, so after n draws it has weight n + 1.
+      for (int k = 0; k < S; ++k) {
+        VectorView mean(pivot_mean_.col(k));
+        mean += (draw.col(permutation[k]) - mean) / (n + 2);
+      }
+    } else {
+      for (int k = 0; k < S; ++k) {
+        ConstVectorView x(draw.row(permutation[k]));
+        VectorView mean(pivot_mean_.row(k));
+        VectorView sum_of_squares(pivot_sum_of_squares_.row(k));
+        for (int d = 0; d < x.size(); ++d) {
+          double delta = x[d] - mean[d];
+          mean[d] += delta / (n + 1);
+          sum_of_squares[d] += delta * (x[d] - mean[d]);
+        }
+      }
+    }
+    ++number_of_draws_;
+    refresh_pivot();
+  }
+
+  void StreamingRelabeler::refresh_pivot() {
+    if (type_ == PROBS) {
+      pivot_log_mean_ = log(pivot_mean_);
+    } else if (number_of_draws_ > 1) {
+      // Pool the within-cluster variance of each feature across clusters,
+      // so that features on different scales get comparable weight.
+      double df = number_of_clusters_ * (number_of_draws_ - 1.0);
+      for (int d = 0; d < feature_variance_.size(); ++d) {
+        double variance = pivot_sum_of_squares_.col(d).sum() / df;
+        feature_variance_[d] = variance > 0 ? variance : 1.0;
+      }
+    }
+  }
+
+}  // namespace BOOM
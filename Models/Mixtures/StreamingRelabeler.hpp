@@ -0,0 +1,137 @@
+#ifndef BOOM_MODELS_MIXTURES_STREAMING_RELABELER_HPP_
+#define BOOM_MODELS_MIXTURES_STREAMING_RELABELER_HPP_
+/*
+  Copyright (C) 2005-2024 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include <vector>
+
+#include "LinAlg/Matrix.hpp"
+
+namespace BOOM {
+
+  class ThreadWorkerPool;
+
+  // Removes label switching from mixture model MCMC output one draw (or one
+  // batch of draws) at a time, as the draws are produced.
+  //
+  // identify_permutation_from_probs iterates over the full history of
+  // membership probabilities, so it must hold every draw in memory.  The
+  // relabeler instead matches each new draw against running "pivot"
+  // statistics built from the draws already relabeled, and then folds the
+  // relabeled draw into the pivot.  Nothing is kept from past draws other
+  // than the pivot and the S permutations already returned.
+  //
+  // Two kinds of pivot are supported.  A relabeler uses whichever kind its
+  // first draw supplies.
+  //
+  //  * Membership probabilities: an N x S matrix of probabilities that each
+  //    observation belongs to each cluster.  The pivot is the running mean
+  //    of the relabeled matrices, and the cost of a labeling is the KL
+  //    divergence used by identify_permutation_from_probs.  The pivot takes
+  //    O(N * S) memory, independent of the number of draws.
+  //
+  //  * Cluster features: an S x d matrix with a row of summaries for each
+  //    cluster (e.g. mixing weight and mean).  The pivot is the running mean
+  //    and variance of each relabeled feature, and the cost of a labeling is
+  //    the standardized squared distance of each cluster from the pivot.
+  //    Each draw costs O(S^2 * d) time and memory, independent of N.
+  //
+  // In each case the permutation is the solution to an S x S linear
+  // assignment problem.  Element k of a returned permutation is the label,
+  // in the original draw, of the cluster relabeled k.  This is the
+  // convention used by identify_permutation_from_probs.
+  //
+  // Draws passed together to relabel_batch are matched against the same
+  // pivot, so their assignment problems can be solved in parallel.
+  class StreamingRelabeler {
+   public:
+    explicit StreamingRelabeler(int number_of_clusters);
+
+    // Solve the assignment problems for a batch on the given pool.  The pool
+    // is not owned, and must outlive this object.  Passing nullptr (the
+    // default) solves them sequentially.
+    void set_thread_pool(ThreadWorkerPool *pool) { pool_ = pool; }
+
+    // Relabel a single draw of N x S membership probabilities.
+    std::vector<int> relabel_probs(const Matrix &probs);
+
+    // Relabel a single draw of S x d cluster features.
+    std::vector<int> relabel_features(const Matrix &features);
+
+    // Relabel a batch of draws of membership probabilities, or of cluster
+    // features, against the current pivot, then update the pivot with all
+    // of them.
+    std::vector<std::vector<int>> relabel_probs_batch(
+        const std::vector<Matrix> &probs);
+    std::vector<std::vector<int>> relabel_features_batch(
+        const std::vector<Matrix> &features);
+
+    // The number of draws relabeled so far.
+    int number_of_draws() const { return number_of_draws_; }
+
+    // The sum, over all draws, of the cost of the chosen permutation.
+    double total_cost() const { return total_cost_; }
+
+    // The current pivot.  For probabilities this is the N x S mean
+    // membership probability matrix.  For features it is the S x d matrix of
+    // mean features, with rows in relabeled order.
+    const Matrix &pivot() const { return pivot_mean_; }
+
+   private:
+    enum PivotType { UNSET, PROBS, FEATURES };
+
+    std::vector<std::vector<int>> relabel_batch(
+        const std::vector<Matrix> &draws, PivotType type);
+
+    // Check that 'draw' matches the pivot type and dimensions, and set up
+    // the pivot if this is the first draw.
+    void check_draw(const Matrix &draw, PivotType type);
+
+    // The S x S cost matrix for matching 'draw' to the pivot.  Element (i,
+    // j) is the cost of giving cluster j of the draw the label i.
+    Matrix cost_matrix(const Matrix &draw) const;
+
+    // Fold a relabeled draw into the pivot statistics.
+    void update_pivot(const Matrix &draw, const std::vector<int> &permutation);
+
+    // Refresh the quantities derived from the pivot statistics that are used
+    // by cost_matrix().
+    void refresh_pivot();
+
+    int number_of_clusters_;
+    PivotType type_;
+    int number_of_draws_;
+    double total_cost_;
+    ThreadWorkerPool *pool_;
+
+    // The running mean of the relabeled draws.  For probabilities it is
+    // shrunk toward 1/S as in identify_permutation_from_probs.
+    Matrix pivot_mean_;
+
+    // For probabilities, the log of pivot_mean_.  For features, the running
+    // sum of squared deviations of each relabeled feature.
+    Matrix pivot_log_mean_;
+    Matrix pivot_sum_of_squares_;
+
+    // For features, the pooled variance of each feature (column).
+    Vector feature_variance_;
+  };
+
+}  // namespace BOOM
+
+#endif  //  BOOM_MODELS_MIXTURES_STREAMING_RELABELER_HPP_
@@ -0,0 +1,101 @@
+#include "gtest/gtest.h"
+#include "distributions.hpp"
+
+#include "Models/MvnGivenSigma.hpp"
+#include "Models/WishartModel.hpp"
+#include "Models/Mixtures/DirichletProcessMvnModel.hpp"
+#include "Models/Mixtures/PosteriorSamplers/DirichletProcessMvnBlockedGibbsSampler.hpp"
+#include "test_utils/test_utils.hpp"
+
+namespace {
+  using namespace BOOM;
+
+  class DpMvnBlockedGibbsTest : public ::testing::Test {
+   protected:
+    DpMvnBlockedGibbsTest()
+        : mu1_{3.0, -1.2, 2.7},
+          mu2_{5.0, 8.1, -2.7},
+          Sigma_(Vector{
+              1, .8, .3,
+              .8, 1.5, .4,
+              .3, .4, 2.0}) {
+      GlobalRng::rng.seed(8675309);
+    }
+
+    Ptr<DirichletProcessMvnModel> simulate_model(int n1, int n2) {
+      NEW(DirichletProcessMvnModel, model)(mu1_.size(), 1.0);
+      for (int i = 0; i < n1; ++i) {
+        model->add_data(new VectorData(rmvn(mu1_, Sigma_)));
+      }
+      for (int i = 0; i < n2; ++i) {
+        model->add_data(new VectorData(rmvn(mu2_, Sigma_)));
+      }
+      return model;
+    }
+
+    Ptr<DirichletProcessMvnBlockedGibbsSampler> make_sampler(
+        DirichletProcessMvnModel *model, RNG &seeding_rng) {
+      NEW(MvnGivenSigma, mean_base_measure)(.5 * (mu1_ + mu2_), 1.0);
+      NEW(WishartModel, precision_base_measure)(mu1_.size() + 1, Sigma_);
+      NEW(DirichletProcessMvnBlockedGibbsSampler, sampler)(
+          model, mean_base_measure, precision_base_measure, 10, seeding_rng);
+      model->set_method(sampler);
+      return sampler;
+    }
+
+    Vector mu1_;
+    Vector mu2_;
+    SpdMatrix Sigma_;
+  };
+
+  // Two well separated clusters should be found, and every observation
+  // should be assigned to one of them.
+  TEST_F(DpMvnBlockedGibbsTest, FindsClusters) {
+    int n1 = 200;
+    int n2 = 100;
+    Ptr<DirichletProcessMvnModel> model = simulate_model(n1, n2);
+    RNG seeding_rng(8675309);
+    make_sampler(model.get(), seeding_rng);
+    // Starting from a single cluster, it can take a few hundred iterations
+    // for an empty component to land near the second cluster.
+    for (int i = 0; i < 500; ++i) {
+      model->sample_posterior();
+    }
+    EXPECT_LE(model->number_of_clusters(), 4);
+    EXPECT_DOUBLE_EQ(n1 + n2, sum(model->allocation_counts()));
+
+    // The first observation and the last observation come from different
+    // true clusters.
+    EXPECT_NE(model->cluster_indicators(0),
+              model->cluster_indicators(n1 + n2 - 1));
+    for (int indicator : model->cluster_indicators()) {
+      EXPECT_GE(indicator, 0);
+      EXPECT_LT(indicator, model->number_of_clusters());
+    }
+  }
+
+  // The draws should not depend on the number of threads.
+  TEST_F(DpMvnBlockedGibbsTest, ThreadedDrawsAreReproducible) {
+    Ptr<DirichletProcessMvnModel> model = simulate_model(1500, 1000);
+    NEW(DirichletProcessMvnModel, threaded_model)(model->dim(), 1.0);
+    for (const auto &dp : model->dat()) {
+      threaded_model->add_data(dp);
+    }
+
+    RNG seeding_rng(12345);
+    make_sampler(model.get(), seeding_rng);
+    RNG threaded_seeding_rng(12345);
+    make_sampler(threaded_model.get(), threaded_seeding_rng)
+        ->set_number_of_threads(4);
+
+    for (int i = 0; i < 5; ++i) {
+      model->sample_posterior();
+      threaded_model->sample_posterior();
+    }
+    EXPECT_EQ(model->cluster_indicators(),
+              threaded_model->cluster_indicators());
+    EXPECT_TRUE(VectorEquals(model->allocation_counts(),
+                             threaded_model->allocation_counts()));
+  }
+
+}  // namespace
@@ -58,4 +58,47 @@ namespace {
     }
   }
 
+  // The cached cluster posteriors, maintained by rank one updates while
+  // sampling, should give the same membership probabilities as computing
+  // each marginal density from scratch.
+  TEST_F(DpMvnTest, CachedPredictiveDensity) {
+    Vector mu1{3.0, -1.2, 2.7};
+    Vector mu2{5.0, 8.1, -2.7};
+    SpdMatrix Sigma(Vector{
+        1, .8, .3,
+        .8, 1.5, .4,
+        .3, .4, 2.0});
+    int dim = mu1.size();
+    NEW(DirichletProcessMvnModel, model)(dim, 1.0);
+    for (int i = 0; i < 60; ++i) {
+      model->add_data(new VectorData(rmvn(i % 2 ? mu1 : mu2, Sigma)));
+    }
+    NEW(MvnGivenSigma, mean_base_measure)(.5 * (mu1 + mu2), 1.0);
+    NEW(WishartModel, precision_base_measure)(dim + 1, Sigma);
+    NEW(DirichletProcessMvnCollapsedGibbsSampler, sampler)(
+        model.get(), mean_base_measure, precision_base_measure);
+    model->set_method(sampler);
+    for (int i = 0; i < 20; ++i) {
+      model->sample_posterior();
+    }
+
+    int n = model->dat().size();
+    MvnSuf empty_suf(dim);
+    for (int j = 0; j < 5; ++j) {
+      Vector y = rmvn(j % 2 ? mu1 : mu2, Sigma);
+      Vector expected(model->number_of_clusters() + 1);
+      for (int i = 0; i < model->number_of_clusters(); ++i) {
+        const MvnSuf &suf(*model->cluster(i).suf());
+        expected[i] = log(suf.n()) - log(n - 1 + model->alpha()) +
+            sampler->log_marginal_density(y, suf);
+      }
+      expected.back() = log(model->alpha()) - log(n - 1 + model->alpha()) +
+          sampler->log_marginal_density(y, empty_suf);
+      expected.normalize_logprob();
+      EXPECT_TRUE(VectorEquals(expected,
+                               sampler->cluster_membership_probability(y),
+                               1e-6));
+    }
+  }
+
 }  // namespace
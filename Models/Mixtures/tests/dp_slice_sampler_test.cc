@@ -0,0 +1,74 @@
+#include "gtest/gtest.h"
+#include "distributions.hpp"
+
+#include "Models/MvnGivenSigma.hpp"
+#include "Models/MvnModel.hpp"
+#include "Models/WishartModel.hpp"
+#include "Models/Mixtures/DirichletProcessMixture.hpp"
+#include "Models/Mixtures/PosteriorSamplers/DirichletProcessSliceSampler.hpp"
+#include "Models/Mixtures/PosteriorSamplers/SplitMerge.hpp"
+#include "Models/PosteriorSamplers/MvnConjSampler.hpp"
+
+namespace {
+  using namespace BOOM;
+
+  class DpSliceSamplerTest : public ::testing::Test {
+   protected:
+    DpSliceSamplerTest() {
+      GlobalRng::rng.seed(8675309);
+      for (int i = 0; i < 600; ++i) {
+        Vector mu(2, (i % 3) * 6.0);
+        data_.push_back(mu + rnorm_vector(2, 0, 1));
+      }
+    }
+
+    Ptr<ConjugateDirichletProcessMixtureModel> make_model(
+        int batch_size, int nthreads, RNG &seeding_rng) {
+      NEW(MvnModel, prototype)(2);
+      NEW(MvnGivenSigma, mean_base_measure)(Vector(2, 0.0), 0.1);
+      NEW(WishartModel, precision_base_measure)(3.0, SpdMatrix(2, 1.0));
+      NEW(MvnModel, base_model)(2);
+      NEW(MvnConjSampler, base_distribution)(
+          base_model.get(), mean_base_measure, precision_base_measure,
+          seeding_rng);
+      NEW(UnivParams, concentration)(1.0);
+      NEW(ConjugateDirichletProcessMixtureModel, model)(
+          prototype, base_distribution, concentration);
+      for (const auto &y : data_) {
+        model->add_data(new VectorData(y));
+      }
+      NEW(DirichletProcessSliceSampler, sampler)(model.get(), 1, seeding_rng);
+      sampler->set_split_merge_strategy(
+          new SplitMerge::SingleObservationSplitStrategy(model.get(), 1.0));
+      sampler->set_split_merge_batch_size(batch_size);
+      sampler->set_number_of_threads(nthreads);
+      model->set_method(sampler);
+      return model;
+    }
+
+    std::vector<Vector> data_;
+  };
+
+  // Batched split-merge proposals are generated concurrently, but the draws
+  // should not depend on the number of threads.
+  TEST_F(DpSliceSamplerTest, BatchedSplitMergeIsReproducible) {
+    RNG seeding_rng(12345);
+    Ptr<ConjugateDirichletProcessMixtureModel> model =
+        make_model(6, 0, seeding_rng);
+    RNG threaded_seeding_rng(12345);
+    Ptr<ConjugateDirichletProcessMixtureModel> threaded_model =
+        make_model(6, 4, threaded_seeding_rng);
+
+    for (int i = 0; i < 20; ++i) {
+      model->sample_posterior();
+      threaded_model->sample_posterior();
+    }
+    EXPECT_EQ(model->number_of_components(),
+              threaded_model->number_of_components());
+    for (int i = 0; i < data_.size(); ++i) {
+      EXPECT_EQ(model->cluster_indicator(i),
+                threaded_model->cluster_indicator(i));
+    }
+  }
+
+}  // namespace
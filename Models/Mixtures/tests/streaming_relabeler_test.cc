@@ -0,0 +1,133 @@
+#include "gtest/gtest.h"
+#include "distributions.hpp"
+#include "Models/Mixtures/StreamingRelabeler.hpp"
+#include "cpputil/ThreadTools.hpp"
+#include "cpputil/seq.hpp"
+#include "test_utils/test_utils.hpp"
+
+#include <algorithm>
+
+namespace {
+  using namespace BOOM;
+
+  class StreamingRelabelerTest : public ::testing::Test {
+   protected:
+    StreamingRelabelerTest() {
+      GlobalRng::rng.seed(8675309);
+    }
+
+    // A random permutation of 0, ..., S-1.
+    std::vector<int> random_permutation(int S) {
+      std::vector<int> ans = seq<int>(0, S - 1);
+      for (int i = S - 1; i > 0; --i) {
+        std::swap(ans[i], ans[random_int(0, i)]);
+      }
+      return ans;
+    }
+
+    // Return a copy of 'truth' with its columns scrambled, so that
+    // column scramble[k] of the answer is column k of 'truth'.
+    Matrix scramble_columns(const Matrix &truth,
+                            const std::vector<int> &scramble) {
+      Matrix ans(truth.nrow(), truth.ncol());
+      for (int k = 0; k < truth.ncol(); ++k) {
+        ans.col(scramble[k]) = truth.col(k);
+      }
+      return ans;
+    }
+  };
+
+  TEST_F(StreamingRelabelerTest, Features) {
+    int S = 4;
+    Matrix means(S, 2);
+    for (int k = 0; k < S; ++k) {
+      means(k, 0) = 10.0 * k;
+      means(k, 1) = 0.1 * (S - k);
+    }
+
+    StreamingRelabeler relabeler(S);
+    for (int draw = 0; draw < 200; ++draw) {
+      std::vector<int> scramble = draw == 0 ? seq<int>(0, S - 1)
+                                            : random_permutation(S);
+      Matrix features(S, 2);
+      for (int k = 0; k < S; ++k) {
+        features(scramble[k], 0) = means(k, 0) + rnorm(0, 1);
+        features(scramble[k], 1) = means(k, 1) + rnorm(0, .01);
+      }
+      std::vector<int> permutation = relabeler.relabel_features(features);
+      EXPECT_EQ(permutation, scramble) << "draw " << draw;
+    }
+    EXPECT_EQ(relabeler.number_of_draws(), 200);
+    EXPECT_TRUE(MatrixEquals(relabeler.pivot(), means, .5));
+  }
+
+  TEST_F(StreamingRelabelerTest, Probs) {
+    int S = 3;
+    int nobs = 500;
+    Matrix truth(nobs, S);
+    for (int i = 0; i < nobs; ++i) {
+      truth.row(i) = rdirichlet(Vector(S, 0.3));
+    }
+
+    StreamingRelabeler relabeler(S);
+    for (int draw = 0; draw < 50; ++draw) {
+      std::vector<int> scramble = draw == 0 ? seq<int>(0, S - 1)
+                                            : random_permutation(S);
+      Matrix probs(nobs, S);
+      for (int i = 0; i < nobs; ++i) {
+        probs.row(i) = rdirichlet(20 * truth.row(i) + .1);
+      }
+      std::vector<int> permutation =
+          relabeler.relabel_probs(scramble_columns(probs, scramble));
+      EXPECT_EQ(permutation, scramble) << "draw " << draw;
+    }
+    EXPECT_GT(relabeler.total_cost(), 0.0);
+  }
+
+  // A batch gives the same labels whether or not it is solved on a pool.
+  TEST_F(StreamingRelabelerTest, ParallelBatches) {
+    int S = 5;
+    Matrix means(S, 1);
+    for (int k = 0; k < S; ++k) means(k, 0) = 3.0 * k;
+
+    std::vector<Matrix> draws;
+    std::vector<std::vector<int>> scrambles;
+    for (int draw = 0; draw < 64; ++draw) {
+      scrambles.push_back(draw == 0 ? seq<int>(0, S - 1)
+                                    : random_permutation(S));
+      Matrix features(S, 1);
+      for (int k = 0; k < S; ++k) {
+        features(scrambles.back()[k], 0) = means(k, 0) + rnorm(0, .3);
+      }
+      draws.push_back(features);
+    }
+
+    StreamingRelabeler serial(S);
+    StreamingRelabeler parallel(S);
+    ThreadWorkerPool pool(4);
+    parallel.set_thread_pool(&pool);
+    for (int start = 0; start < draws.size(); start += 16) {
+      std::vector<Matrix> batch(draws.begin() + start,
+                                draws.begin() + start + 16);
+      std::vector<std::vector<int>> serial_labels =
+          serial.relabel_features_batch(batch);
+      std::vector<std::vector<int>> parallel_labels =
+          parallel.relabel_features_batch(batch);
+      for (int i = 0; i < batch.size(); ++i) {
+        EXPECT_EQ(serial_labels[i], scrambles[start + i]);
+        EXPECT_EQ(parallel_labels[i], serial_labels[i]);
+      }
+    }
+    EXPECT_DOUBLE_EQ(serial.total_cost(), parallel.total_cost());
+  }
+
+  TEST_F(StreamingRelabelerTest, Errors) {
+    StreamingRelabeler relabeler(3);
+    EXPECT_THROW(relabeler.relabel_features(Matrix(2, 2)),
+                 std::exception);
+    relabeler.relabel_features(Matrix(3, 2));
+    EXPECT_THROW(relabeler.relabel_features(Matrix(3, 4)), std::exception);
+    EXPECT_THROW(relabeler.relabel_probs(Matrix(10, 3)), std::exception);
+  }
+
+}  // namespace
@@ -17,6 +17,7 @@
   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
 */
 #include <algorithm>
+#include <sstream>
 
 #include "Models/DoubleModel.hpp"
 #include "Models/ModelTypes.hpp"
@@ -34,32 +35,82 @@ namespace BOOM {
   Model::Model(const Model &) : RefCounted() {}
 
   Vector Model::vectorize_params(bool minimal) const {
-    std::vector<Ptr<Params>> prm(parameter_vector());
-    uint nprm = prm.size();
-    uint N(0), nmax(0);
-    for (uint i = 0; i < nprm; ++i) {
-      uint n = prm[i]->size();
-      N += n;
-      nmax = std::max(nmax, n);
-    }
-    Vector ans(N);
-    Vector workspace(nmax);
-    Vector::iterator it = ans.begin();
-    for (uint i = 0; i < nprm; ++i) {
-      workspace = prm[i]->vectorize(minimal);
-      it = std::copy(workspace.begin(), workspace.end(), it);
+    return ParamLayout(parameter_vector(), minimal).vectorize();
+  }
+
+  void Model::unvectorize_params(const Vector &v, bool minimal) {
+    ParamLayout layout(parameter_vector(), minimal);
+    if (v.size() < layout.size()) {
+      std::ostringstream err;
+      err << "A vector of size " << v.size() << " was passed to "
+          << "unvectorize_params, but the model has " << layout.size()
+          << " parameters.";
+      report_error(err.str());
+    }
+    layout.unvectorize(ConstVectorView(v, 0, layout.size()));
+  }
+
+  MemoryFootprint Model::memory_footprint() const {
+    MemoryFootprint ans = data_memory_footprint();
+    for (const auto &prm : parameter_vector()) {
+      ans.add(MemoryFootprint::kParameters, prm->memory_footprint());
     }
     return ans;
   }
 
-  void Model::unvectorize_params(const Vector &v, bool minimal) {
-    std::vector<Ptr<Params>> prm(parameter_vector());
-    Vector::const_iterator b = v.begin();
-    for (uint i = 0; i < prm.size(); ++i) {
-      b = prm[i]->unvectorize(b, minimal);
+  void Model::write_checkpoint(CheckpointWriter &out) const {
+    out.begin_section("Model");
+    out.write(vectorize_params(false));
+    out.write(number_of_sampling_methods());
+    for (int i = 0; i < number_of_sampling_methods(); ++i) {
+      sampler(i)->write_checkpoint(out);
+    }
+  }
+
+  void Model::read_checkpoint(CheckpointReader &in) {
+    in.expect_section("Model");
+    Vector params(in.read_double_vector());
+    if (params.size() != vectorize_params(false).size()) {
+      std::ostringstream err;
+      err << "The checkpoint holds " << params.size() << " parameters, but "
+          << "the model has " << vectorize_params(false).size() << ".";
+      report_error(err.str());
+    }
+    unvectorize_params(params, false);
+    int number_of_samplers = in.read_int();
+    if (number_of_samplers != number_of_sampling_methods()) {
+      std::ostringstream err;
+      err << "The checkpoint holds " << number_of_samplers
+          << " posterior samplers, but the model has "
+          << number_of_sampling_methods() << ".";
+      report_error(err.str());
+    }
+    for (int i = 0; i < number_of_samplers; ++i) {
+      sampler(i)->read_checkpoint(in);
     }
   }
 
+  void save_checkpoint(const Model &model, const std::string &filename,
+                       int64_t iteration) {
+    CheckpointWriter out;
+    out.write(iteration);
+    GlobalRng::rng.write_checkpoint(out);
+    model.write_checkpoint(out);
+    out.save(filename);
+  }
+
+  int64_t restore_checkpoint(Model &model, const std::string &filename) {
+    CheckpointReader in = CheckpointReader::load(filename);
+    int64_t iteration = in.read_int();
+    GlobalRng::rng.read_checkpoint(in);
+    model.read_checkpoint(in);
+    if (!in.at_end()) {
+      report_error("Checkpoint file " + filename + " has unread data.  It "
+                   "was probably written by a different kind of model.");
+    }
+    return iteration;
+  }
+
   //============================================================
   void PosteriorModeModel::find_posterior_mode(double epsilon) {
     if (number_of_sampling_methods() != 1) {
@@ -143,6 +194,49 @@ namespace BOOM {
   }
 
   //============================================================
+  bool ParameterVersionStamp::matches(
+      const std::vector<Ptr<Params>> &params) const {
+    if (!valid_ || params.size() != params_.size()) {
+      return false;
+    }
+    for (size_t i = 0; i < params.size(); ++i) {
+      if (params[i].get() != params_[i].get()
+          || params[i]->version() != versions_[i]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  void ParameterVersionStamp::update(const std::vector<Ptr<Params>> &params) {
+    params_ = params;
+    versions_.resize(params.size());
+    for (size_t i = 0; i < params.size(); ++i) {
+      versions_[i] = params[i]->version();
+    }
+    valid_ = true;
+  }
+
+  void ParameterVersionStamp::clear() {
+    valid_ = false;
+    params_.clear();
+    versions_.clear();
+  }
+
+  //======================================================================
+  double LoglikeModel::cached_log_likelihood() const {
+    const std::vector<Ptr<Params>> params = parameter_vector();
+    if (!log_likelihood_stamp_.matches(params)) {
+      cached_log_likelihood_ = log_likelihood();
+      log_likelihood_stamp_.update(params);
+    }
+    return cached_log_likelihood_;
+  }
+
+  void LoglikeModel::invalidate_log_likelihood_cache() const {
+    log_likelihood_stamp_.clear();
+  }
+
   void LoglikeModel::mle() {
     LoglikeTF loglike(this);
     Vector prms = vectorize_params(true);
@@ -150,6 +244,24 @@ namespace BOOM {
     unvectorize_params(prms, true);
   }
 
+  double dLoglikeModel::cached_log_likelihood(Vector &gradient) const {
+    const std::vector<Ptr<Params>> params = parameter_vector();
+    if (!gradient_stamp_.matches(params)) {
+      Vector theta = vectorize_params(true);
+      cached_log_likelihood_gradient_.resize(theta.size());
+      cached_log_likelihood_value_ =
+          dloglike(theta, cached_log_likelihood_gradient_);
+      gradient_stamp_.update(params);
+    }
+    gradient = cached_log_likelihood_gradient_;
+    return cached_log_likelihood_value_;
+  }
+
+  void dLoglikeModel::invalidate_log_likelihood_cache() const {
+    LoglikeModel::invalidate_log_likelihood_cache();
+    gradient_stamp_.clear();
+  }
+
   void dLoglikeModel::mle() {
     dLoglikeTF loglike(this);
     Vector prms = vectorize_params(true);
@@ -167,6 +279,24 @@ namespace BOOM {
   }
 
   void d2LoglikeModel::mle() {
+    Vector parameters = vectorize_params(true);
+    if (parameters.size() > kLimitedMemoryDimension) {
+      // The Hessian is not needed here, and in high dimensions it is too
+      // expensive to build and factor at each Newton step.
+      d2LoglikeTF loglike(this);
+      double logf;
+      std::string error_message;
+      bool ok = max_nd1_careful(parameters, logf, Target(loglike),
+                                dTarget(loglike), error_message, 1e-5, 500,
+                                LBFGS);
+      if (ok) {
+        unvectorize_params(parameters, true);
+        MLE_Model::set_status(SUCCESS, "");
+      } else {
+        MLE_Model::set_status(FAILURE, error_message);
+      }
+      return;
+    }
     Vector gradient;
     Matrix Hessian;
     mle_result(gradient, Hessian);
@@ -205,6 +335,21 @@ namespace BOOM {
     return logscale ? ans : exp(ans);
   }
 
+  //======================================================================
+  void MixtureComponent::pdf_batch(const std::vector<Ptr<Data>> &data,
+                                   VectorView ans, bool logscale) const {
+    if (ans.size() != data.size()) {
+      report_error("Output vector has the wrong size in pdf_batch.");
+    }
+    for (size_t i = 0; i < data.size(); ++i) {
+      if (data[i]->missing()) {
+        ans[i] = logscale ? 0.0 : 1.0;
+      } else {
+        ans[i] = pdf(data[i].get(), logscale);
+      }
+    }
+  }
+
   //======================================================================
   double DiffDoubleModel::logp(double x) const {
     double g(0), h(0);
@@ -26,6 +26,8 @@
 #include "LinAlg/Vector.hpp"
 #include "Models/DataTypes.hpp"
 #include "Models/ParamTypes.hpp"
+#include "cpputil/Checkpoint.hpp"
+#include "cpputil/MemoryFootprint.hpp"
 #include "distributions/rng.hpp"
 
 namespace BOOM {
@@ -98,8 +100,43 @@ namespace BOOM {
     virtual void set_method(const Ptr<PosteriorSampler> &sampler) {}
     virtual PosteriorSampler *sampler(int i) = 0;
     virtual PosteriorSampler const *const sampler(int i) const = 0;
+
+    //------------ checkpointing ----------------------
+    // Save or restore the model parameters and the state of each posterior
+    // sampler.  Data are not part of the checkpoint: the model being
+    // restored must already hold the same data, and have the same
+    // structure and samplers, as the one that was saved.  Models with
+    // state outside their parameters (e.g. the trees in a BART model)
+    // override these functions and call the base class versions.
+    virtual void write_checkpoint(CheckpointWriter &out) const;
+    virtual void read_checkpoint(CheckpointReader &in);
+
+    //------------ memory accounting ----------------------
+    // An estimate of the memory used by the model, by category (see
+    // MemoryFootprint).  The default counts the parameters and
+    // data_memory_footprint().  Models holding other large objects (e.g.
+    // Kalman filters) override this and call the base class version.
+    virtual MemoryFootprint memory_footprint() const;
+
+    // The memory used by the data assigned to the model, and any sufficient
+    // statistics.  This is implemented by the DataPolicy.  The default
+    // reports nothing.
+    virtual MemoryFootprint data_memory_footprint() const {
+      return MemoryFootprint();
+    }
   };
 
+  // Write a checkpoint file holding the state of 'model' (see
+  // Model::write_checkpoint), the GlobalRng, and the MCMC iteration number.
+  // The file is replaced atomically, so it is safe to checkpoint
+  // periodically to the same file from a process that might be killed.
+  void save_checkpoint(const Model &model, const std::string &filename,
+                       int64_t iteration = 0);
+
+  // Restore 'model' and the GlobalRng from a file written by
+  // save_checkpoint.  Returns the iteration number that was saved.
+  int64_t restore_checkpoint(Model &model, const std::string &filename);
+
   // The result of deepclone will have identical parameters in distinct
   // memory.  It will contain pointers to the same data.  It will contain
   // equivalent posterior samplers (but pointing to the new data structures).
@@ -222,9 +259,42 @@ namespace BOOM {
     // prior density.  Returns false otherwise.
     bool can_increment_log_prior_gradient() const;
   };
+  //======================================================================
+  // Records the identity and version() of each Params in a model's
+  // parameter_vector(), so that quantities computed from the current
+  // parameters can be reused until one of the parameters signals a change.
+  // Copies of a stamp are empty, so a copied model never reuses a value
+  // computed by the original.
+  class ParameterVersionStamp {
+   public:
+    ParameterVersionStamp() : valid_(false) {}
+    ParameterVersionStamp(const ParameterVersionStamp &rhs) : valid_(false) {}
+    ParameterVersionStamp &operator=(const ParameterVersionStamp &rhs) {
+      clear();
+      return *this;
+    }
+
+    // Returns true if 'params' holds the same objects passed to the most
+    // recent call to update(), and none of them has signalled since.
+    bool matches(const std::vector<Ptr<Params>> &params) const;
+
+    // Record the current versions of 'params'.
+    void update(const std::vector<Ptr<Params>> &params);
+
+    // Forget the recorded versions, so that matches() returns false.
+    void clear();
+
+   private:
+    bool valid_;
+    std::vector<Ptr<Params>> params_;
+    std::vector<unsigned int> versions_;
+  };
+
   //======================================================================
   class LoglikeModel : public MLE_Model {
    public:
+    LoglikeModel() : cached_log_likelihood_(0) {}
+
     // Evaluate log likelihood at the given parameter vector.
     virtual double loglike(const Vector &theta) const = 0;
 
@@ -233,14 +303,41 @@ namespace BOOM {
       return loglike(vectorize_params(true));
     }
 
+    // The value of log_likelihood(), reused from the previous call if no
+    // element of parameter_vector() has signalled a change since then.
+    // Repeated evaluations at unchanged parameters (e.g. the current state
+    // in a Metropolis-Hastings step) are then free.
+    //
+    // Only the parameters are tracked.  Call
+    // invalidate_log_likelihood_cache() after changing the model's data, or
+    // after changing a parameter without signalling.
+    double cached_log_likelihood() const;
+    virtual void invalidate_log_likelihood_cache() const;
+
     // Set model parameters to their maximum likelihood estimates.
     void mle() override;
+
+   private:
+    mutable ParameterVersionStamp log_likelihood_stamp_;
+    mutable double cached_log_likelihood_;
   };
 
   class dLoglikeModel : public LoglikeModel {
    public:
+    dLoglikeModel() : cached_log_likelihood_value_(0) {}
     virtual double dloglike(const Vector &x, Vector &g) const = 0;
     void mle() override;
+
+    // The log likelihood and its gradient at the current parameters,
+    // computed by dloglike() and memoized as in cached_log_likelihood().
+    using LoglikeModel::cached_log_likelihood;
+    double cached_log_likelihood(Vector &gradient) const;
+    void invalidate_log_likelihood_cache() const override;
+
+   private:
+    mutable ParameterVersionStamp gradient_stamp_;
+    mutable double cached_log_likelihood_value_;
+    mutable Vector cached_log_likelihood_gradient_;
   };
 
   class d2LoglikeModel : public dLoglikeModel {
@@ -285,6 +382,18 @@ namespace BOOM {
 
     virtual double pdf(const Data *, bool logscale) const = 0;
 
+    // Evaluate the density of each element of 'data', writing the results to
+    // 'ans', which must have the same size as 'data'.  Elements of 'data'
+    // that are missing are assigned ans[i] = 0 on the log scale (1 on the
+    // probability scale).
+    //
+    // The default implementation calls pdf() on each element.  Child classes
+    // with simple densities override it to evaluate all the data in one
+    // vectorized pass, which is much faster when it is called from the E-step
+    // of a mixture model or the forward pass of an HMM.
+    virtual void pdf_batch(const std::vector<Ptr<Data>> &data, VectorView ans,
+                           bool logscale) const;
+
     // The number of data points that have been allocated to this model.  This
     // might have been called "sample_size", but that sometimes refers to
     // certain model parameters, such as the beta distribution.
@@ -51,6 +51,8 @@ namespace BOOM {
     ++counts_[i];
   }
 
+  void MS::Remove(const CategoricalData &d) { --counts_[d.value()]; }
+
   void MS::add_mixture_data(uint y, double prob) { counts_[y] += prob; }
   void MS::add_mixture_data(const Vector &weights) { counts_ += weights; }
   void MS::update_raw(uint k) { ++counts_[k]; }
@@ -238,6 +240,28 @@ namespace BOOM {
     return logscale ? logp_[i] : pi(i);
   }
 
+  // A table lookup per observation, with the log probabilities computed
+  // once for the whole batch.
+  void MM::pdf_batch(const std::vector<Ptr<Data>> &data, VectorView ans,
+                     bool logscale) const {
+    if (ans.size() != data.size()) {
+      report_error("Output vector has the wrong size in pdf_batch.");
+    }
+    check_logp();
+    const Vector &table(logscale ? logp_ : pi());
+    for (size_t i = 0; i < data.size(); ++i) {
+      if (data[i]->missing()) {
+        ans[i] = logscale ? 0.0 : 1.0;
+        continue;
+      }
+      uint value = DAT(data[i])->value();
+      if (value >= dim()) {
+        report_error("too large a value passed to MultinomialModel::pdf_batch");
+      }
+      ans[i] = table[value];
+    }
+  }
+
   uint MM::sim(RNG &rng) const { return rmulti_mt(rng, pi()); }
 
   void MM::add_mixture_data(const Ptr<Data> &dp, double prob) {
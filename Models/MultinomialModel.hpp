@@ -36,6 +36,8 @@ namespace BOOM {
     MultinomialSuf *clone() const override;
 
     void Update(const CategoricalData &d) override;
+    bool supports_remove() const override { return true; }
+    void Remove(const CategoricalData &d) override;
     void add_mixture_data(uint y, double prob);
     void add_mixture_data(const Vector &weights);
     void update_raw(uint k);
@@ -101,6 +103,8 @@ namespace BOOM {
     void mle() override;
     double pdf(const Data *dp, bool logscale) const override;
     double pdf(const Ptr<Data> &dp, bool logscale) const;
+    void pdf_batch(const std::vector<Ptr<Data>> &data, VectorView ans,
+                   bool logscale) const override;
     void add_mixture_data(const Ptr<Data> &, double prob);
     int number_of_observations() const override { return suf()->n().sum(); }
 
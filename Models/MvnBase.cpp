@@ -127,6 +127,37 @@ namespace BOOM {
     sym_ = false;
   }
 
+  void MvnSuf::add_data(const Matrix &Y) {
+    if (Y.nrow() == 0) return;
+    if (ybar_.empty()) {
+      resize(Y.ncol());
+    }
+    if (Y.ncol() != ybar_.size()) {
+      std::ostringstream msg;
+      msg << "attempting to update MvnSuf of dimension " << ybar_.size()
+          << " with a block of data of dimension " << Y.ncol() << ".";
+      report_error(msg.str());
+    }
+    double block_n = Y.nrow();
+    Vector block_mean = Y.col_sums() / block_n;
+    Matrix centered(Y);
+    for (int j = 0; j < centered.ncol(); ++j) {
+      centered.col(j) -= block_mean[j];
+    }
+    check_symmetry();
+    sumsq_.add_inner(centered);
+
+    // Merge the block with the existing data, as in combine().
+    double total = n_ + block_n;
+    wsp_ = block_mean;
+    wsp_ -= ybar_;
+    sumsq_.add_outer(wsp_, n_ * block_n / total, false);
+    wsp_ *= block_n / total;
+    ybar_ += wsp_;
+    n_ = total;
+    sym_ = false;
+  }
+
   Vector MvnSuf::sum() const { return ybar_ * n_; }
   SpdMatrix MvnSuf::sumsq() const {
     check_symmetry();
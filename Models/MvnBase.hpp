@@ -44,12 +44,21 @@ namespace BOOM {
     void Update(const VectorData &x) override;
     void update_raw(const Vector &x);
     void add_mixture_data(const Vector &x, double prob);
+
+    // Add a block of observations.  Row i of Y is observation i.  The block's
+    // centered sum of squares is computed with a single rank-k update and
+    // merged with the existing statistics, which is much faster than one
+    // update_raw call per row.
+    void add_data(const Matrix &Y);
+
     void update_expected_value(double sample_size, const Vector &expected_sum,
                                const SpdMatrix &expected_sum_of_squares);
 
     // Remove the vector x from the set of sufficient statistics,
     // assuming that x was previously added.
     void remove_data(const Vector &x);
+    bool supports_remove() const override { return true; }
+    void Remove(const VectorData &x) override { remove_data(x.value()); }
 
     Vector sum() const;
     SpdMatrix sumsq() const;  // Un-centered sum of squares
@@ -58,6 +58,35 @@ namespace BOOM {
     return logscale ? ans : exp(ans);
   }
 
+  void MvnModel::pdf_batch(const std::vector<Ptr<Data>> &data,
+                           VectorView ans, bool logscale) const {
+    if (ans.size() != data.size()) {
+      report_error("Output vector has the wrong size in pdf_batch.");
+    }
+    const double log2pi = 1.83787706641;
+    int n = data.size();
+    int p = dim();
+    Matrix residuals(n, p, 0.0);
+    for (int i = 0; i < n; ++i) {
+      if (!data[i]->missing()) {
+        residuals.row(i) = DAT(data[i])->value() - mu();
+      }
+    }
+    Matrix scaled_residuals = residuals * siginv();
+    double normalizing_constant = 0.5 * (ldsi() - p * log2pi);
+    for (int i = 0; i < n; ++i) {
+      if (data[i]->missing()) {
+        ans[i] = 0.0;
+      } else {
+        ans[i] = normalizing_constant -
+                 0.5 * residuals.row(i).dot(scaled_residuals.row(i));
+      }
+    }
+    if (!logscale) {
+      for (int i = 0; i < n; ++i) ans[i] = exp(ans[i]);
+    }
+  }
+
   Vector MvnModel::sim(RNG &rng) const {
     return rmvn_L_mt(rng, mu(), Sigma_chol());
   }
@@ -77,6 +77,11 @@ namespace BOOM {
     double pdf(const Ptr<Data> &dp, bool logscale) const;
     double pdf(const Data *, bool logscale) const override;
     double pdf(const Vector &x, bool logscale) const;
+
+    // The quadratic forms for all the data are computed from a single
+    // matrix product with siginv().
+    void pdf_batch(const std::vector<Ptr<Data>> &data, VectorView ans,
+                   bool logscale) const override;
     int number_of_observations() const override { return dat().size(); }
 
     Vector sim(RNG &rng = GlobalRng::rng) const override;
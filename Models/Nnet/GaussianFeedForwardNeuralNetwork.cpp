@@ -17,11 +17,16 @@
 */
 
 #include "Models/Nnet/GaussianFeedForwardNeuralNetwork.hpp"
+#include "LinAlg/SubMatrix.hpp"
+#include <algorithm>
 
 namespace BOOM {
 
   namespace {
     using GFFNN = GaussianFeedForwardNeuralNetwork;
+
+    // The number of rows passed through the network at once by predict().
+    const int prediction_block_size = 256;
   }
 
   GFFNN::GaussianFeedForwardNeuralNetwork()
@@ -48,6 +53,22 @@ namespace BOOM {
     return *this;
   }
   
+  Vector GFFNN::predict(const Matrix &predictors) const {
+    int nrow = predictors.nrow();
+    Vector ans(nrow);
+    std::vector<Matrix> activation_probs;
+    for (int start = 0; start < nrow; start += prediction_block_size) {
+      int end = std::min(nrow, start + prediction_block_size);
+      fill_activation_probabilities(
+          Matrix(ConstSubMatrix(predictors, start, end - 1,
+                                0, predictors.ncol() - 1)),
+          activation_probs);
+      VectorView(ans, start, end - start) =
+          activation_probs.back() * terminal_layer_->Beta();
+    }
+    return ans;
+  }
+
   void GFFNN::restructure_terminal_layer(int dim) {
     if (dim != terminal_layer_->xdim()) {
       ParamPolicy::drop_model(terminal_layer_);
@@ -53,6 +53,10 @@ namespace BOOM {
       return predict(ConstVectorView(predictors));
     }
 
+    // Predictions for each row of a predictor matrix, computed a block of
+    // rows at a time using matrix operations.
+    Vector predict(const Matrix &predictors) const;
+
     Ptr<RegressionModel> terminal_layer() {return terminal_layer_;}
 
     double residual_sd() const {return terminal_layer_->sigma();}
@@ -70,6 +70,25 @@ namespace BOOM {
     }
   }
   
+  void HiddenLayer::predict(const Matrix &inputs, Matrix &outputs) const {
+    if (inputs.ncol() != input_dimension()) {
+      report_error("The inputs are the wrong dimension in "
+                   "HiddenLayer::predict.");
+    }
+    outputs = inputs * coefficient_matrix();
+    for (double &value : outputs) {
+      value = 1.0 / (1.0 + std::exp(-value));
+    }
+  }
+
+  Matrix HiddenLayer::coefficient_matrix() const {
+    Matrix ans(input_dimension(), output_dimension());
+    for (int node = 0; node < models_.size(); ++node) {
+      ans.col(node) = models_[node]->Beta();
+    }
+    return ans;
+  }
+
   //===========================================================================
   namespace {
     using FFNN = FeedForwardNeuralNetwork;
@@ -132,6 +151,17 @@ namespace BOOM {
     }
   }
 
+  void FFNN::fill_activation_probabilities(
+      const Matrix &inputs,
+      std::vector<Matrix> &activation_probs) const {
+    activation_probs.resize(hidden_layers_.size());
+    const Matrix *in = &inputs;
+    for (int i = 0; i < hidden_layers_.size(); ++i) {
+      hidden_layers_[i]->predict(*in, activation_probs[i]);
+      in = &activation_probs[i];
+    }
+  }
+
   std::vector<Vector> FFNN::activation_probability_workspace() const {
     std::vector<Vector> ans;
     for (int i = 0; i < hidden_layers_.size(); ++i) {
@@ -83,6 +83,22 @@ namespace BOOM {
     //   outputs: The marginal probabilties that each output node is active.  
     void predict(const Vector &inputs, Vector &outputs) const;
 
+    // A batched version of predict, evaluating all the nodes for a block of
+    // observations with a single matrix multiplication.
+    //
+    // Args:
+    //   inputs: Each row contains the inputs to the hidden layer for one
+    //     observation.
+    //   outputs: On output, element (i, j) is the marginal probability that
+    //     node j is active for observation i.  The matrix is resized if
+    //     needed.
+    void predict(const Matrix &inputs, Matrix &outputs) const;
+
+    // The coefficients of the logistic regressions implementing the layer.
+    // Column j holds the coefficients for node j, so there is one row per
+    // input.
+    Matrix coefficient_matrix() const;
+
     Ptr<BinomialLogitModel> logistic_regression(int node) {
       return models_[node];
     }
@@ -145,6 +161,19 @@ namespace BOOM {
         const Vector &inputs,
         std::vector<Vector> &activation_probs) const;
     
+    // A batched version of fill_activation_probabilities.
+    //
+    // Args:
+    //   inputs: A block of observed predictors, with one row per observation.
+    //   activation_probs: On output, element i is a matrix with one row per
+    //     observation and one column per node in hidden layer i, containing
+    //     the probability that each node is active.  The vector and its
+    //     elements are resized as needed, so they can be reused across
+    //     blocks.
+    void fill_activation_probabilities(
+        const Matrix &inputs,
+        std::vector<Matrix> &activation_probs) const;
+
     // Allocate a data structure that can be passed to
     // fill_activation_probabilities.
     std::vector<Vector> activation_probability_workspace() const;
@@ -19,11 +19,16 @@
 #include "Models/Nnet/PosteriorSamplers/GaussianFeedForwardPosteriorSampler.hpp"
 #include "distributions.hpp"
 #include "cpputil/lse.hpp"
+#include <algorithm>
 
 namespace BOOM {
 
   namespace {
     using GFFPS = GaussianFeedForwardPosteriorSampler;
+
+    // The number of observations whose activation probabilities are
+    // computed together by impute_hidden_layer_outputs.
+    const int imputation_block_size = 256;
   }  // namespace 
   
   GFFPS::GaussianFeedForwardPosteriorSampler(
@@ -44,37 +49,109 @@ namespace BOOM {
     draw_parameters_given_hidden_nodes();
   }
   
+  void GFFPS::set_number_of_threads(int number_of_threads) {
+    pool_.set_number_of_threads(number_of_threads);
+    worker_rngs_.clear();
+    RNG::RngIntType seed = seed_rng(rng());
+    for (int i = 0; i < pool_.number_of_threads(); ++i) {
+      worker_rngs_.emplace_back(seed, i);
+    }
+  }
+
   // The imputation method is a "collapsed Gibbs sampler" that integrates out
   // latent data from preceding layers (i.e. preceding nodes are activated
   // probabilistically), but conditions on the latent data from the current
   // layer and the layer above.
+  //
+  // Given the model parameters the observations are conditionally
+  // independent, so they are split into shards that can be imputed in
+  // parallel.  Each shard accumulates its own sufficient statistics, which
+  // are added to the models once all the shards are done.
   void GFFPS::impute_hidden_layer_outputs(RNG &rng) {
     int number_of_hidden_layers = model_->number_of_hidden_layers();
     if (number_of_hidden_layers == 0) return;
     ensure_space_for_latent_data();
     clear_latent_data();
+
+    const std::vector<Ptr<RegressionData>> &data(model_->dat());
+    int sample_size = data.size();
+    int number_of_shards = pool_.no_threads() ? 1 : std::max<int>(
+        1, std::min<int>(worker_rngs_.size(), sample_size));
+    shards_.resize(number_of_shards);
+    for (auto &shard : shards_) {
+      shard.terminal_suf.reset(model_->terminal_layer()->suf()->clone());
+      shard.terminal_suf->clear();
+      shard.hidden_layer_sufs.resize(number_of_hidden_layers);
+      for (auto &suf : shard.hidden_layer_sufs) {
+        suf.clear();
+      }
+    }
+
+    pool_.parallel_for(0, number_of_shards, 1, [&](int s) {
+      int begin = static_cast<int64_t>(s) * sample_size / number_of_shards;
+      int end = static_cast<int64_t>(s + 1) * sample_size / number_of_shards;
+      impute_shard(number_of_shards == 1 ? rng : worker_rngs_[s],
+                   begin, end, shards_[s]);
+    });
+
+    for (const auto &shard : shards_) {
+      model_->terminal_layer()->suf()->combine(shard.terminal_suf);
+      for (int layer = 1; layer < number_of_hidden_layers; ++layer) {
+        imputers_[layer].combine_latent_data(shard.hidden_layer_sufs[layer]);
+      }
+    }
+    for (int i = 0; i < sample_size; ++i) {
+      imputers_[0].store_initial_layer_latent_data(
+          imputed_hidden_layer_outputs_[i][0], data[i]);
+    }
+  }
+
+  // The activation probabilities are computed for a block of observations at
+  // a time using matrix operations.  The imputation itself then proceeds one
+  // observation at a time, reading that observation's row of each block.
+  void GFFPS::impute_shard(RNG &rng, int begin, int end,
+                           ImputationShard &shard) {
+    int number_of_hidden_layers = model_->number_of_hidden_layers();
     std::vector<Vector> allocation_probs =
         model_->activation_probability_workspace();
     std::vector<Vector> complementary_allocation_probs = allocation_probs;
     std::vector<Vector> workspace = allocation_probs;
-    for (int i = 0; i < model_->dat().size(); ++i) {
-      const Ptr<RegressionData> &data_point(model_->dat()[i]);
-      Nnet::HiddenNodeValues &outputs(imputed_hidden_layer_outputs_[i]);
-      model_->fill_activation_probabilities(data_point->x(), allocation_probs);
-      impute_terminal_layer_inputs(rng, data_point->y(), outputs.back(),
-                                   allocation_probs.back(),
-                                   complementary_allocation_probs.back());
-      for (int layer = number_of_hidden_layers - 1; layer > 0; --layer) {
-        // This for-loop intentionally skips layer 0, because the inputs to the
-        // first hidden layer are the observed predictors.
-        imputers_[layer].impute_inputs(
-            rng,
-            outputs,
-            allocation_probs[layer - 1],
-            complementary_allocation_probs[layer - 1],
-            workspace[layer - 1]);
+    const std::vector<Ptr<RegressionData>> &data(model_->dat());
+    Matrix predictors;
+    std::vector<Matrix> block_allocation_probs;
+    for (int block_start = begin; block_start < end;
+         block_start += imputation_block_size) {
+      int block_end = std::min(end, block_start + imputation_block_size);
+      predictors.resize(block_end - block_start, data[block_start]->xdim());
+      for (int i = block_start; i < block_end; ++i) {
+        predictors.row(i - block_start) = data[i]->x();
+      }
+      model_->fill_activation_probabilities(
+          predictors, block_allocation_probs);
+
+      for (int i = block_start; i < block_end; ++i) {
+        Nnet::HiddenNodeValues &outputs(imputed_hidden_layer_outputs_[i]);
+        for (int layer = 0; layer < number_of_hidden_layers; ++layer) {
+          allocation_probs[layer] = block_allocation_probs[layer].row(
+              i - block_start);
+        }
+        impute_terminal_layer_inputs(rng, data[i]->y(), outputs.back(),
+                                     allocation_probs.back(),
+                                     complementary_allocation_probs.back(),
+                                     *shard.terminal_suf);
+        for (int layer = number_of_hidden_layers - 1; layer > 0; --layer) {
+          // This for-loop intentionally skips layer 0, because the inputs to
+          // the first hidden layer are the observed predictors.
+          imputers_[layer].draw_inputs(
+              rng,
+              outputs,
+              allocation_probs[layer - 1],
+              complementary_allocation_probs[layer - 1],
+              workspace[layer - 1]);
+          shard.hidden_layer_sufs[layer].add(outputs[layer - 1],
+                                             outputs[layer]);
+        }
       }
-      imputers_[0].store_initial_layer_latent_data(outputs[0], data_point);
     }
   }
 
@@ -174,17 +251,19 @@ namespace BOOM {
   //     over-written by their logarithms.
   //   logprob_complement: On input this is any vector with size matching
   //     logprob.  On output its elements contain log(1 - exp(logprob)).
+  //   terminal_suf: Sufficient statistics for the terminal layer, to which
+  //     the imputed data are added.
   //
   // Effects:
-  //   The latent data for the terminal layer is imputed, and the sufficient
-  //   statistics for the latent regression model in the terminal layer are
-  //   updated to included the imputed data.
+  //   The latent data for the terminal layer is imputed, and terminal_suf is
+  //   updated to include the imputed data.
   void GFFPS::impute_terminal_layer_inputs(
       RNG &rng,
       double response,
       std::vector<bool> &binary_inputs,
       Vector &logprob,
-      Vector &logprob_complement) {
+      Vector &logprob_complement,
+      RegSuf &terminal_suf) const {
     for (int i = 0; i < logprob.size(); ++i) {
       logprob_complement[i] = log(1 - logprob[i]);
       logprob[i] = log(logprob[i]);
@@ -205,8 +284,7 @@ namespace BOOM {
         terminal_layer_inputs[i] = 1 - terminal_layer_inputs[i];
       }
     }
-    model_->terminal_layer()->suf()->add_mixture_data(
-        response, terminal_layer_inputs, 1.0);
+    terminal_suf.add_mixture_data(response, terminal_layer_inputs, 1.0);
     Nnet::to_binary(terminal_layer_inputs, binary_inputs);
   }
 
@@ -21,6 +21,7 @@
 #include "Models/Nnet/GaussianFeedForwardNeuralNetwork.hpp"
 #include "Models/Nnet/PosteriorSamplers/HiddenLayerImputer.hpp"
 #include "Models/PosteriorSamplers/PosteriorSampler.hpp"
+#include "cpputil/ThreadTools.hpp"
 
 namespace BOOM {
 
@@ -34,6 +35,13 @@ namespace BOOM {
     double logpri() const override;
     void draw() override;
 
+    // Impute the hidden layer outputs using threads from the global thread
+    // pool.  The observations are split into one shard per thread.  Each
+    // shard has its own random number generator and its own sufficient
+    // statistics, which are merged once all the shards are done.  The
+    // default of zero threads does all the work in the calling thread.
+    void set_number_of_threads(int number_of_threads);
+
    private:
     //---------------------------------------------------------------------------
     // This section contains implementation for the 'draw' method.
@@ -75,12 +83,29 @@ namespace BOOM {
     // allocated to manage it.
     void ensure_imputers();
 
+    // The latent data imputed for a contiguous range of observations.
+    struct ImputationShard {
+      // Complete data sufficient statistics for the terminal layer.
+      Ptr<RegSuf> terminal_suf;
+
+      // Element i holds the latent data for hidden layer i.  Element 0 is
+      // unused, because the inputs to the first layer are observed.
+      std::vector<HiddenLayerSuf> hidden_layer_sufs;
+    };
+
     // Implementation for impute_hidden_layer_outputs.  Don't call these from
     // elsewhere.
+    //
+    // Impute the hidden layer outputs for observations begin..end-1, storing
+    // the imputed data in 'shard'.  This function does not modify the model,
+    // so different shards may be imputed in parallel.
+    void impute_shard(RNG &rng, int begin, int end, ImputationShard &shard);
+
     void impute_terminal_layer_inputs(RNG &rng,
                                       double response,
                                       std::vector<bool> &inputs,
-                                      Vector &wsp1, Vector &wsp2);
+                                      Vector &wsp1, Vector &wsp2,
+                                      RegSuf &terminal_suf) const;
 
     //----------------------------------------------------------------------
     // Data section.
@@ -92,6 +117,12 @@ namespace BOOM {
     // imputed_hidden_layer_outputs_[i][layer][node] indicates whether the
     // specified node in the specified hidden layer is 'on' for observation i.
     std::vector<Nnet::HiddenNodeValues> imputed_hidden_layer_outputs_;
+
+    // Threads used by impute_hidden_layer_outputs, with one random number
+    // generator per thread.
+    SharedThreadPool pool_;
+    std::vector<RNG> worker_rngs_;
+    std::vector<ImputationShard> shards_;
   };
 
 }  // namespace BOOM
@@ -22,6 +22,21 @@
 
 namespace BOOM {
 
+  void HiddenLayerSuf::add(const std::vector<bool> &inputs,
+                           const std::vector<bool> &outputs) {
+    auto it = counts_.find(inputs);
+    if (it == counts_.end()) {
+      it = counts_.emplace(inputs, Counts{0.0, Vector(outputs.size(), 0.0)})
+          .first;
+    }
+    Counts &counts(it->second);
+    counts.trials += 1.0;
+    for (int i = 0; i < outputs.size(); ++i) {
+      counts.successes[i] += outputs[i];
+    }
+  }
+
+  //===========================================================================
   HiddenLayerImputer::HiddenLayerImputer(const Ptr<HiddenLayer> &layer,
                                          int layer_index) 
       : layer_(layer),
@@ -36,6 +51,19 @@ namespace BOOM {
       Vector &complementary_allocation_probs,
       Vector &input_workspace) {
     if (layer_index_ <= 0) return;
+    draw_inputs(rng, outputs, allocation_probs, complementary_allocation_probs,
+                input_workspace);
+    store_latent_data(outputs);
+  }
+
+  //---------------------------------------------------------------------------
+  void HiddenLayerImputer::draw_inputs(
+      RNG &rng,
+      Nnet::HiddenNodeValues &outputs,
+      Vector &allocation_probs,
+      Vector &complementary_allocation_probs,
+      Vector &input_workspace) const {
+    if (layer_index_ <= 0) return;
     std::vector<bool> &inputs(outputs[layer_index_ - 1]);
     Nnet::to_numeric(inputs, input_workspace);
     for (int i = 0; i < allocation_probs.size(); ++i) {
@@ -67,7 +95,6 @@ namespace BOOM {
         input_workspace[i] = 1 - input_workspace[i];
       }
     }
-    store_latent_data(outputs);
   }
 
   //---------------------------------------------------------------------------
@@ -132,6 +159,20 @@ namespace BOOM {
     }
   }
 
+  //---------------------------------------------------------------------------
+  void HiddenLayerImputer::combine_latent_data(const HiddenLayerSuf &suf) {
+    if (layer_index_ <= 0) {
+      report_error("Don't call combine_latent_data for hidden layer 0.");
+    }
+    for (const auto &el : suf.counts()) {
+      std::vector<Ptr<BinomialRegressionData>> data_row = get_data_row(
+          el.first);
+      for (int i = 0; i < data_row.size(); ++i) {
+        data_row[i]->increment(el.second.successes[i], el.second.trials);
+      }
+    }
+  }
+
   //---------------------------------------------------------------------------
   std::vector<Ptr<BinomialRegressionData>> HiddenLayerImputer::get_data_row(
       const std::vector<bool> &inputs) {
@@ -18,6 +18,7 @@
   Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
 */
 
+#include <map>
 #include "Models/Nnet/Nnet.hpp"
 #include "Models/PosteriorSamplers/PosteriorSampler.hpp"
 
@@ -27,6 +28,36 @@ namespace HiddenLayerImputerTestNamespace {
 }
 
 namespace BOOM {
+  // Imputed data for one hidden layer, summarized by the vector of inputs to
+  // the layer.  For each distinct input vector it records the number of
+  // observations with those inputs ('trials') and the number of those
+  // observations for which each node was active ('successes').
+  //
+  // These are the sufficient statistics for the logistic regressions in the
+  // layer.  They let several threads impute latent data at once, each into
+  // its own HiddenLayerSuf, with the results merged into the layer's models
+  // afterwards by HiddenLayerImputer::combine_latent_data.
+  class HiddenLayerSuf {
+   public:
+    struct Counts {
+      double trials;
+      Vector successes;
+    };
+
+    void clear() { counts_.clear(); }
+
+    // Record the imputed inputs and outputs of the layer for a single
+    // observation.
+    void add(const std::vector<bool> &inputs, const std::vector<bool> &outputs);
+
+    const std::map<std::vector<bool>, Counts> &counts() const {
+      return counts_;
+    }
+
+   private:
+    std::map<std::vector<bool>, Counts> counts_;
+  };
+
   // A HiddenLayerImputer manages the imputed data for a single hidden layer in
   // a feed forward neural network.
   class HiddenLayerImputer {
@@ -65,6 +96,16 @@ namespace BOOM {
                        Vector &complementary_allocation_probs,
                        Vector &input_workspace);
 
+    // The MCMC draw from impute_inputs, without storing the imputed data.
+    // This function only reads the layer's parameters, so it may be called
+    // from several threads at once.  The arguments and the effect on
+    // outputs[layer_index_ - 1] are the same as impute_inputs.
+    void draw_inputs(RNG &rng,
+                     Nnet::HiddenNodeValues &outputs,
+                     Vector &allocation_probs,
+                     Vector &complementary_allocation_probs,
+                     Vector &input_workspace) const;
+
     // The conditional distribution for the vector of inputs to this layer,
     // given the set of predictors and model parameters, and given the outputs
     // for the layer.
@@ -106,6 +147,10 @@ namespace BOOM {
     // managed by this object.
     void store_latent_data(Nnet::HiddenNodeValues &outputs);
 
+    // Add latent data accumulated away from the layer (e.g. by a worker
+    // thread) to the logistic regression models in the managed layer.
+    void combine_latent_data(const HiddenLayerSuf &suf);
+
    private:
     // For testing.  Let the test rig access private data.
     friend class HiddenLayerImputerTestNamespace::HiddenLayerImputerTest;
@@ -83,6 +83,49 @@ namespace HiddenLayerImputerTestNamespace {
     EXPECT_NEAR(logp, logp_manual, 1e-7);
   }
 
+  //===========================================================================
+  // Latent data accumulated in a HiddenLayerSuf and then combined should give
+  // the same logistic regression data as storing it one observation at a
+  // time.
+  TEST_F(HiddenLayerImputerTest, CombineLatentDataTest) {
+    Ptr<HiddenLayer> other_layer1 = layer1_->clone();
+    HiddenLayerImputer other_imputer(other_layer1, 1);
+
+    HiddenLayerSuf suf;
+    for (int obs = 0; obs < 50; ++obs) {
+      Nnet::HiddenNodeValues outputs;
+      outputs.push_back(std::vector<bool>(layer0_->output_dimension()));
+      outputs.push_back(std::vector<bool>(layer1_->output_dimension()));
+      // Only use a few input patterns, so some of them repeat.
+      for (int i = 0; i < 2; ++i) {
+        outputs[0][i] = runif() < .5;
+      }
+      for (int i = 0; i < outputs[1].size(); ++i) {
+        outputs[1][i] = runif() < .5;
+      }
+      imputer1_.store_latent_data(outputs);
+      suf.add(outputs[0], outputs[1]);
+    }
+    EXPECT_LE(suf.counts().size(), 4);
+    other_imputer.combine_latent_data(suf);
+
+    for (int node = 0; node < layer1_->output_dimension(); ++node) {
+      const auto &data(layer1_->logistic_regression(node)->dat());
+      const auto &other_data(other_layer1->logistic_regression(node)->dat());
+      ASSERT_EQ(data.size(), other_data.size());
+      double total_y = 0, total_n = 0, other_total_y = 0, other_total_n = 0;
+      for (int i = 0; i < data.size(); ++i) {
+        total_y += data[i]->y();
+        total_n += data[i]->n();
+        other_total_y += other_data[i]->y();
+        other_total_n += other_data[i]->n();
+      }
+      EXPECT_DOUBLE_EQ(total_y, other_total_y);
+      EXPECT_DOUBLE_EQ(total_n, other_total_n);
+      EXPECT_DOUBLE_EQ(50, total_n);
+    }
+  }
+
   //===========================================================================
   TEST_F(HiddenLayerImputerTest, ImputeInputsTest) {
     Vector allocation_probs(layer1_->input_dimension());
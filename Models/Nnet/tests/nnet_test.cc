@@ -197,5 +197,31 @@ namespace {
     EXPECT_TRUE(VectorEquals(activation_probs[0], manual_activation_probs[0]));
     EXPECT_TRUE(VectorEquals(activation_probs[1], manual_activation_probs[1]));
   }
+
+  //===========================================================================
+  // The batched forward pass should agree with the one observation at a time
+  // version.
+  TEST_F(NnetTest, BatchedActivationProbabilities) {
+    int nobs = 300;
+    Matrix X(nobs, layer1_->input_dimension());
+    X.randomize();
+
+    std::vector<Matrix> block_probs;
+    network_.fill_activation_probabilities(X, block_probs);
+    ASSERT_EQ(2, block_probs.size());
+    EXPECT_EQ(nobs, block_probs[0].nrow());
+    EXPECT_EQ(2, block_probs[0].ncol());
+    EXPECT_EQ(3, block_probs[1].ncol());
+
+    std::vector<Vector> activation_probs =
+        network_.activation_probability_workspace();
+    Vector predictions = network_.predict(X);
+    for (int i = 0; i < nobs; ++i) {
+      network_.fill_activation_probabilities(X.row(i), activation_probs);
+      EXPECT_TRUE(VectorEquals(activation_probs[0], block_probs[0].row(i)));
+      EXPECT_TRUE(VectorEquals(activation_probs[1], block_probs[1].row(i)));
+      EXPECT_NEAR(predictions[i], network_.predict(X.row(i)), 1e-8);
+    }
+  }
   
 }  // namespace
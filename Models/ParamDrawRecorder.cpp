@@ -0,0 +1,234 @@
+// Copyright 2018 Google LLC. All Rights Reserved.
+/*
+  Copyright (C) 2005-2018 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#include "Models/ParamDrawRecorder.hpp"
+#include <algorithm>
+#include <sstream>
+#include "cpputil/report_error.hpp"
+
+namespace BOOM {
+
+  void ParamDrawRecorder::add_parameter(const std::string &name,
+                                        const Ptr<Params> &prm,
+                                        bool minimal, int thin,
+                                        bool single_precision) {
+    if (!prm) {
+      report_error("A null parameter cannot be recorded.");
+    }
+    if (parameter_index(name) >= 0) {
+      std::ostringstream err;
+      err << "A parameter named '" << name << "' is already being recorded.";
+      report_error(err.str());
+    }
+    if (thin < 1) {
+      report_error("thin must be at least 1.");
+    }
+    names_.push_back(name);
+    parameters_.push_back(prm);
+    minimal_.push_back(minimal);
+    thin_.push_back(thin);
+    single_precision_.push_back(single_precision);
+    dims_.push_back(0);
+    draws_.push_back(Matrix());
+    single_precision_draws_.push_back(std::vector<float>());
+    monitored_.push_back(false);
+  }
+
+  void ParamDrawRecorder::monitor_convergence(
+      const std::vector<std::string> &names, int max_batches) {
+    if (parameters_.empty()) {
+      report_error("Parameters must be registered before they can be "
+                   "monitored.");
+    }
+    std::vector<bool> monitored(parameters_.size(), names.empty());
+    for (const auto &name : names) {
+      int index = parameter_index(name);
+      if (index < 0) {
+        report_error("No parameter named '" + name +
+                     "' is being recorded.");
+      }
+      monitored[index] = true;
+    }
+    monitored_ = monitored;
+    monitor_max_batches_ = max_batches;
+  }
+
+  void ParamDrawRecorder::prepare_to_write(int niter) {
+    if (niter < 0) {
+      report_error("niter must be non-negative.");
+    }
+    niter_ = niter;
+    position_ = 0;
+    for (int i = 0; i < parameters_.size(); ++i) {
+      dims_[i] = parameters_[i]->size(minimal_[i]);
+      int nstored = number_of_stored_draws(i);
+      if (single_precision_[i]) {
+        draws_[i] = Matrix();
+        single_precision_draws_[i].assign(dims_[i] * nstored, 0.0f);
+      } else {
+        draws_[i].resize(dims_[i], nstored);
+        draws_[i] = 0.0;
+        single_precision_draws_[i].clear();
+      }
+    }
+
+    int monitored_dim = 0;
+    for (int i = 0; i < parameters_.size(); ++i) {
+      if (monitored_[i]) monitored_dim += dims_[i];
+    }
+    if (monitored_dim > 0) {
+      monitor_.reset(new McmcConvergenceMonitor(
+          1, monitored_dim, monitor_max_batches_));
+      monitored_draw_.resize(monitored_dim);
+    } else {
+      monitor_.reset();
+    }
+  }
+
+  void ParamDrawRecorder::record() {
+    if (position_ >= niter_) {
+      std::ostringstream err;
+      err << "Space was allocated for " << niter_ << " draws, all of which "
+          << "have been recorded.";
+      report_error(err.str());
+    }
+    int monitor_position = 0;
+    for (int i = 0; i < parameters_.size(); ++i) {
+      bool store = position_ % thin_[i] == 0;
+      bool monitor = monitor_ && monitored_[i];
+      if (!store && !monitor) continue;
+      Vector value = parameters_[i]->vectorize(minimal_[i]);
+      if (value.size() != dims_[i]) {
+        std::ostringstream err;
+        err << "The size of parameter '" << names_[i] << "' changed from "
+            << dims_[i] << " to " << value.size()
+            << " after space was allocated.";
+        report_error(err.str());
+      }
+      if (store) {
+        int column = position_ / thin_[i];
+        if (single_precision_[i]) {
+          std::copy(value.begin(), value.end(),
+                    single_precision_draws_[i].begin() + column * dims_[i]);
+        } else {
+          draws_[i].col(column) = value;
+        }
+      }
+      if (monitor) {
+        std::copy(value.begin(), value.end(),
+                  monitored_draw_.begin() + monitor_position);
+        monitor_position += dims_[i];
+      }
+    }
+    if (monitor_) {
+      monitor_->add(0, monitored_draw_);
+    }
+    ++position_;
+  }
+
+  void ParamDrawRecorder::sample_and_record(Model *model, int niter) {
+    run_mcmc(model, niter, 0, 1, this);
+  }
+
+  const Matrix &ParamDrawRecorder::draws(int i) const {
+    if (single_precision_[i]) {
+      report_error("Parameter '" + names_[i] + "' is stored in single "
+                   "precision.");
+    }
+    return draws_[i];
+  }
+
+  const std::vector<float> &ParamDrawRecorder::single_precision_draws(
+      int i) const {
+    if (!single_precision_[i]) {
+      report_error("Parameter '" + names_[i] + "' is stored in double "
+                   "precision.");
+    }
+    return single_precision_draws_[i];
+  }
+
+  Vector ParamDrawRecorder::draw(int i, int j) const {
+    if (single_precision_[i]) {
+      auto begin = single_precision_draws_[i].begin() + j * dims_[i];
+      return Vector(begin, begin + dims_[i]);
+    }
+    return draws_[i].col(j);
+  }
+
+  MemoryFootprint ParamDrawRecorder::memory_footprint() const {
+    std::size_t bytes = 0;
+    for (const Matrix &draws : draws_) {
+      bytes += draws.size() * sizeof(double);
+    }
+    for (const std::vector<float> &draws : single_precision_draws_) {
+      bytes += heap_bytes(draws);
+    }
+    return MemoryFootprint(MemoryFootprint::kMcmcOutput, bytes);
+  }
+
+  int ParamDrawRecorder::parameter_index(const std::string &name) const {
+    for (int i = 0; i < names_.size(); ++i) {
+      if (names_[i] == name) return i;
+    }
+    return -1;
+  }
+
+  int run_mcmc(Model *model, int niter, int burn, int thin,
+               ParamDrawRecorder *recorder, int callback_every,
+               const std::function<void(int)> &callback,
+               const McmcStoppingRule &stopping_rule) {
+    if (!model) {
+      report_error("run_mcmc needs a model.");
+    }
+    if (niter < 0 || burn < 0) {
+      report_error("niter and burn must be non-negative.");
+    }
+    if (thin < 1) {
+      report_error("thin must be at least 1.");
+    }
+    if (recorder) {
+      recorder->prepare_to_write(niter);
+    }
+    if (stopping_rule && !(recorder && recorder->convergence_monitor())) {
+      report_error("A stopping rule needs a recorder that is monitoring "
+                   "convergence.");
+    }
+    int check_every = callback_every > 0 ? callback_every : 1;
+    for (int i = 0; i < burn; ++i) {
+      model->sample_posterior();
+    }
+    for (int i = 0; i < niter; ++i) {
+      for (int j = 0; j < thin; ++j) {
+        model->sample_posterior();
+      }
+      if (recorder) {
+        recorder->record();
+      }
+      if (callback_every > 0 && callback && (i + 1) % callback_every == 0) {
+        callback(i + 1);
+      }
+      if (stopping_rule && (i + 1) % check_every == 0
+          && stopping_rule(*recorder->convergence_monitor())) {
+        return i + 1;
+      }
+    }
+    return niter;
+  }
+
+}  // namespace BOOM
@@ -0,0 +1,202 @@
+// Copyright 2018 Google LLC. All Rights Reserved.
+/*
+  Copyright (C) 2005-2018 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#ifndef BOOM_MODELS_PARAM_DRAW_RECORDER_HPP_
+#define BOOM_MODELS_PARAM_DRAW_RECORDER_HPP_
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include "LinAlg/Matrix.hpp"
+#include "Models/ModelTypes.hpp"
+#include "Models/ParamTypes.hpp"
+#include "cpputil/Ptr.hpp"
+#include "stats/mcmc_convergence.hpp"
+
+namespace BOOM {
+
+  // Records MCMC draws of a collection of parameters into storage that is
+  // allocated once, before the MCMC run begins.  This plays the role that
+  // RListIoManager plays for R, for interfaces (e.g. Python) that want the
+  // draws as plain numeric arrays.
+  //
+  // The basic idiom is
+  //   ParamDrawRecorder recorder;
+  //   recorder.add_parameter("beta", model->coef_prm());
+  //   recorder.add_parameter("sigsq", model->Sigsq_prm());
+  //   recorder.prepare_to_write(niter);
+  //   for (int i = 0; i < niter; ++i) {
+  //     model->sample_posterior();
+  //     recorder.record();
+  //   }
+  //
+  // The draws for each parameter are stored one draw per column, so each
+  // call to record() writes to contiguous memory.  Viewed as a row-major
+  // array, the storage is an (niter x dim) matrix with one draw per row,
+  // which is how it is presented to Python without copying.
+  class ParamDrawRecorder {
+   public:
+    // Register a parameter to be recorded.
+    //
+    // Args:
+    //   name:  The name of the parameter.  Names must be unique.
+    //   prm:  The parameter to be recorded.
+    //   minimal: Passed to prm->vectorize().  If false then parameters with
+    //     redundant representations (e.g. symmetric matrices) are stored in
+    //     full.
+    //   thin: Store only the draws from calls 0, thin, 2 * thin, ... to
+    //     record().
+    //   single_precision: If true the draws are stored as floats, halving
+    //     the storage cost.
+    void add_parameter(const std::string &name, const Ptr<Params> &prm,
+                       bool minimal = false, int thin = 1,
+                       bool single_precision = false);
+
+    // Follow the convergence of the named parameters as draws are recorded.
+    // Each call to record() (including calls whose draws are thinned away)
+    // adds the current values of the named parameters, in the order in which
+    // they were registered, to a single-chain McmcConvergenceMonitor.  The
+    // monitor is rebuilt by each call to prepare_to_write().
+    //
+    // Args:
+    //   names: The parameters to monitor.  If empty, all registered
+    //     parameters are monitored.
+    //   max_batches:  Passed to the McmcConvergenceMonitor.
+    void monitor_convergence(
+        const std::vector<std::string> &names = std::vector<std::string>(),
+        int max_batches = 64);
+
+    // The monitor created by the most recent call to prepare_to_write(), or
+    // nullptr if no parameters are being monitored.
+    const McmcConvergenceMonitor *convergence_monitor() const {
+      return monitor_.get();
+    }
+
+    // Allocate space for niter draws of each registered parameter, and reset
+    // the write position to the first draw.  The sizes of the parameters
+    // are taken from their current values.
+    void prepare_to_write(int niter);
+
+    // Store the current value of each registered parameter, and advance to
+    // the next draw.  It is an error to call record() more than niter()
+    // times after a call to prepare_to_write().
+    void record();
+
+    // Run 'niter' iterations of the model's posterior sampler, recording the
+    // parameters after each one.  Space is allocated for niter draws.
+    void sample_and_record(Model *model, int niter);
+
+    // The number of draws allocated by the most recent call to
+    // prepare_to_write().
+    int niter() const { return niter_; }
+
+    // The number of calls to record() since the last call to
+    // prepare_to_write().
+    int number_recorded() const { return position_; }
+
+    int number_of_parameters() const { return parameters_.size(); }
+    const std::string &name(int i) const { return names_[i]; }
+    const std::vector<std::string> &names() const { return names_; }
+
+    // The index of the parameter with the given name, or -1 if no such
+    // parameter has been registered.
+    int parameter_index(const std::string &name) const;
+
+    // The number of values in a single draw of parameter i.
+    int dim(int i) const { return dims_[i]; }
+
+    int thin(int i) const { return thin_[i]; }
+    bool single_precision(int i) const { return single_precision_[i]; }
+
+    // The number of draws of parameter i allocated by prepare_to_write(),
+    // after thinning.
+    int number_of_stored_draws(int i) const {
+      return (niter_ + thin_[i] - 1) / thin_[i];
+    }
+
+    // The storage for parameter i, which must be stored in double
+    // precision.  Column j is the j'th stored draw.  Columns that have not
+    // been written hold zeros.
+    const Matrix &draws(int i) const;
+
+    // The storage for parameter i, which must be stored in single precision.
+    // Draw j occupies elements [j * dim(i), (j + 1) * dim(i)).
+    const std::vector<float> &single_precision_draws(int i) const;
+
+    // Stored draw j of parameter i.
+    Vector draw(int i, int j) const;
+
+    // The storage allocated for the draws, reported under
+    // MemoryFootprint::kMcmcOutput.
+    MemoryFootprint memory_footprint() const;
+
+   private:
+    std::vector<std::string> names_;
+    std::vector<Ptr<Params>> parameters_;
+    std::vector<bool> minimal_;
+    std::vector<int> thin_;
+    std::vector<bool> single_precision_;
+    std::vector<int> dims_;
+    std::vector<Matrix> draws_;
+    std::vector<std::vector<float>> single_precision_draws_;
+    int niter_ = 0;
+    int position_ = 0;
+
+    // Convergence monitoring.  monitored_[i] is true if parameter i is fed
+    // to the monitor.
+    std::vector<bool> monitored_;
+    int monitor_max_batches_ = 64;
+    std::unique_ptr<McmcConvergenceMonitor> monitor_;
+    Vector monitored_draw_;
+  };
+
+  //===========================================================================
+  // Run an MCMC loop on a model.
+  //
+  // Args:
+  //   model:  The model to be sampled.  Its posterior sampler must be set.
+  //   niter:  The number of draws to keep.
+  //   burn:  The number of initial iterations to discard.
+  //   thin: The number of calls to model->sample_posterior() per kept draw.
+  //     A value of 1 keeps every iteration after the burn-in.
+  //   recorder: If non-NULL, space is allocated for niter draws and each kept
+  //     draw is recorded.
+  //   callback_every: If positive, 'callback' is called after every
+  //     callback_every kept draws.
+  //   callback: Called with the number of kept draws so far, e.g. to report
+  //     progress or to check for an interrupt.  Exceptions thrown by the
+  //     callback end the run.
+  //   stopping_rule: If set, the run ends as soon as the rule is satisfied by
+  //     the recorder's convergence monitor, which must exist.  The rule is
+  //     checked after every callback_every kept draws, or after every kept
+  //     draw if callback_every is not positive.
+  //
+  // Returns:
+  //   The number of draws kept, which is less than niter if the stopping
+  //   rule ended the run.
+  int run_mcmc(Model *model, int niter, int burn = 0, int thin = 1,
+               ParamDrawRecorder *recorder = nullptr, int callback_every = 0,
+               const std::function<void(int)> &callback =
+                   std::function<void(int)>(),
+               const McmcStoppingRule &stopping_rule = McmcStoppingRule());
+
+}  // namespace BOOM
+
+#endif  // BOOM_MODELS_PARAM_DRAW_RECORDER_HPP_
@@ -17,6 +17,7 @@
   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
 */
 #include <algorithm>
+#include <sstream>
 #include <string>
 
 #include "LinAlg/VectorView.hpp"
@@ -25,19 +26,57 @@
 
 namespace BOOM {
 
+  namespace {
+    // Views of [offset, offset + length) that are valid even when length is
+    // zero and offset is the end of the vector.
+    VectorView segment(VectorView v, int offset, int length) {
+      return VectorView(v.data() + offset * v.stride(), length, v.stride());
+    }
+
+    ConstVectorView segment(const ConstVectorView &v, int offset,
+                            int length) {
+      return ConstVectorView(v.data() + offset * v.stride(), length,
+                             v.stride());
+    }
+
+    void check_span_size(int span_size, int param_size) {
+      if (span_size != param_size) {
+        std::ostringstream err;
+        err << "A span of size " << span_size << " was used to hold a "
+            << "parameter of size " << param_size << ".";
+        report_error(err.str());
+      }
+    }
+
+    // Scratch space for setting VectorParams and MatrixParams through their
+    // set() methods, which child classes override to maintain invariants.
+    // Reusing the storage avoids an allocation on each call.
+    Vector &vector_workspace() {
+      static thread_local Vector workspace;
+      return workspace;
+    }
+
+    Matrix &matrix_workspace() {
+      static thread_local Matrix workspace;
+      return workspace;
+    }
+  }  // namespace
+
   Vector vectorize(const std::vector<Ptr<Params>> &v, bool minimal) {
     uint N = v.size();
     uint vec_size(0);
 
     for (uint i = 0; i < N; ++i) vec_size += v[i]->size(minimal);
     Vector ans(vec_size);
-    Vector::iterator it = ans.begin();
+    int offset = 0;
     for (uint i = 0; i < N; ++i) {
-      Vector tmp = v[i]->vectorize(minimal);
-      it = std::copy(tmp.begin(), tmp.end(), it);
+      int n = v[i]->size(minimal);
+      v[i]->vectorize_into(segment(VectorView(ans), offset, n), minimal);
+      offset += n;
     }
     return ans;
   }
+
   void unvectorize(std::vector<Ptr<Params>> &pvec,
                    const Vector &v,
                    bool minimal) {
@@ -47,6 +86,56 @@ namespace BOOM {
     }
   }
 
+  //======================================================================
+  ParamLayout::ParamLayout(const std::vector<Ptr<Params>> &params,
+                           bool minimal)
+      : params_(params), offsets_(1, 0), minimal_(minimal) {
+    offsets_.reserve(params_.size() + 1);
+    for (const auto &prm : params_) {
+      offsets_.push_back(offsets_.back() + prm->size(minimal_));
+    }
+  }
+
+  bool ParamLayout::matches(const std::vector<Ptr<Params>> &params) const {
+    if (params.size() != params_.size()) return false;
+    for (int i = 0; i < params_.size(); ++i) {
+      if (params[i] != params_[i] || params[i]->size(minimal_) != size(i)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  void ParamLayout::vectorize(VectorView out) const {
+    check_span_size(out.size(), size());
+    for (int i = 0; i < params_.size(); ++i) {
+      params_[i]->vectorize_into(segment(out, offset(i), size(i)), minimal_);
+    }
+  }
+
+  Vector ParamLayout::vectorize() const {
+    Vector ans(size());
+    vectorize(VectorView(ans));
+    return ans;
+  }
+
+  int ParamLayout::unvectorize(const ConstVectorView &values) {
+    check_span_size(values.size(), size());
+    workspace_.resize(size());
+    int number_changed = 0;
+    for (int i = 0; i < params_.size(); ++i) {
+      ConstVectorView new_values(segment(values, offset(i), size(i)));
+      VectorView current(segment(VectorView(workspace_), offset(i), size(i)));
+      params_[i]->vectorize_into(current, minimal_);
+      if (!std::equal(new_values.begin(), new_values.end(),
+                      current.begin())) {
+        params_[i]->unvectorize_from(new_values, minimal_);
+        ++number_changed;
+      }
+    }
+    return number_changed;
+  }
+
   std::ostream &operator<<(std::ostream &out,
                            const std::vector<Ptr<Params>> &v) {
     out << vectorize(v, false);
@@ -62,6 +151,19 @@ namespace BOOM {
     return this->unvectorize(it, minimal);
   }
 
+  void Params::vectorize_into(VectorView out, bool minimal) const {
+    Vector values = vectorize(minimal);
+    check_span_size(out.size(), values.size());
+    out = values;
+  }
+
+  void Params::unvectorize_from(const ConstVectorView &values, bool minimal) {
+    check_span_size(values.size(), size(minimal));
+    const Vector tmp(values);
+    Vector::const_iterator it = tmp.begin();
+    unvectorize(it, minimal);
+  }
+
   //======================================================================
 
   typedef UnivData<double> UDD;
@@ -82,6 +184,16 @@ namespace BOOM {
     return ++v;
   }
 
+  void UnivParams::vectorize_into(VectorView out, bool) const {
+    check_span_size(out.size(), 1);
+    out[0] = value();
+  }
+
+  void UnivParams::unvectorize_from(const ConstVectorView &values, bool) {
+    check_span_size(values.size(), 1);
+    set(values[0]);
+  }
+
   void UnivParamsObserver::set(const double &rhs, bool Signal) {
     report_error("set is disabled.");
   }
@@ -110,6 +222,19 @@ namespace BOOM {
     return e;
   }
 
+  void VectorParams::vectorize_into(VectorView out, bool) const {
+    check_span_size(out.size(), dim());
+    out = value();
+  }
+
+  void VectorParams::unvectorize_from(const ConstVectorView &values, bool) {
+    check_span_size(values.size(), dim());
+    Vector &workspace(vector_workspace());
+    workspace.resize(values.size());
+    std::copy(values.begin(), values.end(), workspace.begin());
+    set(workspace);
+  }
+
   //============================================================
   typedef MatrixData MD;
   typedef MatrixParams MP;
@@ -137,4 +262,17 @@ namespace BOOM {
     return e;
   }
 
+  void MP::vectorize_into(VectorView out, bool) const {
+    check_span_size(out.size(), size());
+    std::copy(value().begin(), value().end(), out.begin());
+  }
+
+  void MP::unvectorize_from(const ConstVectorView &values, bool) {
+    check_span_size(values.size(), size());
+    Matrix &workspace(matrix_workspace());
+    workspace.resize(nrow(), ncol());
+    std::copy(values.begin(), values.end(), workspace.begin());
+    set(workspace);
+  }
+
 }  // namespace BOOM
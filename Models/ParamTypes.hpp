@@ -20,6 +20,7 @@
 #ifndef BOOM_PARAM_TYPES_H
 #define BOOM_PARAM_TYPES_H
 
+#include "LinAlg/VectorView.hpp"
 #include "Models/DataTypes.hpp"
 
 namespace BOOM {
@@ -66,6 +67,15 @@ namespace BOOM {
                                                bool minimal = true) = 0;
     virtual Vector::const_iterator unvectorize(const Vector &v,
                                                bool minimal = true);
+
+    // Versions of vectorize() and unvectorize() that read and write a
+    // caller-supplied span of exactly size(minimal) elements.  The default
+    // implementations go through vectorize() and unvectorize().  Child
+    // classes that can copy their values directly should override both, so
+    // that bulk parameter transfers (see ParamLayout) need no temporaries.
+    virtual void vectorize_into(VectorView out, bool minimal = true) const;
+    virtual void unvectorize_from(const ConstVectorView &values,
+                                  bool minimal = true);
   };
 
   //============================================================
@@ -79,6 +89,58 @@ namespace BOOM {
   std::ostream &operator<<(std::ostream &out,
                            const std::vector<Ptr<Params>> &v);
 
+  //============================================================
+  // The position of each element of a collection of Params in the vector
+  // produced by vectorize(params, minimal).  The offsets are computed once,
+  // so the parameters can be repeatedly saved and restored (e.g. while an
+  // optimizer evaluates a model at trial parameter values) with one copy
+  // per Params and no intermediate vectors.
+  //
+  // The layout holds the sizes the Params had when it was built.  If a
+  // Params changes size (e.g. a GlmCoefs gains a variable) the layout must
+  // be rebuilt.
+  class ParamLayout {
+   public:
+    ParamLayout() : offsets_(1, 0), minimal_(true) {}
+    explicit ParamLayout(const std::vector<Ptr<Params>> &params,
+                         bool minimal = true);
+
+    int number_of_params() const { return params_.size(); }
+    bool minimal() const { return minimal_; }
+
+    // The total number of elements in the vectorized parameters.
+    int size() const { return offsets_.back(); }
+
+    // The position and size of params[i] in the vectorized parameters.
+    int offset(int i) const { return offsets_[i]; }
+    int size(int i) const { return offsets_[i + 1] - offsets_[i]; }
+
+    // Returns true if 'params' is the collection described by this layout,
+    // with the same sizes.
+    bool matches(const std::vector<Ptr<Params>> &params) const;
+
+    // Write the current parameter values into 'out', which must have
+    // size() elements.
+    void vectorize(VectorView out) const;
+    Vector vectorize() const;
+
+    // Set the parameters to the values in 'values', which must have size()
+    // elements.  Params whose values are unchanged are not set, so their
+    // observers are not notified.
+    //
+    // Returns:
+    //   The number of Params whose values changed.
+    int unvectorize(const ConstVectorView &values);
+
+   private:
+    std::vector<Ptr<Params>> params_;
+    std::vector<int> offsets_;
+    bool minimal_;
+
+    // Holds the current values of the parameters during unvectorize().
+    Vector workspace_;
+  };
+
   //============================================================
 
   class UnivParams : virtual public Params, public DoubleData {
@@ -93,6 +155,9 @@ namespace BOOM {
     Vector::const_iterator unvectorize(Vector::const_iterator &v,
                                        bool minimal = true) override;
     using Params::unvectorize;
+    void vectorize_into(VectorView out, bool minimal = true) const override;
+    void unvectorize_from(const ConstVectorView &values,
+                          bool minimal = true) override;
   };
 
   //===========================================================================
@@ -149,6 +214,9 @@ namespace BOOM {
     Vector::const_iterator unvectorize(Vector::const_iterator &v,
                                        bool minimal = true) override;
     using Params::unvectorize;
+    void vectorize_into(VectorView out, bool minimal = true) const override;
+    void unvectorize_from(const ConstVectorView &values,
+                          bool minimal = true) override;
   };
 
   //------------------------------------------------------------
@@ -164,6 +232,9 @@ namespace BOOM {
     Vector::const_iterator unvectorize(Vector::const_iterator &v,
                                        bool minimal = true) override;
     using Params::unvectorize;
+    void vectorize_into(VectorView out, bool minimal = true) const override;
+    void unvectorize_from(const ConstVectorView &values,
+                          bool minimal = true) override;
   };
 
 }  // namespace BOOM
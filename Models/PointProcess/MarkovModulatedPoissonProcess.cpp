@@ -298,6 +298,13 @@ namespace BOOM {
           }
         }
       }
+
+      event_loglikelihood_ = log_event_rate_;
+      if (!minimal_mixture_components_.empty()) {
+        for (int i = 0; i < processes_.size(); ++i) {
+          event_loglikelihood_.row(i) += logp_.row(mixture_component_id_[i]);
+        }
+      }
     }
 
     // If the call to 'evaluate' indicated that 'process' was not a
@@ -606,6 +613,9 @@ namespace BOOM {
       report_error(err.str());
     }
     process_info_->evaluate(process, source);
+    // The hazards for every state and every event in one matrix product.
+    state_cumulative_hazard_ =
+        state_membership_ * process_info_->cumulative_hazard();
     double loglike = initialize_filter(process);
     for (int i = 0; i < process.number_of_events(); ++i) {
       loglike += fwd_1(i, *process_info_);
@@ -627,21 +637,24 @@ namespace BOOM {
     Matrix &P(filter_[t]);  // Do we need a sparse matrix here?
     P = negative_infinity();
     int S = hmm_state_space_size();
+    ConstVectorView event_loglikelihood(
+        process_info.event_loglikelihood().col(t));
     for (int r = 0; r < S; ++r) {
-      const HmmState *first_state = hmm_states_[r].get();
       double log_prior_hazard =
-          log(pi0_[r]) -
-          process_info.conditional_cumulative_hazard(first_state, t);
-      typedef std::vector<HmmState *> StateVector;
-      const StateVector &potential_states(
-          first_state->potential_outgoing_transitions());
-      for (StateVector::const_iterator it = potential_states.begin();
-           it != potential_states.end(); ++it) {
-        const HmmState *second_state = *it;
-        int s = second_state->id_number();
-        P(r, s) =
-            log_prior_hazard + conditional_event_loglikelihood(
-                                   t, first_state, second_state, process_info);
+          log(pi0_[r]) - state_cumulative_hazard_(r, t);
+      for (const Transition &transition : transitions_[r]) {
+        const std::vector<int> &culprits(transition.culprits);
+        double loglike;
+        if (culprits.size() == 1) {
+          loglike = event_loglikelihood[culprits[0]];
+        } else {
+          mutable_workspace_.resize(culprits.size());
+          for (int i = 0; i < culprits.size(); ++i) {
+            mutable_workspace_[i] = event_loglikelihood[culprits[i]];
+          }
+          loglike = lse(mutable_workspace_);
+        }
+        P(r, transition.to) = log_prior_hazard + loglike;
       }
     }
     double loglike = normalize_filter(P);
@@ -1047,6 +1060,36 @@ namespace BOOM {
       }
     }
     process_info_.reset(new ProcessInfo(processes, mixture_components));
+    build_transition_tables();
+  }
+
+  void MMPP::build_transition_tables() {
+    int S = hmm_state_space_size();
+    state_membership_.resize(S, process_info_->number_of_processes());
+    state_membership_ = 0.0;
+    transitions_.assign(S, std::vector<Transition>());
+    for (int r = 0; r < S; ++r) {
+      const HmmState *first_state = hmm_states_[r].get();
+      for (const PoissonProcess *process : first_state->active_processes()) {
+        state_membership_(r, process_info_->process_id(process)) = 1.0;
+      }
+      for (const HmmState *second_state :
+               first_state->potential_outgoing_transitions()) {
+        const std::vector<PoissonProcess *> &potential_culprits(
+            first_state->processes_transitioning_to(second_state));
+        if (potential_culprits.empty()) {
+          report_error(
+              "potential_culprits was empty in "
+              "MMPP::build_transition_tables.");
+        }
+        Transition transition;
+        transition.to = second_state->id_number();
+        for (const PoissonProcess *process : potential_culprits) {
+          transition.culprits.push_back(process_info_->process_id(process));
+        }
+        transitions_[r].push_back(transition);
+      }
+    }
   }
 
 }  // namespace BOOM
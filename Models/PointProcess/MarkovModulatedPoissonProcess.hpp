@@ -172,10 +172,26 @@ namespace BOOM {
       // 'evaluate'.
       double conditional_cumulative_hazard(const HmmState *state, int t) const;
 
-     private:
-      // Returns the position of 'process' in processes_;
+      // Returns the position of 'process' in processes_.  This is the row
+      // corresponding to 'process' in cumulative_hazard() and
+      // event_loglikelihood().
       int process_id(const PoissonProcess *process) const;
 
+      int number_of_processes() const { return processes_.size(); }
+
+      // Cumulative hazard for the component Poisson processes between
+      // events t-1 and t.  Columns are time.  Rows correspond to
+      // process_id().
+      const Matrix &cumulative_hazard() const { return cumulative_hazard_; }
+
+      // Element (i, t) is log_event_rate(process, t) +
+      // mixture_log_likelihood(process, t), where process_id(process) == i.
+      const Matrix &event_loglikelihood() const {
+        return event_loglikelihood_;
+      }
+
+     private:
+
       const double neginf_;
       std::vector<PoissonProcess *> processes_;
 
@@ -208,6 +224,10 @@ namespace BOOM {
       // The log_density of the mixture components, if any are present.
       // Columns are time.  Rows correspond to mixture_component_id_.
       Matrix logp_;
+
+      // The sum of log_event_rate_ and the matching row of logp_.  Columns
+      // are time.  Rows correspond to process_id_.
+      Matrix event_loglikelihood_;
     };
 
   }  // namespace MmppHelper
@@ -544,6 +564,21 @@ namespace BOOM {
     double initialize_filter(const PointProcess &process);
     void create_process_info();
 
+    // Translates the hmm state space into the rows of the matrices held by
+    // process_info_, so the forward filter can work with integer offsets
+    // instead of looking up PoissonProcess pointers.  Called by
+    // create_process_info().
+    void build_transition_tables();
+
+    // One outgoing transition from an hmm state.
+    struct Transition {
+      // The id_number of the destination state.
+      int to;
+      // The process_info_ ids of the processes that could have caused the
+      // transition.
+      std::vector<int> culprits;
+    };
+
     // Storage needed for forward_backward filtering.  It is managed
     // during the call to initialize_filter, so it does not need
     // special attention in the constructor.
@@ -553,6 +588,17 @@ namespace BOOM {
     double last_loglike_;
     mutable Vector mutable_workspace_;
 
+    // Element (r, i) is 1 if process_info_ process i is active in hmm state
+    // r, and 0 otherwise.
+    Matrix state_membership_;
+
+    // transitions_[r] lists the transitions out of hmm state r.
+    std::vector<std::vector<Transition>> transitions_;
+
+    // Element (r, t) is the conditional_cumulative_hazard of hmm state r
+    // between events t-1 and t.  Filled by filter().
+    Matrix state_cumulative_hazard_;
+
     // Each vector element corresponds to the PointProcess for a
     // single data series.  Space for a new data series is allocated
     // when add_data is called.  Each matrix has a number of rows
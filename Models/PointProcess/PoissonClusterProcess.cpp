@@ -93,6 +93,9 @@ namespace BOOM {
     }
 
     using PCP = PoissonClusterProcess;
+
+    // The number of data series in each shard of a threaded imputation.
+    constexpr int kSeriesPerShard = 16;
     
   }  // unnamed namespace
 
@@ -158,6 +161,7 @@ namespace BOOM {
     secondary_mark_model_ = secondary_mark_model;
     fill_state_maps();
     register_models_with_param_policy();
+    workers_.clear();
   }
 
   //----------------------------------------------------------------------
@@ -179,6 +183,10 @@ namespace BOOM {
 
   //----------------------------------------------------------------------
   void PCP::impute_latent_data(RNG &rng) {
+    if (pool_.number_of_threads() > 0) {
+      impute_latent_data_with_threads(rng);
+      return;
+    }
     const std::vector<Ptr<PointProcess> > &data(dat());
     last_loglike_ = 0;
     clear_client_data();
@@ -195,6 +203,80 @@ namespace BOOM {
     }
   }
 
+  //----------------------------------------------------------------------
+  void PCP::set_number_of_threads(int n) {
+    pool_.set_number_of_threads(n);
+    workers_.clear();
+  }
+
+  //----------------------------------------------------------------------
+  // Each worker filters the shards w, w + nworkers, ... using its own
+  // copies of the component processes, so the only shared state written
+  // by the workers is the column of probability_of_activity_ and
+  // probability_of_responsibility_ belonging to each series.
+  void PCP::impute_latent_data_with_threads(RNG &rng) {
+    const std::vector<Ptr<PointProcess>> &data(dat());
+    last_loglike_ = 0;
+    clear_client_data();
+    int nworkers = pool_.number_of_threads();
+    if (workers_.size() != nworkers) {
+      workers_.clear();
+      for (int w = 0; w < nworkers; ++w) {
+        Ptr<PoissonClusterProcess> worker(clone());
+        worker->clear_data();
+        workers_.push_back(worker);
+      }
+    }
+    Vector params = vectorize_params(false);
+    for (auto &worker : workers_) {
+      worker->unvectorize_params(params, false);
+      worker->clear_client_data();
+    }
+
+    RNG::RngIntType seed = seed_rng(rng);
+    int nshards = (data.size() + kSeriesPerShard - 1) / kSeriesPerShard;
+    std::vector<double> shard_loglike(nshards, 0.0);
+    const std::vector<int> empty_source;
+    pool_.parallel_for(0, nworkers, 1, [&](int w) {
+      PoissonClusterProcess &worker(*workers_[w]);
+      for (int shard = w; shard < nshards; shard += nworkers) {
+        RNG shard_rng(seed, shard);
+        int end = std::min<int>(data.size(), (shard + 1) * kSeriesPerShard);
+        for (int i = shard * kSeriesPerShard; i < end; ++i) {
+          const PointProcess &process(*data[i]);
+          SourceMap::const_iterator it = known_source_store_.find(data[i]);
+          const std::vector<int> &source(
+              it == known_source_store_.end() ? empty_source : it->second);
+          shard_loglike[shard] += worker.filter(process, source);
+          worker.backward_sampling(shard_rng, process, source,
+                                   probability_of_activity_[i],
+                                   probability_of_responsibility_[i]);
+        }
+      }
+    });
+
+    for (double loglike : shard_loglike) {
+      last_loglike_ += loglike;
+    }
+    for (const auto &worker : workers_) {
+      combine_client_data(*worker);
+    }
+  }
+
+  //----------------------------------------------------------------------
+  void PCP::combine_client_data(const PoissonClusterProcess &worker) {
+    background_->combine_data(*worker.background_, true);
+    primary_birth_->combine_data(*worker.primary_birth_, true);
+    primary_death_->combine_data(*worker.primary_death_, true);
+    primary_traffic_->combine_data(*worker.primary_traffic_, true);
+    secondary_traffic_->combine_data(*worker.secondary_traffic_, true);
+    secondary_death_->combine_data(*worker.secondary_death_, true);
+    if (!!primary_mark_model_) {
+      primary_mark_model_->combine_data(*worker.primary_mark_model_, true);
+      secondary_mark_model_->combine_data(*worker.secondary_mark_model_, true);
+    }
+  }
+
   //----------------------------------------------------------------------
   void PCP::sample_client_posterior() {
     background_->sample_posterior();
@@ -296,9 +378,29 @@ namespace BOOM {
         filter_[i].resize(S, S);
       }
     }
+    evaluate_marks(data);
     return loglike;
   }
 
+  //----------------------------------------------------------------------
+  // The mark densities are needed by both the forward filter and the
+  // backward sampler, so they are evaluated once per event and stored.
+  void PCP::evaluate_marks(const PointProcess &data) {
+    int n = data.number_of_events();
+    logp_primary_.resize(n);
+    logp_secondary_.resize(n);
+    logp_primary_ = 0.0;
+    logp_secondary_ = 0.0;
+    if (!primary_mark_model_) return;
+    for (int t = 0; t < n; ++t) {
+      const PointProcessEvent &event(data.event(t));
+      if (event.has_mark()) {
+        logp_primary_[t] = primary_mark_model_->pdf(event.mark(), true);
+        logp_secondary_[t] = secondary_mark_model_->pdf(event.mark(), true);
+      }
+    }
+  }
+
   //----------------------------------------------------------------------
   // return log(p(events[t] | events[0..t-1]).
   double PCP::fwd_1(const PointProcess &data, int t, int source) {
@@ -309,12 +411,8 @@ namespace BOOM {
                               : data.event(t - 1).timestamp());
     const PointProcessEvent &event(data.event(t));
     const DateTime &t1(event.timestamp());
-    double logp_primary = 0;
-    double logp_secondary = 0;
-    if (!!primary_mark_model_ && event.has_mark()) {
-      logp_primary = primary_mark_model_->pdf(event.mark(), true);
-      logp_secondary = secondary_mark_model_->pdf(event.mark(), true);
-    }
+    double logp_primary = logp_primary_[t];
+    double logp_secondary = logp_secondary_[t];
     // TODO(stevescott):  remove comments
     // if(source == 1){
     //   logp_secondary == negative_infinity();
@@ -548,14 +646,9 @@ namespace BOOM {
     // could have produced the event.  Sample one of them from the
     // full conditional distribution.
     Vector wsp(n);
-    const PointProcessEvent &event(data.event(t));
-    const DateTime &time(event.timestamp());
-    double logp_primary = 0;
-    double logp_secondary = 0;
-    if (event.has_mark() && !!primary_mark_model_) {
-      logp_primary = primary_mark_model_->pdf(event.mark(), true);
-      logp_secondary = secondary_mark_model_->pdf(event.mark(), true);
-    }
+    const DateTime &time(data.event(t).timestamp());
+    double logp_primary = logp_primary_[t];
+    double logp_secondary = logp_secondary_[t];
     for (int i = 0; i < n; ++i) {
       PoissonProcess *process = candidates[i];
       wsp[i] = log(process->event_rate(time)) +
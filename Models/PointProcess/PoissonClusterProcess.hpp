@@ -29,6 +29,7 @@
 #include <map>
 #include <vector>
 #include "LinAlg/Selector.hpp"
+#include "cpputil/ThreadTools.hpp"
 
 namespace BOOM {
 
@@ -73,6 +74,15 @@ namespace BOOM {
     virtual void clear_client_data();
     void impute_latent_data(RNG &rng);
 
+    // Impute the latent data using 'n' threads.  The data series are
+    // divided into fixed size shards, each with its own random number
+    // stream, so the imputed latent data depend on the RNG passed to
+    // impute_latent_data() but not on the number of threads.  Each thread
+    // accumulates sufficient statistics in its own copies of the component
+    // processes and mark models, which are combined with the client models
+    // once all threads have finished.  If n <= 0 imputation is serial.
+    void set_number_of_threads(int n);
+
     // Sample the posterior distributions of the client models.  To be
     // called after impute_latent_data().
     virtual void sample_client_posterior();
@@ -287,6 +297,15 @@ namespace BOOM {
    private:
     void initialize();
     void fill_state_maps();  // make virtual
+
+    // Fill logp_primary_ and logp_secondary_ with the log densities of the
+    // marks in 'data'.  Called by initialize_filter().
+    void evaluate_marks(const PointProcess &data);
+
+    void impute_latent_data_with_threads(RNG &rng);
+
+    // Add the data imputed by a worker to the client models.
+    void combine_client_data(const PoissonClusterProcess &worker);
     void setup_filter();
     virtual void register_models_with_param_policy();
 
@@ -382,6 +401,12 @@ namespace BOOM {
     std::vector<Matrix> filter_;
     Vector pi0_;
     mutable Vector wsp_;
+
+    // The log densities of each event's mark under the primary and
+    // secondary mark models, for the data most recently filtered.  Events
+    // without marks, or models without mark models, have log density 0.
+    Vector logp_primary_;
+    Vector logp_secondary_;
     Vector one_;
     double last_loglike_;
 
@@ -403,6 +428,12 @@ namespace BOOM {
     // each PointProcess.  If some events are known to be
     typedef std::map<Ptr<PointProcess>, std::vector<int> > SourceMap;
     SourceMap known_source_store_;
+
+    // Copies of this model used for threaded imputation.  The workers own
+    // no data.  They hold imputed sufficient statistics between calls to
+    // impute_latent_data().
+    SharedThreadPool pool_;
+    std::vector<Ptr<PoissonClusterProcess>> workers_;
   };
 
 }  // namespace BOOM
@@ -179,7 +179,21 @@ namespace BOOM {
   WP::WeeklyCyclePoissonProcess()
       : ParamPolicy(new UnivParams(1.0), new VectorParams(7, 1.0),
                     new VectorParams(24, 1.0), new VectorParams(24, 1.0)),
-        DataPolicy(new WS) {}
+        DataPolicy(new WS),
+        cumulative_intensity_current_(false) {
+    set_observers();
+  }
+
+  WP::WeeklyCyclePoissonProcess(const WP &rhs)
+      : Model(rhs),
+        PoissonProcess(rhs),
+        ParamPolicy(rhs),
+        DataPolicy(rhs),
+        PriorPolicy(rhs),
+        LoglikeModel(rhs),
+        cumulative_intensity_current_(false) {
+    set_observers();
+  }
 
   WP *WP::clone() const { return new WP(*this); }
 
@@ -194,6 +208,8 @@ namespace BOOM {
            hourly_pattern(day)[hour];
   }
 
+  // The integral of the event rate is piecewise linear over the week, so it
+  // can be found by interpolating a table of cumulative hourly intensities.
   double WP::expected_number_of_events(const DateTime &t0,
                                        const DateTime &t1) const {
     double duration = t1 - t0;
@@ -201,24 +217,47 @@ namespace BOOM {
     double lambda = average_daily_rate();
     double ans = 7 * weeks * lambda;
     duration -= 7 * weeks;
+    if (duration <= 0) return ans;
+
+    ensure_cumulative_intensity_current();
+    double start = 24.0 * t0.date().day_of_week()
+        + t0.seconds_into_day() / 3600.0;
+    double end = start + 24.0 * duration;
+    if (end > 168) {
+      // The interval wraps past the end of the week.
+      ans += cumulative_intensity_.back() - cumulative_intensity(start)
+          + cumulative_intensity(end - 168);
+    } else {
+      ans += cumulative_intensity(end) - cumulative_intensity(start);
+    }
+    return ans;
+  }
+
+  double WP::cumulative_intensity(double hours) const {
+    int hour = std::min<int>(floor(hours), 167);
+    DayNames day = DayNames(hour / 24);
+    return cumulative_intensity_[hour]
+        + DateTime::hours_to_days(hours - hour) * event_rate(day, hour % 24);
+  }
 
+  void WP::ensure_cumulative_intensity_current() const {
+    if (cumulative_intensity_current_) return;
     const double one_hour = DateTime::hours_to_days(1.0);
-    double time_to_next_hour = t0.time_to_next_hour();
-    if (time_to_next_hour == 0) time_to_next_hour = one_hour;
-    DayNames day = t0.date().day_of_week();
-    int hour = t0.hour();
-    double dt = std::min<double>(time_to_next_hour, duration);
-    while (duration > 0) {
-      ans += dt * event_rate(day, hour);
-      duration -= dt;
-      ++hour;
-      if (hour == 24) {
-        hour = 0;
-        day = next(day);
-      }
-      dt = std::min<double>(one_hour, duration);
+    cumulative_intensity_.resize(169);
+    cumulative_intensity_[0] = 0.0;
+    for (int k = 0; k < 168; ++k) {
+      cumulative_intensity_[k + 1] = cumulative_intensity_[k]
+          + one_hour * event_rate(DayNames(k / 24), k % 24);
     }
-    return ans;
+    cumulative_intensity_current_ = true;
+  }
+
+  void WP::set_observers() {
+    auto invalidate = [this]() { cumulative_intensity_current_ = false; };
+    average_daily_event_rate_prm()->add_observer(this, invalidate);
+    day_of_week_cycle_prm()->add_observer(this, invalidate);
+    weekday_hour_of_day_cycle_prm()->add_observer(this, invalidate);
+    weekend_hour_of_day_cycle_prm()->add_observer(this, invalidate);
   }
 
   double WP::loglike(const Vector &lam0_delta_weekday_weekend) const {
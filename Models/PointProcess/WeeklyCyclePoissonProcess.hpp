@@ -85,6 +85,7 @@ namespace BOOM {
         public LoglikeModel {
    public:
     WeeklyCyclePoissonProcess();
+    WeeklyCyclePoissonProcess(const WeeklyCyclePoissonProcess &rhs);
     WeeklyCyclePoissonProcess *clone() const override;
 
     // Concatenate a collection of 4 parameters into a single vector
@@ -144,6 +145,24 @@ namespace BOOM {
     void maximize_average_daily_rate();
     void maximize_daily_pattern();
     void maximize_hourly_pattern();
+
+    // Invalidate the cumulative intensity table when the parameters change.
+    void set_observers();
+
+    // Fill cumulative_intensity_ if it is out of date.
+    void ensure_cumulative_intensity_current() const;
+
+    // The expected number of events between the start of the week
+    // (midnight Sunday morning) and the point 'hours' hours later.
+    // Args:
+    //   hours:  A point in the week, in [0, 168].
+    double cumulative_intensity(double hours) const;
+
+    // Element k is the expected number of events in the first k hours of
+    // the week, so the table has 169 elements.  Hour k of the week is
+    // hour k % 24 on day k / 24.
+    mutable Vector cumulative_intensity_;
+    mutable bool cumulative_intensity_current_;
   };
 
 }  // namespace BOOM
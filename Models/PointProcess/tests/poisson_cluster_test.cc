@@ -0,0 +1,120 @@
+#include "gtest/gtest.h"
+#include "Models/PointProcess/HomogeneousPoissonProcess.hpp"
+#include "Models/PointProcess/PoissonClusterProcess.hpp"
+#include "cpputil/DateTime.hpp"
+#include "distributions.hpp"
+
+#include "test_utils/test_utils.hpp"
+
+namespace {
+  using namespace BOOM;
+  using std::endl;
+  using std::cout;
+
+  class PoissonClusterTest : public ::testing::Test {
+   protected:
+    PoissonClusterTest() {
+      GlobalRng::rng.seed(8675309);
+    }
+
+    // If 'output' is non-NULL it is filled with the model's component
+    // processes.
+    Ptr<PoissonClusterProcess> make_model(
+        const std::vector<Ptr<PointProcess>> &data,
+        PoissonClusterComponentProcesses *output = nullptr) {
+      PoissonClusterComponentProcesses components;
+      components.background = new HomogeneousPoissonProcess(2.0);
+      components.primary_birth = new HomogeneousPoissonProcess(1.0);
+      components.primary_traffic = new HomogeneousPoissonProcess(20.0);
+      components.primary_death = new HomogeneousPoissonProcess(4.0);
+      components.secondary_traffic = new HomogeneousPoissonProcess(10.0);
+      components.secondary_death = new HomogeneousPoissonProcess(3.0);
+      NEW(PoissonClusterProcess, model)(components);
+      if (output) *output = components;
+      for (const auto &dp : data) {
+        model->add_data(dp);
+      }
+      return model;
+    }
+
+    std::vector<Ptr<PointProcess>> simulate_data(int nseries) {
+      std::vector<Ptr<PointProcess>> data;
+      Ptr<PoissonClusterProcess> truth =
+          make_model(std::vector<Ptr<PointProcess>>());
+      DateTime t0(Date(Mar, 4, 2022), 0.0);
+      for (int i = 0; i < nseries; ++i) {
+        data.push_back(new PointProcess(
+            truth->simulate(GlobalRng::rng, t0, t0 + 3.0)));
+      }
+      return data;
+    }
+
+    // The total event count and exposure time attributed to the component
+    // processes.
+    Vector component_stats(const PoissonClusterComponentProcesses &model) {
+      std::vector<Ptr<PoissonProcess>> processes = {
+          model.background, model.primary_birth, model.primary_traffic,
+          model.primary_death, model.secondary_traffic,
+          model.secondary_death};
+      Vector ans;
+      for (const auto &process : processes) {
+        const HomogeneousPoissonProcess *homogeneous =
+            dynamic_cast<const HomogeneousPoissonProcess *>(process.get());
+        ans.push_back(homogeneous->suf()->count());
+        ans.push_back(homogeneous->suf()->exposure());
+      }
+      return ans;
+    }
+  };
+
+  // The threaded imputation is sharded by data series, so the imputed
+  // latent data do not depend on the number of threads.
+  TEST_F(PoissonClusterTest, ThreadsAgree) {
+    std::vector<Ptr<PointProcess>> data = simulate_data(50);
+    int total_events = 0;
+    for (const auto &dp : data) total_events += dp->number_of_events();
+
+    PoissonClusterComponentProcesses one_thread_components;
+    Ptr<PoissonClusterProcess> one_thread =
+        make_model(data, &one_thread_components);
+    one_thread->set_number_of_threads(1);
+    PoissonClusterComponentProcesses three_thread_components;
+    Ptr<PoissonClusterProcess> three_threads =
+        make_model(data, &three_thread_components);
+    three_threads->set_number_of_threads(3);
+
+    RNG rng1(12345);
+    RNG rng3(12345);
+    for (int iteration = 0; iteration < 3; ++iteration) {
+      one_thread->impute_latent_data(rng1);
+      three_threads->impute_latent_data(rng3);
+      EXPECT_NEAR(one_thread->loglike(), three_threads->loglike(), 1e-8);
+      for (int i = 0; i < data.size(); ++i) {
+        EXPECT_TRUE(MatrixEquals(
+            one_thread->probability_of_activity()[i],
+            three_threads->probability_of_activity()[i]));
+        EXPECT_TRUE(MatrixEquals(
+            one_thread->probability_of_responsibility()[i],
+            three_threads->probability_of_responsibility()[i]));
+      }
+      Vector stats = component_stats(one_thread_components);
+      EXPECT_TRUE(VectorEquals(stats,
+                               component_stats(three_thread_components)));
+      int attributed_events = 0;
+      for (int i = 0; i < stats.size(); i += 2) attributed_events += stats[i];
+      EXPECT_EQ(total_events, attributed_events);
+    }
+  }
+
+  // Threaded and serial imputation filter the data the same way.
+  TEST_F(PoissonClusterTest, ThreadedLoglikeMatchesSerial) {
+    std::vector<Ptr<PointProcess>> data = simulate_data(20);
+    Ptr<PoissonClusterProcess> serial = make_model(data);
+    Ptr<PoissonClusterProcess> threaded = make_model(data);
+    threaded->set_number_of_threads(2);
+    serial->impute_latent_data(GlobalRng::rng);
+    threaded->impute_latent_data(GlobalRng::rng);
+    EXPECT_NEAR(serial->loglike(), threaded->loglike(), 1e-8);
+  }
+
+}  // namespace
@@ -0,0 +1,79 @@
+#include "gtest/gtest.h"
+#include "Models/PointProcess/WeeklyCyclePoissonProcess.hpp"
+#include "cpputil/DateTime.hpp"
+#include "distributions.hpp"
+
+#include "test_utils/test_utils.hpp"
+
+namespace {
+  using namespace BOOM;
+  using std::endl;
+  using std::cout;
+
+  class WeeklyCycleTest : public ::testing::Test {
+   protected:
+    WeeklyCycleTest() {
+      GlobalRng::rng.seed(8675309);
+      Vector daily(7);
+      for (double &d : daily) d = runif(.5, 1.5);
+      daily *= 7.0 / sum(daily);
+      Vector weekday(24), weekend(24);
+      for (double &h : weekday) h = runif(.1, 2);
+      for (double &h : weekend) h = runif(.1, 2);
+      weekday *= 24.0 / sum(weekday);
+      weekend *= 24.0 / sum(weekend);
+      process_.set_average_daily_rate(3.0);
+      process_.set_day_of_week_pattern(daily);
+      process_.set_weekday_hourly_pattern(weekday);
+      process_.set_weekend_hourly_pattern(weekend);
+    }
+
+    // Integrate the event rate over [t0, t1] one hour at a time.
+    double hourly_integral(const DateTime &t0, const DateTime &t1) const {
+      double ans = 0;
+      DateTime t = t0;
+      while (t < t1) {
+        double dt = std::min<double>(t.time_to_next_hour(), t1 - t);
+        ans += dt * process_.event_rate(t);
+        t += dt;
+      }
+      return ans;
+    }
+
+    WeeklyCyclePoissonProcess process_;
+  };
+
+  TEST_F(WeeklyCycleTest, ExpectedEventsMatchHourlyIntegral) {
+    DateTime start(Date(Mar, 4, 2022), 0.0);
+    for (int i = 0; i < 200; ++i) {
+      DateTime t0 = start + runif(0, 14);
+      // Mix short windows with windows spanning several weeks.
+      double duration = i % 4 == 0 ? runif(0, 30) : runif(0, 2);
+      DateTime t1 = t0 + duration;
+      EXPECT_NEAR(hourly_integral(t0, t1),
+                  process_.expected_number_of_events(t0, t1),
+                  1e-8)
+          << "window " << i << " of length " << duration;
+    }
+  }
+
+  // Changing a parameter invalidates the cached intensity table.
+  TEST_F(WeeklyCycleTest, TableTracksParameters) {
+    DateTime t0(Date(Mar, 4, 2022), .3);
+    DateTime t1 = t0 + 2.6;
+    double before = process_.expected_number_of_events(t0, t1);
+    process_.set_average_daily_rate(6.0);
+    EXPECT_NEAR(2 * before, process_.expected_number_of_events(t0, t1), 1e-8);
+
+    Vector weekday(24, 1.0);
+    process_.set_weekday_hourly_pattern(weekday);
+    EXPECT_NEAR(hourly_integral(t0, t1),
+                process_.expected_number_of_events(t0, t1), 1e-8);
+
+    Ptr<WeeklyCyclePoissonProcess> copy(process_.clone());
+    copy->set_average_daily_rate(1.0);
+    EXPECT_NEAR(process_.expected_number_of_events(t0, t1) / 6.0,
+                copy->expected_number_of_events(t0, t1), 1e-8);
+  }
+
+}  // namespace
@@ -20,6 +20,7 @@
 #include "Models/PoissonGammaModel.hpp"
 #include "Bmath/Bmath.hpp"
 #include "cpputil/report_error.hpp"
+#include "distributions/vectorized_special_functions.hpp"
 #include "stats/moments.hpp"
 
 namespace BOOM {
@@ -139,12 +140,12 @@ namespace BOOM {
     const std::vector<Ptr<PoissonData> > &data(dat());
     int nobs = data.size();
     double ans = nobs * (a * log(b) - lgamma(a));
+    Vector apy(nobs);
     for (int i = 0; i < nobs; ++i) {
-      double apy = a + data[i]->number_of_events();
-      double npb = b + data[i]->number_of_trials();
-      ans += lgamma(apy) - apy * log(npb);
+      apy[i] = a + data[i]->number_of_events();
+      ans -= apy[i] * log(b + data[i]->number_of_trials());
     }
-    return ans;
+    return ans + sum_lgamma(apy);
   }
 
   double PoissonGammaModel::Loglike(const Vector &ab, Vector &g, Matrix &H,
@@ -173,18 +174,33 @@ namespace BOOM {
       }
     }
 
+    // The special functions of a + y are evaluated in bulk.
+    Vector apy(nobs);
+    Vector npb(nobs);
+    for (int i = 0; i < nobs; ++i) {
+      apy[i] = a + data[i]->number_of_events();
+      npb[i] = b + data[i]->number_of_trials();
+    }
+    ans += sum_lgamma(apy);
+    Vector psi, psi1;
+    if (nd > 0) {
+      psi = digamma_vector(apy);
+      if (nd > 1) {
+        psi1 = trigamma_vector(apy);
+      }
+    }
+
     for (int i = 0; i < nobs; ++i) {
-      double apy = a + data[i]->number_of_events();
-      double npb = b + data[i]->number_of_trials();
-      ans += lgamma(apy) - apy * log(npb);
+      double log_npb = log(npb[i]);
+      ans -= apy[i] * log_npb;
       if (nd > 0) {
-        g[0] += digamma(apy) - log(npb);
-        g[1] -= apy / (npb);
+        g[0] += psi[i] - log_npb;
+        g[1] -= apy[i] / (npb[i]);
         if (nd > 1) {
-          H(0, 0) += trigamma(apy);
-          H(1, 0) -= 1.0 / npb;
-          H(0, 1) -= 1.0 / npb;
-          H(1, 1) += apy / (npb * npb);
+          H(0, 0) += psi1[i];
+          H(1, 0) -= 1.0 / npb[i];
+          H(0, 1) -= 1.0 / npb[i];
+          H(1, 1) += apy[i] / (npb[i] * npb[i]);
         }
       }
     }
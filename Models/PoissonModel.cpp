@@ -25,6 +25,7 @@
 #include "Models/SufstatAbstractCombineImpl.hpp"
 #include "cpputil/math_utils.hpp"
 #include "distributions.hpp"
+#include "distributions/vectorized_densities.hpp"
 
 namespace BOOM {
 
@@ -62,12 +63,31 @@ namespace BOOM {
     n_ += 1.0;
   }
 
+  void PoissonSuf::Remove(const DataType &X) {
+    int x = X.value();
+    sum_ -= x;
+    lognc_ -= lgamma(x + 1);
+    n_ -= 1.0;
+  }
+
   void PoissonSuf::add_mixture_data(double y, double prob) {
     n_ += prob;
     lognc_ += log(prob) + lgamma(y + 1);
     sum_ += (prob * y);
   }
 
+  void PoissonSuf::add_data(const ConstVectorView &counts) {
+    double sum = 0;
+    double lognc = 0;
+    for (double y : counts) {
+      sum += y;
+      lognc += lgamma(y + 1);
+    }
+    sum_ += sum;
+    lognc_ += lognc;
+    n_ += counts.size();
+  }
+
   double PoissonSuf::sum() const { return sum_; }
   double PoissonSuf::n() const { return n_; }
   double PoissonSuf::lognc() const { return lognc_; }
@@ -188,6 +208,17 @@ namespace BOOM {
   double PoissonModel::pdf(const Data *dp, bool logscale) const {
     return dpois(DAT(dp)->value(), lam(), logscale);
   }
+  void PoissonModel::pdf_batch(const std::vector<Ptr<Data>> &data,
+                               VectorView ans, bool logscale) const {
+    Vector values(data.size());
+    for (size_t i = 0; i < data.size(); ++i) {
+      values[i] = DAT(data[i])->value();
+    }
+    dpois_vector(values, lam(), ans, logscale);
+    for (size_t i = 0; i < data.size(); ++i) {
+      if (data[i]->missing()) ans[i] = logscale ? 0.0 : 1.0;
+    }
+  }
   double PoissonModel::mean() const { return lam(); }
   double PoissonModel::var() const { return lam(); }
   double PoissonModel::sd() const { return sqrt(lam()); }
@@ -58,7 +58,14 @@ namespace BOOM {
     double lognc() const;
 
     void Update(const IntData &dat) override;
+    bool supports_remove() const override { return true; }
+    void Remove(const IntData &dat) override;
     void add_mixture_data(double y, double prob);
+
+    // Add a block of event counts, each with unit exposure.  Equivalent to
+    // calling Update once per element, without creating IntData objects.
+    void add_data(const ConstVectorView &counts);
+
     void combine(const Ptr<PoissonSuf> &);
     void combine(const PoissonSuf &);
     PoissonSuf *abstract_combine(Sufstat *s) override;
@@ -101,6 +108,8 @@ namespace BOOM {
     // probability calculations
     virtual double pdf(const Ptr<Data> &dp, bool logscale) const;
     double pdf(const Data *x, bool logscale) const override;
+    void pdf_batch(const std::vector<Ptr<Data>> &data, VectorView ans,
+                   bool logscale) const override;
     double pdf(uint x, bool logscale) const;
     double logp(int x) const override;
     int number_of_observations() const override { return dat().size(); }
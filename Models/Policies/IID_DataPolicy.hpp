@@ -65,6 +65,8 @@ namespace BOOM {
 
     virtual void combine_data(const Model &mod, bool just_suf = true);
 
+    MemoryFootprint data_memory_footprint() const override;
+
     void signal() {
       for (size_t i = 0; i < observers_.size(); ++i) {
         observers_[i]();
@@ -146,6 +148,15 @@ namespace BOOM {
     }
   }
 
+  template <class D>
+  MemoryFootprint IID_DataPolicy<D>::data_memory_footprint() const {
+    std::size_t bytes = heap_bytes(dat_);
+    for (const auto &dp : dat_) {
+      bytes += dp->memory_footprint();
+    }
+    return MemoryFootprint(MemoryFootprint::kData, bytes);
+  }
+
   template <class D>
   void IID_DataPolicy<D>::add_data(const Ptr<DataType> &d) {
     dat_.push_back(d);
@@ -55,6 +55,18 @@ namespace BOOM {
     return *this;
   }
 
+  MemoryFootprint MixtureDataPolicy::data_memory_footprint() const {
+    std::size_t bytes = heap_bytes(dat_) + heap_bytes(latent_)
+        + heap_bytes(known_data_source_);
+    for (const auto &dp : dat_) {
+      bytes += dp->memory_footprint();
+    }
+    for (const auto &dp : latent_) {
+      bytes += dp->memory_footprint();
+    }
+    return MemoryFootprint(MemoryFootprint::kData, bytes);
+  }
+
   void MixtureDataPolicy::clear_data() {
     dat().clear();
     latent_data().clear();
@@ -56,6 +56,9 @@ namespace BOOM {
     void add_data(const Ptr<Data> &dp) override;
     void combine_data(const Model &, bool just_suf = true) override;
 
+    // Includes the latent mixture indicators.
+    MemoryFootprint data_memory_footprint() const override;
+
     // Add a data point to the model.  The data point is known to come from a
     // particular mixture component.
     //
@@ -19,9 +19,14 @@
 #ifndef BOOM_IID_SUFSTAT_DATA_POLICY_HPP
 #define BOOM_IID_SUFSTAT_DATA_POLICY_HPP
 
+#include <unordered_map>
+#include <unordered_set>
+
 #include "Models/Policies/IID_DataPolicy.hpp"
 #include "Models/Sufstat.hpp"
+#include "Samplers/McmcProfiler.hpp"
 #include "cpputil/Ptr.hpp"
+#include "cpputil/report_error.hpp"
 
 namespace BOOM {
 
@@ -40,6 +45,7 @@ namespace BOOM {
     SufstatDataPolicy(const SufstatDataPolicy &);
     SufstatDataPolicy *clone() const = 0;
     SufstatDataPolicy &operator=(const SufstatDataPolicy &);
+    ~SufstatDataPolicy() override { stop_tracking_data_changes(); }
 
     virtual void clear_data();
     void only_keep_sufstats(bool tf = true);
@@ -61,8 +67,19 @@ namespace BOOM {
     virtual void add_data(const Ptr<DataType> &dp);
     virtual void add_data(DataType *dp) { add_data(Ptr<DataType>(dp)); }
 
+    // Removes dp from the data set.  As in IID_DataPolicy, suf() is left
+    // alone; models that support removal subtract dp from suf() themselves.
+    void remove_data(const Ptr<Data> &dp) override;
+
     virtual void combine_data(const Model &, bool just_suf = true);
 
+    // Includes the copies of the data kept for change tracking.
+    MemoryFootprint data_memory_footprint() const override;
+
+    // Observations added directly to suf(), e.g. through the block add_data
+    // methods of the sufficient statistics, are not stored by the data
+    // policy.  Models fed that way should call only_keep_sufstats(), or
+    // refresh_suf() will discard them.
     const Ptr<S> suf() const { return suf_; }
     Ptr<S> suf() {return suf_;}
     void clear_suf() { suf_->clear(); }
@@ -70,19 +87,67 @@ namespace BOOM {
     void refresh_suf();
     void set_suf(const Ptr<S> &s) { suf_ = s; }
 
+    // Data augmentation samplers often change the values of only a few data
+    // points between calls to refresh_suf().  When change tracking is on,
+    // the policy observes each data point, and keeps a copy of the value it
+    // contributed to suf().  refresh_suf() then subtracts the old value and
+    // adds the new one for just the data points that have signalled a change
+    // since the last refresh, instead of rebuilding suf() from scratch.
+    //
+    // Tracking requires a sufficient statistic that supports exact removal
+    // (see Sufstat::supports_remove).  It keeps a second copy of the
+    // data, and is not copied along with the model.  Data points must
+    // signal() when their values change, and must do so from one thread at a
+    // time.
+    void track_data_changes(bool tf = true);
+    bool is_tracking_data_changes() const { return track_changes_; }
+
    private:
     Ptr<S> suf_;
     bool only_keep_suf_;
+
+    // Change tracking.  'contributions_' maps each tracked data point to a
+    // copy of the value it last contributed to suf_, or to NULL if it was
+    // missing.
+    bool track_changes_ = false;
+    std::unordered_map<DataType *, Ptr<DataType>> contributions_;
+    std::unordered_set<DataType *> changed_;
+
+    void start_tracking(const Ptr<DataType> &d);
+    void update_tracked_suf(DataType *d);
+    void stop_tracking_data_changes();
   };
   //======================================================================
   template <class D, class S>
   void SufstatDataPolicy<D, S>::refresh_suf() {
     if (only_keep_suf_) return;
+    ScopedPhaseTimer timer(McmcProfiler::kRefreshSuf);
+    if (track_changes_) {
+      for (DataType *d : changed_) {
+        update_tracked_suf(d);
+      }
+      changed_.clear();
+      return;
+    }
     suf()->clear();
     const DatasetType &d(this->dat());
     for (uint i = 0; i < d.size(); ++i) suf_->update(d[i]);
   }
 
+  template <class D, class S>
+  MemoryFootprint SufstatDataPolicy<D, S>::data_memory_footprint() const {
+    MemoryFootprint ans = DPBase::data_memory_footprint();
+    ans.add(MemoryFootprint::kSufficientStatistics, suf_->memory_footprint());
+    std::size_t tracking_bytes = 0;
+    for (const auto &el : contributions_) {
+      tracking_bytes += sizeof(el);
+      if (el.second) tracking_bytes += el.second->memory_footprint();
+    }
+    tracking_bytes += changed_.size() * sizeof(DataType *);
+    ans.add(MemoryFootprint::kData, tracking_bytes);
+    return ans;
+  }
+
   template <class D, class S>
   SufstatDataPolicy<D, S>::SufstatDataPolicy(const Ptr<S> &s)
       : DPBase(), suf_(s), only_keep_suf_(false) {}
@@ -114,6 +179,7 @@ namespace BOOM {
   SufstatDataPolicy<D, S> &SufstatDataPolicy<D, S>::operator=(
       const SufstatDataPolicy &rhs) {
     if (&rhs != this) {
+      stop_tracking_data_changes();
       DPBase::operator=(rhs);
       suf_ = rhs.suf_->clone();
       only_keep_suf_ = rhs.only_keep_suf_;
@@ -125,43 +191,63 @@ namespace BOOM {
   template <class D, class S>
   void SufstatDataPolicy<D, S>::only_keep_sufstats(bool tf) {
     only_keep_suf_ = tf;
-    if (tf) clear_data_but_not_sufstats();
+    if (tf) {
+      stop_tracking_data_changes();
+      clear_data_but_not_sufstats();
+    }
   }
 
   template <class D, class S>
   void SufstatDataPolicy<D, S>::clear_data() {
+    bool tracking = track_changes_;
+    stop_tracking_data_changes();
     DPBase::clear_data();
     suf()->clear();
+    track_changes_ = tracking;
   }
 
   template <class D, class S>
   void SufstatDataPolicy<D, S>::clear_data_but_not_sufstats() {
+    stop_tracking_data_changes();
     DPBase::clear_data();
   }
 
   template <class D, class S>
   void SufstatDataPolicy<D, S>::set_data(const DatasetType &d) {
+    bool tracking = track_changes_;
+    stop_tracking_data_changes();
     DPBase::set_data(d);
     refresh_suf();
+    track_data_changes(tracking);
   }
 
   template <class D, class S>
   template <class Fwd>
   void SufstatDataPolicy<D, S>::set_data(Fwd b, Fwd e) {
+    bool tracking = track_changes_;
+    stop_tracking_data_changes();
     DPBase::set_data(b, e);
     refresh_suf();
+    track_data_changes(tracking);
   }
 
   template <class D, class S>
   template <class Fwd>
   void SufstatDataPolicy<D, S>::set_data_raw(Fwd b, Fwd e) {
+    bool tracking = track_changes_;
+    stop_tracking_data_changes();
     DPBase::set_data_raw(b, e);
     refresh_suf();
+    track_data_changes(tracking);
   }
 
   template <class D, class S>
   void SufstatDataPolicy<D, S>::add_data(const Ptr<DataType> &d) {
     if (!only_keep_suf_) DPBase::add_data(d);
+    if (track_changes_) {
+      start_tracking(d);
+      return;
+    }
     // Add data to the vector of pointers in the data policy, but
     // don't update the sufficient statistics if d is missing.
     if (!d->missing()) suf()->update(d);
@@ -172,6 +258,24 @@ namespace BOOM {
     add_data(this->DAT(d));
   }
 
+  template <class D, class S>
+  void SufstatDataPolicy<D, S>::remove_data(const Ptr<Data> &dp) {
+    if (track_changes_) {
+      // Bring suf_ up to date with the current value of dp, so that a model
+      // removing dp from suf_ subtracts what was added.
+      DataType *data_point = dynamic_cast<DataType *>(dp.get());
+      auto it = contributions_.find(data_point);
+      if (it != contributions_.end()) {
+        if (changed_.erase(data_point) > 0) {
+          update_tracked_suf(data_point);
+        }
+        data_point->remove_observer(this);
+        contributions_.erase(it);
+      }
+    }
+    DPBase::remove_data(dp);
+  }
+
   template <class D, class S>
   void SufstatDataPolicy<D, S>::combine_data(const Model &other,
                                              bool just_suf) {
@@ -180,5 +284,62 @@ namespace BOOM {
     if (!just_suf) IID_DataPolicy<D>::combine_data(other, just_suf);
   }
 
+  template <class D, class S>
+  void SufstatDataPolicy<D, S>::track_data_changes(bool tf) {
+    if (!tf) {
+      stop_tracking_data_changes();
+      return;
+    }
+    if (track_changes_) return;
+    if (!suf_->supports_remove()) {
+      report_error("Change tracking requires sufficient statistics that "
+                   "support removing data.");
+    }
+    if (only_keep_suf_) {
+      report_error("Change tracking requires the raw data to be kept.");
+    }
+    suf_->clear();
+    track_changes_ = true;
+    for (const auto &d : this->dat()) {
+      start_tracking(d);
+    }
+  }
+
+  template <class D, class S>
+  void SufstatDataPolicy<D, S>::start_tracking(const Ptr<DataType> &d) {
+    DataType *data_point = d.get();
+    contributions_[data_point] = nullptr;
+    update_tracked_suf(data_point);
+    data_point->add_observer(
+        this, [this, data_point]() { this->changed_.insert(data_point); });
+  }
+
+  template <class D, class S>
+  void SufstatDataPolicy<D, S>::update_tracked_suf(DataType *d) {
+    auto it = contributions_.find(d);
+    if (it == contributions_.end()) return;
+    // Go through the base class, because concrete sufficient statistics
+    // often have their own overloads of remove().
+    Sufstat &suf(*suf_);
+    if (!!it->second) {
+      suf.remove(*it->second);
+      it->second.reset();
+    }
+    if (!d->missing()) {
+      suf.update(*d);
+      it->second.reset(dynamic_cast<DataType *>(d->clone()));
+    }
+  }
+
+  template <class D, class S>
+  void SufstatDataPolicy<D, S>::stop_tracking_data_changes() {
+    for (auto &it : contributions_) {
+      it.first->remove_observer(this);
+    }
+    contributions_.clear();
+    changed_.clear();
+    track_changes_ = false;
+  }
+
 }  // namespace BOOM
 #endif  // BOOM_IID_SUFSTAT_DATA_POLICY_HPP
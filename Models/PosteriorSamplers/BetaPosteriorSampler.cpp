@@ -131,6 +131,20 @@ namespace BOOM {
     return mean_prior_->logp(mean) + sample_size_prior_->logp(sample_size);
   }
 
+  void BetaPosteriorSampler::write_checkpoint(CheckpointWriter &out) const {
+    out.begin_section("BetaPosteriorSampler");
+    PosteriorSampler::write_checkpoint(out);
+    mean_sampler_.write_checkpoint(out);
+    sample_size_sampler_.write_checkpoint(out);
+  }
+
+  void BetaPosteriorSampler::read_checkpoint(CheckpointReader &in) {
+    in.expect_section("BetaPosteriorSampler");
+    PosteriorSampler::read_checkpoint(in);
+    mean_sampler_.read_checkpoint(in);
+    sample_size_sampler_.read_checkpoint(in);
+  }
+
   std::string BetaPosteriorSampler::error_message(
       const char *thing_being_drawn,
       const std::exception *e) const {
@@ -40,6 +40,8 @@ namespace BOOM {
     BetaPosteriorSampler *clone_to_new_host(Model *new_host) const override;
     void draw() override;
     double logpri() const override;
+    void write_checkpoint(CheckpointWriter &out) const override;
+    void read_checkpoint(CheckpointReader &in) override;
 
    private:
     BetaModel *model_;
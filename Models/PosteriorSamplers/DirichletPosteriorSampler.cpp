@@ -21,6 +21,7 @@
 #include "Samplers/ScalarSliceSampler.hpp"
 #include "cpputil/math_utils.hpp"
 #include "distributions.hpp"
+#include "distributions/vectorized_special_functions.hpp"
 
 namespace BOOM {
   typedef DirichletPosteriorSampler DPS;
@@ -137,8 +138,7 @@ namespace BOOM {
     DLP::DirichletLogp(uint pos, const Vector &nu, const Vector &sumlogpi,
                        double nobs, const VectorModel *phi_prior,
                        const DoubleModel *alpha_prior, double min_nu)
-        : sumlogpi_(sumlogpi),
-          nobs_(nobs),
+        : loglike_(nu, pos, sumlogpi, nobs),
           pos_(pos),
           nu_(nu),
           min_nu_(min_nu),
@@ -153,8 +153,11 @@ namespace BOOM {
     }
 
     //----------------------------------------------------------------------
+    // The likelihood depends on nu only through nu_[pos_], so it is
+    // evaluated in constant time by loglike_.  The phi prior still sees the
+    // whole vector.
     double DLP::logp() const {
-      double alpha = sum(nu_);
+      double alpha = loglike_.other_sum() + nu_[pos_];
       if (alpha <= 0) return BOOM::negative_infinity();
       uint d = nu_.size();
       double ans = alpha_prior_->logp(alpha);  // alpha prior
@@ -162,7 +165,7 @@ namespace BOOM {
       ans += phi_prior_->logp(nu_ / alpha);  // phi prior
       if (!std::isfinite(ans)) return ans;
       ans -= (d - 1) * log(alpha);  // jacobian
-      ans += dirichlet_loglike(nu_, 0, 0, sumlogpi_, nobs_);
+      ans += loglike_(nu_[pos_]);
       return ans;
     }
     //----------------------------------------------------------------------
@@ -289,20 +292,23 @@ namespace BOOM {
       }
 
       double nu0 = alpha * phi0;
-      ans += (nu0 - 1) * sumlog[0] - n * lgamma(nu0);
+      Vector nu = truncated_phi * alpha;
+      ans += (nu0 - 1) * sumlog[0] - n * (lgamma(nu0) + sum_lgamma(nu));
       for (int s = 0; s < truncated_phi.size(); ++s) {
-        double nu = truncated_phi[s] * alpha;
-        ans += (nu - 1) * sumlog[s + 1] - n * lgamma(nu);
-        if (nderiv > 0) {
+        ans += (nu[s] - 1) * sumlog[s + 1];
+      }
+      if (nderiv > 0) {
+        double psi0 = digamma(nu0);
+        Vector psi = digamma_vector(nu);
+        for (int s = 0; s < truncated_phi.size(); ++s) {
           gradient[s] += alpha * (sumlog[s + 1] - sumlog[0]) -
-                         n * alpha * (digamma(nu) - digamma(nu0));
-          if (nderiv > 1) {
-            for (int r = 0; r < truncated_phi.size(); ++r) {
-              Hessian(r, s) -= n * square(alpha) * trigamma(nu0);
-              if (r == s) {
-                Hessian(s, s) -= n * square(alpha) * trigamma(nu);
-              }
-            }
+                         n * alpha * (psi[s] - psi0);
+        }
+        if (nderiv > 1) {
+          Hessian -= n * square(alpha) * trigamma(nu0);
+          Vector psi1 = trigamma_vector(nu);
+          for (int s = 0; s < truncated_phi.size(); ++s) {
+            Hessian(s, s) -= n * square(alpha) * psi1[s];
           }
         }
       }
@@ -410,12 +416,20 @@ namespace BOOM {
         }
       }
 
+      Vector nu = alpha * phi;
+      ans -= n * sum_lgamma(nu);
       for (int s = 0; s < phi.size(); ++s) {
-        ans += (alpha * phi[s] - 1) * sumlog[s] - n * lgamma(alpha * phi[s]);
-        if (nderiv > 0) {
-          d1 += phi[s] * (sumlog[s] - n * digamma(alpha * phi[s]));
-          if (nderiv > 1) {
-            d2 += -n * trigamma(alpha * phi[s]) * square(phi[s]);
+        ans += (nu[s] - 1) * sumlog[s];
+      }
+      if (nderiv > 0) {
+        Vector psi = digamma_vector(nu);
+        for (int s = 0; s < phi.size(); ++s) {
+          d1 += phi[s] * (sumlog[s] - n * psi[s]);
+        }
+        if (nderiv > 1) {
+          Vector psi1 = trigamma_vector(nu);
+          for (int s = 0; s < phi.size(); ++s) {
+            d2 += -n * psi1[s] * square(phi[s]);
           }
         }
       }
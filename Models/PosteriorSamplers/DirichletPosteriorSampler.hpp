@@ -31,6 +31,7 @@
 #include "Samplers/UnivariateSliceSampler.hpp"
 
 #include "TargetFun/TargetFun.hpp"
+#include "distributions.hpp"
 #include "TargetFun/MultinomialLogitTransform.hpp"
 
 namespace BOOM {
@@ -147,8 +148,7 @@ namespace BOOM {
 
      private:
       double logp() const;
-      const Vector &sumlogpi_;
-      const double nobs_;
+      DirichletElementLoglike loglike_;
       const uint pos_;
       mutable Vector nu_;
       const double min_nu_;
@@ -44,21 +44,17 @@ namespace BOOM {
   }
 
   struct target : public ScalarTargetFun {
-    const Vector &sumlog_;
-    double nobs_;
-    Vector &nu_;
-    uint which_;
+    DirichletElementLoglike loglike_;
     Ptr<DoubleModel> pri_;
 
-    target(const Vector &sumlog, double nobs, Vector &nu_, uint i,
+    target(const Vector &sumlog, double nobs, const Vector &nu, uint i,
            Ptr<DoubleModel> &pri)
-        : sumlog_(sumlog), nobs_(nobs), nu_(nu_), which_(i), pri_(pri) {}
+        : loglike_(nu, i, sumlog, nobs), pri_(pri) {}
 
     double operator()(double nu) const {
-      nu_[which_] = nu;
       double ans = pri_->logp(nu);
       if (!std::isfinite(ans)) return ans;
-      ans += dirichlet_loglike(nu_, 0, 0, sumlog_, nobs_);
+      ans += loglike_(nu);
       return ans;
     }
   };
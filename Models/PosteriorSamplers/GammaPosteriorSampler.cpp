@@ -131,9 +131,9 @@ namespace BOOM {
         mean_prior_(mean_prior),
         alpha_prior_(alpha_prior),
         mean_sampler_(GammaMeanAlphaLogPosterior(model_, mean_prior_.get()),
-                      true, 1.0, &seeding_rng),
+                      true, 1.0, &rng()),
         alpha_sampler_(GammaAlphaLogPosterior(model_, alpha_prior_.get()), true,
-                       1.0, &seeding_rng) {
+                       1.0, &rng()) {
     mean_sampler_.set_lower_limit(0);
     alpha_sampler_.set_lower_limit(0);
   }
@@ -165,6 +165,20 @@ namespace BOOM {
     return mean_prior_->logp(mean) + alpha_prior_->logp(a);
   }
 
+  void GammaPosteriorSampler::write_checkpoint(CheckpointWriter &out) const {
+    out.begin_section("GammaPosteriorSampler");
+    PosteriorSampler::write_checkpoint(out);
+    mean_sampler_.write_checkpoint(out);
+    alpha_sampler_.write_checkpoint(out);
+  }
+
+  void GammaPosteriorSampler::read_checkpoint(CheckpointReader &in) {
+    in.expect_section("GammaPosteriorSampler");
+    PosteriorSampler::read_checkpoint(in);
+    mean_sampler_.read_checkpoint(in);
+    alpha_sampler_.read_checkpoint(in);
+  }
+
   //======================================================================
 
   GammaPosteriorSamplerBeta::GammaPosteriorSamplerBeta(
@@ -208,4 +222,18 @@ namespace BOOM {
     return mean_prior_->logp(mean) + beta_prior_->logp(beta);
   }
 
+  void GammaPosteriorSamplerBeta::write_checkpoint(CheckpointWriter &out) const {
+    out.begin_section("GammaPosteriorSamplerBeta");
+    PosteriorSampler::write_checkpoint(out);
+    mean_sampler_.write_checkpoint(out);
+    beta_sampler_.write_checkpoint(out);
+  }
+
+  void GammaPosteriorSamplerBeta::read_checkpoint(CheckpointReader &in) {
+    in.expect_section("GammaPosteriorSamplerBeta");
+    PosteriorSampler::read_checkpoint(in);
+    mean_sampler_.read_checkpoint(in);
+    beta_sampler_.read_checkpoint(in);
+  }
+
 }  // namespace BOOM
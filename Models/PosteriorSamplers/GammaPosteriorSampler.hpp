@@ -39,6 +39,8 @@ namespace BOOM {
 
     void draw() override;
     double logpri() const override;
+    void write_checkpoint(CheckpointWriter &out) const override;
+    void read_checkpoint(CheckpointReader &in) override;
 
    private:
     GammaModel *model_;
@@ -59,6 +61,8 @@ namespace BOOM {
     GammaPosteriorSamplerBeta *clone_to_new_host(Model *model) const override;
     void draw() override;
     double logpri() const override;
+    void write_checkpoint(CheckpointWriter &out) const override;
+    void read_checkpoint(CheckpointReader &in) override;
 
    private:
     GammaModel *model_;
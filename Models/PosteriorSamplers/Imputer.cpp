@@ -34,8 +34,14 @@ namespace BOOM {
       std::vector<std::future<void>> jobs;
       jobs.reserve(workers_.size());
       for (int i = 0; i < workers_.size(); ++i) {
-        jobs.emplace_back(
-            pool_.submit(workers_[i]->data_imputation_callback()));
+        if (ordered_reduction_) {
+          LatentDataImputerWorker *worker = workers_[i].get();
+          jobs.emplace_back(
+              pool_.submit([worker]() { worker->impute_latent_data(); }));
+        } else {
+          jobs.emplace_back(
+              pool_.submit(workers_[i]->data_imputation_callback()));
+        }
       }
       std::vector<std::string> error_messages;
       for (int i = 0; i < jobs.size(); ++i) {
@@ -62,6 +68,11 @@ namespace BOOM {
           report_error(err.str());
         }
       }
+      if (ordered_reduction_) {
+        for (int i = 0; i < workers_.size(); ++i) {
+          workers_[i]->combine_complete_data();
+        }
+      }
     }
   }
 
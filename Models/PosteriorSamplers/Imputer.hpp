@@ -20,6 +20,7 @@
 #ifndef BOOM_LATENT_DATA_IMPUTER_HPP
 #define BOOM_LATENT_DATA_IMPUTER_HPP
 
+#include <algorithm>
 #include <cstddef>
 #include <future>
 #include <memory>
@@ -172,11 +173,23 @@ namespace BOOM {
                                           SUFFICIENT_STATISTICS *suf,
                                           RNG &rng) = 0;
 
+    // Impute the latent data for the observations in [begin, end), adding
+    // the augmented data to suf.  The default implementation calls
+    // impute_latent_data_point() for each observation.  Workers that can
+    // share work across observations (e.g. by computing linear predictors
+    // for a block of observations at once) may override it.
+    virtual void impute_latent_data_range(Iterator begin, Iterator end,
+                                          SUFFICIENT_STATISTICS *suf,
+                                          RNG &rng) {
+      for (Iterator it = begin; it != end; ++it) {
+        impute_latent_data_point(**it, suf, rng);
+      }
+    }
+
     void impute_latent_data() override {
       suf_->clear();
-      for (Iterator it = observed_data_begin_; it != observed_data_end_; ++it) {
-        impute_latent_data_point(**it, suf_.get(), *rng_);
-      }
+      impute_latent_data_range(observed_data_begin_, observed_data_end_,
+                               suf_.get(), *rng_);
     };
 
     void combine_complete_data() override { global_suf_.combine(*suf_); }
@@ -200,7 +213,9 @@ namespace BOOM {
     ParallelLatentDataImputer() {}
 
     // Set the number of background threads to use for data augmentation.  If n
-    // <= 0 then no background threads are created.
+    // <= 0 then the work is done in the calling thread.  Threads are borrowed
+    // from the process-wide global_thread_pool(), so nested models do not
+    // oversubscribe the machine.
     void set_number_of_threads(int n) { pool_.set_number_of_threads(n); }
 
     // Add a worker.  The number of workers need not be the same as the number
@@ -212,6 +227,13 @@ namespace BOOM {
     // Removes all elements from the collection of workers.
     void clear_workers() { workers_.clear(); }
 
+    // If true then the workers impute their latent data in parallel, but
+    // their complete data are combined in worker order, in the calling
+    // thread, once every worker has finished.  The combined result then does
+    // not depend on the order in which threads finish.  If false (the
+    // default) each worker combines its data as soon as it finishes.
+    void set_ordered_reduction(bool ordered) { ordered_reduction_ = ordered; }
+
     // The total number of data points seen by all the workers.
     int number_of_observations_managed() const {
       int ans = 0;
@@ -227,10 +249,43 @@ namespace BOOM {
     void impute_latent_data();
 
    private:
-    ThreadWorkerPool pool_;
+    SharedThreadPool pool_;
     std::vector<Ptr<LatentDataImputerWorker>> workers_;
+    bool ordered_reduction_ = false;
   };
 
+  //======================================================================
+  // A default implementation of the the "assign_data_to_workers" member
+  // function declared in LatentDataSampler.
+  template <class OBSERVED_DATA, class WORKER>
+  void assign_data_to_workers(const std::vector<Ptr<OBSERVED_DATA>> &data,
+                              std::vector<Ptr<WORKER>> &workers) {
+    size_t number_of_workers = workers.size();
+    if (number_of_workers == 0) return;
+    size_t nobs = data.size();
+    if (nobs == 0) return;
+    size_t chunk_size = nobs / number_of_workers;
+    typedef typename std::vector<Ptr<OBSERVED_DATA>>::const_iterator Iterator;
+    Iterator it = data.begin();
+    Iterator end = data.end();
+    if (chunk_size == 0) {
+      for (int i = 0; i < nobs; ++i) {
+        workers[i]->set_data(it, it + 1);
+        ++it;
+      }
+      for (int i = nobs; i < number_of_workers; ++i) {
+        workers[i]->set_data(end, end);
+      }
+    } else {
+      for (int i = 0; i < number_of_workers; ++i) {
+        Iterator e = it + chunk_size;
+        if (e > end || (i + 1) == number_of_workers) e = end;
+        workers[i]->set_data(it, e);
+        it = e;
+      }
+    }
+  }
+
   //======================================================================
   // A mix-in class for PosteriorSampler classes that want to sample latent data
   // in parallel.  This class owns and manages the latent data imputer object
@@ -242,7 +297,10 @@ namespace BOOM {
   class LatentDataSampler {
    public:
     LatentDataSampler()
-        : latent_data_fixed_(false), reassign_data_each_time_(false) {}
+        : latent_data_fixed_(false),
+          reassign_data_each_time_(false),
+          block_size_(0),
+          requested_number_of_workers_(1) {}
 
     // Create a new worker, which has access to the global repository of
     // complete data, protected by mutex.
@@ -257,10 +315,19 @@ namespace BOOM {
 
     // Use up to 'n' logical threads to simulate the latent data.  If
     // n <= 1 then run single threaded.
+    //
+    // If an imputation block size has been set then workers are tied to
+    // blocks of data rather than threads, and 'n' only sets the number of
+    // threads.
     virtual void set_number_of_workers(int n) {
       if (n < 1) {
         n = 1;
       }
+      requested_number_of_workers_ = n;
+      if (block_size_ > 0) {
+        imputer_.set_number_of_threads(n == 1 ? 0 : n);
+        return;
+      }
       imputer_.clear_workers();
       workers_.clear();
       for (int i = 0; i < n; ++i) {
@@ -272,6 +339,30 @@ namespace BOOM {
       assign_data_to_workers();
     }
 
+    // Impute the latent data in fixed blocks of consecutive observations, so
+    // that the draws do not depend on the number of threads.
+    //
+    // Each block of 'block_size' observations gets its own worker, and thus
+    // its own RNG stream, seeded in block order.  Blocks are handed to
+    // threads as threads become free, and the complete data from each block
+    // are combined in block order after all blocks have been imputed.  Runs
+    // with the same seed produce identical output for any argument to
+    // set_number_of_workers(), which then only sets the number of threads.
+    //
+    // Args:
+    //   block_size: The number of observations in each block.  If
+    //     block_size <= 0 then the data are split evenly among the workers
+    //     created by set_number_of_workers(), which is the default behavior.
+    void set_imputation_block_size(int block_size) {
+      block_size_ = std::max<int>(block_size, 0);
+      imputer_.clear_workers();
+      workers_.clear();
+      imputer_.set_ordered_reduction(block_size_ > 0);
+      set_number_of_workers(requested_number_of_workers_);
+    }
+
+    int imputation_block_size() const { return block_size_; }
+
     // By default, this class updates its own latent data through a call to
     // impute_latent_data().  Calling this function with a 'true' argument (the
     // default), sets a flag that turns impute_latent_data into a no-op.  The
@@ -316,6 +407,36 @@ namespace BOOM {
    protected:
     std::vector<Ptr<WORKER>> &workers() { return workers_; }
 
+    // Assign the observed data to the workers.  Child classes can implement
+    // assign_data_to_workers() by calling this function with the model's
+    // data.  If an imputation block size has been set, workers are created
+    // as needed so that each block of data has its own worker.  Workers left
+    // over from a larger data set are given empty ranges, so each block keeps
+    // its RNG stream when the data change size.  Otherwise the data are split
+    // evenly among the existing workers.
+    //
+    // WORKER must provide set_data(begin, end), as SufstatImputeWorker does.
+    template <class OBSERVED_DATA>
+    void distribute_data(const std::vector<Ptr<OBSERVED_DATA>> &data) {
+      if (block_size_ <= 0) {
+        BOOM::assign_data_to_workers(data, workers_);
+        return;
+      }
+      size_t number_of_blocks = (data.size() + block_size_ - 1) / block_size_;
+      while (workers_.size() < number_of_blocks) {
+        Ptr<WORKER> worker = create_worker(global_complete_data_mutex_);
+        imputer_.add_worker(worker);
+        workers_.push_back(worker);
+      }
+      auto it = data.begin();
+      for (size_t i = 0; i < workers_.size(); ++i) {
+        auto block_end = it + std::min<std::ptrdiff_t>(block_size_,
+                                                        data.end() - it);
+        workers_[i]->set_data(it, block_end);
+        it = block_end;
+      }
+    }
+
    private:
     // If this flag is set then latent data will not be changed from its current
     // values.
@@ -330,6 +451,13 @@ namespace BOOM {
     // drawing from the correct data set.
     bool reassign_data_each_time_;
 
+    // If positive, the number of observations in each imputation block.  See
+    // set_imputation_block_size().
+    int block_size_;
+
+    // The argument to the most recent call to set_number_of_workers().
+    int requested_number_of_workers_;
+
     // A mutex protecting the global sufficient statistics held by a child
     // object.
     std::mutex global_complete_data_mutex_;
@@ -342,38 +470,6 @@ namespace BOOM {
     ParallelLatentDataImputer imputer_;
   };
 
-  //======================================================================
-  // A default implementation of the the "assign_data_to_workers" member
-  // function declared in LatentDataSampler.
-  template <class OBSERVED_DATA, class WORKER>
-  void assign_data_to_workers(const std::vector<Ptr<OBSERVED_DATA>> &data,
-                              std::vector<Ptr<WORKER>> &workers) {
-    size_t number_of_workers = workers.size();
-    if (number_of_workers == 0) return;
-    size_t nobs = data.size();
-    if (nobs == 0) return;
-    size_t chunk_size = nobs / number_of_workers;
-    typedef typename std::vector<Ptr<OBSERVED_DATA>>::const_iterator Iterator;
-    Iterator it = data.begin();
-    Iterator end = data.end();
-    if (chunk_size == 0) {
-      for (int i = 0; i < nobs; ++i) {
-        workers[i]->set_data(it, it + 1);
-        ++it;
-      }
-      for (int i = nobs; i < number_of_workers; ++i) {
-        workers[i]->set_data(end, end);
-      }
-    } else {
-      for (int i = 0; i < number_of_workers; ++i) {
-        Iterator e = it + chunk_size;
-        if (e > end || (i + 1) == number_of_workers) e = end;
-        workers[i]->set_data(it, e);
-        it = e;
-      }
-    }
-  }
-
 }  // namespace BOOM
 
 #endif  // BOOM_LATENT_DATA_IMPUTER_HPP
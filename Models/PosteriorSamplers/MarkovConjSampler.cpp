@@ -18,12 +18,56 @@
 */
 
 #include "Models/PosteriorSamplers/MarkovConjSampler.hpp"
+#include <sstream>
+#include <vector>
+#include "LinAlg/VectorView.hpp"
 #include "distributions.hpp"
 
 namespace BOOM {
 
   typedef MarkovConjSampler MCS;
 
+  namespace {
+    // The positions of the positive elements of a row of prior counts.  A
+    // zero prior count marks a transition that is not allowed, so the
+    // corresponding transition probability is held at zero.  Returns an
+    // empty vector if every transition is allowed.
+    std::vector<int> allowed_transitions(const ConstVectorView &prior_counts) {
+      std::vector<int> ans;
+      bool all_allowed = true;
+      for (int j = 0; j < prior_counts.size(); ++j) {
+        if (prior_counts[j] > 0) {
+          ans.push_back(j);
+        } else {
+          all_allowed = false;
+        }
+      }
+      if (all_allowed) ans.clear();
+      return ans;
+    }
+
+    // The elements of v at the given positions.
+    Vector subset(const ConstVectorView &v, const std::vector<int> &positions) {
+      Vector ans(positions.size());
+      for (int i = 0; i < positions.size(); ++i) ans[i] = v[positions[i]];
+      return ans;
+    }
+
+    void check_no_forbidden_transitions(const ConstVectorView &counts,
+                                        const ConstVectorView &prior_counts,
+                                        int row) {
+      for (int j = 0; j < counts.size(); ++j) {
+        if (prior_counts[j] <= 0 && counts[j] > 0) {
+          std::ostringstream err;
+          err << "The data contain a transition from state " << row
+              << " to state " << j
+              << ", which has zero prior probability.";
+          report_error(err.str());
+        }
+      }
+    }
+  }  // namespace
+
   MCS::MarkovConjSampler(MarkovModel *Mod, const Ptr<ProductDirichletModel> &Q,
                          const Ptr<DirichletModel> &pi0, RNG &seeding_rng)
       : PosteriorSampler(seeding_rng), mod_(Mod), Q_(Q), pi0_(pi0) {}
@@ -64,7 +108,13 @@ namespace BOOM {
     uint S = Nu.nrow();
     double ans = 0;
     for (uint s = 0; s < S; ++s) {
-      ans += ddirichlet(Q.row(s), Nu.row(s), true);
+      std::vector<int> allowed = allowed_transitions(Nu.row(s));
+      if (allowed.empty()) {
+        ans += ddirichlet(Q.row(s), Nu.row(s), true);
+      } else {
+        ans += ddirichlet(subset(Q.row(s), allowed), subset(Nu.row(s), allowed),
+                          true);
+      }
     }
 
     if (mod_->pi0_fixed()) return ans;
@@ -82,7 +132,17 @@ namespace BOOM {
     uint S = Nu.nrow();
     for (uint s = 0; s < S; ++s) {
       wsp = Nu.row(s) + N.row(s);
-      Q.row(s) = rdirichlet_mt(rng(), wsp);
+      std::vector<int> allowed = allowed_transitions(Nu.row(s));
+      if (allowed.empty()) {
+        Q.row(s) = rdirichlet_mt(rng(), wsp);
+      } else {
+        check_no_forbidden_transitions(N.row(s), Nu.row(s), s);
+        Vector probs = rdirichlet_mt(rng(), subset(wsp, allowed));
+        Q.row(s) = 0.0;
+        for (int i = 0; i < allowed.size(); ++i) {
+          Q(s, allowed[i]) = probs[i];
+        }
+      }
     }
     mod_->set_Q(Q);
 
@@ -104,7 +164,17 @@ namespace BOOM {
     uint S = Nu.nrow();
     for (uint s = 0; s < S; ++s) {
       wsp = Nu.row(s) + N.row(s);
-      Q.row(s) = mdirichlet(wsp);
+      std::vector<int> allowed = allowed_transitions(Nu.row(s));
+      if (allowed.empty()) {
+        Q.row(s) = mdirichlet(wsp);
+      } else {
+        check_no_forbidden_transitions(N.row(s), Nu.row(s), s);
+        Vector probs = mdirichlet(subset(wsp, allowed));
+        Q.row(s) = 0.0;
+        for (int i = 0; i < allowed.size(); ++i) {
+          Q(s, allowed[i]) = probs[i];
+        }
+      }
     }
     mod_->set_Q(Q);
 
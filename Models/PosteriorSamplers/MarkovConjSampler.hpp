@@ -26,6 +26,14 @@
 #include "distributions/rng.hpp"
 
 namespace BOOM {
+  // Draws the transition probabilities of a MarkovModel from their
+  // conjugate (product Dirichlet) full conditional distribution.
+  //
+  // The prior may be sparse.  A zero in row r, column s of the prior counts
+  // Nu marks the transition r -> s as not allowed: Q(r, s) is held at zero
+  // and the remaining elements of the row are drawn from a Dirichlet
+  // distribution over the allowed transitions.  Observing a transition that
+  // is not allowed is an error.  Rows with no zeros are handled as before.
   class MarkovConjSampler : public PosteriorSampler {
    public:
     MarkovConjSampler(MarkovModel *Mod,
@@ -122,8 +122,18 @@ namespace BOOM {
 
     SpdMatrix Siginv = rWish_mt(rng(), posterior_.variance_sample_size(),
                                 posterior_.sum_of_squares().inv());
-    Vector mu = rmvn_ivar_mt(rng(), posterior_.mean(),
-                             posterior_.mean_sample_size() * Siginv);
+
+    WorkspaceScope scope(workspace());
+    SpdMatrix &mean_precision(scope.workspace().spd(Siginv.nrow()));
+    mean_precision = Siginv;
+    mean_precision *= posterior_.mean_sample_size();
+    mean_precision_cholesky_.decompose(mean_precision);
+    if (!mean_precision_cholesky_.is_pos_def()) {
+      report_error("Cholesky decomposition failed in MvnConjSampler.");
+    }
+    Vector &mu(scope.workspace().vector(Siginv.nrow()));
+    rmvn_precision_cholesky_mt(rng(), posterior_.mean(),
+                               mean_precision_cholesky_, VectorView(mu));
     model.set_siginv(Siginv);
     model.set_mu(mu);
   }
@@ -20,6 +20,7 @@
 #ifndef BOOM_MVN_CONJ_SAMPLER_HPP
 #define BOOM_MVN_CONJ_SAMPLER_HPP
 
+#include "LinAlg/Cholesky.hpp"
 #include "Models/MvnGivenSigma.hpp"
 #include "Models/MvnModel.hpp"
 #include "Models/PosteriorSamplers/HierarchicalPosteriorSampler.hpp"
@@ -144,6 +145,10 @@ namespace BOOM {
     mutable NormalInverseWishart::NormalInverseWishartParameters prior_;
     mutable NormalInverseWishart::NormalInverseWishartParameters posterior_;
 
+    // The factor of the precision of mu given Siginv, kept between draws so
+    // its storage is reused.
+    Cholesky mean_precision_cholesky_;
+
     // Report an error if either the mean vector or Sigma matrix is the wrong
     // size.
     void check_dimension(const Vector &mean, const SpdMatrix &Sigma) const;
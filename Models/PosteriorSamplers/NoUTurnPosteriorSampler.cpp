@@ -0,0 +1,83 @@
+// Copyright 2018 Google LLC. All Rights Reserved.
+/*
+  Copyright (C) 2005-2018 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#include "Models/PosteriorSamplers/NoUTurnPosteriorSampler.hpp"
+#include "cpputil/report_error.hpp"
+
+namespace BOOM {
+
+  namespace {
+    typedef NoUTurnPosteriorSampler NUPS;
+
+    // Presents a std::function log density as a dTargetFun.
+    class LogDensityTargetFun : public dTargetFun {
+     public:
+      explicit LogDensityTargetFun(const NUPS::LogDensity &log_density)
+          : log_density_(log_density) {}
+      double operator()(const Vector &x) const override {
+        Vector gradient;
+        return log_density_(x, gradient);
+      }
+      double operator()(const Vector &x, Vector &gradient) const override {
+        return log_density_(x, gradient);
+      }
+
+     private:
+      NUPS::LogDensity log_density_;
+    };
+  }  // namespace
+
+  NUPS::NoUTurnPosteriorSampler(Model *model, const LogDensity &log_posterior,
+                                const LogPrior &log_prior, RNG &seeding_rng)
+      : PosteriorSampler(seeding_rng),
+        model_(model),
+        log_prior_(log_prior),
+        sampler_(new LogDensityTargetFun(log_posterior)) {
+    sampler_.set_rng(&rng(), false);
+  }
+
+  void NUPS::draw() {
+    Vector parameters = model_->vectorize_params(true);
+    if (to_sampling_scale_) {
+      parameters = to_sampling_scale_(parameters);
+    }
+    parameters = sampler_.draw(parameters);
+    if (from_sampling_scale_) {
+      parameters = from_sampling_scale_(parameters);
+    }
+    model_->unvectorize_params(parameters, true);
+  }
+
+  double NUPS::logpri() const {
+    if (!log_prior_) {
+      report_error("No log prior was supplied to NoUTurnPosteriorSampler.");
+    }
+    return log_prior_(model_->vectorize_params(true));
+  }
+
+  void NUPS::set_transformation(const Mapping &to_sampling_scale,
+                                const Mapping &from_sampling_scale) {
+    if (!to_sampling_scale || !from_sampling_scale) {
+      report_error("Both directions of the transformation are needed.");
+    }
+    to_sampling_scale_ = to_sampling_scale;
+    from_sampling_scale_ = from_sampling_scale;
+  }
+
+}  // namespace BOOM
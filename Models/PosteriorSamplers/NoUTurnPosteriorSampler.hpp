@@ -0,0 +1,88 @@
+// Copyright 2018 Google LLC. All Rights Reserved.
+/*
+  Copyright (C) 2005-2018 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#ifndef BOOM_NO_U_TURN_POSTERIOR_SAMPLER_HPP_
+#define BOOM_NO_U_TURN_POSTERIOR_SAMPLER_HPP_
+
+#include <functional>
+#include "LinAlg/Vector.hpp"
+#include "Models/ModelTypes.hpp"
+#include "Models/PosteriorSamplers/PosteriorSampler.hpp"
+#include "Samplers/NoUTurnSampler.hpp"
+
+namespace BOOM {
+
+  // A posterior sampler that draws all the parameters of a model jointly
+  // using the No-U-Turn Sampler.  The parameters are the elements of
+  // model->vectorize_params(true), and the caller supplies the log
+  // posterior density and its gradient as a function of that vector.
+  //
+  // Parameters with a restricted range (variances, probabilities) should
+  // be sampled on an unrestricted scale.  To do so, supply the mappings to
+  // and from the sampling scale with set_transformation(), and express the
+  // log posterior on the sampling scale, including the log Jacobian.  A
+  // Transformation object from TargetFun/Transformation.hpp can be used
+  // to build such a function.
+  class NoUTurnPosteriorSampler : public PosteriorSampler {
+   public:
+    typedef std::function<double(const Vector &x, Vector &gradient)>
+        LogDensity;
+    typedef std::function<double(const Vector &x)> LogPrior;
+    typedef std::function<Vector(const Vector &)> Mapping;
+
+    // Args:
+    //   model:  The model whose parameters are to be sampled.
+    //   log_posterior: The un-normalized log posterior density on the
+    //     sampling scale.  On return the second argument is the gradient.
+    //   log_prior: The log prior density as a function of
+    //     model->vectorize_params(true), used to implement logpri().
+    //   seeding_rng: The random number generator used to seed the RNG for
+    //     this sampler.
+    NoUTurnPosteriorSampler(Model *model, const LogDensity &log_posterior,
+                            const LogPrior &log_prior,
+                            RNG &seeding_rng = GlobalRng::rng);
+
+    void draw() override;
+    double logpri() const override;
+
+    // Sample the parameters on a transformed scale.
+    //
+    // Args:
+    //   to_sampling_scale: Maps model->vectorize_params(true) to the
+    //     sampling scale.
+    //   from_sampling_scale:  The inverse of to_sampling_scale.
+    void set_transformation(const Mapping &to_sampling_scale,
+                            const Mapping &from_sampling_scale);
+
+    // The underlying sampler, which can be used to set the mass matrix,
+    // step size, and adaptation schedule.
+    NoUTurnSampler &sampler() { return sampler_; }
+    const NoUTurnSampler &sampler() const { return sampler_; }
+
+   private:
+    Model *model_;
+    LogPrior log_prior_;
+    Mapping to_sampling_scale_;
+    Mapping from_sampling_scale_;
+    NoUTurnSampler sampler_;
+  };
+
+}  // namespace BOOM
+
+#endif  // BOOM_NO_U_TURN_POSTERIOR_SAMPLER_HPP_
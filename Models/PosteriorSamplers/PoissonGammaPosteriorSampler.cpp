@@ -69,6 +69,20 @@ namespace BOOM {
                model_->prior_sample_size());
   }
 
+  void PoissonGammaPosteriorSampler::write_checkpoint(CheckpointWriter &out) const {
+    out.begin_section("PoissonGammaPosteriorSampler");
+    PosteriorSampler::write_checkpoint(out);
+    prior_mean_sampler_.write_checkpoint(out);
+    prior_sample_size_sampler_.write_checkpoint(out);
+  }
+
+  void PoissonGammaPosteriorSampler::read_checkpoint(CheckpointReader &in) {
+    in.expect_section("PoissonGammaPosteriorSampler");
+    PosteriorSampler::read_checkpoint(in);
+    prior_mean_sampler_.read_checkpoint(in);
+    prior_sample_size_sampler_.read_checkpoint(in);
+  }
+
   double PoissonGammaPosteriorSampler::logp(double prior_mean,
                                             double prior_sample_size) const {
     double ans = prior_mean_prior_distribution_->logp(prior_mean);
@@ -40,6 +40,8 @@ namespace BOOM {
 
     void draw() override;
     double logpri() const override;
+    void write_checkpoint(CheckpointWriter &out) const override;
+    void read_checkpoint(CheckpointReader &in) override;
 
     double logp(double prior_mean, double prior_sample_size) const;
 
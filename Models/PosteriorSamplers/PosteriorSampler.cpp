@@ -46,6 +46,14 @@ namespace BOOM {
 
   void PosteriorSampler::set_seed(unsigned long s) { rng_.seed(s); }
 
+  void PosteriorSampler::write_checkpoint(CheckpointWriter &out) const {
+    rng_.write_checkpoint(out);
+  }
+
+  void PosteriorSampler::read_checkpoint(CheckpointReader &in) {
+    rng_.read_checkpoint(in);
+  }
+
   void PosteriorSampler::find_posterior_mode(double epsilon) {
     report_error("Sampler class does not implement find_posterior_mode.");
   }
@@ -22,6 +22,8 @@
 
 #include "LinAlg/Vector.hpp"
 #include "LinAlg/VectorView.hpp"
+#include "LinAlg/Workspace.hpp"
+#include "cpputil/Checkpoint.hpp"
 #include "cpputil/Ptr.hpp"
 #include "cpputil/RefCounted.hpp"
 #include "distributions/rng.hpp"
@@ -60,6 +62,15 @@ namespace BOOM {
     RNG &rng() const { return rng_; }
     void set_seed(unsigned long);
 
+    // Save or restore the state the sampler carries from one draw to the
+    // next, so that an MCMC run restored from a checkpoint continues
+    // exactly as the original run would have.  The default implementation
+    // records the sampler's RNG.  Samplers with additional state (e.g.
+    // adaptive slice samplers, Metropolis-Hastings move accounting) should
+    // override these functions and call the base class versions.
+    virtual void write_checkpoint(CheckpointWriter &out) const;
+    virtual void read_checkpoint(CheckpointReader &in);
+
     // Returns true if the child class implements
     // find_posterior_mode().  Returns false otherwise.
     virtual bool can_find_posterior_mode() const { return false; }
@@ -102,8 +113,22 @@ namespace BOOM {
     friend void intrusive_ptr_add_ref(PosteriorSampler *m);
     friend void intrusive_ptr_release(PosteriorSampler *m);
 
+   protected:
+    // Scratch space that persists from one call to draw() to the next.
+    // Temporaries requested through a WorkspaceScope on this arena keep their
+    // storage when the scope closes, so after the first draw has sized them,
+    // later draws of the same dimension do not allocate.  Each sampler
+    // (including a copy or clone) has its own arena, so samplers for
+    // different chains running on different threads never share one.
+    //
+    // Usage:
+    //   WorkspaceScope scope(workspace());
+    //   SpdMatrix &precision(scope.workspace().spd(dim));
+    WorkspaceArena &workspace() const { return workspace_.arena(); }
+
    private:
     mutable RNG rng_;
+    PersistentWorkspace workspace_;
   };
 
 }  // namespace BOOM
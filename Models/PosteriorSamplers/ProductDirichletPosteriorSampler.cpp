@@ -20,11 +20,81 @@
 #include "Models/PosteriorSamplers/DirichletPosteriorSampler.hpp"
 #include "Samplers/ScalarSliceSampler.hpp"
 #include "cpputil/math_utils.hpp"
+#include "distributions.hpp"
+#include <vector>
 
 namespace BOOM {
 
   typedef ProductDirichletPosteriorSampler PDPS;
 
+  namespace {
+    // The log posterior of a single element of a row of Nu, for rows where
+    // some elements are structural zeros.  The zeros mark transitions that
+    // are not allowed.  They are held fixed, and the Dirichlet likelihood
+    // involves only the allowed elements, because the observed probability
+    // matrices have zeros (with log = -infinity) in the other positions.
+    class SparseRowLogp : public ScalarTargetFun {
+     public:
+      // Args:
+      //   nu: The full row of Nu.
+      //   allowed:  The positions of the positive elements of nu.
+      //   which: The index in 'allowed' of the element being sampled.
+      //   sumlog:  The full row of the sufficient statistic.
+      //   nobs:  The number of observations.
+      SparseRowLogp(const Vector &nu, const std::vector<int> &allowed,
+                    int which, const Vector &sumlog, double nobs,
+                    const VectorModel *phi_prior,
+                    const DoubleModel *alpha_prior, double min_nu)
+          : nu_(nu),
+            position_(allowed[which]),
+            number_allowed_(allowed.size()),
+            loglike_(subset(nu, allowed), which, subset(sumlog, allowed),
+                     nobs),
+            phi_prior_(phi_prior),
+            alpha_prior_(alpha_prior),
+            min_nu_(min_nu) {}
+
+      double operator()(double nu) const override {
+        if (nu < min_nu_ || nu <= 0) return negative_infinity();
+        nu_[position_] = nu;
+        double alpha = loglike_.other_sum() + nu;
+        double ans = alpha_prior_->logp(alpha);
+        if (!std::isfinite(ans)) return ans;
+        ans += phi_prior_->logp(nu_ / alpha);
+        if (!std::isfinite(ans)) return ans;
+        ans -= (number_allowed_ - 1) * log(alpha);
+        ans += loglike_(nu);
+        return ans;
+      }
+
+     private:
+      static Vector subset(const Vector &v, const std::vector<int> &positions) {
+        Vector ans(positions.size());
+        for (int i = 0; i < positions.size(); ++i) ans[i] = v[positions[i]];
+        return ans;
+      }
+
+      mutable Vector nu_;
+      int position_;
+      int number_allowed_;
+      DirichletElementLoglike loglike_;
+      const VectorModel *phi_prior_;
+      const DoubleModel *alpha_prior_;
+      double min_nu_;
+    };
+
+    // The positions of the positive elements of nu, or an empty vector if
+    // all the elements are positive.
+    std::vector<int> structural_nonzeros(const Vector &nu) {
+      std::vector<int> ans;
+      for (int j = 0; j < nu.size(); ++j) {
+        if (nu[j] > 0) ans.push_back(j);
+      }
+      if (ans.size() == nu.size()) ans.clear();
+      return ans;
+    }
+  }  // namespace
+
   PDPS *PDPS::clone_to_new_host(Model *new_host) const {
     std::vector<Ptr<VectorModel>> phi;
     std::vector<Ptr<DoubleModel>> alpha;
@@ -49,6 +119,20 @@ namespace BOOM {
     for (uint i = 0; i < d; ++i) {
       Vector sumlog_i(sumlog.row(i));
       Vector nu(Nu.row(i));
+      std::vector<int> allowed = structural_nonzeros(nu);
+      if (!allowed.empty()) {
+        for (int k = 0; k < allowed.size(); ++k) {
+          int j = allowed[k];
+          SparseRowLogp logp(nu, allowed, k, sumlog_i, nobs,
+                             phi_row_prior_[i].get(),
+                             alpha_row_prior_[i].get(), min_nu_);
+          ScalarSliceSampler sam(logp, true);
+          sam.set_lower_limit(min_nu_);
+          nu[j] = sam.draw(nu[j]);
+        }
+        Nu.row(i) = nu;
+        continue;
+      }
       for (uint j = 0; j < d; ++j) {
         DirichletSampler::DirichletLogp logp(
             j, nu, sumlog_i, nobs, phi_row_prior_[i].get(),
@@ -72,7 +156,12 @@ namespace BOOM {
       double a = sum(Nu.row(i));
       if (a <= 0) return BOOM::negative_infinity();
       phi = Nu.row(i);
+      // Structural zeros (transitions that are not allowed) are exempt from
+      // the min_nu_ bound, and do not count towards the dimension of phi.
+      int number_allowed = 0;
       for (uint j = 0; j < d; ++j) {
+        if (phi[j] == 0) continue;
+        ++number_allowed;
         if (phi[j] < min_nu_) {
           return BOOM::negative_infinity();
         }
@@ -80,7 +169,7 @@ namespace BOOM {
       phi /= a;
       ans += alpha_row_prior_[i]->logp(a);
       ans += phi_row_prior_[i]->logp(phi);
-      ans -= (d - 1) * log(a);
+      ans -= (number_allowed - 1) * log(a);
     }
     return ans;
   }
@@ -25,6 +25,14 @@
 #include "Models/DoubleModel.hpp"
 
 namespace BOOM {
+  // Samples the parameter matrix Nu of a ProductDirichletModel, one element
+  // at a time.  Each row is given its own prior on phi = nu / sum(nu) and on
+  // alpha = sum(nu).
+  //
+  // Zeros in the initial value of Nu are structural: they mark transitions
+  // that are not allowed in a sparse Markov chain, and stay at zero.  The
+  // other elements of the row are sampled given the allowed elements of
+  // the observed probability vectors.
   class ProductDirichletPosteriorSampler : public PosteriorSampler {
    public:
     // template constructor is needed for polymorphic vectors of models
@@ -36,6 +36,13 @@ namespace BOOM {
 
   SpdData *SpdData::clone() const { return new SpdData(*this); }
 
+  std::size_t SpdData::memory_footprint() const {
+    std::size_t elements = var_.size() + ivar_.size()
+        + ivar_chol_.nrow() * ivar_chol_.nrow()
+        + var_chol_.nrow() * var_chol_.nrow();
+    return sizeof(*this) + observer_bytes() + elements * sizeof(double);
+  }
+
   uint SpdData::size(bool minimal) const {
     uint nrow = dim();
     if (minimal) {
@@ -69,6 +69,9 @@ namespace BOOM {
     void set_var_chol(const Matrix &L, bool signal = true);
     void set_ivar_chol(const Matrix &L, bool signal = true);
 
+    // Counts all four representations, whether or not they are current.
+    std::size_t memory_footprint() const override;
+
    private:
     // Report an error message stating that nothing is current.
     void nothing_current() const;
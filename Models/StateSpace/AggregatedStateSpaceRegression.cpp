@@ -204,8 +204,8 @@ namespace BOOM {
     Vector ans(v.size());
 
     VectorView state_component(ans, 0, state_dim);
-    Vector arg =
-        (observation_vector_.dense() * w) + ConstVectorView(v, 0, state_dim);
+    Vector arg(ConstVectorView(v, 0, state_dim));
+    observation_vector_.add_this_to(arg, w);
     state_component = transition_matrix_->Tmult(arg);
     ans[state_dim] = (1 - fraction_in_initial_period_ * contains_end_) * W;
     ans[state_dim + 1] = (1 - static_cast<int>(contains_end_)) * W;
@@ -256,6 +256,65 @@ namespace BOOM {
     P(state_dim + 1, state_dim + 1) = a * a * Py + b * b * PY + 2 * a * b * PyY;
   }
   //----------------------------------------------------------------------
+  // The transition matrix can be written in block form as
+  //
+  //   | G * T   0     |   where   G = | I  |
+  //   | 0       (a b) |               | z' |
+  //
+  // with rows (a, y) and Y at time t+1 and columns a and (y, Y) at time t.
+  // Partitioning N the same way as P in sandwich_inplace gives
+  //
+  //   T'(G' N1 G)T         =  T'(Na + z Nay' + Nay z' + Ny z z')T
+  //   T'G' N12 * (a b)     =  T'(NaY + z NyY) * (a b)
+  //   (a b)' NY (a b)
+  //
+  // where N1 is the leading (state_dim + 1) block of N, and N12 is the
+  // covariance of that block with Y.
+  void AccumulatorTransitionMatrix::sandwich_inplace_transpose(
+      SpdMatrix &N) const {
+    int state_dim = transition_matrix_->ncol();
+    if (N.ncol() != state_dim + 2)
+      report_multiplication_error(transition_matrix_, observation_vector_,
+                                  contains_end_, fraction_in_initial_period_,
+                                  N.col(0));
+
+    double a = 1 - fraction_in_initial_period_ * contains_end_;
+    int b = !contains_end_;
+
+    Vector Nay(ConstVectorView(N.col(state_dim), 0, state_dim));
+    Vector NaY(ConstVectorView(N.col(state_dim + 1), 0, state_dim));
+    double Ny = N(state_dim, state_dim);
+    double NyY = N(state_dim, state_dim + 1);
+    double NY = N(state_dim + 1, state_dim + 1);
+
+    // Fold the fine observation into the client block, touching only the
+    // rows and columns where z is nonzero.
+    SubMatrix Na(N, 0, state_dim - 1, 0, state_dim - 1);
+    for (const auto &zi : observation_vector_) {
+      Na.col(zi.first).axpy(Nay, zi.second);
+      Na.row(zi.first).axpy(Nay, zi.second);
+      for (const auto &zj : observation_vector_) {
+        Na(zi.first, zj.first) += Ny * zi.second * zj.second;
+      }
+    }
+    SpdMatrix client_N(Na.to_matrix(), false);
+    transition_matrix_->sandwich_inplace_transpose(client_N);
+    Na = client_N;
+
+    Vector cross = NaY;
+    observation_vector_.add_this_to(cross, NyY);
+    Vector T_cross = transition_matrix_->Tmult(cross);
+    VectorView(N.col(state_dim), 0, state_dim) = a * T_cross;
+    VectorView(N.row(state_dim), 0, state_dim) = a * T_cross;
+    VectorView(N.col(state_dim + 1), 0, state_dim) = b * T_cross;
+    VectorView(N.row(state_dim + 1), 0, state_dim) = b * T_cross;
+
+    N(state_dim, state_dim) = a * a * NY;
+    N(state_dim, state_dim + 1) = a * b * NY;
+    N(state_dim + 1, state_dim) = a * b * NY;
+    N(state_dim + 1, state_dim + 1) = b * b * NY;
+  }
+  //----------------------------------------------------------------------
   Matrix &AccumulatorTransitionMatrix::add_to(Matrix &P) const {
     int state_dim = transition_matrix_->nrow();
     if (P.nrow() != state_dim + 2 || P.ncol() != state_dim + 2) {
@@ -350,7 +409,7 @@ namespace BOOM {
       report_error("wrong sizes in AccumulatorStateVarianceMatrix::add_to");
     }
 
-    SubMatrix RQR(m, 0, state_dim, 0, state_dim);
+    SubMatrix RQR(m, 0, state_dim - 1, 0, state_dim - 1);
     state_variance_matrix_->add_to_submatrix(RQR);
 
     Vector ZRQR = (*state_variance_matrix_) * observation_vector_.dense();
@@ -161,6 +161,12 @@ namespace BOOM {
       return dense().inner(weights);
     }
     void sandwich_inplace(SpdMatrix &P) const override;
+
+    // P -> this->transpose() * P * this, as used by the disturbance smoother.
+    // Like sandwich_inplace, the cumulator rows are handled blockwise so the
+    // only matrix work is on the client state.
+    void sandwich_inplace_transpose(SpdMatrix &P) const override;
+
     Matrix &add_to(Matrix &P) const override;
 
    private:
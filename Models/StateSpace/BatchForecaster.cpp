@@ -0,0 +1,110 @@
+/*
+  Copyright (C) 2005-2024 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include "Models/StateSpace/BatchForecaster.hpp"
+#include <cmath>
+#include "Models/PosteriorSamplers/ZeroMeanGaussianConjSampler.hpp"
+#include "Models/StateSpace/PosteriorSamplers/StateSpacePosteriorSampler.hpp"
+#include "cpputil/ThreadTools.hpp"
+#include "cpputil/report_error.hpp"
+#include "stats/moments.hpp"
+#include "stats/quantile.hpp"
+
+namespace BOOM {
+
+  BatchStateSpaceForecaster::BatchStateSpaceForecaster(
+      const StateSpecification &specification, const Options &options)
+      : specification_(specification),
+        options_(options)
+  {
+    if (!specification_) {
+      report_error("BatchStateSpaceForecaster needs a state specification.");
+    }
+    if (options_.horizon < 1) {
+      report_error("The forecast horizon must be positive.");
+    }
+    if (options_.burn < 0 || options_.burn >= options_.niter) {
+      report_error("Need 0 <= burn < niter.");
+    }
+    if (options_.quantiles.empty()) {
+      report_error("At least one quantile must be requested.");
+    }
+  }
+
+  Matrix BatchStateSpaceForecaster::forecast_one(
+      const Vector &series, int series_index) const {
+    RNG rng(options_.seed, series_index, RNG::PHILOX);
+
+    std::vector<bool> observed(series.size());
+    std::vector<double> observed_values;
+    for (int t = 0; t < series.size(); ++t) {
+      observed[t] = std::isfinite(series[t]);
+      if (observed[t]) observed_values.push_back(series[t]);
+    }
+    if (observed_values.size() < 2) {
+      report_error("Each series needs at least two observed values.");
+    }
+    Vector y(series);
+    for (int t = 0; t < y.size(); ++t) {
+      if (!observed[t]) y[t] = 0;
+    }
+
+    NEW(StateSpaceModel, model)(y, observed);
+    specification_(*model, rng);
+    if (model->number_of_state_models() == 0) {
+      report_error("The state specification did not add any state.");
+    }
+    if (model->observation_model()->number_of_sampling_methods() == 0) {
+      double sigma_guess = sd(observed_values);
+      if (!(sigma_guess > 0)) sigma_guess = 1.0;
+      NEW(ZeroMeanGaussianConjSampler, observation_sampler)(
+          model->observation_model(), 1, sigma_guess, rng);
+      model->observation_model()->set_method(observation_sampler);
+    }
+    NEW(StateSpacePosteriorSampler, sampler)(model.get(), rng);
+    model->set_method(sampler);
+
+    Matrix draws(options_.niter - options_.burn, options_.horizon);
+    for (int i = 0; i < options_.niter; ++i) {
+      model->sample_posterior();
+      if (i >= options_.burn) {
+        draws.row(i - options_.burn) = model->simulate_forecast(
+            rng, options_.horizon, model->final_state());
+      }
+    }
+    return quantile(draws, options_.quantiles);
+  }
+
+  Array BatchStateSpaceForecaster::forecast(
+      const std::vector<Vector> &series) const {
+    int nseries = series.size();
+    int nquantiles = options_.quantiles.size();
+    Array ans(std::vector<int>{nseries, nquantiles, options_.horizon});
+    global_thread_pool().parallel_for(
+        0, nseries, 1, [this, &series, &ans, nquantiles](int s) {
+          Matrix quantiles = forecast_one(series[s], s);
+          for (int q = 0; q < nquantiles; ++q) {
+            for (int h = 0; h < options_.horizon; ++h) {
+              ans(s, q, h) = quantiles(q, h);
+            }
+          }
+        });
+    return ans;
+  }
+
+}  // namespace BOOM
@@ -0,0 +1,112 @@
+#ifndef BOOM_STATE_SPACE_BATCH_FORECASTER_HPP_
+#define BOOM_STATE_SPACE_BATCH_FORECASTER_HPP_
+
+/*
+  Copyright (C) 2005-2024 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include <functional>
+#include <vector>
+#include "LinAlg/Array.hpp"
+#include "LinAlg/Vector.hpp"
+#include "Models/StateSpace/StateSpaceModel.hpp"
+#include "distributions/rng.hpp"
+
+namespace BOOM {
+
+  // Fits a separate Gaussian state space model to each of many time series,
+  // and summarizes the posterior predictive distribution of each series by a
+  // set of quantiles.  All the work is done in C++, with the series spread
+  // across the global thread pool, so the per-series overhead is just the
+  // construction of one StateSpaceModel.
+  //
+  // Usage:
+  //   BatchStateSpaceForecaster::Options options;
+  //   options.horizon = 28;
+  //   BatchStateSpaceForecaster forecaster(
+  //       [](StateSpaceModel &model, RNG &seeding_rng) {
+  //         NEW(LocalLevelStateModel, level)(...);
+  //         level->set_method(new ZeroMeanGaussianConjSampler(
+  //             level.get(), 1, .01, seeding_rng));
+  //         model.add_state(level);
+  //       },
+  //       options);
+  //   Array forecast_quantiles = forecaster.forecast(series);
+  class BatchStateSpaceForecaster {
+   public:
+    struct Options {
+      // The number of MCMC iterations for each series, including burn-in.
+      int niter = 1000;
+
+      // The number of initial MCMC iterations to discard.
+      int burn = 100;
+
+      // The number of time periods to forecast.
+      int horizon = 1;
+
+      // The quantiles of the predictive distribution to report.
+      Vector quantiles = Vector{.025, .5, .975};
+
+      // Series i is simulated using random numbers from the Philox stream
+      // (seed, i), so results do not depend on the number of threads.
+      RNG::RngIntType seed = 8675309;
+    };
+
+    // A function that adds state models (with posterior samplers) to a model
+    // holding a single series.  Any random number generators the function
+    // needs (e.g. to seed posterior samplers) must be seeded from
+    // seeding_rng, which is specific to the series, because the function is
+    // called concurrently from different threads.
+    //
+    // The function may also set a posterior sampler for the observation
+    // model.  If it does not, a ZeroMeanGaussianConjSampler with one prior
+    // observation and a prior guess equal to the sample standard deviation
+    // of the series is used.
+    using StateSpecification =
+        std::function<void(StateSpaceModel &model, RNG &seeding_rng)>;
+
+    BatchStateSpaceForecaster(const StateSpecification &specification,
+                              const Options &options);
+
+    // Fit a model to each series and forecast.
+    //
+    // Args:
+    //   series: The time series to be forecast.  Missing values may be coded
+    //     as NaN.
+    //
+    // Returns:
+    //   An array with dimensions [series.size(), number of quantiles,
+    //   horizon].  Element (s, q, h) is quantile q of the predictive
+    //   distribution for series s, h + 1 periods after the end of the data.
+    //   The array's data are stored contiguously.
+    Array forecast(const std::vector<Vector> &series) const;
+
+    // Fit and forecast a single series.  This is the unit of work done by
+    // forecast().
+    //
+    // Returns:
+    //   A matrix with one row per quantile and one column per time period.
+    Matrix forecast_one(const Vector &series, int series_index) const;
+
+   private:
+    StateSpecification specification_;
+    Options options_;
+  };
+
+}  // namespace BOOM
+
+#endif  // BOOM_STATE_SPACE_BATCH_FORECASTER_HPP_
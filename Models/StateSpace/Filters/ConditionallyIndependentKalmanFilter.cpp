@@ -21,6 +21,7 @@
 #include "LinAlg/DiagonalMatrix.hpp"
 #include "LinAlg/Cholesky.hpp"
 #include "cpputil/math_utils.hpp"
+#include "cpputil/Constants.hpp"
 
 namespace BOOM {
 
@@ -202,6 +203,93 @@ namespace BOOM {
       }
     }
 
+    //---------------------------------------------------------------------------
+    double Marginal::update(const Vector &observation,
+                            const Selector &observed) {
+      if (observed.nvars() > model_->state_dimension()) {
+        double log_likelihood = 0;
+        if (collapsed_update(observation, observed, log_likelihood)) {
+          return log_likelihood;
+        }
+      }
+      return MultivariateMarginalDistributionBase::update(
+          observation, observed);
+    }
+
+    //---------------------------------------------------------------------------
+    // With H = diag(1 / hinv) the observation variance, Z the observation
+    // coefficients, and P = LL' the state variance, the collapsed observation
+    // is summarized by M = Z' Hinv Z and w = Z' Hinv v, where v is the
+    // prediction error.  Let K = I + L'ML.  Then
+    //
+    //   Finv = Hinv - Hinv Z L Kinv L' Z' Hinv    (Woodbury)
+    //   log |Finv| = log |Hinv| - log |K|         (determinant lemma)
+    //   v' Finv v = v' Hinv v - (L'w)' Kinv (L'w)
+    //   P[t|t] = P - P Z' Finv Z P = L Kinv L'
+    //   a[t|t] = a + P Z' Finv v = a + P[t|t] w.
+    bool Marginal::collapsed_update(const Vector &observation,
+                                    const Selector &observed,
+                                    double &log_likelihood) {
+      int t = time_index();
+      SpdMatrix variance = previous() ? previous()->state_variance() :
+          model_->initial_state_variance();
+      Ptr<SparseKalmanMatrix> observation_coefficients =
+          model_->observation_coefficients(t, observed);
+
+      Vector observation_precision =
+          1.0 / model_->observation_variance(t, observed).diag();
+      Vector prediction_error = observed.select_if_needed(observation)
+          - *observation_coefficients * state_mean();
+      Vector scaled_prediction_error = prediction_error;
+      double sumlog_precision = 0;
+      for (int i = 0; i < observation_precision.size(); ++i) {
+        scaled_prediction_error[i] *= observation_precision[i];
+        sumlog_precision += log(observation_precision[i]);
+      }
+
+      Cholesky state_variance_chol(variance);
+      Matrix lower_triangle = state_variance_chol.getL(false);
+      SpdMatrix inner = sandwich_transpose(
+          lower_triangle, observation_coefficients->inner(observation_precision));
+      inner.diag() += 1.0;
+      double condition_number = inner.condition_number();
+      Cholesky inner_chol(inner);
+      if (!(condition_number < 1e+8) || !inner_chol.is_pos_def()) {
+        return false;
+      }
+      SpdMatrix inner_inverse = inner_chol.inv();
+
+      Vector collapsed_error = lower_triangle.Tmult(
+          observation_coefficients->Tmult(scaled_prediction_error));
+      forecast_precision_inner_matrix_ = inner_inverse;
+      forecast_precision_inner_condition_number_ = condition_number;
+      forecast_precision_log_determinant_ = sumlog_precision - inner_chol.logdet();
+      forecast_precision_implementation_ = ForecastPrecisionImplementation::Woodbury;
+      set_prediction_error(prediction_error);
+
+      log_likelihood = -.5 * observed.nvars() * Constants::log_root_2pi
+          + .5 * forecast_precision_log_determinant_
+          - .5 * (prediction_error.dot(scaled_prediction_error)
+                  - inner_inverse.Mdist(collapsed_error));
+      if (std::isnan(log_likelihood)) {
+        log_likelihood = negative_infinity();
+      }
+
+      // Contemporaneous moments, followed by the transition to t + 1.
+      Vector contemporaneous_mean = state_mean()
+          + lower_triangle * (inner_inverse * collapsed_error);
+      SpdMatrix contemporaneous_variance = sandwich(
+          lower_triangle, inner_inverse);
+      const SparseKalmanMatrix &transition(
+          *model_->state_transition_matrix(t));
+      set_state_mean(transition * contemporaneous_mean);
+      transition.sandwich_inplace(contemporaneous_variance);
+      model_->state_variance_matrix(t)->add_to(contemporaneous_variance);
+      contemporaneous_variance.fix_near_symmetry();
+      set_state_variance(contemporaneous_variance);
+      return true;
+    }
+
     //---------------------------------------------------------------------------
     SpdMatrix Marginal::direct_forecast_precision() const {
       // Ensure the the 'state_variance' we're using is P[t] and not P[t+1].
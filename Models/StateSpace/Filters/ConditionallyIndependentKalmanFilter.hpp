@@ -56,6 +56,18 @@ namespace BOOM {
       // of Y is large.  The resulting matrix will be large^2.
       SpdMatrix direct_forecast_precision() const;
 
+      // When more series are observed than there are state variables, the
+      // observation is collapsed to the state dimension before the update.
+      // Because the observation variance is diagonal, Z' Hinv y and
+      // Z' Hinv Z carry all the information y[t] has about the state, so the
+      // update, the log likelihood, and the Woodbury representation of the
+      // forecast precision can be computed from state_dim x state_dim
+      // matrices.  The cost is linear in the number of observed series.
+      // Smaller observations, or poorly conditioned collapsed updates, are
+      // handled by the base class.
+      double update(const Vector &observation,
+                    const Selector &observed) override;
+
       Ptr<SparseKalmanMatrix> sparse_forecast_precision() const override;
       double forecast_precision_log_determinant() const override;
 
@@ -70,6 +82,13 @@ namespace BOOM {
       const MultivariateStateSpaceModelBase *model() const override;
 
      private:
+      // Implements update() in the case where y[t] has more observed elements
+      // than the state has dimensions.  Returns false, without modifying the
+      // object, if the collapsed update would be numerically unreliable.
+      bool collapsed_update(const Vector &observation,
+                            const Selector &observed,
+                            double &log_likelihood);
+
       // Called as part of the 'update' method in the base class.
       void update_sparse_forecast_precision(const Selector &observed) override;
 
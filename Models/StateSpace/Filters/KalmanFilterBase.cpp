@@ -18,6 +18,7 @@
 
 #include "Models/StateSpace/Filters/KalmanFilterBase.hpp"
 #include "Models/StateSpace/StateSpaceModelBase.hpp"
+#include "cpputil/MemoryFootprint.hpp"
 
 namespace BOOM {
   namespace Kalman {
@@ -32,6 +33,12 @@ namespace BOOM {
       state_variance_ = var;
     }
 
+    void MarginalDistributionBase::take_state_variance(
+        MarginalDistributionBase &previous) {
+      state_variance_.swap(previous.state_variance_);
+      previous.state_variance_ = SpdMatrix();
+    }
+
     void MarginalDistributionBase::increment_state_variance(
         const SpdMatrix &variance_increment) {
       state_variance_ += variance_increment;
@@ -49,12 +56,32 @@ namespace BOOM {
         }
       }
     }
+
+    std::size_t MarginalDistributionBase::memory_footprint() const {
+      return sizeof(*this) + heap_bytes(state_mean_)
+          + state_variance_.size() * sizeof(double)
+          + heap_bytes(scaled_state_error_);
+    }
   }  // namespace Kalman
 
   //===========================================================================
   KalmanFilterBase::KalmanFilterBase()
       : status_(NOT_CURRENT), log_likelihood_(negative_infinity()) {}
 
+  KalmanFilterBase::KalmanFilterBase(const KalmanFilterBase &rhs)
+      : status_(rhs.status_.load()),
+        log_likelihood_(rhs.log_likelihood_),
+        initial_scaled_state_error_(rhs.initial_scaled_state_error_) {}
+
+  KalmanFilterBase &KalmanFilterBase::operator=(const KalmanFilterBase &rhs) {
+    if (&rhs != this) {
+      status_ = rhs.status_.load();
+      log_likelihood_ = rhs.log_likelihood_;
+      initial_scaled_state_error_ = rhs.initial_scaled_state_error_;
+    }
+    return *this;
+  }
+
   std::ostream &KalmanFilterBase::print(std::ostream &out) const {
     for (int i = 0; i < size(); ++i) {
       out << (*this)[i].state_mean() << std::endl;
@@ -68,6 +95,14 @@ namespace BOOM {
     return out.str();
   }
 
+  std::size_t KalmanFilterBase::memory_footprint() const {
+    std::size_t ans = sizeof(*this) + heap_bytes(initial_scaled_state_error_);
+    for (int t = 0; t < size(); ++t) {
+      ans += (*this)[t].memory_footprint();
+    }
+    return ans;
+  }
+
   Matrix KalmanFilterBase::state_mean() const {
     Matrix ans;
     int time_dimension = size();
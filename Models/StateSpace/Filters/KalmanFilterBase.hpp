@@ -19,6 +19,8 @@
   Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
 */
 
+#include <atomic>
+#include <cstddef>
 #include "LinAlg/SpdMatrix.hpp"
 #include "LinAlg/Vector.hpp"
 #include "LinAlg/VectorView.hpp"
@@ -50,6 +52,16 @@ namespace BOOM {
 
       virtual ~MarginalDistributionBase() {}
 
+      // Filters store their marginal distributions by value in a
+      // std::vector.  Declaring the move operations lets the vector grow by
+      // moving each node's mean and variance rather than copying them.
+      MarginalDistributionBase(const MarginalDistributionBase &rhs) = default;
+      MarginalDistributionBase(MarginalDistributionBase &&rhs) = default;
+      MarginalDistributionBase &operator=(
+          const MarginalDistributionBase &rhs) = default;
+      MarginalDistributionBase &operator=(
+          MarginalDistributionBase &&rhs) = default;
+
       // The time index for the time point described by this marginal
       // distribution.
       int time_index() const { return time_index_; }
@@ -71,6 +83,12 @@ namespace BOOM {
       void set_state_variance(const SpdMatrix &var);
       void increment_state_variance(const SpdMatrix &variance_increment);
 
+      // Move the state variance held by 'previous' into this marginal
+      // distribution, leaving 'previous' with an empty (0 x 0) variance.
+      // Filters use this instead of set_state_variance() when they do not
+      // keep the state variance for every time point.
+      void take_state_variance(MarginalDistributionBase &previous);
+
       // Convert the state mean and variance from forward-looking moments
       // (e.g. E(state[t+1] | Data to t)) to contemporaneous moments
       // (e.g. E(state[t] | Data to t)).
@@ -94,7 +112,13 @@ namespace BOOM {
         scaled_state_error_ = scaled_error;
       }
 
+      // The number of bytes held by this marginal distribution, including
+      // the heap storage of its state moments.  Child classes holding
+      // additional storage should override.
+      virtual std::size_t memory_footprint() const;
+
      protected:
+      Vector & mutable_state_mean() {return state_mean_;}
       SpdMatrix & mutable_state_variance() {return state_variance_;}
       void check_variance(const SpdMatrix &v) const;
 
@@ -123,6 +147,8 @@ namespace BOOM {
   class KalmanFilterBase {
    public:
     KalmanFilterBase();
+    KalmanFilterBase(const KalmanFilterBase &rhs);
+    KalmanFilterBase &operator=(const KalmanFilterBase &rhs);
     virtual ~KalmanFilterBase() {}
 
     //--------------------------------------------------------------------------
@@ -140,6 +166,7 @@ namespace BOOM {
     enum KalmanFilterStatus { NOT_CURRENT, MCMC_CURRENT, CURRENT };
 
     void set_status(const KalmanFilterStatus &status) { status_ = status; }
+    KalmanFilterStatus status() const { return status_; }
 
     // Print the state mean of each marginal distribution.
     virtual std::ostream & print(std::ostream &out) const;
@@ -153,6 +180,9 @@ namespace BOOM {
     // The number of nodes (time points) managed by the filter.
     virtual int size() const = 0;
 
+    // The number of bytes held by the filter and its marginal distributions.
+    virtual std::size_t memory_footprint() const;
+
     // Return the last computed value of log likelihood.
     double log_likelihood() const {
       return log_likelihood_;
@@ -196,8 +226,10 @@ namespace BOOM {
 
    private:
     // For explanation, please see the comments for the enum definition ofr
-    // KalmanFilterStatus.
-    KalmanFilterStatus status_;
+    // KalmanFilterStatus.  The status is atomic because parameter observers
+    // may mark the filter NOT_CURRENT from several threads at once, e.g. when
+    // the regression models in a multivariate model are drawn in parallel.
+    std::atomic<KalmanFilterStatus> status_;
 
     // The log likelihood of the data as computed by the last forward update.
     double log_likelihood_;
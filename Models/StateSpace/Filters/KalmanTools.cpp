@@ -19,6 +19,7 @@
 
 #include "Models/StateSpace/Filters/KalmanTools.hpp"
 #include "distributions.hpp"
+#include "LinAlg/fused_operations.hpp"
 namespace BOOM {
 
   double scalar_kalman_update(double y, Vector &a, SpdMatrix &P, Vector &K,
@@ -64,12 +65,13 @@ namespace BOOM {
     Z = observed.select_rows(Z);
     H = observed.select(H);
 
-    v = Y - Z * a;
+    residual(v, Y, Z, a);
     F = Z * P * Z.transpose() + H;
     SpdMatrix Finv = F.inv();
     K = T * P * Z.transpose() * Finv;
-    Vector a_contemp = a + P * Z.Tmult(Finv * v);
-    a = T * a_contemp;
+    Vector a_contemp = a;
+    matrix_vector_product(a_contemp, P, Z.Tmult(Finv * v), 1.0, 1.0);
+    matrix_vector_product(a, T, a_contemp);
 
     SpdMatrix Pcontemp = P - P * (Z.Tmult(Finv * Z)) * P;
     P = T * Pcontemp * T.transpose() + RQR;
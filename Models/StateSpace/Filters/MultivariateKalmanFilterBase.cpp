@@ -19,8 +19,10 @@
 #include "Models/StateSpace/Filters/MultivariateKalmanFilterBase.hpp"
 #include "Models/StateSpace/Multivariate/MultivariateStateSpaceModelBase.hpp"
 #include "cpputil/report_error.hpp"
+#include "cpputil/MemoryFootprint.hpp"
 #include "cpputil/Constants.hpp"
 #include "LinAlg/Eigen.hpp"
+#include "Samplers/McmcProfiler.hpp"
 
 namespace BOOM {
 
@@ -275,6 +277,11 @@ namespace BOOM {
       return log_likelihood;
     }
 
+    std::size_t MultivariateMarginalDistributionBase::memory_footprint() const {
+      return MarginalDistributionBase::memory_footprint()
+          - sizeof(MarginalDistributionBase) + sizeof(*this)
+          + heap_bytes(prediction_error_);
+    }
   }  // namespace Kalman
 
   //===========================================================================
@@ -282,6 +289,7 @@ namespace BOOM {
     if (!model()) {
       report_error("Model must be set before calling update().");
     }
+    ScopedPhaseTimer timer(McmcProfiler::kKalmanFilter);
     clear_loglikelihood();
     // TODO: Verify that the isolate_shared_state line doesn't break anything
     // when the model has series-specific state.
@@ -328,6 +336,7 @@ namespace BOOM {
     if (!model()) {
       report_error("Model must be set before calling fast_disturbance_smooth().");
     }
+    ScopedPhaseTimer timer(McmcProfiler::kKalmanSmoother);
 
     int n = model()->time_dimension();
     Vector r(model()->state_dimension(), 0.0);
@@ -404,6 +413,7 @@ namespace BOOM {
     if (!model()) {
       report_error("Model must be set before calling fast_disturbance_smooth().");
     }
+    ScopedPhaseTimer timer(McmcProfiler::kKalmanSmoother);
 
     int n = model()->time_dimension();
     int state_dimension = model()->state_dimension();
@@ -79,7 +79,8 @@ namespace BOOM {
       //
       // Returns:
       //   The log likelihood log p(y_t | Y_{t-1}).
-      double update(const Vector &observation, const Selector &observed);
+      virtual double update(const Vector &observation,
+                            const Selector &observed);
 
       // The difference between the observed data at this time point and its
       // expected value given past data.  If any data elements are missing, they
@@ -124,16 +125,19 @@ namespace BOOM {
       // structural matrices defining the state space model.
       virtual const MultivariateStateSpaceModelBase *model() const = 0;
 
+      std::size_t memory_footprint() const override;
+
+     protected:
+      // Implement update() in the case where y[t] is fully missing (i.e. no
+      // part of it is observed.
+      double fully_missing_update();
+
      private:
       // Store a minimial set of information to allow sparse_forecast_precision
       // to be quickly computed.
       virtual void update_sparse_forecast_precision(
           const Selector &observed) = 0;
 
-      // Implement update() in the case where y[t] is fully missing (i.e. no
-      // part of it is observed.
-      double fully_missing_update();
-
       // y[t] - E(y[t] | Y[t-1]).  The dimension matches y[t], which might vary
       // across t.
       Vector prediction_error_;
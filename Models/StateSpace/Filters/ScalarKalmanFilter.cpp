@@ -18,9 +18,39 @@
 
 #include "Models/StateSpace/Filters/ScalarKalmanFilter.hpp"
 #include "Models/StateSpace/StateSpaceModelBase.hpp"
+#include <algorithm>
+#include <type_traits>
+#include "LinAlg/fused_operations.hpp"
+#include "LinAlg/QR.hpp"
+#include "LinAlg/SubMatrix.hpp"
+#include "LinAlg/Workspace.hpp"
+#include "Samplers/McmcProfiler.hpp"
+#include "cpputil/MemoryFootprint.hpp"
+#include "cpputil/math_utils.hpp"
 #include "distributions.hpp"
 
 namespace BOOM {
+
+  namespace {
+    // Returns a matrix L with L * L^T == Sigma.  The Cholesky factor is used
+    // if Sigma is positive definite.  Otherwise (e.g. if Sigma has some zero
+    // eigenvalues) the transpose of the eigen_root is used.
+    Matrix variance_square_root(const SpdMatrix &Sigma) {
+      bool ok = true;
+      Matrix ans = Sigma.chol(ok);
+      if (!ok) {
+        ans = eigen_root(Sigma).transpose();
+      }
+      return ans;
+    }
+  }  // namespace
+
+  // std::vector only moves its elements when it grows if the move
+  // constructor cannot throw.  Otherwise every node would be copied.
+  static_assert(std::is_nothrow_move_constructible<
+                    Kalman::ScalarMarginalDistribution>::value,
+                "Kalman filter nodes should be cheap to move.");
+
   namespace Kalman {
     namespace {
       // Shorten the name.
@@ -41,7 +71,18 @@ namespace BOOM {
     double Marginal::update(double y, bool missing, int t,
                             double observation_variance_scale_factor) {
       const SparseVector observation_coefficients = model_->observation_matrix(t);
-      Vector PZ = state_variance() * observation_coefficients;
+      // PZ is scratch space, so it is taken from the per-thread workspace to
+      // avoid a heap allocation at each time point.
+      WorkspaceScope scope;
+      const SpdMatrix &P(state_variance());
+      Vector &PZ(scope.workspace().vector(P.nrow()));
+      // P is symmetric, so PZ combines the columns of P selected by the
+      // nonzero elements of Z.  Regression style state models (e.g. dynamic
+      // regression) have sparse Z, and columns are contiguous in memory.
+      PZ = 0.0;
+      for (const auto &element : observation_coefficients) {
+        PZ.axpy(P.col(element.first), element.second);
+      }
 
       prediction_variance_ =
           observation_coefficients.dot(PZ) +
@@ -57,7 +98,8 @@ namespace BOOM {
 
       double loglike = 0;
       if (!missing) {
-        kalman_gain_ = TPZ / prediction_variance_;
+        kalman_gain_ = TPZ;
+        kalman_gain_ /= prediction_variance_;
         double mu = observation_coefficients.dot(state_mean());
         prediction_error_ = y - mu;
         loglike = dnorm(y, mu, sqrt(prediction_variance_), true);
@@ -66,12 +108,11 @@ namespace BOOM {
         prediction_error_ = 0;
       }
 
+      Vector new_state_mean = state_transition_matrix * state_mean();
       if (!missing) {
-        set_state_mean(state_transition_matrix * state_mean()
-                       + kalman_gain_ * prediction_error_);
-      } else {
-        set_state_mean(state_transition_matrix * state_mean());
+        new_state_mean.axpy(kalman_gain_, prediction_error_);
       }
+      mutable_state_mean().swap(new_state_mean);
 
       state_transition_matrix.sandwich_inplace(mutable_state_variance());
       if (!missing) {
@@ -82,6 +123,173 @@ namespace BOOM {
       return loglike;
     }
 
+    double Marginal::steady_state_update(double y, int t,
+                                         double prediction_variance,
+                                         const Vector &kalman_gain) {
+      const SparseKalmanMatrix &state_transition_matrix(
+          *model_->state_transition_matrix(t));
+      prediction_variance_ = prediction_variance;
+      kalman_gain_ = kalman_gain;
+      double mu = model_->observation_matrix(t).dot(state_mean());
+      prediction_error_ = y - mu;
+      set_state_mean(state_transition_matrix * state_mean()
+                     + kalman_gain_ * prediction_error_);
+      return dnorm(y, mu, sqrt(prediction_variance_), true);
+    }
+
+    double Marginal::update(double y, bool missing,
+                            const SparseVector &observation_coefficients,
+                            double observation_variance,
+                            const Matrix &transition,
+                            const SpdMatrix &state_error_variance) {
+      WorkspaceScope scope;
+      const SpdMatrix &P(state_variance());
+      const int state_dim = P.nrow();
+      Vector &PZ(scope.workspace().vector(state_dim));
+      PZ = 0.0;
+      for (const auto &element : observation_coefficients) {
+        PZ.axpy(P.col(element.first), element.second);
+      }
+      prediction_variance_ =
+          observation_coefficients.dot(PZ) + observation_variance;
+      if (prediction_variance_ <= 0) {
+        report_error("Found a zero (or negative) forecast variance!");
+      }
+      Vector &TPZ(scope.workspace().vector(state_dim));
+      matrix_vector_product(VectorView(TPZ), transition, PZ);
+
+      double loglike = 0;
+      Vector &new_state_mean(scope.workspace().vector(state_dim));
+      matrix_vector_product(VectorView(new_state_mean), transition,
+                            state_mean());
+      if (!missing) {
+        kalman_gain_ = TPZ;
+        kalman_gain_ /= prediction_variance_;
+        double mu = observation_coefficients.dot(state_mean());
+        prediction_error_ = y - mu;
+        loglike = dnorm(y, mu, sqrt(prediction_variance_), true);
+        new_state_mean.axpy(kalman_gain_, prediction_error_);
+      } else {
+        kalman_gain_ = 0.0;
+        prediction_error_ = 0;
+      }
+      mutable_state_mean() = new_state_mean;
+
+      // variance = T * P * T', evaluated into the existing storage.
+      SpdMatrix &variance(mutable_state_variance());
+      Matrix &TP(scope.workspace().matrix(state_dim, state_dim));
+      matrix_product(SubMatrix(TP), ConstSubMatrix(transition),
+                     ConstSubMatrix(variance));
+      matrix_product_transpose(SubMatrix(variance), ConstSubMatrix(TP),
+                               ConstSubMatrix(transition));
+      if (!missing) {
+        variance.Matrix::add_outer(TPZ, kalman_gain_, -1);
+      }
+      variance += state_error_variance;
+      variance.fix_near_symmetry();
+      return loglike;
+    }
+
+    // The square root filter uses the "array" form of the Kalman filter.  If
+    // P = L * L^T, H is the observation variance, and RQR^T = V * V^T, then the
+    // pre-array
+    //
+    //   A = | sqrt(H)   Z^T * L   0 |
+    //       | 0         T * L     V |
+    //
+    // satisfies A * A^T = | F        Z^T P T^T |
+    //                     | T P Z    T P T^T + RQR^T |.
+    // An orthogonal transformation of the columns of A (here taken from the
+    // QR decomposition of A^T) produces a lower triangular post-array
+    //
+    //   B = | sqrt(F)              0 |
+    //       | T P Z / sqrt(F)      L_new |
+    //
+    // with B * B^T = A * A^T, so that F, the Kalman gain, and the factor of
+    // the updated state variance can be read off of B.  When y is missing the
+    // first row and column are omitted.
+    double Marginal::square_root_update(
+        double y, bool missing, int t, Matrix &state_variance_factor,
+        double observation_variance_scale_factor) {
+      const SparseVector observation_coefficients = model_->observation_matrix(t);
+      const SparseKalmanMatrix &state_transition_matrix(
+          *model_->state_transition_matrix(t));
+      const int state_dim = state_variance_factor.nrow();
+
+      Matrix transition_factor = state_transition_matrix * state_variance_factor;
+      Matrix error_factor = (*model_->state_error_expander(t)) *
+          variance_square_root(model_->state_error_variance(t)->dense());
+      const int error_dim = error_factor.ncol();
+
+      const double observation_variance = model_->observation_variance(t) *
+          observation_variance_scale_factor;
+      Vector ZL(state_dim);
+      for (int j = 0; j < state_dim; ++j) {
+        ZL[j] = observation_coefficients.dot(state_variance_factor.col(j));
+      }
+
+      // Fill the transpose of the pre-array, so that the QR decomposition gives
+      // the transpose of the post-array.
+      int offset = missing ? 0 : 1;
+      Matrix pre_array_transpose(offset + state_dim + error_dim,
+                                 offset + state_dim, 0.0);
+      if (!missing) {
+        pre_array_transpose(0, 0) = sqrt(observation_variance);
+        for (int j = 0; j < state_dim; ++j) {
+          pre_array_transpose(1 + j, 0) = ZL[j];
+        }
+      }
+      for (int i = 0; i < state_dim; ++i) {
+        for (int j = 0; j < state_dim; ++j) {
+          pre_array_transpose(offset + j, offset + i) = transition_factor(i, j);
+        }
+        for (int k = 0; k < error_dim; ++k) {
+          pre_array_transpose(offset + state_dim + k, offset + i) =
+              error_factor(i, k);
+        }
+      }
+      Matrix post_array_transpose =
+          QR(pre_array_transpose, true).getR();
+      // Choose signs so the diagonal of the post array is non-negative.
+      for (int i = 0; i < post_array_transpose.nrow(); ++i) {
+        if (post_array_transpose(i, i) < 0) {
+          post_array_transpose.row(i) *= -1;
+        }
+      }
+
+      double loglike = 0;
+      if (!missing) {
+        const double root_prediction_variance = post_array_transpose(0, 0);
+        prediction_variance_ = square(root_prediction_variance);
+        if (prediction_variance_ <= 0) {
+          report_error("Found a zero (or negative) forecast variance!");
+        }
+        kalman_gain_.resize(state_dim);
+        for (int i = 0; i < state_dim; ++i) {
+          kalman_gain_[i] =
+              post_array_transpose(0, 1 + i) / root_prediction_variance;
+        }
+        double mu = observation_coefficients.dot(state_mean());
+        prediction_error_ = y - mu;
+        loglike = dnorm(y, mu, root_prediction_variance, true);
+        set_state_mean(state_transition_matrix * state_mean()
+                       + kalman_gain_ * prediction_error_);
+      } else {
+        prediction_variance_ = ZL.normsq() + observation_variance;
+        kalman_gain_.resize(state_dim);
+        kalman_gain_ = 0.0;
+        prediction_error_ = 0;
+        set_state_mean(state_transition_matrix * state_mean());
+      }
+
+      const Matrix post_array = post_array_transpose.transpose();
+      state_variance_factor = ConstSubMatrix(
+          post_array, offset, offset + state_dim - 1,
+          offset, offset + state_dim - 1).to_matrix();
+      mutable_state_variance() = state_variance_factor.outer();
+      return loglike;
+    }
+
     const Marginal *Marginal::previous() const {
       if (time_index() < 1) {
         return nullptr;
@@ -123,16 +331,187 @@ namespace BOOM {
       return P - (P * Z).outer() / prediction_variance_;
     }
 
+    std::size_t Marginal::memory_footprint() const {
+      return MarginalDistributionBase::memory_footprint()
+          - sizeof(MarginalDistributionBase) + sizeof(*this)
+          + heap_bytes(kalman_gain_);
+    }
   }  // namespace Kalman
 
+  namespace {
+    // Returns true if P1 and P2 differ by less than tolerance, relative to the
+    // scale of P1.
+    bool variance_has_converged(const SpdMatrix &P1, const SpdMatrix &P2,
+                                double tolerance) {
+      const double *p1 = P1.data();
+      const double *p2 = P2.data();
+      double scale = 0;
+      double max_change = 0;
+      for (int i = 0; i < P1.size(); ++i) {
+        scale = std::max(scale, fabs(p1[i]));
+        max_change = std::max(max_change, fabs(p1[i] - p2[i]));
+      }
+      return max_change <= tolerance * (1 + scale);
+    }
+
+    //---------------------------------------------------------------------
+    // An element of the associative scan used by the parallel filter.  In
+    // the notation of Sarkka and Garcia-Fernandez (2021), the filtered state
+    // at the end of a stretch of time, given the filtered state x at the
+    // start, is N(A x + b, C), and the likelihood of the stretch's data as a
+    // function of x is proportional to exp(eta' x - x' J x / 2).
+    struct FilterElement {
+      Matrix A;
+      Vector b;
+      SpdMatrix C;
+      Vector eta;
+      SpdMatrix J;
+    };
+
+    // The element for time t > 0, with transition T, state error variance
+    // RQR, observation vector Z, and observation variance H.
+    void fill_element(FilterElement &element, double y, bool missing,
+                      const SparseVector &Z, double H, const Matrix &T,
+                      const SpdMatrix &RQR) {
+      const int dim = T.nrow();
+      element.A = T;
+      element.b.resize(dim);
+      element.b = 0.0;
+      element.C = RQR;
+      element.eta.resize(dim);
+      element.eta = 0.0;
+      element.J.resize(dim);
+      element.J = 0.0;
+      if (missing) return;
+
+      Vector QZ = RQR * Z;
+      double S = Z.dot(QZ) + H;
+      if (S <= 0) {
+        report_error("Found a zero (or negative) forecast variance!");
+      }
+      Vector TZ(dim);
+      for (int j = 0; j < dim; ++j) {
+        TZ[j] = Z.dot(T.col(j));
+      }
+      // A = (I - K Z') T, with K = QZ / S.
+      element.A.add_outer(QZ, TZ, -1.0 / S);
+      element.b.axpy(QZ, y / S);
+      element.C.add_outer(QZ, -1.0 / S);
+      element.eta.axpy(TZ, y / S);
+      element.J.add_outer(TZ, 1.0 / S);
+    }
+
+    // The element for time 0 is the filtered state given the first
+    // observation.  It does not depend on an earlier state, so A is zero.
+    void fill_initial_element(FilterElement &element, double y, bool missing,
+                              const SparseVector &Z, double H,
+                              const Vector &a0, const SpdMatrix &P0) {
+      const int dim = a0.size();
+      element.A.resize(dim, dim);
+      element.A = 0.0;
+      element.b = a0;
+      element.C = P0;
+      element.eta.resize(dim);
+      element.eta = 0.0;
+      element.J.resize(dim);
+      element.J = 0.0;
+      if (missing) return;
+
+      Vector PZ = P0 * Z;
+      double S = Z.dot(PZ) + H;
+      if (S <= 0) {
+        report_error("Found a zero (or negative) forecast variance!");
+      }
+      element.b.axpy(PZ, (y - Z.dot(a0)) / S);
+      element.C.add_outer(PZ, -1.0 / S);
+    }
+
+    // Replace 'earlier' with the combination of 'earlier' followed by
+    // 'later'.
+    void combine_elements(FilterElement &earlier, const FilterElement &later) {
+      Matrix X = earlier.C * later.J;
+      X.diag() += 1.0;
+      // Xinv = (I + C_i J_j)^{-1}.  Because C and J are symmetric, the
+      // transpose of Xinv is (I + J_j C_i)^{-1}.
+      Matrix Xinv = X.inv();
+      Matrix M = later.A * Xinv;
+
+      Vector b = earlier.b + earlier.C * later.eta;
+      b = M * b;
+      b += later.b;
+
+      SpdMatrix C = M * earlier.C * later.A.transpose();
+      C += later.C;
+      C.fix_near_symmetry();
+
+      Matrix AtXinvt = earlier.A.Tmult(Xinv.transpose());
+      Vector eta = AtXinvt * (later.eta - later.J * earlier.b);
+      eta += earlier.eta;
+
+      SpdMatrix J = AtXinvt * later.J * earlier.A;
+      J += earlier.J;
+      J.fix_near_symmetry();
+
+      earlier.A = M * earlier.A;
+      earlier.b.swap(b);
+      earlier.C.swap(C);
+      earlier.eta.swap(eta);
+      earlier.J.swap(J);
+    }
+  }  // namespace
+
   ScalarKalmanFilter::ScalarKalmanFilter(ScalarStateSpaceModelBase *model)
-      : model_(model)
+      : model_(model),
+        steady_state_tolerance_(1e-8),
+        number_of_steady_state_updates_(0),
+        square_root_filtering_(false),
+        state_variance_factor_time_(-1),
+        keep_state_variances_(true),
+        time_block_size_(1024)
   {}
 
+  void ScalarKalmanFilter::initialize_from_previous_node(int t) {
+    nodes_[t].set_state_mean(nodes_[t - 1].state_mean());
+    if (keep_state_variances_) {
+      nodes_[t].set_state_variance(nodes_[t - 1].state_variance());
+    } else {
+      nodes_[t].take_state_variance(nodes_[t - 1]);
+    }
+  }
+
+  double ScalarKalmanFilter::update_node(double y, int t, bool missing) {
+    if (!square_root_filtering_) {
+      return nodes_[t].update(y, missing, t);
+    }
+    if (t == 0 || state_variance_factor_time_ != t - 1) {
+      state_variance_factor_ = variance_square_root(
+          nodes_[t].state_variance());
+    }
+    double ans = nodes_[t].square_root_update(
+        y, missing, t, state_variance_factor_);
+    state_variance_factor_time_ = t;
+    return ans;
+  }
+
+  std::size_t ScalarKalmanFilter::memory_footprint() const {
+    return KalmanFilterBase::memory_footprint() - sizeof(KalmanFilterBase)
+        + sizeof(*this)
+        + (nodes_.capacity() - nodes_.size())
+            * sizeof(Kalman::ScalarMarginalDistribution)
+        + state_variance_factor_.size() * sizeof(double)
+        + previous_state_variance_.size() * sizeof(double);
+  }
+
   void ScalarKalmanFilter::update() {
     if (!model_) {
       report_error("Model must be set before calling update().");
     }
+    ScopedPhaseTimer timer(McmcProfiler::kKalmanFilter);
+    if (use_parallel_update()) {
+      parallel_update();
+      return;
+    }
+    nodes_.reserve(model_->time_dimension() + 1);
     while (nodes_.size() <= model_->time_dimension()) {
       nodes_.push_back(Kalman::ScalarMarginalDistribution(
           model_, this, nodes_.size()));
@@ -143,15 +522,60 @@ namespace BOOM {
       nodes_[0].set_state_variance(model_->initial_state_variance());
     }
 
-    for (int t = 0; t < model_->time_dimension(); ++t) {
+    // Steady state bookkeeping.  'converged' indicates that the state
+    // variance and Kalman gain have stopped changing, given that the
+    // observation variance remains equal to steady_observation_variance.
+    const bool time_invariant = steady_state_tolerance_ >= 0
+        && model_->state_is_time_invariant();
+    bool converged = false;
+    bool previous_was_observed = false;
+    double steady_observation_variance = negative_infinity();
+    number_of_steady_state_updates_ = 0;
+
+    const int n = model_->time_dimension();
+    for (int t = 0; t < n; ++t) {
       if (t > 0) {
-        nodes_[t].set_state_mean(nodes_[t-1].state_mean());
-        nodes_[t].set_state_variance(nodes_[t-1].state_variance());
+        initialize_from_previous_node(t);
+      }
+      const bool missing = model_->is_missing_observation(t);
+      double observation_variance = 0;
+      bool same_observation_variance = false;
+      if (time_invariant && !missing) {
+        observation_variance = model_->observation_variance(t);
+        same_observation_variance =
+            observation_variance == steady_observation_variance;
+      }
+      const bool check_convergence = time_invariant && !missing && !converged
+          && previous_was_observed && same_observation_variance;
+      if (check_convergence && !keep_state_variances_) {
+        previous_state_variance_ = nodes_[t].state_variance();
+      }
+
+      if (converged && same_observation_variance && t + 1 < n) {
+        const Kalman::ScalarMarginalDistribution &previous(nodes_[t - 1]);
+        increment_log_likelihood(nodes_[t].steady_state_update(
+            model_->adjusted_observation(t), t,
+            previous.prediction_variance(), previous.kalman_gain()));
+        ++number_of_steady_state_updates_;
+        // The state variance is unchanged, so its factor remains valid.
+        state_variance_factor_time_ = t;
+      } else {
+        increment_log_likelihood(update_node(
+            model_->adjusted_observation(t), t, missing));
+        if (check_convergence) {
+          converged = variance_has_converged(
+              nodes_[t].state_variance(),
+              keep_state_variances_ ? nodes_[t - 1].state_variance()
+                                    : previous_state_variance_,
+              steady_state_tolerance_);
+        } else {
+          converged = false;
+        }
+        if (time_invariant && !missing) {
+          steady_observation_variance = observation_variance;
+        }
+        previous_was_observed = !missing;
       }
-      increment_log_likelihood(nodes_[t].update(
-          model_->adjusted_observation(t),
-          model_->is_missing_observation(t),
-          t));
       if (!std::isfinite(log_likelihood())) {
         set_status(NOT_CURRENT);
         return;
@@ -160,6 +584,119 @@ namespace BOOM {
     set_status(CURRENT);
   }
 
+  bool ScalarKalmanFilter::use_parallel_update() const {
+    return !pool_.no_threads()
+        && !square_root_filtering_
+        && model_->time_dimension() >= 2 * time_block_size_
+        && model_->state_is_time_invariant();
+  }
+
+  // The state model matrices are read once, in the calling thread, because
+  // the model's matrix accessors fill shared caches.  The transition and
+  // state error variance are time invariant, so dense copies at t = 0 serve
+  // for all t.
+  void ScalarKalmanFilter::parallel_update() {
+    const int n = model_->time_dimension();
+    nodes_.reserve(n + 1);
+    while (nodes_.size() <= n) {
+      nodes_.push_back(Kalman::ScalarMarginalDistribution(
+          model_, this, nodes_.size()));
+    }
+    clear_loglikelihood();
+    number_of_steady_state_updates_ = 0;
+    state_variance_factor_time_ = -1;
+
+    const Matrix transition = model_->state_transition_matrix(0)->dense();
+    const SpdMatrix state_error_variance(
+        model_->state_variance_matrix(0)->dense());
+    const Vector initial_mean = model_->initial_state_mean();
+    const SpdMatrix initial_variance = model_->initial_state_variance();
+    Vector y(n);
+    std::vector<bool> missing(n);
+    Vector observation_variance(n);
+    std::vector<SparseVector> observation_coefficients;
+    observation_coefficients.reserve(n);
+    for (int t = 0; t < n; ++t) {
+      missing[t] = model_->is_missing_observation(t);
+      y[t] = missing[t] ? 0.0 : model_->adjusted_observation(t);
+      observation_variance[t] = model_->observation_variance(t);
+      observation_coefficients.push_back(model_->observation_matrix(t));
+    }
+
+    const int block_size = time_block_size_;
+    const int number_of_blocks = (n + block_size - 1) / block_size;
+    auto block_begin = [block_size](int block) { return block * block_size; };
+    auto block_end = [block_size, n](int block) {
+      return std::min<int>(n, (block + 1) * block_size);
+    };
+
+    // Summarize each block but the last.
+    std::vector<FilterElement> summaries(number_of_blocks - 1);
+    pool_.parallel_for(0, number_of_blocks - 1, 1, [&](int block) {
+      FilterElement &summary(summaries[block]);
+      FilterElement element;
+      int t = block_begin(block);
+      if (t == 0) {
+        fill_initial_element(summary, y[0], missing[0],
+                             observation_coefficients[0],
+                             observation_variance[0],
+                             initial_mean, initial_variance);
+      } else {
+        fill_element(summary, y[t], missing[t], observation_coefficients[t],
+                     observation_variance[t], transition,
+                     state_error_variance);
+      }
+      for (++t; t < block_end(block); ++t) {
+        fill_element(element, y[t], missing[t], observation_coefficients[t],
+                     observation_variance[t], transition,
+                     state_error_variance);
+        combine_elements(summary, element);
+      }
+    });
+
+    // After this loop, summaries[b] holds the filtered distribution of the
+    // state at the last time point in block b.  Block 0's summary has A = 0,
+    // so each running product is free of the (unknown) initial state.
+    for (int block = 1; block < number_of_blocks - 1; ++block) {
+      FilterElement running = summaries[block - 1];
+      combine_elements(running, summaries[block]);
+      summaries[block] = std::move(running);
+    }
+
+    // Rerun the filter within each block from its predicted starting state.
+    Vector block_loglike(number_of_blocks, 0.0);
+    pool_.parallel_for(0, number_of_blocks, 1, [&](int block) {
+      const int begin = block_begin(block);
+      if (block == 0) {
+        nodes_[0].set_state_mean(initial_mean);
+        nodes_[0].set_state_variance(initial_variance);
+      } else {
+        const FilterElement &filtered(summaries[block - 1]);
+        nodes_[begin].set_state_mean(transition * filtered.b);
+        SpdMatrix variance = sandwich(transition, filtered.C);
+        variance += state_error_variance;
+        variance.fix_near_symmetry();
+        nodes_[begin].set_state_variance(variance);
+      }
+      double loglike = 0;
+      for (int t = begin; t < block_end(block); ++t) {
+        if (t > begin) {
+          initialize_from_previous_node(t);
+        }
+        loglike += nodes_[t].update(y[t], missing[t],
+                                    observation_coefficients[t],
+                                    observation_variance[t], transition,
+                                    state_error_variance);
+      }
+      block_loglike[block] = loglike;
+    });
+
+    for (int block = 0; block < number_of_blocks; ++block) {
+      increment_log_likelihood(block_loglike[block]);
+    }
+    set_status(std::isfinite(log_likelihood()) ? CURRENT : NOT_CURRENT);
+  }
+
   // Disturbance smoother replaces Durbin and Koopman's K[t] with r[t].  The
   // disturbance smoother is equation (5) in Durbin and Koopman (2002).
   //
@@ -169,6 +706,7 @@ namespace BOOM {
     if (!model_) {
       report_error("Model must be set before calling fast_disturbance_smooth().");
     }
+    ScopedPhaseTimer timer(McmcProfiler::kKalmanSmoother);
 
     int n = model_->time_dimension();
     Vector r(model_->state_dimension(), 0.0);
@@ -190,7 +728,7 @@ namespace BOOM {
       Vector rt_1 = model_->state_transition_matrix(t)->Tmult(r);
       model_->observation_matrix(t).add_this_to(rt_1, coefficient);
       nodes_[t].set_scaled_state_error(r);
-      r = rt_1;
+      r.swap(rt_1);
     }
     set_initial_scaled_state_error(r);
   }
@@ -208,10 +746,9 @@ namespace BOOM {
       nodes_[t].set_state_mean(model_->initial_state_mean());
       nodes_[t].set_state_variance(model_->initial_state_variance());
     } else {
-      nodes_[t].set_state_mean(nodes_[t-1].state_mean());
-      nodes_[t].set_state_variance(nodes_[t-1].state_variance());
+      initialize_from_previous_node(t);
     }
-    increment_log_likelihood(nodes_[t].update(y, missing, t));
+    increment_log_likelihood(update_node(y, t, missing));
   }
 
   double ScalarKalmanFilter::prediction_error(int t, bool standardize) const {
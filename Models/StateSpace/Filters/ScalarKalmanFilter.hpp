@@ -20,7 +20,10 @@
 */
 
 #include "Models/StateSpace/Filters/KalmanFilterBase.hpp"
+#include "Models/StateSpace/Filters/SparseVector.hpp"
+#include "LinAlg/Matrix.hpp"
 #include "LinAlg/Vector.hpp"
+#include "cpputil/ThreadTools.hpp"
 
 namespace BOOM {
   class ScalarStateSpaceModelBase;
@@ -57,6 +60,62 @@ namespace BOOM {
                     int t,
                     double observation_variance_scale_factor = 1.0);
 
+      // Update this marginal distribution using a converged ("steady state")
+      // prediction variance and Kalman gain.  The state variance must already
+      // be set to the steady state value, which the update leaves unchanged.
+      // Only the state mean and prediction error are computed, which avoids
+      // the O(state_dimension^3) covariance recursion.
+      //
+      // Args:
+      //   y:  The observed data point, which must not be missing.
+      //   t:  The time index associated with this marginal distribution.
+      //   prediction_variance:  The steady state value of F.
+      //   kalman_gain:  The steady state value of K.
+      //
+      // Returns:
+      //   The log likelihood contribution of y.
+      double steady_state_update(double y, int t, double prediction_variance,
+                                 const Vector &kalman_gain);
+
+      // A version of update() that takes the model matrices as arguments
+      // instead of asking the model for them, so that nodes in different
+      // stretches of time can be updated from different threads.
+      //
+      // Args:
+      //   y, missing:  As in update().
+      //   observation_coefficients:  The observation vector Z[t].
+      //   observation_variance:  The observation variance H[t].
+      //   transition:  A dense copy of the state transition matrix T[t].
+      //   state_error_variance: A dense copy of the state error variance
+      //     R[t] * Q[t] * R[t]^T.
+      //
+      // Returns:
+      //   The log likelihood contribution of y.
+      double update(double y, bool missing,
+                    const SparseVector &observation_coefficients,
+                    double observation_variance,
+                    const Matrix &transition,
+                    const SpdMatrix &state_error_variance);
+
+      // An alternative to update() that propagates a square root of the state
+      // variance instead of the variance itself.  The result is the same as
+      // update() in exact arithmetic, but the state variance is guaranteed to
+      // remain symmetric and non-negative definite.
+      //
+      // Args:
+      //   y, missing, t, observation_variance_scale_factor:  As in update().
+      //   state_variance_factor: On input, a matrix L with L * L^T equal to
+      //     the state_variance() held by this marginal distribution.  On
+      //     output, a lower triangular factor of the updated state variance.
+      //
+      // Returns:
+      //   The log likelihood contribution of y.
+      double square_root_update(double y,
+                                bool missing,
+                                int t,
+                                Matrix &state_variance_factor,
+                                double observation_variance_scale_factor = 1.0);
+
       // After the call to update(), state_mean() and state_variance() refer to
       // the predictive mean and variance of the state at time_dimension() + 1
       // given data to time_dimension().
@@ -78,6 +137,8 @@ namespace BOOM {
       const Vector &kalman_gain() const {return kalman_gain_;}
       void set_kalman_gain(const Vector &gain) {kalman_gain_ = gain;}
 
+      std::size_t memory_footprint() const override;
+
       // Return the previous node if time_dimension > 1, else nullptr.
       ScalarMarginalDistribution *previous();
       const ScalarMarginalDistribution *previous() const;
@@ -106,6 +167,74 @@ namespace BOOM {
 
     void fast_disturbance_smooth() override;
 
+    // If all of the model's state components are time invariant, then the
+    // state variance converges after a modest number of observations.  Once
+    // the largest change in the state variance between consecutive time points
+    // is smaller than tolerance * (1 + max_abs(P)), update() stops running
+    // the covariance recursion and reuses the converged prediction variance
+    // and Kalman gain.  The full recursion is used again at missing
+    // observations, when the observation variance changes, and at the final
+    // time point.  A negative tolerance disables the steady state shortcut.
+    void set_steady_state_tolerance(double tolerance) {
+      steady_state_tolerance_ = tolerance;
+    }
+    double steady_state_tolerance() const { return steady_state_tolerance_; }
+
+    // The number of time points handled by the steady state shortcut during
+    // the most recent call to update().
+    int number_of_steady_state_updates() const {
+      return number_of_steady_state_updates_;
+    }
+
+    // If square root filtering is turned on, the filter propagates a Cholesky
+    // factor of the state variance through an orthogonal (QR) transformation
+    // of the usual update equations, rather than updating the variance
+    // directly.  This costs somewhat more per time point, but is numerically
+    // stable for long series and large state dimensions, where the ordinary
+    // recursion can lose symmetry or positive definiteness.  It is off by
+    // default.
+    void set_square_root_filtering(bool square_root) {
+      square_root_filtering_ = square_root;
+      state_variance_factor_time_ = -1;
+    }
+    bool square_root_filtering() const { return square_root_filtering_; }
+
+    // By default each node keeps the state variance P[t] produced by the
+    // filter, which takes O(T * state_dimension^2) memory.  The disturbance
+    // smoother used for posterior simulation (fast_disturbance_smooth) only
+    // needs the prediction errors, prediction variances, and Kalman gains,
+    // so when the variances are not kept each node hands its variance on to
+    // the next, and only the final node retains one.  Memory for the filter
+    // is then O(T * state_dimension).  Operations that need the state
+    // variance at every time point (e.g. Estep(true), or the posterior
+    // variance of the state) are unavailable in that case.
+    void set_keep_state_variances(bool keep) { keep_state_variances_ = keep; }
+    bool keep_state_variances() const { return keep_state_variances_; }
+
+    // If the filter is given threads, and the model's state is time
+    // invariant, then update() splits long series into blocks of
+    // time_block_size() time points and runs the filter in parallel over
+    // time.  Each observation contributes an element of an associative
+    // operator whose product over a block summarizes the block's effect on
+    // the filtered state (Sarkka and Garcia-Fernandez, 2021).  The block
+    // summaries are computed in parallel, combined in a short serial pass,
+    // and the filter is then rerun inside each block from the correct
+    // starting state, again in parallel.  The nodes hold the same quantities
+    // as in the serial filter.  Block boundaries do not depend on the number
+    // of threads, so neither do the results.
+    //
+    // The parallel filter does about three times the arithmetic of the serial
+    // filter, and does not use the steady state shortcut, so it pays off only
+    // for long series with several threads.  Square root filtering, time
+    // varying state, and series shorter than two blocks use the serial
+    // filter.
+    void set_number_of_threads(int n) { pool_.set_number_of_threads(n); }
+    int number_of_threads() const { return pool_.number_of_threads(); }
+    void set_time_block_size(int block_size) {
+      time_block_size_ = std::max<int>(block_size, 1);
+    }
+    int time_block_size() const { return time_block_size_; }
+
     // Return the one-step prediction error held by the filter at time t.  If
     // 'standardize' is true then divide the prediction error by the square
     // root of the prediction variance.
@@ -122,10 +251,41 @@ namespace BOOM {
 
     const Kalman::ScalarMarginalDistribution &back() const;
     int size() const override {return nodes_.size();}
+    std::size_t memory_footprint() const override;
 
    private:
+    // Update nodes_[t] using whichever recursion has been requested.
+    double update_node(double y, int t, bool missing);
+
+    // Start nodes_[t] from the state mean and variance in nodes_[t - 1].
+    void initialize_from_previous_node(int t);
+
+    // Returns true if update() should use parallel_update().
+    bool use_parallel_update() const;
+
+    // The time-parallel version of update().  See set_number_of_threads.
+    void parallel_update();
+
     ScalarStateSpaceModelBase *model_;
     std::vector<Kalman::ScalarMarginalDistribution> nodes_;
+    double steady_state_tolerance_;
+    int number_of_steady_state_updates_;
+
+    // Used in square root filtering.  A square root of the state variance
+    // held by nodes_[state_variance_factor_time_].  A negative time index
+    // means the factor is not current.
+    bool square_root_filtering_;
+    Matrix state_variance_factor_;
+    int state_variance_factor_time_;
+
+    // If keep_state_variances_ is false then previous_state_variance_ holds
+    // the state variance from the preceding node for the steady state check.
+    bool keep_state_variances_;
+    SpdMatrix previous_state_variance_;
+
+    // Used by parallel_update().
+    SharedThreadPool pool_;
+    int time_block_size_;
   };
 
 }  // namespace BOOM
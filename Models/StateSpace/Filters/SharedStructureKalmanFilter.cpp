@@ -0,0 +1,131 @@
+// Copyright 2018 Google LLC. All Rights Reserved.
+/*
+  Copyright (C) 2005-2024 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+
+#include "Models/StateSpace/Filters/SharedStructureKalmanFilter.hpp"
+
+#include <cmath>
+#include <map>
+
+#include "Models/StateSpace/Filters/SparseKalmanTools.hpp"
+#include "Models/StateSpace/StateSpaceModelBase.hpp"
+#include "cpputil/report_error.hpp"
+#include "distributions.hpp"
+
+namespace BOOM {
+
+  namespace {
+    using SSKF = SharedStructureKalmanFilter;
+  }  // namespace
+
+  SSKF::SharedStructureKalmanFilter(const ScalarStateSpaceModelBase *model)
+      : model_(model) {
+    if (!model_) {
+      report_error("SharedStructureKalmanFilter needs a non-null model.");
+    }
+  }
+
+  void SSKF::filter(const Matrix &series) {
+    int time_dimension = series.nrow();
+    int number_of_series = series.ncol();
+    log_likelihood_.resize(number_of_series);
+    log_likelihood_ = 0.0;
+    prediction_errors_.resize(time_dimension, number_of_series);
+    prediction_variances_.resize(time_dimension, number_of_series);
+    final_state_means_.resize(model_->state_dimension(), number_of_series);
+    final_state_variances_.clear();
+    pattern_index_.assign(number_of_series, -1);
+
+    std::map<std::vector<bool>, std::vector<int>> patterns;
+    std::vector<bool> missing(time_dimension);
+    for (int s = 0; s < number_of_series; ++s) {
+      for (int t = 0; t < time_dimension; ++t) {
+        missing[t] = std::isnan(series(t, s));
+      }
+      patterns[missing].push_back(s);
+    }
+
+    for (const auto &pattern : patterns) {
+      for (int s : pattern.second) {
+        pattern_index_[s] = final_state_variances_.size();
+      }
+      final_state_variances_.push_back(
+          filter_pattern(series, pattern.second, pattern.first));
+    }
+  }
+
+  SpdMatrix SSKF::filter_pattern(const Matrix &series,
+                                 const std::vector<int> &columns,
+                                 const std::vector<bool> &missing) {
+    int number_of_series = columns.size();
+    Matrix state_means(model_->state_dimension(), number_of_series);
+    Vector initial_state_mean = model_->initial_state_mean();
+    for (int i = 0; i < number_of_series; ++i) {
+      state_means.col(i) = initial_state_mean;
+    }
+    SpdMatrix P = model_->initial_state_variance();
+
+    // The covariance recursion is run through the scalar filter with a
+    // placeholder mean.  The gain it produces is then applied to every
+    // series in the group.
+    Vector placeholder_mean(model_->state_dimension());
+    Vector kalman_gain;
+    double forecast_variance = 0;
+    double placeholder_error = 0;
+    Vector prediction_errors(number_of_series);
+    for (int t = 0; t < series.nrow(); ++t) {
+      SparseVector Z = model_->observation_matrix(t);
+      const SparseKalmanMatrix &transition(
+          *model_->state_transition_matrix(t));
+      for (int i = 0; i < number_of_series; ++i) {
+        prediction_errors[i] = missing[t]
+            ? 0.0
+            : series(t, columns[i]) - Z.dot(state_means.col(i));
+      }
+
+      placeholder_mean = 0.0;
+      sparse_scalar_kalman_update(
+          0.0, placeholder_mean, P, kalman_gain, forecast_variance,
+          placeholder_error, missing[t], Z, model_->observation_variance(t),
+          transition, *model_->state_variance_matrix(t));
+
+      double forecast_sd = sqrt(forecast_variance);
+      for (int i = 0; i < number_of_series; ++i) {
+        int s = columns[i];
+        prediction_errors_(t, s) = prediction_errors[i];
+        prediction_variances_(t, s) = forecast_variance;
+        if (!missing[t]) {
+          log_likelihood_[s] +=
+              dnorm(prediction_errors[i], 0, forecast_sd, true);
+        }
+      }
+
+      state_means = transition * state_means;
+      if (!missing[t]) {
+        state_means.add_outer(kalman_gain, prediction_errors);
+      }
+    }
+
+    for (int i = 0; i < number_of_series; ++i) {
+      final_state_means_.col(columns[i]) = state_means.col(i);
+    }
+    return P;
+  }
+
+}  // namespace BOOM
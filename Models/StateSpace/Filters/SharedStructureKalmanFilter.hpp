@@ -0,0 +1,115 @@
+#ifndef BOOM_STATE_SPACE_SHARED_STRUCTURE_KALMAN_FILTER_HPP_
+#define BOOM_STATE_SPACE_SHARED_STRUCTURE_KALMAN_FILTER_HPP_
+// Copyright 2018 Google LLC. All Rights Reserved.
+/*
+  Copyright (C) 2005-2024 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+
+#include <vector>
+
+#include "LinAlg/Matrix.hpp"
+#include "LinAlg/SpdMatrix.hpp"
+#include "LinAlg/Vector.hpp"
+
+namespace BOOM {
+  class ScalarStateSpaceModelBase;
+
+  // Runs the Kalman filter on many time series that share the same state
+  // space model, structure and parameters alike, as in a panel of per-store
+  // models with common local level and seasonal components.
+  //
+  // The state variance P[t], the Kalman gain K[t] and the forecast variance
+  // F[t] do not depend on the observed values, only on which values are
+  // missing.  Series are therefore grouped by missing-data pattern, the
+  // covariance recursion is run once per group using
+  // sparse_scalar_kalman_update, and the state means for all the series in
+  // the group are updated together as the columns of a matrix.  When every
+  // series is fully observed, the cost of the covariance recursion is paid
+  // once no matter how many series there are.
+  //
+  // Usage:
+  //   SharedStructureKalmanFilter filter(model.get());
+  //   filter.filter(series);   // One series per column.
+  //   Vector loglike = filter.log_likelihood();
+  class SharedStructureKalmanFilter {
+   public:
+    // Args:
+    //   model: Supplies the state space structure:  observation_matrix(t),
+    //     observation_variance(t), state_transition_matrix(t),
+    //     state_variance_matrix(t), and the initial state distribution.  Any
+    //     data assigned to the model are ignored, except insofar as they
+    //     affect observation_variance(t).  The model is not owned, and must
+    //     outlive calls to filter().
+    explicit SharedStructureKalmanFilter(const ScalarStateSpaceModelBase *model);
+
+    // Run the filter.
+    //
+    // Args:
+    //   series: A matrix with one row per time point and one column per
+    //     series.  Missing values are coded as NaN.
+    void filter(const Matrix &series);
+
+    // The number of distinct missing-data patterns among the series passed
+    // to the most recent call to filter(), which is the number of times the
+    // covariance recursion was run.
+    int number_of_patterns() const { return final_state_variances_.size(); }
+
+    // The log likelihood of each series.
+    const Vector &log_likelihood() const { return log_likelihood_; }
+
+    // One-step prediction errors v[t] = y[t] - E(y[t] | Y[t-1]), with one row
+    // per time point and one column per series.  Missing observations have
+    // prediction error zero.
+    const Matrix &prediction_errors() const { return prediction_errors_; }
+
+    // The variance F[t] of each one-step prediction error, laid out like
+    // prediction_errors().
+    const Matrix &prediction_variances() const {
+      return prediction_variances_;
+    }
+
+    // The mean of the state one period past the end of the data, given all
+    // the data, with one column per series.
+    const Matrix &final_state_means() const { return final_state_means_; }
+
+    // The variance of the state one period past the end of the data for the
+    // given series.  Series with the same missing-data pattern share a
+    // variance.
+    const SpdMatrix &final_state_variance(int series) const {
+      return final_state_variances_[pattern_index_[series]];
+    }
+
+   private:
+    // Filter the columns of 'series' listed in 'columns', all of which have
+    // the missing-data pattern 'missing'.  Returns the final state variance.
+    SpdMatrix filter_pattern(const Matrix &series,
+                             const std::vector<int> &columns,
+                             const std::vector<bool> &missing);
+
+    const ScalarStateSpaceModelBase *model_;
+    Vector log_likelihood_;
+    Matrix prediction_errors_;
+    Matrix prediction_variances_;
+    Matrix final_state_means_;
+    std::vector<SpdMatrix> final_state_variances_;
+    std::vector<int> pattern_index_;
+  };
+
+}  // namespace BOOM
+
+#endif  // BOOM_STATE_SPACE_SHARED_STRUCTURE_KALMAN_FILTER_HPP_
@@ -975,6 +975,20 @@ namespace BOOM {
     v[0] += v[1];
   }
 
+  void LocalLinearTrendMatrix::matrix_multiply_inplace(SubMatrix m) const {
+    conforms_to_cols(m.nrow());
+    for (int j = 0; j < m.ncol(); ++j) {
+      m(0, j) += m(1, j);
+    }
+  }
+
+  // m * this->transpose() adds the second column of m to the first.
+  void LocalLinearTrendMatrix::matrix_transpose_premultiply_inplace(
+      SubMatrix m) const {
+    conforms_to_cols(m.ncol());
+    m.col(0) += m.col(1);
+  }
+
   SpdMatrix LocalLinearTrendMatrix::inner() const {
     // 1 0 * 1 1  = 1 1
     // 1 1   0 1    1 2
@@ -1008,6 +1022,111 @@ namespace BOOM {
     return ans;
   }
 
+  //======================================================================
+  RotationMatrix::RotationMatrix(double angle)
+      : cosine_(cos(angle)), sine_(sin(angle)) {}
+
+  RotationMatrix *RotationMatrix::clone() const {
+    return new RotationMatrix(*this);
+  }
+
+  void RotationMatrix::multiply(VectorView lhs,
+                                const ConstVectorView &rhs) const {
+    conforms_to_rows(lhs.size());
+    conforms_to_cols(rhs.size());
+    lhs[0] = cosine_ * rhs[0] + sine_ * rhs[1];
+    lhs[1] = cosine_ * rhs[1] - sine_ * rhs[0];
+  }
+
+  void RotationMatrix::multiply_and_add(VectorView lhs,
+                                        const ConstVectorView &rhs) const {
+    conforms_to_rows(lhs.size());
+    conforms_to_cols(rhs.size());
+    lhs[0] += cosine_ * rhs[0] + sine_ * rhs[1];
+    lhs[1] += cosine_ * rhs[1] - sine_ * rhs[0];
+  }
+
+  void RotationMatrix::Tmult(VectorView lhs,
+                             const ConstVectorView &rhs) const {
+    conforms_to_cols(lhs.size());
+    conforms_to_rows(rhs.size());
+    lhs[0] = cosine_ * rhs[0] - sine_ * rhs[1];
+    lhs[1] = cosine_ * rhs[1] + sine_ * rhs[0];
+  }
+
+  void RotationMatrix::multiply_inplace(VectorView v) const {
+    conforms_to_cols(v.size());
+    double first = v[0];
+    v[0] = cosine_ * first + sine_ * v[1];
+    v[1] = cosine_ * v[1] - sine_ * first;
+  }
+
+  void RotationMatrix::matrix_multiply_inplace(SubMatrix m) const {
+    conforms_to_cols(m.nrow());
+    for (int j = 0; j < m.ncol(); ++j) {
+      double first = m(0, j);
+      double second = m(1, j);
+      m(0, j) = cosine_ * first + sine_ * second;
+      m(1, j) = cosine_ * second - sine_ * first;
+    }
+  }
+
+  // m * this->transpose() replaces the columns (a, b) of m with
+  // (cos * a + sin * b, cos * b - sin * a).
+  void RotationMatrix::matrix_transpose_premultiply_inplace(
+      SubMatrix m) const {
+    conforms_to_cols(m.ncol());
+    VectorView first(m.col(0));
+    VectorView second(m.col(1));
+    for (int i = 0; i < m.nrow(); ++i) {
+      double a = first[i];
+      double b = second[i];
+      first[i] = cosine_ * a + sine_ * b;
+      second[i] = cosine_ * b - sine_ * a;
+    }
+  }
+
+  SpdMatrix RotationMatrix::inner() const {
+    return SpdMatrix(2, 1.0);
+  }
+
+  SpdMatrix RotationMatrix::inner(const ConstVectorView &weights) const {
+    //  c -s * w1 0  *  c s  =  c^2 w1 + s^2 w2   cs (w1 - w2)
+    //  s  c   0  w2   -s c     cs (w1 - w2)      s^2 w1 + c^2 w2
+    if (weights.size() != 2) {
+      report_error("Wrong size weight vector");
+    }
+    double cc = cosine_ * cosine_;
+    double ss = sine_ * sine_;
+    SpdMatrix ans(2);
+    ans(0, 0) = cc * weights[0] + ss * weights[1];
+    ans(1, 1) = ss * weights[0] + cc * weights[1];
+    ans(0, 1) = ans(1, 0) = cosine_ * sine_ * (weights[0] - weights[1]);
+    return ans;
+  }
+
+  void RotationMatrix::add_to_block(SubMatrix block) const {
+    check_can_add(block);
+    block(0, 0) += cosine_;
+    block(0, 1) += sine_;
+    block(1, 0) -= sine_;
+    block(1, 1) += cosine_;
+  }
+
+  Matrix RotationMatrix::dense() const {
+    Matrix ans(2, 2);
+    ans(0, 0) = ans(1, 1) = cosine_;
+    ans(0, 1) = sine_;
+    ans(1, 0) = -sine_;
+    return ans;
+  }
+
+  Vector RotationMatrix::left_inverse(const ConstVectorView &x) const {
+    Vector ans(2);
+    Tmult(VectorView(ans), x);
+    return ans;
+  }
+
   //======================================================================
   namespace {
     typedef DiagonalMatrixParamView DMPV;
@@ -1183,6 +1302,27 @@ namespace BOOM {
     *now = total;
   }
 
+  void SSSM::matrix_multiply_inplace(SubMatrix m) const {
+    conforms_to_rows(m.nrow());
+    for (int j = 0; j < m.ncol(); ++j) {
+      SSSM::multiply_inplace(m.col(j));
+    }
+  }
+
+  // The columns of m * this->transpose() are the columns of m shifted one
+  // place to the right, with minus the sum of the columns in front.
+  void SSSM::matrix_transpose_premultiply_inplace(SubMatrix m) const {
+    conforms_to_cols(m.ncol());
+    int n = m.ncol();
+    Vector total = m.col(n - 1);
+    total *= -1;
+    for (int k = n - 1; k > 0; --k) {
+      total -= m.col(k - 1);
+      m.col(k) = m.col(k - 1);
+    }
+    m.col(0) = total;
+  }
+
   SpdMatrix SSSM::inner() const {
     // -1  1  0  0 .... 0          -1 -1 -1 -1 ... -1
     // -1  0  1  0 .... 0           1  0  0  0 .... 0
@@ -1309,6 +1449,32 @@ namespace BOOM {
     }
   }
 
+  void AutoRegressionTransitionMatrix::matrix_multiply_inplace(
+      SubMatrix m) const {
+    conforms_to_rows(m.nrow());
+    for (int j = 0; j < m.ncol(); ++j) {
+      AutoRegressionTransitionMatrix::multiply_inplace(m.col(j));
+    }
+  }
+
+  // The columns of m * this->transpose() are the columns of m shifted one
+  // place to the right, with the rho-weighted sum of the columns in front.
+  void AutoRegressionTransitionMatrix::matrix_transpose_premultiply_inplace(
+      SubMatrix m) const {
+    conforms_to_cols(m.ncol());
+    int p = m.ncol();
+    const Vector &rho(autoregression_params_->value());
+    Vector first_column(m.nrow(), 0.0);
+    for (int k = p - 1; k >= 0; --k) {
+      first_column.axpy(m.col(k), rho[k]);
+      if (k > 0) {
+        m.col(k) = m.col(k - 1);
+      } else {
+        m.col(0) = first_column;
+      }
+    }
+  }
+
   SpdMatrix AutoRegressionTransitionMatrix::inner() const {
     SpdMatrix ans = outer(autoregression_params_->value());
     int dim = ans.nrow();
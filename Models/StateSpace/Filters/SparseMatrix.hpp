@@ -538,6 +538,10 @@ namespace BOOM {
                           const ConstVectorView &rhs) const override;
     void Tmult(VectorView lhs, const ConstVectorView &rhs) const override;
     void multiply_inplace(VectorView v) const override;
+    // These operate on whole rows or columns at a time, which avoids a
+    // virtual call to multiply_inplace for each row or column of m.
+    void matrix_multiply_inplace(SubMatrix m) const override;
+    void matrix_transpose_premultiply_inplace(SubMatrix m) const override;
     SpdMatrix inner() const override;
     SpdMatrix inner(const ConstVectorView &weights) const override;
     void add_to_block(SubMatrix block) const override;
@@ -549,6 +553,39 @@ namespace BOOM {
     }
   };
 
+  //======================================================================
+  // A 2x2 rotation through 'angle' radians:
+  //   cos(angle)  sin(angle)
+  //  -sin(angle)  cos(angle)
+  // This is the transition matrix for one harmonic in a trigonometric
+  // seasonal model.  Because the matrix is orthogonal, inner() is the
+  // identity and the left inverse is the transpose.
+  class RotationMatrix : public SparseMatrixBlock {
+   public:
+    explicit RotationMatrix(double angle);
+    RotationMatrix *clone() const override;
+    int nrow() const override { return 2; }
+    int ncol() const override { return 2; }
+    void multiply(VectorView lhs, const ConstVectorView &rhs) const override;
+    void multiply_and_add(VectorView lhs,
+                          const ConstVectorView &rhs) const override;
+    void Tmult(VectorView lhs, const ConstVectorView &rhs) const override;
+    void multiply_inplace(VectorView v) const override;
+    // Rotate the two rows (or columns) of m directly, rather than copying
+    // each column (or row) through multiply_inplace.
+    void matrix_multiply_inplace(SubMatrix m) const override;
+    void matrix_transpose_premultiply_inplace(SubMatrix m) const override;
+    SpdMatrix inner() const override;
+    SpdMatrix inner(const ConstVectorView &weights) const override;
+    void add_to_block(SubMatrix block) const override;
+    Matrix dense() const override;
+    Vector left_inverse(const ConstVectorView &x) const override;
+
+   private:
+    double cosine_;
+    double sine_;
+  };
+
   //======================================================================
   // A SparseMatrixBlock filled with a DenseMatrix.  I.e. a dense
   // sub-block of a sparse matrix.
@@ -849,6 +886,8 @@ namespace BOOM {
     void Tmult(VectorView lhs, const ConstVectorView &rhs) const override;
     // x = (*this) * x;
     void multiply_inplace(VectorView x) const override;
+    void matrix_multiply_inplace(SubMatrix m) const override;
+    void matrix_transpose_premultiply_inplace(SubMatrix m) const override;
     SpdMatrix inner() const override;
     SpdMatrix inner(const ConstVectorView &weights) const override;
     void add_to_block(SubMatrix block) const override;
@@ -889,8 +928,8 @@ namespace BOOM {
     SpdMatrix inner() const override;
     SpdMatrix inner(const ConstVectorView &weights) const override;
     void add_to_block(SubMatrix block) const override;
-    // virtual void matrix_multiply_inplace(SubMatrix m) const;
-    // virtual void matrix_transpose_premultiply_inplace(SubMatrix m) const;
+    void matrix_multiply_inplace(SubMatrix m) const override;
+    void matrix_transpose_premultiply_inplace(SubMatrix m) const override;
     Matrix dense() const override;
 
     Vector left_inverse(const ConstVectorView &x) const override;
@@ -204,12 +204,23 @@ namespace BOOM {
 
   //======================================================================
 
+  SparseVector sparsify(const ConstVectorView &dense) {
+    SparseVector ans(dense.size());
+    for (int i = 0; i < dense.size(); ++i) {
+      if (dense[i] != 0.0) {
+        ans[i] = dense[i];
+      }
+    }
+    return ans;
+  }
+
+  // P is symmetric, so P * z is the combination of the columns of P selected
+  // by the nonzero elements of z.  Columns are contiguous in memory, unlike
+  // rows.
   Vector operator*(const SpdMatrix &P, const SparseVector &z) {
-    int n = nrow(P);
-    Vector ans(n);
-    for (int i = 0; i < n; ++i) {
-      //      ans[i] = z.dot(P.col(i));
-      ans[i] = z.dot(P.row(i));
+    Vector ans(nrow(P), 0.0);
+    for (const auto &el : z) {
+      ans.axpy(P.col(el.first), el.second);
     }
     return ans;
   }
@@ -101,6 +101,11 @@ namespace BOOM {
     friend class SparseVectorReturnProxy;
   };
 
+  // Returns a SparseVector holding only the nonzero elements of 'dense'.
+  // Contrast with the SparseVector(const Vector &) constructor, which stores
+  // every element.
+  SparseVector sparsify(const ConstVectorView &dense);
+
   Vector operator*(const SpdMatrix &P, const SparseVector &v);
   Vector operator*(const SubMatrix P, const SparseVector &v);
   std::ostream &operator<<(std::ostream &, const SparseVector &v);
@@ -13,6 +13,7 @@
 #include "LinAlg/LU.hpp"
 #include "LinAlg/Cholesky.hpp"
 
+#include "cpputil/Constants.hpp"
 #include "test_utils/test_utils.hpp"
 #include <fstream>
 
@@ -294,6 +295,97 @@ namespace {
                                        forecast_precision0_hi)->dense();
   }
 
+  //===========================================================================
+  // With many more series than factors the update works with the collapsed
+  // observation.  Check it against the dense update.
+  TEST_F(ConditionallyIndependentKalmanFilterTest, CollapsedUpdateMatchesDense) {
+    int ydim = 60;
+    int sample_size = 3;
+    int nfactors = 3;
+    Matrix data(sample_size, ydim);
+    data.randomize();
+
+    NEW(MultivariateStateSpaceRegressionModel, model)(0, ydim);
+    for (int i = 0; i < sample_size; ++i) {
+      for (int j = 0; j < ydim; ++j) {
+        NEW(MultivariateTimeSeriesRegressionData, data_point)(
+            data(i, j), Vector(1, 1.0), j, i);
+        model->add_data(data_point);
+      }
+    }
+
+    NEW(ConditionallyIndependentSharedLocalLevelStateModel, state_model)(
+        model.get(), nfactors, ydim);
+    for (int i = 0; i < ydim; ++i) {
+      Vector beta = state_model->raw_observation_coefficients(i)->Beta();
+      beta.randomize();
+      state_model->raw_observation_coefficients(i)->set_Beta(beta);
+    }
+    for (int s = 0; s < nfactors; ++s) {
+      state_model->innovation_model(s)->set_sigsq(1.0 + s);
+    }
+    SpdMatrix state_variance(nfactors);
+    state_variance.randomize();
+    Vector state_mean(nfactors);
+    state_mean.randomize();
+    state_model->set_initial_state_mean(state_mean);
+    state_model->set_initial_state_variance(state_variance);
+    model->add_state(state_model);
+    for (int i = 0; i < ydim; ++i) {
+      model->observation_model()->model(i)->set_sigsq(runif(.5, 2.0));
+    }
+
+    // The dense marginal is built from the full observation coefficients and
+    // variance, and subsets them in the update.
+    DenseKalmanMarginal dense(model.get(), 0);
+    Selector observed(ydim, true);
+    observed.drop(7);
+    observed.drop(30);
+    model->set_observed_status(0, observed);
+
+    dense.set_state_mean(state_mean);
+    dense.set_state_variance(state_variance);
+    double dense_loglike = dense.update(data.row(0), observed);
+
+    Marginal collapsed(model.get(), &model->get_filter(), 0);
+    collapsed.set_state_mean(state_mean);
+    collapsed.set_state_variance(state_variance);
+    double collapsed_loglike = collapsed.update(data.row(0), observed);
+
+    // The multivariate filters use -.5 * nobs * log_root_2pi as the normalizing
+    // constant, while the dense marginal uses -nobs * log_root_2pi.
+    EXPECT_NEAR(dense_loglike + .5 * observed.nvars() * Constants::log_root_2pi,
+                collapsed_loglike, 1e-6);
+    EXPECT_TRUE(VectorEquals(dense.prediction_error(),
+                             collapsed.prediction_error()));
+    EXPECT_NEAR(dense.forecast_precision_log_determinant(),
+                collapsed.forecast_precision_log_determinant(),
+                1e-6);
+    EXPECT_TRUE(VectorEquals(dense.state_mean(), collapsed.state_mean(), 1e-6))
+        << "dense:     " << dense.state_mean() << "\n"
+        << "collapsed: " << collapsed.state_mean();
+    EXPECT_TRUE(MatrixEquals(dense.state_variance(),
+                             collapsed.state_variance(), 1e-6));
+    EXPECT_TRUE(MatrixEquals(collapsed.sparse_forecast_precision()->dense(),
+                             dense.forecast_precision(), 1e-6));
+
+    // The full filter produces the same log likelihood as a sequence of dense
+    // updates.
+    model->set_observed_status(0, Selector(ydim, true));
+    dense.set_state_mean(state_mean);
+    dense.set_state_variance(state_variance);
+    double dense_total = dense.update(data.row(0), Selector(ydim, true));
+    for (int t = 1; t < sample_size; ++t) {
+      DenseKalmanMarginal next(model.get(), t);
+      next.set_state_mean(dense.state_mean());
+      next.set_state_variance(dense.state_variance());
+      dense_total += next.update(data.row(t), model->observed_status(t));
+      dense = next;
+    }
+    EXPECT_NEAR(dense_total + .5 * sample_size * ydim * Constants::log_root_2pi,
+                model->log_likelihood(), 1e-6);
+  }
+
   // Check that kalman_gain(t) and forecast_precision(t) are the same when going
   // forwards and backwards.
   TEST_F(ConditionallyIndependentKalmanFilterTest, ForwardBackWardMatch) {
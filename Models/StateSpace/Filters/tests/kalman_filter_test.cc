@@ -71,4 +71,98 @@ namespace {
     // TODO(finish this later)
   }
 
+  // Running the filter one observation at a time grows the vector of nodes
+  // incrementally.  The nodes should survive being moved as the vector grows.
+  TEST_F(KalmanFilterTest, IncrementalUpdateMatchesFullFilter) {
+    int n = 250;
+    Vector y(n);
+    for (int t = 0; t < n; ++t) {
+      y[t] = sin(t / 3.0) + rnorm(0, .5);
+    }
+    NEW(StateSpaceModel, model)(y);
+    NEW(LocalLevelStateModel, level)(.01);
+    level->set_initial_state_mean(0.0);
+    level->set_initial_state_variance(1.0);
+    model->add_state(level);
+    NEW(SeasonalStateModel, seasonal)(4, 1);
+    seasonal->set_initial_state_mean(Vector(3, 0.0));
+    seasonal->set_initial_state_variance(SpdMatrix(3, 1.0));
+    model->add_state(seasonal);
+    model->observation_model()->set_sigsq(.25);
+
+    ScalarKalmanFilter &full(model->get_filter());
+    full.set_steady_state_tolerance(-1);
+    model->kalman_filter();
+
+    ScalarKalmanFilter incremental(model.get());
+    for (int t = 0; t < n; ++t) {
+      incremental.update(y[t], t);
+    }
+    EXPECT_EQ(n, incremental.size());
+    for (int t = 0; t < n; t += 50) {
+      EXPECT_DOUBLE_EQ(full[t].prediction_error(),
+                       incremental[t].prediction_error());
+      EXPECT_DOUBLE_EQ(full[t].prediction_variance(),
+                       incremental[t].prediction_variance());
+      EXPECT_TRUE(VectorEquals(full[t].state_mean(),
+                               incremental[t].state_mean()));
+      EXPECT_TRUE(MatrixEquals(full[t].state_variance(),
+                               incremental[t].state_variance()));
+      EXPECT_TRUE(VectorEquals(full[t].kalman_gain(),
+                               incremental[t].kalman_gain()));
+    }
+  }
+
+  // The time-parallel filter reproduces the serial filter, including across
+  // block boundaries and at missing observations.
+  TEST_F(KalmanFilterTest, ParallelFilterMatchesSerialFilter) {
+    int n = 1000;
+    Vector y(n);
+    std::vector<bool> observed(n, true);
+    for (int t = 0; t < n; ++t) {
+      y[t] = sin(t / 3.0) + rnorm(0, .5);
+      if (t % 37 == 5 || (t >= 190 && t < 200)) {
+        observed[t] = false;
+      }
+    }
+    NEW(StateSpaceModel, model)(y, observed);
+    NEW(LocalLevelStateModel, level)(.01);
+    level->set_initial_state_mean(0.0);
+    level->set_initial_state_variance(1.0);
+    model->add_state(level);
+    NEW(SeasonalStateModel, seasonal)(4, 1);
+    seasonal->set_initial_state_mean(Vector(3, 0.0));
+    seasonal->set_initial_state_variance(SpdMatrix(3, 1.0));
+    model->add_state(seasonal);
+    model->observation_model()->set_sigsq(.25);
+
+    ScalarKalmanFilter serial(model.get());
+    serial.set_steady_state_tolerance(-1);
+    serial.update();
+
+    ScalarKalmanFilter parallel(model.get());
+    parallel.set_number_of_threads(3);
+    parallel.set_time_block_size(64);
+    parallel.update();
+
+    EXPECT_NEAR(serial.log_likelihood(), parallel.log_likelihood(), 1e-6);
+    for (int t = 0; t < n; ++t) {
+      ASSERT_NEAR(serial[t].prediction_error(),
+                  parallel[t].prediction_error(), 1e-6) << "t = " << t;
+      EXPECT_NEAR(serial[t].prediction_variance(),
+                  parallel[t].prediction_variance(), 1e-6);
+      EXPECT_TRUE(VectorEquals(serial[t].state_mean(),
+                               parallel[t].state_mean(), 1e-6));
+      EXPECT_TRUE(MatrixEquals(serial[t].state_variance(),
+                               parallel[t].state_variance(), 1e-6));
+    }
+
+    // The results do not depend on the number of threads.
+    ScalarKalmanFilter more_threads(model.get());
+    more_threads.set_number_of_threads(6);
+    more_threads.set_time_block_size(64);
+    more_threads.update();
+    EXPECT_DOUBLE_EQ(parallel.log_likelihood(), more_threads.log_likelihood());
+  }
+
 }  // namespace
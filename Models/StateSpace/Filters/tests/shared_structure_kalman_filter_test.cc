@@ -0,0 +1,92 @@
+#include "gtest/gtest.h"
+#include "distributions.hpp"
+#include "Models/StateSpace/Filters/SharedStructureKalmanFilter.hpp"
+#include "Models/StateSpace/StateSpaceModel.hpp"
+#include "Models/StateSpace/StateModels/LocalLevelStateModel.hpp"
+#include "Models/StateSpace/StateModels/SeasonalStateModel.hpp"
+
+#include "test_utils/test_utils.hpp"
+#include <cmath>
+#include <limits>
+
+namespace {
+  using namespace BOOM;
+  using std::endl;
+  using std::cout;
+
+  class SharedStructureKalmanFilterTest : public ::testing::Test {
+   protected:
+    SharedStructureKalmanFilterTest() {
+      GlobalRng::rng.seed(8675309);
+    }
+  };
+
+  Ptr<StateSpaceModel> local_level_seasonal_model(
+      const Vector &y, const std::vector<bool> &observed) {
+    NEW(StateSpaceModel, model)(y, observed);
+    NEW(LocalLevelStateModel, level)(square(.3));
+    level->set_initial_state_mean(0.0);
+    level->set_initial_state_variance(4.0);
+    model->add_state(level);
+    NEW(SeasonalStateModel, seasonal)(4, 1);
+    seasonal->set_sigsq(square(.2));
+    seasonal->set_initial_state_mean(Vector(3, 0.0));
+    seasonal->set_initial_state_variance(SpdMatrix(3, 2.0));
+    model->add_state(seasonal);
+    model->observation_model()->set_sigsq(square(1.1));
+    return model;
+  }
+
+  // Each series should get the same answers it would from a model fit to
+  // that series alone.
+  TEST_F(SharedStructureKalmanFilterTest, MatchesSeriesBySeries) {
+    int time_dimension = 40;
+    int number_of_series = 7;
+    Matrix series(time_dimension, number_of_series);
+    for (int s = 0; s < number_of_series; ++s) {
+      double level = rnorm();
+      for (int t = 0; t < time_dimension; ++t) {
+        level += rnorm(0, .3);
+        series(t, s) = level + (t % 4) + rnorm(0, 1.1);
+      }
+    }
+    // Series 3 and 4 share a missing-data pattern.  Series 5 has its own.
+    for (int s : {3, 4}) {
+      series(10, s) = std::numeric_limits<double>::quiet_NaN();
+      series(11, s) = std::numeric_limits<double>::quiet_NaN();
+    }
+    series(25, 5) = std::numeric_limits<double>::quiet_NaN();
+
+    Ptr<StateSpaceModel> structure = local_level_seasonal_model(
+        Vector(), std::vector<bool>());
+    SharedStructureKalmanFilter filter(structure.get());
+    filter.filter(series);
+    EXPECT_EQ(3, filter.number_of_patterns());
+
+    for (int s = 0; s < number_of_series; ++s) {
+      Vector y(series.col(s));
+      std::vector<bool> observed(time_dimension);
+      for (int t = 0; t < time_dimension; ++t) {
+        observed[t] = !std::isnan(y[t]);
+        if (!observed[t]) y[t] = 0.0;
+      }
+      Ptr<StateSpaceModel> model = local_level_seasonal_model(y, observed);
+      EXPECT_NEAR(model->log_likelihood(), filter.log_likelihood()[s], 1e-8);
+
+      ScalarKalmanFilter &single(model->get_filter());
+      for (int t = 0; t < time_dimension; ++t) {
+        if (observed[t]) {
+          EXPECT_NEAR(single[t].prediction_error(),
+                      filter.prediction_errors()(t, s), 1e-8);
+          EXPECT_NEAR(single[t].prediction_variance(),
+                      filter.prediction_variances()(t, s), 1e-8);
+        }
+      }
+      EXPECT_TRUE(VectorEquals(single.back().state_mean(),
+                               filter.final_state_means().col(s), 1e-8));
+      EXPECT_TRUE(MatrixEquals(single.back().state_variance(),
+                               filter.final_state_variance(s), 1e-8));
+    }
+  }
+
+}  // namespace
@@ -299,6 +299,68 @@ namespace {
     CheckSparseMatrixBlock(rho_kalman, rho_dense);
   }
 
+  TEST_F(SparseMatrixTest, Rotation) {
+    double angle = 2 * Constants::pi / 7;
+    NEW(RotationMatrix, rotation)(angle);
+    Matrix rotation_dense(2, 2);
+    rotation_dense(0, 0) = rotation_dense(1, 1) = cos(angle);
+    rotation_dense(0, 1) = sin(angle);
+    rotation_dense(1, 0) = -sin(angle);
+
+    CheckSparseMatrixBlock(rotation, rotation_dense);
+  }
+
+  // BlockDiagonalMatrix::sandwich_inplace applies each block to a strip of
+  // the state variance, which is not square.
+  void CheckStripMultiplication(const SparseMatrixBlock &sparse,
+                                const Matrix &dense) {
+    int dim = dense.nrow();
+    Matrix big(dim + 3, dim + 5);
+    big.randomize();
+    Matrix original = big;
+    sparse.matrix_multiply_inplace(SubMatrix(big, 1, dim, 0, big.ncol() - 1));
+    Matrix expected = original;
+    SubMatrix(expected, 1, dim, 0, expected.ncol() - 1) =
+        dense * ConstSubMatrix(original, 1, dim, 0, original.ncol() - 1)
+        .to_matrix();
+    EXPECT_TRUE(MatrixEquals(big, expected));
+
+    big = original;
+    sparse.matrix_transpose_premultiply_inplace(
+        SubMatrix(big, 0, big.nrow() - 1, 2, dim + 1));
+    expected = original;
+    SubMatrix(expected, 0, expected.nrow() - 1, 2, dim + 1) =
+        ConstSubMatrix(original, 0, original.nrow() - 1, 2, dim + 1)
+        .to_matrix() * dense.transpose();
+    EXPECT_TRUE(MatrixEquals(big, expected));
+  }
+
+  TEST_F(SparseMatrixTest, StripMultiplication) {
+    Matrix trend_dense(2, 2, 1.0);
+    trend_dense(1, 0) = 0.0;
+    CheckStripMultiplication(LocalLinearTrendMatrix(), trend_dense);
+
+    Matrix seasonal_dense(4, 4, 0.0);
+    seasonal_dense.row(0) = -1;
+    seasonal_dense.subdiag(1) = 1.0;
+    CheckStripMultiplication(SeasonalStateSpaceMatrix(5), seasonal_dense);
+
+    Vector elements(3);
+    elements.randomize();
+    NEW(GlmCoefs, rho)(elements);
+    Matrix rho_dense(3, 3, 0.0);
+    rho_dense.row(0) = elements;
+    rho_dense.subdiag(1) = 1.0;
+    CheckStripMultiplication(AutoRegressionTransitionMatrix(rho), rho_dense);
+
+    double angle = 1.3;
+    Matrix rotation_dense(2, 2);
+    rotation_dense(0, 0) = rotation_dense(1, 1) = cos(angle);
+    rotation_dense(0, 1) = sin(angle);
+    rotation_dense(1, 0) = -sin(angle);
+    CheckStripMultiplication(RotationMatrix(angle), rotation_dense);
+  }
+
   TEST_F(SparseMatrixTest, ArmaTransition) {
     Vector coefficients = {.8, .3, 0, 0};
     NEW(ArmaStateSpaceTransitionMatrix, T)(coefficients);
@@ -19,11 +19,49 @@
   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
 */
 
+#include <cmath>
+
 #include "Models/DataTypes.hpp"
 #include "cpputil/Ptr.hpp"
 
 namespace BOOM {
   namespace StateSpace {
+    // Combines the conditionally Gaussian observations at a single time point
+    // into one pseudo-observation.  If y_i ~ N(mu, 1 / w_i) independently,
+    // then the precision weighted mean sum(w_i * y_i) / sum(w_i) is sufficient
+    // for mu, and has variance 1 / sum(w_i).  Multiplexed data types use this
+    // to give the scalar Kalman filter a single observation per time period,
+    // so the cost of filtering does not depend on the number of observations
+    // in each period.
+    class CollapsedObservation {
+     public:
+      CollapsedObservation() : weighted_sum_(0.0), total_precision_(0.0) {}
+
+      // Add an observation with the given value and precision (inverse
+      // variance).  Observations with a common unknown variance can use the
+      // default precision, in which case value() is the sample mean.
+      void add(double value, double precision = 1.0) {
+        weighted_sum_ += precision * value;
+        total_precision_ += precision;
+      }
+
+      // True if the observations added so far carry no usable information.
+      bool empty() const {
+        return !(total_precision_ > 0) || !std::isfinite(total_precision_);
+      }
+
+      // The precision weighted mean of the observations.  Only meaningful if
+      // !empty().
+      double value() const { return weighted_sum_ / total_precision_; }
+
+      // The sum of the precisions of the observations.
+      double precision() const { return total_precision_; }
+
+     private:
+      double weighted_sum_;
+      double total_precision_;
+    };
+
     class MultiplexedData : public Data {
      public:
       MultiplexedData();
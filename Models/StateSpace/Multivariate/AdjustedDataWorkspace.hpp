@@ -19,6 +19,10 @@
   Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
 */
 
+#include <algorithm>
+#include <atomic>
+#include "cpputil/ThreadTools.hpp"
+
 namespace BOOM {
 
   namespace StateSpaceUtilities {
@@ -33,6 +37,26 @@ namespace BOOM {
             workspace_status_(WorkspaceStatus::UNSET)
       {}
 
+      // Observers are not copied, so a copied workspace starts out stale.
+      AdjustedDataWorkspace(const AdjustedDataWorkspace &rhs)
+          : pool_(rhs.pool_),
+            adjusted_data_workspace_(rhs.adjusted_data_workspace_),
+            workspace_current_(false),
+            workspace_time_index_(rhs.workspace_time_index_),
+            workspace_status_(rhs.workspace_status_)
+      {}
+
+      AdjustedDataWorkspace &operator=(const AdjustedDataWorkspace &rhs) {
+        if (&rhs != this) {
+          pool_ = rhs.pool_;
+          adjusted_data_workspace_ = rhs.adjusted_data_workspace_;
+          workspace_current_ = false;
+          workspace_time_index_ = rhs.workspace_time_index_;
+          workspace_status_ = rhs.workspace_status_;
+        }
+        return *this;
+      }
+
       template <class DATA_POLICY, class STATE_MANAGER, class OBSERVATION_MODEL>
       void isolate_shared_state(int time,
                                 const DATA_POLICY &data_policy,
@@ -45,20 +69,13 @@ namespace BOOM {
         }
         const Selector &observed(data_policy.observed(time));
         adjusted_data_workspace_.resize(observed.nvars());
-        for (int series = 0; series < data_policy.nseries(); ++series) {
-          if (observed[series]) {
-            int s = observed.dense_index(series);
-            Ptr<typename DATA_POLICY::DataType> data_point =
-                data_policy.data_point(series, time);
-            adjusted_data_workspace_[s] = data_point->y()
-                - state_manager.series_specific_state_contribution(
-                    series, time);
-
-            double regression_contribution = observation_model->model(
-                series)->predict(data_point->x());
-            adjusted_data_workspace_[s] -= regression_contribution;
-          }
-        }
+        for_each_observed_series(observed, [&](int s, int series) {
+          const Ptr<typename DATA_POLICY::DataType> &data_point(
+              data_policy.data_point(series, time));
+          adjusted_data_workspace_[s] = data_point->y()
+              - state_manager.series_specific_state_contribution(series, time)
+              - observation_model->model(series)->predict(data_point->x());
+        });
         workspace_current_ = true;
         workspace_time_index_ = time;
         workspace_status_ = ISOLATE_SHARED_STATE;
@@ -82,15 +99,14 @@ namespace BOOM {
         Vector shared_state_contribution =
             observation_coefficients * shared_state.col(time);
 
-        for (int s = 0; s < observed.nvars(); ++s) {
-          int series = observed.sparse_index(s);
+        for_each_observed_series(observed, [&](int s, int series) {
           const typename DATA_POLICY::DataType *data_point =
               data_policy.data_point(series, time).get();
           const Vector &predictors(data_point->x());
           adjusted_data_workspace_[s] = data_point->y()
               - shared_state_contribution[s]
               - observation_model->model(series)->predict(predictors);
-        }
+        });
         workspace_current_ = true;
         workspace_time_index_ = time;
         workspace_status_ = ISOLATE_SERIES_SPECIFIC_STATE;
@@ -140,7 +156,31 @@ namespace BOOM {
         workspace_status_ = UNSET;
       }
 
+      // Set the number of threads used to compute the adjusted data.  Series
+      // are processed in fixed blocks, each adjusted value depends only on its
+      // own series, so the results do not depend on the number of threads.
+      // The default is zero, which does the work in the calling thread.
+      void set_number_of_threads(int n) { pool_.set_number_of_threads(n); }
+
      private:
+      // Call f(s, series) for each observed series, where s is the dense index
+      // of the series among the observed elements.
+      template <class FUN>
+      void for_each_observed_series(const Selector &observed, FUN f) {
+        int nobs = observed.nvars();
+        int nblocks = (nobs + series_block_size_ - 1) / series_block_size_;
+        pool_.parallel_for(0, nblocks, 1, [&](int block) {
+          int begin = block * series_block_size_;
+          int end = std::min<int>(begin + series_block_size_, nobs);
+          for (int s = begin; s < end; ++s) {
+            f(s, observed.sparse_index(s));
+          }
+        });
+      }
+
+      static constexpr int series_block_size_ = 256;
+      SharedThreadPool pool_;
+
       // A workspace where observed data can be modified by subtracting off
       // components on which we wish to condition.
       //
@@ -156,7 +196,9 @@ namespace BOOM {
       //
       // A flag indicating that the workspace holds current values.  This is set
       // to false whenever new parameters are assigned or new state is drawn.
-      bool workspace_current_;
+      // Parameters for different series may be assigned in parallel, so the
+      // flag is atomic.
+      std::atomic<bool> workspace_current_;
 
       // The time index that the workspace currently describes.
       int workspace_time_index_;
@@ -22,6 +22,7 @@
 #include "LinAlg/SubMatrix.hpp"
 #include "Models/StateSpace/Filters/SparseKalmanTools.hpp"
 #include "Models/PosteriorSamplers/PosteriorSampler.hpp"
+#include "Samplers/McmcProfiler.hpp"
 #include "cpputil/report_error.hpp"
 #include "distributions.hpp"
 #include "numopt.hpp"
@@ -141,6 +142,7 @@ namespace BOOM {
     if (number_of_state_models() == 0) {
       report_error("No state has been defined.");
     }
+    ScopedPhaseTimer timer(McmcProfiler::kImputeLatentData);
     set_state_model_behavior(StateModel::MIXTURE);
     if (state_is_fixed_) {
       observe_fixed_state();
@@ -191,6 +191,10 @@ namespace BOOM {
       adjusted_data_workspace_.unset();
     }
 
+    void set_number_of_workspace_threads(int n) {
+      adjusted_data_workspace_.set_number_of_threads(n);
+    }
+
     // Add the data from 'rhs' to the data from the current model.
     void combine_data(const MultivariateStateSpaceRegressionDataPolicy &rhs) {
       if (rhs.nseries_ != nseries_) {
@@ -18,6 +18,7 @@
   Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
 */
 
+#include <atomic>
 #include "Models/IndependentMvnModel.hpp"
 #include "Models/Glm/Glm.hpp"
 #include "Models/Glm/IndependentRegressionModels.hpp"
@@ -315,6 +316,13 @@ namespace BOOM {
     // The vector of adjusted observations across all time series at time t.
     ConstVectorView adjusted_observation(int time) const override;
 
+    // Set the number of threads used to compute adjusted_observation(time)
+    // across series.  The default is zero, which computes the adjusted
+    // observations in the calling thread.
+    void set_number_of_workspace_threads(int n) {
+      data_policy_.set_number_of_workspace_threads(n);
+    }
+
     //--------------------------------------------------------------------------
     // Kalman filter parameters.
     //--------------------------------------------------------------------------
@@ -561,7 +569,8 @@ namespace BOOM {
     mutable DiagonalMatrix observation_variance_;
 
     // A flag to keep track of whether the observation variance is current.
-    mutable bool observation_variance_current_;
+    // It is atomic because the residual variances may be drawn in parallel.
+    mutable std::atomic<bool> observation_variance_current_;
 
     // A Selector of size nseries() with all elements included.  Useful for
     // calling observation_coefficients when you want to assume all elements are
@@ -20,6 +20,7 @@
 #include "Models/StateSpace/PosteriorSamplers/StateSpacePosteriorSampler.hpp"
 #include "Models/PosteriorSamplers/PosteriorSampler.hpp"
 #include "Models/StateSpace/Multivariate/ProxyScalarStateSpaceModel.hpp"
+#include "Models/Glm/PosteriorSamplers/IndependentRegressionModelsPosteriorSampler.hpp"
 
 namespace BOOM {
 
@@ -64,14 +65,8 @@ namespace BOOM {
 
     // Sample parameters for proxy models if any series specific state is
     // present.
-    using Proxy = ProxyScalarStateSpaceModel<MultivariateStateSpaceRegressionModel>;
     if (model_->has_series_specific_state()) {
-      for (int j = 0; j < model_->nseries(); ++j) {
-        Proxy &proxy(*model_->series_specific_model(j));
-        for (int s = 0; s < proxy.number_of_state_models(); ++s) {
-          proxy.state_model(s)->sample_posterior();
-        }
-      }
+      draw_series_specific_state_parameters();
     }
 
     // The complete data sufficient statistics for the observation model and the
@@ -85,6 +80,31 @@ namespace BOOM {
     model_->impute_state(rng());
   }
 
+  void MSSRPS::set_number_of_threads(int n) {
+    pool_.set_number_of_threads(n);
+    model_->set_number_of_workspace_threads(n);
+    IndependentRegressionModels *observation_model = model_->observation_model();
+    for (int i = 0; i < observation_model->number_of_sampling_methods(); ++i) {
+      auto *sampler = dynamic_cast<IndependentRegressionModelsPosteriorSampler *>(
+          observation_model->sampler(i));
+      if (sampler) {
+        sampler->set_number_of_threads(n);
+      }
+    }
+  }
+
+  // The proxy models for different series share no parameters, so they can be
+  // drawn in parallel.
+  void MSSRPS::draw_series_specific_state_parameters() {
+    using Proxy = ProxyScalarStateSpaceModel<MultivariateStateSpaceRegressionModel>;
+    pool_.parallel_for(0, model_->nseries(), 1, [this](int series) {
+      Proxy &proxy(*model_->series_specific_model(series));
+      for (int s = 0; s < proxy.number_of_state_models(); ++s) {
+        proxy.state_model(s)->sample_posterior();
+      }
+    });
+  }
+
   double MSSRPS::logpri() const {
     double ans = model_->observation_model()->logpri();
     for (int s = 0; s < model_->number_of_state_models(); ++s) {
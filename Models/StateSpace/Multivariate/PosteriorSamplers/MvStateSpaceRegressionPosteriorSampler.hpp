@@ -22,6 +22,7 @@
 // in ancient, archaic tar formats.
 #include "Models/StateSpace/Multivariate/MultivariateStateSpaceRegressionModel.hpp"
 #include "Models/PosteriorSamplers/PosteriorSampler.hpp"
+#include "cpputil/ThreadTools.hpp"
 
 namespace BOOM {
 
@@ -45,9 +46,26 @@ namespace BOOM {
     void draw() override;
     double logpri() const override;
 
+    // Set the number of threads used for work that is conditionally
+    // independent across series once the shared state has been imputed:
+    // the adjusted data computed by the model, the parameter draws for
+    // series-specific state models, and the per-series regression draws made
+    // by an IndependentRegressionModelsPosteriorSampler assigned to
+    // model->observation_model().  The observation model's sampler must be
+    // assigned before this function is called.
+    //
+    // Each series is drawn by samplers with their own RNGs, so the draws do
+    // not depend on the number of threads.  The default is zero, which does
+    // all the work in the calling thread.
+    void set_number_of_threads(int n);
+
    private:
     MultivariateStateSpaceRegressionModel *model_;
     bool latent_data_initialized_;
+    SharedThreadPool pool_;
+
+    // Draw the parameters of the series-specific state models.
+    void draw_series_specific_state_parameters();
 
     // A stub for when non-gaussian data becomes supported.
     virtual void impute_nonstate_latent_data() {}
@@ -543,6 +543,44 @@ namespace BoomStateSpaceTesting {
 
   //===========================================================================
   // Test the full MCMC experience.
+  //===========================================================================
+  // The per-series work in the posterior sampler gives the same draws when it
+  // is spread across threads.
+  TEST_F(MultivariateStateSpaceRegressionModelTest, ThreadedDrawsMatchSerial) {
+    int xdim = 2;
+    int nseries = 300;
+    int nfactors = 2;
+    int sample_size = 20;
+    double residual_sd = .5;
+
+    GlobalRng::rng.seed(31416);
+    McmcTestFramework serial(xdim, nseries, nfactors, sample_size, 0,
+                             residual_sd);
+    GlobalRng::rng.seed(31416);
+    McmcTestFramework threaded(xdim, nseries, nfactors, sample_size, 0,
+                               residual_sd);
+    auto *sampler = dynamic_cast<MultivariateStateSpaceRegressionPosteriorSampler *>(
+        threaded.model->sampler(0));
+    ASSERT_TRUE(sampler != nullptr);
+    sampler->set_number_of_threads(4);
+
+    for (int iteration = 0; iteration < 5; ++iteration) {
+      serial.model->sample_posterior();
+      threaded.model->sample_posterior();
+    }
+
+    for (int i = 0; i < nseries; ++i) {
+      EXPECT_EQ(serial.model->observation_model()->model(i)->Beta(),
+                threaded.model->observation_model()->model(i)->Beta());
+      EXPECT_DOUBLE_EQ(serial.model->observation_model()->model(i)->sigsq(),
+                       threaded.model->observation_model()->model(i)->sigsq());
+    }
+    EXPECT_TRUE(MatrixEquals(serial.model->shared_state(),
+                             threaded.model->shared_state()));
+    EXPECT_DOUBLE_EQ(serial.model->log_likelihood(),
+                     threaded.model->log_likelihood());
+  }
+
   TEST_F(MultivariateStateSpaceRegressionModelTest, McmcTest) {
     // Simulate fake data from the model: shared local level and a regression
     // effect.
@@ -81,8 +81,18 @@ namespace BOOM {
     draw_inclusion_indicators();
     model_->draw_coefficients_given_inclusion(rng());
     draw_residual_variance();
-    draw_unscaled_state_innovation_variance();
-    draw_transition_probabilities();
+    draw_coefficient_hyperparameters();
+  }
+
+  void DRDGS::draw_coefficient_hyperparameters() {
+    pool_.parallel_for(0, model_->xdim(), 1, [this](int j) {
+      refresh_innovation_suf(j);
+      refresh_transition_suf(j);
+    });
+    for (int j = 0; j < model_->xdim(); ++j) {
+      model_->innovation_error_model(j)->sample_posterior();
+      model_->transition_model(j)->sample_posterior();
+    }
   }
 
   double DRDGS::logpri() const {
@@ -134,14 +144,19 @@ namespace BOOM {
     posterior_precision.diag() += 1.0 / unscaled_prior_variance;
     Vector posterior_mean = posterior_precision.solve(xty);
 
-    int mapped_index = inc.INDX(predictor_index);
-    ans += 0.5 * log(unscaled_prior_variance[mapped_index]);
     ans -= 0.5 * posterior_precision.logdet();
 
     double SSE = model_->data(time_index)->yty() + xtx.Mdist(posterior_mean)
         - 2 * posterior_mean.dot(xty);
-    double prior_sum_of_squares = square(posterior_mean[mapped_index])
-        / unscaled_prior_variance[mapped_index];
+
+    // The prior for element j only contributes if element j is included.
+    double prior_sum_of_squares = 0;
+    if (inc[predictor_index]) {
+      int mapped_index = inc.INDX(predictor_index);
+      ans += 0.5 * log(unscaled_prior_variance[mapped_index]);
+      prior_sum_of_squares = square(posterior_mean[mapped_index])
+          / unscaled_prior_variance[mapped_index];
+    }
 
     double sum_of_squares = SSE + prior_sum_of_squares;
     ans -=  0.5 * sum_of_squares / model_->residual_variance();
@@ -233,39 +248,51 @@ namespace BOOM {
   }
 
   void DRDGS::draw_unscaled_state_innovation_variance() {
-    // The innovation variance is the variance of the innovation model times the
-    // residual variance.  To preserve this definition, we must divide dbeta[t]
-    // by sigma.
-    double sigma = model_->residual_sd();
-
+    pool_.parallel_for(0, model_->xdim(), 1, [this](int j) {
+      refresh_innovation_suf(j);
+    });
     for (int j = 0; j < model_->xdim(); ++j) {
-      Ptr<GaussianSuf> suf = model_->innovation_error_model(j)->suf();
-      suf->clear();
-      // The for loop starts from 1 to allow differencing.
-      for (int t = 1; t < model_->time_dimension(); ++t) {
-        if (model_->inclusion_indicator(t, j)) {
-          double dbeta = model_->coefficient(t, j)
-              - model_->coefficient(t - 1, j);
-          suf->update_raw(dbeta / sigma);
-        }
-      }
       model_->innovation_error_model(j)->sample_posterior();
     }
   }
 
   void DRDGS::draw_transition_probabilities() {
+    pool_.parallel_for(0, model_->xdim(), 1, [this](int j) {
+      refresh_transition_suf(j);
+    });
     for (int j = 0; j < model_->xdim(); ++j) {
-      model_->transition_model(j)->suf()->clear();
-      bool then = model_->inclusion_indicator(0, j);
-      for (int t = 1; t < model_->time_dimension(); ++t) {
-        bool now = model_->inclusion_indicator(t, j);
-        model_->transition_model(j)->suf()->add_transition(then, now);
-        then = now;
-      }
       model_->transition_model(j)->sample_posterior();
     }
   }
 
+  void DRDGS::refresh_innovation_suf(int j) {
+    // The innovation variance is the variance of the innovation model times the
+    // residual variance.  To preserve this definition, we must divide dbeta[t]
+    // by sigma.
+    double sigma = model_->residual_sd();
+    Ptr<GaussianSuf> suf = model_->innovation_error_model(j)->suf();
+    suf->clear();
+    // The for loop starts from 1 to allow differencing.
+    for (int t = 1; t < model_->time_dimension(); ++t) {
+      if (model_->inclusion_indicator(t, j)) {
+        double dbeta = model_->coefficient(t, j)
+            - model_->coefficient(t - 1, j);
+        suf->update_raw(dbeta / sigma);
+      }
+    }
+  }
+
+  void DRDGS::refresh_transition_suf(int j) {
+    Ptr<MarkovSuf> suf = model_->transition_model(j)->suf();
+    suf->clear();
+    bool then = model_->inclusion_indicator(0, j);
+    for (int t = 1; t < model_->time_dimension(); ++t) {
+      bool now = model_->inclusion_indicator(t, j);
+      suf->add_transition(then, now);
+      then = now;
+    }
+  }
+
   Matrix DRDGS::infer_Markov_prior(double prior_success_prob,
                                    double expected_time,
                                    double sample_size) {
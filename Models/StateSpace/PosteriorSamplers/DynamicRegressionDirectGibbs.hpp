@@ -23,6 +23,7 @@
 #include "Models/PosteriorSamplers/MarkovConjSampler.hpp"
 #include "Models/ChisqModel.hpp"
 #include "Models/PosteriorSamplers/GenericGaussianVarianceSampler.hpp"
+#include "cpputil/ThreadTools.hpp"
 
 namespace BOOM {
 
@@ -95,6 +96,22 @@ namespace BOOM {
     void draw() override;
     double logpri() const override;
 
+    // Given the coefficient paths and the residual variance, the innovation
+    // variance and the inclusion transition probabilities for each
+    // coefficient are conditionally independent of those for the other
+    // coefficients.  The passes over time that collect their sufficient
+    // statistics can then be spread across threads, one coefficient per task.
+    // The draws themselves are made serially, so the sampler produces the
+    // same draws for any number of threads.  A value of 0 or less (the
+    // default) does all the work in the calling thread.
+    void set_number_of_threads(int number_of_threads) {
+      pool_.set_number_of_threads(number_of_threads);
+    }
+
+    // Draw the innovation variances and the transition probabilities for all
+    // coefficients, as a block.
+    void draw_coefficient_hyperparameters();
+
     // Draw each inclusion indicator by a direct Gibbs sampler, integrating over
     // the model coefficients, but conditioning on everything else.
     void draw_inclusion_indicators();
@@ -168,6 +185,12 @@ namespace BOOM {
     Ptr<ChisqModel> residual_precision_prior_;
     GenericGaussianVarianceSampler residual_variance_sampler_;
 
+    SharedThreadPool pool_;
+
+    // Refill the sufficient statistics of the innovation error model, or the
+    // inclusion transition model, for a single coefficient.
+    void refresh_innovation_suf(int predictor_index);
+    void refresh_transition_suf(int predictor_index);
   };
 
 
@@ -0,0 +1,309 @@
+/*
+  Copyright (C) 2005-2024 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include "Models/StateSpace/PosteriorSamplers/LiuWestStateSpaceFilter.hpp"
+#include <cmath>
+#include <sstream>
+#include "LinAlg/Cholesky.hpp"
+#include "Models/MvnBase.hpp"
+#include "Models/StateSpace/Filters/SparseKalmanTools.hpp"
+#include "cpputil/lse.hpp"
+#include "cpputil/math_utils.hpp"
+#include "cpputil/report_error.hpp"
+#include "distributions.hpp"
+#include "distributions/CategoricalSampler.hpp"
+#include "stats/Resampler.hpp"
+
+namespace BOOM {
+
+  LiuWestStateSpaceFilter::LiuWestStateSpaceFilter(
+      const Ptr<StateSpaceModel> &model, double kernel_scale_factor)
+      : model_(model),
+        kernel_scale_factor_(kernel_scale_factor),
+        log_predictive_density_(0)
+  {
+    if (!model_) {
+      report_error("LiuWestStateSpaceFilter needs a model.");
+    }
+    if (kernel_scale_factor_ <= 0 || kernel_scale_factor_ >= 1.0) {
+      report_error("Kernel scale factor parameter must be strictly between "
+                   "0 and 1.");
+    }
+  }
+
+  void LiuWestStateSpaceFilter::set_particles(const Matrix &parameters) {
+    int parameter_dimension = model_->vectorize_params(true).size();
+    if (parameters.ncol() != parameter_dimension) {
+      std::ostringstream err;
+      err << "Parameter matrix had " << parameters.ncol()
+          << " columns, but " << parameter_dimension
+          << " were expected.";
+      report_error(err.str());
+    }
+    int nparticles = parameters.nrow();
+    if (nparticles <= 0) {
+      report_error("The number of particles must be positive.");
+    }
+    if (model_->time_dimension() == 0) {
+      report_error("The model must contain data before the particles can be "
+                   "set.");
+    }
+
+    parameter_particles_.resize(nparticles);
+    state_means_.resize(nparticles);
+    state_variances_.resize(nparticles);
+    log_weights_.resize(nparticles);
+    log_scale_.assign(parameter_dimension, true);
+    ScalarKalmanFilter &filter(model_->get_filter());
+    for (int i = 0; i < nparticles; ++i) {
+      parameter_particles_[i] = parameters.row(i);
+      for (int j = 0; j < parameter_dimension; ++j) {
+        if (!(parameters(i, j) > 0)) log_scale_[j] = false;
+      }
+      ParameterHolder holder(model_.get(), parameter_particles_[i]);
+      model_->kalman_filter();
+      state_means_[i] = filter.back().state_mean();
+      state_variances_[i] = filter.back().state_variance();
+      log_weights_[i] = 0;
+    }
+    // The filter holds results for the last particle, not the restored
+    // parameters.
+    filter.set_status(KalmanFilterBase::NOT_CURRENT);
+  }
+
+  double LiuWestStateSpaceFilter::kalman_step(
+      double y, bool missing, int t, Vector &state_mean,
+      SpdMatrix &state_variance) const {
+    Vector kalman_gain;
+    double forecast_variance, forecast_error;
+    return sparse_scalar_kalman_update(
+        y, state_mean, state_variance, kalman_gain, forecast_variance,
+        forecast_error, missing, model_->observation_matrix(t),
+        model_->observation_variance(t),
+        *model_->state_transition_matrix(t),
+        *model_->state_variance_matrix(t));
+  }
+
+  void LiuWestStateSpaceFilter::update(RNG &rng, double y, bool missing) {
+    if (parameter_particles_.empty()) {
+      report_error("Call set_particles() before update().");
+    }
+    int t = model_->time_dimension();
+    NEW(StateSpace::MultiplexedDoubleData, data_point)(y);
+    if (missing) {
+      data_point->set_missing_status(Data::completely_missing);
+      data_point->double_data_ptr(0)->set_missing_status(
+          Data::completely_missing);
+    }
+    model_->add_data(data_point);
+    model_->get_filter().set_status(KalmanFilterBase::NOT_CURRENT);
+    ParameterHolder original_parameters(model_.get(),
+                                        model_->vectorize_params(true));
+
+    int nparticles = number_of_particles();
+    if (missing) {
+      // No new information about the parameters, so each particle just
+      // moves forward in time.
+      for (int i = 0; i < nparticles; ++i) {
+        model_->unvectorize_params(parameter_particles_[i]);
+        kalman_step(y, true, t, state_means_[i], state_variances_[i]);
+      }
+      return;
+    }
+
+    //====== Step 1
+    // Compute the means and variance to be used in the kernel density
+    // estimate, and weight each kernel by the predictive density of y
+    // evaluated at the kernel mean.
+    std::vector<Vector> kernel_parameters(nparticles);
+    MvnSuf suf(parameter_particles_[0].size());
+    for (int i = 0; i < nparticles; ++i) {
+      kernel_parameters[i] = to_kernel_scale(parameter_particles_[i]);
+      suf.update_raw(kernel_parameters[i]);
+    }
+    Vector parameter_mean = suf.ybar();
+    double particle_weight = sqrt(1 - square(kernel_scale_factor_));
+    std::vector<Vector> kernel_means(nparticles);
+    Vector first_stage_loglike(nparticles, negative_infinity());
+    Vector kernel_weights(nparticles);
+    for (int i = 0; i < nparticles; ++i) {
+      kernel_means[i] = particle_weight * kernel_parameters[i]
+          + (1 - particle_weight) * parameter_mean;
+      try {
+        model_->unvectorize_params(from_kernel_scale(kernel_means[i]));
+        Vector state_mean = state_means_[i];
+        SpdMatrix state_variance = state_variances_[i];
+        first_stage_loglike[i] = kalman_step(
+            y, false, t, state_mean, state_variance);
+      } catch (...) {
+        first_stage_loglike[i] = negative_infinity();
+      }
+      if (!std::isfinite(first_stage_loglike[i])) {
+        first_stage_loglike[i] = negative_infinity();
+      }
+      kernel_weights[i] = log_weights_[i] + first_stage_loglike[i];
+    }
+    double max_log_weight = max(kernel_weights);
+    if (!std::isfinite(max_log_weight)) {
+      report_error("All particles have zero weight in "
+                   "LiuWestStateSpaceFilter::update.");
+    }
+    // The log predictive density of y is log sum_i w[i] p(y | particle i),
+    // with the first stage density standing in for p(y | particle i).
+    double log_predictive = lse(log_weights_ + first_stage_loglike)
+        - lse(log_weights_);
+    kernel_weights.normalize_logprob();
+    log_predictive_density_ += log_predictive;
+
+    SpdMatrix kernel_variance = suf.sample_var();
+    kernel_variance *= square(kernel_scale_factor_);
+    Cholesky kernel_cholesky(kernel_variance);
+    // Parameters that are constant across particles make the variance
+    // singular.  In that case the kernel smooths each parameter separately.
+    bool full_kernel = kernel_cholesky.is_pos_def();
+    Matrix kernel_root;
+    Vector kernel_sd;
+    if (full_kernel) {
+      kernel_root = kernel_cholesky.getL();
+    } else {
+      kernel_sd = sqrt(kernel_variance.diag());
+    }
+
+    //===== Step 2:
+    // Propose new parameters for each particle, advance the state
+    // distribution, and update the weights.
+    std::vector<Vector> new_parameter_particles(nparticles);
+    std::vector<Vector> new_state_means(nparticles);
+    std::vector<SpdMatrix> new_state_variances(nparticles);
+    Vector new_log_weights(nparticles);
+    // Every particle draws its parent from the same kernel weights.
+    CategoricalSampler kernel_sampler(kernel_weights, nparticles);
+    for (int i = 0; i < nparticles; ++i) {
+      int particle = kernel_sampler.draw(rng);
+      Vector proposal;
+      if (full_kernel) {
+        proposal = rmvn_L_mt(rng, kernel_means[particle], kernel_root);
+      } else {
+        proposal = kernel_means[particle];
+        for (int j = 0; j < proposal.size(); ++j) {
+          proposal[j] += rnorm_mt(rng, 0, kernel_sd[j]);
+        }
+      }
+      new_state_means[i] = state_means_[particle];
+      new_state_variances[i] = state_variances_[particle];
+      try {
+        new_parameter_particles[i] = from_kernel_scale(proposal);
+        model_->unvectorize_params(new_parameter_particles[i]);
+        new_log_weights[i] = kalman_step(
+            y, false, t, new_state_means[i], new_state_variances[i])
+            - first_stage_loglike[particle];
+      } catch (...) {
+        // The proposal was an illegal parameter value.  Keep right-sized
+        // values for the particle and give it zero weight.
+        new_parameter_particles[i] = parameter_particles_[particle];
+        new_log_weights[i] = negative_infinity();
+      }
+      if (!std::isfinite(new_log_weights[i])) {
+        new_log_weights[i] = negative_infinity();
+      }
+    }
+    std::swap(new_parameter_particles, parameter_particles_);
+    std::swap(new_state_means, state_means_);
+    std::swap(new_state_variances, state_variances_);
+    std::swap(new_log_weights, log_weights_);
+  }
+
+  Vector LiuWestStateSpaceFilter::particle_weights() const {
+    Vector ans = log_weights_;
+    ans.normalize_logprob();
+    return ans;
+  }
+
+  double LiuWestStateSpaceFilter::effective_sample_size() const {
+    Vector weights = particle_weights();
+    double sum_of_squares = weights.normsq();
+    return sum_of_squares > 0 ? 1.0 / sum_of_squares : 0.0;
+  }
+
+  Matrix LiuWestStateSpaceFilter::parameter_distribution(RNG *rng) const {
+    std::vector<Vector> particles = parameter_particles_;
+    if (rng) {
+      Resampler resampler(particle_weights(), false);
+      particles = resampler(parameter_particles_, -1, *rng);
+    }
+    Matrix ans(particles.size(), particles.empty() ? 0 : particles[0].size());
+    for (int i = 0; i < particles.size(); ++i) {
+      ans.row(i) = particles[i];
+    }
+    return ans;
+  }
+
+  Matrix LiuWestStateSpaceFilter::predicted_state_means() const {
+    Matrix ans(number_of_particles(), model_->state_dimension());
+    for (int i = 0; i < number_of_particles(); ++i) {
+      ans.row(i) = state_means_[i];
+    }
+    return ans;
+  }
+
+  Matrix LiuWestStateSpaceFilter::simulate_forecast(RNG &rng, int horizon) {
+    if (horizon < 0) {
+      report_error("simulate_forecast called with a negative horizon.");
+    }
+    int nparticles = number_of_particles();
+    Matrix ans(nparticles, horizon);
+    ParameterHolder original_parameters(model_.get(),
+                                        model_->vectorize_params(true));
+    Resampler resampler(particle_weights(), false);
+    std::vector<int> draws = resampler(nparticles, rng);
+    int T = model_->time_dimension();
+    for (int i = 0; i < nparticles; ++i) {
+      int particle = draws[i];
+      model_->unvectorize_params(parameter_particles_[particle]);
+      Vector state = rmvn_mt(rng, state_means_[particle],
+                             state_variances_[particle]);
+      for (int h = 0; h < horizon; ++h) {
+        if (h > 0) {
+          state = model_->simulate_next_state(rng, state, T + h);
+        }
+        ans(i, h) = model_->observation_matrix(T + h).dot(state)
+            + rnorm_mt(rng, 0, sqrt(model_->observation_variance(T + h)));
+      }
+    }
+    return ans;
+  }
+
+  Vector LiuWestStateSpaceFilter::to_kernel_scale(
+      const Vector &parameters) const {
+    Vector ans(parameters);
+    for (int j = 0; j < ans.size(); ++j) {
+      if (log_scale_[j]) ans[j] = log(ans[j]);
+    }
+    return ans;
+  }
+
+  Vector LiuWestStateSpaceFilter::from_kernel_scale(
+      const Vector &kernel_parameters) const {
+    Vector ans(kernel_parameters);
+    for (int j = 0; j < ans.size(); ++j) {
+      if (log_scale_[j]) ans[j] = exp(ans[j]);
+    }
+    return ans;
+  }
+
+}  // namespace BOOM
@@ -0,0 +1,143 @@
+#ifndef BOOM_STATE_SPACE_LIU_WEST_STATE_SPACE_FILTER_HPP_
+#define BOOM_STATE_SPACE_LIU_WEST_STATE_SPACE_FILTER_HPP_
+/*
+  Copyright (C) 2005-2024 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include <vector>
+#include "LinAlg/Matrix.hpp"
+#include "LinAlg/SpdMatrix.hpp"
+#include "LinAlg/Vector.hpp"
+#include "Models/StateSpace/StateSpaceModel.hpp"
+#include "distributions/rng.hpp"
+
+namespace BOOM {
+
+  // Updates the posterior distribution of a StateSpaceModel as new
+  // observations arrive, in constant time per observation, without re-running
+  // the Kalman filter or MCMC over the full history.
+  //
+  // The filter is a Liu and West (2001) particle filter with the state
+  // integrated out.  Each particle holds a parameter value along with the
+  // Kalman filter's one step predictive distribution of the state (the mean
+  // a[t] and variance P[t] held by the last filter node), so a new
+  // observation costs one Kalman filter step per particle.  Parameters are
+  // refreshed at each update by drawing from a kernel density estimate of
+  // the parameter distribution, which prevents the particles from collapsing
+  // onto a few parameter values.
+  //
+  // A typical use is to fit the model by MCMC, seed the filter with the MCMC
+  // draws using set_particles(), and then call update() as each new
+  // observation arrives.  Each observation is also appended to the model, so
+  // the particles can be refreshed periodically by re-running the MCMC on the
+  // full (or a rolling window of the) data and calling set_particles() again.
+  class LiuWestStateSpaceFilter {
+   public:
+    // Args:
+    //   model: The model to be filtered.  The model must have been given all
+    //     its state models.  Its parameters are restored after each call to
+    //     set_particles() or update().
+    //   kernel_scale_factor: The kernel density estimate of the parameters
+    //     has variance = kernel_scale_factor^2 *
+    //     sample_variance(parameter_particles).  Parameters that are positive
+    //     in every particle (e.g. variances) are smoothed on the log scale.
+    LiuWestStateSpaceFilter(const Ptr<StateSpaceModel> &model,
+                            double kernel_scale_factor = .05);
+
+    // Set the particle ensemble by running the Kalman filter over the data
+    // held by the model once for each set of parameters.  This must be called
+    // before update().
+    //
+    // Args:
+    //   parameters: An N x parameter_dimension matrix, where N is the number
+    //     of particles.  Row i is vectorize_params(true) for a draw of the
+    //     model parameters, e.g. from a previous MCMC run.
+    void set_particles(const Matrix &parameters);
+
+    // Update the particle distribution with a new observation, which is
+    // appended to the model's data.
+    //
+    // Args:
+    //   rng:  The random number generator to use for the update.
+    //   y:  The value of the new observation.
+    //   missing: If true then 'y' is ignored, and the particles simply move
+    //     forward one time period.
+    void update(RNG &rng, double y, bool missing = false);
+
+    int number_of_particles() const { return parameter_particles_.size(); }
+
+    // The number of observations in the model, including those added by
+    // update().
+    int time_dimension() const { return model_->time_dimension(); }
+
+    // The normalized particle weights.
+    Vector particle_weights() const;
+
+    // The effective number of particles implied by the particle weights.
+    double effective_sample_size() const;
+
+    // The sum over calls to update() of the log predictive density of each
+    // new observation.
+    double log_predictive_density() const { return log_predictive_density_; }
+
+    // Returns the current parameter distribution, with one particle per row.
+    //
+    // Args:
+    //   rng: If non-null then the particles are resampled with replacement
+    //     from the weighted particle distribution, so the output can be
+    //     viewed as an unweighted sample.  If null then the particles must be
+    //     interpreted in the context of particle_weights().
+    Matrix parameter_distribution(RNG *rng = &GlobalRng::rng) const;
+
+    // The mean of the one step predictive distribution of the state at time
+    // time_dimension() for each particle, with one particle per row.
+    Matrix predicted_state_means() const;
+
+    // Simulate from the posterior predictive distribution of the next
+    // 'horizon' observations.
+    //
+    // Returns:
+    //   A matrix with number_of_particles() rows and 'horizon' columns.  The
+    //   rows are draws from the resampled particle distribution, so they
+    //   carry equal weight.
+    Matrix simulate_forecast(RNG &rng, int horizon);
+
+   private:
+    // Advance the predictive distribution (state_mean, state_variance) by
+    // one Kalman filter step at time t, using the model's current
+    // parameters.  Returns the log predictive density of y.
+    double kalman_step(double y, bool missing, int t, Vector &state_mean,
+                       SpdMatrix &state_variance) const;
+
+    // Map parameters to and from the scale used by the kernel density
+    // estimate.
+    Vector to_kernel_scale(const Vector &parameters) const;
+    Vector from_kernel_scale(const Vector &kernel_parameters) const;
+
+    Ptr<StateSpaceModel> model_;
+    double kernel_scale_factor_;
+    std::vector<Vector> parameter_particles_;
+    std::vector<Vector> state_means_;
+    std::vector<SpdMatrix> state_variances_;
+    Vector log_weights_;
+    std::vector<bool> log_scale_;
+    double log_predictive_density_;
+  };
+
+}  // namespace BOOM
+
+#endif  // BOOM_STATE_SPACE_LIU_WEST_STATE_SPACE_FILTER_HPP_
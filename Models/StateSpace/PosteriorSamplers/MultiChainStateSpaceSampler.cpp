@@ -0,0 +1,135 @@
+/*
+  Copyright (C) 2005-2024 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include "Models/StateSpace/PosteriorSamplers/MultiChainStateSpaceSampler.hpp"
+#include <algorithm>
+#include "Models/PosteriorSamplers/PosteriorSampler.hpp"
+#include "cpputil/ThreadTools.hpp"
+#include "cpputil/report_error.hpp"
+
+namespace BOOM {
+
+  namespace {
+    void reseed_samplers(Model *model, RNG &seeding_rng) {
+      for (int i = 0; i < model->number_of_sampling_methods(); ++i) {
+        model->sampler(i)->set_seed(seeding_rng.next_bits());
+      }
+    }
+
+    // The un-normalized log posterior density at the model's current
+    // parameters.  The data enter through the Kalman filter likelihood, so
+    // this costs a filter run.
+    double log_posterior(ScalarStateSpaceModelBase *model) {
+      double ans = model->observation_model()->logpri();
+      for (int s = 0; s < model->number_of_state_models(); ++s) {
+        ans += model->state_model(s)->logpri();
+      }
+      return ans + model->log_likelihood();
+    }
+  }  // namespace
+
+  MultiChainStateSpaceSampler::MultiChainStateSpaceSampler(
+      const ScalarStateSpaceModelBase &prototype,
+      int number_of_chains,
+      RNG::RngIntType seed)
+      : monitor_(std::max<int>(number_of_chains, 1),
+                 prototype.vectorize_params(true).size()),
+        max_rhat_(-1),
+        min_effective_sample_size_(0),
+        check_interval_(100)
+  {
+    if (number_of_chains < 1) {
+      report_error("MultiChainStateSpaceSampler needs at least one chain.");
+    }
+    for (int c = 0; c < number_of_chains; ++c) {
+      Ptr<ScalarStateSpaceModelBase> chain(prototype.deepclone());
+      RNG seeding_rng(seed, c, RNG::PHILOX);
+      reseed_samplers(chain.get(), seeding_rng);
+      reseed_samplers(chain->observation_model(), seeding_rng);
+      for (int s = 0; s < chain->number_of_state_models(); ++s) {
+        reseed_samplers(chain->state_model(s), seeding_rng);
+      }
+      chains_.push_back(chain);
+    }
+  }
+
+  void MultiChainStateSpaceSampler::set_stopping_rule(
+      double max_rhat, double min_effective_sample_size, int check_interval) {
+    max_rhat_ = max_rhat;
+    min_effective_sample_size_ = min_effective_sample_size;
+    check_interval_ = std::max<int>(check_interval, 1);
+  }
+
+  void MultiChainStateSpaceSampler::set_telemetry(McmcTelemetry *telemetry,
+                                                  int report_every) {
+    reporters_.clear();
+    if (telemetry) {
+      for (int c = 0; c < chains_.size(); ++c) {
+        reporters_.emplace_back(telemetry, c, report_every);
+      }
+    }
+  }
+
+  void MultiChainStateSpaceSampler::run_block(int niter, bool record) {
+    global_thread_pool().parallel_for(
+        0, chains_.size(), 1, [this, niter, record](int c) {
+          ScalarStateSpaceModelBase *model = chains_[c].get();
+          McmcTelemetryReporter *reporter =
+              reporters_.empty() ? nullptr : &reporters_[c];
+          for (int i = 0; i < niter; ++i) {
+            model->sample_posterior();
+            if (record) {
+              monitor_.add(c, model->vectorize_params(true));
+            }
+            if (reporter && reporter->tick()) {
+              reporter->report(log_posterior(model));
+            }
+          }
+        });
+  }
+
+  int MultiChainStateSpaceSampler::run(int niter, int burn) {
+    burn = std::min<int>(std::max<int>(burn, 0), niter);
+    if (burn > 0) {
+      run_block(burn, false);
+    }
+    int iterations = burn;
+    while (iterations < niter) {
+      int block_size = std::min<int>(niter - iterations, check_interval_);
+      run_block(block_size, true);
+      iterations += block_size;
+      if (converged()) break;
+    }
+    return iterations;
+  }
+
+  bool MultiChainStateSpaceSampler::converged() const {
+    if (max_rhat_ <= 0 || monitor_.min_sample_size() < 2) {
+      return false;
+    }
+    Vector rhat = monitor_.rhat();
+    Vector ess = monitor_.effective_sample_size();
+    for (int i = 0; i < rhat.size(); ++i) {
+      if (!(rhat[i] <= max_rhat_) || ess[i] < min_effective_sample_size_) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+}  // namespace BOOM
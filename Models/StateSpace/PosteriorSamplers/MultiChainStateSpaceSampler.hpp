@@ -0,0 +1,117 @@
+#ifndef BOOM_STATE_SPACE_MULTI_CHAIN_STATE_SPACE_SAMPLER_HPP_
+#define BOOM_STATE_SPACE_MULTI_CHAIN_STATE_SPACE_SAMPLER_HPP_
+
+/*
+  Copyright (C) 2005-2024 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include <vector>
+#include "Models/StateSpace/StateSpaceModelBase.hpp"
+#include "distributions/rng.hpp"
+#include "Samplers/McmcTelemetry.hpp"
+#include "stats/mcmc_convergence.hpp"
+
+namespace BOOM {
+
+  // Runs several MCMC chains for the same scalar state space model in
+  // parallel, on the global thread pool, while tracking convergence
+  // diagnostics.
+  //
+  // Each chain is a deepclone() of a prototype model.  Cloning a state space
+  // model copies parameters, state, Kalman filters, and posterior samplers,
+  // but the clones share the prototype's data objects, so the observed data
+  // are held only once.  This requires that the posterior samplers treat the
+  // observed data as read only, which is the case for Gaussian observation
+  // models (e.g. StateSpaceModel and StateSpaceRegressionModel).  Models
+  // whose samplers write latent variables into their data objects must give
+  // each chain its own copy of the data.
+  //
+  // The samplers in each chain are reseeded from an RNG stream determined by
+  // (seed, chain index), so results are reproducible regardless of how the
+  // chains are scheduled.
+  class MultiChainStateSpaceSampler {
+   public:
+    // Args:
+    //   prototype: A model with posterior samplers assigned to the model, its
+    //     observation model, and its state models.  The prototype is cloned
+    //     but not otherwise used.
+    //   number_of_chains:  The number of chains to run.
+    //   seed:  The seed used to generate the RNG streams for the chains.
+    MultiChainStateSpaceSampler(const ScalarStateSpaceModelBase &prototype,
+                                int number_of_chains,
+                                RNG::RngIntType seed);
+
+    // Stop a call to run() early once every element of
+    // chain(c)->vectorize_params() has rhat() <= max_rhat and
+    // effective_sample_size() >= min_effective_sample_size.  The rule is
+    // checked every check_interval iterations.  A non-positive max_rhat
+    // disables early stopping.
+    void set_stopping_rule(double max_rhat,
+                           double min_effective_sample_size,
+                           int check_interval = 100);
+
+    // Publish the progress of each chain to 'telemetry' every report_every
+    // iterations, with the chain's log posterior.  The telemetry object is
+    // owned by the caller, and must outlive calls to run().  Passing nullptr
+    // turns reporting off.
+    void set_telemetry(McmcTelemetry *telemetry, int report_every = 100);
+
+    // Run each chain for (at most) niter iterations.  The first 'burn'
+    // iterations of the call are discarded; later draws are recorded in the
+    // convergence monitor.
+    //
+    // Returns:
+    //   The number of iterations run by each chain.
+    int run(int niter, int burn = 0);
+
+    int number_of_chains() const { return chains_.size(); }
+    ScalarStateSpaceModelBase *chain(int c) { return chains_[c].get(); }
+    const ScalarStateSpaceModelBase *chain(int c) const {
+      return chains_[c].get();
+    }
+
+    // Convergence diagnostics for the recorded draws, one element per model
+    // parameter.
+    Vector rhat() const { return monitor_.rhat(); }
+    Vector effective_sample_size() const {
+      return monitor_.effective_sample_size();
+    }
+    const McmcConvergenceMonitor &monitor() const { return monitor_; }
+
+    // Returns true if the stopping rule is satisfied by the draws recorded
+    // so far.
+    bool converged() const;
+
+   private:
+    // Run 'niter' iterations for each chain, recording draws only if
+    // 'record' is true.
+    void run_block(int niter, bool record);
+
+    std::vector<Ptr<ScalarStateSpaceModelBase>> chains_;
+    McmcConvergenceMonitor monitor_;
+    double max_rhat_;
+    double min_effective_sample_size_;
+    int check_interval_;
+
+    // One reporter per chain, so that iteration counts and rates persist
+    // across the blocks run by run().  Empty if telemetry is off.
+    std::vector<McmcTelemetryReporter> reporters_;
+  };
+
+}  // namespace BOOM
+
+#endif  // BOOM_STATE_SPACE_MULTI_CHAIN_STATE_SPACE_SAMPLER_HPP_
@@ -81,27 +81,32 @@ namespace BOOM {
 
   void SSLPS::impute_nonstate_latent_data() {
     const std::vector<Ptr<AugmentedData> > &data(model_->dat());
+    // The state contributions are computed serially, because the state models
+    // need not be safe to query from several threads at once.
+    Vector state_contribution(data.size());
     for (int t = 0; t < data.size(); ++t) {
-      Ptr<AugmentedData> dp = data[t];
-      double state_contribution =
+      state_contribution[t] =
           model_->observation_matrix(t).dot(model_->state(t));
-      for (int j = 0; j < dp->total_sample_size(); ++j) {
-        const BinomialRegressionData &observation(dp->binomial_data(j));
+    }
+    const Vector &beta(model_->observation_model()->Beta());
+    impute_latent_data_by_time(data.size(), [&](int t, RNG &rng) {
+      AugmentedData &data_point(*data[t]);
+      for (int j = 0; j < data_point.total_sample_size(); ++j) {
+        const BinomialRegressionData &observation(data_point.binomial_data(j));
         if (observation.missing() == Data::observed) {
           double precision_weighted_sum = 0;
           double total_precision = 0;
-          double regression_contribution =
-              model_->observation_model()->predict(observation.x());
+          double regression_contribution = observation.x().dot(beta);
           std::tie(precision_weighted_sum, total_precision) =
               data_imputer_.impute(
-                  rng(), observation.n(), observation.y(),
-                  state_contribution + regression_contribution);
-          dp->set_latent_data(precision_weighted_sum / total_precision,
-                              total_precision, j);
+                  rng, observation.n(), observation.y(),
+                  state_contribution[t] + regression_contribution);
+          data_point.set_latent_data(precision_weighted_sum / total_precision,
+                                     total_precision, j);
         }
       }
-      dp->set_state_model_offset(state_contribution);
-    }
+      data_point.set_state_model_offset(state_contribution[t]);
+    });
   }
 
   void SSLPS::clear_complete_data_sufficient_statistics() {
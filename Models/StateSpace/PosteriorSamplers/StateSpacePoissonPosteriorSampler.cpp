@@ -53,7 +53,8 @@ namespace BOOM {
       RNG &seeding_rng)
       : StateSpacePosteriorSampler(model, seeding_rng),
         model_(model),
-        observation_model_sampler_(observation_model_sampler) {
+        observation_model_sampler_(observation_model_sampler),
+        mixture_table_prepared_(false) {
     model_->register_data_observer(new StateSpace::PoissonSufstatManager(this));
     observation_model_sampler_->fix_latent_data(true);
   }
@@ -78,18 +79,41 @@ namespace BOOM {
 
   void SSPPS::impute_nonstate_latent_data() {
     const std::vector<Ptr<AugmentedData> > &data(model_->dat());
+    if (!mixture_table_prepared_) {
+      // Imputation only reads the shared mixture table once it holds an
+      // entry for every response, so it is safe to impute in parallel.
+      std::vector<int> responses;
+      for (const auto &data_point : data) {
+        for (int j = 0; j < data_point->total_sample_size(); ++j) {
+          const PoissonRegressionData &observation(
+              data_point->poisson_data(j));
+          if (observation.missing() == Data::observed) {
+            responses.push_back(observation.y());
+          }
+        }
+      }
+      PoissonDataImputer::prepare_mixture_table(responses);
+      mixture_table_prepared_ = true;
+    }
+    // The state contributions are computed serially, because the state models
+    // need not be safe to query from several threads at once.
+    Vector state_contribution(data.size());
     for (int t = 0; t < data.size(); ++t) {
-      Ptr<AugmentedData> dp = data[t];
-      if (dp->missing()) {
-        continue;
+      if (!data[t]->missing()) {
+        state_contribution[t] =
+            model_->observation_matrix(t).dot(model_->state(t));
       }
-      double state_contribution =
-          model_->observation_matrix(t).dot(model_->state(t));
-      for (int j = 0; j < dp->total_sample_size(); ++j) {
-        const PoissonRegressionData &observation(dp->poisson_data(j));
+    }
+    const Vector &beta(model_->observation_model()->Beta());
+    impute_latent_data_by_time(data.size(), [&](int t, RNG &rng) {
+      AugmentedData &data_point(*data[t]);
+      if (data_point.missing()) {
+        return;
+      }
+      for (int j = 0; j < data_point.total_sample_size(); ++j) {
+        const PoissonRegressionData &observation(data_point.poisson_data(j));
         if (observation.missing() == Data::observed) {
-          double regression_contribution =
-              model_->observation_model()->predict(observation.x());
+          double regression_contribution = observation.x().dot(beta);
 
           double internal_neglog_final_event_time = 0;
           double internal_mixture_mean = 0;
@@ -98,10 +122,10 @@ namespace BOOM {
           double external_mixture_mean = 0;
           double external_mixture_precision = 0;
           data_imputer_.impute(
-              rng(),
+              rng,
               observation.y(),
               observation.exposure(),
-              state_contribution + regression_contribution,
+              state_contribution[t] + regression_contribution,
               &internal_neglog_final_event_time,
               &internal_mixture_mean,
               &internal_mixture_precision,
@@ -119,12 +143,12 @@ namespace BOOM {
                 internal_mixture_precision;
             total_precision += internal_mixture_precision;
           }
-          dp->set_latent_data(precision_weighted_sum / total_precision,
-                              total_precision, j);
+          data_point.set_latent_data(precision_weighted_sum / total_precision,
+                                     total_precision, j);
         }
       }
-      dp->set_state_model_offset(state_contribution);
-    }
+      data_point.set_state_model_offset(state_contribution[t]);
+    });
   }
 
   void SSPPS::clear_complete_data_sufficient_statistics() {
@@ -66,6 +66,10 @@ namespace BOOM {
     StateSpacePoissonModel *model_;
     Ptr<PoissonRegressionSpikeSlabSampler> observation_model_sampler_;
     PoissonDataImputer data_imputer_;
+
+    // Set once the shared mixture table holds an entry for every observed
+    // response, after which latent data can be imputed in parallel.
+    bool mixture_table_prepared_;
   };
 }  // namespace BOOM
 
@@ -18,6 +18,9 @@
 */
 
 #include "Models/StateSpace/PosteriorSamplers/StateSpacePosteriorSampler.hpp"
+#include <algorithm>
+#include "LinAlg/Workspace.hpp"
+#include "Samplers/McmcProfiler.hpp"
 #include "TargetFun/TargetFun.hpp"
 #include "cpputil/math_utils.hpp"
 #include "numopt.hpp"
@@ -26,6 +29,11 @@ namespace BOOM {
 
   namespace {
     using SSPS = StateSpacePosteriorSampler;
+
+    // The number of shards used by impute_latent_data_by_time.  It is fixed,
+    // rather than tied to the number of threads, so that the random number
+    // streams (and hence the draws) do not depend on the thread count.
+    const int kMaxImputationShards = 64;
   }
 
   SSPS::StateSpacePosteriorSampler(StateSpaceModelBase *model, RNG &seeding_rng)
@@ -40,18 +48,24 @@ namespace BOOM {
   }
 
   void SSPS::draw() {
+    // Scratch objects taken from the thread's workspace during this iteration
+    // are returned to the pool when it ends.
+    WorkspaceScope scope;
     if (!latent_data_initialized_) {
       model_->impute_state(rng());
       latent_data_initialized_ = true;
       impute_nonstate_latent_data();
     }
-    // Multivariate state space models sometimes use proxies that don't have an
-    // explicit observation model.
-    if (model_->observation_model()) {
-      model_->observation_model()->sample_posterior();
-    }
-    for (int s = 0; s < model_->number_of_state_models(); ++s) {
-      model_->state_model(s)->sample_posterior();
+    {
+      ScopedPhaseTimer timer(McmcProfiler::kParameterDraws);
+      // Multivariate state space models sometimes use proxies that don't have
+      // an explicit observation model.
+      if (model_->observation_model()) {
+        model_->observation_model()->sample_posterior();
+      }
+      for (int s = 0; s < model_->number_of_state_models(); ++s) {
+        model_->state_model(s)->sample_posterior();
+      }
     }
     // The complete data sufficient statistics for the observation model and the
     // state models are updated when calling impute_state.  The non-state latent
@@ -76,6 +90,30 @@ namespace BOOM {
     return ans;
   }
 
+  void SSPS::impute_latent_data_by_time(
+      int number_of_time_points,
+      const std::function<void(int t, RNG &rng)> &impute) {
+    if (pool_.no_threads() || number_of_time_points < 2) {
+      for (int t = 0; t < number_of_time_points; ++t) {
+        impute(t, rng());
+      }
+      return;
+    }
+    const int number_of_shards =
+        std::min<int>(number_of_time_points, kMaxImputationShards);
+    RNG::RngIntType seed = seed_rng(rng());
+    pool_.parallel_for(0, number_of_shards, 1, [&](int shard) {
+      RNG shard_rng(seed, shard);
+      int begin = static_cast<long>(shard) * number_of_time_points
+          / number_of_shards;
+      int end = static_cast<long>(shard + 1) * number_of_time_points
+          / number_of_shards;
+      for (int t = begin; t < end; ++t) {
+        impute(t, shard_rng);
+      }
+    });
+  }
+
   void SSPS::Mstep() {
     for (int i = 0; i < model_->number_of_state_models(); ++i) {
       model_->state_model(i)->find_posterior_mode();
@@ -19,6 +19,8 @@
 #ifndef BOOM_STATE_SPACE_POSTERIOR_SAMPLER_HPP_
 #define BOOM_STATE_SPACE_POSTERIOR_SAMPLER_HPP_
 
+#include <functional>
+
 #include "Models/PosteriorSamplers/PosteriorSampler.hpp"
 #include "Models/StateSpace/StateSpaceModelBase.hpp"
 
@@ -72,6 +74,14 @@ namespace BOOM {
 
     void disable_threads() { pool_.set_number_of_threads(-1); }
 
+    // Impute non-state latent data (e.g. the weights in a Student T model or
+    // the mixture indicators in a logit or Poisson model) using the given
+    // number of threads.  A value of 0 or less imputes serially, which is the
+    // default.
+    void set_number_of_threads(int number_of_threads) {
+      pool_.set_number_of_threads(number_of_threads);
+    }
+
    protected:
     // Samplers for models with observation equations that are
     // conditionally normal can override this function to impute the
@@ -79,6 +89,20 @@ namespace BOOM {
     // no-op.
     virtual void impute_nonstate_latent_data() {}
 
+    // Call impute(t, rng) for t = 0, ..., number_of_time_points - 1.  If
+    // threads are enabled the time points are divided into a fixed set of
+    // contiguous shards, each with its own RNG seeded from rng(), so the
+    // draws do not depend on the number of threads.  Without threads each
+    // call uses rng() directly.
+    //
+    // 'impute' may be called concurrently for different values of t, so it
+    // must only modify data belonging to time t.  Anything that touches the
+    // state models (e.g. observation_matrix(t)) should be computed before
+    // calling this function.
+    void impute_latent_data_by_time(
+        int number_of_time_points,
+        const std::function<void(int t, RNG &rng)> &impute);
+
    private:
     // The M step in an EM algorithm for finding the posterior mode.
     // The Estep is provided by the model.  The Mstep is kept here
@@ -93,7 +117,7 @@ namespace BOOM {
     StateSpaceModelBase *model_;
     bool latent_data_initialized_;
 
-    ThreadWorkerPool pool_;
+    SharedThreadPool pool_;
   };
 }  // namespace BOOM
 #endif  // BOOM_STATE_SPACE_POSTERIOR_SAMPLER_HPP_
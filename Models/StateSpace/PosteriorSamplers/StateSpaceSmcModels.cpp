@@ -0,0 +1,132 @@
+// Copyright 2018 Google LLC. All Rights Reserved.
+/*
+  Copyright (C) 2005-2018 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#include "Models/StateSpace/PosteriorSamplers/StateSpaceSmcModels.hpp"
+#include <cmath>
+#include "cpputil/report_error.hpp"
+#include "distributions.hpp"
+
+namespace BOOM {
+
+  ScalarStateSpaceSmcModel::ScalarStateSpaceSmcModel(
+      ScalarStateSpaceModelBase *model)
+      : model_(model) {
+    if (!model_) {
+      report_error("ScalarStateSpaceSmcModel needs a non-null model.");
+    }
+    // Simulating state errors must use the marginal distribution of each
+    // state model, rather than the latent variable representations used for
+    // MCMC.
+    model_->set_state_model_behavior(StateModel::MARGINAL);
+  }
+
+  int ScalarStateSpaceSmcModel::state_dimension() const {
+    return model_->state_dimension();
+  }
+
+  void ScalarStateSpaceSmcModel::simulate_initial_state(
+      RNG &rng, VectorView state) const {
+    model_->simulate_initial_state(rng, state);
+  }
+
+  void ScalarStateSpaceSmcModel::simulate_transition(
+      RNG &rng, const ConstVectorView &previous_state, VectorView next_state,
+      int t) const {
+    // Work one state model at a time.  The model's own simulate_next_state()
+    // assembles a block diagonal transition matrix in a workspace shared by
+    // all callers, which would race when particles are moved in parallel.
+    for (int s = 0; s < model_->number_of_state_models(); ++s) {
+      VectorView next(model_->state_component(next_state, s));
+      const StateModel *state_model = model_->state_model(s);
+      next = (*state_model->state_transition_matrix(t - 1)) *
+             model_->state_component(previous_state, s);
+      Vector error(next.size(), 0.0);
+      state_model->simulate_state_error(rng, VectorView(error), t - 1);
+      next += error;
+    }
+  }
+
+  double ScalarStateSpaceSmcModel::state_contribution(
+      const ConstVectorView &state, int t) const {
+    if (t < 0 || t >= model_->time_dimension()) {
+      report_error("Add the observation for each time point to the model "
+                   "before filtering it.");
+    }
+    return model_->observation_matrix(t).dot(state);
+  }
+
+  //===========================================================================
+  StateSpaceSmcModel::StateSpaceSmcModel(const Ptr<StateSpaceModel> &model)
+      : ScalarStateSpaceSmcModel(model.get()), model_(model) {}
+
+  double StateSpaceSmcModel::log_observation_density(
+      const ConstVectorView &state, int t) const {
+    double mu = state_contribution(state, t);
+    if (model_->is_missing_observation(t)) {
+      return 0.0;
+    }
+    return dnorm(model_->adjusted_observation(t), mu,
+                 sqrt(model_->observation_variance(t)), true);
+  }
+
+  //===========================================================================
+  StateSpacePoissonSmcModel::StateSpacePoissonSmcModel(
+      const Ptr<StateSpacePoissonModel> &model)
+      : ScalarStateSpaceSmcModel(model.get()), model_(model) {}
+
+  double StateSpacePoissonSmcModel::log_observation_density(
+      const ConstVectorView &state, int t) const {
+    double state_eta = state_contribution(state, t);
+    if (model_->is_missing_observation(t)) {
+      return 0.0;
+    }
+    double ans = 0;
+    const PoissonRegressionModel *regression = model_->observation_model();
+    for (int j = 0; j < model_->total_sample_size(t); ++j) {
+      const PoissonRegressionData &data(model_->data(t, j));
+      if (data.missing() != Data::observed) continue;
+      double eta = state_eta + regression->predict(data.x());
+      ans += dpois(data.y(), data.exposure() * exp(eta), true);
+    }
+    return ans;
+  }
+
+  //===========================================================================
+  StateSpaceLogitSmcModel::StateSpaceLogitSmcModel(
+      const Ptr<StateSpaceLogitModel> &model)
+      : ScalarStateSpaceSmcModel(model.get()), model_(model) {}
+
+  double StateSpaceLogitSmcModel::log_observation_density(
+      const ConstVectorView &state, int t) const {
+    double state_eta = state_contribution(state, t);
+    if (model_->is_missing_observation(t)) {
+      return 0.0;
+    }
+    double ans = 0;
+    const BinomialLogitModel *regression = model_->observation_model();
+    for (int j = 0; j < model_->total_sample_size(t); ++j) {
+      const BinomialRegressionData &data(model_->data(t, j));
+      if (data.missing() != Data::observed) continue;
+      double eta = state_eta + regression->predict(data.x());
+      ans += dbinom(data.y(), data.n(), plogis(eta, 0, 1, true, false), true);
+    }
+    return ans;
+  }
+
+}  // namespace BOOM
@@ -0,0 +1,98 @@
+// Copyright 2018 Google LLC. All Rights Reserved.
+/*
+  Copyright (C) 2005-2018 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#ifndef BOOM_STATE_SPACE_SMC_MODELS_HPP_
+#define BOOM_STATE_SPACE_SMC_MODELS_HPP_
+
+#include "Models/StateSpace/StateSpaceLogitModel.hpp"
+#include "Models/StateSpace/StateSpaceModel.hpp"
+#include "Models/StateSpace/StateSpacePoissonModel.hpp"
+#include "Samplers/SequentialMonteCarlo.hpp"
+
+namespace BOOM {
+
+  // Adapters exposing scalar state space models to a
+  // SequentialMonteCarloFilter, so the state distribution of non-Gaussian
+  // models can be updated as new observations arrive without re-running MCMC.
+  //
+  // The state dynamics come from the model's state models, and the
+  // observation density is the model's own likelihood (rather than the
+  // conditionally Gaussian data augmentation used by the MCMC samplers).  The
+  // model parameters are read at each call, so they must not be changed while
+  // a multi-threaded filter is running.  New observations are added to the
+  // model itself before calling SequentialMonteCarloFilter::update().
+  class ScalarStateSpaceSmcModel : public SmcModel {
+   public:
+    explicit ScalarStateSpaceSmcModel(ScalarStateSpaceModelBase *model);
+    int state_dimension() const override;
+    void simulate_initial_state(RNG &rng, VectorView state) const override;
+    void simulate_transition(RNG &rng, const ConstVectorView &previous_state,
+                             VectorView next_state, int t) const override;
+
+   protected:
+    // The contribution of the state to the linear predictor at time t.
+    // Reports an error if t is past the end of the model's data.
+    double state_contribution(const ConstVectorView &state, int t) const;
+
+   private:
+    ScalarStateSpaceModelBase *model_;
+  };
+
+  //---------------------------------------------------------------------------
+  // The Gaussian observation density of a StateSpaceModel.  Time points with
+  // several observations are summarized by their mean, so the log density is
+  // correct up to a constant that does not depend on the state.
+  class StateSpaceSmcModel : public ScalarStateSpaceSmcModel {
+   public:
+    explicit StateSpaceSmcModel(const Ptr<StateSpaceModel> &model);
+    double log_observation_density(const ConstVectorView &state,
+                                   int t) const override;
+
+   private:
+    Ptr<StateSpaceModel> model_;
+  };
+
+  //---------------------------------------------------------------------------
+  // y[t, j] ~ Poisson(exposure[t, j] * exp(Z[t]' state + beta' x[t, j])).
+  class StateSpacePoissonSmcModel : public ScalarStateSpaceSmcModel {
+   public:
+    explicit StateSpacePoissonSmcModel(
+        const Ptr<StateSpacePoissonModel> &model);
+    double log_observation_density(const ConstVectorView &state,
+                                   int t) const override;
+
+   private:
+    Ptr<StateSpacePoissonModel> model_;
+  };
+
+  //---------------------------------------------------------------------------
+  // y[t, j] ~ Binomial(n[t, j], logit^{-1}(Z[t]' state + beta' x[t, j])).
+  class StateSpaceLogitSmcModel : public ScalarStateSpaceSmcModel {
+   public:
+    explicit StateSpaceLogitSmcModel(const Ptr<StateSpaceLogitModel> &model);
+    double log_observation_density(const ConstVectorView &state,
+                                   int t) const override;
+
+   private:
+    Ptr<StateSpaceLogitModel> model_;
+  };
+
+}  // namespace BOOM
+
+#endif  // BOOM_STATE_SPACE_SMC_MODELS_HPP_
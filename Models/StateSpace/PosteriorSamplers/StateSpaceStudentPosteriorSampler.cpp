@@ -59,24 +59,32 @@ namespace BOOM {
 
   void SSSPS::impute_nonstate_latent_data() {
     const std::vector<Ptr<AugmentedData>> &data(model_->dat());
+    // The state contributions are computed serially, because the state models
+    // need not be safe to query from several threads at once.
+    Vector state_contribution(data.size());
     for (int t = 0; t < data.size(); ++t) {
-      Ptr<AugmentedData> dp = data[t];
-      double state_contribution =
+      state_contribution[t] =
           model_->observation_matrix(t).dot(model_->state(t));
-      for (int j = 0; j < dp->total_sample_size(); ++j) {
-        const RegressionData &observation(dp->regression_data(j));
+    }
+    const TRegressionModel *observation_model = model_->observation_model();
+    const Vector &beta(observation_model->Beta());
+    double sigma = observation_model->sigma();
+    double nu = observation_model->nu();
+    impute_latent_data_by_time(data.size(), [&](int t, RNG &rng) {
+      AugmentedData &data_point(*data[t]);
+      for (int j = 0; j < data_point.total_sample_size(); ++j) {
+        const RegressionData &observation(data_point.regression_data(j));
         if (observation.missing() == Data::observed) {
-          double regression_contribution =
-              model_->observation_model()->predict(observation.x());
+          double regression_contribution = observation.x().dot(beta);
           double weight = data_imputer_.impute(
-              rng(),
-              observation.y() - regression_contribution - state_contribution,
-              model_->observation_model()->sigma(),
-              model_->observation_model()->nu());
-          dp->set_weight(weight, j);
+              rng,
+              observation.y() - regression_contribution
+              - state_contribution[t],
+              sigma, nu);
+          data_point.set_weight(weight, j);
         }
       }
-    }
+    });
   }
 
   void SSSPS::clear_complete_data_sufficient_statistics() {
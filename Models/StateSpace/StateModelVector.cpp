@@ -108,6 +108,16 @@ namespace BOOM {
                             start + size - 1);
     }
 
+    ConstSubMatrix StateModelVectorBase::state_error_covariance_component(
+        const Matrix &full_covariance, int state) const {
+      int row_start = state_positions_[state];
+      int nrow = state_model(state)->state_dimension();
+      int col_start = state_error_positions_[state];
+      int ncol = state_model(state)->state_error_dimension();
+      return ConstSubMatrix(full_covariance, row_start, row_start + nrow - 1,
+                            col_start, col_start + ncol - 1);
+    }
+
     ConstSubMatrix StateModelVectorBase::full_state_subcomponent(
         const Matrix &state, int state_model_index) const {
       int start = state_positions_[state_model_index];
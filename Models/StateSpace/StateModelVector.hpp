@@ -119,6 +119,21 @@ namespace BOOM {
       ConstSubMatrix state_error_variance_component(
           const SpdMatrix &full_error_variance, int state_model_index) const;
 
+      //----------------------------------------------------------------------
+      // The block of a state by state error covariance matrix (e.g. Cov(state,
+      // state error)) corresponding to a specific state model.
+      //
+      // Args:
+      //   full_covariance: A matrix with state_dimension() rows and
+      //     state_error_dimension() columns.
+      //   state_model_index: The index of the desired state model.
+      //
+      // Returns:
+      //   The block of full_covariance whose rows belong to the state, and
+      //   whose columns belong to the state errors, of state_model_index.
+      ConstSubMatrix state_error_covariance_component(
+          const Matrix &full_covariance, int state_model_index) const;
+
       //----------------------------------------------------------------------
       // The complete state vector (across time, so the return value is a
       // matrix) for a specified state component.
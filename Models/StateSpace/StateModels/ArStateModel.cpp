@@ -83,6 +83,51 @@ namespace BOOM {
         "of the EM algorithm.");
   }
 
+  //======================================================================
+  // The model parameters are the included AR coefficients followed by sigsq.
+  void ArStateModel::increment_expected_gradient(
+      VectorView gradient, int t, const ConstVectorView &state_error_mean,
+      const ConstSubMatrix &state_error_variance) {
+    if (gradient.size() != Phi_prm()->inc().nvars() + 1 ||
+        state_error_mean.size() != 1 || state_error_variance.nrow() != 1 ||
+        state_error_variance.ncol() != 1) {
+      report_error(
+          "Wrong size arguments to ArStateModel::"
+          "increment_expected_gradient.");
+    }
+    double mean = state_error_mean[0];
+    double var = state_error_variance(0, 0);
+    double sigsq = ArModel::sigsq();
+    gradient[gradient.size() - 1] +=
+        (-.5 / sigsq) + .5 * (var + mean * mean) / (sigsq * sigsq);
+  }
+
+  //======================================================================
+  // The complete data log likelihood contains -(alpha[t+1][0] - phi' *
+  // alpha[t])^2 / (2 * sigsq), whose derivative with respect to phi is
+  // error[t] * alpha[t] / sigsq.
+  void ArStateModel::increment_expected_transition_gradient(
+      VectorView gradient, int t, const ConstVectorView &state_mean,
+      const ConstVectorView &state_error_mean,
+      const ConstSubMatrix &state_error_covariance) {
+    const Selector &included(Phi_prm()->inc());
+    if (gradient.size() != included.nvars() + 1 ||
+        state_mean.size() != state_dimension() ||
+        state_error_mean.size() != 1 ||
+        state_error_covariance.nrow() != state_dimension() ||
+        state_error_covariance.ncol() != 1) {
+      report_error(
+          "Wrong size arguments to ArStateModel::"
+          "increment_expected_transition_gradient.");
+    }
+    double sigsq = ArModel::sigsq();
+    for (int i = 0; i < included.nvars(); ++i) {
+      int lag = included.indx(i);
+      gradient[i] += (state_error_mean[0] * state_mean[lag]
+                      + state_error_covariance(lag, 0)) / sigsq;
+    }
+  }
+
   //======================================================================
   void ArStateModel::simulate_state_error(RNG &rng, VectorView eta,
                                           int t) const {
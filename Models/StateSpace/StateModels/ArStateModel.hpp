@@ -67,6 +67,18 @@ namespace BOOM {
         int t, const ConstVectorView &error_mean,
         const ConstSubMatrix &error_variance) override;
 
+    // The gradient with respect to sigsq.  The gradient with respect to the
+    // AR coefficients is handled by increment_expected_transition_gradient.
+    void increment_expected_gradient(
+        VectorView gradient, int t, const ConstVectorView &state_error_mean,
+        const ConstSubMatrix &state_error_variance) override;
+
+    bool transition_depends_on_parameters() const override { return true; }
+    void increment_expected_transition_gradient(
+        VectorView gradient, int t, const ConstVectorView &state_mean,
+        const ConstVectorView &state_error_mean,
+        const ConstSubMatrix &state_error_covariance) override;
+
     void simulate_state_error(RNG &rng, VectorView eta, int t) const override;
 
     using StateModel::simulate;
@@ -77,6 +89,7 @@ namespace BOOM {
     Ptr<SparseMatrixBlock> state_error_variance(int t) const override;
 
     SparseVector observation_matrix(int t) const override;
+    bool is_time_invariant() const override { return true; }
 
     Vector initial_state_mean() const override;
     SpdMatrix initial_state_variance() const override;
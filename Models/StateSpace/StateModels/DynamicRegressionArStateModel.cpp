@@ -230,7 +230,9 @@ namespace BOOM {
     int pos = 0;
     int lags = coefficient_transition_model_[0]->number_of_lags();
     for (int i = 0; i < x.size(); ++i) {
-      ans[pos] = x[i];
+      if (x[i] != 0.0) {
+        ans[pos] = x[i];
+      }
       pos += lags;
     }
     return ans;
@@ -37,7 +37,7 @@ namespace BOOM {
     setup_models_and_transition_variance_matrix();
     sparse_predictor_vectors_.reserve(nrow(X));
     for (int i = 0; i < nrow(X); ++i) {
-      sparse_predictor_vectors_.push_back(SparseVector(X.row(i)));
+      sparse_predictor_vectors_.push_back(sparsify(X.row(i)));
       sparse_predictor_matrices_.push_back(
           new DenseMatrix(Matrix(1, xdim_, X.row(i))));
     }
@@ -55,7 +55,7 @@ namespace BOOM {
       const Matrix &X(predictors[i]);
       sparse_predictor_matrices_.push_back(new DenseMatrix(X));
       for (int j = 0; j < X.nrow(); ++j) {
-        sparse_predictor_vectors_.push_back(SparseVector(X.row(j)));
+        sparse_predictor_vectors_.push_back(sparsify(X.row(j)));
       }
     }
     compute_predictor_variance();
@@ -258,7 +258,7 @@ namespace BOOM {
       report_error("Forecast data has the wrong number of columns");
     }
     for (int i = 0; i < nrow(predictors); ++i) {
-      sparse_predictor_vectors_.push_back(SparseVector(predictors.row(i)));
+      sparse_predictor_vectors_.push_back(sparsify(predictors.row(i)));
       sparse_predictor_matrices_.push_back(
           new DenseMatrix(Matrix(1, xdim_, predictors.row(i))));
     }
@@ -278,7 +278,7 @@ namespace BOOM {
             "number of columns.");
       }
       sparse_predictor_matrices_.push_back(predictor_matrix);
-      sparse_predictor_vectors_.push_back(SparseVector(predictors[t].row(0)));
+      sparse_predictor_vectors_.push_back(sparsify(predictors[t].row(0)));
     }
   }
 
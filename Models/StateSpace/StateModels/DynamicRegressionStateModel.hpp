@@ -36,6 +36,9 @@ namespace BOOM {
   // by a set of time varying regression coefficients.
   //
   // The observation matrix at time t is the vector of predictors x[t].
+  // Only the nonzero elements of x[t] are stored, so the cost of a Kalman
+  // filter update grows with the number of nonzero predictors rather than
+  // with the full dimension of x[t].
   // The transition matrix is the identity.
   // The RQR matrix is a diagonal matrix of sigma^2 (with a different
   // variance per coefficient).
@@ -20,6 +20,7 @@
 #include "Models/StateSpace/StateModels/Holiday.hpp"
 #include <algorithm>
 #include <cassert>
+#include <sstream>
 #include "cpputil/report_error.hpp"
 
 namespace BOOM {
@@ -386,4 +387,50 @@ namespace BOOM {
     return NULL;
   }
 
+  //===========================================================================
+  HolidayCalendar::HolidayCalendar(const Date &time_zero)
+      : time_zero_(time_zero) {}
+
+  void HolidayCalendar::add_holiday(const Ptr<Holiday> &holiday) {
+    holidays_.push_back(holiday);
+    table_.clear();
+  }
+
+  void HolidayCalendar::set_time_zero(const Date &time_zero) {
+    time_zero_ = time_zero;
+    table_.clear();
+  }
+
+  void HolidayCalendar::extend(int max_time) {
+    int old_size = table_.size();
+    if (max_time <= old_size) return;
+    table_.reserve(max_time);
+    for (int t = old_size; t < max_time; ++t) {
+      table_.push_back(lookup(t));
+    }
+  }
+
+  HolidayCalendar::Entry HolidayCalendar::lookup(int t) const {
+    Entry ans = {-1, -1};
+    Date date = time_zero_ + t;
+    for (int h = 0; h < holidays_.size(); ++h) {
+      if (holidays_[h]->active(date)) {
+        // It is possible (but rare) for multiple holidays to be active on the
+        // same date.
+        if (ans.holiday >= 0) {
+          std::ostringstream err;
+          err << "More than one holiday is active on " << date
+              << ".  This violates a model assumption that only one"
+              << " holiday is active at a time.  If you really want to allow"
+              << " this behavior, please place the co-occurring holidays in "
+              << "different holiday state models.";
+          report_error(err.str());
+        }
+        ans.holiday = h;
+        ans.day = holidays_[h]->days_into_influence_window(date);
+      }
+    }
+    return ans;
+  }
+
 }  // namespace BOOM
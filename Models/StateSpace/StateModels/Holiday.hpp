@@ -23,6 +23,7 @@
 #include <map>
 #include <vector>
 #include "cpputil/Date.hpp"
+#include "cpputil/Ptr.hpp"
 #include "cpputil/RefCounted.hpp"
 
 namespace BOOM {
@@ -360,6 +361,73 @@ namespace BOOM {
         : FixedDateHoliday(Dec, 25, days_before, days_after) {}
   };
 
+  //===========================================================================
+  // A table recording which of a collection of holidays is active at each time
+  // point of a daily time series, and how far into its influence window the
+  // active holiday is.
+  //
+  // Deciding whether a holiday is active means computing the holiday's date,
+  // which for moving holidays (Easter, Super Bowl Sunday, ...) involves a fair
+  // amount of calendar arithmetic.  State models consult the holidays for each
+  // time point on each pass of the Kalman filter, so the answers are
+  // tabulated once by extend() and looked up thereafter.  Time points outside
+  // the tabulated range are computed on demand.
+  //
+  // At most one holiday in the calendar may be active at any time point.
+  class HolidayCalendar {
+   public:
+    // Args:
+    //   time_zero:  The date corresponding to time index t = 0.
+    explicit HolidayCalendar(const Date &time_zero);
+
+    // Adding a holiday or changing time zero clears the table.
+    void add_holiday(const Ptr<Holiday> &holiday);
+    void set_time_zero(const Date &time_zero);
+
+    // Tabulate time points 0, 1, ..., max_time - 1.  Typically max_time covers
+    // both the training data and the forecast horizon.  Calling extend() with
+    // a value no larger than the current table size does nothing.
+    void extend(int max_time);
+
+    // The number of holidays in the calendar.
+    int number_of_holidays() const { return holidays_.size(); }
+
+    // The holiday with the given index, or nullptr if index is out of range.
+    const Holiday *holiday(int index) const {
+      return (index >= 0 && index < holidays_.size()) ? holidays_[index].get()
+                                                     : nullptr;
+    }
+
+    // The index of the holiday active at time t, or -1 if no holiday is
+    // active.
+    int which_holiday(int t) const {
+      return (t >= 0 && t < table_.size()) ? table_[t].holiday
+                                           : lookup(t).holiday;
+    }
+
+    // The number of days into the influence window of the holiday active at
+    // time t, or -1 if no holiday is active.
+    int which_day(int t) const {
+      return (t >= 0 && t < table_.size()) ? table_[t].day : lookup(t).day;
+    }
+
+    // The number of tabulated time points.
+    int size() const { return table_.size(); }
+
+   private:
+    struct Entry {
+      int holiday;
+      int day;
+    };
+
+    // Compute the table entry for time t directly from the holidays.
+    Entry lookup(int t) const;
+
+    Date time_zero_;
+    std::vector<Ptr<Holiday>> holidays_;
+    std::vector<Entry> table_;
+  };
+
 }  // namespace BOOM
 
 #endif  // BOOM_HOLIDAY_HPP_
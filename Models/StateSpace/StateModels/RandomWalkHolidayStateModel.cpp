@@ -26,7 +26,8 @@
 namespace BOOM {
   typedef RandomWalkHolidayStateModel RWHSM;
   RWHSM::RandomWalkHolidayStateModel(const Ptr<Holiday> &holiday, const Date &time_zero)
-      : holiday_(holiday), time_zero_(time_zero) {
+      : holiday_(holiday), time_zero_(time_zero), calendar_(time_zero) {
+    calendar_.add_holiday(holiday);
     int dim = holiday->maximum_window_width();
     initial_state_mean_.resize(dim);
     initial_state_variance_.resize(dim);
@@ -45,24 +46,26 @@ namespace BOOM {
 
   void RWHSM::observe_state(const ConstVectorView &then,
                             const ConstVectorView &now, int time_now) {
-    Date today = time_zero_ + time_now;
-    if (holiday_->active(today)) {
-      int position = holiday_->days_into_influence_window(today);
+    int position = calendar_.which_day(time_now);
+    if (position >= 0) {
       double delta = now[position] - then[position];
       suf()->update_raw(delta);
     }
   }
 
+  void RWHSM::observe_time_dimension(int max_time) {
+    calendar_.extend(max_time);
+  }
+
   uint RWHSM::state_dimension() const {
     return holiday_->maximum_window_width();
   }
 
   void RWHSM::simulate_state_error(RNG &rng, VectorView eta, int t) const {
     assert(eta.size() == state_dimension());
-    Date next = time_zero_ + t + 1;
     eta = 0;
-    if (holiday_->active(next)) {
-      int position = holiday_->days_into_influence_window(next);
+    int position = calendar_.which_day(t + 1);
+    if (position >= 0) {
       eta[position] = rnorm_mt(rng, 0, sigma());
     }
   }
@@ -74,9 +77,8 @@ namespace BOOM {
   Ptr<SparseMatrixBlock> RWHSM::state_variance_matrix(int t) const {
     // The relevant variance matrix is for the value of the state at the next
     // time period.
-    Date next = time_zero_ + t + 1;
-    if (holiday_->active(next)) {
-      int position = holiday_->days_into_influence_window(next);
+    int position = calendar_.which_day(t + 1);
+    if (position >= 0) {
       return active_state_variance_matrix_[position];
     }
     return zero_state_variance_matrix_;
@@ -91,10 +93,9 @@ namespace BOOM {
   }
 
   SparseVector RWHSM::observation_matrix(int t) const {
-    Date now = time_zero_ + t;
     SparseVector ans(state_dimension());
-    if (holiday_->active(now)) {
-      int position = holiday_->days_into_influence_window(now);
+    int position = calendar_.which_day(t);
+    if (position >= 0) {
       ans[position] = 1.0;
     }
     return ans;
@@ -128,6 +129,9 @@ namespace BOOM {
     initial_state_variance_ = Sigma;
   }
 
-  void RWHSM::set_time_zero(const Date &time_zero) { time_zero_ = time_zero; }
+  void RWHSM::set_time_zero(const Date &time_zero) {
+    time_zero_ = time_zero;
+    calendar_.set_time_zero(time_zero);
+  }
 
 }  // namespace BOOM
@@ -67,6 +67,10 @@ namespace BOOM {
     void observe_state(const ConstVectorView &then, const ConstVectorView &now,
                        int time_now) override;
 
+    // Tabulates the holiday's influence window for time points 0, ...,
+    // max_time - 1, so the model matrices can be found by table lookup.
+    void observe_time_dimension(int max_time) override;
+
     uint state_dimension() const override;
     uint state_error_dimension() const override { return 1; }
     void simulate_state_error(RNG &rng, VectorView eta, int t) const override;
@@ -91,6 +95,9 @@ namespace BOOM {
    private:
     Ptr<Holiday> holiday_;
     Date time_zero_;
+
+    // Records the position in the holiday window at each time point.
+    HolidayCalendar calendar_;
     Vector initial_state_mean_;
     SpdMatrix initial_state_variance_;
     Ptr<IdentityMatrix> identity_transition_matrix_;
@@ -32,46 +32,22 @@ namespace BOOM {
 
   Impl::RegressionHolidayBaseImpl(const Date &time_of_first_observation,
                                   const Ptr<UnivParams> &residual_variance)
-      : time_of_first_observation_(time_of_first_observation),
-        residual_variance_(residual_variance),
+      : residual_variance_(residual_variance),
         state_transition_matrix_(new IdentityMatrix(1)),
         state_variance_matrix_(new ZeroMatrix(1)),
         state_error_expander_(new IdentityMatrix(1)),
         state_error_variance_(new ZeroMatrix(1)),
+        calendar_(time_of_first_observation),
         initial_state_mean_(1, 1.0),
         initial_state_variance_(1, 0.0) {
   }
 
   void Impl::observe_time_dimension(int max_time) {
-    if (which_holiday_.size() == max_time) return;
-    Date date = time_of_first_observation_;
-    which_holiday_.resize(max_time);
-    which_day_.resize(max_time);
-    for (int t = 0; t < max_time; ++t, ++date) {
-      which_holiday_[t] = -1;
-      which_day_[t] = -1;
-      for (int h = 0; h < holidays_.size(); ++h) {
-        if (holidays_[h]->active(date)) {
-          // It is possible (but rare) for multiple holidays to be active on the
-          // same date.
-          if (which_holiday_[t] >= 0) {
-            std::ostringstream err;
-            err << "More than one holiday is active on " << date
-                << ".  This violates a model assumption that only one"
-                << " holiday is active at a time.  If you really want to allow"
-                << " this behavior, please place the co-occurring holidays in "
-                << "different holiday state models.";
-            report_error(err.str());
-          }
-          which_holiday_[t] = h;
-          which_day_[t] = holidays_[h]->days_into_influence_window(date);
-        }
-      }
-    }
+    calendar_.extend(max_time);
   }
 
   void Impl::add_holiday(const Ptr<Holiday> &holiday) {
-    holidays_.push_back(holiday);
+    calendar_.add_holiday(holiday);
   }
 
   Ptr<UnivParams> Impl::extract_residual_variance_parameter(
@@ -65,9 +65,7 @@ namespace BOOM {
 
     // Add a holiday to the set of holidays represented by the model.
     void add_holiday(const Ptr<Holiday> &holiday);
-    const Holiday *holiday(int t) const {
-      return (t >= 0 && t < holidays_.size()) ? holidays_[t].get() : nullptr;
-    }
+    const Holiday *holiday(int t) const { return calendar_.holiday(t); }
 
     // The state of a regression model is just the number 1.  This state gets
     // multiplied by Z_t (observation_matrix) containing the results of the
@@ -104,22 +102,20 @@ namespace BOOM {
 
     // The index of the holiday model active at time t.
     //
-    // This function assumes that holidays have been added using add_holiday(),
-    // and that observe_time_dimension() has been called with a number larger
-    // than t.
-    int which_holiday(int t) const {
-      return (t >= 0 && t < which_holiday_.size()) ? which_holiday_[t] : -1;
-    }
+    // This function assumes that holidays have been added using add_holiday().
+    // It is a table lookup if observe_time_dimension() has been called with a
+    // number larger than t.  Otherwise the answer is computed from the
+    // holidays, which is much slower.
+    int which_holiday(int t) const { return calendar_.which_holiday(t); }
 
     // The number of days into the influence window of the active holiday at
     // time t, or -1 if no holiday is active at time t.
     //
-    // This function assumes that holidays have been added using add_holiday(),
-    // and that observe_time_dimension() has been called with a number larger
-    // than t.
-    int which_day(int t) const {
-      return (t >= 0 && t < which_day_.size()) ? which_day_[t] : -1;
-    }
+    // This function assumes that holidays have been added using add_holiday().
+    // It is a table lookup if observe_time_dimension() has been called with a
+    // number larger than t.  Otherwise the answer is computed from the
+    // holidays, which is much slower.
+    int which_day(int t) const { return calendar_.which_day(t); }
 
     const Vector &initial_state_mean() const { return initial_state_mean_; }
     const SpdMatrix &initial_state_variance() const {
@@ -142,9 +138,7 @@ namespace BOOM {
         ScalarStateSpaceModelBase &model);
 
    private:
-    Date time_of_first_observation_;
     Ptr<UnivParams> residual_variance_;
-    std::vector<Ptr<Holiday>> holidays_;
 
     // State space model matrices.  These are trivial.
     Ptr<IdentityMatrix> state_transition_matrix_;  // The 1x1 identity.
@@ -152,11 +146,10 @@ namespace BOOM {
     Ptr<IdentityMatrix> state_error_expander_;     // The 1x1 identity.
     Ptr<ZeroMatrix> state_error_variance_;         // 1x1
 
-    // A mapping from integer time t to which holiday is active at time t, and
-    // which day in the holiday is active at time t.  These are filled when
-    // observe_time_dimension is called.
-    std::vector<int> which_holiday_;
-    std::vector<int> which_day_;
+    // The holidays, and a mapping from integer time t to which holiday is
+    // active at time t and which day in the holiday is active at time t.  The
+    // mapping is tabulated when observe_time_dimension is called.
+    HolidayCalendar calendar_;
 
     // The state is alwasy 1, so the mean is 1, and the variance is zero.
     Vector initial_state_mean_;
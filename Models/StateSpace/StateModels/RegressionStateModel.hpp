@@ -62,6 +62,13 @@ namespace BOOM {
         int t, const ConstVectorView &state_error_mean,
         const ConstSubMatrix &state_error_variance) override;
 
+    // The regression coefficients are not part of this model's parameter
+    // vector (the regression model is managed by the state space model that
+    // owns it), so there is nothing to add.
+    void increment_expected_gradient(
+        VectorView gradient, int t, const ConstVectorView &state_error_mean,
+        const ConstSubMatrix &state_error_variance) override {}
+
     void simulate_state_error(RNG &rng, VectorView eta, int t) const override;
     void simulate_initial_state(RNG &rng, VectorView eta) const override;
 
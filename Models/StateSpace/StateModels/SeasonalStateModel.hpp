@@ -54,6 +54,7 @@ namespace BOOM {
     Ptr<SparseMatrixBlock> state_error_expander(int t) const override;
     Ptr<SparseMatrixBlock> state_error_variance(int t) const override;
     SparseVector observation_matrix(int t) const override;
+    bool transition_depends_on_parameters() const override { return false; }
 
     Vector initial_state_mean() const override;
     void set_initial_state_mean(const Vector &mu);
@@ -124,6 +125,10 @@ namespace BOOM {
 
     int season_duration() const {return duration_;}
 
+    // Seasons of length 1 change at every time point, so the model matrices
+    // are the same for all t.
+    bool is_time_invariant() const override { return duration_ == 1; }
+
    private:
     uint duration_;
     int time_of_first_observation_;
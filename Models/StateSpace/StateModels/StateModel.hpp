@@ -176,6 +176,12 @@ namespace BOOM {
     //   this call, but for the constraints being satisfied.
     virtual void impose_identifiability_constraint() {}
 
+    // Returns false if state_transition_matrix(t) is the same for all values
+    // of the model parameters, so that the transition can be applied to the
+    // states from many MCMC draws at once.  The default is the safe
+    // assumption that the transition matrix depends on the parameters.
+    virtual bool transition_depends_on_parameters() const { return true; }
+
     Matrix simulate(int ntimes, RNG &rng = GlobalRng::rng) const;
 
    private:
@@ -189,6 +195,39 @@ namespace BOOM {
     StateModel * clone() const override = 0;
     // Observation coefficients for a ScalarStateModel(Base).
     virtual SparseVector observation_matrix(int t) const = 0;
+
+    // Returns true if state_transition_matrix(t), state_variance_matrix(t) and
+    // observation_matrix(t) do not depend on t.  Filters can use this to skip
+    // redundant work once the state variance has converged.  The default
+    // implementation makes the safe assumption that the model is time varying.
+    virtual bool is_time_invariant() const { return false; }
+
+    // Parameters that enter the state transition matrix (e.g. AR
+    // coefficients) affect the log likelihood through the joint distribution
+    // of the state and the state error, which increment_expected_gradient
+    // does not see.  Models with such parameters return true here, and add
+    // the corresponding terms in increment_expected_transition_gradient.
+    virtual bool transition_depends_on_parameters() const { return false; }
+
+    // Add the expected derivative of log p(state[t+1] | state[t]) with
+    // respect to the parameters of the state transition matrix to gradient.
+    // Derivatives with respect to the state error variance belong in
+    // increment_expected_gradient.  Only called if
+    // transition_depends_on_parameters() is true.
+    //
+    // Args:
+    //   gradient: Subset of the gradient vector corresponding to this state
+    //     model.
+    //   t: The time index of the state.  The state error is for the t -> t+1
+    //     transition.
+    //   state_mean: E(state[t] | Y) for this state model.
+    //   state_error_mean: E(error[t] | Y) for this state model.
+    //   state_error_covariance: Cov(state[t], error[t] | Y) for this state
+    //     model, with rows for the state and columns for the state error.
+    virtual void increment_expected_transition_gradient(
+        VectorView gradient, int t, const ConstVectorView &state_mean,
+        const ConstVectorView &state_error_mean,
+        const ConstSubMatrix &state_error_covariance) {}
   };
 
   //===========================================================================
@@ -74,6 +74,8 @@ namespace BOOM {
     SparseVector observation_matrix(int t) const override {
       return observation_matrix_;
     }
+    bool is_time_invariant() const override { return true; }
+    bool transition_depends_on_parameters() const override { return false; }
 
     Vector initial_state_mean() const override { return initial_state_mean_; }
 
@@ -130,14 +130,7 @@ namespace BOOM {
 
     for (int i = 0; i < frequencies_.size(); ++i) {
       double freq = 2 * Constants::pi * frequencies_[i] / period_;
-      double cosine = cos(freq);
-      double sine = sin(freq);
-      Matrix rotation(2, 2);
-      rotation(0, 0) = cosine;
-      rotation(0, 1) = sine;
-      rotation(1, 0) = -sine;
-      rotation(1, 1) = cosine;
-      state_transition_matrix_->add_block(new DenseMatrix(rotation));
+      state_transition_matrix_->add_block(new RotationMatrix(freq));
     }
   }
 
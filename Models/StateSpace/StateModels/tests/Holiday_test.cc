@@ -247,4 +247,50 @@ namespace {
     EXPECT_EQ(4, second_holiday.maximum_window_width());
   }
   
+  // The tabulated calendar should agree with the holidays themselves, both
+  // inside the table and beyond it.
+  TEST_F(HolidayTest, Calendar) {
+    Date time_zero(Jan, 1, 2010);
+    Ptr<Holiday> easter(new EasterSunday(3, 1));
+    Ptr<Holiday> christmas(new Christmas(2, 2));
+    HolidayCalendar calendar(time_zero);
+    calendar.add_holiday(easter);
+    calendar.add_holiday(christmas);
+    EXPECT_EQ(2, calendar.number_of_holidays());
+    EXPECT_EQ(christmas.get(), calendar.holiday(1));
+    EXPECT_EQ(nullptr, calendar.holiday(2));
+
+    int max_time = 3 * 365;
+    calendar.extend(max_time);
+    EXPECT_EQ(max_time, calendar.size());
+    calendar.extend(10);
+    EXPECT_EQ(max_time, calendar.size());
+
+    for (int t = 0; t < max_time + 365; ++t) {
+      Date date = time_zero + t;
+      if (easter->active(date)) {
+        EXPECT_EQ(0, calendar.which_holiday(t));
+        EXPECT_EQ(easter->days_into_influence_window(date),
+                  calendar.which_day(t));
+      } else if (christmas->active(date)) {
+        EXPECT_EQ(1, calendar.which_holiday(t));
+        EXPECT_EQ(christmas->days_into_influence_window(date),
+                  calendar.which_day(t));
+      } else {
+        EXPECT_EQ(-1, calendar.which_holiday(t));
+        EXPECT_EQ(-1, calendar.which_day(t));
+      }
+    }
+
+    // Easter 2011 was April 24, so its window starts 3 days before.
+    EXPECT_EQ(0, calendar.which_day(Date(Apr, 21, 2011) - time_zero));
+    EXPECT_EQ(3, calendar.which_day(Date(Apr, 24, 2011) - time_zero));
+
+    // Moving time zero invalidates the table.
+    calendar.set_time_zero(Date(Apr, 21, 2011));
+    EXPECT_EQ(0, calendar.size());
+    EXPECT_EQ(0, calendar.which_holiday(0));
+    EXPECT_EQ(0, calendar.which_day(0));
+  }
+
 }  // namespace
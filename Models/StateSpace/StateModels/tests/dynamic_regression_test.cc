@@ -162,4 +162,55 @@ namespace {
       EXPECT_LT(var(regression_draws.col(t)), sample_var);
     }
   }
+
+  //======================================================================
+  // Zero predictors are dropped from the observation vectors, and the
+  // Kalman filter gives the same answer as a dense filter.
+  TEST_F(DynamicRegressionStateModelTest, SparsePredictors) {
+    SimulateData();
+    for (int t = 0; t < sample_size_; ++t) {
+      for (int j = 0; j < xdim_; ++j) {
+        if ((t + j) % 3 != 0) predictors_(t, j) = 0.0;
+      }
+    }
+    BuildModel();
+    level_model_->set_sigsq(square(true_trend_sd_));
+    model_->observation_model()->set_sigsq(square(true_observation_sd_));
+    for (int j = 0; j < xdim_; ++j) {
+      dynamic_regression_model_->set_sigsq(square(true_coefficient_sd_), j);
+    }
+
+    int nonzero = 0;
+    for (int t = 0; t < sample_size_; ++t) {
+      SparseVector x = dynamic_regression_model_->observation_matrix(t);
+      int count = 0;
+      for (const auto &el : x) {
+        EXPECT_NE(0.0, el.second);
+        EXPECT_DOUBLE_EQ(predictors_(t, el.first), el.second);
+        ++count;
+      }
+      nonzero += count;
+    }
+    EXPECT_LT(nonzero, sample_size_ * xdim_ / 2);
+
+    // A dense Kalman filter for the local level + dynamic regression model.
+    int dim = xdim_ + 1;
+    Vector a = model_->initial_state_mean();
+    SpdMatrix P = model_->initial_state_variance();
+    Vector innovation_variance(dim, square(true_coefficient_sd_));
+    innovation_variance[0] = square(true_trend_sd_);
+    double loglike = 0;
+    for (int t = 0; t < sample_size_; ++t) {
+      Vector Z(dim, 1.0);
+      VectorView(Z, 1) = predictors_.row(t);
+      Vector PZ = P * Z;
+      double F = Z.dot(PZ) + square(true_observation_sd_);
+      double v = data_[t] - Z.dot(a);
+      loglike += dnorm(data_[t], Z.dot(a), sqrt(F), true);
+      a.axpy(PZ, v / F);
+      P.add_outer(PZ, -1.0 / F);
+      for (int i = 0; i < dim; ++i) P(i, i) += innovation_variance[i];
+    }
+    EXPECT_NEAR(loglike, model_->log_likelihood(), 1e-6);
+  }
 }  // namespace
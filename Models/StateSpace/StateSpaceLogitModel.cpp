@@ -93,19 +93,15 @@ namespace BOOM {
     if (missing() == Data::completely_missing || binomial_data_.empty()) {
       return negative_infinity();
     }
-    double total_precision = 0;
-    double ans = 0;
+    CollapsedObservation ans;
     for (int i = 0; i < binomial_data_.size(); ++i) {
       if (binomial_data(i).missing() == Data::observed) {
-        ans += precisions_[i] * (latent_continuous_values_[i] -
-                                 coefficients.predict(binomial_data_[i]->x()));
-        total_precision += precisions_[i];
+        ans.add(latent_continuous_values_[i]
+                - coefficients.predict(binomial_data_[i]->x()),
+                precisions_[i]);
       }
     }
-    if (total_precision <= 0 || !std::isfinite(total_precision)) {
-      return negative_infinity();
-    }
-    return ans / total_precision;
+    return ans.empty() ? negative_infinity() : ans.value();
   }
 
   double ABRD::latent_data_overall_variance() const {
@@ -0,0 +1,103 @@
+// Copyright 2018 Google LLC. All Rights Reserved.
+/*
+  Copyright (C) 2005-2024 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#include "Models/StateSpace/StateSpaceMemoryEstimate.hpp"
+#include "Models/StateSpace/Filters/ScalarKalmanFilter.hpp"
+#include "Models/StateSpace/StateSpaceModel.hpp"
+#include "Models/StateSpace/StateSpaceRegressionModel.hpp"
+#include "cpputil/report_error.hpp"
+
+namespace BOOM {
+
+  namespace {
+    // The bytes held by one scalar Kalman filter over 'time_dimension' time
+    // points once the filter and the disturbance smoother have been run.
+    std::size_t scalar_filter_bytes(std::size_t time_dimension,
+                                    std::size_t state_dimension,
+                                    bool keep_state_variances) {
+      std::size_t vector_bytes = state_dimension * sizeof(double);
+      std::size_t variance_bytes = vector_bytes * state_dimension;
+      // Each node holds the state mean, the Kalman gain, and the scaled state
+      // error, plus the state variance if the filter keeps it.
+      std::size_t node_bytes = sizeof(Kalman::ScalarMarginalDistribution)
+          + 3 * vector_bytes
+          + (keep_state_variances ? variance_bytes : 0);
+      return sizeof(ScalarKalmanFilter) + vector_bytes
+          + time_dimension * node_bytes
+          + (keep_state_variances ? 0 : variance_bytes);
+    }
+  }  // namespace
+
+  MemoryFootprint EstimateStateSpaceMemory(
+      const StateSpaceMemoryOptions &options) {
+    if (options.time_dimension < 0 || options.state_dimension < 0
+        || options.number_of_state_models < 0 || options.xdim < 0
+        || options.niter < 0) {
+      report_error("Dimensions passed to EstimateStateSpaceMemory must be "
+                   "non-negative.");
+    }
+    std::size_t time_dimension = options.time_dimension;
+    std::size_t state_dimension = options.state_dimension;
+    std::size_t xdim = options.xdim;
+    std::size_t niter = options.niter;
+
+    MemoryFootprint ans;
+    // The model owns a filter for likelihood evaluation, and a second one for
+    // simulating the state.
+    ans.add(MemoryFootprint::kKalmanFilter,
+            2 * scalar_filter_bytes(time_dimension, state_dimension,
+                                    options.keep_state_variances));
+    ans.add(MemoryFootprint::kState,
+            state_dimension * time_dimension * sizeof(double));
+
+    if (xdim > 0) {
+      std::size_t data_point_bytes =
+          sizeof(StateSpace::MultiplexedRegressionData)
+          + sizeof(Ptr<RegressionData>)
+          + sizeof(RegressionData) + sizeof(VectorData)
+          + 2 * xdim * sizeof(double);
+      ans.add(MemoryFootprint::kData, time_dimension * data_point_bytes);
+      ans.add(MemoryFootprint::kSufficientStatistics,
+              (xdim * xdim + xdim) * sizeof(double));
+      ans.add(MemoryFootprint::kParameters, xdim * sizeof(double));
+    } else {
+      std::size_t data_point_bytes =
+          sizeof(StateSpace::MultiplexedDoubleData)
+          + sizeof(Ptr<DoubleData>) + sizeof(DoubleData);
+      ans.add(MemoryFootprint::kData, time_dimension * data_point_bytes);
+    }
+
+    // The MCMC output always holds the final state and the residual
+    // standard deviation.
+    std::size_t values_per_draw = state_dimension + 1 + xdim;
+    if (options.save_state_contributions) {
+      values_per_draw += options.number_of_state_models * time_dimension;
+    }
+    if (options.save_prediction_errors) {
+      values_per_draw += time_dimension;
+    }
+    if (options.save_full_state) {
+      values_per_draw += state_dimension * time_dimension;
+    }
+    ans.add(MemoryFootprint::kMcmcOutput,
+            niter * values_per_draw * sizeof(double));
+    return ans;
+  }
+
+}  // namespace BOOM
@@ -0,0 +1,67 @@
+// Copyright 2018 Google LLC. All Rights Reserved.
+#ifndef BOOM_STATE_SPACE_MEMORY_ESTIMATE_HPP_
+#define BOOM_STATE_SPACE_MEMORY_ESTIMATE_HPP_
+/*
+  Copyright (C) 2005-2024 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#include "cpputil/MemoryFootprint.hpp"
+
+namespace BOOM {
+
+  // The problem dimensions and output options that determine the memory
+  // needed to fit a scalar state space model (e.g. a bsts model) by MCMC.
+  struct StateSpaceMemoryOptions {
+    // The number of time points.
+    int time_dimension = 0;
+
+    // The dimension of the full state vector.
+    int state_dimension = 0;
+
+    // The number of state models making up the state.
+    int number_of_state_models = 1;
+
+    // The number of regression predictors, or 0 for models without a
+    // regression component.
+    int xdim = 0;
+
+    // The number of MCMC iterations.
+    int niter = 0;
+
+    // If false the Kalman filters keep the state variance only for the most
+    // recent time point.
+    bool keep_state_variances = true;
+
+    // Options controlling what is saved in the MCMC output.
+    bool save_state_contributions = true;
+    bool save_prediction_errors = true;
+    bool save_full_state = false;
+  };
+
+  // A dry-run estimate of the memory needed to fit a scalar state space model
+  // with the given dimensions, computed without building the model.  The
+  // categories match those reported by StateSpaceModelBase::memory_footprint()
+  // and the MCMC output managers, so the estimate can be checked against a
+  // fitted model.  The total() of the estimate is a prediction of the peak
+  // resident set size attributable to the model, which is reached once the
+  // MCMC output has been fully allocated.
+  MemoryFootprint EstimateStateSpaceMemory(
+      const StateSpaceMemoryOptions &options);
+
+}  // namespace BOOM
+
+#endif  // BOOM_STATE_SPACE_MEMORY_ESTIMATE_HPP_
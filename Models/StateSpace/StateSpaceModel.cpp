@@ -35,6 +35,14 @@ namespace BOOM {
 
   MDD *MDD::clone() const { return new MDD(*this); }
 
+  std::size_t MDD::memory_footprint() const {
+    std::size_t ans = sizeof(*this) + observer_bytes() + heap_bytes(data_);
+    for (const auto &dp : data_) {
+      ans += dp->memory_footprint();
+    }
+    return ans;
+  }
+
   std::ostream &MDD::display(std::ostream &out) const {
     for (int i = 0; i < data_.size(); ++i) {
       data_[i]->display(out) << std::endl;
@@ -52,13 +60,13 @@ namespace BOOM {
         observed_sample_size() == 0) {
       return negative_infinity();
     }
-    double ans = 0;
+    StateSpace::CollapsedObservation ans;
     for (int i = 0; i < data_.size(); ++i) {
       if (data_[i]->missing() == Data::observed) {
-        ans += data_[i]->value();
+        ans.add(data_[i]->value());
       }
     }
-    return ans / observed_sample_size();
+    return ans.value();
   }
 
   const DoubleData &MDD::double_data(int i) const { return *(data_[i]); }
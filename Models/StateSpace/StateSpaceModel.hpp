@@ -49,6 +49,8 @@ namespace BOOM {
 
       int total_sample_size() const override { return data_.size(); }
 
+      std::size_t memory_footprint() const override;
+
      private:
       std::vector<Ptr<DoubleData>> data_;
     };
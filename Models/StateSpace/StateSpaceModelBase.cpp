@@ -18,11 +18,13 @@
 */
 
 #include "Models/StateSpace/StateSpaceModelBase.hpp"
+#include <atomic>
 #include <functional>
 
 #include "LinAlg/SubMatrix.hpp"
 #include "Models/StateSpace/Filters/SparseKalmanTools.hpp"
 #include "Models/PosteriorSamplers/PosteriorSampler.hpp"
+#include "Samplers/McmcProfiler.hpp"
 #include "cpputil/report_error.hpp"
 #include "distributions.hpp"
 #include "numopt.hpp"
@@ -129,6 +131,23 @@ namespace BOOM {
   }
 
   //----------------------------------------------------------------------
+  MemoryFootprint Base::memory_footprint() const {
+    MemoryFootprint ans = Model::memory_footprint();
+    ans.add(MemoryFootprint::kKalmanFilter, get_filter().memory_footprint());
+    if (&get_simulation_filter() != &get_filter()) {
+      ans.add(MemoryFootprint::kKalmanFilter,
+              get_simulation_filter().memory_footprint());
+    }
+    ans.add(MemoryFootprint::kState, state_.size() * sizeof(double));
+    if (observation_model()) {
+      ans.add(observation_model()->data_memory_footprint());
+    }
+    for (int s = 0; s < number_of_state_models(); ++s) {
+      ans.add(state_model(s)->data_memory_footprint());
+    }
+    return ans;
+  }
+
   VectorView Base::state_parameter_component(Vector &model_parameters,
                                              int s) const {
     int start = parameter_positions_[s];
@@ -279,6 +298,7 @@ namespace BOOM {
     if (number_of_state_models() == 0) {
       report_error("No state has been defined.");
     }
+    ScopedPhaseTimer timer(McmcProfiler::kImputeLatentData);
     set_state_model_behavior(StateModel::MIXTURE);
     if (state_is_fixed_) {
       observe_fixed_state();
@@ -299,11 +319,7 @@ namespace BOOM {
           : model_(model) {}
 
       double operator()(const Vector &parameters) {
-        Vector old_parameters = model_->vectorize_params();
-        model_->unvectorize_params(parameters);
-        double ans = model_->log_likelihood();
-        model_->unvectorize_params(old_parameters);
-        return ans;
+        return model_->log_likelihood(parameters);
       }
 
      private:
@@ -396,7 +412,12 @@ namespace BOOM {
 
   //----------------------------------------------------------------------
   const SpdMatrix &Base::state_posterior_variance(int t) const {
-    return get_filter()[t].state_variance();
+    const SpdMatrix &ans(get_filter()[t].state_variance());
+    if (ans.nrow() != state_dimension()) {
+      report_error("The Kalman filter did not keep the state variance for "
+                   "each time point.");
+    }
+    return ans;
   }
 
   //----------------------------------------------------------------------
@@ -404,6 +425,17 @@ namespace BOOM {
     return get_filter().compute_log_likelihood();
   }
 
+  //----------------------------------------------------------------------
+  double Base::scratch_log_likelihood() {
+    KalmanFilterBase &filter(get_simulation_filter());
+    filter.set_status(KalmanFilterBase::NOT_CURRENT);
+    double ans = filter.compute_log_likelihood();
+    // The simulation filter is refilled by the next simulation, so it should
+    // not be mistaken for a current filter.
+    filter.set_status(KalmanFilterBase::NOT_CURRENT);
+    return ans;
+  }
+
   //----------------------------------------------------------------------
   double Base::log_likelihood(const Vector &parameters) {
     StateSpaceUtils::LogLikelihoodEvaluator evaluator(this);
@@ -482,6 +514,62 @@ namespace BOOM {
     return ans;
   }
 
+  //----------------------------------------------------------------------
+  std::vector<Matrix> Base::simulate_state_forecast(
+      RNG &rng, int horizon, const Matrix &parameter_draws,
+      const Matrix &final_states) {
+    if (horizon < 0) {
+      report_error(
+          "simulate_state_forecast called with a negative "
+          "forecast horizon.");
+    }
+    int ndraws = parameter_draws.nrow();
+    if (final_states.nrow() != ndraws) {
+      report_error("parameter_draws and final_states must have the same "
+                   "number of rows.");
+    }
+    if (final_states.ncol() != state_dimension()) {
+      report_error("final_states must have state_dimension() columns.");
+    }
+    bool transition_is_fixed = true;
+    for (int s = 0; s < number_of_state_models(); ++s) {
+      if (state_model(s)->transition_depends_on_parameters()) {
+        transition_is_fixed = false;
+        break;
+      }
+    }
+
+    int T = time_dimension();
+    std::vector<Matrix> ans(horizon + 1, Matrix(state_dimension(), ndraws));
+    ans[0] = final_states.transpose();
+    for (int d = 0; d < ndraws; ++d) {
+      ParameterHolder holder(this, Vector(parameter_draws.row(d)));
+      for (int h = 1; h <= horizon; ++h) {
+        if (transition_is_fixed) {
+          // Just the errors for now.  The transitions are applied below.
+          ans[h].col(d) = simulate_state_error(rng, T + h - 1);
+        } else {
+          simulate_next_state(rng, ans[h - 1].col(d), ans[h].col(d), T + h);
+        }
+      }
+    }
+
+    if (transition_is_fixed) {
+      Matrix transitioned;
+      for (int h = 1; h <= horizon; ++h) {
+        transitioned = ans[h - 1];
+        for (int s = 0; s < number_of_state_models(); ++s) {
+          state_model(s)->state_transition_matrix(T + h - 1)
+              ->matrix_multiply_inplace(
+                  state_models().mutable_full_state_subcomponent(
+                      transitioned, s));
+        }
+        ans[h] += transitioned;
+      }
+    }
+    return ans;
+  }
+
   //----------------------------------------------------------------------
   Vector Base::simulate_state_error(RNG &rng, int t) const {
     // simulate N(0, RQR) for the state at time t+1, using the
@@ -572,6 +660,11 @@ namespace BOOM {
     // Compute log likelihood (the return value) and fill the kalman filter with
     // current values.
     kalman_filter();
+    if (save_state_distributions && time_dimension() > 0
+        && get_filter()[0].state_variance().nrow() != state_dimension()) {
+      report_error("Saving state distributions requires a Kalman filter that "
+                   "keeps the state variance for each time point.");
+    }
 
     // This is the disturbance smoother from Durbin and Koopman, equation
     // (4.69).
@@ -673,6 +766,14 @@ namespace BOOM {
     }
     return ans;
   }
+
+  bool ScalarBase::state_is_time_invariant() const {
+    for (int s = 0; s < number_of_state_models(); ++s) {
+      if (!state_model(s)->is_time_invariant()) return false;
+    }
+    return true;
+  }
+
   //----------------------------------------------------------------------
   void ScalarBase::kalman_filter() {
     filter_.update();
@@ -839,11 +940,73 @@ namespace BOOM {
           observation_error_variance);
     }
 
+    bool transition_gradient = false;
+    if (gradient && t + 1 < time_dimension()) {
+      for (int s = 0; s < number_of_state_models(); ++s) {
+        if (state_model(s)->transition_depends_on_parameters()) {
+          transition_gradient = true;
+          break;
+        }
+      }
+    }
+    if (transition_gradient) {
+      const Vector r_now = r;
+      const SpdMatrix N_now = N;
+      sparse_scalar_kalman_disturbance_smoother_update(
+          r, N, (*state_transition_matrix(t)), K, observation_matrix(t), F, v);
+      update_state_transition_gradient(gradient, t, r_now, N_now, r);
+      return;
+    }
+
     // Kalman smoother: convert r[t] to r[t-1] and N[t] to N[t-1].
     sparse_scalar_kalman_disturbance_smoother_update(
         r, N, (*state_transition_matrix(t)), K, observation_matrix(t), F, v);
   }
 
+  //----------------------------------------------------------------------
+  // With a[t] and P[t] the predicted state mean and variance, and
+  // L[t] = T[t] - K[t] * Z[t]', Durbin and Koopman (section 4.5) give
+  //
+  //         E(alpha[t] | Y) = a[t] + P[t] * r[t-1]
+  //           E(eta[t] | Y) = Q[t] * R[t]' * r[t]
+  //   Cov(alpha[t], eta[t]) = -P[t] * L[t]' * N[t] * R[t] * Q[t].
+  void ScalarBase::update_state_transition_gradient(
+      Vector *gradient, int t, const Vector &r, const SpdMatrix &N,
+      const Vector &previous_r) {
+    const bool first = t == 0;
+    if (!first
+        && get_filter()[t - 1].state_variance().nrow() != state_dimension()) {
+      report_error("Gradients for state models with parameters in the state "
+                   "transition matrix require a Kalman filter that keeps the "
+                   "state variance for each time point.");
+    }
+    const Vector a(first ? initial_state_mean()
+                   : get_filter()[t - 1].state_mean());
+    const SpdMatrix P(first ? initial_state_variance()
+                      : get_filter()[t - 1].state_variance());
+    const Vector state_mean = a + P * previous_r;
+
+    const Matrix RQ = state_error_expander(t)->dense()
+        * state_error_variance(t)->dense();
+    const Vector state_error_mean = RQ.Tmult(r);
+    const Matrix NRQ = N * RQ;
+    Matrix covariance = state_transition_matrix(t)->Tmult(NRQ);
+    covariance -= observation_matrix(t).outer_product_transpose(
+        NRQ.Tmult(get_filter()[t].kalman_gain())).transpose();
+    covariance = P * covariance;
+    covariance *= -1;
+
+    for (int s = 0; s < number_of_state_models(); ++s) {
+      if (state_model(s)->transition_depends_on_parameters()) {
+        state_model(s)->increment_expected_transition_gradient(
+            state_parameter_component(*gradient, s), t,
+            state_component(ConstVectorView(state_mean), s),
+            const_state_error_component(state_error_mean, s),
+            state_models().state_error_covariance_component(covariance, s));
+      }
+    }
+  }
+
   //----------------------------------------------------------------------
 
   double ScalarBase::simulate_adjusted_observation(RNG &rng, int t) {
@@ -898,55 +1061,32 @@ namespace BOOM {
         int niter,
         const std::vector<int> &cutpoints,
         bool standardize) {
-      std::vector<Matrix> prediction_errors(cutpoints.size(),
-                                            Matrix(niter, model.time_dimension()));
-      std::vector<std::future<void>> futures;
-      int desired_threads = std::min<int>(
-          cutpoints.size(),
-          std::thread::hardware_concurrency() - 1);
-      BOOM::ThreadWorkerPool pool;
-      pool.add_threads(desired_threads);
+      std::vector<Matrix> prediction_errors(cutpoints.size());
+      if (cutpoints.empty()) return prediction_errors;
+
+      // One worker per thread, rather than one per cutpoint.  Workers share
+      // the prototype's data objects, so each one costs a copy of the
+      // parameters, state, and samplers, but not the data.
+      int number_of_workers = std::max<int>(1, std::min<int>(
+          cutpoints.size(), global_thread_pool_size()));
       std::vector<Ptr<ScalarStateSpaceModelBase>> workers;
-
-      class WorkWrapper {
-       public:
-        WorkWrapper(const Ptr<ScalarStateSpaceModelBase> worker,
-                    int niter,
-                    int cutpoint,
-                    bool standardize,
-                    Matrix &output)
-            : worker_(worker),
-              niter_(niter),
-              cutpoint_(cutpoint),
-              standardize_(standardize),
-              output_(output)
-        {}
-
-        void operator()() {
-          output_ = worker_->simulate_holdout_prediction_errors(
-              niter_, cutpoint_, standardize_);
-        }
-
-       private:
-        Ptr<ScalarStateSpaceModelBase> worker_;
-        int niter_;
-        int cutpoint_;
-        bool standardize_;
-        Matrix &output_;
-      };
-
-      for (int i = 0; i < cutpoints.size(); ++i) {
+      for (int w = 0; w < number_of_workers; ++w) {
         workers.push_back(model.deepclone());
-        futures.emplace_back(pool.submit(WorkWrapper(
-            workers[i],
-            niter,
-            cutpoints[i],
-            standardize,
-            prediction_errors[i])));
-      }
-      for (int i = 0; i < futures.size(); ++i) {
-        futures[i].get();
       }
+      Vector starting_parameters = model.vectorize_params(true);
+      std::atomic<int> next_cutpoint(0);
+      global_thread_pool().parallel_for(
+          0, number_of_workers, 1, [&](int w) {
+            ScalarStateSpaceModelBase *worker = workers[w].get();
+            for (int i = next_cutpoint++; i < cutpoints.size();
+                 i = next_cutpoint++) {
+              // Each holdout run starts from the prototype's parameters, as
+              // it would with a fresh clone.
+              worker->unvectorize_params(starting_parameters, true);
+              prediction_errors[i] = worker->simulate_holdout_prediction_errors(
+                  niter, cutpoints[i], standardize);
+            }
+          });
       return prediction_errors;
     }
   }  // namespace StateSpaceUtils
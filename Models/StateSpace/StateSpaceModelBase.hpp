@@ -284,6 +284,11 @@ namespace BOOM {
     virtual KalmanFilterBase & get_simulation_filter() = 0;
     virtual const KalmanFilterBase & get_simulation_filter() const = 0;
 
+    // In addition to the parameters and data, the footprint includes the
+    // Kalman filters, the imputed state, and the sufficient statistics held
+    // by the state models and the observation model.
+    MemoryFootprint memory_footprint() const override;
+
     //------------- Parameter estimation by MLE and MAP --------------------
     // Set model parameters to their maximum-likelihood estimates, and return
     // the likelihood at the MLE.  Note that some state models cannot be used
@@ -360,12 +365,23 @@ namespace BOOM {
     double log_likelihood();
 
     // Evaluate the model log likelihood as a function of the model parameters.
+    // The evaluation uses scratch_log_likelihood(), so the main Kalman filter
+    // is left as it was.
     //
     // Args:
     //   parameters: The vector of model parameters in the same order as
     //     produced by vectorize_params(true).
     double log_likelihood(const Vector &parameters);
 
+    // Returns the log likelihood under the current set of model parameters,
+    // computed with a fresh run of the simulation filter.  The main Kalman
+    // filter, and the log likelihood it caches, are not touched.  Trial
+    // parameters (e.g. a Metropolis-Hastings proposal, or a point visited by
+    // an optimizer) can be evaluated with this function.  If the trial is
+    // rejected, the log likelihood at the restored parameters is still
+    // available from log_likelihood() without refiltering.
+    double scratch_log_likelihood();
+
     // Evaluate the log likelihood function and its derivatives as a function of
     // model parameters.
     // Args:
@@ -447,6 +463,34 @@ namespace BOOM {
     //   state given data to time_dimension().
     Matrix simulate_state_forecast(RNG &rng, int horizon) const;
 
+    // Simulate state forecasts for a collection of saved MCMC draws at once.
+    // The forecasts are stored draw-by-draw in the columns of a matrix for
+    // each forecast period, so all draws can be advanced together.  If none
+    // of the state models has a transition matrix that depends on model
+    // parameters then each period is advanced with one blockwise
+    // matrix-matrix product, rather than one matrix-vector product per draw.
+    //
+    // Args:
+    //   rng:  The random number generator to use for the simulation.
+    //   horizon:  The number of time periods into the future to forecast.
+    //   parameter_draws: Row d contains vectorize_params(true) for MCMC draw
+    //     d.
+    //   final_states: Row d contains the value of the state at time
+    //     time_dimension() - 1 for MCMC draw d.
+    //
+    // Returns:
+    //   A vector of 'horizon + 1' matrices, each with state_dimension() rows
+    //   and one column per draw.  Column d of element h is a draw of the
+    //   state h periods after the end of the training data, so element zero
+    //   is the transpose of final_states.
+    //
+    // Side effects:
+    //   Model parameters are set to each draw in turn, and restored to their
+    //   original values before returning.
+    std::vector<Matrix> simulate_state_forecast(RNG &rng, int horizon,
+                                                const Matrix &parameter_draws,
+                                                const Matrix &final_states);
+
     // Simulates the error for the state at time t+1.  (Using the notation of
     // Durbin and Koopman, this uses the model matrices indexed as t.)
     //
@@ -654,6 +698,11 @@ namespace BOOM {
     // Durbin and Koopman's Z[t].transpose() built from state models.
     virtual SparseVector observation_matrix(int t) const;
 
+    // Returns true if every state model reports that its transition matrix,
+    // state variance, and observation coefficients do not depend on t.  The
+    // observation variance is not included in this check.
+    bool state_is_time_invariant() const;
+
     //----------------- Access to data -----------------
     // Returns y[t], after adjusting for regression effects that are not
     // included in the state vector.  This is the value that the time series
@@ -705,6 +754,25 @@ namespace BOOM {
     ScalarKalmanFilter &get_simulation_filter() override;
     const ScalarKalmanFilter &get_simulation_filter() const override;
 
+    // If 'keep' is false then the Kalman filters used by this model keep the
+    // state variance only for the final time point, which reduces the memory
+    // needed by the filters from O(T * state_dimension^2) to O(T *
+    // state_dimension).  This is enough for MCMC, but not for Estep(true)
+    // or state_posterior_variance().  See
+    // ScalarKalmanFilter::set_keep_state_variances.
+    void set_keep_filter_state_variances(bool keep) {
+      filter_.set_keep_state_variances(keep);
+      simulation_filter_.set_keep_state_variances(keep);
+    }
+
+    // Let the Kalman filters used by this model run in parallel over time
+    // for long series with time invariant state.  See
+    // ScalarKalmanFilter::set_number_of_threads.
+    void set_number_of_filter_threads(int n) {
+      filter_.set_number_of_threads(n);
+      simulation_filter_.set_number_of_threads(n);
+    }
+
    protected:
 
     StateSpaceUtils::StateModelVector<StateModel> &
@@ -770,6 +838,21 @@ namespace BOOM {
         double observation_error_variance);
 
    private:
+    // Increment the gradient for state models whose transition matrices
+    // depend on model parameters, using the smoothed joint distribution of
+    // state[t] and the state error at time t.  Called from
+    // update_observation_model.
+    //
+    // Args:
+    //   gradient:  The full log likelihood gradient.
+    //   t:  The time index of the state.
+    //   r, N: The smoothing quantities r[t] and N[t] (before the update to
+    //     time t-1).
+    //   previous_r: The value of r[t-1].
+    void update_state_transition_gradient(Vector *gradient, int t,
+                                          const Vector &r, const SpdMatrix &N,
+                                          const Vector &previous_r);
+
     // data starts here
     StateSpaceUtils::StateModelVector<StateModel> state_models_;
 
@@ -793,7 +876,10 @@ namespace BOOM {
     // model's parameters are copied to a safe storage location, the new
     // parameters are injected into the model, and log likelihood is evaluated.
     // The old parameters are replaced upon completion (or if an exception is
-    // thrown).
+    // thrown).  Only the Params whose values differ from the trial values are
+    // set and restored.  Log likelihood and log posterior evaluations run the
+    // model's simulation filter (see scratch_log_likelihood()), so the main
+    // Kalman filter stays current for the restored parameters.
     class LogLikelihoodEvaluator {
      public:
       explicit LogLikelihoodEvaluator(const StateSpaceModelBase *model)
@@ -801,7 +887,7 @@ namespace BOOM {
 
       double evaluate_log_likelihood(const Vector &parameters) {
         ParameterHolder storage(model_, parameters);
-        return model_->log_likelihood();
+        return model_->scratch_log_likelihood();
       }
 
       double evaluate_log_posterior(const Vector &parameters) {
@@ -816,7 +902,7 @@ namespace BOOM {
             return ans;
           }
         }
-        ans += model_->log_likelihood();
+        ans += model_->scratch_log_likelihood();
         return ans;
       }
 
@@ -830,7 +916,10 @@ namespace BOOM {
       mutable StateSpaceModelBase *model_;
     };
 
-    // Compute one-step prediction errors on one or more holdout sets.
+    // Compute one-step prediction errors on one or more holdout sets.  The
+    // cutpoints are processed in parallel on the global thread pool.  Each
+    // thread gets one copy of the model, which is reused for each of the
+    // cutpoints it handles, and the copies share the model's data.
     //
     // Args:
     //   model:  The model to be assessed.
@@ -89,19 +89,15 @@ namespace BOOM {
         latent_continuous_values_.empty()) {
       return negative_infinity();
     }
-    double ans = 0;
-    double total_precision = 0;
+    CollapsedObservation ans;
     for (int i = 0; i < latent_continuous_values_.size(); ++i) {
       if (poisson_data_[i]->missing() == Data::observed) {
-        ans += precisions_[i] * (latent_continuous_values_[i] -
-                                 coefficients.predict(poisson_data_[i]->x()));
-        total_precision += precisions_[i];
+        ans.add(latent_continuous_values_[i]
+                - coefficients.predict(poisson_data_[i]->x()),
+                precisions_[i]);
       }
     }
-    if (total_precision <= 0 || !std::isfinite(total_precision)) {
-      return negative_infinity();
-    }
-    return ans / total_precision;
+    return ans.empty() ? negative_infinity() : ans.value();
   }
 
   double APRD::latent_data_overall_variance() const {
@@ -27,6 +27,10 @@ namespace BOOM {
   namespace {
     typedef StateSpaceRegressionModel SSRM;
     typedef StateSpace::MultiplexedRegressionData MRD;
+
+    // After this many incremental updates regression_contribution() is
+    // recomputed from scratch, so rounding errors cannot accumulate.
+    const int kMaxIncrementalUpdates = 100;
   }  // namespace
 
   MRD::MultiplexedRegressionData() : state_model_offset_(0) {}
@@ -45,6 +49,16 @@ namespace BOOM {
 
   MRD *MRD::clone() const { return new MRD(*this); }
 
+  std::size_t MRD::memory_footprint() const {
+    std::size_t ans = sizeof(*this) + observer_bytes()
+        + heap_bytes(regression_data_)
+        + predictors_.size() * sizeof(double);
+    for (const auto &dp : regression_data_) {
+      ans += dp->memory_footprint();
+    }
+    return ans;
+  }
+
   std::ostream &MRD::display(std::ostream &out) const {
     out << "state model offset: " << state_model_offset_ << std::endl
         << std::setw(10) << " response "
@@ -66,14 +80,14 @@ namespace BOOM {
     if (missing() == Data::completely_missing || observed_sample_size() == 0) {
       return negative_infinity();
     }
-    double ans = 0;
+    CollapsedObservation ans;
     for (int i = 0; i < regression_data_.size(); ++i) {
       const RegressionData &observation(regression_data(i));
       if (observation.missing() == Data::observed) {
-        ans += observation.y() - coefficients.predict(observation.x());
+        ans.add(observation.y() - coefficients.predict(observation.x()));
       }
     }
-    return ans / observed_sample_size();
+    return ans.value();
   }
 
   const RegressionData &MRD::regression_data(int i) const {
@@ -87,14 +101,14 @@ namespace BOOM {
   //======================================================================
   void SSRM::setup() {
     regression_->only_keep_sufstats(true);
+    predictor_means_current_ = false;
+    incremental_updates_ = 0;
+    cross_products_current_ = false;
   }
 
   SSRM::StateSpaceRegressionModel(int xdim)
       : regression_(new RegressionModel(xdim)) {
     setup();
-    // Note that in this constructor the regression model will still need to
-    // have data added, so we can't call fix_xtx().  This means that the xtx
-    // matrix will be re-computed with each trip through the data.
   }
 
   SSRM::StateSpaceRegressionModel(const Vector &y, const Matrix &X,
@@ -118,10 +132,6 @@ namespace BOOM {
       }
       add_data(dp);
     }
-
-    // The cast is necessary because the regression model stores a Ptr
-    // to a base class that does not supply fix_xtx();
-    regression_->suf().dcast<NeRegSuf>()->fix_xtx();
   }
 
   SSRM::StateSpaceRegressionModel(const SSRM &rhs)
@@ -159,6 +169,8 @@ namespace BOOM {
 
   void SSRM::add_multiplexed_data(const Ptr<MRD> &dp) {
     DataPolicy::add_data(dp);
+    predictor_means_current_ = false;
+    cross_products_current_ = false;
     for (int i = 0; i < dp->total_sample_size(); ++i) {
       regression_model()->add_data(dp->regression_data_ptr(i));
     }
@@ -199,6 +211,38 @@ namespace BOOM {
     }
   }
 
+  void SSRM::clear_client_data() {
+    if (!cross_products_current_) {
+      fix_predictor_cross_products();
+    }
+    ScalarStateSpaceModelBase::clear_client_data();
+  }
+
+  void SSRM::fix_predictor_cross_products() {
+    // The cast is necessary because the regression model stores a Ptr to a
+    // base class that does not supply a way to modify xtx alone.
+    Ptr<NeRegSuf> suf = regression_->suf().dcast<NeRegSuf>();
+    if (!!suf) {
+      suf->fix_xtx(false);
+      suf->clear();
+      // The rows must be the ones visited by observe_data_given_state.  The
+      // response is irrelevant because everything but xtx is cleared below.
+      for (int t = 0; t < time_dimension(); ++t) {
+        if (is_missing_observation(t)) continue;
+        const MRD &dp(*dat()[t]);
+        for (int i = 0; i < dp.total_sample_size(); ++i) {
+          const RegressionData &observation(dp.regression_data(i));
+          if (observation.missing() == Data::observed) {
+            suf->add_mixture_data(0.0, observation.x(), 1.0);
+          }
+        }
+      }
+      suf->fix_xtx(true);
+      suf->clear();
+    }
+    cross_products_current_ = true;
+  }
+
   Matrix SSRM::forecast(const Matrix &newX) {
     kalman_filter();
     Kalman::ScalarMarginalDistribution marg = get_filter().back();
@@ -344,19 +388,74 @@ namespace BOOM {
 
   Vector SSRM::regression_contribution() const {
     const std::vector<Ptr<MRD>> &data(dat());
-    Vector ans(data.size());
+    if (!predictor_means_current_ || predictor_means_.nrow() != data.size()) {
+      refresh_predictor_means();
+    }
+    const GlmCoefs &coefficients(regression_->coef());
+    const Vector &beta(coefficients.Beta());
+    if (cached_contribution_.size() != data.size()
+        || cached_coefficients_.size() != beta.size()
+        || incremental_updates_ >= kMaxIncrementalUpdates) {
+      recompute_regression_contribution(coefficients);
+      return cached_contribution_;
+    }
+
+    std::vector<int> changed;
+    for (int j = 0; j < beta.size(); ++j) {
+      if (beta[j] != cached_coefficients_[j]) {
+        changed.push_back(j);
+      }
+    }
+    // Each changed coefficient costs a pass over its column, so once more
+    // than half the included coefficients have moved it is cheaper to start
+    // over.
+    if (2 * changed.size() > coefficients.nvars()) {
+      recompute_regression_contribution(coefficients);
+    } else if (!changed.empty()) {
+      for (int j : changed) {
+        cached_contribution_.axpy(predictor_means_.col(j),
+                                  beta[j] - cached_coefficients_[j]);
+        cached_coefficients_[j] = beta[j];
+      }
+      ++incremental_updates_;
+    }
+    return cached_contribution_;
+  }
+
+  void SSRM::refresh_predictor_means() const {
+    const std::vector<Ptr<MRD>> &data(dat());
+    predictor_means_.resize(data.size(), xdim());
+    predictor_means_ = 0.0;
     for (int time = 0; time < data.size(); ++time) {
-      Ptr<MRD> dp = data[time];
-      double average_contribution = 0;
-      for (int j = 0; j < data[time]->total_sample_size(); ++j) {
-        average_contribution +=
-            regression_model()->predict(dp->regression_data(j).x());
+      const MRD &dp(*data[time]);
+      int n = dp.total_sample_size();
+      if (n > 0) {
+        VectorView row(predictor_means_.row(time));
+        for (int j = 0; j < n; ++j) {
+          row += dp.regression_data(j).x();
+        }
+        row /= n;
       }
-      ans[time] = dp->total_sample_size() > 0
-                      ? average_contribution /= dp->total_sample_size()
-                      : 0;
     }
-    return ans;
+    predictor_means_current_ = true;
+    // The cached contribution was built from the old means.
+    cached_contribution_.clear();
+  }
+
+  void SSRM::recompute_regression_contribution(
+      const GlmCoefs &coefficients) const {
+    const Vector &beta(coefficients.Beta());
+    cached_contribution_.resize(predictor_means_.nrow());
+    cached_contribution_ = 0.0;
+    const Selector &included(coefficients.inc());
+    for (int i = 0; i < included.nvars(); ++i) {
+      int j = included.indx(i);
+      if (beta[j] != 0.0) {
+        cached_contribution_.axpy(predictor_means_.col(j), beta[j]);
+      }
+    }
+    cached_coefficients_ = beta;
+    incremental_updates_ = 0;
   }
 
 }  // namespace BOOM
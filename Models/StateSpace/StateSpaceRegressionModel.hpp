@@ -63,6 +63,8 @@ namespace BOOM {
 
       const Matrix &predictors() const { return predictors_; }
 
+      std::size_t memory_footprint() const override;
+
      private:
       std::vector<Ptr<RegressionData>> regression_data_;
       double state_model_offset_;
@@ -116,6 +118,14 @@ namespace BOOM {
 
     void observe_data_given_state(int t) override;
 
+    // The predictors never change, so the X'X part of the regression
+    // model's sufficient statistics is computed once (when data has changed
+    // since the last call) and then held fixed.  Each subsequent trip
+    // through the data only accumulates X'y, y'y, and the counts, which is
+    // O(T * p) rather than O(T * p^2).  Samplers needing X'X for a subset of
+    // variables extract it from the fixed matrix with a Selector.
+    void clear_client_data() override;
+
     // Forecast the next nrow(newX) time steps given the current data,
     // using the Kalman filter.  The first column of Matrix is the mean
     // of the forecast.  The second column is the standard errors.
@@ -159,6 +169,14 @@ namespace BOOM {
     // time point.  In the case of multiplexed data, the average regression
     // contribution for each time point is computed (averaging across
     // observations with potentially different predictors).
+    //
+    // The average prediction at each time point is the prediction at the
+    // average predictor row, so the averages are computed once and cached.
+    // Successive calls (e.g. once per MCMC iteration) then only touch the
+    // columns of the included coefficients, or just the columns of the
+    // coefficients that changed since the previous call if there are few of
+    // them.  The cache makes this function unsafe to call concurrently on the
+    // same model.
     Vector regression_contribution() const override;
     bool has_regression() const override { return true; }
 
@@ -204,8 +222,29 @@ namespace BOOM {
     // observation error variance.
     Ptr<RegressionModel> regression_;
 
+    // Cached by regression_contribution().  Row t of predictor_means_ is the
+    // average predictor vector at time t.  cached_contribution_ is
+    // predictor_means_ * cached_coefficients_, possibly after a number of
+    // incremental updates.
+    mutable Matrix predictor_means_;
+    mutable bool predictor_means_current_;
+    mutable Vector cached_coefficients_;
+    mutable Vector cached_contribution_;
+    mutable int incremental_updates_;
+
+    // True if the fixed X'X in the regression model's sufficient statistics
+    // reflects the current data set.
+    bool cross_products_current_;
+
     // Initialization work common to several constructors
     void setup();
+
+    // Recompute X'X from the observed rows of the data and fix it in the
+    // regression model's sufficient statistics.
+    void fix_predictor_cross_products();
+
+    void refresh_predictor_means() const;
+    void recompute_regression_contribution(const GlmCoefs &coefficients) const;
   };
 
 }  // namespace BOOM
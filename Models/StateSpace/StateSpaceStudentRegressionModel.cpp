@@ -76,16 +76,14 @@ namespace BOOM {
 
   double AugmentedData::adjusted_observation(
       const GlmCoefs &coefficients) const {
-    double ans = 0;
-    double total_precision = 0;
+    CollapsedObservation ans;
     for (int i = 0; i < regression_data_.size(); ++i) {
       const RegressionData &data(regression_data(i));
       if (data.missing() == Data::observed) {
-        ans += weights_[i] * (data.y() - coefficients.predict(data.x()));
-        total_precision += weights_[i];
+        ans.add(data.y() - coefficients.predict(data.x()), weights_[i]);
       }
     }
-    return total_precision > 0 ? ans / total_precision : 0;
+    return ans.precision() > 0 ? ans.value() : 0;
   }
 
   double AugmentedData::sum_of_weights() const {
@@ -0,0 +1,87 @@
+#include "gtest/gtest.h"
+#include "Models/StateSpace/BatchForecaster.hpp"
+#include "Models/StateSpace/StateModels/LocalLevelStateModel.hpp"
+#include "Models/PosteriorSamplers/ZeroMeanGaussianConjSampler.hpp"
+#include "cpputil/ThreadTools.hpp"
+#include "distributions.hpp"
+#include "test_utils/test_utils.hpp"
+#include <limits>
+
+namespace {
+  using namespace BOOM;
+  using std::endl;
+  using std::cout;
+
+  class BatchForecasterTest : public ::testing::Test {
+   protected:
+    BatchForecasterTest() {
+      GlobalRng::rng.seed(8675309);
+      options_.niter = 200;
+      options_.burn = 50;
+      options_.horizon = 5;
+      options_.quantiles = Vector{.1, .5, .9};
+      for (int s = 0; s < 4; ++s) {
+        Vector y(60);
+        double level = 10 * s;
+        for (int t = 0; t < y.size(); ++t) {
+          level += rnorm(0, .1);
+          y[t] = level + rnorm(0, .5);
+        }
+        series_.push_back(y);
+      }
+      series_[2][10] = std::numeric_limits<double>::quiet_NaN();
+    }
+
+    static void local_level(StateSpaceModel &model, RNG &seeding_rng) {
+      NEW(LocalLevelStateModel, level)(.1);
+      NEW(ZeroMeanGaussianConjSampler, level_sampler)(
+          level.get(), 1, .1, seeding_rng);
+      level->set_method(level_sampler);
+      level->set_initial_state_mean(model.adjusted_observation(0));
+      level->set_initial_state_variance(1.0);
+      model.add_state(level);
+    }
+
+    BatchStateSpaceForecaster::Options options_;
+    std::vector<Vector> series_;
+  };
+
+  TEST_F(BatchForecasterTest, QuantilesAreSensible) {
+    BatchStateSpaceForecaster forecaster(local_level, options_);
+    Array ans = forecaster.forecast(series_);
+    ASSERT_EQ(3, ans.ndim());
+    EXPECT_EQ(4, ans.dim(0));
+    EXPECT_EQ(3, ans.dim(1));
+    EXPECT_EQ(5, ans.dim(2));
+    for (int s = 0; s < 4; ++s) {
+      for (int h = 0; h < 5; ++h) {
+        EXPECT_LT(ans(s, 0, h), ans(s, 1, h));
+        EXPECT_LT(ans(s, 1, h), ans(s, 2, h));
+      }
+      EXPECT_NEAR(ans(s, 1, 0), series_[s].back(), 2.0);
+    }
+  }
+
+  TEST_F(BatchForecasterTest, ResultsDoNotDependOnThreads) {
+    BatchStateSpaceForecaster forecaster(local_level, options_);
+    int original_pool_size = global_thread_pool_size();
+    set_global_thread_pool_size(0);
+    Array serial = forecaster.forecast(series_);
+    set_global_thread_pool_size(3);
+    Array parallel = forecaster.forecast(series_);
+    set_global_thread_pool_size(original_pool_size);
+
+    Matrix single = forecaster.forecast_one(series_[3], 3);
+    for (int q = 0; q < 3; ++q) {
+      for (int h = 0; h < 5; ++h) {
+        EXPECT_DOUBLE_EQ(single(q, h), serial(3, q, h));
+      }
+    }
+    for (int s = 0; s < 4; ++s) {
+      for (int h = 0; h < 5; ++h) {
+        EXPECT_DOUBLE_EQ(serial(s, 1, h), parallel(s, 1, h));
+      }
+    }
+  }
+
+}  // namespace
@@ -446,4 +446,47 @@ namespace {
     std::cout << final_beta_draws << beta_path.last_col() << std::endl;
   }
 
+  // The per-coefficient hyperparameter updates produce the same draws no
+  // matter how many threads share the work.
+  TEST_F(DynamicRegressionDirectGibbsTest, ThreadedHyperparameters) {
+    int time_dimension = 15;
+    int xdim = 4;
+    Vector beta(xdim, 1.0);
+    std::vector<Ptr<RegressionDataTimePoint>> data;
+    for (int t = 0; t < time_dimension; ++t) {
+      data.push_back(new RegressionDataTimePoint(
+          simulate_data(20, beta, 1.0)));
+    }
+
+    auto run = [&](int number_of_threads) {
+      NEW(DynamicRegressionModel, model)(xdim);
+      for (const auto &time_point : data) {
+        model->add_data(time_point);
+      }
+      RNG seeding_rng(8675309);
+      NEW(DynamicRegressionDirectGibbsSampler, sampler)(
+          model.get(), 1.0, 1.0, Vector(xdim, .01), Vector(xdim, 1.0),
+          Vector(xdim, .9), Vector(xdim, 10.0), Vector(xdim, 1.0),
+          seeding_rng);
+      sampler->set_number_of_threads(number_of_threads);
+      model->set_method(sampler);
+      for (int t = 0; t < time_dimension; ++t) {
+        model->set_inclusion_indicators(t, Selector(xdim, true));
+      }
+      Vector ans;
+      for (int i = 0; i < 5; ++i) {
+        model->sample_posterior();
+        ans.concat(model->unscaled_innovation_variances());
+        for (int j = 0; j < xdim; ++j) {
+          ans.concat(model->transition_model(j)->Q().row(1));
+        }
+      }
+      return ans;
+    };
+
+    Vector serial = run(0);
+    EXPECT_TRUE(VectorEquals(serial, run(2)));
+    EXPECT_TRUE(VectorEquals(serial, run(4)));
+  }
+
 }  // namespace
@@ -0,0 +1,108 @@
+#include "gtest/gtest.h"
+#include "Models/StateSpace/PosteriorSamplers/LiuWestStateSpaceFilter.hpp"
+#include "Models/StateSpace/StateModels/LocalLevelStateModel.hpp"
+#include "distributions.hpp"
+#include "test_utils/test_utils.hpp"
+
+namespace {
+  using namespace BOOM;
+  using std::endl;
+  using std::cout;
+
+  class LiuWestStateSpaceFilterTest : public ::testing::Test {
+   protected:
+    LiuWestStateSpaceFilterTest() {
+      GlobalRng::rng.seed(8675309);
+      int n = 100;
+      y_.resize(n);
+      double level = 3.0;
+      for (int t = 0; t < n; ++t) {
+        level += rnorm(0, .2);
+        y_[t] = level + rnorm(0, .5);
+      }
+    }
+
+    Ptr<StateSpaceModel> local_level_model(int ntrain) {
+      NEW(StateSpaceModel, model)(Vector(y_.begin(), y_.begin() + ntrain));
+      model->observation_model()->set_sigsq(.25);
+      NEW(LocalLevelStateModel, level)(.2);
+      level->set_initial_state_mean(y_[0]);
+      level->set_initial_state_variance(1.0);
+      model->add_state(level);
+      return model;
+    }
+
+    Vector y_;
+  };
+
+  // With identical particles the kernel is degenerate, so the filter reduces
+  // to the Kalman filter, and the predictive density of the new data matches
+  // the change in the log likelihood.
+  TEST_F(LiuWestStateSpaceFilterTest, IdenticalParticlesMatchKalmanFilter) {
+    int ntrain = 80;
+    Ptr<StateSpaceModel> model = local_level_model(ntrain);
+    double training_loglike = model->log_likelihood();
+    Vector parameters = model->vectorize_params(true);
+    Matrix draws(10, parameters.size());
+    for (int i = 0; i < draws.nrow(); ++i) {
+      draws.row(i) = parameters;
+    }
+
+    LiuWestStateSpaceFilter filter(model);
+    filter.set_particles(draws);
+    for (int t = ntrain; t < y_.size(); ++t) {
+      filter.update(GlobalRng::rng, y_[t], t == 90);
+    }
+    EXPECT_EQ(y_.size(), filter.time_dimension());
+    EXPECT_TRUE(VectorEquals(parameters, model->vectorize_params(true)));
+    EXPECT_TRUE(model->is_missing_observation(90));
+
+    double full_loglike = model->log_likelihood();
+    EXPECT_NEAR(full_loglike - training_loglike,
+                filter.log_predictive_density(), 1e-6);
+    EXPECT_NEAR(10.0, filter.effective_sample_size(), 1e-8);
+
+    model->kalman_filter();
+    Vector final_mean = model->get_filter().back().state_mean();
+    Matrix means = filter.predicted_state_means();
+    for (int i = 0; i < means.nrow(); ++i) {
+      EXPECT_NEAR(final_mean[0], means(i, 0), 1e-8);
+    }
+  }
+
+  TEST_F(LiuWestStateSpaceFilterTest, ParameterLearning) {
+    int ntrain = 50;
+    Ptr<StateSpaceModel> model = local_level_model(ntrain);
+    Vector parameters = model->vectorize_params(true);
+    int nparticles = 200;
+    Matrix draws(nparticles, parameters.size());
+    for (int i = 0; i < nparticles; ++i) {
+      for (int j = 0; j < parameters.size(); ++j) {
+        draws(i, j) = parameters[j] * exp(rnorm(0, .5));
+      }
+    }
+
+    LiuWestStateSpaceFilter filter(model, .1);
+    filter.set_particles(draws);
+    for (int t = ntrain; t < y_.size(); ++t) {
+      filter.update(GlobalRng::rng, y_[t]);
+    }
+    EXPECT_NEAR(1.0, sum(filter.particle_weights()), 1e-8);
+    EXPECT_GT(filter.effective_sample_size(), 1.0);
+
+    Matrix parameter_draws = filter.parameter_distribution();
+    EXPECT_EQ(nparticles, parameter_draws.nrow());
+    EXPECT_EQ(parameters.size(), parameter_draws.ncol());
+    for (int i = 0; i < nparticles; ++i) {
+      for (int j = 0; j < parameters.size(); ++j) {
+        EXPECT_GT(parameter_draws(i, j), 0);
+      }
+    }
+
+    Matrix forecast = filter.simulate_forecast(GlobalRng::rng, 3);
+    EXPECT_EQ(nparticles, forecast.nrow());
+    EXPECT_EQ(3, forecast.ncol());
+    EXPECT_NEAR(y_.back(), mean(forecast.col(0)), 1.0);
+  }
+
+}  // namespace
@@ -0,0 +1,153 @@
+#include "gtest/gtest.h"
+#include "Models/GaussianModel.hpp"
+#include "Models/ParamDrawRecorder.hpp"
+#include "Models/StateSpace/StateSpaceMemoryEstimate.hpp"
+#include "Models/StateSpace/StateSpaceModel.hpp"
+#include "Models/StateSpace/StateModels/LocalLevelStateModel.hpp"
+#include "Models/StateSpace/StateModels/SeasonalStateModel.hpp"
+#include "Models/StateSpace/PosteriorSamplers/StateSpacePosteriorSampler.hpp"
+#include "Models/PosteriorSamplers/ZeroMeanGaussianConjSampler.hpp"
+#include "distributions.hpp"
+
+#include "test_utils/test_utils.hpp"
+
+namespace {
+  using namespace BOOM;
+  using std::endl;
+  using std::cout;
+
+  class MemoryFootprintTest : public ::testing::Test {
+   protected:
+    MemoryFootprintTest() {
+      GlobalRng::rng.seed(8675309);
+    }
+
+    // A local level plus seasonal model fit to simulated data.
+    Ptr<StateSpaceModel> local_level_model(int time_dimension) {
+      Vector y(time_dimension);
+      double level = 0;
+      for (int t = 0; t < time_dimension; ++t) {
+        level += rnorm(0, .1);
+        y[t] = level + rnorm(0, 1.0);
+      }
+      NEW(StateSpaceModel, model)(y);
+      NEW(LocalLevelStateModel, level_model)(.1);
+      level_model->set_initial_state_mean(0.0);
+      level_model->set_initial_state_variance(1.0);
+      NEW(ZeroMeanGaussianConjSampler, level_sampler)(
+          level_model.get(), 1, .1);
+      level_model->set_method(level_sampler);
+      model->add_state(level_model);
+
+      NEW(SeasonalStateModel, seasonal)(7);
+      seasonal->set_initial_state_mean(Vector(6, 0.0));
+      seasonal->set_initial_state_variance(SpdMatrix(6, 1.0));
+      NEW(ZeroMeanGaussianConjSampler, seasonal_sampler)(
+          seasonal.get(), 1, .1);
+      seasonal->set_method(seasonal_sampler);
+      model->add_state(seasonal);
+
+      NEW(ZeroMeanGaussianConjSampler, observation_sampler)(
+          model->observation_model(), 1, 1);
+      model->observation_model()->set_method(observation_sampler);
+      NEW(StateSpacePosteriorSampler, sampler)(model.get());
+      model->set_method(sampler);
+      return model;
+    }
+  };
+
+  TEST_F(MemoryFootprintTest, Categories) {
+    MemoryFootprint footprint(MemoryFootprint::kData, 100);
+    footprint.add(MemoryFootprint::kParameters, 20);
+    footprint.add(MemoryFootprint::kData, 5);
+    EXPECT_EQ(105, footprint.bytes(MemoryFootprint::kData));
+    EXPECT_EQ(0, footprint.bytes(MemoryFootprint::kState));
+    EXPECT_EQ(125, footprint.total());
+
+    MemoryFootprint other(MemoryFootprint::kState, 8);
+    other.add(footprint);
+    EXPECT_EQ(133, other.total());
+    EXPECT_EQ(3, other.categories().size());
+  }
+
+  TEST_F(MemoryFootprintTest, DataGrowsWithSize) {
+    NEW(VectorData, small)(Vector(10));
+    NEW(VectorData, large)(Vector(1000));
+    EXPECT_GE(large->memory_footprint() - small->memory_footprint(),
+              990 * sizeof(double));
+
+    GaussianModel model(0, 1);
+    for (int i = 0; i < 100; ++i) {
+      model.add_data(new DoubleData(rnorm()));
+    }
+    MemoryFootprint footprint = model.memory_footprint();
+    EXPECT_GE(footprint.bytes(MemoryFootprint::kData),
+              100 * sizeof(DoubleData));
+    EXPECT_GT(footprint.bytes(MemoryFootprint::kSufficientStatistics), 0);
+    EXPECT_GT(footprint.bytes(MemoryFootprint::kParameters), 0);
+  }
+
+  TEST_F(MemoryFootprintTest, ParamDrawRecorder) {
+    GaussianModel model(0, 1);
+    ParamDrawRecorder recorder;
+    recorder.add_parameter("mu", model.Mu_prm());
+    recorder.add_parameter("sigsq", model.Sigsq_prm(), false, 1, true);
+    recorder.prepare_to_write(100);
+    EXPECT_EQ(100 * sizeof(double) + 100 * sizeof(float),
+              recorder.memory_footprint().bytes(MemoryFootprint::kMcmcOutput));
+  }
+
+  // The dry-run estimate agrees with the footprint of a fitted model.
+  TEST_F(MemoryFootprintTest, EstimateMatchesModel) {
+    int time_dimension = 300;
+    Ptr<StateSpaceModel> model = local_level_model(time_dimension);
+    model->sample_posterior();
+    model->kalman_filter();
+    MemoryFootprint actual = model->memory_footprint();
+
+    StateSpaceMemoryOptions options;
+    options.time_dimension = time_dimension;
+    options.state_dimension = model->state_dimension();
+    options.number_of_state_models = model->number_of_state_models();
+    options.niter = 0;
+    MemoryFootprint estimate = EstimateStateSpaceMemory(options);
+
+    EXPECT_EQ(actual.bytes(MemoryFootprint::kState),
+              estimate.bytes(MemoryFootprint::kState));
+    double filter_ratio =
+        double(estimate.bytes(MemoryFootprint::kKalmanFilter))
+        / actual.bytes(MemoryFootprint::kKalmanFilter);
+    EXPECT_NEAR(1.0, filter_ratio, .25)
+        << "estimate: " << estimate << endl
+        << "actual: " << actual;
+    double data_ratio = double(estimate.bytes(MemoryFootprint::kData))
+        / actual.bytes(MemoryFootprint::kData);
+    EXPECT_NEAR(1.0, data_ratio, .25)
+        << "estimate: " << estimate << endl
+        << "actual: " << actual;
+  }
+
+  TEST_F(MemoryFootprintTest, EstimateOfMcmcOutput) {
+    StateSpaceMemoryOptions options;
+    options.time_dimension = 100;
+    options.state_dimension = 8;
+    options.number_of_state_models = 2;
+    options.niter = 1000;
+    MemoryFootprint with_state_contributions =
+        EstimateStateSpaceMemory(options);
+    EXPECT_EQ(1000 * (8 + 1 + 2 * 100 + 100) * sizeof(double),
+              with_state_contributions.bytes(MemoryFootprint::kMcmcOutput));
+
+    options.save_full_state = true;
+    MemoryFootprint with_full_state = EstimateStateSpaceMemory(options);
+    EXPECT_EQ(1000 * 8 * 100 * sizeof(double),
+              with_full_state.bytes(MemoryFootprint::kMcmcOutput)
+              - with_state_contributions.bytes(MemoryFootprint::kMcmcOutput));
+
+    options.keep_state_variances = false;
+    EXPECT_LT(EstimateStateSpaceMemory(options).bytes(
+                  MemoryFootprint::kKalmanFilter),
+              with_full_state.bytes(MemoryFootprint::kKalmanFilter));
+  }
+
+}  // namespace
@@ -1,6 +1,7 @@
 #include "gtest/gtest.h"
 #include "Models/StateSpace/AggregatedStateSpaceRegression.hpp"
 #include "distributions.hpp"
+#include "test_utils/test_utils.hpp"
 
 namespace {
   using namespace BOOM;
@@ -42,4 +43,41 @@ namespace {
   //   x[500] = 4;
   // }
 
+  // The blockwise products for the cumulator transition should match dense
+  // matrix algebra on the expanded state.
+  TEST_F(FineNowcastingDataTest, AccumulatorTransitionSandwich) {
+    BlockDiagonalMatrix client_transition;
+    client_transition.add_block(new LocalLinearTrendMatrix);
+    client_transition.add_block(new SeasonalStateSpaceMatrix(4));
+    int client_dim = client_transition.nrow();
+
+    SparseVector Z(client_dim);
+    Z[0] = 1.0;
+    Z[2] = 0.7;
+
+    for (bool contains_end : {true, false}) {
+      AccumulatorTransitionMatrix transition(&client_transition, Z, .3,
+                                             contains_end);
+      Matrix dense = transition.dense();
+
+      SpdMatrix P(client_dim + 2);
+      P.randomize();
+      SpdMatrix original_P = P;
+      transition.sandwich_inplace(P);
+      EXPECT_TRUE(MatrixEquals(P, dense * original_P * dense.transpose(),
+                               1e-8));
+
+      SpdMatrix N(client_dim + 2);
+      N.randomize();
+      SpdMatrix original_N = N;
+      transition.sandwich_inplace_transpose(N);
+      EXPECT_TRUE(MatrixEquals(N, dense.transpose() * original_N * dense,
+                               1e-8));
+
+      Vector v(client_dim + 2);
+      v.randomize();
+      EXPECT_TRUE(VectorEquals(transition.Tmult(v), v * dense, 1e-8));
+    }
+  }
+
 }  // namespace
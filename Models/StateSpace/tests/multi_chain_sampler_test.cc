@@ -0,0 +1,115 @@
+#include "gtest/gtest.h"
+#include "Models/StateSpace/StateSpaceModel.hpp"
+#include "Models/StateSpace/PosteriorSamplers/MultiChainStateSpaceSampler.hpp"
+#include "Models/StateSpace/PosteriorSamplers/StateSpacePosteriorSampler.hpp"
+#include "Models/StateSpace/StateModels/LocalLevelStateModel.hpp"
+#include "Models/PosteriorSamplers/ZeroMeanGaussianConjSampler.hpp"
+#include "cpputil/ThreadTools.hpp"
+#include "distributions.hpp"
+#include "test_utils/test_utils.hpp"
+
+namespace {
+  using namespace BOOM;
+  using std::endl;
+  using std::cout;
+
+  class MultiChainSamplerTest : public ::testing::Test {
+   protected:
+    MultiChainSamplerTest() {
+      GlobalRng::rng.seed(8675309);
+      int n = 100;
+      Vector y(n);
+      double level = 0;
+      for (int t = 0; t < n; ++t) {
+        level += rnorm(0, .3);
+        y[t] = level + rnorm(0, 1);
+      }
+      model_.reset(new StateSpaceModel(y));
+      NEW(LocalLevelStateModel, level_model)(.5);
+      NEW(ZeroMeanGaussianConjSampler, level_sampler)(
+          level_model.get(), 1, .3);
+      level_model->set_method(level_sampler);
+      level_model->set_initial_state_mean(y[0]);
+      level_model->set_initial_state_variance(1.0);
+      model_->add_state(level_model);
+      NEW(ZeroMeanGaussianConjSampler, observation_sampler)(
+          model_->observation_model(), 1, 1);
+      model_->observation_model()->set_method(observation_sampler);
+      NEW(StateSpacePosteriorSampler, sampler)(model_.get());
+      model_->set_method(sampler);
+    }
+
+    Ptr<StateSpaceModel> model_;
+  };
+
+  TEST_F(MultiChainSamplerTest, ChainsShareDataAndDiffer) {
+    MultiChainStateSpaceSampler sampler(*model_, 3, 12345);
+    EXPECT_EQ(3, sampler.number_of_chains());
+    const StateSpaceModel *chain =
+        dynamic_cast<const StateSpaceModel *>(sampler.chain(1));
+    ASSERT_TRUE(chain != nullptr);
+    EXPECT_EQ(model_->dat()[7].get(), chain->dat()[7].get());
+
+    int iterations = sampler.run(300, 50);
+    EXPECT_EQ(300, iterations);
+    EXPECT_EQ(250, sampler.monitor().sample_size(0));
+    EXPECT_NE(sampler.chain(0)->vectorize_params(),
+              sampler.chain(1)->vectorize_params());
+
+    Vector rhat = sampler.rhat();
+    EXPECT_EQ(model_->vectorize_params().size(), rhat.size());
+    for (int i = 0; i < rhat.size(); ++i) {
+      EXPECT_LT(rhat[i], 1.5);
+      EXPECT_GT(sampler.effective_sample_size()[i], 0.0);
+    }
+  }
+
+  TEST_F(MultiChainSamplerTest, ReproducibleWithThreads) {
+    int original_pool_size = global_thread_pool_size();
+    set_global_thread_pool_size(2);
+    MultiChainStateSpaceSampler first(*model_, 2, 999);
+    first.run(40);
+    MultiChainStateSpaceSampler second(*model_, 2, 999);
+    second.run(40);
+    set_global_thread_pool_size(original_pool_size);
+    EXPECT_TRUE(VectorEquals(first.chain(1)->vectorize_params(),
+                             second.chain(1)->vectorize_params()));
+  }
+
+  TEST_F(MultiChainSamplerTest, EarlyStopping) {
+    MultiChainStateSpaceSampler sampler(*model_, 3, 4);
+    sampler.set_stopping_rule(1.2, 10, 50);
+    int iterations = sampler.run(5000, 50);
+    EXPECT_LT(iterations, 5000);
+    EXPECT_EQ(0, (iterations - 50) % 50);
+    EXPECT_TRUE(sampler.converged());
+  }
+
+  // Chains running on worker threads report their progress through the
+  // telemetry buffer.
+  TEST_F(MultiChainSamplerTest, Telemetry) {
+    int original_pool_size = global_thread_pool_size();
+    set_global_thread_pool_size(3);
+    McmcTelemetry telemetry;
+    std::vector<McmcTelemetryRecord> records;
+    telemetry.set_callback([&records](const McmcTelemetryRecord &record) {
+      records.push_back(record);
+    });
+    MultiChainStateSpaceSampler sampler(*model_, 3, 12345);
+    sampler.set_telemetry(&telemetry, 25);
+    sampler.run(100, 50);
+    set_global_thread_pool_size(original_pool_size);
+
+    EXPECT_EQ(12, telemetry.flush());
+    EXPECT_EQ(0, telemetry.number_dropped());
+    std::vector<int> last_iteration(3, 0);
+    for (const auto &record : records) {
+      EXPECT_EQ(last_iteration[record.chain] + 25, record.iteration);
+      last_iteration[record.chain] = record.iteration;
+      EXPECT_TRUE(std::isfinite(record.log_posterior));
+      EXPECT_GT(record.iterations_per_second, 0.0);
+    }
+    EXPECT_EQ(std::vector<int>(3, 100), last_iteration);
+  }
+
+}  // namespace
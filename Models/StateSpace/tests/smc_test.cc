@@ -0,0 +1,150 @@
+#include "gtest/gtest.h"
+#include "Models/StateSpace/PosteriorSamplers/StateSpaceSmcModels.hpp"
+#include "Models/StateSpace/StateModels/LocalLevelStateModel.hpp"
+#include "Samplers/SequentialMonteCarlo.hpp"
+#include "distributions.hpp"
+#include "test_utils/test_utils.hpp"
+
+namespace {
+  using namespace BOOM;
+  using std::endl;
+  using std::cout;
+
+  class SmcTest : public ::testing::Test {
+   protected:
+    SmcTest() {
+      GlobalRng::rng.seed(8675309);
+      int n = 50;
+      level_.resize(n);
+      double level = 1.0;
+      for (int t = 0; t < n; ++t) {
+        level += rnorm(0, .1);
+        level_[t] = level;
+      }
+    }
+
+    Ptr<LocalLevelStateModel> level_model(double initial_mean) {
+      NEW(LocalLevelStateModel, level)(.1);
+      level->set_initial_state_mean(initial_mean);
+      level->set_initial_state_variance(1.0);
+      return level;
+    }
+
+    Vector level_;
+  };
+
+  // Stratified and systematic resampling give each category a count within
+  // one of its expected value.
+  TEST_F(SmcTest, LowVarianceResampling) {
+    Vector probs = {.1, .25, .05, .6};
+    int n = 1000;
+    for (auto method : {ResamplingMethod::STRATIFIED,
+                        ResamplingMethod::SYSTEMATIC}) {
+      std::vector<int> index =
+          resample_indices(GlobalRng::rng, probs, n, method);
+      ASSERT_EQ(n, index.size());
+      Vector counts(probs.size(), 0.0);
+      for (int i : index) {
+        ++counts[i];
+      }
+      for (int k = 0; k < probs.size(); ++k) {
+        EXPECT_LE(fabs(counts[k] - n * probs[k]), 1.0 + 1e-8);
+      }
+    }
+    std::vector<int> index = resample_indices(
+        GlobalRng::rng, probs, n, ResamplingMethod::MULTINOMIAL);
+    EXPECT_EQ(n, index.size());
+  }
+
+  // The particle filter estimate of the log likelihood of a Gaussian local
+  // level model is close to the exact value from the Kalman filter.
+  TEST_F(SmcTest, GaussianLikelihoodMatchesKalmanFilter) {
+    Vector y(level_.size());
+    for (int t = 0; t < y.size(); ++t) {
+      y[t] = level_[t] + rnorm(0, .3);
+    }
+    NEW(StateSpaceModel, model)(y);
+    model->observation_model()->set_sigsq(.09);
+    model->add_state(level_model(y[0]));
+    double loglike = model->log_likelihood();
+
+    NEW(StateSpaceSmcModel, smc_model)(model);
+    SequentialMonteCarloFilter filter(smc_model);
+    filter.initialize(GlobalRng::rng, 5000);
+    EXPECT_EQ(-1, filter.time());
+    for (int t = 0; t < y.size(); ++t) {
+      filter.update(GlobalRng::rng);
+    }
+    EXPECT_EQ(y.size() - 1, filter.time());
+    EXPECT_NEAR(loglike, filter.log_predictive_density(), 0.5);
+    EXPECT_GT(filter.number_of_resampling_events(), 0);
+
+    model->kalman_filter();
+    const Kalman::ScalarMarginalDistribution &final_marginal(
+        model->get_filter().back());
+    // The filtered mean at the final time point.
+    double filtered_mean = final_marginal.contemporaneous_state_mean()[0];
+    EXPECT_NEAR(filtered_mean, filter.state_mean()[0], .05);
+  }
+
+  // Multi-threaded propagation reproduces the single threaded output.
+  TEST_F(SmcTest, PoissonFilterIsReproducible) {
+    int n = level_.size();
+    Vector counts(n);
+    for (int t = 0; t < n; ++t) {
+      counts[t] = rpois(exp(level_[t]));
+    }
+    NEW(StateSpacePoissonModel, model)(counts, Vector(n, 1.0), Matrix(n, 1, 1.0));
+    model->add_state(level_model(1.0));
+    NEW(StateSpacePoissonSmcModel, smc_model)(model);
+
+    SequentialMonteCarloFilter serial(smc_model, .5,
+                                      ResamplingMethod::STRATIFIED);
+    SequentialMonteCarloFilter threaded(smc_model, .5,
+                                        ResamplingMethod::STRATIFIED);
+    threaded.set_number_of_threads(3);
+    RNG serial_rng(12345);
+    RNG threaded_rng(12345);
+    serial.initialize(serial_rng, 1000);
+    threaded.initialize(threaded_rng, 1000);
+    for (int t = 0; t < n; ++t) {
+      double serial_increment = serial.update(serial_rng);
+      EXPECT_DOUBLE_EQ(serial_increment, threaded.update(threaded_rng));
+      EXPECT_TRUE(std::isfinite(serial_increment));
+    }
+    EXPECT_TRUE(MatrixEquals(serial.particle_states(),
+                             threaded.particle_states()));
+    EXPECT_TRUE(VectorEquals(serial.log_weights(), threaded.log_weights()));
+    EXPECT_GE(serial.effective_sample_size(), 500.0);
+    EXPECT_NEAR(level_.back(), serial.state_mean()[0], .5);
+  }
+
+  // A filter that never resamples keeps accumulating weights, and can be
+  // restarted from a given set of particles.
+  TEST_F(SmcTest, LogitFilterWithoutResampling) {
+    int n = level_.size();
+    Vector successes(n), trials(n, 10.0);
+    for (int t = 0; t < n; ++t) {
+      successes[t] = rbinom(10, plogis(level_[t]));
+    }
+    NEW(StateSpaceLogitModel, model)(successes, trials, Matrix(n, 1, 1.0));
+    model->add_state(level_model(1.0));
+    NEW(StateSpaceLogitSmcModel, smc_model)(model);
+
+    SequentialMonteCarloFilter filter(smc_model, 0.0);
+    Matrix states(200, 1);
+    states.randomize();
+    filter.set_particles(states, 9);
+    for (int t = 10; t < n; ++t) {
+      filter.update(GlobalRng::rng);
+    }
+    EXPECT_EQ(0, filter.number_of_resampling_events());
+    EXPECT_LT(filter.effective_sample_size(), 200.0);
+    EXPECT_NEAR(1.0, sum(filter.particle_weights()), 1e-8);
+
+    filter.resample(GlobalRng::rng);
+    EXPECT_EQ(1, filter.number_of_resampling_events());
+    EXPECT_NEAR(200.0, filter.effective_sample_size(), 1e-6);
+  }
+
+}  // namespace
@@ -1,12 +1,14 @@
 #include "gtest/gtest.h"
 #include "Models/StateSpace/StateSpaceModel.hpp"
 #include "Models/StateSpace/PosteriorSamplers/StateSpacePosteriorSampler.hpp"
+#include "Models/StateSpace/StateModels/ArStateModel.hpp"
 #include "Models/StateSpace/StateModels/LocalLinearTrend.hpp"
 #include "Models/StateSpace/StateModels/SeasonalStateModel.hpp"
 #include "Models/ZeroMeanGaussianModel.hpp"
 #include "Models/PosteriorSamplers/ZeroMeanMvnIndependenceSampler.hpp"
 #include "Models/PosteriorSamplers/ZeroMeanGaussianConjSampler.hpp"
 #include "distributions.hpp"
+#include "numopt/NumericalDerivatives.hpp"
 
 #include "test_utils/test_utils.hpp"
 #include <fstream>
@@ -107,6 +109,277 @@ namespace {
         10,
         {60, 80, 90},
         false);
+    ASSERT_EQ(3, errors.size());
+    for (const auto &error : errors) {
+      EXPECT_EQ(10, error.nrow());
+      EXPECT_EQ(model_->time_dimension(), error.ncol());
+    }
+
+    // With fewer threads than cutpoints, the worker models are reused.
+    int original_pool_size = global_thread_pool_size();
+    set_global_thread_pool_size(2);
+    errors = compute_prediction_errors(*model_, 10, {60, 80, 90}, true);
+    set_global_thread_pool_size(original_pool_size);
+    ASSERT_EQ(3, errors.size());
+    for (const auto &error : errors) {
+      EXPECT_EQ(10, error.nrow());
+      EXPECT_EQ(model_->time_dimension(), error.ncol());
+      EXPECT_TRUE(std::isfinite(error(9, error.ncol() - 1)));
+    }
+  }
+
+  // The steady state shortcut in the Kalman filter should give the same
+  // answers as the full covariance recursion, including in the presence of
+  // missing data.
+  // A local linear trend plus day-of-week model with fixed parameters, used
+  // to compare different versions of the Kalman filter.
+  Ptr<StateSpaceModel> trend_seasonal_model(const Vector &y,
+                                            const std::vector<bool> &observed) {
+    NEW(StateSpaceModel, model)(y, observed);
+    NEW(LocalLinearTrendStateModel, trend)();
+    trend->set_initial_state_mean(Vector{5, 0});
+    trend->set_initial_state_variance(SpdMatrix(2, 3.0));
+    SpdMatrix trend_variance(2, 0.0);
+    trend_variance(0, 0) = .01;
+    trend_variance(1, 1) = .001;
+    trend->set_Sigma(trend_variance);
+    model->add_state(trend);
+    NEW(SeasonalStateModel, seasonal)(7);
+    seasonal->set_initial_state_mean(Vector(6, 0.0));
+    seasonal->set_initial_state_variance(SpdMatrix(6, 3.0));
+    seasonal->set_sigsq(.05);
+    model->add_state(seasonal);
+    model->observation_model()->set_sigsq(.2);
+    return model;
+  }
+
+  Vector simulate_series(int n) {
+    Vector y(n);
+    for (int t = 0; t < n; ++t) {
+      y[t] = 5 + sin(t) + rnorm(0, .3);
+    }
+    return y;
+  }
+
+  TEST_F(StateSpaceModelTest, SteadyStateFilter) {
+    int n = 300;
+    Vector y = simulate_series(n);
+    std::vector<bool> observed(n, true);
+    observed[40] = false;
+    observed[200] = false;
+    observed[201] = false;
+    Ptr<StateSpaceModel> model = trend_seasonal_model(y, observed);
+    EXPECT_TRUE(model->state_is_time_invariant());
+
+    ScalarKalmanFilter &filter(model->get_filter());
+    model->kalman_filter();
+    double steady_loglike = filter.log_likelihood();
+    Vector steady_errors = model->one_step_prediction_errors(true);
+    EXPECT_GT(filter.number_of_steady_state_updates(), 20);
+    EXPECT_LT(filter.number_of_steady_state_updates(), n - 3);
+
+    filter.set_steady_state_tolerance(-1);
+    model->kalman_filter();
+    EXPECT_EQ(0, filter.number_of_steady_state_updates());
+    EXPECT_NEAR(steady_loglike, filter.log_likelihood(), 1e-5);
+    Vector full_errors = model->one_step_prediction_errors(true);
+    EXPECT_TRUE(VectorEquals(steady_errors, full_errors, 1e-5))
+        << steady_errors - full_errors;
+  }
+
+  // The square root filter should match the ordinary filter.
+  TEST_F(StateSpaceModelTest, SquareRootFilter) {
+    int n = 100;
+    Vector y = simulate_series(n);
+    std::vector<bool> observed(n, true);
+    observed[10] = false;
+    observed[50] = false;
+    Ptr<StateSpaceModel> model = trend_seasonal_model(y, observed);
+    ScalarKalmanFilter &filter(model->get_filter());
+    filter.set_steady_state_tolerance(-1);
+
+    model->kalman_filter();
+    double loglike = filter.log_likelihood();
+    Vector errors = model->one_step_prediction_errors(true);
+    SpdMatrix final_variance = filter[n - 1].state_variance();
+    Vector final_gain = filter[n - 2].kalman_gain();
+
+    filter.set_square_root_filtering(true);
+    model->kalman_filter();
+    EXPECT_NEAR(loglike, filter.log_likelihood(), 1e-8);
+    EXPECT_TRUE(VectorEquals(errors, model->one_step_prediction_errors(true)));
+    EXPECT_TRUE(MatrixEquals(final_variance, filter[n - 1].state_variance()));
+    EXPECT_TRUE(VectorEquals(final_gain, filter[n - 2].kalman_gain()));
+    EXPECT_TRUE(filter[n - 1].state_variance().is_sym(1e-14));
+
+    // The steady state shortcut works with square root filtering.
+    filter.set_steady_state_tolerance(1e-8);
+    model->kalman_filter();
+    EXPECT_NEAR(loglike, filter.log_likelihood(), 1e-5);
+  }
+
+  // A filter that does not keep the state variance at every time point
+  // should give the same answers for everything posterior simulation needs.
+  TEST_F(StateSpaceModelTest, LeanFilterStorage) {
+    int n = 120;
+    Vector y = simulate_series(n);
+    std::vector<bool> observed(n, true);
+    observed[30] = false;
+    Ptr<StateSpaceModel> model = trend_seasonal_model(y, observed);
+    Ptr<StateSpaceModel> lean_model(model->clone());
+    lean_model->set_keep_filter_state_variances(false);
+
+    model->kalman_filter();
+    lean_model->kalman_filter();
+    ScalarKalmanFilter &filter(model->get_filter());
+    ScalarKalmanFilter &lean_filter(lean_model->get_filter());
+    EXPECT_DOUBLE_EQ(filter.log_likelihood(), lean_filter.log_likelihood());
+    EXPECT_EQ(filter.number_of_steady_state_updates(),
+              lean_filter.number_of_steady_state_updates());
+    EXPECT_EQ(0, lean_filter[10].state_variance().nrow());
+    EXPECT_TRUE(MatrixEquals(filter.back().state_variance(),
+                             lean_filter.back().state_variance()));
+    for (int t = 0; t < n; ++t) {
+      EXPECT_DOUBLE_EQ(filter[t].prediction_error(),
+                       lean_filter[t].prediction_error());
+      EXPECT_DOUBLE_EQ(filter[t].prediction_variance(),
+                       lean_filter[t].prediction_variance());
+      EXPECT_TRUE(VectorEquals(filter[t].kalman_gain(),
+                               lean_filter[t].kalman_gain()));
+    }
+
+    RNG rng(17);
+    RNG lean_rng(17);
+    model->impute_state(rng);
+    lean_model->impute_state(lean_rng);
+    EXPECT_TRUE(MatrixEquals(model->state(), lean_model->state()));
+
+    EXPECT_THROW(lean_model->Estep(true), std::exception);
+    lean_model->set_keep_filter_state_variances(true);
+    lean_model->kalman_filter();
+    EXPECT_TRUE(MatrixEquals(filter[10].state_variance(),
+                             lean_filter[10].state_variance()));
+  }
+
+  // Simulate a state forecast one draw at a time, from 'final_state' using
+  // the model's current parameters.
+  Matrix forecast_one_draw(StateSpaceModel &model, RNG &rng, int horizon,
+                           const Vector &final_state) {
+    Matrix ans(model.state_dimension(), horizon + 1);
+    ans.col(0) = final_state;
+    int T = model.time_dimension();
+    for (int h = 1; h <= horizon; ++h) {
+      model.simulate_next_state(rng, ans.col(h - 1), ans.col(h), T + h);
+    }
+    return ans;
+  }
+
+  // Forecasting many MCMC draws at once should match forecasting them one at
+  // a time with the same random numbers.
+  void check_multi_draw_forecast(StateSpaceModel &model) {
+    int ndraws = 5;
+    int horizon = 8;
+    Vector parameters = model.vectorize_params(true);
+    Matrix parameter_draws(ndraws, parameters.size());
+    Matrix final_states(ndraws, model.state_dimension());
+    for (int d = 0; d < ndraws; ++d) {
+      parameter_draws.row(d) = parameters * (1 + .01 * d);
+      for (int i = 0; i < model.state_dimension(); ++i) {
+        final_states(d, i) = rnorm();
+      }
+    }
+
+    RNG rng(12);
+    std::vector<Matrix> forecast = model.simulate_state_forecast(
+        rng, horizon, parameter_draws, final_states);
+    ASSERT_EQ(horizon + 1, forecast.size());
+    EXPECT_TRUE(VectorEquals(parameters, model.vectorize_params(true)));
+
+    RNG reference_rng(12);
+    for (int d = 0; d < ndraws; ++d) {
+      model.unvectorize_params(parameter_draws.row(d), true);
+      Matrix reference = forecast_one_draw(
+          model, reference_rng, horizon, final_states.row(d));
+      for (int h = 0; h <= horizon; ++h) {
+        EXPECT_TRUE(VectorEquals(reference.col(h), forecast[h].col(d)))
+            << "draw " << d << " horizon " << h;
+      }
+    }
+    model.unvectorize_params(parameters, true);
+  }
+
+  TEST_F(StateSpaceModelTest, MultiDrawStateForecast) {
+    int n = 50;
+    Vector y = simulate_series(n);
+    std::vector<bool> observed(n, true);
+    Ptr<StateSpaceModel> model = trend_seasonal_model(y, observed);
+    check_multi_draw_forecast(*model);
+
+    // An AR state model has a transition matrix that depends on its
+    // parameters, which exercises the draw-at-a-time path.
+    NEW(ArStateModel, ar)(2);
+    ar->set_phi(Vector{.6, .2});
+    ar->set_sigsq(.3);
+    model->add_state(ar);
+    check_multi_draw_forecast(*model);
+  }
+
+  // Evaluating the log likelihood at trial parameters does not disturb the
+  // main Kalman filter, so the log likelihood at the current parameters is
+  // still available without refiltering.
+  TEST_F(StateSpaceModelTest, TrialParameterEvaluation) {
+    setup();
+    for (int i = 0; i < 5; ++i) {
+      model_->sample_posterior();
+    }
+    double current_loglike = model_->log_likelihood();
+    ScalarKalmanFilter &filter(model_->get_filter());
+    EXPECT_EQ(KalmanFilterBase::CURRENT, filter.status());
+
+    Vector parameters = model_->vectorize_params();
+    Vector trial = parameters * 1.5;
+    double trial_loglike = model_->log_likelihood(trial);
+    EXPECT_NE(current_loglike, trial_loglike);
+    EXPECT_TRUE(VectorEquals(parameters, model_->vectorize_params()));
+    EXPECT_EQ(KalmanFilterBase::CURRENT, filter.status());
+    EXPECT_DOUBLE_EQ(current_loglike, model_->log_likelihood());
+
+    // The trial value matches a full filter run at the trial parameters.
+    model_->unvectorize_params(trial);
+    filter.set_status(KalmanFilterBase::NOT_CURRENT);
+    EXPECT_DOUBLE_EQ(trial_loglike, model_->log_likelihood());
+  }
+
+  // The analytic gradient of log likelihood matches a numerical derivative
+  // when the AR coefficients enter through the state transition matrix.
+  TEST_F(StateSpaceModelTest, ArLogLikelihoodGradient) {
+    int n = 200;
+    Vector phi = {.6, .2};
+    Vector ar(n + 2, 0.0);
+    Vector y(n);
+    for (int t = 0; t < n; ++t) {
+      ar[t + 2] = phi[0] * ar[t + 1] + phi[1] * ar[t] + rnorm(0, .7);
+      y[t] = ar[t + 2] + rnorm(0, .5);
+    }
+    NEW(StateSpaceModel, model)(y);
+    NEW(ArStateModel, ar_model)(2);
+    ar_model->set_phi(Vector{.5, .1});
+    ar_model->set_sigsq(.4);
+    model->add_state(ar_model);
+    model->observation_model()->set_sigsq(.3);
+
+    Vector parameters = model->vectorize_params(true);
+    Vector gradient(parameters.size());
+    double loglike = model->log_likelihood_derivatives(parameters, gradient);
+    EXPECT_NEAR(model->log_likelihood(parameters), loglike, 1e-8);
+
+    NumericalDerivatives numeric([&model](const Vector &x) {
+      return model->log_likelihood(x);
+    });
+    Vector numeric_gradient = numeric.gradient(parameters);
+    EXPECT_TRUE(VectorEquals(gradient, numeric_gradient, 1e-4))
+        << "analytic: " << gradient << endl
+        << "numeric:  " << numeric_gradient;
   }
 
 }  // namespace
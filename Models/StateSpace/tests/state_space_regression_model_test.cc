@@ -117,4 +117,126 @@ namespace {
                                          .95, .2));
   }
 
+  TEST_F(StateSpaceRegressionModelTest, CollapsedObservations) {
+    StateSpace::CollapsedObservation collapsed;
+    EXPECT_TRUE(collapsed.empty());
+    collapsed.add(1.0, 2.0);
+    collapsed.add(4.0, 1.0);
+    EXPECT_FALSE(collapsed.empty());
+    EXPECT_DOUBLE_EQ(2.0, collapsed.value());
+    EXPECT_DOUBLE_EQ(3.0, collapsed.precision());
+
+    // Several observations at one time point reduce to a single observation
+    // of the mean residual, with variance sigsq / n.
+    int xdim = 2;
+    StateSpaceRegressionModel model(xdim);
+    Vector beta = {1.0, -2.0};
+    model.regression_model()->set_Beta(beta);
+    model.regression_model()->set_sigsq(4.0);
+    NEW(StateSpace::MultiplexedRegressionData, data_point)();
+    Vector x0 = {1.0, 3.0};
+    Vector x1 = {1.0, -1.0};
+    Vector x2 = {1.0, 0.5};
+    data_point->add_data(new RegressionData(2.0, x0));
+    data_point->add_data(new RegressionData(7.0, x1));
+    NEW(RegressionData, missing_observation)(100.0, x2);
+    missing_observation->set_missing_status(Data::completely_missing);
+    data_point->add_data(missing_observation);
+    model.add_multiplexed_data(data_point);
+
+    double expected = ((2.0 - (1 - 6)) + (7.0 - (1 + 2))) / 2;
+    EXPECT_DOUBLE_EQ(expected, model.adjusted_observation(0));
+    EXPECT_DOUBLE_EQ(2.0, model.observation_variance(0));
+  }
+
+  // The cached regression contribution must track changes to the
+  // coefficients and to the data.
+  TEST_F(StateSpaceRegressionModelTest, CachedRegressionContribution) {
+    int xdim = 5;
+    int time_dimension = 20;
+    StateSpaceRegressionModel model(xdim);
+    Matrix X(3 * time_dimension, xdim);
+    X.randomize();
+    for (int t = 0; t < time_dimension; ++t) {
+      // Time point t has 1 + (t % 3) observations.
+      std::vector<Ptr<RegressionData>> observations;
+      for (int j = 0; j <= t % 3; ++j) {
+        observations.push_back(new RegressionData(1.0, X.row(3 * t + j)));
+      }
+      model.add_multiplexed_data(
+          new StateSpace::MultiplexedRegressionData(observations));
+    }
+
+    auto direct = [&model, xdim]() {
+      Vector ans(model.time_dimension());
+      const Vector &beta(model.regression_model()->Beta());
+      for (int t = 0; t < model.time_dimension(); ++t) {
+        const StateSpace::MultiplexedRegressionData &dp(*model.dat()[t]);
+        for (int j = 0; j < dp.total_sample_size(); ++j) {
+          ans[t] += dp.regression_data(j).x().dot(beta);
+        }
+        ans[t] /= dp.total_sample_size();
+      }
+      return ans;
+    };
+
+    Vector beta = {1.0, -2.0, 0.5, 3.0, 0.0};
+    model.regression_model()->set_Beta(beta);
+    EXPECT_TRUE(VectorEquals(model.regression_contribution(), direct(), 1e-10));
+
+    // A single changed coefficient is applied incrementally.
+    model.regression_model()->set_Beta(Vector{1.0, -2.0, 0.75, 3.0, 0.0});
+    EXPECT_TRUE(VectorEquals(model.regression_contribution(), direct(), 1e-10));
+
+    // Dropping a variable zeros its coefficient.
+    model.regression_model()->coef().drop(1);
+    EXPECT_TRUE(VectorEquals(model.regression_contribution(), direct(), 1e-10));
+
+    // Changing everything triggers a full recomputation.
+    model.regression_model()->coef().add(1);
+    model.regression_model()->set_Beta(Vector{-1.0, 2.0, 1.5, 0.25, 4.0});
+    EXPECT_TRUE(VectorEquals(model.regression_contribution(), direct(), 1e-10));
+
+    // Adding data invalidates the cached predictor means.
+    model.add_regression_data(new RegressionData(1.0, X.row(0)));
+    Vector contribution = model.regression_contribution();
+    EXPECT_EQ(time_dimension + 1, contribution.size());
+    EXPECT_TRUE(VectorEquals(contribution, direct(), 1e-10));
+  }
+
+  // X'X is computed once from the observed rows and survives clearing the
+  // client data, until new data arrives.
+  TEST_F(StateSpaceRegressionModelTest, FixedPredictorCrossProducts) {
+    int xdim = 3;
+    int sample_size = 12;
+    Matrix X(sample_size, xdim);
+    X.randomize();
+    Vector y(sample_size);
+    y.randomize();
+    std::vector<bool> observed(sample_size, true);
+    observed[4] = false;
+    StateSpaceRegressionModel model(y, X, observed);
+
+    SpdMatrix expected_xtx(xdim, 0.0);
+    for (int i = 0; i < sample_size; ++i) {
+      if (observed[i]) expected_xtx.add_outer(X.row(i));
+    }
+    model.clear_client_data();
+    const RegSuf &suf(*model.regression_model()->suf());
+    EXPECT_TRUE(MatrixEquals(suf.xtx(), expected_xtx, 1e-10));
+    EXPECT_DOUBLE_EQ(0.0, suf.n());
+    EXPECT_DOUBLE_EQ(0.0, suf.yty());
+
+    model.regression_model()->suf()->add_mixture_data(1.0, Vector(X.row(0)), 1.0);
+    model.clear_client_data();
+    EXPECT_TRUE(MatrixEquals(suf.xtx(), expected_xtx, 1e-10));
+    EXPECT_DOUBLE_EQ(0.0, suf.n());
+
+    Vector x = {1.0, 2.0, -1.0};
+    model.add_regression_data(new RegressionData(3.0, x));
+    expected_xtx.add_outer(x);
+    model.clear_client_data();
+    EXPECT_TRUE(MatrixEquals(suf.xtx(), expected_xtx, 1e-10));
+  }
+
 }  // namespace
@@ -125,4 +125,58 @@ namespace {
                                          .95, .2));
   }
 
+  // Imputing the latent weights in parallel should give draws that do not
+  // depend on the number of threads.
+  TEST_F(StateSpaceStudentRegressionTest, ThreadedImputation) {
+    int sample_size = 200;
+    int xdim = 2;
+    Matrix predictors(sample_size, xdim);
+    predictors.randomize();
+    Vector coefficients(xdim);
+    for (int i = 0; i < xdim; ++i) coefficients[i] = i + 1;
+    Vector y = predictors * coefficients
+        + cumsum(rnorm_vector(sample_size, 0, 1.0))
+        + rnorm_vector(sample_size, 0, .3);
+
+    auto run = [&](int number_of_threads) {
+      GlobalRng::rng.seed(31415);
+      NEW(StateSpaceStudentRegressionModel, model)(xdim);
+      NEW(LocalLevelStateModel, state_model)(1.0);
+      NEW(ZeroMeanGaussianConjSampler, state_model_sampler)(
+          state_model.get(), 1, 1.0);
+      state_model->set_method(state_model_sampler);
+      state_model->set_initial_state_mean(0);
+      state_model->set_initial_state_variance(1.0);
+      model->add_state(state_model);
+      NEW(TRegressionSpikeSlabSampler, observation_model_sampler)(
+          model->observation_model(),
+          new MvnModel(Vector(xdim, 0), SpdMatrix(xdim, 100.0)),
+          new VariableSelectionPrior(xdim, 0.5),
+          new ChisqModel(1, .3),
+          new UniformModel(0.1, 100));
+      model->observation_model()->set_method(observation_model_sampler);
+      NEW(StateSpaceStudentPosteriorSampler, sampler)(
+          model.get(), observation_model_sampler);
+      sampler->set_number_of_threads(number_of_threads);
+      model->set_method(sampler);
+      for (int i = 0; i < sample_size; ++i) {
+        model->add_data(new StateSpace::AugmentedStudentRegressionData(
+            y[i], predictors.row(i)));
+      }
+      for (int i = 0; i < 5; ++i) {
+        model->sample_posterior();
+      }
+      Vector weights(sample_size);
+      for (int i = 0; i < sample_size; ++i) {
+        weights[i] = model->dat()[i]->weight(0);
+      }
+      return weights;
+    };
+
+    Vector two_threads = run(2);
+    Vector four_threads = run(4);
+    EXPECT_TRUE(VectorEquals(two_threads, four_threads, 1e-12));
+    EXPECT_GT(min(two_threads), 0.0);
+  }
+
 }  // namespace
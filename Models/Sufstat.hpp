@@ -40,6 +40,15 @@ namespace BOOM {
     virtual void clear() = 0;
     virtual void update(const Ptr<Data> &) = 0;
     virtual void update(const Data &) = 0;
+
+    // Sufficient statistics where subtraction is exact can remove a data
+    // point that was previously passed to update().
+    virtual bool supports_remove() const { return false; }
+    virtual void remove(const Data &) {
+      report_error("These sufficient statistics do not support removing "
+                   "data.");
+    }
+
     virtual ~Sufstat() {}
     virtual Sufstat *clone() const override = 0;
     virtual Sufstat *abstract_combine(Sufstat *rhs) = 0;
@@ -51,6 +60,12 @@ namespace BOOM {
                                                bool minimal = true) = 0;
     virtual std::ostream &print(std::ostream &) const = 0;
 
+    // Estimated from the size of the vectorized statistics.
+    std::size_t memory_footprint() const override {
+      return sizeof(*this) + observer_bytes()
+          + vectorize(false).size() * sizeof(double);
+    }
+
     std::ostream &display(std::ostream &out) const override {
       return print(out);
     }
@@ -83,6 +98,16 @@ namespace BOOM {
     void update(const Data &d) override {
       Update(dynamic_cast<const DataType &>(d));
     }
+    void remove(const Data &d) override {
+      Remove(dynamic_cast<const DataType &>(d));
+    }
+
+    // Classes that override Remove should also override supports_remove to
+    // return true.
+    virtual void Remove(const DataType &) {
+      report_error("These sufficient statistics do not support removing "
+                   "data.");
+    }
   };
 
   //==================================================================
@@ -55,6 +55,61 @@ namespace BOOM {
     reg_suf_->add_mixture_data(y, x, weight);
   }
 
+  // With the series held by 'series' (earlier lags first), the regression of
+  // series[t] on series[t-1], ..., series[t-p] for t = p, ..., T-1 has
+  //
+  //   xtx(i, j) = sum_{u = p-1-i}^{T-2-i} series[u] * series[u - (j - i)].
+  //
+  // Moving from (i, j) to (i + 1, j + 1) shifts the range of u down by one, so
+  // each diagonal of xtx is a single sum followed by O(1) updates.
+  void ArSuf::add_series(const Vector &y) {
+    const int p = reg_suf_->size();
+    std::vector<double> series(lags_.rbegin(), lags_.rend());
+    series.insert(series.end(), y.begin(), y.end());
+    const int T = series.size();
+    if (T > p) {
+      SpdMatrix xtx(p, 0.0);
+      Vector xty(p, 0.0);
+      Vector xbar(p, 0.0);
+      double yty = 0;
+      double ysum = 0;
+      for (int t = p; t < T; ++t) {
+        yty += series[t] * series[t];
+        ysum += series[t];
+      }
+      for (int i = 0; i < p; ++i) {
+        double cross = 0;
+        double sum = 0;
+        for (int t = p; t < T; ++t) {
+          cross += series[t] * series[t - 1 - i];
+          sum += series[t - 1 - i];
+        }
+        xty[i] = cross;
+        xbar[i] = sum;
+      }
+      for (int lag = 0; lag < p; ++lag) {
+        double value = 0;
+        for (int u = p - 1; u <= T - 2; ++u) {
+          value += series[u] * series[u - lag];
+        }
+        xtx(0, lag) = value;
+        for (int i = 0; i + lag + 1 < p; ++i) {
+          value += series[p - 2 - i] * series[p - 2 - i - lag]
+              - series[T - 2 - i] * series[T - 2 - i - lag];
+          xtx(i + 1, i + 1 + lag) = value;
+        }
+      }
+      xtx.reflect();
+      const double n = T - p;
+      reg_suf_->combine(NeRegSuf(xtx, xty, yty, n, ysum / n, xbar / n));
+    }
+
+    lags_.clear();
+    for (int t = T - 1; t >= 0 && lags_.size() < p; --t) {
+      lags_.push_back(series[t]);
+    }
+  }
+
   void ArSuf::combine(const Ptr<ArSuf> &s) { reg_suf_->combine(s->reg_suf_); }
 
   void ArSuf::combine(const ArSuf &s) { reg_suf_->combine(*s.reg_suf_); }
@@ -43,6 +43,12 @@ namespace BOOM {
     void Update(const DoubleData &y) override;
     void add_mixture_data(double y, const Vector &lags, double weight);
 
+    // Equivalent to calling Update() on each element of y in order, but the
+    // cross products of the lags are formed from lagged products of the
+    // series in O(T * p) operations, instead of a rank one update of xtx at
+    // each time point.
+    void add_series(const Vector &y);
+
     ArSuf *abstract_combine(Sufstat *s) override;
     void combine(const Ptr<ArSuf> &s);
     void combine(const ArSuf &s);
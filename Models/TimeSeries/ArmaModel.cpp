@@ -19,6 +19,7 @@
 #include "Models/TimeSeries/ArmaModel.hpp"
 #include "Models/StateSpace/Filters/SparseKalmanTools.hpp"
 #include "Models/TimeSeries/ArModel.hpp"
+#include "cpputil/Constants.hpp"
 #include "cpputil/math_utils.hpp"
 #include "distributions.hpp"
 
@@ -27,6 +28,54 @@ namespace BOOM {
   namespace {
     using ASSTM = ArmaStateSpaceTransitionMatrix;
     using ASSVM = ArmaStateSpaceVarianceMatrix;
+
+    // Autocovariances gamma[0], ..., gamma[nlags] of the ARMA process with
+    // unit innovation variance, from Brockwell and Davis (1991) section 3.3.
+    // With theta[0] = 1, and psi the MA(infinity) coefficients,
+    //
+    //  gamma[k] - sum_r phi[r] gamma[k - r] = sum_{j = k}^q theta[j] psi[j - k]
+    //
+    // The equations for k = 0, ..., p are solved jointly (using gamma[-k] =
+    // gamma[k]) and the rest follow by recursion.
+    Vector arma_autocovariance(const Vector &phi, const Vector &ma_coefficients,
+                               int nlags) {
+      const int p = phi.size();
+      const int q = ma_coefficients.size();
+      Vector theta = concat(1.0, ma_coefficients);
+      Vector psi(q + 1, 0.0);
+      for (int j = 0; j <= q; ++j) {
+        psi[j] = theta[j];
+        for (int r = 1; r <= std::min(j, p); ++r) {
+          psi[j] += phi[r - 1] * psi[j - r];
+        }
+      }
+      auto rhs = [&](int k) {
+        double ans = 0;
+        for (int j = k; j <= q; ++j) {
+          ans += theta[j] * psi[j - k];
+        }
+        return ans;
+      };
+
+      Vector gamma(std::max(nlags, p) + 1, 0.0);
+      Matrix system(p + 1, p + 1, 0.0);
+      Vector right_side(p + 1);
+      for (int k = 0; k <= p; ++k) {
+        system(k, k) += 1.0;
+        for (int r = 1; r <= p; ++r) {
+          system(k, std::abs(k - r)) -= phi[r - 1];
+        }
+        right_side[k] = rhs(k);
+      }
+      VectorView(gamma, 0, p + 1) = system.solve(right_side);
+      for (int k = p + 1; k < gamma.size(); ++k) {
+        gamma[k] = rhs(k);
+        for (int r = 1; r <= p; ++r) {
+          gamma[k] += phi[r - 1] * gamma[k - r];
+        }
+      }
+      return Vector(ConstVectorView(gamma, 0, nlags + 1));
+    }
   }  // namespace
 
   ASSTM::ArmaStateSpaceTransitionMatrix(const Vector &expanded_ar_coefficients)
@@ -285,6 +334,111 @@ namespace BOOM {
     return ans;
   }
 
+  // The innovations algorithm is applied to the transformed process
+  //
+  //   W[t] = y[t] / sigma                          t = 1, ..., m
+  //   W[t] = phi(B) y[t] / sigma                   t > m
+  //
+  // with m = max(p, q).  The covariance kappa(i, j) of W is banded once
+  // min(i, j) > m, so theta[n][j] is zero for j > q and the recursion for
+  // the innovation variances only involves the last q steps.
+  double ArmaModel::innovations_log_likelihood(const Vector &ar_coefficients,
+                                               const Vector &ma_coefficients,
+                                               double sigsq) const {
+    if (ar_coefficients.size() != ar_dimension()) {
+      report_error("ar_coefficients are the wrong size.");
+    }
+    if (ma_coefficients.size() != ma_dimension()) {
+      report_error("ma_coefficients are the wrong size.");
+    }
+    if (sigsq <= 0 || !is_invertible(ar_coefficients)) {
+      return negative_infinity();
+    }
+    const std::vector<Ptr<DoubleData>> &data(dat());
+    const int n = data.size();
+    if (n == 0) return 0;
+
+    const int p = ar_dimension();
+    const int q = ma_dimension();
+    const int m = std::max(p, q);
+    const Vector gamma = arma_autocovariance(ar_coefficients, ma_coefficients,
+                                             m);
+    const Vector theta = concat(1.0, ma_coefficients);
+
+    // kappa(i, j) for 1-based time indices i <= j.
+    auto kappa = [&](int i, int j) {
+      int lag = j - i;
+      if (j <= m) {
+        return gamma[lag];
+      } else if (i <= m) {
+        if (lag > m) return 0.0;
+        double ans = gamma[lag];
+        for (int r = 1; r <= p; ++r) {
+          ans -= ar_coefficients[r - 1] * gamma[std::abs(r - lag)];
+        }
+        return ans;
+      } else {
+        if (lag > q) return 0.0;
+        double ans = 0;
+        for (int r = 0; r + lag <= q; ++r) {
+          ans += theta[r] * theta[r + lag];
+        }
+        return ans;
+      }
+    };
+
+    // coefficients[k][j - 1] holds theta_{k, j}, the weight on the innovation
+    // j steps back in the prediction of W[k + 1].  Only the innovations that
+    // can have a nonzero weight are stored.
+    std::vector<Vector> coefficients(n);
+    Vector v(n);
+    Vector innovations(n);
+    const auto y = [&data](int t) { return data[t]->value(); };
+    v[0] = kappa(1, 1);
+    double sum_log_v = 0;
+    double sum_squares = 0;
+    for (int k = 0; k < n; ++k) {
+      if (k > 0) {
+        const int width = k < m ? k : std::min(k, q);
+        Vector &theta_k(coefficients[k]);
+        theta_k.resize(width);
+        // theta_{k, k - i} for i = k - width, ..., k - 1.
+        for (int i = k - width; i < k; ++i) {
+          double value = kappa(i + 1, k + 1);
+          for (int j = k - width; j < i; ++j) {
+            const Vector &theta_i(coefficients[i]);
+            int lag_i = i - j;
+            if (lag_i > theta_i.size()) continue;
+            value -= theta_i[lag_i - 1] * theta_k[k - j - 1] * v[j];
+          }
+          theta_k[k - i - 1] = value / v[i];
+        }
+        double vk = kappa(k + 1, k + 1);
+        for (int j = k - width; j < k; ++j) {
+          vk -= square(theta_k[k - j - 1]) * v[j];
+        }
+        v[k] = vk;
+      }
+
+      // The one step prediction of y[k] and its error.
+      double prediction = 0;
+      if (k >= m) {
+        for (int r = 1; r <= p; ++r) {
+          prediction += ar_coefficients[r - 1] * y(k - r);
+        }
+      }
+      const Vector &theta_k(coefficients[k]);
+      for (int j = 1; j <= theta_k.size(); ++j) {
+        prediction += theta_k[j - 1] * innovations[k - j];
+      }
+      innovations[k] = y(k) - prediction;
+      sum_log_v += log(v[k]);
+      sum_squares += square(innovations[k]) / v[k];
+    }
+    return -.5 * n * log(2 * Constants::pi * sigsq) - .5 * sum_log_v
+        - .5 * sum_squares / sigsq;
+  }
+
   Vector ArmaModel::expand_ar_coefficients(const Vector &ar_coefficients,
                                            int dimension) const {
     if (dimension < ar_coefficients.size()) {
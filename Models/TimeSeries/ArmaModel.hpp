@@ -201,6 +201,17 @@ namespace BOOM {
     double log_likelihood(const Vector &ar_coefficients,
                           const Vector &ma_coefficients, double sigsq) const;
 
+    // The exact log likelihood of the data under the stationary
+    // distribution of the process, computed with the innovations algorithm
+    // for ARMA processes (Brockwell and Davis, 1991, section 5.3).  After the
+    // first max(p, q) observations each step costs O(p + q^2) scalar
+    // operations, with no matrix arithmetic.  Arguments are as in
+    // log_likelihood().  Returns negative infinity if the AR coefficients
+    // are not stationary.
+    double innovations_log_likelihood(const Vector &ar_coefficients,
+                                      const Vector &ma_coefficients,
+                                      double sigsq) const;
+
     // Simulate an ARMA process of the specified length.
     // Args:
     //   length:  The desired number of observations in the simulated series.
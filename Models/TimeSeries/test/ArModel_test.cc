@@ -0,0 +1,48 @@
+#include "gtest/gtest.h"
+#include "Models/TimeSeries/ArModel.hpp"
+#include "distributions.hpp"
+#include "test_utils/test_utils.hpp"
+
+namespace {
+  using namespace BOOM;
+  using std::endl;
+
+  class ArModelTest : public ::testing::Test {
+   protected:
+    ArModelTest() {
+      GlobalRng::rng.seed(8675309);
+    }
+  };
+
+  // Adding a whole series matches adding its elements one at a time,
+  // including when the series arrives in pieces.
+  TEST_F(ArModelTest, AddSeriesMatchesUpdate) {
+    ArModel model(3);
+    model.set_phi(Vector{.5, .2, -.1});
+    Vector y = model.simulate(200);
+
+    ArSuf sequential(3);
+    for (double yt : y) {
+      sequential.Update(DoubleData(yt));
+    }
+
+    ArSuf batch(3);
+    batch.add_series(Vector(ConstVectorView(y, 0, 2)));
+    batch.add_series(Vector(ConstVectorView(y, 2, 100)));
+    batch.Update(DoubleData(y[102]));
+    batch.add_series(Vector(ConstVectorView(y, 103)));
+
+    EXPECT_DOUBLE_EQ(sequential.n(), batch.n());
+    EXPECT_NEAR(sequential.yty(), batch.yty(), 1e-8);
+    EXPECT_TRUE(VectorEquals(sequential.xty(), batch.xty()));
+    EXPECT_TRUE(MatrixEquals(sequential.xtx(), batch.xtx()))
+        << "sequential: " << endl << sequential.xtx()
+        << "batch: " << endl << batch.xtx();
+
+    // Subsequent updates see the same lags.
+    sequential.Update(DoubleData(1.5));
+    batch.Update(DoubleData(1.5));
+    EXPECT_TRUE(VectorEquals(sequential.xty(), batch.xty()));
+  }
+
+}  // namespace
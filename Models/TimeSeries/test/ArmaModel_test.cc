@@ -3,6 +3,8 @@
 #include "Models/TimeSeries/ArmaPriors.hpp"
 #include "Models/TimeSeries/PosteriorSamplers/ArmaSliceSampler.hpp"
 #include "Models/ChisqModel.hpp"
+#include "cpputil/math_utils.hpp"
+#include "distributions.hpp"
 #include "test_utils/test_utils.hpp"
 
 namespace {
@@ -113,6 +115,45 @@ namespace {
     EXPECT_LT(wrong_log_likelihood, true_log_likelihood);
   }
 
+  // Log likelihood of y under the stationary ARMA model, from the full
+  // Toeplitz covariance matrix.
+  double dense_arma_log_likelihood(const ArmaModel &model, const Vector &y) {
+    int n = y.size();
+    Vector acvf = model.autocovariance(n - 1);
+    SpdMatrix Sigma(n);
+    for (int i = 0; i < n; ++i) {
+      for (int j = 0; j < n; ++j) {
+        Sigma(i, j) = acvf[std::abs(i - j)];
+      }
+    }
+    return dmvn(y, Vector(n, 0.0), Sigma.inv(), true);
+  }
+
+  TEST_F(ArmaModelTest, InnovationsLogLikelihood) {
+    for (int p : {0, 1, 2}) {
+      for (int q : {0, 1, 2}) {
+        if (p + q == 0) continue;
+        Vector phi(phi_.begin(), phi_.begin() + p);
+        Vector theta(theta_.begin(), theta_.begin() + q);
+        ArmaModel model(new GlmCoefs(phi), new VectorParams(theta),
+                        new UnivParams(1.8));
+        Vector y = model.simulate(40, GlobalRng::rng);
+        for (int i = 0; i < y.size(); ++i) {
+          model.add_data(new DoubleData(y[i]));
+        }
+        EXPECT_NEAR(dense_arma_log_likelihood(model, y),
+                    model.innovations_log_likelihood(phi, theta, 1.8), 1e-4)
+            << "p = " << p << ", q = " << q;
+      }
+    }
+
+    ArmaModel model(new GlmCoefs(phi_), new VectorParams(theta_),
+                    new UnivParams(1.8));
+    model.add_data(new DoubleData(1.0));
+    EXPECT_EQ(negative_infinity(), model.innovations_log_likelihood(
+        Vector{1.2, .3}, theta_, 1.8));
+  }
+
   TEST_F(ArmaModelTest, Acf) {
     ArmaModel model(new GlmCoefs(phi_),
                     new VectorParams(theta_),
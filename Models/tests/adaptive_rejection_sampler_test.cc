@@ -0,0 +1,118 @@
+#include "gtest/gtest.h"
+#include "Samplers/ScalarAdaptiveRejectionSampler.hpp"
+#include "distributions.hpp"
+#include "distributions/BoundedAdaptiveRejectionSampler.hpp"
+
+#include "test_utils/test_utils.hpp"
+
+namespace {
+  using namespace BOOM;
+  using std::endl;
+  using std::cout;
+
+  class AdaptiveRejectionSamplerTest : public ::testing::Test {
+   protected:
+    AdaptiveRejectionSamplerTest() {
+      GlobalRng::rng.seed(8675309);
+    }
+  };
+
+  // A target that drifts slowly, as a full conditional distribution would
+  // from one MCMC iteration to the next.  Retaining the hull should need
+  // far fewer log density evaluations than rebuilding it for each draw.
+  TEST_F(AdaptiveRejectionSamplerTest, RetainedHullSavesEvaluations) {
+    int evaluations = 0;
+    double mu = 0;
+    double sigma = .01;
+    std::function<double(double)> logf = [&](double x) {
+      ++evaluations;
+      return dnorm(x, mu, sigma, true);
+    };
+
+    int niter = 1000;
+    for (int i = 0; i < niter; ++i) {
+      mu = 50 + sigma * sin(.01 * i);
+      ScalarAdaptiveRejectionSampler sampler(logf);
+      sampler.draw();
+    }
+    int rebuild_evaluations = evaluations;
+
+    evaluations = 0;
+    ScalarAdaptiveRejectionSampler sampler(logf);
+    Vector draws(niter);
+    for (int i = 0; i < niter; ++i) {
+      mu = 50 + sigma * sin(.01 * i);
+      sampler.log_density_changed();
+      draws[i] = sampler.draw();
+    }
+    EXPECT_LT(evaluations, rebuild_evaluations / 2);
+
+    // The draws with a retained hull still come from the (moving) target.
+    Vector standardized(niter);
+    for (int i = 0; i < niter; ++i) {
+      standardized[i] = (draws[i] - 50 - sigma * sin(.01 * i)) / sigma;
+    }
+    EXPECT_TRUE(DistributionsMatch(standardized, [](double x) {
+          return pnorm(x);
+        }));
+  }
+
+  // Replacing the log density keeps the approximation valid, even when the
+  // target moves far enough that the old knots are in its tail.
+  TEST_F(AdaptiveRejectionSamplerTest, SetLogDensity) {
+    ScalarAdaptiveRejectionSampler sampler(
+        [](double x) { return dgamma(x, 2.0, 1.0, true); });
+    sampler.set_lower_limit(0.0);
+    for (int i = 0; i < 100; ++i) {
+      sampler.draw();
+    }
+
+    sampler.set_log_density(
+        [](double x) { return dgamma(x, 30.0, 2.0, true); });
+    int n = 5000;
+    Vector draws(n);
+    for (int i = 0; i < n; ++i) {
+      draws[i] = sampler.draw();
+    }
+    EXPECT_TRUE(DistributionsMatch(draws, [](double x) {
+          return pgamma(x, 30.0, 2.0);
+        }));
+  }
+
+  TEST_F(AdaptiveRejectionSamplerTest, BoundedSetLogDensity) {
+    // A normal distribution truncated to (1, infinity).
+    double mu = 0;
+    BoundedAdaptiveRejectionSampler sampler(
+        1.0,
+        [&](double x) { return -0.5 * square(x - mu); },
+        [&](double x) { return -(x - mu); });
+    for (int i = 0; i < 100; ++i) {
+      sampler.draw(GlobalRng::rng);
+    }
+    int points = sampler.number_of_points();
+    EXPECT_GT(points, 1);
+
+    mu = 0.5;
+    sampler.set_log_density(
+        [&](double x) { return -0.5 * square(x - mu); },
+        [&](double x) { return -(x - mu); });
+    EXPECT_EQ(points, sampler.number_of_points());
+    int n = 5000;
+    Vector draws(n);
+    for (int i = 0; i < n; ++i) {
+      draws[i] = sampler.draw(GlobalRng::rng);
+    }
+    double tail = pnorm(1.0, mu, 1.0, false);
+    EXPECT_TRUE(DistributionsMatch(draws, [&](double x) {
+          return (pnorm(x, mu, 1.0) - (1 - tail)) / tail;
+        }));
+
+    // The lower bound must remain to the right of the mode.
+    EXPECT_THROW(
+        sampler.set_log_density(
+            [](double x) { return -0.5 * square(x - 3); },
+            [](double x) { return -(x - 3); }),
+        std::exception);
+  }
+
+}  // namespace
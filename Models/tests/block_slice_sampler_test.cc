@@ -0,0 +1,98 @@
+#include "gtest/gtest.h"
+#include "Samplers/BlockSeparableSliceSampler.hpp"
+#include "distributions.hpp"
+#include "stats/moments.hpp"
+
+#include "test_utils/test_utils.hpp"
+
+namespace {
+  using namespace BOOM;
+  using std::endl;
+  using std::cout;
+
+  class BlockSliceSamplerTest : public ::testing::Test {
+   protected:
+    BlockSliceSamplerTest() {
+      GlobalRng::rng.seed(8675309);
+    }
+  };
+
+  // Independent bivariate normal blocks with correlation .8.  Block b has
+  // mean (b, -b) and occupies coordinates b and nblocks + b, so blocks are
+  // not contiguous.
+  class NormalBlocks : public BlockSeparableTarget {
+   public:
+    explicit NormalBlocks(int nblocks) : nblocks_(nblocks) {}
+    int number_of_blocks() const override { return nblocks_; }
+    std::vector<int> block_coordinates(int block) const override {
+      return {block, nblocks_ + block};
+    }
+    double block_log_density(int block, const Vector &values) const override {
+      double z0 = values[0] - block;
+      double z1 = values[1] + block;
+      double rho = .8;
+      return -(z0 * z0 - 2 * rho * z0 * z1 + z1 * z1) / (2 * (1 - rho * rho));
+    }
+
+   private:
+    int nblocks_;
+  };
+
+  TEST_F(BlockSliceSamplerTest, ThreadsMatchSerial) {
+    int nblocks = 50;
+    NEW(NormalBlocks, target)(nblocks);
+    RNG serial_rng(12345);
+    RNG threaded_rng(12345);
+    BlockSeparableSliceSampler serial(target, 1.0, true, &serial_rng);
+    BlockSeparableSliceSampler threaded(target, 1.0, true, &threaded_rng);
+    threaded.set_number_of_threads(3);
+
+    Vector serial_x(2 * nblocks, 0.0);
+    Vector threaded_x(serial_x);
+    for (int i = 0; i < 200; ++i) {
+      serial_x = serial.draw(serial_x);
+      threaded_x = threaded.draw(threaded_x);
+    }
+    int niter = 2000;
+    Matrix draws(niter, 2 * nblocks);
+    for (int i = 0; i < niter; ++i) {
+      serial_x = serial.draw(serial_x);
+      threaded_x = threaded.draw(threaded_x);
+      draws.row(i) = serial_x;
+    }
+    EXPECT_TRUE(VectorEquals(serial_x, threaded_x));
+
+    Vector draw_mean = mean(draws);
+    for (int b = 0; b < nblocks; ++b) {
+      EXPECT_NEAR(b, draw_mean[b], .2);
+      EXPECT_NEAR(-b, draw_mean[nblocks + b], .2);
+    }
+    Matrix first_block(niter, 2);
+    first_block.col(0) = draws.col(0);
+    first_block.col(1) = draws.col(nblocks);
+    EXPECT_NEAR(.8, cor(first_block)(0, 1), .05);
+  }
+
+  // Blocks are checked against the dimension of the argument, and limits
+  // confine the draws.
+  TEST_F(BlockSliceSamplerTest, LimitsAndErrors) {
+    NEW(NormalBlocks, target)(3);
+    BlockSeparableSliceSampler sampler(target);
+    EXPECT_THROW(sampler.draw(Vector(4, 0.0)), std::exception);
+
+    BlockSeparableSliceSampler limited(target);
+    Vector lower(6, negative_infinity());
+    Vector upper(6, infinity());
+    lower[2] = 1.5;
+    upper[2] = 3.0;
+    limited.set_limits(lower, upper);
+    Vector x(6, 0.0);
+    x[2] = 2.0;
+    for (int i = 0; i < 100; ++i) {
+      x = limited.draw(x);
+      EXPECT_GE(x[2], 1.5);
+      EXPECT_LE(x[2], 3.0);
+    }
+  }
+
+}  // namespace
@@ -0,0 +1,130 @@
+#include "gtest/gtest.h"
+#include "Models/GammaModel.hpp"
+#include "Models/PosteriorSamplers/GammaPosteriorSampler.hpp"
+#include "Samplers/MoveAccounting.hpp"
+#include "Samplers/SliceSampler.hpp"
+#include "cpputil/Checkpoint.hpp"
+#include "distributions.hpp"
+#include "test_utils/test_utils.hpp"
+
+#include <cstdio>
+#include <fstream>
+
+namespace {
+  using namespace BOOM;
+  using std::endl;
+
+  class CheckpointTest : public ::testing::Test {
+   protected:
+    CheckpointTest() {
+      GlobalRng::rng.seed(8675309);
+    }
+  };
+
+  // A restored RNG continues the sequence of the saved one, for each engine.
+  TEST_F(CheckpointTest, Rng) {
+    for (auto engine : {RNG::MERSENNE_TWISTER, RNG::XOSHIRO, RNG::PHILOX}) {
+      RNG rng(12345, engine);
+      for (int i = 0; i < 7; ++i) rng();
+      CheckpointWriter out;
+      rng.write_checkpoint(out);
+      Vector expected(10);
+      rng.fill_uniform(expected.data(), expected.size());
+
+      RNG restored(3, RNG::XOSHIRO);
+      CheckpointReader in(out.payload());
+      restored.read_checkpoint(in);
+      EXPECT_TRUE(in.at_end());
+      EXPECT_EQ(engine, restored.engine());
+      for (int i = 0; i < expected.size(); ++i) {
+        EXPECT_EQ(expected[i], restored());
+      }
+    }
+  }
+
+  TEST_F(CheckpointTest, SamplerState) {
+    MoveAccounting accounting;
+    accounting.record_acceptance("birth");
+    accounting.record_rejection("birth");
+    accounting.record_special("death", "empty");
+    CheckpointWriter out;
+    accounting.write_checkpoint(out);
+
+    // The slice sampler adapts its scale, which is part of its state.
+    auto logp = [](const Vector &x) { return -0.5 * x.normsq() / 100.0; };
+    SliceSampler slice(logp);
+    slice.set_rng(new RNG(17), true);
+    Vector x(2, 0.0);
+    for (int i = 0; i < 5; ++i) x = slice.draw(x);
+    slice.write_checkpoint(out);
+    Vector expected = slice.draw(x);
+
+    CheckpointReader in(out.payload());
+    MoveAccounting restored_accounting;
+    restored_accounting.read_checkpoint(in);
+    EXPECT_TRUE(MatrixEquals(accounting.to_matrix(),
+                             restored_accounting.to_matrix()));
+    SliceSampler restored_slice(logp);
+    restored_slice.set_rng(new RNG(99), true);
+    restored_slice.read_checkpoint(in);
+    EXPECT_TRUE(in.at_end());
+    EXPECT_EQ(expected, restored_slice.draw(x));
+
+    // Restoring into the wrong kind of object is an error.
+    CheckpointReader wrong(out.payload());
+    EXPECT_THROW(slice.read_checkpoint(wrong), std::exception);
+  }
+
+  Ptr<GammaModel> gamma_model(const Vector &data, RNG &seeding_rng) {
+    NEW(GammaModel, model)(1.0, 1.0);
+    for (double y : data) {
+      model->add_data(new DoubleData(y));
+    }
+    NEW(GammaPosteriorSampler, sampler)(
+        model.get(), new GammaModel(1.0, 1.0), new GammaModel(1.0, 1.0),
+        seeding_rng);
+    model->set_method(sampler);
+    return model;
+  }
+
+  // A run restored from a checkpoint reproduces the original run exactly.
+  TEST_F(CheckpointTest, ModelRestoresBitExactly) {
+    Vector data(200);
+    for (double &y : data) y = rgamma(3.0, 2.0);
+    RNG seed(101);
+    Ptr<GammaModel> model = gamma_model(data, seed);
+    for (int i = 0; i < 20; ++i) model->sample_posterior();
+
+    std::string filename = "checkpoint_test.ckpt";
+    save_checkpoint(*model, filename, 20);
+    std::vector<Vector> expected;
+    for (int i = 0; i < 10; ++i) {
+      model->sample_posterior();
+      expected.push_back(model->vectorize_params());
+    }
+    Vector global_draws(3);
+    GlobalRng::rng.fill_uniform(global_draws.data(), 3);
+
+    RNG other_seed(202);
+    Ptr<GammaModel> restored = gamma_model(data, other_seed);
+    EXPECT_EQ(20, restore_checkpoint(*restored, filename));
+    for (int i = 0; i < 10; ++i) {
+      restored->sample_posterior();
+      EXPECT_EQ(expected[i], restored->vectorize_params());
+    }
+    Vector restored_global_draws(3);
+    GlobalRng::rng.fill_uniform(restored_global_draws.data(), 3);
+    EXPECT_EQ(global_draws, restored_global_draws);
+
+    // A damaged file is detected.
+    {
+      std::fstream file(filename,
+                        std::ios::in | std::ios::out | std::ios::binary);
+      file.seekp(CheckpointFormat::header_size + 20);
+      file.put('\x7f');
+    }
+    EXPECT_THROW(restore_checkpoint(*restored, filename), std::exception);
+    std::remove(filename.c_str());
+  }
+
+}  // namespace
@@ -0,0 +1,62 @@
+#include "gtest/gtest.h"
+#include "Models/CompositeModel.hpp"
+#include "Models/GaussianModel.hpp"
+#include "Models/MultinomialModel.hpp"
+#include "Models/PoissonModel.hpp"
+#include "distributions.hpp"
+
+#include "test_utils/test_utils.hpp"
+
+namespace {
+  using namespace BOOM;
+
+  class CompositeModelTest : public ::testing::Test {
+   protected:
+    CompositeModelTest() {
+      GlobalRng::rng.seed(8675309);
+    }
+  };
+
+  // pdf_batch should agree with pdf, observation by observation.
+  TEST_F(CompositeModelTest, PdfBatch) {
+    NEW(CompositeModel, model)();
+    model->add_model(new GaussianModel(1.2, 3.1));
+    model->add_model(new PoissonModel(4.0));
+    model->add_model(new MultinomialModel(Vector{.2, .3, .5}));
+
+    std::vector<Ptr<Data>> data;
+    for (int i = 0; i < 50; ++i) {
+      NEW(CompositeData, observation)();
+      observation->add(new DoubleData(rnorm(1.2, 3.1)));
+      observation->add(new IntData(rpois(4.0)));
+      observation->add(new CategoricalData(rmulti(Vector{.2, .3, .5}), 3));
+      data.push_back(observation);
+    }
+    // A missing field, and a missing observation.
+    dynamic_cast<CompositeData *>(data[2].get())->get_ptr(1)
+        ->set_missing_status(Data::completely_missing);
+    data[7]->set_missing_status(Data::completely_missing);
+
+    Vector log_densities(data.size());
+    model->pdf_batch(data, VectorView(log_densities), true);
+    Vector densities(data.size());
+    model->pdf_batch(data, VectorView(densities), false);
+    for (int i = 0; i < data.size(); ++i) {
+      if (i == 7) {
+        EXPECT_DOUBLE_EQ(0.0, log_densities[i]);
+        EXPECT_DOUBLE_EQ(1.0, densities[i]);
+      } else {
+        EXPECT_NEAR(model->pdf(data[i].get(), true), log_densities[i], 1e-10);
+        EXPECT_NEAR(model->pdf(data[i].get(), false), densities[i], 1e-10);
+      }
+    }
+
+    CompositeDataTable table(data);
+    EXPECT_EQ(table.nrow(), data.size());
+    EXPECT_EQ(table.ncol(), 3);
+    Vector table_log_densities(data.size());
+    model->logp_batch(table, VectorView(table_log_densities));
+    EXPECT_TRUE(VectorEquals(log_densities, table_log_densities));
+  }
+
+}  // namespace
@@ -0,0 +1,114 @@
+#include "gtest/gtest.h"
+#include "Models/CategoricalData.hpp"
+#include "Models/DataTypes.hpp"
+#include "Models/ParamTypes.hpp"
+#include "test_utils/test_utils.hpp"
+
+namespace {
+  using namespace BOOM;
+  using std::endl;
+  using std::cout;
+
+  TEST(DataSignalTest, ObserversAreNotifiedImmediately) {
+    NEW(VectorParams, prm)(3);
+    int first = 0;
+    int second = 0;
+    prm->add_observer(&first, [&first]() { ++first; });
+    prm->add_observer(&second, [&second]() { ++second; });
+    prm->set(Vector{1.0, 2.0, 3.0});
+    prm->set_element(4.0, 1);
+    EXPECT_EQ(2, first);
+    EXPECT_EQ(2, second);
+
+    prm->remove_observer(&first);
+    prm->set_element(5.0, 2);
+    EXPECT_EQ(2, first);
+    EXPECT_EQ(3, second);
+
+    prm->clear_observers();
+    prm->set_element(6.0, 2);
+    EXPECT_EQ(3, second);
+  }
+
+  // Inside a batch each object notifies its observers once, when the
+  // outermost batch closes.
+  TEST(DataSignalTest, BatchNotifiesEachObjectOnce) {
+    std::vector<Ptr<CategoricalData>> indicators;
+    std::vector<int> signals(10, 0);
+    for (int i = 0; i < signals.size(); ++i) {
+      indicators.push_back(new CategoricalData(0, 3));
+      if (i % 2 == 0) {
+        indicators.back()->add_observer(
+            &signals, [&signals, i]() { ++signals[i]; });
+      }
+    }
+
+    {
+      DataSignalBatch outer;
+      EXPECT_TRUE(DataSignalBatch::active());
+      for (int rep = 0; rep < 5; ++rep) {
+        for (auto &indicator : indicators) indicator->set(rep % 3);
+      }
+      {
+        DataSignalBatch inner;
+        indicators[0]->set(2);
+      }
+      EXPECT_EQ(std::vector<int>(10, 0), signals);
+    }
+    EXPECT_FALSE(DataSignalBatch::active());
+    for (int i = 0; i < signals.size(); ++i) {
+      EXPECT_EQ(i % 2 == 0 ? 1 : 0, signals[i]);
+    }
+
+    indicators[0]->set(1);
+    EXPECT_EQ(2, signals[0]);
+  }
+
+  // Objects destroyed inside a batch are dropped from it, and observers that
+  // set other values during the flush notify their own observers right away.
+  TEST(DataSignalTest, BatchHandlesDestructionAndChainedSignals) {
+    int destroyed_signals = 0;
+    int chained_signals = 0;
+    NEW(UnivParams, downstream)(0.0);
+    downstream->add_observer(&chained_signals,
+                             [&chained_signals]() { ++chained_signals; });
+    NEW(UnivParams, upstream)(0.0);
+    upstream->add_observer(downstream.get(), [&downstream, &upstream]() {
+      downstream->set(2 * upstream->value());
+    });
+
+    {
+      DataSignalBatch batch;
+      Ptr<UnivParams> temporary(new UnivParams(1.0));
+      temporary->add_observer(
+          &destroyed_signals, [&destroyed_signals]() { ++destroyed_signals; });
+      temporary->set(3.0);
+      temporary.reset();
+      upstream->set(4.0);
+      EXPECT_DOUBLE_EQ(0.0, downstream->value());
+    }
+    EXPECT_EQ(0, destroyed_signals);
+    EXPECT_DOUBLE_EQ(8.0, downstream->value());
+    EXPECT_EQ(1, chained_signals);
+  }
+
+  // Each signal increments the version, whether or not there are
+  // observers.  Copies start over.
+  TEST(DataSignalTest, VersionCountsSignals) {
+    NEW(VectorParams, prm)(3);
+    EXPECT_EQ(0, prm->version());
+    prm->set(Vector{1.0, 2.0, 3.0});
+    EXPECT_EQ(1, prm->version());
+    prm->set(Vector{1.0, 2.0, 4.0}, false);
+    EXPECT_EQ(1, prm->version());
+    {
+      DataSignalBatch batch;
+      prm->set_element(2.0, 0);
+      prm->set_element(3.0, 0);
+    }
+    EXPECT_EQ(3, prm->version());
+    Ptr<VectorParams> copy = prm->clone();
+    EXPECT_EQ(0, copy->version());
+  }
+
+}  // namespace
@@ -0,0 +1,90 @@
+#include "gtest/gtest.h"
+#include "Models/FiniteMixtureModel.hpp"
+#include "Models/BinomialModel.hpp"
+#include "Models/MultinomialModel.hpp"
+#include "Models/PoissonModel.hpp"
+#include "distributions.hpp"
+
+#include "test_utils/test_utils.hpp"
+
+namespace {
+  using namespace BOOM;
+  using std::endl;
+  using std::cout;
+
+  class FiniteMixtureTest : public ::testing::Test {
+   protected:
+    FiniteMixtureTest() {
+      GlobalRng::rng.seed(8675309);
+    }
+  };
+
+  // Imputing the latent data should give the same answer for a fixed seed,
+  // no matter how many threads are used.
+  TEST_F(FiniteMixtureTest, ThreadedImputationIsReproducible) {
+    int S = 3;
+    std::vector<Ptr<PoissonModel>> components;
+    for (int s = 0; s < S; ++s) {
+      components.push_back(new PoissonModel(1.0 + 3 * s));
+    }
+    NEW(MultinomialModel, mixing_distribution)(S);
+    NEW(FiniteMixtureModel, model)(components, mixing_distribution);
+    int n = 5000;
+    for (int i = 0; i < n; ++i) {
+      model->add_data(new IntData(rpois(1.0 + 3 * random_int(0, S - 1))));
+    }
+
+    RNG rng(12345);
+    model->impute_latent_data(rng);
+    Vector assignment = model->class_assignment();
+    double loglike = model->last_loglike();
+    Vector counts(S);
+    for (int s = 0; s < S; ++s) {
+      counts[s] = components[s]->suf()->n();
+    }
+    EXPECT_DOUBLE_EQ(n, sum(counts));
+    EXPECT_TRUE(VectorEquals(counts, mixing_distribution->suf()->n()));
+
+    for (int threads : {0, 1, 4}) {
+      model->set_number_of_threads(threads);
+      rng.seed(12345);
+      model->impute_latent_data(rng);
+      EXPECT_TRUE(VectorEquals(assignment, model->class_assignment()))
+          << "threads = " << threads;
+      EXPECT_NEAR(loglike, model->last_loglike(), 1e-6);
+      for (int s = 0; s < S; ++s) {
+        EXPECT_DOUBLE_EQ(counts[s], components[s]->suf()->n());
+      }
+      EXPECT_TRUE(VectorEquals(counts, mixing_distribution->suf()->n()));
+    }
+  }
+
+  // The threaded E-step should match the serial one.
+  TEST_F(FiniteMixtureTest, ThreadedEStep) {
+    int S = 2;
+    std::vector<Ptr<BinomialModel>> components;
+    components.push_back(new BinomialModel(.2));
+    components.push_back(new BinomialModel(.7));
+    NEW(MultinomialModel, mixing_distribution)(S);
+    NEW(EmFiniteMixtureModel, model)(
+        components.begin(), components.end(), mixing_distribution);
+    int n = 5000;
+    for (int i = 0; i < n; ++i) {
+      double prob = runif() < .5 ? .2 : .7;
+      model->add_data(new BinomialData(10, rbinom(10, prob)));
+    }
+
+    double loglike = model->EStep();
+    Vector trials = {components[0]->suf()->nobs(),
+                     components[1]->suf()->nobs()};
+    Vector counts = mixing_distribution->suf()->n();
+    EXPECT_NEAR(n, sum(counts), 1e-6);
+
+    model->set_number_of_threads(4);
+    EXPECT_NEAR(loglike, model->EStep(), 1e-6);
+    EXPECT_NEAR(trials[0], components[0]->suf()->nobs(), 1e-6);
+    EXPECT_NEAR(trials[1], components[1]->suf()->nobs(), 1e-6);
+    EXPECT_TRUE(VectorEquals(counts, mixing_distribution->suf()->n(), 1e-6));
+  }
+
+}  // namespace
@@ -43,6 +43,133 @@ namespace {
     EXPECT_DOUBLE_EQ(0, suf.centered_sumsq(suf.ybar()));
   }
 
+  // Adding a block of data matches adding the observations one at a time.
+  TEST_F(GaussianTest, SufBlockUpdate) {
+    Vector y = rnorm_vector(1000, 3, 7);
+    GaussianSuf block_suf;
+    GaussianSuf raw_suf;
+    block_suf.update_raw(1.2);
+    raw_suf.update_raw(1.2);
+    block_suf.add_data(ConstVectorView(y.data(), 600, 1));
+    block_suf.add_data(ConstVectorView(y, 600));
+    for (double yi : y) {
+      raw_suf.update_raw(yi);
+    }
+    EXPECT_DOUBLE_EQ(raw_suf.n(), block_suf.n());
+    EXPECT_NEAR(raw_suf.sum(), block_suf.sum(), 1e-8);
+    EXPECT_NEAR(raw_suf.sumsq(), block_suf.sumsq(), 1e-6);
+
+    // Models that only keep sufficient statistics can be fed blocks directly.
+    GaussianModel model;
+    model.only_keep_sufstats();
+    model.suf()->add_data(y);
+    EXPECT_DOUBLE_EQ(1000, model.suf()->n());
+    EXPECT_NEAR(y.sum() / 1000, model.suf()->ybar(), 1e-10);
+  }
+
+  // The variance of data with a large mean is computed accurately, and
+  // does not depend on how the data are split across shards.
+  TEST_F(GaussianTest, SufPrecisionAndSharding) {
+    int n = 10000;
+    Vector y = rnorm_vector(n, 1e+9, 1.0);
+    GaussianSuf serial;
+    for (double yi : y) {
+      serial.update_raw(yi);
+    }
+    double mean = 0;
+    for (double yi : y) mean += (yi - 1e+9);
+    mean = 1e+9 + mean / n;
+    double ss = 0;
+    for (double yi : y) ss += square(yi - mean);
+    EXPECT_NEAR(ss / (n - 1), serial.sample_var(), 1e-6);
+    EXPECT_NEAR(mean, serial.ybar(), 1e-5);
+
+    for (int nshards : {2, 3, 7, 16}) {
+      std::vector<GaussianSuf> shards(nshards);
+      int shard_size = n / nshards;
+      for (int s = 0; s < nshards; ++s) {
+        int begin = s * shard_size;
+        int end = (s + 1 == nshards) ? n : begin + shard_size;
+        shards[s].add_data(ConstVectorView(y, begin, end - begin));
+      }
+      GaussianSuf merged;
+      for (const auto &shard : shards) {
+        merged.combine(shard);
+      }
+      EXPECT_DOUBLE_EQ(n, merged.n());
+      EXPECT_NEAR(serial.ybar(), merged.ybar(), 1e-5);
+      EXPECT_NEAR(serial.sample_var(), merged.sample_var(), 1e-6)
+          << nshards << " shards.";
+    }
+
+    // Removing data undoes adding it.
+    GaussianSuf suf(serial);
+    suf.update_raw(1e+9 + 3.0);
+    suf.remove(1e+9 + 3.0);
+    EXPECT_NEAR(serial.sample_var(), suf.sample_var(), 1e-6);
+
+    // The serialized form is (n, sum, sumsq).
+    Vector v = serial.vectorize();
+    EXPECT_DOUBLE_EQ(n, v[0]);
+    EXPECT_DOUBLE_EQ(serial.sum(), v[1]);
+    GaussianSuf restored;
+    restored.unvectorize(v);
+    EXPECT_DOUBLE_EQ(serial.ybar(), restored.ybar());
+  }
+
+  // With change tracking, refresh_suf only revisits the data points that
+  // changed, and gives the same answer as rebuilding from scratch.
+  TEST_F(GaussianTest, TrackedRefresh) {
+    GaussianModel model;
+    std::vector<Ptr<DoubleData>> data;
+    for (int i = 0; i < 100; ++i) {
+      data.push_back(new DoubleData(rnorm(2, 3)));
+      model.add_data(data.back());
+    }
+    model.track_data_changes();
+    EXPECT_TRUE(model.is_tracking_data_changes());
+    EXPECT_DOUBLE_EQ(100, model.suf()->n());
+
+    for (int i = 0; i < 100; i += 17) {
+      data[i]->set(rnorm(-4, 1));
+    }
+    // A data point that changes twice between refreshes.
+    data[3]->set(12.0);
+    data[3]->set(-1.5);
+    model.refresh_suf();
+
+    GaussianSuf expected;
+    for (const auto &el : data) {
+      expected.update_raw(el->value());
+    }
+    EXPECT_DOUBLE_EQ(expected.n(), model.suf()->n());
+    EXPECT_NEAR(expected.sum(), model.suf()->sum(), 1e-8);
+    EXPECT_NEAR(expected.sumsq(), model.suf()->sumsq(), 1e-8);
+
+    // Removing a data point with a pending change removes it completely.
+    double old_value = data[20]->value();
+    data[20]->set(100.0);
+    model.remove_data(data[20]);
+    expected.remove(old_value);
+    model.refresh_suf();
+    EXPECT_DOUBLE_EQ(expected.n(), model.suf()->n());
+    EXPECT_NEAR(expected.sum(), model.suf()->sum(), 1e-8);
+    data[20]->set(7.0);
+    model.refresh_suf();
+    EXPECT_NEAR(expected.sum(), model.suf()->sum(), 1e-8);
+
+    // Data added while tracking is tracked too.
+    NEW(DoubleData, extra)(1.0);
+    model.add_data(extra);
+    extra->set(2.0);
+    model.refresh_suf();
+    EXPECT_NEAR(expected.sum() + 2.0, model.suf()->sum(), 1e-8);
+
+    model.track_data_changes(false);
+    model.refresh_suf();
+    EXPECT_NEAR(expected.sum() + 2.0, model.suf()->sum(), 1e-8);
+  }
+
   TEST_F(GaussianTest, LogLikelihood) {
     int nobs = 4;
     Vector y(nobs);
@@ -196,4 +323,56 @@ namespace {
     EXPECT_NEAR(model->sd(), copy->sd(), 1e-8);
   }
 
+  // A GaussianModel that counts its likelihood evaluations.
+  class CountingGaussianModel : public GaussianModel {
+   public:
+    CountingGaussianModel(double mu, double sigma)
+        : GaussianModel(mu, sigma), evaluations_(0) {}
+    double Loglike(const Vector &mu_sigsq, Vector &g, Matrix &h,
+                   BOOM::uint nd) const override {
+      ++evaluations_;
+      return GaussianModel::Loglike(mu_sigsq, g, h, nd);
+    }
+    int evaluations() const { return evaluations_; }
+
+   private:
+    mutable int evaluations_;
+  };
+
+  // The cached log likelihood is recomputed only when a parameter changes.
+  TEST_F(GaussianTest, CachedLogLikelihood) {
+    CountingGaussianModel model(1.0, 2.0);
+    Vector y = rnorm_vector(50, 1.0, 2.0);
+    for (double yi : y) {
+      model.add_data(new DoubleData(yi));
+    }
+
+    double loglike = model.cached_log_likelihood();
+    EXPECT_DOUBLE_EQ(model.log_likelihood(), loglike);
+    int evaluations = model.evaluations();
+    EXPECT_DOUBLE_EQ(loglike, model.cached_log_likelihood());
+    EXPECT_EQ(evaluations, model.evaluations());
+
+    model.set_mu(1.5);
+    double new_loglike = model.cached_log_likelihood();
+    EXPECT_EQ(evaluations + 1, model.evaluations());
+    EXPECT_NE(loglike, new_loglike);
+
+    Vector gradient;
+    double value = model.cached_log_likelihood(gradient);
+    EXPECT_DOUBLE_EQ(new_loglike, value);
+    EXPECT_EQ(2, gradient.size());
+    Vector second_gradient;
+    model.cached_log_likelihood(second_gradient);
+    EXPECT_EQ(evaluations + 2, model.evaluations());
+    EXPECT_EQ(gradient, second_gradient);
+
+    // Data are not tracked, so new data need an explicit invalidation.
+    model.add_data(new DoubleData(3.0));
+    EXPECT_DOUBLE_EQ(new_loglike, model.cached_log_likelihood());
+    model.invalidate_log_likelihood_cache();
+    EXPECT_DOUBLE_EQ(model.log_likelihood(), model.cached_log_likelihood());
+    EXPECT_NE(new_loglike, model.cached_log_likelihood());
+  }
+
 }  // namespace
@@ -0,0 +1,128 @@
+#include "gtest/gtest.h"
+#include "Models/LowRankPlusDiagonalMvnModel.hpp"
+#include "Models/MvnModel.hpp"
+#include "distributions.hpp"
+#include "stats/moments.hpp"
+
+#include "test_utils/test_utils.hpp"
+
+namespace {
+  using namespace BOOM;
+  using std::endl;
+  using std::cout;
+
+  class LowRankPlusDiagonalMvnTest : public ::testing::Test {
+   protected:
+    LowRankPlusDiagonalMvnTest()
+        : dim_(7), rank_(2), mean_(dim_), factor_(dim_, rank_),
+          diagonal_(dim_) {
+      GlobalRng::rng.seed(8675309);
+      mean_.randomize();
+      factor_.randomize();
+      for (int i = 0; i < dim_; ++i) {
+        diagonal_[i] = runif(.5, 2.0);
+      }
+    }
+
+    SpdMatrix dense_variance() const {
+      SpdMatrix ans(dim_, 0.0);
+      ans.add_outer(factor_);
+      ans.diag() += diagonal_;
+      return ans;
+    }
+
+    int dim_;
+    int rank_;
+    Vector mean_;
+    Matrix factor_;
+    Vector diagonal_;
+  };
+
+  TEST_F(LowRankPlusDiagonalMvnTest, DensityMatchesDenseMvn) {
+    LowRankPlusDiagonalMvnModel model(mean_, factor_, diagonal_);
+    MvnModel mvn(mean_, dense_variance());
+    EXPECT_TRUE(MatrixEquals(model.Sigma(), mvn.Sigma()));
+    EXPECT_TRUE(MatrixEquals(model.siginv(), mvn.siginv(), 1e-6));
+    EXPECT_NEAR(model.ldsi(), mvn.ldsi(), 1e-8);
+
+    Vector y = mvn.sim();
+    EXPECT_NEAR(model.logp(y), mvn.logp(y), 1e-8);
+    Vector gradient, mvn_gradient;
+    Matrix hessian, mvn_hessian;
+    EXPECT_NEAR(model.Logp(y, gradient, hessian, 2),
+                mvn.Logp(y, mvn_gradient, mvn_hessian, 2), 1e-8);
+    EXPECT_TRUE(VectorEquals(gradient, mvn_gradient, 1e-6));
+    EXPECT_TRUE(MatrixEquals(hessian, mvn_hessian, 1e-6));
+    EXPECT_TRUE(VectorEquals(model.precision_times(y), mvn.siginv() * y,
+                             1e-6));
+
+    Selector included("1011010");
+    Vector y_subset = included.select(y);
+    Vector subset_gradient(included.nvars());
+    Vector mvn_subset_gradient(included.nvars());
+    EXPECT_NEAR(
+        model.logp_given_inclusion(y_subset, &subset_gradient, nullptr,
+                                   included, true),
+        mvn.logp_given_inclusion(y_subset, &mvn_subset_gradient, nullptr,
+                                 included, true),
+        1e-8);
+    EXPECT_TRUE(VectorEquals(subset_gradient, mvn_subset_gradient, 1e-6));
+  }
+
+  TEST_F(LowRankPlusDiagonalMvnTest, ConditionalDistribution) {
+    LowRankPlusDiagonalMvnModel model(mean_, factor_, diagonal_);
+    Selector observed("0110100");
+    Selector unobserved = observed.complement();
+    Vector y = model.sim();
+    Vector observed_values = observed.select(y);
+    Ptr<LowRankPlusDiagonalMvnModel> conditional =
+        model.conditional_distribution(observed, observed_values);
+
+    SpdMatrix variance = dense_variance();
+    SpdMatrix Voo = observed.select(variance);
+    Matrix Vuo = unobserved.select_rows(observed.select_cols(variance));
+    SpdMatrix Vuu = unobserved.select(variance);
+    Vector mean = unobserved.select(mean_) +
+        Vuo * Voo.solve(observed_values - observed.select(mean_));
+    SpdMatrix conditional_variance(Vuu - Vuo * Voo.solve(Vuo.transpose()));
+
+    EXPECT_TRUE(VectorEquals(conditional->mu(), mean, 1e-6));
+    EXPECT_TRUE(MatrixEquals(conditional->Sigma(), conditional_variance,
+                             1e-6));
+  }
+
+  TEST_F(LowRankPlusDiagonalMvnTest, Posterior) {
+    LowRankPlusDiagonalMvnModel prior(mean_, factor_, diagonal_);
+    Vector observation_variance(dim_);
+    for (int i = 0; i < dim_; ++i) {
+      observation_variance[i] = runif(.2, 3.0);
+    }
+    Vector y = prior.sim();
+    Ptr<LowRankPlusDiagonalMvnModel> posterior =
+        prior.posterior(y, observation_variance);
+
+    SpdMatrix precision = dense_variance().inv();
+    precision.diag() += 1.0 / observation_variance;
+    SpdMatrix variance = precision.inv();
+    Vector mean = variance *
+        (prior.precision_times(mean_) + y / observation_variance);
+    EXPECT_TRUE(VectorEquals(posterior->mu(), mean, 1e-6));
+    EXPECT_TRUE(MatrixEquals(posterior->Sigma(), variance, 1e-6));
+  }
+
+  TEST_F(LowRankPlusDiagonalMvnTest, Simulation) {
+    LowRankPlusDiagonalMvnModel model(mean_, factor_, diagonal_);
+    int ndraws = 20000;
+    Matrix draws(ndraws, dim_);
+    for (int i = 0; i < ndraws; ++i) {
+      draws.row(i) = model.sim();
+    }
+    SpdMatrix variance = dense_variance();
+    for (int j = 0; j < dim_; ++j) {
+      EXPECT_NEAR(mean(draws.col(j)), mean_[j],
+                  4 * sqrt(variance(j, j) / ndraws));
+    }
+    EXPECT_TRUE(MatrixEquals(var(draws), variance, .2));
+  }
+
+}  // namespace
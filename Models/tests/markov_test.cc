@@ -33,5 +33,39 @@ namespace {
 
   }
 
+  // Counting transitions from MarkovSequences should match adding the same
+  // series as linked MarkovData, whether or not threads are used.
+  TEST_F(MarkovTest, SequencesMatchLinkedData) {
+    int S = 4;
+    MarkovModel linked_model(S);
+    MarkovSequences sequences(S);
+    for (int series = 0; series < 30; ++series) {
+      int length = 1 + random_int(0, 5000);
+      std::vector<int> states(length);
+      std::vector<uint> ustates(length);
+      for (int t = 0; t < length; ++t) {
+        states[t] = random_int(0, S - 1);
+        ustates[t] = states[t];
+      }
+      sequences.add_series(states);
+      linked_model.add_data_series(make_markov_data(ustates));
+    }
+    EXPECT_EQ(30, sequences.number_of_series());
+
+    MarkovModel serial_model(S);
+    serial_model.add_sequences(sequences);
+    EXPECT_TRUE(MatrixEquals(serial_model.suf()->trans(),
+                             linked_model.suf()->trans()));
+    EXPECT_TRUE(VectorEquals(serial_model.suf()->init(),
+                             linked_model.suf()->init()));
+
+    MarkovSuf threaded_suf(S);
+    SharedThreadPool pool(4);
+    threaded_suf.add_sequences(sequences, &pool);
+    EXPECT_TRUE(MatrixEquals(threaded_suf.trans(),
+                             linked_model.suf()->trans()));
+    EXPECT_TRUE(VectorEquals(threaded_suf.init(),
+                             linked_model.suf()->init()));
+  }
 
 }  // namespace
@@ -0,0 +1,109 @@
+#include "gtest/gtest.h"
+#include "Models/FiniteMixtureModel.hpp"
+#include "Models/GaussianModel.hpp"
+#include "Models/MultinomialModel.hpp"
+#include "Models/PoissonModel.hpp"
+#include "Samplers/McmcProfiler.hpp"
+#include "distributions.hpp"
+
+#include "test_utils/test_utils.hpp"
+
+namespace {
+  using namespace BOOM;
+  using std::endl;
+  using std::cout;
+
+  class McmcProfilerTest : public ::testing::Test {
+   protected:
+    McmcProfilerTest() {
+      GlobalRng::rng.seed(8675309);
+      McmcProfiler::reset();
+    }
+    ~McmcProfilerTest() override {
+      McmcProfiler::enable(false);
+      McmcProfiler::reset();
+    }
+
+    // The row of the report for the named phase, or -1 if there is none.
+    int find_phase(const LabeledMatrix &report, const std::string &phase) {
+      const std::vector<std::string> &names(report.row_names());
+      for (int i = 0; i < names.size(); ++i) {
+        if (names[i] == phase) return i;
+      }
+      return -1;
+    }
+  };
+
+  TEST_F(McmcProfilerTest, DisabledTimersRecordNothing) {
+    EXPECT_FALSE(McmcProfiler::enabled());
+    {
+      ScopedPhaseTimer timer("some_phase");
+    }
+    EXPECT_EQ(0, McmcProfiler::report().nrow());
+  }
+
+  TEST_F(McmcProfilerTest, TimersAccumulate) {
+    McmcProfiler::enable();
+    for (int i = 0; i < 3; ++i) {
+      ScopedPhaseTimer timer("some_phase");
+    }
+    McmcProfiler::record("other_phase", 2.5);
+    LabeledMatrix report = McmcProfiler::report();
+    ASSERT_EQ(2, report.nrow());
+    ASSERT_EQ(2, report.ncol());
+    EXPECT_EQ("seconds", report.col_names()[0]);
+    EXPECT_EQ("calls", report.col_names()[1]);
+
+    int some = find_phase(report, "some_phase");
+    ASSERT_GE(some, 0);
+    EXPECT_DOUBLE_EQ(3, report(some, 1));
+    EXPECT_GE(report(some, 0), 0.0);
+
+    int other = find_phase(report, "other_phase");
+    ASSERT_GE(other, 0);
+    EXPECT_DOUBLE_EQ(1, report(other, 1));
+    EXPECT_DOUBLE_EQ(2.5, report(other, 0));
+
+    // Disabling stops the recording, but keeps what was recorded.
+    McmcProfiler::enable(false);
+    {
+      ScopedPhaseTimer timer("some_phase");
+    }
+    EXPECT_DOUBLE_EQ(3, McmcProfiler::report()(some, 1));
+
+    McmcProfiler::reset();
+    EXPECT_EQ(0, McmcProfiler::report().nrow());
+  }
+
+  // Model code reports its phases under the standard names.
+  TEST_F(McmcProfilerTest, ModelPhasesAreRecorded) {
+    McmcProfiler::enable();
+    NEW(GaussianModel, gaussian)(0, 1);
+    std::vector<Ptr<DoubleData>> data;
+    for (int i = 0; i < 10; ++i) data.push_back(new DoubleData(rnorm()));
+    gaussian->set_data(data);
+    gaussian->refresh_suf();
+
+    int S = 2;
+    std::vector<Ptr<PoissonModel>> components;
+    for (int s = 0; s < S; ++s) {
+      components.push_back(new PoissonModel(1.0 + 3 * s));
+    }
+    NEW(MultinomialModel, mixing_distribution)(S);
+    NEW(FiniteMixtureModel, model)(components, mixing_distribution);
+    for (int i = 0; i < 100; ++i) {
+      model->add_data(new IntData(rpois(1.0 + 3 * random_int(0, S - 1))));
+    }
+    model->impute_latent_data(GlobalRng::rng);
+    model->impute_latent_data(GlobalRng::rng);
+
+    LabeledMatrix report = McmcProfiler::report();
+    int refresh = find_phase(report, McmcProfiler::kRefreshSuf);
+    ASSERT_GE(refresh, 0);
+    EXPECT_GE(report(refresh, 1), 1.0);
+    int impute = find_phase(report, McmcProfiler::kImputeLatentData);
+    ASSERT_GE(impute, 0);
+    EXPECT_DOUBLE_EQ(2, report(impute, 1));
+  }
+
+}  // namespace
@@ -0,0 +1,105 @@
+#include "gtest/gtest.h"
+#include "Samplers/McmcTelemetry.hpp"
+
+#include <unistd.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "test_utils/test_utils.hpp"
+
+namespace {
+  using namespace BOOM;
+  using std::endl;
+  using std::cout;
+
+  TEST(McmcTelemetryTest, ReporterPublishesEveryFewIterations) {
+    McmcTelemetry telemetry;
+    std::vector<McmcTelemetryRecord> records;
+    telemetry.set_callback([&records](const McmcTelemetryRecord &record) {
+      records.push_back(record);
+    });
+    McmcTelemetryReporter reporter(&telemetry, 2, 10);
+    for (int i = 0; i < 35; ++i) {
+      if (reporter.tick()) {
+        reporter.report(-1.5 * i);
+      }
+    }
+    EXPECT_EQ(3, telemetry.flush());
+    ASSERT_EQ(3, records.size());
+    EXPECT_EQ(2, records[0].chain);
+    EXPECT_EQ(10, records[0].iteration);
+    EXPECT_EQ(30, records[2].iteration);
+    EXPECT_DOUBLE_EQ(-1.5 * 29, records[2].log_posterior);
+    EXPECT_TRUE(std::isnan(records[2].acceptance_rate));
+    EXPECT_EQ(0, telemetry.flush());
+
+    McmcTelemetryReporter silent(nullptr, 0, 1);
+    EXPECT_FALSE(silent.tick());
+  }
+
+  TEST(McmcTelemetryTest, DropsWhenFull) {
+    McmcTelemetry telemetry(4);
+    McmcTelemetryRecord record;
+    for (int i = 0; i < 6; ++i) {
+      record.iteration = i;
+      telemetry.publish(record);
+    }
+    EXPECT_EQ(2, telemetry.number_dropped());
+    EXPECT_EQ(4, telemetry.flush());
+  }
+
+  // Records from several threads are written to a file descriptor one whole
+  // line at a time.
+  TEST(McmcTelemetryTest, WritesLinesToFileDescriptor) {
+    int pipe_fds[2];
+    ASSERT_EQ(0, pipe(pipe_fds));
+    int nthreads = 4;
+    int reports_per_thread = 20;
+    {
+      McmcTelemetry telemetry(16);
+      telemetry.set_file_descriptor(pipe_fds[1]);
+      telemetry.start_reporting(.001);
+      std::vector<std::thread> chains;
+      for (int c = 0; c < nthreads; ++c) {
+        chains.emplace_back([&telemetry, c, reports_per_thread]() {
+          McmcTelemetryReporter reporter(&telemetry, c, 1);
+          for (int i = 0; i < reports_per_thread; ++i) {
+            reporter.tick();
+            reporter.report(1.0, .25);
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+          }
+        });
+      }
+      for (auto &chain : chains) {
+        chain.join();
+      }
+      telemetry.stop_reporting();
+      telemetry.flush();
+      EXPECT_EQ(0, telemetry.number_dropped());
+    }
+    close(pipe_fds[1]);
+
+    std::string output;
+    char buffer[4096];
+    ssize_t bytes;
+    while ((bytes = read(pipe_fds[0], buffer, sizeof(buffer))) > 0) {
+      output.append(buffer, bytes);
+    }
+    close(pipe_fds[0]);
+
+    int lines = 0;
+    std::size_t start = 0;
+    std::size_t end;
+    while ((end = output.find('\n', start)) != std::string::npos) {
+      std::string line = output.substr(start, end - start);
+      EXPECT_EQ(0, line.find("chain ")) << line;
+      EXPECT_NE(std::string::npos, line.find(" acceptance_rate 0.25")) << line;
+      ++lines;
+      start = end + 1;
+    }
+    EXPECT_EQ(start, output.size());
+    EXPECT_EQ(nthreads * reports_per_thread, lines);
+  }
+
+}  // namespace
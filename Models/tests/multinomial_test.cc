@@ -37,6 +37,28 @@ namespace {
     EXPECT_EQ(3, suf.dim());
   }
 
+  TEST_F(MultinomialTest, TrackedRefresh) {
+    MultinomialModel model(3);
+    std::vector<Ptr<CategoricalData>> data;
+    for (int i = 0; i < 50; ++i) {
+      data.push_back(new CategoricalData(i % 3, 3));
+      model.add_data(data.back());
+    }
+    model.track_data_changes();
+    data[0]->set(2);
+    data[1]->set(2);
+    model.refresh_suf();
+    EXPECT_TRUE(VectorEquals(model.suf()->n(), Vector{16, 16, 18}));
+
+    model.clear_data();
+    EXPECT_TRUE(model.is_tracking_data_changes());
+    EXPECT_TRUE(VectorEquals(model.suf()->n(), Vector{0, 0, 0}));
+    model.add_data(data[0]);
+    data[0]->set(1);
+    model.refresh_suf();
+    EXPECT_TRUE(VectorEquals(model.suf()->n(), Vector{0, 1, 0}));
+  }
+
   TEST_F(MultinomialTest, ModelTest) {
     MultinomialModel model(3);
     EXPECT_TRUE(VectorEquals(model.pi(), Vector{1, 1, 1} / 3.0));
@@ -53,6 +75,29 @@ namespace {
     EXPECT_NEAR(model.logpi()[2], log(.3), 1e-8);
   }
 
+  TEST_F(MultinomialTest, BatchDensity) {
+    MultinomialModel model(Vector{.5, .2, .3});
+    std::vector<Ptr<Data>> data;
+    for (int value : {0, 2, 1, 1, 0}) {
+      data.push_back(new CategoricalData(value, 3));
+    }
+    data[3]->set_missing_status(Data::completely_missing);
+
+    Vector log_densities(data.size());
+    model.pdf_batch(data, VectorView(log_densities), true);
+    Vector densities(data.size());
+    model.pdf_batch(data, VectorView(densities), false);
+    for (int i = 0; i < data.size(); ++i) {
+      if (data[i]->missing()) {
+        EXPECT_DOUBLE_EQ(0.0, log_densities[i]);
+        EXPECT_DOUBLE_EQ(1.0, densities[i]);
+      } else {
+        EXPECT_NEAR(model.pdf(data[i], true), log_densities[i], 1e-12);
+        EXPECT_NEAR(model.pdf(data[i], false), densities[i], 1e-12);
+      }
+    }
+  }
+
   TEST_F(MultinomialTest, McmcTest) {
     NEW(MultinomialModel, model)(3);
     Vector probs = {.5, .3, .2};
@@ -0,0 +1,86 @@
+#include "gtest/gtest.h"
+#include "Models/MvnModel.hpp"
+#include "distributions.hpp"
+
+#include "test_utils/test_utils.hpp"
+
+namespace {
+  using namespace BOOM;
+  using std::endl;
+  using std::cout;
+
+  class MvnTest : public ::testing::Test {
+   protected:
+    MvnTest() {
+      GlobalRng::rng.seed(8675309);
+    }
+  };
+
+  // Adding a block of data matches adding the observations one at a time.
+  TEST_F(MvnTest, SufBlockUpdate) {
+    int dim = 3;
+    Matrix Y(200, dim);
+    Y.randomize();
+    Y.col(1) += 4.0;
+    MvnSuf raw_suf(dim);
+    MvnSuf block_suf(dim);
+    Vector first = rnorm_vector(dim, 0, 1);
+    raw_suf.update_raw(first);
+    block_suf.update_raw(first);
+    for (int i = 0; i < Y.nrow(); ++i) {
+      raw_suf.update_raw(Y.row(i));
+    }
+    Matrix head(50, dim);
+    Matrix tail(150, dim);
+    for (int i = 0; i < Y.nrow(); ++i) {
+      if (i < 50) {
+        head.row(i) = Y.row(i);
+      } else {
+        tail.row(i - 50) = Y.row(i);
+      }
+    }
+    block_suf.add_data(head);
+    block_suf.add_data(tail);
+    EXPECT_DOUBLE_EQ(raw_suf.n(), block_suf.n());
+    EXPECT_TRUE(VectorEquals(raw_suf.ybar(), block_suf.ybar(), 1e-10));
+    EXPECT_TRUE(MatrixEquals(raw_suf.center_sumsq(), block_suf.center_sumsq(),
+                             1e-8));
+    EXPECT_TRUE(MatrixEquals(raw_suf.sumsq(), block_suf.sumsq(), 1e-8));
+
+    // An empty suf takes its dimension from the first block.
+    MvnSuf empty_suf;
+    empty_suf.add_data(Y);
+    EXPECT_EQ(dim, empty_suf.ybar().size());
+    EXPECT_DOUBLE_EQ(200, empty_suf.n());
+  }
+
+  // The batch densities should match the observation-by-observation ones.
+  TEST_F(MvnTest, BatchDensity) {
+    int dim = 3;
+    SpdMatrix Sigma(dim);
+    Sigma.randomize();
+    Vector mu = rnorm_vector(dim, 0, 1);
+    MvnModel model(mu, Sigma);
+
+    std::vector<Ptr<Data>> data;
+    for (int i = 0; i < 10; ++i) {
+      data.push_back(new VectorData(rnorm_vector(dim, 0, 2)));
+    }
+    data[4]->set_missing_status(Data::completely_missing);
+
+    Vector log_densities(data.size());
+    model.pdf_batch(data, VectorView(log_densities), true);
+    Vector densities(data.size());
+    model.pdf_batch(data, VectorView(densities), false);
+    for (int i = 0; i < data.size(); ++i) {
+      if (data[i]->missing()) {
+        EXPECT_DOUBLE_EQ(0.0, log_densities[i]);
+        EXPECT_DOUBLE_EQ(1.0, densities[i]);
+      } else {
+        EXPECT_NEAR(model.pdf(data[i], true), log_densities[i], 1e-8);
+        EXPECT_NEAR(model.pdf(data[i], false), densities[i], 1e-8);
+      }
+    }
+  }
+
+}  // namespace
@@ -0,0 +1,134 @@
+#include "gtest/gtest.h"
+#include "Models/GaussianModel.hpp"
+#include "Models/PosteriorSamplers/NoUTurnPosteriorSampler.hpp"
+#include "Samplers/NoUTurnSampler.hpp"
+#include "distributions.hpp"
+#include "stats/moments.hpp"
+
+#include "test_utils/test_utils.hpp"
+
+namespace {
+  using namespace BOOM;
+  using std::endl;
+  using std::cout;
+
+  class NoUTurnTest : public ::testing::Test {
+   protected:
+    NoUTurnTest() {
+      GlobalRng::rng.seed(8675309);
+    }
+  };
+
+  // A zero mean multivariate normal log density.
+  class MvnTarget : public dTargetFun {
+   public:
+    explicit MvnTarget(const SpdMatrix &variance)
+        : precision_(variance.inv()) {}
+    double operator()(const Vector &x) const override {
+      return -0.5 * precision_.Mdist(x);
+    }
+    double operator()(const Vector &x, Vector &gradient) const override {
+      gradient = precision_ * x * -1.0;
+      return -0.5 * precision_.Mdist(x);
+    }
+
+   private:
+    SpdMatrix precision_;
+  };
+
+  // Draws from a strongly correlated bivariate normal have the right
+  // moments, with either a diagonal or a dense mass matrix.  The dense mass
+  // matrix removes the correlation, so it needs shorter trajectories.
+  TEST_F(NoUTurnTest, CorrelatedNormal) {
+    SpdMatrix variance(2);
+    variance(0, 0) = 1.0;
+    variance(1, 1) = 9.0;
+    variance(0, 1) = variance(1, 0) = .95 * 3;
+    NEW(MvnTarget, target)(variance);
+
+    double mean_steps[2];
+    for (bool dense : {false, true}) {
+      NoUTurnSampler sampler(target);
+      if (dense) {
+        sampler.set_inverse_mass(variance);
+      } else {
+        sampler.set_diagonal_inverse_mass(Vector{1.0, 9.0});
+      }
+      sampler.adapt_step_size(500);
+      Vector x(2, 0.0);
+      for (int i = 0; i < 500; ++i) {
+        x = sampler.draw(x);
+      }
+      // Large steps early in the adaptation can diverge.
+      int warmup_divergences = sampler.number_of_divergences();
+      int niter = 4000;
+      Matrix draws(niter, 2);
+      double total_steps = 0;
+      for (int i = 0; i < niter; ++i) {
+        x = sampler.draw(x);
+        draws.row(i) = x;
+        total_steps += sampler.number_of_leapfrog_steps();
+      }
+      mean_steps[dense] = total_steps / niter;
+      EXPECT_EQ(warmup_divergences, sampler.number_of_divergences());
+      EXPECT_TRUE(VectorEquals(Vector(2, 0.0), mean(draws), .2))
+          << "dense = " << dense << endl
+          << mean(draws);
+      SpdMatrix sample_variance = var(draws);
+      EXPECT_NEAR(1.0, sample_variance(0, 0), .15) << "dense = " << dense;
+      EXPECT_NEAR(9.0, sample_variance(1, 1), 1.2) << "dense = " << dense;
+      EXPECT_NEAR(.95, cor(draws)(0, 1), .02) << "dense = " << dense;
+    }
+    EXPECT_LT(mean_steps[1], mean_steps[0]);
+  }
+
+  // The posterior sampler draws the mean and variance of a Gaussian model,
+  // with the variance sampled on the log scale.  The prior is flat for the
+  // mean and for the log of the variance.
+  TEST_F(NoUTurnTest, GaussianPosterior) {
+    Vector y(200);
+    for (int i = 0; i < y.size(); ++i) {
+      y[i] = rnorm(3.0, 2.0);
+    }
+    NEW(GaussianModel, model)(y);
+    double n = y.size();
+    double ybar = mean(y);
+    double sample_variance = var(y);
+
+    // Parameters on the sampling scale are (mu, log(sigsq)).
+    auto log_posterior = [&](const Vector &z, Vector &gradient) {
+      double mu = z[0];
+      double sigsq = exp(z[1]);
+      double ss = (n - 1) * sample_variance + n * square(ybar - mu);
+      gradient.resize(2);
+      gradient[0] = n * (ybar - mu) / sigsq;
+      gradient[1] = -n / 2 + ss / (2 * sigsq);
+      return -0.5 * n * z[1] - ss / (2 * sigsq);
+    };
+    auto log_prior = [](const Vector &theta) { return -log(theta[1]); };
+
+    NEW(NoUTurnPosteriorSampler, sampler)(model.get(), log_posterior,
+                                          log_prior);
+    sampler->set_transformation(
+        [](const Vector &theta) { return Vector{theta[0], log(theta[1])}; },
+        [](const Vector &z) { return Vector{z[0], exp(z[1])}; });
+    sampler->sampler().adapt_step_size(200);
+    model->set_method(sampler);
+
+    for (int i = 0; i < 200; ++i) {
+      model->sample_posterior();
+    }
+    int niter = 2000;
+    Vector mu_draws(niter), sigsq_draws(niter);
+    for (int i = 0; i < niter; ++i) {
+      model->sample_posterior();
+      mu_draws[i] = model->mu();
+      sigsq_draws[i] = model->sigsq();
+    }
+    EXPECT_NEAR(ybar, mean(mu_draws), .05);
+    EXPECT_NEAR(sqrt(sample_variance / n), sd(mu_draws), .03);
+    EXPECT_NEAR(sample_variance, mean(sigsq_draws), .3);
+    EXPECT_NEAR(-log(model->sigsq()), model->logpri(), 1e-8);
+  }
+
+}  // namespace
@@ -0,0 +1,100 @@
+#include "gtest/gtest.h"
+#include "Samplers/ParallelTempering.hpp"
+#include "cpputil/lse.hpp"
+#include "distributions.hpp"
+
+#include "test_utils/test_utils.hpp"
+
+namespace {
+  using namespace BOOM;
+  using std::endl;
+  using std::cout;
+
+  class ParallelTemperingTest : public ::testing::Test {
+   protected:
+    ParallelTemperingTest() {
+      GlobalRng::rng.seed(8675309);
+    }
+  };
+
+  // A scalar parameter with a flat prior on [-10, 10] and a likelihood with
+  // two well separated modes at -4 and 4.  A random walk Metropolis sampler
+  // with a small step size almost never crosses between the modes at
+  // temperature 1.
+  class BimodalReplica : public TemperedReplica {
+   public:
+    explicit BimodalReplica(double start) : theta_(start) {
+      loglike_ = loglike(theta_);
+    }
+
+    void draw(RNG &rng, double inverse_temperature) override {
+      for (int i = 0; i < 5; ++i) {
+        double proposal = theta_ + rnorm_mt(rng, 0, 0.5);
+        if (fabs(proposal) > 10) continue;
+        double candidate = loglike(proposal);
+        double log_alpha = inverse_temperature * (candidate - loglike_);
+        if (log(runif_mt(rng)) < log_alpha) {
+          theta_ = proposal;
+          loglike_ = candidate;
+        }
+      }
+    }
+
+    double log_likelihood() const override { return loglike_; }
+    double theta() const { return theta_; }
+
+   private:
+    static double loglike(double theta) {
+      return lse2(dnorm(theta, -4, .3, true), dnorm(theta, 4, .3, true)) *
+          10;
+    }
+
+    double theta_;
+    double loglike_;
+  };
+
+  TEST_F(ParallelTemperingTest, Ladder) {
+    Vector ladder = ParallelTemperingSampler::geometric_ladder(4, 8.0);
+    EXPECT_TRUE(VectorEquals(ladder, Vector{1.0, .5, .25, .125}));
+  }
+
+  // The cold chain visits both modes in roughly equal proportion, and the
+  // adapted ladder stays ordered.
+  TEST_F(ParallelTemperingTest, MixesBetweenModes) {
+    std::vector<Ptr<TemperedReplica>> replicas;
+    for (int k = 0; k < 6; ++k) {
+      replicas.push_back(new BimodalReplica(-4));
+    }
+    ParallelTemperingSampler sampler(replicas);
+    sampler.set_number_of_threads(2);
+    for (int i = 0; i < 1000; ++i) {
+      sampler.draw(GlobalRng::rng);
+    }
+    sampler.set_adaptation(false);
+    const Vector &beta = sampler.inverse_temperatures();
+    EXPECT_DOUBLE_EQ(1.0, beta[0]);
+    for (int k = 1; k < beta.size(); ++k) {
+      EXPECT_LT(beta[k], beta[k - 1]);
+      EXPECT_GT(beta[k], 0.0);
+    }
+
+    int niter = 5000;
+    int positive = 0;
+    for (int i = 0; i < niter; ++i) {
+      sampler.draw(GlobalRng::rng);
+      const BimodalReplica *cold = dynamic_cast<const BimodalReplica *>(
+          sampler.cold_replica().get());
+      positive += cold->theta() > 0;
+    }
+    double fraction = positive / static_cast<double>(niter);
+    EXPECT_GT(fraction, .3);
+    EXPECT_LT(fraction, .7);
+
+    Vector rates = sampler.swap_acceptance_rates();
+    EXPECT_EQ(5, rates.size());
+    for (int k = 0; k < rates.size(); ++k) {
+      EXPECT_GT(rates[k], .05);
+    }
+  }
+
+}  // namespace
@@ -0,0 +1,163 @@
+#include "gtest/gtest.h"
+#include "Models/ChisqModel.hpp"
+#include "Models/GaussianModel.hpp"
+#include "Models/GaussianModelGivenSigma.hpp"
+#include "Models/ParamDrawRecorder.hpp"
+#include "Models/PosteriorSamplers/GaussianConjSampler.hpp"
+#include "Models/SpdParams.hpp"
+#include "distributions.hpp"
+#include "test_utils/test_utils.hpp"
+
+namespace {
+  using namespace BOOM;
+  using std::endl;
+  using std::cout;
+
+  class ParamDrawRecorderTest : public ::testing::Test {
+   protected:
+    ParamDrawRecorderTest() {
+      GlobalRng::rng.seed(8675309);
+    }
+  };
+
+  TEST_F(ParamDrawRecorderTest, RecordsCurrentValues) {
+    NEW(VectorParams, beta)(Vector{1.0, 2.0, 3.0});
+    NEW(SpdParams, Sigma)(SpdMatrix(2, 1.0));
+    ParamDrawRecorder recorder;
+    recorder.add_parameter("beta", beta);
+    recorder.add_parameter("Sigma", Sigma);
+    EXPECT_EQ(2, recorder.number_of_parameters());
+    EXPECT_EQ(1, recorder.parameter_index("Sigma"));
+    EXPECT_EQ(-1, recorder.parameter_index("sigma"));
+    EXPECT_THROW(recorder.add_parameter("beta", beta), std::exception);
+
+    recorder.prepare_to_write(3);
+    EXPECT_EQ(3, recorder.draws(0).nrow());
+    EXPECT_EQ(3, recorder.draws(0).ncol());
+    EXPECT_EQ(4, recorder.draws(1).nrow());
+
+    for (int i = 0; i < 3; ++i) {
+      beta->set(Vector(3, i));
+      recorder.record();
+    }
+    EXPECT_EQ(3, recorder.number_recorded());
+    EXPECT_TRUE(VectorEquals(recorder.draw(0, 1), Vector(3, 1.0)));
+    EXPECT_TRUE(VectorEquals(recorder.draw(1, 2), Sigma->vectorize(false)));
+    EXPECT_THROW(recorder.record(), std::exception);
+
+    // Parameters whose size changes after space is allocated are an error.
+    recorder.prepare_to_write(2);
+    beta->set(Vector(2, 0.0));
+    EXPECT_THROW(recorder.record(), std::exception);
+  }
+
+  TEST_F(ParamDrawRecorderTest, ThinnedAndSinglePrecision) {
+    NEW(VectorParams, beta)(Vector{1.0, 2.0});
+    NEW(UnivParams, sigsq)(1.0);
+    ParamDrawRecorder recorder;
+    recorder.add_parameter("beta", beta, false, 3, true);
+    recorder.add_parameter("sigsq", sigsq, false, 2);
+    recorder.prepare_to_write(7);
+    EXPECT_EQ(3, recorder.number_of_stored_draws(0));
+    EXPECT_EQ(4, recorder.number_of_stored_draws(1));
+    EXPECT_EQ(6, recorder.single_precision_draws(0).size());
+    EXPECT_THROW(recorder.draws(0), std::exception);
+    EXPECT_THROW(recorder.single_precision_draws(1), std::exception);
+
+    for (int i = 0; i < 7; ++i) {
+      beta->set(Vector(2, i + .25));
+      sigsq->set(i);
+      recorder.record();
+    }
+    EXPECT_TRUE(VectorEquals(recorder.draw(0, 2), Vector(2, 6.25)));
+    EXPECT_FLOAT_EQ(3.25, recorder.single_precision_draws(0)[2]);
+    EXPECT_TRUE(VectorEquals(recorder.draws(1).row(0),
+                             Vector{0.0, 2.0, 4.0, 6.0}));
+  }
+
+  TEST_F(ParamDrawRecorderTest, SampleAndRecord) {
+    NEW(GaussianModel, model)(0, 1);
+    for (int i = 0; i < 100; ++i) {
+      model->add_data(new DoubleData(rnorm(3, 7.0)));
+    }
+    NEW(GaussianModelGivenSigma, mean_prior)(model->Sigsq_prm());
+    NEW(ChisqModel, precision_prior)(1, 1.0);
+    NEW(GaussianConjSampler, sampler)(model.get(), mean_prior, precision_prior);
+    model->set_method(sampler);
+
+    ParamDrawRecorder recorder;
+    recorder.add_parameter("mu", model->Mu_prm());
+    recorder.add_parameter("sigsq", model->Sigsq_prm());
+    recorder.sample_and_record(model.get(), 200);
+    EXPECT_EQ(200, recorder.number_recorded());
+    EXPECT_DOUBLE_EQ(model->mu(), recorder.draw(0, 199)[0]);
+    EXPECT_DOUBLE_EQ(model->sigsq(), recorder.draw(1, 199)[0]);
+    EXPECT_NEAR(3.0, recorder.draws(0).row(0).sum() / 200, 2.0);
+  }
+
+  TEST_F(ParamDrawRecorderTest, RunMcmc) {
+    NEW(GaussianModel, model)(0, 1);
+    for (int i = 0; i < 50; ++i) {
+      model->add_data(new DoubleData(rnorm(3, 7.0)));
+    }
+    NEW(GaussianModelGivenSigma, mean_prior)(model->Sigsq_prm());
+    NEW(ChisqModel, precision_prior)(1, 1.0);
+    NEW(GaussianConjSampler, sampler)(model.get(), mean_prior, precision_prior);
+    model->set_method(sampler);
+
+    ParamDrawRecorder recorder;
+    recorder.add_parameter("mu", model->Mu_prm());
+    std::vector<int> progress;
+    run_mcmc(model.get(), 30, 10, 2, &recorder, 10,
+             [&progress](int iteration) { progress.push_back(iteration); });
+    EXPECT_EQ(30, recorder.number_recorded());
+    EXPECT_EQ(std::vector<int>({10, 20, 30}), progress);
+    EXPECT_DOUBLE_EQ(model->mu(), recorder.draw(0, 29)[0]);
+
+    // Exceptions from the callback end the run.
+    EXPECT_THROW(run_mcmc(model.get(), 30, 0, 1, &recorder, 5,
+                          [](int iteration) {
+                            if (iteration == 10) report_error("stop");
+                          }),
+                 std::exception);
+    EXPECT_EQ(10, recorder.number_recorded());
+    EXPECT_THROW(run_mcmc(model.get(), 10, 0, 0), std::exception);
+  }
+
+  TEST_F(ParamDrawRecorderTest, StopsWhenConverged) {
+    NEW(GaussianModel, model)(0, 1);
+    for (int i = 0; i < 50; ++i) {
+      model->add_data(new DoubleData(rnorm(3, 7.0)));
+    }
+    NEW(GaussianModelGivenSigma, mean_prior)(model->Sigsq_prm());
+    NEW(ChisqModel, precision_prior)(1, 1.0);
+    NEW(GaussianConjSampler, sampler)(model.get(), mean_prior, precision_prior);
+    model->set_method(sampler);
+
+    ParamDrawRecorder recorder;
+    recorder.add_parameter("mu", model->Mu_prm());
+    recorder.add_parameter("sigsq", model->Sigsq_prm(), false, 5);
+    McmcStoppingRule rule = ConvergenceStoppingRule(200);
+    // The rule needs a monitor.
+    EXPECT_THROW(run_mcmc(model.get(), 10, 0, 1, &recorder, 0,
+                          std::function<void(int)>(), rule),
+                 std::exception);
+
+    recorder.monitor_convergence({"sigsq"});
+    int nkept = run_mcmc(model.get(), 5000, 0, 1, &recorder, 50,
+                         std::function<void(int)>(), rule);
+    EXPECT_LT(nkept, 5000);
+    EXPECT_EQ(0, nkept % 50);
+    EXPECT_EQ(nkept, recorder.number_recorded());
+    const McmcConvergenceMonitor *monitor = recorder.convergence_monitor();
+    ASSERT_TRUE(monitor != nullptr);
+    EXPECT_EQ(1, monitor->dimension());
+    // Thinned draws are still monitored.
+    EXPECT_EQ(nkept, monitor->sample_size(0));
+    EXPECT_GE(monitor->effective_sample_size()[0], 200);
+    EXPECT_LE(monitor->split_rhat()[0], 1.05);
+
+    EXPECT_THROW(recorder.monitor_convergence({"tau"}), std::exception);
+  }
+
+}  // namespace
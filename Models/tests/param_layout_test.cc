@@ -0,0 +1,152 @@
+#include "gtest/gtest.h"
+#include "Models/Glm/GlmCoefs.hpp"
+#include "Models/GaussianModel.hpp"
+#include "Models/ParamTypes.hpp"
+#include "Models/SpdParams.hpp"
+#include "cpputil/ParamHolder.hpp"
+#include "distributions.hpp"
+#include "test_utils/test_utils.hpp"
+
+namespace {
+  using namespace BOOM;
+  using std::endl;
+  using std::cout;
+
+  class ParamLayoutTest : public ::testing::Test {
+   protected:
+    ParamLayoutTest() {
+      GlobalRng::rng.seed(8675309);
+      SpdMatrix variance(3);
+      variance.randomize();
+      Matrix matrix(2, 3);
+      matrix.randomize();
+      Vector coefficients = {1.0, 0.0, -2.0, 3.0};
+      Selector included("1011");
+
+      scalar_ = new UnivParams(1.7);
+      vector_ = new VectorParams(Vector{1.0, 2.0, 3.0});
+      matrix_ = new MatrixParams(matrix);
+      spd_ = new SpdParams(variance);
+      coefs_ = new GlmCoefs(coefficients, included);
+      params_ = {scalar_, vector_, matrix_, spd_, coefs_};
+    }
+
+    Ptr<UnivParams> scalar_;
+    Ptr<VectorParams> vector_;
+    Ptr<MatrixParams> matrix_;
+    Ptr<SpdParams> spd_;
+    Ptr<GlmCoefs> coefs_;
+    std::vector<Ptr<Params>> params_;
+  };
+
+  // The layout reproduces the free vectorize() function, in both the
+  // minimal and full representations.
+  TEST_F(ParamLayoutTest, MatchesVectorize) {
+    for (bool minimal : {true, false}) {
+      ParamLayout layout(params_, minimal);
+      EXPECT_EQ(5, layout.number_of_params());
+      Vector expected = vectorize(params_, minimal);
+      EXPECT_EQ(expected.size(), layout.size());
+      EXPECT_EQ(expected, layout.vectorize());
+
+      int offset = 0;
+      for (int i = 0; i < params_.size(); ++i) {
+        EXPECT_EQ(offset, layout.offset(i));
+        EXPECT_EQ(params_[i]->size(minimal), layout.size(i));
+        EXPECT_EQ(params_[i]->vectorize(minimal),
+                  Vector(ConstVectorView(expected, offset, layout.size(i))));
+        offset += layout.size(i);
+      }
+      EXPECT_TRUE(layout.matches(params_));
+    }
+
+    ParamLayout layout(params_);
+    coefs_->drop(2);
+    EXPECT_FALSE(layout.matches(params_));
+  }
+
+  // Writing into a span and reading back round trips, and only the Params
+  // whose values change notify their observers.
+  TEST_F(ParamLayoutTest, UnvectorizeSignalsChangedParamsOnly) {
+    std::vector<int> signals(params_.size(), 0);
+    for (int i = 0; i < params_.size(); ++i) {
+      params_[i]->add_observer(this, [&signals, i]() { ++signals[i]; });
+    }
+
+    for (bool minimal : {true, false}) {
+      ParamLayout layout(params_, minimal);
+      Vector original(layout.size());
+      layout.vectorize(VectorView(original));
+      EXPECT_EQ(0, layout.unvectorize(original));
+      EXPECT_EQ(std::vector<int>(params_.size(), 0), signals);
+
+      Vector changed = original;
+      changed[layout.offset(1) + 2] = 7.0;
+      EXPECT_EQ(1, layout.unvectorize(changed));
+      EXPECT_DOUBLE_EQ(7.0, vector_->value()[2]);
+      EXPECT_EQ(1, signals[1]);
+      EXPECT_EQ(changed, layout.vectorize());
+
+      // Change every parameter, keeping the variance matrix positive
+      // definite and the excluded coefficients at zero.
+      Vector updated = original;
+      for (int i = 0; i < params_.size(); ++i) {
+        updated[layout.offset(i)] += 1.0;
+      }
+      EXPECT_EQ(5, layout.unvectorize(updated));
+      EXPECT_EQ(updated, layout.vectorize());
+      EXPECT_TRUE(VectorEquals(updated, vectorize(params_, minimal)));
+
+      layout.unvectorize(original);
+      EXPECT_EQ(original, layout.vectorize());
+      std::fill(signals.begin(), signals.end(), 0);
+    }
+    for (auto &prm : params_) {
+      prm->remove_observer(this);
+    }
+
+    ParamLayout layout(params_);
+    EXPECT_THROW(layout.unvectorize(Vector(layout.size() + 1)),
+                 std::exception);
+  }
+
+  // The included GlmCoefs are the minimal representation, and setting the
+  // full coefficient vector keeps the included coefficients current.
+  TEST_F(ParamLayoutTest, GlmCoefsSpans) {
+    Vector minimal(3);
+    coefs_->vectorize_into(VectorView(minimal), true);
+    EXPECT_EQ(Vector({1.0, -2.0, 3.0}), minimal);
+
+    Vector full = {4.0, 0.0, 5.0, 6.0};
+    coefs_->unvectorize_from(ConstVectorView(full), false);
+    EXPECT_EQ(Vector({4.0, 5.0, 6.0}), coefs_->included_coefficients());
+  }
+
+  TEST_F(ParamLayoutTest, HoldersRestoreValues) {
+    Vector original = vectorize(params_);
+    Vector workspace;
+    {
+      Vector trial = original;
+      trial[0] = -3.0;
+      ParamVectorHolder holder(trial, params_, workspace);
+      EXPECT_DOUBLE_EQ(-3.0, scalar_->value());
+    }
+    EXPECT_EQ(original, vectorize(params_));
+
+    {
+      ParamHolder holder(Vector{8.0, 9.0, 10.0}, vector_, workspace);
+      EXPECT_EQ(Vector({8.0, 9.0, 10.0}), vector_->value());
+    }
+    EXPECT_EQ(Vector({1.0, 2.0, 3.0}), vector_->value());
+
+    NEW(GaussianModel, model)(1.2, 3.4);
+    Vector model_params = model->vectorize_params();
+    {
+      ParameterHolder holder(model.get(), Vector{0.0, 1.0});
+      EXPECT_DOUBLE_EQ(0.0, model->mu());
+      EXPECT_DOUBLE_EQ(1.0, model->sigsq());
+    }
+    EXPECT_EQ(model_params, model->vectorize_params());
+  }
+
+}  // namespace
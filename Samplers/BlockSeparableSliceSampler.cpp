@@ -0,0 +1,143 @@
+// Copyright 2018 Google LLC. All Rights Reserved.
+/*
+  Copyright (C) 2005-2018 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#include "Samplers/BlockSeparableSliceSampler.hpp"
+#include <algorithm>
+#include <cmath>
+#include "cpputil/report_error.hpp"
+#include "distributions.hpp"
+
+namespace BOOM {
+
+  namespace {
+    typedef BlockSeparableSliceSampler BSSS;
+
+    // Blocks are drawn in shards of this size.  Each shard has its own
+    // random number stream.
+    const int block_shard_size = 16;
+  }  // namespace
+
+  BSSS::BlockSeparableSliceSampler(const Ptr<BlockSeparableTarget> &target,
+                                   double suggested_dx, bool unimodal,
+                                   RNG *rng)
+      : Sampler(rng),
+        target_(target),
+        suggested_dx_(suggested_dx),
+        unimodal_(unimodal),
+        dimension_(-1) {}
+
+  Vector BSSS::draw(const Vector &x) {
+    if (dimension_ < 0) {
+      initialize(x.size());
+    } else if (x.size() != dimension_) {
+      report_error("Argument to BlockSeparableSliceSampler::draw has the "
+                   "wrong dimension.");
+    }
+    int nblocks = blocks_.size();
+    int nshards = (nblocks + block_shard_size - 1) / block_shard_size;
+    RNG::RngIntType seed = seed_rng(rng());
+    pool_.parallel_for(0, nshards, 1, [&](int shard) {
+      RNG shard_rng(seed, shard);
+      int begin = shard * block_shard_size;
+      int end = std::min(nblocks, begin + block_shard_size);
+      for (int b = begin; b < end; ++b) {
+        Block &block(*blocks_[b]);
+        for (int i = 0; i < block.coordinates.size(); ++i) {
+          block.values[i] = x[block.coordinates[i]];
+        }
+        for (int i = 0; i < block.samplers.size(); ++i) {
+          block.samplers[i].set_rng(&shard_rng, false);
+          block.values[i] = block.samplers[i].draw(block.values[i]);
+          block.samplers[i].set_rng(nullptr, false);
+        }
+      }
+    });
+
+    Vector ans(x);
+    for (const auto &block : blocks_) {
+      for (int i = 0; i < block->coordinates.size(); ++i) {
+        ans[block->coordinates[i]] = block->values[i];
+      }
+    }
+    return ans;
+  }
+
+  void BSSS::set_limits(const Vector &lower, const Vector &upper) {
+    if (dimension_ < 0) {
+      initialize(lower.size());
+    }
+    if (lower.size() != dimension_ || upper.size() != dimension_) {
+      report_error("Limits are the wrong dimension in "
+                   "BlockSeparableSliceSampler::set_limits.");
+    }
+    for (auto &block : blocks_) {
+      for (int i = 0; i < block->coordinates.size(); ++i) {
+        int pos = block->coordinates[i];
+        if (upper[pos] <= lower[pos]) {
+          report_error("Upper limit must be larger than lower limit.");
+        }
+        if (std::isfinite(lower[pos])) {
+          block->samplers[i].set_lower_limit(lower[pos]);
+        }
+        if (std::isfinite(upper[pos])) {
+          block->samplers[i].set_upper_limit(upper[pos]);
+        }
+      }
+    }
+  }
+
+  void BSSS::initialize(int dimension) {
+    dimension_ = dimension;
+    std::vector<bool> used(dimension, false);
+    int nblocks = target_->number_of_blocks();
+    blocks_.clear();
+    blocks_.reserve(nblocks);
+    for (int b = 0; b < nblocks; ++b) {
+      std::unique_ptr<Block> block(new Block);
+      block->coordinates = target_->block_coordinates(b);
+      for (int pos : block->coordinates) {
+        if (pos < 0 || pos >= dimension) {
+          report_error("Block coordinate out of range.");
+        }
+        if (used[pos]) {
+          report_error("Blocks in a BlockSeparableTarget must not overlap.");
+        }
+        used[pos] = true;
+      }
+      block->values.resize(block->coordinates.size());
+      Ptr<BlockSeparableTarget> target = target_;
+      Vector *values = &block->values;
+      for (int i = 0; i < block->coordinates.size(); ++i) {
+        // Each scalar target moves one coordinate of the block, leaving the
+        // others at their current values.
+        auto scalar_target = [target, b, values, i](double value) {
+          double original = (*values)[i];
+          (*values)[i] = value;
+          double ans = target->block_log_density(b, *values);
+          (*values)[i] = original;
+          return ans;
+        };
+        block->samplers.push_back(
+            ScalarSliceSampler(scalar_target, unimodal_, suggested_dx_));
+      }
+      blocks_.push_back(std::move(block));
+    }
+  }
+
+}  // namespace BOOM
@@ -0,0 +1,133 @@
+// Copyright 2018 Google LLC. All Rights Reserved.
+/*
+  Copyright (C) 2005-2018 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#ifndef BOOM_SAMPLERS_BLOCK_SEPARABLE_SLICE_SAMPLER_HPP_
+#define BOOM_SAMPLERS_BLOCK_SEPARABLE_SLICE_SAMPLER_HPP_
+
+#include <memory>
+#include <vector>
+#include "LinAlg/Vector.hpp"
+#include "Samplers/Sampler.hpp"
+#include "Samplers/ScalarSliceSampler.hpp"
+#include "TargetFun/TargetFun.hpp"
+#include "cpputil/Ptr.hpp"
+#include "cpputil/RefCounted.hpp"
+#include "cpputil/ThreadTools.hpp"
+
+namespace BOOM {
+
+  // A log density whose argument splits into blocks of coordinates that are
+  // conditionally independent: the log density is a sum of terms, one per
+  // block, each depending only on the coordinates in its block.  Examples
+  // include the subject parameters in an IRT model given the item
+  // parameters, or group level parameters in a hierarchical model given
+  // the hyperparameters.
+  class BlockSeparableTarget : private RefCounted {
+   public:
+    virtual ~BlockSeparableTarget() {}
+
+    virtual int number_of_blocks() const = 0;
+
+    // The positions in the full argument vector of the coordinates in the
+    // given block.  Blocks must not overlap.  Coordinates that belong to no
+    // block are left unchanged by the sampler.
+    virtual std::vector<int> block_coordinates(int block) const = 0;
+
+    // The log density of one block, up to an additive constant.
+    //
+    // Args:
+    //   block:  The index of the block to evaluate.
+    //   values: The values of the coordinates in the block, in the order
+    //     given by block_coordinates(block).
+    //
+    // This function is called concurrently for different blocks when the
+    // sampler is multi-threaded, so it must not modify shared state.
+    virtual double block_log_density(int block,
+                                     const Vector &values) const = 0;
+
+    friend void intrusive_ptr_add_ref(BlockSeparableTarget *t) {
+      t->up_count();
+    }
+    friend void intrusive_ptr_release(BlockSeparableTarget *t) {
+      t->down_count();
+      if (t->ref_count() == 0) delete t;
+    }
+  };
+
+  //===========================================================================
+  // A slice sampler for a BlockSeparableTarget.  Within a block the
+  // coordinates are drawn one at a time, as in UnivariateSliceSampler, but
+  // each scalar update evaluates only the log density of its own block.
+  // Different blocks are updated concurrently.
+  //
+  // Blocks are grouped into fixed-size shards, each with its own random
+  // number stream seeded from this sampler's RNG, so the draws for a given
+  // seed do not depend on the number of threads.
+  class BlockSeparableSliceSampler : public Sampler {
+   public:
+    // Args:
+    //   target:  The log density to be sampled.
+    //   suggested_dx: The initial step size for each scalar slice sampler.
+    //   unimodal:  If true, the conditional density of each coordinate is
+    //     known to be unimodal.
+    //   rng: The random number generator used to seed the per-shard
+    //     streams.  If nullptr then GlobalRng::rng is used.
+    explicit BlockSeparableSliceSampler(
+        const Ptr<BlockSeparableTarget> &target, double suggested_dx = 1.0,
+        bool unimodal = false, RNG *rng = nullptr);
+
+    Vector draw(const Vector &x) override;
+
+    // Set lower and upper limits for the domain of each variable.  The
+    // arguments have the dimension of the full argument vector.
+    // negative_infinity() and infinity() are legal values, but lower[i] <
+    // upper[i] is a requirement for all i.
+    void set_limits(const Vector &lower, const Vector &upper);
+
+    void set_number_of_threads(int nthreads) {
+      pool_.set_number_of_threads(nthreads);
+    }
+
+   private:
+    // The coordinates in a block, their current values, and a scalar slice
+    // sampler for each one.
+    struct Block {
+      std::vector<int> coordinates;
+      Vector values;
+      std::vector<ScalarSliceSampler> samplers;
+    };
+
+    // Build the blocks, reporting an error if the target's blocks are not
+    // valid for an argument of the given dimension.
+    void initialize(int dimension);
+
+    Ptr<BlockSeparableTarget> target_;
+    double suggested_dx_;
+    bool unimodal_;
+    int dimension_;
+
+    // Blocks hold pointers to their own 'values' member, so they are held
+    // by pointer to keep their addresses fixed.
+    std::vector<std::unique_ptr<Block>> blocks_;
+    SharedThreadPool pool_;
+  };
+
+}  // namespace BOOM
+
+#endif  // BOOM_SAMPLERS_BLOCK_SEPARABLE_SLICE_SAMPLER_HPP_
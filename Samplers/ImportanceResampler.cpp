@@ -19,15 +19,50 @@
 
 #include "Samplers/ImportanceResampler.hpp"
 #include "cpputil/math_utils.hpp"
+#include "cpputil/report_error.hpp"
 #include "distributions.hpp"
 #include "stats/Resampler.hpp"
 
 namespace BOOM {
 
+  std::vector<int> resample_indices(RNG &rng, const Vector &probs,
+                                    int number_of_draws,
+                                    ResamplingMethod method) {
+    if (number_of_draws < 0) {
+      report_error("number_of_draws must be non-negative.");
+    }
+    if (method == ResamplingMethod::MULTINOMIAL) {
+      Resampler resample(probs);
+      return resample(number_of_draws, rng);
+    }
+    double total = probs.sum();
+    if (!(total > 0)) {
+      report_error("Resampling probabilities must have a positive sum.");
+    }
+    std::vector<int> ans(number_of_draws);
+    int last = static_cast<int>(probs.size()) - 1;
+    double u = runif_mt(rng, 0, 1);
+    double cumulative_prob = probs[0] / total;
+    int index = 0;
+    for (int i = 0; i < number_of_draws; ++i) {
+      if (method == ResamplingMethod::STRATIFIED && i > 0) {
+        u = runif_mt(rng, 0, 1);
+      }
+      double target = (i + u) / number_of_draws;
+      while (cumulative_prob < target && index < last) {
+        cumulative_prob += probs[++index] / total;
+      }
+      ans[i] = index;
+    }
+    return ans;
+  }
+
   ImportanceResampler::ImportanceResampler(
       const std::function<double(const Vector &)> &log_target_density,
       const Ptr<DirectProposal> &proposal)
-      : log_target_density_(log_target_density), proposal_(proposal) {}
+      : log_target_density_(log_target_density),
+        proposal_(proposal),
+        method_(ResamplingMethod::MULTINOMIAL) {}
 
   std::pair<Matrix, Vector> ImportanceResampler::draw(int number_of_draws,
                                                       RNG &rng) {
@@ -47,8 +82,17 @@ namespace BOOM {
     importance_weights -= max_log_importance_weight;
     importance_weights.normalize_logprob();
 
-    std::vector<int> resampling_counts =
-        rmultinom_mt(rng, number_of_draws, importance_weights);
+    std::vector<int> resampling_counts;
+    if (method_ == ResamplingMethod::MULTINOMIAL) {
+      resampling_counts =
+          rmultinom_mt(rng, number_of_draws, importance_weights);
+    } else {
+      resampling_counts.assign(number_of_draws, 0);
+      for (int index : resample_indices(rng, importance_weights,
+                                        number_of_draws, method_)) {
+        ++resampling_counts[index];
+      }
+    }
 
     int number_of_distinct_draws = 0;
 
@@ -21,12 +21,35 @@
 #define BOOM_SAMPLERS_IMPORTANCE_RESAMPLER_HPP_
 
 #include <functional>
+#include <vector>
 #include "LinAlg/Matrix.hpp"
 #include "LinAlg/Vector.hpp"
 #include "Samplers/DirectProposal.hpp"
 
 namespace BOOM {
 
+  // Schemes for drawing a resample from a discrete distribution.  Stratified
+  // and systematic resampling draw one uniform per stratum [i/n, (i+1)/n)
+  // (or a single uniform shared by all strata), which leaves less Monte Carlo
+  // noise in the resampled counts than multinomial resampling.
+  enum class ResamplingMethod { MULTINOMIAL, STRATIFIED, SYSTEMATIC };
+
+  // Draw indices from a discrete distribution.
+  //
+  // Args:
+  //   rng:  The random number generator.
+  //   probs: A discrete distribution with non-negative entries.  It need not
+  //     sum to 1.
+  //   number_of_draws:  The number of indices to draw.
+  //   method:  The resampling scheme to use.
+  //
+  // Returns:
+  //   A vector of number_of_draws indices into probs.  The stratified and
+  //   systematic schemes return the indices in increasing order.
+  std::vector<int> resample_indices(
+      RNG &rng, const Vector &probs, int number_of_draws,
+      ResamplingMethod method = ResamplingMethod::MULTINOMIAL);
+
   // An implementation of sampling with importance resampling.
   class ImportanceResampler {
    public:
@@ -57,9 +80,14 @@ namespace BOOM {
     // draw from the target distribution.  The number of draws
     Matrix draw_and_resample(int number_of_draws, RNG &rng = GlobalRng::rng);
 
+    // Set the scheme used to resample the proposal draws.  The default is
+    // multinomial resampling.
+    void set_resampling_method(ResamplingMethod method) { method_ = method; }
+
    private:
     std::function<double(const Vector &)> log_target_density_;
     Ptr<DirectProposal> proposal_;
+    ResamplingMethod method_;
   };
 
 }  // namespace BOOM
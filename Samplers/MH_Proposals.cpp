@@ -18,9 +18,27 @@
 */
 #include "Samplers/MH_Proposals.hpp"
 #include "LinAlg/Cholesky.hpp"
+#include "cpputil/lse.hpp"
+#include "cpputil/math_utils.hpp"
+#include "cpputil/report_error.hpp"
 #include "distributions.hpp"
 namespace BOOM {
 
+  namespace {
+    // A draw from a multivariate T (or normal if nu <= 0) distribution with
+    // mean zero and variance chol * chol.transpose().
+    Vector mvt_step(const Matrix &chol, double nu, int dim, RNG &rng) {
+      Vector ans(dim);
+      for (int i = 0; i < dim; ++i) ans[i] = rnorm_mt(rng, 0, 1);
+      ans = chol * ans;
+      if (std::isfinite(nu) && nu > 0) {
+        double w = rgamma_mt(rng, nu / 2.0, nu / 2.0);
+        ans /= sqrt(w);
+      }
+      return ans;
+    }
+  }  // namespace
+
   MH_Proposal::MH_Proposal() {}
 
   typedef MvtMhProposal MVTP;
@@ -30,14 +48,7 @@ namespace BOOM {
   }
 
   Vector MVTP::draw(const Vector &old, RNG *rng) const {
-    int n = old.size();
-    Vector ans(n);
-    for (int i = 0; i < n; ++i) ans[i] = rnorm_mt(*rng, 0, 1);
-    ans = chol_ * ans;
-    if (std::isfinite(nu_) && nu_ > 0) {
-      double w = rgamma_mt(*rng, nu_ / 2.0, nu_ / 2.0);
-      ans /= sqrt(w);
-    }
+    Vector ans = mvt_step(chol_, nu_, old.size(), *rng);
     ans += mu(old);
     return ans;
   }
@@ -69,7 +80,105 @@ namespace BOOM {
   }
 
   typedef MvtRwmProposal MVTR;
-  MVTR::MvtRwmProposal(const SpdMatrix &Ivar, double nu) : MVTP(Ivar, nu) {}
+  MVTR::MvtRwmProposal(const SpdMatrix &Ivar, double nu)
+      : MVTP(Ivar, nu),
+        adapting_(false),
+        warmup_(100),
+        fixed_proposal_probability_(1.0),
+        refresh_interval_(10),
+        number_of_observations_(0),
+        adapted_ldsi_(0) {}
+
+  Vector MVTR::draw(const Vector &old, RNG *rng) const {
+    if (!adapted() || runif_mt(*rng) < fixed_proposal_probability_) {
+      return MVTP::draw(old, rng);
+    }
+    Vector ans = mvt_step(adapted_chol_, nu(), old.size(), *rng);
+    ans += old;
+    return ans;
+  }
+
+  double MVTR::logf(const Vector &x, const Vector &old) const {
+    double fixed = MVTP::logf(x, old);
+    double p = fixed_proposal_probability_;
+    if (!adapted() || p >= 1) return fixed;
+    double adaptive = (std::isfinite(nu()) && nu() > 0)
+        ? dmvt(x, old, adapted_siginv_, nu(), adapted_ldsi_, true)
+        : dmvn(x, old, adapted_siginv_, adapted_ldsi_, true);
+    return lse2(log(p) + fixed, log(1 - p) + adaptive);
+  }
+
+  void MVTR::enable_adaptation(int warmup, double fixed_proposal_probability,
+                               int refresh_interval) {
+    if (fixed_proposal_probability <= 0 || fixed_proposal_probability > 1) {
+      report_error("fixed_proposal_probability must be in (0, 1].");
+    }
+    adapting_ = true;
+    warmup_ = std::max<int>(warmup, 2);
+    fixed_proposal_probability_ = fixed_proposal_probability;
+    refresh_interval_ = std::max<int>(refresh_interval, 1);
+    number_of_observations_ = 0;
+    running_mean_.resize(0);
+    running_sum_of_squares_.resize(0);
+    adapted_chol_ = Matrix();
+  }
+
+  void MVTR::disable_adaptation() {
+    adapting_ = false;
+    fixed_proposal_probability_ = 1.0;
+    number_of_observations_ = 0;
+    running_mean_.resize(0);
+    running_sum_of_squares_.resize(0);
+    adapted_chol_ = Matrix();
+  }
+
+  void MVTR::observe(const Vector &state) {
+    if (!adapting_) return;
+    if (state.size() != dim()) {
+      report_error("Wrong size state passed to MvtRwmProposal::observe.");
+    }
+    if (number_of_observations_ == 0) {
+      running_mean_ = state;
+      running_sum_of_squares_ = SpdMatrix(dim(), 0.0);
+      number_of_observations_ = 1;
+      return;
+    }
+    // Welford's update of the running mean and sum of squares.
+    ++number_of_observations_;
+    Vector delta = state - running_mean_;
+    running_mean_.axpy(delta, 1.0 / number_of_observations_);
+    running_sum_of_squares_.add_outer(
+        delta, 1.0 - 1.0 / number_of_observations_, false);
+    if (number_of_observations_ >= warmup_
+        && (number_of_observations_ - warmup_) % refresh_interval_ == 0) {
+      running_sum_of_squares_.reflect();
+      refresh_adapted_variance();
+    }
+  }
+
+  SpdMatrix MVTR::adapted_variance() const {
+    SpdMatrix ans(adapted_chol_.nrow(), 0.0);
+    ans.add_outer(adapted_chol_);
+    return ans;
+  }
+
+  void MVTR::refresh_adapted_variance() {
+    int d = dim();
+    SpdMatrix variance = running_sum_of_squares_ / (number_of_observations_ - 1);
+    // A small ridge keeps the variance positive definite if the chain has not
+    // yet moved in some direction.
+    double ridge = 1e-6 * variance.trace() / d + 1e-12;
+    variance.diag() += ridge;
+    variance *= square(2.38) / d;
+    Cholesky cholesky(variance);
+    if (!cholesky.is_pos_def()) {
+      // Keep the previous factorization, if any.
+      return;
+    }
+    adapted_chol_ = cholesky.getL();
+    adapted_siginv_ = cholesky.inv();
+    adapted_ldsi_ = -cholesky.logdet();
+  }
 
   typedef MvtIndepProposal MVTI;
   MVTI::MvtIndepProposal(const Vector &mu, const SpdMatrix &Ivar, double nu)
@@ -58,6 +58,7 @@ namespace BOOM {
     void set_nu(double nu);
     uint dim() const;
     const SpdMatrix &ivar() const { return siginv_; }
+    double nu() const { return nu_; }
 
    private:
     SpdMatrix siginv_;
@@ -81,13 +82,81 @@ namespace BOOM {
     Vector mu_;
   };
 
+  // A random walk proposal centered on the current state.
+  //
+  // The proposal can optionally adapt its variance to the target, following
+  // the adaptive Metropolis algorithm of Haario, Saksman, and Tamminen
+  // (2001).  The sampler using the proposal passes each state of the chain to
+  // observe(), which maintains the running mean and variance C of the
+  // observed states.  Once 'warmup' states have been observed, each step is
+  // drawn
+  //   - with probability 'fixed_proposal_probability' from the fixed
+  //     proposal given by the constructor, set_ivar() or set_var(),
+  //   - otherwise with variance (2.38^2 / dim) * (C + epsilon * I), which is
+  //     the optimal random walk scale for a Gaussian target.
+  // Every observed state gets weight 1/n in C, so the amount of adaptation
+  // diminishes as the chain runs, which (together with the fixed component)
+  // preserves convergence to the target (Roberts and Rosenthal, 2009).  The
+  // Cholesky factor of the adapted variance is cached, and refreshed every
+  // 'refresh_interval' observations, so most draws cost O(dim^2).
+  //
+  // The mixture of two symmetric proposals is symmetric, so sym() is true
+  // with or without adaptation.
   class MvtRwmProposal : public MvtMhProposal {
    public:
     MvtRwmProposal(const SpdMatrix &Ivar, double nu);
     bool sym() const override { return true; }
     const Vector &mu(const Vector &old) const override { return old; }
 
+    Vector draw(const Vector &old, RNG *rng) const override;
+    double logf(const Vector &x, const Vector &old) const override;
+
+    // Turn on adaptation, discarding any previously observed states.
+    // Args:
+    //   warmup:  The number of observed states needed before the adapted
+    //     component is used.  At least 2.
+    //   fixed_proposal_probability:  The probability of drawing from the
+    //     fixed proposal once the adapted component is in use.  Must be in
+    //     (0, 1].
+    //   refresh_interval:  The number of observations between refreshes of
+    //     the adapted variance.
+    void enable_adaptation(int warmup = 100,
+                           double fixed_proposal_probability = .05,
+                           int refresh_interval = 10);
+    void disable_adaptation();
+    bool adapting() const { return adapting_; }
+
+    // Record a state of the chain.  A no-op unless adapting().
+    void observe(const Vector &state);
+
+    // The number of states passed to observe() since adaptation was enabled.
+    int number_of_observations() const { return number_of_observations_; }
+
+    // Returns true if draw() can use the adapted component.
+    bool adapted() const {
+      return adapting_ && adapted_chol_.nrow() > 0;
+    }
+
+    // The variance of the adapted component.  Only meaningful if adapted().
+    SpdMatrix adapted_variance() const;
+
    private:
+    void refresh_adapted_variance();
+
+    bool adapting_;
+    int warmup_;
+    double fixed_proposal_probability_;
+    int refresh_interval_;
+
+    // Running moments of the observed states.
+    int number_of_observations_;
+    Vector running_mean_;
+    SpdMatrix running_sum_of_squares_;
+
+    // The cached factorization of the adapted variance.
+    Matrix adapted_chol_;
+    SpdMatrix adapted_siginv_;
+    double adapted_ldsi_;
   };
 
   class MvnIndepProposal : public MvtIndepProposal {
@@ -0,0 +1,72 @@
+// Copyright 2018 Google LLC. All Rights Reserved.
+/*
+  Copyright (C) 2005-2024 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include "Samplers/McmcProfiler.hpp"
+
+#include <mutex>
+#include "Samplers/MoveAccounting.hpp"
+
+namespace BOOM {
+
+  std::atomic<bool> McmcProfiler::enabled_(false);
+
+  namespace {
+    // The accounting object and its lock are function-level statics so they
+    // are constructed on first use, regardless of static initialization
+    // order.
+    std::mutex &profiler_mutex() {
+      static std::mutex mutex;
+      return mutex;
+    }
+
+    MoveAccounting &profiler_accounting() {
+      static MoveAccounting accounting;
+      return accounting;
+    }
+  }  // namespace
+
+  void McmcProfiler::record(const char *phase, double seconds) {
+    std::lock_guard<std::mutex> lock(profiler_mutex());
+    MoveAccounting &accounting(profiler_accounting());
+    accounting.record_time(phase, seconds);
+    accounting.record_special(phase, "calls");
+  }
+
+  LabeledMatrix McmcProfiler::report() {
+    std::lock_guard<std::mutex> lock(profiler_mutex());
+    LabeledMatrix counts = profiler_accounting().to_matrix();
+    const std::vector<std::string> &outcomes(counts.col_names());
+    int seconds_column = -1;
+    int calls_column = -1;
+    for (int j = 0; j < outcomes.size(); ++j) {
+      if (outcomes[j] == "seconds") seconds_column = j;
+      if (outcomes[j] == "calls") calls_column = j;
+    }
+    Matrix ans(counts.nrow(), 2, 0.0);
+    if (seconds_column >= 0) ans.col(0) = counts.col(seconds_column);
+    if (calls_column >= 0) ans.col(1) = counts.col(calls_column);
+    return LabeledMatrix(ans, counts.row_names(), {"seconds", "calls"});
+  }
+
+  void McmcProfiler::reset() {
+    std::lock_guard<std::mutex> lock(profiler_mutex());
+    profiler_accounting() = MoveAccounting();
+  }
+
+}  // namespace BOOM
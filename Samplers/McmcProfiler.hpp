@@ -0,0 +1,116 @@
+#ifndef BOOM_SAMPLERS_MCMC_PROFILER_HPP_
+#define BOOM_SAMPLERS_MCMC_PROFILER_HPP_
+// Copyright 2018 Google LLC. All Rights Reserved.
+/*
+  Copyright (C) 2005-2024 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include <atomic>
+#include <chrono>
+
+#include "LinAlg/Matrix.hpp"
+
+namespace BOOM {
+
+  // A process-wide record of the time spent in the major phases of an MCMC
+  // iteration: latent data imputation, sufficient statistic refreshes, Kalman
+  // filtering and smoothing, parameter draws, and output.  Phases are
+  // identified by name rather than by model, so the times from every model in
+  // a sampler tree (e.g. all the state models in a state space model) are
+  // aggregated under the same phase.
+  //
+  // Profiling is off by default.  When it is off, a ScopedPhaseTimer costs a
+  // single relaxed atomic load.  When it is on, each timed phase costs two
+  // clock reads and a mutex-protected update of a MoveAccounting object.
+  //
+  // Phases can nest.  For example, "impute_latent_data" for a state space
+  // model includes the "kalman_filter" and "kalman_smoother" time spent
+  // computing it, so the rows of the report do not sum to the total run
+  // time.  Time spent by worker threads is summed across threads.
+  class McmcProfiler {
+   public:
+    // Standard phase names, so that the same phase in different models is
+    // reported on a single line.
+    static constexpr const char *kImputeLatentData = "impute_latent_data";
+    static constexpr const char *kRefreshSuf = "refresh_suf";
+    static constexpr const char *kKalmanFilter = "kalman_filter";
+    static constexpr const char *kKalmanSmoother = "kalman_smoother";
+    static constexpr const char *kParameterDraws = "parameter_draws";
+    static constexpr const char *kIoWrite = "io_write";
+
+    // Turn profiling on or off.  Turning profiling off does not clear the
+    // times already recorded.
+    static void enable(bool on = true) {
+      enabled_.store(on, std::memory_order_relaxed);
+    }
+    static bool enabled() { return enabled_.load(std::memory_order_relaxed); }
+
+    // Add a timed call to the named phase.  Safe to call from multiple
+    // threads.
+    static void record(const char *phase, double seconds);
+
+    // A matrix with one row per phase.  The columns are "seconds", the total
+    // wall time spent in the phase, and "calls", the number of times the
+    // phase was entered.
+    static LabeledMatrix report();
+
+    // Discard all recorded times.
+    static void reset();
+
+   private:
+    static std::atomic<bool> enabled_;
+  };
+
+  // Times the lifetime of the object, and records it in the McmcProfiler
+  // under the given phase name.  The name must be a string with static
+  // storage duration, such as a string literal or one of the McmcProfiler
+  // phase constants.  If profiling is disabled when the timer is created then
+  // nothing is recorded.
+  //
+  // Idiom:
+  //   void MyModel::impute_latent_data() {
+  //     ScopedPhaseTimer timer(McmcProfiler::kImputeLatentData);
+  //     ...
+  //   }
+  class ScopedPhaseTimer {
+   public:
+    explicit ScopedPhaseTimer(const char *phase)
+        : phase_(McmcProfiler::enabled() ? phase : nullptr) {
+      if (phase_) {
+        start_ = std::chrono::steady_clock::now();
+      }
+    }
+
+    ~ScopedPhaseTimer() {
+      if (phase_) {
+        std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - start_;
+        McmcProfiler::record(phase_, elapsed.count());
+      }
+    }
+
+    ScopedPhaseTimer(const ScopedPhaseTimer &rhs) = delete;
+    ScopedPhaseTimer &operator=(const ScopedPhaseTimer &rhs) = delete;
+
+   private:
+    const char *phase_;
+    std::chrono::steady_clock::time_point start_;
+  };
+
+}  // namespace BOOM
+
+#endif  // BOOM_SAMPLERS_MCMC_PROFILER_HPP_
@@ -0,0 +1,171 @@
+// Copyright 2018 Google LLC. All Rights Reserved.
+/*
+  Copyright (C) 2005-2024 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include "Samplers/McmcTelemetry.hpp"
+
+#include <unistd.h>
+#include <cerrno>
+#include <sstream>
+
+namespace BOOM {
+
+  namespace {
+    // Write all of 'line' to 'fd', retrying after interruptions and partial
+    // writes.  Errors are ignored: telemetry must not stop the sampler.
+    void write_line(int fd, const std::string &line) {
+      const char *data = line.data();
+      std::size_t remaining = line.size();
+      while (remaining > 0) {
+        ssize_t written = ::write(fd, data, remaining);
+        if (written < 0) {
+          if (errno == EINTR) continue;
+          return;
+        }
+        data += written;
+        remaining -= written;
+      }
+    }
+  }  // namespace
+
+  McmcTelemetry::McmcTelemetry(int capacity)
+      : buffer_(capacity > 0 ? capacity : 2),
+        fd_(-1),
+        number_dropped_(0),
+        flushing_(false),
+        reporting_(false) {}
+
+  McmcTelemetry::~McmcTelemetry() {
+    stop_reporting();
+    flush();
+  }
+
+  bool McmcTelemetry::publish(const McmcTelemetryRecord &record) {
+    if (buffer_.push(record)) {
+      return true;
+    }
+    number_dropped_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  int McmcTelemetry::flush() {
+    if (flushing_.exchange(true, std::memory_order_acquire)) {
+      return 0;
+    }
+    int ans = 0;
+    McmcTelemetryRecord record;
+    while (buffer_.pop(record)) {
+      if (callback_) {
+        callback_(record);
+      }
+      if (fd_ >= 0) {
+        write_line(fd_, format(record));
+      }
+      ++ans;
+    }
+    flushing_.store(false, std::memory_order_release);
+    return ans;
+  }
+
+  void McmcTelemetry::start_reporting(double interval_seconds) {
+    stop_reporting();
+    std::chrono::duration<double> interval(
+        interval_seconds > 0 ? interval_seconds : 0.5);
+    {
+      std::lock_guard<std::mutex> lock(reporter_mutex_);
+      reporting_ = true;
+    }
+    reporter_ = std::thread([this, interval]() {
+      std::unique_lock<std::mutex> lock(reporter_mutex_);
+      while (reporting_) {
+        reporter_wakeup_.wait_for(lock, interval);
+        lock.unlock();
+        flush();
+        lock.lock();
+      }
+    });
+  }
+
+  void McmcTelemetry::stop_reporting() {
+    {
+      std::lock_guard<std::mutex> lock(reporter_mutex_);
+      reporting_ = false;
+    }
+    reporter_wakeup_.notify_all();
+    if (reporter_.joinable()) {
+      reporter_.join();
+    }
+  }
+
+  std::string McmcTelemetry::format(const McmcTelemetryRecord &record) {
+    std::ostringstream out;
+    out << "chain " << record.chain
+        << " iteration " << record.iteration
+        << " seconds " << record.elapsed_seconds
+        << " iterations_per_second " << record.iterations_per_second;
+    if (record.log_posterior == record.log_posterior) {
+      out << " log_posterior " << record.log_posterior;
+    }
+    if (record.acceptance_rate == record.acceptance_rate) {
+      out << " acceptance_rate " << record.acceptance_rate;
+    }
+    out << "\n";
+    return out.str();
+  }
+
+  //===========================================================================
+  McmcTelemetryReporter::McmcTelemetryReporter(
+      McmcTelemetry *telemetry, int chain, int report_every)
+      : telemetry_(telemetry),
+        chain_(chain),
+        report_every_(report_every > 0 ? report_every : 1),
+        iteration_(0),
+        last_reported_iteration_(0),
+        start_(std::chrono::steady_clock::now()),
+        last_report_time_(start_) {}
+
+  bool McmcTelemetryReporter::tick() {
+    ++iteration_;
+    return telemetry_ && iteration_ % report_every_ == 0;
+  }
+
+  void McmcTelemetryReporter::report(double log_posterior,
+                                     double acceptance_rate) {
+    if (!telemetry_) return;
+    std::chrono::steady_clock::time_point now =
+        std::chrono::steady_clock::now();
+    std::chrono::duration<double> elapsed = now - start_;
+    std::chrono::duration<double> since_last = now - last_report_time_;
+
+    McmcTelemetryRecord record;
+    record.chain = chain_;
+    record.iteration = iteration_;
+    record.elapsed_seconds = elapsed.count();
+    record.iterations_per_second =
+        since_last.count() > 0
+        ? (iteration_ - last_reported_iteration_) / since_last.count()
+        : 0.0;
+    record.log_posterior = log_posterior;
+    record.acceptance_rate = acceptance_rate;
+    telemetry_->publish(record);
+
+    last_reported_iteration_ = iteration_;
+    last_report_time_ = now;
+  }
+
+}  // namespace BOOM
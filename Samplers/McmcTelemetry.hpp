@@ -0,0 +1,180 @@
+#ifndef BOOM_SAMPLERS_MCMC_TELEMETRY_HPP_
+#define BOOM_SAMPLERS_MCMC_TELEMETRY_HPP_
+// Copyright 2018 Google LLC. All Rights Reserved.
+/*
+  Copyright (C) 2005-2024 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "cpputil/LockFreeRingBuffer.hpp"
+
+namespace BOOM {
+
+  // A snapshot of the progress of one MCMC chain.
+  struct McmcTelemetryRecord {
+    // The chain that produced the record.
+    int chain = 0;
+
+    // The number of iterations completed by the chain.
+    int iteration = 0;
+
+    // Wall time since the chain's reporter was created.
+    double elapsed_seconds = 0;
+
+    // Iterations per second since the chain's previous report.
+    double iterations_per_second = 0;
+
+    // Quantities that not every sampler can supply are NaN when unavailable.
+    double log_posterior = std::numeric_limits<double>::quiet_NaN();
+    double acceptance_rate = std::numeric_limits<double>::quiet_NaN();
+  };
+
+  // Collects progress reports from MCMC chains, which may be running on
+  // worker threads, and delivers them to a callback and/or a file
+  // descriptor.
+  //
+  // Chains publish() records into a lock-free ring buffer, so reporting
+  // never blocks a chain or serializes chains against one another.  If the
+  // buffer is full the record is dropped (and counted) rather than waiting
+  // for space.  Records are delivered by flush(), which can be called from
+  // the thread that owns the sinks (e.g. the R main thread, which is the
+  // only thread allowed to print to the R console), or periodically from a
+  // background thread started by start_reporting().
+  //
+  // Each record written to the file descriptor is formatted as a single line
+  // and written with a single call to write(), so output from different
+  // chains is never interleaved within a line.
+  class McmcTelemetry {
+   public:
+    typedef std::function<void(const McmcTelemetryRecord &)> Callback;
+
+    // Args:
+    //   capacity: The number of records that can be waiting for delivery.
+    //     Rounded up to a power of 2.
+    explicit McmcTelemetry(int capacity = 1024);
+
+    // Stops the background thread (if any) and delivers any pending records.
+    ~McmcTelemetry();
+
+    McmcTelemetry(const McmcTelemetry &rhs) = delete;
+    McmcTelemetry &operator=(const McmcTelemetry &rhs) = delete;
+
+    // Sinks for delivered records.  These should be set before records are
+    // published.  The callback runs on the thread that calls flush().
+    void set_callback(const Callback &callback) { callback_ = callback; }
+
+    // Write each record as a line of text to the given file descriptor
+    // (e.g. 1 for stdout, or a pipe).  A negative value turns this sink off.
+    void set_file_descriptor(int fd) { fd_ = fd; }
+
+    // Add a record to the queue awaiting delivery.  Safe to call from any
+    // thread, and never blocks.
+    //
+    // Returns:
+    //   true if the record was queued, or false if the buffer was full and
+    //   the record was dropped.
+    bool publish(const McmcTelemetryRecord &record);
+
+    // Deliver all queued records to the sinks.  If another thread is already
+    // flushing this call returns immediately.
+    //
+    // Returns:
+    //   The number of records delivered by this call.
+    int flush();
+
+    // Start a background thread that calls flush() every 'interval_seconds'
+    // until stop_reporting() is called or the object is destroyed.
+    void start_reporting(double interval_seconds = 0.5);
+    void stop_reporting();
+
+    // The number of records dropped because the buffer was full.
+    std::size_t number_dropped() const {
+      return number_dropped_.load(std::memory_order_relaxed);
+    }
+
+    // The line of text written to the file descriptor for 'record'.  The
+    // line ends in a newline.
+    static std::string format(const McmcTelemetryRecord &record);
+
+   private:
+    LockFreeRingBuffer<McmcTelemetryRecord> buffer_;
+    Callback callback_;
+    int fd_;
+    std::atomic<std::size_t> number_dropped_;
+    std::atomic<bool> flushing_;
+
+    // Only the background reporting thread and the calls that start and stop
+    // it use these.  The mutex is never taken by publish().
+    std::thread reporter_;
+    std::mutex reporter_mutex_;
+    std::condition_variable reporter_wakeup_;
+    bool reporting_;
+  };
+
+  // Publishes periodic McmcTelemetryRecords on behalf of a single chain.
+  // Each chain should have its own reporter, which is not shared across
+  // threads.
+  //
+  // Idiom:
+  //   McmcTelemetryReporter reporter(&telemetry, chain, 100);
+  //   for (int i = 0; i < niter; ++i) {
+  //     model->sample_posterior();
+  //     if (reporter.tick()) {
+  //       reporter.report(model->log_likelihood() + model->logpri());
+  //     }
+  //   }
+  class McmcTelemetryReporter {
+   public:
+    // Args:
+    //   telemetry: The collector receiving the records.  If nullptr then
+    //     tick() always returns false.
+    //   chain:  The chain number to place in the records.
+    //   report_every: tick() returns true every report_every iterations.
+    McmcTelemetryReporter(McmcTelemetry *telemetry, int chain,
+                          int report_every = 100);
+
+    // Count an iteration.  Returns true if a report is due.
+    bool tick();
+
+    // Publish a record describing the progress since the previous report.
+    void report(
+        double log_posterior = std::numeric_limits<double>::quiet_NaN(),
+        double acceptance_rate = std::numeric_limits<double>::quiet_NaN());
+
+    int iteration() const { return iteration_; }
+
+   private:
+    McmcTelemetry *telemetry_;
+    int chain_;
+    int report_every_;
+    int iteration_;
+    int last_reported_iteration_;
+    std::chrono::steady_clock::time_point start_;
+    std::chrono::steady_clock::time_point last_report_time_;
+  };
+
+}  // namespace BOOM
+
+#endif  // BOOM_SAMPLERS_MCMC_TELEMETRY_HPP_
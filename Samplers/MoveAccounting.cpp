@@ -157,4 +157,42 @@ namespace BOOM {
     }
   }
 
+  void MoveAccounting::write_checkpoint(CheckpointWriter &out) const {
+    out.begin_section("MoveAccounting");
+    out.write(static_cast<int>(counts_.size()));
+    for (const auto &move : counts_) {
+      out.write(move.first);
+      out.write(static_cast<int>(move.second.size()));
+      for (const auto &outcome : move.second) {
+        out.write(outcome.first);
+        out.write(outcome.second);
+      }
+    }
+    out.write(static_cast<int>(time_in_seconds_.size()));
+    for (const auto &timing : time_in_seconds_) {
+      out.write(timing.first);
+      out.write(timing.second);
+    }
+  }
+
+  void MoveAccounting::read_checkpoint(CheckpointReader &in) {
+    in.expect_section("MoveAccounting");
+    counts_.clear();
+    time_in_seconds_.clear();
+    int number_of_moves = in.read_int();
+    for (int i = 0; i < number_of_moves; ++i) {
+      std::map<std::string, int> &outcomes(counts_[in.read_string()]);
+      int number_of_outcomes = in.read_int();
+      for (int j = 0; j < number_of_outcomes; ++j) {
+        std::string outcome = in.read_string();
+        outcomes[outcome] = in.read_int();
+      }
+    }
+    int number_of_timings = in.read_int();
+    for (int i = 0; i < number_of_timings; ++i) {
+      std::string move = in.read_string();
+      time_in_seconds_[move] = in.read_double();
+    }
+  }
+
 }  // namespace BOOM
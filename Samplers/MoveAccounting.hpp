@@ -26,6 +26,7 @@
 #include <vector>
 
 #include "LinAlg/Matrix.hpp"
+#include "cpputil/Checkpoint.hpp"
 
 namespace BOOM {
 
@@ -87,6 +88,16 @@ namespace BOOM {
     MoveTimer start_time(const std::string &move_type);
     double stop_time(const std::string &move_type, clock_t start);
 
+    // Add time measured elsewhere (e.g. wall time rather than CPU time) to
+    // the total for the given move type.
+    void record_time(const std::string &move_type, double seconds) {
+      time_in_seconds_[move_type] += seconds;
+    }
+
+    // Save or restore the counts and timings.
+    void write_checkpoint(CheckpointWriter &out) const;
+    void read_checkpoint(CheckpointReader &in);
+
    private:
     // counts_ is essentially a matrix indexed by strings instead of
     // integers.  The "row" index is called a "move type".  It is
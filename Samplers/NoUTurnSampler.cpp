@@ -0,0 +1,304 @@
+// Copyright 2018 Google LLC. All Rights Reserved.
+/*
+  Copyright (C) 2005-2018 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#include "Samplers/NoUTurnSampler.hpp"
+#include <algorithm>
+#include <cmath>
+#include "cpputil/math_utils.hpp"
+#include "cpputil/report_error.hpp"
+#include "distributions.hpp"
+
+namespace BOOM {
+
+  namespace {
+    typedef NoUTurnSampler NUTS;
+
+    // Dual averaging constants recommended by Hoffman and Gelman.
+    const double dual_averaging_gamma = 0.05;
+    const double dual_averaging_t0 = 10;
+    const double dual_averaging_kappa = 0.75;
+
+    // A trajectory is abandoned if the energy drops this far below its
+    // starting value, which signals that the integrator is unstable.
+    const double max_energy_error = 1000;
+  }  // namespace
+
+  NUTS::NoUTurnSampler(const Ptr<dTargetFun> &logf, RNG *rng)
+      : Sampler(rng),
+        logf_(logf),
+        step_size_(1.0),
+        step_size_initialized_(false),
+        max_tree_depth_(10),
+        dense_mass_(false),
+        adaptation_draws_remaining_(0),
+        adaptation_iteration_(0),
+        target_acceptance_rate_(0.8),
+        log_step_size_target_(0.0),
+        log_step_size_average_(0.0),
+        acceptance_gap_average_(0.0),
+        leapfrog_steps_(0),
+        acceptance_rate_(0.0),
+        divergences_(0),
+        divergent_(false) {}
+
+  Vector NUTS::draw(const Vector &x) {
+    if (!dense_mass_ && inverse_mass_diagonal_.size() != x.size()) {
+      inverse_mass_diagonal_.resize(x.size());
+      inverse_mass_diagonal_ = 1.0;
+    }
+    PhasePoint current;
+    current.position = x;
+    current.logp = (*logf_)(x, current.gradient);
+    if (!std::isfinite(current.logp)) {
+      report_error("NoUTurnSampler must start from a point with positive "
+                   "density.");
+    }
+    if (!step_size_initialized_) {
+      initialize_step_size(current);
+    }
+
+    current.momentum = draw_momentum();
+    double initial_energy = current.logp - kinetic_energy(current.momentum);
+    double log_slice = initial_energy - rexp_mt(rng(), 1.0);
+
+    PhasePoint minus = current;
+    PhasePoint plus = current;
+    Vector ans = x;
+    double number_in_slice = 1;
+    bool ok = true;
+    double acceptance_sum = 0;
+    leapfrog_steps_ = 0;
+    divergent_ = false;
+    for (int depth = 0; ok && depth < max_tree_depth_; ++depth) {
+      int direction = runif_mt(rng()) < 0.5 ? -1 : 1;
+      Tree tree = build_tree(direction < 0 ? minus : plus, log_slice,
+                             direction, depth, initial_energy);
+      if (direction < 0) {
+        minus = tree.minus;
+      } else {
+        plus = tree.plus;
+      }
+      if (tree.ok &&
+          runif_mt(rng()) < tree.number_in_slice / number_in_slice) {
+        ans = tree.proposal.position;
+      }
+      number_in_slice += tree.number_in_slice;
+      acceptance_sum += tree.acceptance_sum;
+      leapfrog_steps_ += tree.number_of_steps;
+      ok = tree.ok && no_u_turn(minus, plus);
+    }
+    if (divergent_) ++divergences_;
+    acceptance_rate_ = acceptance_sum / leapfrog_steps_;
+
+    if (adaptation_draws_remaining_ > 0) {
+      update_step_size(acceptance_rate_);
+      if (--adaptation_draws_remaining_ == 0) {
+        step_size_ = exp(log_step_size_average_);
+      }
+    }
+    return ans;
+  }
+
+  void NUTS::set_step_size(double step_size) {
+    if (step_size <= 0) {
+      report_error("Step size must be positive.");
+    }
+    step_size_ = step_size;
+    step_size_initialized_ = true;
+    adaptation_iteration_ = 0;
+  }
+
+  void NUTS::adapt_step_size(int number_of_draws,
+                             double target_acceptance_rate) {
+    if (target_acceptance_rate <= 0 || target_acceptance_rate >= 1) {
+      report_error("Target acceptance rate must be in (0, 1).");
+    }
+    adaptation_draws_remaining_ = number_of_draws;
+    adaptation_iteration_ = 0;
+    target_acceptance_rate_ = target_acceptance_rate;
+  }
+
+  void NUTS::set_diagonal_inverse_mass(const Vector &inverse_mass) {
+    for (double m : inverse_mass) {
+      if (m <= 0) {
+        report_error("Inverse mass elements must be positive.");
+      }
+    }
+    inverse_mass_diagonal_ = inverse_mass;
+    dense_mass_ = false;
+    inverse_mass_ = SpdMatrix();
+    mass_cholesky_ = Matrix();
+  }
+
+  void NUTS::set_inverse_mass(const SpdMatrix &inverse_mass) {
+    bool ok = true;
+    SpdMatrix mass = inverse_mass.inv(ok);
+    if (ok) mass_cholesky_ = mass.chol(ok);
+    if (!ok) {
+      report_error("Inverse mass matrix must be positive definite.");
+    }
+    inverse_mass_ = inverse_mass;
+    dense_mass_ = true;
+    inverse_mass_diagonal_ = Vector();
+  }
+
+  void NUTS::set_max_tree_depth(int depth) {
+    if (depth <= 0) {
+      report_error("Maximum tree depth must be positive.");
+    }
+    max_tree_depth_ = depth;
+  }
+
+  NUTS::Tree NUTS::build_tree(const PhasePoint &start, double log_slice,
+                              int direction, int depth,
+                              double initial_energy) {
+    if (depth == 0) {
+      Tree tree;
+      tree.proposal = start;
+      leapfrog(tree.proposal, direction * step_size_);
+      double energy =
+          tree.proposal.logp - kinetic_energy(tree.proposal.momentum);
+      if (std::isnan(energy)) {
+        energy = negative_infinity();
+      }
+      tree.number_in_slice = log_slice <= energy ? 1 : 0;
+      tree.ok = log_slice < energy + max_energy_error;
+      if (!tree.ok) divergent_ = true;
+      tree.acceptance_sum = std::min<double>(1.0, exp(energy - initial_energy));
+      tree.number_of_steps = 1;
+      tree.minus = tree.proposal;
+      tree.plus = tree.proposal;
+      return tree;
+    }
+
+    Tree tree = build_tree(start, log_slice, direction, depth - 1,
+                           initial_energy);
+    if (!tree.ok) {
+      return tree;
+    }
+    Tree extension = build_tree(direction < 0 ? tree.minus : tree.plus,
+                                log_slice, direction, depth - 1,
+                                initial_energy);
+    if (direction < 0) {
+      tree.minus = extension.minus;
+    } else {
+      tree.plus = extension.plus;
+    }
+    double total = tree.number_in_slice + extension.number_in_slice;
+    if (extension.number_in_slice > 0 &&
+        runif_mt(rng()) < extension.number_in_slice / total) {
+      tree.proposal = extension.proposal;
+    }
+    tree.number_in_slice = total;
+    tree.acceptance_sum += extension.acceptance_sum;
+    tree.number_of_steps += extension.number_of_steps;
+    tree.ok = extension.ok && no_u_turn(tree.minus, tree.plus);
+    return tree;
+  }
+
+  void NUTS::leapfrog(PhasePoint &point, double epsilon) const {
+    point.momentum.axpy(point.gradient, epsilon / 2);
+    point.position.axpy(inverse_mass_times(point.momentum), epsilon);
+    point.logp = (*logf_)(point.position, point.gradient);
+    if (!std::isfinite(point.logp)) {
+      point.logp = negative_infinity();
+      return;
+    }
+    point.momentum.axpy(point.gradient, epsilon / 2);
+  }
+
+  bool NUTS::no_u_turn(const PhasePoint &minus, const PhasePoint &plus) const {
+    Vector span = plus.position - minus.position;
+    return span.dot(inverse_mass_times(minus.momentum)) >= 0 &&
+           span.dot(inverse_mass_times(plus.momentum)) >= 0;
+  }
+
+  double NUTS::kinetic_energy(const Vector &momentum) const {
+    return 0.5 * momentum.dot(inverse_mass_times(momentum));
+  }
+
+  Vector NUTS::inverse_mass_times(const Vector &momentum) const {
+    if (dense_mass_) {
+      return inverse_mass_ * momentum;
+    }
+    Vector ans(momentum);
+    for (int i = 0; i < ans.size(); ++i) {
+      ans[i] *= inverse_mass_diagonal_[i];
+    }
+    return ans;
+  }
+
+  Vector NUTS::draw_momentum() {
+    int dim = dense_mass_ ? inverse_mass_.nrow()
+                          : inverse_mass_diagonal_.size();
+    Vector z(dim);
+    rnorm_mt(rng(), z);
+    if (dense_mass_) {
+      return mass_cholesky_ * z;
+    }
+    for (int i = 0; i < dim; ++i) {
+      z[i] /= sqrt(inverse_mass_diagonal_[i]);
+    }
+    return z;
+  }
+
+  void NUTS::initialize_step_size(const PhasePoint &point) {
+    step_size_ = 1.0;
+    PhasePoint trial = point;
+    trial.momentum = draw_momentum();
+    double initial_energy = point.logp - kinetic_energy(trial.momentum);
+    Vector momentum = trial.momentum;
+    leapfrog(trial, step_size_);
+    double log_ratio =
+        trial.logp - kinetic_energy(trial.momentum) - initial_energy;
+    if (std::isnan(log_ratio)) log_ratio = negative_infinity();
+    int direction = log_ratio > -log(2.0) ? 1 : -1;
+    for (int i = 0; i < 100 && direction * log_ratio > -direction * log(2.0);
+         ++i) {
+      step_size_ *= direction > 0 ? 2.0 : 0.5;
+      trial.position = point.position;
+      trial.gradient = point.gradient;
+      trial.momentum = momentum;
+      leapfrog(trial, step_size_);
+      log_ratio = trial.logp - kinetic_energy(trial.momentum) - initial_energy;
+      if (std::isnan(log_ratio)) log_ratio = negative_infinity();
+    }
+    step_size_initialized_ = true;
+  }
+
+  void NUTS::update_step_size(double acceptance_rate) {
+    if (adaptation_iteration_ == 0) {
+      log_step_size_target_ = log(10 * step_size_);
+      log_step_size_average_ = 0.0;
+      acceptance_gap_average_ = 0.0;
+    }
+    double m = ++adaptation_iteration_;
+    double w = 1.0 / (m + dual_averaging_t0);
+    acceptance_gap_average_ = (1 - w) * acceptance_gap_average_ +
+                              w * (target_acceptance_rate_ - acceptance_rate);
+    double log_step_size = log_step_size_target_ -
+                           sqrt(m) / dual_averaging_gamma *
+                               acceptance_gap_average_;
+    double eta = pow(m, -dual_averaging_kappa);
+    log_step_size_average_ =
+        eta * log_step_size + (1 - eta) * log_step_size_average_;
+    step_size_ = exp(log_step_size);
+  }
+
+}  // namespace BOOM
@@ -0,0 +1,177 @@
+// Copyright 2018 Google LLC. All Rights Reserved.
+/*
+  Copyright (C) 2005-2018 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#ifndef BOOM_SAMPLERS_NO_U_TURN_SAMPLER_HPP_
+#define BOOM_SAMPLERS_NO_U_TURN_SAMPLER_HPP_
+
+#include "LinAlg/Matrix.hpp"
+#include "LinAlg/SpdMatrix.hpp"
+#include "LinAlg/Vector.hpp"
+#include "Samplers/Sampler.hpp"
+#include "TargetFun/TargetFun.hpp"
+#include "cpputil/Ptr.hpp"
+
+namespace BOOM {
+
+  // The No-U-Turn Sampler (Hoffman and Gelman, 2014, JMLR), a form of
+  // Hamiltonian Monte Carlo that chooses the length of each trajectory
+  // automatically.  Each draw simulates Hamiltonian dynamics with the
+  // leapfrog integrator, doubling the trajectory forward or backward in
+  // time until it starts to turn back on itself, then samples a point from
+  // the trajectory.
+  //
+  // The momentum has a N(0, M) distribution, where the mass matrix M can
+  // be diagonal or dense.  Setting M^{-1} to an estimate of the posterior
+  // variance removes most of the correlation between the parameters, which
+  // is where HMC has the largest advantage over random walk and slice
+  // samplers.
+  //
+  // The step size is tuned by dual averaging during an initial set of
+  // adaptation draws, targeting a given mean acceptance probability.  Draws
+  // made during adaptation do not leave the target distribution invariant,
+  // and should be discarded as burn-in.
+  class NoUTurnSampler : public Sampler {
+   public:
+    // Args:
+    //   logf: The log of the target density, which must be differentiable.
+    //   rng: The random number generator to use for the draws.  If nullptr
+    //     then GlobalRng::rng is used.
+    explicit NoUTurnSampler(const Ptr<dTargetFun> &logf, RNG *rng = nullptr);
+
+    Vector draw(const Vector &x) override;
+
+    // Set the step size for the leapfrog integrator.  If step size
+    // adaptation is still underway, the value is used to restart it.
+    void set_step_size(double step_size);
+    double step_size() const { return step_size_; }
+
+    // Tune the step size during the next 'number_of_draws' calls to draw().
+    //
+    // Args:
+    //   number_of_draws:  The number of draws used for adaptation.
+    //   target_acceptance_rate: The desired mean acceptance probability for
+    //     points in a trajectory.  Values between 0.6 and 0.9 work well.
+    void adapt_step_size(int number_of_draws,
+                         double target_acceptance_rate = 0.8);
+
+    // Set the mass matrix to a diagonal matrix.
+    //
+    // Args:
+    //   inverse_mass: The diagonal of the inverse mass matrix, e.g. the
+    //     posterior variances of the parameters.  All elements must be
+    //     positive.
+    void set_diagonal_inverse_mass(const Vector &inverse_mass);
+
+    // Set a dense mass matrix.
+    //
+    // Args:
+    //   inverse_mass: The inverse of the mass matrix, e.g. the posterior
+    //     variance of the parameters.
+    void set_inverse_mass(const SpdMatrix &inverse_mass);
+
+    // The maximum number of trajectory doublings in a single draw.  A
+    // trajectory has at most 2^max_tree_depth leapfrog steps.
+    void set_max_tree_depth(int depth);
+
+    // The number of leapfrog steps in the most recent draw.
+    int number_of_leapfrog_steps() const { return leapfrog_steps_; }
+
+    // The mean acceptance probability over the points visited in the most
+    // recent draw.
+    double acceptance_rate() const { return acceptance_rate_; }
+
+    // The number of draws whose trajectories were stopped by a numerical
+    // divergence: a jump in the energy large enough that the integrator
+    // has become unstable.
+    int number_of_divergences() const { return divergences_; }
+
+   private:
+    // A point in phase space, with the gradient of logf at its position.
+    struct PhasePoint {
+      Vector position;
+      Vector momentum;
+      Vector gradient;
+      double logp;
+    };
+
+    // A subtrajectory built by build_tree().
+    struct Tree {
+      PhasePoint minus;
+      PhasePoint plus;
+      PhasePoint proposal;
+      // The number of points in the tree inside the slice.
+      double number_in_slice;
+      // False if the tree made a U-turn or diverged.
+      bool ok;
+      double acceptance_sum;
+      int number_of_steps;
+    };
+
+    // Build a tree of 2^depth leapfrog steps starting from 'start' in the
+    // given direction (+1 or -1).
+    Tree build_tree(const PhasePoint &start, double log_slice, int direction,
+                    int depth, double initial_energy);
+
+    // Move 'point' one leapfrog step of size epsilon.
+    void leapfrog(PhasePoint &point, double epsilon) const;
+
+    // Returns true if the trajectory from minus to plus has not started to
+    // double back on itself.
+    bool no_u_turn(const PhasePoint &minus, const PhasePoint &plus) const;
+
+    double kinetic_energy(const Vector &momentum) const;
+    Vector inverse_mass_times(const Vector &momentum) const;
+    Vector draw_momentum();
+
+    // Find a step size for which a single leapfrog step from 'point' has
+    // an acceptance probability near 1/2.
+    void initialize_step_size(const PhasePoint &point);
+    void update_step_size(double acceptance_rate);
+
+    Ptr<dTargetFun> logf_;
+    double step_size_;
+    bool step_size_initialized_;
+    int max_tree_depth_;
+
+    // The inverse mass matrix is stored as a vector if it is diagonal.  If
+    // it is dense, mass_cholesky_ is the lower Cholesky factor of the mass
+    // matrix, used to draw momenta.
+    bool dense_mass_;
+    Vector inverse_mass_diagonal_;
+    SpdMatrix inverse_mass_;
+    Matrix mass_cholesky_;
+
+    // Dual averaging state.  See Hoffman and Gelman section 3.2.1.
+    int adaptation_draws_remaining_;
+    int adaptation_iteration_;
+    double target_acceptance_rate_;
+    double log_step_size_target_;
+    double log_step_size_average_;
+    double acceptance_gap_average_;
+
+    int leapfrog_steps_;
+    double acceptance_rate_;
+    int divergences_;
+    // Set if the draw in progress has hit a divergence.
+    bool divergent_;
+  };
+
+}  // namespace BOOM
+
+#endif  // BOOM_SAMPLERS_NO_U_TURN_SAMPLER_HPP_
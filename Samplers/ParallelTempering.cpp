@@ -0,0 +1,159 @@
+/*
+  Copyright (C) 2005-2024 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#include "Samplers/ParallelTempering.hpp"
+#include <algorithm>
+#include <cmath>
+#include "cpputil/report_error.hpp"
+#include "distributions.hpp"
+
+namespace BOOM {
+
+  namespace {
+    // The step size for ladder adaptation at step n is (n + 1)^(-kDecay).
+    const double kDecay = 0.6;
+  }  // namespace
+
+  ParallelTemperingSampler::ParallelTemperingSampler(
+      const std::vector<Ptr<TemperedReplica>> &replicas,
+      const Vector &inverse_temperatures)
+      : replicas_(replicas),
+        inverse_temperatures_(inverse_temperatures),
+        log_likelihoods_(replicas.size(), 0.0),
+        swaps_proposed_(replicas.size(), 0),
+        swaps_accepted_(replicas.size(), 0),
+        iteration_(0),
+        adapt_(true),
+        target_swap_rate_(0.234),
+        adaptation_steps_(0) {
+    const int nrungs = replicas_.size();
+    if (nrungs < 2) {
+      report_error("ParallelTemperingSampler needs at least two replicas.");
+    }
+    for (const auto &replica : replicas_) {
+      if (!replica) {
+        report_error("ParallelTemperingSampler was given a null replica.");
+      }
+    }
+    if (inverse_temperatures_.empty()) {
+      inverse_temperatures_ = geometric_ladder(nrungs, std::pow(2.0, nrungs));
+    }
+    if (inverse_temperatures_.size() != nrungs) {
+      report_error("There must be one inverse temperature per replica.");
+    }
+    if (inverse_temperatures_[0] != 1.0) {
+      report_error("The first inverse temperature must be 1.");
+    }
+    for (int k = 1; k < nrungs; ++k) {
+      if (inverse_temperatures_[k] <= 0 ||
+          inverse_temperatures_[k] >= inverse_temperatures_[k - 1]) {
+        report_error("Inverse temperatures must be positive and strictly "
+                     "decreasing.");
+      }
+    }
+    for (int k = 0; k < nrungs; ++k) {
+      replica_at_rung_.push_back(k);
+    }
+  }
+
+  Vector ParallelTemperingSampler::geometric_ladder(int number_of_rungs,
+                                                    double max_temperature) {
+    if (number_of_rungs < 1 || max_temperature < 1) {
+      report_error("A temperature ladder needs at least one rung and a "
+                   "maximum temperature of at least 1.");
+    }
+    Vector ans(number_of_rungs, 1.0);
+    if (number_of_rungs == 1) return ans;
+    const double log_ratio = -std::log(max_temperature) / (number_of_rungs - 1);
+    for (int k = 1; k < number_of_rungs; ++k) {
+      ans[k] = std::exp(k * log_ratio);
+    }
+    return ans;
+  }
+
+  void ParallelTemperingSampler::set_target_swap_rate(double rate) {
+    if (rate <= 0 || rate >= 1) {
+      report_error("The target swap rate must be between 0 and 1.");
+    }
+    target_swap_rate_ = rate;
+  }
+
+  void ParallelTemperingSampler::draw(RNG &rng) {
+    const int nrungs = number_of_rungs();
+    // Replica streams are seeded by rung, so the output for a given seed
+    // does not depend on the number of threads.
+    RNG::RngIntType seed = seed_rng(rng);
+    pool_.parallel_for(0, nrungs, 1, [&](int rung) {
+      RNG replica_rng(seed, rung);
+      const int r = replica_at_rung_[rung];
+      replicas_[r]->draw(replica_rng, inverse_temperatures_[rung]);
+      log_likelihoods_[r] = replicas_[r]->log_likelihood();
+    });
+    propose_swaps(rng);
+    ++iteration_;
+  }
+
+  void ParallelTemperingSampler::propose_swaps(RNG &rng) {
+    for (int k = iteration_ % 2; k + 1 < number_of_rungs(); k += 2) {
+      int &colder = replica_at_rung_[k];
+      int &hotter = replica_at_rung_[k + 1];
+      const double log_alpha =
+          (inverse_temperatures_[k] - inverse_temperatures_[k + 1]) *
+          (log_likelihoods_[hotter] - log_likelihoods_[colder]);
+      const double acceptance_probability =
+          log_alpha >= 0 ? 1.0 : std::exp(log_alpha);
+      ++swaps_proposed_[k];
+      if (runif_mt(rng) < acceptance_probability) {
+        std::swap(colder, hotter);
+        ++swaps_accepted_[k];
+      }
+      if (adapt_) {
+        adapt_ladder(k, acceptance_probability);
+      }
+    }
+  }
+
+  // The log of the gap between temperatures k and k+1 moves up when swaps
+  // are accepted too often, and down when they are accepted too rarely.  All
+  // hotter rungs shift with it, which keeps the ladder ordered.
+  void ParallelTemperingSampler::adapt_ladder(int rung,
+                                              double acceptance_probability) {
+    const double step = std::pow(adaptation_steps_ + 1.0, -kDecay);
+    ++adaptation_steps_;
+    const double colder_temperature = 1.0 / inverse_temperatures_[rung];
+    const double hotter_temperature = 1.0 / inverse_temperatures_[rung + 1];
+    const double gap = hotter_temperature - colder_temperature;
+    const double new_gap =
+        gap * std::exp(step * (acceptance_probability - target_swap_rate_));
+    const double shift = new_gap - gap;
+    for (int k = rung + 1; k < number_of_rungs(); ++k) {
+      inverse_temperatures_[k] = 1.0 / (1.0 / inverse_temperatures_[k] + shift);
+    }
+  }
+
+  Vector ParallelTemperingSampler::swap_acceptance_rates() const {
+    Vector ans(number_of_rungs() - 1, 0.0);
+    for (int k = 0; k < ans.size(); ++k) {
+      if (swaps_proposed_[k] > 0) {
+        ans[k] = swaps_accepted_[k] / static_cast<double>(swaps_proposed_[k]);
+      }
+    }
+    return ans;
+  }
+
+}  // namespace BOOM
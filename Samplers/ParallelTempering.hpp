@@ -0,0 +1,155 @@
+/*
+  Copyright (C) 2005-2024 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#ifndef BOOM_SAMPLERS_PARALLEL_TEMPERING_HPP_
+#define BOOM_SAMPLERS_PARALLEL_TEMPERING_HPP_
+
+#include <vector>
+#include "LinAlg/Vector.hpp"
+#include "cpputil/Ptr.hpp"
+#include "cpputil/RefCounted.hpp"
+#include "cpputil/ThreadTools.hpp"
+#include "distributions/rng.hpp"
+
+namespace BOOM {
+
+  // One chain in a parallel tempering run: typically a model with its own
+  // copy of the data and a posterior sampler.  The replica must be able to
+  // sample from the tempered posterior
+  //
+  //     p(theta) * p(y | theta)^inverse_temperature,
+  //
+  // which for most samplers means raising the complete data sufficient
+  // statistics (or the log likelihood in an MH ratio) to the given power.
+  //
+  // Different replicas are updated concurrently, so they must not share
+  // mutable state.
+  class TemperedReplica : private RefCounted {
+   public:
+    virtual ~TemperedReplica() {}
+
+    // Do one MCMC update of the replica's parameters, targeting the
+    // tempered posterior above.
+    //
+    // Args:
+    //   rng:  The random number generator to use for the update.
+    //   inverse_temperature:  The power applied to the likelihood, in (0, 1].
+    virtual void draw(RNG &rng, double inverse_temperature) = 0;
+
+    // The (untempered) log likelihood at the replica's current parameters.
+    virtual double log_likelihood() const = 0;
+
+    friend void intrusive_ptr_add_ref(TemperedReplica *r) { r->up_count(); }
+    friend void intrusive_ptr_release(TemperedReplica *r) {
+      r->down_count();
+      if (r->ref_count() == 0) delete r;
+    }
+  };
+
+  //===========================================================================
+  // Runs a set of replicas at a ladder of temperatures, and proposes swaps
+  // between adjacent temperatures so that the hot chains, which move freely
+  // between modes, can pass their states down to the cold chain.
+  //
+  // Rather than copying parameters between replicas, a swap exchanges the
+  // temperatures of the two replicas involved.  The replica currently at
+  // inverse temperature 1 (the cold_replica()) holds the draw from the
+  // posterior.
+  //
+  // Each call to draw() updates every replica, in parallel on the thread
+  // pool, and then proposes swaps between adjacent rungs, alternating
+  // between even and odd pairs.  While adaptation is on, the spacing of the
+  // ladder is adjusted after each swap proposal using the stochastic
+  // approximation scheme of Miasojedow, Moulines, and Vihola (2013), so that
+  // each adjacent pair swaps at the target rate.  Adaptation should be
+  // turned off after burn-in to leave a valid Markov chain.
+  class ParallelTemperingSampler {
+   public:
+    // Args:
+    //   replicas: The chains to be run, one per rung of the temperature
+    //     ladder.  At least two are needed.
+    //   inverse_temperatures: A decreasing sequence of values in (0, 1],
+    //     starting with 1, one per replica.  If empty, a geometric ladder
+    //     with a maximum temperature of 2^(number of replicas) is used.
+    explicit ParallelTemperingSampler(
+        const std::vector<Ptr<TemperedReplica>> &replicas,
+        const Vector &inverse_temperatures = Vector());
+
+    // A geometric ladder of inverse temperatures, running from 1 down to
+    // 1 / max_temperature.
+    static Vector geometric_ladder(int number_of_rungs, double max_temperature);
+
+    // Update each replica at its current temperature, then propose swaps.
+    void draw(RNG &rng);
+
+    void set_number_of_threads(int nthreads) {
+      pool_.set_number_of_threads(nthreads);
+    }
+
+    // Turn ladder adaptation on or off.  Adaptation is on by default.
+    void set_adaptation(bool adapt) { adapt_ = adapt; }
+    bool adapting() const { return adapt_; }
+
+    // The swap acceptance rate the ladder adaptation aims for.  The default
+    // is 0.234.
+    void set_target_swap_rate(double rate);
+
+    int number_of_rungs() const { return replicas_.size(); }
+    const Vector &inverse_temperatures() const { return inverse_temperatures_; }
+
+    // The replica currently running at the given rung of the ladder.  Rung 0
+    // has inverse temperature 1.
+    const Ptr<TemperedReplica> &replica_at_rung(int rung) const {
+      return replicas_[replica_at_rung_[rung]];
+    }
+    const Ptr<TemperedReplica> &cold_replica() const {
+      return replica_at_rung(0);
+    }
+
+    // Element k is the fraction of proposed swaps between rungs k and k+1
+    // that were accepted.
+    Vector swap_acceptance_rates() const;
+
+   private:
+    void propose_swaps(RNG &rng);
+    void adapt_ladder(int rung, double acceptance_probability);
+
+    std::vector<Ptr<TemperedReplica>> replicas_;
+    Vector inverse_temperatures_;
+
+    // replica_at_rung_[k] is the index (in replicas_) of the replica
+    // running at inverse_temperatures_[k].
+    std::vector<int> replica_at_rung_;
+
+    // Log likelihoods of the replicas, indexed as replicas_.
+    Vector log_likelihoods_;
+
+    std::vector<int> swaps_proposed_;
+    std::vector<int> swaps_accepted_;
+    int iteration_;
+
+    bool adapt_;
+    double target_swap_rate_;
+    int adaptation_steps_;
+
+    SharedThreadPool pool_;
+  };
+
+}  // namespace BOOM
+
+#endif  // BOOM_SAMPLERS_PARALLEL_TEMPERING_HPP_
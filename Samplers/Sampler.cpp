@@ -17,6 +17,7 @@
   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
 */
 #include "Samplers/Sampler.hpp"
+#include "cpputil/report_error.hpp"
 
 namespace BOOM {
 
@@ -45,6 +46,24 @@ namespace BOOM {
     }
   }
 
+  void SamplerBase::write_checkpoint(CheckpointWriter &out) const {
+    out.write(owns_rng_);
+    if (owns_rng_) {
+      rng_->write_checkpoint(out);
+    }
+  }
+
+  void SamplerBase::read_checkpoint(CheckpointReader &in) {
+    bool owned = in.read_bool();
+    if (owned != owns_rng_) {
+      report_error("Checkpoint does not match the RNG ownership of this "
+                   "sampler.");
+    }
+    if (owns_rng_) {
+      rng_->read_checkpoint(in);
+    }
+  }
+
   void SamplerBase::set_seed(unsigned long s) {
     if (rng_) {
       rng_->seed(s);
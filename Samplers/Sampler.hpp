@@ -20,6 +20,7 @@
 #define BOOM_SAMPLERS_HPP
 
 #include "LinAlg/Vector.hpp"
+#include "cpputil/Checkpoint.hpp"
 #include "cpputil/RefCounted.hpp"
 #include "distributions/rng.hpp"
 
@@ -49,6 +50,15 @@ namespace BOOM {
     }
     void set_rng(RNG *r, bool owns_rng = true);
 
+    // Save or restore any state that the sampler carries from one draw to
+    // the next, such as an adaptive step size.  The default implementation
+    // handles the RNG if the sampler owns it.  An RNG owned by someone else
+    // (typically a PosteriorSampler) is checkpointed by its owner.  Child
+    // classes with adaptive state should override these functions and
+    // call the base class versions.
+    virtual void write_checkpoint(CheckpointWriter &out) const;
+    virtual void read_checkpoint(CheckpointReader &in);
+
    private:
     mutable RNG *rng_;
     bool owns_rng_;
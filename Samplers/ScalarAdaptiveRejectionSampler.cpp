@@ -27,7 +27,15 @@ namespace BOOM {
 
   ScalarAdaptiveRejectionSampler::ScalarAdaptiveRejectionSampler(
       const std::function<double(double)> &logf)
-      : log_density_(logf) {}
+      : log_density_(logf),
+        approximation_is_stale_(false),
+        max_retained_knots_(6) {}
+
+  void ScalarAdaptiveRejectionSampler::set_log_density(
+      const std::function<double(double)> &log_density) {
+    log_density_ = log_density;
+    approximation_is_stale_ = true;
+  }
 
   void ScalarAdaptiveRejectionSampler::add_point(double x) {
     if (x < log_density_approximation_.lower_limit() ||
@@ -38,6 +46,10 @@ namespace BOOM {
   }
 
   double ScalarAdaptiveRejectionSampler::draw() {
+    if (approximation_is_stale_) {
+      log_density_approximation_.refresh(log_density_, max_retained_knots_);
+      approximation_is_stale_ = false;
+    }
     ensure_approximation_is_initialized();
     double candidate = log_density_approximation_.sample(rng());
 
@@ -190,6 +202,61 @@ namespace BOOM {
       update_region_probabilities(position_of_new_knot);
     }
 
+    void PEA::refresh(const std::function<double(double)> &logf,
+                      int max_knots) {
+      // Choose the knots to keep, spread evenly (by rank) over the current
+      // knots, always including the extremes.
+      Vector candidates;
+      int nknots = knots_.size();
+      if (max_knots < 2) max_knots = 2;
+      if (nknots <= max_knots) {
+        candidates = knots_;
+      } else {
+        for (int j = 0; j < max_knots; ++j) {
+          candidates.push_back(
+              knots_[lround(j * (nknots - 1.0) / (max_knots - 1.0))]);
+        }
+      }
+
+      Vector knots;
+      Vector values;
+      knots.reserve(candidates.size());
+      values.reserve(candidates.size());
+      for (int i = 0; i < candidates.size(); ++i) {
+        double x = candidates[i];
+        double y = logf(x);
+        if (!std::isfinite(y)) continue;
+        // The secant slopes of a concave function decrease from left to
+        // right.  A retained knot that sits below the secant joining its
+        // neighbors violates concavity, so it is dropped.
+        while (knots.size() >= 2) {
+          int n = knots.size();
+          double left_slope =
+              (values[n - 1] - values[n - 2]) / (knots[n - 1] - knots[n - 2]);
+          double right_slope = (y - values[n - 1]) / (x - knots[n - 1]);
+          if (right_slope <= left_slope) break;
+          knots.pop_back();
+          values.pop_back();
+        }
+        knots.push_back(x);
+        values.push_back(y);
+      }
+      knots_ = knots;
+      logf_ = values;
+      if (knots_.size() < 3) {
+        log_region_probability_.clear();
+      } else {
+        log_region_probability_.resize(knots_.size() + 1);
+        recompute_region_probabilities();
+      }
+    }
+
+    void PEA::clear() {
+      knots_.clear();
+      logf_.clear();
+      log_region_probability_.clear();
+    }
+
     // Args:
     //   position_of_new_knot: Index of the new knot location, in the
     //     "old" vector of knots.
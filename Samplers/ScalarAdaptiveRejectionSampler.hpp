@@ -55,6 +55,20 @@ namespace BOOM {
       // (lower_limit, upper_limit).
       void add_point(double x, double log_f_of_x);
 
+      // Re-evaluate the approximation at its existing knots under a new (or
+      // modified) log density, so the knots learned for one target can be
+      // reused for a nearby one.  Knots where logf is not finite, or which
+      // would make the piecewise linear interpolant non-concave, are
+      // dropped.  If fewer than three knots survive the approximation must
+      // be rebuilt by adding points before it can be sampled.
+      //
+      // Each retained knot costs one evaluation of logf, so at most
+      // 'max_knots' knots (spread over the current set) are kept.
+      void refresh(const std::function<double(double)> &logf, int max_knots);
+
+      // Remove all the knots.  The limits are retained.
+      void clear();
+
       // Return the lower bound for logf.  The lower bound is the
       // linear interpolation between the first knot less than x and
       // the first knot greater than x.  If x is less than the first
@@ -220,6 +234,35 @@ namespace BOOM {
     // Adds the point x to the approximate density.
     void add_point(double x);
 
+    // Replace the target distribution with one having the given log density.
+    // The knots of the current approximation are kept, and re-evaluated
+    // under the new log density when draw() is next called.  When the
+    // target changes slowly (e.g. a full conditional distribution in a Gibbs
+    // sampler) the retained knots usually give a tight envelope, so few
+    // extra log density evaluations are needed to adapt it.
+    void set_log_density(const std::function<double(double)> &log_density);
+
+    // Signal that the target has changed without replacing the log density
+    // function, e.g. because the function reads model parameters that have
+    // since been updated.  The approximation is refreshed lazily, as with
+    // set_log_density().
+    void log_density_changed() { approximation_is_stale_ = true; }
+
+    // When the approximation is refreshed, at most this many of its knots
+    // are re-evaluated and kept.  Each retained knot costs one evaluation of
+    // the log density, but gives a tighter initial envelope.  The default
+    // is 6.
+    void set_max_retained_knots(int max_knots) {
+      max_retained_knots_ = max_knots;
+    }
+
+    // Discard the approximation, so that it is rebuilt from scratch at the
+    // next call to draw().
+    void clear_approximation() {
+      log_density_approximation_.clear();
+      approximation_is_stale_ = false;
+    }
+
     double draw();
     double draw(double) override { return draw(); }  // ignore argument
 
@@ -240,6 +283,14 @@ namespace BOOM {
 
     std::function<double(double)> log_density_;
     ARS::PiecewiseExponentialApproximation log_density_approximation_;
+
+    // True if the knots of log_density_approximation_ must be re-evaluated
+    // before the next draw.
+    bool approximation_is_stale_;
+
+    // The largest number of knots re-evaluated when the approximation is
+    // refreshed.
+    int max_retained_knots_;
   };
 
 }  // namespace BOOM
@@ -42,6 +42,18 @@ namespace BOOM {
         estimate_dx_(true) {}
 
   void SSS::set_suggested_dx(double dx) { suggested_dx_ = dx; }
+
+  void SSS::write_checkpoint(CheckpointWriter &out) const {
+    out.begin_section("ScalarSliceSampler");
+    ScalarSampler::write_checkpoint(out);
+    out.write(suggested_dx_);
+  }
+
+  void SSS::read_checkpoint(CheckpointReader &in) {
+    in.expect_section("ScalarSliceSampler");
+    ScalarSampler::read_checkpoint(in);
+    suggested_dx_ = in.read_double();
+  }
   void SSS::set_min_dx(double dx) { min_dx_ = dx; }
   void SSS::estimate_dx(bool yn) { estimate_dx_ = yn; }
 
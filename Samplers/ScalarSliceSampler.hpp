@@ -39,6 +39,8 @@ namespace BOOM {
     void estimate_dx(bool should_dx_be_estimated);
     void set_min_dx(double dx);
     double draw(double x) override;
+    void write_checkpoint(CheckpointWriter &out) const override;
+    void read_checkpoint(CheckpointReader &in) override;
     virtual double logp(double x) const;
 
    private:
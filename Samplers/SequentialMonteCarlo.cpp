@@ -0,0 +1,190 @@
+// Copyright 2018 Google LLC. All Rights Reserved.
+/*
+  Copyright (C) 2005-2018 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#include "Samplers/SequentialMonteCarlo.hpp"
+#include <algorithm>
+#include <cmath>
+#include "cpputil/lse.hpp"
+#include "cpputil/report_error.hpp"
+
+namespace BOOM {
+
+  namespace {
+    // The number of particles propagated by each worker task.  Fixing the
+    // shard size (rather than deriving it from the number of threads) keeps
+    // the random number streams, and hence the output, independent of the
+    // number of threads.
+    const int particle_shard_size = 256;
+  }  // namespace
+
+  void SmcModel::simulate_initial_state(RNG &, VectorView) const {
+    report_error("This model has no initial state distribution.  "
+                 "Supply the particles with set_particles().");
+  }
+
+  SequentialMonteCarloFilter::SequentialMonteCarloFilter(
+      const Ptr<SmcModel> &model, double resampling_threshold,
+      ResamplingMethod method)
+      : model_(model),
+        resampling_threshold_(0.5),
+        method_(method),
+        time_(-1),
+        log_predictive_density_(0.0),
+        resampling_events_(0) {
+    if (!model_) {
+      report_error("SequentialMonteCarloFilter needs a non-null model.");
+    }
+    set_resampling_threshold(resampling_threshold);
+  }
+
+  void SequentialMonteCarloFilter::set_resampling_threshold(double threshold) {
+    if (threshold < 0 || threshold > 1) {
+      report_error("The resampling threshold must be between 0 and 1.");
+    }
+    resampling_threshold_ = threshold;
+  }
+
+  void SequentialMonteCarloFilter::initialize(RNG &rng,
+                                              int number_of_particles) {
+    if (number_of_particles <= 0) {
+      report_error("number_of_particles must be positive.");
+    }
+    states_.resize(number_of_particles, model_->state_dimension());
+    for (int i = 0; i < number_of_particles; ++i) {
+      model_->simulate_initial_state(rng, states_.row(i));
+    }
+    log_weights_.resize(number_of_particles);
+    log_weights_ = 0.0;
+    time_ = -1;
+    log_predictive_density_ = 0.0;
+    resampling_events_ = 0;
+  }
+
+  void SequentialMonteCarloFilter::set_particles(const Matrix &states,
+                                                 int time,
+                                                 const Vector &log_weights) {
+    if (states.nrow() == 0 || states.ncol() != model_->state_dimension()) {
+      report_error("The particle matrix must have one column per state "
+                   "element, and at least one row.");
+    }
+    if (!log_weights.empty() && log_weights.size() != states.nrow()) {
+      report_error("There must be one log weight per particle.");
+    }
+    states_ = states;
+    if (log_weights.empty()) {
+      log_weights_.resize(states.nrow());
+      log_weights_ = 0.0;
+    } else {
+      log_weights_ = log_weights;
+    }
+    time_ = time;
+    log_predictive_density_ = 0.0;
+    resampling_events_ = 0;
+  }
+
+  double SequentialMonteCarloFilter::update(RNG &rng) {
+    int N = number_of_particles();
+    if (N == 0) {
+      report_error("Call initialize() or set_particles() before update().");
+    }
+    int t = time_ + 1;
+    // Particles from initialize() are already at time 0.
+    bool transition = t > 0;
+    if (transition) {
+      workspace_.resize(N, states_.ncol());
+    }
+    double previous_lse = lse(log_weights_);
+
+    int nshards = (N + particle_shard_size - 1) / particle_shard_size;
+    if (nshards == 1) {
+      propagate(0, N, t, transition, rng);
+    } else {
+      RNG::RngIntType seed = seed_rng(rng);
+      pool_.parallel_for(0, nshards, 1, [&](int shard) {
+        RNG shard_rng(seed, shard);
+        int begin = shard * particle_shard_size;
+        int end = std::min<int>(begin + particle_shard_size, N);
+        propagate(begin, end, t, transition, shard_rng);
+      });
+    }
+    if (transition) {
+      std::swap(states_, workspace_);
+    }
+    time_ = t;
+
+    double increment = lse(log_weights_) - previous_lse;
+    if (!std::isfinite(increment)) {
+      report_error("Every particle has zero weight.  The observation may be "
+                   "inconsistent with the model.");
+    }
+    log_predictive_density_ += increment;
+    if (effective_sample_size() < resampling_threshold_ * N) {
+      resample(rng);
+    }
+    return increment;
+  }
+
+  void SequentialMonteCarloFilter::propagate(int begin, int end, int t,
+                                             bool transition, RNG &rng) {
+    const Matrix &states(states_);
+    for (int i = begin; i < end; ++i) {
+      if (transition) {
+        VectorView next(workspace_.row(i));
+        model_->simulate_transition(rng, states.row(i), next, t);
+        log_weights_[i] += model_->log_observation_density(next, t);
+      } else {
+        log_weights_[i] += model_->log_observation_density(states.row(i), t);
+      }
+    }
+  }
+
+  void SequentialMonteCarloFilter::resample(RNG &rng) {
+    int N = number_of_particles();
+    std::vector<int> index =
+        resample_indices(rng, particle_weights(), N, method_);
+    workspace_.resize(N, states_.ncol());
+    // Columns are contiguous, so gather one state element at a time.
+    for (int j = 0; j < states_.ncol(); ++j) {
+      auto source = states_.col_begin(j);
+      auto destination = workspace_.col_begin(j);
+      for (int i = 0; i < N; ++i) {
+        destination[i] = source[index[i]];
+      }
+    }
+    std::swap(states_, workspace_);
+    log_weights_ = 0.0;
+    ++resampling_events_;
+  }
+
+  Vector SequentialMonteCarloFilter::particle_weights() const {
+    Vector ans(log_weights_);
+    ans.normalize_logprob();
+    return ans;
+  }
+
+  double SequentialMonteCarloFilter::effective_sample_size() const {
+    Vector weights = particle_weights();
+    return 1.0 / weights.normsq();
+  }
+
+  Vector SequentialMonteCarloFilter::state_mean() const {
+    return particle_weights() * states_;
+  }
+
+}  // namespace BOOM
@@ -0,0 +1,189 @@
+// Copyright 2018 Google LLC. All Rights Reserved.
+/*
+  Copyright (C) 2005-2018 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#ifndef BOOM_SAMPLERS_SEQUENTIAL_MONTE_CARLO_HPP_
+#define BOOM_SAMPLERS_SEQUENTIAL_MONTE_CARLO_HPP_
+
+#include "LinAlg/Matrix.hpp"
+#include "LinAlg/Vector.hpp"
+#include "LinAlg/VectorView.hpp"
+#include "Samplers/ImportanceResampler.hpp"
+#include "cpputil/Ptr.hpp"
+#include "cpputil/RefCounted.hpp"
+#include "cpputil/ThreadTools.hpp"
+#include "distributions/rng.hpp"
+
+namespace BOOM {
+
+  // The model-specific half of a bootstrap particle filter: a Markov state
+  // process and the density of the observation at each time given the
+  // state.  Model parameters are held fixed by the implementation.
+  //
+  // The member functions are called concurrently from several threads when
+  // the filter is multi-threaded, so they must not modify shared state.
+  class SmcModel : private RefCounted {
+   public:
+    virtual ~SmcModel() {}
+
+    // The dimension of the latent state at a single time point.
+    virtual int state_dimension() const = 0;
+
+    // Simulate the state at time 0 from its prior distribution.  The default
+    // implementation reports an error, in which case the particles must be
+    // supplied with SequentialMonteCarloFilter::set_particles().
+    virtual void simulate_initial_state(RNG &rng, VectorView state) const;
+
+    // Simulate the state at time t given the state at time t-1.
+    //
+    // Args:
+    //   rng:  The random number generator to use for the simulation.
+    //   previous_state:  The state at time t-1.
+    //   next_state:  On output, a draw of the state at time t.
+    //   t:  The time index of next_state.
+    virtual void simulate_transition(RNG &rng,
+                                     const ConstVectorView &previous_state,
+                                     VectorView next_state, int t) const = 0;
+
+    // The log density of the observation at time t given state.  Missing
+    // observations contribute 0.
+    virtual double log_observation_density(const ConstVectorView &state,
+                                           int t) const = 0;
+
+    friend void intrusive_ptr_add_ref(SmcModel *m) { m->up_count(); }
+    friend void intrusive_ptr_release(SmcModel *m) {
+      m->down_count();
+      if (m->ref_count() == 0) delete m;
+    }
+  };
+
+  //===========================================================================
+  // A bootstrap particle filter with adaptive resampling.
+  //
+  // The particle states are stored as a structure of arrays: an
+  // (number_of_particles x state_dimension) matrix whose columns (one per
+  // state element) are contiguous, so resampling and moment calculations
+  // stream through memory.  Each call to update() moves the particles forward
+  // one time period by simulating from the transition distribution, weights
+  // them by the observation density, and resamples when the effective sample
+  // size drops below a fraction of the number of particles.
+  //
+  // Particles are propagated in fixed-size shards, each with its own random
+  // number stream seeded from the caller's RNG, so the output for a given
+  // seed does not depend on the number of threads.
+  class SequentialMonteCarloFilter {
+   public:
+    // Args:
+    //   model:  The model to be filtered.
+    //   resampling_threshold: The particles are resampled when the effective
+    //     sample size drops below resampling_threshold *
+    //     number_of_particles().  A value of 1 resamples at every step, and a
+    //     value of 0 never resamples.
+    //   method:  The resampling scheme.
+    explicit SequentialMonteCarloFilter(
+        const Ptr<SmcModel> &model, double resampling_threshold = 0.5,
+        ResamplingMethod method = ResamplingMethod::SYSTEMATIC);
+
+    // Draw number_of_particles equally weighted particles from the model's
+    // initial state distribution.  The first call to update() weights them
+    // by the observation at time 0.
+    void initialize(RNG &rng, int number_of_particles);
+
+    // Set the particle ensemble, e.g. from the final state draws of an MCMC
+    // run.
+    //
+    // Args:
+    //   states: A (number_of_particles x state_dimension) matrix of particle
+    //     states at time 'time'.
+    //   time: The time index of the states.  The next call to update() moves
+    //     the particles to time + 1.
+    //   log_weights: Unnormalized log weights for the particles.  If empty
+    //     the particles are equally weighted.
+    void set_particles(const Matrix &states, int time,
+                       const Vector &log_weights = Vector());
+
+    // Absorb the observation at time time() + 1.
+    //
+    // Returns:
+    //   The log predictive density of the new observation given the
+    //   observations that came before it.
+    double update(RNG &rng);
+
+    // Resample the particles and reset their weights, regardless of the
+    // effective sample size.
+    void resample(RNG &rng);
+
+    void set_number_of_threads(int nthreads) {
+      pool_.set_number_of_threads(nthreads);
+    }
+
+    void set_resampling_method(ResamplingMethod method) { method_ = method; }
+    void set_resampling_threshold(double threshold);
+
+    int number_of_particles() const { return states_.nrow(); }
+    int state_dimension() const { return model_->state_dimension(); }
+
+    // The time index of the most recent observation absorbed into the
+    // particles.  Before the first update() after initialize() this is -1.
+    int time() const { return time_; }
+
+    // Particle states, one particle per row.  These are weighted samples,
+    // to be interpreted in light of particle_weights().
+    const Matrix &particle_states() const { return states_; }
+    const Vector &log_weights() const { return log_weights_; }
+
+    // The normalized particle weights.
+    Vector particle_weights() const;
+
+    // The effective number of particles implied by the particle weights:
+    // 1 / sum(w^2) for normalized weights w.
+    double effective_sample_size() const;
+
+    // The weighted mean of the particle states.
+    Vector state_mean() const;
+
+    // The sum over calls to update() of the log predictive density of each
+    // new observation.
+    double log_predictive_density() const { return log_predictive_density_; }
+
+    // The number of times the particles have been resampled.
+    int number_of_resampling_events() const { return resampling_events_; }
+
+   private:
+    // Move the particles in [begin, end) to time t (if 'transition' is
+    // true), and add the observation density at time t to their log
+    // weights.
+    void propagate(int begin, int end, int t, bool transition, RNG &rng);
+
+    Ptr<SmcModel> model_;
+    double resampling_threshold_;
+    ResamplingMethod method_;
+
+    Matrix states_;
+    Matrix workspace_;
+    Vector log_weights_;
+    int time_;
+    double log_predictive_density_;
+    int resampling_events_;
+
+    SharedThreadPool pool_;
+  };
+
+}  // namespace BOOM
+
+#endif  // BOOM_SAMPLERS_SEQUENTIAL_MONTE_CARLO_HPP_
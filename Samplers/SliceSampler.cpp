@@ -77,7 +77,7 @@ namespace BOOM {
   void SliceSampler::set_random_direction() {
     random_direction_.resize(last_position_.size());
     for (uint i = 0; i < random_direction_.size(); ++i) {
-      random_direction_[i] = scale_ * rnorm();
+      random_direction_[i] = scale_ * rnorm_mt(rng());
     }
   }
 
@@ -146,6 +146,18 @@ namespace BOOM {
     }
   }
 
+  void SliceSampler::write_checkpoint(CheckpointWriter &out) const {
+    out.begin_section("SliceSampler");
+    Sampler::write_checkpoint(out);
+    out.write(scale_);
+  }
+
+  void SliceSampler::read_checkpoint(CheckpointReader &in) {
+    in.expect_section("SliceSampler");
+    Sampler::read_checkpoint(in);
+    scale_ = in.read_double();
+  }
+
   Vector SliceSampler::draw(const Vector &theta) {
     last_position_ = theta;
     initialize();
@@ -31,6 +31,8 @@ namespace BOOM {
    public:
     explicit SliceSampler(const Func &log_density, bool unimodal = false);
     Vector draw(const Vector &x) override;
+    void write_checkpoint(CheckpointWriter &out) const override;
+    void read_checkpoint(CheckpointReader &in) override;
 
    private:
     // lo and hi, last_position_, and random_direction_ define slice boundaries.
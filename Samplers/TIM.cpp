@@ -35,7 +35,11 @@ namespace BOOM {
         dummy_gradient_(0),
         dummy_Hessian_(0, 0),
         mode_is_fixed_(0),
-        mode_has_been_found_(0) {}
+        mode_has_been_found_(0),
+        cache_acceptance_threshold_(0.0),
+        cache_window_(20),
+        recent_acceptance_rate_(1.0),
+        number_of_mode_searches_(0) {}
 
   inline double TIM_empty_target(const Vector &) { return 1.0; }
 
@@ -50,7 +54,11 @@ namespace BOOM {
         dummy_gradient_(0),
         dummy_Hessian_(0, 0),
         mode_is_fixed_(0),
-        mode_has_been_found_(0) {
+        mode_has_been_found_(0),
+        cache_acceptance_threshold_(0.0),
+        cache_window_(20),
+        recent_acceptance_rate_(1.0),
+        number_of_mode_searches_(0) {
     f_ = [logf, this](const Vector &x) {
       return logf(x, this->dummy_gradient_, this->dummy_Hessian_, 0);
     };
@@ -66,13 +74,31 @@ namespace BOOM {
 
   Vector TIM::draw(const Vector &old) {
     check_proposal(old.size());
-    if (!mode_has_been_found_ || !mode_is_fixed_) {
-      bool ok = locate_mode(old);
+    bool caching = cache_acceptance_threshold_ > 0;
+    if (!mode_has_been_found_ ||
+        (!mode_is_fixed_ &&
+         (!caching ||
+          recent_acceptance_rate_ < cache_acceptance_threshold_))) {
+      bool ok = false;
+      if (caching && mode_has_been_found_ && mode().size() == old.size()) {
+        ok = locate_mode(mode());
+      }
+      if (!ok) {
+        ok = locate_mode(old);
+      }
       if (!ok) {
         report_failure(old);
       }
+      ++number_of_mode_searches_;
+      recent_acceptance_rate_ = 1.0;
+    }
+    Vector ans = MetropolisHastings::draw(old);
+    if (caching) {
+      double accepted = last_draw_was_accepted() ? 1.0 : 0.0;
+      recent_acceptance_rate_ +=
+          (accepted - recent_acceptance_rate_) / cache_window_;
     }
-    return MetropolisHastings::draw(old);
+    return ans;
   }
 
   void TIM::report_failure(const Vector &old) {
@@ -92,6 +118,15 @@ namespace BOOM {
 
   void TIM::fix_mode(bool yn) { mode_is_fixed_ = yn; }
 
+  void TIM::cache_mode(double acceptance_threshold, int window) {
+    if (window < 1) {
+      report_error("The window for TIM mode caching must be at least 1.");
+    }
+    cache_acceptance_threshold_ = acceptance_threshold;
+    cache_window_ = window;
+    recent_acceptance_rate_ = 1.0;
+  }
+
   bool TIM::locate_mode(const Vector &old) {
     cand_ = old;
     Vector gradient = old;
@@ -66,6 +66,28 @@ namespace BOOM {
     // turn mode location back off again use fix_mode(false).
     void fix_mode(bool yn = true);
 
+    // When the mode is not fixed, locating it on every draw costs several
+    // passes over the data for a typical log posterior.  If the target
+    // changes slowly from one draw to the next (e.g. because it depends on
+    // latent data or other parameters in a Gibbs sampler) the previous
+    // modal approximation is often still a good proposal.
+    //
+    // After a call to cache_mode(), the most recent mode and Hessian are
+    // reused as the proposal as long as the recent acceptance rate stays
+    // at or above 'acceptance_threshold'.  When it drops below the
+    // threshold the mode is located again, using the previous mode as the
+    // starting value for Newton's method.
+    //
+    // Args:
+    //   acceptance_threshold: The acceptance rate below which the mode is
+    //     located again.  A value <= 0 turns caching off.
+    //   window: The acceptance rate is an exponentially weighted moving
+    //     average with weight 1 / window on the most recent draw.
+    void cache_mode(double acceptance_threshold, int window = 20);
+
+    // The number of times draw() has located the mode.
+    int number_of_mode_searches() const { return number_of_mode_searches_; }
+
     // Locates the mode of the target distribution, with 'old' as a
     // starting value.  Returns 'true' if the mode was located
     // successfully, 'false' otherwise.
@@ -104,6 +126,12 @@ namespace BOOM {
     Matrix dummy_Hessian_;
     bool mode_is_fixed_;
     bool mode_has_been_found_;
+
+    // Mode caching.  See cache_mode().
+    double cache_acceptance_threshold_;
+    double cache_window_;
+    double recent_acceptance_rate_;
+    int number_of_mode_searches_;
   };
 }  // namespace BOOM
 #endif
@@ -57,6 +57,32 @@ namespace BOOM {
                                      int position) const = 0;
   };
 
+  //----------------------------------------------------------------------
+  // A dTargetFun that is a sum of terms, one per observation, such as a
+  // log likelihood for independent data.  The sum can be evaluated over a
+  // subset of the terms, so stochastic gradient methods can work with
+  // minibatches whose cost does not depend on the number of terms.
+  class dSubsampleTargetFun : public dTargetFun {
+   public:
+    // The number of terms in the full sum.
+    virtual int number_of_terms() const = 0;
+
+    // Evaluate the sum of the terms listed in 'subsample'.  An index listed
+    // more than once contributes once for each time it is listed.
+    //
+    // Args:
+    //   x:  The function argument.
+    //   gradient: On output, the gradient of the subsample sum with respect
+    //     to x.
+    //   subsample: Indices of the terms to include, each in the range [0,
+    //     number_of_terms()).
+    //
+    // Returns:
+    //   The sum of the terms in 'subsample' evaluated at x.
+    virtual double subsample_value(const Vector &x, Vector &gradient,
+                                   const std::vector<int> &subsample) const = 0;
+  };
+
   //----------------------------------------------------------------------
   // A dTargetFun that can also take second derivatives.
   class d2TargetFun : virtual public dTargetFun {
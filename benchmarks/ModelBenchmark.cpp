@@ -0,0 +1,103 @@
+// Copyright 2018 Google LLC. All Rights Reserved.
+/*
+  Copyright (C) 2005-2024 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include "benchmarks/ModelBenchmark.hpp"
+
+#include <sys/resource.h>
+#include <chrono>
+
+#include "distributions.hpp"
+#include "stats/mcmc_convergence.hpp"
+
+namespace BOOM {
+  namespace Benchmarks {
+
+    namespace {
+      using Clock = std::chrono::steady_clock;
+
+      double seconds_since(const Clock::time_point &start) {
+        return std::chrono::duration<double>(Clock::now() - start).count();
+      }
+    }  // namespace
+
+    double PeakRssMegabytes() {
+      struct rusage usage;
+      getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+      // Darwin reports ru_maxrss in bytes.
+      return usage.ru_maxrss / (1024.0 * 1024.0);
+#else
+      // Linux reports ru_maxrss in kilobytes.
+      return usage.ru_maxrss / 1024.0;
+#endif
+    }
+
+    void RunModelBenchmark(
+        benchmark::State &state,
+        const std::function<std::unique_ptr<ModelBenchmark>()> &factory,
+        int burn, int niter) {
+      double simulate_seconds = 0;
+      double build_seconds = 0;
+      double burn_seconds = 0;
+      double sample_seconds = 0;
+      double ess = 0;
+      for (auto _ : state) {
+        state.PauseTiming();
+        GlobalRng::rng.seed(8675309);
+        std::unique_ptr<ModelBenchmark> model = factory();
+        Clock::time_point start = Clock::now();
+        model->SimulateData();
+        simulate_seconds += seconds_since(start);
+        start = Clock::now();
+        model->BuildModel();
+        build_seconds += seconds_since(start);
+        state.ResumeTiming();
+
+        start = Clock::now();
+        for (int i = 0; i < burn; ++i) {
+          model->Draw();
+        }
+        burn_seconds += seconds_since(start);
+
+        // Recording the monitored parameters is part of the sampling phase,
+        // but it is negligible next to a draw.
+        McmcConvergenceMonitor monitor(1, model->MonitoredParameters().size());
+        start = Clock::now();
+        for (int i = 0; i < niter; ++i) {
+          model->Draw();
+          monitor.add(0, model->MonitoredParameters());
+        }
+        sample_seconds += seconds_since(start);
+        ess += min(monitor.effective_sample_size());
+      }
+
+      double runs = state.iterations();
+      state.counters["simulate_seconds"] = simulate_seconds / runs;
+      state.counters["build_seconds"] = build_seconds / runs;
+      state.counters["burn_seconds"] = burn_seconds / runs;
+      state.counters["sample_seconds"] = sample_seconds / runs;
+      state.counters["iterations_per_second"] =
+          niter * runs / sample_seconds;
+      state.counters["min_ess"] = ess / runs;
+      state.counters["ess_per_second"] = ess / sample_seconds;
+      state.counters["peak_rss_mb"] = PeakRssMegabytes();
+    }
+
+  }  // namespace Benchmarks
+}  // namespace BOOM
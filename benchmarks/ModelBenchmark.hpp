@@ -0,0 +1,89 @@
+#ifndef BOOM_BENCHMARKS_MODEL_BENCHMARK_HPP_
+#define BOOM_BENCHMARKS_MODEL_BENCHMARK_HPP_
+// Copyright 2018 Google LLC. All Rights Reserved.
+/*
+  Copyright (C) 2005-2024 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include <functional>
+#include <memory>
+#include "benchmark/benchmark.h"
+#include "LinAlg/Vector.hpp"
+
+namespace BOOM {
+  namespace Benchmarks {
+
+    // An end-to-end MCMC benchmark: simulate a data set, build a model with a
+    // posterior sampler, then run the sampler.  Concrete benchmarks implement
+    // the phases.  RunModelBenchmark times each phase separately, and
+    // measures the effective sample size of a few monitored parameters.
+    class ModelBenchmark {
+     public:
+      virtual ~ModelBenchmark() {}
+
+      // Simulate the data to be fit.  Simulation should use GlobalRng::rng,
+      // which is seeded before this call, so the data are reproducible.
+      virtual void SimulateData() = 0;
+
+      // Create the model, assign it the simulated data, and set a posterior
+      // sampler.
+      virtual void BuildModel() = 0;
+
+      // Run a single MCMC iteration.
+      virtual void Draw() = 0;
+
+      // The model parameters whose effective sample size is reported.  These
+      // should be scalar summaries that are identified in the posterior, such
+      // as a residual standard deviation or sorted component means, so that
+      // label switching does not masquerade as poor mixing.
+      virtual Vector MonitoredParameters() const = 0;
+    };
+
+    // Run the benchmark produced by 'factory' once per benchmark iteration.
+    //
+    // Args:
+    //   state:  The Google benchmark state.
+    //   factory:  Produces a fresh benchmark object for each run.
+    //   burn:  The number of MCMC iterations to discard.
+    //   niter:  The number of MCMC iterations to time after the burn-in.
+    //
+    // The following counters are reported, in seconds where applicable, and
+    // are averaged over benchmark iterations.
+    //   simulate_seconds, build_seconds, burn_seconds, sample_seconds:  The
+    //     wall time spent in each phase.
+    //   iterations_per_second:  niter / sample_seconds.
+    //   min_ess:  The smallest effective sample size among the monitored
+    //     parameters, estimated by batch means.
+    //   ess_per_second:  min_ess / sample_seconds.
+    //   peak_rss_mb: The peak resident set size of the process, in megabytes.
+    //     This is a high water mark for the whole process, so it is only
+    //     meaningful for the largest benchmark in a run.  Use
+    //     --benchmark_filter to measure a single benchmark in isolation.
+    //
+    // The benchmark's reported time covers the burn-in and sampling phases.
+    void RunModelBenchmark(
+        benchmark::State &state,
+        const std::function<std::unique_ptr<ModelBenchmark>()> &factory,
+        int burn, int niter);
+
+    // The peak resident set size of the current process, in megabytes.
+    double PeakRssMegabytes();
+
+  }  // namespace Benchmarks
+}  // namespace BOOM
+
+#endif  // BOOM_BENCHMARKS_MODEL_BENCHMARK_HPP_
@@ -0,0 +1,76 @@
+// Copyright 2018 Google LLC. All Rights Reserved.
+/*
+  Copyright (C) 2005-2024 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include "benchmark/benchmark.h"
+#include "LinAlg/Matrix.hpp"
+#include "LinAlg/SpdMatrix.hpp"
+#include "LinAlg/Vector.hpp"
+#include "distributions.hpp"
+
+namespace {
+  using namespace BOOM;
+
+  SpdMatrix random_spd(int n) {
+    Matrix X(2 * n, n);
+    X.randomize();
+    SpdMatrix ans(n, 0.0);
+    ans.add_inner(X);
+    ans.diag() += 1.0;
+    return ans;
+  }
+
+  // A multivariate normal draw, including the Cholesky decomposition of the
+  // variance.
+  void BM_Rmvn(benchmark::State &state) {
+    RNG rng(8675309);
+    int n = state.range(0);
+    SpdMatrix Sigma = random_spd(n);
+    Vector mu(n, 0.0);
+    for (auto _ : state) {
+      Vector draw = rmvn_mt(rng, mu, Sigma);
+      benchmark::DoNotOptimize(draw.data());
+    }
+  }
+  BENCHMARK(BM_Rmvn)->RangeMultiplier(4)->Range(2, 128);
+
+  // A Wishart draw given the inverse of the sum of squares.
+  void BM_RWish(benchmark::State &state) {
+    RNG rng(8675309);
+    int n = state.range(0);
+    SpdMatrix sumsq_inv = random_spd(n);
+    for (auto _ : state) {
+      SpdMatrix draw = rWish_mt(rng, n + 2.0, sumsq_inv);
+      benchmark::DoNotOptimize(draw.data());
+    }
+  }
+  BENCHMARK(BM_RWish)->RangeMultiplier(4)->Range(2, 128);
+
+  // Standard normal draws restricted to lie above state.range(0) / 4.
+  // The cutpoints cover both regimes of the sampler: the bulk of the
+  // distribution, and far into the tail.
+  void BM_TrunNorm(benchmark::State &state) {
+    RNG rng(8675309);
+    double cutpoint = state.range(0) / 4.0;
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(trun_norm_mt(rng, cutpoint));
+    }
+  }
+  BENCHMARK(BM_TrunNorm)->DenseRange(-8, 24, 8);
+
+}  // namespace
@@ -0,0 +1,80 @@
+// Copyright 2018 Google LLC. All Rights Reserved.
+/*
+  Copyright (C) 2005-2024 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include "benchmark/benchmark.h"
+#include "LinAlg/Cholesky.hpp"
+#include "LinAlg/Matrix.hpp"
+#include "LinAlg/SpdMatrix.hpp"
+#include "LinAlg/Vector.hpp"
+#include "distributions.hpp"
+
+namespace {
+  using namespace BOOM;
+
+  // A well conditioned random SPD matrix of dimension n.
+  SpdMatrix random_spd(int n) {
+    Matrix X(2 * n, n);
+    X.randomize();
+    SpdMatrix ans(n, 0.0);
+    ans.add_inner(X);
+    ans.diag() += 1.0;
+    return ans;
+  }
+
+  // Matrix * Matrix for square matrices of dimension state.range(0).
+  void BM_MatrixMultiply(benchmark::State &state) {
+    GlobalRng::rng.seed(8675309);
+    int n = state.range(0);
+    Matrix A(n, n), B(n, n);
+    A.randomize();
+    B.randomize();
+    for (auto _ : state) {
+      Matrix C = A * B;
+      benchmark::DoNotOptimize(C.data());
+    }
+    state.SetItemsProcessed(state.iterations() * n * n * n);
+  }
+  BENCHMARK(BM_MatrixMultiply)->RangeMultiplier(4)->Range(4, 256);
+
+  // The lower Cholesky triangle of an SPD matrix.
+  void BM_SpdChol(benchmark::State &state) {
+    GlobalRng::rng.seed(8675309);
+    SpdMatrix Sigma = random_spd(state.range(0));
+    for (auto _ : state) {
+      Matrix L = Sigma.chol();
+      benchmark::DoNotOptimize(L.data());
+    }
+  }
+  BENCHMARK(BM_SpdChol)->RangeMultiplier(4)->Range(4, 256);
+
+  // Solve a linear system given an existing decomposition.
+  void BM_CholeskySolve(benchmark::State &state) {
+    GlobalRng::rng.seed(8675309);
+    int n = state.range(0);
+    Cholesky chol(random_spd(n));
+    Vector b(n);
+    b.randomize();
+    for (auto _ : state) {
+      Vector x = chol.solve(b);
+      benchmark::DoNotOptimize(x.data());
+    }
+  }
+  BENCHMARK(BM_CholeskySolve)->RangeMultiplier(4)->Range(4, 256);
+
+}  // namespace
@@ -0,0 +1,64 @@
+// Copyright 2018 Google LLC. All Rights Reserved.
+/*
+  Copyright (C) 2005-2024 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include "benchmark/benchmark.h"
+#include "LinAlg/Vector.hpp"
+#include "cpputil/lse.hpp"
+#include "distributions.hpp"
+
+namespace {
+  using namespace BOOM;
+
+  Vector random_logprob(int n) {
+    GlobalRng::rng.seed(8675309);
+    Vector ans(n);
+    for (double &x : ans) x = rnorm(0, 10);
+    return ans;
+  }
+
+  void BM_Lse(benchmark::State &state) {
+    Vector v = random_logprob(state.range(0));
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(lse(v));
+    }
+    state.SetItemsProcessed(state.iterations() * v.size());
+  }
+  BENCHMARK(BM_Lse)->RangeMultiplier(8)->Range(2, 4096);
+
+  void BM_LseApproximate(benchmark::State &state) {
+    Vector v = random_logprob(state.range(0));
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(lse_approximate(v));
+    }
+    state.SetItemsProcessed(state.iterations() * v.size());
+  }
+  BENCHMARK(BM_LseApproximate)->RangeMultiplier(8)->Range(2, 4096);
+
+  void BM_NormalizeLogprob(benchmark::State &state) {
+    Vector v = random_logprob(state.range(0));
+    Vector work(v.size());
+    for (auto _ : state) {
+      work = v;
+      benchmark::DoNotOptimize(normalize_logprob_inplace(VectorView(work)));
+    }
+    state.SetItemsProcessed(state.iterations() * v.size());
+  }
+  BENCHMARK(BM_NormalizeLogprob)->RangeMultiplier(8)->Range(2, 4096);
+
+}  // namespace
@@ -0,0 +1,442 @@
+// Copyright 2018 Google LLC. All Rights Reserved.
+/*
+  Copyright (C) 2005-2024 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+// End-to-end MCMC benchmarks for representative BOOM models.  See
+// ModelBenchmark.hpp for the reported counters.
+
+#include <algorithm>
+#include <limits>
+
+#include "benchmark/benchmark.h"
+#include "benchmarks/ModelBenchmark.hpp"
+
+#include "Models/Bart/GaussianBartModel.hpp"
+#include "Models/Bart/PosteriorSamplers/GaussianBartPosteriorSampler.hpp"
+#include "Models/ChisqModel.hpp"
+#include "Models/GammaModel.hpp"
+#include "Models/Glm/BinomialLogitModel.hpp"
+#include "Models/Glm/PosteriorSamplers/BinomialLogitAuxmixSampler.hpp"
+#include "Models/Glm/PosteriorSamplers/BregVsSampler.hpp"
+#include "Models/Glm/RegressionModel.hpp"
+#include "Models/Glm/VariableSelectionPrior.hpp"
+#include "Models/HMM/HMM2.hpp"
+#include "Models/HMM/PosteriorSamplers/HmmPosteriorSampler.hpp"
+#include "Models/MarkovModel.hpp"
+#include "Models/Mixtures/DirichletProcessMvnModel.hpp"
+#include "Models/Mixtures/PosteriorSamplers/DirichletProcessMvnCollapsedGibbsSampler.hpp"
+#include "Models/MvnGivenScalarSigma.hpp"
+#include "Models/MvnGivenSigma.hpp"
+#include "Models/MvnModel.hpp"
+#include "Models/PoissonModel.hpp"
+#include "Models/PosteriorSamplers/MarkovConjSampler.hpp"
+#include "Models/PosteriorSamplers/PoissonGammaSampler.hpp"
+#include "Models/PosteriorSamplers/ZeroMeanGaussianConjSampler.hpp"
+#include "Models/ProductDirichletModel.hpp"
+#include "Models/StateSpace/PosteriorSamplers/StateSpacePosteriorSampler.hpp"
+#include "Models/StateSpace/StateModels/test_utils/LocalLinearTrendModule.hpp"
+#include "Models/StateSpace/StateModels/test_utils/SeasonalTestModule.hpp"
+#include "Models/StateSpace/StateSpaceModel.hpp"
+#include "Models/TimeSeries/TimeSeries.hpp"
+#include "Models/WishartModel.hpp"
+#include "cpputil/Constants.hpp"
+#include "distributions.hpp"
+
+namespace {
+  using namespace BOOM;
+  using namespace BOOM::Benchmarks;
+  using namespace BOOM::StateSpaceTesting;
+
+  // A simulated regression design with an intercept and standard normal
+  // predictors.
+  Matrix simulate_design(int sample_size, int xdim) {
+    Matrix X(sample_size, xdim);
+    X.randomize_gaussian(0, 1);
+    X.col(0) = 1.0;
+    return X;
+  }
+
+  //===========================================================================
+  // A bsts-style model: local linear trend plus a weekly seasonal, with
+  // Gaussian observation errors.  The simulation and state models come from
+  // the StateSpace test modules.
+  class BstsBenchmark : public ModelBenchmark {
+   public:
+    explicit BstsBenchmark(int time_dimension)
+        : time_dimension_(time_dimension) {}
+
+    void SimulateData() override {
+      state_modules_.AddModule(new LocalLinearTrendModule(.3, 10, .01, 0));
+      state_modules_.AddModule(new SeasonalTestModule(.1, 7));
+      state_modules_.SimulateData(time_dimension_);
+      data_ = state_modules_.StateContribution();
+      for (double &y : data_) y += rnorm(0, observation_sd_);
+    }
+
+    void BuildModel() override {
+      model_ = new StateSpaceModel;
+      NEW(ChisqModel, residual_precision_prior)(1.0, observation_sd_);
+      NEW(ZeroMeanGaussianConjSampler, residual_precision_sampler)(
+          model_->observation_model(), residual_precision_prior);
+      model_->observation_model()->set_method(residual_precision_sampler);
+      state_modules_.ImbueState(*model_);
+      for (double y : data_) {
+        NEW(StateSpace::MultiplexedDoubleData, data_point)();
+        data_point->add_data(new DoubleData(y));
+        model_->add_data(data_point);
+      }
+      NEW(StateSpacePosteriorSampler, sampler)(model_.get());
+      model_->set_method(sampler);
+    }
+
+    void Draw() override { model_->sample_posterior(); }
+
+    Vector MonitoredParameters() const override {
+      Vector ans(1, model_->observation_model()->sigma());
+      for (int s = 0; s < model_->number_of_state_models(); ++s) {
+        ans.concat(model_->state_model(s)->vectorize_params(true));
+      }
+      return ans;
+    }
+
+   private:
+    int time_dimension_;
+    double observation_sd_ = 1.0;
+    StateModuleManager<StateModel, ScalarStateSpaceModelBase> state_modules_;
+    Vector data_;
+    Ptr<StateSpaceModel> model_;
+  };
+
+  void BM_Bsts(benchmark::State &state) {
+    int time_dimension = state.range(0);
+    RunModelBenchmark(
+        state,
+        [time_dimension]() {
+          return std::unique_ptr<ModelBenchmark>(
+              new BstsBenchmark(time_dimension));
+        },
+        10, 100);
+  }
+  BENCHMARK(BM_Bsts)
+      ->Arg(1000)->Arg(10000)->Arg(100000)
+      ->Unit(benchmark::kMillisecond)->UseRealTime();
+
+  //===========================================================================
+  // Spike and slab regression with five nonzero coefficients.
+  class SpikeSlabBenchmark : public ModelBenchmark {
+   public:
+    SpikeSlabBenchmark(int sample_size, int xdim)
+        : sample_size_(sample_size), xdim_(xdim) {}
+
+    void SimulateData() override {
+      X_ = simulate_design(sample_size_, xdim_);
+      Vector beta(xdim_, 0.0);
+      for (int i = 0; i < std::min(xdim_, 5); ++i) beta[i] = 2.0 - i;
+      y_ = X_ * beta;
+      for (double &y : y_) y += rnorm(0, 1.0);
+    }
+
+    void BuildModel() override {
+      model_ = new RegressionModel(X_, y_, false);
+      NEW(MvnGivenScalarSigma, slab)(
+          Vector(xdim_, 0.0), model_->suf()->xtx() / sample_size_,
+          model_->Sigsq_prm());
+      NEW(ChisqModel, residual_precision_prior)(1.0, 1.0);
+      NEW(VariableSelectionPrior, spike)(xdim_, 5.0 / xdim_);
+      NEW(BregVsSampler, sampler)(
+          model_.get(), slab, residual_precision_prior, spike);
+      model_->set_method(sampler);
+    }
+
+    void Draw() override { model_->sample_posterior(); }
+
+    Vector MonitoredParameters() const override {
+      Vector ans(1, model_->sigma());
+      ans.concat(ConstVectorView(model_->Beta(), 0, std::min(xdim_, 3)));
+      return ans;
+    }
+
+   private:
+    int sample_size_;
+    int xdim_;
+    Matrix X_;
+    Vector y_;
+    Ptr<RegressionModel> model_;
+  };
+
+  void BM_SpikeSlabRegression(benchmark::State &state) {
+    int sample_size = state.range(0);
+    int xdim = state.range(1);
+    RunModelBenchmark(
+        state,
+        [sample_size, xdim]() {
+          return std::unique_ptr<ModelBenchmark>(
+              new SpikeSlabBenchmark(sample_size, xdim));
+        },
+        10, 200);
+  }
+  BENCHMARK(BM_SpikeSlabRegression)
+      ->ArgsProduct({{1000, 10000}, {10, 100, 500}})
+      ->Unit(benchmark::kMillisecond)->UseRealTime();
+
+  //===========================================================================
+  // Logistic regression fit by data augmentation with the auxiliary mixture
+  // sampler.
+  class LogitAuxmixBenchmark : public ModelBenchmark {
+   public:
+    LogitAuxmixBenchmark(int sample_size, int xdim)
+        : sample_size_(sample_size), xdim_(xdim) {}
+
+    void SimulateData() override {
+      Matrix X = simulate_design(sample_size_, xdim_);
+      Vector beta(xdim_);
+      beta.randomize_gaussian(0, 1.0 / sqrt(xdim_));
+      for (int i = 0; i < sample_size_; ++i) {
+        double prob = plogis(X.row(i).dot(beta));
+        data_.push_back(new BinomialRegressionData(
+            runif(0, 1) < prob, 1, X.row(i)));
+      }
+    }
+
+    void BuildModel() override {
+      model_ = new BinomialLogitModel(xdim_);
+      for (const auto &dp : data_) model_->add_data(dp);
+      NEW(MvnModel, prior)(Vector(xdim_, 0.0), SpdMatrix(xdim_, 1.0));
+      NEW(BinomialLogitAuxmixSampler, sampler)(model_.get(), prior);
+      model_->set_method(sampler);
+    }
+
+    void Draw() override { model_->sample_posterior(); }
+
+    Vector MonitoredParameters() const override { return model_->Beta(); }
+
+   private:
+    int sample_size_;
+    int xdim_;
+    std::vector<Ptr<BinomialRegressionData>> data_;
+    Ptr<BinomialLogitModel> model_;
+  };
+
+  void BM_LogitAuxmix(benchmark::State &state) {
+    int sample_size = state.range(0);
+    int xdim = state.range(1);
+    RunModelBenchmark(
+        state,
+        [sample_size, xdim]() {
+          return std::unique_ptr<ModelBenchmark>(
+              new LogitAuxmixBenchmark(sample_size, xdim));
+        },
+        10, 200);
+  }
+  BENCHMARK(BM_LogitAuxmix)
+      ->ArgsProduct({{1000, 10000}, {5, 20}})
+      ->Unit(benchmark::kMillisecond)->UseRealTime();
+
+  //===========================================================================
+  // Gaussian BART with a fixed number of trees, fit to a nonlinear function
+  // of five predictors.
+  class BartBenchmark : public ModelBenchmark {
+   public:
+    BartBenchmark(int sample_size, int number_of_trees)
+        : sample_size_(sample_size), number_of_trees_(number_of_trees) {}
+
+    void SimulateData() override {
+      X_.resize(sample_size_, 5);
+      X_.randomize();
+      y_.resize(sample_size_);
+      for (int i = 0; i < sample_size_; ++i) {
+        ConstVectorView x(X_.row(i));
+        y_[i] = 10 * sin(Constants::pi * x[0] * x[1]) +
+                20 * square(x[2] - .5) + 10 * x[3] + 5 * x[4] +
+                rnorm(0, 1.0);
+      }
+    }
+
+    void BuildModel() override {
+      model_ = new GaussianBartModel(number_of_trees_, y_, X_);
+      model_->finalize_data();
+      int number_of_trees = number_of_trees_;
+      NEW(GaussianBartPosteriorSampler, sampler)(
+          model_.get(), sd(y_), 3.0, 2.0 * sd(y_), .95, 2.0,
+          [number_of_trees](int n) {
+            return n == number_of_trees
+                       ? 0.0
+                       : -std::numeric_limits<double>::infinity();
+          });
+      model_->set_method(sampler);
+    }
+
+    void Draw() override { model_->sample_posterior(); }
+
+    Vector MonitoredParameters() const override {
+      return Vector(1, sqrt(model_->sigsq()));
+    }
+
+   private:
+    int sample_size_;
+    int number_of_trees_;
+    Matrix X_;
+    Vector y_;
+    Ptr<GaussianBartModel> model_;
+  };
+
+  void BM_GaussianBart(benchmark::State &state) {
+    int sample_size = state.range(0);
+    int number_of_trees = state.range(1);
+    RunModelBenchmark(
+        state,
+        [sample_size, number_of_trees]() {
+          return std::unique_ptr<ModelBenchmark>(
+              new BartBenchmark(sample_size, number_of_trees));
+        },
+        10, 50);
+  }
+  BENCHMARK(BM_GaussianBart)
+      ->ArgsProduct({{1000, 5000}, {200}})
+      ->Unit(benchmark::kMillisecond)->UseRealTime();
+
+  //===========================================================================
+  // A hidden Markov model with Poisson emissions, fit to a single long
+  // series.
+  class HmmBenchmark : public ModelBenchmark {
+   public:
+    HmmBenchmark(int number_of_states, int series_length)
+        : number_of_states_(number_of_states),
+          series_length_(series_length) {}
+
+    void SimulateData() override {
+      int S = number_of_states_;
+      series_ = new TimeSeries<Data>;
+      int state = 0;
+      for (int t = 0; t < series_length_; ++t) {
+        // Stay in the current state with probability .9, otherwise move to a
+        // uniformly chosen state.
+        if (runif(0, 1) > .9) state = random_int(0, S - 1);
+        series_->add_data_point(new IntData(rpois(1.0 + 3.0 * state)));
+      }
+    }
+
+    void BuildModel() override {
+      int S = number_of_states_;
+      std::vector<Ptr<MixtureComponent>> components;
+      for (int s = 0; s < S; ++s) {
+        NEW(PoissonModel, component)(1.0 + 3.0 * s);
+        NEW(PoissonGammaSampler, component_sampler)(
+            component.get(), new GammaModel(1.0, .1));
+        component->set_method(component_sampler);
+        components_.push_back(component);
+        components.push_back(component);
+      }
+      NEW(MarkovModel, markov)(S);
+      NEW(MarkovConjSampler, markov_sampler)(
+          markov.get(), new ProductDirichletModel(Matrix(S, S, 1.0)));
+      markov->set_method(markov_sampler);
+      model_ = new HiddenMarkovModel(components, markov);
+      model_->add_data_series(series_);
+      NEW(HmmPosteriorSampler, sampler)(model_.get());
+      model_->set_method(sampler);
+    }
+
+    void Draw() override { model_->sample_posterior(); }
+
+    // The emission rates are sorted so that label switching is not counted
+    // against the mixing.
+    Vector MonitoredParameters() const override {
+      Vector ans;
+      for (const auto &component : components_) ans.push_back(component->lam());
+      std::sort(ans.begin(), ans.end());
+      return ans;
+    }
+
+   private:
+    int number_of_states_;
+    int series_length_;
+    Ptr<TimeSeries<Data>> series_;
+    std::vector<Ptr<PoissonModel>> components_;
+    Ptr<HiddenMarkovModel> model_;
+  };
+
+  void BM_PoissonHmm(benchmark::State &state) {
+    int number_of_states = state.range(0);
+    RunModelBenchmark(
+        state,
+        [number_of_states]() {
+          return std::unique_ptr<ModelBenchmark>(
+              new HmmBenchmark(number_of_states, 5000));
+        },
+        10, 100);
+  }
+  BENCHMARK(BM_PoissonHmm)
+      ->Arg(2)->Arg(8)->Arg(32)
+      ->Unit(benchmark::kMillisecond)->UseRealTime();
+
+  //===========================================================================
+  // A Dirichlet process mixture of multivariate normals, fit by collapsed
+  // Gibbs sampling to data from three well separated clusters.
+  class DpMvnBenchmark : public ModelBenchmark {
+   public:
+    DpMvnBenchmark(int sample_size, int dim)
+        : sample_size_(sample_size), dim_(dim) {}
+
+    void SimulateData() override {
+      SpdMatrix Sigma(dim_, 1.0);
+      for (int i = 0; i < sample_size_; ++i) {
+        Vector mu(dim_, 5.0 * (i % 3));
+        data_.push_back(new VectorData(rmvn(mu, Sigma)));
+      }
+    }
+
+    void BuildModel() override {
+      model_ = new DirichletProcessMvnModel(dim_, 1.0);
+      for (const auto &dp : data_) model_->add_data(dp);
+      NEW(MvnGivenSigma, mean_base_measure)(Vector(dim_, 5.0), 1.0);
+      NEW(WishartModel, precision_base_measure)(dim_ + 1, SpdMatrix(dim_, 1.0));
+      NEW(DirichletProcessMvnCollapsedGibbsSampler, sampler)(
+          model_.get(), mean_base_measure, precision_base_measure);
+      model_->set_method(sampler);
+    }
+
+    void Draw() override { model_->sample_posterior(); }
+
+    Vector MonitoredParameters() const override {
+      return Vector(1, model_->number_of_clusters());
+    }
+
+   private:
+    int sample_size_;
+    int dim_;
+    std::vector<Ptr<VectorData>> data_;
+    Ptr<DirichletProcessMvnModel> model_;
+  };
+
+  void BM_DirichletProcessMvn(benchmark::State &state) {
+    int sample_size = state.range(0);
+    int dim = state.range(1);
+    RunModelBenchmark(
+        state,
+        [sample_size, dim]() {
+          return std::unique_ptr<ModelBenchmark>(
+              new DpMvnBenchmark(sample_size, dim));
+        },
+        10, 100);
+  }
+  BENCHMARK(BM_DirichletProcessMvn)
+      ->ArgsProduct({{500, 2000}, {2, 5}})
+      ->Unit(benchmark::kMillisecond)->UseRealTime();
+
+}  // namespace
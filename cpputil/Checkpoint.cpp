@@ -0,0 +1,198 @@
+// Copyright 2018 Google LLC. All Rights Reserved.
+/*
+  Copyright (C) 2018 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#include "cpputil/Checkpoint.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include "cpputil/report_error.hpp"
+
+namespace BOOM {
+
+  namespace {
+    const char magic[] = "BOOMCKPT";
+
+    uint64_t fnv1a_hash(const std::string &data) {
+      uint64_t hash = 0xcbf29ce484222325ULL;
+      for (unsigned char c : data) {
+        hash ^= c;
+        hash *= 0x100000001b3ULL;
+      }
+      return hash;
+    }
+  }  // namespace
+
+  void CheckpointWriter::write(const std::string &value) {
+    write(static_cast<int64_t>(value.size()));
+    append(value.data(), value.size());
+  }
+
+  void CheckpointWriter::write(const std::vector<double> &values) {
+    write(static_cast<int64_t>(values.size()));
+    append(values.data(), values.size() * sizeof(double));
+  }
+
+  void CheckpointWriter::write(const std::vector<int> &values) {
+    write(static_cast<int64_t>(values.size()));
+    for (int value : values) {
+      write(value);
+    }
+  }
+
+  void CheckpointWriter::save(const std::string &filename) const {
+    std::string temporary = filename + ".tmp";
+    {
+      std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+      if (!out) {
+        report_error("Could not open " + temporary + " for writing.");
+      }
+      char header[CheckpointFormat::header_size];
+      std::memset(header, 0, sizeof(header));
+      std::memcpy(header, magic, 8);
+      uint32_t byte_order = CheckpointFormat::byte_order_mark;
+      uint32_t version = CheckpointFormat::version;
+      uint64_t size = payload_.size();
+      uint64_t hash = fnv1a_hash(payload_);
+      std::memcpy(header + 8, &byte_order, 4);
+      std::memcpy(header + 12, &version, 4);
+      std::memcpy(header + 16, &size, 8);
+      std::memcpy(header + 24, &hash, 8);
+      out.write(header, sizeof(header));
+      out.write(payload_.data(), payload_.size());
+      out.flush();
+      if (!out) {
+        report_error("Error writing checkpoint file " + temporary + ".");
+      }
+    }
+    if (std::rename(temporary.c_str(), filename.c_str()) != 0) {
+      report_error("Could not rename " + temporary + " to " + filename + ".");
+    }
+  }
+
+  //===========================================================================
+  CheckpointReader::CheckpointReader(const std::string &payload)
+      : payload_(payload), position_(0) {}
+
+  CheckpointReader CheckpointReader::load(const std::string &filename) {
+    std::ifstream in(filename, std::ios::binary);
+    if (!in) {
+      report_error("Could not open checkpoint file " + filename + ".");
+    }
+    char header[CheckpointFormat::header_size];
+    in.read(header, sizeof(header));
+    if (in.gcount() != sizeof(header) || std::memcmp(header, magic, 8) != 0) {
+      report_error(filename + " is not a checkpoint file.");
+    }
+    uint32_t byte_order, version;
+    uint64_t size, hash;
+    std::memcpy(&byte_order, header + 8, 4);
+    std::memcpy(&version, header + 12, 4);
+    std::memcpy(&size, header + 16, 8);
+    std::memcpy(&hash, header + 24, 8);
+    if (byte_order != CheckpointFormat::byte_order_mark) {
+      report_error(filename + " was written on a machine with a different "
+                   "byte order.");
+    }
+    if (version != CheckpointFormat::version) {
+      std::ostringstream err;
+      err << filename << " has checkpoint format version " << version
+          << ".  This library reads version " << CheckpointFormat::version
+          << ".";
+      report_error(err.str());
+    }
+    std::string payload(size, '\0');
+    in.read(&payload[0], size);
+    if (static_cast<uint64_t>(in.gcount()) != size) {
+      report_error("Checkpoint file " + filename + " is truncated.");
+    }
+    if (fnv1a_hash(payload) != hash) {
+      report_error("Checkpoint file " + filename + " is corrupt.");
+    }
+    return CheckpointReader(payload);
+  }
+
+  void CheckpointReader::expect_section(const std::string &name) {
+    std::string section = read_string();
+    if (section != name) {
+      report_error("Expected checkpoint section '" + name + "' but found '"
+                   + section + "'.");
+    }
+  }
+
+  int64_t CheckpointReader::read_int() {
+    int64_t value;
+    extract(&value, sizeof(value));
+    return value;
+  }
+
+  uint64_t CheckpointReader::read_uint64() {
+    uint64_t value;
+    extract(&value, sizeof(value));
+    return value;
+  }
+
+  double CheckpointReader::read_double() {
+    double value;
+    extract(&value, sizeof(value));
+    return value;
+  }
+
+  std::string CheckpointReader::read_string() {
+    int64_t size = read_int();
+    if (size < 0 || size > payload_.size() - position_) {
+      report_error("Malformed string in checkpoint.");
+    }
+    std::string value = payload_.substr(position_, size);
+    position_ += size;
+    return value;
+  }
+
+  std::vector<double> CheckpointReader::read_double_vector() {
+    int64_t size = read_int();
+    if (size < 0 || size > (payload_.size() - position_) / sizeof(double)) {
+      report_error("Malformed vector in checkpoint.");
+    }
+    std::vector<double> values(size);
+    extract(values.data(), size * sizeof(double));
+    return values;
+  }
+
+  std::vector<int> CheckpointReader::read_int_vector() {
+    int64_t size = read_int();
+    if (size < 0 || size > (payload_.size() - position_) / sizeof(int64_t)) {
+      report_error("Malformed vector in checkpoint.");
+    }
+    std::vector<int> values(size);
+    for (int64_t i = 0; i < size; ++i) {
+      values[i] = read_int();
+    }
+    return values;
+  }
+
+  void CheckpointReader::extract(void *data, std::size_t size) {
+    if (size > payload_.size() - position_) {
+      report_error("Attempt to read past the end of a checkpoint.");
+    }
+    std::memcpy(data, payload_.data() + position_, size);
+    position_ += size;
+  }
+
+}  // namespace BOOM
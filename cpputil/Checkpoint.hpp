@@ -0,0 +1,120 @@
+// Copyright 2018 Google LLC. All Rights Reserved.
+/*
+  Copyright (C) 2018 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#ifndef BOOM_CPPUTIL_CHECKPOINT_HPP_
+#define BOOM_CPPUTIL_CHECKPOINT_HPP_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Compact binary snapshots of the state of a running computation (model
+// parameters, sampler adaptation state, random number generators), so a
+// long MCMC run can be resumed after its process is killed.
+//
+// A checkpoint file has the layout (integers in native byte order; the
+// byte_order field detects a mismatch):
+//   bytes  0 -  7: magic string "BOOMCKPT".
+//   bytes  8 - 11: uint32 byte_order = 0x01020304.
+//   bytes 12 - 15: uint32 format version, currently 1.
+//   bytes 16 - 23: uint64 payload size in bytes.
+//   bytes 24 - 31: uint64 FNV-1a hash of the payload.
+//   bytes 32 - ...: The payload.
+//
+// The payload is a sequence of values written by CheckpointWriter and read
+// back, in the same order, by CheckpointReader.  Objects begin their
+// portion of the payload with a named section, so a checkpoint restored
+// into the wrong kind of object is caught rather than silently misread.
+namespace BOOM {
+
+  namespace CheckpointFormat {
+    constexpr int header_size = 32;
+    constexpr uint32_t byte_order_mark = 0x01020304;
+    constexpr uint32_t version = 1;
+  }  // namespace CheckpointFormat
+
+  class CheckpointWriter {
+   public:
+    CheckpointWriter() {}
+
+    // Mark the start of the state belonging to the named object.
+    void begin_section(const std::string &name) { write(name); }
+
+    void write(int64_t value) { append(&value, sizeof(value)); }
+    void write(uint64_t value) { append(&value, sizeof(value)); }
+    void write(int value) { write(static_cast<int64_t>(value)); }
+    void write(double value) { append(&value, sizeof(value)); }
+    void write(bool value) { write(static_cast<int64_t>(value)); }
+    void write(const std::string &value);
+    void write(const char *value) { write(std::string(value)); }
+    void write(const std::vector<double> &values);
+    void write(const std::vector<int> &values);
+
+    // The serialized payload.
+    const std::string &payload() const { return payload_; }
+
+    // Write the checkpoint to a file.  The data are first written to a
+    // temporary file that is renamed to 'filename' when complete, so an
+    // interruption never leaves a partially written checkpoint in place of
+    // a good one.
+    void save(const std::string &filename) const;
+
+   private:
+    void append(const void *data, std::size_t size) {
+      payload_.append(static_cast<const char *>(data), size);
+    }
+
+    std::string payload_;
+  };
+
+  class CheckpointReader {
+   public:
+    // Read from a payload produced by CheckpointWriter::payload().
+    explicit CheckpointReader(const std::string &payload);
+
+    // Read a checkpoint file written by CheckpointWriter::save.  An error
+    // is reported if the file is truncated, corrupt, or from an
+    // incompatible format version.
+    static CheckpointReader load(const std::string &filename);
+
+    // Report an error unless the next item is a section with the given
+    // name.
+    void expect_section(const std::string &name);
+
+    int64_t read_int();
+    uint64_t read_uint64();
+    double read_double();
+    bool read_bool() { return read_int() != 0; }
+    std::string read_string();
+    std::vector<double> read_double_vector();
+    std::vector<int> read_int_vector();
+
+    // True if the entire payload has been read.
+    bool at_end() const { return position_ == payload_.size(); }
+
+   private:
+    void extract(void *data, std::size_t size);
+
+    std::string payload_;
+    std::size_t position_;
+  };
+
+}  // namespace BOOM
+
+#endif  // BOOM_CPPUTIL_CHECKPOINT_HPP_
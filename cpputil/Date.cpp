@@ -75,38 +75,43 @@ namespace BOOM {
   }
 
   Date &Date::set(int days_after_jan_1_1970) {
-    if (days_after_jan_1_1970 == 0) return set(Jan, 1, 1970);
     days_after_origin_ = days_after_jan_1_1970;
-    if (days_after_jan_1_1970 < 0) {
-      return set_before_1970(-days_after_jan_1_1970);
-    }
-    int days_into_year;
-    year_ =
-        1970 + years_after_jan_1_1970(days_after_jan_1_1970, &days_into_year);
-    bool leap = is_leap_year(year_);
-    find_month_and_day(days_into_year, leap, &month_, &day_);
-    check(month_, day_, year_);
+    civil_from_days(days_after_jan_1_1970, &year_, &month_, &day_);
     return *this;
   }
 
-  Date &Date::set_before_1970(int days_before) {
-    if (days_before < 0) return set(-days_before);
-    days_after_origin_ = -days_before;
-    // year_delta is the number of complete years in days_before days.
-    int year_delta = years_before_jan_1_1970(days_before, &days_before);
-    year_ = 1970 - year_delta;
-    // now days_before is the number of days before the start of year_;
-    if (days_before == 0) {
-      month_ = Jan;
-      day_ = 1;
-      return *this;
-    }
-    --year_;  // Now year_ is the actual year of the Date object.
-    bool leap = is_leap_year(year_);
-    int days_into_year = 365 + leap - days_before;
-    find_month_and_day(days_into_year, leap, &month_, &day_);
-    check(month_, day_, year_);
-    return *this;
+  // The conversions between day counts and calendar dates use the algorithms
+  // from Howard Hinnant's "chrono-Compatible Low-Level Date Algorithms".
+  // Shifting the start of the year to March 1 puts the leap day at the end of
+  // the year, and the Gregorian calendar repeats every 400 years (an "era"
+  // of 146097 days), so both directions take a fixed number of integer
+  // operations.
+  long Date::days_from_civil(int year, MonthNames month, int day) {
+    long y = year - (month <= Feb);
+    long era = (y >= 0 ? y : y - 399) / 400;
+    long year_of_era = y - era * 400;
+    long day_of_year = (153 * (month + (month > Feb ? -3 : 9)) + 2) / 5
+        + day - 1;
+    long day_of_era = year_of_era * 365 + year_of_era / 4
+        - year_of_era / 100 + day_of_year;
+    // 719468 is the number of days from Mar 1, 0000 to Jan 1, 1970.
+    return era * 146097 + day_of_era - 719468;
+  }
+
+  void Date::civil_from_days(long days_after_jan_1_1970, int *year,
+                             MonthNames *month, int *day) {
+    long z = days_after_jan_1_1970 + 719468;
+    long era = (z >= 0 ? z : z - 146096) / 146097;
+    long day_of_era = z - era * 146097;
+    long year_of_era = (day_of_era - day_of_era / 1460
+                        + day_of_era / 36524 - day_of_era / 146096) / 365;
+    long day_of_year = day_of_era
+        - (365 * year_of_era + year_of_era / 4 - year_of_era / 100);
+    long shifted_month = (5 * day_of_year + 2) / 153;
+    *day = day_of_year - (153 * shifted_month + 2) / 5 + 1;
+    int m = shifted_month < 10 ? shifted_month + 3 : shifted_month - 9;
+    *month = MonthNames(m);
+    *year = year_of_era + era * 400 + (m <= Feb);
   }
 
   void Date::find_month_and_day(int days_after_jan1, bool leap,
@@ -195,28 +200,13 @@ namespace BOOM {
   }
 
   int Date::days_after_jan_1_1970(MonthNames month, int day, int year) {
-    if (year < 1970) return -1 * days_before_jan_1_1970(month, day, year);
-    int ans = 365 * (year - 1970) + number_of_leap_years_after_1970(year);
-    ans += days_into_year(month, day, is_leap_year(year));
-    // ans includes jan 1, 1970, so subtract it off before returning.
-    return ans - 1;
+    return days_from_civil(year, month, day);
   }
 
   // Compute the number of days that a particular date is before Jan
   // 1, 1970.
   int Date::days_before_jan_1_1970(MonthNames month, int day, int year) {
-    if (year >= 1970) return -1 * days_after_jan_1_1970(month, day, year);
-
-    // Compute the number of days needed to get to Jan 1 of next year
-    bool leap = is_leap_year(year);
-
-    // The number of days is the number of days until the end of the
-    // year plus the number of days in the complete years between Jan
-    // 1 next year and Jan 1 1970.
-    int days_to_jan1 = 366 + leap - days_into_year(month, day, leap);
-    ++year;
-    return days_to_jan1 + 365 * (1970 - year) +
-           number_of_leap_years_before_1970(year) + is_leap_year(year);
+    return -days_from_civil(year, month, day);
   }
 
   Date::Date(const std::string &m, int d, int yyyy) {
@@ -335,10 +325,7 @@ namespace BOOM {
   int Date::year() const { return year_; }
 
   DayNames Date::day_of_week() const {
-    // Jan 1 1970 was a Thursday.  So computing the day of week means taking the
-    // julian date mod 7, then subtracting 4.
-    int day = days_after_origin_ % 7;
-    return DayNames((day + 4) % 7);
+    return BOOM::day_of_week(days_after_origin_);
   }
 
   time_t Date::to_time_t() const {
@@ -721,6 +708,48 @@ namespace BOOM {
   }
 
   //============================================================
+  std::vector<Date> dates_from_days(const std::vector<int> &days) {
+    std::vector<Date> ans;
+    ans.reserve(days.size());
+    for (int d : days) {
+      ans.emplace_back(d);
+    }
+    return ans;
+  }
+
+  std::vector<int> days_after_jan_1_1970(const std::vector<Date> &dates) {
+    std::vector<int> ans(dates.size());
+    for (size_t i = 0; i < dates.size(); ++i) {
+      ans[i] = dates[i].days_after_jan_1_1970();
+    }
+    return ans;
+  }
+
+  std::vector<DayNames> days_of_week(const std::vector<int> &days) {
+    std::vector<DayNames> ans(days.size());
+    for (size_t i = 0; i < days.size(); ++i) {
+      ans[i] = day_of_week(days[i]);
+    }
+    return ans;
+  }
+
+  void decompose_days(const std::vector<int> &days,
+                      std::vector<int> *years,
+                      std::vector<MonthNames> *months,
+                      std::vector<int> *days_of_month) {
+    if (years) years->resize(days.size());
+    if (months) months->resize(days.size());
+    if (days_of_month) days_of_month->resize(days.size());
+    int year, day;
+    MonthNames month;
+    for (size_t i = 0; i < days.size(); ++i) {
+      Date::civil_from_days(days[i], &year, &month, &day);
+      if (years) (*years)[i] = year;
+      if (months) (*months)[i] = month;
+      if (days_of_month) (*days_of_month)[i] = day;
+    }
+  }
+
   Date nth_weekday_in_month(int n, DayNames weekday, MonthNames month,
                             int year) {
     if (n < 1) report_error("n must be >= 1 in nth_weekday_in_month");
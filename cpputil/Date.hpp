@@ -22,6 +22,7 @@
 
 #include <string>
 #include <ctime>
+#include <vector>
 #include "uint.hpp"
 #include <ctime>
 
@@ -193,6 +194,13 @@ namespace BOOM {
     static void find_month_and_day(int days_into_year, bool leap,
                                    MonthNames *month, int *day);
 
+    // Constant time conversions between calendar dates (in the proleptic
+    // Gregorian calendar) and the number of days after Jan 1, 1970, which
+    // is negative for earlier dates.
+    static long days_from_civil(int year, MonthNames month, int day);
+    static void civil_from_days(long days_after_jan_1_1970, int *year,
+                                MonthNames *month, int *day);
+
    private:
     MonthNames month_;
     int day_;
@@ -216,7 +224,6 @@ namespace BOOM {
 
     Date &start_next_month();
     Date &end_prev_month();
-    Date &set_before_1970(int days_before_jan_1_1970);
 
     void check(MonthNames month, int day, int four_digit_year) const;
     static int compute_local_time_zone();
@@ -233,6 +240,29 @@ namespace BOOM {
   // last_weekday_in_month(Fri, Feb, 2006);
   Date last_weekday_in_month(DayNames weekday, MonthNames month, int year);
 
+  // The day of the week for a date expressed as days after Jan 1, 1970 (a
+  // Thursday).  Valid for negative day counts as well.
+  inline DayNames day_of_week(long days_after_jan_1_1970) {
+    long remainder = (days_after_jan_1_1970 + 4) % 7;
+    return DayNames(remainder < 0 ? remainder + 7 : remainder);
+  }
+
+  //======================================================================
+  // Vectorized calendar functions, for processing long sequences of
+  // timestamps.  Day counts are days after Jan 1, 1970, which is how R
+  // stores Date objects.
+  std::vector<Date> dates_from_days(const std::vector<int> &days);
+  std::vector<int> days_after_jan_1_1970(const std::vector<Date> &dates);
+  std::vector<DayNames> days_of_week(const std::vector<int> &days);
+
+  // Split each day count into its calendar components.  Any of the output
+  // arguments can be nullptr if that component is not needed.  Non-null
+  // outputs are resized to match 'days'.
+  void decompose_days(const std::vector<int> &days,
+                      std::vector<int> *years,
+                      std::vector<MonthNames> *months,
+                      std::vector<int> *days_of_month);
+
   std::ostream &operator<<(std::ostream &, const Date &d);
   std::ostream &display(std::ostream &, DayNames,
                         calendar_format = Abbreviations);
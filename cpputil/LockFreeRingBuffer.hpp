@@ -0,0 +1,138 @@
+#ifndef BOOM_CPPUTIL_LOCK_FREE_RING_BUFFER_HPP_
+#define BOOM_CPPUTIL_LOCK_FREE_RING_BUFFER_HPP_
+
+// Copyright 2018 Google LLC. All Rights Reserved.
+/*
+  Copyright (C) 2005-2024 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+namespace BOOM {
+
+  // A bounded queue that any number of threads can push to and pop from
+  // without locks.  This is Dmitry Vyukov's bounded MPMC queue: each cell
+  // carries a sequence number telling producers and consumers whether the
+  // cell is free to write or ready to read, so a push or pop costs one
+  // compare-and-swap on a shared position plus a store to the cell.
+  //
+  // push() fails rather than blocking when the buffer is full, and pop()
+  // fails when it is empty, so neither call can stall a thread doing
+  // useful work.
+  //
+  // T must be default constructible and copy assignable.
+  template <class T>
+  class LockFreeRingBuffer {
+   public:
+    // Args:
+    //   capacity: The maximum number of elements held at once.  It is
+    //     rounded up to a power of 2 (with a minimum of 2).
+    explicit LockFreeRingBuffer(std::size_t capacity)
+        : capacity_(round_up_to_power_of_two(capacity)),
+          mask_(capacity_ - 1),
+          cells_(new Cell[capacity_]),
+          enqueue_position_(0),
+          dequeue_position_(0) {
+      for (std::size_t i = 0; i < capacity_; ++i) {
+        cells_[i].sequence.store(i, std::memory_order_relaxed);
+      }
+    }
+
+    LockFreeRingBuffer(const LockFreeRingBuffer &rhs) = delete;
+    LockFreeRingBuffer &operator=(const LockFreeRingBuffer &rhs) = delete;
+
+    // Add 'value' to the back of the queue.  Returns false, leaving the
+    // queue unchanged, if the queue is full.
+    bool push(const T &value) {
+      Cell *cell;
+      std::size_t position = enqueue_position_.load(std::memory_order_relaxed);
+      while (true) {
+        cell = &cells_[position & mask_];
+        std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        std::ptrdiff_t difference = static_cast<std::ptrdiff_t>(sequence)
+            - static_cast<std::ptrdiff_t>(position);
+        if (difference == 0) {
+          if (enqueue_position_.compare_exchange_weak(
+                  position, position + 1, std::memory_order_relaxed)) {
+            break;
+          }
+        } else if (difference < 0) {
+          return false;
+        } else {
+          position = enqueue_position_.load(std::memory_order_relaxed);
+        }
+      }
+      cell->value = value;
+      cell->sequence.store(position + 1, std::memory_order_release);
+      return true;
+    }
+
+    // Remove the element at the front of the queue and store it in 'value'.
+    // Returns false, leaving 'value' unchanged, if the queue is empty.
+    bool pop(T &value) {
+      Cell *cell;
+      std::size_t position = dequeue_position_.load(std::memory_order_relaxed);
+      while (true) {
+        cell = &cells_[position & mask_];
+        std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        std::ptrdiff_t difference = static_cast<std::ptrdiff_t>(sequence)
+            - static_cast<std::ptrdiff_t>(position + 1);
+        if (difference == 0) {
+          if (dequeue_position_.compare_exchange_weak(
+                  position, position + 1, std::memory_order_relaxed)) {
+            break;
+          }
+        } else if (difference < 0) {
+          return false;
+        } else {
+          position = dequeue_position_.load(std::memory_order_relaxed);
+        }
+      }
+      value = cell->value;
+      cell->sequence.store(position + mask_ + 1, std::memory_order_release);
+      return true;
+    }
+
+    std::size_t capacity() const { return capacity_; }
+
+   private:
+    struct Cell {
+      std::atomic<std::size_t> sequence;
+      T value;
+    };
+
+    static std::size_t round_up_to_power_of_two(std::size_t n) {
+      std::size_t ans = 2;
+      while (ans < n) ans *= 2;
+      return ans;
+    }
+
+    std::size_t capacity_;
+    std::size_t mask_;
+    std::unique_ptr<Cell[]> cells_;
+
+    // The producer and consumer positions are kept on separate cache lines so
+    // that pushing and popping threads do not contend.
+    alignas(64) std::atomic<std::size_t> enqueue_position_;
+    alignas(64) std::atomic<std::size_t> dequeue_position_;
+  };
+
+}  // namespace BOOM
+
+#endif  // BOOM_CPPUTIL_LOCK_FREE_RING_BUFFER_HPP_
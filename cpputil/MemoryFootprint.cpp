@@ -0,0 +1,51 @@
+// Copyright 2018 Google LLC. All Rights Reserved.
+/*
+  Copyright (C) 2005-2024 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include "cpputil/MemoryFootprint.hpp"
+
+namespace BOOM {
+
+  void MemoryFootprint::add(const MemoryFootprint &other) {
+    for (const auto &el : other.bytes_) {
+      bytes_[el.first] += el.second;
+    }
+  }
+
+  std::size_t MemoryFootprint::bytes(const std::string &category) const {
+    auto it = bytes_.find(category);
+    return it == bytes_.end() ? 0 : it->second;
+  }
+
+  std::size_t MemoryFootprint::total() const {
+    std::size_t ans = 0;
+    for (const auto &el : bytes_) {
+      ans += el.second;
+    }
+    return ans;
+  }
+
+  std::ostream &MemoryFootprint::print(std::ostream &out) const {
+    for (const auto &el : bytes_) {
+      out << el.first << ": " << el.second << " bytes\n";
+    }
+    out << "total: " << total() << " bytes\n";
+    return out;
+  }
+
+}  // namespace BOOM
@@ -0,0 +1,93 @@
+// Copyright 2018 Google LLC. All Rights Reserved.
+/*
+  Copyright (C) 2005-2024 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#ifndef BOOM_CPPUTIL_MEMORY_FOOTPRINT_HPP_
+#define BOOM_CPPUTIL_MEMORY_FOOTPRINT_HPP_
+
+#include <cstddef>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace BOOM {
+
+  // An estimate of the memory used by an object (e.g. a model and its data),
+  // in bytes, broken down by category.  Categories are free-form strings, but
+  // the standard ones used throughout the library are given below so that
+  // footprints from different objects can be added together.
+  //
+  // The estimates count the objects themselves plus the heap storage they
+  // own.  Allocator overhead and storage shared with other objects through
+  // pointers that the object does not own are not counted.
+  class MemoryFootprint {
+   public:
+    static constexpr const char *kParameters = "parameters";
+    static constexpr const char *kData = "data";
+    static constexpr const char *kSufficientStatistics =
+        "sufficient_statistics";
+    static constexpr const char *kKalmanFilter = "kalman_filter";
+    static constexpr const char *kState = "state";
+    static constexpr const char *kMcmcOutput = "mcmc_output";
+
+    MemoryFootprint() {}
+    MemoryFootprint(const std::string &category, std::size_t bytes) {
+      add(category, bytes);
+    }
+
+    // Add 'bytes' to the given category.
+    void add(const std::string &category, std::size_t bytes) {
+      bytes_[category] += bytes;
+    }
+
+    // Add each category in 'other' to the corresponding category here.
+    void add(const MemoryFootprint &other);
+
+    // The number of bytes in the given category, which is zero if the
+    // category is absent.
+    std::size_t bytes(const std::string &category) const;
+
+    // The number of bytes in all categories.
+    std::size_t total() const;
+
+    const std::map<std::string, std::size_t> &categories() const {
+      return bytes_;
+    }
+
+    std::ostream &print(std::ostream &out) const;
+
+   private:
+    std::map<std::string, std::size_t> bytes_;
+  };
+
+  inline std::ostream &operator<<(std::ostream &out,
+                                  const MemoryFootprint &footprint) {
+    return footprint.print(out);
+  }
+
+  // The heap storage owned by a std::vector.  Vector and other containers
+  // derived from std::vector can be passed directly.
+  template <class T>
+  std::size_t heap_bytes(const std::vector<T> &v) {
+    return v.capacity() * sizeof(T);
+  }
+
+}  // namespace BOOM
+
+#endif  // BOOM_CPPUTIL_MEMORY_FOOTPRINT_HPP_
@@ -24,31 +24,39 @@ namespace BOOM {
 
   PH::ParamHolder(const Ptr<Params> &held, Vector &Wsp)
       : storage_(Wsp), prm_(held) {
-    storage_ = prm_->vectorize(true);
+    storage_.resize(prm_->size(true));
+    prm_->vectorize_into(VectorView(storage_), true);
   }
 
   PH::ParamHolder(const Vector &x, const Ptr<Params> &held, Vector &Wsp)
       : storage_(Wsp), prm_(held) {
-    storage_ = prm_->vectorize(true);
-    prm_->unvectorize(x, true);
+    storage_.resize(prm_->size(true));
+    prm_->vectorize_into(VectorView(storage_), true);
+    prm_->unvectorize_from(ConstVectorView(x, 0, storage_.size()), true);
   }
 
-  PH::~ParamHolder() { prm_->unvectorize(storage_, true); }
+  PH::~ParamHolder() {
+    prm_->unvectorize_from(ConstVectorView(storage_), true);
+  }
 
   //------------------------------------------------------------
 
   typedef ParamVectorHolder PVH;
   PVH::ParamVectorHolder(const std::vector<Ptr<Params>> &held, Vector &Wsp)
-      : v(Wsp), prm(held) {}
+      : v(Wsp), layout_(held, true) {
+    v.resize(layout_.size());
+    layout_.vectorize(VectorView(v));
+  }
 
   PVH::ParamVectorHolder(const Vector &x,
                          const std::vector<Ptr<Params>> &held,
                          Vector &Wsp)
-      : v(Wsp), prm(held) {
-    v = vectorize(prm, true);
-    unvectorize(prm, x, true);
+      : v(Wsp), layout_(held, true) {
+    v.resize(layout_.size());
+    layout_.vectorize(VectorView(v));
+    layout_.unvectorize(ConstVectorView(x));
   }
 
-  PVH::~ParamVectorHolder() { unvectorize(prm, v, true); }
+  PVH::~ParamVectorHolder() { layout_.unvectorize(ConstVectorView(v)); }
 
 }  // namespace BOOM
@@ -20,7 +20,7 @@
 #define BOOM_PARAM_HOLDER_HPP
 
 #include "LinAlg/Vector.hpp"
-
+#include "Models/ParamTypes.hpp"
 #include "cpputil/Ptr.hpp"
 
 namespace BOOM {
@@ -39,7 +39,6 @@ namespace BOOM {
     double *source_;
   };
 
-  class Params;
   class ParamHolder {
    public:
     // Store the current value of held_prm in Wsp, to be restored when the
@@ -59,7 +58,10 @@ namespace BOOM {
     Ptr<Params> prm_;
   };
 
-  // For holding and restoring a vector of parameters.
+  // For holding and restoring a vector of parameters.  The parameter
+  // layout is computed once, and parameters whose values are unchanged when
+  // the holder goes out of scope are not reset, so their observers are not
+  // notified.
   class ParamVectorHolder {
    public:
     ParamVectorHolder(const std::vector<Ptr<Params>> &held, Vector &Wsp);
@@ -68,7 +70,7 @@ namespace BOOM {
 
    private:
     Vector &v;
-    std::vector<Ptr<Params>> prm;
+    ParamLayout layout_;
   };
 }  // namespace BOOM
 #endif  // BOOM_PARAM_HOLDER_HPP
@@ -46,53 +46,235 @@ namespace BOOM {
     return task_queue_.empty();
   }
 
+  //======================================================================
+  void WorkStealingTaskQueue::push(MoveOnlyTaskWrapper &&task) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tasks_.emplace_back(std::move(task));
+  }
+
+  bool WorkStealingTaskQueue::try_pop(MoveOnlyTaskWrapper &task) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (tasks_.empty()) return false;
+    task = std::move(tasks_.back());
+    tasks_.pop_back();
+    return true;
+  }
+
+  bool WorkStealingTaskQueue::try_steal(MoveOnlyTaskWrapper &task) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (tasks_.empty()) return false;
+    task = std::move(tasks_.front());
+    tasks_.pop_front();
+    return true;
+  }
+
+  bool WorkStealingTaskQueue::empty() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return tasks_.empty();
+  }
+
+  size_t WorkStealingTaskQueue::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return tasks_.size();
+  }
+
+  //======================================================================
+  namespace {
+    // Identifies the pool (if any) that owns the current thread, and the
+    // index of the current thread within that pool.  Used to route tasks
+    // submitted by worker threads onto the worker's own queue.
+    thread_local const void *current_pool = nullptr;
+    thread_local int current_worker_index = -1;
+  }  // namespace
+
+  void ThreadWorkerPool::ParallelForState::run_chunks(
+      const std::function<void(int)> &body) {
+    while (true) {
+      int chunk = next_chunk_++;
+      if (chunk >= number_of_chunks_) return;
+      int lo = begin_ + chunk * grain_;
+      int hi = std::min<int>(end_, lo + grain_);
+      std::exception_ptr error;
+      try {
+        for (int i = lo; i < hi; ++i) body(i);
+      } catch (...) {
+        error = std::current_exception();
+      }
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (error && !error_) error_ = error;
+      if (++completed_chunks_ == number_of_chunks_) {
+        all_done_.notify_all();
+      }
+    }
+  }
+
+  void ThreadWorkerPool::ParallelForState::wait() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    all_done_.wait(lock,
+                   [this]() { return completed_chunks_ == number_of_chunks_; });
+    if (error_) std::rethrow_exception(error_);
+  }
+
+  //======================================================================
   ThreadWorkerPool::ThreadWorkerPool(int number_of_threads)
-      : done_(false)
-  {
+      : done_(false), next_queue_(0), pending_tasks_(0), busy_workers_(0) {
+    // Tasks submitted before any threads are started wait here until
+    // add_threads() is called.
+    queues_.emplace_back(new WorkStealingTaskQueue);
     if (number_of_threads > 0) {
       add_threads(number_of_threads);
     }
   }
 
-  ThreadWorkerPool::~ThreadWorkerPool() { done_ = true; }
+  ThreadWorkerPool::~ThreadWorkerPool() { stop_threads(); }
 
   void ThreadWorkerPool::add_threads(int number_of_threads) {
-    try {
-      for (int i = 0; i < number_of_threads; ++i) {
-        threads_.push_back(std::thread(&ThreadWorkerPool::worker_thread, this));
-      }
-    } catch (...) {
-      done_ = true;
-      throw;
-    }
+    if (number_of_threads <= 0) return;
+    start_threads(number_of_joinable_threads() + number_of_threads);
   }
 
   void ThreadWorkerPool::set_number_of_threads(int n) {
     if (n <= 0) {
-      done_ = true;
-      threads_.clear();
+      stop_threads();
       return;
+    } else if (number_of_joinable_threads() < n) {
+      start_threads(n);
+    }
+  }
+
+  void ThreadWorkerPool::push_task(MoveOnlyTaskWrapper &&task) {
+    int index;
+    if (current_pool == this && current_worker_index >= 0) {
+      index = current_worker_index;
     } else {
-      int current_number_of_joinable_threads = 0;
-      done_ = false;
-      for (int i = 0; i < threads_.size(); ++i) {
-        current_number_of_joinable_threads += threads_[i].joinable();
+      index = next_queue_++ % queues_.size();
+    }
+    queues_[index]->push(std::move(task));
+    ++pending_tasks_;
+    // Taking the lock before notifying prevents a lost wakeup between a
+    // worker's check of pending_tasks_ and its call to wait().
+    std::lock_guard<std::mutex> lock(sleep_mutex_);
+    new_work_.notify_one();
+  }
+
+  bool ThreadWorkerPool::in_worker_thread() const {
+    return current_pool == this;
+  }
+
+  bool ThreadWorkerPool::find_task(int index, MoveOnlyTaskWrapper &task) {
+    if (queues_[index]->try_pop(task)) {
+      --pending_tasks_;
+      return true;
+    }
+    int nqueues = queues_.size();
+    for (int i = 1; i < nqueues; ++i) {
+      if (queues_[(index + i) % nqueues]->try_steal(task)) {
+        --pending_tasks_;
+        return true;
       }
-      if (current_number_of_joinable_threads < n) {
-        add_threads(n - current_number_of_joinable_threads);
+    }
+    return false;
+  }
+
+  void ThreadWorkerPool::stop_threads() {
+    {
+      std::lock_guard<std::mutex> lock(sleep_mutex_);
+      done_ = true;
+      new_work_.notify_all();
+    }
+    threads_.clear();
+  }
+
+  void ThreadWorkerPool::start_threads(int number_of_threads) {
+    stop_threads();
+    std::vector<MoveOnlyTaskWrapper> orphans;
+    for (auto &queue : queues_) {
+      MoveOnlyTaskWrapper task;
+      while (queue->try_steal(task)) orphans.emplace_back(std::move(task));
+    }
+    queues_.clear();
+    for (int i = 0; i < number_of_threads; ++i) {
+      queues_.emplace_back(new WorkStealingTaskQueue);
+    }
+    for (size_t i = 0; i < orphans.size(); ++i) {
+      queues_[i % number_of_threads]->push(std::move(orphans[i]));
+    }
+    done_ = false;
+    try {
+      for (int i = 0; i < number_of_threads; ++i) {
+        threads_.push_back(
+            std::thread(&ThreadWorkerPool::worker_thread, this, i));
       }
+    } catch (...) {
+      stop_threads();
+      throw;
     }
   }
 
-  void ThreadWorkerPool::worker_thread() {
+  void ThreadWorkerPool::worker_thread(int index) {
+    current_pool = this;
+    current_worker_index = index;
     while (!done_) {
       MoveOnlyTaskWrapper task;
-      if (work_queue_.wait_and_pop(task)) {
+      if (find_task(index, task)) {
+        ++busy_workers_;
         task();
+        --busy_workers_;
       } else {
-        std::this_thread::yield();
+        std::unique_lock<std::mutex> lock(sleep_mutex_);
+        new_work_.wait(lock,
+                       [this]() { return done_ || pending_tasks_ > 0; });
+      }
+    }
+    current_pool = nullptr;
+    current_worker_index = -1;
+  }
+
+  //======================================================================
+  namespace {
+    std::mutex global_pool_mutex;
+    int global_pool_size = -1;
+    std::atomic<bool> global_pool_started(false);
+
+    int default_global_pool_size() {
+      int ans = std::thread::hardware_concurrency();
+      return ans > 0 ? ans : 1;
+    }
+
+    ThreadWorkerPool &global_pool_instance() {
+      static ThreadWorkerPool pool;
+      return pool;
+    }
+  }  // namespace
+
+  ThreadWorkerPool &global_thread_pool() {
+    ThreadWorkerPool &pool(global_pool_instance());
+    if (!global_pool_started) {
+      std::lock_guard<std::mutex> lock(global_pool_mutex);
+      if (!global_pool_started) {
+        if (global_pool_size < 0) global_pool_size = default_global_pool_size();
+        pool.set_number_of_threads(global_pool_size);
+        global_pool_started = true;
       }
     }
+    return pool;
+  }
+
+  void set_global_thread_pool_size(int number_of_threads) {
+    std::lock_guard<std::mutex> lock(global_pool_mutex);
+    global_pool_size = std::max<int>(number_of_threads, 0);
+    if (global_pool_started) {
+      // The pool is already running.  Restart it at the new size.
+      ThreadWorkerPool &pool(global_pool_instance());
+      pool.set_number_of_threads(0);
+      pool.set_number_of_threads(global_pool_size);
+    }
+  }
+
+  int global_thread_pool_size() {
+    std::lock_guard<std::mutex> lock(global_pool_mutex);
+    if (global_pool_size < 0) global_pool_size = default_global_pool_size();
+    return global_pool_size;
   }
 
 }  // namespace BOOM
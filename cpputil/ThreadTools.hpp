@@ -20,13 +20,19 @@
   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
 */
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <condition_variable>
+#include <deque>
+#include <exception>
 #include <functional>
 #include <future>
+#include <memory>
 #include <mutex>
 #include <queue>
 #include <thread>
+#include <vector>
 
 // The main object defined here is the ThreadWorkerPool.  Before defining that
 // object, we must first define some building blocks.
@@ -149,8 +155,44 @@ namespace BOOM {
   };
 
   //======================================================================
-  // Manages a collection of threads and a ThreadSafeTaskQueue for
-  // passing work to them.
+  // A double ended task queue owned by a single worker thread in a
+  // ThreadWorkerPool.  The owning thread pushes and pops from the back of the
+  // queue (LIFO, which keeps recently produced work in a warm cache).  Other
+  // threads with nothing to do "steal" work from the front of the queue
+  // (FIFO, which tends to grab the largest outstanding pieces of work).
+  //
+  // Each queue has its own mutex, so contention is limited to the owner and
+  // whichever thieves happen to be visiting the same queue at the same time.
+  class WorkStealingTaskQueue {
+   public:
+    // Add a task to the back of the queue.
+    void push(MoveOnlyTaskWrapper &&task);
+
+    // Pop a task from the back of the queue.  Returns true if a task was
+    // placed in the argument, and false if the queue was empty.  Never
+    // blocks waiting for work.
+    bool try_pop(MoveOnlyTaskWrapper &task);
+
+    // Remove a task from the front of the queue.  Returns true if a task was
+    // placed in the argument, and false if the queue was empty.  Never
+    // blocks waiting for work.
+    bool try_steal(MoveOnlyTaskWrapper &task);
+
+    bool empty() const;
+    size_t size() const;
+
+   private:
+    mutable std::mutex mutex_;
+    std::deque<MoveOnlyTaskWrapper> tasks_;
+  };
+
+  //======================================================================
+  // Manages a collection of threads, each of which owns a
+  // WorkStealingTaskQueue.  Work submitted from outside the pool is dealt
+  // round-robin to the worker queues.  Work submitted by a worker thread
+  // (e.g. nested parallelism) goes on that worker's own queue.  A worker that
+  // runs out of work steals from its siblings, and sleeps on a condition
+  // variable when the whole pool is idle.
   //
   // The idiom for using this is:
   //
@@ -166,6 +208,10 @@ namespace BOOM {
   //
   // Note that the call to futures[i].get() passes any exceptions
   // encountered by worker threads back to the calling thread.
+  //
+  // Loops over an index range can use parallel_for instead:
+  //
+  // pool.parallel_for(0, n, 16, [&](int i) {do_work_on(i);});
   class ThreadWorkerPool {
    public:
     // Start a worker pool with the given number of threads.
@@ -196,14 +242,64 @@ namespace BOOM {
     //   remote thread completes, or an exception is thrown.  If an
     //   exception is thrown by the remote thread then wait() passes
     //   it to the current thread.
+    //
+    // If submit() is called by one of the pool's own worker threads while
+    // every worker is busy, the task is run immediately in the calling
+    // thread.  This keeps nested parallel code from queueing work that no
+    // thread is free to pick up.
     template <typename FunctionType>
     std::future<void> submit(FunctionType work) {
       std::packaged_task<void()> task(std::move(work));
       std::future<void> res(task.get_future());
-      work_queue_.push(std::move(task));
+      if (in_worker_thread() && saturated()) {
+        task();
+      } else {
+        push_task(MoveOnlyTaskWrapper(std::move(task)));
+      }
       return res;
     }
 
+    // Call body(i) for each i in [begin, end), distributing the work across
+    // the pool.
+    //
+    // Args:
+    //   begin, end:  The half open range of indices to iterate over.
+    //   grain: The number of consecutive indices handled by a single task.
+    //     Larger values reduce scheduling overhead.  Smaller values improve
+    //     load balance.  Values less than 1 are treated as 1.
+    //   body: A function-like object with signature void(int).
+    //
+    // The calling thread participates in the work, so it is safe to call
+    // parallel_for from inside a task running on this pool.  The call
+    // returns once every index has been processed.  If any call to body
+    // throws, the first exception is rethrown in the calling thread after
+    // the remaining work has drained.
+    template <typename Body>
+    void parallel_for(int begin, int end, int grain, Body body) {
+      if (end <= begin) return;
+      if (grain < 1) grain = 1;
+      int number_of_chunks = 1 + (end - begin - 1) / grain;
+      if (no_threads() || number_of_chunks == 1) {
+        for (int i = begin; i < end; ++i) body(i);
+        return;
+      }
+      std::shared_ptr<ParallelForState> state(
+          new ParallelForState(begin, end, grain, number_of_chunks));
+      std::function<void(int)> shared_body(std::move(body));
+      std::function<void()> chunk_runner = [state, shared_body]() {
+        state->run_chunks(shared_body);
+      };
+      int number_of_helpers =
+          (in_worker_thread() && saturated())
+              ? 0
+              : std::min<int>(number_of_threads(), number_of_chunks - 1);
+      for (int i = 0; i < number_of_helpers; ++i) {
+        push_task(MoveOnlyTaskWrapper(std::function<void()>(chunk_runner)));
+      }
+      chunk_runner();
+      state->wait();
+    }
+
     // Returns true() if there are currently no threads available to
     // do work.  Worker threads can be added by calling add_threads().
     bool no_threads() const { return threads_.empty(); }
@@ -218,20 +314,172 @@ namespace BOOM {
       return ans;
     }
 
+    // The number of tasks that have been submitted but not yet started.
+    int number_of_pending_tasks() const { return pending_tasks_; }
+
+    // Returns true if the calling thread is one of this pool's workers.
+    bool in_worker_thread() const;
+
+    // Returns true if every worker thread is currently running a task.
+    bool saturated() const { return busy_workers_ >= number_of_threads(); }
+
    private:
+    // Book keeping shared by the tasks making up a single call to
+    // parallel_for.  Chunks are claimed dynamically through an atomic
+    // counter, so threads that arrive late (or never) do not hold up the
+    // calling thread.
+    class ParallelForState {
+     public:
+      ParallelForState(int begin, int end, int grain, int number_of_chunks)
+          : begin_(begin),
+            end_(end),
+            grain_(grain),
+            number_of_chunks_(number_of_chunks),
+            next_chunk_(0),
+            completed_chunks_(0) {}
+
+      // Claim and process chunks until there are none left.
+      void run_chunks(const std::function<void(int)> &body);
+
+      // Block until every chunk has been processed.  Rethrows the first
+      // exception (if any) produced by the loop body.
+      void wait();
+
+     private:
+      int begin_;
+      int end_;
+      int grain_;
+      int number_of_chunks_;
+      std::atomic<int> next_chunk_;
+      int completed_chunks_;
+      std::exception_ptr error_;
+      std::mutex mutex_;
+      std::condition_variable all_done_;
+    };
+
+    // Place a task on a worker queue and wake a sleeping worker.
+    void push_task(MoveOnlyTaskWrapper &&task);
+
+    // Look for work, first in the queue owned by worker 'index' and then in
+    // the queues owned by other workers.  Returns true iff a task was found.
+    bool find_task(int index, MoveOnlyTaskWrapper &task);
+
+    // Join all worker threads.  Any tasks that have not started remain in
+    // the worker queues.
+    void stop_threads();
+
+    // Start the requested number of worker threads.  Tasks currently in the
+    // queues are redistributed to the new set of workers.
+    void start_threads(int number_of_threads);
+
     // A flag indicating that worker threads should shut down.
     std::atomic_bool done_;
 
-    // A queue for passing work to worker threads.
-    ThreadSafeTaskQueue work_queue_;
+    // One queue per worker thread.  The set of queues is only modified when
+    // no worker threads are running.
+    std::vector<std::unique_ptr<WorkStealingTaskQueue>> queues_;
+
+    // Round robin counter used to deal externally submitted work to the
+    // worker queues.
+    std::atomic<unsigned int> next_queue_;
+
+    // The number of tasks sitting in worker queues.  Used to decide whether
+    // idle workers may go to sleep.
+    std::atomic<int> pending_tasks_;
+
+    // The number of worker threads currently running a task.
+    std::atomic<int> busy_workers_;
+
+    // Idle workers block on new_work_ until pending_tasks_ is positive or
+    // the pool is shutting down.
+    std::mutex sleep_mutex_;
+    std::condition_variable new_work_;
 
     // The collection of worker threads.
     ThreadVector threads_;
 
-    // A thread to run in the background.  Continually checks to see
-    // if there is work in the queue.  If it finds a task then do it,
-    // otherwise yield to the next thread.
-    void worker_thread();
+    // The main loop run by each worker thread.  Runs tasks until told to
+    // shut down, sleeping when there is no work in the pool.
+    void worker_thread(int index);
+  };
+
+  //======================================================================
+  // A process-wide ThreadWorkerPool shared by every model and sampler that
+  // does its work through a SharedThreadPool.  The pool's threads are
+  // started the first time it is needed.  Sharing one pool keeps nested
+  // models (e.g. a hierarchical model whose children impute with threads)
+  // from creating many more threads than there are cores.
+  ThreadWorkerPool &global_thread_pool();
+
+  // Set the number of threads in the global pool.  The default is
+  // std::thread::hardware_concurrency().  A value of zero (or less) makes all
+  // SharedThreadPool objects run their work in the calling thread.  Resizing
+  // the pool waits for running tasks to finish, so this should be called
+  // while no parallel work is in flight (typically once at startup).
+  void set_global_thread_pool_size(int number_of_threads);
+
+  // The number of threads the global pool has (or will have once started).
+  int global_thread_pool_size();
+
+  //======================================================================
+  // A handle to the global_thread_pool() offering the same interface as
+  // ThreadWorkerPool, so that classes can switch from owning a private pool
+  // to sharing the global one by changing the type of a data member.
+  //
+  // The "number of threads" in a SharedThreadPool is the degree of
+  // parallelism requested by its owner.  It determines whether work is
+  // farmed out at all (no_threads()), but the threads themselves belong to
+  // the global pool, whose size caps the total concurrency in the process.
+  // Copies of a SharedThreadPool refer to the same global pool.
+  class SharedThreadPool {
+   public:
+    explicit SharedThreadPool(int number_of_threads = 0)
+        : number_of_threads_(std::max<int>(number_of_threads, 0)) {}
+
+    void add_threads(int number_of_additional_threads) {
+      number_of_threads_ += std::max<int>(number_of_additional_threads, 0);
+    }
+
+    void set_number_of_threads(int number_of_threads) {
+      number_of_threads_ = std::max<int>(number_of_threads, 0);
+    }
+
+    // Returns true if work submitted to this pool will be run in the calling
+    // thread, either because the owner asked for no threads or because the
+    // global pool has none.
+    bool no_threads() const {
+      return number_of_threads_ <= 0 || global_thread_pool_size() <= 0;
+    }
+
+    int number_of_threads() const { return number_of_threads_; }
+    int number_of_joinable_threads() const { return number_of_threads_; }
+
+    // Submit a job to the global pool.  If no_threads() the job is run
+    // immediately in the calling thread.  Either way the returned future
+    // behaves as in ThreadWorkerPool::submit.
+    template <typename FunctionType>
+    std::future<void> submit(FunctionType work) {
+      if (no_threads()) {
+        std::packaged_task<void()> task(std::move(work));
+        std::future<void> res(task.get_future());
+        task();
+        return res;
+      }
+      return global_thread_pool().submit(std::move(work));
+    }
+
+    // See ThreadWorkerPool::parallel_for.
+    template <typename Body>
+    void parallel_for(int begin, int end, int grain, Body body) {
+      if (no_threads()) {
+        for (int i = begin; i < end; ++i) body(i);
+      } else {
+        global_thread_pool().parallel_for(begin, end, grain, std::move(body));
+      }
+    }
+
+   private:
+    int number_of_threads_;
   };
 
 }  // namespace BOOM
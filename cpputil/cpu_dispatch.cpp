@@ -0,0 +1,51 @@
+/*
+  Copyright (C) 2005-2024 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include "cpputil/cpu_dispatch.hpp"
+
+namespace BOOM {
+
+  namespace {
+    CpuFeatures detect_cpu_features() {
+      CpuFeatures ans;
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+      __builtin_cpu_init();
+      ans.sse4_2 = __builtin_cpu_supports("sse4.2");
+      ans.avx2 = __builtin_cpu_supports("avx2");
+      ans.fma = __builtin_cpu_supports("fma");
+      ans.avx512f = __builtin_cpu_supports("avx512f");
+#endif
+      return ans;
+    }
+  }  // namespace
+
+  const CpuFeatures &cpu_features() {
+    static const CpuFeatures features = detect_cpu_features();
+    return features;
+  }
+
+  std::string simd_dispatch_target() {
+    if (!BOOM_HAVE_MULTIVERSIONING) return "default";
+    const CpuFeatures &features(cpu_features());
+    if (features.avx512f) return "avx512f";
+    if (features.avx2) return "avx2";
+    if (features.sse4_2) return "sse4.2";
+    return "default";
+  }
+
+}  // namespace BOOM
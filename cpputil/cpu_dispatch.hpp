@@ -0,0 +1,99 @@
+#ifndef BOOM_CPPUTIL_CPU_DISPATCH_HPP_
+#define BOOM_CPPUTIL_CPU_DISPATCH_HPP_
+
+/*
+  Copyright (C) 2005-2024 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include <cstdlib>
+#include <string>
+
+// Runtime selection of SIMD instruction sets for hot loops.
+//
+// The Python and R packages are built with generic compiler flags, so that
+// one binary runs on any x86-64 machine.  That limits the compiler to SSE2.
+// Marking a function BOOM_TARGET_CLONES asks the compiler to build one copy
+// of the function for each instruction set in the list below, and to pick
+// the best copy the first time the function is called, based on the CPU the
+// program is running on.
+//
+// The attribute is worth applying only to functions that are mostly a
+// simple loop over contiguous memory that the compiler can vectorize.  The
+// loop should be self contained: a cloned function is never inlined, and
+// under GCC other functions are not inlined into it, so a loop that calls
+// a helper (or a libm function like std::log) is not vectorized.  Code
+// built on Eigen gains nothing from the attribute: Eigen chooses its packet
+// size from preprocessor flags at compile time.
+//
+// Reductions are not reordered, and under GCC multiply-adds are not fused,
+// so each clone does the same floating point operations in the same order
+// as the generic version and gets the same answer on every machine.  Clang
+// may fuse multiply-adds in the avx512f clone, which can change the last
+// bit of a result.
+//
+// Multiversioning relies on the ELF "ifunc" mechanism, so it is used only
+// by GCC and clang on x86-64 Linux with glibc.  Elsewhere the macro expands
+// to nothing.  Defining BOOM_NO_MULTIVERSIONING turns it off everywhere,
+// e.g. to rule it out when debugging.
+
+#define BOOM_CLONED_INSTRUCTION_SETS "default", "sse4.2", "avx2", "avx512f"
+
+#if !defined(BOOM_NO_MULTIVERSIONING) && defined(__x86_64__) && \
+    defined(__linux__) && defined(__GLIBC__)
+#if defined(__clang__) && __clang_major__ >= 14
+#define BOOM_HAVE_MULTIVERSIONING 1
+#define BOOM_TARGET_CLONES \
+  __attribute__((target_clones(BOOM_CLONED_INSTRUCTION_SETS)))
+#elif !defined(__clang__) && defined(__GNUC__) && __GNUC__ >= 6
+// Before version 12 GCC does not vectorize at -O2, which is what R and
+// most Python distributions build with, and from version 12 it vectorizes
+// only loops with no runtime alias checks.  The kernels ask for full
+// vectorization explicitly.
+#define BOOM_HAVE_MULTIVERSIONING 1
+#define BOOM_TARGET_CLONES                                     \
+  __attribute__((target_clones(BOOM_CLONED_INSTRUCTION_SETS), \
+                 optimize("tree-vectorize", "fp-contract=off")))
+#endif
+#endif
+
+#ifndef BOOM_HAVE_MULTIVERSIONING
+#define BOOM_HAVE_MULTIVERSIONING 0
+#define BOOM_TARGET_CLONES
+#endif
+
+namespace BOOM {
+
+  // The SIMD extensions supported by the CPU the program is running on.  All
+  // are false on platforms other than x86-64.
+  struct CpuFeatures {
+    bool sse4_2 = false;
+    bool avx2 = false;
+    bool fma = false;
+    bool avx512f = false;
+  };
+
+  const CpuFeatures &cpu_features();
+
+  // The name of the instruction set used by BOOM_TARGET_CLONES functions
+  // on this machine: one of "avx512f", "avx2", "sse4.2", or "default".  If
+  // multiversioning is unavailable this is always "default".  Intended for
+  // diagnostic messages and bug reports.
+  std::string simd_dispatch_target();
+
+}  // namespace BOOM
+
+#endif  // BOOM_CPPUTIL_CPU_DISPATCH_HPP_
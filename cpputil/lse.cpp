@@ -16,28 +16,78 @@
   License along with this library; if not, write to the Free Software
   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
 */
-#include "LinAlg/Vector.hpp"
+#include "cpputil/lse.hpp"
 
 #include <cmath>
+#include "LinAlg/EigenMap.hpp"
 #include "cpputil/math_utils.hpp"
 #include "cpputil/report_error.hpp"
 
 namespace BOOM {
 
-  double lse_safe(const Vector &eta) {
-    double m = eta.max();
-    if (m == negative_infinity()) return m;
-    double tmp = 0;
-    uint n = eta.size();
-    for (uint i = 0; i < n; ++i) {
-      tmp += exp(eta[i] - m);
+  namespace {
+    // Shifted log probabilities below this value have exponentials that are
+    // zero or subnormal in double precision.  Eigen's exp clamps its argument
+    // near here, so smaller values (including -infinity) are set to zero
+    // explicitly.
+    constexpr double kUnderflow = -708.0;
+
+    // exp(x) for an Eigen array expression x with elements <= 0.
+    template <class ARRAY>
+    Eigen::ArrayXXd exp_nonpositive(const ARRAY &x, bool approximate) {
+      if (approximate) {
+        return x.template cast<float>().exp().template cast<double>();
+      } else {
+        return (x < kUnderflow).select(0.0, x.exp());
+      }
     }
-    if (tmp > 0) {
-      return m + log(tmp);
-    } else {
-      return negative_infinity();
+
+    // Set ans = exp(x - shift) and return the sum of ans.  'ans' may be the
+    // same as 'x'.
+    double exp_shifted(const ConstVectorView &x, double shift, VectorView ans,
+                       bool approximate) {
+      Eigen::ArrayXXd values =
+          exp_nonpositive(EigenMap(x).array() - shift, approximate);
+      EigenMap(ans).array() = values.col(0);
+      return values.sum();
     }
-  }
+
+    double lse_impl(const Vector &x, bool approximate) {
+      if (x.empty()) return negative_infinity();
+      double max_value = x.max();
+      if (max_value == negative_infinity()) return max_value;
+      Vector workspace(x.size());
+      double total =
+          exp_shifted(x, max_value, VectorView(workspace), approximate);
+      if (total > 0) {
+        return max_value + std::log(total);
+      } else {
+        return negative_infinity();
+      }
+    }
+
+    // Compute the row-wise maxima of log_prob, and the row-wise sums of
+    // exp(log_prob - max).  If 'normalized' is non-NULL the exponentials
+    // are stored there.  Eigen evaluates the row-wise operations a column at
+    // a time, so the inner loops run over contiguous memory.
+    void row_maxima_and_sums(const Matrix &log_prob, Matrix *normalized,
+                             Vector &maxima, Vector &sums, bool approximate) {
+      auto values = EigenMap(log_prob).array();
+      maxima.resize(log_prob.nrow());
+      sums.resize(log_prob.nrow());
+      EigenMap(maxima) = values.rowwise().maxCoeff();
+      Eigen::ArrayXXd exponentials = exp_nonpositive(
+          values.colwise() - EigenMap(maxima).array(), approximate);
+      EigenMap(sums) = exponentials.rowwise().sum();
+      if (normalized) {
+        EigenMap(*normalized).array() = exponentials;
+      }
+    }
+  }  // namespace
+
+  double lse_safe(const Vector &eta) { return lse_impl(eta, false); }
+
+  double lse_approximate(const Vector &eta) { return lse_impl(eta, true); }
 
   double lse_fast(const Vector &eta) {
     double ans = 0;
@@ -54,6 +104,37 @@ namespace BOOM {
 
   double lse(const Vector &eta) { return lse_safe(eta); }
 
+  double normalize_logprob_inplace(VectorView x, bool approximate) {
+    if (x.size() == 0) {
+      report_error("normalize_logprob_inplace called for an empty vector.");
+    }
+    double max_value = x.max();
+    double total = exp_shifted(x, max_value, x, approximate);
+    x /= total;
+    return max_value + std::log(total);
+  }
+
+  Vector lse_rows(const Matrix &log_prob, bool approximate) {
+    Vector maxima, sums;
+    row_maxima_and_sums(log_prob, nullptr, maxima, sums, approximate);
+    for (int i = 0; i < maxima.size(); ++i) {
+      if (maxima[i] != negative_infinity()) {
+        maxima[i] += std::log(sums[i]);
+      }
+    }
+    return maxima;
+  }
+
+  Vector normalize_logprob_rows(Matrix &log_prob, bool approximate) {
+    Vector maxima, sums;
+    row_maxima_and_sums(log_prob, &log_prob, maxima, sums, approximate);
+    EigenMap(log_prob).array().colwise() /= EigenMap(sums).array();
+    for (int i = 0; i < maxima.size(); ++i) {
+      maxima[i] += std::log(sums[i]);
+    }
+    return maxima;
+  }
+
   double lde2(double x, double y) {
     if (x <= y) {
       if (x < y) {
@@ -0,0 +1,57 @@
+#include "gtest/gtest.h"
+#include <cmath>
+#include "cpputil/Constants.hpp"
+#include "cpputil/cpu_dispatch.hpp"
+#include "distributions.hpp"
+#include "distributions/vectorized_densities.hpp"
+#include "test_utils/test_utils.hpp"
+
+namespace {
+  using namespace BOOM;
+  using std::endl;
+
+  class CpuDispatchTest : public ::testing::Test {
+   protected:
+    CpuDispatchTest() {
+      GlobalRng::rng.seed(8675309);
+    }
+  };
+
+  TEST_F(CpuDispatchTest, TargetMatchesFeatures) {
+    const CpuFeatures &features(cpu_features());
+    std::string target = simd_dispatch_target();
+    if (!BOOM_HAVE_MULTIVERSIONING) {
+      EXPECT_EQ(target, "default");
+    } else if (features.avx512f) {
+      EXPECT_EQ(target, "avx512f");
+    } else if (features.avx2) {
+      EXPECT_EQ(target, "avx2");
+    } else if (features.sse4_2) {
+      EXPECT_EQ(target, "sse4.2");
+    } else {
+      EXPECT_EQ(target, "default");
+    }
+    // Every x86-64 CPU with AVX2 also has SSE 4.2.
+    if (features.avx2) {
+      EXPECT_TRUE(features.sse4_2);
+    }
+  }
+
+  // Whichever clone is chosen, the answer agrees with the scalar formula.
+  // The vector is long enough to reach the vectorized part of the loop, and
+  // has an odd length to reach the remainder.
+  TEST_F(CpuDispatchTest, ClonedKernelsMatchScalarCode) {
+    Vector x(1003);
+    x.randomize();
+    Vector ans = dnorm_vector(x, 0.3, 1.7);
+    const double log_normalizing_constant =
+        -Constants::log_root_2pi - std::log(1.7);
+    const double precision = 1.0 / (1.7 * 1.7);
+    for (int i = 0; i < x.size(); ++i) {
+      double z = x[i] - 0.3;
+      EXPECT_DOUBLE_EQ(ans[i],
+                       log_normalizing_constant - 0.5 * precision * z * z);
+    }
+  }
+
+}  // namespace
@@ -0,0 +1,92 @@
+#include "gtest/gtest.h"
+#include "cpputil/Date.hpp"
+#include "cpputil/DateTime.hpp"
+#include "test_utils/test_utils.hpp"
+
+namespace {
+  using namespace BOOM;
+  using std::endl;
+
+  TEST(DateTest, KnownDates) {
+    EXPECT_EQ(0, Date(Jan, 1, 1970).days_after_jan_1_1970());
+    EXPECT_EQ(-25567, Date(Jan, 1, 1900).days_after_jan_1_1970());
+    EXPECT_EQ(11016, Date(Feb, 29, 2000).days_after_jan_1_1970());
+    EXPECT_EQ(-135080, Date(Mar, 1, 1600).days_after_jan_1_1970());
+    EXPECT_EQ(47541, Date(Mar, 1, 2100).days_after_jan_1_1970());
+
+    EXPECT_EQ(Mon, Date(Jan, 1, 1900).day_of_week());
+    EXPECT_EQ(Tue, Date(Feb, 29, 2000).day_of_week());
+    EXPECT_EQ(Wed, Date(Mar, 1, 1600).day_of_week());
+    EXPECT_EQ(Thu, Date(Dec, 25, 1969).day_of_week());
+
+    Date date(-135080);
+    EXPECT_EQ(Mar, date.month());
+    EXPECT_EQ(1, date.day());
+    EXPECT_EQ(1600, date.year());
+  }
+
+  // Stepping one day at a time must agree with the constant time
+  // conversions, across leap years and century boundaries on both sides of
+  // 1970.
+  TEST(DateTest, ConversionsAgreeWithDayByDayStepping) {
+    int start = -150000;
+    int end = 150000;
+    int year = 1559;
+    MonthNames month = Apr;
+    int day = 26;
+    for (int days = start; days < end; ++days) {
+      Date date(days);
+      ASSERT_EQ(year, date.year()) << "days = " << days;
+      ASSERT_EQ(month, date.month()) << "days = " << days;
+      ASSERT_EQ(day, date.day()) << "days = " << days;
+      ASSERT_EQ(days, Date::days_from_civil(year, month, day));
+      ASSERT_EQ(days, Date::days_after_jan_1_1970(month, day, year));
+      ASSERT_EQ(-days, Date::days_before_jan_1_1970(month, day, year));
+      if (day < Date::days_in_month(month, Date::is_leap_year(year))) {
+        ++day;
+      } else {
+        day = 1;
+        if (month == Dec) ++year;
+        month = next(month);
+      }
+    }
+  }
+
+  TEST(DateTest, Arithmetic) {
+    Date date(Dec, 30, 1899);
+    date += 3;
+    EXPECT_EQ(Date(Jan, 2, 1900), date);
+    date -= 800;
+    EXPECT_EQ(Date(Oct, 24, 1897), date);
+    EXPECT_EQ(800, Date(Jan, 2, 1900) - date);
+
+    DateTime date_time(Date(Feb, 28, 2000), .75);
+    date_time += 0.5;
+    EXPECT_EQ(Date(Feb, 29, 2000), date_time.date());
+  }
+
+  TEST(DateTest, Vectorized) {
+    std::vector<int> days = {-25567, -7, 0, 11016, 47541};
+    std::vector<Date> dates = dates_from_days(days);
+    ASSERT_EQ(days.size(), dates.size());
+    EXPECT_EQ(Date(Jan, 1, 1900), dates[0]);
+    EXPECT_EQ(Date(Mar, 1, 2100), dates[4]);
+    EXPECT_EQ(days, days_after_jan_1_1970(dates));
+
+    std::vector<DayNames> weekdays = days_of_week(days);
+    std::vector<DayNames> expected_weekdays = {Mon, Thu, Thu, Tue, Mon};
+    EXPECT_EQ(expected_weekdays, weekdays);
+
+    std::vector<int> years;
+    std::vector<MonthNames> months;
+    std::vector<int> days_of_month;
+    decompose_days(days, &years, &months, &days_of_month);
+    EXPECT_EQ(std::vector<int>({1900, 1969, 1970, 2000, 2100}), years);
+    EXPECT_EQ(std::vector<MonthNames>({Jan, Dec, Jan, Feb, Mar}), months);
+    EXPECT_EQ(std::vector<int>({1, 25, 1, 29, 1}), days_of_month);
+
+    decompose_days(days, nullptr, &months, nullptr);
+    EXPECT_EQ(Feb, months[3]);
+  }
+
+}  // namespace
@@ -0,0 +1,72 @@
+#include "gtest/gtest.h"
+#include "cpputil/LockFreeRingBuffer.hpp"
+
+#include <thread>
+#include <vector>
+
+namespace {
+  using namespace BOOM;
+
+  TEST(LockFreeRingBufferTest, FifoAndCapacity) {
+    LockFreeRingBuffer<int> buffer(5);
+    EXPECT_EQ(8, buffer.capacity());
+    int value = -1;
+    EXPECT_FALSE(buffer.pop(value));
+    EXPECT_EQ(-1, value);
+    for (int i = 0; i < 8; ++i) {
+      EXPECT_TRUE(buffer.push(i));
+    }
+    EXPECT_FALSE(buffer.push(8));
+    for (int i = 0; i < 8; ++i) {
+      EXPECT_TRUE(buffer.pop(value));
+      EXPECT_EQ(i, value);
+    }
+    EXPECT_FALSE(buffer.pop(value));
+
+    // The buffer wraps around.
+    for (int round = 0; round < 5; ++round) {
+      EXPECT_TRUE(buffer.push(round));
+      EXPECT_TRUE(buffer.pop(value));
+      EXPECT_EQ(round, value);
+    }
+  }
+
+  // Several producers push concurrently while one consumer pops.  Every
+  // value arrives exactly once, and each producer's values arrive in order.
+  TEST(LockFreeRingBufferTest, ConcurrentProducers) {
+    LockFreeRingBuffer<int> buffer(64);
+    int nthreads = 4;
+    int per_thread = 20000;
+    std::vector<std::thread> producers;
+    for (int p = 0; p < nthreads; ++p) {
+      producers.emplace_back([&buffer, p, per_thread]() {
+        for (int i = 0; i < per_thread; ++i) {
+          while (!buffer.push(p * per_thread + i)) {
+            std::this_thread::yield();
+          }
+        }
+      });
+    }
+
+    std::vector<int> last(nthreads, -1);
+    int received = 0;
+    while (received < nthreads * per_thread) {
+      int value;
+      if (buffer.pop(value)) {
+        int producer = value / per_thread;
+        ASSERT_GT(value % per_thread, last[producer]);
+        last[producer] = value % per_thread;
+        ++received;
+      } else {
+        std::this_thread::yield();
+      }
+    }
+    for (auto &thread : producers) {
+      thread.join();
+    }
+    for (int p = 0; p < nthreads; ++p) {
+      EXPECT_EQ(per_thread - 1, last[p]);
+    }
+  }
+
+}  // namespace
@@ -48,25 +48,156 @@ namespace {
 
   TEST(threading, record_integers) {
     ThreadWorkerPool pool;
-    // int num_threads = 3;
-    // int num_tasks = 7;
-    // pool.add_threads(num_threads);
-    // std::vector<std::future<void>> futures;
-    // futures.reserve(num_tasks);
-
-    // std::vector<int> answers(num_tasks);
-    // for (size_t i = 0; i < num_tasks; ++i) {
-    //   futures.emplace_back(pool.submit(
-    //       [i, &answers]() {
-    //         answers[i] = i;
-    //       }));
-    // }
-    // for (auto &f : futures) {
-    //   f.get();
-    // }
-    // for (size_t i = 0; i < answers.size(); ++i) {
-    //   EXPECT_EQ(answers[i], i);
-    // }
+    int num_threads = 3;
+    int num_tasks = 7;
+    pool.add_threads(num_threads);
+    std::vector<std::future<void>> futures;
+    futures.reserve(num_tasks);
+
+    std::vector<int> answers(num_tasks);
+    for (size_t i = 0; i < num_tasks; ++i) {
+      futures.emplace_back(pool.submit(
+          [i, &answers]() {
+            answers[i] = i;
+          }));
+    }
+    for (auto &f : futures) {
+      f.get();
+    }
+    for (size_t i = 0; i < answers.size(); ++i) {
+      EXPECT_EQ(answers[i], i);
+    }
+  }
+
+  TEST(threading, tasks_submitted_before_threads_are_run) {
+    ThreadWorkerPool pool;
+    int value = 0;
+    std::future<void> future = pool.submit([&value]() {value = 17;});
+    EXPECT_EQ(1, pool.number_of_pending_tasks());
+    pool.add_threads(2);
+    future.get();
+    EXPECT_EQ(17, value);
+    EXPECT_EQ(0, pool.number_of_pending_tasks());
+  }
+
+  TEST(threading, exceptions_pass_through_futures) {
+    ThreadWorkerPool pool(2);
+    std::future<void> future = pool.submit(
+        []() {throw std::runtime_error("oops");});
+    EXPECT_THROW(future.get(), std::runtime_error);
+  }
+
+  TEST(threading, parallel_for) {
+    ThreadWorkerPool pool(4);
+    int n = 1000;
+    std::vector<int> answers(n, -1);
+    pool.parallel_for(0, n, 7, [&answers](int i) {answers[i] = i;});
+    for (int i = 0; i < n; ++i) {
+      EXPECT_EQ(i, answers[i]);
+    }
+
+    // An empty range is a no-op.
+    pool.parallel_for(10, 10, 3, [&answers](int i) {answers[i] = 0;});
+    EXPECT_EQ(10, answers[10]);
+
+    // parallel_for also works with no threads in the pool.
+    ThreadWorkerPool serial_pool;
+    std::vector<int> serial_answers(n, -1);
+    serial_pool.parallel_for(
+        0, n, 50, [&serial_answers](int i) {serial_answers[i] = 2 * i;});
+    for (int i = 0; i < n; ++i) {
+      EXPECT_EQ(2 * i, serial_answers[i]);
+    }
+  }
+
+  TEST(threading, nested_parallel_for) {
+    // Inner loops run on the same pool as the outer loop.  The calling
+    // threads participate in the work, so nesting does not deadlock.
+    ThreadWorkerPool pool(3);
+    int outer = 20;
+    int inner = 50;
+    std::vector<std::vector<int>> answers(outer, std::vector<int>(inner, 0));
+    pool.parallel_for(0, outer, 1, [&](int i) {
+        pool.parallel_for(0, inner, 4, [&answers, i](int j) {
+            answers[i][j] = i * j;
+          });
+      });
+    for (int i = 0; i < outer; ++i) {
+      for (int j = 0; j < inner; ++j) {
+        EXPECT_EQ(i * j, answers[i][j]);
+      }
+    }
+  }
+
+  TEST(threading, parallel_for_rethrows) {
+    ThreadWorkerPool pool(2);
+    std::atomic<int> count(0);
+    EXPECT_THROW(pool.parallel_for(0, 100, 1, [&count](int i) {
+          ++count;
+          if (i == 37) throw std::runtime_error("bad index");
+        }), std::runtime_error);
+    // The remaining work drains before the exception is rethrown.
+    EXPECT_EQ(100, count);
+  }
+
+  TEST(threading, resize_pool) {
+    ThreadWorkerPool pool(2);
+    EXPECT_EQ(2, pool.number_of_threads());
+    pool.set_number_of_threads(5);
+    EXPECT_EQ(5, pool.number_of_threads());
+    std::atomic<int> total(0);
+    pool.parallel_for(0, 100, 3, [&total](int i) {total += i;});
+    EXPECT_EQ(4950, total);
+    pool.set_number_of_threads(0);
+    EXPECT_TRUE(pool.no_threads());
+    pool.set_number_of_threads(1);
+    EXPECT_EQ(1, pool.number_of_threads());
+    pool.submit([&total]() {total = 0;}).get();
+    EXPECT_EQ(0, total);
+  }
+
+  TEST(threading, shared_thread_pool) {
+    // A SharedThreadPool with no threads runs work inline.
+    SharedThreadPool serial;
+    EXPECT_TRUE(serial.no_threads());
+    int value = 0;
+    serial.submit([&value]() {value = 3;}).get();
+    EXPECT_EQ(3, value);
+
+    set_global_thread_pool_size(3);
+    EXPECT_EQ(3, global_thread_pool_size());
+    SharedThreadPool a(4);
+    SharedThreadPool b(2);
+    EXPECT_FALSE(a.no_threads());
+    EXPECT_EQ(4, a.number_of_threads());
+
+    // Nested work submitted through several handles shares the global pool.
+    int n = 16;
+    std::vector<std::atomic<int>> counts(n);
+    for (auto &c : counts) c = 0;
+    std::vector<std::future<void>> futures;
+    for (int i = 0; i < n; ++i) {
+      futures.emplace_back(a.submit([&b, &counts, i]() {
+            std::vector<std::future<void>> inner;
+            for (int j = 0; j < 5; ++j) {
+              inner.emplace_back(b.submit([&counts, i]() {++counts[i];}));
+            }
+            for (auto &f : inner) f.get();
+          }));
+    }
+    for (auto &f : futures) f.get();
+    for (int i = 0; i < n; ++i) {
+      EXPECT_EQ(5, counts[i]);
+    }
+    EXPECT_EQ(3, global_thread_pool().number_of_threads());
+
+    // Setting the global pool size to zero makes everything serial.
+    set_global_thread_pool_size(0);
+    EXPECT_TRUE(a.no_threads());
+    a.submit([&value]() {value = 4;}).get();
+    EXPECT_EQ(4, value);
+    set_global_thread_pool_size(2);
+    EXPECT_FALSE(a.no_threads());
   }
 
 }  // namespace
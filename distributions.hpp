@@ -33,6 +33,7 @@
 #include "uint.hpp"
 
 namespace BOOM {
+  class Cholesky;
   class VectorView;
   class ConstVectorView;
 
@@ -197,6 +198,60 @@ namespace BOOM {
   int random_int(int lo, int hi);
   int random_int_mt(RNG &rng, int lo, int hi);
 
+  //===========================================================================
+  // Bulk random variate generation.  Each function fills its 'out' argument
+  // with independent draws from the named distribution, using the same
+  // parameterization as the scalar version.  The bulk versions generate
+  // their uniform deviates in blocks and transform them in tight loops that
+  // the compiler can vectorize, which is much faster than repeated scalar
+  // calls when many draws are needed.
+  //
+  // The bulk normal generator uses the Box-Muller transform, so its draws
+  // differ from those produced by repeated calls to the scalar rnorm_mt with
+  // the same seed.  The bulk uniform generator matches the scalar version
+  // draw for draw.
+  void runif_mt(RNG &rng, VectorView out, double lo = 0, double hi = 1);
+  void runif_mt(RNG &rng, Vector &out, double lo = 0, double hi = 1);
+  void rnorm_mt(RNG &rng, VectorView out, double mu = 0, double sigma = 1);
+  void rnorm_mt(RNG &rng, Vector &out, double mu = 0, double sigma = 1);
+
+  // Gamma deviates with shape a and rate b (mean a / b), simulated using the
+  // method of Marsaglia and Tsang (2000).
+  void rgamma_mt(RNG &rng, VectorView out, double a, double b);
+  void rgamma_mt(RNG &rng, Vector &out, double a, double b);
+
+  // Truncated normal deviates.  out[i] is drawn from N(mu[i], sigma^2)
+  // truncated to (lo[i], hi[i]), either of which may be infinite.  The
+  // draws are generated in blocks, with each element of a block proposing
+  // candidates from the envelope best suited to its interval and rejected
+  // elements retrying together in the next pass, so no per-element sampler
+  // object is built.  The draws differ from those of rtrun_norm_2_mt with the
+  // same seed.
+  void rtrun_norm_2_mt(RNG &rng, VectorView out, const ConstVectorView &mu,
+                       double sigma, const ConstVectorView &lo,
+                       const ConstVectorView &hi);
+  void rtrun_norm_2_mt(RNG &rng, Vector &out, const ConstVectorView &mu,
+                       double sigma, const ConstVectorView &lo,
+                       const ConstVectorView &hi);
+
+  // One-sided truncated normal deviates.  out[i] is drawn from
+  // N(mu[i], sigma^2) truncated to lie above cutpoint[i] if
+  // positive_support[i] is true, or below it otherwise.  This is the batch
+  // analog of the scalar rtrun_norm_mt, suitable for imputing the latent
+  // variables in a probit model.
+  void rtrun_norm_mt(RNG &rng, VectorView out, const ConstVectorView &mu,
+                     double sigma, const ConstVectorView &cutpoint,
+                     const std::vector<bool> &positive_support);
+  void rtrun_norm_mt(RNG &rng, Vector &out, const ConstVectorView &mu,
+                     double sigma, const ConstVectorView &cutpoint,
+                     const std::vector<bool> &positive_support);
+
+  // Independent draws from a single truncated normal distribution.
+  void rtrun_norm_mt(RNG &rng, VectorView out, double mu, double sigma,
+                     double cutpoint, bool positive_support = true);
+  void rtrun_norm_mt(RNG &rng, Vector &out, double mu, double sigma,
+                     double cutpoint, bool positive_support = true);
+
   // Returns an n-vector of independent normal deviates, each with mean mu and
   // standard deviation sigma.
   inline Vector rnorm_vector(int n, double mu, double sigma) {
@@ -204,9 +259,7 @@ namespace BOOM {
       return Vector(0);
     }
     Vector ans(n);
-    for (int i = 0; i < n; ++i) {
-      ans[i] = rnorm_mt(GlobalRng::rng, mu, sigma);
-    }
+    rnorm_mt(GlobalRng::rng, ans, mu, sigma);
     return ans;
   }
 
@@ -223,6 +276,12 @@ namespace BOOM {
   // Simulate sample_size draws from N(0, Sigma).
   Matrix rmvn_repeated(int sample_size, const SpdMatrix &Sigma);
 
+  // Simulate n draws from N(mu, Sigma), returned as the rows of an n x dim
+  // matrix.  Sigma is factored once, and the draws are formed with a single
+  // triangular matrix product.  To draw repeatedly from the same Sigma across
+  // calls, see MvnDrawer in distributions/MvnDrawer.hpp.
+  Matrix rmvn_many_mt(RNG &rng, int n, const Vector &mu, const SpdMatrix &Sigma);
+
   // rmvn_robust computes the spectral decomposition of Sigma which
   // can be done even if there is a zero pivot that would prevent the
   // Cholesky decomposition from working, so it can be used even if
@@ -249,6 +308,21 @@ namespace BOOM {
   Vector rmvn_precision_upper_cholesky_mt(
       RNG &rng, const Vector &mean, const Matrix &precision_upper_cholesky);
 
+  // Simulate a multivariate normal given the Cholesky decomposition of its
+  // precision matrix, writing the draw into caller-owned storage instead of
+  // allocating a new Vector.  Uses the same random deviates as
+  // rmvn_ivar_mt(rng, mean, precision).
+  // Args:
+  //   rng:  The U(0, 1) random number generator to use for the simulation.
+  //   mean:  The mean of the distribution to be simulated.
+  //   precision_cholesky:  The Cholesky decomposition of the precision
+  //     matrix.  It must be positive definite.
+  //   ans:  On output, a draw from N(mean, precision^{-1}).  Must have the
+  //     same size as mean, and must not overlap it.
+  void rmvn_precision_cholesky_mt(RNG &rng, const ConstVectorView &mean,
+                                  const Cholesky &precision_cholesky,
+                                  VectorView ans);
+
   // Simulate given the precision matrix, and the precision matrix
   // times the mean.  This form arises frequently in Bayesian
   // inference.
@@ -376,6 +450,11 @@ namespace BOOM {
   SpdMatrix rWish(double df, const SpdMatrix &sumsq_inv, bool inv = false);
   SpdMatrix rWish_mt(RNG &, double df, const SpdMatrix &sumsq_inv,
                      bool inv = false);
+
+  // The Bartlett decomposition of a draw from the Wishart distribution with
+  // identity scale: a lower triangular matrix with sqrt(chisq(df - i)) on the
+  // diagonal and standard normals below it.
+  Matrix WishartTriangle(RNG &rng, int dim, double df);
   SpdMatrix rWishChol(double df, const Matrix &sumsq_upper_chol,
                       bool inv = false);
   SpdMatrix rWishChol_mt(RNG &, double df, const Matrix &sumsq_upper_chol,
@@ -411,6 +490,34 @@ namespace BOOM {
   double dirichlet_loglike(const Vector &nu, Vector *g, Matrix *h,
                            const Vector &sumlogpi, double nobs);
 
+  // The Dirichlet log likelihood computed by dirichlet_loglike, viewed as a
+  // function of the single element nu[position] with the other elements of
+  // nu held fixed.  The terms not involving nu[position] are computed once
+  // by the constructor, so each evaluation costs one call to lgamma instead
+  // of O(nu.size()).  This is what a one-element-at-a-time slice sampler
+  // needs.
+  class DirichletElementLoglike {
+   public:
+    DirichletElementLoglike(const Vector &nu, int position,
+                            const Vector &sumlogpi, double nobs);
+
+    // Returns dirichlet_loglike(nu, 0, 0, sumlogpi, nobs) with
+    // nu[position] replaced by nu_element.
+    double operator()(double nu_element) const;
+
+    // The sum of the elements of nu other than nu[position].
+    double other_sum() const { return other_sum_; }
+
+   private:
+    double sumlog_;
+    double nobs_;
+    double other_sum_;
+    double other_sum_lgamma_;
+    double other_linear_term_;
+    // False if any element of nu other than nu[position] is non-positive.
+    bool others_valid_;
+  };
+
   Vector rdirichlet(const Vector &nu);
   Vector rdirichlet_mt(RNG &rng, const Vector &nu);
   Vector rdirichlet(const VectorView &nu);
@@ -420,6 +527,9 @@ namespace BOOM {
 
   //===========================================================================
   // Multinomial distribution.
+  // Each call to rmulti or rmulti_mt scans the probability vector.  See
+  // CategoricalSampler in distributions/CategoricalSampler.hpp when many
+  // draws are needed from the same distribution.
   uint rmulti(const Vector &);
   uint rmulti(const VectorView &);
   uint rmulti(const ConstVectorView &);
@@ -436,6 +546,7 @@ namespace BOOM {
   //
   // Returns:
   //   A vector of length 'sample_size' containing random draws from 'probs'.
+  //   Large samples are drawn using an alias table.
   std::vector<int> rmulti_vector_mt(RNG &rng,
                                     int sample_size,
                                     const Vector &probs);
@@ -60,17 +60,62 @@ namespace BOOM {
     update_cdf();
   }
 
+  //----------------------------------------------------------------------
+  void BARS::set_log_density(
+      const std::function<double(double)> &log_target_density,
+      const std::function<double(double)> &log_target_density_derivative) {
+    std::vector<double> x;
+    std::vector<double> values;
+    std::vector<double> derivatives;
+    x.reserve(x_.size());
+    values.reserve(x_.size());
+    derivatives.reserve(x_.size());
+    for (int i = 0; i < x_.size(); ++i) {
+      double y = log_target_density(x_[i]);
+      double d = log_target_density_derivative(x_[i]);
+      // The support lower bound is always kept.  Other points are kept if
+      // their tangent lines are consistent with a concave log density.
+      if (i > 0 && (!std::isfinite(y) || !std::isfinite(d) ||
+                    d >= derivatives.back())) {
+        continue;
+      }
+      x.push_back(x_[i]);
+      values.push_back(y);
+      derivatives.push_back(d);
+    }
+    if (!std::isfinite(values[0]) || derivatives[0] >= 0) {
+      std::ostringstream err;
+      err << "lower bound of " << x[0]
+          << " must be to the right of the mode of "
+          << "logf in BoundedAdaptiveRejectionSampler::set_log_density"
+          << std::endl
+          << "a        = " << x[0] << std::endl
+          << "logf(a)  = " << values[0] << std::endl
+          << "dlogf(a) = " << derivatives[0] << std::endl;
+      report_error(err.str());
+    }
+    log_target_density_ = log_target_density;
+    log_target_density_derivative_ = log_target_density_derivative;
+    x_ = x;
+    log_density_values_ = values;
+    log_density_derivative_values_ = derivatives;
+    refresh_knots();
+    update_cdf();
+  }
+
   //----------------------------------------------------------------------
   void BARS::add_point(double z) {
-    auto it = std::lower_bound(knots_.begin(), knots_.end(), z);
+    // The search is over x_ rather than knots_.  A point can lie between
+    // knots_[k] and x_[k], in which case it belongs before x_[k].
+    auto it = std::lower_bound(x_.begin(), x_.end(), z);
 
-    if (it == knots_.end()) {
+    if (it == x_.end()) {
       x_.push_back(z);
       log_density_values_.push_back(log_target_density_(z));
       log_density_derivative_values_.push_back(
           log_target_density_derivative_(z));
     } else {
-      uint k = it - knots_.begin();
+      uint k = it - x_.begin();
       x_.insert(x_.begin() + k, z);
       log_density_values_.insert(log_density_values_.begin() + k,
                                  log_target_density_(z));
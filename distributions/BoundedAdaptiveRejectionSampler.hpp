@@ -54,6 +54,23 @@ namespace BOOM {
     // process is repeated until a successful proposal is made.
     double draw(RNG &);
 
+    // Replace the target distribution, keeping the support lower bound and
+    // the points tried so far.  The retained points are re-evaluated under
+    // the new log density, and any that are no longer consistent with a
+    // concave log density (non-finite values, or derivatives that fail to
+    // decrease from left to right) are dropped.  This lets a sampler whose
+    // target changes slowly (e.g. from one MCMC iteration to the next) reuse
+    // its hull rather than rebuilding it from scratch.
+    //
+    // The support lower bound must still be to the right of the mode of the
+    // new log density.
+    void set_log_density(
+        const std::function<double(double)> &log_target_density,
+        const std::function<double(double)> &log_target_density_derivative);
+
+    // The number of points defining the outer hull.
+    int number_of_points() const { return x_.size(); }
+
     std::ostream &print(std::ostream &out) const;
 
    private:
@@ -0,0 +1,139 @@
+// Copyright 2018 Google LLC. All Rights Reserved.
+/*
+  Copyright (C) 2005-2024 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#include "distributions/CategoricalSampler.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+#include "cpputil/report_error.hpp"
+
+namespace BOOM {
+
+  namespace {
+    // Below this many categories a scan of the cumulative distribution is
+    // about as fast as an alias table lookup.
+    const int kMinimumAliasDimension = 8;
+
+    // Building an alias table costs about as much as four scans of the
+    // cumulative distribution.
+    const int kMinimumAliasDraws = 4;
+  }  // namespace
+
+  CategoricalSampler::CategoricalSampler() : dim_(0) {}
+
+  CategoricalSampler::CategoricalSampler(const ConstVectorView &probs,
+                                         int expected_number_of_draws)
+      : dim_(0) {
+    set_probs(probs, expected_number_of_draws);
+  }
+
+  void CategoricalSampler::set_probs(const ConstVectorView &probs,
+                                     int expected_number_of_draws) {
+    int dim = probs.size();
+    if (dim == 0) {
+      report_error("CategoricalSampler needs at least one category.");
+    }
+    double total = 0;
+    for (int i = 0; i < dim; ++i) {
+      double p = probs[i];
+      if (!std::isfinite(p) || p < 0) {
+        std::ostringstream err;
+        err << "Illegal probability " << p << " in position " << i
+            << " passed to CategoricalSampler.";
+        report_error(err.str());
+      }
+      total += p;
+    }
+    if (total <= 0) {
+      report_error("Probabilities passed to CategoricalSampler must sum to "
+                   "a positive number.");
+    }
+
+    dim_ = dim;
+    cutoff_.clear();
+    alias_.clear();
+    cdf_.clear();
+    if (dim_ < kMinimumAliasDimension
+        || expected_number_of_draws < kMinimumAliasDraws) {
+      cdf_.resize(dim_);
+      double running_total = 0;
+      for (int i = 0; i < dim_; ++i) {
+        running_total += probs[i];
+        cdf_[i] = running_total / total;
+      }
+      return;
+    }
+
+    // Vose's method.  Each slot of the table holds mass 1 / K.  Categories
+    // with less than 1 / K of the mass ("small") fill the rest of their slot
+    // with part of a category having more than 1 / K ("large").
+    cutoff_.resize(dim_);
+    alias_.resize(dim_);
+    std::vector<int> small, large;
+    small.reserve(dim_);
+    large.reserve(dim_);
+    for (int i = 0; i < dim_; ++i) {
+      cutoff_[i] = probs[i] * dim_ / total;
+      alias_[i] = i;
+      if (cutoff_[i] < 1.0) {
+        small.push_back(i);
+      } else {
+        large.push_back(i);
+      }
+    }
+    while (!small.empty() && !large.empty()) {
+      int s = small.back();
+      small.pop_back();
+      int l = large.back();
+      alias_[s] = l;
+      cutoff_[l] -= 1.0 - cutoff_[s];
+      if (cutoff_[l] < 1.0) {
+        large.pop_back();
+        small.push_back(l);
+      }
+    }
+    // Whatever remains differs from 1 only by rounding error.
+    for (int i : small) cutoff_[i] = 1.0;
+    for (int i : large) cutoff_[i] = 1.0;
+  }
+
+  int CategoricalSampler::draw(RNG &rng) const {
+    if (dim_ == 0) {
+      report_error("set_probs() must be called before drawing from a "
+                   "CategoricalSampler.");
+    }
+    double u = rng();
+    if (!alias_.empty()) {
+      double x = u * dim_;
+      int slot = std::min<int>(static_cast<int>(x), dim_ - 1);
+      return (x - slot) < cutoff_[slot] ? slot : alias_[slot];
+    }
+    int ans = std::upper_bound(cdf_.begin(), cdf_.end(), u) - cdf_.begin();
+    return std::min<int>(ans, dim_ - 1);
+  }
+
+  void CategoricalSampler::draw(RNG &rng, std::vector<int> &ans) const {
+    for (int &value : ans) {
+      value = draw(rng);
+    }
+  }
+
+}  // namespace BOOM
@@ -0,0 +1,93 @@
+#ifndef BOOM_DISTRIBUTIONS_CATEGORICAL_SAMPLER_HPP_
+#define BOOM_DISTRIBUTIONS_CATEGORICAL_SAMPLER_HPP_
+// Copyright 2018 Google LLC. All Rights Reserved.
+/*
+  Copyright (C) 2005-2024 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#include <limits>
+#include <vector>
+
+#include "LinAlg/Vector.hpp"
+#include "LinAlg/VectorView.hpp"
+#include "distributions/rng.hpp"
+
+namespace BOOM {
+
+  // Draws from a fixed discrete distribution on {0, ..., K-1}.  rmulti_mt
+  // scans the probability vector on every draw, which costs O(K).  A
+  // CategoricalSampler does its O(K) work once, when the probabilities are
+  // set, by building a Walker/Vose alias table.  Each draw then costs one
+  // uniform deviate and a table lookup, regardless of K.
+  //
+  // Building the table costs a few passes over the probabilities, so it
+  // only pays off when several draws are taken from the same distribution.
+  // The constructor and set_probs() accept the number of draws the caller
+  // expects to make.  If that number is too small to recover the setup cost
+  // (or K is small enough that a scan is as fast as a lookup) the sampler
+  // stores the cumulative distribution instead and scans it on each draw.
+  //
+  // The draw methods are const, so a single sampler can be shared across
+  // threads as long as each thread has its own RNG.
+  class CategoricalSampler {
+   public:
+    // An empty sampler.  set_probs() must be called before drawing.
+    CategoricalSampler();
+
+    // Args:
+    //   probs: The (non-negative) probabilities of each category.  They
+    //     need not sum to 1.  At least one must be positive.
+    //   expected_number_of_draws: The number of draws the caller plans to
+    //     take from this distribution.  It affects speed, not correctness.
+    explicit CategoricalSampler(
+        const ConstVectorView &probs,
+        int expected_number_of_draws = std::numeric_limits<int>::max());
+
+    void set_probs(
+        const ConstVectorView &probs,
+        int expected_number_of_draws = std::numeric_limits<int>::max());
+
+    // A single draw from the distribution.
+    int draw(RNG &rng) const;
+
+    // Fill 'ans' with independent draws.  The number of draws is
+    // ans.size().
+    void draw(RNG &rng, std::vector<int> &ans) const;
+
+    // The number of categories.
+    int dim() const { return dim_; }
+
+    // True if draws come from an alias table, false if from a scan.
+    bool uses_alias_table() const { return !alias_.empty(); }
+
+   private:
+    int dim_;
+
+    // Alias table: category i is returned with probability
+    // cutoff_[i] / K when the uniform deviate lands in slot i, and
+    // alias_[i] is returned otherwise.
+    std::vector<double> cutoff_;
+    std::vector<int> alias_;
+
+    // Normalized cumulative distribution, used instead of the alias table
+    // when few draws are expected.
+    std::vector<double> cdf_;
+  };
+
+}  // namespace BOOM
+
+#endif  // BOOM_DISTRIBUTIONS_CATEGORICAL_SAMPLER_HPP_
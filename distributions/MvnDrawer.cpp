@@ -0,0 +1,126 @@
+// Copyright 2018 Google LLC. All Rights Reserved.
+/*
+  Copyright (C) 2005-2024 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#include "distributions/MvnDrawer.hpp"
+#include <cmath>
+#include "LinAlg/EigenMap.hpp"
+#include "cpputil/report_error.hpp"
+#include "distributions.hpp"
+
+namespace BOOM {
+
+  MvnDrawer::MvnDrawer(const SpdMatrix &Sigma) { set_variance(Sigma); }
+
+  void MvnDrawer::set_variance(const SpdMatrix &Sigma) {
+    bool okay = true;
+    root_ = Sigma.chol(okay);
+    lower_triangular_ = okay;
+    if (!okay) {
+      // Use the spectral square root, as rmvn_robust_mt does.
+      int n = Sigma.nrow();
+      Matrix eigenvectors(n, n);
+      Vector eigenvalues = eigen(Sigma, eigenvectors);
+      for (int j = 0; j < n; ++j) {
+        eigenvectors.col(j) *= std::sqrt(std::fabs(eigenvalues[j]));
+      }
+      root_ = eigenvectors;
+    }
+  }
+
+  Vector MvnDrawer::draw(RNG &rng) const {
+    Vector z(dim());
+    rnorm_mt(rng, z, 0, 1);
+    if (lower_triangular_) {
+      return Lmult(root_, z);
+    } else {
+      return root_ * z;
+    }
+  }
+
+  Vector MvnDrawer::draw(RNG &rng, const Vector &mu) const {
+    if (mu.size() != dim()) {
+      report_error("Mean and variance have different dimensions in "
+                   "MvnDrawer::draw.");
+    }
+    Vector ans = draw(rng);
+    ans += mu;
+    return ans;
+  }
+
+  Matrix MvnDrawer::draw_many(RNG &rng, int n) const {
+    int d = dim();
+    // Fill the deviates one draw (row) at a time, so the RNG is consumed in
+    // the same order as by successive calls to draw().
+    Matrix z(n, d);
+    for (int i = 0; i < n; ++i) {
+      rnorm_mt(rng, z.row(i), 0, 1);
+    }
+    Matrix ans(n, d);
+    if (lower_triangular_) {
+      EigenMap(ans).noalias() = EigenMap(z)
+          * EigenMap(root_).triangularView<Eigen::Lower>().transpose();
+    } else {
+      EigenMap(ans).noalias() = EigenMap(z) * EigenMap(root_).transpose();
+    }
+    return ans;
+  }
+
+  Matrix MvnDrawer::draw_many(RNG &rng, int n, const Vector &mu) const {
+    if (mu.size() != dim()) {
+      report_error("Mean and variance have different dimensions in "
+                   "MvnDrawer::draw_many.");
+    }
+    Matrix ans = draw_many(rng, n);
+    for (int i = 0; i < n; ++i) {
+      ans.row(i) += mu;
+    }
+    return ans;
+  }
+
+  //===========================================================================
+  WishartDrawer::WishartDrawer(double df, const SpdMatrix &sumsq_inv) {
+    set_parameters(df, sumsq_inv);
+  }
+
+  void WishartDrawer::set_parameters(double df, const SpdMatrix &sumsq_inv) {
+    if (df <= sumsq_inv.nrow() - 1) {
+      report_error("WishartDrawer needs df > dim - 1.");
+    }
+    bool ok = true;
+    Matrix cholesky = sumsq_inv.chol(ok);
+    if (!ok) {
+      report_error("The scale matrix passed to WishartDrawer is not "
+                   "positive definite.");
+    }
+    df_ = df;
+    scale_cholesky_ = cholesky;
+  }
+
+  SpdMatrix WishartDrawer::draw(RNG &rng) const {
+    Matrix bartlett = WishartTriangle(rng, dim(), df_);
+    // The product of two lower triangular matrices is the lower Cholesky
+    // triangle of the draw.
+    Matrix cholesky(dim(), dim());
+    EigenMap(cholesky).noalias() =
+        EigenMap(scale_cholesky_).triangularView<Eigen::Lower>()
+        * EigenMap(bartlett);
+    return LLT(cholesky);
+  }
+
+}  // namespace BOOM
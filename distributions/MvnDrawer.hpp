@@ -0,0 +1,103 @@
+#ifndef BOOM_DISTRIBUTIONS_MVN_DRAWER_HPP_
+#define BOOM_DISTRIBUTIONS_MVN_DRAWER_HPP_
+// Copyright 2018 Google LLC. All Rights Reserved.
+/*
+  Copyright (C) 2005-2024 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#include "LinAlg/Matrix.hpp"
+#include "LinAlg/SpdMatrix.hpp"
+#include "LinAlg/Vector.hpp"
+#include "distributions/rng.hpp"
+
+namespace BOOM {
+
+  // Draws from a multivariate normal distribution with a fixed variance
+  // matrix.  The variance is factored once, when it is set, so repeated draws
+  // cost a triangular matrix-vector product each instead of a Cholesky
+  // decomposition.  Like rmvn_mt, the drawer falls back to a spectral square
+  // root if the variance is only positive semidefinite.
+  //
+  // Draws consume the RNG exactly as rmvn_mt does, so replacing repeated calls
+  // to rmvn_mt(rng, mu, Sigma) with a drawer does not change the simulated
+  // values.
+  //
+  // The draw methods are const and do not use shared workspace, so a single
+  // drawer can be used from several threads as long as each has its own RNG.
+  class MvnDrawer {
+   public:
+    // A drawer of dimension 0.  Call set_variance() before drawing.
+    MvnDrawer() : lower_triangular_(true) {}
+    explicit MvnDrawer(const SpdMatrix &Sigma);
+
+    // Factor a new variance matrix.
+    void set_variance(const SpdMatrix &Sigma);
+
+    int dim() const { return root_.nrow(); }
+
+    // A matrix R with R * R^T equal to the variance.  R is the lower Cholesky
+    // triangle unless the Cholesky decomposition failed.
+    const Matrix &variance_square_root() const { return root_; }
+
+    // A draw from N(0, Sigma).
+    Vector draw(RNG &rng) const;
+
+    // A draw from N(mu, Sigma).
+    Vector draw(RNG &rng, const Vector &mu) const;
+
+    // Simulate n independent draws as the rows of an n x dim() matrix.  The
+    // standard normal deviates for all the draws are generated first, and
+    // transformed by a single triangular matrix-matrix product.  Row i
+    // matches the i'th of n successive calls to draw().
+    Matrix draw_many(RNG &rng, int n) const;
+    Matrix draw_many(RNG &rng, int n, const Vector &mu) const;
+
+   private:
+    Matrix root_;
+    bool lower_triangular_;
+  };
+
+  // Draws from a Wishart distribution with fixed degrees of freedom and scale
+  // matrix, matching rWish_mt(rng, df, sumsq_inv).  The Cholesky factor of the
+  // scale matrix is computed once.  Each draw needs a fresh Bartlett
+  // triangle, which is combined with the cached factor by a triangular
+  // product.
+  class WishartDrawer {
+   public:
+    WishartDrawer() : df_(0) {}
+
+    // Args:
+    //   df:  The degrees of freedom.
+    //   sumsq_inv: The scale matrix.  The mean of the distribution is
+    //     df * sumsq_inv.
+    WishartDrawer(double df, const SpdMatrix &sumsq_inv);
+
+    void set_parameters(double df, const SpdMatrix &sumsq_inv);
+
+    int dim() const { return scale_cholesky_.nrow(); }
+    double df() const { return df_; }
+
+    SpdMatrix draw(RNG &rng) const;
+
+   private:
+    double df_;
+    Matrix scale_cholesky_;
+  };
+
+}  // namespace BOOM
+
+#endif  // BOOM_DISTRIBUTIONS_MVN_DRAWER_HPP_
@@ -24,6 +24,7 @@
 #include <stdexcept>
 #include "cpputil/report_error.hpp"
 #include "distributions.hpp"
+#include "distributions/MvnDrawer.hpp"
 
 namespace BOOM {
 
@@ -44,19 +45,10 @@ namespace BOOM {
 
   SpdMatrix rWish_mt(RNG &rng, double nu, const SpdMatrix &sumsq_inv,
                      bool inv) {
-    uint d = sumsq_inv.nrow();
-    Matrix L = WishartTriangle(rng, d, nu);
-    bool ok = true;
-    Matrix ss_chol = sumsq_inv.chol(ok);
-    if (!ok) {
-      report_error("problem in rWish");
-    }
-
-    Matrix tmp(ss_chol * L);  // tmp is the lower cholesky triangle of siginv
     if (inv) {
       report_error("need to invert from choelsky factor in rwish");
     }
-    return LLT(tmp);
+    return WishartDrawer(nu, sumsq_inv).draw(rng);
   }
 
   SpdMatrix rWishChol(double nu, const Matrix &sumsq_upper_chol, bool inv) {
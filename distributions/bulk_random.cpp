@@ -0,0 +1,348 @@
+/*
+  Copyright (C) 2005-2024 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include <cmath>
+#include <vector>
+#include "distributions.hpp"
+#include "LinAlg/Vector.hpp"
+#include "LinAlg/VectorView.hpp"
+#include "cpputil/Constants.hpp"
+#include "cpputil/math_utils.hpp"
+#include "cpputil/report_error.hpp"
+
+namespace BOOM {
+
+  namespace {
+    // Draws are generated in blocks of this size.  The block lives on the
+    // stack, and is small enough to stay in L1 cache.
+    const int kBulkBlockSize = 256;
+
+    // Fill z[0], ..., z[n-1] with standard normal deviates, where n is even,
+    // using the basic (trigonometric) Box-Muller transform.  The transform is
+    // free of branches, so the loop vectorizes.
+    void fill_standard_normal_pairs(RNG &rng, double *z, int n) {
+      rng.fill_uniform(z, n);
+      for (int i = 0; i < n; i += 2) {
+        // 1 - u is in (0, 1], so the log is finite.
+        double radius = std::sqrt(-2.0 * std::log(1.0 - z[i]));
+        double theta = 2.0 * Constants::pi * z[i + 1];
+        z[i] = radius * std::cos(theta);
+        z[i + 1] = radius * std::sin(theta);
+      }
+    }
+
+    // A single Marsaglia-Tsang gamma deviate with shape a >= 1 and unit
+    // rate, given d = a - 1/3 and c = 1 / sqrt(9d).
+    double marsaglia_tsang(RNG &rng, double d, double c) {
+      while (true) {
+        double x, v;
+        do {
+          x = rnorm_mt(rng);
+          v = 1.0 + c * x;
+        } while (v <= 0);
+        v = v * v * v;
+        double u = 1.0 - rng();
+        double x2 = x * x;
+        if (u < 1.0 - 0.0331 * x2 * x2) return d * v;
+        if (std::log(u) < 0.5 * x2 + d * (1.0 - v + std::log(v))) {
+          return d * v;
+        }
+      }
+    }
+
+    // Proposal distributions used by the truncated normal sampler.
+    enum TruncatedNormalProposal {
+      kNormalProposal,
+      kUniformProposal,
+      kExponentialProposal
+    };
+
+    // Fill z[i] with a draw from the standard normal distribution truncated
+    // to (lo[i], hi[i]), for i = 0, ..., n - 1, where n <= kBulkBlockSize.
+    // The bounds may be infinite.
+    //
+    // Each lane is assigned one of the proposals from Robert (1995,
+    // Statistics and Computing): an untruncated normal when the interval is
+    // wide and contains zero, a uniform when it is narrow, and a translated
+    // exponential in the tails.  Every lane in a round consumes two uniforms,
+    // and the candidates and acceptance decisions for all lanes are computed
+    // in a branch-free loop.  Accepted lanes are written to z, and rejected
+    // lanes are compacted into the next round.
+    void fill_truncated_standard_normal(RNG &rng, double *z, const double *lo,
+                                        const double *hi, int n) {
+      int method[kBulkBlockSize];
+      double lower[kBulkBlockSize];
+      double upper[kBulkBlockSize];
+      double sign[kBulkBlockSize];
+      double mode_square[kBulkBlockSize];
+      double alpha[kBulkBlockSize];
+      double tail_mass[kBulkBlockSize];
+
+      for (int i = 0; i < n; ++i) {
+        // Reflect intervals lying below zero, so that upper[i] > 0.
+        bool reflect = hi[i] <= 0;
+        sign[i] = reflect ? -1.0 : 1.0;
+        double l = reflect ? -hi[i] : lo[i];
+        double h = reflect ? -lo[i] : hi[i];
+        lower[i] = l;
+        upper[i] = h;
+        mode_square[i] = 0;
+        alpha[i] = 1;
+        tail_mass[i] = 1;
+        if (l <= 0) {
+          method[i] = h - l >= Constants::root_2pi ? kNormalProposal
+                                                   : kUniformProposal;
+        } else {
+          double root = std::sqrt(l * l + 4);
+          double uniform_width =
+              2 * std::exp(0.5 + 0.25 * l * (l - root)) / (l + root);
+          if (h - l < uniform_width) {
+            method[i] = kUniformProposal;
+            mode_square[i] = l * l;
+          } else {
+            method[i] = kExponentialProposal;
+            alpha[i] = 0.5 * (l + root);
+            tail_mass[i] = -std::expm1(-alpha[i] * (h - l));
+          }
+        }
+      }
+
+      int slot[kBulkBlockSize];
+      for (int i = 0; i < n; ++i) slot[i] = i;
+      double uniforms[2 * kBulkBlockSize];
+      double candidate[kBulkBlockSize];
+      bool accept[kBulkBlockSize];
+      int pending = n;
+      while (pending > 0) {
+        rng.fill_uniform(uniforms, 2 * pending);
+        for (int j = 0; j < pending; ++j) {
+          int k = slot[j];
+          double u1 = uniforms[2 * j];
+          double u2 = uniforms[2 * j + 1];
+          double l = lower[k];
+          double h = upper[k];
+          // 1 - u is in (0, 1], so the logs are finite.
+          double normal = std::sqrt(-2.0 * std::log(1.0 - u1))
+              * std::cos(2.0 * Constants::pi * u2);
+          double uniform = l + (h - l) * u1;
+          double exponential =
+              l - std::log(1.0 - u1 * tail_mass[k]) / alpha[k];
+          int m = method[k];
+          double cand = m == kNormalProposal ? normal
+              : m == kUniformProposal ? uniform : exponential;
+          double shift = cand - alpha[k];
+          double log_acceptance_ratio = m == kNormalProposal
+              ? ((cand > l && cand < h) ? 0.0 : negative_infinity())
+              : m == kUniformProposal
+              ? 0.5 * (mode_square[k] - cand * cand)
+              : -0.5 * shift * shift;
+          // Normal lanes used u2 for the candidate, but their acceptance
+          // ratio is either 1 or 0, so u2 does not affect the decision.
+          accept[j] = 1.0 - u2 <= std::exp(log_acceptance_ratio);
+          candidate[j] = sign[k] * cand;
+        }
+        int rejected = 0;
+        for (int j = 0; j < pending; ++j) {
+          if (accept[j]) {
+            z[slot[j]] = candidate[j];
+          } else {
+            slot[rejected++] = slot[j];
+          }
+        }
+        pending = rejected;
+      }
+    }
+  }  // namespace
+
+  void runif_mt(RNG &rng, VectorView out, double lo, double hi) {
+    if (!std::isfinite(lo) || !std::isfinite(hi) || hi < lo) {
+      report_error("Illegal bounds in bulk runif_mt.");
+    }
+    double width = hi - lo;
+    int n = out.size();
+    if (out.stride() == 1) {
+      double *data = out.data();
+      rng.fill_uniform(data, n);
+      if (lo != 0 || hi != 1) {
+        for (int i = 0; i < n; ++i) data[i] = lo + width * data[i];
+      }
+      return;
+    }
+    double buffer[kBulkBlockSize];
+    for (int start = 0; start < n; start += kBulkBlockSize) {
+      int block = std::min<int>(kBulkBlockSize, n - start);
+      rng.fill_uniform(buffer, block);
+      for (int i = 0; i < block; ++i) {
+        out[start + i] = lo + width * buffer[i];
+      }
+    }
+  }
+
+  void runif_mt(RNG &rng, Vector &out, double lo, double hi) {
+    runif_mt(rng, VectorView(out), lo, hi);
+  }
+
+  void rnorm_mt(RNG &rng, VectorView out, double mu, double sigma) {
+    if (!std::isfinite(mu) || !std::isfinite(sigma) || sigma < 0) {
+      report_error("Illegal parameters in bulk rnorm_mt.");
+    }
+    int n = out.size();
+    double buffer[kBulkBlockSize];
+    for (int start = 0; start < n; start += kBulkBlockSize) {
+      int block = std::min<int>(kBulkBlockSize, n - start);
+      // Box-Muller produces draws in pairs.  An odd trailing draw wastes
+      // half of a pair.
+      fill_standard_normal_pairs(rng, buffer, block + (block % 2));
+      if (out.stride() == 1) {
+        double *data = out.data() + start;
+        for (int i = 0; i < block; ++i) data[i] = mu + sigma * buffer[i];
+      } else {
+        for (int i = 0; i < block; ++i) {
+          out[start + i] = mu + sigma * buffer[i];
+        }
+      }
+    }
+  }
+
+  void rnorm_mt(RNG &rng, Vector &out, double mu, double sigma) {
+    rnorm_mt(rng, VectorView(out), mu, sigma);
+  }
+
+  void rgamma_mt(RNG &rng, VectorView out, double a, double b) {
+    if (!std::isfinite(a) || !std::isfinite(b) || a <= 0 || b <= 0) {
+      report_error("Illegal parameters in bulk rgamma_mt.");
+    }
+    int n = out.size();
+    // For a < 1 use the boost Gamma(a) = Gamma(a + 1) * U^(1/a).
+    bool boost = a < 1;
+    double shape = boost ? a + 1 : a;
+    double d = shape - 1.0 / 3.0;
+    double c = 1.0 / std::sqrt(9.0 * d);
+    for (int i = 0; i < n; ++i) {
+      out[i] = marsaglia_tsang(rng, d, c) / b;
+    }
+    if (boost) {
+      double buffer[kBulkBlockSize];
+      double inverse_shape = 1.0 / a;
+      for (int start = 0; start < n; start += kBulkBlockSize) {
+        int block = std::min<int>(kBulkBlockSize, n - start);
+        rng.fill_uniform(buffer, block);
+        for (int i = 0; i < block; ++i) {
+          out[start + i] *= std::pow(1.0 - buffer[i], inverse_shape);
+        }
+      }
+    }
+  }
+
+  void rgamma_mt(RNG &rng, Vector &out, double a, double b) {
+    rgamma_mt(rng, VectorView(out), a, b);
+  }
+
+  void rtrun_norm_2_mt(RNG &rng, VectorView out, const ConstVectorView &mu,
+                       double sigma, const ConstVectorView &lo,
+                       const ConstVectorView &hi) {
+    int n = out.size();
+    if (mu.size() != n || lo.size() != n || hi.size() != n) {
+      report_error("The arguments to bulk rtrun_norm_2_mt must all be the "
+                   "same size.");
+    }
+    if (!std::isfinite(sigma) || sigma <= 0) {
+      report_error("Illegal standard deviation in bulk rtrun_norm_2_mt.");
+    }
+    double standard_lo[kBulkBlockSize];
+    double standard_hi[kBulkBlockSize];
+    double z[kBulkBlockSize];
+    for (int start = 0; start < n; start += kBulkBlockSize) {
+      int block = std::min<int>(kBulkBlockSize, n - start);
+      for (int i = 0; i < block; ++i) {
+        double mean = mu[start + i];
+        double a = lo[start + i];
+        double b = hi[start + i];
+        if (!std::isfinite(mean) || !(a < b)) {
+          report_error("Illegal arguments in bulk rtrun_norm_2_mt.  Each mean "
+                       "must be finite, and each lower bound must be less "
+                       "than the corresponding upper bound.");
+        }
+        standard_lo[i] = (a - mean) / sigma;
+        standard_hi[i] = (b - mean) / sigma;
+      }
+      fill_truncated_standard_normal(rng, z, standard_lo, standard_hi, block);
+      for (int i = 0; i < block; ++i) {
+        out[start + i] = mu[start + i] + sigma * z[i];
+      }
+    }
+  }
+
+  void rtrun_norm_2_mt(RNG &rng, Vector &out, const ConstVectorView &mu,
+                       double sigma, const ConstVectorView &lo,
+                       const ConstVectorView &hi) {
+    rtrun_norm_2_mt(rng, VectorView(out), mu, sigma, lo, hi);
+  }
+
+  void rtrun_norm_mt(RNG &rng, VectorView out, const ConstVectorView &mu,
+                     double sigma, const ConstVectorView &cutpoint,
+                     const std::vector<bool> &positive_support) {
+    int n = out.size();
+    if (mu.size() != n || cutpoint.size() != n
+        || positive_support.size() != n) {
+      report_error("The arguments to bulk rtrun_norm_mt must all be the "
+                   "same size.");
+    }
+    Vector lo(n), hi(n);
+    for (int i = 0; i < n; ++i) {
+      lo[i] = positive_support[i] ? cutpoint[i] : negative_infinity();
+      hi[i] = positive_support[i] ? infinity() : cutpoint[i];
+    }
+    rtrun_norm_2_mt(rng, out, mu, sigma, lo, hi);
+  }
+
+  void rtrun_norm_mt(RNG &rng, Vector &out, const ConstVectorView &mu,
+                     double sigma, const ConstVectorView &cutpoint,
+                     const std::vector<bool> &positive_support) {
+    rtrun_norm_mt(rng, VectorView(out), mu, sigma, cutpoint, positive_support);
+  }
+
+  void rtrun_norm_mt(RNG &rng, VectorView out, double mu, double sigma,
+                     double cutpoint, bool positive_support) {
+    if (!std::isfinite(mu) || !std::isfinite(sigma) || sigma <= 0) {
+      report_error("Illegal parameters in bulk rtrun_norm_mt.");
+    }
+    int n = out.size();
+    double standard_lo[kBulkBlockSize];
+    double standard_hi[kBulkBlockSize];
+    double z[kBulkBlockSize];
+    double a = (cutpoint - mu) / sigma;
+    for (int i = 0; i < std::min<int>(n, kBulkBlockSize); ++i) {
+      standard_lo[i] = positive_support ? a : negative_infinity();
+      standard_hi[i] = positive_support ? infinity() : a;
+    }
+    for (int start = 0; start < n; start += kBulkBlockSize) {
+      int block = std::min<int>(kBulkBlockSize, n - start);
+      fill_truncated_standard_normal(rng, z, standard_lo, standard_hi, block);
+      for (int i = 0; i < block; ++i) {
+        out[start + i] = mu + sigma * z[i];
+      }
+    }
+  }
+
+  void rtrun_norm_mt(RNG &rng, Vector &out, double mu, double sigma,
+                     double cutpoint, bool positive_support) {
+    rtrun_norm_mt(rng, VectorView(out), mu, sigma, cutpoint, positive_support);
+  }
+
+}  // namespace BOOM
@@ -21,6 +21,7 @@
 
 #include "LinAlg/Matrix.hpp"
 #include "LinAlg/Vector.hpp"
+#include "distributions/vectorized_special_functions.hpp"
 #include "cpputil/math_utils.hpp"
 #include "cpputil/report_error.hpp"
 
@@ -216,19 +217,22 @@ namespace BOOM {
       return BOOM::negative_infinity();
     }
 
-    double ans = nobs * lgamma(sum);
-    double tmp = 0.0, tmp1 = 0.0;
-    if (g) tmp = nobs * digamma(sum);
-    if (h) tmp1 = nobs * trigamma(sum);
-
+    double ans = nobs * (lgamma(sum) - sum_lgamma(nu));
     for (uint i = 0; i < n; ++i) {
-      ans += (nu(i) - 1) * sumlogpi(i) - nobs * lgamma(nu(i));
-      if (g) {
-        (*g)(i) = tmp + sumlogpi(i) - nobs * digamma(nu(i));
-        if (h) {
-          for (uint j = 0; j < n; ++j) {
-            (*h)(i, j) = tmp1 - (i == j ? nobs * trigamma(nu(i)) : 0);
-          }
+      ans += (nu(i) - 1) * sumlogpi(i);
+    }
+
+    if (g) {
+      double tmp = nobs * digamma(sum);
+      Vector psi = digamma_vector(nu);
+      for (uint i = 0; i < n; ++i) {
+        (*g)(i) = tmp + sumlogpi(i) - nobs * psi[i];
+      }
+      if (h) {
+        *h = nobs * trigamma(sum);
+        Vector psi1 = trigamma_vector(nu);
+        for (uint i = 0; i < n; ++i) {
+          (*h)(i, i) -= nobs * psi1[i];
         }
       }
     }
@@ -236,4 +240,44 @@ namespace BOOM {
     return ans;
   }
 
+  //======================================================================
+  DirichletElementLoglike::DirichletElementLoglike(const Vector &nu,
+                                                   int position,
+                                                   const Vector &sumlogpi,
+                                                   double nobs)
+      : sumlog_(sumlogpi[position]),
+        nobs_(nobs),
+        other_sum_(0.0),
+        other_sum_lgamma_(0.0),
+        other_linear_term_(0.0),
+        others_valid_(true) {
+    if (nu.size() != sumlogpi.size()) {
+      report_error("nu and sumlogpi must be the same size.");
+    }
+    if (position < 0 || position >= nu.size()) {
+      report_error("position is out of range.");
+    }
+    for (int i = 0; i < nu.size(); ++i) {
+      if (i == position) continue;
+      if (nu[i] <= 0) {
+        others_valid_ = false;
+        return;
+      }
+      other_sum_ += nu[i];
+      other_linear_term_ += (nu[i] - 1) * sumlogpi[i];
+    }
+    Vector others(nu);
+    others.erase(others.begin() + position);
+    other_sum_lgamma_ = sum_lgamma(others);
+  }
+
+  double DirichletElementLoglike::operator()(double nu_element) const {
+    if (!others_valid_ || nu_element <= 0) {
+      return negative_infinity();
+    }
+    double total = other_sum_ + nu_element;
+    return nobs_ * (lgamma(total) - other_sum_lgamma_ - lgamma(nu_element))
+        + other_linear_term_ + (nu_element - 1) * sumlog_;
+  }
+
 }  // namespace BOOM
@@ -17,6 +17,7 @@
   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
 */
 #include "distributions/inverse_gaussian.hpp"
+#include <algorithm>
 #include <cmath>
 #include <stdexcept>
 #include "cpputil/math_utils.hpp"
@@ -67,4 +68,41 @@ namespace BOOM {
     if (z > mu / (mu + x)) return mu2 / x;
     return x;
   }
+
+  namespace {
+    // Bulk draws are generated in blocks of this size.
+    const int kInverseGaussianBlockSize = 256;
+  }  // namespace
+
+  void rig_mt(RNG &rng, VectorView out, const ConstVectorView &mu,
+              double lambda) {
+    if (mu.size() != out.size()) {
+      report_error("mu and out must be the same size in bulk rig_mt.");
+    }
+    if (lambda <= 0) {
+      report_error("lambda <= 0 in bulk rig_mt.");
+    }
+    int n = out.size();
+    int buffer_size = std::min<int>(n, kInverseGaussianBlockSize);
+    Vector normals(buffer_size);
+    Vector uniforms(buffer_size);
+    double half_lambda_inverse = .5 / lambda;
+    for (int start = 0; start < n; start += kInverseGaussianBlockSize) {
+      int block = std::min<int>(kInverseGaussianBlockSize, n - start);
+      rnorm_mt(rng, VectorView(normals.data(), block, 1));
+      runif_mt(rng, VectorView(uniforms.data(), block, 1));
+      for (int i = 0; i < block; ++i) {
+        double m = mu[start + i];
+        double muy = m * normals[i] * normals[i];
+        double mu2lam = m * half_lambda_inverse;
+        double x = m + muy * mu2lam - mu2lam * sqrt(muy * (4 * lambda + muy));
+        out[start + i] = uniforms[i] > m / (m + x) ? m * m / x : x;
+      }
+    }
+  }
+
+  void rig_mt(RNG &rng, Vector &out, const ConstVectorView &mu,
+              double lambda) {
+    rig_mt(rng, VectorView(out), mu, lambda);
+  }
 }  // namespace BOOM
@@ -19,6 +19,8 @@
 #ifndef BOOM_INVERSE_GAUSSIAN_HPP_
 #define BOOM_INVERSE_GAUSSIAN_HPP_
 #include "distributions.hpp"
+#include "LinAlg/Vector.hpp"
+#include "LinAlg/VectorView.hpp"
 
 namespace BOOM {
 
@@ -45,5 +47,16 @@ namespace BOOM {
     return rig_mt(GlobalRng::rng, mu, lambda);
   }
 
+  // Bulk inverse Gaussian deviates.  out[i] is drawn from IG(mu[i], lambda)
+  // using the same transformation as rig_mt, but with the normal and uniform
+  // deviates generated in blocks by the bulk generators in
+  // distributions.hpp, and a branch-free transformation loop that the
+  // compiler can vectorize.  The draws differ from those of repeated calls
+  // to rig_mt with the same seed.
+  void rig_mt(RNG &rng, VectorView out, const ConstVectorView &mu,
+              double lambda);
+  void rig_mt(RNG &rng, Vector &out, const ConstVectorView &mu,
+              double lambda);
+
 }  // namespace BOOM
 #endif  // BOOM_INVERSE_GAUSSIAN_HPP_
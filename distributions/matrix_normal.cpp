@@ -76,10 +76,7 @@ namespace BOOM {
     uint xdim = Mu.nrow();
     uint ydim = Mu.ncol();
     Matrix Z(xdim, ydim);
-    double *zdata = Z.data();
-    for (uint i = 0; i < xdim * ydim; ++i) {
-      zdata[i] = rnorm_mt(rng);
-    }
+    Z.randomize_gaussian(0, 1, rng);
 
     Matrix Ominv_U(t(Cholesky(Ominv).getL()));
     Matrix Lsig(Linv(Cholesky(Siginv).getL()));
@@ -25,6 +25,7 @@
 #include "LinAlg/Vector.hpp"
 #include "LinAlg/DiagonalMatrix.hpp"
 #include "distributions.hpp"
+#include "distributions/MvnDrawer.hpp"
 #include "cpputil/report_error.hpp"
 
 namespace BOOM {
@@ -55,7 +56,7 @@ namespace BOOM {
     // L is the lower cholesky triangle of Sigma.
     uint n = mu.size();
     Vector wsp(n);
-    for (uint i = 0; i < n; ++i) wsp[i] = rnorm_mt(rng, 0, 1);
+    rnorm_mt(rng, wsp, 0, 1);
     return Lmult(L, wsp) + mu;
   }
   //======================================================================
@@ -64,17 +65,12 @@ namespace BOOM {
   }
 
   Matrix rmvn_repeated(int sample_size, const SpdMatrix &Sigma) {
-    int ydim = Sigma.nrow();
-    Matrix ans(sample_size, ydim);
-    Matrix L = Sigma.chol();
-    for (int i = 0; i < sample_size; ++i) {
-      Vector draw(ydim);
-      for (int j = 0; j < ydim; ++j) {
-        draw[j] = rnorm_mt(GlobalRng::rng, 0, 1);
-      }
-      ans.row(i) = L * draw;
-    }
-    return ans;
+    return MvnDrawer(Sigma).draw_many(GlobalRng::rng, sample_size);
+  }
+
+  Matrix rmvn_many_mt(RNG &rng, int n, const Vector &mu,
+                      const SpdMatrix &Sigma) {
+    return MvnDrawer(Sigma).draw_many(rng, n, mu);
   }
 
   Vector rmvn_mt(RNG &rng, const Vector &mu, const SpdMatrix &V) {
@@ -116,11 +112,22 @@ namespace BOOM {
     // U is the upper cholesky factor of the inverse variance Matrix
     uint n = mu.size();
     Vector z(n);
-    for (uint i = 0; i < n; ++i) z[i] = rnorm_mt(rng, 0, 1);
+    rnorm_mt(rng, z, 0, 1);
     //    if precision = L L^T then Sigma = (L^T)^{-1} L^{-1} = U U^T
     return Usolve_inplace(precision_upper_cholesky, z) + mu;
   }
 
+  void rmvn_precision_cholesky_mt(RNG &rng, const ConstVectorView &mean,
+                                  const Cholesky &precision_cholesky,
+                                  VectorView ans) {
+    if (mean.size() != ans.size()) {
+      report_error("Wrong size output in rmvn_precision_cholesky_mt.");
+    }
+    rnorm_mt(rng, ans, 0, 1);
+    precision_cholesky.upper_solve_inplace(ans);
+    ans += mean;
+  }
+
   Vector rmvn_suf(const SpdMatrix &Ivar, const Vector &IvarMu) {
     return rmvn_suf_mt(GlobalRng::rng, Ivar, IvarMu);
   }
@@ -129,7 +136,7 @@ namespace BOOM {
     Cholesky L(Ivar);
     uint n = IvarMu.size();
     Vector z(n);
-    for (uint i = 0; i < n; ++i) z[i] = rnorm_mt(rng);
+    rnorm_mt(rng, z);
     LTsolve_inplace(L.getL(), z);  // returns LT^-1 z which is ~ N(0, Ivar.inv)
     z += L.solve(IvarMu);
     return z;
@@ -19,29 +19,193 @@
 
 #include "distributions/rng.hpp"
 #include <ctime>
+#include <sstream>
 #include "cpputil/math_utils.hpp"
+#include "cpputil/report_error.hpp"
 #include "distributions.hpp"
 
 namespace BOOM {
 
-  RNG::RNG()
-      : generator_(std::random_device()())
-  {}
+  namespace {
+    RNG::Engine global_default_engine = RNG::MERSENNE_TWISTER;
+  }  // namespace
 
-  RNG::RNG(RngIntType seed)
-      : generator_(seed)
-  {}
+  RNG::RNG() {
+    set_engine(default_engine(), std::random_device()());
+  }
+
+  RNG::RNG(RngIntType seed) {
+    set_engine(default_engine(), seed);
+  }
+
+  RNG::RNG(RngIntType seed, Engine engine) {
+    set_engine(engine, seed);
+  }
+
+  RNG::RNG(RngIntType seed, RngIntType stream, Engine engine) {
+    if (engine == PHILOX) {
+      engine_ = PHILOX;
+      generator_ = Philox4x32(seed, stream);
+    } else {
+      // Hash the (seed, stream) pair into a single seed.
+      SplitMix64 mixer(seed);
+      RngIntType mixed_seed = mixer() ^ SplitMix64(stream)();
+      set_engine(engine, mixed_seed);
+    }
+  }
+
+  RNG::RNG(const RNG &rhs)
+      : engine_(rhs.engine_),
+        dist_(rhs.dist_)
+  {
+    *this = rhs;
+  }
+
+  RNG &RNG::operator=(const RNG &rhs) {
+    if (&rhs != this) {
+      engine_ = rhs.engine_;
+      dist_ = rhs.dist_;
+      switch (engine_) {
+        case XOSHIRO:
+          generator_ = std::get<Xoshiro256PlusPlus>(rhs.generator_);
+          break;
+        case PHILOX:
+          generator_ = std::get<Philox4x32>(rhs.generator_);
+          break;
+        default:
+          generator_ = MersenneTwisterStorage(new std::mt19937_64(
+              *std::get<MersenneTwisterStorage>(rhs.generator_)));
+      }
+    }
+    return *this;
+  }
+
+  void RNG::set_engine(Engine engine, RngIntType seed) {
+    engine_ = engine;
+    switch (engine_) {
+      case XOSHIRO:
+        generator_ = Xoshiro256PlusPlus(seed);
+        break;
+      case PHILOX:
+        generator_ = Philox4x32(seed);
+        break;
+      default:
+        engine_ = MERSENNE_TWISTER;
+        generator_ = MersenneTwisterStorage(new std::mt19937_64(seed));
+    }
+  }
 
   void RNG::seed() {
-    generator_.seed(std::random_device()());
+    seed(std::random_device()());
+  }
+
+  void RNG::seed(RngIntType seed) {
+    switch (engine_) {
+      case XOSHIRO:
+        std::get<Xoshiro256PlusPlus>(generator_).seed(seed);
+        break;
+      case PHILOX:
+        std::get<Philox4x32>(generator_).seed(seed);
+        break;
+      default:
+        std::get<MersenneTwisterStorage>(generator_)->seed(seed);
+    }
+  }
+
+  void RNG::fill_uniform(double *out, std::size_t n) {
+    switch (engine_) {
+      case XOSHIRO: {
+        Xoshiro256PlusPlus &engine(std::get<Xoshiro256PlusPlus>(generator_));
+        for (std::size_t i = 0; i < n; ++i) {
+          out[i] = (engine() >> 11) * 0x1.0p-53;
+        }
+        break;
+      }
+      case PHILOX: {
+        Philox4x32 &engine(std::get<Philox4x32>(generator_));
+        for (std::size_t i = 0; i < n; ++i) {
+          out[i] = (engine() >> 11) * 0x1.0p-53;
+        }
+        break;
+      }
+      default: {
+        std::mt19937_64 &engine(*std::get<MersenneTwisterStorage>(generator_));
+        for (std::size_t i = 0; i < n; ++i) {
+          out[i] = dist_(engine);
+        }
+      }
+    }
+  }
+
+  void RNG::write_checkpoint(CheckpointWriter &out) const {
+    out.begin_section("RNG");
+    out.write(static_cast<int>(engine_));
+    switch (engine_) {
+      case XOSHIRO: {
+        std::uint64_t state[4];
+        std::get<Xoshiro256PlusPlus>(generator_).get_state(state);
+        for (std::uint64_t word : state) out.write(word);
+        break;
+      }
+      case PHILOX: {
+        std::uint64_t state[Philox4x32::state_size];
+        std::get<Philox4x32>(generator_).get_state(state);
+        for (std::uint64_t word : state) out.write(word);
+        break;
+      }
+      default: {
+        // The standard guarantees that the text representation of an
+        // engine restores it exactly.
+        std::ostringstream state;
+        state << *std::get<MersenneTwisterStorage>(generator_);
+        out.write(state.str());
+      }
+    }
+  }
+
+  void RNG::read_checkpoint(CheckpointReader &in) {
+    in.expect_section("RNG");
+    Engine engine = static_cast<Engine>(in.read_int());
+    set_engine(engine, 0);
+    switch (engine_) {
+      case XOSHIRO: {
+        std::uint64_t state[4];
+        for (std::uint64_t &word : state) word = in.read_uint64();
+        std::get<Xoshiro256PlusPlus>(generator_).set_state(state);
+        break;
+      }
+      case PHILOX: {
+        std::uint64_t state[Philox4x32::state_size];
+        for (std::uint64_t &word : state) word = in.read_uint64();
+        std::get<Philox4x32>(generator_).set_state(state);
+        break;
+      }
+      default: {
+        std::istringstream state(in.read_string());
+        state >> *std::get<MersenneTwisterStorage>(generator_);
+        if (!state) {
+          report_error("Could not restore the state of a Mersenne twister.");
+        }
+      }
+    }
+    dist_.reset();
+  }
+
+  void RNG::set_default_engine(Engine engine) {
+    global_default_engine = engine;
+  }
+
+  RNG::Engine RNG::default_engine() {
+    return global_default_engine;
   }
 
   RNG::RngIntType seed_rng(RNG &rng) {
+    // Use the raw bits.  Scaling a uniform by the largest RngIntType and
+    // rounding to a (signed) long overflows for half the draws, which mapped
+    // all of those seeds to the same value.
     RNG::RngIntType ans = 0;
     while (ans <= 2) {
-      double u = runif_mt(rng) * static_cast<double>(
-          std::numeric_limits<RNG::RngIntType>::max());
-      ans = lround(u);
+      ans = rng.next_bits();
     }
     return ans;
   }
@@ -22,34 +22,125 @@
 
 #include <random>
 #include <cstdint>
+#include <memory>
+#include <variant>
+#include "cpputil/Checkpoint.hpp"
+#include "distributions/rng_engines.hpp"
 
 namespace BOOM {
   // A random number generator for simulating real valued U[0, 1) deviates.
+  //
+  // The bits are supplied by one of several engines.  The default is
+  // std::mt19937_64, which is what BOOM has always used, so existing seeds
+  // reproduce existing results.  The alternatives are much cheaper to store
+  // and to seed, which matters when many RNG objects are created (e.g. one
+  // per thread or per imputation worker).
+  //
+  //   * MERSENNE_TWISTER: std::mt19937_64.  2.5KB of state.
+  //   * XOSHIRO: xoshiro256++.  32 bytes of state.  Fast to seed and draw.
+  //   * PHILOX: Philox4x32-10, a counter based generator.  The (seed, stream)
+  //     pair determines the sequence, so parallel workers can be given
+  //     independent reproducible streams with RNG(seed, worker_id, PHILOX).
   class RNG {
    public:
     using RngIntType = std::uint_fast64_t;
 
-    // Seed with std::random_device.
+    enum Engine { MERSENNE_TWISTER, XOSHIRO, PHILOX };
+
+    // Seed with std::random_device, using the default engine.
     RNG();
 
-    // Seed with a specified value.
+    // Seed with a specified value, using the default engine.
     explicit RNG(RngIntType seed);
 
+    // Seed with a specified value, using the specified engine.
+    RNG(RngIntType seed, Engine engine);
+
+    // Create a generator for the given stream id.  Generators with the same
+    // seed and different stream ids produce independent sequences.  Engines
+    // other than PHILOX do not have native streams, so for those the stream
+    // id is mixed into the seed.
+    RNG(RngIntType seed, RngIntType stream, Engine engine = PHILOX);
+
+    RNG(const RNG &rhs);
+    RNG(RNG &&rhs) = default;
+    RNG &operator=(const RNG &rhs);
+    RNG &operator=(RNG &&rhs) = default;
+
     // Seed from a C++ standard random device, if one is present.
     void seed();
 
     // Seed using a specified value.
-    void seed(RngIntType seed) {generator_.seed(seed);}
+    void seed(RngIntType seed);
 
     // Simulate a U[0, 1) random deviate.
-    double operator()() {return dist_(generator_);}
-
-    std::mt19937_64 & generator() {return generator_;}
+    double operator()() {
+      if (engine_ == MERSENNE_TWISTER) {
+        return dist_(*std::get<MersenneTwisterStorage>(generator_));
+      } else {
+        // The top 53 bits of a random 64 bit integer, scaled to [0, 1).
+        return (next_bits() >> 11) * 0x1.0p-53;
+      }
+    }
+
+    // Simulate 64 uniformly distributed random bits.
+    std::uint64_t next_bits() {
+      switch (engine_) {
+        case XOSHIRO:
+          return std::get<Xoshiro256PlusPlus>(generator_)();
+        case PHILOX:
+          return std::get<Philox4x32>(generator_)();
+        default:
+          return (*std::get<MersenneTwisterStorage>(generator_))();
+      }
+    }
+
+    // Fill out[0], ..., out[n-1] with U[0, 1) deviates.  Equivalent to n
+    // calls to operator(), but the engine is only selected once, which lets
+    // the compiler keep the inner loop tight.
+    void fill_uniform(double *out, std::size_t n);
+
+    Engine engine() const { return engine_; }
+
+    // Save or restore the complete state of the generator, including its
+    // engine, so a restored generator continues the original sequence
+    // exactly.
+    void write_checkpoint(CheckpointWriter &out) const;
+    void read_checkpoint(CheckpointReader &in);
+
+    // A UniformRandomBitGenerator view of this RNG, suitable for use with
+    // the distributions in <random>.  The view refers to this RNG, and must
+    // not outlive it.
+    class BitGenerator {
+     public:
+      using result_type = std::uint64_t;
+      explicit BitGenerator(RNG &rng) : rng_(&rng) {}
+      result_type operator()() { return rng_->next_bits(); }
+      static constexpr result_type min() { return 0; }
+      static constexpr result_type max() {
+        return std::numeric_limits<result_type>::max();
+      }
+
+     private:
+      RNG *rng_;
+    };
+    BitGenerator generator() { return BitGenerator(*this); }
+
+    // The engine used by RNG objects constructed without one.  Changing the
+    // default does not affect existing RNG objects (including the GlobalRng).
+    static void set_default_engine(Engine engine);
+    static Engine default_engine();
 
    private:
-    // TODO(steve): once you can use c++17 in R and elsewhere replace this with
-    // a std::variant that will choose the fastest RNG for each implementation.
-    std::mt19937_64 generator_;
+    // The Mersenne twister is held by pointer so that RNG objects using the
+    // other engines stay small.
+    using MersenneTwisterStorage = std::unique_ptr<std::mt19937_64>;
+
+    void set_engine(Engine engine, RngIntType seed);
+
+    Engine engine_;
+    std::variant<MersenneTwisterStorage, Xoshiro256PlusPlus, Philox4x32>
+        generator_;
     std::uniform_real_distribution<double> dist_;
   };
 
@@ -0,0 +1,105 @@
+/*
+  Copyright (C) 2005-2024 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include "distributions/rng_engines.hpp"
+
+namespace BOOM {
+
+  void Xoshiro256PlusPlus::seed(std::uint64_t seed) {
+    SplitMix64 expander(seed);
+    for (int i = 0; i < 4; ++i) {
+      state_[i] = expander();
+    }
+  }
+
+  void Xoshiro256PlusPlus::jump() {
+    static const std::uint64_t jump_polynomial[] = {
+      0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL,
+      0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL};
+    std::uint64_t s0 = 0;
+    std::uint64_t s1 = 0;
+    std::uint64_t s2 = 0;
+    std::uint64_t s3 = 0;
+    for (int i = 0; i < 4; ++i) {
+      for (int b = 0; b < 64; ++b) {
+        if (jump_polynomial[i] & (1ULL << b)) {
+          s0 ^= state_[0];
+          s1 ^= state_[1];
+          s2 ^= state_[2];
+          s3 ^= state_[3];
+        }
+        (*this)();
+      }
+    }
+    state_[0] = s0;
+    state_[1] = s1;
+    state_[2] = s2;
+    state_[3] = s3;
+  }
+
+  //===========================================================================
+  namespace {
+    const std::uint32_t kPhiloxM0 = 0xD2511F53;
+    const std::uint32_t kPhiloxM1 = 0xCD9E8D57;
+    const std::uint32_t kPhiloxW0 = 0x9E3779B9;
+    const std::uint32_t kPhiloxW1 = 0xBB67AE85;
+
+    inline void philox_round(std::uint32_t ctr[4], const std::uint32_t key[2]) {
+      std::uint64_t product0 = static_cast<std::uint64_t>(kPhiloxM0) * ctr[0];
+      std::uint64_t product1 = static_cast<std::uint64_t>(kPhiloxM1) * ctr[2];
+      std::uint32_t hi0 = product0 >> 32;
+      std::uint32_t lo0 = static_cast<std::uint32_t>(product0);
+      std::uint32_t hi1 = product1 >> 32;
+      std::uint32_t lo1 = static_cast<std::uint32_t>(product1);
+      std::uint32_t c1 = ctr[1];
+      std::uint32_t c3 = ctr[3];
+      ctr[0] = hi1 ^ c1 ^ key[0];
+      ctr[1] = lo1;
+      ctr[2] = hi0 ^ c3 ^ key[1];
+      ctr[3] = lo0;
+    }
+  }  // namespace
+
+  void Philox4x32::bijection(std::uint32_t ctr[4], const std::uint32_t key[2]) {
+    std::uint32_t round_key[2] = {key[0], key[1]};
+    for (int round = 0; round < 10; ++round) {
+      if (round > 0) {
+        round_key[0] += kPhiloxW0;
+        round_key[1] += kPhiloxW1;
+      }
+      philox_round(ctr, round_key);
+    }
+  }
+
+  void Philox4x32::refill() {
+    std::uint32_t ctr[4] = {
+      static_cast<std::uint32_t>(position_),
+      static_cast<std::uint32_t>(position_ >> 32),
+      static_cast<std::uint32_t>(stream_),
+      static_cast<std::uint32_t>(stream_ >> 32)};
+    const std::uint32_t key[2] = {
+      static_cast<std::uint32_t>(key_),
+      static_cast<std::uint32_t>(key_ >> 32)};
+    bijection(ctr, key);
+    buffer_[0] = (static_cast<std::uint64_t>(ctr[1]) << 32) | ctr[0];
+    buffer_[1] = (static_cast<std::uint64_t>(ctr[3]) << 32) | ctr[2];
+    ++position_;
+    buffer_index_ = 0;
+  }
+
+}  // namespace BOOM
@@ -0,0 +1,198 @@
+#ifndef BOOM_DISTRIBUTIONS_RNG_ENGINES_HPP_
+#define BOOM_DISTRIBUTIONS_RNG_ENGINES_HPP_
+
+/*
+  Copyright (C) 2005-2024 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include <cstdint>
+#include <limits>
+
+// Small, fast random bit generators that can be used as alternatives to
+// std::mt19937_64 inside BOOM::RNG.  Both classes satisfy the C++
+// UniformRandomBitGenerator requirements, so they can also be used directly
+// with the distributions in <random>.
+
+namespace BOOM {
+
+  // The splitmix64 generator of Sebastiano Vigna.  Its main use here is to
+  // expand a single 64 bit seed into the state of a larger generator.
+  class SplitMix64 {
+   public:
+    using result_type = std::uint64_t;
+    explicit SplitMix64(std::uint64_t seed) : state_(seed) {}
+
+    std::uint64_t operator()() {
+      std::uint64_t z = (state_ += 0x9e3779b97f4a7c15ULL);
+      z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+      z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+      return z ^ (z >> 31);
+    }
+
+   private:
+    std::uint64_t state_;
+  };
+
+  //===========================================================================
+  // The xoshiro256++ generator of Blackman and Vigna (2018).  It has 32 bytes
+  // of state, a period of 2^256 - 1, and is several times faster than the
+  // Mersenne twister, both to seed and to draw.
+  class Xoshiro256PlusPlus {
+   public:
+    using result_type = std::uint64_t;
+
+    explicit Xoshiro256PlusPlus(std::uint64_t seed = 8675309) {
+      this->seed(seed);
+    }
+
+    // The state is filled using splitmix64, as recommended by the authors,
+    // which guarantees that the state is not all zero.
+    void seed(std::uint64_t seed);
+
+    std::uint64_t operator()() {
+      const std::uint64_t result = rotl(state_[0] + state_[3], 23) + state_[0];
+      const std::uint64_t t = state_[1] << 17;
+      state_[2] ^= state_[0];
+      state_[3] ^= state_[1];
+      state_[1] ^= state_[2];
+      state_[0] ^= state_[3];
+      state_[2] ^= t;
+      state_[3] = rotl(state_[3], 45);
+      return result;
+    }
+
+    // Advance the generator by 2^128 steps.  Calling jump() k times on a
+    // copy of a generator gives the k'th of 2^128 non-overlapping
+    // subsequences, each of length 2^128.
+    void jump();
+
+    // The full generator state, for checkpointing.
+    void get_state(std::uint64_t state[4]) const {
+      for (int i = 0; i < 4; ++i) state[i] = state_[i];
+    }
+    void set_state(const std::uint64_t state[4]) {
+      for (int i = 0; i < 4; ++i) state_[i] = state[i];
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() {
+      return std::numeric_limits<result_type>::max();
+    }
+
+   private:
+    static std::uint64_t rotl(std::uint64_t x, int k) {
+      return (x << k) | (x >> (64 - k));
+    }
+    std::uint64_t state_[4];
+  };
+
+  //===========================================================================
+  // The Philox4x32-10 counter based generator of Salmon, Moraes, Dror and
+  // Shaw (2011), "Parallel random numbers: as easy as 1, 2, 3."
+  //
+  // The output is a bijective function of a 128 bit counter and a 64 bit key.
+  // The key is the seed.  The upper 64 bits of the counter identify a
+  // "stream" and the lower 64 bits identify the position within the stream.
+  // Generators with the same seed and different stream ids produce
+  // statistically independent sequences, so parallel workers can each get a
+  // reproducible generator determined by (seed, worker_id), without having
+  // to draw seeds from one another.
+  //
+  // Each evaluation of the bijection produces 128 bits, which are returned as
+  // two 64 bit values.
+  class Philox4x32 {
+   public:
+    using result_type = std::uint64_t;
+
+    explicit Philox4x32(std::uint64_t seed = 8675309, std::uint64_t stream = 0)
+        : key_(seed), stream_(stream), position_(0), buffer_index_(2) {}
+
+    // Reset the key, and restart the current stream from the beginning.
+    void seed(std::uint64_t seed) {
+      key_ = seed;
+      position_ = 0;
+      buffer_index_ = 2;
+    }
+
+    // Switch to the beginning of the specified stream.
+    void set_stream(std::uint64_t stream) {
+      stream_ = stream;
+      position_ = 0;
+      buffer_index_ = 2;
+    }
+
+    std::uint64_t stream() const { return stream_; }
+
+    std::uint64_t operator()() {
+      if (buffer_index_ >= 2) {
+        refill();
+      }
+      return buffer_[buffer_index_++];
+    }
+
+    // Skip ahead by 'n' evaluations of the bijection (i.e. 2 * n draws).
+    void discard_blocks(std::uint64_t n) {
+      position_ += n;
+      buffer_index_ = 2;
+    }
+
+    // The full generator state, for checkpointing: the key, stream,
+    // position, the two buffered outputs, and the buffer index.
+    static constexpr int state_size = 6;
+    void get_state(std::uint64_t state[state_size]) const {
+      state[0] = key_;
+      state[1] = stream_;
+      state[2] = position_;
+      state[3] = buffer_[0];
+      state[4] = buffer_[1];
+      state[5] = buffer_index_;
+    }
+    void set_state(const std::uint64_t state[state_size]) {
+      key_ = state[0];
+      stream_ = state[1];
+      position_ = state[2];
+      buffer_[0] = state[3];
+      buffer_[1] = state[4];
+      buffer_index_ = state[5];
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() {
+      return std::numeric_limits<result_type>::max();
+    }
+
+    // The raw bijection.  Maps a 128 bit counter (ctr[0] is least
+    // significant) and a 64 bit key (key[0] is least significant) to 128
+    // output bits, overwriting ctr.  Exposed for testing against published
+    // known-answer vectors.
+    static void bijection(std::uint32_t ctr[4], const std::uint32_t key[2]);
+
+   private:
+    // Evaluate the bijection at the current counter and advance the
+    // position.
+    void refill();
+
+    std::uint64_t key_;
+    std::uint64_t stream_;
+    std::uint64_t position_;
+    std::uint64_t buffer_[2];
+    int buffer_index_;
+  };
+
+}  // namespace BOOM
+
+#endif  // BOOM_DISTRIBUTIONS_RNG_ENGINES_HPP_
@@ -0,0 +1,100 @@
+#include "gtest/gtest.h"
+#include "distributions.hpp"
+#include "distributions/CategoricalSampler.hpp"
+#include "LinAlg/Vector.hpp"
+#include "test_utils/test_utils.hpp"
+
+namespace {
+  using namespace BOOM;
+  using std::cout;
+  using std::endl;
+
+  // Draw 'n' values from 'sampler' and return the proportion of draws in
+  // each category.
+  Vector draw_proportions(RNG &rng, const CategoricalSampler &sampler,
+                          int n) {
+    std::vector<int> draws(n);
+    sampler.draw(rng, draws);
+    Vector ans(sampler.dim(), 0.0);
+    for (int value : draws) {
+      EXPECT_GE(value, 0);
+      EXPECT_LT(value, sampler.dim());
+      ans[value] += 1.0 / n;
+    }
+    return ans;
+  }
+
+  TEST(CategoricalSamplerTest, AliasTable) {
+    RNG rng(8675309);
+    Vector probs = {3, 0, 1, 7, 0.5, 2, 0, 11, 4, 1.5};
+    CategoricalSampler sampler(probs);
+    EXPECT_TRUE(sampler.uses_alias_table());
+    EXPECT_EQ(10, sampler.dim());
+
+    int n = 200000;
+    Vector proportions = draw_proportions(rng, sampler, n);
+    probs /= probs.sum();
+    for (int i = 0; i < probs.size(); ++i) {
+      double se = sqrt(probs[i] * (1 - probs[i]) / n);
+      EXPECT_NEAR(probs[i], proportions[i], 4 * se + 1e-12)
+          << "category " << i;
+    }
+    // Categories with zero probability are never drawn.
+    EXPECT_DOUBLE_EQ(0.0, proportions[1]);
+    EXPECT_DOUBLE_EQ(0.0, proportions[6]);
+  }
+
+  TEST(CategoricalSamplerTest, FewDrawsUseScan) {
+    RNG rng(17);
+    Vector probs = {0, 1, 2, 0, 3, 4, 5, 6, 7, 0};
+    CategoricalSampler sampler(probs, 2);
+    EXPECT_FALSE(sampler.uses_alias_table());
+
+    // Small distributions use the scan no matter how many draws are taken.
+    CategoricalSampler small(Vector{1, 2, 3});
+    EXPECT_FALSE(small.uses_alias_table());
+
+    int n = 100000;
+    Vector proportions = draw_proportions(rng, sampler, n);
+    probs /= probs.sum();
+    for (int i = 0; i < probs.size(); ++i) {
+      double se = sqrt(probs[i] * (1 - probs[i]) / n);
+      EXPECT_NEAR(probs[i], proportions[i], 4 * se + 1e-12)
+          << "category " << i;
+    }
+  }
+
+  TEST(CategoricalSamplerTest, DegenerateDistribution) {
+    RNG rng(3);
+    Vector probs(20, 0.0);
+    probs[13] = 2.0;
+    CategoricalSampler sampler(probs);
+    for (int i = 0; i < 1000; ++i) {
+      EXPECT_EQ(13, sampler.draw(rng));
+    }
+  }
+
+  TEST(CategoricalSamplerTest, IllegalProbabilities) {
+    CategoricalSampler sampler;
+    EXPECT_THROW(sampler.set_probs(Vector{1, -1, 2}), std::exception);
+    EXPECT_THROW(sampler.set_probs(Vector(12, 0.0)), std::exception);
+    RNG rng(1);
+    EXPECT_THROW(sampler.draw(rng), std::exception);
+  }
+
+  TEST(CategoricalSamplerTest, RmultiVector) {
+    RNG rng(29);
+    Vector probs = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+    int n = 50000;
+    std::vector<int> draws = rmulti_vector_mt(rng, n, probs);
+    ASSERT_EQ(n, draws.size());
+    Vector counts(probs.size(), 0.0);
+    for (int value : draws) counts[value] += 1.0;
+    probs /= probs.sum();
+    for (int i = 0; i < probs.size(); ++i) {
+      double se = sqrt(probs[i] * (1 - probs[i]) / n);
+      EXPECT_NEAR(probs[i], counts[i] / n, 4 * se) << "category " << i;
+    }
+  }
+
+}  // namespace
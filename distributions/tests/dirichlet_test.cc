@@ -0,0 +1,50 @@
+#include "gtest/gtest.h"
+#include "distributions.hpp"
+#include "LinAlg/Vector.hpp"
+#include "test_utils/test_utils.hpp"
+
+namespace {
+  using namespace BOOM;
+  using std::endl;
+
+  class DirichletTest : public ::testing::Test {
+   protected:
+    DirichletTest() {
+      GlobalRng::rng.seed(8675309);
+    }
+  };
+
+  // The single element log likelihood should agree with the full
+  // dirichlet_loglike when the other elements are held fixed.
+  TEST_F(DirichletTest, ElementLoglikeMatchesFullLoglike) {
+    Vector nu = {1.2, 0.4, 3.0, 7.5, 0.9};
+    Vector sumlog(nu.size());
+    double nobs = 0;
+    for (int i = 0; i < 40; ++i) {
+      sumlog += log(rdirichlet(nu));
+      ++nobs;
+    }
+
+    for (int pos = 0; pos < nu.size(); ++pos) {
+      DirichletElementLoglike loglike(nu, pos, sumlog, nobs);
+      EXPECT_NEAR(loglike.other_sum(), sum(nu) - nu[pos], 1e-12);
+      for (double value : {0.01, 0.5, 1.0, 2.7, 25.0}) {
+        Vector full_nu = nu;
+        full_nu[pos] = value;
+        double full = dirichlet_loglike(full_nu, nullptr, nullptr, sumlog,
+                                        nobs);
+        EXPECT_NEAR(loglike(value), full, 1e-8 * (1 + fabs(full)))
+            << "pos = " << pos << " value = " << value;
+      }
+      EXPECT_EQ(loglike(0.0), negative_infinity());
+      EXPECT_EQ(loglike(-1.0), negative_infinity());
+    }
+
+    // A non-positive element elsewhere in nu makes the likelihood zero.
+    Vector bad_nu = nu;
+    bad_nu[1] = -0.5;
+    DirichletElementLoglike bad(bad_nu, 0, sumlog, nobs);
+    EXPECT_EQ(bad(1.0), negative_infinity());
+  }
+
+}  // namespace
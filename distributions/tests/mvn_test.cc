@@ -1,7 +1,9 @@
 #include "gtest/gtest.h"
 #include "distributions.hpp"
+#include "distributions/MvnDrawer.hpp"
 #include "test_utils/test_utils.hpp"
 #include "numopt/NumericalDerivatives.hpp"
+#include "LinAlg/Cholesky.hpp"
 #include "LinAlg/DiagonalMatrix.hpp"
 #include "stats/ECDF.hpp"
 #include "stats/AsciiDistributionCompare.hpp"
@@ -91,4 +93,88 @@ namespace {
     EXPECT_TRUE(TwoSampleKs(draws.col(4), original_draws.col(4)));
   }
 
-}  // namespace 
+  // The cached drawer reproduces rmvn_mt, one draw at a time or in a batch.
+  TEST(MvnDrawerTest, MatchesRmvn) {
+    Vector mu = {1.0, -2.0, 3.0, 0.5};
+    SpdMatrix Sigma(4);
+    Sigma.randomize();
+    MvnDrawer drawer(Sigma);
+    EXPECT_EQ(4, drawer.dim());
+    EXPECT_TRUE(MatrixEquals(
+        Sigma, drawer.variance_square_root().multT(
+            drawer.variance_square_root())));
+
+    RNG rng1(17);
+    RNG rng2(17);
+    RNG rng3(17);
+    Matrix batch = drawer.draw_many(rng3, 10, mu);
+    ASSERT_EQ(10, batch.nrow());
+    for (int i = 0; i < 10; ++i) {
+      Vector direct = rmvn_mt(rng1, mu, Sigma);
+      EXPECT_TRUE(VectorEquals(direct, drawer.draw(rng2, mu)));
+      EXPECT_TRUE(VectorEquals(direct, batch.row(i)));
+    }
+
+    RNG rng4(17);
+    EXPECT_TRUE(MatrixEquals(batch, rmvn_many_mt(rng4, 10, mu, Sigma)));
+  }
+
+  // Drawing from a Cholesky factor of the precision gives the same draw as
+  // rmvn_ivar_mt.
+  TEST(RmvnTest, PrecisionCholesky) {
+    Vector mu = {1.0, -2.0, 3.0, 0.5};
+    SpdMatrix precision(4);
+    precision.randomize();
+    Cholesky precision_cholesky(precision);
+    RNG rng1(17);
+    RNG rng2(17);
+    Vector draw(4);
+    for (int i = 0; i < 5; ++i) {
+      rmvn_precision_cholesky_mt(rng2, mu, precision_cholesky,
+                                 VectorView(draw));
+      EXPECT_TRUE(VectorEquals(rmvn_ivar_mt(rng1, mu, precision), draw));
+    }
+  }
+
+  // A singular variance falls back to the spectral square root.
+  TEST(MvnDrawerTest, SingularVariance) {
+    GlobalRng::rng.seed(8675309);
+    Vector x = {1.0, 2.0, -1.0};
+    SpdMatrix Sigma(3, 0.0);
+    Sigma.add_outer(x);
+    MvnDrawer drawer(Sigma);
+    EXPECT_TRUE(MatrixEquals(
+        Sigma, drawer.variance_square_root().multT(
+            drawer.variance_square_root())));
+    Matrix draws = drawer.draw_many(GlobalRng::rng, 1000);
+    for (int i = 0; i < draws.nrow(); ++i) {
+      // Each draw is a multiple of x.
+      double scale = draws(i, 0);
+      EXPECT_NEAR(2 * scale, draws(i, 1), 1e-6);
+      EXPECT_NEAR(-scale, draws(i, 2), 1e-6);
+    }
+  }
+
+  TEST(WishartDrawerTest, MatchesRWish) {
+    SpdMatrix scale(3);
+    scale.randomize();
+    double df = 7.5;
+    WishartDrawer drawer(df, scale);
+    RNG rng1(31);
+    RNG rng2(31);
+    SpdMatrix mean(3, 0.0);
+    int ndraws = 20000;
+    for (int i = 0; i < ndraws; ++i) {
+      SpdMatrix draw = drawer.draw(rng2);
+      if (i < 5) {
+        SpdMatrix direct = rWish_mt(rng1, df, scale);
+        EXPECT_TRUE(MatrixEquals(direct, draw));
+      }
+      mean += draw;
+    }
+    mean /= ndraws;
+    EXPECT_TRUE(MatrixEquals(mean, df * scale, .05 * df * scale.max_abs()))
+        << mean << endl << df * scale;
+  }
+
+}  // namespace
@@ -0,0 +1,280 @@
+#include "gtest/gtest.h"
+#include "distributions.hpp"
+#include "distributions/inverse_gaussian.hpp"
+#include "distributions/rng.hpp"
+#include "distributions/rng_engines.hpp"
+#include "Bmath/Bmath.hpp"
+#include "LinAlg/Vector.hpp"
+#include "test_utils/test_utils.hpp"
+
+namespace {
+
+  using namespace BOOM;
+  using std::cout;
+  using std::endl;
+
+  // Check that the first 'n' draws from an RNG look like U[0, 1).
+  void check_uniform(RNG &rng, int n = 10000) {
+    Vector draws(n);
+    for (int i = 0; i < n; ++i) {
+      draws[i] = rng();
+      EXPECT_GE(draws[i], 0.0);
+      EXPECT_LT(draws[i], 1.0);
+    }
+    EXPECT_NEAR(draws.sum() / n, .5, .02);
+    EXPECT_TRUE(DistributionsMatch(draws, [](double x) {return x;}));
+  }
+
+  TEST(RngTest, DefaultEngineMatchesMersenneTwister) {
+    RNG rng(12345);
+    EXPECT_EQ(RNG::MERSENNE_TWISTER, rng.engine());
+    std::mt19937_64 reference(12345);
+    std::uniform_real_distribution<double> dist;
+    for (int i = 0; i < 10; ++i) {
+      EXPECT_DOUBLE_EQ(dist(reference), rng());
+    }
+  }
+
+  TEST(RngTest, AllEnginesAreUniform) {
+    RNG mt(87, RNG::MERSENNE_TWISTER);
+    check_uniform(mt);
+    RNG xoshiro(87, RNG::XOSHIRO);
+    check_uniform(xoshiro);
+    RNG philox(87, RNG::PHILOX);
+    check_uniform(philox);
+  }
+
+  TEST(RngTest, SeedingIsReproducible) {
+    for (RNG::Engine engine : {RNG::MERSENNE_TWISTER, RNG::XOSHIRO,
+                               RNG::PHILOX}) {
+      RNG rng1(31, engine);
+      RNG rng2(32, engine);
+      EXPECT_NE(rng1(), rng2());
+      rng1.seed(99);
+      rng2.seed(99);
+      for (int i = 0; i < 20; ++i) {
+        EXPECT_EQ(rng1(), rng2());
+      }
+    }
+  }
+
+  TEST(RngTest, CopiesAreIndependent) {
+    for (RNG::Engine engine : {RNG::MERSENNE_TWISTER, RNG::XOSHIRO,
+                               RNG::PHILOX}) {
+      RNG rng(17, engine);
+      rng();
+      RNG copy(rng);
+      EXPECT_EQ(engine, copy.engine());
+      double u = rng();
+      EXPECT_EQ(u, copy());
+      RNG assigned;
+      assigned = copy;
+      double v = rng();
+      EXPECT_EQ(v, assigned());
+      // Drawing from 'assigned' did not advance 'copy'.
+      EXPECT_EQ(v, copy());
+    }
+  }
+
+  TEST(RngTest, PhiloxKnownAnswers) {
+    // Known answer tests from the Random123 distribution.
+    std::uint32_t ctr[4] = {0, 0, 0, 0};
+    std::uint32_t key[2] = {0, 0};
+    Philox4x32::bijection(ctr, key);
+    EXPECT_EQ(0x6627e8d5u, ctr[0]);
+    EXPECT_EQ(0xe169c58du, ctr[1]);
+    EXPECT_EQ(0xbc57ac4cu, ctr[2]);
+    EXPECT_EQ(0x9b00dbd8u, ctr[3]);
+
+    std::uint32_t ctr2[4] = {0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff};
+    std::uint32_t key2[2] = {0xffffffff, 0xffffffff};
+    Philox4x32::bijection(ctr2, key2);
+    EXPECT_EQ(0x408f276du, ctr2[0]);
+    EXPECT_EQ(0x41c83b0eu, ctr2[1]);
+    EXPECT_EQ(0xa20bc7c6u, ctr2[2]);
+    EXPECT_EQ(0x6d5451fdu, ctr2[3]);
+  }
+
+  TEST(RngTest, PhiloxStreams) {
+    // The same (seed, stream) pair gives the same sequence.  Different
+    // streams give different sequences.
+    RNG a(8675309, 3);
+    RNG b(8675309, 3);
+    RNG c(8675309, 4);
+    int same_as_c = 0;
+    for (int i = 0; i < 100; ++i) {
+      double u = a();
+      EXPECT_EQ(u, b());
+      same_as_c += (u == c());
+    }
+    EXPECT_EQ(0, same_as_c);
+
+    // Skipping ahead one block skips two draws.
+    Philox4x32 engine(1, 2);
+    Philox4x32 skipper(1, 2);
+    engine();
+    engine();
+    skipper.discard_blocks(1);
+    EXPECT_EQ(engine(), skipper());
+  }
+
+  TEST(RngTest, XoshiroJump) {
+    Xoshiro256PlusPlus engine(7);
+    Xoshiro256PlusPlus jumped(engine);
+    jumped.jump();
+    EXPECT_NE(engine(), jumped());
+  }
+
+  TEST(RngTest, DefaultEngineCanBeChanged) {
+    RNG::set_default_engine(RNG::XOSHIRO);
+    RNG rng(12);
+    EXPECT_EQ(RNG::XOSHIRO, rng.engine());
+    RNG::set_default_engine(RNG::MERSENNE_TWISTER);
+    RNG rng2(12);
+    EXPECT_EQ(RNG::MERSENNE_TWISTER, rng2.engine());
+  }
+
+  TEST(RngTest, WorksWithStandardDistributions) {
+    RNG rng(4, RNG::XOSHIRO);
+    double total = 0;
+    int n = 10000;
+    for (int i = 0; i < n; ++i) {
+      total += Rmath::rpois_mt(rng, 3.0);
+    }
+    EXPECT_NEAR(total / n, 3.0, .1);
+  }
+
+  TEST(BulkRandomTest, UniformMatchesScalar) {
+    RNG rng1(19);
+    RNG rng2(19);
+    Vector bulk(101);
+    runif_mt(rng1, bulk, 2.0, 5.0);
+    for (int i = 0; i < bulk.size(); ++i) {
+      EXPECT_DOUBLE_EQ(runif_mt(rng2, 2.0, 5.0), bulk[i]);
+    }
+  }
+
+  TEST(BulkRandomTest, Normal) {
+    RNG rng(23, RNG::XOSHIRO);
+    Vector draws(20001);
+    rnorm_mt(rng, draws, 3.0, 2.0);
+    EXPECT_TRUE(DistributionsMatch(draws, [](double x) {
+          return pnorm(x, 3.0, 2.0);
+        }));
+
+    // Strided views are filled correctly.
+    Matrix m(500, 3, -1.0);
+    rnorm_mt(rng, m.col(1), 0.0, 1.0);
+    EXPECT_TRUE(DistributionsMatch(Vector(m.col(1)), [](double x) {
+          return pnorm(x);
+        }));
+    EXPECT_DOUBLE_EQ(-1.0, m.col(0).max());
+    EXPECT_DOUBLE_EQ(-1.0, m.col(2).max());
+  }
+
+  TEST(BulkRandomTest, Gamma) {
+    RNG rng(29);
+    for (double shape : {0.3, 1.0, 4.5}) {
+      Vector draws(10000);
+      rgamma_mt(rng, draws, shape, 2.0);
+      EXPECT_TRUE(DistributionsMatch(draws, [shape](double x) {
+            return pgamma(x, shape, 2.0);
+          })) << "shape = " << shape;
+    }
+  }
+
+  TEST(BulkRandomTest, InverseGaussian) {
+    RNG rng(37);
+    for (double mu : {0.05, 1.0, 20.0}) {
+      Vector draws(10000);
+      rig_mt(rng, draws, Vector(draws.size(), mu), 2.0);
+      EXPECT_GT(draws.min(), 0.0);
+      EXPECT_TRUE(DistributionsMatch(draws, [mu](double x) {
+            return pig(x, mu, 2.0, false);
+          })) << "mu = " << mu;
+    }
+
+    // Different means in the same batch.
+    int n = 20000;
+    Vector mu(n);
+    for (int i = 0; i < n; ++i) {
+      mu[i] = i % 2 == 0 ? 0.5 : 3.0;
+    }
+    Vector draws(n);
+    rig_mt(rng, draws, mu, 1.0);
+    Vector even, odd;
+    for (int i = 0; i < n; i += 2) {
+      even.push_back(draws[i]);
+      odd.push_back(draws[i + 1]);
+    }
+    EXPECT_TRUE(DistributionsMatch(even, [](double x) {
+          return pig(x, 0.5, 1.0, false);
+        }));
+    EXPECT_TRUE(DistributionsMatch(odd, [](double x) {
+          return pig(x, 3.0, 1.0, false);
+        }));
+  }
+
+  TEST(BulkRandomTest, TruncatedNormal) {
+    RNG rng(31);
+    int n = 10000;
+    // One sided truncation in the body and in both tails.
+    for (double cutpoint : {-1.0, 0.5, 4.0}) {
+      for (bool positive : {true, false}) {
+        Vector draws(n);
+        rtrun_norm_mt(rng, draws, 1.0, 2.0, cutpoint, positive);
+        double tail = pnorm(cutpoint, 1.0, 2.0, !positive);
+        EXPECT_TRUE(DistributionsMatch(draws, [=](double x) {
+              double p = pnorm(x, 1.0, 2.0);
+              return positive ? (p - (1 - tail)) / tail : p / tail;
+            }, .001)) << "cutpoint = " << cutpoint << " positive = " << positive;
+      }
+    }
+
+    // Two sided truncation: wide and narrow intervals containing the mean,
+    // and narrow and wide intervals in both tails.
+    std::vector<std::pair<double, double>> intervals = {
+      {-3.0, 4.0}, {-0.2, 0.3}, {2.0, 2.1}, {2.0, 9.0}, {-9.0, -2.0},
+      {-3.05, -3.0}};
+    for (const auto &interval : intervals) {
+      double lo = interval.first;
+      double hi = interval.second;
+      Vector draws(n);
+      rtrun_norm_2_mt(rng, draws, Vector(n, 0.0), 1.0, Vector(n, lo),
+                      Vector(n, hi));
+      EXPECT_GE(draws.min(), lo);
+      EXPECT_LE(draws.max(), hi);
+      double plo = pnorm(lo);
+      double mass = pnorm(hi) - plo;
+      EXPECT_TRUE(DistributionsMatch(draws, [=](double x) {
+            return (pnorm(x) - plo) / mass;
+          }, .001)) << "interval = (" << lo << ", " << hi << ")";
+    }
+
+    // Different means and directions in the same batch, as in a probit
+    // imputer.
+    Vector mu(n);
+    std::vector<bool> positive(n);
+    for (int i = 0; i < n; ++i) {
+      mu[i] = (i % 7) - 3.0;
+      positive[i] = i % 3 == 0;
+    }
+    Vector draws(n);
+    rtrun_norm_mt(rng, draws, mu, 1.0, Vector(n, 0.0), positive);
+    for (int i = 0; i < n; ++i) {
+      if (positive[i]) {
+        EXPECT_GT(draws[i], 0.0);
+      } else {
+        EXPECT_LT(draws[i], 0.0);
+      }
+    }
+    double mean, variance;
+    Vector subset;
+    for (int i = 0; i < n; i += 21) subset.push_back(draws[i]);
+    // Observations i % 21 == 0 have mean -3 and positive support.
+    trun_norm_moments(-3.0, 1.0, 0.0, true, &mean, &variance);
+    EXPECT_NEAR(mean, subset.sum() / subset.size(),
+                4 * sqrt(variance / subset.size()));
+  }
+
+}  // namespace
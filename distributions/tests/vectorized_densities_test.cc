@@ -0,0 +1,85 @@
+#include "gtest/gtest.h"
+#include "distributions.hpp"
+#include "distributions/vectorized_densities.hpp"
+#include "LinAlg/Vector.hpp"
+#include "cpputil/math_utils.hpp"
+#include "test_utils/test_utils.hpp"
+
+namespace {
+
+  using namespace BOOM;
+  using std::cout;
+  using std::endl;
+
+  class VectorizedDensityTest : public ::testing::Test {
+   protected:
+    VectorizedDensityTest() {
+      GlobalRng::rng.seed(8675309);
+    }
+  };
+
+  TEST_F(VectorizedDensityTest, Normal) {
+    Vector x(37);
+    x.randomize_gaussian(1.2, 3.0);
+    Vector ans = dnorm_vector(x, 1.2, 3.0);
+    Vector raw = dnorm_vector(x, 1.2, 3.0, false);
+    for (int i = 0; i < x.size(); ++i) {
+      EXPECT_NEAR(ans[i], dnorm(x[i], 1.2, 3.0, true), 1e-10);
+      EXPECT_NEAR(raw[i], dnorm(x[i], 1.2, 3.0, false), 1e-12);
+    }
+  }
+
+  TEST_F(VectorizedDensityTest, Gamma) {
+    Vector x(23);
+    for (int i = 0; i < x.size(); ++i) {
+      x[i] = rgamma(2.3, 1.7);
+    }
+    x[3] = -1.0;
+    Vector ans = dgamma_vector(x, 2.3, 1.7);
+    for (int i = 0; i < x.size(); ++i) {
+      if (i != 3) {
+        EXPECT_NEAR(ans[i], dgamma(x[i], 2.3, 1.7, true), 1e-10);
+      }
+    }
+    EXPECT_EQ(ans[3], negative_infinity());
+  }
+
+  TEST_F(VectorizedDensityTest, Beta) {
+    Vector x(19);
+    for (int i = 0; i < x.size(); ++i) {
+      x[i] = rbeta(1.5, 4.0);
+    }
+    x[0] = 1.5;
+    Vector ans = dbeta_vector(x, 1.5, 4.0);
+    for (int i = 1; i < x.size(); ++i) {
+      EXPECT_NEAR(ans[i], dbeta(x[i], 1.5, 4.0, true), 1e-10);
+    }
+    EXPECT_EQ(ans[0], negative_infinity());
+  }
+
+  TEST_F(VectorizedDensityTest, Poisson) {
+    Vector x(29);
+    for (int i = 0; i < x.size(); ++i) {
+      x[i] = rpois(3.7);
+    }
+    Vector ans = dpois_vector(x, 3.7);
+    Vector raw = dpois_vector(x, 3.7, false);
+    for (int i = 0; i < x.size(); ++i) {
+      EXPECT_NEAR(ans[i], dpois(x[i], 3.7, true), 1e-10);
+      EXPECT_NEAR(raw[i], dpois(x[i], 3.7, false), 1e-12);
+    }
+  }
+
+  TEST_F(VectorizedDensityTest, Binomial) {
+    Vector n(17), x(17);
+    for (int i = 0; i < n.size(); ++i) {
+      n[i] = 1 + i;
+      x[i] = rbinom(n[i], .3);
+    }
+    Vector ans = dbinom_vector(x, n, .3);
+    for (int i = 0; i < x.size(); ++i) {
+      EXPECT_NEAR(ans[i], dbinom(x[i], n[i], .3, true), 1e-10);
+    }
+  }
+
+}  // namespace
@@ -0,0 +1,98 @@
+#include "gtest/gtest.h"
+#include "distributions.hpp"
+#include "distributions/vectorized_special_functions.hpp"
+#include "LinAlg/Vector.hpp"
+#include "cpputil/math_utils.hpp"
+#include "test_utils/test_utils.hpp"
+
+namespace {
+
+  using namespace BOOM;
+  using std::cout;
+  using std::endl;
+
+  // Arguments spanning many orders of magnitude, including the points where
+  // the shifted and unshifted code paths meet.
+  Vector test_arguments() {
+    Vector ans = {1e-150, 1e-20, 1e-8, .001, .1, .5, .9999, 1.0, 1.4616321,
+                  1.5, 2.0, 2.5, 3.7, 7.999999, 8.0, 8.000001, 12.3, 100.0,
+                  1e4, 1e8, 1e15, 1e100};
+    return ans;
+  }
+
+  // Check that 'value' matches 'truth' to within an absolute tolerance when
+  // truth is small, and a relative tolerance otherwise.
+  void check_close(double value, double truth, double x, double tol) {
+    double scale = std::max(1.0, std::fabs(truth));
+    EXPECT_NEAR(value, truth, tol * scale) << "x = " << x;
+  }
+
+  TEST(VectorizedSpecialFunctions, Lgamma) {
+    Vector x = test_arguments();
+    Vector ans = lgamma_vector(x);
+    for (int i = 0; i < x.size(); ++i) {
+      check_close(ans[i], BOOM::lgamma(x[i]), x[i], 1e-12);
+    }
+    EXPECT_NEAR(sum(ans), sum_lgamma(x), 1e-12 * std::fabs(sum(ans)));
+  }
+
+  TEST(VectorizedSpecialFunctions, Digamma) {
+    Vector x = test_arguments();
+    Vector ans = digamma_vector(x);
+    for (int i = 0; i < x.size(); ++i) {
+      if (x[i] > 1e-5) {
+        check_close(ans[i], BOOM::digamma(x[i]), x[i], 1e-12);
+      } else {
+        // The scalar version is inaccurate for tiny arguments, so compare
+        // against the leading terms of the series expansion about 0.
+        constexpr double euler_gamma = 0.57721566490153286;
+        check_close(ans[i], -1.0 / x[i] - euler_gamma, x[i], 1e-13);
+      }
+    }
+  }
+
+  TEST(VectorizedSpecialFunctions, Trigamma) {
+    Vector x = test_arguments();
+    Vector ans = trigamma_vector(x);
+    for (int i = 0; i < x.size(); ++i) {
+      EXPECT_NEAR(ans[i] / BOOM::trigamma(x[i]), 1.0, 1e-13) << "x = " << x[i];
+    }
+  }
+
+  TEST(VectorizedSpecialFunctions, OutOfRangeArgumentsUseScalarVersions) {
+    Vector x = {-2.5, -.3, 0.0, 1e305, 3.0};
+    Vector lg = lgamma_vector(x);
+    Vector dg = digamma_vector(x);
+    for (int i = 0; i < x.size(); ++i) {
+      EXPECT_DOUBLE_EQ(lg[i], BOOM::lgamma(x[i])) << "x = " << x[i];
+    }
+    EXPECT_DOUBLE_EQ(dg[0], BOOM::digamma(-2.5));
+    EXPECT_DOUBLE_EQ(dg[1], BOOM::digamma(-.3));
+  }
+
+  TEST(VectorizedSpecialFunctions, StridedViews) {
+    Vector x = test_arguments();
+    Vector ans(2 * x.size());
+    VectorView view(ans.data(), x.size(), 2);
+    lgamma_vector(ConstVectorView(x), view);
+    for (int i = 0; i < x.size(); ++i) {
+      check_close(view[i], BOOM::lgamma(x[i]), x[i], 1e-12);
+    }
+  }
+
+  TEST(VectorizedSpecialFunctions, LbetaAndLog1p) {
+    Vector a = {.3, 1.0, 2.5, 17.0, 400.0};
+    Vector b = {.7, 3.0, 2.5, .01, 900.0};
+    Vector ans = lbeta_vector(a, b);
+    for (int i = 0; i < a.size(); ++i) {
+      check_close(ans[i], BOOM::lbeta(a[i], b[i]), a[i], 1e-11);
+    }
+
+    Vector y = {-.5, 1e-12, .2, 3.0};
+    Vector l1p = log1p_vector(y);
+    for (int i = 0; i < y.size(); ++i) {
+      EXPECT_DOUBLE_EQ(l1p[i], std::log1p(y[i]));
+    }
+  }
+
+}  // namespace
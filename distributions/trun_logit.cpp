@@ -18,8 +18,11 @@
 */
 
 #include "distributions/trun_logit.hpp"
+#include <algorithm>
+#include <cmath>
 #include "cpputil/math_utils.hpp"
 #include "cpputil/Constants.hpp"
+#include "cpputil/report_error.hpp"
 #include "distributions.hpp"           // for plogis
 #include "math/special_functions.hpp"  // for dilog
 #include "stats/logit.hpp"             // for lope
@@ -173,4 +176,39 @@ namespace BOOM {
     return qlogis(ans) + mean;
   }
 
+  void rtrun_logit_2_mt(RNG &rng, VectorView out, const ConstVectorView &mean,
+                        double lo, double hi) {
+    if (out.size() != mean.size()) {
+      report_error("out and mean must be the same size in rtrun_logit_2_mt.");
+    }
+    if (!(lo < hi)) {
+      report_error("rtrun_logit_2_mt requires lo < hi.");
+    }
+    const int block_size = 256;
+    int n = out.size();
+    double uniforms[block_size];
+    for (int start = 0; start < n; start += block_size) {
+      int block = std::min<int>(block_size, n - start);
+      rng.fill_uniform(uniforms, block);
+      for (int i = 0; i < block; ++i) {
+        double mu = mean[start + i];
+        double a = lo - mu;
+        double b = hi - mu;
+        // The logistic CDF is accurate near 0 but not near 1, so an interval
+        // above the mean is reflected below it.
+        bool reflect = a > 0;
+        double left = reflect ? -b : a;
+        double right = reflect ? -a : b;
+        double F_left = 1.0 / (1.0 + exp(-left));
+        double F_right = 1.0 / (1.0 + exp(-right));
+        // Keep p away from 0 and 1 so the logit stays finite when the
+        // interval is unbounded.
+        double u = std::max(uniforms[i], 0x1.0p-54);
+        double p = std::min(F_left + u * (F_right - F_left), 1 - 0x1.0p-53);
+        double z = log(p) - log1p(-p);
+        out[start + i] = mu + (reflect ? -z : z);
+      }
+    }
+  }
+
 }  // namespace BOOM
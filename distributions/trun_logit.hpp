@@ -19,8 +19,8 @@
 #ifndef BOOM_DISTRIBUTIONS_TRUN_LOGIT_HPP_
 #define BOOM_DISTRIBUTIONS_TRUN_LOGIT_HPP_
 
+#include "LinAlg/VectorView.hpp"
 #include "distributions/rng.hpp"
-#include "distributions/trun_logit.hpp"
 
 namespace BOOM {
 
@@ -72,6 +72,15 @@ namespace BOOM {
   //   above: If true, then support is above 'cutpoint'.  Otherwise
   //     support is below 'cutpoint.'
   double rtrun_logit_mt(RNG &rng, double mean, double cutpoint, bool above);
+
+  // Bulk draws from two-sided truncated logistic distributions.  out[i] is a
+  // logistic deviate with location mean[i] and unit scale, truncated to the
+  // interval (lo, hi), either end of which may be infinite.  The uniform
+  // deviates are generated in blocks, and the inverse CDF transformation is
+  // free of branches so the loop vectorizes.  Intervals above the mean are
+  // reflected below it, so the draws stay accurate far into either tail.
+  void rtrun_logit_2_mt(RNG &rng, VectorView out, const ConstVectorView &mean,
+                        double lo, double hi);
 }  // namespace BOOM
 
 #endif  //  BOOM_DISTRIBUTIONS_TRUN_LOGIT_HPP_
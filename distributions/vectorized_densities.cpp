@@ -0,0 +1,230 @@
+/*
+  Copyright (C) 2005-2024 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include "distributions/vectorized_densities.hpp"
+#include <cmath>
+#include <sstream>
+#include "cpputil/Constants.hpp"
+#include "cpputil/cpu_dispatch.hpp"
+#include "cpputil/math_utils.hpp"
+#include "cpputil/report_error.hpp"
+
+namespace BOOM {
+
+  namespace {
+    void check_sizes(const ConstVectorView &x, const VectorView &ans,
+                     const char *caller) {
+      if (x.size() != ans.size()) {
+        std::ostringstream err;
+        err << "Size mismatch in " << caller << ".  x has size " << x.size()
+            << " but the output has size " << ans.size() << ".";
+        report_error(err.str());
+      }
+    }
+
+    // out[i] = log_normalizing_constant - 0.5 * precision * (x[i] - mu)^2.
+    BOOM_TARGET_CLONES
+    void dnorm_contiguous(const double *x, int n, double mu, double precision,
+                          double log_normalizing_constant, double *out) {
+      for (int i = 0; i < n; ++i) {
+        double z = x[i] - mu;
+        out[i] = log_normalizing_constant - 0.5 * precision * z * z;
+      }
+    }
+
+    // Convert log densities to the requested scale.
+    void finish(VectorView ans, bool logscale) {
+      if (!logscale) {
+        int n = ans.size();
+        for (int i = 0; i < n; ++i) ans[i] = std::exp(ans[i]);
+      }
+    }
+  }  // namespace
+
+  //===========================================================================
+  void dnorm_vector(const ConstVectorView &x, double mu, double sigma,
+                    VectorView ans, bool logscale) {
+    check_sizes(x, ans, "dnorm_vector");
+    if (!(sigma > 0) || !std::isfinite(sigma)) {
+      report_error("sigma must be positive and finite in dnorm_vector.");
+    }
+    const double log_normalizing_constant =
+        -Constants::log_root_2pi - std::log(sigma);
+    const double precision = 1.0 / (sigma * sigma);
+    int n = x.size();
+    if (x.stride() == 1 && ans.stride() == 1) {
+      dnorm_contiguous(x.data(), n, mu, precision, log_normalizing_constant,
+                       ans.data());
+    } else {
+      for (int i = 0; i < n; ++i) {
+        double z = x[i] - mu;
+        ans[i] = log_normalizing_constant - 0.5 * precision * z * z;
+      }
+    }
+    finish(ans, logscale);
+  }
+
+  Vector dnorm_vector(const ConstVectorView &x, double mu, double sigma,
+                      bool logscale) {
+    Vector ans(x.size());
+    dnorm_vector(x, mu, sigma, VectorView(ans), logscale);
+    return ans;
+  }
+
+  //===========================================================================
+  void dgamma_vector(const ConstVectorView &x, double a, double b,
+                     VectorView ans, bool logscale) {
+    check_sizes(x, ans, "dgamma_vector");
+    if (!(a > 0) || !(b > 0)) {
+      report_error("Both parameters must be positive in dgamma_vector.");
+    }
+    const double log_normalizing_constant = a * std::log(b) - std::lgamma(a);
+    const double am1 = a - 1;
+    int n = x.size();
+    for (int i = 0; i < n; ++i) {
+      double y = x[i];
+      ans[i] = log_normalizing_constant + am1 * std::log(y) - b * y;
+    }
+    // Patch up the boundary of the support.  This loop is separate so the
+    // main loop above has no branches.
+    for (int i = 0; i < n; ++i) {
+      double y = x[i];
+      if (y < 0) {
+        ans[i] = negative_infinity();
+      } else if (y == 0) {
+        ans[i] = a < 1 ? infinity() : a > 1 ? negative_infinity() : std::log(b);
+      }
+    }
+    finish(ans, logscale);
+  }
+
+  Vector dgamma_vector(const ConstVectorView &x, double a, double b,
+                       bool logscale) {
+    Vector ans(x.size());
+    dgamma_vector(x, a, b, VectorView(ans), logscale);
+    return ans;
+  }
+
+  //===========================================================================
+  void dbeta_vector(const ConstVectorView &x, double a, double b,
+                    VectorView ans, bool logscale) {
+    check_sizes(x, ans, "dbeta_vector");
+    if (!(a > 0) || !(b > 0)) {
+      report_error("Both parameters must be positive in dbeta_vector.");
+    }
+    const double log_normalizing_constant =
+        std::lgamma(a + b) - std::lgamma(a) - std::lgamma(b);
+    const double am1 = a - 1;
+    const double bm1 = b - 1;
+    int n = x.size();
+    for (int i = 0; i < n; ++i) {
+      double y = x[i];
+      ans[i] = log_normalizing_constant + am1 * std::log(y) +
+               bm1 * std::log1p(-y);
+    }
+    for (int i = 0; i < n; ++i) {
+      double y = x[i];
+      if (y < 0 || y > 1) {
+        ans[i] = negative_infinity();
+      } else if (y == 0) {
+        ans[i] = a < 1 ? infinity() : a > 1 ? negative_infinity()
+                                            : log_normalizing_constant;
+      } else if (y == 1) {
+        ans[i] = b < 1 ? infinity() : b > 1 ? negative_infinity()
+                                            : log_normalizing_constant;
+      }
+    }
+    finish(ans, logscale);
+  }
+
+  Vector dbeta_vector(const ConstVectorView &x, double a, double b,
+                      bool logscale) {
+    Vector ans(x.size());
+    dbeta_vector(x, a, b, VectorView(ans), logscale);
+    return ans;
+  }
+
+  //===========================================================================
+  void dpois_vector(const ConstVectorView &x, double lambda, VectorView ans,
+                    bool logscale) {
+    check_sizes(x, ans, "dpois_vector");
+    if (!(lambda >= 0)) {
+      report_error("lambda must be non-negative in dpois_vector.");
+    }
+    int n = x.size();
+    if (lambda == 0) {
+      for (int i = 0; i < n; ++i) ans[i] = x[i] == 0 ? 0 : negative_infinity();
+    } else {
+      const double log_lambda = std::log(lambda);
+      for (int i = 0; i < n; ++i) {
+        double y = x[i];
+        ans[i] = y * log_lambda - lambda - std::lgamma(y + 1);
+      }
+      for (int i = 0; i < n; ++i) {
+        double y = x[i];
+        if (y < 0 || y != std::floor(y)) ans[i] = negative_infinity();
+      }
+    }
+    finish(ans, logscale);
+  }
+
+  Vector dpois_vector(const ConstVectorView &x, double lambda, bool logscale) {
+    Vector ans(x.size());
+    dpois_vector(x, lambda, VectorView(ans), logscale);
+    return ans;
+  }
+
+  //===========================================================================
+  void dbinom_vector(const ConstVectorView &x, const ConstVectorView &n,
+                     double p, VectorView ans, bool logscale) {
+    check_sizes(x, ans, "dbinom_vector");
+    check_sizes(n, ans, "dbinom_vector");
+    if (!(p >= 0 && p <= 1)) {
+      report_error("p must be in [0, 1] in dbinom_vector.");
+    }
+    int size = x.size();
+    if (p == 0 || p == 1) {
+      for (int i = 0; i < size; ++i) {
+        double degenerate_value = p == 0 ? 0 : n[i];
+        ans[i] = x[i] == degenerate_value ? 0 : negative_infinity();
+      }
+    } else {
+      const double logp = std::log(p);
+      const double logq = std::log1p(-p);
+      for (int i = 0; i < size; ++i) {
+        double y = x[i];
+        double trials = n[i];
+        ans[i] = std::lgamma(trials + 1) - std::lgamma(y + 1)
+            - std::lgamma(trials - y + 1) + y * logp + (trials - y) * logq;
+      }
+    }
+    for (int i = 0; i < size; ++i) {
+      double y = x[i];
+      if (y < 0 || y > n[i] || y != std::floor(y)) ans[i] = negative_infinity();
+    }
+    finish(ans, logscale);
+  }
+
+  Vector dbinom_vector(const ConstVectorView &x, const ConstVectorView &n,
+                       double p, bool logscale) {
+    Vector ans(x.size());
+    dbinom_vector(x, n, p, VectorView(ans), logscale);
+    return ans;
+  }
+
+}  // namespace BOOM
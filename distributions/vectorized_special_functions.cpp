@@ -0,0 +1,232 @@
+/*
+  Copyright (C) 2005-2024 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include "distributions/vectorized_special_functions.hpp"
+#include <cmath>
+#include <sstream>
+#include "cpputil/Constants.hpp"
+#include "cpputil/report_error.hpp"
+#include "distributions.hpp"
+
+namespace BOOM {
+
+  namespace {
+    // Arguments are shifted until they are at least this large before the
+    // asymptotic series are applied.
+    constexpr double kShiftThreshold = 8.0;
+    constexpr int kMaxShifts = 8;
+
+    void check_sizes(const ConstVectorView &x, const VectorView &ans,
+                     const char *caller) {
+      if (x.size() != ans.size()) {
+        std::ostringstream err;
+        err << "Size mismatch in " << caller << ".  The input has size "
+            << x.size() << " but the output has size " << ans.size() << ".";
+        report_error(err.str());
+      }
+    }
+
+    // True if x can be handled by the vectorized code path.  The lower limit
+    // keeps 1 / x^2 finite in trigamma_kernel.
+    inline bool in_range(double x) { return x >= 1e-150 && x <= 1e300; }
+
+    // lgamma(x) for x >= kShiftThreshold, from Stirling's series.
+    inline double lgamma_asymptotic(double x) {
+      double r = 1.0 / x;
+      double r2 = r * r;
+      double series =
+          r * (1.0 / 12 +
+               r2 * (-1.0 / 360 +
+                     r2 * (1.0 / 1260 +
+                           r2 * (-1.0 / 1680 +
+                                 r2 * (1.0 / 1188 +
+                                       r2 * (-691.0 / 360360 +
+                                             r2 * (1.0 / 156)))))));
+      return (x - 0.5) * std::log(x) - x + Constants::log_root_2pi + series;
+    }
+
+    inline double lgamma_kernel(double x) {
+      // lgamma(x) = lgamma(x + 1) - log(x).  The shifts are accumulated as
+      // a product so only one extra log is needed.
+      double product = 1.0;
+      for (int k = 0; k < kMaxShifts; ++k) {
+        bool shift = x < kShiftThreshold;
+        product *= shift ? x : 1.0;
+        x += shift ? 1.0 : 0.0;
+      }
+      return lgamma_asymptotic(x) - std::log(product);
+    }
+
+    inline double digamma_kernel(double x) {
+      // digamma(x) = digamma(x + 1) - 1 / x.
+      double correction = 0.0;
+      for (int k = 0; k < kMaxShifts; ++k) {
+        bool shift = x < kShiftThreshold;
+        correction += shift ? 1.0 / x : 0.0;
+        x += shift ? 1.0 : 0.0;
+      }
+      double r = 1.0 / x;
+      double r2 = r * r;
+      double series =
+          r2 * (1.0 / 12 +
+                r2 * (-1.0 / 120 +
+                      r2 * (1.0 / 252 +
+                            r2 * (-1.0 / 240 +
+                                  r2 * (1.0 / 132 +
+                                        r2 * (-691.0 / 32760 +
+                                              r2 * (1.0 / 12)))))));
+      return std::log(x) - 0.5 * r - series - correction;
+    }
+
+    inline double trigamma_kernel(double x) {
+      // trigamma(x) = trigamma(x + 1) + 1 / x^2.
+      double correction = 0.0;
+      for (int k = 0; k < kMaxShifts; ++k) {
+        bool shift = x < kShiftThreshold;
+        correction += shift ? 1.0 / (x * x) : 0.0;
+        x += shift ? 1.0 : 0.0;
+      }
+      double r = 1.0 / x;
+      double r2 = r * r;
+      double series =
+          r * (1.0 +
+               r * (0.5 +
+                    r * (1.0 / 6 +
+                         r2 * (-1.0 / 30 +
+                               r2 * (1.0 / 42 +
+                                     r2 * (-1.0 / 30 +
+                                           r2 * (5.0 / 66 +
+                                                 r2 * (-691.0 / 2730 +
+                                                       r2 * (7.0 / 6)))))))));
+      return series + correction;
+    }
+
+    // Apply 'kernel' to each element of x, and 'scalar' to the elements that
+    // are out of range for the kernel.
+    template <class KERNEL, class SCALAR>
+    void apply(const ConstVectorView &x, VectorView ans, KERNEL kernel,
+               SCALAR scalar, const char *caller) {
+      check_sizes(x, ans, caller);
+      int n = x.size();
+      if (x.stride() == 1 && ans.stride() == 1) {
+        const double *xd = x.data();
+        double *out = ans.data();
+        for (int i = 0; i < n; ++i) {
+          // Out of range arguments are replaced by 1 here, and fixed below.
+          out[i] = kernel(in_range(xd[i]) ? xd[i] : 1.0);
+        }
+      } else {
+        for (int i = 0; i < n; ++i) {
+          ans[i] = kernel(in_range(x[i]) ? x[i] : 1.0);
+        }
+      }
+      for (int i = 0; i < n; ++i) {
+        if (!in_range(x[i])) {
+          ans[i] = scalar(x[i]);
+        }
+      }
+    }
+  }  // namespace
+
+  //===========================================================================
+  void lgamma_vector(const ConstVectorView &x, VectorView ans) {
+    apply(x, ans, lgamma_kernel, [](double y) { return lgamma(y); },
+          "lgamma_vector");
+  }
+
+  Vector lgamma_vector(const ConstVectorView &x) {
+    Vector ans(x.size());
+    lgamma_vector(x, VectorView(ans));
+    return ans;
+  }
+
+  //===========================================================================
+  void digamma_vector(const ConstVectorView &x, VectorView ans) {
+    apply(x, ans, digamma_kernel, [](double y) { return digamma(y); },
+          "digamma_vector");
+  }
+
+  Vector digamma_vector(const ConstVectorView &x) {
+    Vector ans(x.size());
+    digamma_vector(x, VectorView(ans));
+    return ans;
+  }
+
+  //===========================================================================
+  void trigamma_vector(const ConstVectorView &x, VectorView ans) {
+    apply(x, ans, trigamma_kernel, [](double y) { return trigamma(y); },
+          "trigamma_vector");
+  }
+
+  Vector trigamma_vector(const ConstVectorView &x) {
+    Vector ans(x.size());
+    trigamma_vector(x, VectorView(ans));
+    return ans;
+  }
+
+  //===========================================================================
+  void log1p_vector(const ConstVectorView &x, VectorView ans) {
+    check_sizes(x, ans, "log1p_vector");
+    int n = x.size();
+    for (int i = 0; i < n; ++i) {
+      ans[i] = std::log1p(x[i]);
+    }
+  }
+
+  Vector log1p_vector(const ConstVectorView &x) {
+    Vector ans(x.size());
+    log1p_vector(x, VectorView(ans));
+    return ans;
+  }
+
+  //===========================================================================
+  void lbeta_vector(const ConstVectorView &a, const ConstVectorView &b,
+                    VectorView ans) {
+    check_sizes(a, ans, "lbeta_vector");
+    check_sizes(b, ans, "lbeta_vector");
+    int n = a.size();
+    for (int i = 0; i < n; ++i) {
+      double ai = a[i];
+      double bi = b[i];
+      if (in_range(ai) && in_range(bi) && in_range(ai + bi)) {
+        ans[i] = lgamma_kernel(ai) + lgamma_kernel(bi) -
+                 lgamma_kernel(ai + bi);
+      } else {
+        ans[i] = lbeta(ai, bi);
+      }
+    }
+  }
+
+  Vector lbeta_vector(const ConstVectorView &a, const ConstVectorView &b) {
+    Vector ans(a.size());
+    lbeta_vector(a, b, VectorView(ans));
+    return ans;
+  }
+
+  //===========================================================================
+  double sum_lgamma(const ConstVectorView &x) {
+    double ans = 0;
+    int n = x.size();
+    for (int i = 0; i < n; ++i) {
+      double y = x[i];
+      ans += in_range(y) ? lgamma_kernel(y) : lgamma(y);
+    }
+    return ans;
+  }
+
+}  // namespace BOOM
@@ -0,0 +1,79 @@
+#ifndef BOOM_DISTRIBUTIONS_VECTORIZED_SPECIAL_FUNCTIONS_HPP_
+#define BOOM_DISTRIBUTIONS_VECTORIZED_SPECIAL_FUNCTIONS_HPP_
+
+/*
+  Copyright (C) 2005-2024 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include "LinAlg/Vector.hpp"
+#include "LinAlg/VectorView.hpp"
+
+// Special functions evaluated over whole arrays in a single call.
+//
+// The log likelihoods of the gamma, beta and Dirichlet families spend most
+// of their time in lgamma, digamma and trigamma.  The scalar versions in
+// Bmath branch on the size of the argument, which prevents the compiler
+// from vectorizing a loop that calls them.  The kernels here use a single
+// code path for positive arguments: the recurrence relation is applied a
+// fixed number of times (with a mask, so arguments that are already large
+// are left alone) to shift every argument above 8, and an asymptotic series
+// is applied to the result.  Arguments that are not positive and finite are
+// handed to the scalar versions in a separate pass.
+//
+// Accuracy relative to the scalar Bmath versions, for arguments in
+// [1e-150, 1e300]:
+//   lgamma_vector:   absolute error below 1e-12 when |lgamma(x)| < 1, and
+//                    relative error below 1e-13 otherwise.
+//   digamma_vector:  same tolerances as lgamma_vector, for x > 1e-5.  For
+//                    smaller x the scalar version loses accuracy, while
+//                    digamma_vector remains accurate to 1e-13 relative to
+//                    the series -1/x - EulerGamma.
+//   trigamma_vector: relative error below 1e-13.
+//   log1p_vector and lbeta_vector agree with the scalar versions to within
+//   the tolerance of lgamma_vector.
+// These tolerances are checked in tests/vectorized_special_functions_test.cc.
+//
+// As in vectorized_densities.hpp, each function writes into a
+// caller-supplied view of the same size as its input, or returns a newly
+// allocated Vector.
+
+namespace BOOM {
+
+  void lgamma_vector(const ConstVectorView &x, VectorView ans);
+  Vector lgamma_vector(const ConstVectorView &x);
+
+  void digamma_vector(const ConstVectorView &x, VectorView ans);
+  Vector digamma_vector(const ConstVectorView &x);
+
+  void trigamma_vector(const ConstVectorView &x, VectorView ans);
+  Vector trigamma_vector(const ConstVectorView &x);
+
+  void log1p_vector(const ConstVectorView &x, VectorView ans);
+  Vector log1p_vector(const ConstVectorView &x);
+
+  // ans[i] = log(Beta(a[i], b[i])).
+  void lbeta_vector(const ConstVectorView &a, const ConstVectorView &b,
+                    VectorView ans);
+  Vector lbeta_vector(const ConstVectorView &a, const ConstVectorView &b);
+
+  // Returns the sum of lgamma(x[i]).  This is the form in which lgamma
+  // usually enters a log likelihood.
+  double sum_lgamma(const ConstVectorView &x);
+
+}  // namespace BOOM
+
+#endif  // BOOM_DISTRIBUTIONS_VECTORIZED_SPECIAL_FUNCTIONS_HPP_
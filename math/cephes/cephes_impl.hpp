@@ -42,6 +42,60 @@ namespace BOOM {
     double spence(double x);
     double zeta(double x, double q);
     double zetac(double x);
+
+    // Batched versions of the functions above.  ans[i] is the function
+    // evaluated at x[i], for i = 0, ..., n-1.  The inner loops run over the
+    // points rather than the coefficients, so they vectorize.
+    void chbevl(const double *x, double *ans, int n, const double *array,
+                int number_of_coefficients);
+    void p1evl(const double *x, double *ans, int n, const double *coef,
+               int N);
+    void polevl(const double *x, double *ans, int n, const double *coef,
+                int N);
+    void spence(const double *x, double *ans, int n);
+
+    //----------------------------------------------------------------------
+    // Versions of polevl and p1evl where the degree is known at compile
+    // time, as it is for every fixed coefficient table in this directory.
+    // The Horner loop has a constant trip count, so it is fully unrolled,
+    // and a loop over points that calls these functions can be vectorized.
+    template <int N>
+    inline double polevl(double x, const double *coef) {
+      double ans = coef[0];
+      for (int i = 1; i <= N; ++i) {
+        ans = ans * x + coef[i];
+      }
+      return ans;
+    }
+
+    // Same as polevl<N>, but the leading coefficient is 1 and is omitted
+    // from coef.
+    template <int N>
+    inline double p1evl(double x, const double *coef) {
+      double ans = x + coef[0];
+      for (int i = 1; i < N; ++i) {
+        ans = ans * x + coef[i];
+      }
+      return ans;
+    }
+
+    // Batched evaluation of polevl<N>.
+    template <int N>
+    inline void polevl(const double *x, double *ans, int n,
+                       const double *coef) {
+      for (int i = 0; i < n; ++i) {
+        ans[i] = polevl<N>(x[i], coef);
+      }
+    }
+
+    // Batched evaluation of p1evl<N>.
+    template <int N>
+    inline void p1evl(const double *x, double *ans, int n,
+                      const double *coef) {
+      for (int i = 0; i < n; ++i) {
+        ans[i] = p1evl<N>(x[i], coef);
+      }
+    }
   }
 }
 
@@ -16,6 +16,7 @@
   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
 */
 
+#include <algorithm>
 #include <cmath>
 #include <vector>
 
@@ -100,5 +101,35 @@ Direct inquiries to 30 Frost Street, Cambridge, MA 02140
 
       return( 0.5*(b0-b2) );
     }
+
+    // Batched version.  The three term recurrence is run for all points in
+    // a block at once, with the loop over points innermost so it vectorizes.
+    void chbevl(const double *x, double *ans, int n, const double *array,
+                int number_of_coefficients) {
+      const int block_size = 256;
+      double b0[block_size];
+      double b1[block_size];
+      double b2[block_size];
+      for (int start = 0; start < n; start += block_size) {
+        const int m = std::min(n - start, block_size);
+        const double *xx = x + start;
+        for (int i = 0; i < m; ++i) {
+          b0[i] = array[0];
+          b1[i] = 0.0;
+          b2[i] = 0.0;
+        }
+        for (int k = 1; k < number_of_coefficients; ++k) {
+          const double c = array[k];
+          for (int i = 0; i < m; ++i) {
+            b2[i] = b1[i];
+            b1[i] = b0[i];
+            b0[i] = xx[i] * b1[i] - b2[i] + c;
+          }
+        }
+        for (int i = 0; i < m; ++i) {
+          ans[start + i] = 0.5 * (b0[i] - b2[i]);
+        }
+      }
+    }
   }  // namespace Cephes
 }  // namespace BOOM
@@ -19,6 +19,8 @@
 // This file was modified from the public domain cephes math library
 // taken from netlib.
 
+#include <algorithm>
+
 namespace BOOM {
   namespace Cephes {
 
@@ -111,5 +113,46 @@ Direct inquiries to 30 Frost Street, Cambridge, MA 02140
       return( ans );
     }
 
+    //----------------------------------------------------------------------
+    // Batched versions.  The points are processed in blocks small enough to
+    // stay in L1 cache.  Within a block the loop over coefficients is
+    // outermost, so the inner loop is a vectorizable multiply-add over the
+    // points in the block.
+    namespace {
+      const int kBlockSize = 256;
+    }  // namespace
+
+    void polevl(const double *x, double *ans, int n, const double *coef,
+                int N) {
+      for (int start = 0; start < n; start += kBlockSize) {
+        const int end = std::min(n, start + kBlockSize);
+        for (int i = start; i < end; ++i) {
+          ans[i] = coef[0];
+        }
+        for (int k = 1; k <= N; ++k) {
+          const double c = coef[k];
+          for (int i = start; i < end; ++i) {
+            ans[i] = ans[i] * x[i] + c;
+          }
+        }
+      }
+    }
+
+    void p1evl(const double *x, double *ans, int n, const double *coef,
+               int N) {
+      for (int start = 0; start < n; start += kBlockSize) {
+        const int end = std::min(n, start + kBlockSize);
+        for (int i = start; i < end; ++i) {
+          ans[i] = x[i] + coef[0];
+        }
+        for (int k = 1; k < N; ++k) {
+          const double c = coef[k];
+          for (int i = start; i < end; ++i) {
+            ans[i] = ans[i] * x[i] + c;
+          }
+        }
+      }
+    }
+
   }  // namespace Cephes
 }  // namespace BOOM
@@ -284,7 +284,7 @@ namespace BOOM {
       if (x >= 0.875)
       {
         u = 1.0 - x;
-        s = polevl(u, A4, 12) / p1evl(u, B4, 12);
+        s = polevl<12>(u, A4) / p1evl<12>(u, B4);
         s =  s * u * u - 1.202056903159594285400 * u;
         s +=  1.0823232337111381915160;
         return s;
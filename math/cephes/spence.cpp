@@ -19,6 +19,7 @@
 // This file was modified from the public domain cephes math library
 // taken from netlib.
 
+#include <algorithm>
 #include "cephes_impl.hpp"
 
 namespace BOOM {
@@ -135,7 +136,7 @@ namespace BOOM {
       w = x - 1.0;
 
 
-    y = -w * polevl( w, A, 7) / polevl( w, B, 7 );
+    y = -w * polevl<7>(w, A) / polevl<7>(w, B);
 
     if( flag & 1 )
       y = (PI * PI)/6.0  - log(x) * log(1.0-x) - y;
@@ -148,5 +149,72 @@ namespace BOOM {
 
     return( y );
   }
+
+  // Batched version of spence.  Each block of points is handled in three
+  // passes: map the points into the range of the rational approximation,
+  // evaluate the approximation for the whole block, then undo the
+  // transformations.  The middle pass, which does most of the arithmetic,
+  // vectorizes.
+  void spence(const double *x, double *ans, int n) {
+    for (int i = 0; i < n; ++i) {
+      if (x[i] < 0.0) {
+        report_error("Domain error in BOOM::Cephes::spence:  x < 0.");
+      }
+    }
+
+    const int block_size = 256;
+    double xt[block_size];
+    double w[block_size];
+    double numerator[block_size];
+    double denominator[block_size];
+    int flag[block_size];
+    for (int start = 0; start < n; start += block_size) {
+      const int m = std::min(n - start, block_size);
+      const double *xx = x + start;
+      double *y = ans + start;
+
+      for (int i = 0; i < m; ++i) {
+        double xi = xx[i];
+        int f = 0;
+        if (xi > 2.0) {
+          xi = 1.0 / xi;
+          f |= 2;
+        }
+        if (xi > 1.5) {
+          w[i] = (1.0 / xi) - 1.0;
+          f |= 2;
+        } else if (xi < 0.5) {
+          w[i] = -xi;
+          f |= 1;
+        } else {
+          w[i] = xi - 1.0;
+        }
+        xt[i] = xi;
+        flag[i] = f;
+      }
+
+      polevl<7>(w, numerator, m, A);
+      polevl<7>(w, denominator, m, B);
+
+      for (int i = 0; i < m; ++i) {
+        if (xx[i] == 1.0) {
+          y[i] = 0.0;
+          continue;
+        } else if (xx[i] == 0.0) {
+          y[i] = PI * PI / 6.0;
+          continue;
+        }
+        double yi = -w[i] * numerator[i] / denominator[i];
+        if (flag[i] & 1) {
+          yi = (PI * PI) / 6.0 - log(xt[i]) * log(1.0 - xt[i]) - yi;
+        }
+        if (flag[i] & 2) {
+          double z = log(xt[i]);
+          yi = -0.5 * z * z - yi;
+        }
+        y[i] = yi;
+      }
+    }
+  }
   }  // namespace Cephes
 }  // namespace BOOM
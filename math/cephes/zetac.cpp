@@ -223,7 +223,7 @@ namespace BOOM {
     if( x < 1.0 )
     {
       w = 1.0 - x;
-      a = polevl( x, R, 5 ) / ( w * p1evl( x, S, 5 ));
+      a = polevl<5>(x, R) / ( w * p1evl<5>(x, S));
       return( a );
     }
 
@@ -237,14 +237,14 @@ namespace BOOM {
     {
       b = pow( 2.0, x ) * (x - 1.0);
       w = 1.0/x;
-      s = (x * polevl( w, P, 8 )) / (b * p1evl( w, Q, 8 ));
+      s = (x * polevl<8>(w, P)) / (b * p1evl<8>(w, Q));
       return( s );
     }
 
     if( x <= 50.0 )
     {
       b = pow( 2.0, -x );
-      w = polevl( x, A, 10 ) / p1evl( x, B, 10 );
+      w = polevl<10>(x, A) / p1evl<10>(x, B);
       w = exp(w) + b;
       return(w);
     }
@@ -18,6 +18,7 @@
 
 #include "math/fft.hpp"
 #include "math/kissfft/kiss_fft.hpp"
+#include <algorithm>
 #include <vector>
 #include <complex>
 #include <sstream>
@@ -133,4 +134,49 @@ namespace BOOM {
     return out.str();
   }
 
+  //===========================================================================
+  RealFftPlan::RealFftPlan(int nfft)
+      : nfft_(nfft),
+        workspace_(nfft, 0.0)
+  {
+    if (nfft <= 0 || nfft % 2 != 0) {
+      std::ostringstream err;
+      err << "RealFftPlan requires a positive even length.  Got " << nfft
+          << ".";
+      report_error(err.str());
+    }
+    forward_config_.reset(new FFT::RealConfig(nfft, false));
+    inverse_config_.reset(new FFT::RealConfig(nfft, true));
+  }
+
+  // Defined here, where FFT::RealConfig is a complete type.
+  RealFftPlan::~RealFftPlan() {}
+
+  void RealFftPlan::transform(const ConstVectorView &time_domain,
+                              ComplexVector &frequency_domain) {
+    if (time_domain.size() > nfft_) {
+      std::ostringstream err;
+      err << "A series of length " << time_domain.size()
+          << " cannot be transformed by a plan of length " << nfft_ << ".";
+      report_error(err.str());
+    }
+    std::copy(time_domain.begin(), time_domain.end(), workspace_.begin());
+    std::fill(workspace_.begin() + time_domain.size(), workspace_.end(), 0.0);
+    frequency_domain.resize(frequency_size());
+    FFT::kiss_fftr(*forward_config_, workspace_, frequency_domain);
+  }
+
+  void RealFftPlan::inverse_transform(const ComplexVector &frequency_domain,
+                                      Vector &time_domain) {
+    if (frequency_domain.size() != frequency_size()) {
+      std::ostringstream err;
+      err << "The frequency domain has " << frequency_domain.size()
+          << " elements, but a plan of length " << nfft_ << " requires "
+          << frequency_size() << ".";
+      report_error(err.str());
+    }
+    time_domain.resize(nfft_);
+    FFT::kiss_fftri(*inverse_config_, frequency_domain, time_domain);
+  }
+
 }  // namespace BOOM
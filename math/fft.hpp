@@ -19,8 +19,10 @@
 */
 
 #include "LinAlg/Vector.hpp"
+#include "LinAlg/VectorView.hpp"
 #include <vector>
 #include <complex>
+#include <memory>
 
 namespace FFT {
   class RealConfig;
@@ -86,6 +88,58 @@ namespace BOOM {
     void reflect(std::vector<std::complex<double>> &freq) const;
   };
 
+  //===========================================================================
+  // A real-input FFT of a fixed, even length.  The kissfft configurations
+  // (factorization, twiddle factors, and scratch space) for the forward and
+  // inverse transforms are built once by the constructor and reused by every
+  // call, so transforming many series of the same length costs one setup
+  // instead of one per series.
+  //
+  // Unlike FastFourierTransform, the frequency domain here is only the
+  // non-redundant half of the spectrum: nfft / 2 + 1 complex values.
+  //
+  // A plan holds scratch buffers, so it must not be shared across threads.
+  // Give each thread its own plan.
+  class RealFftPlan {
+   public:
+    // Args:
+    //   nfft:  The transform length.  Must be even and positive.
+    explicit RealFftPlan(int nfft);
+    ~RealFftPlan();
+
+    int nfft() const {return nfft_;}
+
+    // The number of complex values in the frequency domain: nfft / 2 + 1.
+    int frequency_size() const {return nfft_ / 2 + 1;}
+
+    // The forward transform of a real sequence.
+    //
+    // Args:
+    //   time_domain: The sequence to transform.  If it is shorter than nfft
+    //     it is padded with zeros.  It is an error for it to be longer.
+    //   frequency_domain: On output, contains the first nfft / 2 + 1 elements
+    //     of the discrete Fourier transform of the padded sequence.
+    void transform(const ConstVectorView &time_domain,
+                   std::vector<std::complex<double>> &frequency_domain);
+
+    // The inverse transform of a half spectrum produced by 'transform'.
+    //
+    // Args:
+    //   frequency_domain:  A vector of nfft / 2 + 1 complex values.
+    //   time_domain: On output, a real sequence of length nfft.  As with
+    //     FastFourierTransform, the output is not scaled, so a round trip
+    //     multiplies the original sequence by nfft.
+    void inverse_transform(
+        const std::vector<std::complex<double>> &frequency_domain,
+        Vector &time_domain);
+
+   private:
+    int nfft_;
+    std::unique_ptr<FFT::RealConfig> forward_config_;
+    std::unique_ptr<FFT::RealConfig> inverse_config_;
+    Vector workspace_;
+  };
+
 }  // namespace BOOM
 
 #endif  //  BOOM_MATH_FFT_HPP_
@@ -0,0 +1,51 @@
+/*
+  Copyright (C) 2005-2024 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#include "math/special_functions.hpp"
+#include "math/cephes/cephes_impl.hpp"
+#include "LinAlg/VectorView.hpp"
+
+#include <vector>
+
+namespace BOOM {
+
+  Vector dilog(const ConstVectorView &x) {
+    Vector ans(x.size());
+    // Gather the elements handled by spence into a contiguous buffer, and
+    // send them through the batched implementation all at once.
+    std::vector<int> position;
+    std::vector<double> one_minus_x;
+    position.reserve(x.size());
+    one_minus_x.reserve(x.size());
+    for (int i = 0; i < x.size(); ++i) {
+      if (0 < x[i] && x[i] < 1) {
+        position.push_back(i);
+        one_minus_x.push_back(1 - x[i]);
+      } else {
+        ans[i] = polylog(2, x[i]);
+      }
+    }
+    std::vector<double> values(one_minus_x.size());
+    Cephes::spence(one_minus_x.data(), values.data(), one_minus_x.size());
+    for (int j = 0; j < position.size(); ++j) {
+      ans[position[j]] = values[j];
+    }
+    return ans;
+  }
+
+}  // namespace BOOM
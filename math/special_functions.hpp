@@ -19,6 +19,8 @@
 #ifndef BOOM_MATH_SPECIAL_FUNCTIONS_HPP_
 #define BOOM_MATH_SPECIAL_FUNCTIONS_HPP_
 
+#include "LinAlg/Vector.hpp"
+
 namespace BOOM {
 
   namespace Cephes {
@@ -48,6 +50,11 @@ namespace BOOM {
     }
   }
 
+  // The dilogarithm evaluated at each element of x.  Elements in (0, 1) are
+  // evaluated together, which is much faster than calling the scalar
+  // version in a loop.
+  Vector dilog(const ConstVectorView &x);
+
   //======================================================================
   // Returns the log of the multivariate gamma function.
   // Args:
@@ -188,4 +188,39 @@ namespace {
     CheckResults(x, real_z, imag_z);
   }
 
+  // A plan reproduces FastFourierTransform on the non-redundant half of the
+  // spectrum, and can be reused across series.
+  TEST_F(FFTtest, RealFftPlan) {
+    FastFourierTransform fft;
+    RealFftPlan plan(12);
+    EXPECT_EQ(7, plan.frequency_size());
+    ComplexVector half;
+    Vector inverse;
+    for (int rep = 0; rep < 3; ++rep) {
+      Vector x(12);
+      x.randomize();
+      ComplexVector full = fft.transform(x);
+      plan.transform(x, half);
+      ASSERT_EQ(7, half.size());
+      for (int k = 0; k < 7; ++k) {
+        EXPECT_NEAR(full[k].real(), half[k].real(), 1e-10);
+        EXPECT_NEAR(full[k].imag(), half[k].imag(), 1e-10);
+      }
+      plan.inverse_transform(half, inverse);
+      EXPECT_TRUE(VectorEquals(inverse / 12.0, x, 1e-10));
+    }
+
+    // Short inputs are zero padded.
+    Vector short_x = {1.0, 2.0, 3.0};
+    Vector padded(12, 0.0);
+    VectorView(padded, 0, 3) = short_x;
+    ComplexVector padded_transform;
+    plan.transform(short_x, half);
+    plan.transform(padded, padded_transform);
+    for (int k = 0; k < 7; ++k) {
+      EXPECT_DOUBLE_EQ(half[k].real(), padded_transform[k].real());
+      EXPECT_DOUBLE_EQ(half[k].imag(), padded_transform[k].imag());
+    }
+  }
+
 }  // namespace
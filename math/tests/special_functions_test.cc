@@ -0,0 +1,82 @@
+#include "gtest/gtest.h"
+#include "math/special_functions.hpp"
+#include "math/cephes/cephes_impl.hpp"
+#include "LinAlg/VectorView.hpp"
+#include "test_utils/test_utils.hpp"
+#include "distributions.hpp"
+
+namespace {
+  using namespace BOOM;
+  using std::endl;
+
+  class SpecialFunctionsTest : public ::testing::Test {
+   protected:
+    SpecialFunctionsTest() {
+      GlobalRng::rng.seed(8675309);
+    }
+  };
+
+  TEST_F(SpecialFunctionsTest, BatchedPolevlMatchesScalar) {
+    const double coef[6] = {1.5, -2.0, 0.25, 3.0, -1.0, 0.5};
+    Vector x(1000);
+    for (int i = 0; i < x.size(); ++i) {
+      x[i] = runif(-2, 2);
+    }
+    Vector batched(x.size());
+    Vector fixed(x.size());
+    Vector monic(x.size());
+    Cephes::polevl(x.data(), batched.data(), x.size(), coef, 5);
+    Cephes::polevl<5>(x.data(), fixed.data(), x.size(), coef);
+    Cephes::p1evl(x.data(), monic.data(), x.size(), coef, 6);
+    for (int i = 0; i < x.size(); ++i) {
+      double scalar = Cephes::polevl(x[i], coef, 5);
+      EXPECT_NEAR(batched[i], scalar, 1e-12 * (1 + fabs(scalar)));
+      EXPECT_NEAR(fixed[i], scalar, 1e-12 * (1 + fabs(scalar)));
+      double scalar_monic = Cephes::p1evl(x[i], coef, 6);
+      EXPECT_NEAR(monic[i], scalar_monic, 1e-12 * (1 + fabs(scalar_monic)));
+    }
+  }
+
+  TEST_F(SpecialFunctionsTest, BatchedChbevlMatchesScalar) {
+    double coef[8] = {0.3, -1.2, 0.7, 0.05, -0.4, 0.9, 0.01, -0.2};
+    Vector x(300);
+    for (int i = 0; i < x.size(); ++i) {
+      x[i] = runif(-2, 2);
+    }
+    Vector batched(x.size());
+    Cephes::chbevl(x.data(), batched.data(), x.size(), coef, 8);
+    for (int i = 0; i < x.size(); ++i) {
+      EXPECT_NEAR(batched[i], Cephes::chbevl(x[i], coef, 8), 1e-12);
+    }
+  }
+
+  TEST_F(SpecialFunctionsTest, BatchedDilogMatchesScalar) {
+    Vector x(700);
+    for (int i = 0; i < x.size(); ++i) {
+      x[i] = runif(-3, 3);
+    }
+    x[0] = 0.0;
+    x[1] = 1.0;
+    x[2] = 0.5;
+    Vector batched = dilog(x);
+    for (int i = 0; i < x.size(); ++i) {
+      double scalar = dilog(x[i]);
+      EXPECT_NEAR(batched[i], scalar, 1e-12 * (1 + fabs(scalar)))
+          << "x[" << i << "] = " << x[i];
+    }
+
+    Vector y(600);
+    for (int i = 0; i < y.size(); ++i) {
+      y[i] = runif(0, 5);
+    }
+    y[0] = 0.0;
+    y[1] = 1.0;
+    Vector spence_values(y.size());
+    Cephes::spence(y.data(), spence_values.data(), y.size());
+    for (int i = 0; i < y.size(); ++i) {
+      EXPECT_DOUBLE_EQ(spence_values[i], Cephes::spence(y[i]))
+          << "y[" << i << "] = " << y[i];
+    }
+  }
+
+}  // namespace
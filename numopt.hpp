@@ -55,16 +55,27 @@ namespace BOOM{
   //    in the optimization.
   //  * Both: Try conjugate gradient first, and then transition to
   //    BFGS.
+  //  * LBFGS: Limited memory BFGS, which approximates the Hessian
+  //    using the last few gradient differences instead of storing it.
   //
   // Conjugate gradient is more stable far from the mode, but requires
   // more function evaluations.  BFGS can be unstable far from the
-  // mode, but is faster near the mode.
+  // mode, but is faster near the mode.  BFGS stores and updates a
+  // dense p x p matrix, so for high dimensional problems (thousands of
+  // parameters) LBFGS, which needs O(p) storage and time per
+  // iteration, is the better choice.
   enum OptimizationMethod {
     BFGS,
     ConjugateGradient,
-    Both
+    Both,
+    LBFGS
   };
 
+  // Above this dimension the dense matrix kept by BFGS (or a Hessian
+  // formed for Newton's method) is more expensive than it is worth, and
+  // optimizers that don't need the Hessian switch to LBFGS.
+  const int kLimitedMemoryDimension = 1000;
+
   // Optimize a function for which no derivative information is
   // available.
   // Args:
@@ -222,6 +233,36 @@ namespace BOOM{
               bool &fail,
               int trace_freq= -1);
 
+  // Minimize a function using the limited memory BFGS algorithm.  Search
+  // directions come from the two loop recursion over the most recent
+  // 'history_size' steps, and step sizes from a line search satisfying the
+  // strong Wolfe conditions.
+  //
+  // Args:
+  //   x: On input x is the initial set of function arguments of the
+  //      algorithm.  On output it is the minimizing value.
+  //   target:  The function to be minimized, with gradient.
+  //   max_iterations:  The maximum number of iterations allowed.
+  //   absolute_tolerance: The algorithm converges when the largest
+  //     absolute element of the gradient is smaller than this.
+  //   relative_tolerance: The algorithm converges when the relative
+  //     change in the function value is smaller than this.
+  //   function_count: On output this is filled with the number of
+  //     function (and gradient) evaluations that were made.
+  //   fail:  Filled with 'false' on successful exit, and 'true' otherwise.
+  //   history_size: The number of steps used to approximate the Hessian.
+  //
+  // Returns:
+  //   The value of target at the minimizing x.
+  double lbfgs(Vector &x,
+               const dTarget &target,
+               int max_iterations,
+               double absolute_tolerance,
+               double relative_tolerance,
+               int &function_count,
+               bool &fail,
+               int history_size = 10);
+
   // Minimize the function f using the conjugate gradient algorithm.
   // Args:
 
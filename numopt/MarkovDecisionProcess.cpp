@@ -17,31 +17,167 @@
 */
 
 #include "numopt/MarkovDecisionProcess.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "cpputil/ThreadTools.hpp"
+#include "cpputil/math_utils.hpp"
 #include "cpputil/report_error.hpp"
 
 namespace BOOM {
 
+  namespace {
+    // The number of states handled by one task in a parallel backup.
+    const int kStatesPerTask = 256;
+  }  // namespace
+
+  MarkovDecisionProcess::MarkovDecisionProcess(
+      const Array &transition_probabilities, const Array &rewards)
+      : num_states_(0),
+        num_actions_(0),
+        tolerance_(1e-8),
+        pool_(nullptr),
+        number_of_iterations_(0) {
+    if (transition_probabilities.ndim() != 3) {
+      report_error("transition_probabilities must be a 3-way array.");
+    }
+    num_states_ = transition_probabilities.dim(0);
+    num_actions_ = transition_probabilities.dim(1);
+    if (transition_probabilities.dim(2) != num_states_) {
+      report_error("The first and last dimensions of transition_probabilities "
+                   "must be the same size.");
+    }
+    if (rewards.ndim() != 3) {
+      report_error("rewards must be a 3-way array.");
+    }
+    if (rewards.dim(0) != num_states_ || rewards.dim(2) != num_states_) {
+      report_error("The first and last dimension of rewards must equal the "
+                   "number of states.");
+    }
+    if (rewards.dim(1) != num_actions_) {
+      report_error("The middle dimension of rewards must be the number "
+                   "of actions.");
+    }
+
+    std::vector<Transition> transitions;
+    for (int r = 0; r < num_states_; ++r) {
+      for (int a = 0; a < num_actions_; ++a) {
+        ConstVectorView probs(transition_probabilities.vector_slice(r, a, -1));
+        ConstVectorView reward(rewards.vector_slice(r, a, -1));
+        for (int s = 0; s < num_states_; ++s) {
+          if (probs[s] != 0.0) {
+            transitions.push_back({r, a, s, probs[s], reward[s]});
+          }
+        }
+      }
+    }
+    build(transitions);
+  }
+
+  MarkovDecisionProcess::MarkovDecisionProcess(
+      int num_states, int num_actions,
+      const std::vector<Transition> &transitions)
+      : num_states_(num_states),
+        num_actions_(num_actions),
+        tolerance_(1e-8),
+        pool_(nullptr),
+        number_of_iterations_(0) {
+    if (num_states <= 0 || num_actions <= 0) {
+      report_error("An MDP needs at least one state and one action.");
+    }
+    build(transitions);
+  }
+
+  void MarkovDecisionProcess::build(
+      const std::vector<Transition> &transitions) {
+    int number_of_rows = num_states_ * num_actions_;
+    row_start_.assign(number_of_rows + 1, 0);
+    expected_reward_.assign(number_of_rows, 0.0);
+    std::vector<double> total_probability(number_of_rows, 0.0);
+    for (const Transition &t : transitions) {
+      if (t.from < 0 || t.from >= num_states_ || t.to < 0
+          || t.to >= num_states_) {
+        report_error("Transition refers to a state that does not exist.");
+      }
+      if (t.action < 0 || t.action >= num_actions_) {
+        report_error("Transition refers to an action that does not exist.");
+      }
+      if (t.probability < 0 || t.probability > 1.0) {
+        report_error("Transition probabilities must all be between 0 and 1.");
+      }
+      int row = t.from * num_actions_ + t.action;
+      ++row_start_[row + 1];
+      total_probability[row] += t.probability;
+      expected_reward_[row] += t.probability * t.reward;
+    }
+    for (int row = 0; row < number_of_rows; ++row) {
+      if (fabs(total_probability[row] - 1.0) > 1e-8) {
+        report_error("Transition probabilities must sum to 1.");
+      }
+      row_start_[row + 1] += row_start_[row];
+    }
+
+    next_state_.resize(transitions.size());
+    probability_.resize(transitions.size());
+    std::vector<int> position(row_start_.begin(), row_start_.end() - 1);
+    for (const Transition &t : transitions) {
+      int row = t.from * num_actions_ + t.action;
+      int k = position[row]++;
+      next_state_[k] = t.to;
+      probability_[k] = t.probability;
+    }
+  }
+
+  void MarkovDecisionProcess::set_tolerance(double tolerance) {
+    if (tolerance < 0) {
+      report_error("The convergence tolerance must be non-negative.");
+    }
+    tolerance_ = tolerance;
+  }
+
+  double MarkovDecisionProcess::action_value(int state, int action,
+                                             double discount_rate,
+                                             const Vector &value) const {
+    int row = state * num_actions_ + action;
+    double future = 0;
+    for (int k = row_start_[row]; k < row_start_[row + 1]; ++k) {
+      future += probability_[k] * value[next_state_[k]];
+    }
+    return expected_reward_[row] + discount_rate * future;
+  }
+
+  template <class Backup>
+  void MarkovDecisionProcess::for_each_state(Backup backup) const {
+    if (pool_) {
+      pool_->parallel_for(0, num_states_, kStatesPerTask, backup);
+    } else {
+      for (int r = 0; r < num_states_; ++r) backup(r);
+    }
+  }
+
   Vector MarkovDecisionProcess::value_iteration(
       int horizon, double discount_rate) const {
     Vector old_value(num_states(), 0.0);
     Vector value(num_states());
+    number_of_iterations_ = 0;
     for (int i = 0; i < horizon; ++i) {
-      for (int r = 0; r < num_states(); ++r) {
+      for_each_state([&](int r) {
         double conditional_value = negative_infinity();
         for (int a = 0; a < num_actions(); ++a) {
-          double tmp_value = transition_probabilities_.vector_slice(r, a, -1).dot(
-              discount_rate * old_value + rewards_.vector_slice(r, a, -1));
-          conditional_value = std::max<double>(conditional_value, tmp_value);
+          conditional_value = std::max<double>(
+              conditional_value, action_value(r, a, discount_rate, old_value));
         }
-        value(r) = conditional_value;
-      }
-      old_value = value;
-      Vector diff = old_value - value;
-      if (diff.max_abs() < 1e-8) {
-        return value;
+        value[r] = conditional_value;
+      });
+      ++number_of_iterations_;
+      double change = (value - old_value).max_abs();
+      old_value.swap(value);
+      if (change < tolerance_) {
+        break;
       }
     }
-    return value;
+    return old_value;
   }
 
   // The optimal policy is derived using value iteration.
@@ -59,62 +195,19 @@ namespace BOOM {
       int horizon, double discount_rate) const {
     Vector value = value_iteration(horizon, discount_rate);
     std::vector<int> policy(num_states());
-
-    for (int s = 0; s < num_states(); ++s) {
+    for_each_state([&](int s) {
       double best_value = negative_infinity();
       int best_action = -1;
       for (int a = 0; a < num_actions(); ++a) {
-        double tmp_value = transition_probabilities_.vector_slice(s, a, -1).dot(
-            discount_rate * value + rewards_.vector_slice(s, a, -1));
+        double tmp_value = action_value(s, a, discount_rate, value);
         if (tmp_value > best_value) {
           best_action = a;
           best_value = tmp_value;
         }
       }
       policy[s] = best_action;
-    }
+    });
     return policy;
   }
 
-  void MarkovDecisionProcess::validate_transition_probabilities(
-      const Array &transition_probabilities) {
-    if (transition_probabilities.ndim() != 3) {
-      report_error("transition_probabilities must be a 3-way array.");
-    }
-
-    if (transition_probabilities_.dim(2) != num_states()) {
-      report_error("The first and last dimensions of transition_probabilities "
-                   "must be the same size.");
-    }
-
-    for (int a = 0; a < num_actions(); ++a) {
-      for (int r = 0; r < num_states(); ++r) {
-        ConstVectorView probs(transition_probabilities.vector_slice(r, a, -1));
-        double lo = probs.min();
-        double hi = probs.max();
-        double total = probs.sum();
-        if (lo < 0 || hi > 1.0) {
-          report_error("Transition probabilities must all be between 0 and 1.");
-        }
-        if (fabs(total - 1.0) > 1e-8) {
-          report_error("Transition probabilities must sum to 1.");
-        }
-      }
-    }
-  }
-
-  void MarkovDecisionProcess::validate_rewards(const Array &rewards) {
-    if (rewards.ndim() != 3) {
-      report_error("rewards must be a 3-way array.");
-    }
-    if (rewards.dim(0) != num_states() || rewards.dim(2) != num_states()) {
-      report_error("The first and last dimension of rewards must equal the "
-                   "number of states.");
-    }
-    if (rewards.dim(1) != num_actions()) {
-      report_error("The middle dimension of rewards must be the number "
-                   "of actions.");
-    }
-  }
-
 }  // namespace BOOM
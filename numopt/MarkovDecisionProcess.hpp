@@ -19,37 +19,79 @@
   Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
 */
 
+#include <vector>
+
 #include "LinAlg/Vector.hpp"
 #include "LinAlg/Matrix.hpp"
 #include "LinAlg/Array.hpp"
 
 namespace BOOM {
 
+  class ThreadWorkerPool;
+
   // A finite state, stationary Markov decsision process.
+  //
+  // Transitions are stored sparsely, in compressed sparse row form with one
+  // row for each (state, action) pair.  The rows for a given state are
+  // adjacent, so a Bellman backup for one state reads a single contiguous
+  // block of memory.  Rewards enter the backup only through their expected
+  // value given the state and action, so only those are stored.
   class MarkovDecisionProcess {
    public:
+    // A single possible transition, for building sparse MDPs.
+    struct Transition {
+      // The current state.
+      int from;
+      // The action taken in the current state.
+      int action;
+      // The next state.
+      int to;
+      // The probability of moving to 'to', given 'from' and 'action'.
+      double probability;
+      // The expected reward under 'action' when moving from 'from' to 'to'.
+      double reward;
+    };
+
     // transition_probabilities: A 3-way array.  Element (r, a, s) is the
     //   probability of transitioning to state s, given that the current state
     //   is r and the current action is a.
     // rewards: Element (r, a, s) is the expected reward under action a when
     //   transitioning from r to s.
     MarkovDecisionProcess(const Array &transition_probabilities,
-                          const Array &rewards)
-        : transition_probabilities_(transition_probabilities),
-          rewards_(rewards)
-    {
-      validate_transition_probabilities(transition_probabilities);
-      validate_rewards(rewards);
-    }
+                          const Array &rewards);
+
+    // Args:
+    //   num_states:  The number of states in the process.
+    //   num_actions:  The number of actions available in each state.
+    //   transitions: The transitions with nonzero probability.  The
+    //     probabilities for each (from, action) pair must sum to 1.  The
+    //     transitions can be given in any order, and duplicates are added
+    //     together.
+    MarkovDecisionProcess(int num_states, int num_actions,
+                          const std::vector<Transition> &transitions);
 
     int num_states() const {
-      return transition_probabilities_.dim(0);
+      return num_states_;
     }
 
     int num_actions() const {
-      return transition_probabilities_.dim(1);
+      return num_actions_;
     }
 
+    // Distribute the Bellman backups across the given pool.  The pool is not
+    // owned, and must outlive this object.  Passing nullptr (the default)
+    // does the backups in the calling thread.
+    void set_thread_pool(ThreadWorkerPool *pool) { pool_ = pool; }
+
+    // Value iteration stops before the horizon is reached once no element of
+    // the value function changes by more than 'tolerance' in an iteration.
+    // The default is 1e-8.
+    void set_tolerance(double tolerance);
+
+    // The number of iterations run by the most recent call to
+    // value_iteration (or optimal_policy).
+    int number_of_iterations() const { return number_of_iterations_; }
+
     // Args:
     //   discount_rate: A positive number giving the time value of money.  A
     //     discount rate of 1.0 means that one dollar tomorrow has equal value
@@ -75,12 +117,36 @@ namespace BOOM {
     std::vector<int> optimal_policy(int horizon, double discount_rate) const;
 
    private:
-    void validate_transition_probabilities(
-        const Array &transition_probabilities);
-    void validate_rewards(const Array &rewards);
+    // Build the sparse representation from a list of transitions.
+    void build(const std::vector<Transition> &transitions);
+
+    // The expected discounted value of taking 'action' in 'state', given the
+    // value function for the next period.
+    double action_value(int state, int action, double discount_rate,
+                        const Vector &value) const;
+
+    // Call backup(r) for each state r, in parallel if a pool is present.
+    template <class Backup>
+    void for_each_state(Backup backup) const;
+
+    int num_states_;
+    int num_actions_;
+
+    // Row (r * num_actions_ + a) describes the transitions from state r under
+    // action a.  Its next states are next_state_[row_start_[row]] through
+    // next_state_[row_start_[row + 1] - 1], with the corresponding
+    // probabilities.
+    std::vector<int> row_start_;
+    std::vector<int> next_state_;
+    std::vector<double> probability_;
+
+    // Element (r * num_actions_ + a) is the expected reward from taking
+    // action a in state r.
+    std::vector<double> expected_reward_;
 
-    Array transition_probabilities_;
-    Array rewards_;
+    double tolerance_;
+    ThreadWorkerPool *pool_;
+    mutable int number_of_iterations_;
   };
 
 }  // namespace BOOMx
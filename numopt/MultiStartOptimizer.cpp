@@ -0,0 +1,238 @@
+/*
+  Copyright (C) 2005-2024 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include "numopt/MultiStartOptimizer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <future>
+
+#include "cpputil/math_utils.hpp"
+#include "cpputil/report_error.hpp"
+#include "distributions.hpp"
+#include "numopt/NelderMead.hpp"
+#include "numopt/Powell.hpp"
+#include "numopt/SimulatedAnnealingOptimizer.hpp"
+
+namespace BOOM {
+
+  namespace {
+    // Thrown through the local search to stop it once the target value has
+    // been reached by another search.
+    struct SearchCancelled {};
+
+    // Atomically replace 'best' with 'value' if 'value' is smaller.
+    void update_best(std::atomic<double> &best, double value) {
+      double current = best.load(std::memory_order_relaxed);
+      while (value < current &&
+             !best.compare_exchange_weak(current, value,
+                                         std::memory_order_relaxed)) {
+      }
+    }
+  }  // namespace
+
+  MultiStartMinimizer::MultiStartMinimizer(const Target &target, Method method)
+      : target_(target),
+        method_(method),
+        number_of_starts_(10),
+        evaluation_limit_(10000),
+        target_value_(negative_infinity()),
+        jitter_sd_(1.0),
+        best_value_(infinity()),
+        stop_(false) {}
+
+  void MultiStartMinimizer::set_number_of_starts(int number_of_starts) {
+    if (number_of_starts <= 0) {
+      report_error("The number of starts must be positive.");
+    }
+    number_of_starts_ = number_of_starts;
+  }
+
+  void MultiStartMinimizer::set_number_of_threads(int number_of_threads) {
+    pool_.set_number_of_threads(number_of_threads);
+  }
+
+  void MultiStartMinimizer::set_evaluation_limit(int evaluation_limit) {
+    if (evaluation_limit <= 0) {
+      report_error("The evaluation limit must be positive.");
+    }
+    evaluation_limit_ = evaluation_limit;
+  }
+
+  void MultiStartMinimizer::set_target_value(double target_value) {
+    target_value_ = target_value;
+  }
+
+  void MultiStartMinimizer::set_jitter_sd(double jitter_sd) {
+    if (jitter_sd < 0) {
+      report_error("The jitter standard deviation must be non-negative.");
+    }
+    jitter_sd_ = jitter_sd;
+  }
+
+  void MultiStartMinimizer::set_starting_value_generator(
+      const StartingValueGenerator &gen) {
+    starting_value_generator_ = gen;
+  }
+
+  double MultiStartMinimizer::minimize(const Vector &initial_value,
+                                       RNG &seeding_rng) {
+    best_value_.store(infinity());
+    stop_.store(false);
+    RNG::RngIntType seed = seed_rng(seeding_rng);
+
+    std::vector<LocalOptimum> results(number_of_starts_);
+    std::vector<char> ran(number_of_starts_, false);
+    auto run = [&](int start) {
+      if (stop_.load(std::memory_order_relaxed)) return;
+      results[start] = run_search(start, initial_value, seed);
+      ran[start] = true;
+    };
+
+    if (pool_.no_threads()) {
+      for (int i = 0; i < number_of_starts_; ++i) run(i);
+    } else {
+      std::vector<std::future<void>> futures;
+      for (int i = 0; i < number_of_starts_; ++i) {
+        futures.emplace_back(pool_.submit([&run, i]() { run(i); }));
+      }
+      for (auto &future : futures) {
+        future.get();
+      }
+    }
+
+    optima_.clear();
+    for (int i = 0; i < number_of_starts_; ++i) {
+      if (ran[i]) optima_.push_back(std::move(results[i]));
+    }
+    std::stable_sort(optima_.begin(), optima_.end(),
+                     [](const LocalOptimum &a, const LocalOptimum &b) {
+                       return a.value < b.value;
+                     });
+    return minimum();
+  }
+
+  LocalOptimum MultiStartMinimizer::run_search(int start,
+                                               const Vector &initial_value,
+                                               RNG::RngIntType seed) {
+    RNG rng(seed, start);
+    LocalOptimum ans;
+    ans.start = start;
+    ans.cancelled = false;
+    if (starting_value_generator_) {
+      ans.x = starting_value_generator_(start, rng);
+    } else {
+      ans.x = initial_value;
+      if (start > 0 && jitter_sd_ > 0) {
+        for (int i = 0; i < ans.x.size(); ++i) {
+          ans.x[i] += rnorm_mt(rng, 0, jitter_sd_);
+        }
+      }
+    }
+    ans.value = infinity();
+
+    // The best point seen by this search, kept in case it is cancelled.
+    int function_count = 0;
+    Vector best_x = ans.x;
+    double best_value = infinity();
+    Target target = [&](const Vector &x) {
+      if (stop_.load(std::memory_order_relaxed)) {
+        throw SearchCancelled();
+      }
+      double value = target_(x);
+      ++function_count;
+      if (value < best_value) {
+        best_value = value;
+        best_x = x;
+        update_best(best_value_, value);
+        if (value <= target_value_) {
+          stop_.store(true, std::memory_order_relaxed);
+        }
+      }
+      return value;
+    };
+
+    try {
+      switch (method_) {
+        case NELDER_MEAD: {
+          NelderMeadMinimizer minimizer(target);
+          minimizer.set_evaluation_limit(evaluation_limit_);
+          minimizer.minimize(ans.x);
+          break;
+        }
+        case POWELL: {
+          PowellMinimizer minimizer(target);
+          minimizer.set_evaluation_limit(evaluation_limit_);
+          minimizer.minimize(ans.x);
+          break;
+        }
+        case SIMULATED_ANNEALING: {
+          SimulatedAnnealingOptimizer minimizer(target);
+          minimizer.set_max_fun_count(evaluation_limit_);
+          Vector x = ans.x;
+          minimizer.minimize(x, rng);
+          break;
+        }
+        default:
+          report_error("Unknown method in MultiStartMinimizer.");
+      }
+    } catch (SearchCancelled &) {
+      ans.cancelled = true;
+    }
+    // Each method reports its own notion of the optimum, but all of them
+    // evaluate the target there, so the best point seen is the answer.
+    ans.x = best_x;
+    ans.value = best_value;
+    ans.function_count = function_count;
+    return ans;
+  }
+
+  std::vector<LocalOptimum> MultiStartMinimizer::distinct_optima(
+      double tolerance) const {
+    std::vector<LocalOptimum> ans;
+    for (const auto &optimum : optima_) {
+      bool duplicate = false;
+      for (const auto &kept : ans) {
+        if ((optimum.x - kept.x).max_abs() <= tolerance) {
+          duplicate = true;
+          break;
+        }
+      }
+      if (!duplicate) ans.push_back(optimum);
+    }
+    return ans;
+  }
+
+  const Vector &MultiStartMinimizer::minimizing_value() const {
+    if (optima_.empty()) {
+      report_error("minimize() must be called before minimizing_value().");
+    }
+    return optima_[0].x;
+  }
+
+  double MultiStartMinimizer::minimum() const {
+    return optima_.empty() ? infinity() : optima_[0].value;
+  }
+
+  int MultiStartMinimizer::function_count() const {
+    int ans = 0;
+    for (const auto &optimum : optima_) ans += optimum.function_count;
+    return ans;
+  }
+
+}  // namespace BOOM
@@ -0,0 +1,151 @@
+#ifndef BOOM_NUMOPT_MULTI_START_OPTIMIZER_HPP_
+#define BOOM_NUMOPT_MULTI_START_OPTIMIZER_HPP_
+
+/*
+  Copyright (C) 2005-2024 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include <atomic>
+#include <functional>
+#include <vector>
+
+#include "LinAlg/Vector.hpp"
+#include "cpputil/ThreadTools.hpp"
+#include "distributions/rng.hpp"
+#include "numopt.hpp"
+
+namespace BOOM {
+
+  // The outcome of a single local search run by a MultiStartMinimizer.
+  struct LocalOptimum {
+    // The point where the search ended, and the value of the target there.
+    Vector x;
+    double value;
+
+    // The index of the start that produced this optimum.
+    int start;
+
+    // The number of target evaluations made by the search.
+    int function_count;
+
+    // True if the search was stopped early because another search had
+    // already reached the target value.
+    bool cancelled;
+  };
+
+  // Minimizes a (possibly multimodal) function by running independent local
+  // searches from several starting values, in parallel on a thread pool.
+  //
+  // Each start draws from its own RNG stream, determined by the seed passed
+  // to minimize() and the index of the start, so results are reproducible
+  // regardless of the number of threads or the order in which starts run.
+  //
+  // The best value found by any search is shared among all searches.  If a
+  // target value is set (see set_target_value) then once the best value is
+  // at or below the target, starts that have not begun are skipped, and
+  // searches in progress are stopped at their next function evaluation.
+  //
+  // The target function is called concurrently from several threads, so it
+  // must be safe to do so.  In particular it should not modify shared model
+  // state.
+  class MultiStartMinimizer {
+   public:
+    // The local search algorithm run from each start.
+    enum Method { NELDER_MEAD, POWELL, SIMULATED_ANNEALING };
+
+    // Produces a starting value for the start with the given index, using
+    // the given RNG.
+    typedef std::function<Vector(int start, RNG &rng)> StartingValueGenerator;
+
+    explicit MultiStartMinimizer(const Target &target,
+                                 Method method = NELDER_MEAD);
+
+    // Args:
+    //   number_of_starts: The number of local searches to run.
+    void set_number_of_starts(int number_of_starts);
+
+    // Args:
+    //   number_of_threads: The number of worker threads used to run the
+    //     searches.  If <= 0 the searches run sequentially in the calling
+    //     thread.
+    void set_number_of_threads(int number_of_threads);
+
+    // The maximum number of target evaluations allowed in each search.
+    void set_evaluation_limit(int evaluation_limit);
+
+    // Stop all searches once any of them finds a value <= target_value.
+    void set_target_value(double target_value);
+
+    // By default the first start is the initial value passed to minimize(),
+    // and the others add independent N(0, jitter_sd^2) noise to each of its
+    // elements.
+    void set_jitter_sd(double jitter_sd);
+
+    // Replace the default starting values.
+    void set_starting_value_generator(const StartingValueGenerator &gen);
+
+    // Run the searches.
+    // Args:
+    //   initial_value:  The starting point used by the default generator.
+    //     Also determines the dimension of the problem.
+    //   seeding_rng: Supplies the seed for the per-start RNG streams.
+    //
+    // Returns:
+    //   The smallest value found.
+    double minimize(const Vector &initial_value,
+                    RNG &seeding_rng = GlobalRng::rng);
+
+    // The outcome of each search that ran, sorted by value (best first).
+    // Starts that were skipped because the target value was reached are
+    // omitted.
+    const std::vector<LocalOptimum> &optima() const { return optima_; }
+
+    // The ranked optima, with any optimum within 'tolerance' (in each
+    // coordinate) of a better one removed.
+    std::vector<LocalOptimum> distinct_optima(double tolerance) const;
+
+    const Vector &minimizing_value() const;
+    double minimum() const;
+
+    // The total number of target evaluations made by all searches.
+    int function_count() const;
+
+   private:
+    // Run the local search for the given start.
+    LocalOptimum run_search(int start, const Vector &initial_value,
+                            RNG::RngIntType seed);
+
+    Target target_;
+    Method method_;
+    int number_of_starts_;
+    int evaluation_limit_;
+    double target_value_;
+    double jitter_sd_;
+    StartingValueGenerator starting_value_generator_;
+    ThreadWorkerPool pool_;
+
+    // The best value found so far by any search, and whether searches should
+    // stop.  These are shared among worker threads.
+    std::atomic<double> best_value_;
+    std::atomic<bool> stop_;
+
+    std::vector<LocalOptimum> optima_;
+  };
+
+}  // namespace BOOM
+
+#endif  // BOOM_NUMOPT_MULTI_START_OPTIMIZER_HPP_
@@ -21,101 +21,151 @@
 #include <limits>
 #include "LinAlg/SpdMatrix.hpp"
 #include "cpputil/math_utils.hpp"
+#include "cpputil/ThreadTools.hpp"
 #include "cpputil/report_error.hpp"
 
 namespace BOOM {
 
-  NumericalDerivatives::NumericalDerivatives(const Target &f) : f_(f) {}
+  namespace {
+    // The number of doubles in one block of evaluation points.
+    const int kBlockElements = 1 << 16;
+
+    // The step size used to differentiate with respect to x.
+    // The value for h was taken from:
+    // http://journal.info.unlp.edu.ar/journal/journal6/papers/ipaper.pdf
+    double step_size(double x) {
+      static const double tol = cbrt(std::numeric_limits<double>::epsilon());
+      return tol * std::max<double>(0.1, fabs(x));
+    }
+  }  // namespace
 
-  // The value for h was taken from:
-  // http://journal.info.unlp.edu.ar/journal/journal6/papers/ipaper.pdf
-  Vector NumericalDerivatives::gradient(const Vector &x) const {
+  NumericalDerivatives::NumericalDerivatives(const Target &f)
+      : f_(f), pool_(nullptr) {}
+
+  NumericalDerivatives::NumericalDerivatives(const BatchTarget &f)
+      : batch_f_(f), pool_(nullptr) {}
+
+  Vector NumericalDerivatives::evaluate(
+      const Vector &x, int number_of_points,
+      const std::function<void(int, VectorView)> &fill_point) const {
+    Vector ans(number_of_points);
     int dim = x.size();
-    Vector g(dim);
-    const double tol = cbrt(std::numeric_limits<double>::epsilon());
-    for (int i = 0; i < dim; ++i) {
-      double h = tol * std::max<double>(0.1, fabs(x[i]));
-      g[i] = scalar_first_derivative(x, i, h);
+    int block_size = std::max<int>(1, kBlockElements / std::max<int>(1, dim));
+    Matrix points;
+    for (int start = 0; start < number_of_points; start += block_size) {
+      int rows = std::min<int>(block_size, number_of_points - start);
+      if (points.nrow() != rows) points.resize(rows, dim);
+      for (int k = 0; k < rows; ++k) {
+        VectorView row(points.row(k));
+        row = x;
+        fill_point(start + k, row);
+      }
+      if (batch_f_) {
+        Vector values = batch_f_(points);
+        if (values.size() != rows) {
+          report_error("A BatchTarget must return one value per row.");
+        }
+        VectorView(ans, start, rows) = values;
+      } else if (pool_) {
+        pool_->parallel_for(0, rows, 1, [&](int k) {
+          ans[start + k] = f_(Vector(points.row(k)));
+        });
+      } else {
+        Vector point(dim);
+        for (int k = 0; k < rows; ++k) {
+          point = points.row(k);
+          ans[start + k] = f_(point);
+        }
+      }
     }
-    return g;
+    return ans;
   }
 
   // A Richardson approximation to the first derivative.  For
   // derivation, see
   // http://www2.math.umd.edu/~dlevy/classes/amsc466/lecture-notes/differentiation-chap.pdf
-  double NumericalDerivatives::scalar_first_derivative(const Vector &x, int pos,
-                                                       double h) const {
-    Vector dx(x);
-    dx[pos] = x[pos] + h;
-    double fp1 = f_(dx);
-    dx[pos] = x[pos] - h;
-    double fm1 = f_(dx);
-    dx[pos] = x[pos] + 2 * h;
-    double fp2 = f_(dx);
-    dx[pos] = x[pos] - 2 * h;
-    double fm2 = f_(dx);
+  //
+  // Point 4 * i + m perturbs x[i] by offsets[m] * h[i].
+  Vector NumericalDerivatives::gradient(const Vector &x) const {
+    int dim = x.size();
+    Vector h(dim);
+    for (int i = 0; i < dim; ++i) {
+      h[i] = step_size(x[i]);
+    }
+    static const double offsets[4] = {1, -1, 2, -2};
+    Vector values = evaluate(x, 4 * dim, [&](int k, VectorView point) {
+      int i = k / 4;
+      point[i] += offsets[k % 4] * h[i];
+    });
 
-    double df = -fp2 + 8 * fp1 - 8 * fm1 + fm2;
-    return df / (12 * h);
+    Vector g(dim);
+    for (int i = 0; i < dim; ++i) {
+      double fp1 = values[4 * i];
+      double fm1 = values[4 * i + 1];
+      double fp2 = values[4 * i + 2];
+      double fm2 = values[4 * i + 3];
+      double df = -fp2 + 8 * fp1 - 8 * fm1 + fm2;
+      g[i] = df / (12 * h[i]);
+    }
+    return g;
   }
 
+  // The diagonal elements use the homogeneous second difference, and the
+  // off-diagonal elements use the central second derivative found here:
+  // http://terminus.sdsu.edu/SDSU/Math693a_f2005/Lectures/16/lecture-static-04.pdf
+  //
+  // The points are laid out as: x itself, then x[i] + h and x[i] - h for
+  // each i, then 4 points for each pair i < j, with x[i] and x[j] perturbed
+  // by (+, +), (+, -), (-, -), (-, +).
   Matrix NumericalDerivatives::Hessian(const Vector &x,
                                        bool quick_and_dirty) const {
     int dim = x.size();
-    SpdMatrix ans(x.size());
-    const double tol = cbrt(std::numeric_limits<double>::epsilon());
+    Vector h(dim);
     for (int i = 0; i < dim; ++i) {
-      double hi = tol * std::max<double>(0.1, fabs(x[i]));
-      int lo = quick_and_dirty ? i : 0;
-      for (int j = lo; j < dim; ++j) {
-        double hj = tol * std::max<double>(0.1, fabs(x[j]));
-        if (i == j) {
-          ans(i, j) = homogeneous_scalar_second_derivative(x, i, hi);
-        } else {
-          ans(i, j) = scalar_second_derivative(x, i, hi, j, hj);
-        }
+      h[i] = step_size(x[i]);
+    }
+    std::vector<std::pair<int, int>> pairs;
+    pairs.reserve(dim * (dim - 1) / 2);
+    for (int i = 0; i < dim; ++i) {
+      for (int j = i + 1; j < dim; ++j) {
+        pairs.emplace_back(i, j);
       }
     }
-    if (quick_and_dirty) {
-      ans.reflect();
-    } else {
-      ans = .5 * (ans + ans.transpose());
+    int first_pair_point = 1 + 2 * dim;
+    static const double signs[4][2] = {{1, 1}, {1, -1}, {-1, -1}, {-1, 1}};
+    Vector values = evaluate(
+        x, first_pair_point + 4 * pairs.size(), [&](int k, VectorView point) {
+          if (k == 0) return;
+          if (k < first_pair_point) {
+            int i = (k - 1) / 2;
+            point[i] += (k % 2 == 1 ? 1 : -1) * h[i];
+          } else {
+            k -= first_pair_point;
+            const std::pair<int, int> &pair(pairs[k / 4]);
+            point[pair.first] += signs[k % 4][0] * h[pair.first];
+            point[pair.second] += signs[k % 4][1] * h[pair.second];
+          }
+        });
+
+    SpdMatrix ans(dim);
+    double f0 = values[0];
+    for (int i = 0; i < dim; ++i) {
+      double fp = values[1 + 2 * i];
+      double fm = values[2 + 2 * i];
+      ans(i, i) = (fp + fm - 2 * f0) / square(h[i]);
     }
-    return std::move(ans);
-  }
-
-  double NumericalDerivatives::homogeneous_scalar_second_derivative(
-      const Vector &x, int pos, double h) const {
-    Vector dx(x);
-    double f0 = f_(x);
-    dx[pos] = x[pos] + h;
-    double fp = f_(dx);
-    dx[pos] = x[pos] - h;
-    double fm = f_(dx);
-    return (fp + fm - 2 * f0) / square(h);
-  }
-
-  // Using the central second derivative found here:
-  // http://terminus.sdsu.edu/SDSU/Math693a_f2005/Lectures/16/lecture-static-04.pdf
-  double NumericalDerivatives::scalar_second_derivative(const Vector &x, int i,
-                                                        double hi, int j,
-                                                        double hj) const {
-    if (i == j) {
-      report_error("Call homogeneous_scalar_second_derivative instead.");
+    for (int m = 0; m < pairs.size(); ++m) {
+      int i = pairs[m].first;
+      int j = pairs[m].second;
+      const double *f = values.data() + first_pair_point + 4 * m;
+      // f[0], ..., f[3] are f_plus_plus, f_plus_minus, f_minus_minus, and
+      // f_minus_plus.
+      ans(i, j) = (f[0] - f[1] - f[3] + f[2]) / (4 * h[i] * h[j]);
     }
-    Vector dx(x);
-    dx[i] = x[i] + hi;
-    dx[j] = x[j] + hj;
-    // pp, pm, etc indicate whether x[i] and x[j] are plus or minus.
-    double f_plus_plus = f_(dx);
-    dx[j] = x[j] - hj;
-    double f_plus_minus = f_(dx);
-    dx[i] = x[i] - hi;
-    double f_minus_minus = f_(dx);
-    dx[j] = x[j] + hj;
-    double f_minus_plus = f_(dx);
-    return (+f_plus_plus - f_plus_minus - f_minus_plus + f_minus_minus) /
-           (4 * hi * hj);
+    // The upper and lower triangles would be computed from the same
+    // points, so reflecting covers both settings of quick_and_dirty.
+    ans.reflect();
+    return std::move(ans);
   }
 
   ScalarNumericalDerivatives::ScalarNumericalDerivatives(const ScalarTarget &f)
@@ -26,10 +26,32 @@
 
 namespace BOOM {
 
+  class ThreadWorkerPool;
+
+  // Finite difference approximations to the gradient and Hessian of a
+  // function of several variables.
+  //
+  // All the points needed for a gradient or Hessian are generated up front
+  // and evaluated together, in blocks of rows of a Matrix.  This lets a
+  // BatchTarget evaluate many perturbed points in a single call (e.g. with
+  // one matrix multiply), or lets the points of an ordinary Target be
+  // evaluated in parallel on a thread pool.
   class NumericalDerivatives {
    public:
     typedef std::function<double(const Vector &)> Target;
+
+    // A function evaluated at each row of 'points', returning a vector with
+    // one value per row.
+    typedef std::function<Vector(const Matrix &points)> BatchTarget;
+
     explicit NumericalDerivatives(const Target &f);
+    explicit NumericalDerivatives(const BatchTarget &f);
+
+    // Evaluate the points of a Target on the given pool.  The target is
+    // called concurrently, so it must be thread safe.  Passing nullptr
+    // (the default) evaluates the points sequentially.  The pool is not
+    // owned, and must outlive this object.  Has no effect on a BatchTarget.
+    void set_thread_pool(ThreadWorkerPool *pool) { pool_ = pool; }
 
     // Returns the gradient of f at the point x.
     Vector gradient(const Vector &x) const;
@@ -41,26 +63,24 @@ namespace BOOM {
     // lower triangle.  It can be more precise (but is more expensive)
     // to compute both triangles and average them, which is what is
     // done if quick_and_dirty is false.
+    //
+    // The points are evaluated in one pass, and the points needed for the
+    // (i, j) and (j, i) elements are the same, so both settings make the
+    // same number of function evaluations: 1 + 2p + 2p(p-1).
     Matrix Hessian(const Vector &x, bool quick_and_dirty = false) const;
 
    private:
-    // First partial derivative of f with respect to x[pos].
-    // Args:
-    //   x: The location where the derivative is to be taken.
-    //   pos:  Ordinate of x with which to differentiate.
-    //   h:  Step size to use in the approximation.
-    double scalar_first_derivative(const Vector &x, int pos, double h) const;
-
-    // Second partial derivative of f with respect to x[i] and x[j].
-    // Separate step sizes are used.
-    double scalar_second_derivative(const Vector &x, int i, double hi, int j,
-                                    double hj) const;
-
-    // Second partial derivative of f with respect to x[i].
-    double homogeneous_scalar_second_derivative(const Vector &x, int pos,
-                                                double h) const;
+    // Evaluate the target at 'number_of_points' points.  fill_point(k, row)
+    // writes point k into 'row', which on entry holds the central point.
+    // Points are handed to the target in blocks, so a large problem does not
+    // need a matrix holding all its points at once.
+    Vector evaluate(
+        const Vector &x, int number_of_points,
+        const std::function<void(int, VectorView)> &fill_point) const;
 
     Target f_;
+    BatchTarget batch_f_;
+    ThreadWorkerPool *pool_;
   };
 
   // Compute the first and second derivatives of a scalar target function.
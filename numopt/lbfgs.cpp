@@ -0,0 +1,294 @@
+// Copyright 2018 Google LLC. All Rights Reserved.
+/*
+  Copyright (C) 2005-2024 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+
+#include "numopt.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <deque>
+
+#include "LinAlg/Vector.hpp"
+#include "cpputil/math_utils.hpp"
+
+namespace BOOM {
+
+  namespace {
+    // Constants for the strong Wolfe conditions.  kSufficientDecrease is the
+    // Armijo constant, and kCurvature bounds the directional derivative at
+    // the accepted point.  These are the usual values for quasi-Newton
+    // methods (Nocedal and Wright, 2006, section 3.1).
+    const double kSufficientDecrease = 1e-4;
+    const double kCurvature = 0.9;
+
+    // The maximum number of function evaluations in one line search.
+    const int kMaxLineSearchEvaluations = 40;
+
+    // The value, gradient, and directional derivative of the target at one
+    // point along a search direction.
+    struct LinePoint {
+      double step = 0;
+      double value = 0;
+      double slope = 0;
+      Vector x;
+      Vector gradient;
+    };
+
+    // Minimizes a function along a ray, returning a step satisfying the
+    // strong Wolfe conditions.  This is algorithms 3.5 and 3.6 of Nocedal
+    // and Wright (2006), with safeguarded cubic interpolation in the zoom
+    // phase.
+    class WolfeLineSearch {
+     public:
+      WolfeLineSearch(const dTarget &target, const Vector &x, double value,
+                      const Vector &gradient, const Vector &direction,
+                      int &function_count)
+          : target_(target),
+            x_(x),
+            direction_(direction),
+            initial_value_(value),
+            initial_slope_(gradient.dot(direction)),
+            function_count_(function_count) {}
+
+      // Search along the ray starting with the step 'initial_step'.
+      // Returns true if an acceptable point was found, in which case it is
+      // stored in 'ans'.
+      bool search(double initial_step, LinePoint &ans) {
+        LinePoint previous;
+        previous.step = 0;
+        previous.value = initial_value_;
+        previous.slope = initial_slope_;
+        double step = initial_step;
+        for (int i = 0; i < kMaxLineSearchEvaluations; ++i) {
+          LinePoint current = evaluate(step);
+          if (!std::isfinite(current.value)) {
+            // Stepped out of the domain.  Back up toward the last good
+            // point.
+            step = previous.step + 0.5 * (step - previous.step);
+            continue;
+          }
+          if (!sufficient_decrease(current)
+              || (i > 0 && current.value >= previous.value)) {
+            return zoom(previous, current, ans);
+          }
+          if (curvature_condition(current)) {
+            ans = current;
+            return true;
+          }
+          if (current.slope >= 0) {
+            return zoom(current, previous, ans);
+          }
+          previous = current;
+          step *= 2;
+        }
+        return false;
+      }
+
+     private:
+      LinePoint evaluate(double step) {
+        LinePoint ans;
+        ans.step = step;
+        ans.x = x_;
+        ans.x.axpy(direction_, step);
+        ans.gradient.resize(x_.size());
+        ans.value = target_(ans.x, ans.gradient);
+        ans.slope = ans.gradient.dot(direction_);
+        ++function_count_;
+        return ans;
+      }
+
+      bool sufficient_decrease(const LinePoint &point) const {
+        return point.value <= initial_value_
+            + kSufficientDecrease * point.step * initial_slope_;
+      }
+
+      bool curvature_condition(const LinePoint &point) const {
+        return std::fabs(point.slope) <= -kCurvature * initial_slope_;
+      }
+
+      // The minimizer of the cubic interpolating the values and slopes at
+      // lo and hi, kept away from the ends of the interval.  Falls back to
+      // bisection if the cubic has no minimum.
+      double interpolate(const LinePoint &lo, const LinePoint &hi) const {
+        double left = std::min(lo.step, hi.step);
+        double right = std::max(lo.step, hi.step);
+        double margin = 0.1 * (right - left);
+        double d1 = lo.slope + hi.slope
+            - 3 * (lo.value - hi.value) / (lo.step - hi.step);
+        double discriminant = d1 * d1 - lo.slope * hi.slope;
+        double ans = 0.5 * (left + right);
+        if (discriminant >= 0) {
+          double d2 = std::sqrt(discriminant);
+          if (hi.step < lo.step) d2 = -d2;
+          double candidate = hi.step - (hi.step - lo.step)
+              * (hi.slope + d2 - d1) / (hi.slope - lo.slope + 2 * d2);
+          if (std::isfinite(candidate)) ans = candidate;
+        }
+        return std::min(std::max(ans, left + margin), right - margin);
+      }
+
+      // Find an acceptable step between lo and hi.  'lo' satisfies the
+      // sufficient decrease condition and has the smallest value of the
+      // points tried so far.
+      bool zoom(LinePoint lo, LinePoint hi, LinePoint &ans) {
+        for (int i = 0; i < kMaxLineSearchEvaluations; ++i) {
+          if (std::fabs(hi.step - lo.step) <= 1e-14 * std::fabs(lo.step)) {
+            break;
+          }
+          LinePoint current = evaluate(interpolate(lo, hi));
+          if (!std::isfinite(current.value) || !sufficient_decrease(current)
+              || current.value >= lo.value) {
+            hi = current;
+            if (!std::isfinite(hi.value)) {
+              hi.value = infinity();
+              hi.slope = 0;
+            }
+          } else {
+            if (curvature_condition(current)) {
+              ans = current;
+              return true;
+            }
+            if (current.slope * (hi.step - lo.step) >= 0) {
+              hi = lo;
+            }
+            lo = current;
+          }
+        }
+        // The interval has collapsed.  Accept the best point found if it
+        // made progress.
+        if (lo.step > 0 && lo.value < initial_value_) {
+          ans = lo;
+          return true;
+        }
+        return false;
+      }
+
+      const dTarget &target_;
+      const Vector &x_;
+      const Vector &direction_;
+      double initial_value_;
+      double initial_slope_;
+      int &function_count_;
+    };
+
+    // The L-BFGS two loop recursion, computing -H * gradient, where H is the
+    // limited memory approximation to the inverse Hessian defined by the
+    // stored steps s and gradient changes y.
+    Vector search_direction(const Vector &gradient,
+                            const std::deque<Vector> &s,
+                            const std::deque<Vector> &y,
+                            const std::deque<double> &rho) {
+      Vector q = gradient;
+      int m = s.size();
+      std::vector<double> alpha(m);
+      for (int i = m - 1; i >= 0; --i) {
+        alpha[i] = rho[i] * s[i].dot(q);
+        q.axpy(y[i], -alpha[i]);
+      }
+      if (m > 0) {
+        q *= s.back().dot(y.back()) / y.back().dot(y.back());
+      }
+      for (int i = 0; i < m; ++i) {
+        double beta = rho[i] * y[i].dot(q);
+        q.axpy(s[i], alpha[i] - beta);
+      }
+      return q *= -1;
+    }
+  }  // namespace
+
+  double lbfgs(Vector &x, const dTarget &target, int max_iterations,
+               double absolute_tolerance, double relative_tolerance,
+               int &function_count, bool &fail, int history_size) {
+    function_count = 0;
+    fail = false;
+    if (history_size < 1) history_size = 1;
+    Vector gradient(x.size());
+    double value = target(x, gradient);
+    ++function_count;
+    if (!std::isfinite(value)) {
+      fail = true;
+      return value;
+    }
+
+    std::deque<Vector> s, y;
+    std::deque<double> rho;
+    for (int iteration = 0; iteration < max_iterations; ++iteration) {
+      if (gradient.abs_norm() == 0
+          || gradient.max_abs() <= absolute_tolerance) {
+        return value;
+      }
+      Vector direction = search_direction(gradient, s, y, rho);
+      if (direction.dot(gradient) >= 0) {
+        // The approximate inverse Hessian has lost positive definiteness.
+        s.clear();
+        y.clear();
+        rho.clear();
+        direction = gradient * -1;
+      }
+      // Without curvature information the first step is scaled so that it
+      // moves x by a unit distance.
+      double initial_step =
+          s.empty() ? 1.0 / std::sqrt(direction.normsq()) : 1.0;
+
+      LinePoint next;
+      WolfeLineSearch line_search(target, x, value, gradient, direction,
+                                  function_count);
+      if (!line_search.search(initial_step, next)) {
+        if (s.empty()) {
+          // Even steepest descent made no progress.
+          fail = true;
+          return value;
+        }
+        // Retry from steepest descent.
+        s.clear();
+        y.clear();
+        rho.clear();
+        continue;
+      }
+
+      Vector step = next.x - x;
+      Vector gradient_change = next.gradient - gradient;
+      double curvature = step.dot(gradient_change);
+      // The strong Wolfe conditions guarantee positive curvature, up to
+      // rounding error.
+      if (curvature > 1e-12 * step.normsq()) {
+        s.push_back(step);
+        y.push_back(gradient_change);
+        rho.push_back(1.0 / curvature);
+        if (static_cast<int>(s.size()) > history_size) {
+          s.pop_front();
+          y.pop_front();
+          rho.pop_front();
+        }
+      }
+
+      double old_value = value;
+      x = next.x;
+      gradient = next.gradient;
+      value = next.value;
+      if (std::fabs(old_value - value)
+          <= relative_tolerance * (std::fabs(old_value) + relative_tolerance)) {
+        return value;
+      }
+    }
+    fail = true;
+    return value;
+  }
+
+}  // namespace BOOM
@@ -80,13 +80,28 @@ namespace BOOM {
           x = original_x;
         }
         // Polish off with bfgs near the mode.
-        function_value = bfgs(x, negative_f, negative_f, 200, epsilon, epsilon,
-                              fcount, gcount, fail);
+        if (x.size() > kLimitedMemoryDimension) {
+          function_value = lbfgs(x, negative_f, max_iterations, epsilon,
+                                 epsilon, fcount, fail);
+        } else {
+          function_value = bfgs(x, negative_f, negative_f, 200, epsilon,
+                                epsilon, fcount, gcount, fail);
+        }
         if (!std::isfinite(function_value) || !x.all_finite()) {
           x = original_x;
         }
         break;
       }
+
+      case LBFGS: {
+        function_value = lbfgs(x, negative_f, max_iterations, epsilon, epsilon,
+                               fcount, fail);
+        if (!std::isfinite(function_value) || !x.all_finite()) {
+          x = original_x;
+        }
+        break;
+      }
+
       default:
         error_message = "Unknown optimization method.";
         return false;
@@ -98,7 +113,13 @@ namespace BOOM {
                          fcount, 1000);
       fcount = gcount = 0;
       fail = false;
-      if (method == BFGS) {
+      if (method == LBFGS) {
+        function_value = lbfgs(x, negative_f, max_iterations, 1e-8, 1e-8,
+                               fcount, fail);
+        if (!std::isfinite(function_value) || !x.all_finite()) {
+          x = original_x;
+        }
+      } else if (method == BFGS) {
         function_value = bfgs(x, negative_f, negative_f, 200, 1e-8, 1e-8,
                               fcount, gcount, fail);
         if (!std::isfinite(function_value) || !x.all_finite()) {
@@ -165,8 +186,11 @@ namespace BOOM {
         // again.
         x = original_x;
         bool fail = false;
-        double bfgs_answer = bfgs(x, nd2f, nd2f, 200, leps, leps,
-                                  function_count, gradient_count, fail);
+        double bfgs_answer =
+            x.size() > kLimitedMemoryDimension
+                ? lbfgs(x, nd2f, 500, leps, leps, function_count, fail)
+                : bfgs(x, nd2f, nd2f, 200, leps, leps, function_count,
+                       gradient_count, fail);
         // If bfgs succeeded and got the same answer as Newton Raphson
         // (and that answer was finite), then accept that answer.
         happy =
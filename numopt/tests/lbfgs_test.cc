@@ -0,0 +1,104 @@
+#include "gtest/gtest.h"
+#include "numopt.hpp"
+#include "LinAlg/Vector.hpp"
+#include "cpputil/math_utils.hpp"
+#include "distributions.hpp"
+#include "test_utils/test_utils.hpp"
+
+namespace {
+  using namespace BOOM;
+  using std::endl;
+  using std::cout;
+
+  class LbfgsTest : public ::testing::Test {
+   protected:
+    LbfgsTest() {
+      GlobalRng::rng.seed(8675309);
+    }
+  };
+
+  // The Rosenbrock function has a long curved valley with a minimum of 0 at
+  // (1, 1).
+  double rosenbrock(const Vector &x, Vector &gradient) {
+    double a = 1 - x[0];
+    double b = x[1] - square(x[0]);
+    gradient.resize(2);
+    gradient[0] = -2 * a - 400 * x[0] * b;
+    gradient[1] = 200 * b;
+    return square(a) + 100 * square(b);
+  }
+
+  TEST_F(LbfgsTest, Rosenbrock) {
+    Vector x = {-1.2, 1.0};
+    int function_count = 0;
+    bool fail = true;
+    double value = lbfgs(x, rosenbrock, 500, 1e-8, 1e-12, function_count,
+                         fail);
+    EXPECT_FALSE(fail);
+    EXPECT_NEAR(value, 0.0, 1e-8);
+    EXPECT_NEAR(x[0], 1.0, 1e-4);
+    EXPECT_NEAR(x[1], 1.0, 1e-4);
+    EXPECT_LT(function_count, 200);
+  }
+
+  // A badly scaled quadratic in enough dimensions that dense BFGS would be
+  // expensive.
+  TEST_F(LbfgsTest, HighDimensionalQuadratic) {
+    int dim = 5000;
+    Vector scale(dim), center(dim);
+    for (int i = 0; i < dim; ++i) {
+      scale[i] = 1.0 + 99.0 * i / dim;
+      center[i] = rnorm_mt(GlobalRng::rng);
+    }
+    auto target = [&](const Vector &x, Vector &gradient) {
+      gradient.resize(x.size());
+      double ans = 0;
+      for (int i = 0; i < x.size(); ++i) {
+        double deviation = x[i] - center[i];
+        ans += 0.5 * scale[i] * square(deviation);
+        gradient[i] = scale[i] * deviation;
+      }
+      return ans;
+    };
+
+    Vector x(dim, 0.0);
+    int function_count = 0;
+    bool fail = true;
+    double value = lbfgs(x, target, 1000, 1e-6, 1e-14, function_count, fail);
+    EXPECT_FALSE(fail);
+    EXPECT_NEAR(value, 0.0, 1e-8);
+    EXPECT_LT((x - center).max_abs(), 1e-4);
+  }
+
+  // Maximize a function that is -infinity outside a bounded region, which
+  // the line search must back away from.
+  TEST_F(LbfgsTest, MaxNd1Careful) {
+    auto target = [](const Vector &x) {
+      double ans = 0;
+      for (int i = 0; i < x.size(); ++i) {
+        if (x[i] <= 0) return negative_infinity();
+        ans += 3 * log(x[i]) - x[i] * (i + 1);
+      }
+      return ans;
+    };
+    auto gradient = [&target](const Vector &x, Vector &g) {
+      g.resize(x.size());
+      for (int i = 0; i < x.size(); ++i) {
+        g[i] = 3 / x[i] - (i + 1);
+      }
+      return target(x);
+    };
+
+    Vector x(20, 1.0);
+    double value;
+    std::string error_message;
+    bool ok = max_nd1_careful(x, value, target, gradient, error_message,
+                              1e-8, 500, LBFGS);
+    EXPECT_TRUE(ok) << error_message;
+    for (int i = 0; i < x.size(); ++i) {
+      EXPECT_NEAR(x[i], 3.0 / (i + 1), 1e-3);
+    }
+    EXPECT_NEAR(value, target(x), 1e-10);
+  }
+
+}  // namespace
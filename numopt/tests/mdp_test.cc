@@ -1,6 +1,7 @@
 #include "gtest/gtest.h"
 #include "numopt/MarkovDecisionProcess.hpp"
 #include "LinAlg/Matrix.hpp"
+#include "cpputil/ThreadTools.hpp"
 #include "test_utils/test_utils.hpp"
 
 namespace {
@@ -83,4 +84,77 @@ namespace {
     EXPECT_EQ(policy[0], 1);
   }
 
+  // An inventory problem.  The state is the stock on hand, the action is the
+  // number of units ordered, and demand is 0, 1, or 2 units per period.
+  // Each unit sold earns 3, each unit ordered costs 1, and each unit held
+  // costs 0.1.
+  std::vector<MarkovDecisionProcess::Transition> inventory_transitions(
+      int capacity, int max_order) {
+    std::vector<MarkovDecisionProcess::Transition> ans;
+    const double demand_probs[3] = {.3, .5, .2};
+    for (int stock = 0; stock <= capacity; ++stock) {
+      for (int order = 0; order <= max_order; ++order) {
+        int available = std::min(capacity, stock + order);
+        for (int demand = 0; demand < 3; ++demand) {
+          int sold = std::min(demand, available);
+          double reward = 3.0 * sold - order - 0.1 * available;
+          ans.push_back({stock, order, available - sold, demand_probs[demand],
+                         reward});
+        }
+      }
+    }
+    return ans;
+  }
+
+  TEST_F(MarkovDecisionProcessTest, SparseMatchesDense) {
+    int capacity = 6;
+    int max_order = 3;
+    int num_states = capacity + 1;
+    int num_actions = max_order + 1;
+    std::vector<MarkovDecisionProcess::Transition> transitions =
+        inventory_transitions(capacity, max_order);
+
+    Array transition_probabilities({num_states, num_actions, num_states});
+    Array rewards({num_states, num_actions, num_states});
+    for (const auto &t : transitions) {
+      transition_probabilities(t.from, t.action, t.to) += t.probability;
+      rewards(t.from, t.action, t.to) = t.reward;
+    }
+
+    MarkovDecisionProcess dense(transition_probabilities, rewards);
+    MarkovDecisionProcess sparse(num_states, num_actions, transitions);
+    Vector dense_value = dense.value_iteration(5000, .9);
+    Vector sparse_value = sparse.value_iteration(5000, .9);
+    EXPECT_TRUE(VectorEquals(dense_value, sparse_value, 1e-6))
+        << dense_value << "\n" << sparse_value;
+    EXPECT_EQ(dense.optimal_policy(5000, .9), sparse.optimal_policy(5000, .9));
+
+    // Value iteration stopped well before the horizon, at a fixed point of
+    // the Bellman equation.
+    EXPECT_LT(sparse.number_of_iterations(), 5000);
+    EXPECT_GT(sparse.number_of_iterations(), 10);
+    sparse.set_tolerance(0.0);
+    EXPECT_EQ(sparse.value_iteration(3, .9).size(), num_states);
+    EXPECT_EQ(sparse.number_of_iterations(), 3);
+  }
+
+  TEST_F(MarkovDecisionProcessTest, ParallelBackups) {
+    int capacity = 5000;
+    int max_order = 4;
+    MarkovDecisionProcess mdp(capacity + 1, max_order + 1,
+                              inventory_transitions(capacity, max_order));
+    mdp.set_tolerance(1e-6);
+    Vector serial_value = mdp.value_iteration(500, .95);
+    std::vector<int> serial_policy = mdp.optimal_policy(500, .95);
+
+    ThreadWorkerPool pool(4);
+    mdp.set_thread_pool(&pool);
+    Vector parallel_value = mdp.value_iteration(500, .95);
+    EXPECT_TRUE(VectorEquals(serial_value, parallel_value, 1e-12));
+    EXPECT_EQ(serial_policy, mdp.optimal_policy(500, .95));
+
+    // With a large stock it isn't worth ordering more.
+    EXPECT_EQ(serial_policy.back(), 0);
+  }
+
 }  // namespace
@@ -0,0 +1,103 @@
+#include "gtest/gtest.h"
+#include "numopt.hpp"
+#include "numopt/MultiStartOptimizer.hpp"
+#include "LinAlg/Vector.hpp"
+#include "cpputil/Constants.hpp"
+#include "cpputil/math_utils.hpp"
+#include "test_utils/test_utils.hpp"
+
+namespace {
+  using namespace BOOM;
+  using std::endl;
+  using std::cout;
+
+  class MultiStartOptimizerTest : public ::testing::Test {
+   protected:
+    MultiStartOptimizerTest() {
+      GlobalRng::rng.seed(8675309);
+    }
+  };
+
+  // A function with local minima near each integer point, and a global
+  // minimum of 0 at (1, -2).
+  double bumpy(const Vector &x) {
+    double ans = 0;
+    Vector center = {1, -2};
+    for (int i = 0; i < x.size(); ++i) {
+      double z = x[i] - center[i];
+      ans += square(z) + 10 * (1 - cos(2 * Constants::pi * z));
+    }
+    return ans;
+  }
+
+  TEST_F(MultiStartOptimizerTest, FindsGlobalMinimum) {
+    MultiStartMinimizer optimizer(bumpy);
+    optimizer.set_number_of_starts(40);
+    optimizer.set_number_of_threads(4);
+    optimizer.set_jitter_sd(3.0);
+    Vector x = {4.0, 4.0};
+    double value = optimizer.minimize(x);
+    EXPECT_NEAR(value, 0.0, 1e-4);
+    EXPECT_NEAR(optimizer.minimizing_value()[0], 1.0, 1e-2);
+    EXPECT_NEAR(optimizer.minimizing_value()[1], -2.0, 1e-2);
+
+    const std::vector<LocalOptimum> &optima(optimizer.optima());
+    EXPECT_EQ(optima.size(), 40);
+    int total_count = 0;
+    for (int i = 0; i < optima.size(); ++i) {
+      if (i > 0) {
+        EXPECT_LE(optima[i - 1].value, optima[i].value);
+      }
+      EXPECT_FALSE(optima[i].cancelled);
+      total_count += optima[i].function_count;
+    }
+    EXPECT_EQ(total_count, optimizer.function_count());
+
+    // The searches end in several different basins.
+    std::vector<LocalOptimum> distinct = optimizer.distinct_optima(0.25);
+    EXPECT_GT(distinct.size(), 1);
+    EXPECT_LT(distinct.size(), optima.size());
+    EXPECT_DOUBLE_EQ(distinct[0].value, value);
+  }
+
+  // The results for a given seed do not depend on the number of threads.
+  TEST_F(MultiStartOptimizerTest, Reproducible) {
+    for (auto method : {MultiStartMinimizer::NELDER_MEAD,
+                        MultiStartMinimizer::POWELL,
+                        MultiStartMinimizer::SIMULATED_ANNEALING}) {
+      MultiStartMinimizer serial(bumpy, method);
+      serial.set_number_of_starts(8);
+      serial.set_evaluation_limit(2000);
+      MultiStartMinimizer parallel(bumpy, method);
+      parallel.set_number_of_starts(8);
+      parallel.set_evaluation_limit(2000);
+      parallel.set_number_of_threads(3);
+
+      Vector x = {0.3, 0.7};
+      RNG rng1(17), rng2(17);
+      serial.minimize(x, rng1);
+      parallel.minimize(x, rng2);
+      ASSERT_EQ(serial.optima().size(), parallel.optima().size());
+      for (int i = 0; i < serial.optima().size(); ++i) {
+        EXPECT_EQ(serial.optima()[i].start, parallel.optima()[i].start);
+        EXPECT_DOUBLE_EQ(serial.optima()[i].value,
+                         parallel.optima()[i].value);
+        EXPECT_TRUE(VectorEquals(serial.optima()[i].x,
+                                 parallel.optima()[i].x));
+      }
+    }
+  }
+
+  // Once the target value is reached the remaining starts are skipped.
+  TEST_F(MultiStartOptimizerTest, EarlyTermination) {
+    MultiStartMinimizer optimizer(bumpy);
+    optimizer.set_number_of_starts(100);
+    optimizer.set_target_value(1.0);
+    Vector x = {1.2, -1.9};
+    double value = optimizer.minimize(x);
+    EXPECT_LE(value, 1.0);
+    EXPECT_EQ(optimizer.optima().size(), 1);
+    EXPECT_TRUE(optimizer.optima()[0].cancelled);
+  }
+
+}  // namespace
@@ -0,0 +1,131 @@
+#include "gtest/gtest.h"
+#include "numopt/NumericalDerivatives.hpp"
+#include "LinAlg/Matrix.hpp"
+#include "LinAlg/SpdMatrix.hpp"
+#include "LinAlg/Vector.hpp"
+#include "cpputil/ThreadTools.hpp"
+#include "cpputil/math_utils.hpp"
+#include "distributions.hpp"
+#include "test_utils/test_utils.hpp"
+
+namespace {
+  using namespace BOOM;
+  using std::endl;
+  using std::cout;
+
+  class NumericalDerivativesTest : public ::testing::Test {
+   protected:
+    NumericalDerivativesTest() {
+      GlobalRng::rng.seed(8675309);
+    }
+  };
+
+  // f(x) = sum(exp(a .* x)) + 0.5 * x' B x has gradient a .* exp(a .* x) + Bx
+  // and Hessian diag(a^2 .* exp(a .* x)) + B.
+  class TestFunction {
+   public:
+    explicit TestFunction(int dim) : a_(dim), B_(dim) {
+      a_.randomize();
+      B_.randomize();
+    }
+
+    double operator()(const Vector &x) const {
+      double ans = 0.5 * B_.Mdist(x);
+      for (int i = 0; i < x.size(); ++i) ans += exp(a_[i] * x[i]);
+      return ans;
+    }
+
+    Vector gradient(const Vector &x) const {
+      Vector ans = B_ * x;
+      for (int i = 0; i < x.size(); ++i) ans[i] += a_[i] * exp(a_[i] * x[i]);
+      return ans;
+    }
+
+    Matrix Hessian(const Vector &x) const {
+      Matrix ans = B_;
+      for (int i = 0; i < x.size(); ++i) {
+        ans(i, i) += square(a_[i]) * exp(a_[i] * x[i]);
+      }
+      return ans;
+    }
+
+   private:
+    Vector a_;
+    SpdMatrix B_;
+  };
+
+  TEST_F(NumericalDerivativesTest, ScalarTarget) {
+    TestFunction f(5);
+    Vector x(5);
+    x.randomize();
+    NumericalDerivatives derivatives([&f](const Vector &x) { return f(x); });
+    EXPECT_TRUE(VectorEquals(derivatives.gradient(x), f.gradient(x), 1e-6))
+        << derivatives.gradient(x) << "\n" << f.gradient(x);
+    EXPECT_TRUE(MatrixEquals(derivatives.Hessian(x), f.Hessian(x), .05))
+        << derivatives.Hessian(x) << "\n" << f.Hessian(x);
+    EXPECT_TRUE(MatrixEquals(derivatives.Hessian(x, true),
+                             derivatives.Hessian(x, false)));
+  }
+
+  // A batch target sees each point exactly once, and gives the same answer
+  // as evaluating the points one at a time.
+  TEST_F(NumericalDerivativesTest, BatchTarget) {
+    int dim = 7;
+    TestFunction f(dim);
+    Vector x(dim);
+    x.randomize();
+    int calls = 0;
+    int points = 0;
+    NumericalDerivatives::BatchTarget batch = [&](const Matrix &X) {
+      ++calls;
+      points += X.nrow();
+      Vector ans(X.nrow());
+      for (int i = 0; i < X.nrow(); ++i) ans[i] = f(X.row(i));
+      return ans;
+    };
+    NumericalDerivatives batch_derivatives(batch);
+    NumericalDerivatives derivatives([&f](const Vector &x) { return f(x); });
+
+    Vector gradient = batch_derivatives.gradient(x);
+    EXPECT_EQ(calls, 1);
+    EXPECT_EQ(points, 4 * dim);
+    EXPECT_TRUE(VectorEquals(gradient, derivatives.gradient(x), 1e-12));
+
+    calls = points = 0;
+    Matrix hessian = batch_derivatives.Hessian(x);
+    EXPECT_EQ(calls, 1);
+    EXPECT_EQ(points, 1 + 2 * dim + 2 * dim * (dim - 1));
+    EXPECT_TRUE(MatrixEquals(hessian, derivatives.Hessian(x), 1e-12));
+  }
+
+  // Large problems are split into several batches, and points can be
+  // evaluated on a thread pool.
+  TEST_F(NumericalDerivativesTest, ThreadPoolAndBlocks) {
+    int dim = 300;
+    TestFunction f(dim);
+    Vector x(dim);
+    x.randomize();
+    NumericalDerivatives derivatives([&f](const Vector &x) { return f(x); });
+    Vector serial_gradient = derivatives.gradient(x);
+    Vector exact_gradient = f.gradient(x);
+    EXPECT_TRUE(VectorEquals(serial_gradient, exact_gradient,
+                             1e-6 * exact_gradient.max_abs()));
+
+    ThreadWorkerPool pool(4);
+    derivatives.set_thread_pool(&pool);
+    EXPECT_TRUE(VectorEquals(derivatives.gradient(x), serial_gradient, 1e-12));
+
+    int calls = 0;
+    NumericalDerivatives batch_derivatives(
+        NumericalDerivatives::BatchTarget([&](const Matrix &X) {
+          ++calls;
+          Vector ans(X.nrow());
+          for (int i = 0; i < X.nrow(); ++i) ans[i] = f(X.row(i));
+          return ans;
+        }));
+    EXPECT_TRUE(
+        VectorEquals(batch_derivatives.gradient(x), serial_gradient, 1e-12));
+    EXPECT_GT(calls, 1);
+  }
+
+}  // namespace
@@ -0,0 +1,457 @@
+// Copyright 2018 Google LLC. All Rights Reserved.
+/*
+  Copyright (C) 2018 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#include "stats/ArrowImport.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <sstream>
+#include <unordered_map>
+
+#include "Models/CategoricalData.hpp"
+#include "cpputil/DefaultVnames.hpp"
+#include "cpputil/report_error.hpp"
+
+namespace BOOM {
+
+  namespace {
+    // Arrow format strings for the supported primitive types.
+    constexpr char numeric_formats[] = "bcCsSiIlLfg";
+
+    bool is_numeric_format(const char *format) {
+      return format && format[0] != '\0' && format[1] == '\0' &&
+          std::strchr(numeric_formats, format[0]) != nullptr;
+    }
+
+    bool is_integer_format(const char *format) {
+      return is_numeric_format(format) && std::strchr("cCsSiIlL", format[0]);
+    }
+
+    bool is_string_format(const char *format) {
+      return format &&
+          (std::strcmp(format, "u") == 0 || std::strcmp(format, "U") == 0);
+    }
+
+    // Element k of a buffer holding values of type T.
+    template <class T>
+    inline T buffer_value(const void *buffer, int64_t k) {
+      return static_cast<const T *>(buffer)[k];
+    }
+
+    inline bool bit_is_set(const void *bitmap, int64_t k) {
+      return (static_cast<const uint8_t *>(bitmap)[k >> 3] >> (k & 7)) & 1;
+    }
+
+    // Element k of an integer, floating point, or boolean buffer, converted
+    // to double.
+    double primitive_value(char format, const void *buffer, int64_t k) {
+      switch (format) {
+        case 'b': return bit_is_set(buffer, k);
+        case 'c': return buffer_value<int8_t>(buffer, k);
+        case 'C': return buffer_value<uint8_t>(buffer, k);
+        case 's': return buffer_value<int16_t>(buffer, k);
+        case 'S': return buffer_value<uint16_t>(buffer, k);
+        case 'i': return buffer_value<int32_t>(buffer, k);
+        case 'I': return buffer_value<uint32_t>(buffer, k);
+        case 'l': return buffer_value<int64_t>(buffer, k);
+        case 'L': return buffer_value<uint64_t>(buffer, k);
+        case 'f': return buffer_value<float>(buffer, k);
+        case 'g': return buffer_value<double>(buffer, k);
+        default:
+          report_error(std::string("Unsupported Arrow format: ") + format);
+          return 0;
+      }
+    }
+
+    // Element k of a utf8 ("u") or large utf8 ("U") array, where k includes
+    // the array's offset.
+    std::string string_value(const ArrowSchema &schema,
+                             const ArrowArray &array,
+                             int64_t k) {
+      const char *data = static_cast<const char *>(array.buffers[2]);
+      if (schema.format[0] == 'u') {
+        int32_t begin = buffer_value<int32_t>(array.buffers[1], k);
+        int32_t end = buffer_value<int32_t>(array.buffers[1], k + 1);
+        return std::string(data + begin, data + end);
+      } else {
+        int64_t begin = buffer_value<int64_t>(array.buffers[1], k);
+        int64_t end = buffer_value<int64_t>(array.buffers[1], k + 1);
+        return std::string(data + begin, data + end);
+      }
+    }
+
+    // Express 'column' in terms of 'labels', which must contain all of its
+    // levels.
+    std::vector<int32_t> recode(const CategoricalColumn &column,
+                                const std::vector<std::string> &labels) {
+      std::vector<int32_t> new_code;
+      for (const auto &label : column.labels()) {
+        new_code.push_back(std::lower_bound(labels.begin(), labels.end(),
+                                            label) - labels.begin());
+      }
+      std::vector<int32_t> codes;
+      codes.reserve(column.size());
+      for (int32_t code : column.codes()) {
+        codes.push_back(new_code[code]);
+      }
+      return codes;
+    }
+
+    DataTable batches_to_data_table(
+        const std::vector<const ArrowRecordBatch *> &batches) {
+      DataTable table;
+      if (batches.empty()) {
+        return table;
+      }
+      const ArrowRecordBatch &first(*batches[0]);
+      int64_t total_rows = 0;
+      for (const ArrowRecordBatch *batch : batches) {
+        if (batch->column_names() != first.column_names()) {
+          report_error("All record batches must have the same columns.");
+        }
+        total_rows += batch->nrow();
+      }
+
+      for (int j = 0; j < first.ncol(); ++j) {
+        if (first.is_numeric(j)) {
+          Vector values(total_rows);
+          int64_t cursor = 0;
+          for (const ArrowRecordBatch *batch : batches) {
+            if (!batch->is_numeric(j)) {
+              report_error("Column " + first.column_name(j) +
+                           " has different types in different batches.");
+            }
+            batch->fill_numeric(
+                j, 0, batch->nrow(),
+                VectorView(values.data() + cursor, batch->nrow(), 1));
+            cursor += batch->nrow();
+          }
+          table.append_variable(values, first.column_name(j));
+        } else if (first.is_categorical(j)) {
+          CategoricalColumn column = first.categorical_column(j);
+          std::vector<CategoricalColumn> pieces;
+          bool same_levels = true;
+          for (int b = 1; b < batches.size(); ++b) {
+            if (!batches[b]->is_categorical(j)) {
+              report_error("Column " + first.column_name(j) +
+                           " has different types in different batches.");
+            }
+            pieces.push_back(batches[b]->categorical_column(j));
+            same_levels = same_levels
+                && pieces.back().labels() == column.labels();
+          }
+          if (same_levels) {
+            for (const auto &piece : pieces) {
+              column.concat(piece);
+            }
+          } else {
+            std::vector<std::string> labels = column.labels();
+            for (const auto &piece : pieces) {
+              labels.insert(labels.end(), piece.labels().begin(),
+                            piece.labels().end());
+            }
+            std::sort(labels.begin(), labels.end());
+            labels.erase(std::unique(labels.begin(), labels.end()),
+                         labels.end());
+            std::vector<int32_t> codes = recode(column, labels);
+            for (const auto &piece : pieces) {
+              std::vector<int32_t> piece_codes = recode(piece, labels);
+              codes.insert(codes.end(), piece_codes.begin(),
+                           piece_codes.end());
+            }
+            NEW(CatKey, key)(labels);
+            column = CategoricalColumn(codes, key);
+          }
+          table.append_variable(column, first.column_name(j));
+        } else {
+          report_error("Column " + first.column_name(j) +
+                       " has unsupported Arrow type '" + first.format(j) +
+                       "'.");
+        }
+      }
+      return table;
+    }
+  }  // namespace
+
+  //===========================================================================
+  ArrowRecordBatch::ArrowRecordBatch(ArrowSchema *schema, ArrowArray *array) {
+    if (!schema || !array || !schema->release || !array->release) {
+      report_error("ArrowRecordBatch needs an unreleased schema and array.");
+    }
+    schema_ = *schema;
+    array_ = *array;
+    schema->release = nullptr;
+    array->release = nullptr;
+
+    if (std::strcmp(schema_.format, "+s") != 0) {
+      release();
+      report_error("An Arrow record batch must have struct type ('+s').");
+    }
+    if (schema_.n_children != array_.n_children) {
+      release();
+      report_error("The Arrow schema and array have different numbers of "
+                   "columns.");
+    }
+    std::vector<std::string> default_names = default_vnames(ncol());
+    for (int j = 0; j < ncol(); ++j) {
+      const char *name = column_schema(j).name;
+      names_.push_back(name && name[0] != '\0' ? name : default_names[j]);
+      if (column_array(j).length < array_.offset + array_.length) {
+        release();
+        report_error("Column " + names_.back() +
+                     " is shorter than the record batch.");
+      }
+    }
+  }
+
+  ArrowRecordBatch::ArrowRecordBatch(ArrowRecordBatch &&rhs)
+      : schema_(rhs.schema_),
+        array_(rhs.array_),
+        names_(std::move(rhs.names_))
+  {
+    rhs.schema_.release = nullptr;
+    rhs.array_.release = nullptr;
+  }
+
+  ArrowRecordBatch &ArrowRecordBatch::operator=(ArrowRecordBatch &&rhs) {
+    if (&rhs != this) {
+      release();
+      schema_ = rhs.schema_;
+      array_ = rhs.array_;
+      names_ = std::move(rhs.names_);
+      rhs.schema_.release = nullptr;
+      rhs.array_.release = nullptr;
+    }
+    return *this;
+  }
+
+  ArrowRecordBatch::~ArrowRecordBatch() { release(); }
+
+  void ArrowRecordBatch::release() {
+    if (array_.release) {
+      array_.release(&array_);
+      array_.release = nullptr;
+    }
+    if (schema_.release) {
+      schema_.release(&schema_);
+      schema_.release = nullptr;
+    }
+  }
+
+  int ArrowRecordBatch::column_index(const std::string &name) const {
+    auto it = std::find(names_.begin(), names_.end(), name);
+    if (it == names_.end()) {
+      report_error("No column named " + name + " in the record batch.");
+    }
+    return it - names_.begin();
+  }
+
+  bool ArrowRecordBatch::is_numeric(int j) const {
+    check_column(j);
+    return !column_schema(j).dictionary
+        && is_numeric_format(column_schema(j).format);
+  }
+
+  bool ArrowRecordBatch::is_categorical(int j) const {
+    check_column(j);
+    const ArrowSchema &schema(column_schema(j));
+    if (schema.dictionary) {
+      return is_string_format(schema.dictionary->format)
+          && is_integer_format(schema.format);
+    }
+    return is_string_format(schema.format);
+  }
+
+  bool ArrowRecordBatch::has_contiguous_doubles(int j) const {
+    if (!is_numeric(j) || column_schema(j).format[0] != 'g') {
+      return false;
+    }
+    const ArrowArray &array(column_array(j));
+    if (array.null_count != 0 && array.buffers[0] != nullptr) {
+      return false;
+    }
+    const double *data =
+        static_cast<const double *>(array.buffers[1]) + physical_index(j, 0);
+    return reinterpret_cast<std::uintptr_t>(data) % alignof(double) == 0;
+  }
+
+  ConstVectorView ArrowRecordBatch::numeric_view(int j) const {
+    if (!has_contiguous_doubles(j)) {
+      report_error("Column " + column_name(j) + " can't be viewed without "
+                   "copying.  Use numeric_column instead.");
+    }
+    return ConstVectorView(
+        static_cast<const double *>(column_array(j).buffers[1])
+        + physical_index(j, 0),
+        nrow(), 1);
+  }
+
+  Vector ArrowRecordBatch::numeric_column(int j) const {
+    Vector ans(nrow());
+    fill_numeric(j, 0, nrow(), VectorView(ans));
+    return ans;
+  }
+
+  void ArrowRecordBatch::fill_numeric(int j, int begin, int end,
+                                      VectorView output) const {
+    check_numeric(j);
+    if (begin < 0 || end > nrow() || output.size() != end - begin) {
+      report_error("Invalid range passed to ArrowRecordBatch::fill_numeric.");
+    }
+    const ArrowArray &array(column_array(j));
+    char format = column_schema(j).format[0];
+    const void *values = array.buffers[1];
+    bool has_nulls = array.null_count != 0 && array.buffers[0] != nullptr;
+    for (int i = begin; i < end; ++i) {
+      int64_t k = physical_index(j, i);
+      output[i - begin] = (has_nulls && !bit_is_set(array.buffers[0], k))
+          ? std::numeric_limits<double>::quiet_NaN()
+          : primitive_value(format, values, k);
+    }
+  }
+
+  CategoricalColumn ArrowRecordBatch::categorical_column(int j) const {
+    if (!is_categorical(j)) {
+      report_error("Column " + column_name(j) + " is not categorical.");
+    }
+    const ArrowSchema &schema(column_schema(j));
+    const ArrowArray &array(column_array(j));
+    for (int i = 0; i < nrow(); ++i) {
+      if (!is_valid(j, i)) {
+        std::ostringstream err;
+        err << "Element " << i << " of categorical column " << column_name(j)
+            << " is null.  Missing categorical values are not supported.";
+        report_error(err.str());
+      }
+    }
+
+    std::vector<int32_t> codes(nrow());
+    if (schema.dictionary) {
+      const ArrowArray &dictionary(*array.dictionary);
+      std::vector<std::string> labels;
+      for (int64_t d = 0; d < dictionary.length; ++d) {
+        labels.push_back(string_value(*schema.dictionary, dictionary,
+                                      dictionary.offset + d));
+      }
+      for (int i = 0; i < nrow(); ++i) {
+        codes[i] = std::lround(primitive_value(
+            schema.format[0], array.buffers[1], physical_index(j, i)));
+      }
+      NEW(CatKey, key)(labels);
+      return CategoricalColumn(codes, key);
+    }
+
+    // Plain strings are coded in order of appearance, then recoded so the
+    // levels are sorted.
+    std::unordered_map<std::string, int32_t> level_map;
+    std::vector<std::string> labels;
+    for (int i = 0; i < nrow(); ++i) {
+      std::string value = string_value(schema, array, physical_index(j, i));
+      auto it = level_map.find(value);
+      if (it == level_map.end()) {
+        it = level_map.emplace(value, labels.size()).first;
+        labels.push_back(value);
+      }
+      codes[i] = it->second;
+    }
+    NEW(CatKey, unsorted_key)(labels);
+    std::sort(labels.begin(), labels.end());
+    return CategoricalColumn(
+        recode(CategoricalColumn(codes, unsorted_key), labels),
+        new CatKey(labels));
+  }
+
+  bool ArrowRecordBatch::is_valid(int j, int64_t i) const {
+    const ArrowArray &array(column_array(j));
+    if (array.null_count == 0 || array.buffers[0] == nullptr) {
+      return true;
+    }
+    return bit_is_set(array.buffers[0], physical_index(j, i));
+  }
+
+  void ArrowRecordBatch::check_column(int j) const {
+    if (j < 0 || j >= ncol()) {
+      std::ostringstream err;
+      err << "Column index " << j << " is out of range for a record batch "
+          << "with " << ncol() << " columns.";
+      report_error(err.str());
+    }
+  }
+
+  void ArrowRecordBatch::check_numeric(int j) const {
+    if (!is_numeric(j)) {
+      report_error("Column " + column_name(j) + " has Arrow type '" +
+                   format(j) + "', which is not numeric.");
+    }
+  }
+
+  //===========================================================================
+  DataTable arrow_to_data_table(const ArrowRecordBatch &batch) {
+    return batches_to_data_table({&batch});
+  }
+
+  DataTable arrow_to_data_table(const std::vector<ArrowRecordBatch> &batches) {
+    std::vector<const ArrowRecordBatch *> pointers;
+    for (const auto &batch : batches) {
+      pointers.push_back(&batch);
+    }
+    return batches_to_data_table(pointers);
+  }
+
+  Matrix arrow_to_matrix(const ArrowRecordBatch &batch,
+                         const std::vector<std::string> &columns) {
+    Matrix ans(batch.nrow(), columns.size());
+    for (int k = 0; k < columns.size(); ++k) {
+      batch.fill_numeric(batch.column_index(columns[k]), 0, batch.nrow(),
+                         ans.col(k));
+    }
+    return ans;
+  }
+
+  void stream_arrow_batch(
+      const ArrowRecordBatch &batch,
+      const std::string &response,
+      const std::vector<std::string> &predictors,
+      int block_size,
+      const std::function<void(const Matrix &X, const Vector &y)> &callback) {
+    if (block_size < 1) {
+      report_error("block_size must be positive.");
+    }
+    int response_index = batch.column_index(response);
+    std::vector<int> predictor_index;
+    for (const auto &name : predictors) {
+      predictor_index.push_back(batch.column_index(name));
+    }
+    Matrix X;
+    Vector y;
+    for (int begin = 0; begin < batch.nrow(); begin += block_size) {
+      int end = std::min(begin + block_size, batch.nrow());
+      X.resize(end - begin, predictor_index.size());
+      y.resize(end - begin);
+      for (int k = 0; k < predictor_index.size(); ++k) {
+        batch.fill_numeric(predictor_index[k], begin, end, X.col(k));
+      }
+      batch.fill_numeric(response_index, begin, end, VectorView(y));
+      callback(X, y);
+    }
+  }
+
+}  // namespace BOOM
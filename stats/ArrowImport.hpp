@@ -0,0 +1,217 @@
+// Copyright 2018 Google LLC. All Rights Reserved.
+/*
+  Copyright (C) 2018 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#ifndef BOOM_STATS_ARROW_IMPORT_HPP_
+#define BOOM_STATS_ARROW_IMPORT_HPP_
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+#include "LinAlg/Matrix.hpp"
+#include "LinAlg/Vector.hpp"
+#include "LinAlg/VectorView.hpp"
+#include "stats/DataTable.hpp"
+
+// Import of columnar data in the Apache Arrow format, as produced by Parquet
+// readers and most feature pipelines.  Data cross the boundary through the
+// Arrow C data interface, an ABI-stable pair of C structs that any Arrow
+// implementation can export (e.g. pyarrow's RecordBatch._export_to_c, or
+// arrow::ExportRecordBatch in C++).  Using the C interface means BOOM does
+// not need to link against an Arrow library, and files in formats such as
+// Parquet are read by whatever Arrow implementation the caller already has.
+//
+// The struct definitions are copied from the Arrow specification, which
+// asks consumers to define them under this guard so that multiple copies
+// can coexist.
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+extern "C" {
+  struct ArrowSchema {
+    // Array type description
+    const char* format;
+    const char* name;
+    const char* metadata;
+    int64_t flags;
+    int64_t n_children;
+    struct ArrowSchema** children;
+    struct ArrowSchema* dictionary;
+
+    // Release callback
+    void (*release)(struct ArrowSchema*);
+    // Opaque producer-specific data
+    void* private_data;
+  };
+
+  struct ArrowArray {
+    // Array data description
+    int64_t length;
+    int64_t null_count;
+    int64_t offset;
+    int64_t n_buffers;
+    int64_t n_children;
+    const void** buffers;
+    struct ArrowArray** children;
+    struct ArrowArray* dictionary;
+
+    // Release callback
+    void (*release)(struct ArrowArray*);
+    // Opaque producer-specific data
+    void* private_data;
+  };
+}  // extern "C"
+
+#endif  // ARROW_C_DATA_INTERFACE
+
+namespace BOOM {
+
+  //===========================================================================
+  // A record batch (a table with named, typed columns of equal length)
+  // exported through the Arrow C data interface.
+  //
+  // Supported column types are booleans, signed and unsigned integers of
+  // any width, 32 and 64 bit floating point numbers (all "numeric"),
+  // strings, and dictionary encoded strings (both "categorical").  Null
+  // numeric values become NaN.  Null categorical values are an error.
+  //
+  // Numeric accessors that return views point into the Arrow buffers, which
+  // remain valid as long as the ArrowRecordBatch exists.
+  class ArrowRecordBatch {
+   public:
+    // Take ownership of an exported record batch.  The structs are moved
+    // into this object, leaving 'schema' and 'array' marked as released, as
+    // described in the Arrow specification.  The Arrow memory is released
+    // when this object is destroyed.
+    //
+    // Args:
+    //   schema:  The schema of the batch, which must have struct type.
+    //   array:  The data for the batch.
+    ArrowRecordBatch(ArrowSchema *schema, ArrowArray *array);
+
+    ArrowRecordBatch(const ArrowRecordBatch &rhs) = delete;
+    ArrowRecordBatch &operator=(const ArrowRecordBatch &rhs) = delete;
+    ArrowRecordBatch(ArrowRecordBatch &&rhs);
+    ArrowRecordBatch &operator=(ArrowRecordBatch &&rhs);
+    ~ArrowRecordBatch();
+
+    int nrow() const { return array_.length; }
+    int ncol() const { return schema_.n_children; }
+
+    const std::string &column_name(int j) const { return names_[j]; }
+    const std::vector<std::string> &column_names() const { return names_; }
+
+    // The position of the column with the given name.  It is an error if no
+    // such column exists.
+    int column_index(const std::string &name) const;
+
+    // The Arrow format string describing the type of column j, e.g. "g" for
+    // float64 or "u" for utf8 strings.
+    std::string format(int j) const { return schema_.children[j]->format; }
+
+    bool is_numeric(int j) const;
+    bool is_categorical(int j) const;
+
+    // True if column j can be viewed without copying: 64 bit floating point
+    // numbers with no nulls, stored at a properly aligned address.
+    bool has_contiguous_doubles(int j) const;
+
+    // A view of column j that refers to the Arrow buffer.  It is an error to
+    // call this function unless has_contiguous_doubles(j).
+    ConstVectorView numeric_view(int j) const;
+
+    // A copy of numeric column j, converted to double.  Nulls become NaN.
+    Vector numeric_column(int j) const;
+
+    // Copy elements [begin, end) of numeric column j to 'output', which
+    // must have size end - begin.
+    void fill_numeric(int j, int begin, int end, VectorView output) const;
+
+    // The codes and levels of categorical column j.  Dictionary encoded
+    // columns keep the dictionary order of their levels.  Plain string
+    // columns have their levels sorted, as in DataTable::read_file.
+    CategoricalColumn categorical_column(int j) const;
+
+   private:
+    const ArrowSchema &column_schema(int j) const {
+      return *schema_.children[j];
+    }
+    const ArrowArray &column_array(int j) const {
+      return *array_.children[j];
+    }
+
+    // The position of element i of column j in the column's buffers.
+    int64_t physical_index(int j, int64_t i) const {
+      return array_.offset + column_array(j).offset + i;
+    }
+
+    bool is_valid(int j, int64_t i) const;
+    void check_column(int j) const;
+    void check_numeric(int j) const;
+    void release();
+
+    ArrowSchema schema_;
+    ArrowArray array_;
+    std::vector<std::string> names_;
+  };
+
+  //===========================================================================
+  // Conversions from record batches to the data structures used by models.
+
+  // A DataTable with one variable for each numeric or categorical column in
+  // 'batch'.  The data are copied, so the table outlives the batch.  This is
+  // the entry point for models that consume a DataTable, such as
+  // MixedDataImputer.
+  DataTable arrow_to_data_table(const ArrowRecordBatch &batch);
+
+  // A DataTable holding the rows of several batches with the same columns,
+  // such as the row groups of a Parquet file.  If the levels of a
+  // categorical column differ across batches, the table uses the sorted
+  // union of the levels.
+  DataTable arrow_to_data_table(const std::vector<ArrowRecordBatch> &batches);
+
+  // A design matrix (or bsts predictor matrix) with one row per record and
+  // one column per entry in 'columns', each of which must be numeric.
+  Matrix arrow_to_matrix(const ArrowRecordBatch &batch,
+                         const std::vector<std::string> &columns);
+
+  // Pass the rows of 'batch' to 'callback' in blocks of at most
+  // 'block_size', as a design matrix X and a response vector y.  This
+  // matches the streaming interface of BigRegressionModel:
+  //
+  //   stream_arrow_batch(batch, "y", predictor_names, 1000,
+  //       [&model](const Matrix &X, const Vector &y) {
+  //         model.stream_data_for_initial_screen(X, y);
+  //       });
+  //
+  // Only one block is held in memory at a time.
+  void stream_arrow_batch(
+      const ArrowRecordBatch &batch,
+      const std::string &response,
+      const std::vector<std::string> &predictors,
+      int block_size,
+      const std::function<void(const Matrix &X, const Vector &y)> &callback);
+
+}  // namespace BOOM
+
+#endif  // BOOM_STATS_ARROW_IMPORT_HPP_
@@ -0,0 +1,325 @@
+/*
+  Copyright (C) 2005-2024 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include "stats/BinaryMatrixFile.hpp"
+#include <cstring>
+#include <sstream>
+#include <vector>
+#include "cpputil/report_error.hpp"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace BOOM {
+
+  namespace {
+    const char magic[8] = {'B', 'O', 'O', 'M', 'M', 'A', 'T', '1'};
+
+    struct Header {
+      int64_t nrow;
+      int64_t ncol;
+      uint32_t dtype;
+    };
+
+    // Parse the header of a binary matrix file held in 'buffer'.
+    Header parse_header(const char *buffer, size_t size,
+                        const std::string &filename) {
+      std::ostringstream err;
+      if (size < BinaryMatrixFormat::header_size ||
+          std::memcmp(buffer, magic, sizeof(magic)) != 0) {
+        err << filename << " is not a binary matrix file.";
+        report_error(err.str());
+      }
+      uint32_t byte_order, dtype;
+      std::memcpy(&byte_order, buffer + 8, sizeof(byte_order));
+      std::memcpy(&dtype, buffer + 12, sizeof(dtype));
+      if (byte_order != BinaryMatrixFormat::byte_order_mark) {
+        err << filename << " was written on a machine with a different "
+            << "byte order.";
+        report_error(err.str());
+      }
+      if (dtype != BinaryMatrixFormat::dtype_double
+          && dtype != BinaryMatrixFormat::dtype_float) {
+        err << filename << " has data type " << dtype
+            << ".  Only types " << BinaryMatrixFormat::dtype_double
+            << " (double) and " << BinaryMatrixFormat::dtype_float
+            << " (float) are supported.";
+        report_error(err.str());
+      }
+      Header header;
+      header.dtype = dtype;
+      std::memcpy(&header.nrow, buffer + 16, sizeof(header.nrow));
+      std::memcpy(&header.ncol, buffer + 24, sizeof(header.ncol));
+      if (header.nrow < 0 || header.ncol < 0) {
+        err << filename << " has a corrupt header.";
+        report_error(err.str());
+      }
+      size_t element_size = dtype == BinaryMatrixFormat::dtype_float
+          ? sizeof(float) : sizeof(double);
+      size_t expected_size = BinaryMatrixFormat::header_size
+          + element_size * header.nrow * header.ncol;
+      if (size < expected_size) {
+        err << filename << " is truncated.  The header describes a "
+            << header.nrow << " x " << header.ncol << " matrix, which needs "
+            << expected_size << " bytes, but the file has " << size << ".";
+        report_error(err.str());
+      }
+      return header;
+    }
+  }  // namespace
+
+  //===========================================================================
+  BinaryMatrixWriter::BinaryMatrixWriter(const std::string &filename,
+                                         int64_t nrow, bool single_precision)
+      : filename_(filename),
+        out_(filename, std::ios::binary | std::ios::trunc),
+        nrow_(nrow),
+        ncol_(0),
+        single_precision_(single_precision)
+  {
+    if (!out_) {
+      report_error("Could not open " + filename + " for writing.");
+    }
+    if (nrow_ < 0) {
+      report_error("The number of rows must be non-negative.");
+    }
+    write_header();
+  }
+
+  BinaryMatrixWriter::~BinaryMatrixWriter() {
+    if (out_.is_open()) {
+      try {
+        close();
+      } catch (...) {
+      }
+    }
+  }
+
+  void BinaryMatrixWriter::write_header() {
+    char header[BinaryMatrixFormat::header_size];
+    std::memset(header, 0, sizeof(header));
+    std::memcpy(header, magic, sizeof(magic));
+    uint32_t byte_order = BinaryMatrixFormat::byte_order_mark;
+    uint32_t dtype = single_precision_ ? BinaryMatrixFormat::dtype_float
+                                       : BinaryMatrixFormat::dtype_double;
+    std::memcpy(header + 8, &byte_order, sizeof(byte_order));
+    std::memcpy(header + 12, &dtype, sizeof(dtype));
+    std::memcpy(header + 16, &nrow_, sizeof(nrow_));
+    std::memcpy(header + 24, &ncol_, sizeof(ncol_));
+    out_.seekp(0);
+    out_.write(header, sizeof(header));
+  }
+
+  void BinaryMatrixWriter::add_column(const ConstVectorView &column) {
+    if (!out_.is_open()) {
+      report_error("add_column called on a closed BinaryMatrixWriter.");
+    }
+    if (column.size() != nrow_) {
+      std::ostringstream err;
+      err << "Column has " << column.size() << " elements, but "
+          << nrow_ << " were expected.";
+      report_error(err.str());
+    }
+    if (single_precision_) {
+      std::vector<float> buffer(column.begin(), column.end());
+      out_.write(reinterpret_cast<const char *>(buffer.data()),
+                 sizeof(float) * nrow_);
+    } else if (column.stride() == 1) {
+      out_.write(reinterpret_cast<const char *>(column.data()),
+                 sizeof(double) * nrow_);
+    } else {
+      std::vector<double> buffer(column.begin(), column.end());
+      out_.write(reinterpret_cast<const char *>(buffer.data()),
+                 sizeof(double) * nrow_);
+    }
+    if (!out_) {
+      report_error("Error writing to " + filename_ + ".");
+    }
+    ++ncol_;
+  }
+
+  void BinaryMatrixWriter::close() {
+    if (!out_.is_open()) return;
+    write_header();
+    out_.close();
+    if (!out_) {
+      report_error("Error closing " + filename_ + ".");
+    }
+  }
+
+  void write_binary_matrix(const std::string &filename,
+                           const ConstSubMatrix &matrix,
+                           bool single_precision) {
+    BinaryMatrixWriter writer(filename, matrix.nrow(), single_precision);
+    for (int j = 0; j < matrix.ncol(); ++j) {
+      writer.add_column(matrix.col(j));
+    }
+    writer.close();
+  }
+
+  //===========================================================================
+  MappedMatrix::MappedMatrix(const std::string &filename)
+      : mapping_(nullptr),
+        mapping_size_(0),
+        data_(nullptr),
+        float_data_(nullptr),
+        nrow_(0),
+        ncol_(0),
+        single_precision_(false)
+  {
+#ifdef _WIN32
+    report_error("MappedMatrix is not supported on this platform.");
+#else
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+      report_error("Could not open " + filename + ".");
+    }
+    struct stat file_status;
+    if (::fstat(fd, &file_status) != 0) {
+      ::close(fd);
+      report_error("Could not determine the size of " + filename + ".");
+    }
+    size_t size = file_status.st_size;
+    void *mapping = size > 0
+        ? ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0)
+        : MAP_FAILED;
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+      report_error("Could not memory map " + filename + ".");
+    }
+    mapping_ = mapping;
+    mapping_size_ = size;
+    Header header;
+    try {
+      header = parse_header(static_cast<const char *>(mapping_),
+                            mapping_size_, filename);
+    } catch (...) {
+      unmap();
+      throw;
+    }
+    nrow_ = header.nrow;
+    ncol_ = header.ncol;
+    single_precision_ = header.dtype == BinaryMatrixFormat::dtype_float;
+    const char *elements =
+        static_cast<const char *>(mapping_) + BinaryMatrixFormat::header_size;
+    if (single_precision_) {
+      float_data_ = reinterpret_cast<const float *>(elements);
+    } else {
+      data_ = reinterpret_cast<const double *>(elements);
+    }
+#endif
+  }
+
+  MappedMatrix::MappedMatrix(MappedMatrix &&rhs)
+      : mapping_(rhs.mapping_),
+        mapping_size_(rhs.mapping_size_),
+        data_(rhs.data_),
+        float_data_(rhs.float_data_),
+        nrow_(rhs.nrow_),
+        ncol_(rhs.ncol_),
+        single_precision_(rhs.single_precision_)
+  {
+    rhs.mapping_ = nullptr;
+    rhs.mapping_size_ = 0;
+    rhs.data_ = nullptr;
+    rhs.float_data_ = nullptr;
+  }
+
+  MappedMatrix &MappedMatrix::operator=(MappedMatrix &&rhs) {
+    if (&rhs != this) {
+      unmap();
+      std::swap(mapping_, rhs.mapping_);
+      std::swap(mapping_size_, rhs.mapping_size_);
+      std::swap(data_, rhs.data_);
+      std::swap(float_data_, rhs.float_data_);
+      nrow_ = rhs.nrow_;
+      ncol_ = rhs.ncol_;
+      single_precision_ = rhs.single_precision_;
+    }
+    return *this;
+  }
+
+  MappedMatrix::~MappedMatrix() { unmap(); }
+
+  void MappedMatrix::unmap() {
+#ifndef _WIN32
+    if (mapping_) {
+      ::munmap(mapping_, mapping_size_);
+    }
+#endif
+    mapping_ = nullptr;
+    mapping_size_ = 0;
+    data_ = nullptr;
+    float_data_ = nullptr;
+  }
+
+  void MappedMatrix::check_double_precision() const {
+    if (single_precision_) {
+      report_error("This binary matrix file stores floats.  Use float_view() "
+                   "or column() to access it.");
+    }
+  }
+
+  ConstSubMatrix MappedMatrix::view() const {
+    check_double_precision();
+    return ConstSubMatrix(data_, nrow_, ncol_);
+  }
+
+  ConstFloatSubMatrix MappedMatrix::float_view() const {
+    if (!single_precision_) {
+      report_error("This binary matrix file stores doubles.  Use view() to "
+                   "access it.");
+    }
+    return ConstFloatSubMatrix(float_data_, nrow_, ncol_);
+  }
+
+  ConstVectorView MappedMatrix::col(int j) const {
+    check_double_precision();
+    return ConstVectorView(data_ + int64_t(j) * nrow_, nrow_, 1);
+  }
+
+  Vector MappedMatrix::column(int j) const {
+    return single_precision_ ? float_view().col(j) : Vector(col(j));
+  }
+
+  Matrix MappedMatrix::to_matrix() const {
+    return single_precision_ ? float_view().to_matrix() : view().to_matrix();
+  }
+
+  ConstSubMatrix MappedMatrix::rows(int begin, int end) const {
+    if (begin < 0 || end > nrow_ || begin > end) {
+      report_error("Invalid row range in MappedMatrix::rows.");
+    }
+    check_double_precision();
+    return ConstSubMatrix(data_ + begin, end - begin, ncol_, nrow_);
+  }
+
+  ConstSubMatrix MappedMatrix::columns(int begin, int end) const {
+    if (begin < 0 || end > ncol_ || begin > end) {
+      report_error("Invalid column range in MappedMatrix::columns.");
+    }
+    check_double_precision();
+    return ConstSubMatrix(data_ + int64_t(begin) * nrow_, nrow_,
+                          end - begin, nrow_);
+  }
+
+}  // namespace BOOM
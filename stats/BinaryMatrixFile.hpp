@@ -0,0 +1,162 @@
+#ifndef BOOM_STATS_BINARY_MATRIX_FILE_HPP_
+#define BOOM_STATS_BINARY_MATRIX_FILE_HPP_
+/*
+  Copyright (C) 2005-2024 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include "LinAlg/FloatMatrix.hpp"
+#include "LinAlg/Matrix.hpp"
+#include "LinAlg/SubMatrix.hpp"
+#include "LinAlg/VectorView.hpp"
+
+// A simple binary file format for large, dense, numeric matrices, such as
+// the design matrix for a very wide regression.  Reading the file does not
+// involve parsing, and the file can be memory mapped, so a program can
+// stream chunks of a matrix that is much larger than RAM.
+//
+// Layout (all integers little endian on the machines we support; the
+// byte_order field detects a mismatch):
+//   bytes  0 -  7: magic string "BOOMMAT1".
+//   bytes  8 - 11: uint32 byte_order = 0x01020304.
+//   bytes 12 - 15: uint32 dtype.  1 = IEEE double, 2 = IEEE float.
+//   bytes 16 - 23: int64 number of rows.
+//   bytes 24 - 31: int64 number of columns.
+//   bytes 32 - 63: reserved, zero.
+//   bytes 64 - ...: The matrix elements in column major order.
+namespace BOOM {
+
+  namespace BinaryMatrixFormat {
+    constexpr int header_size = 64;
+    constexpr uint32_t byte_order_mark = 0x01020304;
+    constexpr uint32_t dtype_double = 1;
+    constexpr uint32_t dtype_float = 2;
+  }  // namespace BinaryMatrixFormat
+
+  //===========================================================================
+  // Writes a binary matrix file one column at a time, so the full matrix
+  // need not be held in memory.
+  //
+  // Usage:
+  //   BinaryMatrixWriter writer("design.bin", nrow);
+  //   for (...) writer.add_column(next_column);
+  //   writer.close();
+  class BinaryMatrixWriter {
+   public:
+    // Args:
+    //   filename:  The name of the file to be (over)written.
+    //   nrow:  The number of rows in each column.
+    //   single_precision: If true the elements are rounded to float when
+    //     they are written, which halves the size of the file.
+    BinaryMatrixWriter(const std::string &filename, int64_t nrow,
+                       bool single_precision = false);
+    BinaryMatrixWriter(const BinaryMatrixWriter &rhs) = delete;
+    BinaryMatrixWriter &operator=(const BinaryMatrixWriter &rhs) = delete;
+
+    // Closes the file if close() has not already been called.
+    ~BinaryMatrixWriter();
+
+    void add_column(const ConstVectorView &column);
+
+    int64_t nrow() const { return nrow_; }
+    int64_t ncol() const { return ncol_; }
+
+    // Record the number of columns in the header and close the file.  Any
+    // further calls to add_column are an error.
+    void close();
+
+   private:
+    void write_header();
+
+    std::string filename_;
+    std::ofstream out_;
+    int64_t nrow_;
+    int64_t ncol_;
+    bool single_precision_;
+  };
+
+  // Write 'matrix' to a binary matrix file.
+  void write_binary_matrix(const std::string &filename,
+                           const ConstSubMatrix &matrix,
+                           bool single_precision = false);
+
+  //===========================================================================
+  // A read-only, memory mapped view of a binary matrix file.  The operating
+  // system pages the data in as it is touched, so only the parts of the
+  // matrix in use occupy RAM.  Views returned by this object are valid for
+  // the lifetime of the object.
+  class MappedMatrix {
+   public:
+    // Map the named file.  An error is reported if the file does not exist,
+    // is not a binary matrix file, or if memory mapping is not supported on
+    // the current platform.
+    explicit MappedMatrix(const std::string &filename);
+    MappedMatrix(const MappedMatrix &rhs) = delete;
+    MappedMatrix &operator=(const MappedMatrix &rhs) = delete;
+    MappedMatrix(MappedMatrix &&rhs);
+    MappedMatrix &operator=(MappedMatrix &&rhs);
+    ~MappedMatrix();
+
+    int nrow() const { return nrow_; }
+    int ncol() const { return ncol_; }
+
+    // True if the file stores its elements as float.  The double precision
+    // views below (view, rows, columns, col) are only available if this is
+    // false.  The float views are only available if it is true.
+    bool single_precision() const { return single_precision_; }
+
+    // The whole matrix.
+    ConstSubMatrix view() const;
+    ConstFloatSubMatrix float_view() const;
+
+    // Rows [begin, end) of the matrix.  Because the data are stored in
+    // column major order, streaming row blocks touches every column, so
+    // prefer column blocks where the algorithm allows.
+    ConstSubMatrix rows(int begin, int end) const;
+
+    // Columns [begin, end) of the matrix.  These are contiguous in the
+    // file.
+    ConstSubMatrix columns(int begin, int end) const;
+
+    ConstVectorView col(int j) const;
+
+    // A copy of column j, in double precision.  Works for either storage
+    // type.
+    Vector column(int j) const;
+
+    // Copy the whole matrix into memory, in double precision.
+    Matrix to_matrix() const;
+
+   private:
+    void unmap();
+    void check_double_precision() const;
+
+    void *mapping_;
+    size_t mapping_size_;
+    // Exactly one of data_ and float_data_ is non-NULL for a mapped file.
+    const double *data_;
+    const float *float_data_;
+    int nrow_;
+    int ncol_;
+    bool single_precision_;
+  };
+
+}  // namespace BOOM
+
+#endif  // BOOM_STATS_BINARY_MATRIX_FILE_HPP_
@@ -0,0 +1,138 @@
+// Copyright 2018 Google LLC. All Rights Reserved.
+/*
+  Copyright (C) 2005-2024 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+
+#include "stats/Bootstrap.hpp"
+
+#include <sstream>
+
+#include "Bmath/Bmath.hpp"
+#include "Models/Glm/RegressionModel.hpp"
+#include "cpputil/ThreadTools.hpp"
+#include "cpputil/report_error.hpp"
+#include "distributions.hpp"
+
+namespace BOOM {
+
+  BootstrapResampler::BootstrapResampler(int sample_size)
+      : probs_(sample_size > 0 ? sample_size : 0,
+               sample_size > 0 ? 1.0 / sample_size : 0.0),
+        replicate_size_(sample_size),
+        pool_(nullptr) {
+    if (sample_size <= 0) {
+      report_error("BootstrapResampler needs a positive sample size.");
+    }
+  }
+
+  BootstrapResampler::BootstrapResampler(const Vector &probs,
+                                         int replicate_size)
+      : probs_(probs.begin(), probs.end()),
+        replicate_size_(replicate_size < 0 ? probs.size() : replicate_size),
+        pool_(nullptr) {
+    if (probs.empty()) {
+      report_error("Resampling weights cannot be empty.");
+    }
+    double total = 0;
+    for (double p : probs_) {
+      if (p < 0) {
+        report_error("Negative resampling weight found.");
+      }
+      total += p;
+    }
+    if (total <= 0) {
+      report_error("Negative or zero normalizing constant.");
+    }
+    for (double &p : probs_) {
+      p /= total;
+    }
+  }
+
+  Vector BootstrapResampler::counts(RNG::RngIntType seed,
+                                    int replicate) const {
+    RNG rng(seed, replicate);
+    std::vector<int> counts;
+    rmultinom_mt(rng, replicate_size_, probs_, counts);
+    return Vector(counts.begin(), counts.end());
+  }
+
+  Matrix BootstrapResampler::replicate(int number_of_replicates,
+                                       const Statistic &statistic,
+                                       RNG &rng) const {
+    if (number_of_replicates <= 0) {
+      return Matrix(0, 0);
+    }
+    RNG::RngIntType seed = seed_rng(rng);
+    std::vector<Vector> values(number_of_replicates);
+    auto run = [&](int r) { values[r] = statistic(counts(seed, r)); };
+    if (pool_) {
+      pool_->parallel_for(0, number_of_replicates, 1, run);
+    } else {
+      for (int r = 0; r < number_of_replicates; ++r) {
+        run(r);
+      }
+    }
+
+    Matrix ans(number_of_replicates, values[0].size());
+    for (int r = 0; r < number_of_replicates; ++r) {
+      if (values[r].size() != ans.ncol()) {
+        report_error("A bootstrap statistic must return vectors of the same "
+                     "size for each replicate.");
+      }
+      ans.row(r) = values[r];
+    }
+    return ans;
+  }
+
+  Matrix BootstrapResampler::column_means(const Matrix &data,
+                                          int number_of_replicates,
+                                          RNG &rng) const {
+    check_sample_size(data.nrow());
+    return replicate(
+        number_of_replicates,
+        [&data](const Vector &counts) {
+          return (counts * data) / counts.sum();
+        },
+        rng);
+  }
+
+  Matrix BootstrapResampler::regression_coefficients(
+      const Matrix &X, const Vector &y, int number_of_replicates,
+      RNG &rng) const {
+    check_sample_size(X.nrow());
+    check_sample_size(y.size());
+    return replicate(
+        number_of_replicates,
+        [&X, &y](const Vector &counts) {
+          NeRegSuf suf(X.ncol());
+          suf.add_data(X, y, counts);
+          return suf.beta_hat();
+        },
+        rng);
+  }
+
+  void BootstrapResampler::check_sample_size(int nobs) const {
+    if (nobs != sample_size()) {
+      std::ostringstream err;
+      err << "The data has " << nobs << " observations, but the "
+          << "BootstrapResampler was built for " << sample_size() << ".";
+      report_error(err.str());
+    }
+  }
+
+}  // namespace BOOM
@@ -0,0 +1,122 @@
+#ifndef BOOM_STATS_BOOTSTRAP_HPP_
+#define BOOM_STATS_BOOTSTRAP_HPP_
+// Copyright 2018 Google LLC. All Rights Reserved.
+/*
+  Copyright (C) 2005-2024 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#include <functional>
+#include <vector>
+
+#include "LinAlg/Matrix.hpp"
+#include "LinAlg/Vector.hpp"
+#include "distributions/rng.hpp"
+
+namespace BOOM {
+
+  class ThreadWorkerPool;
+
+  // Generates bootstrap replicates of a data set and evaluates statistics on
+  // them.
+  //
+  // A replicate is described by a vector of multinomial counts: counts[i] is
+  // the number of times observation i appears in the resampled data.
+  // Statistics are computed as weighted statistics of the original data,
+  // with the counts as weights, so no resampled copy of the data is ever
+  // built.
+  //
+  // Replicate r is generated from its own RNG stream, RNG(seed, r), where the
+  // seed is drawn once from the RNG passed to replicate().  The draws are
+  // therefore reproducible, and they are the same whether or not a thread
+  // pool is used, regardless of the number of threads.
+  //
+  // Typical usage:
+  //   BootstrapResampler bootstrap(data.nrow());
+  //   ThreadWorkerPool pool(8);
+  //   bootstrap.set_thread_pool(&pool);
+  //   Matrix means = bootstrap.column_means(data, 1000, rng);
+  class BootstrapResampler {
+   public:
+    // A statistic to be computed on each replicate.  The argument is the
+    // vector of counts describing the replicate.  The statistic must return a
+    // vector of the same size for each replicate, and must be safe to call
+    // from several threads at once.
+    typedef std::function<Vector(const Vector &counts)> Statistic;
+
+    // The classical bootstrap: each replicate draws 'sample_size'
+    // observations with equal probability from a sample of that size.
+    explicit BootstrapResampler(int sample_size);
+
+    // A weighted bootstrap, drawing observations with probability
+    // proportional to 'probs'.
+    //
+    // Args:
+    //   probs:  Non-negative sampling weights, one per observation.
+    //   replicate_size: The number of draws in each replicate.  If negative
+    //     then probs.size() is used.
+    explicit BootstrapResampler(const Vector &probs, int replicate_size = -1);
+
+    // Replicates are generated in parallel on the given pool.  The pool is
+    // not owned.  If nullptr (the default) the work is done on the calling
+    // thread.
+    void set_thread_pool(ThreadWorkerPool *pool) { pool_ = pool; }
+
+    // The number of observations in the original data.
+    int sample_size() const { return probs_.size(); }
+
+    // The number of draws making up each replicate.
+    int replicate_size() const { return replicate_size_; }
+
+    // The counts for replicate number 'replicate' generated from 'seed'.
+    Vector counts(RNG::RngIntType seed, int replicate) const;
+
+    // Evaluate a statistic on a collection of bootstrap replicates.
+    //
+    // Args:
+    //   number_of_replicates:  The number of bootstrap replicates to draw.
+    //   statistic:  The statistic to compute on each replicate.
+    //   rng:  Supplies the seed for the replicate streams.
+    //
+    // Returns:
+    //   A matrix with one row per replicate, containing the value of the
+    //   statistic for that replicate.
+    Matrix replicate(int number_of_replicates, const Statistic &statistic,
+                     RNG &rng = GlobalRng::rng) const;
+
+    // Bootstrap distribution of the column means of 'data', which has one
+    // row per observation.  The return value has one row per replicate.
+    Matrix column_means(const Matrix &data, int number_of_replicates,
+                        RNG &rng = GlobalRng::rng) const;
+
+    // Bootstrap distribution of the least squares coefficients from
+    // regressing y on X.  The counts are passed to NeRegSuf as observation
+    // weights.  The return value has one row per replicate.
+    Matrix regression_coefficients(const Matrix &X, const Vector &y,
+                                   int number_of_replicates,
+                                   RNG &rng = GlobalRng::rng) const;
+
+   private:
+    void check_sample_size(int nobs) const;
+
+    std::vector<double> probs_;
+    int replicate_size_;
+    ThreadWorkerPool *pool_;
+  };
+
+}  // namespace BOOM
+
+#endif  // BOOM_STATS_BOOTSTRAP_HPP_
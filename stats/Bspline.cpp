@@ -19,6 +19,8 @@
 #include "stats/Bspline.hpp"
 #include <sstream>
 #include <algorithm>
+#include <cmath>
+#include <vector>
 #include "LinAlg/Matrix.hpp"
 #include "cpputil/math_utils.hpp"
 #include "cpputil/report_error.hpp"
@@ -141,6 +143,41 @@ namespace BOOM {
     return (ans);
   }
 
+  void Bspline::fill_basis_matrix(const ConstVectorView &x,
+                                  SubMatrix &out) const {
+    int number_of_knot_spans = number_of_knots() - 1;
+    if (basis_dimension_ != number_of_knot_spans + degree()) {
+      // Duplicate knots change the layout of the basis, so leave them to the
+      // general algorithm.
+      SplineBase::fill_basis_matrix(x, out);
+      return;
+    }
+    std::vector<int> spans;
+    locate_knot_spans(x, spans);
+    std::vector<double> values, left, right;
+    const double lo = knot(0);
+    const double hi = final_knot();
+    for (int i = 0; i < x.size(); ++i) {
+      double xi = x[i];
+      if (std::isnan(xi)) {
+        out.row(i) = basis(xi);
+        continue;
+      } else if (xi < lo || xi > hi || (xi == hi && degree() == 0)) {
+        // basis() treats the right endpoint as outside the domain of a
+        // piecewise constant spline.
+        continue;
+      }
+      // Otherwise the right endpoint belongs to the final knot span.
+      int span = std::min<int>(spans[i], number_of_knot_spans - 1);
+      nonzero_bspline_values(xi, span, order_, values, left, right);
+      // The nonzero basis functions begin with the one whose support starts
+      // 'degree' knots before 'span', which is basis element 'span'.
+      for (int r = 0; r < order_; ++r) {
+        out(i, span + r) = values[r];
+      }
+    }
+  }
+
   double Bspline::compute_coefficient(double x, int knot_span,
                                       int degree) const {
     if (knot(knot_span) < knot(knot_span + degree)) {
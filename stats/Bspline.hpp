@@ -77,6 +77,11 @@ namespace BOOM {
     double compute_coefficient(double x, int knot_span, int degree) const;
 
    private:
+    // Evaluates the 'order' nonzero basis functions at each point directly
+    // into 'out'.
+    void fill_basis_matrix(const ConstVectorView &x,
+                           SubMatrix &out) const override;
+
     // The order (1 + degree) of the piecewise polynomial connecting the knots.
     int order_;
 
@@ -18,15 +18,20 @@
 */
 
 #include "stats/DataTable.hpp"
+#include "stats/BinaryMatrixFile.hpp"
 #include "stats/moments.hpp"
 
+#include <algorithm>
 #include <cctype>
+#include <charconv>
+#include <cstring>
 #include <fstream>
 // TODO: add this back when c++17 support is widely available.
 // #include <filesystem>
 #include <iomanip>
 #include <sstream>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "Models/CategoricalData.hpp"
@@ -34,8 +39,16 @@
 #include "cpputil/Ptr.hpp"
 #include "cpputil/math_utils.hpp"
 #include "cpputil/report_error.hpp"
+#include "cpputil/ThreadTools.hpp"
 #include "cpputil/string_utils.hpp"
 
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 namespace BOOM {
   using std::endl;
 
@@ -278,6 +291,78 @@ namespace BOOM {
     }
   }
 
+  //===========================================================================
+  CategoricalColumn::CategoricalColumn(const std::vector<std::string> &raw_data)
+      : key_(make_catkey(raw_data)) {
+    std::unordered_map<std::string, int> level_map;
+    const std::vector<std::string> &labels(key_->labels());
+    for (int i = 0; i < labels.size(); ++i) {
+      level_map[labels[i]] = i;
+    }
+    codes_.reserve(raw_data.size());
+    for (const auto &value : raw_data) {
+      codes_.push_back(level_map[value]);
+    }
+  }
+
+  CategoricalColumn::CategoricalColumn(const std::vector<std::int32_t> &codes,
+                                       const Ptr<CatKey> &key)
+      : codes_(codes), key_(key) {
+    int nlevels = key_->max_levels();
+    for (int code : codes_) {
+      if (code < 0 || code >= nlevels) {
+        std::ostringstream err;
+        err << "Code " << code << " is out of range for a key with "
+            << nlevels << " levels.";
+        report_error(err.str());
+      }
+    }
+  }
+
+  CategoricalColumn::CategoricalColumn(const CategoricalVariable &variable)
+      : key_(variable.empty() ? Ptr<CatKey>(new CatKey)
+             : variable[0]->catkey()) {
+    codes_.reserve(variable.size());
+    for (int i = 0; i < variable.size(); ++i) {
+      codes_.push_back(variable[i]->value());
+    }
+  }
+
+  void CategoricalColumn::concat(const CategoricalColumn &rhs) {
+    codes_.insert(codes_.end(), rhs.codes_.begin(), rhs.codes_.end());
+  }
+
+  void CategoricalColumn::set_order(
+      const std::vector<std::string> &level_names) {
+    if (level_names == labels()) {
+      return;
+    }
+    if (level_names.size() != nlevels()) {
+      report_error("The new ordering must contain each level exactly once.");
+    }
+    NEW(CatKey, new_key)(level_names);
+    std::vector<int> new_codes(nlevels());
+    for (int i = 0; i < nlevels(); ++i) {
+      new_codes[i] = new_key->findstr(key_->label(i));
+    }
+    for (auto &code : codes_) {
+      code = new_codes[code];
+    }
+    key_ = new_key;
+  }
+
+  CategoricalVariable CategoricalColumn::to_variable() const {
+    std::vector<Ptr<LabeledCategoricalData>> data;
+    data.reserve(codes_.size());
+    for (int code : codes_) {
+      data.push_back(new LabeledCategoricalData(code, key_));
+    }
+    if (data.empty()) {
+      return CategoricalVariable();
+    }
+    return CategoricalVariable(data);
+  }
+
   const Vector &get(const std::map<uint, Vector> &m, uint i) {
     return m.find(i)->second;
   }
@@ -304,6 +389,294 @@ namespace BOOM {
   }
 
   inline void unknown_type() { report_error("unknown type"); }
+  //-----------------------------------------------------------------
+  // Tools for DataTable::read_file_parallel.
+  namespace {
+    // Chunks smaller than this are not worth handing to a separate thread.
+    constexpr std::size_t min_parse_chunk_bytes = 1 << 16;
+
+    // Each thread gets this many chunks, so that a slow chunk does not hold
+    // up the rest of the file.
+    constexpr int parse_chunks_per_thread = 4;
+
+    inline bool is_white(char c) {
+      return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+    }
+
+    inline bool is_quote(char c) {
+      return c == '"' || c == '\'';
+    }
+
+    // A field in a line of text, referring to memory owned by someone else.
+    struct TextField {
+      const char *begin;
+      const char *end;
+
+      bool empty() const { return begin == end; }
+      std::string str() const { return std::string(begin, end); }
+    };
+
+    // Splits a line of text into fields without copying, following the
+    // conventions of StringSplitter: quoted separators do not start new
+    // fields, and matching quotes around a field are removed.
+    class FieldTokenizer {
+     public:
+      explicit FieldTokenizer(const std::string &sep)
+          : delimiters_(is_all_white(sep) && sep != "\t" ? " \t" : sep),
+            delimited_(!is_all_white(sep) || sep == "\t")
+      {}
+
+      // Split [begin, end) into fields, which are written to 'fields'.
+      void split(const char *begin, const char *end,
+                 std::vector<TextField> &fields) const {
+        fields.clear();
+        if (delimited_) {
+          split_delimited(begin, end, fields);
+        } else {
+          split_space(begin, end, fields);
+        }
+      }
+
+     private:
+      bool is_delimiter(char c) const {
+        return delimiters_.find(c) != std::string::npos;
+      }
+
+      // Returns the first delimiter at or after 'pos' that is not inside a
+      // quoted string, or 'end' if there is none.
+      const char *find_boundary(const char *pos, const char *end) const {
+        char open_quote = 0;
+        for (; pos != end; ++pos) {
+          if (open_quote) {
+            if (*pos == open_quote) open_quote = 0;
+          } else if (is_quote(*pos)) {
+            open_quote = *pos;
+          } else if (is_delimiter(*pos)) {
+            break;
+          }
+        }
+        return pos;
+      }
+
+      static TextField strip_quotes(const char *begin, const char *end) {
+        if (end - begin >= 2 && is_quote(*begin) && end[-1] == *begin) {
+          return {begin + 1, end - 1};
+        }
+        return {begin, end};
+      }
+
+      void split_delimited(const char *pos, const char *end,
+                           std::vector<TextField> &fields) const {
+        while (true) {
+          const char *boundary = find_boundary(pos, end);
+          const char *begin = pos;
+          const char *stop = boundary;
+          while (begin != stop && is_white(*begin)) ++begin;
+          while (stop != begin && is_white(stop[-1])) --stop;
+          fields.push_back(strip_quotes(begin, stop));
+          if (boundary == end) return;
+          // A trailing delimiter ends an empty field.
+          pos = boundary + 1;
+        }
+      }
+
+      void split_space(const char *pos, const char *end,
+                       std::vector<TextField> &fields) const {
+        while (true) {
+          while (pos != end && is_delimiter(*pos)) ++pos;
+          if (pos == end) return;
+          const char *boundary = find_boundary(pos, end);
+          fields.push_back(strip_quotes(pos, boundary));
+          pos = boundary;
+        }
+      }
+
+      std::string delimiters_;
+      bool delimited_;
+    };
+
+    // Returns the end of the line beginning at 'pos', which is either the
+    // position of the next newline character or 'end'.
+    inline const char *find_line_end(const char *pos, const char *end) {
+      const void *newline = std::memchr(pos, '\n', end - pos);
+      return newline ? static_cast<const char *>(newline) : end;
+    }
+
+    // Remove a trailing carriage return from a line.
+    inline const char *strip_carriage_return(const char *begin,
+                                             const char *end) {
+      return (end != begin && end[-1] == '\r') ? end - 1 : end;
+    }
+
+    inline bool is_blank(const char *begin, const char *end) {
+      for (; begin != end; ++begin) {
+        if (!is_white(*begin)) return false;
+      }
+      return true;
+    }
+
+    // Convert a field to a number.  Returns false if the field is not
+    // numeric.
+    bool parse_numeric_field(const TextField &field, double &value) {
+      const char *begin = field.begin;
+      if (begin != field.end && *begin == '+') ++begin;
+      std::from_chars_result result = std::from_chars(begin, field.end, value);
+      if (result.ec == std::errc() && result.ptr == field.end) {
+        return true;
+      }
+      // Anything from_chars could not handle, such as "1e", falls back to
+      // the same rules used by read_file.
+      std::string text = field.str();
+      if (!is_numeric(text)) return false;
+      value = std::strtod(text.c_str(), nullptr);
+      return true;
+    }
+
+    // A read-only memory mapping of a text file.
+    class MappedTextFile {
+     public:
+      explicit MappedTextFile(const std::string &filename)
+          : mapping_(nullptr), size_(0) {
+#ifdef _WIN32
+        report_error("Memory mapped files are not supported on this "
+                     "platform.  Use DataTable::read_file instead.");
+#else
+        int fd = ::open(filename.c_str(), O_RDONLY);
+        if (fd < 0) {
+          report_error("Could not open file: " + filename);
+        }
+        struct stat file_status;
+        if (::fstat(fd, &file_status) != 0) {
+          ::close(fd);
+          report_error("Could not determine the size of " + filename + ".");
+        }
+        size_ = file_status.st_size;
+        if (size_ > 0) {
+          void *mapping = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+          if (mapping == MAP_FAILED) {
+            ::close(fd);
+            report_error("Could not memory map " + filename + ".");
+          }
+          mapping_ = mapping;
+          ::madvise(mapping_, size_, MADV_SEQUENTIAL);
+        }
+        ::close(fd);
+#endif
+      }
+
+      MappedTextFile(const MappedTextFile &rhs) = delete;
+      MappedTextFile &operator=(const MappedTextFile &rhs) = delete;
+
+      ~MappedTextFile() {
+#ifndef _WIN32
+        if (mapping_) ::munmap(mapping_, size_);
+#endif
+      }
+
+      const char *begin() const { return static_cast<const char *>(mapping_); }
+      const char *end() const { return begin() + size_; }
+      std::size_t size() const { return size_; }
+
+     private:
+      void *mapping_;
+      std::size_t size_;
+    };
+
+    // The output of parsing one chunk of a text file.
+    struct ParsedChunk {
+      // One element per numeric variable.
+      std::vector<Vector> numeric_data;
+
+      // One element per categorical variable.  Codes refer to positions in
+      // 'levels', which holds the distinct values in order of appearance.
+      std::vector<std::vector<std::int32_t>> codes;
+      std::vector<std::vector<std::string>> levels;
+
+      // The number of lines in the chunk, including blank lines.
+      int number_of_lines = 0;
+
+      // If an error occurred, the line (counting from 1 within the chunk)
+      // where it happened and a description.  Parsing stops at the first
+      // error.
+      int error_line = 0;
+      std::string error_message;
+    };
+
+    // Parse the lines in [begin, end).
+    //
+    // Args:
+    //   begin, end:  The range of text to parse.  'begin' is the start of a
+    //     line.
+    //   tokenizer:  Splits lines into fields.
+    //   types: The type of each variable, and its position among variables
+    //     of that type.
+    //   variable_names:  Used in error messages.
+    //   number_of_numeric, number_of_categorical: The number of variables of
+    //     each type.
+    //   chunk:  Output.
+    void parse_text_chunk(
+        const char *begin, const char *end,
+        const FieldTokenizer &tokenizer,
+        const std::vector<std::pair<VariableType, int>> &types,
+        const std::vector<std::string> &variable_names,
+        int number_of_numeric,
+        int number_of_categorical,
+        ParsedChunk &chunk) {
+      chunk.numeric_data.resize(number_of_numeric);
+      chunk.codes.resize(number_of_categorical);
+      chunk.levels.resize(number_of_categorical);
+      std::vector<std::unordered_map<std::string, std::int32_t>> level_maps(
+          number_of_categorical);
+      std::vector<TextField> fields;
+      std::string label;
+
+      const char *pos = begin;
+      while (pos < end) {
+        const char *line_end = find_line_end(pos, end);
+        const char *content_end = strip_carriage_return(pos, line_end);
+        ++chunk.number_of_lines;
+        const char *line_begin = pos;
+        pos = line_end + 1;
+        if (is_blank(line_begin, content_end)) continue;
+
+        tokenizer.split(line_begin, content_end, fields);
+        if (fields.size() != types.size()) {
+          std::ostringstream err;
+          err << "has " << fields.size() << " fields.  Previous lines had "
+              << types.size() << " fields.";
+          chunk.error_line = chunk.number_of_lines;
+          chunk.error_message = err.str();
+          return;
+        }
+        for (int i = 0; i < fields.size(); ++i) {
+          int index = types[i].second;
+          if (types[i].first == VariableType::numeric) {
+            double value;
+            if (!parse_numeric_field(fields[i], value)) {
+              std::ostringstream err;
+              err << "expected a numeric value in field number " << i + 1
+                  << " (" << variable_names[i] << ").  Got "
+                  << fields[i].str() << ".";
+              chunk.error_line = chunk.number_of_lines;
+              chunk.error_message = err.str();
+              return;
+            }
+            chunk.numeric_data[index].push_back(value);
+          } else {
+            label.assign(fields[i].begin, fields[i].end);
+            auto it = level_maps[index].find(label);
+            if (it == level_maps[index].end()) {
+              it = level_maps[index].emplace(
+                  label, chunk.levels[index].size()).first;
+              chunk.levels[index].push_back(label);
+            }
+            chunk.codes[index].push_back(it->second);
+          }
+        }
+      }
+    }
+  }  // namespace
+
   //-----------------------------------------------------------------
 
   DataTable::DataTable()
@@ -403,11 +776,188 @@ namespace BOOM {
     }
   }
 
+  void DataTable::read_file_parallel(const std::string &fname,
+                                     bool header,
+                                     const std::string &sep,
+                                     int nthreads,
+                                     int type_sample_size) {
+    if (nvars() > 0) {
+      report_error("read_file_parallel must be called on an empty table.");
+    }
+    MappedTextFile file(fname);
+    FieldTokenizer tokenizer(sep);
+    std::vector<TextField> fields;
+
+    const char *body = file.begin();
+    const char *end = file.end();
+    int header_lines = 0;
+    std::vector<std::string> variable_names;
+    if (header && body != end) {
+      const char *line_end = find_line_end(body, end);
+      tokenizer.split(body, strip_carriage_return(body, line_end), fields);
+      for (const auto &field : fields) {
+        variable_names.push_back(field.str());
+      }
+      header_lines = 1;
+      body = std::min(line_end + 1, end);
+    }
+
+    //---------------------------------------------------------------------
+    // Diagnose the variable types from the first few rows.  Rows with the
+    // wrong number of fields are skipped here, and reported below.
+    uint nfields = variable_names.size();
+    std::vector<bool> numeric;
+    int rows_sampled = 0;
+    for (const char *pos = body;
+         pos < end && rows_sampled < std::max(type_sample_size, 1); ) {
+      const char *line_end = find_line_end(pos, end);
+      const char *content_end = strip_carriage_return(pos, line_end);
+      const char *line_begin = pos;
+      pos = line_end + 1;
+      if (is_blank(line_begin, content_end)) continue;
+      tokenizer.split(line_begin, content_end, fields);
+      if (nfields == 0) {
+        nfields = fields.size();
+      }
+      if (fields.size() != nfields) continue;
+      if (numeric.empty()) {
+        numeric.assign(nfields, true);
+      }
+      for (uint i = 0; i < nfields; ++i) {
+        if (numeric[i] && !is_numeric(fields[i].str())) {
+          numeric[i] = false;
+        }
+      }
+      ++rows_sampled;
+    }
+    if (rows_sampled == 0) {
+      // The file contains no data.
+      return;
+    }
+    if (variable_names.empty()) {
+      variable_names = default_vnames(nfields);
+    }
+    for (uint i = 0; i < nfields; ++i) {
+      type_index_->add_variable(
+          numeric[i] ? VariableType::numeric : VariableType::categorical,
+          variable_names[i]);
+    }
+    std::vector<std::pair<VariableType, int>> types;
+    for (uint i = 0; i < nfields; ++i) {
+      types.push_back(type_index_->type_map(i));
+    }
+    int number_of_numeric = type_index_->number_of_numeric_fields();
+    int number_of_categorical = type_index_->number_of_categorical_fields();
+
+    //---------------------------------------------------------------------
+    // Divide the body of the file into chunks that start on line boundaries,
+    // and parse them in parallel.
+    SharedThreadPool pool(nthreads);
+    std::size_t body_size = end - body;
+    std::size_t max_chunks = pool.no_threads()
+        ? 1 : parse_chunks_per_thread * pool.number_of_threads();
+    int number_of_chunks = std::max<std::size_t>(
+        1, std::min(max_chunks, body_size / min_parse_chunk_bytes));
+    std::vector<const char *> boundaries(1, body);
+    for (int k = 1; k < number_of_chunks; ++k) {
+      const char *pos = std::max(body + k * (body_size / number_of_chunks),
+                                 boundaries.back());
+      boundaries.push_back(std::min(find_line_end(pos, end) + 1, end));
+    }
+    boundaries.push_back(end);
+
+    std::vector<ParsedChunk> chunks(number_of_chunks);
+    pool.parallel_for(0, number_of_chunks, 1, [&](int k) {
+        parse_text_chunk(boundaries[k], boundaries[k + 1], tokenizer, types,
+                         variable_names, number_of_numeric,
+                         number_of_categorical, chunks[k]);
+      });
+
+    int line_number = header_lines;
+    for (const auto &chunk : chunks) {
+      if (!chunk.error_message.empty()) {
+        type_index_ = new DataTypeIndex;
+        std::ostringstream err;
+        err << "file: " << fname << endl
+            << " line number " << line_number + chunk.error_line << " "
+            << chunk.error_message;
+        report_error(err.str());
+      }
+      line_number += chunk.number_of_lines;
+    }
+
+    //---------------------------------------------------------------------
+    // Assemble the columns.  Categorical levels are sorted, as they are in
+    // read_file.
+    numeric_variables_.resize(number_of_numeric);
+    categorical_variables_.resize(number_of_categorical);
+    pool.parallel_for(0, number_of_numeric + number_of_categorical, 1,
+                      [&](int j) {
+      if (j < number_of_numeric) {
+        std::size_t total = 0;
+        for (const auto &chunk : chunks) {
+          total += chunk.numeric_data[j].size();
+        }
+        Vector &column(numeric_variables_[j]);
+        column.reserve(total);
+        for (const auto &chunk : chunks) {
+          column.insert(column.end(), chunk.numeric_data[j].begin(),
+                        chunk.numeric_data[j].end());
+        }
+      } else {
+        int index = j - number_of_numeric;
+        std::vector<std::string> labels;
+        std::size_t total = 0;
+        for (const auto &chunk : chunks) {
+          labels.insert(labels.end(), chunk.levels[index].begin(),
+                        chunk.levels[index].end());
+          total += chunk.codes[index].size();
+        }
+        std::sort(labels.begin(), labels.end());
+        labels.erase(std::unique(labels.begin(), labels.end()), labels.end());
+        std::vector<std::int32_t> codes;
+        codes.reserve(total);
+        for (const auto &chunk : chunks) {
+          std::vector<std::int32_t> recode;
+          for (const auto &level : chunk.levels[index]) {
+            recode.push_back(std::lower_bound(labels.begin(), labels.end(),
+                                              level) - labels.begin());
+          }
+          for (std::int32_t code : chunk.codes[index]) {
+            codes.push_back(recode[code]);
+          }
+        }
+        NEW(CatKey, key)(labels);
+        categorical_variables_[index] = CategoricalColumn(codes, key);
+      }
+    });
+  }
+
   DataTable *DataTable::clone() const { return new DataTable(*this); }
 
   std::ostream &DataTable::display(std::ostream &out) const { return print(out); }
 
   //--- build a DataTable by appending variables ---
+  void DataTable::write_binary(const std::string &filename) const {
+    if (categorical_dim() > 0) {
+      report_error("Only numeric variables can be written to a binary "
+                   "matrix file.");
+    }
+    BinaryMatrixWriter writer(filename, nrow());
+    for (const auto &variable : numeric_variables_) {
+      writer.add_column(ConstVectorView(variable));
+    }
+    writer.close();
+  }
+
+  void DataTable::read_binary(const std::string &filename) {
+    MappedMatrix data(filename);
+    std::vector<std::string> names = default_vnames(data.ncol(), nvars());
+    for (int j = 0; j < data.ncol(); ++j) {
+      append_variable(data.column(j), names[j]);
+    }
+  }
+
   void DataTable::append_variable(const Vector &v, const std::string &name) {
     // If there are no variables, ie the table is empty, append to the numeric
     // variables.  IMPORTANT: The first set of observations determines the size
@@ -431,6 +981,11 @@ namespace BOOM {
 
   void DataTable::append_variable(const CategoricalVariable &cv,
                                   const std::string &name) {
+    append_variable(CategoricalColumn(cv), name);
+  }
+
+  void DataTable::append_variable(const CategoricalColumn &cv,
+                                  const std::string &name) {
     // If there are no variables, ie the table is empty, append to the numeric
     // variables.  IMPORTANT: The first set of observations determines the size
     // of the data columns from then on! (since nobs() method refers to the
@@ -479,7 +1034,7 @@ namespace BOOM {
           case VariableType::categorical:
             {
               categorical_variables_[categorical_counter].push_back(
-                  row.categorical_data()[categorical_counter]);
+                  row.categorical_data()[categorical_counter]->value());
               ++categorical_counter;
             }
             break;
@@ -504,10 +1059,10 @@ namespace BOOM {
 
           case VariableType::categorical:
             {
-              categorical_variables_.push_back(
-                  CategoricalVariable(
-                      std::vector<Ptr<LabeledCategoricalData>>(
-                          1, row.mutable_categorical(i))));
+              Ptr<LabeledCategoricalData> value = row.mutable_categorical(i);
+              categorical_variables_.push_back(CategoricalColumn(
+                  std::vector<std::int32_t>(1, value->value()),
+                  value->catkey()));
             }
             break;
 
@@ -558,9 +1113,9 @@ namespace BOOM {
         if (type == VariableType::numeric) {
           X(i, column++) = numeric_variables_[index][i];
         } else if (type == VariableType::categorical) {
-          const Ptr<LabeledCategoricalData> x(categorical_variables_[index][i]);
-          for (uint k = 1; k < x->nlevels(); ++k)
-            X(i, column++) = (k == x->value() ? 1 : 0);
+          const CategoricalColumn &x(categorical_variables_[index]);
+          for (uint k = 1; k < x.nlevels(); ++k)
+            X(i, column++) = (k == x[i] ? 1 : 0);
         } else {
           unknown_type();
         }
@@ -579,7 +1134,6 @@ namespace BOOM {
       if (type == VariableType::numeric) {
         dimnames.push_back(vnames()[J]);
       } else if (type == VariableType::categorical) {
-        const Ptr<LabeledCategoricalData> x(categorical_variables_[index][0]);
         std::string stub = vnames()[J];
         std::vector<std::string> labs = categorical_variables_[index].labels();
         for (uint i = 1; i < labs.size(); ++i) {
@@ -617,11 +1171,7 @@ namespace BOOM {
             << rhs.categorical_variables_[i].labels() << endl;
         report_error(err.str());
       }
-      Ptr<CatKey> key = categorical_variables_[i].key();
-      for (int j = 0; j < rhs.categorical_variables_[i].size(); ++j) {
-        uint value = rhs.categorical_variables_[i][j]->value();
-        categorical_variables_[i].push_back(new LabeledCategoricalData(value, key));
-      }
+      categorical_variables_[i].concat(rhs.categorical_variables_[i]);
     }
     return *this;
   }
@@ -632,7 +1182,7 @@ namespace BOOM {
     int index;
     std::tie(type, index) = type_index_->type_map(i);
     if (type == VariableType::numeric) return 1;
-    return categorical_variables_[index][0]->nlevels();
+    return categorical_variables_[index].nlevels();
   }
 
   int DataTable::numeric_dim() const {
@@ -663,7 +1213,7 @@ namespace BOOM {
     } else {
       Vector ans(nobs());
       for (uint i = 0; i < nobs(); ++i) {
-        ans[i] = categorical_variables_[index][i]->value();
+        ans[i] = categorical_variables_[index][i];
       }
       return ans;
     }
@@ -680,7 +1230,7 @@ namespace BOOM {
     }
   }
 
-  CategoricalVariable DataTable::get_nominal(uint n) const {
+  const CategoricalColumn &DataTable::categorical_column(uint n) const {
     VariableType type;
     int index;
     std::tie(type, index) = type_index_->type_map(n);
@@ -688,12 +1238,17 @@ namespace BOOM {
     return categorical_variables_[index];
   }
 
+  CategoricalVariable DataTable::get_nominal(uint n) const {
+    return categorical_column(n).to_variable();
+  }
+
   Ptr<LabeledCategoricalData> DataTable::get_nominal(int row, int col) const {
     VariableType type;
     int index;
     std::tie(type, index) = type_index_->type_map(col);
     if (type != VariableType::categorical) wrong_type_error(1, col);
-    return categorical_variables_[index][row];
+    const CategoricalColumn &column(categorical_variables_[index]);
+    return new LabeledCategoricalData(column[row], column.key());
   }
 
   void DataTable::set_numeric_value(int row, int column, double value) {
@@ -714,7 +1269,7 @@ namespace BOOM {
       report_error(
           "Attempt to set categorical value to non-categorical variable.");
     }
-    categorical_variables_[index][row]->set(value);
+    categorical_variables_[index].set(row, value);
   }
 
   // DataTable::OrdinalVariable DataTable::get_ordinal(uint n)const{
@@ -742,7 +1297,9 @@ namespace BOOM {
     }
     std::vector<Ptr<LabeledCategoricalData>> categoricals;
     for (int i = 0; i < categorical_variables_.size(); ++i) {
-      categoricals.push_back(categorical_variables_[i][row_index]);
+      const CategoricalColumn &column(categorical_variables_[i]);
+      categoricals.push_back(
+          new LabeledCategoricalData(column[row_index], column.key()));
     }
     return new MixedMultivariateData(type_index_, numerics, categoricals);
   }
@@ -20,6 +20,7 @@
 #ifndef BOOM_DATA_TABLE_HPP
 #define BOOM_DATA_TABLE_HPP
 
+#include <cstdint>
 #include <limits>
 #include "uint.hpp"
 
@@ -222,6 +223,60 @@ namespace BOOM {
     std::vector<Ptr<LabeledCategoricalData>> data_;
   };
 
+  //===========================================================================
+  // A CategoricalColumn is the compact form of a CategoricalVariable: an array
+  // of integer codes sharing a single CatKey that maps codes to labels.  No
+  // per-observation objects are created, so this is how DataTable stores its
+  // categorical variables.
+  class CategoricalColumn {
+   public:
+    CategoricalColumn() : key_(new CatKey) {}
+
+    // Build a column from string data.  The levels are the sorted unique
+    // values in raw_data.
+    explicit CategoricalColumn(const std::vector<std::string> &raw_data);
+
+    // Args:
+    //   codes: The levels of each observation.  Each must be in the range [0,
+    //     key->max_levels()).
+    //   key:  Maps the codes to labels.
+    CategoricalColumn(const std::vector<std::int32_t> &codes,
+                      const Ptr<CatKey> &key);
+
+    // Compress a CategoricalVariable.  The column shares the variable's key.
+    explicit CategoricalColumn(const CategoricalVariable &variable);
+
+    int size() const { return codes_.size(); }
+    bool empty() const { return codes_.empty(); }
+
+    // The level of observation i.
+    int operator[](int i) const { return codes_[i]; }
+    void set(int i, int code) { codes_[i] = code; }
+    void push_back(int code) { codes_.push_back(code); }
+
+    const std::vector<std::int32_t> &codes() const { return codes_; }
+    const Ptr<CatKey> &key() const { return key_; }
+    int nlevels() const { return key_->max_levels(); }
+    const std::vector<std::string> &labels() const { return key_->labels(); }
+    const std::string &label(int i) const { return key_->label(codes_[i]); }
+
+    // Append the codes from another column with the same labels.
+    void concat(const CategoricalColumn &rhs);
+
+    // Reorder the levels of the key, remapping the codes so that each
+    // observation keeps its label.  The key is replaced rather than modified,
+    // so other holders of the old key are unaffected.
+    void set_order(const std::vector<std::string> &level_names);
+
+    // Expand the column into a CategoricalVariable, creating one data object
+    // per observation.  The variable shares this column's key.
+    CategoricalVariable to_variable() const;
+
+   private:
+    std::vector<std::int32_t> codes_;
+    Ptr<CatKey> key_;
+  };
+
   //===========================================================================
   // Timestamps are an important data type that are distinct from "numeric" or
   // "categorical" data.
@@ -276,6 +331,43 @@ namespace BOOM {
                    bool header = false,
                    const std::string &sep = "");
 
+    // Read a delimited text file into an empty table, parsing it in
+    // parallel.  The file is memory mapped and divided into chunks that
+    // begin and end on line boundaries.  Each chunk is parsed by a separate
+    // thread directly into column storage, without creating intermediate
+    // strings for numeric fields.
+    //
+    // Variable types are diagnosed from a sample of rows at the start of
+    // the file: a column is numeric if every sampled value is numeric.  It is
+    // an error for a later row to contain a non-numeric value in a numeric
+    // column.
+    //
+    // Args:
+    //   filename:  The name of the file to read.
+    //   header: If 'true' then the first line of the file contains variable
+    //     names.
+    //   sep: The set of field separator characters.  An empty string (or one
+    //     made of spaces) splits fields on runs of white space.
+    //   nthreads:  The number of threads to use for parsing.
+    //   type_sample_size:  The number of rows used to diagnose variable types.
+    void read_file_parallel(const std::string &filename,
+                            bool header = false,
+                            const std::string &sep = "",
+                            int nthreads = 0,
+                            int type_sample_size = 1000);
+
+    // Write the numeric variables in the table to a binary matrix file (see
+    // stats/BinaryMatrixFile.hpp), one column per variable.  It is an error
+    // to call this function on a table containing categorical variables.
+    // Variable names are not stored.
+    void write_binary(const std::string &filename) const;
+
+    // Append each column of a binary matrix file to the table as a numeric
+    // variable.  Variables are given default names.  Note that this copies
+    // the data into memory.  To stream a file too large for memory, use
+    // MappedMatrix directly.
+    void read_binary(const std::string &filename);
+
     //--- build a DataTable by appending variables ---
     //
     // If the data table is empty, appending the first variable determines the
@@ -283,6 +375,8 @@ namespace BOOM {
     virtual void append_variable(const Vector &v, const std::string &name);
     virtual void append_variable(const CategoricalVariable &cv,
                                  const std::string &name);
+    void append_variable(const CategoricalColumn &column,
+                         const std::string &name);
 
     // If the data table is empty, appending the first row determines the number
     // and type of columns.
@@ -324,7 +418,20 @@ namespace BOOM {
     }
     Vector getvar(uint which_column) const;
     double getvar(int which_row, int which_column) const;
+
+    // The categorical variable in the requested column, in its stored form
+    // as an array of codes.  This is the efficient way to access categorical
+    // data.
+    const CategoricalColumn &categorical_column(uint which_column) const;
+
+    // The categorical variable in the requested column, expanded into one
+    // data object per observation.  This allocates nrow() objects.  The
+    // returned variable shares the table's CatKey, which should not be
+    // reordered through it.
     CategoricalVariable get_nominal(uint which_column) const;
+
+    // A newly allocated data object holding the requested cell.  Changes to
+    // the returned object do not affect the table.
     Ptr<LabeledCategoricalData> get_nominal(
         int which_row, int which_column) const;
     //    OrdinalVariable get_ordinal(uint which_column) const;
@@ -357,7 +464,7 @@ namespace BOOM {
     // the variable type of column i, and which index in the relevant vector it
     // is stored.
     std::vector<Vector> numeric_variables_;
-    std::vector<CategoricalVariable> categorical_variables_;
+    std::vector<CategoricalColumn> categorical_variables_;
     Ptr<DataTypeIndex> type_index_;
   };
 
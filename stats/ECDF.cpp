@@ -20,10 +20,69 @@
 #include "stats/ECDF.hpp"
 #include <algorithm>
 #include <cmath>
+#include <numeric>
+#include <vector>
 #include "cpputil/report_error.hpp"
 
 namespace BOOM {
 
+  namespace {
+    // Count, for each element of x, the number of elements of 'sorted_data'
+    // that are <= x[i] (if 'equality' is true) or < x[i] (otherwise), and
+    // divide by the sample size.
+    Vector batch_cdf(const Vector &sorted_data, const ConstVectorView &x,
+                     bool equality) {
+      if (sorted_data.empty()) {
+        report_error("An empty empirical CDF cannot be evaluated.");
+      }
+      const size_t n = sorted_data.size();
+      const size_t m = x.size();
+      Vector ans(m);
+      auto count = [&](double value) -> size_t {
+        return (equality
+                ? std::upper_bound(sorted_data.begin(), sorted_data.end(),
+                                   value)
+                : std::lower_bound(sorted_data.begin(), sorted_data.end(),
+                                   value)) - sorted_data.begin();
+      };
+
+      // A handful of queries against a large sample is cheaper with binary
+      // searches than with a pass over the whole sample.
+      if (m * std::log2(n + 1.0) < n) {
+        for (size_t i = 0; i < m; ++i) {
+          ans[i] = static_cast<double>(count(x[i])) / n;
+        }
+        return ans;
+      }
+
+      // NaN's can't be ordered, so they are set aside and evaluated
+      // individually.
+      std::vector<int> order;
+      order.reserve(m);
+      for (size_t i = 0; i < m; ++i) {
+        if (std::isnan(x[i])) {
+          ans[i] = static_cast<double>(count(x[i])) / n;
+        } else {
+          order.push_back(i);
+        }
+      }
+      std::sort(order.begin(), order.end(),
+                [&x](int i, int j) { return x[i] < x[j]; });
+
+      size_t position = 0;
+      for (int i : order) {
+        const double value = x[i];
+        if (equality) {
+          while (position < n && sorted_data[position] <= value) ++position;
+        } else {
+          while (position < n && sorted_data[position] < value) ++position;
+        }
+        ans[i] = static_cast<double>(position) / n;
+      }
+      return ans;
+    }
+  }  // namespace
+
   ECDF::ECDF(const ConstVectorView &unsorted_data)
       : sorted_data_(unsorted_data) {
     if (sorted_data_.empty()) {
@@ -79,4 +138,22 @@ namespace BOOM {
     }
   }
 
+  Vector ECDF::fplus(const ConstVectorView &x) const {
+    return batch_cdf(sorted_data_, x, true);
+  }
+
+  Vector ECDF::fminus(const ConstVectorView &x) const {
+    return batch_cdf(sorted_data_, x, false);
+  }
+
+  Vector ECDF::quantile(const ConstVectorView &probabilities) const {
+    // Each quantile is an O(1) lookup in the sorted data, so no merge is
+    // needed.
+    Vector ans(probabilities.size());
+    for (int i = 0; i < probabilities.size(); ++i) {
+      ans[i] = quantile(probabilities[i]);
+    }
+    return ans;
+  }
+
 }  // namespace BOOM
@@ -69,6 +69,16 @@ namespace BOOM {
     //   distribution.
     double quantile(double probability) const;
 
+    // Batched versions of fplus, fminus, and quantile, returning one value
+    // per element of the argument.  The query points are sorted and matched
+    // against the data in a single merge pass, so evaluating the ECDF at m
+    // points costs O(m log m + n) rather than O(m log n).  (Binary searches
+    // are still used when m is small relative to the data.)  NaN query
+    // points are handled as in the scalar versions.
+    Vector fplus(const ConstVectorView &x) const;
+    Vector fminus(const ConstVectorView &x) const;
+    Vector quantile(const ConstVectorView &probabilities) const;
+
     const Vector &sorted_data() const { return sorted_data_; }
 
     void restore(const Vector &sorted_data) {sorted_data_ = sorted_data;}
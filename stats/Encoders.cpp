@@ -17,10 +17,68 @@
 */
 
 #include "stats/Encoders.hpp"
+
+#include <algorithm>
+
 #include "cpputil/report_error.hpp"
 
 namespace BOOM {
 
+  namespace {
+    // The number of rows encoded at once by InteractionEncoder::encode_into.
+    // Its workspace holds this many rows of each main effect.
+    const int kInteractionChunkRows = 1024;
+
+    void check_encoding_block(const DataEncoder &encoder,
+                              const DataTable &table, const SubMatrix &out,
+                              int first_row) {
+      if (out.ncol() != encoder.dim()) {
+        report_error("The output block must have one column per encoded "
+                     "variable.");
+      }
+      if (first_row < 0 || first_row + out.nrow() > table.nrow()) {
+        report_error("The rows to be encoded are not all in the table.");
+      }
+    }
+  }  // namespace
+
+  SparseVector DataEncoder::encode_row_sparse(
+      const MixedMultivariateData &data) const {
+    Vector dense = encode_row(data);
+    SparseVector ans(dense.size());
+    for (int i = 0; i < dense.size(); ++i) {
+      if (dense[i] != 0.0) {
+        ans[i] = dense[i];
+      }
+    }
+    return ans;
+  }
+
+  void DataEncoder::encode_into(const DataTable &table, SubMatrix out,
+                                int first_row) const {
+    check_encoding_block(*this, table, out, first_row);
+    for (int i = 0; i < out.nrow(); ++i) {
+      encode_row(*table.row(first_row + i), out.row(i));
+    }
+  }
+
+  void DataEncoder::encode_in_chunks(
+      const DataTable &table, int chunk_size,
+      const std::function<void(int, const Matrix &)> &callback) const {
+    if (chunk_size <= 0) {
+      report_error("chunk_size must be positive.");
+    }
+    Matrix block;
+    for (int first_row = 0; first_row < table.nrow(); first_row += chunk_size) {
+      int rows = std::min<int>(chunk_size, table.nrow() - first_row);
+      if (block.nrow() != rows) {
+        block.resize(rows, dim());
+      }
+      encode_into(table, SubMatrix(block), first_row);
+      callback(first_row, block);
+    }
+  }
+
   EffectsEncoder::EffectsEncoder(int which_variable, const Ptr<CatKeyBase> &key)
       : MainEffectsEncoder(which_variable),
         key_(key)
@@ -75,8 +133,34 @@ namespace BOOM {
     return ans;
   }
 
+  Matrix EffectsEncoder::encode(const CategoricalColumn &column) const {
+    Matrix ans(column.size(), dim());
+    encode(column, SubMatrix(ans), 0);
+    return ans;
+  }
+
+  void EffectsEncoder::encode(const CategoricalColumn &column, SubMatrix out,
+                              int first_row) const {
+    int reference_level = key_->max_levels() - 1;
+    const std::int32_t *codes = column.codes().data() + first_row;
+    int nrow = out.nrow();
+    for (int j = 0; j < dim(); ++j) {
+      double *ans_column = out.col_begin(j);
+      for (int i = 0; i < nrow; ++i) {
+        int level = codes[i];
+        ans_column[i] = level == reference_level ? -1.0 : (level == j);
+      }
+    }
+  }
+
   Matrix EffectsEncoder::encode_dataset(const DataTable &table) const {
-    return encode(table.get_nominal(which_variable()));
+    return encode(table.categorical_column(which_variable()));
+  }
+
+  void EffectsEncoder::encode_into(const DataTable &table, SubMatrix out,
+                                   int first_row) const {
+    check_encoding_block(*this, table, out, first_row);
+    encode(table.categorical_column(which_variable()), out, first_row);
   }
 
   Vector EffectsEncoder::encode_row(const MixedMultivariateData &row) const {
@@ -88,6 +172,23 @@ namespace BOOM {
     encode(row.categorical(which_variable()), view);
   }
 
+  SparseVector EffectsEncoder::encode_sparse(int level) const {
+    SparseVector ans(dim());
+    if (level == key_->max_levels() - 1) {
+      for (int i = 0; i < dim(); ++i) {
+        ans[i] = -1.0;
+      }
+    } else {
+      ans[level] = 1.0;
+    }
+    return ans;
+  }
+
+  SparseVector EffectsEncoder::encode_row_sparse(
+      const MixedMultivariateData &row) const {
+    return encode_sparse(row.categorical(which_variable()).value());
+  }
+
   //===========================================================================
   InteractionEncoder::InteractionEncoder(
       const Ptr<DataEncoder> &encoder1, const Ptr<DataEncoder> &encoder2)
@@ -97,20 +198,81 @@ namespace BOOM {
         wsp2_(encoder2->dim())
   {}
 
+  Matrix InteractionEncoder::encode_dataset(const DataTable &table) const {
+    Matrix ans(table.nrow(), dim());
+    encode_into(table, SubMatrix(ans), 0);
+    return ans;
+  }
+
+  void InteractionEncoder::encode_into(const DataTable &table, SubMatrix out,
+                                       int first_row) const {
+    check_encoding_block(*this, table, out, first_row);
+    int dim1 = encoder1_->dim();
+    int dim2 = encoder2_->dim();
+    if (dim1 == 0 || dim2 == 0) return;
+    int nrow = out.nrow();
+    int chunk = std::min<int>(nrow, kInteractionChunkRows);
+    Matrix m1(chunk, dim1), m2(chunk, dim2);
+    for (int start = 0; start < nrow; start += chunk) {
+      int rows = std::min<int>(chunk, nrow - start);
+      if (rows != m1.nrow()) {
+        m1.resize(rows, dim1);
+        m2.resize(rows, dim2);
+      }
+      encoder1_->encode_into(table, SubMatrix(m1), first_row + start);
+      encoder2_->encode_into(table, SubMatrix(m2), first_row + start);
+      int index = 0;
+      for (int i = 0; i < dim1; ++i) {
+        const double *col1 = m1.data() + i * rows;
+        for (int j = 0; j < dim2; ++j) {
+          const double *col2 = m2.data() + j * rows;
+          double *ans = out.col_begin(index++) + start;
+          for (int k = 0; k < rows; ++k) {
+            ans[k] = col1[k] * col2[k];
+          }
+        }
+      }
+    }
+  }
+
+  SparseVector InteractionEncoder::encode_row_sparse(
+      const MixedMultivariateData &data) const {
+    SparseVector v1 = encoder1_->encode_row_sparse(data);
+    SparseVector v2 = encoder2_->encode_row_sparse(data);
+    int dim2 = encoder2_->dim();
+    SparseVector ans(dim());
+    for (const auto &el1 : v1) {
+      for (const auto &el2 : v2) {
+        ans[el1.first * dim2 + el2.first] = el1.second * el2.second;
+      }
+    }
+    return ans;
+  }
+
   //===========================================================================
   Matrix DatasetEncoder::encode_dataset(const DataTable &table) const {
-    int nrow = table.nrow();
-    Matrix ans(nrow, dim());
+    Matrix ans(table.nrow(), dim());
+    encode_into(table, SubMatrix(ans), 0);
+    return ans;
+  }
+
+  void DatasetEncoder::encode_into(const DataTable &table, SubMatrix out,
+                                   int first_row) const {
+    check_encoding_block(*this, table, out, first_row);
+    int nrow = out.nrow();
+    if (nrow == 0) return;
     if (add_intercept_) {
-      ans.col(0) = 1.0;
+      out.col(0) = 1.0;
     }
     int start = add_intercept_;
     for (size_t i = 0; i < encoders_.size(); ++i) {
       int end = start + encoders_[i]->dim();
-      SubMatrix(ans, 0, nrow-1, start, end-1) = encoders_[i]->encode_dataset(table);
+      if (end > start) {
+        encoders_[i]->encode_into(
+            table, SubMatrix(out, 0, nrow - 1, start, end - 1), first_row);
+      }
       start = end;
     }
-    return ans;
   }
 
   void DatasetEncoder::encode_row(const MixedMultivariateData &data,
@@ -126,6 +288,20 @@ namespace BOOM {
     }
   }
 
+  SparseVector DatasetEncoder::encode_row_sparse(
+      const MixedMultivariateData &data) const {
+    SparseVector ans(0);
+    if (add_intercept_) {
+      SparseVector intercept(1);
+      intercept[0] = 1.0;
+      ans.concatenate(intercept);
+    }
+    for (size_t i = 0; i < encoders_.size(); ++i) {
+      ans.concatenate(encoders_[i]->encode_row_sparse(data));
+    }
+    return ans;
+  }
+
   Vector DatasetEncoder::encode_row(const MixedMultivariateData &data) const {
     Vector ans(dim());
     encode_row(data, VectorView(ans));
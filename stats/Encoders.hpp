@@ -19,11 +19,15 @@
   Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
 */
 
+#include <functional>
+
 #include "cpputil/RefCounted.hpp"
 #include "stats/DataTable.hpp"
 #include "LinAlg/Vector.hpp"
 #include "LinAlg/Matrix.hpp"
+#include "LinAlg/SubMatrix.hpp"
 #include "Models/CategoricalData.hpp"
+#include "Models/StateSpace/Filters/SparseVector.hpp"
 
 namespace BOOM {
 
@@ -38,6 +42,32 @@ namespace BOOM {
     virtual void encode_row(
         const MixedMultivariateData &data, VectorView v) const = 0;
 
+    // The encoded row as a sparse vector.  Encodings of categorical
+    // variables are mostly zeros, so models that can exploit sparsity (see
+    // RegSuf::add_mixture_data and GlmCoefs::predict) save a great deal of
+    // work by using this form.  The default implementation extracts the
+    // nonzero elements of the dense encoding.  Child classes should
+    // override if the nonzeros can be found directly.
+    virtual SparseVector encode_row_sparse(
+        const MixedMultivariateData &data) const;
+
+    // Write the encodings of rows first_row, ..., first_row + out.nrow() - 1
+    // of 'table' into 'out', which must have dim() columns.  This lets a
+    // large table be encoded in chunks, or straight into a block of a larger
+    // matrix, without materializing the full design matrix.  The default
+    // implementation encodes one row at a time.  Child classes should
+    // override if the encoding can be done a column at a time.
+    virtual void encode_into(const DataTable &table, SubMatrix out,
+                             int first_row) const;
+
+    // Encode 'table' in blocks of at most 'chunk_size' rows, calling
+    // callback(first_row, block) for each block.  The block is reused, so
+    // peak memory is a single chunk of the design matrix.
+    void encode_in_chunks(
+        const DataTable &table, int chunk_size,
+        const std::function<void(int first_row, const Matrix &block)>
+            &callback) const;
+
    private:
     friend void intrusive_ptr_add_ref(DataEncoder *d) {d->up_count();}
     friend void intrusive_ptr_release(DataEncoder *d) {
@@ -82,11 +112,24 @@ namespace BOOM {
     void encode(int level, VectorView view) const;
 
     Matrix encode(const CategoricalVariable &variable) const;
+    Matrix encode(const CategoricalColumn &column) const;
+
+    // Encode column[first_row], ..., column[first_row + out.nrow() - 1] into
+    // 'out'.
+    void encode(const CategoricalColumn &column, SubMatrix out,
+                int first_row) const;
 
     Matrix encode_dataset(const DataTable &data) const override;
+    void encode_into(const DataTable &table, SubMatrix out,
+                     int first_row) const override;
     Vector encode_row(const MixedMultivariateData &row) const override;
     void encode_row(const MixedMultivariateData &row, VectorView view) const override;
 
+    // Levels other than the reference level produce a single nonzero.
+    SparseVector encode_sparse(int level) const;
+    SparseVector encode_row_sparse(
+        const MixedMultivariateData &row) const override;
+
    private:
     Ptr<CatKeyBase> key_;
   };
@@ -101,19 +144,12 @@ namespace BOOM {
       return encoder1_->dim() * encoder2_->dim();
     }
 
-    Matrix encode_dataset(const DataTable &table) const override {
-      Matrix m1 = encoder1_->encode_dataset(table);
-      Matrix m2 = encoder2_->encode_dataset(table);
+    Matrix encode_dataset(const DataTable &table) const override;
 
-      Matrix ans(table.nrow(), dim());
-      int index = 0;
-      for (int i = 0; i < m1.ncol(); ++i) {
-        for (int j = 0; j < m2.ncol(); ++j) {
-          ans.col(index++) = m1.col(i) * m2.col(j);
-        }
-      }
-      return ans;
-    }
+    // The main effects are encoded a chunk of rows at a time into a small
+    // workspace, and their products are written directly into 'out'.
+    void encode_into(const DataTable &table, SubMatrix out,
+                     int first_row) const override;
 
     void encode_row(const MixedMultivariateData &data,
                     VectorView ans) const override {
@@ -133,6 +169,11 @@ namespace BOOM {
       return ans;
     }
 
+    // The nonzeros of the interaction are the products of the nonzeros of
+    // the two main effects.
+    SparseVector encode_row_sparse(
+        const MixedMultivariateData &data) const override;
+
    private:
     Ptr<DataEncoder> encoder1_;
     Ptr<DataEncoder> encoder2_;
@@ -156,9 +197,13 @@ namespace BOOM {
     bool add_intercept() const {return add_intercept_;}
 
     Matrix encode_dataset(const DataTable &data) const override;
+    void encode_into(const DataTable &table, SubMatrix out,
+                     int first_row) const override;
     Vector encode_row(const MixedMultivariateData &row) const override;
     void encode_row(
         const MixedMultivariateData &row, VectorView ans) const override;
+    SparseVector encode_row_sparse(
+        const MixedMultivariateData &row) const override;
 
     const std::vector<Ptr<DataEncoder>> &encoders() const {return encoders_;}
 
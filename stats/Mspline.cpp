@@ -18,6 +18,8 @@
 */
 
 #include "stats/Mspline.hpp"
+#include <cmath>
+#include <vector>
 #include "cpputil/math_utils.hpp"
 #include "cpputil/report_error.hpp"
 
@@ -73,6 +75,38 @@ namespace BOOM {
     }
   }
 
+  // An Mspline basis function is a rescaled B-spline on the same knots:
+  // M_i(x) = order * B_i(x) / (knot(i + order) - knot(i)).
+  void Mspline::fill_basis_matrix(const ConstVectorView &x,
+                                  SubMatrix &out) const {
+    if (order_ < 1) {
+      SplineBase::fill_basis_matrix(x, out);
+      return;
+    }
+    std::vector<int> spans;
+    locate_knot_spans(x, spans);
+    std::vector<double> values, left, right;
+    const double lo = knot(0);
+    const double hi = final_knot();
+    for (int i = 0; i < x.size(); ++i) {
+      double xi = x[i];
+      if (std::isnan(xi)) {
+        out.row(i) = basis(xi);
+        continue;
+      } else if (xi < lo || xi >= hi) {
+        continue;
+      }
+      int span = spans[i] + order_ - 1;
+      nonzero_bspline_values(xi, span, order_, values, left, right);
+      int first = span - order_ + 1;
+      for (int r = 0; r < order_; ++r) {
+        int which = first + r;
+        out(i, which) =
+            order_ * values[r] / (knot(which + order_) - knot(which));
+      }
+    }
+  }
+
   void Mspline::increment_basis_dimension() { ++basis_dimension_; }
 
   void Mspline::decrement_basis_dimension() { --basis_dimension_; }
@@ -99,6 +133,49 @@ namespace BOOM {
     }
   }
 
+  // Ispline basis function i is the sum of the B-splines of order order() + 1
+  // numbered i and above that are nonzero at x.
+  void Ispline::fill_basis_matrix(const ConstVectorView &x,
+                                  SubMatrix &out) const {
+    if (order() < 1) {
+      SplineBase::fill_basis_matrix(x, out);
+      return;
+    }
+    std::vector<int> spans;
+    locate_knot_spans(x, spans);
+    std::vector<double> values, left, right;
+    const double lo = knot(0);
+    const double hi = final_knot();
+    const int dim = basis_dimension();
+    for (int i = 0; i < x.size(); ++i) {
+      double xi = x[i];
+      if (std::isnan(xi)) {
+        out.row(i) = basis(xi);
+        continue;
+      } else if (xi < lo) {
+        continue;
+      } else if (xi >= hi) {
+        out.row(i) = 1.0;
+        continue;
+      }
+      int span = spans[i] + order() - 1;
+      nonzero_bspline_values(xi, span, order() + 1, values, left, right);
+      // values[r] belongs to B-spline number span - order() + r.
+      int first = span - order() + 1;
+      for (int which = 0; which < std::min(first, dim); ++which) {
+        out(i, which) = 1.0;
+      }
+      double tail_sum = 0;
+      for (int r = order(); r >= 1; --r) {
+        tail_sum += values[r];
+        int which = span - order() + r;
+        if (which < dim) {
+          out(i, which) = tail_sum;
+        }
+      }
+    }
+  }
+
   Vector Ispline::basis(double x) const {
     Vector ans(basis_dimension());
     for (int i = 0; i < ans.size(); ++i) {
@@ -84,6 +84,11 @@ namespace BOOM {
                                   int which_basis_element) const;
 
    private:
+    // Evaluates the 'order' nonzero basis functions at each point directly
+    // into 'out', using the relationship between M-splines and B-splines.
+    void fill_basis_matrix(const ConstVectorView &x,
+                           SubMatrix &out) const override;
+
     void increment_basis_dimension() override;
     void decrement_basis_dimension() override;
     int order_;
@@ -124,6 +129,13 @@ namespace BOOM {
     //   The value of the indicated basis function at x.
     double ispline_basis_function(double x, int order,
                                   int which_basis_element) const;
+
+   private:
+    // Each Ispline basis function is a sum of B-splines of order order() + 1,
+    // so the basis matrix can be filled from the order() + 1 B-splines that
+    // are nonzero at each point.
+    void fill_basis_matrix(const ConstVectorView &x,
+                           SubMatrix &out) const override;
   };
 
 }  // namespace BOOM
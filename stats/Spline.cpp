@@ -30,10 +30,80 @@ namespace BOOM {
 
   Matrix SplineBase::basis_matrix(const Vector &x) const {
     Matrix ans(x.size(), this->basis_dimension());
+    basis_matrix(x, SubMatrix(ans));
+    return ans;
+  }
+
+  void SplineBase::basis_matrix(const ConstVectorView &x,
+                                SubMatrix out) const {
+    if (out.nrow() != x.size() || out.ncol() != basis_dimension()) {
+      std::ostringstream err;
+      err << "A basis matrix for " << x.size() << " points with basis "
+          << "dimension " << basis_dimension() << " cannot be stored in a "
+          << out.nrow() << " by " << out.ncol() << " matrix.";
+      report_error(err.str());
+    }
+    out = 0.0;
+    if (x.size() == 0 || basis_dimension() == 0) {
+      return;
+    }
+    fill_basis_matrix(x, out);
+  }
+
+  void SplineBase::fill_basis_matrix(const ConstVectorView &x,
+                                     SubMatrix &out) const {
     for (int i = 0; i < x.size(); ++i) {
-      ans.row(i) = this->basis(x[i]);
+      out.row(i) = this->basis(x[i]);
+    }
+  }
+
+  void SplineBase::locate_knot_spans(const ConstVectorView &x,
+                                     std::vector<int> &spans) const {
+    spans.resize(x.size());
+    bool sorted = true;
+    for (int i = 1; i < x.size(); ++i) {
+      if (!(x[i - 1] <= x[i])) {
+        sorted = false;
+        break;
+      }
+    }
+    if (sorted) {
+      // Walk the knots and the data together.
+      int terminal_knot = 0;
+      for (int i = 0; i < x.size(); ++i) {
+        while (terminal_knot < knots_.size() && knots_[terminal_knot] <= x[i]) {
+          ++terminal_knot;
+        }
+        spans[i] = terminal_knot - 1;
+      }
+    } else {
+      // Sorting the data would cost more than a binary search over the
+      // (typically few) knots for each point.
+      for (int i = 0; i < x.size(); ++i) {
+        spans[i] = SplineBase::knot_span(x[i]);
+      }
+    }
+  }
+
+  void SplineBase::nonzero_bspline_values(double x, int span, int order,
+                                          std::vector<double> &values,
+                                          std::vector<double> &left,
+                                          std::vector<double> &right) const {
+    if (values.size() < order) values.resize(order);
+    if (left.size() < order) left.resize(order);
+    if (right.size() < order) right.resize(order);
+    values[0] = 1.0;
+    for (int j = 1; j < order; ++j) {
+      left[j] = x - knot(span + 1 - j);
+      right[j] = knot(span + j) - x;
+      double saved = 0.0;
+      for (int r = 0; r < j; ++r) {
+        double term = values[r] / (right[r + 1] + left[j - r]);
+        values[r] = saved + right[r + 1] * term;
+        saved = left[j - r] * term;
+      }
+      values[j] = saved;
     }
-    return ans;
   }
 
   double SplineBase::final_knot() const {
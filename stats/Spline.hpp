@@ -18,8 +18,10 @@
 */
 #ifndef BOOM_SPLINE_HPP
 #define BOOM_SPLINE_HPP
+#include <vector>
 #include "LinAlg/Vector.hpp"
 #include "LinAlg/Matrix.hpp"
+#include "LinAlg/SubMatrix.hpp"
 
 namespace BOOM {
   // A base class providing features shared by different spline bases.
@@ -43,6 +45,14 @@ namespace BOOM {
     // Row i of the returned matrix is the basis expansion of x[i].
     Matrix basis_matrix(const Vector &x) const;
 
+    // Fill 'out' with the basis expansion of each element of x.  Row i of
+    // 'out' is the basis expansion of x[i], so 'out' must have x.size() rows
+    // and basis_dimension() columns.  This is the preferred way to build a
+    // spline design matrix for many points: subclasses only evaluate the few
+    // basis functions that are nonzero at each point, and no memory is
+    // allocated per point.
+    void basis_matrix(const ConstVectorView &x, SubMatrix out) const;
+
     // The dimension of the spline basis (i.e. the dimension of the
     // vector returned by a call to 'basis()'.
     virtual int basis_dimension() const = 0;
@@ -75,6 +85,37 @@ namespace BOOM {
     // Compute the index of the largest knot less than or equal to x.
     virtual int knot_span(double x) const;
 
+   protected:
+    // Fill 'out' with the basis expansion of x.  'out' has been checked for
+    // size and set to zero.  The default implementation calls basis() for
+    // each element of x.
+    virtual void fill_basis_matrix(const ConstVectorView &x,
+                                   SubMatrix &out) const;
+
+    // Compute SplineBase::knot_span(x[i]) for each element of x, storing the
+    // result in spans[i].  If x is sorted the spans are found in a single
+    // pass through the knots.
+    void locate_knot_spans(const ConstVectorView &x,
+                           std::vector<int> &spans) const;
+
+    // Evaluate the B-splines of the given order that are nonzero at x, using
+    // de Boor's recursion (BSPLVB in "A Practical Guide to Splines") on the
+    // knot sequence defined by knot().
+    //
+    // Args:
+    //   x:  The point at which to evaluate the splines.
+    //   span:  An index with knot(span) <= x < knot(span + 1).
+    //   order:  The order (degree + 1) of the B-splines.
+    //   values: On output, values[r] is the value at x of the B-spline
+    //     supported on [knot(span - order + 1 + r), knot(span + 1 + r)), for
+    //     r = 0, ..., order - 1.
+    //   left, right:  Workspace.
+    // All three vectors are resized to 'order' if needed.
+    void nonzero_bspline_values(double x, int span, int order,
+                                std::vector<double> &values,
+                                std::vector<double> &left,
+                                std::vector<double> &right) const;
+
    private:
     virtual void increment_basis_dimension() = 0;
     virtual void decrement_basis_dimension() = 0;
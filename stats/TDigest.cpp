@@ -0,0 +1,244 @@
+// Copyright 2018 Google LLC. All Rights Reserved.
+/*
+  Copyright (C) 2005-2024 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#include "stats/TDigest.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "cpputil/Constants.hpp"
+#include "cpputil/math_utils.hpp"
+#include "cpputil/report_error.hpp"
+
+namespace BOOM {
+
+  namespace {
+    // The number of buffered points, as a multiple of the compression, that
+    // triggers a merge.
+    const double kBufferMultiple = 5;
+
+    // The k1 scale function from Dunning and Ertl.  A centroid may span at
+    // most one unit of k, which keeps centroids in the tails small.
+    double scale(double q, double compression) {
+      return compression / (2 * Constants::pi) * std::asin(2 * q - 1);
+    }
+
+    double inverse_scale(double k, double compression) {
+      double angle = 2 * Constants::pi * k / compression;
+      if (angle >= Constants::pi / 2) return 1.0;
+      return (std::sin(angle) + 1) / 2;
+    }
+  }  // namespace
+
+  TDigest::TDigest(double compression)
+      : compression_(compression),
+        min_(infinity()),
+        max_(negative_infinity()),
+        total_weight_(0.0),
+        buffer_weight_(0.0) {
+    if (compression < 10) {
+      report_error("TDigest compression must be at least 10.");
+    }
+  }
+
+  TDigest::TDigest(const TDigestState &state)
+      : compression_(100),
+        min_(infinity()),
+        max_(negative_infinity()),
+        total_weight_(0.0),
+        buffer_weight_(0.0) {
+    restore_from_state(state);
+  }
+
+  void TDigest::add(double x, double weight) {
+    if (!std::isfinite(x)) {
+      report_error("Only finite values can be added to a TDigest.");
+    }
+    if (weight <= 0) return;
+    buffer_.emplace_back(x, weight);
+    buffer_weight_ += weight;
+    min_ = std::min(min_, x);
+    max_ = std::max(max_, x);
+    if (buffer_.size() >= kBufferMultiple * compression_) {
+      compress();
+    }
+  }
+
+  void TDigest::add(const Vector &x) {
+    for (double value : x) add(value);
+  }
+
+  void TDigest::merge(const TDigest &other) {
+    if (&other == this) {
+      report_error("A TDigest cannot be merged with itself.");
+    }
+    other.compress();
+    for (int i = 0; i < other.means_.size(); ++i) {
+      buffer_.emplace_back(other.means_[i], other.weights_[i]);
+    }
+    buffer_weight_ += other.total_weight_;
+    min_ = std::min(min_, other.min_);
+    max_ = std::max(max_, other.max_);
+    if (buffer_.size() >= kBufferMultiple * compression_) {
+      compress();
+    }
+  }
+
+  void TDigest::compress() const {
+    if (buffer_.empty()) return;
+    for (int i = 0; i < means_.size(); ++i) {
+      buffer_.emplace_back(means_[i], weights_[i]);
+    }
+    std::sort(buffer_.begin(), buffer_.end());
+    double total = total_weight_ + buffer_weight_;
+
+    means_.clear();
+    weights_.clear();
+    double weight_so_far = 0;
+    double weight_limit = total * inverse_scale(
+        scale(0, compression_) + 1, compression_);
+    double mean = buffer_[0].first;
+    double weight = buffer_[0].second;
+    for (size_t i = 1; i < buffer_.size(); ++i) {
+      double proposed = weight + buffer_[i].second;
+      if (weight_so_far + proposed <= weight_limit) {
+        mean += (buffer_[i].first - mean) * buffer_[i].second / proposed;
+        weight = proposed;
+      } else {
+        means_.push_back(mean);
+        weights_.push_back(weight);
+        weight_so_far += weight;
+        weight_limit = total * inverse_scale(
+            scale(weight_so_far / total, compression_) + 1, compression_);
+        mean = buffer_[i].first;
+        weight = buffer_[i].second;
+      }
+    }
+    means_.push_back(mean);
+    weights_.push_back(weight);
+
+    total_weight_ = total;
+    buffer_.clear();
+    buffer_weight_ = 0;
+  }
+
+  int TDigest::number_of_centroids() const {
+    compress();
+    return means_.size();
+  }
+
+  // The digest is treated as a piecewise linear CDF.  Half of each
+  // centroid's weight lies on either side of its mean, and the data
+  // between adjacent centroid means is uniformly spread.  The outer half
+  // centroids are spread between the mean and the observed min or max.
+  double TDigest::quantile(double prob) const {
+    if (prob < 0 || prob > 1) {
+      report_error("Probability argument to TDigest::quantile must be "
+                   "between 0 and 1.");
+    }
+    compress();
+    int n = means_.size();
+    if (n == 0) {
+      report_error("Cannot compute quantiles of an empty TDigest.");
+    }
+    if (n == 1) {
+      return min_ + prob * (max_ - min_);
+    }
+    double index = prob * total_weight_;
+    double left_half = weights_[0] / 2;
+    if (index < left_half) {
+      return min_ + (index / left_half) * (means_[0] - min_);
+    }
+    double right_half = weights_[n - 1] / 2;
+    if (index > total_weight_ - right_half) {
+      double fraction = (total_weight_ - index) / right_half;
+      return max_ - fraction * (max_ - means_[n - 1]);
+    }
+    double cumulative = left_half;
+    for (int i = 0; i + 1 < n; ++i) {
+      double gap = (weights_[i] + weights_[i + 1]) / 2;
+      if (index <= cumulative + gap) {
+        double fraction = (index - cumulative) / gap;
+        return means_[i] + fraction * (means_[i + 1] - means_[i]);
+      }
+      cumulative += gap;
+    }
+    return means_[n - 1];
+  }
+
+  double TDigest::cdf(double x) const {
+    compress();
+    int n = means_.size();
+    if (n == 0) {
+      report_error("Cannot compute the CDF of an empty TDigest.");
+    }
+    if (x < min_) return 0.0;
+    if (x >= max_) return 1.0;
+    if (n == 1) {
+      return (x - min_) / (max_ - min_);
+    }
+    if (x < means_[0]) {
+      double left_half = weights_[0] / 2;
+      return left_half * (x - min_) / (means_[0] - min_) / total_weight_;
+    }
+    if (x >= means_[n - 1]) {
+      double right_half = weights_[n - 1] / 2;
+      return 1.0 - right_half * (max_ - x) / (max_ - means_[n - 1])
+          / total_weight_;
+    }
+    double cumulative = weights_[0] / 2;
+    for (int i = 0; i + 1 < n; ++i) {
+      double gap = (weights_[i] + weights_[i + 1]) / 2;
+      if (x < means_[i + 1]) {
+        double fraction = (x - means_[i]) / (means_[i + 1] - means_[i]);
+        return (cumulative + fraction * gap) / total_weight_;
+      }
+      cumulative += gap;
+    }
+    return 1.0;
+  }
+
+  TDigestState TDigest::save_state() const {
+    compress();
+    TDigestState state;
+    state.compression = compression_;
+    state.min = min_;
+    state.max = max_;
+    state.means = Vector(means_.begin(), means_.end());
+    state.weights = Vector(weights_.begin(), weights_.end());
+    return state;
+  }
+
+  void TDigest::restore_from_state(const TDigestState &state) {
+    if (state.means.size() != state.weights.size()) {
+      report_error("TDigestState must have the same number of means and "
+                   "weights.");
+    }
+    compression_ = state.compression;
+    min_ = state.min;
+    max_ = state.max;
+    means_.assign(state.means.begin(), state.means.end());
+    weights_.assign(state.weights.begin(), state.weights.end());
+    total_weight_ = 0;
+    for (double w : weights_) total_weight_ += w;
+    buffer_.clear();
+    buffer_weight_ = 0;
+  }
+
+}  // namespace BOOM
@@ -0,0 +1,108 @@
+#ifndef BOOM_STATS_TDIGEST_HPP_
+#define BOOM_STATS_TDIGEST_HPP_
+// Copyright 2018 Google LLC. All Rights Reserved.
+/*
+  Copyright (C) 2005-2024 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+*/
+
+#include <vector>
+#include "LinAlg/Vector.hpp"
+
+namespace BOOM {
+
+  // The serialized state of a TDigest.
+  struct TDigestState {
+    double compression;
+    double min;
+    double max;
+    Vector means;
+    Vector weights;
+  };
+
+  // A mergeable approximation to the empirical distribution of continuous
+  // numeric data, from Dunning and Ertl (2019) "Computing extremely accurate
+  // quantiles using t-digests".
+  //
+  // The digest summarizes the data with a sorted set of weighted centroids.
+  // Centroids near the tails are kept small, so extreme quantiles are
+  // accurate to a few parts per million, while the number of centroids is
+  // bounded by about 'compression' regardless of the amount of data.
+  //
+  // Unlike IQagent, two digests can be merged.  Summaries of MCMC draws or
+  // forecasts computed on separate threads (or machines) can be combined
+  // into a summary of all the data without sharing the raw draws.
+  class TDigest {
+   public:
+    // Args:
+    //   compression: Controls the tradeoff between accuracy and size.  The
+    //     digest holds at most about 'compression' centroids.
+    explicit TDigest(double compression = 100);
+
+    // Args:
+    //   state:  The serialized state of a previously fit TDigest.
+    explicit TDigest(const TDigestState &state);
+
+    // Add a data point to the empirical distribution.
+    void add(double x, double weight = 1.0);
+
+    // Add a collection of data points to the empirical distribution.
+    void add(const Vector &x);
+
+    // Add the data summarized by 'other' to this digest.
+    void merge(const TDigest &other);
+
+    // Return the approximate quantile associated with the given probability.
+    double quantile(double prob) const;
+
+    // Return the approximate fraction of data less than or equal to x.
+    double cdf(double x) const;
+
+    // The total weight of the data added to the digest.
+    double count() const { return total_weight_ + buffer_weight_; }
+
+    // The smallest and largest values added.
+    double min() const { return min_; }
+    double max() const { return max_; }
+
+    // The number of centroids in the compressed digest.
+    int number_of_centroids() const;
+
+    TDigestState save_state() const;
+    void restore_from_state(const TDigestState &state);
+
+   private:
+    // Fold any buffered points into the centroids.  The digest is logically
+    // const before and after, so this is callable from const members.
+    void compress() const;
+
+    double compression_;
+    double min_;
+    double max_;
+
+    // The merged centroids, sorted by mean.
+    mutable std::vector<double> means_;
+    mutable std::vector<double> weights_;
+    mutable double total_weight_;
+
+    // Points (or centroids from merged digests) not yet merged.
+    mutable std::vector<std::pair<double, double>> buffer_;
+    mutable double buffer_weight_;
+  };
+
+}  // namespace BOOM
+
+#endif  // BOOM_STATS_TDIGEST_HPP_
@@ -17,8 +17,60 @@
 */
 
 #include "stats/acf.hpp"
+#include "math/fft.hpp"
+#include "math/kissfft/kiss_fft.hpp"
+#include "cpputil/report_error.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <sstream>
 
 namespace BOOM {
+  namespace {
+    using ComplexVector = std::vector<std::complex<double>>;
+
+    // Rescale an autocovariance function to the correlation scale, keeping
+    // the correlations in [-1, 1].
+    void normalize_acf(VectorView ans, int n) {
+      if (n == 1) {
+        ans[0] = 1.0;
+      } else {
+        double variance = ans[0];
+        for (int lag = 0; lag < ans.size(); ++lag) {
+          double a = ans[lag] / variance;
+          ans[lag] = (a > 1.) ? 1. : ((a < -1.) ? -1. : a);
+        }
+      }
+    }
+
+    // The length of a real FFT that is long enough to hold lags up to
+    // num_lags of a series of length n without wrapping around.
+    int padded_fft_size(int n, int num_lags) {
+      int max_lag = std::max(0, std::min(num_lags, n - 1));
+      return FFT::kiss_fftr_next_fast_size_real(n + max_lag);
+    }
+
+    // Fill 'ans' with sum_i x[i + lag] * x[i] / n for lag = 0, ...,
+    // ans.size() - 1.  Lags that exceed the length of the series are NaN.
+    void fft_autocovariance(RealFftPlan &plan,
+                            const ConstVectorView &x,
+                            VectorView ans,
+                            ComplexVector &frequency_domain,
+                            Vector &time_domain) {
+      plan.transform(x, frequency_domain);
+      for (auto &z : frequency_domain) {
+        z = std::norm(z);
+      }
+      plan.inverse_transform(frequency_domain, time_domain);
+      int n = x.size();
+      double scale = 1.0 / (static_cast<double>(n) * plan.nfft());
+      for (int lag = 0; lag < ans.size(); ++lag) {
+        ans[lag] = lag < n ? time_domain[lag] * scale
+            : std::numeric_limits<double>::quiet_NaN();
+      }
+    }
+
+  }  // namespace
 
   Vector acf(const ConstVectorView &x, int num_lags, bool correlation) {
     Vector ans(num_lags + 1);
@@ -33,15 +85,83 @@ namespace BOOM {
       ans[lag] = (nu > 0) ? sum/(nu + lag) : std::numeric_limits<double>::quiet_NaN();
     }
     if(correlation) {
-      if(n == 1) {
-        ans[0] = 1.0;
-      } else {
-        double se = 0;
-        se = sqrt(ans[0]);
-        for(int lag = 0; lag <= num_lags; lag++) { // ensure correlations remain in  [-1,1] :
-          double a = ans[lag] / se;
-          ans[lag] = (a > 1.) ? 1. : ((a < -1.) ? -1. : a);
+      normalize_acf(VectorView(ans), n);
+    }
+    return ans;
+  }
+
+  Vector fft_acf(const ConstVectorView &x, int num_lags, bool correlation) {
+    int n = x.size();
+    Vector ans(num_lags + 1, std::numeric_limits<double>::quiet_NaN());
+    if (n == 0) {
+      return ans;
+    }
+    RealFftPlan plan(padded_fft_size(n, num_lags));
+    ComplexVector frequency_domain;
+    Vector time_domain;
+    fft_autocovariance(plan, x, VectorView(ans), frequency_domain,
+                       time_domain);
+    if (correlation) {
+      normalize_acf(VectorView(ans), n);
+    }
+    return ans;
+  }
+
+  Vector cross_correlation(const ConstVectorView &x, const ConstVectorView &y,
+                           int num_lags, bool correlation) {
+    int n = x.size();
+    if (y.size() != n) {
+      std::ostringstream err;
+      err << "cross_correlation requires series of the same length.  "
+          << "Got " << n << " and " << y.size() << ".";
+      report_error(err.str());
+    }
+    Vector ans(2 * num_lags + 1, std::numeric_limits<double>::quiet_NaN());
+    if (n == 0) {
+      return ans;
+    }
+    RealFftPlan plan(padded_fft_size(n, num_lags));
+    ComplexVector x_transform, y_transform;
+    plan.transform(x, x_transform);
+    plan.transform(y, y_transform);
+    for (int i = 0; i < x_transform.size(); ++i) {
+      x_transform[i] *= std::conj(y_transform[i]);
+    }
+    Vector time_domain;
+    plan.inverse_transform(x_transform, time_domain);
+
+    int nfft = plan.nfft();
+    double scale = 1.0 / (static_cast<double>(n) * nfft);
+    if (correlation) {
+      scale /= sqrt(x.normsq() * y.normsq()) / n;
+    }
+    for (int lag = -num_lags; lag <= num_lags; ++lag) {
+      if (std::abs(lag) < n) {
+        double value = time_domain[lag >= 0 ? lag : nfft + lag] * scale;
+        if (correlation) {
+          value = std::max(-1.0, std::min(1.0, value));
         }
+        ans[num_lags + lag] = value;
+      }
+    }
+    return ans;
+  }
+
+  Matrix batch_acf(const Matrix &series, int num_lags, bool correlation) {
+    int n = series.ncol();
+    Matrix ans(series.nrow(), num_lags + 1,
+               std::numeric_limits<double>::quiet_NaN());
+    if (n == 0) {
+      return ans;
+    }
+    RealFftPlan plan(padded_fft_size(n, num_lags));
+    ComplexVector frequency_domain;
+    Vector time_domain;
+    for (int i = 0; i < series.nrow(); ++i) {
+      fft_autocovariance(plan, series.row(i), ans.row(i), frequency_domain,
+                         time_domain);
+      if (correlation) {
+        normalize_acf(ans.row(i), n);
       }
     }
     return ans;
@@ -21,12 +21,52 @@
 
 #include "LinAlg/Vector.hpp"
 #include "LinAlg/VectorView.hpp"
+#include "LinAlg/Matrix.hpp"
 
 namespace BOOM {
 
-  // Compute the autocorrelation function of an input sequence.
+  // Compute the autocorrelation function of an input sequence.  The sequence
+  // is not centered, so subtract the mean first if that is desired.  Element
+  // 'lag' of the result is sum_i x[i + lag] * x[i] / n, divided by element 0
+  // if 'correlation' is true.
   Vector acf(const ConstVectorView &x, int num_lags, bool correlation = true);
 
+  // The same quantity as 'acf', computed with a fast Fourier transform.  The
+  // cost is O(n log n) instead of O(n * num_lags), which is a savings when
+  // num_lags is more than a few dozen.
+  Vector fft_acf(const ConstVectorView &x, int num_lags,
+                 bool correlation = true);
+
+  // The cross-covariance (or cross-correlation) function of two series of the
+  // same length, computed with a fast Fourier transform.  Neither series is
+  // centered.
+  //
+  // Args:
+  //   x, y:  The series to be compared.  They must be the same length.
+  //   num_lags:  The largest lag (in absolute value) to compute.
+  //   correlation: If true the result is divided by sqrt(sum(x^2) * sum(y^2))
+  //     / n, which puts it on the correlation scale.
+  //
+  // Returns:
+  //   A vector of length 2 * num_lags + 1.  Element num_lags + k is
+  //   sum_i x[i + k] * y[i] / n for k = -num_lags, ..., num_lags, where the
+  //   sum runs over the indices with both terms inside the series.
+  Vector cross_correlation(const ConstVectorView &x, const ConstVectorView &y,
+                           int num_lags, bool correlation = true);
+
+  // Autocorrelation functions for a collection of series of the same length.
+  // One FFT plan is built and shared by all the series.
+  //
+  // Args:
+  //   series:  Each row is a time series.
+  //   num_lags:  The number of lags to compute for each series.
+  //   correlation:  As in 'acf'.
+  //
+  // Returns:
+  //   A matrix with num_lags + 1 columns.  Row i is fft_acf(series.row(i)).
+  Matrix batch_acf(const Matrix &series, int num_lags,
+                   bool correlation = true);
+
 }  // namespace BOOM
 
 
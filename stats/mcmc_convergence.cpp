@@ -0,0 +1,355 @@
+/*
+  Copyright (C) 2005-2024 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include "stats/mcmc_convergence.hpp"
+#include <algorithm>
+#include <cmath>
+#include "cpputil/math_utils.hpp"
+#include "cpputil/report_error.hpp"
+
+namespace BOOM {
+
+  namespace {
+    // The Gelman-Rubin potential scale reduction factor computed from the
+    // means and variances of two or more chains.
+    double potential_scale_reduction(const std::vector<double> &means,
+                                     const std::vector<double> &variances,
+                                     double average_sample_size) {
+      int m = means.size();
+      double grand_mean = 0;
+      double within = 0;
+      for (int c = 0; c < m; ++c) {
+        grand_mean += means[c];
+        within += variances[c];
+      }
+      grand_mean /= m;
+      within /= m;
+      double between = 0;
+      for (int c = 0; c < m; ++c) {
+        between += square(means[c] - grand_mean);
+      }
+      // 'between' is B / n in the notation of Gelman and Rubin (1992).
+      between /= (m - 1);
+      if (within <= 0) {
+        return between <= 0 ? 1.0 : infinity();
+      }
+      double pooled = (average_sample_size - 1) / average_sample_size * within
+          + between;
+      return std::sqrt(pooled / within);
+    }
+  }  // namespace
+
+  McmcConvergenceMonitor::ChainSummary::ChainSummary(int dim)
+      : sample_size(0),
+        mean(dim, 0.0),
+        sum_of_squares(dim, 0.0),
+        batch_size(1),
+        draws_in_current_batch(0),
+        current_batch_sum(dim, 0.0),
+        current_batch_sum_of_squares(dim, 0.0)
+  {}
+
+  McmcConvergenceMonitor::McmcConvergenceMonitor(
+      int number_of_chains, int dimension, int max_batches)
+      : dimension_(dimension),
+        max_batches_(max_batches),
+        chains_(number_of_chains, ChainSummary(dimension))
+  {
+    if (number_of_chains < 1) {
+      report_error("McmcConvergenceMonitor needs at least one chain.");
+    }
+    if (max_batches < 4 || max_batches % 2 != 0) {
+      report_error("max_batches must be an even number of at least 4.");
+    }
+  }
+
+  void McmcConvergenceMonitor::add(int chain, const ConstVectorView &draw) {
+    if (draw.size() != dimension_) {
+      report_error("Draw has the wrong dimension in "
+                   "McmcConvergenceMonitor::add.");
+    }
+    ChainSummary &summary(chains_[chain]);
+    ++summary.sample_size;
+    for (int i = 0; i < dimension_; ++i) {
+      double delta = draw[i] - summary.mean[i];
+      summary.mean[i] += delta / summary.sample_size;
+      summary.sum_of_squares[i] += delta * (draw[i] - summary.mean[i]);
+    }
+
+    int k = summary.draws_in_current_batch;
+    for (int i = 0; i < dimension_; ++i) {
+      double old_mean = k > 0 ? summary.current_batch_sum[i] / k : 0.0;
+      summary.current_batch_sum[i] += draw[i];
+      double new_mean = summary.current_batch_sum[i] / (k + 1);
+      summary.current_batch_sum_of_squares[i] +=
+          (draw[i] - old_mean) * (draw[i] - new_mean);
+    }
+    if (++summary.draws_in_current_batch == summary.batch_size) {
+      summary.batch_sums.push_back(summary.current_batch_sum);
+      summary.batch_sums_of_squares.push_back(
+          summary.current_batch_sum_of_squares);
+      summary.current_batch_sum = 0.0;
+      summary.current_batch_sum_of_squares = 0.0;
+      summary.draws_in_current_batch = 0;
+      if (summary.batch_sums.size() == max_batches_) {
+        merge_batches(summary);
+      }
+    }
+  }
+
+  // Combine adjacent pairs of batches, doubling the batch size.  The batch
+  // count is even when this is called, so no batch is left over.  The sums of
+  // squares are pooled using the difference between the two batch means.
+  void McmcConvergenceMonitor::merge_batches(ChainSummary &chain) {
+    int half = chain.batch_sums.size() / 2;
+    for (int i = 0; i < half; ++i) {
+      const Vector &first(chain.batch_sums[2 * i]);
+      const Vector &second(chain.batch_sums[2 * i + 1]);
+      Vector sum_of_squares = chain.batch_sums_of_squares[2 * i]
+          + chain.batch_sums_of_squares[2 * i + 1];
+      for (int j = 0; j < dimension_; ++j) {
+        sum_of_squares[j] +=
+            square(first[j] - second[j]) / (2.0 * chain.batch_size);
+      }
+      chain.batch_sums[i] = first + second;
+      chain.batch_sums_of_squares[i] = sum_of_squares;
+    }
+    chain.batch_sums.resize(half);
+    chain.batch_sums_of_squares.resize(half);
+    chain.batch_size *= 2;
+  }
+
+  void McmcConvergenceMonitor::summarize_batches(
+      const ChainSummary &chain, int begin, int end,
+      Vector &mean, Vector &sum_of_squares) const {
+    double n = double(end - begin) * chain.batch_size;
+    mean.resize(dimension_);
+    mean = 0.0;
+    sum_of_squares.resize(dimension_);
+    sum_of_squares = 0.0;
+    for (int b = begin; b < end; ++b) {
+      mean += chain.batch_sums[b];
+      sum_of_squares += chain.batch_sums_of_squares[b];
+    }
+    mean /= n;
+    for (int b = begin; b < end; ++b) {
+      for (int i = 0; i < dimension_; ++i) {
+        sum_of_squares[i] += chain.batch_size
+            * square(chain.batch_sums[b][i] / chain.batch_size - mean[i]);
+      }
+    }
+  }
+
+  void McmcConvergenceMonitor::batch_mean_variance(
+      const ChainSummary &chain, int begin, int end,
+      Vector &mean, Vector &variance) const {
+    int number_of_batches = end - begin;
+    mean.resize(dimension_);
+    mean = 0.0;
+    variance.resize(dimension_);
+    variance = 0.0;
+    for (int b = begin; b < end; ++b) {
+      mean += chain.batch_sums[b];
+    }
+    mean /= double(number_of_batches) * chain.batch_size;
+    for (int b = begin; b < end; ++b) {
+      for (int i = 0; i < dimension_; ++i) {
+        variance[i] +=
+            square(chain.batch_sums[b][i] / chain.batch_size - mean[i]);
+      }
+    }
+    variance /= double(number_of_batches - 1) * number_of_batches;
+  }
+
+  int McmcConvergenceMonitor::min_sample_size() const {
+    int ans = chains_[0].sample_size;
+    for (const auto &chain : chains_) {
+      ans = std::min<int>(ans, chain.sample_size);
+    }
+    return ans;
+  }
+
+  Vector McmcConvergenceMonitor::rhat() const {
+    std::vector<const ChainSummary *> usable;
+    for (const auto &chain : chains_) {
+      if (chain.sample_size >= 2) usable.push_back(&chain);
+    }
+    Vector ans(dimension_, infinity());
+    int m = usable.size();
+    if (m < 2) return ans;
+
+    double average_sample_size = 0;
+    for (const auto *chain : usable) {
+      average_sample_size += chain->sample_size;
+    }
+    average_sample_size /= m;
+
+    std::vector<double> means(m);
+    std::vector<double> variances(m);
+    for (int i = 0; i < dimension_; ++i) {
+      for (int c = 0; c < m; ++c) {
+        means[c] = usable[c]->mean[i];
+        variances[c] = usable[c]->sum_of_squares[i]
+            / (usable[c]->sample_size - 1);
+      }
+      ans[i] = potential_scale_reduction(means, variances,
+                                         average_sample_size);
+    }
+    return ans;
+  }
+
+  Vector McmcConvergenceMonitor::split_rhat() const {
+    // The means and variances of each half chain.
+    std::vector<Vector> means;
+    std::vector<Vector> variances;
+    double average_sample_size = 0;
+    Vector mean, sum_of_squares;
+    for (const auto &chain : chains_) {
+      int half = chain.batch_sums.size() / 2;
+      if (half < 2) continue;
+      double n = double(half) * chain.batch_size;
+      for (int begin = 0; begin <= half; begin += half) {
+        summarize_batches(chain, begin, begin + half, mean, sum_of_squares);
+        means.push_back(mean);
+        variances.push_back(sum_of_squares / (n - 1));
+        average_sample_size += n;
+      }
+    }
+    Vector ans(dimension_, infinity());
+    int m = means.size();
+    if (m < 2) return ans;
+    average_sample_size /= m;
+
+    std::vector<double> element_means(m);
+    std::vector<double> element_variances(m);
+    for (int i = 0; i < dimension_; ++i) {
+      for (int c = 0; c < m; ++c) {
+        element_means[c] = means[c][i];
+        element_variances[c] = variances[c][i];
+      }
+      ans[i] = potential_scale_reduction(element_means, element_variances,
+                                         average_sample_size);
+    }
+    return ans;
+  }
+
+  Vector McmcConvergenceMonitor::geweke(int chain_number) const {
+    const ChainSummary &chain(chains_[chain_number]);
+    int number_of_batches = chain.batch_sums.size();
+    Vector ans(dimension_, infinity());
+    if (number_of_batches < 10) return ans;
+    int first = std::max<int>(2, number_of_batches / 10);
+    int last = number_of_batches / 2;
+    Vector early_mean, early_variance, late_mean, late_variance;
+    batch_mean_variance(chain, 0, first, early_mean, early_variance);
+    batch_mean_variance(chain, number_of_batches - last, number_of_batches,
+                        late_mean, late_variance);
+    for (int i = 0; i < dimension_; ++i) {
+      double difference = early_mean[i] - late_mean[i];
+      double variance = early_variance[i] + late_variance[i];
+      if (variance <= 0) {
+        ans[i] = difference == 0 ? 0.0 : infinity();
+      } else {
+        ans[i] = difference / std::sqrt(variance);
+      }
+    }
+    return ans;
+  }
+
+  Vector McmcConvergenceMonitor::effective_sample_size() const {
+    Vector ans(dimension_, 0.0);
+    for (const auto &chain : chains_) {
+      int number_of_batches = chain.batch_sums.size();
+      if (number_of_batches < 2) continue;
+      int n = chain.sample_size;
+      double used = number_of_batches * chain.batch_size;
+      for (int i = 0; i < dimension_; ++i) {
+        double batch_mean_of_means = 0;
+        for (const auto &batch : chain.batch_sums) {
+          batch_mean_of_means += batch[i];
+        }
+        batch_mean_of_means /= used;
+        double batch_variance = 0;
+        for (const auto &batch : chain.batch_sums) {
+          batch_variance +=
+              square(batch[i] / chain.batch_size - batch_mean_of_means);
+        }
+        batch_variance /= (number_of_batches - 1);
+        double sample_variance = chain.sum_of_squares[i] / (n - 1);
+        // The variance of the chain mean is approximately
+        // batch_size * batch_variance / n.
+        double asymptotic_variance = chain.batch_size * batch_variance;
+        if (asymptotic_variance <= 0) {
+          ans[i] += n;
+        } else {
+          ans[i] += std::min<double>(
+              n, n * sample_variance / asymptotic_variance);
+        }
+      }
+    }
+    return ans;
+  }
+
+  void McmcConvergenceMonitor::clear() {
+    for (auto &chain : chains_) {
+      chain = ChainSummary(dimension_);
+    }
+  }
+
+  //===========================================================================
+  McmcStoppingRule ConvergenceStoppingRule(
+      double min_effective_sample_size,
+      double max_split_rhat,
+      double max_abs_geweke,
+      const std::vector<int> &elements) {
+    return [min_effective_sample_size, max_split_rhat, max_abs_geweke,
+            elements](const McmcConvergenceMonitor &monitor) {
+      std::vector<int> positions = elements;
+      if (positions.empty()) {
+        for (int i = 0; i < monitor.dimension(); ++i) {
+          positions.push_back(i);
+        }
+      }
+      for (int i : positions) {
+        if (i < 0 || i >= monitor.dimension()) {
+          report_error("Stopping rule element is out of range.");
+        }
+      }
+      Vector ess = monitor.effective_sample_size();
+      for (int i : positions) {
+        if (ess[i] < min_effective_sample_size) return false;
+      }
+      if (std::isfinite(max_split_rhat)) {
+        Vector rhat = monitor.split_rhat();
+        for (int i : positions) {
+          if (!(rhat[i] <= max_split_rhat)) return false;
+        }
+      }
+      if (std::isfinite(max_abs_geweke)) {
+        for (int chain = 0; chain < monitor.number_of_chains(); ++chain) {
+          Vector z = monitor.geweke(chain);
+          for (int i : positions) {
+            if (!(std::fabs(z[i]) <= max_abs_geweke)) return false;
+          }
+        }
+      }
+      return true;
+    };
+  }
+
+}  // namespace BOOM
@@ -0,0 +1,160 @@
+#ifndef BOOM_STATS_MCMC_CONVERGENCE_HPP_
+#define BOOM_STATS_MCMC_CONVERGENCE_HPP_
+
+/*
+  Copyright (C) 2005-2024 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include <functional>
+#include <vector>
+#include "LinAlg/Vector.hpp"
+#include "LinAlg/VectorView.hpp"
+#include "cpputil/math_utils.hpp"
+
+namespace BOOM {
+
+  // Convergence diagnostics for a set of parallel MCMC chains, computed from
+  // running summaries so that the draws themselves need not be stored.
+  //
+  // For each chain and each element of the parameter vector the monitor keeps
+  // the running mean and sum of squared deviations (Welford's algorithm),
+  // along with the sum and the sum of squared deviations within each of a set
+  // of batches.  The number of batches is kept between max_batches / 2 and
+  // max_batches by merging adjacent batches (doubling the batch size)
+  // whenever the limit is reached.  Diagnostics that compare different parts
+  // of a chain (split R-hat, Geweke) work from the batches, so they ignore
+  // the draws in the current incomplete batch.
+  //
+  // Calls to add() for different chains touch disjoint storage, so different
+  // chains can be recorded from different threads.  The diagnostics must not
+  // be computed while draws are being added.
+  class McmcConvergenceMonitor {
+   public:
+    // Args:
+    //   number_of_chains:  The number of chains being monitored.
+    //   dimension:  The dimension of each draw.
+    //   max_batches: The maximum number of batch means retained per chain for
+    //     computing the effective sample size.  Must be an even number >= 4.
+    McmcConvergenceMonitor(int number_of_chains, int dimension,
+                           int max_batches = 64);
+
+    // Record a draw from the specified chain.
+    void add(int chain, const ConstVectorView &draw);
+
+    int number_of_chains() const { return chains_.size(); }
+    int dimension() const { return dimension_; }
+
+    // The number of draws recorded for the given chain.
+    int sample_size(int chain) const { return chains_[chain].sample_size; }
+
+    // The smallest sample size across all chains.
+    int min_sample_size() const;
+
+    // The Gelman-Rubin potential scale reduction factor for each element of
+    // the parameter vector.  Values near 1 indicate that the chains have mixed.
+    // Elements are infinite if fewer than two chains have at least two draws.
+    Vector rhat() const;
+
+    // The split R-hat statistic of Gelman et al. (2013) for each element of
+    // the parameter vector.  Each chain is split into two halves, which are
+    // compared as if they were separate chains, so that a chain that is
+    // still drifting is detected even if it is the only chain.  A chain
+    // contributes once it has four complete batches.  Elements are infinite
+    // if no chain qualifies.
+    Vector split_rhat() const;
+
+    // The Geweke (1992) z-scores for each element of the parameter vector in
+    // the given chain, comparing the mean of the first 10% of the chain to
+    // the mean of the last 50%.  The variance of each segment mean is
+    // estimated from the batch means in the segment.  Large absolute values
+    // suggest that the chain has not yet forgotten its starting point.
+    // Elements are infinite until the chain has ten complete batches.
+    Vector geweke(int chain) const;
+
+    // The effective sample size for each element of the parameter vector,
+    // summed across chains.  Each chain's contribution is estimated by the
+    // method of batch means, and is bounded by the number of draws in the
+    // chain.  A chain contributes zero until it has two complete batches.
+    Vector effective_sample_size() const;
+
+    // Discard all recorded draws.
+    void clear();
+
+   private:
+    struct ChainSummary {
+      explicit ChainSummary(int dim);
+      int sample_size;
+      Vector mean;
+      Vector sum_of_squares;
+
+      // Batch means bookkeeping.  The sums of squares are deviations from
+      // the batch mean.
+      int batch_size;
+      int draws_in_current_batch;
+      Vector current_batch_sum;
+      Vector current_batch_sum_of_squares;
+      std::vector<Vector> batch_sums;
+      std::vector<Vector> batch_sums_of_squares;
+    };
+
+    void merge_batches(ChainSummary &chain);
+
+    // Compute the mean and the sum of squared deviations of the draws in
+    // batches [begin, end) of 'chain'.
+    void summarize_batches(const ChainSummary &chain, int begin, int end,
+                           Vector &mean, Vector &sum_of_squares) const;
+
+    // The mean and the variance of the mean of the draws in batches [begin,
+    // end) of 'chain', with the variance estimated from the batch means.
+    void batch_mean_variance(const ChainSummary &chain, int begin, int end,
+                             Vector &mean, Vector &variance) const;
+
+    int dimension_;
+    int max_batches_;
+    std::vector<ChainSummary> chains_;
+  };
+
+  //===========================================================================
+  // A rule for ending an MCMC run early.  The rule is passed the convergence
+  // monitor that has been following the run, and returns true if the run can
+  // stop.
+  typedef std::function<bool(const McmcConvergenceMonitor &)>
+      McmcStoppingRule;
+
+  // A stopping rule that is satisfied once the monitored parameters have
+  // reached a target effective sample size and show no signs of
+  // nonconvergence.
+  //
+  // Args:
+  //   min_effective_sample_size: The effective sample size that each
+  //     monitored element must reach.
+  //   max_split_rhat: The largest acceptable split R-hat for any monitored
+  //     element.  An infinite value disables the check.
+  //   max_abs_geweke: The largest acceptable absolute Geweke z-score for any
+  //     monitored element in any chain.  An infinite value disables the
+  //     check.
+  //   elements: The positions in the monitored vector of the parameters of
+  //     interest.  If empty, all elements are checked.
+  McmcStoppingRule ConvergenceStoppingRule(
+      double min_effective_sample_size,
+      double max_split_rhat = 1.05,
+      double max_abs_geweke = infinity(),
+      const std::vector<int> &elements = std::vector<int>());
+
+}  // namespace BOOM
+
+#endif  // BOOM_STATS_MCMC_CONVERGENCE_HPP_
@@ -0,0 +1,115 @@
+/*
+  Copyright (C) 2005-2023 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include "stats/periodogram.hpp"
+#include "math/fft.hpp"
+#include "cpputil/Constants.hpp"
+#include "cpputil/report_error.hpp"
+#include <cmath>
+#include <sstream>
+
+namespace BOOM {
+  namespace {
+    using ComplexVector = std::vector<std::complex<double>>;
+
+    // Holds the FFT plan, window, and workspace needed to compute Welch
+    // periodograms of series of a given length, so they can be reused across
+    // series.
+    class WelchPeriodogram {
+     public:
+      WelchPeriodogram(int series_length, int segment_length, int overlap)
+          : segment_length_(segment_length),
+            step_(segment_length - overlap),
+            number_of_segments_(0),
+            plan_(segment_length),
+            window_(segment_length),
+            segment_(segment_length) {
+        if (overlap < 0 || overlap >= segment_length) {
+          std::ostringstream err;
+          err << "The overlap between segments must be in [0, "
+              << segment_length << ").  Got " << overlap << ".";
+          report_error(err.str());
+        }
+        if (series_length < segment_length) {
+          std::ostringstream err;
+          err << "A series of length " << series_length
+              << " is shorter than the segment length " << segment_length
+              << ".";
+          report_error(err.str());
+        }
+        number_of_segments_ = 1 + (series_length - segment_length) / step_;
+
+        double sumsq = 0;
+        for (int i = 0; i < segment_length; ++i) {
+          window_[i] = .5 * (1 - cos(2 * Constants::pi * i / segment_length));
+          sumsq += window_[i] * window_[i];
+        }
+        scale_ = 1.0 / (number_of_segments_ * sumsq);
+      }
+
+      // Fill 'ans' with the periodogram of x.
+      void compute(const ConstVectorView &x, VectorView ans) {
+        ans = 0.0;
+        for (int s = 0; s < number_of_segments_; ++s) {
+          ConstVectorView segment(x, s * step_, segment_length_);
+          double mean = segment.sum() / segment_length_;
+          for (int i = 0; i < segment_length_; ++i) {
+            segment_[i] = (segment[i] - mean) * window_[i];
+          }
+          plan_.transform(segment_, frequency_domain_);
+          for (int k = 0; k < ans.size(); ++k) {
+            ans[k] += std::norm(frequency_domain_[k]);
+          }
+        }
+        ans *= scale_;
+      }
+
+      int frequency_size() const {return plan_.frequency_size();}
+
+     private:
+      int segment_length_;
+      int step_;
+      int number_of_segments_;
+      double scale_;
+      RealFftPlan plan_;
+      Vector window_;
+      Vector segment_;
+      ComplexVector frequency_domain_;
+    };
+
+  }  // namespace
+
+  Vector welch_periodogram(const ConstVectorView &x, int segment_length,
+                           int overlap) {
+    WelchPeriodogram periodogram(x.size(), segment_length, overlap);
+    Vector ans(periodogram.frequency_size());
+    periodogram.compute(x, VectorView(ans));
+    return ans;
+  }
+
+  Matrix batch_welch_periodogram(const Matrix &series, int segment_length,
+                                 int overlap) {
+    WelchPeriodogram periodogram(series.ncol(), segment_length, overlap);
+    Matrix ans(series.nrow(), periodogram.frequency_size());
+    for (int i = 0; i < series.nrow(); ++i) {
+      periodogram.compute(series.row(i), ans.row(i));
+    }
+    return ans;
+  }
+
+}  // namespace BOOM
@@ -0,0 +1,63 @@
+#ifndef BOOM_STATS_PERIODOGRAM_HPP_
+#define BOOM_STATS_PERIODOGRAM_HPP_
+
+/*
+  Copyright (C) 2005-2023 Steven L. Scott
+
+  This library is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+
+  This library is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public License along
+  with this library; if not, write to the Free Software Foundation, Inc., 51
+  Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+*/
+
+#include "LinAlg/Vector.hpp"
+#include "LinAlg/VectorView.hpp"
+#include "LinAlg/Matrix.hpp"
+
+namespace BOOM {
+
+  // Welch's estimate of the spectral density of a time series.  The series
+  // is split into overlapping segments.  Each segment is centered, multiplied
+  // by a Hann window, and transformed with a fast Fourier transform.  The
+  // estimate is the average of the squared moduli of the transforms.
+  //
+  // Args:
+  //   x:  The time series.  Its length must be at least segment_length.
+  //   segment_length:  The length of each segment.  Must be even.
+  //   overlap: The number of observations shared by adjacent segments.  Must
+  //     be in [0, segment_length).  Half the segment length is a common
+  //     choice.
+  //
+  // Returns:
+  //   A vector of length segment_length / 2 + 1.  Element k is the estimated
+  //   spectral density at frequency k / segment_length cycles per
+  //   observation.  The scale is such that white noise with variance sigma^2
+  //   has density sigma^2 at every frequency.
+  Vector welch_periodogram(const ConstVectorView &x, int segment_length,
+                           int overlap);
+
+  // Welch periodograms for a collection of series of the same length.  One
+  // FFT plan and one window are built and shared by all the series.
+  //
+  // Args:
+  //   series:  Each row is a time series.
+  //   segment_length, overlap:  As in welch_periodogram.
+  //
+  // Returns:
+  //   A matrix with segment_length / 2 + 1 columns.  Row i is
+  //   welch_periodogram(series.row(i), segment_length, overlap).
+  Matrix batch_welch_periodogram(const Matrix &series, int segment_length,
+                                 int overlap);
+
+}  // namespace BOOM
+
+#endif  // BOOM_STATS_PERIODOGRAM_HPP_
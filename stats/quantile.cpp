@@ -17,39 +17,132 @@
 */
 
 #include "stats/quantile.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "cpputil/math_utils.hpp"
 #include "cpputil/report_error.hpp"
+#include "cpputil/ThreadTools.hpp"
 #include "LinAlg/Vector.hpp"
 #include "LinAlg/Matrix.hpp"
 
 namespace BOOM {
 
+  namespace {
+    // Where a target quantile falls among the order statistics of n data
+    // points.  The rules match sorted_vector_quantile.
+    struct QuantileLocation {
+      QuantileLocation(double target_quantile, int n) {
+        if (target_quantile < 0 || target_quantile > 1) {
+          report_error("Illegal quantile argument");
+        }
+        double real_index = target_quantile * (n - 1);
+        index = lround(floor(real_index));
+        fraction = real_index - index;
+        interpolate = n > 1 && fraction > std::min<double>(0.01, (1.0 / n));
+      }
+      int index;
+      double fraction;
+      bool interpolate;
+    };
+
+    // Compute the requested quantiles of the n values starting at 'data',
+    // which is used as workspace and left partially ordered.  Rather than
+    // sorting, the order statistics needed by the targets are placed with
+    // nth_element, each call working on the part of the data above the
+    // previous one.
+    void select_quantiles(double *data, int n, const ConstVectorView &targets,
+                          double *ans, int ans_stride) {
+      if (n == 0) {
+        for (int i = 0; i < targets.size(); ++i) {
+          ans[i * ans_stride] = negative_infinity();
+        }
+        return;
+      }
+      std::vector<QuantileLocation> locations;
+      locations.reserve(targets.size());
+      std::vector<int> ranks;
+      for (int i = 0; i < targets.size(); ++i) {
+        locations.emplace_back(targets[i], n);
+        ranks.push_back(locations.back().index);
+        if (locations.back().interpolate) {
+          ranks.push_back(locations.back().index + 1);
+        }
+      }
+      std::sort(ranks.begin(), ranks.end());
+      ranks.erase(std::unique(ranks.begin(), ranks.end()), ranks.end());
+
+      int lo = 0;
+      for (int rank : ranks) {
+        std::nth_element(data + lo, data + rank, data + n);
+        lo = rank + 1;
+      }
+
+      for (int i = 0; i < locations.size(); ++i) {
+        const QuantileLocation &loc(locations[i]);
+        ans[i * ans_stride] = loc.interpolate
+            ? (1 - loc.fraction) * data[loc.index]
+              + loc.fraction * data[loc.index + 1]
+            : data[loc.index];
+      }
+    }
+
+    // Fill column j of 'ans' with the target quantiles of column j of 'data'.
+    void column_quantiles(const Matrix &data, const Vector &target_quantiles,
+                          Matrix &ans, ThreadWorkerPool *pool) {
+      const int nrow = data.nrow();
+      const int ncol = data.ncol();
+      auto process_column = [&](int j, std::vector<double> &workspace) {
+        const double *column = data.data() + static_cast<size_t>(j) * nrow;
+        workspace.assign(column, column + nrow);
+        select_quantiles(workspace.data(), nrow, target_quantiles,
+                         ans.data() + static_cast<size_t>(j) * ans.nrow(), 1);
+      };
+      if (pool) {
+        // Group small columns so each task has a meaningful amount of work.
+        int grain = std::max<int>(1, 16384 / std::max<int>(nrow, 1));
+        pool->parallel_for(0, ncol, grain, [&](int j) {
+          thread_local std::vector<double> workspace;
+          process_column(j, workspace);
+        });
+      } else {
+        std::vector<double> workspace;
+        for (int j = 0; j < ncol; ++j) {
+          process_column(j, workspace);
+        }
+      }
+    }
+  }  // namespace
+
   double quantile(const ConstVectorView &data, double target_quantile) {
-    Vector sorted = sort(data);
-    return sorted_vector_quantile(sorted, target_quantile);
+    Vector workspace(data);
+    double ans;
+    select_quantiles(workspace.data(), workspace.size(),
+                     ConstVectorView(&target_quantile, 1, 1), &ans, 1);
+    return ans;
   }
 
   Vector quantile(const ConstVectorView &data, const Vector &target_quantiles) {
-    Vector sorted = sort(data);
+    Vector workspace(data);
     Vector ans(target_quantiles.size());
-    for (int i = 0; i < target_quantiles.size(); ++i) {
-      ans[i] = sorted_vector_quantile(sorted, target_quantiles[i]);
-    }
+    select_quantiles(workspace.data(), workspace.size(), target_quantiles,
+                     ans.data(), 1);
     return ans;
   }
 
-  Vector quantile(const Matrix &draws, double target_quantile) {
-    Vector ans(draws.ncol());
-    for (int i = 0; i < draws.ncol(); ++i) {
-      ans[i] = quantile(draws.col(i), target_quantile);
-    }
-    return ans;
+  Vector quantile(const Matrix &draws, double target_quantile,
+                  ThreadWorkerPool *pool) {
+    Matrix ans(1, draws.ncol());
+    column_quantiles(draws, Vector(1, target_quantile), ans, pool);
+    return ans.row(0);
   }
 
-  Matrix quantile(const Matrix &data, const Vector &target_quantiles) {
+  Matrix quantile(const Matrix &data, const Vector &target_quantiles,
+                  ThreadWorkerPool *pool) {
     Matrix ans(target_quantiles.size(), data.ncol());
-    for (int i = 0; i < data.ncol(); ++i){
-      ans.col(i) = quantile(data.col(i), target_quantiles);
-    }
+    column_quantiles(data, target_quantiles, ans, pool);
     return ans;
   }
 }
@@ -22,6 +22,8 @@
 
 namespace BOOM {
 
+  class ThreadWorkerPool;
+
   // Return a specific quantile of the input data.
   //
   // Args:
@@ -40,24 +42,31 @@ namespace BOOM {
   Vector quantile(const ConstVectorView &data,
                   const Vector &target_quantiles);
 
-  // Return a specific quantile on each column of data.
+  // Return a specific quantile on each column of data.  This is the usual
+  // way of summarizing a Matrix of MCMC draws, with one column per parameter.
   //
   // Args:
   //   data:  The data to be analyzed.
   //   target_quantile:  The quantile of the data to be returned.
+  //   pool: If non-NULL, columns are processed in parallel by the threads in
+  //     the pool.  The pool is not owned.
   Vector quantile(const Matrix &data,
-                  double target_quantile);
+                  double target_quantile,
+                  ThreadWorkerPool *pool = nullptr);
 
   // Return a collection of quantiles on each column of data.
   //
   // Args:
   //   data:  The data to be analyzed.
   //   target_quantile:  The collection of target quantiles to be returned.
+  //   pool: If non-NULL, columns are processed in parallel by the threads in
+  //     the pool.  The pool is not owned.
   //
   // Returns: A Matrix with columns matching 'data' and rows corresponding to
   //   the target quantiles.
   Matrix quantile(const Matrix &data,
-                  const Vector &target_quantiles);
+                  const Vector &target_quantiles,
+                  ThreadWorkerPool *pool = nullptr);
 
   inline double median(const ConstVectorView &data) {
     return quantile(data, .5);
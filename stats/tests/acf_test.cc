@@ -0,0 +1,107 @@
+#include "gtest/gtest.h"
+#include "stats/acf.hpp"
+
+#include "LinAlg/Vector.hpp"
+#include "LinAlg/Matrix.hpp"
+#include "distributions.hpp"
+
+#include "test_utils/test_utils.hpp"
+
+namespace {
+  using namespace BOOM;
+  using std::endl;
+
+  class AcfTest : public ::testing::Test {
+   protected:
+    AcfTest() {
+      GlobalRng::rng.seed(8675309);
+    }
+  };
+
+  // Simulate a stationary AR(1) series.
+  Vector ar1(int n, double phi) {
+    Vector ans(n);
+    ans[0] = rnorm(0, 1.0 / sqrt(1 - phi * phi));
+    for (int i = 1; i < n; ++i) {
+      ans[i] = phi * ans[i - 1] + rnorm();
+    }
+    return ans;
+  }
+
+  TEST_F(AcfTest, FftMatchesDirectSum) {
+    for (int n : {1, 2, 7, 50, 317}) {
+      Vector x = ar1(n, .7);
+      for (bool correlation : {true, false}) {
+        Vector direct = acf(x, 20, correlation);
+        Vector fast = fft_acf(x, 20, correlation);
+        ASSERT_EQ(direct.size(), fast.size());
+        for (int lag = 0; lag < direct.size(); ++lag) {
+          if (lag < n) {
+            EXPECT_NEAR(direct[lag], fast[lag], 1e-10)
+                << "n = " << n << " lag = " << lag;
+          } else {
+            EXPECT_TRUE(std::isnan(fast[lag]));
+          }
+        }
+      }
+    }
+
+    // The autocorrelation of a long AR(1) series decays geometrically.
+    Vector x = ar1(20000, .7);
+    Vector rho = fft_acf(x, 3);
+    EXPECT_DOUBLE_EQ(1.0, rho[0]);
+    EXPECT_NEAR(.7, rho[1], .03);
+    EXPECT_NEAR(.49, rho[2], .03);
+  }
+
+  TEST_F(AcfTest, CrossCorrelation) {
+    int n = 200;
+    int num_lags = 5;
+    Vector x = ar1(n, .5);
+    Vector y = ar1(n, -.3);
+    Vector ccf = cross_correlation(x, y, num_lags, false);
+    ASSERT_EQ(2 * num_lags + 1, ccf.size());
+    for (int lag = -num_lags; lag <= num_lags; ++lag) {
+      double sum = 0;
+      for (int i = 0; i < n; ++i) {
+        if (i + lag >= 0 && i + lag < n) {
+          sum += x[i + lag] * y[i];
+        }
+      }
+      EXPECT_NEAR(sum / n, ccf[num_lags + lag], 1e-10) << "lag = " << lag;
+    }
+
+    // The cross correlation of a series with itself is symmetric, and
+    // matches the autocorrelation function.
+    Vector self = cross_correlation(x, x, num_lags, true);
+    Vector rho = acf(x, num_lags, true);
+    for (int lag = 0; lag <= num_lags; ++lag) {
+      EXPECT_NEAR(rho[lag], self[num_lags + lag], 1e-10);
+      EXPECT_NEAR(rho[lag], self[num_lags - lag], 1e-10);
+    }
+
+    // A lagged copy of a series is perfectly correlated at the lag.
+    Vector shifted(n, 0.0);
+    for (int i = 2; i < n; ++i) {
+      shifted[i] = x[i - 2];
+    }
+    Vector lagged = cross_correlation(shifted, x, num_lags, true);
+    EXPECT_NEAR(1.0, lagged[num_lags + 2], .05);
+  }
+
+  TEST_F(AcfTest, BatchMatchesSingleSeries) {
+    int nseries = 6;
+    int n = 90;
+    Matrix series(nseries, n);
+    for (int i = 0; i < nseries; ++i) {
+      series.row(i) = ar1(n, .1 * i);
+    }
+    Matrix batch = batch_acf(series, 12);
+    ASSERT_EQ(nseries, batch.nrow());
+    ASSERT_EQ(13, batch.ncol());
+    for (int i = 0; i < nseries; ++i) {
+      EXPECT_TRUE(VectorEquals(batch.row(i), acf(series.row(i), 12), 1e-10));
+    }
+  }
+
+}  // namespace
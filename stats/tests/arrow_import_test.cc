@@ -0,0 +1,248 @@
+#include "gtest/gtest.h"
+#include "stats/ArrowImport.hpp"
+#include "Models/Glm/RegressionModel.hpp"
+#include "distributions.hpp"
+#include "test_utils/test_utils.hpp"
+
+#include <cmath>
+#include <cstring>
+#include <memory>
+
+namespace {
+  using namespace BOOM;
+  using std::endl;
+
+  // Plays the role of an Arrow producer, owning the memory behind an
+  // exported record batch with five columns:
+  //   x:      float64, no nulls.
+  //   count:  int32, with a null in position 1.
+  //   flag:   boolean.
+  //   color:  utf8 strings.
+  //   shape:  int8 indices into a dictionary of utf8 strings.
+  class TestBatch {
+   public:
+    explicit TestBatch(int offset = 0) : release_count_(0) {
+      x_ = {1.5, 2.5, -3.0, 4.0};
+      count_ = {7, 0, 9, 12};
+      count_validity_ = {0x0D};  // Bits 0, 2, 3.
+      flag_ = {0x05};            // true, false, true, false.
+      color_offsets_ = {0, 3, 7, 10, 14};
+      color_data_ = "redbluereddark";
+      shape_indices_ = {1, 0, 1, 1};
+      dictionary_offsets_ = {0, 6, 12};
+      dictionary_data_ = "circlesquare";
+
+      names_ = {"x", "count", "flag", "color", "shape"};
+      formats_ = {"g", "i", "b", "u", "c"};
+      buffers_ = {
+          {nullptr, x_.data()},
+          {count_validity_.data(), count_.data()},
+          {nullptr, flag_.data()},
+          {nullptr, color_offsets_.data(), color_data_.data()},
+          {nullptr, shape_indices_.data()}};
+      for (int j = 0; j < 5; ++j) {
+        child_schemas_[j] = leaf_schema(formats_[j], names_[j].c_str());
+        child_arrays_[j] = leaf_array(4, buffers_[j]);
+        child_schema_pointers_[j] = &child_schemas_[j];
+        child_array_pointers_[j] = &child_arrays_[j];
+      }
+      child_arrays_[1].null_count = 1;
+      dictionary_buffers_ = {nullptr, dictionary_offsets_.data(),
+                             dictionary_data_.data()};
+      dictionary_schema_ = leaf_schema("u", "");
+      dictionary_array_ = leaf_array(2, dictionary_buffers_);
+      child_schemas_[4].dictionary = &dictionary_schema_;
+      child_arrays_[4].dictionary = &dictionary_array_;
+
+      schema_ = leaf_schema("+s", "");
+      schema_.n_children = 5;
+      schema_.children = child_schema_pointers_;
+      schema_.release = &release_schema;
+      schema_.private_data = this;
+
+      std::memset(&array_, 0, sizeof(array_));
+      array_.length = 4 - offset;
+      array_.offset = offset;
+      array_.n_buffers = 1;
+      array_.buffers = top_buffers_;
+      array_.n_children = 5;
+      array_.children = child_array_pointers_;
+      array_.release = &release_array;
+      array_.private_data = this;
+    }
+
+    ArrowSchema *schema() { return &schema_; }
+    ArrowArray *array() { return &array_; }
+    int release_count() const { return release_count_; }
+
+   private:
+    static ArrowSchema leaf_schema(const char *format, const char *name) {
+      ArrowSchema schema;
+      std::memset(&schema, 0, sizeof(schema));
+      schema.format = format;
+      schema.name = name;
+      // Children are released along with their parent.
+      schema.release = &release_child_schema;
+      return schema;
+    }
+
+    static ArrowArray leaf_array(int64_t length,
+                                 std::vector<const void *> &buffers) {
+      ArrowArray array;
+      std::memset(&array, 0, sizeof(array));
+      array.length = length;
+      array.n_buffers = buffers.size();
+      array.buffers = buffers.data();
+      array.release = &release_child_array;
+      return array;
+    }
+
+    static void release_child_schema(ArrowSchema *schema) {
+      schema->release = nullptr;
+    }
+    static void release_child_array(ArrowArray *array) {
+      array->release = nullptr;
+    }
+    static void release_schema(ArrowSchema *schema) {
+      ++static_cast<TestBatch *>(schema->private_data)->release_count_;
+      schema->release = nullptr;
+    }
+    static void release_array(ArrowArray *array) {
+      ++static_cast<TestBatch *>(array->private_data)->release_count_;
+      array->release = nullptr;
+    }
+
+    std::vector<double> x_;
+    std::vector<int32_t> count_;
+    std::vector<uint8_t> count_validity_;
+    std::vector<uint8_t> flag_;
+    std::vector<int32_t> color_offsets_;
+    std::string color_data_;
+    std::vector<int8_t> shape_indices_;
+    std::vector<int32_t> dictionary_offsets_;
+    std::string dictionary_data_;
+
+    std::vector<std::string> names_;
+    std::vector<const char *> formats_;
+    std::vector<std::vector<const void *>> buffers_;
+    std::vector<const void *> dictionary_buffers_;
+    const void *top_buffers_[1] = {nullptr};
+
+    ArrowSchema child_schemas_[5];
+    ArrowArray child_arrays_[5];
+    ArrowSchema *child_schema_pointers_[5];
+    ArrowArray *child_array_pointers_[5];
+    ArrowSchema dictionary_schema_;
+    ArrowArray dictionary_array_;
+    ArrowSchema schema_;
+    ArrowArray array_;
+
+    int release_count_;
+  };
+
+  class ArrowImportTest : public ::testing::Test {
+   protected:
+    ArrowImportTest() {
+      GlobalRng::rng.seed(8675309);
+    }
+  };
+
+  TEST_F(ArrowImportTest, Columns) {
+    TestBatch producer;
+    {
+      ArrowRecordBatch batch(producer.schema(), producer.array());
+      EXPECT_EQ(nullptr, producer.schema()->release);
+      EXPECT_EQ(4, batch.nrow());
+      EXPECT_EQ(5, batch.ncol());
+      EXPECT_EQ("color", batch.column_name(3));
+      EXPECT_EQ(2, batch.column_index("flag"));
+      EXPECT_THROW(batch.column_index("nope"), std::exception);
+
+      EXPECT_TRUE(batch.is_numeric(0));
+      EXPECT_TRUE(batch.is_numeric(2));
+      EXPECT_TRUE(batch.is_categorical(3));
+      EXPECT_TRUE(batch.is_categorical(4));
+      EXPECT_FALSE(batch.is_numeric(4));
+
+      // Doubles without nulls are viewed in place.
+      EXPECT_TRUE(batch.has_contiguous_doubles(0));
+      EXPECT_FALSE(batch.has_contiguous_doubles(1));
+      ConstVectorView x = batch.numeric_view(0);
+      EXPECT_DOUBLE_EQ(-3.0, x[2]);
+      EXPECT_THROW(batch.numeric_view(1), std::exception);
+
+      Vector count = batch.numeric_column(1);
+      EXPECT_DOUBLE_EQ(7.0, count[0]);
+      EXPECT_TRUE(std::isnan(count[1]));
+      EXPECT_DOUBLE_EQ(12.0, count[3]);
+      EXPECT_TRUE(VectorEquals(Vector{1, 0, 1, 0}, batch.numeric_column(2)));
+      EXPECT_THROW(batch.numeric_column(3), std::exception);
+
+      // String levels are sorted.
+      CategoricalColumn color = batch.categorical_column(3);
+      EXPECT_EQ(std::vector<std::string>({"blue", "dark", "red"}),
+                color.labels());
+      EXPECT_EQ(std::vector<int32_t>({2, 0, 2, 1}), color.codes());
+
+      // Dictionary levels keep their order.
+      CategoricalColumn shape = batch.categorical_column(4);
+      EXPECT_EQ(std::vector<std::string>({"circle", "square"}),
+                shape.labels());
+      EXPECT_EQ(std::vector<int32_t>({1, 0, 1, 1}), shape.codes());
+
+      Matrix X = arrow_to_matrix(batch, {"flag", "x"});
+      EXPECT_EQ(4, X.nrow());
+      EXPECT_DOUBLE_EQ(1.5, X(0, 1));
+      EXPECT_DOUBLE_EQ(1.0, X(2, 0));
+      EXPECT_EQ(0, producer.release_count());
+    }
+    EXPECT_EQ(2, producer.release_count());
+  }
+
+  TEST_F(ArrowImportTest, Offset) {
+    TestBatch producer(1);
+    ArrowRecordBatch batch(producer.schema(), producer.array());
+    EXPECT_EQ(3, batch.nrow());
+    EXPECT_TRUE(VectorEquals(Vector{2.5, -3.0, 4.0}, batch.numeric_view(0)));
+    EXPECT_TRUE(std::isnan(batch.numeric_column(1)[0]));
+    EXPECT_EQ(std::vector<int32_t>({0, 1, 1}),
+              batch.categorical_column(4).codes());
+  }
+
+  TEST_F(ArrowImportTest, DataTable) {
+    TestBatch producer1, producer2(2);
+    std::vector<ArrowRecordBatch> batches;
+    batches.emplace_back(producer1.schema(), producer1.array());
+    batches.emplace_back(producer2.schema(), producer2.array());
+    DataTable table = arrow_to_data_table(batches);
+    EXPECT_EQ(6, table.nrow());
+    EXPECT_EQ(5, table.nvars());
+    EXPECT_EQ("shape", table.vnames()[4]);
+    EXPECT_EQ(VariableType::numeric, table.variable_type(1));
+    EXPECT_EQ(VariableType::categorical, table.variable_type(3));
+    EXPECT_DOUBLE_EQ(4.0, table.getvar(0)[5]);
+
+    // The second batch only has "red" and "dark", so the levels are merged.
+    const CategoricalColumn &color(table.categorical_column(3));
+    EXPECT_EQ(3, color.nlevels());
+    EXPECT_EQ("dark", color.label(5));
+    EXPECT_EQ("red", color.label(4));
+  }
+
+  TEST_F(ArrowImportTest, StreamToBigRegression) {
+    TestBatch producer;
+    ArrowRecordBatch batch(producer.schema(), producer.array());
+    BigRegressionModel model(2, 500, false);
+    int nblocks = 0;
+    stream_arrow_batch(batch, "x", {"flag", "flag"}, 3,
+                       [&](const Matrix &X, const Vector &y) {
+                         EXPECT_EQ(2, X.ncol());
+                         EXPECT_EQ(y.size(), X.nrow());
+                         model.stream_data_for_initial_screen(X, y);
+                         ++nblocks;
+                       });
+    EXPECT_EQ(2, nblocks);
+    EXPECT_DOUBLE_EQ(4, model.subordinate_model(0)->suf()->n());
+  }
+
+}  // namespace
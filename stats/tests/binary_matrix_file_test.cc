@@ -0,0 +1,123 @@
+#include "gtest/gtest.h"
+#include <cstdio>
+#include <fstream>
+#include "LinAlg/Matrix.hpp"
+#include "stats/BinaryMatrixFile.hpp"
+#include "stats/DataTable.hpp"
+#include "distributions.hpp"
+#include "test_utils/test_utils.hpp"
+
+namespace {
+  using namespace BOOM;
+  using std::endl;
+
+  class BinaryMatrixFileTest : public ::testing::Test {
+   protected:
+    BinaryMatrixFileTest()
+        : filename_(::testing::TempDir() + "binary_matrix_file_test.bin") {
+      GlobalRng::rng.seed(8675309);
+    }
+    ~BinaryMatrixFileTest() override { std::remove(filename_.c_str()); }
+
+    std::string filename_;
+  };
+
+  TEST_F(BinaryMatrixFileTest, RoundTrip) {
+    Matrix X(7, 4);
+    X.randomize();
+    write_binary_matrix(filename_, ConstSubMatrix(X));
+
+    MappedMatrix mapped(filename_);
+    EXPECT_EQ(7, mapped.nrow());
+    EXPECT_EQ(4, mapped.ncol());
+    EXPECT_TRUE(MatrixEquals(X, mapped.to_matrix()));
+    EXPECT_TRUE(VectorEquals(X.col(2), mapped.col(2)));
+    EXPECT_TRUE(MatrixEquals(ConstSubMatrix(X, 0, 6, 1, 2).to_matrix(),
+                             mapped.columns(1, 3).to_matrix()));
+    EXPECT_TRUE(MatrixEquals(ConstSubMatrix(X, 2, 4, 0, 3).to_matrix(),
+                             mapped.rows(2, 5).to_matrix()));
+
+    MappedMatrix moved(std::move(mapped));
+    EXPECT_TRUE(VectorEquals(X.row(6), moved.view().row(6)));
+  }
+
+  TEST_F(BinaryMatrixFileTest, SinglePrecision) {
+    Matrix X(9, 3);
+    X.randomize();
+    write_binary_matrix(filename_, ConstSubMatrix(X), true);
+
+    MappedMatrix mapped(filename_);
+    EXPECT_TRUE(mapped.single_precision());
+    EXPECT_EQ(9, mapped.nrow());
+    EXPECT_EQ(3, mapped.ncol());
+    Matrix rounded = FloatMatrix(X).to_matrix();
+    EXPECT_TRUE(MatrixEquals(rounded, mapped.to_matrix(), 1e-12));
+    EXPECT_TRUE(MatrixEquals(rounded, mapped.float_view().to_matrix(),
+                             1e-12));
+    EXPECT_TRUE(VectorEquals(rounded.col(1), mapped.column(1), 1e-12));
+    EXPECT_TRUE(MatrixEquals(X, mapped.to_matrix(), 1e-6));
+    EXPECT_THROW(mapped.view(), std::exception);
+    EXPECT_THROW(mapped.col(0), std::exception);
+
+    DataTable restored;
+    restored.read_binary(filename_);
+    EXPECT_TRUE(VectorEquals(rounded.col(2), restored.getvar(2), 1e-12));
+  }
+
+  TEST_F(BinaryMatrixFileTest, ColumnWriter) {
+    Vector first = {1, 2, 3};
+    Vector second = {4, 5, 6};
+    {
+      BinaryMatrixWriter writer(filename_, 3);
+      writer.add_column(ConstVectorView(first));
+      writer.add_column(ConstVectorView(second));
+      EXPECT_THROW(writer.add_column(ConstVectorView(Vector(2))),
+                   std::exception);
+      // The destructor closes the file.
+    }
+    MappedMatrix mapped(filename_);
+    EXPECT_EQ(2, mapped.ncol());
+    EXPECT_TRUE(VectorEquals(second, mapped.col(1)));
+  }
+
+  TEST_F(BinaryMatrixFileTest, DataTable) {
+    DataTable table;
+    Vector x = {1.5, 2.5, 3.5, 4.5};
+    Vector y = {-1, 0, 1, 2};
+    table.append_variable(x, "x");
+    table.append_variable(y, "y");
+    table.write_binary(filename_);
+
+    DataTable restored;
+    restored.read_binary(filename_);
+    EXPECT_EQ(2, restored.nvars());
+    EXPECT_EQ(4, restored.nobs());
+    EXPECT_TRUE(VectorEquals(x, restored.getvar(0)));
+    EXPECT_TRUE(VectorEquals(y, restored.getvar(1)));
+  }
+
+  TEST_F(BinaryMatrixFileTest, BadFiles) {
+    EXPECT_THROW(MappedMatrix(filename_ + ".does_not_exist"), std::exception);
+    {
+      std::ofstream out(filename_);
+      out << "This is not a binary matrix file, but it is long enough to "
+          << "hold a header." << endl;
+    }
+    EXPECT_THROW(MappedMatrix bad(filename_), std::exception);
+
+    Matrix X(10, 3);
+    X.randomize();
+    write_binary_matrix(filename_, ConstSubMatrix(X));
+    {
+      // Truncate the file.
+      std::ifstream in(filename_, std::ios::binary);
+      std::string contents((std::istreambuf_iterator<char>(in)),
+                           std::istreambuf_iterator<char>());
+      in.close();
+      std::ofstream out(filename_, std::ios::binary | std::ios::trunc);
+      out.write(contents.data(), contents.size() - 8);
+    }
+    EXPECT_THROW(MappedMatrix truncated(filename_), std::exception);
+  }
+
+}  // namespace
@@ -0,0 +1,114 @@
+#include "gtest/gtest.h"
+#include "stats/Bootstrap.hpp"
+
+#include "LinAlg/Matrix.hpp"
+#include "LinAlg/Vector.hpp"
+#include "Models/Glm/RegressionModel.hpp"
+#include "cpputil/ThreadTools.hpp"
+#include "distributions.hpp"
+
+#include "test_utils/test_utils.hpp"
+
+namespace {
+  using namespace BOOM;
+  using std::endl;
+
+  class BootstrapTest : public ::testing::Test {
+   protected:
+    BootstrapTest() {
+      GlobalRng::rng.seed(8675309);
+    }
+  };
+
+  // Counts from the classical bootstrap should sum to the sample size, and
+  // average to 1 per observation.
+  TEST_F(BootstrapTest, Counts) {
+    int n = 20;
+    BootstrapResampler bootstrap(n);
+    EXPECT_EQ(n, bootstrap.sample_size());
+    EXPECT_EQ(n, bootstrap.replicate_size());
+
+    RNG::RngIntType seed = seed_rng(GlobalRng::rng);
+    Vector total(n, 0.0);
+    int nrep = 5000;
+    for (int r = 0; r < nrep; ++r) {
+      Vector counts = bootstrap.counts(seed, r);
+      ASSERT_EQ(n, counts.size());
+      EXPECT_DOUBLE_EQ(n, counts.sum());
+      total += counts;
+    }
+    EXPECT_TRUE(VectorEquals(total / nrep, Vector(n, 1.0), .1))
+        << total / nrep;
+
+    // The same seed and replicate number give the same counts.
+    EXPECT_TRUE(VectorEquals(bootstrap.counts(seed, 17),
+                             bootstrap.counts(seed, 17), 1e-12));
+
+    // Zero weights are never drawn.
+    Vector probs = {1, 0, 2, 0};
+    BootstrapResampler weighted(probs, 100);
+    EXPECT_EQ(100, weighted.replicate_size());
+    for (int r = 0; r < 50; ++r) {
+      Vector counts = weighted.counts(seed, r);
+      EXPECT_DOUBLE_EQ(0.0, counts[1]);
+      EXPECT_DOUBLE_EQ(0.0, counts[3]);
+      EXPECT_DOUBLE_EQ(100.0, counts.sum());
+    }
+  }
+
+  // Statistics computed from the counts should match statistics computed on
+  // explicitly resampled copies of the data, and the replicates should not
+  // depend on whether a thread pool is used.
+  TEST_F(BootstrapTest, WeightedStatisticsMatchResampledData) {
+    int n = 50;
+    int xdim = 3;
+    Matrix X(n, xdim);
+    X.randomize();
+    X.col(0) = 1.0;
+    Vector beta = {1.0, -2.0, 3.0};
+    Vector y = X * beta;
+    for (int i = 0; i < n; ++i) {
+      y[i] += rnorm();
+    }
+
+    BootstrapResampler bootstrap(n);
+    int nrep = 40;
+    RNG rng(1234);
+    Matrix means = bootstrap.column_means(X, nrep, rng);
+    RNG rng2(1234);
+    Matrix coefficients = bootstrap.regression_coefficients(X, y, nrep, rng2);
+    ASSERT_EQ(nrep, means.nrow());
+    ASSERT_EQ(xdim, means.ncol());
+    ASSERT_EQ(nrep, coefficients.nrow());
+    ASSERT_EQ(xdim, coefficients.ncol());
+
+    RNG rng3(1234);
+    RNG::RngIntType seed = seed_rng(rng3);
+    for (int r = 0; r < nrep; ++r) {
+      Vector counts = bootstrap.counts(seed, r);
+      int replicate_size = lround(counts.sum());
+      Matrix resampled_X(replicate_size, xdim);
+      Vector resampled_y(replicate_size);
+      int row = 0;
+      for (int i = 0; i < n; ++i) {
+        for (int k = 0; k < lround(counts[i]); ++k) {
+          resampled_X.row(row) = X.row(i);
+          resampled_y[row] = y[i];
+          ++row;
+        }
+      }
+      EXPECT_TRUE(VectorEquals(means.row(r),
+                               resampled_X.col_sums() / replicate_size,
+                               1e-10));
+      NeRegSuf suf(resampled_X, resampled_y);
+      EXPECT_TRUE(VectorEquals(coefficients.row(r), suf.beta_hat(), 1e-8));
+    }
+
+    ThreadWorkerPool pool(4);
+    bootstrap.set_thread_pool(&pool);
+    RNG rng4(1234);
+    Matrix parallel_means = bootstrap.column_means(X, nrep, rng4);
+    EXPECT_TRUE(MatrixEquals(means, parallel_means, 1e-12));
+  }
+
+}  // namespace
@@ -6,6 +6,10 @@
 #include "stats/ChiSquareTest.hpp"
 #include "stats/FreqDist.hpp"
 #include "stats/DataTable.hpp"
+#include "distributions.hpp"
+
+#include <cstdio>
+#include <fstream>
 
 namespace {
   using namespace BOOM;
@@ -58,4 +62,126 @@ namespace {
     EXPECT_EQ(cars.vnames()[1], "MPGCity");
     EXPECT_EQ(cars.vnames()[21], "GP1000MCity");
   }
+
+  TEST_F(MixedMultivariateDataTest, CategoricalColumns) {
+    CategoricalColumn colors(std::vector<std::string>{
+        "red", "blue", "red", "green"});
+    EXPECT_EQ(4, colors.size());
+    EXPECT_EQ(3, colors.nlevels());
+    // Levels are sorted.
+    EXPECT_EQ(std::vector<std::int32_t>({2, 0, 2, 1}), colors.codes());
+    EXPECT_EQ("green", colors.label(3));
+
+    Ptr<CatKey> old_key = colors.key();
+    colors.set_order({"red", "green", "blue"});
+    EXPECT_EQ(std::vector<std::int32_t>({0, 2, 0, 1}), colors.codes());
+    EXPECT_EQ("green", colors.label(3));
+    EXPECT_EQ("blue", old_key->label(0));
+
+    DataTable table;
+    table.append_variable(Vector{1.0, 2.0, 3.0, 4.0}, "x");
+    table.append_variable(colors, "color");
+    table.append_variable(
+        CategoricalColumn(std::vector<std::int32_t>{3, 0, 1, 1}, shape_key_),
+        "shape");
+    EXPECT_EQ(2, table.categorical_dim());
+    EXPECT_EQ(4u, table.nlevels(2));
+    EXPECT_EQ(colors.codes(), table.categorical_column(1).codes());
+    EXPECT_THROW(table.categorical_column(0), std::exception);
+
+    // The expanded form agrees with the codes.
+    CategoricalVariable shapes = table.get_nominal(2);
+    EXPECT_EQ(4, shapes.size());
+    EXPECT_EQ("rhombus", shapes.label(0));
+    EXPECT_EQ(1, table.get_nominal(3, 2)->value());
+
+    table.set_nominal_value(0, 2, 2);
+    EXPECT_EQ(2, table.categorical_column(2)[0]);
+    EXPECT_EQ("triangle", table.row(0)->categorical(2).label());
+
+    DataTable doubled(table);
+    doubled.rbind(table);
+    EXPECT_EQ(8, doubled.nrow());
+    EXPECT_EQ(1, doubled.categorical_column(2)[7]);
+
+    LabeledMatrix design = table.design();
+    EXPECT_EQ(1 + 2 + 3, design.ncol());
+    EXPECT_DOUBLE_EQ(1.0, design(3, 1));
+
+    EXPECT_THROW(CategoricalColumn(std::vector<std::int32_t>{4}, shape_key_),
+                 std::exception);
+  }
+
+  // Checks that two tables have the same variables and values.
+  void ExpectSameTable(const DataTable &expected, const DataTable &actual) {
+    ASSERT_EQ(expected.nvars(), actual.nvars());
+    ASSERT_EQ(expected.nobs(), actual.nobs());
+    EXPECT_EQ(expected.vnames(), actual.vnames());
+    for (int i = 0; i < expected.nvars(); ++i) {
+      ASSERT_EQ(expected.variable_type(i), actual.variable_type(i));
+      if (expected.variable_type(i) == VariableType::numeric) {
+        EXPECT_TRUE(VectorEquals(expected.getvar(i), actual.getvar(i)));
+      } else {
+        EXPECT_EQ(expected.categorical_column(i).labels(),
+                  actual.categorical_column(i).labels());
+        EXPECT_EQ(expected.categorical_column(i).codes(),
+                  actual.categorical_column(i).codes());
+      }
+    }
+  }
+
+  TEST_F(MixedMultivariateDataTest, ParallelReadMatchesSerial) {
+    for (int nthreads : {0, 3}) {
+      DataTable autopref("stats/tests/autopref.txt", false, "\t");
+      DataTable parallel_autopref;
+      parallel_autopref.read_file_parallel(
+          "stats/tests/autopref.txt", false, "\t", nthreads);
+      ExpectSameTable(autopref, parallel_autopref);
+
+      DataTable cars("stats/tests/CarsClean.csv", true, ",");
+      DataTable parallel_cars;
+      parallel_cars.read_file_parallel(
+          "stats/tests/CarsClean.csv", true, ",", nthreads);
+      ExpectSameTable(cars, parallel_cars);
+    }
+  }
+
+  TEST_F(MixedMultivariateDataTest, ParallelReadLargeFile) {
+    // Big enough to be split into several chunks.
+    std::string filename = "parallel_read_test.csv";
+    int nrows = 20000;
+    std::vector<std::string> colors = {"red", "blue", "green"};
+    {
+      std::ofstream out(filename);
+      out << "x,color,y\n";
+      for (int i = 0; i < nrows; ++i) {
+        out << rnorm() << ", " << colors[i % 3] << ","
+            << (i == nrows - 1 ? "+" : "") << i << "\r\n";
+        if (i % 1000 == 0) out << "\n";
+      }
+    }
+    DataTable serial(filename, true, ",");
+    DataTable parallel;
+    parallel.read_file_parallel(filename, true, ",", 4, 10);
+    ExpectSameTable(serial, parallel);
+    EXPECT_EQ(nrows, parallel.nobs());
+    EXPECT_DOUBLE_EQ(nrows - 1, parallel.getvar(2).back());
+
+    // A non-numeric value in a numeric column after the type sample is an
+    // error.
+    {
+      std::ofstream out(filename, std::ios::app);
+      out << "oops,red,1\n";
+    }
+    DataTable bad;
+    EXPECT_THROW(bad.read_file_parallel(filename, true, ",", 4, 10),
+                 std::exception);
+
+    // Values in the type sample determine the variable type.
+    DataTable all;
+    all.read_file_parallel(filename, true, ",", 4, nrows + 1000);
+    EXPECT_EQ(VariableType::categorical, all.variable_type(0));
+    EXPECT_EQ(VariableType::numeric, all.variable_type(2));
+    std::remove(filename.c_str());
+  }
 }  // namespace
@@ -1,6 +1,9 @@
 #include "gtest/gtest.h"
 #include "stats/ECDF.hpp"
 
+#include <cmath>
+#include <limits>
+
 #include "LinAlg/Vector.hpp"
 #include "distributions.hpp"
 
@@ -35,4 +38,41 @@ namespace {
     EXPECT_NEAR(ecdf.quantile(.975), qnorm(.975), .01);
   }
 
+  // The batched evaluations should match the scalar ones, including at ties,
+  // at points outside the range of the data, and at NaN.
+  TEST_F(EcdfTest, BatchedQueries) {
+    int n = 500;
+    Vector values(n);
+    for (int i = 0; i < n; ++i) {
+      // Rounding creates plenty of ties.
+      values[i] = std::round(10 * rnorm()) / 10;
+    }
+    ECDF ecdf(values);
+
+    for (int m : {3, 2000}) {
+      Vector x(m);
+      for (int i = 0; i < m; ++i) {
+        x[i] = std::round(15 * rnorm()) / 10;
+      }
+      x[0] = values[7];
+      x[1] = negative_infinity();
+      x[2] = std::numeric_limits<double>::quiet_NaN();
+
+      Vector plus = ecdf.fplus(x);
+      Vector minus = ecdf.fminus(x);
+      ASSERT_EQ(plus.size(), m);
+      ASSERT_EQ(minus.size(), m);
+      for (int i = 0; i < m; ++i) {
+        EXPECT_DOUBLE_EQ(plus[i], ecdf.fplus(x[i])) << "i = " << i;
+        EXPECT_DOUBLE_EQ(minus[i], ecdf.fminus(x[i])) << "i = " << i;
+      }
+    }
+
+    Vector probs = {0.0, .001, .025, .5, .975, 1.0};
+    Vector quantiles = ecdf.quantile(probs);
+    for (int i = 0; i < probs.size(); ++i) {
+      EXPECT_DOUBLE_EQ(quantiles[i], ecdf.quantile(probs[i]));
+    }
+  }
+
 }  // namespace
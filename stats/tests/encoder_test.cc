@@ -38,4 +38,120 @@ namespace {
     EXPECT_TRUE(VectorEquals(enc, Vector{-1, -1}));
   }
 
+  TEST_F(EncoderTest, EncodeFromCodes) {
+    DataTable table;
+    table.append_variable(
+        CategoricalColumn(std::vector<std::int32_t>{0, 1, 2, 1}, colors_),
+        "color");
+    table.append_variable(
+        CategoricalColumn(std::vector<std::int32_t>{3, 2, 1, 0}, sizes_),
+        "size");
+    NEW(EffectsEncoder, color_encoder)(0, colors_);
+    NEW(EffectsEncoder, size_encoder)(1, sizes_);
+    DatasetEncoder encoder;
+    encoder.add_encoder(color_encoder);
+    encoder.add_encoder(size_encoder);
+    encoder.add_encoder(new InteractionEncoder(color_encoder, size_encoder));
+
+    Matrix encoded = encoder.encode_dataset(table);
+    ASSERT_EQ(4, encoded.nrow());
+    ASSERT_EQ(encoder.dim(), encoded.ncol());
+    for (int i = 0; i < table.nrow(); ++i) {
+      EXPECT_TRUE(VectorEquals(encoded.row(i),
+                               encoder.encode_row(*table.row(i))))
+          << "row " << i;
+    }
+  }
+
+  TEST_F(EncoderTest, SparseEncodingMatchesDense) {
+    Ptr<EffectsEncoder> color_encoder(new EffectsEncoder(0, colors_));
+    Ptr<EffectsEncoder> size_encoder(new EffectsEncoder(1, sizes_));
+    NEW(InteractionEncoder, interaction)(color_encoder, size_encoder);
+    DatasetEncoder encoder;
+    encoder.add_encoder(color_encoder);
+    encoder.add_encoder(size_encoder);
+    encoder.add_encoder(interaction);
+    EXPECT_EQ(1 + 2 + 3 + 6, encoder.dim());
+
+    for (const std::string &color : colors_->labels()) {
+      for (const std::string &size : sizes_->labels()) {
+        MixedMultivariateData row;
+        row.add_categorical(new LabeledCategoricalData(color, colors_));
+        row.add_categorical(new LabeledCategoricalData(size, sizes_));
+
+        Vector dense = encoder.encode_row(row);
+        SparseVector sparse = encoder.encode_row_sparse(row);
+        EXPECT_EQ(encoder.dim(), sparse.size());
+        EXPECT_TRUE(VectorEquals(dense, sparse.dense()))
+            << "color = " << color << " size = " << size << endl
+            << "dense  = " << dense << endl
+            << "sparse = " << sparse.dense();
+      }
+    }
+
+    // A single observation away from the reference levels has one nonzero
+    // per encoder, plus the intercept.
+    MixedMultivariateData row;
+    row.add_categorical(new LabeledCategoricalData("red", colors_));
+    row.add_categorical(new LabeledCategoricalData("small", sizes_));
+    SparseVector sparse = encoder.encode_row_sparse(row);
+    int nonzeros = 0;
+    for (auto it = sparse.begin(); it != sparse.end(); ++it) {
+      ++nonzeros;
+    }
+    EXPECT_EQ(4, nonzeros);
+  }
+
+  // Encoding in chunks, or into a block of a larger matrix, matches
+  // encoding the whole table at once.
+  TEST_F(EncoderTest, EncodeIntoBlocks) {
+    int nrow = 2500;
+    std::vector<std::int32_t> color_codes(nrow), size_codes(nrow);
+    for (int i = 0; i < nrow; ++i) {
+      color_codes[i] = random_int(0, 2);
+      size_codes[i] = random_int(0, 3);
+    }
+    DataTable table;
+    table.append_variable(CategoricalColumn(color_codes, colors_), "color");
+    table.append_variable(CategoricalColumn(size_codes, sizes_), "size");
+    NEW(EffectsEncoder, color_encoder)(0, colors_);
+    NEW(EffectsEncoder, size_encoder)(1, sizes_);
+    DatasetEncoder encoder;
+    encoder.add_encoder(color_encoder);
+    encoder.add_encoder(size_encoder);
+    encoder.add_encoder(new InteractionEncoder(color_encoder, size_encoder));
+
+    Matrix encoded = encoder.encode_dataset(table);
+    for (int i = 0; i < nrow; i += 97) {
+      EXPECT_TRUE(VectorEquals(encoded.row(i),
+                               encoder.encode_row(*table.row(i))))
+          << "row " << i;
+    }
+
+    int rows_seen = 0;
+    encoder.encode_in_chunks(table, 300, [&](int first_row,
+                                             const Matrix &block) {
+      EXPECT_EQ(first_row, rows_seen);
+      EXPECT_LE(block.nrow(), 300);
+      EXPECT_TRUE(MatrixEquals(
+          block, ConstSubMatrix(encoded, first_row,
+                                first_row + block.nrow() - 1,
+                                0, encoded.ncol() - 1).to_matrix()));
+      rows_seen += block.nrow();
+    });
+    EXPECT_EQ(rows_seen, nrow);
+
+    // Write rows 100-199 into the middle of a larger matrix.
+    Matrix big(200, encoder.dim() + 2, 0.0);
+    encoder.encode_into(table, SubMatrix(big, 50, 149, 1, encoder.dim()), 100);
+    EXPECT_TRUE(MatrixEquals(
+        SubMatrix(big, 50, 149, 1, encoder.dim()).to_matrix(),
+        ConstSubMatrix(encoded, 100, 199, 0, encoded.ncol() - 1).to_matrix()));
+    EXPECT_DOUBLE_EQ(big.col(0).abs_norm(), 0.0);
+    EXPECT_DOUBLE_EQ(big.row(0).abs_norm(), 0.0);
+
+    EXPECT_THROW(encoder.encode_into(table, SubMatrix(big), 0),
+                 std::exception);
+  }
+
 }  // namespace
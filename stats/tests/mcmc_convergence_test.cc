@@ -0,0 +1,124 @@
+#include "gtest/gtest.h"
+#include "stats/mcmc_convergence.hpp"
+#include "distributions.hpp"
+#include "test_utils/test_utils.hpp"
+
+namespace {
+  using namespace BOOM;
+  using std::endl;
+  using std::cout;
+
+  class McmcConvergenceTest : public ::testing::Test {
+   protected:
+    McmcConvergenceTest() {
+      GlobalRng::rng.seed(8675309);
+    }
+  };
+
+  TEST_F(McmcConvergenceTest, IndependentDraws) {
+    int nchains = 4;
+    int n = 4000;
+    McmcConvergenceMonitor monitor(nchains, 2);
+    for (int c = 0; c < nchains; ++c) {
+      for (int i = 0; i < n; ++i) {
+        monitor.add(c, Vector{rnorm(0, 1), rnorm(3, 2)});
+      }
+    }
+    EXPECT_EQ(n, monitor.sample_size(2));
+    EXPECT_EQ(n, monitor.min_sample_size());
+    Vector rhat = monitor.rhat();
+    EXPECT_NEAR(rhat[0], 1.0, .01);
+    EXPECT_NEAR(rhat[1], 1.0, .01);
+    Vector ess = monitor.effective_sample_size();
+    EXPECT_GT(ess[0], .6 * nchains * n);
+    EXPECT_LE(ess[0], nchains * n);
+    EXPECT_GT(ess[1], .6 * nchains * n);
+  }
+
+  TEST_F(McmcConvergenceTest, AutocorrelatedDraws) {
+    // The effective sample size of an AR(1) process with coefficient phi is
+    // about n * (1 - phi) / (1 + phi).
+    int nchains = 2;
+    int n = 20000;
+    double phi = .9;
+    McmcConvergenceMonitor monitor(nchains, 1);
+    for (int c = 0; c < nchains; ++c) {
+      double x = 0;
+      for (int i = 0; i < n; ++i) {
+        x = phi * x + rnorm(0, 1);
+        monitor.add(c, Vector(1, x));
+      }
+    }
+    double expected = nchains * n * (1 - phi) / (1 + phi);
+    double ess = monitor.effective_sample_size()[0];
+    EXPECT_GT(ess, .6 * expected);
+    EXPECT_LT(ess, 1.5 * expected);
+  }
+
+  TEST_F(McmcConvergenceTest, ChainsThatDisagree) {
+    McmcConvergenceMonitor monitor(3, 1);
+    for (int c = 0; c < 3; ++c) {
+      for (int i = 0; i < 500; ++i) {
+        monitor.add(c, Vector(1, rnorm(c, 1)));
+      }
+    }
+    EXPECT_GT(monitor.rhat()[0], 1.3);
+
+    monitor.clear();
+    EXPECT_EQ(0, monitor.min_sample_size());
+    EXPECT_FALSE(std::isfinite(monitor.rhat()[0]));
+    EXPECT_DOUBLE_EQ(0.0, monitor.effective_sample_size()[0]);
+  }
+
+  // A single drifting chain goes undetected by R-hat, but not by split R-hat
+  // or the Geweke diagnostic.
+  TEST_F(McmcConvergenceTest, DriftingChain) {
+    int n = 3000;
+    McmcConvergenceMonitor monitor(1, 2);
+    for (int i = 0; i < n; ++i) {
+      monitor.add(0, Vector{rnorm(0, 1), rnorm(0, 1) + 4.0 * i / n});
+    }
+    EXPECT_FALSE(std::isfinite(monitor.rhat()[0]));
+    Vector split_rhat = monitor.split_rhat();
+    EXPECT_NEAR(1.0, split_rhat[0], .01);
+    EXPECT_GT(split_rhat[1], 1.2);
+    Vector z = monitor.geweke(0);
+    EXPECT_LT(std::fabs(z[0]), 4.0);
+    EXPECT_GT(std::fabs(z[1]), 10.0);
+  }
+
+  // The within-batch sums of squares survive batch merging, so split R-hat
+  // agrees with R-hat computed from the half chains directly.
+  TEST_F(McmcConvergenceTest, SplitRhatMatchesHalfChains) {
+    int n = 1024;
+    McmcConvergenceMonitor whole(2, 1, 8);
+    McmcConvergenceMonitor halves(4, 1, 8);
+    for (int c = 0; c < 2; ++c) {
+      for (int i = 0; i < n; ++i) {
+        double x = rnorm(c * .1, 1.0 + i % 3) + 100;
+        whole.add(c, Vector(1, x));
+        halves.add(2 * c + (i >= n / 2), Vector(1, x));
+      }
+    }
+    EXPECT_NEAR(halves.rhat()[0], whole.split_rhat()[0], 1e-8);
+  }
+
+  TEST_F(McmcConvergenceTest, StoppingRule) {
+    McmcConvergenceMonitor monitor(2, 2);
+    McmcStoppingRule rule = ConvergenceStoppingRule(500, 1.05, 3.0, {0});
+    EXPECT_FALSE(rule(monitor));
+    for (int i = 0; i < 1000; ++i) {
+      for (int c = 0; c < 2; ++c) {
+        // Element 1 is stuck at a different value in each chain.
+        monitor.add(c, Vector{rnorm(0, 1), c + rnorm(0, .01)});
+      }
+    }
+    EXPECT_TRUE(rule(monitor));
+    EXPECT_FALSE(ConvergenceStoppingRule(500)(monitor));
+    EXPECT_FALSE(ConvergenceStoppingRule(5000, infinity(), infinity(), {0})(
+        monitor));
+    EXPECT_THROW(ConvergenceStoppingRule(10, 1.1, 3.0, {2})(monitor),
+                 std::exception);
+  }
+
+}  // namespace
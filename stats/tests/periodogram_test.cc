@@ -0,0 +1,75 @@
+#include "gtest/gtest.h"
+#include "stats/periodogram.hpp"
+#include "stats/moments.hpp"
+
+#include "LinAlg/Vector.hpp"
+#include "LinAlg/Matrix.hpp"
+#include "cpputil/Constants.hpp"
+#include "distributions.hpp"
+
+#include "test_utils/test_utils.hpp"
+
+namespace {
+  using namespace BOOM;
+  using std::endl;
+
+  class PeriodogramTest : public ::testing::Test {
+   protected:
+    PeriodogramTest() {
+      GlobalRng::rng.seed(8675309);
+    }
+  };
+
+  // White noise has a flat spectrum at the level of its variance.  Centering
+  // each segment removes power from the lowest frequencies, so they are
+  // skipped.
+  TEST_F(PeriodogramTest, WhiteNoise) {
+    int n = 50000;
+    double sigma = 2.0;
+    Vector x(n);
+    for (int i = 0; i < n; ++i) {
+      x[i] = rnorm(0, sigma);
+    }
+    Vector spectrum = welch_periodogram(x, 64, 32);
+    ASSERT_EQ(33, spectrum.size());
+    for (int k = 2; k < 32; ++k) {
+      EXPECT_NEAR(sigma * sigma, spectrum[k], .5) << "k = " << k;
+    }
+    EXPECT_NEAR(sigma * sigma,
+                mean(ConstVectorView(spectrum, 2, spectrum.size() - 3)), .1);
+  }
+
+  // A seasonal pattern shows up as a peak at its frequency.
+  TEST_F(PeriodogramTest, FindsSeasonalPeak) {
+    int n = 2000;
+    int period = 8;
+    Vector x(n);
+    for (int i = 0; i < n; ++i) {
+      x[i] = 3 * cos(2 * Constants::pi * i / period) + rnorm();
+    }
+    int segment_length = 128;
+    Vector spectrum = welch_periodogram(x, segment_length, 64);
+    int peak = 0;
+    for (int k = 1; k < spectrum.size(); ++k) {
+      if (spectrum[k] > spectrum[peak]) {
+        peak = k;
+      }
+    }
+    EXPECT_EQ(segment_length / period, peak);
+  }
+
+  TEST_F(PeriodogramTest, BatchMatchesSingleSeries) {
+    int nseries = 5;
+    int n = 300;
+    Matrix series(nseries, n);
+    series.randomize();
+    Matrix batch = batch_welch_periodogram(series, 32, 8);
+    ASSERT_EQ(nseries, batch.nrow());
+    ASSERT_EQ(17, batch.ncol());
+    for (int i = 0; i < nseries; ++i) {
+      EXPECT_TRUE(VectorEquals(batch.row(i),
+                               welch_periodogram(series.row(i), 32, 8)));
+    }
+  }
+
+}  // namespace
@@ -2,6 +2,7 @@
 #include "stats/quantile.hpp"
 
 #include "LinAlg/Vector.hpp"
+#include "cpputil/ThreadTools.hpp"
 #include "distributions.hpp"
 
 #include "test_utils/test_utils.hpp"
@@ -85,4 +86,30 @@ namespace {
     }
   }
 
+  // The selection-based quantiles should match those computed by fully
+  // sorting the data, with or without a thread pool.
+  TEST_F(QuantileTest, MatchesSortedQuantiles) {
+    Matrix draws(1001, 37);
+    draws.randomize();
+    Vector target_quantiles = {0.0, 0.025, 0.1, 0.5, 0.5, 0.9, 0.975, 1.0};
+
+    Matrix expected(target_quantiles.size(), draws.ncol());
+    for (int j = 0; j < draws.ncol(); ++j) {
+      Vector sorted = sort(draws.col(j));
+      for (int i = 0; i < target_quantiles.size(); ++i) {
+        expected(i, j) = sorted_vector_quantile(sorted, target_quantiles[i]);
+      }
+    }
+
+    EXPECT_TRUE(MatrixEquals(expected, quantile(draws, target_quantiles),
+                             1e-12));
+
+    ThreadWorkerPool pool(4);
+    EXPECT_TRUE(MatrixEquals(expected,
+                             quantile(draws, target_quantiles, &pool),
+                             1e-12));
+    EXPECT_TRUE(VectorEquals(expected.row(3), quantile(draws, 0.5, &pool),
+                             1e-12));
+  }
+
 }  // namespace
@@ -1,8 +1,12 @@
 #include "gtest/gtest.h"
 
+#include <cmath>
+#include <limits>
+
 #include "distributions.hpp"
 #include "LinAlg/Vector.hpp"
 #include "stats/Bspline.hpp"
+#include "stats/Mspline.hpp"
 #include "test_utils/test_utils.hpp"
 
 namespace {
@@ -32,4 +36,66 @@ namespace {
 
   }
 
+  // Check that basis_matrix agrees with basis() evaluated one point at a time.
+  void CheckBasisMatrix(const SplineBase &spline, const Vector &x) {
+    Matrix basis_matrix = spline.basis_matrix(x);
+    ASSERT_EQ(basis_matrix.nrow(), x.size());
+    ASSERT_EQ(basis_matrix.ncol(), spline.basis_dimension());
+    for (int i = 0; i < x.size(); ++i) {
+      Vector basis = spline.basis(x[i]);
+      for (int j = 0; j < basis.size(); ++j) {
+        if (std::isnan(basis[j])) {
+          EXPECT_TRUE(std::isnan(basis_matrix(i, j)));
+        } else {
+          EXPECT_NEAR(basis_matrix(i, j), basis[j], 1e-10)
+              << "x = " << x[i] << " basis element " << j;
+        }
+      }
+    }
+  }
+
+  TEST_F(BsplineTest, BasisMatrix) {
+    Vector knots = {0, 1.5, 2, 3.7, 4, 6};
+    Vector x(300);
+    for (int i = 0; i < x.size(); ++i) {
+      x[i] = runif(-1, 7);
+    }
+    // Points on the knots, at the boundaries, and outside the domain.
+    x[0] = 0;
+    x[1] = 6;
+    x[2] = 2;
+    x[3] = -.5;
+    x[4] = 6.5;
+    x[5] = std::numeric_limits<double>::quiet_NaN();
+    Vector sorted_x = x;
+    sorted_x.pop_back();  // Avoid sorting the NaN.
+    sorted_x[5] = 3.0;
+    sorted_x.sort();
+
+    for (int degree = 0; degree <= 4; ++degree) {
+      Bspline spline(knots, degree);
+      CheckBasisMatrix(spline, x);
+      CheckBasisMatrix(spline, sorted_x);
+    }
+
+    for (int order = 1; order <= 4; ++order) {
+      Mspline mspline(knots, order);
+      CheckBasisMatrix(mspline, x);
+      CheckBasisMatrix(mspline, sorted_x);
+
+      Ispline ispline(knots, order);
+      CheckBasisMatrix(ispline, x);
+      CheckBasisMatrix(ispline, sorted_x);
+    }
+
+    // Filling a block of a larger matrix.
+    Bspline spline(knots);
+    Matrix design(x.size(), spline.basis_dimension() + 1, 0.0);
+    spline.basis_matrix(x, SubMatrix(design, 0, x.size() - 1,
+                                     1, spline.basis_dimension()));
+    EXPECT_TRUE(VectorEquals(design.col(0), Vector(x.size(), 0.0), 1e-12));
+    EXPECT_TRUE(VectorEquals(design.row(17),
+                             concat(Vector(1, 0.0), spline.basis(x[17])), 1e-10));
+  }
+
 }  // namespace
@@ -0,0 +1,101 @@
+#include "gtest/gtest.h"
+
+#include "stats/TDigest.hpp"
+#include "stats/ECDF.hpp"
+#include "distributions.hpp"
+
+#include "test_utils/test_utils.hpp"
+
+namespace {
+  using namespace BOOM;
+  using std::endl;
+  using std::cout;
+
+  class TDigestTest : public ::testing::Test {
+   protected:
+    TDigestTest() {
+      GlobalRng::rng.seed(8675309);
+    }
+  };
+
+  TEST_F(TDigestTest, MatchesExactQuantiles) {
+    int n = 100000;
+    Vector data(n);
+    for (int i = 0; i < n; ++i) data[i] = rnorm();
+    TDigest digest;
+    digest.add(data);
+    EXPECT_DOUBLE_EQ(digest.count(), n);
+    EXPECT_LE(digest.number_of_centroids(), 200);
+
+    ECDF ecdf(data);
+    for (double p : {.001, .01, .05, .25, .5, .75, .95, .99, .999}) {
+      double q = digest.quantile(p);
+      // Accuracy is measured in probability space, and is relative in the
+      // tails.
+      EXPECT_NEAR(ecdf(q), p, std::min(.005, .25 * std::min(p, 1 - p)))
+          << "p = " << p;
+      EXPECT_NEAR(digest.cdf(q), p, 1e-8) << "p = " << p;
+    }
+    EXPECT_DOUBLE_EQ(digest.quantile(0), data.min());
+    EXPECT_DOUBLE_EQ(digest.quantile(1), data.max());
+    EXPECT_DOUBLE_EQ(digest.cdf(data.min() - 1), 0.0);
+    EXPECT_DOUBLE_EQ(digest.cdf(data.max()), 1.0);
+  }
+
+  // Digests built on separate chunks of data and then merged agree with a
+  // digest of all the data.
+  TEST_F(TDigestTest, Merge) {
+    int chunks = 8;
+    int chunk_size = 20000;
+    TDigest all;
+    std::vector<TDigest> parts(chunks);
+    Vector data(chunks * chunk_size);
+    for (int c = 0; c < chunks; ++c) {
+      // Each chunk has a different distribution, so no single part looks like
+      // the whole.
+      for (int i = 0; i < chunk_size; ++i) {
+        double x = rgamma(1 + c, 1.0);
+        data[c * chunk_size + i] = x;
+        parts[c].add(x);
+        all.add(x);
+      }
+    }
+    TDigest merged;
+    for (const auto &part : parts) merged.merge(part);
+    EXPECT_DOUBLE_EQ(merged.count(), all.count());
+    EXPECT_DOUBLE_EQ(merged.min(), all.min());
+    EXPECT_DOUBLE_EQ(merged.max(), all.max());
+
+    ECDF ecdf(data);
+    for (double p : {.01, .1, .5, .9, .99}) {
+      EXPECT_NEAR(ecdf(merged.quantile(p)), p, .005) << "p = " << p;
+      EXPECT_NEAR(merged.quantile(p), all.quantile(p),
+                  .01 * (1 + fabs(all.quantile(p))));
+    }
+  }
+
+  TEST_F(TDigestTest, SaveAndRestore) {
+    TDigest digest(50);
+    for (int i = 0; i < 5000; ++i) digest.add(rexp(2.0));
+    TDigest copy(digest.save_state());
+    EXPECT_DOUBLE_EQ(copy.count(), digest.count());
+    EXPECT_EQ(copy.number_of_centroids(), digest.number_of_centroids());
+    for (double p : {0.0, .1, .5, .9, 1.0}) {
+      EXPECT_DOUBLE_EQ(copy.quantile(p), digest.quantile(p));
+    }
+  }
+
+  TEST_F(TDigestTest, SmallData) {
+    TDigest digest;
+    EXPECT_THROW(digest.quantile(.5), std::exception);
+    digest.add(3.0);
+    EXPECT_DOUBLE_EQ(digest.quantile(.5), 3.0);
+    digest.add(1.0);
+    digest.add(2.0);
+    EXPECT_DOUBLE_EQ(digest.quantile(0), 1.0);
+    EXPECT_DOUBLE_EQ(digest.quantile(.5), 2.0);
+    EXPECT_DOUBLE_EQ(digest.quantile(1), 3.0);
+    EXPECT_THROW(digest.quantile(1.5), std::exception);
+  }
+
+}  // namespace